@@ -378,6 +378,15 @@ TestFindImpl(BitsetT& bitset, const size_t max_v, const bool is_set) {
         bitset.flip();
     }
 
+    std::vector<size_t> batched_pos;
+    bitset.for_each_batch(
+        [&](const int64_t* const indices, const size_t count) {
+            batched_pos.insert(batched_pos.end(), indices, indices + count);
+            return true;
+        },
+        is_set);
+    ASSERT_EQ(batched_pos, one_pos) << n << ", " << max_v;
+
     StopWatch sw;
 
     auto bit_idx = bitset.find_first(is_set);
@@ -779,6 +788,44 @@ TestInplaceCompareValImpl(BitsetT& bitset, CompareOpType op) {
             ASSERT_TRUE(false) << "Not implemented";
         }
     }
+
+    // the fused ops merge a compare into the bits computed above
+    auto compare = [op](const T& l, const T& r) {
+        switch (op) {
+            case CompareOpType::EQ:
+                return l == r;
+            case CompareOpType::GE:
+                return l >= r;
+            case CompareOpType::GT:
+                return l > r;
+            case CompareOpType::LE:
+                return l <= r;
+            case CompareOpType::LT:
+                return l < r;
+            default:
+                return l != r;
+        }
+    };
+    std::vector<T> u(n, from_i32<T>(0));
+    FillRandom(u, rng, max_v);
+
+    std::vector<bool> before(n);
+    for (size_t i = 0; i < n; i++) {
+        before[i] = bitset[i];
+    }
+    bitset.inplace_compare_val_and(u.data(), n, value, op);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(before[i] && compare(u[i], value), bitset[i]) << i;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        before[i] = bitset[i];
+    }
+    FillRandom(u, rng, max_v);
+    bitset.inplace_compare_val_or(u.data(), n, value, op);
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(before[i] || compare(u[i], value), bitset[i]) << i;
+    }
 }
 
 template <typename BitsetT, typename T>
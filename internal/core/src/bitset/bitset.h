@@ -568,6 +568,17 @@ class BitsetBase {
                                     is_set);
     }
 
+    // Call func(const int64_t* const indices, const size_t n) with batches
+    //   of the indices of the bits set to either true (default), or false,
+    //   in increasing order, until func returns false. Unlike find_next(),
+    //   the indices of a whole block of bits are extracted at once.
+    template <typename Func>
+    inline void
+    for_each_batch(Func func, const bool is_set = true) const {
+        policy_type::op_for_each_batch(
+            this->data(), this->offset(), this->size(), is_set, func);
+    }
+
     // Read multiple bits starting from a given bit index.
     inline data_type
     read(const size_t starting_bit_idx, const size_t nbits) {
@@ -658,6 +669,78 @@ class BitsetBase {
             this->data(), this->offset(), t, size, value);
     }
 
+    // Compare elements of an given array with a given value and AND the
+    //   outcome into the bitset, in a single pass and with no temporary bitset
+    template <typename T>
+    void
+    inplace_compare_val_and(const T* const __restrict t,
+                            const size_t size,
+                            const T& value,
+                            CompareOpType op) {
+        if (op == CompareOpType::EQ) {
+            this->inplace_compare_val_and<T, CompareOpType::EQ>(t, size, value);
+        } else if (op == CompareOpType::GE) {
+            this->inplace_compare_val_and<T, CompareOpType::GE>(t, size, value);
+        } else if (op == CompareOpType::GT) {
+            this->inplace_compare_val_and<T, CompareOpType::GT>(t, size, value);
+        } else if (op == CompareOpType::LE) {
+            this->inplace_compare_val_and<T, CompareOpType::LE>(t, size, value);
+        } else if (op == CompareOpType::LT) {
+            this->inplace_compare_val_and<T, CompareOpType::LT>(t, size, value);
+        } else if (op == CompareOpType::NE) {
+            this->inplace_compare_val_and<T, CompareOpType::NE>(t, size, value);
+        } else {
+            // unimplemented
+        }
+    }
+
+    template <typename T, CompareOpType Op>
+    void
+    inplace_compare_val_and(const T* const __restrict t,
+                            const size_t size,
+                            const T& value) {
+        range_checker::le(size, this->size());
+
+        policy_type::template op_compare_val_and<T, Op>(
+            this->data(), this->offset(), t, size, value);
+    }
+
+    // Compare elements of an given array with a given value and OR the
+    //   outcome into the bitset, in a single pass and with no temporary bitset
+    template <typename T>
+    void
+    inplace_compare_val_or(const T* const __restrict t,
+                           const size_t size,
+                           const T& value,
+                           CompareOpType op) {
+        if (op == CompareOpType::EQ) {
+            this->inplace_compare_val_or<T, CompareOpType::EQ>(t, size, value);
+        } else if (op == CompareOpType::GE) {
+            this->inplace_compare_val_or<T, CompareOpType::GE>(t, size, value);
+        } else if (op == CompareOpType::GT) {
+            this->inplace_compare_val_or<T, CompareOpType::GT>(t, size, value);
+        } else if (op == CompareOpType::LE) {
+            this->inplace_compare_val_or<T, CompareOpType::LE>(t, size, value);
+        } else if (op == CompareOpType::LT) {
+            this->inplace_compare_val_or<T, CompareOpType::LT>(t, size, value);
+        } else if (op == CompareOpType::NE) {
+            this->inplace_compare_val_or<T, CompareOpType::NE>(t, size, value);
+        } else {
+            // unimplemented
+        }
+    }
+
+    template <typename T, CompareOpType Op>
+    void
+    inplace_compare_val_or(const T* const __restrict t,
+                           const size_t size,
+                           const T& value) {
+        range_checker::le(size, this->size());
+
+        policy_type::template op_compare_val_or<T, Op>(
+            this->data(), this->offset(), t, size, value);
+    }
+
     //
     template <typename T>
     void
@@ -171,5 +171,50 @@ struct CompareOpDivFlip {
                                        : CmpOp;
 };
 
+// Split block bloom filter, as in Parquet. A key selects one 256 bit block
+//   by the upper half of its 64 bit hash and sets one bit in every 32 bit
+//   word of the block, picked by the lower half of the hash multiplied by
+//   the word's salt.
+constexpr size_t SPLIT_BLOCK_BLOOM_FILTER_WORDS = 8;
+
+constexpr uint32_t
+    SPLIT_BLOCK_BLOOM_FILTER_SALT[SPLIT_BLOCK_BLOOM_FILTER_WORDS] = {
+        0x47b6137bU,
+        0x44974d91U,
+        0x8824ad5bU,
+        0xa2b7289dU,
+        0x705495c7U,
+        0x2df1424bU,
+        0x9efc4947U,
+        0x5c6bfb31U};
+
+inline size_t
+split_block_bloom_filter_block(const uint64_t hash, const size_t num_blocks) {
+    return static_cast<size_t>(((hash >> 32) * num_blocks) >> 32);
+}
+
+// The positions of the set bits of every byte value, in increasing order,
+//   for extracting the indices of the set bits by a table lookup.
+struct SetBitsLookupTable {
+    uint8_t positions[256][8];
+};
+
+constexpr SetBitsLookupTable
+make_set_bits_lookup_table() {
+    SetBitsLookupTable table{};
+    for (size_t value = 0; value < 256; value++) {
+        size_t n = 0;
+        for (size_t bit = 0; bit < 8; bit++) {
+            if (value & (size_t(1) << bit)) {
+                table.positions[value][n++] = static_cast<uint8_t>(bit);
+            }
+        }
+    }
+    return table;
+}
+
+inline constexpr SetBitsLookupTable SET_BITS_LOOKUP_TABLE =
+    make_set_bits_lookup_table();
+
 }  // namespace bitset
 }  // namespace milvus
@@ -327,6 +327,32 @@ struct BitWiseBitsetPolicy {
         return std::nullopt;
     }
 
+    // bool Func(const int64_t* const indices, const size_t n)
+    template <typename Func>
+    static inline bool
+    op_for_each_batch(const data_type* const data,
+                      const size_t start,
+                      const size_t size,
+                      const bool is_set,
+                      Func func) {
+        constexpr size_t batch_size = 1024;
+        int64_t batch[batch_size];
+        size_t n = 0;
+        for (size_t i = 0; i < size; i++) {
+            if (get_proxy(data, start + i) == is_set) {
+                batch[n++] = i;
+                if (n == batch_size) {
+                    if (!func(batch, n)) {
+                        return false;
+                    }
+                    n = 0;
+                }
+            }
+        }
+
+        return n == 0 || func(batch, n);
+    }
+
     //
     template <typename T, typename U, CompareOpType Op>
     static inline void
@@ -355,6 +381,32 @@ struct BitWiseBitsetPolicy {
         }
     }
 
+    template <typename T, CompareOpType Op>
+    static inline void
+    op_compare_val_and(data_type* const __restrict data,
+                       const size_t start,
+                       const T* const __restrict t,
+                       const size_t size,
+                       const T& value) {
+        for (size_t i = 0; i < size; i++) {
+            get_proxy(data, start + i) &=
+                CompareOperator<Op>::compare(t[i], value);
+        }
+    }
+
+    template <typename T, CompareOpType Op>
+    static inline void
+    op_compare_val_or(data_type* const __restrict data,
+                      const size_t start,
+                      const T* const __restrict t,
+                      const size_t size,
+                      const T& value) {
+        for (size_t i = 0; i < size; i++) {
+            get_proxy(data, start + i) |=
+                CompareOperator<Op>::compare(t[i], value);
+        }
+    }
+
     template <typename T, RangeType Op>
     static inline void
     op_within_range_column(data_type* const __restrict data,
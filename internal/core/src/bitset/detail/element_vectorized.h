@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -226,6 +227,54 @@ struct VectorizedElementWiseBitsetPolicy {
             data, start, size, starting_idx, is_set);
     }
 
+    // bool Func(const int64_t* const indices, const size_t n)
+    template <typename Func>
+    static inline bool
+    op_for_each_batch(const data_type* const data,
+                      const size_t start,
+                      const size_t size,
+                      const bool is_set,
+                      Func func) {
+        // the bits up to the first whole element
+        const size_t start_shift = get_shift(start);
+        const size_t head =
+            (start_shift == 0) ? 0 : std::min(data_bits - start_shift, size);
+        if (!ElementWiseBitsetPolicy<ElementT>::op_for_each_batch(
+                data, start, head, is_set, func)) {
+            return false;
+        }
+
+        // the whole elements, extracted by the vectorized kernel in blocks,
+        //   each fitting the batch
+        constexpr size_t batch_size = 1024;
+        int64_t batch[batch_size];
+        const data_type* const elements = data + get_element(start + head);
+        const size_t middle = (size - head) / data_bits * data_bits;
+        size_t i = 0;
+        while (i < middle) {
+            const size_t nbits = std::min(batch_size, middle - i);
+            size_t count = 0;
+            if (!VectorizedT::op_extract_bits(
+                    batch,
+                    &count,
+                    reinterpret_cast<const uint8_t*>(elements) + i / 8,
+                    nbits,
+                    is_set,
+                    int64_t(head + i))) {
+                break;
+            }
+            if (count > 0 && !func(batch, count)) {
+                return false;
+            }
+            i += nbits;
+        }
+
+        // the remaining bits, all of the whole elements as well if there is
+        //   no vectorized kernel
+        return ElementWiseBitsetPolicy<ElementT>::op_for_each_batch(
+            data, start + head + i, size - head - i, is_set, func, head + i);
+    }
+
     //
     template <typename T, typename U, CompareOpType Op>
     static inline void
@@ -287,6 +336,70 @@ struct VectorizedElementWiseBitsetPolicy {
             });
     }
 
+    //
+    template <typename T, CompareOpType Op>
+    static inline void
+    op_compare_val_and(data_type* const __restrict data,
+                       const size_t start,
+                       const T* const __restrict t,
+                       const size_t size,
+                       const T& value) {
+        op_func(
+            start,
+            size,
+            [data, t, value](const size_t starting_bit,
+                             const size_t ptr_offset,
+                             const size_t nbits) {
+                ElementWiseBitsetPolicy<ElementT>::
+                    template op_compare_val_and<T, Op>(
+                        data, starting_bit, t + ptr_offset, nbits, value);
+            },
+            [data, t, value](const size_t starting_element,
+                             const size_t ptr_offset,
+                             const size_t nbits) {
+                return op_compare_val_fused<T, Op>(
+                    reinterpret_cast<uint8_t*>(data + starting_element),
+                    t + ptr_offset,
+                    nbits,
+                    value,
+                    [](const uint8_t old_v, const uint8_t new_v) {
+                        return uint8_t(old_v & new_v);
+                    });
+            });
+    }
+
+    //
+    template <typename T, CompareOpType Op>
+    static inline void
+    op_compare_val_or(data_type* const __restrict data,
+                      const size_t start,
+                      const T* const __restrict t,
+                      const size_t size,
+                      const T& value) {
+        op_func(
+            start,
+            size,
+            [data, t, value](const size_t starting_bit,
+                             const size_t ptr_offset,
+                             const size_t nbits) {
+                ElementWiseBitsetPolicy<ElementT>::
+                    template op_compare_val_or<T, Op>(
+                        data, starting_bit, t + ptr_offset, nbits, value);
+            },
+            [data, t, value](const size_t starting_element,
+                             const size_t ptr_offset,
+                             const size_t nbits) {
+                return op_compare_val_fused<T, Op>(
+                    reinterpret_cast<uint8_t*>(data + starting_element),
+                    t + ptr_offset,
+                    nbits,
+                    value,
+                    [](const uint8_t old_v, const uint8_t new_v) {
+                        return uint8_t(old_v | new_v);
+                    });
+            });
+    }
+
     //
     template <typename T, RangeType Op>
     static inline void
@@ -413,6 +526,40 @@ struct VectorizedElementWiseBitsetPolicy {
             left, right, start_left, start_right, size);
     }
 
+    // the bits compared by a single run of the compare kernel of a fused op
+    static constexpr size_t fused_block_bits = 2048;
+
+    // Runs the compare kernel over blocks of fused_block_bits into a buffer
+    //   on the stack and merges each block into the bitmask while it is
+    //   still in L1, so a predicate is applied to a running result in one
+    //   sweep of it and with no temporary bitset.
+    // uint8_t MergeFunc(const uint8_t old_v, const uint8_t new_v)
+    // API requirement: size % 8 == 0
+    template <typename T, CompareOpType Op, typename MergeFunc>
+    static inline bool
+    op_compare_val_fused(uint8_t* const __restrict bitmask,
+                         const T* const __restrict t,
+                         const size_t size,
+                         const T& value,
+                         MergeFunc merge) {
+        alignas(64) uint8_t block[fused_block_bits / 8];
+        for (size_t i = 0; i < size; i += fused_block_bits) {
+            const size_t nbits = std::min(fused_block_bits, size - i);
+            if (!VectorizedT::template op_compare_val<T, Op>(
+                    block, t + i, nbits, value)) {
+                // no kernel for T, which is known before the first block
+                return false;
+            }
+
+            uint8_t* const __restrict out = bitmask + i / 8;
+            for (size_t j = 0; j < nbits / 8; j++) {
+                out[j] = merge(out[j], block[j]);
+            }
+        }
+
+        return true;
+    }
+
     // void FuncBaseline(const size_t starting_bit, const size_t ptr_offset, const size_t nbits)
     // bool FuncVectorized(const size_t starting_element, const size_t ptr_offset, const size_t nbits)
     template <typename FuncBaseline, typename FuncVectorized>
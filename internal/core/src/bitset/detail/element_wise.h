@@ -873,6 +873,49 @@ struct ElementWiseBitsetPolicy {
         }
     }
 
+    // Calls func with batches of the indices of the bits set to is_set, plus
+    //   starting_idx, in increasing order, until func returns false.
+    //   Returns false if func stopped the iteration.
+    // bool Func(const int64_t* const indices, const size_t n)
+    template <typename Func>
+    static inline bool
+    op_for_each_batch(const data_type* const data,
+                      const size_t start,
+                      const size_t size,
+                      const bool is_set,
+                      Func func,
+                      const int64_t starting_idx = 0) {
+        constexpr size_t batch_size = 1024;
+        int64_t batch[batch_size];
+        size_t n = 0;
+        for (size_t i = 0; i < size; i += data_bits) {
+            const size_t nbits = (size - i < data_bits) ? size - i : data_bits;
+            data_type value = op_read(data, start + i, nbits);
+            if (!is_set) {
+                value = ~value;
+                if (nbits < data_bits) {
+                    value &= get_shift_mask_begin(nbits);
+                }
+            }
+
+            while (value != 0) {
+                batch[n++] =
+                    starting_idx + i + CtzHelper<data_type>::ctz(value);
+                value &= value - 1;
+            }
+
+            // room for the bits of the next element
+            if (n + data_bits > batch_size) {
+                if (!func(batch, n)) {
+                    return false;
+                }
+                n = 0;
+            }
+        }
+
+        return n == 0 || func(batch, n);
+    }
+
     //
     template <typename T, typename U, CompareOpType Op>
     static inline void
@@ -899,6 +942,46 @@ struct ElementWiseBitsetPolicy {
         });
     }
 
+    //
+    template <typename T, CompareOpType Op>
+    static inline void
+    op_compare_val_and(data_type* const __restrict data,
+                       const size_t start,
+                       const T* const __restrict t,
+                       const size_t size,
+                       const T& value) {
+        op_func(
+            data,
+            start,
+            size,
+            [t, value](const size_t bit_idx) {
+                return CompareOperator<Op>::compare(t[bit_idx], value);
+            },
+            [](const data_type old_v, const data_type new_v) {
+                return old_v & new_v;
+            });
+    }
+
+    //
+    template <typename T, CompareOpType Op>
+    static inline void
+    op_compare_val_or(data_type* const __restrict data,
+                      const size_t start,
+                      const T* const __restrict t,
+                      const size_t size,
+                      const T& value) {
+        op_func(
+            data,
+            start,
+            size,
+            [t, value](const size_t bit_idx) {
+                return CompareOperator<Op>::compare(t[bit_idx], value);
+            },
+            [](const data_type old_v, const data_type new_v) {
+                return old_v | new_v;
+            });
+    }
+
     //
     template <typename T, RangeType Op>
     static inline void
@@ -1235,6 +1318,22 @@ struct ElementWiseBitsetPolicy {
             const size_t start,
             const size_t size,
             Func func) {
+        op_func(data,
+                start,
+                size,
+                func,
+                [](const data_type, const data_type bits) { return bits; });
+    }
+
+    // bool Func(const size_t bit_idx);
+    // data_type MergeFunc(const data_type old_v, const data_type new_v);
+    template <typename Func, typename MergeFunc>
+    static BITSET_ALWAYS_INLINE inline void
+    op_func(data_type* const __restrict data,
+            const size_t start,
+            const size_t size,
+            Func func,
+            MergeFunc merge) {
         if (size == 0) {
             return;
         }
@@ -1256,7 +1355,8 @@ struct ElementWiseBitsetPolicy {
                 bits |= (data_type(bit ? 1 : 0) << j);
             }
 
-            op_write(data, start, size, bits);
+            op_write(
+                data, start, size, merge(op_read(data, start, size), bits));
             return;
         }
 
@@ -1273,7 +1373,8 @@ struct ElementWiseBitsetPolicy {
                 bits |= (data_type(bit ? 1 : 0) << j);
             }
 
-            op_write(data, start, n_bits, bits);
+            op_write(
+                data, start, n_bits, merge(op_read(data, start, n_bits), bits));
 
             // start from the next element
             start_element += 1;
@@ -1289,7 +1390,7 @@ struct ElementWiseBitsetPolicy {
                     bits |= (data_type(bit ? 1 : 0) << j);
                 }
 
-                data[i] = bits;
+                data[i] = merge(data[i], bits);
                 ptr_offset += data_bits;
             }
         }
@@ -1303,7 +1404,10 @@ struct ElementWiseBitsetPolicy {
             }
 
             const size_t starting_bit_idx = end_element * data_bits;
-            op_write(data, starting_bit_idx, end_shift, bits);
+            op_write(data,
+                     starting_bit_idx,
+                     end_shift,
+                     merge(op_read(data, starting_bit_idx, end_shift), bits));
         }
     }
 };
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 #include "neon-decl.h"
@@ -2077,6 +2078,124 @@ ForwardOpsImpl<uint64_t>::op_sub(uint64_t* const left,
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////
+// split block bloom filter
+
+//
+bool
+SplitBlockBloomFilterImpl::op_split_block_filter_test(
+    uint8_t* const __restrict bitmask,
+    const uint32_t* const __restrict blocks,
+    const size_t num_blocks,
+    const uint64_t* const __restrict hashes,
+    const size_t size) {
+    // blocks are picked at random, so the loads are issued ahead of the
+    //   probes to keep several cache misses in flight
+    constexpr size_t PREFETCH_DISTANCE = 16;
+    const auto block_of = [&](const size_t i) {
+        return blocks + split_block_bloom_filter_block(hashes[i], num_blocks) *
+                            SPLIT_BLOCK_BLOOM_FILTER_WORDS;
+    };
+    for (size_t i = 0; i < size && i < PREFETCH_DISTANCE; i++) {
+        __builtin_prefetch(block_of(i));
+    }
+
+    const uint32x4_t salt_lo = vld1q_u32(SPLIT_BLOCK_BLOOM_FILTER_SALT);
+    const uint32x4_t salt_hi = vld1q_u32(SPLIT_BLOCK_BLOOM_FILTER_SALT + 4);
+    const uint32x4_t ones = vdupq_n_u32(1);
+    for (size_t i = 0; i < size; i += 8) {
+        const size_t n = (size - i < 8) ? (size - i) : 8;
+        uint8_t result = 0;
+        for (size_t j = 0; j < n; j++) {
+            if (i + j + PREFETCH_DISTANCE < size) {
+                __builtin_prefetch(block_of(i + j + PREFETCH_DISTANCE));
+            }
+            const uint32_t* const block = block_of(i + j);
+            // one bit per 32 bit word, at the top 5 bits of key * salt
+            const uint32x4_t key =
+                vdupq_n_u32(static_cast<uint32_t>(hashes[i + j]));
+            const uint32x4_t shift_lo =
+                vshrq_n_u32(vmulq_u32(key, salt_lo), 27);
+            const uint32x4_t shift_hi =
+                vshrq_n_u32(vmulq_u32(key, salt_hi), 27);
+            const uint32x4_t mask_lo =
+                vshlq_u32(ones, vreinterpretq_s32_u32(shift_lo));
+            const uint32x4_t mask_hi =
+                vshlq_u32(ones, vreinterpretq_s32_u32(shift_hi));
+            // whether every word has its bit set
+            const uint32x4_t found =
+                vandq_u32(vtstq_u32(vld1q_u32(block), mask_lo),
+                          vtstq_u32(vld1q_u32(block + 4), mask_hi));
+            result |= static_cast<uint8_t>((vminvq_u32(found) != 0) << j);
+        }
+        bitmask[i / 8] = result;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// set bits extraction
+
+//
+bool
+ExtractBitsImpl::op_extract_bits(int64_t* const __restrict indices,
+                                 size_t* const __restrict count,
+                                 const uint8_t* const __restrict bitmask,
+                                 const size_t size,
+                                 const bool is_set,
+                                 const int64_t starting_idx) {
+    // every byte expands into the 8 positions of its set bits from a table,
+    //   all 8 are stored and the output advances by the number of set bits,
+    //   so 'indices' is never written past 'size' entries
+    int64_t* __restrict out = indices;
+    for (size_t i = 0; i < size; i += 64) {
+        const size_t nbytes = (size - i < 64) ? (size - i) / 8 : 8;
+        uint64_t word = 0;
+        std::memcpy(&word, bitmask + i / 8, nbytes);
+        if (!is_set) {
+            word = ~word;
+            if (nbytes < 8) {
+                word &= (uint64_t(1) << (nbytes * 8)) - 1;
+            }
+        }
+
+        for (size_t j = 0; word != 0; j++, word >>= 8) {
+            const uint8_t value = static_cast<uint8_t>(word);
+            if (value == 0) {
+                continue;
+            }
+
+            const uint16x8_t positions =
+                vmovl_u8(vld1_u8(SET_BITS_LOOKUP_TABLE.positions[value]));
+            const uint32x4_t lo = vmovl_u16(vget_low_u16(positions));
+            const uint32x4_t hi = vmovl_u16(vget_high_u16(positions));
+            const int64x2_t base =
+                vdupq_n_s64(starting_idx + int64_t(i + j * 8));
+            vst1q_s64(out,
+                      vaddq_s64(vreinterpretq_s64_u64(
+                                    vmovl_u32(vget_low_u32(lo))),
+                                base));
+            vst1q_s64(out + 2,
+                      vaddq_s64(vreinterpretq_s64_u64(
+                                    vmovl_u32(vget_high_u32(lo))),
+                                base));
+            vst1q_s64(out + 4,
+                      vaddq_s64(vreinterpretq_s64_u64(
+                                    vmovl_u32(vget_low_u32(hi))),
+                                base));
+            vst1q_s64(out + 6,
+                      vaddq_s64(vreinterpretq_s64_u64(
+                                    vmovl_u32(vget_high_u32(hi))),
+                                base));
+            out += __builtin_popcount(value);
+        }
+    }
+
+    *count = out - indices;
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////
 
 }  // namespace neon
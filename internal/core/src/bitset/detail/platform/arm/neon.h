@@ -79,6 +79,14 @@ struct VectorizedNeon {
     template <typename ElementT>
     static constexpr inline auto forward_op_sub =
         neon::ForwardOpsImpl<ElementT>::op_sub;
+
+    // probes a split block bloom filter
+    static constexpr inline auto op_split_block_filter_test =
+        neon::SplitBlockBloomFilterImpl::op_split_block_filter_test;
+
+    // extracts the indices of set bits
+    static constexpr inline auto op_extract_bits =
+        neon::ExtractBitsImpl::op_extract_bits;
 };
 
 }  // namespace arm
@@ -79,6 +79,17 @@ struct VectorizedSve {
     template <typename ElementT>
     static constexpr inline auto forward_op_sub =
         sve::ForwardOpsImpl<ElementT>::op_sub;
+
+    // no SVE kernel, the dynamic dispatch picks the NEON one on SVE machines
+    static inline bool
+    op_extract_bits(int64_t* const __restrict indices,
+                    size_t* const __restrict count,
+                    const uint8_t* const __restrict bitmask,
+                    const size_t size,
+                    const bool is_set,
+                    const int64_t starting_idx) {
+        return false;
+    }
 };
 
 }  // namespace arm
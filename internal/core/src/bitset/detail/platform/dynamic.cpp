@@ -16,8 +16,10 @@
 
 #include "dynamic.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <type_traits>
 
 #if defined(__x86_64__)
@@ -444,10 +446,71 @@ ALL_FORWARD_OPS(DISPATCH_FORWARD_OPS_OP_AND)
 
 }  // namespace dynamic
 
+/////////////////////////////////////////////////////////////////////////////
+// split block bloom filter
+
+using SplitBlockFilterTestFunc =
+    bool (*)(uint8_t* const __restrict bitmask,
+             const uint32_t* const __restrict blocks,
+             const size_t num_blocks,
+             const uint64_t* const __restrict hashes,
+             const size_t size);
+
+SplitBlockFilterTestFunc op_split_block_filter_test_ptr =
+    VectorizedRef::op_split_block_filter_test;
+
+//
+namespace dynamic {
+
+bool
+SplitBlockBloomFilterImpl::op_split_block_filter_test(
+    uint8_t* const __restrict bitmask,
+    const uint32_t* const __restrict blocks,
+    const size_t num_blocks,
+    const uint64_t* const __restrict hashes,
+    const size_t size) {
+    return op_split_block_filter_test_ptr(
+        bitmask, blocks, num_blocks, hashes, size);
+}
+
+}  // namespace dynamic
+
+/////////////////////////////////////////////////////////////////////////////
+// set bits extraction
+
+using ExtractBitsFunc = bool (*)(int64_t* const __restrict indices,
+                                 size_t* const __restrict count,
+                                 const uint8_t* const __restrict bitmask,
+                                 const size_t size,
+                                 const bool is_set,
+                                 const int64_t starting_idx);
+
+ExtractBitsFunc op_extract_bits_ptr = VectorizedRef::op_extract_bits;
+
+//
+namespace dynamic {
+
+bool
+ExtractBitsImpl::op_extract_bits(int64_t* const __restrict indices,
+                                 size_t* const __restrict count,
+                                 const uint8_t* const __restrict bitmask,
+                                 const size_t size,
+                                 const bool is_set,
+                                 const int64_t starting_idx) {
+    return op_extract_bits_ptr(
+        indices, count, bitmask, size, is_set, starting_idx);
+}
+
+}  // namespace dynamic
+
 }  // namespace detail
 }  // namespace bitset
 }  // namespace milvus
 
+// set where AVX-512 runs slower than AVX2, as on hosts that throttle
+// the frequency for it
+static std::atomic<bool> avx512_disabled{false};
+
 //
 static void
 init_dynamic_hook() {
@@ -456,7 +519,7 @@ init_dynamic_hook() {
 
 #if defined(__x86_64__)
     // AVX512 ?
-    if (cpu_support_avx512()) {
+    if (cpu_support_avx512() && !avx512_disabled.load()) {
 #define SET_OP_COMPARE_COLUMN_AVX512(TTYPE, UTYPE, OP)              \
     op_compare_column_##TTYPE##_##UTYPE##_##OP = VectorizedAvx512:: \
         template op_compare_column<TTYPE, UTYPE, CompareOpType::OP>;
@@ -528,6 +591,12 @@ init_dynamic_hook() {
 
         ALL_FORWARD_OPS(SET_FORWARD_OPS_AVX512)
 
+        // a block is 256 bits, the AVX2 kernel probes it in one load
+        op_split_block_filter_test_ptr =
+            VectorizedAvx2::op_split_block_filter_test;
+
+        op_extract_bits_ptr = VectorizedAvx512::op_extract_bits;
+
 #undef SET_OP_COMPARE_COLUMN_AVX512
 #undef SET_OP_COMPARE_VAL_AVX512
 #undef SET_OP_WITHIN_RANGE_COLUMN_AVX512
@@ -610,6 +679,11 @@ init_dynamic_hook() {
 
         ALL_FORWARD_OPS(SET_FORWARD_OPS_AVX2)
 
+        op_split_block_filter_test_ptr =
+            VectorizedAvx2::op_split_block_filter_test;
+
+        op_extract_bits_ptr = VectorizedAvx2::op_extract_bits;
+
 #undef SET_OP_COMPARE_COLUMN_AVX2
 #undef SET_OP_COMPARE_VAL_AVX2
 #undef SET_OP_WITHIN_RANGE_COLUMN_AVX2
@@ -695,6 +769,13 @@ init_dynamic_hook() {
 
         ALL_FORWARD_OPS(SET_FORWARD_OPS_SVE)
 
+        // a block is 256 bits, the NEON kernel probes it in two loads
+        op_split_block_filter_test_ptr =
+            VectorizedNeon::op_split_block_filter_test;
+
+        // SVE has no cheap way to turn bitmask bytes into predicates
+        op_extract_bits_ptr = VectorizedNeon::op_extract_bits;
+
 #undef SET_OP_COMPARE_COLUMN_SVE
 #undef SET_OP_COMPARE_VAL_SVE
 #undef SET_OP_WITHIN_RANGE_COLUMN_SVE
@@ -778,6 +859,11 @@ init_dynamic_hook() {
 
         ALL_FORWARD_OPS(SET_FORWARD_OPS_NEON)
 
+        op_split_block_filter_test_ptr =
+            VectorizedNeon::op_split_block_filter_test;
+
+        op_extract_bits_ptr = VectorizedNeon::op_extract_bits;
+
 #undef SET_OP_COMPARE_COLUMN_NEON
 #undef SET_OP_COMPARE_VAL_NEON
 #undef SET_OP_WITHIN_RANGE_COLUMN_NEON
@@ -803,3 +889,31 @@ static int init_dynamic_ = []() {
 
     return 0;
 }();
+
+namespace milvus {
+namespace bitset {
+namespace detail {
+
+std::vector<std::string>
+dynamic_instruction_sets() {
+    std::vector<std::string> instruction_sets;
+#if defined(__x86_64__)
+    if (x86::cpu_support_avx512()) {
+        instruction_sets.emplace_back("avx512");
+    }
+    if (x86::cpu_support_avx2()) {
+        instruction_sets.emplace_back("avx2");
+    }
+#endif
+    return instruction_sets;
+}
+
+void
+set_dynamic_instruction_set(const std::string& instruction_set) {
+    avx512_disabled.store(instruction_set != "avx512");
+    init_dynamic_hook();
+}
+
+}  // namespace detail
+}  // namespace bitset
+}  // namespace milvus
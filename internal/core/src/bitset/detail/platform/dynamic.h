@@ -18,6 +18,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "bitset/common.h"
 
@@ -296,6 +298,27 @@ ALL_FORWARD_TYPES_1(DECLARE_PARTIAL_FORWARD_OPS)
 
 #undef DECLARE_PARTIAL_FORWARD_OPS
 
+///////////////////////////////////////////////////////////////////////////
+struct SplitBlockBloomFilterImpl {
+    static bool
+    op_split_block_filter_test(uint8_t* const __restrict bitmask,
+                               const uint32_t* const __restrict blocks,
+                               const size_t num_blocks,
+                               const uint64_t* const __restrict hashes,
+                               const size_t size);
+};
+
+///////////////////////////////////////////////////////////////////////////
+struct ExtractBitsImpl {
+    static bool
+    op_extract_bits(int64_t* const __restrict indices,
+                    size_t* const __restrict count,
+                    const uint8_t* const __restrict bitmask,
+                    const size_t size,
+                    const bool is_set,
+                    const int64_t starting_idx);
+};
+
 ///////////////////////////////////////////////////////////////////////////
 
 #undef ALL_DATATYPES_1
@@ -438,8 +461,44 @@ struct VectorizedDynamic {
         return dynamic::ForwardOpsImpl<ElementT>::op_sub(
             left, right, start_left, start_right, size);
     }
+
+    // Sets a bit in a bitmask for every hash that may be in a split block
+    //   bloom filter of 'num_blocks' blocks.
+    static inline bool
+    op_split_block_filter_test(uint8_t* const __restrict bitmask,
+                               const uint32_t* const __restrict blocks,
+                               const size_t num_blocks,
+                               const uint64_t* const __restrict hashes,
+                               const size_t size) {
+        return dynamic::SplitBlockBloomFilterImpl::op_split_block_filter_test(
+            bitmask, blocks, num_blocks, hashes, size);
+    }
+
+    // Writes the indices of the bits of a bitmask set to is_set, plus
+    //   starting_idx, in increasing order and sets their number to count.
+    //   'indices' has room for 'size' entries, which may all be written.
+    // API requirement: size % 8 == 0
+    static inline bool
+    op_extract_bits(int64_t* const __restrict indices,
+                    size_t* const __restrict count,
+                    const uint8_t* const __restrict bitmask,
+                    const size_t size,
+                    const bool is_set,
+                    const int64_t starting_idx) {
+        return dynamic::ExtractBitsImpl::op_extract_bits(
+            indices, count, bitmask, size, is_set, starting_idx);
+    }
 };
 
+// The x86 instruction sets the hooks pick among on this cpu, widest first,
+// empty where the choice is fixed. The hooks start with the widest one.
+std::vector<std::string>
+dynamic_instruction_sets();
+
+// re-points the hooks at one of dynamic_instruction_sets()
+void
+set_dynamic_instruction_set(const std::string& instruction_set);
+
 }  // namespace detail
 }  // namespace bitset
 }  // namespace milvus
\ No newline at end of file
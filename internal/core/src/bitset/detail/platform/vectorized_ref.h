@@ -158,6 +158,31 @@ struct VectorizedRef {
                    const size_t size) {
         return false;
     }
+
+    // Sets a bit in a bitmask for every hash that may be in a split block
+    //   bloom filter of 'num_blocks' blocks.
+    static inline bool
+    op_split_block_filter_test(uint8_t* const __restrict bitmask,
+                               const uint32_t* const __restrict blocks,
+                               const size_t num_blocks,
+                               const uint64_t* const __restrict hashes,
+                               const size_t size) {
+        return false;
+    }
+
+    // Writes the indices of the bits of a bitmask set to is_set, plus
+    //   starting_idx, in increasing order and sets their number to count.
+    //   'indices' has room for 'size' entries, which may all be written.
+    // API requirement: size % 8 == 0
+    static inline bool
+    op_extract_bits(int64_t* const __restrict indices,
+                    size_t* const __restrict count,
+                    const uint8_t* const __restrict bitmask,
+                    const size_t size,
+                    const bool is_set,
+                    const int64_t starting_idx) {
+        return false;
+    }
 };
 
 }  // namespace detail
@@ -311,6 +311,31 @@ ALL_FORWARD_TYPES_1(DECLARE_PARTIAL_FORWARD_OPS)
 
 ///////////////////////////////////////////////////////////////////////////
 
+// probes a split block bloom filter for every hash, a bit per hash
+struct SplitBlockBloomFilterImpl {
+    static bool
+    op_split_block_filter_test(uint8_t* const __restrict bitmask,
+                               const uint32_t* const __restrict blocks,
+                               const size_t num_blocks,
+                               const uint64_t* const __restrict hashes,
+                               const size_t size);
+};
+
+///////////////////////////////////////////////////////////////////////////
+
+// writes the indices of the bits set to is_set, plus starting_idx
+struct ExtractBitsImpl {
+    static bool
+    op_extract_bits(int64_t* const __restrict indices,
+                    size_t* const __restrict count,
+                    const uint8_t* const __restrict bitmask,
+                    const size_t size,
+                    const bool is_set,
+                    const int64_t starting_idx);
+};
+
+///////////////////////////////////////////////////////////////////////////
+
 #undef ALL_DATATYPES_1
 #undef ALL_FORWARD_TYPES_1
 
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 #include "avx2-decl.h"
@@ -1898,6 +1899,107 @@ ForwardOpsImpl<uint64_t>::op_sub(uint64_t* const left,
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////
+// split block bloom filter
+
+//
+bool
+SplitBlockBloomFilterImpl::op_split_block_filter_test(
+    uint8_t* const __restrict bitmask,
+    const uint32_t* const __restrict blocks,
+    const size_t num_blocks,
+    const uint64_t* const __restrict hashes,
+    const size_t size) {
+    // blocks are picked at random, so the loads are issued ahead of the
+    //   probes to keep several cache misses in flight
+    constexpr size_t PREFETCH_DISTANCE = 16;
+    const auto block_of = [&](const size_t i) {
+        return blocks + split_block_bloom_filter_block(hashes[i], num_blocks) *
+                            SPLIT_BLOCK_BLOOM_FILTER_WORDS;
+    };
+    for (size_t i = 0; i < size && i < PREFETCH_DISTANCE; i++) {
+        _mm_prefetch((const char*)block_of(i), _MM_HINT_T0);
+    }
+
+    const __m256i salt =
+        _mm256_loadu_si256((const __m256i*)SPLIT_BLOCK_BLOOM_FILTER_SALT);
+    const __m256i ones = _mm256_set1_epi32(1);
+    for (size_t i = 0; i < size; i += 8) {
+        const size_t n = (size - i < 8) ? (size - i) : 8;
+        uint8_t result = 0;
+        for (size_t j = 0; j < n; j++) {
+            if (i + j + PREFETCH_DISTANCE < size) {
+                _mm_prefetch((const char*)block_of(i + j + PREFETCH_DISTANCE),
+                             _MM_HINT_T0);
+            }
+            const __m256i words =
+                _mm256_loadu_si256((const __m256i*)block_of(i + j));
+            // one bit per 32 bit word, at the top 5 bits of key * salt
+            const __m256i key =
+                _mm256_set1_epi32(static_cast<uint32_t>(hashes[i + j]));
+            const __m256i mask = _mm256_sllv_epi32(
+                ones, _mm256_srli_epi32(_mm256_mullo_epi32(key, salt), 27));
+            // whether all the mask bits are set in the block
+            const int found = _mm256_testc_si256(words, mask);
+            result |= static_cast<uint8_t>(found << j);
+        }
+        bitmask[i / 8] = result;
+    }
+
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////
+// set bits extraction
+
+//
+bool
+ExtractBitsImpl::op_extract_bits(int64_t* const __restrict indices,
+                                 size_t* const __restrict count,
+                                 const uint8_t* const __restrict bitmask,
+                                 const size_t size,
+                                 const bool is_set,
+                                 const int64_t starting_idx) {
+    // every byte expands into the 8 positions of its set bits from a table,
+    //   all 8 are stored and the output advances by the number of set bits,
+    //   so 'indices' is never written past 'size' entries
+    int64_t* __restrict out = indices;
+    for (size_t i = 0; i < size; i += 64) {
+        const size_t nbytes = (size - i < 64) ? (size - i) / 8 : 8;
+        uint64_t word = 0;
+        std::memcpy(&word, bitmask + i / 8, nbytes);
+        if (!is_set) {
+            word = ~word;
+            if (nbytes < 8) {
+                word &= (uint64_t(1) << (nbytes * 8)) - 1;
+            }
+        }
+
+        for (size_t j = 0; word != 0; j++, word >>= 8) {
+            const uint8_t value = static_cast<uint8_t>(word);
+            if (value == 0) {
+                continue;
+            }
+
+            const __m128i positions = _mm_loadl_epi64(
+                (const __m128i*)SET_BITS_LOOKUP_TABLE.positions[value]);
+            const __m256i base =
+                _mm256_set1_epi64x(starting_idx + int64_t(i + j * 8));
+            _mm256_storeu_si256(
+                (__m256i*)out,
+                _mm256_add_epi64(_mm256_cvtepu8_epi64(positions), base));
+            _mm256_storeu_si256(
+                (__m256i*)(out + 4),
+                _mm256_add_epi64(
+                    _mm256_cvtepu8_epi64(_mm_srli_si128(positions, 4)), base));
+            out += __builtin_popcount(value);
+        }
+    }
+
+    *count = out - indices;
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////
 
 }  // namespace avx2
@@ -79,6 +79,14 @@ struct VectorizedAvx2 {
     template <typename ElementT>
     static constexpr inline auto forward_op_sub =
         avx2::ForwardOpsImpl<ElementT>::op_sub;
+
+    // probes a split block bloom filter
+    static constexpr inline auto op_split_block_filter_test =
+        avx2::SplitBlockBloomFilterImpl::op_split_block_filter_test;
+
+    // extracts the indices of set bits
+    static constexpr inline auto op_extract_bits =
+        avx2::ExtractBitsImpl::op_extract_bits;
 };
 
 }  // namespace x86
@@ -311,6 +311,19 @@ ALL_FORWARD_TYPES_1(DECLARE_PARTIAL_FORWARD_OPS)
 
 ///////////////////////////////////////////////////////////////////////////
 
+// writes the indices of the bits set to is_set, plus starting_idx
+struct ExtractBitsImpl {
+    static bool
+    op_extract_bits(int64_t* const __restrict indices,
+                    size_t* const __restrict count,
+                    const uint8_t* const __restrict bitmask,
+                    const size_t size,
+                    const bool is_set,
+                    const int64_t starting_idx);
+};
+
+///////////////////////////////////////////////////////////////////////////
+
 #undef ALL_DATATYPES_1
 #undef ALL_FORWARD_TYPES_1
 
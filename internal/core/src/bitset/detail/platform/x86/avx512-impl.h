@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 #include "avx512-decl.h"
@@ -2180,6 +2181,48 @@ ForwardOpsImpl<uint64_t>::op_sub(uint64_t* const left,
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////
+// set bits extraction
+
+//
+bool
+ExtractBitsImpl::op_extract_bits(int64_t* const __restrict indices,
+                                 size_t* const __restrict count,
+                                 const uint8_t* const __restrict bitmask,
+                                 const size_t size,
+                                 const bool is_set,
+                                 const int64_t starting_idx) {
+    // VPCOMPRESSQ packs the indices of a byte of the bitmask, all 8 lanes
+    //   are stored and the output advances by the number of set bits, so
+    //   'indices' is never written past 'size' entries
+    int64_t* __restrict out = indices;
+    const __m512i iota = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+    for (size_t i = 0; i < size; i += 64) {
+        const size_t nbytes = (size - i < 64) ? (size - i) / 8 : 8;
+        uint64_t word = 0;
+        std::memcpy(&word, bitmask + i / 8, nbytes);
+        if (!is_set) {
+            word = ~word;
+            if (nbytes < 8) {
+                word &= (uint64_t(1) << (nbytes * 8)) - 1;
+            }
+        }
+
+        __m512i base = _mm512_add_epi64(
+            iota, _mm512_set1_epi64(starting_idx + int64_t(i)));
+        const __m512i eight = _mm512_set1_epi64(8);
+        for (; word != 0; word >>= 8) {
+            const __mmask8 value = static_cast<__mmask8>(word);
+            _mm512_storeu_si512(out, _mm512_maskz_compress_epi64(value, base));
+            out += __builtin_popcount(value);
+            base = _mm512_add_epi64(base, eight);
+        }
+    }
+
+    *count = out - indices;
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////
 
 }  // namespace avx512
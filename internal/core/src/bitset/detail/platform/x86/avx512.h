@@ -79,6 +79,10 @@ struct VectorizedAvx512 {
     template <typename ElementT>
     static constexpr inline auto forward_op_sub =
         avx512::ForwardOpsImpl<ElementT>::op_sub;
+
+    // extracts the indices of set bits
+    static constexpr inline auto op_extract_bits =
+        avx512::ExtractBitsImpl::op_extract_bits;
 };
 
 }  // namespace x86
@@ -16,6 +16,7 @@
 
 #include "index/VectorDiskIndex.h"
 
+#include "common/Common.h"
 #include "common/Tracer.h"
 #include "common/Utils.h"
 #include "config/ConfigKnowhere.h"
@@ -31,7 +32,12 @@
 #include "common/RangeSearchHelper.h"
 #include "clustering/types.h"
 #include "clustering/file_utils.h"
+#include "clustering/MiniBatchKmeans.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <random>
+#include <type_traits>
 
 namespace milvus::clustering {
 
@@ -230,7 +236,7 @@ KmeansClustering::IsDataSkew(
 template <typename T>
 void
 KmeansClustering::StreamingAssignandUpload(
-    knowhere::Cluster<knowhere::ClusterNode>& cluster_node,
+    const AssignFunc<T>& assign,
     const milvus::proto::clustering::AnalyzeInfo& config,
     const milvus::proto::clustering::ClusteringCentroidsStats& centroid_stats,
     const std::vector<
@@ -263,38 +269,57 @@ KmeansClustering::StreamingAssignandUpload(
     LOG_INFO(msg_header_ + "start upload cluster id mapping file");
     std::vector<int64_t> num_vectors_each_centroid(num_clusters, 0);
 
-    auto serializeIdMappingAndUpload = [&](const int64_t segment_id,
-                                           const milvus::proto::clustering::
-                                               ClusteringCentroidIdMappingStats&
-                                                   id_mapping_pb) {
-        auto byte_size = id_mapping_pb.ByteSizeLong();
-        std::unique_ptr<uint8_t[]> data =
-            std::make_unique<uint8_t[]>(byte_size);
-        id_mapping_pb.SerializeToArray(data.get(), byte_size);
-        AddClusteringResultFiles(
-            file_manager_->GetChunkManager().get(),
-            data.get(),
-            byte_size,
-            GetRemoteCentroidIdMappingObjectPrefix(segment_id) + "/" +
-                std::string(OFFSET_MAPPING_NAME),
-            remote_paths_to_size);
-        LOG_INFO(
-            msg_header_ +
-                "upload segment {} cluster id mapping file with size {} B done",
-            segment_id,
-            byte_size);
-    };
+    auto serializeIdMappingAndUpload =
+        [&](const int64_t segment_id,
+            const milvus::proto::clustering::ClusteringCentroidIdMappingStats&
+                id_mapping_pb,
+            std::unordered_map<std::string, int64_t>& paths_to_size) {
+            auto byte_size = id_mapping_pb.ByteSizeLong();
+            std::unique_ptr<uint8_t[]> data =
+                std::make_unique<uint8_t[]>(byte_size);
+            id_mapping_pb.SerializeToArray(data.get(), byte_size);
+            AddClusteringResultFiles(
+                file_manager_->GetChunkManager().get(),
+                data.get(),
+                byte_size,
+                GetRemoteCentroidIdMappingObjectPrefix(segment_id) + "/" +
+                    std::string(OFFSET_MAPPING_NAME),
+                paths_to_size);
+            LOG_INFO(msg_header_ +
+                         "upload segment {} cluster id mapping file with size "
+                         "{} B done",
+                     segment_id,
+                     byte_size);
+        };
+
+    // id mapping has been computed, just upload to remote
+    for (int64_t i = 0; i < trained_segments_num; i++) {
+        serializeIdMappingAndUpload(
+            segment_ids[i], id_mapping_stats[i], remote_paths_to_size);
+        for (int64_t j = 0; j < num_clusters; ++j) {
+            num_vectors_each_centroid[j] +=
+                id_mapping_stats[i].num_in_centroid(j);
+        }
+    }
 
-    for (size_t i = 0; i < segment_ids.size(); i++) {
-        int64_t segment_id = segment_ids[i];
-        // id mapping has been computed, just upload to remote
-        if (i < trained_segments_num) {
-            serializeIdMappingAndUpload(segment_id, id_mapping_stats[i]);
-            for (int64_t j = 0; j < num_clusters; ++j) {
-                num_vectors_each_centroid[j] +=
-                    id_mapping_stats[i].num_in_centroid(j);
-            }
-        } else {  // streaming download raw data, assign id mapping, then upload
+    // streaming download raw data, assign id mapping, then upload, a few
+    // segments at once: each holds its raw data until it is assigned
+    int64_t num_segments = segment_ids.size();
+    int64_t rows_to_assign = 0;
+    for (auto i = trained_segments_num; i < num_segments; i++) {
+        rows_to_assign += num_rows.at(segment_ids[i]);
+    }
+    auto num_workers = std::min<int64_t>(
+        std::max<int64_t>(KMEANS_ASSIGN_PARALLELISM.load(), 1),
+        num_segments - trained_segments_num);
+    std::atomic<int64_t> next_segment{trained_segments_num};
+    // guards the results merged by the workers
+    std::mutex mutex;
+    int64_t assigned_rows = 0;
+    auto assign_start = std::chrono::steady_clock::now();
+    index::ParallelRun(num_workers, [&](size_t) {
+        for (auto i = next_segment++; i < num_segments; i = next_segment++) {
+            int64_t segment_id = segment_ids[i];
             int64_t num_row = num_rows.at(segment_id);
             std::unique_ptr<T[]> buf = std::make_unique<T[]>(num_row * dim);
             int64_t offset = 0;
@@ -304,28 +329,36 @@ KmeansClustering::StreamingAssignandUpload(
                               insert_files.at(segment_id),
                               dim,
                               offset);
-            auto dataset = GenDataset(num_row, dim, buf.release());
-            dataset->SetIsOwner(true);
-            auto res = cluster_node.Assign(*dataset);
-            if (!res.has_value()) {
-                ThrowInfo(ErrorCode::UnexpectedError,
-                          fmt::format("failed to kmeans assign: {}: {}",
-                                      KnowhereStatusString(res.error()),
-                                      res.what()));
-            }
-            res.value()->SetIsOwner(true);
-            auto id_mapping =
-                reinterpret_cast<const uint32_t*>(res.value()->GetTensor());
+            std::vector<uint32_t> id_mapping(num_row);
+            assign(buf.get(), num_row, id_mapping.data());
+            buf.reset();
 
             auto id_mapping_pb = CentroidIdMappingToPB(
-                id_mapping, {segment_id}, 1, num_rows, num_clusters)[0];
+                id_mapping.data(), {segment_id}, 1, num_rows, num_clusters)[0];
+            std::unordered_map<std::string, int64_t> paths_to_size;
+            serializeIdMappingAndUpload(
+                segment_id, id_mapping_pb, paths_to_size);
+
+            std::lock_guard lock(mutex);
             for (int64_t j = 0; j < num_clusters; ++j) {
                 num_vectors_each_centroid[j] +=
                     id_mapping_pb.num_in_centroid(j);
             }
-            serializeIdMappingAndUpload(segment_id, id_mapping_pb);
+            remote_paths_to_size.insert(paths_to_size.begin(),
+                                        paths_to_size.end());
+            assigned_rows += num_row;
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - assign_start;
+            LOG_INFO(msg_header_ +
+                         "assigned {} of {} rows in {:.1f}s, about {:.1f}s "
+                         "left",
+                     assigned_rows,
+                     rows_to_assign,
+                     elapsed.count(),
+                     elapsed.count() * (rows_to_assign - assigned_rows) /
+                         assigned_rows);
         }
-    }
+    });
     if (IsDataSkew<T>(config, dim, num_vectors_each_centroid)) {
         LOG_INFO(msg_header_ + "data skew! skip clustering");
         // skip clustering, nothing takes affect
@@ -337,6 +370,123 @@ KmeansClustering::StreamingAssignandUpload(
     is_runned_ = true;
 }
 
+void
+KmeansClustering::TrainMiniBatch(MiniBatchKmeans& kmeans,
+                                 const std::vector<std::string>& files,
+                                 const int64_t train_num,
+                                 const int64_t dim,
+                                 const int64_t batch_rows) {
+    int64_t row_size = dim * sizeof(float);
+    int64_t batch_size = batch_rows * row_size;
+    std::vector<float> batch(batch_rows * dim);
+    auto batch_data = reinterpret_cast<uint8_t*>(batch.data());
+    int64_t batch_offset = 0;
+    int64_t remain_size = train_num * row_size;
+    auto start = std::chrono::steady_clock::now();
+    // the same file batching as FetchDataFiles bounds the pulled data
+    auto file_batch = size_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    for (size_t i = 0; i < files.size() && remain_size > 0; i += file_batch) {
+        Config config;
+        config[INSERT_FILES_KEY] = std::vector<std::string>(
+            files.begin() + i,
+            files.begin() + std::min(files.size(), i + file_batch));
+        auto field_datas = file_manager_->CacheRawDataToMemory(config);
+        for (auto& field_data : field_datas) {
+            auto src = static_cast<const uint8_t*>(field_data->Data());
+            auto size =
+                std::min<int64_t>(field_data->Size(), remain_size);
+            remain_size -= size;
+            // a row may span two batches of the copy, never two updates
+            while (size > 0) {
+                auto n = std::min(size, batch_size - batch_offset);
+                std::memcpy(batch_data + batch_offset, src, n);
+                batch_offset += n;
+                src += n;
+                size -= n;
+                if (batch_offset == batch_size) {
+                    kmeans.Update(batch.data(), batch_rows);
+                    batch_offset = 0;
+                }
+            }
+            field_data.reset();
+        }
+        if (kmeans.TrainedRows() > 0) {
+            std::chrono::duration<double> elapsed =
+                std::chrono::steady_clock::now() - start;
+            LOG_INFO(msg_header_ +
+                         "mini-batch kmeans trained {} of {} rows in "
+                         "{:.1f}s, about {:.1f}s left",
+                     kmeans.TrainedRows(),
+                     train_num,
+                     elapsed.count(),
+                     elapsed.count() * (train_num - kmeans.TrainedRows()) /
+                         kmeans.TrainedRows());
+        }
+    }
+    // the rows short of a batch, all of them for a sample under one batch
+    auto tail_rows = batch_offset / row_size;
+    if (tail_rows > 0) {
+        kmeans.Update(batch.data(), tail_rows);
+    }
+    AssertInfo(kmeans.Initialized(),
+               "mini-batch kmeans got no train data from {} files",
+               files.size());
+}
+
+void
+KmeansClustering::RunMiniBatch(
+    const milvus::proto::clustering::AnalyzeInfo& config,
+    const std::vector<int64_t>& segment_ids,
+    const std::map<int64_t, std::vector<std::string>>& insert_files,
+    const std::map<int64_t, int64_t>& num_rows,
+    const int64_t train_num,
+    const int64_t dim,
+    const int64_t num_clusters,
+    const int64_t mini_batch_size) {
+    knowhere::TimeRecorder rc(msg_header_ + "mini-batch kmeans clustering",
+                              2 /* log level: info */);
+    auto batch_rows = std::max<int64_t>(
+        mini_batch_size / (dim * sizeof(float)), num_clusters);
+    // every segment is assigned after training, so the sample is spread
+    // over all files whatever its size
+    std::vector<std::string> files;
+    for (auto segment_id : segment_ids) {
+        const auto& segment_files = insert_files.at(segment_id);
+        files.insert(files.end(), segment_files.begin(), segment_files.end());
+    }
+    std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
+    std::shuffle(files.begin(), files.end(), rng);
+    LOG_INFO(msg_header_ +
+                 "train data num: {}, dim: {}, num_clusters: {}, mini-batch "
+                 "rows: {}",
+             train_num,
+             dim,
+             num_clusters,
+             batch_rows);
+
+    MiniBatchKmeans kmeans(num_clusters, dim, rng());
+    TrainMiniBatch(kmeans, files, train_num, dim, batch_rows);
+    rc.RecordSection("clustering train done");
+
+    auto centroid_stats =
+        CentroidsToPB<float>(kmeans.Centroids(), num_clusters, dim);
+    StreamingAssignandUpload<float>(
+        [&](const float* data, int64_t num_row, uint32_t* ids) {
+            kmeans.Assign(data, num_row, ids);
+        },
+        config,
+        centroid_stats,
+        {},
+        segment_ids,
+        insert_files,
+        num_rows,
+        dim,
+        0,
+        num_clusters);
+    rc.RecordSection("clustering result upload done");
+    rc.ElapseFromBegin("clustering done");
+}
+
 template <typename T>
 void
 KmeansClustering::Run(const milvus::proto::clustering::AnalyzeInfo& config) {
@@ -363,19 +513,6 @@ KmeansClustering::Run(const milvus::proto::clustering::AnalyzeInfo& config) {
     auto max_cluster_size = config.max_cluster_size();
     AssertInfo(max_cluster_size > 0, "max cluster size must larger than 0");
 
-    auto cluster_node_obj =
-        knowhere::ClusterFactory::Instance().Create<T>(KMEANS_CLUSTER);
-    knowhere::Cluster<knowhere::ClusterNode> cluster_node;
-    if (cluster_node_obj.has_value()) {
-        cluster_node = std::move(cluster_node_obj.value());
-    } else {
-        auto err = cluster_node_obj.error();
-        if (err == knowhere::Status::invalid_cluster_error) {
-            throw SegcoreError(ErrorCode::ClusterSkip, cluster_node_obj.what());
-        }
-        throw SegcoreError(ErrorCode::KnowhereError, cluster_node_obj.what());
-    }
-
     size_t data_num = 0;
     std::vector<int64_t> segment_ids;
     for (auto& [segment_id, num_row_each_segment] : num_rows) {
@@ -407,6 +544,32 @@ KmeansClustering::Run(const milvus::proto::clustering::AnalyzeInfo& config) {
                            "sample data num less than num clusters");
     }
 
+    auto mini_batch_size = KMEANS_MINI_BATCH_SIZE.load();
+    if (std::is_same_v<T, float> && mini_batch_size > 0) {
+        RunMiniBatch(config,
+                     segment_ids,
+                     insert_files,
+                     num_rows,
+                     train_num,
+                     dim,
+                     num_clusters,
+                     mini_batch_size);
+        return;
+    }
+
+    auto cluster_node_obj =
+        knowhere::ClusterFactory::Instance().Create<T>(KMEANS_CLUSTER);
+    knowhere::Cluster<knowhere::ClusterNode> cluster_node;
+    if (cluster_node_obj.has_value()) {
+        cluster_node = std::move(cluster_node_obj.value());
+    } else {
+        auto err = cluster_node_obj.error();
+        if (err == knowhere::Status::invalid_cluster_error) {
+            throw SegcoreError(ErrorCode::ClusterSkip, cluster_node_obj.what());
+        }
+        throw SegcoreError(ErrorCode::KnowhereError, cluster_node_obj.what());
+    }
+
     size_t train_size_final = train_num * dim * sizeof(T);
     knowhere::TimeRecorder rc(msg_header_ + "kmeans clustering",
                               2 /* log level: info */);
@@ -469,7 +632,24 @@ KmeansClustering::Run(const milvus::proto::clustering::AnalyzeInfo& config) {
                                                   num_rows,
                                                   num_clusters);
     // upload
-    StreamingAssignandUpload<T>(cluster_node,
+    // knowhere parallelizes an assign itself, the workers fetch in parallel
+    std::mutex assign_mutex;
+    auto assign = [&](const T* data, int64_t num_row, uint32_t* ids) {
+        auto dataset = GenDataset(num_row, dim, data);
+        std::lock_guard lock(assign_mutex);
+        auto res = cluster_node.Assign(*dataset);
+        if (!res.has_value()) {
+            ThrowInfo(ErrorCode::UnexpectedError,
+                      fmt::format("failed to kmeans assign: {}: {}",
+                                  KnowhereStatusString(res.error()),
+                                  res.what()));
+        }
+        res.value()->SetIsOwner(true);
+        std::copy_n(reinterpret_cast<const uint32_t*>(res.value()->GetTensor()),
+                    num_row,
+                    ids);
+    };
+    StreamingAssignandUpload<T>(assign,
                                 config,
                                 centroid_stats,
                                 id_mapping_stats,
@@ -485,7 +665,7 @@ KmeansClustering::Run(const milvus::proto::clustering::AnalyzeInfo& config) {
 
 template void
 KmeansClustering::StreamingAssignandUpload<float>(
-    knowhere::Cluster<knowhere::ClusterNode>& cluster_node,
+    const AssignFunc<float>& assign,
     const milvus::proto::clustering::AnalyzeInfo& config,
     const milvus::proto::clustering::ClusteringCentroidsStats& centroid_stats,
     const std::vector<
@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "boost/filesystem/path.hpp"
+#include "clustering/MiniBatchKmeans.h"
 #include "storage/MemFileManagerImpl.h"
 #include "pb/clustering.pb.h"
 #include "knowhere/cluster/cluster_factory.h"
@@ -36,6 +39,11 @@ struct ClusteringResultMeta {
         id_mappings;  // id mapping result path/size for each segment
 };
 
+// writes the centroid id of each of the num_rows vectors of data to ids
+template <typename T>
+using AssignFunc =
+    std::function<void(const T* data, int64_t num_rows, uint32_t* ids)>;
+
 class KmeansClustering {
  public:
     explicit KmeansClustering(
@@ -97,7 +105,7 @@ class KmeansClustering {
     template <typename T>
     void
     StreamingAssignandUpload(
-        knowhere::Cluster<knowhere::ClusterNode>& cluster_node,
+        const AssignFunc<T>& assign,
         const milvus::proto::clustering::AnalyzeInfo& config,
         const milvus::proto::clustering::ClusteringCentroidsStats&
             centroid_stats,
@@ -111,6 +119,28 @@ class KmeansClustering {
         const int64_t trained_segments_num,
         const int64_t num_clusters);
 
+    // trains with KMEANS_MINI_BATCH_SIZE bytes of the sample in memory at a
+    // time instead of the whole sample, then assigns every segment
+    void
+    RunMiniBatch(
+        const milvus::proto::clustering::AnalyzeInfo& config,
+        const std::vector<int64_t>& segment_ids,
+        const std::map<int64_t, std::vector<std::string>>& insert_files,
+        const std::map<int64_t, int64_t>& num_rows,
+        const int64_t train_num,
+        const int64_t dim,
+        const int64_t num_clusters,
+        const int64_t mini_batch_size);
+
+    // streams the first train_num rows of files through kmeans, batch_rows
+    // rows at a time
+    void
+    TrainMiniBatch(MiniBatchKmeans& kmeans,
+                   const std::vector<std::string>& files,
+                   const int64_t train_num,
+                   const int64_t dim,
+                   const int64_t batch_rows);
+
     template <typename T>
     void
     FetchDataFiles(uint8_t* buf,
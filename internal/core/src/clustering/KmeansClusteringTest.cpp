@@ -16,6 +16,7 @@
 #include <numeric>
 #include <unordered_set>
 
+#include "common/Common.h"
 #include "common/Tracer.h"
 #include "common/EasyAssert.h"
 #include "index/InvertedIndexTantivy.h"
@@ -339,6 +340,26 @@ test_run() {
                                   config["num_clusters"],
                                   true);
     }
+    // mini-batch training streams the sample 64KB at a time
+    {
+        KMEANS_MINI_BATCH_SIZE.store(64L * 1024);
+        config["min_cluster_ratio"] = 0.01;
+        config[INSERT_FILES_KEY] = remote_files;
+        config["num_clusters"] = 8;
+        config["train_size"] = 1536L * 1024;  // 1.5MB
+        config["dim"] = dim;
+        config["num_rows"] = num_rows;
+        clusteringJob->Run<T>(transforConfigToPB(config));
+        KMEANS_MINI_BATCH_SIZE.store(DEFAULT_KMEANS_MINI_BATCH_SIZE);
+        CheckResultCorrectness<T>(clusteringJob,
+                                  cm,
+                                  segment_id,
+                                  segment_id2,
+                                  dim,
+                                  nb,
+                                  config["num_clusters"],
+                                  true);
+    }
 }
 
 TEST(MajorCompaction, Naive) {
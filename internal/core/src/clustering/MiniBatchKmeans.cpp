@@ -0,0 +1,166 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "clustering/MiniBatchKmeans.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "common/EasyAssert.h"
+#include "index/Utils.h"
+
+namespace milvus::clustering {
+
+namespace {
+
+// independent partial sums, so the loop below vectorizes
+constexpr int64_t kLanes = 8;
+
+// rows one assign task takes
+constexpr int64_t kAssignBatch = 4096;
+
+float
+InnerProduct(const float* left, const float* right, int64_t dim) {
+    float sums[kLanes] = {};
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        for (int64_t l = 0; l < kLanes; ++l) {
+            sums[l] += left[i + l] * right[i + l];
+        }
+    }
+    for (; i < dim; ++i) {
+        sums[0] += left[i] * right[i];
+    }
+    return std::accumulate(sums, sums + kLanes, 0.0f);
+}
+
+}  // namespace
+
+MiniBatchKmeans::MiniBatchKmeans(int64_t num_clusters,
+                                 int64_t dim,
+                                 uint64_t seed)
+    : num_clusters_(num_clusters),
+      dim_(dim),
+      rng_(seed),
+      counts_(num_clusters, 0) {
+    AssertInfo(num_clusters_ > 0, "num clusters must larger than 0");
+    AssertInfo(dim_ > 0, "dim must larger than 0");
+}
+
+void
+MiniBatchKmeans::UpdateNorms() {
+    norms_.resize(num_clusters_);
+    for (int64_t c = 0; c < num_clusters_; ++c) {
+        auto centroid = centroids_.data() + c * dim_;
+        norms_[c] = InnerProduct(centroid, centroid, dim_);
+    }
+}
+
+uint32_t
+MiniBatchKmeans::Nearest(const float* row) const {
+    // |row - c|^2 minus the |row|^2 every centroid shares
+    uint32_t nearest = 0;
+    auto min_distance = std::numeric_limits<float>::max();
+    for (int64_t c = 0; c < num_clusters_; ++c) {
+        auto centroid = centroids_.data() + c * dim_;
+        auto distance = norms_[c] - 2 * InnerProduct(row, centroid, dim_);
+        if (distance < min_distance) {
+            min_distance = distance;
+            nearest = c;
+        }
+    }
+    return nearest;
+}
+
+void
+MiniBatchKmeans::Assign(const float* data,
+                        int64_t num_rows,
+                        uint32_t* ids) const {
+    AssertInfo(Initialized(), "mini-batch kmeans assigns before training");
+    auto num_tasks = (num_rows + kAssignBatch - 1) / kAssignBatch;
+    index::ParallelRun(num_tasks, [&](size_t task) {
+        auto begin = static_cast<int64_t>(task) * kAssignBatch;
+        auto end = std::min(begin + kAssignBatch, num_rows);
+        for (auto i = begin; i < end; ++i) {
+            ids[i] = Nearest(data + i * dim_);
+        }
+    });
+}
+
+void
+MiniBatchKmeans::Update(const float* data, int64_t num_rows) {
+    if (!Initialized()) {
+        AssertInfo(num_rows >= num_clusters_,
+                   "first mini-batch of {} rows is less than {} clusters",
+                   num_rows,
+                   num_clusters_);
+        // k-means++: every next seed is a row drawn with probability
+        // proportional to its squared distance to the nearest seed so far
+        centroids_.resize(num_clusters_ * dim_);
+        std::vector<float> distances(num_rows,
+                                     std::numeric_limits<float>::max());
+        auto pick = static_cast<int64_t>(rng_() % num_rows);
+        for (int64_t c = 0; c < num_clusters_; ++c) {
+            auto centroid = centroids_.data() + c * dim_;
+            std::copy_n(data + pick * dim_, dim_, centroid);
+            if (c + 1 == num_clusters_) {
+                break;
+            }
+            double total = 0;
+            for (int64_t i = 0; i < num_rows; ++i) {
+                auto row = data + i * dim_;
+                auto distance = InnerProduct(row, row, dim_) -
+                                2 * InnerProduct(row, centroid, dim_) +
+                                InnerProduct(centroid, centroid, dim_);
+                distances[i] = std::min(distances[i], std::max(distance, 0.0f));
+                total += distances[i];
+            }
+            if (total <= 0) {
+                // fewer distinct rows than clusters, any row will do
+                pick = static_cast<int64_t>(rng_() % num_rows);
+                continue;
+            }
+            auto target =
+                std::uniform_real_distribution<double>(0, total)(rng_);
+            pick = num_rows - 1;
+            for (int64_t i = 0; i < num_rows; ++i) {
+                target -= distances[i];
+                if (target < 0) {
+                    pick = i;
+                    break;
+                }
+            }
+        }
+        UpdateNorms();
+    }
+
+    std::vector<uint32_t> ids(num_rows);
+    Assign(data, num_rows, ids.data());
+    for (int64_t i = 0; i < num_rows; ++i) {
+        auto c = ids[i];
+        auto eta = 1.0f / ++counts_[c];
+        auto row = data + i * dim_;
+        auto centroid = centroids_.data() + c * dim_;
+        for (int64_t d = 0; d < dim_; ++d) {
+            centroid[d] += eta * (row[d] - centroid[d]);
+        }
+    }
+    UpdateNorms();
+    trained_rows_ += num_rows;
+}
+
+}  // namespace milvus::clustering
@@ -0,0 +1,77 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace milvus::clustering {
+
+// Mini-batch k-means over L2 (Sculley, Web-Scale K-Means Clustering): a
+// batch is assigned to the current centroids, then every row of it moves
+// its centroid towards itself by 1 / (rows the centroid has taken so far).
+// Training holds one batch at a time however many rows stream through it.
+class MiniBatchKmeans {
+ public:
+    MiniBatchKmeans(int64_t num_clusters, int64_t dim, uint64_t seed);
+
+    // the first batch seeds the centroids with k-means++ over its rows, so
+    // it needs at least num_clusters rows
+    void
+    Update(const float* data, int64_t num_rows);
+
+    // the nearest centroid of every row
+    void
+    Assign(const float* data, int64_t num_rows, uint32_t* ids) const;
+
+    bool
+    Initialized() const {
+        return !norms_.empty();
+    }
+
+    // num_clusters * dim, valid once initialized
+    const float*
+    Centroids() const {
+        return centroids_.data();
+    }
+
+    int64_t
+    TrainedRows() const {
+        return trained_rows_;
+    }
+
+ private:
+    uint32_t
+    Nearest(const float* row) const;
+
+    void
+    UpdateNorms();
+
+ private:
+    const int64_t num_clusters_;
+    const int64_t dim_;
+    std::mt19937_64 rng_;
+    std::vector<float> centroids_;
+    // squared L2 norm of every centroid
+    std::vector<float> norms_;
+    // rows every centroid has taken
+    std::vector<int64_t> counts_;
+    int64_t trained_rows_ = 0;
+};
+
+}  // namespace milvus::clustering
@@ -0,0 +1,64 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "clustering/MiniBatchKmeans.h"
+
+using namespace milvus::clustering;
+
+TEST(MiniBatchKmeans, FindsSeparatedClusters) {
+    int64_t dim = 13;
+    int64_t num_clusters = 4;
+    int64_t num_rows = 4000;
+    std::default_random_engine er(42);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    // row i around the corner i % 4 of a square with side 10
+    std::vector<float> data(num_rows * dim);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        for (int64_t d = 0; d < dim; ++d) {
+            data[i * dim + d] = noise(er);
+        }
+        data[i * dim] += 10.0f * (i % 4 % 2);
+        data[i * dim + 1] += 10.0f * (i % 4 / 2);
+    }
+
+    MiniBatchKmeans kmeans(num_clusters, dim, 42);
+    EXPECT_FALSE(kmeans.Initialized());
+    EXPECT_ANY_THROW(kmeans.Update(data.data(), num_clusters - 1));
+    // batches of 100 rows, the first one seeds a centroid at every corner
+    for (int64_t begin = 0; begin < num_rows; begin += 100) {
+        kmeans.Update(data.data() + begin * dim, 100);
+    }
+    EXPECT_EQ(kmeans.TrainedRows(), num_rows);
+
+    std::vector<uint32_t> ids(num_rows);
+    kmeans.Assign(data.data(), num_rows, ids.data());
+    // a row lands on the centroid of its corner, whichever that is
+    std::vector<int64_t> corner_of(num_clusters, -1);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        auto& corner = corner_of[ids[i]];
+        if (corner == -1) {
+            corner = i % 4;
+        }
+        EXPECT_EQ(corner, i % 4);
+    }
+    auto centroids = kmeans.Centroids();
+    for (int64_t c = 0; c < num_clusters; ++c) {
+        ASSERT_NE(corner_of[c], -1);
+        EXPECT_NEAR(centroids[c * dim], 10.0f * (corner_of[c] % 2), 0.1);
+        EXPECT_NEAR(centroids[c * dim + 1], 10.0f * (corner_of[c] / 2), 0.1);
+    }
+}
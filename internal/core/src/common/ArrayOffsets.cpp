@@ -15,17 +15,63 @@
 // limitations under the License.
 
 #include "ArrayOffsets.h"
+
+#include <numeric>
+
 #include "segcore/SegmentInterface.h"
 #include "log/Log.h"
 #include "common/EasyAssert.h"
 
 namespace milvus {
 
+void
+ElementRowIndex::Append(int32_t row_id, int32_t num_elements) {
+    if (num_elements == 0) {
+        return;
+    }
+    // the bits of the words before a new word are all set by then, so its
+    // rank is final
+    auto add_words = [this](int64_t num_bits) {
+        while (static_cast<int64_t>(words_.size()) * 64 < num_bits) {
+            ranks_.push_back(words_.empty()
+                                 ? 0
+                                 : ranks_.back() +
+                                       __builtin_popcountll(words_.back()));
+            words_.push_back(0);
+        }
+    };
+    add_words(num_elements_ + 1);
+    words_[num_elements_ >> 6] |= uint64_t{1} << (num_elements_ & 63);
+    num_elements_ += num_elements;
+    add_words(num_elements_);
+    if (rows_are_ranks_ && row_id != num_marked_) {
+        rows_are_ranks_ = false;
+        rows_.resize(num_marked_);
+        std::iota(rows_.begin(), rows_.end(), 0);
+    }
+    if (!rows_are_ranks_) {
+        rows_.push_back(row_id);
+    }
+    ++num_marked_;
+}
+
+ArrayOffsetsSealed::ArrayOffsetsSealed(
+    std::vector<int32_t> row_to_element_start)
+    : row_to_element_start_(std::move(row_to_element_start)) {
+    AssertInfo(!row_to_element_start_.empty(),
+               "row_to_element_start must have at least one element");
+    for (int32_t row_id = 0; row_id < GetRowCount(); ++row_id) {
+        row_index_.Append(row_id,
+                          row_to_element_start_[row_id + 1] -
+                              row_to_element_start_[row_id]);
+    }
+}
+
 std::pair<int32_t, int32_t>
 ArrayOffsetsSealed::ElementIDToRowID(int32_t elem_id) const {
     assert(elem_id >= 0 && elem_id < GetTotalElementCount());
 
-    int32_t row_id = element_row_ids_[elem_id];
+    int32_t row_id = row_index_.RowOf(elem_id);
     // Compute elem_idx: elem_idx = elem_id - start_of_this_row
     int32_t elem_idx = elem_id - row_to_element_start_[row_id];
     return {row_id, elem_idx};
@@ -94,7 +140,7 @@ ArrayOffsetsSealed::RowBitsetToElementOffsets(
     }
 
     int64_t avg_elem_per_row =
-        static_cast<int64_t>(element_row_ids_.size()) /
+        GetTotalElementCount() /
         (static_cast<int64_t>(row_to_element_start_.size()) - 1);
 
     element_offsets.reserve(selected_rows * avg_elem_per_row);
@@ -124,7 +170,7 @@ ArrayOffsetsSealed::RowOffsetsToElementOffsets(
     int32_t row_count = GetRowCount();
     int64_t avg_elem_per_row =
         (row_count > 0)
-            ? static_cast<int64_t>(element_row_ids_.size()) / row_count
+            ? GetTotalElementCount() / row_count
             : 1;
     element_offsets.reserve(row_offsets.size() * avg_elem_per_row);
     for (auto row_id : row_offsets) {
@@ -157,11 +203,9 @@ ArrayOffsetsSealed::BuildFromSegment(const void* segment,
     FieldId field_id = field_meta.get_id();
     auto data_type = field_meta.get_data_type();
 
-    std::vector<int32_t> element_row_ids;
     // Size is row_count + 1, last element stores total_element_count
     std::vector<int32_t> row_to_element_start(row_count + 1);
-    // Pre-reserve element_row_ids assuming average 4 elements per row
-    element_row_ids.reserve(row_count * 4);
+    int32_t total_elements = 0;
 
     auto temp_op_ctx = std::make_unique<OpContext>();
     auto op_ctx_ptr = temp_op_ctx.get();
@@ -182,12 +226,8 @@ ArrayOffsetsSealed::BuildFromSegment(const void* segment,
                 }
 
                 // Record the start position for this row
-                row_to_element_start[current_row_id] = element_row_ids.size();
-
-                // Add row_id for each element (elem_idx computed on access)
-                for (int32_t j = 0; j < array_len; ++j) {
-                    element_row_ids.emplace_back(current_row_id);
-                }
+                row_to_element_start[current_row_id] = total_elements;
+                total_elements += array_len;
 
                 current_row_id++;
             }
@@ -205,12 +245,8 @@ ArrayOffsetsSealed::BuildFromSegment(const void* segment,
                 }
 
                 // Record the start position for this row
-                row_to_element_start[current_row_id] = element_row_ids.size();
-
-                // Add row_id for each element (elem_idx computed on access)
-                for (int32_t j = 0; j < array_len; ++j) {
-                    element_row_ids.emplace_back(current_row_id);
-                }
+                row_to_element_start[current_row_id] = total_elements;
+                total_elements += array_len;
 
                 current_row_id++;
             }
@@ -218,15 +254,13 @@ ArrayOffsetsSealed::BuildFromSegment(const void* segment,
     }
 
     // Store total element count as the last entry
-    row_to_element_start[row_count] = element_row_ids.size();
+    row_to_element_start[row_count] = total_elements;
 
     AssertInfo(current_row_id == row_count,
                "Row count mismatch: expected {}, got {}",
                row_count,
                current_row_id);
 
-    int64_t total_elements = element_row_ids.size();
-
     LOG_INFO(
         "ArrayOffsetsSealed::BuildFromSegment: struct_name='{}', "
         "field_id={}, row_count={}, total_elements={}",
@@ -236,8 +270,9 @@ ArrayOffsetsSealed::BuildFromSegment(const void* segment,
         total_elements);
 
     auto result = std::make_shared<ArrayOffsetsSealed>(
-        std::move(element_row_ids), std::move(row_to_element_start));
-    result->resource_size_ = 4 * (row_count + 1) + 4 * total_elements;
+        std::move(row_to_element_start));
+    result->resource_size_ =
+        4 * (row_count + 1) + result->row_index_.MemorySize();
     cachinglayer::Manager::GetInstance().ChargeLoadedResource(
         cachinglayer::ResourceUsage{result->resource_size_, 0});
     return result;
@@ -246,9 +281,8 @@ ArrayOffsetsSealed::BuildFromSegment(const void* segment,
 std::pair<int32_t, int32_t>
 ArrayOffsetsGrowing::ElementIDToRowID(int32_t elem_id) const {
     std::shared_lock lock(mutex_);
-    assert(elem_id >= 0 &&
-           elem_id < static_cast<int32_t>(element_row_ids_.size()));
-    int32_t row_id = element_row_ids_[elem_id];
+    assert(elem_id >= 0 && elem_id < row_index_.ElementCount());
+    int32_t row_id = row_index_.RowOf(elem_id);
     // Compute elem_idx: elem_idx = elem_id - start_of_this_row
     int32_t elem_idx = elem_id - row_to_element_start_[row_id];
     return {row_id, elem_idx};
@@ -288,12 +322,14 @@ ArrayOffsetsGrowing::RowBitsetToElementBitset(
     TargetBitmap element_bitset(element_count);
     TargetBitmap valid_element_bitset(element_count);
 
-    for (int64_t elem_id = element_start; elem_id < element_end; ++elem_id) {
-        auto row_id = element_row_ids_[elem_id];
-        int64_t bitset_idx = row_id - row_start;
-        element_bitset[elem_id - element_start] = row_bitset[bitset_idx];
-        valid_element_bitset[elem_id - element_start] =
-            valid_row_bitset[bitset_idx];
+    for (int64_t i = 0; i < row_count; ++i) {
+        int64_t row_id = row_start + i;
+        int64_t start = row_to_element_start_[row_id] - element_start;
+        int64_t end = row_to_element_start_[row_id + 1] - element_start;
+        if (start < end) {
+            element_bitset.set(start, end - start, row_bitset[i]);
+            valid_element_bitset.set(start, end - start, valid_row_bitset[i]);
+        }
     }
 
     return {std::move(element_bitset), std::move(valid_element_bitset)};
@@ -318,7 +354,7 @@ ArrayOffsetsGrowing::RowBitsetToElementOffsets(
         return element_offsets;
     }
     int64_t avg_elem_per_row =
-        static_cast<int64_t>(element_row_ids_.size()) /
+        row_index_.ElementCount() /
         (static_cast<int64_t>(row_to_element_start_.size()) - 1);
     element_offsets.reserve(selected_rows * avg_elem_per_row);
 
@@ -348,8 +384,7 @@ ArrayOffsetsGrowing::RowOffsetsToElementOffsets(
 
     int64_t avg_elem_per_row =
         (committed_row_count_ > 0)
-            ? static_cast<int64_t>(element_row_ids_.size()) /
-                  committed_row_count_
+            ? row_index_.ElementCount() / committed_row_count_
             : 1;
     element_offsets.reserve(row_offsets.size() * avg_elem_per_row);
 
@@ -373,13 +408,6 @@ ArrayOffsetsGrowing::Insert(int64_t row_id_start,
 
     row_to_element_start_.reserve(row_id_start + count + 1);
 
-    // Estimate total elements needed and reserve capacity
-    int64_t total_elements = 0;
-    for (int64_t i = 0; i < count; ++i) {
-        total_elements += array_lengths[i];
-    }
-    element_row_ids_.reserve(element_row_ids_.size() + total_elements);
-
     int32_t original_committed_count = committed_row_count_;
 
     for (int64_t i = 0; i < count; ++i) {
@@ -392,15 +420,12 @@ ArrayOffsetsGrowing::Insert(int64_t row_id_start,
             if (row_to_element_start_.size() >
                 static_cast<size_t>(committed_row_count_)) {
                 row_to_element_start_[committed_row_count_] =
-                    element_row_ids_.size();
+                    row_index_.ElementCount();
             } else {
-                row_to_element_start_.push_back(element_row_ids_.size());
+                row_to_element_start_.push_back(row_index_.ElementCount());
             }
 
-            // Add row_id for each element (elem_idx computed on access)
-            for (int32_t j = 0; j < array_len; ++j) {
-                element_row_ids_.emplace_back(row_id);
-            }
+            row_index_.Append(row_id, array_len);
 
             committed_row_count_++;
         } else {
@@ -414,10 +439,10 @@ ArrayOffsetsGrowing::Insert(int64_t row_id_start,
     if (committed_row_count_ > original_committed_count) {
         if (row_to_element_start_.size() ==
             static_cast<size_t>(committed_row_count_)) {
-            row_to_element_start_.push_back(element_row_ids_.size());
+            row_to_element_start_.push_back(row_index_.ElementCount());
         } else {
             row_to_element_start_[committed_row_count_] =
-                element_row_ids_.size();
+                row_index_.ElementCount();
         }
     }
 }
@@ -436,14 +461,13 @@ ArrayOffsetsGrowing::DrainPendingRows() {
         if (row_to_element_start_.size() >
             static_cast<size_t>(committed_row_count_)) {
             row_to_element_start_[committed_row_count_] =
-                element_row_ids_.size();
+                row_index_.ElementCount();
         } else {
-            row_to_element_start_.push_back(element_row_ids_.size());
+            row_to_element_start_.push_back(row_index_.ElementCount());
         }
 
-        for (int32_t j = 0; j < pending.array_len; ++j) {
-            element_row_ids_.emplace_back(static_cast<int32_t>(pending.row_id));
-        }
+        row_index_.Append(static_cast<int32_t>(pending.row_id),
+                          pending.array_len);
 
         committed_row_count_++;
 
@@ -28,6 +28,68 @@
 
 namespace milvus {
 
+// Maps element ids to the rows holding them in about 1.5 bits an element
+// instead of a row id each: a bit marks the first element of every row with
+// elements, and the rank of the last marked bit at or before an element is
+// its row among those rows. Rows are appended in order.
+class ElementRowIndex {
+ public:
+    void
+    Append(int32_t row_id, int32_t num_elements);
+
+    int64_t
+    ElementCount() const {
+        return num_elements_;
+    }
+
+    int32_t
+    RowOf(int32_t elem_id) const {
+        auto word = elem_id >> 6;
+        auto mask = ~uint64_t{0} >> (63 - (elem_id & 63));
+        int32_t rank =
+            ranks_[word] + __builtin_popcountll(words_[word] & mask) - 1;
+        return rows_are_ranks_ ? rank : rows_[rank];
+    }
+
+    // the row and the index in it of n elements, row_starts[r] the first
+    // element of row r. Negative ids give INVALID_SEG_OFFSET and -1.
+    template <typename T>
+    void
+    RowsOf(const T* elem_ids,
+           int64_t n,
+           const int32_t* row_starts,
+           int64_t* row_ids,
+           int32_t* elem_indices) const {
+        for (int64_t i = 0; i < n; ++i) {
+            if (elem_ids[i] < 0) {
+                row_ids[i] = INVALID_SEG_OFFSET;
+                elem_indices[i] = -1;
+                continue;
+            }
+            auto row_id = RowOf(elem_ids[i]);
+            row_ids[i] = row_id;
+            elem_indices[i] = elem_ids[i] - row_starts[row_id];
+        }
+    }
+
+    size_t
+    MemorySize() const {
+        return words_.capacity() * sizeof(uint64_t) +
+               (ranks_.capacity() + rows_.capacity()) * sizeof(int32_t);
+    }
+
+ private:
+    std::vector<uint64_t> words_;
+    // the marked bits in the words before each word
+    std::vector<int32_t> ranks_;
+    // the row of every marked bit, kept once a row without elements sets
+    // the rank and the row apart
+    std::vector<int32_t> rows_;
+    bool rows_are_ranks_ = true;
+    int64_t num_elements_ = 0;
+    int32_t num_marked_ = 0;
+};
+
 class IArrayOffsets {
  public:
     virtual ~IArrayOffsets() = default;
@@ -44,6 +106,21 @@ class IArrayOffsets {
     virtual std::pair<int32_t, int32_t>
     ElementIDToRowID(int32_t elem_id) const = 0;
 
+    // ElementIDToRowID of n element ids at once, which a growing segment
+    // serves under one lock. Negative ids, INVALID_SEG_OFFSET among them,
+    // give INVALID_SEG_OFFSET and -1.
+    virtual void
+    ElementIDsToRowIDs(const int32_t* elem_ids,
+                       int64_t n,
+                       int64_t* row_ids,
+                       int32_t* elem_indices) const = 0;
+
+    virtual void
+    ElementIDsToRowIDs(const int64_t* elem_ids,
+                       int64_t n,
+                       int64_t* row_ids,
+                       int32_t* elem_indices) const = 0;
+
     // Convert row ID to element ID range
     // elements with id in [ret.first, ret.last) belong to row_id
     virtual std::pair<int32_t, int32_t>
@@ -74,16 +151,10 @@ class ArrayOffsetsSealed : public IArrayOffsets {
     friend class ArrayOffsetsTest;
 
  public:
-    ArrayOffsetsSealed() : element_row_ids_(), row_to_element_start_({0}) {
+    ArrayOffsetsSealed() : row_to_element_start_({0}) {
     }
 
-    ArrayOffsetsSealed(std::vector<int32_t> element_row_ids,
-                       std::vector<int32_t> row_to_element_start)
-        : element_row_ids_(std::move(element_row_ids)),
-          row_to_element_start_(std::move(row_to_element_start)) {
-        AssertInfo(!row_to_element_start_.empty(),
-                   "row_to_element_start must have at least one element");
-    }
+    explicit ArrayOffsetsSealed(std::vector<int32_t> row_to_element_start);
 
     ~ArrayOffsetsSealed() {
         cachinglayer::Manager::GetInstance().RefundLoadedResource(
@@ -97,12 +168,30 @@ class ArrayOffsetsSealed : public IArrayOffsets {
 
     int64_t
     GetTotalElementCount() const override {
-        return element_row_ids_.size();
+        return row_index_.ElementCount();
     }
 
     std::pair<int32_t, int32_t>
     ElementIDToRowID(int32_t elem_id) const override;
 
+    void
+    ElementIDsToRowIDs(const int32_t* elem_ids,
+                       int64_t n,
+                       int64_t* row_ids,
+                       int32_t* elem_indices) const override {
+        row_index_.RowsOf(
+            elem_ids, n, row_to_element_start_.data(), row_ids, elem_indices);
+    }
+
+    void
+    ElementIDsToRowIDs(const int64_t* elem_ids,
+                       int64_t n,
+                       int64_t* row_ids,
+                       int32_t* elem_indices) const override {
+        row_index_.RowsOf(
+            elem_ids, n, row_to_element_start_.data(), row_ids, elem_indices);
+    }
+
     std::pair<int32_t, int32_t>
     ElementIDRangeOfRow(int32_t row_id) const override;
 
@@ -123,8 +212,8 @@ class ArrayOffsetsSealed : public IArrayOffsets {
     BuildFromSegment(const void* segment, const FieldMeta& field_meta);
 
  private:
-    const std::vector<int32_t> element_row_ids_;
     const std::vector<int32_t> row_to_element_start_;
+    ElementRowIndex row_index_;
     int64_t resource_size_{0};
 };
 
@@ -144,12 +233,32 @@ class ArrayOffsetsGrowing : public IArrayOffsets {
     int64_t
     GetTotalElementCount() const override {
         std::shared_lock lock(mutex_);
-        return element_row_ids_.size();
+        return row_index_.ElementCount();
     }
 
     std::pair<int32_t, int32_t>
     ElementIDToRowID(int32_t elem_id) const override;
 
+    void
+    ElementIDsToRowIDs(const int32_t* elem_ids,
+                       int64_t n,
+                       int64_t* row_ids,
+                       int32_t* elem_indices) const override {
+        std::shared_lock lock(mutex_);
+        row_index_.RowsOf(
+            elem_ids, n, row_to_element_start_.data(), row_ids, elem_indices);
+    }
+
+    void
+    ElementIDsToRowIDs(const int64_t* elem_ids,
+                       int64_t n,
+                       int64_t* row_ids,
+                       int32_t* elem_indices) const override {
+        std::shared_lock lock(mutex_);
+        row_index_.RowsOf(
+            elem_ids, n, row_to_element_start_.data(), row_ids, elem_indices);
+    }
+
     std::pair<int32_t, int32_t>
     ElementIDRangeOfRow(int32_t row_id) const override;
 
@@ -176,7 +285,7 @@ class ArrayOffsetsGrowing : public IArrayOffsets {
     DrainPendingRows();
 
  private:
-    std::vector<int32_t> element_row_ids_;
+    ElementRowIndex row_index_;
 
     std::vector<int32_t> row_to_element_start_;
 
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <numeric>
 #include <thread>
 #include <vector>
 
@@ -35,8 +36,7 @@ TEST_F(ArrayOffsetsTest, SealedBasic) {
     // row 1: 3 elements (elem 2, 3, 4)
     // row 2: 1 element  (elem 5)
     ArrayOffsetsSealed offsets(
-        {0, 0, 1, 1, 1, 2},  // element_row_ids
-        {0, 2, 5, 6}         // row_to_element_start (size = row_count + 1)
+        {0, 2, 5, 6}  // row_to_element_start (size = row_count + 1)
     );
 
     // Test GetRowCount
@@ -97,8 +97,7 @@ TEST_F(ArrayOffsetsTest, SealedBasic) {
 }
 
 TEST_F(ArrayOffsetsTest, SealedRowBitsetToElementBitset) {
-    ArrayOffsetsSealed offsets({0, 0, 1, 1, 1, 2},  // element_row_ids
-                               {0, 2, 5, 6}         // row_to_element_start
+    ArrayOffsetsSealed offsets({0, 2, 5, 6}  // row_to_element_start
     );
 
     // row_bitset: row 0 = true, row 1 = false, row 2 = true
@@ -131,8 +130,7 @@ TEST_F(ArrayOffsetsTest, SealedRowBitsetToElementBitset) {
 TEST_F(ArrayOffsetsTest, SealedEmptyArrays) {
     // Test with some rows having empty arrays
     // row 1 and row 3 are empty
-    ArrayOffsetsSealed offsets({0, 0, 2, 2, 2},  // element_row_ids
-                               {0, 2, 2, 5, 5}   // row_to_element_start
+    ArrayOffsetsSealed offsets({0, 2, 2, 5, 5}  // row_to_element_start
     );
 
     EXPECT_EQ(offsets.GetRowCount(), 4);
@@ -425,3 +423,55 @@ TEST_F(ArrayOffsetsTest, LargeArrayLength) {
         EXPECT_EQ(elem_idx, 9999);
     }
 }
+
+TEST_F(ArrayOffsetsTest, ElementIDsToRowIDsMatchesEveryElement) {
+    // empty rows first, between and last, and rows across 64 element words
+    std::vector<int32_t> lens = {0, 0, 3, 70, 0, 1, 64, 0, 0, 130, 2, 0};
+    std::vector<int32_t> starts = {0};
+    std::vector<int64_t> expected_rows;
+    std::vector<int32_t> expected_indices;
+    for (int32_t row = 0; row < static_cast<int32_t>(lens.size()); ++row) {
+        for (int32_t i = 0; i < lens[row]; ++i) {
+            expected_rows.push_back(row);
+            expected_indices.push_back(i);
+        }
+        starts.push_back(starts.back() + lens[row]);
+    }
+    ArrayOffsetsSealed sealed(starts);
+    ArrayOffsetsGrowing growing;
+    // out of order, as concurrent inserts may arrive
+    growing.Insert(6, lens.data() + 6, lens.size() - 6);
+    growing.Insert(0, lens.data(), 6);
+
+    int64_t num_elements = expected_rows.size();
+    std::vector<int64_t> elem_ids(num_elements);
+    std::iota(elem_ids.begin(), elem_ids.end(), 0);
+    elem_ids.push_back(INVALID_SEG_OFFSET);
+    std::vector<int32_t> elem_ids32(elem_ids.begin(), elem_ids.end());
+    for (const IArrayOffsets* offsets :
+         {static_cast<const IArrayOffsets*>(&sealed),
+          static_cast<const IArrayOffsets*>(&growing)}) {
+        ASSERT_EQ(offsets->GetTotalElementCount(), num_elements);
+        std::vector<int64_t> rows(elem_ids.size());
+        std::vector<int32_t> indices(elem_ids.size());
+        offsets->ElementIDsToRowIDs(
+            elem_ids.data(), elem_ids.size(), rows.data(), indices.data());
+        std::vector<int64_t> rows32(elem_ids.size());
+        std::vector<int32_t> indices32(elem_ids.size());
+        offsets->ElementIDsToRowIDs(elem_ids32.data(),
+                                    elem_ids32.size(),
+                                    rows32.data(),
+                                    indices32.data());
+        for (int64_t i = 0; i < num_elements; ++i) {
+            EXPECT_EQ(rows[i], expected_rows[i]) << i;
+            EXPECT_EQ(indices[i], expected_indices[i]) << i;
+            EXPECT_EQ(rows32[i], expected_rows[i]) << i;
+            EXPECT_EQ(indices32[i], expected_indices[i]) << i;
+            auto [row_id, elem_idx] = offsets->ElementIDToRowID(i);
+            EXPECT_EQ(row_id, expected_rows[i]);
+            EXPECT_EQ(elem_idx, expected_indices[i]);
+        }
+        EXPECT_EQ(rows.back(), INVALID_SEG_OFFSET);
+        EXPECT_EQ(indices.back(), -1);
+    }
+}
@@ -20,6 +20,10 @@
 #include <limits>
 #include <type_traits>
 
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
 namespace milvus {
 namespace bits {
 
@@ -468,5 +472,41 @@ extractBits(T a, T mask) {
 #endif
 }
 #endif
+
+/// Deposit the contiguous low bits of integer 'a' at the bit locations
+/// specified by 'mask' in return value; the remaining bits in return value
+/// are set to zero. The inverse of extractBits.
+template <typename T>
+inline T
+depositBits(T a, T mask);
+
+#ifdef __BMI2__
+template <>
+inline uint32_t
+depositBits(uint32_t a, uint32_t mask) {
+    return _pdep_u32(a, mask);
+}
+template <>
+inline uint64_t
+depositBits(uint64_t a, uint64_t mask) {
+    return _pdep_u64(a, mask);
+}
+#else
+template <typename T>
+inline T
+depositBits(T a, T mask) {
+    static_assert(std::is_unsigned_v<T>, "depositBits requires unsigned type");
+
+    T dst = 0;
+    for (; mask != 0; mask &= (mask - 1)) {
+        if (a & 1) {
+            // lowest set bit of mask
+            dst |= mask & (~mask + 1);
+        }
+        a >>= 1;
+    }
+    return dst;
+}
+#endif
 }  // namespace bits
 }  // namespace milvus
\ No newline at end of file
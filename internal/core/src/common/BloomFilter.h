@@ -19,7 +19,11 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <stdexcept>
+#include <boost/align/aligned_allocator.hpp>
+#include "bitset/common.h"
+#include "bitset/detail/platform/dynamic.h"
 #include "log/Log.h"
 #include "xxhash.h"  // from xxhash/xxhash
 
@@ -28,13 +32,48 @@ namespace milvus {
 const std::string UNSUPPORTED_BF_NAME = "Unsupported BloomFilter";
 const std::string BLOCKED_BF_NAME = "BlockedBloomFilter";
 const std::string ALWAYS_TRUE_BF_NAME = "AlwaysTrueBloomFilter";
+const std::string SPLIT_BLOCK_BF_NAME = "SplitBlockBloomFilter";
 
 enum class BFType {
     Unsupported = 0,
     AlwaysTrue,  // empty bloom filter
     Blocked,
+    SplitBlock,  // one 256 bit block per key, as in Parquet
 };
 
+// Binary layout of a bloom filter: a 64 byte header followed by the bit
+// array as little endian uint64 words. The words start 64 bytes into the
+// blob, so a blob placed at a 64 byte aligned offset of an mmap-ed file can
+// be probed in place.
+constexpr uint32_t BLOOM_FILTER_BINARY_MAGIC = 0x3146424d;  // "MBF1"
+constexpr uint16_t BLOOM_FILTER_BINARY_VERSION = 1;
+constexpr size_t BLOOM_FILTER_BINARY_ALIGNMENT = 64;
+
+struct BloomFilterBinaryHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t type;  // BFType
+    uint8_t reserved0;
+    uint32_t k;
+    uint32_t reserved1;
+    uint64_t num_bits;
+    uint64_t num_words;
+    uint8_t reserved2[32];
+};
+static_assert(sizeof(BloomFilterBinaryHeader) ==
+                  BLOOM_FILTER_BINARY_ALIGNMENT,
+              "bloom filter words must start 64 byte aligned");
+
+inline bool
+IsBloomFilterBinary(const uint8_t* data, size_t size) {
+    uint32_t magic = 0;
+    if (size < sizeof(magic)) {
+        return false;
+    }
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == BLOOM_FILTER_BINARY_MAGIC;
+}
+
 inline std::string
 BFTypeToString(BFType type) {
     switch (type) {
@@ -42,6 +81,8 @@ BFTypeToString(BFType type) {
             return BLOCKED_BF_NAME;
         case BFType::AlwaysTrue:
             return ALWAYS_TRUE_BF_NAME;
+        case BFType::SplitBlock:
+            return SPLIT_BLOCK_BF_NAME;
         default:
             return UNSUPPORTED_BF_NAME;
     }
@@ -55,6 +96,9 @@ StringToBFType(std::string_view name) {
     if (name == ALWAYS_TRUE_BF_NAME) {
         return BFType::AlwaysTrue;
     }
+    if (name == SPLIT_BLOCK_BF_NAME) {
+        return BFType::SplitBlock;
+    }
     return BFType::Unsupported;
 }
 
@@ -92,6 +136,27 @@ class BloomFilter {
 
     virtual nlohmann::json
     ToJson() const = 0;
+
+    // Appends the binary layout of the filter to 'out'.
+    virtual void
+    Serialize(std::string& out) const = 0;
+
+ protected:
+    static void
+    AppendBinaryHeader(std::string& out,
+                       BFType type,
+                       uint32_t k,
+                       uint64_t num_bits,
+                       uint64_t num_words) {
+        BloomFilterBinaryHeader header{};
+        header.magic = BLOOM_FILTER_BINARY_MAGIC;
+        header.version = BLOOM_FILTER_BINARY_VERSION;
+        header.type = static_cast<uint8_t>(type);
+        header.k = k;
+        header.num_bits = num_bits;
+        header.num_words = num_words;
+        out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
 };
 using BloomFilterPtr = std::shared_ptr<BloomFilter>;
 
@@ -107,6 +172,8 @@ class BlockedBloomFilter : public BloomFilter {
 
         size_t num_blocks = (num_bits_ + 63) / 64;
         bits_.resize(num_blocks, 0);
+        words_ = bits_.data();
+        num_words_ = bits_.size();
 
         LOG_DEBUG(
             "Created BlockedBloomFilter: capacity={}, fp={}, bits={}, k={}",
@@ -124,10 +191,40 @@ class BlockedBloomFilter : public BloomFilter {
         }
 
         bits_ = data["bits"].get<std::vector<uint64_t>>();
+        words_ = bits_.data();
         num_bits_ = data["num_bits"].get<uint64_t>();
         k_ = data["k"].get<uint32_t>();
     }
 
+    BlockedBloomFilter(std::vector<uint64_t>&& bits,
+                       uint64_t num_bits,
+                       uint32_t k)
+        : bits_(std::move(bits)),
+          words_(bits_.data()),
+          num_words_(bits_.size()),
+          num_bits_(num_bits),
+          k_(k) {
+    }
+
+    // A filter probing 'num_words' words owned by someone else, e.g. an
+    // mmap-ed file. 'owner' keeps them alive, the first Add() copies them.
+    BlockedBloomFilter(const uint64_t* words,
+                       size_t num_words,
+                       uint64_t num_bits,
+                       uint32_t k,
+                       std::shared_ptr<const void> owner)
+        : owner_(std::move(owner)),
+          words_(words),
+          num_words_(num_words),
+          num_bits_(num_bits),
+          k_(k) {
+    }
+
+    // words_ may point into bits_
+    BlockedBloomFilter(const BlockedBloomFilter&) = delete;
+    BlockedBloomFilter&
+    operator=(const BlockedBloomFilter&) = delete;
+
     BFType
     Type() const override {
         return BFType::Blocked;
@@ -195,15 +292,34 @@ class BlockedBloomFilter : public BloomFilter {
     ToJson() const override {
         nlohmann::json data;
         data["type"] = BFTypeToString(Type());
-        data["bits"] = bits_;
+        data["bits"] = std::vector<uint64_t>(words_, words_ + num_words_);
         data["num_bits"] = num_bits_;
         data["k"] = k_;
         return data;
     }
 
+    void
+    Serialize(std::string& out) const override {
+        AppendBinaryHeader(out, Type(), k_, num_bits_, num_words_);
+        out.append(reinterpret_cast<const char*>(words_),
+                   num_words_ * sizeof(uint64_t));
+    }
+
+    // Whether the words are probed where they were loaded from.
+    bool
+    IsZeroCopy() const {
+        return owner_ != nullptr;
+    }
+
  private:
     void
     AddHash(uint64_t hash) {
+        if (owner_ != nullptr) {
+            bits_.assign(words_, words_ + num_words_);
+            words_ = bits_.data();
+            owner_ = nullptr;
+        }
+
         uint64_t h1 = hash;
         uint64_t h2 = hash >> 32;
 
@@ -226,7 +342,7 @@ class BlockedBloomFilter : public BloomFilter {
             uint64_t bit_pos = combined_hash % num_bits_;
             uint64_t block_idx = bit_pos / 64;
             uint64_t bit_idx = bit_pos % 64;
-            if ((bits_[block_idx] & (1ULL << bit_idx)) == 0) {
+            if ((words_[block_idx] & (1ULL << bit_idx)) == 0) {
                 return false;
             }
         }
@@ -234,11 +350,247 @@ class BlockedBloomFilter : public BloomFilter {
     }
 
  private:
+    // words are either owned in bits_ or referenced through owner_
     std::vector<uint64_t> bits_;
+    std::shared_ptr<const void> owner_;
+    const uint64_t* words_{nullptr};
+    size_t num_words_{0};
     uint64_t num_bits_;
     uint32_t k_;
 };
 
+// A bloom filter that puts every key into a single 256 bit block and sets
+// one bit in each of the block's eight 32 bit words, the split block bloom
+// filter of Parquet and Impala. A probe reads one cache line, and batches
+// of probes run through the SIMD kernels of the bitset library.
+class SplitBlockBloomFilter : public BloomFilter {
+ public:
+    static constexpr size_t kWordsPerBlock =
+        bitset::SPLIT_BLOCK_BLOOM_FILTER_WORDS;
+    static constexpr uint64_t kBitsPerBlock = kWordsPerBlock * 32;
+
+    // a block is 32 bytes, 64 byte aligned storage keeps it in a cache line
+    using Blocks =
+        std::vector<uint32_t,
+                    boost::alignment::aligned_allocator<uint32_t, 64>>;
+
+    SplitBlockBloomFilter(uint64_t capacity, double fp) {
+        // a key sets a bit in every word, so each word sees it as a
+        // single hash bloom filter of a eighth of the bits
+        double m = -8.0 * static_cast<double>(std::max<uint64_t>(capacity, 1)) /
+                   std::log(1.0 - std::pow(fp, 1.0 / kWordsPerBlock));
+        num_blocks_ = std::max<size_t>(
+            1, static_cast<size_t>(std::ceil(m / kBitsPerBlock)));
+        blocks_.resize(num_blocks_ * kWordsPerBlock, 0);
+        words_ = blocks_.data();
+
+        LOG_DEBUG(
+            "Created SplitBlockBloomFilter: capacity={}, fp={}, blocks={}",
+            capacity,
+            fp,
+            num_blocks_);
+    }
+
+    explicit SplitBlockBloomFilter(const nlohmann::json& data) {
+        if (!data.contains("blocks") || !data.contains("num_blocks")) {
+            throw std::runtime_error(
+                "Invalid JSON for SplitBlockBloomFilter: missing required "
+                "fields");
+        }
+        auto words = data["blocks"].get<std::vector<uint32_t>>();
+        num_blocks_ = data["num_blocks"].get<size_t>();
+        if (num_blocks_ == 0 || words.size() != num_blocks_ * kWordsPerBlock) {
+            throw std::runtime_error(
+                "Invalid JSON for SplitBlockBloomFilter: block count mismatch");
+        }
+        blocks_.assign(words.begin(), words.end());
+        words_ = blocks_.data();
+    }
+
+    explicit SplitBlockBloomFilter(Blocks&& blocks)
+        : blocks_(std::move(blocks)),
+          words_(blocks_.data()),
+          num_blocks_(blocks_.size() / kWordsPerBlock) {
+    }
+
+    // A filter probing 'num_blocks' blocks owned by someone else, e.g. an
+    // mmap-ed file. 'owner' keeps them alive, the first Add() copies them.
+    SplitBlockBloomFilter(const uint32_t* words,
+                          size_t num_blocks,
+                          std::shared_ptr<const void> owner)
+        : owner_(std::move(owner)), words_(words), num_blocks_(num_blocks) {
+    }
+
+    // words_ may point into blocks_
+    SplitBlockBloomFilter(const SplitBlockBloomFilter&) = delete;
+    SplitBlockBloomFilter&
+    operator=(const SplitBlockBloomFilter&) = delete;
+
+    BFType
+    Type() const override {
+        return BFType::SplitBlock;
+    }
+
+    uint64_t
+    Cap() const override {
+        return num_blocks_ * kBitsPerBlock;
+    }
+
+    uint32_t
+    K() const override {
+        return kWordsPerBlock;
+    }
+
+    size_t
+    NumBlocks() const {
+        return num_blocks_;
+    }
+
+    void
+    Add(const uint8_t* data, size_t len) override {
+        AddHash(XXH3_64bits(data, len));
+    }
+
+    void
+    Add(std::string_view data) override {
+        AddHash(XXH3_64bits(data.data(), data.size()));
+    }
+
+    bool
+    Test(const uint8_t* data, size_t len) const override {
+        return TestHash(XXH3_64bits(data, len));
+    }
+
+    bool
+    Test(std::string_view data) const override {
+        return TestHash(XXH3_64bits(data.data(), data.size()));
+    }
+
+    bool
+    TestLocations(const std::vector<uint64_t>& locs) const override {
+        if (locs.size() != 1) {
+            return true;
+        }
+        return TestHash(locs[0]);
+    }
+
+    // Sets bit i of 'bitmask', which holds at least (size + 7) / 8 bytes,
+    // if hashes[i] may be in the filter.
+    void
+    TestHashes(const uint64_t* hashes, size_t size, uint8_t* bitmask) const {
+        if (bitset::detail::VectorizedDynamic::op_split_block_filter_test(
+                bitmask, words_, num_blocks_, hashes, size)) {
+            return;
+        }
+        std::fill(bitmask, bitmask + (size + 7) / 8, 0);
+        for (size_t i = 0; i < size; ++i) {
+            if (TestHash(hashes[i])) {
+                bitmask[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+            }
+        }
+    }
+
+    std::vector<bool>
+    BatchTestLocations(const std::vector<std::vector<uint64_t>>& locs,
+                       const std::vector<bool>& hits) const override {
+        std::vector<bool> ret(locs.size(), false);
+        std::vector<uint64_t> hashes;
+        std::vector<size_t> rows;
+        hashes.reserve(hits.size());
+        rows.reserve(hits.size());
+        for (size_t i = 0; i < hits.size(); ++i) {
+            if (!hits[i]) {
+                if (locs[i].size() != 1) {
+                    ret[i] = true;
+                    continue;
+                }
+                hashes.push_back(locs[i][0]);
+                rows.push_back(i);
+            }
+        }
+        std::vector<uint8_t> bitmask((hashes.size() + 7) / 8);
+        TestHashes(hashes.data(), hashes.size(), bitmask.data());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            ret[rows[i]] = (bitmask[i / 8] >> (i % 8)) & 1;
+        }
+        return ret;
+    }
+
+    nlohmann::json
+    ToJson() const override {
+        nlohmann::json data;
+        data["type"] = BFTypeToString(Type());
+        data["blocks"] = std::vector<uint32_t>(
+            words_, words_ + num_blocks_ * kWordsPerBlock);
+        data["num_blocks"] = num_blocks_;
+        return data;
+    }
+
+    // The blocks go out as uint64 words, two 32 bit words each, so the
+    // layout matches the other filters.
+    void
+    Serialize(std::string& out) const override {
+        AppendBinaryHeader(
+            out, Type(), K(), Cap(), num_blocks_ * kWordsPerBlock / 2);
+        out.append(reinterpret_cast<const char*>(words_),
+                   num_blocks_ * kWordsPerBlock * sizeof(uint32_t));
+    }
+
+    // Whether the blocks are probed where they were loaded from.
+    bool
+    IsZeroCopy() const {
+        return owner_ != nullptr;
+    }
+
+ private:
+    const uint32_t*
+    BlockOf(uint64_t hash) const {
+        return words_ +
+               bitset::split_block_bloom_filter_block(hash, num_blocks_) *
+                   kWordsPerBlock;
+    }
+
+    static uint32_t
+    BitOf(uint32_t key, size_t word) {
+        const uint32_t salt = bitset::SPLIT_BLOCK_BLOOM_FILTER_SALT[word];
+        return 1U << ((key * salt) >> 27);
+    }
+
+    void
+    AddHash(uint64_t hash) {
+        if (owner_ != nullptr) {
+            blocks_.assign(words_, words_ + num_blocks_ * kWordsPerBlock);
+            words_ = blocks_.data();
+            owner_ = nullptr;
+        }
+
+        auto block = blocks_.data() + (BlockOf(hash) - words_);
+        const auto key = static_cast<uint32_t>(hash);
+        for (size_t i = 0; i < kWordsPerBlock; ++i) {
+            block[i] |= BitOf(key, i);
+        }
+    }
+
+    bool
+    TestHash(uint64_t hash) const {
+        auto block = BlockOf(hash);
+        const auto key = static_cast<uint32_t>(hash);
+        for (size_t i = 0; i < kWordsPerBlock; ++i) {
+            if ((block[i] & BitOf(key, i)) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+ private:
+    // words are either owned in blocks_ or referenced through owner_
+    Blocks blocks_;
+    std::shared_ptr<const void> owner_;
+    const uint32_t* words_{nullptr};
+    size_t num_blocks_{0};
+};
+
 class AlwaysTrueBloomFilter : public BloomFilter {
  public:
     BFType
@@ -291,6 +643,11 @@ class AlwaysTrueBloomFilter : public BloomFilter {
         data["type"] = BFTypeToString(Type());
         return data;
     }
+
+    void
+    Serialize(std::string& out) const override {
+        AppendBinaryHeader(out, Type(), 0, 0, 0);
+    }
 };
 
 static const BloomFilterPtr g_always_true_bf =
@@ -303,6 +660,8 @@ NewBloomFilterWithType(uint64_t capacity, double fp, BFType type) {
             return std::make_shared<BlockedBloomFilter>(capacity, fp);
         case BFType::AlwaysTrue:
             return g_always_true_bf;
+        case BFType::SplitBlock:
+            return std::make_shared<SplitBlockBloomFilter>(capacity, fp);
         default:
             LOG_WARN(
                 "Unsupported bloom filter type {}, falling back to BlockedBF",
@@ -334,16 +693,99 @@ BloomFilterFromJson(const nlohmann::json& data) {
             return std::make_shared<BlockedBloomFilter>(data);
         case BFType::AlwaysTrue:
             return g_always_true_bf;
+        case BFType::SplitBlock:
+            return std::make_shared<SplitBlockBloomFilter>(data);
         default:
             throw std::runtime_error("Unsupported bloom filter type: " +
                                      type_str);
     }
 }
 
+// Loads a filter written by BloomFilter::Serialize(). With an 'owner' that
+// keeps 'data' alive and 8 byte aligned words, the bits are probed in place
+// instead of being copied.
+inline BloomFilterPtr
+BloomFilterFromBinary(const uint8_t* data,
+                      size_t size,
+                      std::shared_ptr<const void> owner = nullptr) {
+    if (!IsBloomFilterBinary(data, size) ||
+        size < sizeof(BloomFilterBinaryHeader)) {
+        throw std::runtime_error("invalid binary bloom filter header");
+    }
+    BloomFilterBinaryHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version > BLOOM_FILTER_BINARY_VERSION) {
+        throw std::runtime_error("unsupported binary bloom filter version " +
+                                 std::to_string(header.version));
+    }
+    const auto type = static_cast<BFType>(header.type);
+    switch (type) {
+        case BFType::AlwaysTrue:
+            return g_always_true_bf;
+        case BFType::Blocked:
+        case BFType::SplitBlock:
+            break;
+        default:
+            throw std::runtime_error("unsupported bloom filter type: " +
+                                     std::to_string(header.type));
+    }
+    if (header.num_bits == 0 || header.k == 0 ||
+        header.num_words != (header.num_bits + 63) / 64 ||
+        size - sizeof(header) < header.num_words * sizeof(uint64_t)) {
+        throw std::runtime_error("corrupted binary bloom filter");
+    }
+    auto words = data + sizeof(header);
+    if (type == BFType::SplitBlock) {
+        if (header.k != SplitBlockBloomFilter::kWordsPerBlock ||
+            header.num_bits % SplitBlockBloomFilter::kBitsPerBlock != 0) {
+            throw std::runtime_error("corrupted binary bloom filter");
+        }
+        const auto num_blocks =
+            header.num_bits / SplitBlockBloomFilter::kBitsPerBlock;
+        if (owner != nullptr &&
+            reinterpret_cast<uintptr_t>(words) % alignof(uint32_t) == 0) {
+            return std::make_shared<SplitBlockBloomFilter>(
+                reinterpret_cast<const uint32_t*>(words),
+                num_blocks,
+                std::move(owner));
+        }
+        SplitBlockBloomFilter::Blocks blocks(
+            num_blocks * SplitBlockBloomFilter::kWordsPerBlock);
+        std::memcpy(blocks.data(), words, blocks.size() * sizeof(uint32_t));
+        return std::make_shared<SplitBlockBloomFilter>(std::move(blocks));
+    }
+    if (owner != nullptr &&
+        reinterpret_cast<uintptr_t>(words) % alignof(uint64_t) == 0) {
+        return std::make_shared<BlockedBloomFilter>(
+            reinterpret_cast<const uint64_t*>(words),
+            header.num_words,
+            header.num_bits,
+            header.k,
+            std::move(owner));
+    }
+    std::vector<uint64_t> bits(header.num_words);
+    std::memcpy(bits.data(), words, header.num_words * sizeof(uint64_t));
+    return std::make_shared<BlockedBloomFilter>(
+        std::move(bits), header.num_bits, header.k);
+}
+
+// Loads a filter in the binary layout, or in the JSON text older versions
+// wrote.
+inline BloomFilterPtr
+LoadBloomFilter(const uint8_t* data,
+                size_t size,
+                std::shared_ptr<const void> owner = nullptr) {
+    if (IsBloomFilterBinary(data, size)) {
+        return BloomFilterFromBinary(data, size, std::move(owner));
+    }
+    return BloomFilterFromJson(nlohmann::json::parse(data, data + size));
+}
+
 inline std::vector<uint64_t>
 Locations(const uint8_t* data, size_t len, uint32_t k, BFType bf_type) {
     switch (bf_type) {
         case BFType::Blocked:
+        case BFType::SplitBlock:
             return {XXH3_64bits(data, len)};
         case BFType::AlwaysTrue:
             return {};
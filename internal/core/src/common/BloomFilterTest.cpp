@@ -295,3 +295,177 @@ TEST(BloomFilterTest, LocationsConsistency) {
     auto locs3 = Locations(data3, 7, BFType::Blocked);
     EXPECT_NE(locs1, locs3);
 }
+
+TEST(BloomFilterTest, BlockedBF_BinarySerialization) {
+    auto bf = NewBloomFilterWithType(1000, 0.01, BFType::Blocked);
+    for (int i = 0; i < 100; ++i) {
+        bf->Add("key_" + std::to_string(i));
+    }
+
+    auto buffer = std::make_shared<std::string>();
+    bf->Serialize(*buffer);
+    ASSERT_EQ(buffer->size(),
+              sizeof(BloomFilterBinaryHeader) + (bf->Cap() + 63) / 64 * 8);
+    auto data = reinterpret_cast<const uint8_t*>(buffer->data());
+
+    // without an owner the bits are copied
+    auto copied = BloomFilterFromBinary(data, buffer->size());
+    ASSERT_EQ(copied->Type(), BFType::Blocked);
+    EXPECT_FALSE(
+        std::static_pointer_cast<BlockedBloomFilter>(copied)->IsZeroCopy());
+
+    auto in_place = LoadBloomFilter(data, buffer->size(), buffer);
+    auto blocked = std::static_pointer_cast<BlockedBloomFilter>(in_place);
+    EXPECT_TRUE(blocked->IsZeroCopy());
+    EXPECT_EQ(in_place->Cap(), bf->Cap());
+    EXPECT_EQ(in_place->K(), bf->K());
+
+    for (const auto& loaded : {copied, in_place}) {
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(loaded->Test("key_" + std::to_string(i)));
+        }
+        EXPECT_EQ(loaded->Test("not_added"), bf->Test("not_added"));
+    }
+
+    // adding to a filter loaded in place leaves the buffer untouched
+    const auto original = *buffer;
+    in_place->Add("new_key");
+    EXPECT_FALSE(blocked->IsZeroCopy());
+    EXPECT_TRUE(in_place->Test("new_key"));
+    EXPECT_EQ(*buffer, original);
+}
+
+TEST(BloomFilterTest, LoadBloomFilterFallsBackToJson) {
+    auto bf = NewBloomFilterWithType(1000, 0.01, BFType::Blocked);
+    bf->Add("legacy");
+    auto json = bf->ToJson().dump();
+    auto loaded = LoadBloomFilter(reinterpret_cast<const uint8_t*>(json.data()),
+                                  json.size());
+    ASSERT_EQ(loaded->Type(), BFType::Blocked);
+    EXPECT_TRUE(loaded->Test("legacy"));
+
+    auto always_true = NewBloomFilterWithType(0, 0.0, BFType::AlwaysTrue);
+    std::string binary;
+    always_true->Serialize(binary);
+    auto loaded_always_true = LoadBloomFilter(
+        reinterpret_cast<const uint8_t*>(binary.data()), binary.size());
+    EXPECT_EQ(loaded_always_true->Type(), BFType::AlwaysTrue);
+
+    std::string truncated;
+    bf->Serialize(truncated);
+    truncated.resize(truncated.size() - 8);
+    EXPECT_THROW(BloomFilterFromBinary(
+                     reinterpret_cast<const uint8_t*>(truncated.data()),
+                     truncated.size()),
+                 std::runtime_error);
+}
+
+TEST(BloomFilterTest, SplitBlockBF_FalsePositiveRate) {
+    const int capacity = 10000;
+    const double expected_fp_rate = 0.01;
+    auto bf =
+        NewBloomFilterWithType(capacity, expected_fp_rate, BFType::SplitBlock);
+    ASSERT_EQ(bf->Type(), BFType::SplitBlock);
+    ASSERT_EQ(bf->K(), 8U);
+    ASSERT_EQ(bf->Cap() % SplitBlockBloomFilter::kBitsPerBlock, 0U);
+
+    for (int i = 0; i < capacity; ++i) {
+        bf->Add("key_" + std::to_string(i));
+    }
+    for (int i = 0; i < capacity; ++i) {
+        EXPECT_TRUE(bf->Test("key_" + std::to_string(i)));
+    }
+
+    int false_positives = 0;
+    const int test_count = 10000;
+    for (int i = 0; i < test_count; ++i) {
+        if (bf->Test("test_key_" + std::to_string(i + capacity))) {
+            false_positives++;
+        }
+    }
+    double actual_fp_rate = static_cast<double>(false_positives) / test_count;
+    EXPECT_LT(actual_fp_rate, expected_fp_rate * 3);
+}
+
+TEST(BloomFilterTest, SplitBlockBF_BatchMatchesSingleProbes) {
+    auto bf = NewBloomFilterWithType(500, 0.05, BFType::SplitBlock);
+    for (int64_t i = 0; i < 500; ++i) {
+        bf->Add(reinterpret_cast<const uint8_t*>(&i), sizeof(i));
+    }
+
+    // not a multiple of 8, so the kernels see a partial last byte
+    const int64_t num_keys = 1003;
+    std::vector<std::vector<uint64_t>> locs;
+    std::vector<bool> hits;
+    for (int64_t i = 0; i < num_keys; ++i) {
+        locs.push_back(Locations(reinterpret_cast<const uint8_t*>(&i),
+                                 sizeof(i),
+                                 bf->K(),
+                                 bf->Type()));
+        hits.push_back(i % 7 == 0);
+    }
+    auto results = bf->BatchTestLocations(locs, hits);
+    ASSERT_EQ(results.size(), static_cast<size_t>(num_keys));
+    for (int64_t i = 0; i < num_keys; ++i) {
+        if (hits[i]) {
+            EXPECT_FALSE(results[i]);
+            continue;
+        }
+        EXPECT_EQ(results[i], bf->TestLocations(locs[i])) << i;
+        if (i < 500) {
+            EXPECT_TRUE(results[i]) << i;
+        }
+    }
+
+    auto split_block = std::static_pointer_cast<SplitBlockBloomFilter>(bf);
+    std::vector<uint64_t> hashes;
+    for (const auto& loc : locs) {
+        hashes.push_back(loc[0]);
+    }
+    std::vector<uint8_t> bitmask((hashes.size() + 7) / 8, 0xff);
+    split_block->TestHashes(hashes.data(), hashes.size(), bitmask.data());
+    for (size_t i = 0; i < hashes.size(); ++i) {
+        EXPECT_EQ((bitmask[i / 8] >> (i % 8)) & 1,
+                  bf->TestLocations(locs[i]) ? 1 : 0)
+            << i;
+    }
+    // the unused bits of the last byte are cleared
+    EXPECT_EQ(bitmask.back() >> (hashes.size() % 8), 0);
+}
+
+TEST(BloomFilterTest, SplitBlockBF_Serialization) {
+    auto bf = NewBloomFilterWithType(1000, 0.01, BFType::SplitBlock);
+    for (int i = 0; i < 100; ++i) {
+        bf->Add("key_" + std::to_string(i));
+    }
+
+    auto from_json = BloomFilterFromJson(bf->ToJson());
+    ASSERT_EQ(from_json->Type(), BFType::SplitBlock);
+    EXPECT_EQ(from_json->Cap(), bf->Cap());
+
+    auto buffer = std::make_shared<std::string>();
+    bf->Serialize(*buffer);
+    ASSERT_EQ(buffer->size(), sizeof(BloomFilterBinaryHeader) + bf->Cap() / 8);
+    auto data = reinterpret_cast<const uint8_t*>(buffer->data());
+    auto copied = BloomFilterFromBinary(data, buffer->size());
+    EXPECT_FALSE(
+        std::static_pointer_cast<SplitBlockBloomFilter>(copied)->IsZeroCopy());
+    auto in_place = LoadBloomFilter(data, buffer->size(), buffer);
+    auto split_block =
+        std::static_pointer_cast<SplitBlockBloomFilter>(in_place);
+    EXPECT_TRUE(split_block->IsZeroCopy());
+
+    for (const auto& loaded : {from_json, copied, in_place}) {
+        ASSERT_EQ(loaded->Type(), BFType::SplitBlock);
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(loaded->Test("key_" + std::to_string(i)));
+        }
+        EXPECT_EQ(loaded->Test("not_added"), bf->Test("not_added"));
+    }
+
+    const auto original = *buffer;
+    in_place->Add("new_key");
+    EXPECT_FALSE(split_block->IsZeroCopy());
+    EXPECT_TRUE(in_place->Test("new_key"));
+    EXPECT_EQ(*buffer, original);
+}
@@ -10,11 +10,47 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <sys/mman.h>
+#include <unistd.h>
 #include <cstdint>
 #include "common/Chunk.h"
 
 namespace milvus {
 
+namespace {
+
+const uintptr_t PAGE_SIZE_MASK = ~(uintptr_t(sysconf(_SC_PAGE_SIZE)) - 1);
+
+// madvise wants a page aligned start, the advice is a hint so a failure is
+// not worth surfacing
+void
+AdvisePages(const char* begin, size_t len, int advice) {
+    auto start = reinterpret_cast<uintptr_t>(begin) & PAGE_SIZE_MASK;
+    auto end = reinterpret_cast<uintptr_t>(begin) + len;
+    madvise(reinterpret_cast<void*>(start), end - start, advice);
+}
+
+}  // namespace
+
+void
+Chunk::Advise(int advice) const {
+    if (chunk_mmap_guard_ == nullptr || !chunk_mmap_guard_->is_file_backed() ||
+        size_ == 0) {
+        return;
+    }
+    if (advice_.exchange(advice, std::memory_order_relaxed) != advice) {
+        AdvisePages(data_, size_, advice);
+    }
+}
+
+void
+Chunk::WillNeed(const char* begin, size_t len) const {
+    if (chunk_mmap_guard_ == nullptr || !chunk_mmap_guard_->is_file_backed() ||
+        len == 0) {
+        return;
+    }
+    AdvisePages(begin, len, MADV_WILLNEED);
+}
+
 std::pair<std::vector<std::string_view>, FixedVector<bool>>
 StringChunk::StringViews(
     std::optional<std::pair<int64_t, int64_t>> offset_len = std::nullopt) {
@@ -43,8 +79,15 @@ StringChunk::StringViews(
     std::vector<std::string_view> ret;
     ret.reserve(len);
     auto end_offset = start_offset + len;
-    for (auto i = start_offset; i < end_offset; i++) {
-        ret.emplace_back(data_ + offsets_[i], offsets_[i + 1] - offsets_[i]);
+    if (codes_ != nullptr) {
+        for (auto i = start_offset; i < end_offset; i++) {
+            ret.emplace_back(DictValue(Code(i)));
+        }
+    } else {
+        for (auto i = start_offset; i < end_offset; i++) {
+            ret.emplace_back(data_ + offsets_[i],
+                             offsets_[i + 1] - offsets_[i]);
+        }
     }
     if (nullable_) {
         FixedVector<bool> res_valid(valid_.begin() + start_offset,
@@ -62,8 +105,12 @@ StringChunk::ViewsByOffsets(const FixedVector<int32_t>& offsets) {
     ret.reserve(size);
     valid_res.reserve(size);
     for (auto i = 0; i < size; ++i) {
-        ret.emplace_back(data_ + offsets_[offsets[i]],
-                         offsets_[offsets[i] + 1] - offsets_[offsets[i]]);
+        if (codes_ != nullptr) {
+            ret.emplace_back(DictValue(Code(offsets[i])));
+        } else {
+            ret.emplace_back(data_ + offsets_[offsets[i]],
+                             offsets_[offsets[i] + 1] - offsets_[offsets[i]]);
+        }
         valid_res.emplace_back(isValid(offsets[i]));
     }
     return {ret, valid_res};
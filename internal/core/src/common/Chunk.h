@@ -12,6 +12,7 @@
 #pragma once
 
 #include <sys/types.h>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -46,6 +47,11 @@ class ChunkMmapGuard {
         : mmap_ptr_(mmap_ptr), mmap_size_(mmap_size), file_path_(file_path) {
     }
 
+    // borrows memory kept alive by 'owner', nothing to unmap
+    explicit ChunkMmapGuard(std::shared_ptr<const void> owner)
+        : mmap_ptr_(nullptr), mmap_size_(0), owner_(std::move(owner)) {
+    }
+
     ~ChunkMmapGuard() {
         if (mmap_ptr_ != nullptr) {
             munmap(mmap_ptr_, mmap_size_);
@@ -69,6 +75,7 @@ class ChunkMmapGuard {
     char* mmap_ptr_;
     size_t mmap_size_;
     const std::string file_path_;
+    std::shared_ptr<const void> owner_;
 };
 
 class Chunk {
@@ -113,6 +120,17 @@ class Chunk {
         return row_nums_;
     }
 
+    // hints the kernel how the pages of a chunk mapped from a file are
+    // read, one of MADV_NORMAL, MADV_SEQUENTIAL or MADV_RANDOM. A no-op for
+    // anonymous memory and when the chunk already has the advice.
+    void
+    Advise(int advice) const;
+
+    // starts reading [begin, begin + len) of a chunk mapped from a file into
+    // the page cache, so the faults on it don't block one by one
+    void
+    WillNeed(const char* begin, size_t len) const;
+
     virtual const char*
     ValueAt(int64_t idx) const = 0;
 
@@ -148,6 +166,7 @@ class Chunk {
         valid_;  // parse null bitmap to valid_ to be compatible with SpanBase
 
     std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard_{nullptr};
+    mutable std::atomic<int> advice_{MADV_NORMAL};
 };
 
 // for fixed size data, includes fixed size array
@@ -212,8 +231,19 @@ class FixedWidthChunk : public Chunk {
 // In this example, 'exampleChunk' is a StringChunk with 3 rows, a pointer to the data stored in 'dataPointer',
 // a total data size of 'dataSize', and it does not support nullability.
 
+// A string chunk is laid out either plain,
+//   [null_bitmap][offsets, row_nums + 1][strings][padding]
+// or dictionary encoded, for the columns of few distinct values,
+//   [null_bitmap][0][dict_size][code_width][codes_offset]
+//   [dict offsets, dict_size + 1][sorted distinct strings][codes][padding]
+// with a code of code_width bytes per row, the position of its string in
+// the dictionary. All offsets are from the start of the chunk. The first
+// offset of a plain chunk is never 0, which marks the encoded layout.
 class StringChunk : public Chunk {
  public:
+    // header words of the dictionary encoded layout, the marker included
+    static constexpr int kDictHeaderWords = 4;
+
     StringChunk() = default;
     StringChunk(int32_t row_nums,
                 char* data,
@@ -223,6 +253,15 @@ class StringChunk : public Chunk {
         : Chunk(row_nums, data, size, nullable, chunk_mmap_guard) {
         auto null_bitmap_bytes_num = nullable_ ? (row_nums_ + 7) / 8 : 0;
         offsets_ = reinterpret_cast<uint32_t*>(data + null_bitmap_bytes_num);
+        if (offsets_[0] == 0) {
+            dict_size_ = offsets_[1];
+            code_width_ = offsets_[2];
+            codes_ = data_ + offsets_[3];
+            dict_offsets_ = offsets_ + kDictHeaderWords;
+            AssertInfo(code_width_ == 1 || code_width_ == 2 || code_width_ == 4,
+                       "invalid code width {} of string chunk",
+                       code_width_);
+        }
     }
 
     std::string_view
@@ -234,9 +273,54 @@ class StringChunk : public Chunk {
                       row_nums_);
         }
 
+        if (codes_ != nullptr) {
+            return DictValue(Code(i));
+        }
         return {data_ + offsets_[i], offsets_[i + 1] - offsets_[i]};
     }
 
+    bool
+    IsDictEncoded() const {
+        return codes_ != nullptr;
+    }
+
+    // the number of distinct strings of an encoded chunk
+    uint32_t
+    DictSize() const {
+        return dict_size_;
+    }
+
+    // the strings of an encoded chunk are in dictionary order, so codes
+    // compare as their strings do
+    std::string_view
+    DictValue(uint32_t code) const {
+        return {data_ + dict_offsets_[code],
+                dict_offsets_[code + 1] - dict_offsets_[code]};
+    }
+
+    uint32_t
+    CodeWidth() const {
+        return code_width_;
+    }
+
+    // the codes of rows [0, row_nums), CodeWidth() bytes each
+    const void*
+    Codes() const {
+        return codes_;
+    }
+
+    uint32_t
+    Code(int64_t i) const {
+        switch (code_width_) {
+            case 1:
+                return reinterpret_cast<const uint8_t*>(codes_)[i];
+            case 2:
+                return reinterpret_cast<const uint16_t*>(codes_)[i];
+            default:
+                return reinterpret_cast<const uint32_t*>(codes_)[i];
+        }
+    }
+
     std::pair<std::vector<std::string_view>, FixedVector<bool>>
     StringViews(std::optional<std::pair<int64_t, int64_t>> offset_len);
 
@@ -315,6 +399,11 @@ class StringChunk : public Chunk {
 
  protected:
     uint32_t* offsets_;
+    // set for the dictionary encoded layout only
+    uint32_t dict_size_{0};
+    uint32_t code_width_{0};
+    const uint32_t* dict_offsets_{nullptr};
+    const char* codes_{nullptr};
 };
 
 using JSONChunk = StringChunk;
@@ -442,6 +531,11 @@ class ArrayChunk : public Chunk {
                   "ArrayChunk::ValueAt is not supported");
     }
 
+    milvus::DataType
+    element_type() const {
+        return element_type_;
+    }
+
  private:
     milvus::DataType element_type_;
     uint32_t* offsets_lens_;
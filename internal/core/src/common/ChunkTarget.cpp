@@ -13,13 +13,164 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "common/Common.h"
 #include "common/EasyAssert.h"
+#include "log/Log.h"
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 #include "File.h"
 
 const uint32_t SYS_PAGE_SIZE = sysconf(_SC_PAGE_SIZE);
 namespace milvus {
+
+namespace {
+
+// MPOL_INTERLEAVE of linux/mempolicy.h, which libc does not export
+constexpr int kMpolInterleave = 3;
+
+// the mask of the online numa nodes, 0 on a single node host
+unsigned long
+OnlineNumaNodes() {
+    static const unsigned long nodes = []() {
+        std::ifstream file("/sys/devices/system/node/online");
+        std::string ranges;
+        if (!std::getline(file, ranges)) {
+            return 0UL;
+        }
+        // a list of ranges like "0-1,3"
+        unsigned long mask = 0;
+        std::stringstream ss(ranges);
+        std::string range;
+        while (std::getline(ss, range, ',')) {
+            auto dash = range.find('-');
+            auto first = std::stoul(range.substr(0, dash));
+            auto last = dash == std::string::npos
+                            ? first
+                            : std::stoul(range.substr(dash + 1));
+            for (auto node = first; node <= last && node < 64; ++node) {
+                mask |= 1UL << node;
+            }
+        }
+        return __builtin_popcountl(mask) > 1 ? mask : 0UL;
+    }();
+    return nodes;
+}
+
+}  // namespace
+
+MemChunkTarget::MemChunkTarget(size_t cap, bool populate) : cap_(cap) {
+    const bool huge_page =
+        CHUNK_HUGE_PAGE_ENABLED.load() && cap >= HUGE_PAGE_SIZE;
+    const bool interleave =
+        CHUNK_NUMA_INTERLEAVE_ENABLED.load() && OnlineNumaNodes() != 0;
+    if (!huge_page && !interleave) {
+        auto mmap_flag = MAP_PRIVATE | MAP_ANON;
+        if (populate) {
+            mmap_flag |= MAP_POPULATE;
+        }
+        auto m = mmap(nullptr, cap, PROT_READ | PROT_WRITE, mmap_flag, -1, 0);
+        AssertInfo(m != MAP_FAILED,
+                   "failed to map: {}, map_size={}",
+                   strerror(errno),
+                   cap);
+        data_ = reinterpret_cast<char*>(m);
+        return;
+    }
+
+    // the placement is decided before any page is faulted in, the writes
+    // fault them in anyway
+    if (huge_page) {
+        data_ = MapHugePages(cap);
+    } else {
+        auto m = mmap(nullptr,
+                      cap,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANON,
+                      -1,
+                      0);
+        AssertInfo(m != MAP_FAILED,
+                   "failed to map: {}, map_size={}",
+                   strerror(errno),
+                   cap);
+        data_ = reinterpret_cast<char*>(m);
+    }
+    if (interleave) {
+        InterleaveNumaNodes(data_, cap);
+    }
+#ifdef MADV_POPULATE_WRITE
+    if (populate) {
+        madvise(data_, cap, MADV_POPULATE_WRITE);
+    }
+#endif
+}
+
+MemChunkTarget::~MemChunkTarget() {
+    // a chunk failed or cancelled half way frees its memory at once
+    if (!released_) {
+        munmap(data_, cap_);
+    }
+}
+
+char*
+MemChunkTarget::MapHugePages(size_t cap) {
+    // over map by a huge page and trim both ends to the aligned range
+    auto map_size = cap + HUGE_PAGE_SIZE;
+    auto m = mmap(nullptr,
+                  map_size,
+                  PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANON,
+                  -1,
+                  0);
+    AssertInfo(m != MAP_FAILED,
+               "failed to map: {}, map_size={}",
+               strerror(errno),
+               map_size);
+    auto begin = reinterpret_cast<uintptr_t>(m);
+    auto aligned = (begin + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    auto end = begin + map_size;
+    // the tail is cut at a page, as munmap of the chunk rounds its size up
+    auto aligned_end = (aligned + cap + SYS_PAGE_SIZE - 1) &
+                       ~(static_cast<uintptr_t>(SYS_PAGE_SIZE) - 1);
+    if (aligned > begin) {
+        munmap(m, aligned - begin);
+    }
+    if (end > aligned_end) {
+        munmap(reinterpret_cast<void*>(aligned_end), end - aligned_end);
+    }
+    auto data = reinterpret_cast<char*>(aligned);
+#ifdef MADV_HUGEPAGE
+    if (madvise(data, cap, MADV_HUGEPAGE) != 0) {
+        LOG_WARN("failed to advise huge pages for chunk of {} bytes: {}",
+                 cap,
+                 strerror(errno));
+    }
+#endif
+    return data;
+}
+
+void
+MemChunkTarget::InterleaveNumaNodes(char* data, size_t cap) {
+#ifdef SYS_mbind
+    auto nodes = OnlineNumaNodes();
+    // the kernel reads one bit less than maxnode
+    if (syscall(SYS_mbind,
+                data,
+                cap,
+                kMpolInterleave,
+                &nodes,
+                sizeof(nodes) * 8 + 1,
+                0) != 0) {
+        LOG_WARN("failed to interleave chunk of {} bytes over numa nodes: {}",
+                 cap,
+                 strerror(errno));
+    }
+#endif
+}
+
 void
 MemChunkTarget::write(const void* data, size_t size) {
     AssertInfo(size + size_ <= cap_, "can not exceed target capacity");
@@ -29,6 +180,7 @@ MemChunkTarget::write(const void* data, size_t size) {
 
 char*
 MemChunkTarget::release() {
+    released_ = true;
     return data_;
 }
 
@@ -37,6 +189,14 @@ MemChunkTarget::tell() {
     return size_;
 }
 
+MmapChunkTarget::~MmapChunkTarget() {
+    if (!released_) {
+        file_writer_.reset();
+        std::error_code ec;
+        std::filesystem::remove(file_path_, ec);
+    }
+}
+
 void
 MmapChunkTarget::flush() {
     if (cap_ > size_) {
@@ -67,6 +227,7 @@ MmapChunkTarget::release() {
                "failed to map: {}, map_size={}",
                strerror(errno),
                cap_);
+    released_ = true;
     return static_cast<char*>(m);
 }
 
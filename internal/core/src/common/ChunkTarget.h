@@ -66,6 +66,9 @@ class MmapChunkTarget : public ChunkTarget {
             std::make_unique<storage::FileWriter>(file_path_, io_prio);
     }
 
+    // removes the file of a chunk given up before release()
+    ~MmapChunkTarget() override;
+
     void
     write(const void* data, size_t size) override;
 
@@ -84,22 +87,17 @@ class MmapChunkTarget : public ChunkTarget {
     size_t cap_{0};
     size_t size_{0};
     bool populate_{false};
+    bool released_{false};
 };
 
 class MemChunkTarget : public ChunkTarget {
  public:
-    explicit MemChunkTarget(size_t cap, bool populate = true) : cap_(cap) {
-        auto mmap_flag = MAP_PRIVATE | MAP_ANON;
-        if (populate) {
-            mmap_flag |= MAP_POPULATE;
-        }
-        auto m = mmap(nullptr, cap, PROT_READ | PROT_WRITE, mmap_flag, -1, 0);
-        AssertInfo(m != MAP_FAILED,
-                   "failed to map: {}, map_size={}",
-                   strerror(errno),
-                   size_);
-        data_ = reinterpret_cast<char*>(m);
-    }
+    static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;  // 2MB
+
+    explicit MemChunkTarget(size_t cap, bool populate = true);
+
+    // unmaps the data of a chunk given up before release()
+    ~MemChunkTarget() override;
 
     void
     write(const void* data, size_t size) override;
@@ -111,9 +109,19 @@ class MemChunkTarget : public ChunkTarget {
     tell() override;
 
  private:
-    char* data_;  // no need to delete in destructor, will be deleted by Chunk
+    // maps cap bytes huge page aligned, so the chunk is backed by huge pages
+    // and the mapping still ends with it
+    static char*
+    MapHugePages(size_t cap);
+
+    // spreads the pages over the numa nodes, before any is faulted in
+    static void
+    InterleaveNumaNodes(char* data, size_t cap);
+
+    char* data_;  // owned by the Chunk once released
     size_t cap_;
     size_t size_ = 0;
+    bool released_ = false;
 };
 
 }  // namespace milvus
\ No newline at end of file
@@ -0,0 +1,63 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "common/Chunk.h"
+#include "common/ChunkTarget.h"
+#include "common/Common.h"
+
+using namespace milvus;
+
+TEST(MemChunkTargetTest, HugePageAndInterleavedPlacement) {
+    CHUNK_HUGE_PAGE_ENABLED.store(true);
+    CHUNK_NUMA_INTERLEAVE_ENABLED.store(true);
+    for (size_t cap : {size_t(4096),
+                       MemChunkTarget::HUGE_PAGE_SIZE,
+                       3 * MemChunkTarget::HUGE_PAGE_SIZE + 4096}) {
+        MemChunkTarget target(cap);
+        std::vector<char> data(cap);
+        for (size_t i = 0; i < cap; ++i) {
+            data[i] = static_cast<char>(i * 31);
+        }
+        target.write(data.data(), cap);
+        EXPECT_EQ(target.tell(), cap);
+        auto released = target.release();
+        if (cap >= MemChunkTarget::HUGE_PAGE_SIZE) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(released) %
+                          MemChunkTarget::HUGE_PAGE_SIZE,
+                      0);
+        }
+        EXPECT_EQ(std::memcmp(released, data.data(), cap), 0);
+        // unmapped the way chunks are
+        ChunkMmapGuard guard(released, cap, "");
+    }
+    CHUNK_HUGE_PAGE_ENABLED.store(DEFAULT_CHUNK_HUGE_PAGE_ENABLED);
+    CHUNK_NUMA_INTERLEAVE_ENABLED.store(DEFAULT_CHUNK_NUMA_INTERLEAVE_ENABLED);
+}
+
+TEST(MmapChunkTargetTest, UnreleasedTargetRemovesItsFile) {
+    auto path =
+        std::filesystem::temp_directory_path() / "mmap_chunk_target_test";
+    {
+        MmapChunkTarget target(
+            path.string(), false, 8192, storage::io::Priority::MIDDLE);
+        std::vector<char> data(4096, 'a');
+        target.write(data.data(), data.size());
+        EXPECT_TRUE(std::filesystem::exists(path));
+    }
+    // a chunk given up half way leaves nothing behind
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
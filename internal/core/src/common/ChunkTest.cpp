@@ -11,6 +11,7 @@
 
 #include <fcntl.h>
 #include <gtest/gtest.h>
+#include <arrow/array/builder_primitive.h>
 #include <arrow/buffer.h>
 #include <arrow/io/memory.h>
 #include <parquet/arrow/reader.h>
@@ -1360,4 +1361,84 @@ TEST(chunk, test_create_group_chunk_nullable_fields) {
             EXPECT_EQ(str_views[i], str_data[i]);
         }
     }
-}
\ No newline at end of file
+}
+TEST(chunk, test_borrow_fixed_width_array) {
+    FieldMeta field_meta(FieldName("a"),
+                         milvus::FieldId(1),
+                         DataType::INT64,
+                         false,
+                         std::nullopt);
+    arrow::Int64Builder builder;
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_TRUE(builder.Append(i * 3).ok());
+    }
+    std::shared_ptr<arrow::Int64Array> array;
+    ASSERT_TRUE(builder.Finish(&array).ok());
+
+    // a single array without nulls is borrowed by the in-memory chunk
+    auto chunk = create_chunk(field_meta, {array});
+    auto fixed_chunk = static_cast<FixedWidthChunk*>(chunk.get());
+    EXPECT_EQ(fixed_chunk->Data(),
+              reinterpret_cast<const char*>(array->raw_values()));
+    EXPECT_EQ(fixed_chunk->RowNums(), 100);
+
+    // several arrays are copied into one
+    chunk = create_chunk(field_meta, {array->Slice(0, 40), array->Slice(40)});
+    fixed_chunk = static_cast<FixedWidthChunk*>(chunk.get());
+    EXPECT_NE(fixed_chunk->Data(),
+              reinterpret_cast<const char*>(array->raw_values()));
+
+    // the borrowed chunk keeps the arrow data alive
+    chunk = create_chunk(field_meta, {array});
+    array.reset();
+    fixed_chunk = static_cast<FixedWidthChunk*>(chunk.get());
+    auto span = fixed_chunk->Span();
+    ASSERT_EQ(span.row_count(), 100);
+    for (int64_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(static_cast<const int64_t*>(span.data())[i], i * 3);
+    }
+}
+
+TEST(chunk, test_create_chunk_from_reader_mmap) {
+    int64_t num_rows = 100000;
+    FixedVector<int64_t> data(num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        data[i] = i * 7;
+    }
+    auto field_data = milvus::storage::CreateFieldData(storage::DataType::INT64,
+                                                       DataType::NONE);
+    field_data->FillFieldData(data.data(), data.size());
+    storage::InsertEventData event_data;
+    event_data.payload_reader =
+        std::make_shared<milvus::storage::PayloadReader>(field_data);
+    auto ser_data = event_data.Serialize();
+    auto buffer = std::make_shared<arrow::io::BufferReader>(
+        ser_data.data() + 2 * sizeof(milvus::Timestamp),
+        ser_data.size() - 2 * sizeof(milvus::Timestamp));
+
+    parquet::arrow::FileReaderBuilder reader_builder;
+    ASSERT_TRUE(reader_builder.Open(buffer).ok());
+    std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
+    ASSERT_TRUE(reader_builder.Build(&arrow_reader).ok());
+    ArrowDataWrapper wrapper;
+    wrapper.arrow_reader = std::move(arrow_reader);
+    ASSERT_TRUE(
+        wrapper.arrow_reader->GetRecordBatchReader(&wrapper.reader).ok());
+
+    FieldMeta field_meta(FieldName("a"),
+                         milvus::FieldId(1),
+                         DataType::INT64,
+                         false,
+                         std::nullopt);
+    auto file_path = boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path();
+    // decoded a batch at a time into the mmap'd file
+    auto chunk = create_chunk_from_reader(
+        field_meta, wrapper, true, file_path.string());
+    auto fixed_chunk = static_cast<FixedWidthChunk*>(chunk.get());
+    auto span = fixed_chunk->Span();
+    ASSERT_EQ(span.row_count(), num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        EXPECT_EQ(static_cast<const int64_t*>(span.data())[i], data[i]);
+    }
+}
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "common/ChunkWriter.h"
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <tuple>
@@ -20,6 +21,7 @@
 #include "arrow/record_batch.h"
 #include "arrow/type_fwd.h"
 #include "common/Chunk.h"
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "simdjson/padded_string.h"
@@ -31,47 +33,152 @@ std::pair<size_t, size_t>
 StringChunkWriter::calculate_size(const arrow::ArrayVector& array_vec) {
     row_nums_ = 0;
     size_t size = 0;
-    // tuple <data, size, offset>
-    std::vector<std::tuple<const uint8_t*, int64_t, int64_t>> null_bitmaps;
+    strs_.clear();
+    for (const auto& data : array_vec) {
+        row_nums_ += data->length();
+    }
+    strs_.reserve(row_nums_);
     for (const auto& data : array_vec) {
         // for bson, we use binary array to store the string
         auto array = std::dynamic_pointer_cast<arrow::BinaryArray>(data);
         for (int i = 0; i < array->length(); i++) {
             auto str = array->GetView(i);
+            strs_.emplace_back(str);
             size += str.size();
         }
-        row_nums_ += array->length();
     }
     if (nullable_) {
         size += (row_nums_ + 7) / 8;
     }
     size += sizeof(uint32_t) * (row_nums_ + 1) + MMAP_STRING_PADDING;
+    if (auto dict_size = try_dict_encode(size)) {
+        size = dict_size;
+    }
     return {size, row_nums_};
 }
 
+size_t
+StringChunkWriter::try_dict_encode(size_t plain_size) {
+    dict_.clear();
+    codes_.clear();
+    code_width_ = 0;
+    auto min_rows_per_value = DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE.load();
+    if (min_rows_per_value <= 0 ||
+        static_cast<int64_t>(row_nums_) < min_rows_per_value) {
+        return 0;
+    }
+    size_t max_values = row_nums_ / min_rows_per_value;
+    for (const auto& str : strs_) {
+        if (codes_.emplace(str, 0).second && codes_.size() > max_values) {
+            codes_.clear();
+            return 0;
+        }
+    }
+
+    dict_.reserve(codes_.size());
+    size_t dict_bytes = 0;
+    for (const auto& [str, _] : codes_) {
+        dict_.push_back(str);
+        dict_bytes += str.size();
+    }
+    std::sort(dict_.begin(), dict_.end());
+    for (size_t code = 0; code < dict_.size(); code++) {
+        codes_[dict_[code]] = code;
+    }
+    code_width_ = dict_.size() <= (1 << 8)    ? 1
+                  : dict_.size() <= (1 << 16) ? 2
+                                              : 4;
+
+    size_t size = nullable_ ? (row_nums_ + 7) / 8 : 0;
+    size += sizeof(uint32_t) *
+                (StringChunk::kDictHeaderWords + dict_.size() + 1) +
+            dict_bytes;
+    // the codes are aligned to their width
+    size = (size + code_width_ - 1) / code_width_ * code_width_;
+    size += code_width_ * row_nums_ + MMAP_STRING_PADDING;
+    if (size >= plain_size) {
+        dict_.clear();
+        codes_.clear();
+        code_width_ = 0;
+        return 0;
+    }
+    return size;
+}
+
+void
+StringChunkWriter::write_dict_to_target(
+    const std::shared_ptr<ChunkTarget>& target) {
+    const uint32_t null_bitmap_bytes =
+        nullable_ ? static_cast<uint32_t>((row_nums_ + 7) / 8) : 0;
+    const uint32_t dict_size = dict_.size();
+    uint32_t pos =
+        null_bitmap_bytes +
+        sizeof(uint32_t) * (StringChunk::kDictHeaderWords + dict_size + 1);
+    std::vector<uint32_t> dict_offsets;
+    dict_offsets.reserve(dict_size + 1);
+    for (const auto& str : dict_) {
+        dict_offsets.push_back(pos);
+        pos += str.size();
+    }
+    dict_offsets.push_back(pos);
+    const uint32_t codes_offset =
+        (pos + code_width_ - 1) / code_width_ * code_width_;
+
+    uint32_t header[StringChunk::kDictHeaderWords] = {
+        0, dict_size, code_width_, codes_offset};
+    target->write(header, sizeof(header));
+    target->write(dict_offsets.data(), dict_offsets.size() * sizeof(uint32_t));
+    for (const auto& str : dict_) {
+        target->write(str.data(), str.size());
+    }
+    // codes are aligned to their width
+    char align[sizeof(uint32_t)] = {};
+    target->write(align, codes_offset - pos);
+
+    auto write_codes = [&](auto code_type) {
+        using Code = decltype(code_type);
+        std::vector<Code> codes;
+        codes.reserve(strs_.size());
+        for (const auto& str : strs_) {
+            codes.push_back(static_cast<Code>(codes_.at(str)));
+        }
+        target->write(codes.data(), codes.size() * sizeof(Code));
+    };
+    switch (code_width_) {
+        case 1:
+            write_codes(uint8_t{});
+            break;
+        case 2:
+            write_codes(uint16_t{});
+            break;
+        default:
+            write_codes(uint32_t{});
+            break;
+    }
+    char padding[MMAP_STRING_PADDING] = {};
+    target->write(padding, MMAP_STRING_PADDING);
+}
+
 void
 StringChunkWriter::write_to_target(const arrow::ArrayVector& array_vec,
                                    const std::shared_ptr<ChunkTarget>& target) {
-    strs_.clear();
-    strs_.reserve(row_nums_);
     // tuple <data, size, offset>
     std::vector<std::tuple<const uint8_t*, int64_t, int64_t>> null_bitmaps;
-    for (const auto& data : array_vec) {
-        // for bson, we use binary array to store the string
-        auto array = std::dynamic_pointer_cast<arrow::BinaryArray>(data);
-        for (int i = 0; i < array->length(); i++) {
-            auto str = array->GetView(i);
-            strs_.emplace_back(str);
-        }
-        if (nullable_) {
+    if (nullable_) {
+        for (const auto& data : array_vec) {
             null_bitmaps.emplace_back(
                 data->null_bitmap_data(), data->length(), data->offset());
         }
     }
 
-    // chunk layout: null bitmap, offset1, offset2, ..., offsetn, str1, str2, ..., strn, padding
     // write null bitmaps
     write_null_bit_maps(null_bitmaps, target);
+    if (code_width_ != 0) {
+        write_dict_to_target(target);
+        return;
+    }
+
+    // chunk layout: null bitmap, offset1, offset2, ..., offsetn, str1, str2, ..., strn, padding
 
     // write data
     const int offset_num = row_nums_ + 1;
@@ -761,41 +868,116 @@ make_chunk(const FieldMeta& field_meta,
     }
 }
 
-ChunkBuffer
-create_chunk_buffer(const FieldMeta& field_meta,
-                    const arrow::ArrayVector& array_vec,
+static std::shared_ptr<ChunkTarget>
+create_chunk_target(size_t size,
                     bool mmap_populate,
                     const std::string& file_path,
                     proto::common::LoadPriority load_priority) {
-    auto cw = create_chunk_writer(field_meta);
-    auto [size, row_nums] = cw->calculate_size(array_vec);
     size_t aligned_size = (size + ChunkTarget::ALIGNED_SIZE - 1) &
                           ~(ChunkTarget::ALIGNED_SIZE - 1);
-    std::shared_ptr<ChunkTarget> target;
     if (file_path.empty()) {
-        target = std::make_shared<MemChunkTarget>(aligned_size, mmap_populate);
-    } else {
-        auto io_prio = storage::io::GetPriorityFromLoadPriority(load_priority);
-        target = std::make_shared<MmapChunkTarget>(
-            file_path, mmap_populate, aligned_size, io_prio);
+        return std::make_shared<MemChunkTarget>(aligned_size, mmap_populate);
     }
-    cw->write_to_target(array_vec, target);
+    auto io_prio = storage::io::GetPriorityFromLoadPriority(load_priority);
+    return std::make_shared<MmapChunkTarget>(
+        file_path, mmap_populate, aligned_size, io_prio);
+}
+
+static ChunkBuffer
+release_chunk_buffer(const std::shared_ptr<ChunkTarget>& target,
+                     size_t size,
+                     size_t row_nums,
+                     const std::string& file_path) {
     auto data = target->release();
-    std::shared_ptr<ChunkMmapGuard> chunk_mmap_guard = nullptr;
-    if (!file_path.empty()) {
-        chunk_mmap_guard =
-            std::make_shared<ChunkMmapGuard>(data, size, file_path);
-    } else {
-        chunk_mmap_guard = std::make_shared<ChunkMmapGuard>(data, size, "");
-    }
     ChunkBuffer buffer;
     buffer.data = data;
     buffer.size = size;
     buffer.row_nums = row_nums;
-    buffer.guard = std::move(chunk_mmap_guard);
+    buffer.guard = std::make_shared<ChunkMmapGuard>(data, size, file_path);
     return buffer;
 }
 
+ChunkBuffer
+create_chunk_buffer(const FieldMeta& field_meta,
+                    const arrow::ArrayVector& array_vec,
+                    bool mmap_populate,
+                    const std::string& file_path,
+                    proto::common::LoadPriority load_priority) {
+    auto cw = create_chunk_writer(field_meta);
+    auto [size, row_nums] = cw->calculate_size(array_vec);
+    if (file_path.empty()) {
+        if (auto borrowed = cw->borrow_buffer(array_vec)) {
+            ChunkBuffer buffer;
+            buffer.data = reinterpret_cast<char*>(
+                const_cast<uint8_t*>(borrowed->data()));
+            buffer.size = size;
+            buffer.row_nums = row_nums;
+            buffer.guard = std::make_shared<ChunkMmapGuard>(
+                std::shared_ptr<const void>(std::move(borrowed)));
+            return buffer;
+        }
+    }
+    auto target =
+        create_chunk_target(size, mmap_populate, file_path, load_priority);
+    cw->write_to_target(array_vec, target);
+    return release_chunk_buffer(target, size, row_nums, file_path);
+}
+
+std::unique_ptr<Chunk>
+create_chunk_from_reader(const FieldMeta& field_meta,
+                         const ArrowDataWrapper& data,
+                         bool mmap_populate,
+                         const std::string& file_path,
+                         proto::common::LoadPriority load_priority,
+                         milvus::OpContext* op_ctx) {
+    auto cw = create_chunk_writer(field_meta);
+    int64_t num_rows = data.arrow_reader == nullptr
+                           ? 0
+                           : data.arrow_reader->parquet_reader()
+                                 ->metadata()
+                                 ->num_rows();
+    auto size =
+        num_rows > 0 ? cw->calculate_fixed_size(num_rows) : std::nullopt;
+    // in memory the column is decoded at once, so the chunk can borrow it
+    if (!size.has_value() || file_path.empty()) {
+        return create_chunk(field_meta,
+                            read_single_column_batches(data.reader),
+                            mmap_populate,
+                            file_path,
+                            load_priority);
+    }
+
+    auto row_size = std::max<size_t>(size.value() / num_rows, 1);
+    data.arrow_reader->set_batch_size(
+        std::max<size_t>(STREAM_BATCH_BYTES / row_size, 1));
+    std::shared_ptr<arrow::RecordBatchReader> reader;
+    auto st = data.arrow_reader->GetRecordBatchReader(&reader);
+    AssertInfo(st.ok(), "get record batch reader failed: {}", st.ToString());
+
+    auto target = create_chunk_target(
+        size.value(), mmap_populate, file_path, load_priority);
+    for (auto batch : *reader) {
+        if (op_ctx && op_ctx->cancellation_token.isCancellationRequested()) {
+            ThrowInfo(ErrorCode::FollyCancel,
+                      "create chunk of field {} cancelled",
+                      field_meta.get_id().get());
+        }
+        AssertInfo(batch.ok(),
+                   "read record batch failed: {}",
+                   batch.status().ToString());
+        cw->write_to_target({batch.ValueOrDie()->column(0)}, target);
+    }
+    AssertInfo(target->tell() == size.value(),
+               "the written size {} of field {} does not match the expected "
+               "size {}",
+               target->tell(),
+               field_meta.get_id().get(),
+               size.value());
+    auto buffer =
+        release_chunk_buffer(target, size.value(), num_rows, file_path);
+    return make_chunk_from_buffer(field_meta, buffer, 0);
+}
+
 std::unique_ptr<Chunk>
 make_chunk_from_buffer(const FieldMeta& field_meta,
                        const ChunkBuffer& buffer,
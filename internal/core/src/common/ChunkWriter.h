@@ -13,14 +13,18 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 #include "arrow/array/array_primitive.h"
+#include "ankerl/unordered_dense.h"
 #include "arrow/type_fwd.h"
+#include "common/ArrowDataWrapper.h"
 #include "common/ChunkTarget.h"
 #include "arrow/record_batch.h"
 #include "common/Chunk.h"
 #include "common/Json.h"
+#include "common/OpContext.h"
 #include "pb/common.pb.h"
 
 namespace milvus {
@@ -36,6 +40,22 @@ class ChunkWriterBase {
     write_to_target(const arrow::ArrayVector& array_vec,
                     const std::shared_ptr<ChunkTarget>& target) = 0;
 
+    // Returns the size of the chunk of num_rows rows if it does not depend on
+    // the values, so the chunk can be written a batch at a time as it is
+    // decoded, nullopt otherwise.
+    virtual std::optional<size_t>
+    calculate_fixed_size(int64_t num_rows) {
+        return std::nullopt;
+    }
+
+    // Returns the arrow buffer already laid out as the chunk of array_vec, so
+    // an in-memory chunk can borrow it instead of copying, nullptr if the
+    // data has to be written to a target.
+    virtual std::shared_ptr<arrow::Buffer>
+    borrow_buffer(const arrow::ArrayVector& array_vec) {
+        return nullptr;
+    }
+
  protected:
     void
     write_null_bit_maps(
@@ -102,6 +122,16 @@ class ChunkWriter final : public ChunkWriterBase {
         return {size, row_nums};
     }
 
+    std::optional<size_t>
+    calculate_fixed_size(int64_t num_rows) override {
+        // the null bitmap leads the chunk, it needs every batch first
+        if (nullable_) {
+            return std::nullopt;
+        }
+        row_nums_ = num_rows;
+        return num_rows * dim_ * sizeof(T);
+    }
+
     void
     write_to_target(const arrow::ArrayVector& array_vec,
                     const std::shared_ptr<ChunkTarget>& target) override {
@@ -127,6 +157,16 @@ class ChunkWriter final : public ChunkWriterBase {
         }
     }
 
+    std::shared_ptr<arrow::Buffer>
+    borrow_buffer(const arrow::ArrayVector& array_vec) override {
+        // the values of a single array without nulls are the chunk as is
+        if (nullable_ || array_vec.size() != 1 ||
+            array_vec[0]->length() == 0 || array_vec[0]->offset() != 0) {
+            return nullptr;
+        }
+        return array_vec[0]->data()->buffers[1];
+    }
+
  private:
     const int64_t dim_;
 };
@@ -182,6 +222,14 @@ class NullableVectorChunkWriter final : public ChunkWriterBase {
     const int64_t dim_;
 };
 
+// booleans are bit packed in arrow but a byte each in the chunk
+template <>
+inline std::shared_ptr<arrow::Buffer>
+ChunkWriter<arrow::BooleanArray, bool>::borrow_buffer(
+    const arrow::ArrayVector& array_vec) {
+    return nullptr;
+}
+
 template <>
 inline void
 ChunkWriter<arrow::BooleanArray, bool>::write_to_target(
@@ -218,7 +266,20 @@ class StringChunkWriter : public ChunkWriterBase {
                     const std::shared_ptr<ChunkTarget>& target) override;
 
  private:
+    // Picks the dictionary encoded layout when the rows repeat few enough
+    // values for it to be smaller, returns its size or 0.
+    size_t
+    try_dict_encode(size_t plain_size);
+
+    void
+    write_dict_to_target(const std::shared_ptr<ChunkTarget>& target);
+
     std::vector<std::string_view> strs_;
+    // the sorted distinct strings and the code of each, set when the chunk
+    // is dictionary encoded
+    std::vector<std::string_view> dict_;
+    ankerl::unordered_dense::map<std::string_view, uint32_t> codes_;
+    uint32_t code_width_{0};
 };
 
 class JSONChunkWriter : public ChunkWriterBase {
@@ -341,6 +402,23 @@ create_group_chunk(const std::vector<FieldId>& field_ids,
                    proto::common::LoadPriority load_priority =
                        proto::common::LoadPriority::HIGH);
 
+// the decoded bytes create_chunk_from_reader holds at a time
+constexpr size_t STREAM_BATCH_BYTES = 16 * 1024 * 1024;  // 16MB
+
+// Creates the chunk of the column read by data, decoding a batch at a time
+// straight into the mmap'd target when the chunk size is known from the row
+// count, so the decoded column is never held in memory as a whole. Other
+// columns and in-memory chunks go through create_chunk. A cancellation of
+// op_ctx is checked between the batches, the partial chunk is dropped.
+std::unique_ptr<Chunk>
+create_chunk_from_reader(const FieldMeta& field_meta,
+                         const ArrowDataWrapper& data,
+                         bool mmap_populate = true,
+                         const std::string& file_path = "",
+                         proto::common::LoadPriority load_priority =
+                             proto::common::LoadPriority::HIGH,
+                         milvus::OpContext* op_ctx = nullptr);
+
 arrow::ArrayVector
 read_single_column_batches(std::shared_ptr<arrow::RecordBatchReader> reader);
 
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 #include <random>
 
@@ -33,6 +34,8 @@
 using milvus::DataType;
 using milvus::MemChunkTarget;
 using milvus::MMAP_ARRAY_PADDING;
+using milvus::StringChunk;
+using milvus::StringChunkWriter;
 using milvus::VectorArrayChunk;
 using milvus::VectorArrayChunkWriter;
 
@@ -374,3 +377,78 @@ INSTANTIATE_TEST_SUITE_P(
     [](const ::testing::TestParamInfo<VectorArrayWriterTestParam>& info) {
         return info.param.test_name;
     });
+
+namespace {
+
+std::unique_ptr<StringChunk>
+WriteStringChunk(const std::shared_ptr<arrow::StringArray>& array,
+                 bool nullable) {
+    arrow::ArrayVector vec{array};
+    StringChunkWriter writer(nullable);
+    auto [size, row_nums] = writer.calculate_size(vec);
+    auto target = std::make_shared<MemChunkTarget>(size);
+    writer.write_to_target(vec, target);
+    EXPECT_EQ(target->tell(), size);
+    return std::make_unique<StringChunk>(
+        row_nums, target->release(), size, nullable, nullptr);
+}
+
+}  // namespace
+
+TEST(StringChunkWriterTest, DictEncodesFewDistinctValues) {
+    int64_t num_rows = 1000;
+    std::vector<std::string> values = {"pear", "apple", "", "banana"};
+    arrow::StringBuilder builder;
+    for (int64_t i = 0; i < num_rows; ++i) {
+        if (i % 7 == 0) {
+            ASSERT_TRUE(builder.AppendNull().ok());
+        } else {
+            ASSERT_TRUE(builder.Append(values[i % values.size()]).ok());
+        }
+    }
+    std::shared_ptr<arrow::StringArray> array;
+    ASSERT_TRUE(builder.Finish(&array).ok());
+
+    auto chunk = WriteStringChunk(array, true);
+    ASSERT_TRUE(chunk->IsDictEncoded());
+    EXPECT_EQ(chunk->DictSize(), values.size());
+    EXPECT_EQ(chunk->CodeWidth(), 1);
+    // the dictionary is sorted, so codes compare as the strings
+    for (uint32_t code = 1; code < chunk->DictSize(); ++code) {
+        EXPECT_LT(chunk->DictValue(code - 1), chunk->DictValue(code));
+    }
+
+    auto [views, valid] = chunk->StringViews(std::nullopt);
+    ASSERT_EQ(views.size(), num_rows);
+    milvus::FixedVector<int32_t> offsets;
+    for (int64_t i = 0; i < num_rows; ++i) {
+        EXPECT_EQ(chunk->isValid(i), i % 7 != 0);
+        EXPECT_EQ(valid[i], i % 7 != 0);
+        if (i % 7 != 0) {
+            EXPECT_EQ((*chunk)[i], values[i % values.size()]);
+            EXPECT_EQ(views[i], values[i % values.size()]);
+            offsets.push_back(i);
+        }
+    }
+    auto [picked, picked_valid] = chunk->ViewsByOffsets(offsets);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        EXPECT_EQ(picked[i], values[offsets[i] % values.size()]);
+        EXPECT_TRUE(picked_valid[i]);
+    }
+}
+
+TEST(StringChunkWriterTest, KeepsDistinctValuesPlain) {
+    int64_t num_rows = 1000;
+    arrow::StringBuilder builder;
+    for (int64_t i = 0; i < num_rows; ++i) {
+        ASSERT_TRUE(builder.Append("value_" + std::to_string(i)).ok());
+    }
+    std::shared_ptr<arrow::StringArray> array;
+    ASSERT_TRUE(builder.Finish(&array).ok());
+
+    auto chunk = WriteStringChunk(array, false);
+    EXPECT_FALSE(chunk->IsDictEncoded());
+    for (int64_t i = 0; i < num_rows; ++i) {
+        EXPECT_EQ((*chunk)[i], "value_" + std::to_string(i));
+    }
+}
@@ -24,6 +24,12 @@ std::atomic<int64_t> FILE_SLICE_SIZE(DEFAULT_INDEX_FILE_SLICE_SIZE);
 std::atomic<int64_t> EXEC_EVAL_EXPR_BATCH_SIZE(
     DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE);
 std::atomic<int64_t> DELETE_DUMP_BATCH_SIZE(DEFAULT_DELETE_DUMP_BATCH_SIZE);
+std::atomic<int64_t> EXEC_AGG_SPILL_MEMORY_LIMIT(
+    DEFAULT_EXEC_AGG_SPILL_MEMORY_LIMIT);
+std::atomic<int64_t> EXEC_EVAL_EXPR_PARALLEL_DEGREE(
+    DEFAULT_EXEC_EVAL_EXPR_PARALLEL_DEGREE);
+std::atomic<bool> EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE(
+    DEFAULT_EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE);
 std::atomic<bool> ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION(
     DEFAULT_ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION);
 std::atomic<bool> OPTIMIZE_EXPR_ENABLED(DEFAULT_OPTIMIZE_EXPR_ENABLED);
@@ -34,6 +40,51 @@ std::atomic<bool> CONFIG_PARAM_TYPE_CHECK_ENABLED(
     DEFAULT_CONFIG_PARAM_TYPE_CHECK_ENABLED);
 std::atomic<bool> ENABLE_PARQUET_STATS_SKIP_INDEX(
     DEFAULT_ENABLE_PARQUET_STATS_SKIP_INDEX);
+std::atomic<int64_t> SKIPINDEX_PAGE_ROWS(DEFAULT_SKIPINDEX_PAGE_ROWS);
+std::atomic<int64_t> REMOTE_READ_RANGE_SIZE(DEFAULT_REMOTE_READ_RANGE_SIZE);
+std::atomic<int64_t> REMOTE_READ_AHEAD_RANGES(
+    DEFAULT_REMOTE_READ_AHEAD_RANGES);
+std::atomic<int64_t> SEGMENT_LOAD_MAX_TASKS(DEFAULT_SEGMENT_LOAD_MAX_TASKS);
+std::atomic<int64_t> SEGMENT_LOAD_MEMORY_BUDGET(
+    DEFAULT_SEGMENT_LOAD_MEMORY_BUDGET);
+std::atomic<int64_t> QUERY_MEMORY_BUDGET(DEFAULT_QUERY_MEMORY_BUDGET);
+std::atomic<int64_t> EXEC_PROFILE_SAMPLE_INTERVAL(
+    DEFAULT_EXEC_PROFILE_SAMPLE_INTERVAL);
+std::atomic<int64_t> DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE(
+    DEFAULT_DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE);
+std::atomic<bool> CHUNK_HUGE_PAGE_ENABLED(DEFAULT_CHUNK_HUGE_PAGE_ENABLED);
+std::atomic<bool> CHUNK_NUMA_INTERLEAVE_ENABLED(
+    DEFAULT_CHUNK_NUMA_INTERLEAVE_ENABLED);
+std::atomic<int64_t> SEARCH_PLAN_CACHE_CAPACITY(
+    DEFAULT_SEARCH_PLAN_CACHE_CAPACITY);
+std::atomic<int64_t> STREAMED_VECTOR_INDEX_TRAIN_ROWS(
+    DEFAULT_STREAMED_VECTOR_INDEX_TRAIN_ROWS);
+std::atomic<int64_t> GEOMETRY_CACHE_DECODED_CAPACITY(
+    DEFAULT_GEOMETRY_CACHE_DECODED_CAPACITY);
+std::atomic<int64_t> RESCORE_MAX_TOPK_FACTOR(DEFAULT_RESCORE_MAX_TOPK_FACTOR);
+std::atomic<int64_t> KMEANS_MINI_BATCH_SIZE(DEFAULT_KMEANS_MINI_BATCH_SIZE);
+std::atomic<int64_t> KMEANS_ASSIGN_PARALLELISM(
+    DEFAULT_KMEANS_ASSIGN_PARALLELISM);
+std::atomic<int64_t> FILTER_SELECTIVITY_SAMPLE_ROWS(
+    DEFAULT_FILTER_SELECTIVITY_SAMPLE_ROWS);
+std::atomic<double> ITERATIVE_FILTER_MIN_PASS_RATE(
+    DEFAULT_ITERATIVE_FILTER_MIN_PASS_RATE);
+std::atomic<double> ITERATIVE_FILTER_AUTO_PASS_RATE(
+    DEFAULT_ITERATIVE_FILTER_AUTO_PASS_RATE);
+std::atomic<double> RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR(
+    DEFAULT_RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR);
+std::atomic<int64_t> NGRAM_INDEX_BUILD_THREADS(
+    DEFAULT_NGRAM_INDEX_BUILD_THREADS);
+std::atomic<bool> QUERY_ASYNC_PRELOAD_ENABLED(
+    DEFAULT_QUERY_ASYNC_PRELOAD_ENABLED);
+std::atomic<bool> JEMALLOC_ARENA_PARTITION_ENABLED(
+    DEFAULT_JEMALLOC_ARENA_PARTITION_ENABLED);
+std::atomic<int64_t> JEMALLOC_TRANSIENT_ARENA_DECAY_MS(
+    DEFAULT_JEMALLOC_TRANSIENT_ARENA_DECAY_MS);
+std::atomic<int64_t> PACKED_WRITER_ASYNC_MEMORY_LIMIT(
+    DEFAULT_PACKED_WRITER_ASYNC_MEMORY_LIMIT);
+std::atomic<bool> INTERIM_INDEX_DISK_CACHE_ENABLED(
+    DEFAULT_INTERIM_INDEX_DISK_CACHE_ENABLED);
 
 void
 SetIndexSliceSize(const int64_t size) {
@@ -55,6 +106,27 @@ SetDefaultDeleteDumpBatchSize(int64_t val) {
              DELETE_DUMP_BATCH_SIZE.load());
 }
 
+void
+SetDefaultAggSpillMemoryLimit(int64_t bytes) {
+    EXEC_AGG_SPILL_MEMORY_LIMIT.store(bytes);
+    LOG_INFO("set default aggregation spill memory limit (byte): {}",
+             EXEC_AGG_SPILL_MEMORY_LIMIT.load());
+}
+
+void
+SetDefaultExprEvalParallelDegree(int64_t val) {
+    EXEC_EVAL_EXPR_PARALLEL_DEGREE.store(val);
+    LOG_INFO("set default expr eval parallel degree: {}",
+             EXEC_EVAL_EXPR_PARALLEL_DEGREE.load());
+}
+
+void
+SetDefaultExprEvalAdaptiveBatchSize(bool val) {
+    EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE.store(val);
+    LOG_INFO("set default expr eval adaptive batch size: {}",
+             EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE.load());
+}
+
 void
 SetDefaultOptimizeExprEnable(bool val) {
     OPTIMIZE_EXPR_ENABLED.store(val);
@@ -83,6 +155,188 @@ SetDefaultEnableParquetStatsSkipIndex(bool val) {
              ENABLE_PARQUET_STATS_SKIP_INDEX.load());
 }
 
+void
+SetDefaultSkipIndexPageRows(int64_t val) {
+    SKIPINDEX_PAGE_ROWS.store(val);
+    LOG_INFO("set default skip index page rows: {}",
+             SKIPINDEX_PAGE_ROWS.load());
+}
+
+void
+SetDefaultRemoteReadRangeSize(int64_t bytes) {
+    REMOTE_READ_RANGE_SIZE.store(bytes);
+    LOG_INFO("set default remote read range size (byte): {}",
+             REMOTE_READ_RANGE_SIZE.load());
+}
+
+void
+SetDefaultRemoteReadAheadRanges(int64_t val) {
+    REMOTE_READ_AHEAD_RANGES.store(val);
+    LOG_INFO("set default remote read ahead ranges: {}",
+             REMOTE_READ_AHEAD_RANGES.load());
+}
+
+void
+SetDefaultSegmentLoadMaxTasks(int64_t val) {
+    SEGMENT_LOAD_MAX_TASKS.store(val);
+    LOG_INFO("set default segment load max tasks: {}",
+             SEGMENT_LOAD_MAX_TASKS.load());
+}
+
+void
+SetDefaultSegmentLoadMemoryBudget(int64_t bytes) {
+    SEGMENT_LOAD_MEMORY_BUDGET.store(bytes);
+    LOG_INFO("set default segment load memory budget (byte): {}",
+             SEGMENT_LOAD_MEMORY_BUDGET.load());
+}
+
+void
+SetDefaultQueryMemoryBudget(int64_t bytes) {
+    QUERY_MEMORY_BUDGET.store(bytes);
+    LOG_INFO("set default query memory budget (byte): {}",
+             QUERY_MEMORY_BUDGET.load());
+}
+
+void
+SetDefaultExecProfileSampleInterval(int64_t val) {
+    EXEC_PROFILE_SAMPLE_INTERVAL.store(val);
+    LOG_INFO("set default exec profile sample interval: {}",
+             EXEC_PROFILE_SAMPLE_INTERVAL.load());
+}
+
+void
+SetDefaultDictStringChunkMinRowsPerValue(int64_t val) {
+    DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE.store(val);
+    LOG_INFO("set default dict string chunk min rows per value: {}",
+             DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE.load());
+}
+
+void
+SetDefaultChunkHugePageEnabled(bool val) {
+    CHUNK_HUGE_PAGE_ENABLED.store(val);
+    LOG_INFO("set default chunk huge page enabled: {}",
+             CHUNK_HUGE_PAGE_ENABLED.load());
+}
+
+void
+SetDefaultChunkNumaInterleaveEnabled(bool val) {
+    CHUNK_NUMA_INTERLEAVE_ENABLED.store(val);
+    LOG_INFO("set default chunk numa interleave enabled: {}",
+             CHUNK_NUMA_INTERLEAVE_ENABLED.load());
+}
+
+void
+SetDefaultSearchPlanCacheCapacity(int64_t val) {
+    SEARCH_PLAN_CACHE_CAPACITY.store(val);
+    LOG_INFO("set default search plan cache capacity: {}",
+             SEARCH_PLAN_CACHE_CAPACITY.load());
+}
+
+void
+SetDefaultStreamedVectorIndexTrainRows(int64_t val) {
+    STREAMED_VECTOR_INDEX_TRAIN_ROWS.store(val);
+    LOG_INFO("set default streamed vector index train rows: {}",
+             STREAMED_VECTOR_INDEX_TRAIN_ROWS.load());
+}
+
+void
+SetDefaultGeometryCacheDecodedCapacity(int64_t val) {
+    GEOMETRY_CACHE_DECODED_CAPACITY.store(val);
+    LOG_INFO("set default geometry cache decoded capacity: {}",
+             GEOMETRY_CACHE_DECODED_CAPACITY.load());
+}
+
+void
+SetDefaultRescoreMaxTopkFactor(int64_t val) {
+    RESCORE_MAX_TOPK_FACTOR.store(val);
+    LOG_INFO("set default rescore max topk factor: {}",
+             RESCORE_MAX_TOPK_FACTOR.load());
+}
+
+void
+SetDefaultKmeansMiniBatchSize(int64_t val) {
+    KMEANS_MINI_BATCH_SIZE.store(val);
+    LOG_INFO("set default kmeans mini batch size: {}",
+             KMEANS_MINI_BATCH_SIZE.load());
+}
+
+void
+SetDefaultKmeansAssignParallelism(int64_t val) {
+    KMEANS_ASSIGN_PARALLELISM.store(val);
+    LOG_INFO("set default kmeans assign parallelism: {}",
+             KMEANS_ASSIGN_PARALLELISM.load());
+}
+
+void
+SetDefaultFilterSelectivitySampleRows(int64_t val) {
+    FILTER_SELECTIVITY_SAMPLE_ROWS.store(val);
+    LOG_INFO("set default filter selectivity sample rows: {}",
+             FILTER_SELECTIVITY_SAMPLE_ROWS.load());
+}
+
+void
+SetDefaultIterativeFilterMinPassRate(double val) {
+    ITERATIVE_FILTER_MIN_PASS_RATE.store(val);
+    LOG_INFO("set default iterative filter min pass rate: {}",
+             ITERATIVE_FILTER_MIN_PASS_RATE.load());
+}
+
+void
+SetDefaultIterativeFilterAutoPassRate(double val) {
+    ITERATIVE_FILTER_AUTO_PASS_RATE.store(val);
+    LOG_INFO("set default iterative filter auto pass rate: {}",
+             ITERATIVE_FILTER_AUTO_PASS_RATE.load());
+}
+
+void
+SetDefaultRandomSampleFilterFirstMaxFactor(double val) {
+    RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR.store(val);
+    LOG_INFO("set default random sample filter first max factor: {}",
+             RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR.load());
+}
+
+void
+SetDefaultNgramIndexBuildThreads(int64_t val) {
+    NGRAM_INDEX_BUILD_THREADS.store(val);
+    LOG_INFO("set default ngram index build threads: {}",
+             NGRAM_INDEX_BUILD_THREADS.load());
+}
+
+void
+SetDefaultQueryAsyncPreloadEnabled(bool val) {
+    QUERY_ASYNC_PRELOAD_ENABLED.store(val);
+    LOG_INFO("set default query async preload enabled: {}",
+             QUERY_ASYNC_PRELOAD_ENABLED.load());
+}
+
+void
+SetDefaultJemallocArenaPartitionEnabled(bool val) {
+    JEMALLOC_ARENA_PARTITION_ENABLED.store(val);
+    LOG_INFO("set default jemalloc arena partition enabled: {}",
+             JEMALLOC_ARENA_PARTITION_ENABLED.load());
+}
+
+void
+SetDefaultJemallocTransientArenaDecayMs(int64_t val) {
+    JEMALLOC_TRANSIENT_ARENA_DECAY_MS.store(val);
+    LOG_INFO("set default jemalloc transient arena decay ms: {}",
+             JEMALLOC_TRANSIENT_ARENA_DECAY_MS.load());
+}
+
+void
+SetDefaultPackedWriterAsyncMemoryLimit(int64_t val) {
+    PACKED_WRITER_ASYNC_MEMORY_LIMIT.store(val);
+    LOG_INFO("set default packed writer async memory limit: {}",
+             PACKED_WRITER_ASYNC_MEMORY_LIMIT.load());
+}
+
+void
+SetDefaultInterimIndexDiskCacheEnabled(bool val) {
+    INTERIM_INDEX_DISK_CACHE_ENABLED.store(val);
+    LOG_INFO("set default interim index disk cache enabled: {}",
+             INTERIM_INDEX_DISK_CACHE_ENABLED.load());
+}
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val) {
     ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION.store(val);
@@ -28,11 +28,40 @@ namespace milvus {
 extern std::atomic<int64_t> FILE_SLICE_SIZE;
 extern std::atomic<int64_t> EXEC_EVAL_EXPR_BATCH_SIZE;
 extern std::atomic<int64_t> DELETE_DUMP_BATCH_SIZE;
+extern std::atomic<int64_t> EXEC_AGG_SPILL_MEMORY_LIMIT;
+extern std::atomic<int64_t> EXEC_EVAL_EXPR_PARALLEL_DEGREE;
+extern std::atomic<bool> EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE;
 extern std::atomic<bool> ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION;
 extern std::atomic<bool> OPTIMIZE_EXPR_ENABLED;
 extern std::atomic<bool> GROWING_JSON_KEY_STATS_ENABLED;
 extern std::atomic<bool> CONFIG_PARAM_TYPE_CHECK_ENABLED;
 extern std::atomic<bool> ENABLE_PARQUET_STATS_SKIP_INDEX;
+extern std::atomic<int64_t> SKIPINDEX_PAGE_ROWS;
+extern std::atomic<int64_t> REMOTE_READ_RANGE_SIZE;
+extern std::atomic<int64_t> REMOTE_READ_AHEAD_RANGES;
+extern std::atomic<int64_t> SEGMENT_LOAD_MAX_TASKS;
+extern std::atomic<int64_t> SEGMENT_LOAD_MEMORY_BUDGET;
+extern std::atomic<int64_t> QUERY_MEMORY_BUDGET;
+extern std::atomic<int64_t> EXEC_PROFILE_SAMPLE_INTERVAL;
+extern std::atomic<int64_t> DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE;
+extern std::atomic<bool> CHUNK_HUGE_PAGE_ENABLED;
+extern std::atomic<bool> CHUNK_NUMA_INTERLEAVE_ENABLED;
+extern std::atomic<int64_t> SEARCH_PLAN_CACHE_CAPACITY;
+extern std::atomic<int64_t> STREAMED_VECTOR_INDEX_TRAIN_ROWS;
+extern std::atomic<int64_t> GEOMETRY_CACHE_DECODED_CAPACITY;
+extern std::atomic<int64_t> RESCORE_MAX_TOPK_FACTOR;
+extern std::atomic<int64_t> KMEANS_MINI_BATCH_SIZE;
+extern std::atomic<int64_t> KMEANS_ASSIGN_PARALLELISM;
+extern std::atomic<int64_t> FILTER_SELECTIVITY_SAMPLE_ROWS;
+extern std::atomic<double> ITERATIVE_FILTER_MIN_PASS_RATE;
+extern std::atomic<double> ITERATIVE_FILTER_AUTO_PASS_RATE;
+extern std::atomic<double> RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR;
+extern std::atomic<int64_t> NGRAM_INDEX_BUILD_THREADS;
+extern std::atomic<bool> QUERY_ASYNC_PRELOAD_ENABLED;
+extern std::atomic<bool> JEMALLOC_ARENA_PARTITION_ENABLED;
+extern std::atomic<int64_t> JEMALLOC_TRANSIENT_ARENA_DECAY_MS;
+extern std::atomic<int64_t> PACKED_WRITER_ASYNC_MEMORY_LIMIT;
+extern std::atomic<bool> INTERIM_INDEX_DISK_CACHE_ENABLED;
 
 void
 SetIndexSliceSize(const int64_t size);
@@ -43,6 +72,15 @@ SetDefaultExecEvalExprBatchSize(int64_t val);
 void
 SetDefaultDeleteDumpBatchSize(int64_t val);
 
+void
+SetDefaultAggSpillMemoryLimit(int64_t bytes);
+
+void
+SetDefaultExprEvalParallelDegree(int64_t val);
+
+void
+SetDefaultExprEvalAdaptiveBatchSize(bool val);
+
 void
 SetDefaultOptimizeExprEnable(bool val);
 
@@ -55,6 +93,84 @@ SetDefaultConfigParamTypeCheck(bool val);
 void
 SetDefaultEnableParquetStatsSkipIndex(bool val);
 
+void
+SetDefaultSkipIndexPageRows(int64_t val);
+
+void
+SetDefaultRemoteReadRangeSize(int64_t bytes);
+
+void
+SetDefaultRemoteReadAheadRanges(int64_t val);
+
+void
+SetDefaultSegmentLoadMaxTasks(int64_t val);
+
+void
+SetDefaultSegmentLoadMemoryBudget(int64_t bytes);
+
+void
+SetDefaultQueryMemoryBudget(int64_t bytes);
+
+void
+SetDefaultExecProfileSampleInterval(int64_t val);
+
+void
+SetDefaultDictStringChunkMinRowsPerValue(int64_t val);
+
+void
+SetDefaultChunkHugePageEnabled(bool val);
+
+void
+SetDefaultChunkNumaInterleaveEnabled(bool val);
+
+void
+SetDefaultSearchPlanCacheCapacity(int64_t val);
+
+void
+SetDefaultStreamedVectorIndexTrainRows(int64_t val);
+
+void
+SetDefaultGeometryCacheDecodedCapacity(int64_t val);
+
+void
+SetDefaultRescoreMaxTopkFactor(int64_t val);
+
+void
+SetDefaultKmeansMiniBatchSize(int64_t val);
+
+void
+SetDefaultKmeansAssignParallelism(int64_t val);
+
+void
+SetDefaultFilterSelectivitySampleRows(int64_t val);
+
+void
+SetDefaultIterativeFilterMinPassRate(double val);
+
+void
+SetDefaultIterativeFilterAutoPassRate(double val);
+
+void
+SetDefaultRandomSampleFilterFirstMaxFactor(double val);
+
+void
+SetDefaultNgramIndexBuildThreads(int64_t val);
+
+void
+SetDefaultQueryAsyncPreloadEnabled(bool val);
+
+void
+SetDefaultJemallocArenaPartitionEnabled(bool val);
+
+void
+SetDefaultJemallocTransientArenaDecayMs(int64_t val);
+
+void
+SetDefaultPackedWriterAsyncMemoryLimit(int64_t val);
+
+void
+SetDefaultInterimIndexDiskCacheEnabled(bool val);
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val);
 
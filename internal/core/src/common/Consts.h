@@ -52,6 +52,8 @@ const char PAGE_RETAIN_ORDER[] = "page_retain_order";
 const char TEXT_LOG_ROOT_PATH[] = "text_log";
 const char ITERATIVE_FILTER[] = "iterative_filter";
 const char HINTS[] = "hints";
+// the recall a search of an interim index asks for, see RecallTuner
+const char RECALL_TARGET[] = "recall_target";
 // json stats related
 const char JSON_KEY_INDEX_LOG_ROOT_PATH[] = "json_key_index_log";
 const char NGRAM_LOG_ROOT_PATH[] = "ngram_log";
@@ -79,10 +81,87 @@ const int64_t DEFAULT_FIELD_MAX_MEMORY_LIMIT = 128 << 20;  // bytes
 
 const int64_t DEFAULT_INDEX_FILE_SLICE_SIZE = 16 << 20;  // bytes
 
+// sequential reads of remote files fetch ranges of this size in parallel
+const int64_t DEFAULT_REMOTE_READ_RANGE_SIZE = 8 << 20;  // bytes
+// at most this many ranges are fetched ahead of the reader, 1 disables it
+const int64_t DEFAULT_REMOTE_READ_AHEAD_RANGES = 8;
+
+// load tasks in flight across all the segments being loaded, bounded by
+// count and by their expected memory
+const int64_t DEFAULT_SEGMENT_LOAD_MAX_TASKS = 16;
+const int64_t DEFAULT_SEGMENT_LOAD_MEMORY_BUDGET = 2LL << 30;  // bytes
+
+// queries wait to start while the memory held by the running ones is over
+// this budget, 0 disables the admission control
+const int64_t DEFAULT_QUERY_MEMORY_BUDGET = 0;  // bytes
+
 const int64_t DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE = 8192;
+// operator calls are timed one in every interval, 0 disables the timing
+const int64_t DEFAULT_EXEC_PROFILE_SAMPLE_INTERVAL = 16;
+// string chunks are dictionary encoded when every distinct value repeats in
+// this many rows on average, 0 disables the encoding
+const int64_t DEFAULT_DICT_STRING_CHUNK_MIN_ROWS_PER_VALUE = 8;
+// in-memory chunks of at least a huge page are backed by transparent huge
+// pages, and spread over the numa nodes when interleave is enabled
+const bool DEFAULT_CHUNK_HUGE_PAGE_ENABLED = false;
+const bool DEFAULT_CHUNK_NUMA_INTERLEAVE_ENABLED = false;
+// parsed search plans kept per collection by their serialized bytes, 0
+// parses every plan
+const int64_t DEFAULT_SEARCH_PLAN_CACHE_CAPACITY = 128;
+// rows an in memory IVF or HNSW index is built on before the rest of the
+// binlogs are streamed into it batch by batch, 0 loads all rows first
+const int64_t DEFAULT_STREAMED_VECTOR_INDEX_TRAIN_ROWS = 0;
+// decoded geometries a geometry cache keeps per segment field, the rest are
+// decoded from their WKB on access, 0 decodes on every access
+const int64_t DEFAULT_GEOMETRY_CACHE_DECODED_CAPACITY = 65536;
+// a rescored search may fetch up to this many times its topk until no
+// unfetched row can be boosted into the topk, 1 rescores the topk only
+const int64_t DEFAULT_RESCORE_MAX_TOPK_FACTOR = 8;
+// bytes of sampled vectors a clustering kmeans trains on at a time, 0 trains
+// on the whole sample at once
+const int64_t DEFAULT_KMEANS_MINI_BATCH_SIZE = 0;
+// segments a clustering kmeans fetches and assigns at once
+const int64_t DEFAULT_KMEANS_ASSIGN_PARALLELISM = 4;
+// random rows a filtered search evaluates its filter on to pick the filter
+// strategy of a segment, 0 keeps the strategy of the plan
+const int64_t DEFAULT_FILTER_SELECTIVITY_SAMPLE_ROWS = 1024;
+// a search hinted to the iterative filter searches on the bitset instead
+// where fewer sampled rows pass the filter
+const double DEFAULT_ITERATIVE_FILTER_MIN_PASS_RATE = 0.01;
+// a search without a hint runs the iterative filter where at least this many
+// sampled rows pass the filter, 0 never does
+const double DEFAULT_ITERATIVE_FILTER_AUTO_PASS_RATE = 0;
+// a filtered random sample of at most this factor draws the sampled rows
+// first and evaluates its filter on them only, 0 always filters every row
+const double DEFAULT_RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR = 0.01;
+// indexing threads an ngram index is built with, each writing its own
+// tantivy segment merged at the end of the build
+const int64_t DEFAULT_NGRAM_INDEX_BUILD_THREADS = 4;
+// whether a search or query of a sealed segment issues the loads of the
+// fields its filter scans before it takes a thread
+const bool DEFAULT_QUERY_ASYNC_PRELOAD_ENABLED = false;
+// whether loads, index builds and queries allocate from jemalloc arenas of
+// their own
+const bool DEFAULT_JEMALLOC_ARENA_PARTITION_ENABLED = false;
+// how soon the load and index build arenas purge their dirty pages
+const int64_t DEFAULT_JEMALLOC_TRANSIENT_ARENA_DECAY_MS = 1000;
+// bytes of record batches the packed writers may queue for their background
+// writes, 0 writes them on the caller thread
+const int64_t DEFAULT_PACKED_WRITER_ASYNC_MEMORY_LIMIT = 0;
+// whether the interim indexes of sealed segments are kept in the local disk
+// cache and reloaded from it by later loads of the same binlogs
+const bool DEFAULT_INTERIM_INDEX_DISK_CACHE_ENABLED = false;
 
 const int64_t DEFAULT_DELETE_DUMP_BATCH_SIZE = 10000;
 
+// 0 means group-by aggregation never spills to disk
+const int64_t DEFAULT_EXEC_AGG_SPILL_MEMORY_LIMIT = 0;  // bytes
+// 1 evaluates filters of a segment on the calling thread only
+const int64_t DEFAULT_EXEC_EVAL_EXPR_PARALLEL_DEGREE = 1;
+// filters tune their batch size unless expression.eval_batch_size is set
+const bool DEFAULT_EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE = true;
+const double DEFAULT_EXEC_AGG_APPROX_PERCENTILE = 0.5;
+
 const bool DEFAULT_ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION = true;
 
 constexpr const char* COLLECTION_TTL_FIELD_KEY = "ttl_field";
@@ -113,6 +192,8 @@ const bool DEFAULT_ENABLE_PARQUET_STATS_SKIP_INDEX = false;
 // skipindex stats related
 const double DEFAULT_BLOOM_FILTER_FALSE_POSITIVE_RATE = 0.01;
 const int64_t DEFAULT_SKIPINDEX_MIN_NGRAM_LENGTH = 3;
+// rows per page zone map inside a chunk, 0 keeps only per chunk metrics
+const int64_t DEFAULT_SKIPINDEX_PAGE_ROWS = 0;
 
 // index config related
 const std::string SEGMENT_INSERT_FILES_KEY = "segment_insert_files";
@@ -0,0 +1,83 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/FrequencySketch.h"
+
+#include <algorithm>
+
+namespace milvus {
+
+namespace {
+
+constexpr uint64_t kSketchSeeds[] = {0xc3a5c85c97cb3127ULL,
+                                     0xb492b66fbe98f273ULL,
+                                     0x9ae16a3b2f90404fULL,
+                                     0xcbf29ce484222325ULL};
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(size_t expected_entries) {
+    width_ = 64;
+    while (width_ < expected_entries) {
+        width_ <<= 1;
+    }
+    counters_.assign(width_ * kDepth, 0);
+    sample_size_ = width_ * 10;
+}
+
+size_t
+FrequencySketch::Index(uint64_t hash, int row) const {
+    auto h = (hash + kSketchSeeds[row]) * kSketchSeeds[row];
+    h ^= h >> 32;
+    return row * width_ + (h & (width_ - 1));
+}
+
+void
+FrequencySketch::Increment(uint64_t hash) {
+    // conservative update, only the smallest counters grow
+    auto min = Estimate(hash);
+    if (min == kMaxCount) {
+        return;
+    }
+    for (int row = 0; row < kDepth; row++) {
+        auto& counter = counters_[Index(hash, row)];
+        if (counter == min) {
+            counter++;
+        }
+    }
+    if (++additions_ >= sample_size_) {
+        Age();
+    }
+}
+
+uint32_t
+FrequencySketch::Estimate(uint64_t hash) const {
+    uint32_t min = kMaxCount;
+    for (int row = 0; row < kDepth; row++) {
+        min = std::min<uint32_t>(min, counters_[Index(hash, row)]);
+    }
+    return min;
+}
+
+void
+FrequencySketch::Age() {
+    for (auto& counter : counters_) {
+        counter >>= 1;
+    }
+    additions_ /= 2;
+}
+
+}  // namespace milvus
@@ -0,0 +1,59 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace milvus {
+
+/**
+ * @brief FrequencySketch is a count-min sketch of 4 bit counters that
+ * estimates how often a key was accessed recently. Every counter is halved
+ * once the number of increments reaches ten times the width of the sketch,
+ * so that the estimates follow the recent popularity of the keys. It is the
+ * frequency filter of the TinyLFU admission of the caches, and is not
+ * thread safe.
+ */
+class FrequencySketch {
+ public:
+    explicit FrequencySketch(size_t expected_entries);
+
+    void
+    Increment(uint64_t hash);
+
+    uint32_t
+    Estimate(uint64_t hash) const;
+
+ private:
+    size_t
+    Index(uint64_t hash, int row) const;
+
+    void
+    Age();
+
+    static constexpr int kDepth = 4;
+    static constexpr uint8_t kMaxCount = 15;
+
+    size_t width_;
+    std::vector<uint8_t> counters_;
+    size_t additions_{0};
+    size_t sample_size_;
+};
+
+}  // namespace milvus
@@ -11,6 +11,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -18,6 +23,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/Geometry.h"
 #include "common/Types.h"
@@ -33,27 +39,108 @@ MakeCacheKey(int64_t segment_id, FieldId field_id) {
     return std::to_string(segment_id) + "_" + std::to_string(field_id.get());
 }
 
-// Vector-based Geometry cache that maintains original field data order
+// Float bounding box of a geometry, rounded outwards so it covers the double
+// envelope. Empty geometries get an inverted box that overlaps nothing.
+struct GeometryEnvelope {
+    float min_x = std::numeric_limits<float>::infinity();
+    float min_y = std::numeric_limits<float>::infinity();
+    float max_x = -std::numeric_limits<float>::infinity();
+    float max_y = -std::numeric_limits<float>::infinity();
+
+    static GeometryEnvelope
+    Of(GEOSContextHandle_t ctx, const GEOSGeometry* geometry) {
+        GeometryEnvelope envelope;
+        if (geometry == nullptr) {
+            return envelope;
+        }
+        auto empty = GEOSisEmpty_r(ctx, geometry);
+        if (empty == 1) {
+            return envelope;
+        }
+        double min_x, min_y, max_x, max_y;
+        if (empty != 0 || GEOSGeom_getXMin_r(ctx, geometry, &min_x) != 1 ||
+            GEOSGeom_getYMin_r(ctx, geometry, &min_y) != 1 ||
+            GEOSGeom_getXMax_r(ctx, geometry, &max_x) != 1 ||
+            GEOSGeom_getYMax_r(ctx, geometry, &max_y) != 1) {
+            // unknown extent, never filter the row out
+            return Unbounded();
+        }
+        envelope.min_x = RoundDown(min_x);
+        envelope.min_y = RoundDown(min_y);
+        envelope.max_x = RoundUp(max_x);
+        envelope.max_y = RoundUp(max_y);
+        return envelope;
+    }
+
+    static GeometryEnvelope
+    Unbounded() {
+        constexpr auto inf = std::numeric_limits<float>::infinity();
+        return {-inf, -inf, inf, inf};
+    }
+
+    bool
+    IsEmpty() const {
+        return !(min_x <= max_x && min_y <= max_y);
+    }
+
+ private:
+    static float
+    RoundDown(double value) {
+        auto rounded = static_cast<float>(value);
+        return rounded > value
+                   ? std::nextafter(rounded,
+                                    -std::numeric_limits<float>::infinity())
+                   : rounded;
+    }
+
+    static float
+    RoundUp(double value) {
+        auto rounded = static_cast<float>(value);
+        return rounded < value
+                   ? std::nextafter(rounded,
+                                    std::numeric_limits<float>::infinity())
+                   : rounded;
+    }
+};
+
+// Geometry cache that maintains original field data order. Rows are kept as
+// their WKB plus an envelope, a bounded number of them decoded: a lookup
+// decodes on miss and a CLOCK sweep per shard evicts the decoded geometries
+// not touched since it last passed. The shared_ptr a lookup returns pins the
+// geometry, eviction only drops the cache's reference.
 class SimpleGeometryCache {
  public:
+    explicit SimpleGeometryCache(
+        int64_t decoded_capacity = GEOMETRY_CACHE_DECODED_CAPACITY.load())
+        : shard_capacity_(decoded_capacity > 0
+                              ? std::max<size_t>(
+                                    1, decoded_capacity / kNumDecodedShards)
+                              : 0) {
+    }
+
     // Append WKB data during field loading
     void
     AppendData(GEOSContextHandle_t ctx, const char* wkb_data, size_t size) {
         std::lock_guard<std::shared_mutex> lock(mutex_);
+        ctx_ = ctx;
 
         if (size == 0 || wkb_data == nullptr) {
-            // Handle null/empty geometry - add invalid geometry
-            geometries_.emplace_back();
+            // Handle null/empty geometry - no WKB, invalid geometry
+            AppendEnvelope(GeometryEnvelope());
         } else {
             try {
-                // Create geometry with cache's context
-                geometries_.emplace_back(ctx, wkb_data, size);
+                // decode once to validate the WKB and take its envelope
+                Geometry geometry(ctx, wkb_data, size);
+                AppendEnvelope(
+                    GeometryEnvelope::Of(ctx, geometry.GetGeometry()));
             } catch (const std::exception& e) {
                 ThrowInfo(UnexpectedError,
                           "Failed to construct geometry from WKB data: {}",
                           e.what());
             }
+            wkb_data_.append(wkb_data, size);
         }
+        wkb_offsets_.push_back(wkb_data_.size());
     }
 
     // Get shared lock for batch operations (RAII)
@@ -62,44 +149,179 @@ class SimpleGeometryCache {
         return std::shared_lock<std::shared_mutex>(mutex_);
     }
 
-    // Get Geometry by offset without locking (use with AcquireReadLock)
-    const Geometry*
+    // Get Geometry by offset without locking (use with AcquireReadLock),
+    // nullptr for a null row
+    std::shared_ptr<const Geometry>
     GetByOffsetUnsafe(size_t offset) const {
-        if (offset >= geometries_.size()) {
+        if (offset >= Rows()) {
             ThrowInfo(UnexpectedError,
                       "offset {} is out of range: {}",
                       offset,
-                      geometries_.size());
+                      Rows());
+        }
+        auto begin = wkb_offsets_[offset];
+        auto size = wkb_offsets_[offset + 1] - begin;
+        if (size == 0) {
+            return nullptr;
+        }
+        if (shard_capacity_ == 0) {
+            return std::make_shared<const Geometry>(
+                ctx_, wkb_data_.data() + begin, size);
         }
 
-        const auto& geometry = geometries_[offset];
-        return geometry.IsValid() ? &geometry : nullptr;
+        auto& shard = decoded_shards_[offset % kNumDecodedShards];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex_);
+            auto it = shard.slot_of_.find(offset);
+            if (it != shard.slot_of_.end()) {
+                auto& slot = shard.slots_[it->second];
+                slot.referenced_ = true;
+                return slot.geometry_;
+            }
+        }
+        // decode outside the shard lock, a racing decode of the same row
+        // keeps the first one published
+        auto geometry = std::make_shared<const Geometry>(
+            ctx_, wkb_data_.data() + begin, size);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto it = shard.slot_of_.find(offset);
+        if (it != shard.slot_of_.end()) {
+            return shard.slots_[it->second].geometry_;
+        }
+        size_t victim;
+        if (shard.slots_.size() < shard_capacity_) {
+            victim = shard.slots_.size();
+            shard.slots_.emplace_back();
+        } else {
+            while (shard.slots_[shard.hand_].referenced_) {
+                shard.slots_[shard.hand_].referenced_ = false;
+                shard.hand_ = (shard.hand_ + 1) % shard.slots_.size();
+            }
+            victim = shard.hand_;
+            shard.hand_ = (shard.hand_ + 1) % shard.slots_.size();
+            shard.slot_of_.erase(shard.slots_[victim].offset_);
+        }
+        auto& slot = shard.slots_[victim];
+        slot.offset_ = offset;
+        slot.geometry_ = geometry;
+        slot.referenced_ = true;
+        shard.slot_of_.emplace(offset, victim);
+        return geometry;
     }
 
     // Get Geometry by offset (thread-safe read for filtering)
-    const Geometry*
+    std::shared_ptr<const Geometry>
     GetByOffset(size_t offset) const {
         std::shared_lock<std::shared_mutex> lock(mutex_);
         return GetByOffsetUnsafe(offset);
     }
 
+    // candidates[i] = whether the envelope of the geometry at offsets[i]
+    // overlaps the query envelope, for the predicates that imply it
+    // (intersects, contains, within, equals, touches, overlaps, crosses).
+    // Branch free over the columnar boxes so it vectorizes; use with
+    // AcquireReadLock.
+    void
+    FilterByEnvelopeUnsafe(const int32_t* offsets,
+                           int size,
+                           const GeometryEnvelope& query,
+                           uint8_t* candidates) const {
+        int32_t max_offset = 0;
+        for (int i = 0; i < size; ++i) {
+            max_offset = std::max(max_offset, offsets[i]);
+        }
+        if (size > 0 && static_cast<size_t>(max_offset) >= min_x_.size()) {
+            ThrowInfo(UnexpectedError,
+                      "offset {} is out of range: {}",
+                      max_offset,
+                      min_x_.size());
+        }
+        const float* min_x = min_x_.data();
+        const float* min_y = min_y_.data();
+        const float* max_x = max_x_.data();
+        const float* max_y = max_y_.data();
+        for (int i = 0; i < size; ++i) {
+            auto offset = offsets[i];
+            candidates[i] = (min_x[offset] <= query.max_x) &
+                            (max_x[offset] >= query.min_x) &
+                            (min_y[offset] <= query.max_y) &
+                            (max_y[offset] >= query.min_y);
+        }
+    }
+
     // Get total number of loaded geometries
     size_t
     Size() const {
         std::shared_lock<std::shared_mutex> lock(mutex_);
-        return geometries_.size();
+        return Rows();
     }
 
     // Check if cache is loaded
     bool
     IsLoaded() const {
         std::shared_lock<std::shared_mutex> lock(mutex_);
-        return !geometries_.empty();
+        return Rows() > 0;
+    }
+
+    // bytes of the WKB, the envelopes and the decoded geometries' slots,
+    // GEOS owns the decoded geometries themselves
+    size_t
+    MemorySize() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        size_t size = wkb_data_.capacity() +
+                      wkb_offsets_.capacity() * sizeof(uint64_t) +
+                      4 * min_x_.capacity() * sizeof(float);
+        for (auto& shard : decoded_shards_) {
+            std::lock_guard<std::mutex> shard_lock(shard.mutex_);
+            size += shard.slots_.capacity() * sizeof(DecodedSlot);
+        }
+        return size;
+    }
+
+ private:
+    static constexpr size_t kNumDecodedShards = 16;
+
+    struct DecodedSlot {
+        size_t offset_ = 0;
+        std::shared_ptr<const Geometry> geometry_;
+        // set on every hit, cleared as the CLOCK hand passes
+        bool referenced_ = false;
+    };
+
+    struct DecodedShard {
+        std::mutex mutex_;
+        std::vector<DecodedSlot> slots_;
+        std::unordered_map<size_t, size_t> slot_of_;
+        size_t hand_ = 0;
+    };
+
+    size_t
+    Rows() const {
+        return wkb_offsets_.size() - 1;
+    }
+
+    void
+    AppendEnvelope(const GeometryEnvelope& envelope) {
+        min_x_.push_back(envelope.min_x);
+        min_y_.push_back(envelope.min_y);
+        max_x_.push_back(envelope.max_x);
+        max_y_.push_back(envelope.max_y);
     }
 
  private:
-    mutable std::shared_mutex mutex_;   // For read/write operations
-    std::vector<Geometry> geometries_;  // Direct storage of Geometry objects
+    mutable std::shared_mutex mutex_;  // For read/write operations
+    GEOSContextHandle_t ctx_ = nullptr;
+    // WKB of all rows back to back, row i in [wkb_offsets_[i],
+    // wkb_offsets_[i + 1]), empty for a null row
+    std::string wkb_data_;
+    std::vector<uint64_t> wkb_offsets_{0};
+    // envelope sidecar, one column per bound, indexed like the rows
+    std::vector<float> min_x_;
+    std::vector<float> min_y_;
+    std::vector<float> max_x_;
+    std::vector<float> max_y_;
+    const size_t shard_capacity_;
+    mutable std::array<DecodedShard, kNumDecodedShards> decoded_shards_;
 };
 
 // Global cache instance per segment+field
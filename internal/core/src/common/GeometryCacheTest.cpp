@@ -0,0 +1,159 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/Geometry.h"
+#include "common/GeometryCache.h"
+
+namespace milvus::exec {
+namespace {
+
+class GeometryCacheTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        ctx_ = GEOS_init_r();
+    }
+
+    void
+    TearDown() override {
+        GEOS_finish_r(ctx_);
+    }
+
+    void
+    Append(SimpleGeometryCache& cache, const std::string& wkt) {
+        auto wkb = Geometry(ctx_, wkt.c_str()).to_wkb_string();
+        cache.AppendData(ctx_, wkb.data(), wkb.size());
+    }
+
+    GEOSContextHandle_t ctx_;
+};
+
+TEST_F(GeometryCacheTest, EnvelopeCoversDoubleBounds) {
+    // 0.1 has no exact float, the box still contains it
+    Geometry point(ctx_, "POINT (0.1 -0.1)");
+    auto envelope = GeometryEnvelope::Of(ctx_, point.GetGeometry());
+    EXPECT_LE(envelope.min_x, 0.1);
+    EXPECT_GE(envelope.max_x, 0.1);
+    EXPECT_LE(envelope.min_y, -0.1);
+    EXPECT_GE(envelope.max_y, -0.1);
+    EXPECT_FALSE(envelope.IsEmpty());
+
+    Geometry empty(ctx_, "POLYGON EMPTY");
+    EXPECT_TRUE(GeometryEnvelope::Of(ctx_, empty.GetGeometry()).IsEmpty());
+    EXPECT_TRUE(GeometryEnvelope::Of(ctx_, nullptr).IsEmpty());
+}
+
+TEST_F(GeometryCacheTest, FilterByEnvelopeKeepsEveryMatch) {
+    SimpleGeometryCache cache;
+    std::default_random_engine er(42);
+    std::uniform_real_distribution<double> coord(-180.0, 180.0);
+    int64_t num_rows = 1000;
+    for (int64_t i = 0; i < num_rows; ++i) {
+        auto x = coord(er);
+        auto y = coord(er) / 2;
+        if (i % 3 == 0) {
+            Append(cache,
+                   "POLYGON ((" + std::to_string(x) + " " + std::to_string(y) +
+                       ", " + std::to_string(x + 1) + " " +
+                       std::to_string(y) + ", " + std::to_string(x + 1) +
+                       " " + std::to_string(y + 1) + ", " +
+                       std::to_string(x) + " " + std::to_string(y) + "))");
+        } else if (i % 50 == 1) {
+            cache.AppendData(ctx_, nullptr, 0);
+        } else {
+            Append(cache,
+                   "POINT (" + std::to_string(x) + " " + std::to_string(y) +
+                       ")");
+        }
+    }
+
+    Geometry query(ctx_, "POLYGON ((10 10, 14 10, 14 14, 10 14, 10 10))");
+    auto query_envelope = GeometryEnvelope::Of(ctx_, query.GetGeometry());
+    std::vector<int32_t> offsets(num_rows);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    std::vector<uint8_t> candidates(num_rows);
+    auto lock = cache.AcquireReadLock();
+    cache.FilterByEnvelopeUnsafe(
+        offsets.data(), num_rows, query_envelope, candidates.data());
+
+    int64_t num_candidates = 0;
+    for (int64_t i = 0; i < num_rows; ++i) {
+        auto geometry = cache.GetByOffsetUnsafe(i);
+        if (geometry == nullptr) {
+            EXPECT_FALSE(candidates[i]);
+            continue;
+        }
+        if (geometry->intersects(query)) {
+            EXPECT_TRUE(candidates[i]) << i;
+        }
+        num_candidates += candidates[i];
+    }
+    // rows away from a small window never reach GEOS
+    EXPECT_LT(num_candidates, num_rows / 20);
+
+    int32_t out_of_range = num_rows;
+    EXPECT_ANY_THROW(cache.FilterByEnvelopeUnsafe(
+        &out_of_range, 1, query_envelope, candidates.data()));
+}
+
+TEST_F(GeometryCacheTest, DecodesEvictedGeometriesAgain) {
+    // 16 shards of 2 decoded geometries
+    SimpleGeometryCache cache(32);
+    int64_t num_rows = 500;
+    std::vector<std::string> wkts;
+    for (int64_t i = 0; i < num_rows; ++i) {
+        if (i % 7 == 3) {
+            wkts.emplace_back();
+            cache.AppendData(ctx_, nullptr, 0);
+            continue;
+        }
+        wkts.push_back(Geometry(ctx_,
+                                ("POINT (" + std::to_string(i) + " " +
+                                 std::to_string(-i) + ")")
+                                    .c_str())
+                           .to_wkt_string());
+        Append(cache, wkts.back());
+    }
+    ASSERT_EQ(cache.Size(), num_rows);
+
+    auto pinned = cache.GetByOffset(0);
+    ASSERT_NE(pinned, nullptr);
+    for (int round = 0; round < 2; ++round) {
+        for (int64_t i = 0; i < num_rows; ++i) {
+            auto geometry = cache.GetByOffset(i);
+            if (wkts[i].empty()) {
+                EXPECT_EQ(geometry, nullptr);
+                continue;
+            }
+            ASSERT_NE(geometry, nullptr);
+            EXPECT_EQ(geometry->to_wkt_string(), wkts[i]);
+        }
+    }
+    // evicted since, the pinned geometry stays usable
+    EXPECT_EQ(pinned->to_wkt_string(), wkts[0]);
+    EXPECT_NE(cache.GetByOffset(0).get(), nullptr);
+
+    // without decoded slots every lookup decodes
+    SimpleGeometryCache uncached(0);
+    Append(uncached, wkts[0]);
+    EXPECT_NE(uncached.GetByOffset(0), uncached.GetByOffset(0));
+    EXPECT_ANY_THROW(uncached.GetByOffset(1));
+}
+
+}  // namespace
+}  // namespace milvus::exec
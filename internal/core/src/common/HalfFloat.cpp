@@ -0,0 +1,238 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/HalfFloat.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "common/EasyAssert.h"
+#include "common/HalfFloatKernels.h"
+
+namespace milvus {
+
+static_assert(sizeof(float16) == sizeof(uint16_t) &&
+                  sizeof(bfloat16) == sizeof(uint16_t),
+              "the half precision types must be their raw bits");
+
+namespace half_float {
+
+namespace {
+
+template <float (*ToFloat)(uint16_t)>
+void
+NativeToFloat(const uint16_t* src, float* dst, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        dst[i] = ToFloat(src[i]);
+    }
+}
+
+template <uint16_t (*FromFloat)(float)>
+void
+NativeFromFloat(const float* src, uint16_t* dst, int64_t n) {
+    for (int64_t i = 0; i < n; ++i) {
+        dst[i] = FromFloat(src[i]);
+    }
+}
+
+// independent partial sums, so the loop vectorizes
+constexpr int64_t kLanes = 8;
+
+template <float (*ToFloat)(uint16_t)>
+float
+NativeDots(const float* queries,
+           int64_t num_queries,
+           const uint16_t* vector,
+           int64_t dim,
+           float* dots) {
+    float sums[kMaxDotQueries][kLanes] = {};
+    float norms[kLanes] = {};
+    float block[kLanes];
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        for (int64_t l = 0; l < kLanes; ++l) {
+            block[l] = ToFloat(vector[i + l]);
+            norms[l] += block[l] * block[l];
+        }
+        for (int64_t q = 0; q < num_queries; ++q) {
+            for (int64_t l = 0; l < kLanes; ++l) {
+                sums[q][l] += queries[q * dim + i + l] * block[l];
+            }
+        }
+    }
+    float norm = 0;
+    for (int64_t l = 0; l < kLanes; ++l) {
+        norm += norms[l];
+    }
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = 0;
+        for (int64_t l = 0; l < kLanes; ++l) {
+            dots[q] += sums[q][l];
+        }
+    }
+    for (; i < dim; ++i) {
+        auto value = ToFloat(vector[i]);
+        norm += value * value;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            dots[q] += queries[q * dim + i] * value;
+        }
+    }
+    return norm;
+}
+
+bool
+CpuSupportsAvx2() {
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+           __builtin_cpu_supports("f16c");
+#else
+    return false;
+#endif
+}
+
+// set by SelectKernels, the preferred kernels until then
+std::atomic<const Kernels*> selected_kernels{nullptr};
+
+const Kernels&
+SelectedKernels() {
+    auto kernels = selected_kernels.load(std::memory_order_acquire);
+    return kernels != nullptr ? *kernels : SupportedKernels().front();
+}
+
+}  // namespace
+
+Kernels
+NativeKernels() {
+    return Kernels{"native",
+                   NativeToFloat<Fp16ToFloat>,
+                   NativeToFloat<Bf16ToFloat>,
+                   NativeFromFloat<FloatToFp16>,
+                   NativeFromFloat<FloatToBf16>,
+                   NativeDots<Fp16ToFloat>,
+                   NativeDots<Bf16ToFloat>};
+}
+
+const std::vector<Kernels>&
+SupportedKernels() {
+    static const std::vector<Kernels> kernels = [] {
+        std::vector<Kernels> kernels;
+#if defined(__x86_64__) || defined(_M_X64)
+        if (CpuSupportsAvx2()) {
+            kernels.push_back(Avx2Kernels());
+        }
+#elif defined(__aarch64__)
+        // NEON is part of the aarch64 baseline
+        kernels.push_back(NeonKernels());
+#endif
+        kernels.push_back(NativeKernels());
+        return kernels;
+    }();
+    return kernels;
+}
+
+void
+SelectKernels(const std::string& name) {
+    for (const auto& kernels : SupportedKernels()) {
+        if (name == kernels.name) {
+            selected_kernels.store(&kernels, std::memory_order_release);
+            return;
+        }
+    }
+    ThrowInfo(InvalidParameter, "unsupported half float kernels: {}", name);
+}
+
+}  // namespace half_float
+
+namespace {
+
+template <typename Kernel, typename T>
+float
+TiledDots(Kernel kernel,
+          const float* queries,
+          int64_t num_queries,
+          const T* vector,
+          int64_t dim,
+          float* dots) {
+    constexpr auto kTile = half_float::kMaxDotQueries;
+    auto bits = reinterpret_cast<const uint16_t*>(vector);
+    auto norm = kernel(queries, std::min(num_queries, kTile), bits, dim, dots);
+    for (int64_t q = kTile; q < num_queries; q += kTile) {
+        auto tile = std::min(num_queries - q, kTile);
+        kernel(queries + q * dim, tile, bits, dim, dots + q);
+    }
+    return norm;
+}
+
+}  // namespace
+
+void
+HalfToFloat(const float16* src, float* dst, int64_t n) {
+    half_float::SelectedKernels().fp16_to_float(
+        reinterpret_cast<const uint16_t*>(src), dst, n);
+}
+
+void
+HalfToFloat(const bfloat16* src, float* dst, int64_t n) {
+    half_float::SelectedKernels().bf16_to_float(
+        reinterpret_cast<const uint16_t*>(src), dst, n);
+}
+
+void
+FloatToHalf(const float* src, float16* dst, int64_t n) {
+    half_float::SelectedKernels().float_to_fp16(
+        src, reinterpret_cast<uint16_t*>(dst), n);
+}
+
+void
+FloatToHalf(const float* src, bfloat16* dst, int64_t n) {
+    half_float::SelectedKernels().float_to_bf16(
+        src, reinterpret_cast<uint16_t*>(dst), n);
+}
+
+float
+HalfDots(const float* queries,
+         int64_t num_queries,
+         const float16* vector,
+         int64_t dim,
+         float* dots) {
+    return TiledDots(half_float::SelectedKernels().fp16_dots,
+                     queries,
+                     num_queries,
+                     vector,
+                     dim,
+                     dots);
+}
+
+float
+HalfDots(const float* queries,
+         int64_t num_queries,
+         const bfloat16* vector,
+         int64_t dim,
+         float* dots) {
+    return TiledDots(half_float::SelectedKernels().bf16_dots,
+                     queries,
+                     num_queries,
+                     vector,
+                     dim,
+                     dots);
+}
+
+const char*
+HalfFloatInstructionSet() {
+    return half_float::SelectedKernels().name;
+}
+
+}  // namespace milvus
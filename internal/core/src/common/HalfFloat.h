@@ -0,0 +1,62 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/Types.h"
+
+namespace milvus {
+
+// Bulk conversions between float16 / bfloat16 vector elements and floats,
+// F16C or NEON where the cpu has them. Floats round to the nearest even
+// half precision value.
+void
+HalfToFloat(const float16* src, float* dst, int64_t n);
+
+void
+HalfToFloat(const bfloat16* src, float* dst, int64_t n);
+
+void
+FloatToHalf(const float* src, float16* dst, int64_t n);
+
+void
+FloatToHalf(const float* src, bfloat16* dst, int64_t n);
+
+// dots[q] is the inner product of the float vector queries[q * dim, (q + 1)
+// * dim) with the half precision vector, computed on the half precision
+// elements with fp32 accumulators, without converting vector to a buffer
+// first. Returns the squared norm of vector, which cosine scores need.
+float
+HalfDots(const float* queries,
+         int64_t num_queries,
+         const float16* vector,
+         int64_t dim,
+         float* dots);
+
+float
+HalfDots(const float* queries,
+         int64_t num_queries,
+         const bfloat16* vector,
+         int64_t dim,
+         float* dots);
+
+// the instruction set of the kernels above, for the logs
+const char*
+HalfFloatInstructionSet();
+
+}  // namespace milvus
@@ -0,0 +1,162 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compiled with -mavx2 -mfma -mf16c, only called once the cpu is checked.
+
+#include <immintrin.h>
+
+#include "common/HalfFloatKernels.h"
+
+namespace milvus::half_float {
+
+namespace {
+
+constexpr int64_t kLanes = 8;
+
+inline __m256
+LoadFp16(const uint16_t* src) {
+    return _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+inline __m256
+LoadBf16(const uint16_t* src) {
+    auto widened = _mm256_cvtepu16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(widened, 16));
+}
+
+inline float
+HorizontalSum(__m256 v) {
+    auto sum = _mm_add_ps(_mm256_castps256_ps128(v),
+                          _mm256_extractf128_ps(v, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+    return _mm_cvtss_f32(sum);
+}
+
+void
+Fp16ToFloatAvx2(const uint16_t* src, float* dst, int64_t n) {
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        _mm256_storeu_ps(dst + i, LoadFp16(src + i));
+    }
+    for (; i < n; ++i) {
+        dst[i] = Fp16ToFloat(src[i]);
+    }
+}
+
+void
+Bf16ToFloatAvx2(const uint16_t* src, float* dst, int64_t n) {
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        _mm256_storeu_ps(dst + i, LoadBf16(src + i));
+    }
+    for (; i < n; ++i) {
+        dst[i] = Bf16ToFloat(src[i]);
+    }
+}
+
+void
+FloatToFp16Avx2(const float* src, uint16_t* dst, int64_t n) {
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        auto half = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                    _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), half);
+    }
+    for (; i < n; ++i) {
+        dst[i] = FloatToFp16(src[i]);
+    }
+}
+
+void
+FloatToBf16Avx2(const float* src, uint16_t* dst, int64_t n) {
+    const auto round = _mm256_set1_epi32(0x7FFF);
+    const auto one = _mm256_set1_epi32(1);
+    const auto quiet = _mm256_set1_epi32(0x00400000);
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        auto values = _mm256_loadu_ps(src + i);
+        auto bits = _mm256_castps_si256(values);
+        // round to nearest even, NaNs stay NaNs once quieted
+        auto odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        auto rounded = _mm256_add_epi32(bits, _mm256_add_epi32(round, odd));
+        auto nan = _mm256_castps_si256(
+            _mm256_cmp_ps(values, values, _CMP_UNORD_Q));
+        rounded = _mm256_blendv_epi8(
+            rounded, _mm256_or_si256(bits, quiet), nan);
+        auto shifted = _mm256_srli_epi32(rounded, 16);
+        // the 16 bit halves of both 128 bit lanes, in order
+        auto packed = _mm256_permute4x64_epi64(
+            _mm256_packus_epi32(shifted, shifted), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_castsi256_si128(packed));
+    }
+    for (; i < n; ++i) {
+        dst[i] = FloatToBf16(src[i]);
+    }
+}
+
+template <__m256 (*Load)(const uint16_t*), float (*ToFloat)(uint16_t)>
+float
+DotsAvx2(const float* queries,
+         int64_t num_queries,
+         const uint16_t* vector,
+         int64_t dim,
+         float* dots) {
+    __m256 sums[kMaxDotQueries];
+    for (auto& sum : sums) {
+        sum = _mm256_setzero_ps();
+    }
+    auto norms = _mm256_setzero_ps();
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        auto block = Load(vector + i);
+        norms = _mm256_fmadd_ps(block, block, norms);
+        for (int64_t q = 0; q < num_queries; ++q) {
+            sums[q] = _mm256_fmadd_ps(
+                _mm256_loadu_ps(queries + q * dim + i), block, sums[q]);
+        }
+    }
+    auto norm = HorizontalSum(norms);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = HorizontalSum(sums[q]);
+    }
+    for (; i < dim; ++i) {
+        auto value = ToFloat(vector[i]);
+        norm += value * value;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            dots[q] += queries[q * dim + i] * value;
+        }
+    }
+    return norm;
+}
+
+}  // namespace
+
+Kernels
+Avx2Kernels() {
+    return Kernels{"avx2",
+                   Fp16ToFloatAvx2,
+                   Bf16ToFloatAvx2,
+                   FloatToFp16Avx2,
+                   FloatToBf16Avx2,
+                   DotsAvx2<LoadFp16, Fp16ToFloat>,
+                   DotsAvx2<LoadBf16, Bf16ToFloat>};
+}
+
+}  // namespace milvus::half_float
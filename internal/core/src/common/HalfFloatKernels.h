@@ -0,0 +1,143 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// The instruction set variants behind common/HalfFloat.h. They take the
+// half precision values as their raw bits.
+namespace milvus::half_float {
+
+// the most query vectors a dots kernel scores in one pass over a vector
+constexpr int64_t kMaxDotQueries = 4;
+
+struct Kernels {
+    const char* name;
+    void (*fp16_to_float)(const uint16_t* src, float* dst, int64_t n);
+    void (*bf16_to_float)(const uint16_t* src, float* dst, int64_t n);
+    void (*float_to_fp16)(const float* src, uint16_t* dst, int64_t n);
+    void (*float_to_bf16)(const float* src, uint16_t* dst, int64_t n);
+    // dots[q] is the inner product of queries[q * dim, (q + 1) * dim) with
+    // vector, for num_queries <= kMaxDotQueries, the return value the
+    // squared norm of vector
+    float (*fp16_dots)(const float* queries,
+                       int64_t num_queries,
+                       const uint16_t* vector,
+                       int64_t dim,
+                       float* dots);
+    float (*bf16_dots)(const float* queries,
+                       int64_t num_queries,
+                       const uint16_t* vector,
+                       int64_t dim,
+                       float* dots);
+};
+
+Kernels
+NativeKernels();
+
+// the kernels this cpu runs, preferred first
+const std::vector<Kernels>&
+SupportedKernels();
+
+// points the conversions and dots of common/HalfFloat.h at the supported
+// kernels of name, they call the preferred ones until then
+void
+SelectKernels(const std::string& name);
+
+#if defined(__x86_64__) || defined(_M_X64)
+// AVX2, FMA and F16C
+Kernels
+Avx2Kernels();
+#endif
+
+#if defined(__aarch64__)
+Kernels
+NeonKernels();
+#endif
+
+inline float
+BitsToFloat(uint32_t bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint32_t
+FloatToBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float
+Fp16ToFloat(uint16_t half) {
+    // the exponent is rebiased by a multiplication, subnormals by a
+    // subtraction from a float of the same mantissa
+    const uint32_t w = static_cast<uint32_t>(half) << 16;
+    const uint32_t sign = w & 0x80000000u;
+    const uint32_t two_w = w + w;
+    const float normalized =
+        BitsToFloat((two_w >> 4) + (0xE0u << 23)) * 0x1.0p-112f;
+    const float denormalized =
+        BitsToFloat((two_w >> 17) | (126u << 23)) - 0.5f;
+    const uint32_t bits = two_w < (1u << 27) ? FloatToBits(denormalized)
+                                             : FloatToBits(normalized);
+    return BitsToFloat(sign | bits);
+}
+
+inline uint16_t
+FloatToFp16(float value) {
+    // rounds to nearest even by adding the value to a power of two that
+    // leaves the fp16 mantissa in the low bits
+    float base = (std::abs(value) * 0x1.0p+112f) * 0x1.0p-110f;
+    const uint32_t w = FloatToBits(value);
+    const uint32_t shl1_w = w + w;
+    const uint32_t sign = w & 0x80000000u;
+    uint32_t bias = shl1_w & 0xFF000000u;
+    if (bias < 0x71000000u) {
+        bias = 0x71000000u;
+    }
+    base = BitsToFloat((bias >> 1) + 0x07800000u) + base;
+    const uint32_t bits = FloatToBits(base);
+    const uint32_t exp_bits = (bits >> 13) & 0x00007C00u;
+    const uint32_t mantissa_bits = bits & 0x00000FFFu;
+    const uint32_t nonsign = exp_bits + mantissa_bits;
+    return static_cast<uint16_t>((sign >> 16) |
+                                 (shl1_w > 0xFF000000u ? 0x7E00u : nonsign));
+}
+
+inline float
+Bf16ToFloat(uint16_t half) {
+    return BitsToFloat(static_cast<uint32_t>(half) << 16);
+}
+
+inline uint16_t
+FloatToBf16(float value) {
+    const uint32_t bits = FloatToBits(value);
+    if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+        // a quiet NaN of the same sign
+        return static_cast<uint16_t>((bits >> 16) | 0x0040u);
+    }
+    return static_cast<uint16_t>(
+        (bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16);
+}
+
+}  // namespace milvus::half_float
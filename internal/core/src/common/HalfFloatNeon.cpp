@@ -0,0 +1,131 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if defined(__aarch64__)
+
+#include <arm_neon.h>
+
+#include "common/HalfFloatKernels.h"
+
+namespace milvus::half_float {
+
+namespace {
+
+constexpr int64_t kLanes = 4;
+
+inline float32x4_t
+LoadFp16(const uint16_t* src) {
+    return vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src)));
+}
+
+inline float32x4_t
+LoadBf16(const uint16_t* src) {
+    return vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src), 16));
+}
+
+void
+Fp16ToFloatNeon(const uint16_t* src, float* dst, int64_t n) {
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        vst1q_f32(dst + i, LoadFp16(src + i));
+    }
+    for (; i < n; ++i) {
+        dst[i] = Fp16ToFloat(src[i]);
+    }
+}
+
+void
+Bf16ToFloatNeon(const uint16_t* src, float* dst, int64_t n) {
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        vst1q_f32(dst + i, LoadBf16(src + i));
+    }
+    for (; i < n; ++i) {
+        dst[i] = Bf16ToFloat(src[i]);
+    }
+}
+
+void
+FloatToFp16Neon(const float* src, uint16_t* dst, int64_t n) {
+    int64_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        vst1_u16(dst + i,
+                 vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+    }
+    for (; i < n; ++i) {
+        dst[i] = FloatToFp16(src[i]);
+    }
+}
+
+void
+FloatToBf16Neon(const float* src, uint16_t* dst, int64_t n) {
+    // the scalar rounding vectorizes as it is
+    for (int64_t i = 0; i < n; ++i) {
+        dst[i] = FloatToBf16(src[i]);
+    }
+}
+
+template <float32x4_t (*Load)(const uint16_t*), float (*ToFloat)(uint16_t)>
+float
+DotsNeon(const float* queries,
+         int64_t num_queries,
+         const uint16_t* vector,
+         int64_t dim,
+         float* dots) {
+    float32x4_t sums[kMaxDotQueries];
+    for (auto& sum : sums) {
+        sum = vdupq_n_f32(0);
+    }
+    auto norms = vdupq_n_f32(0);
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        auto block = Load(vector + i);
+        norms = vfmaq_f32(norms, block, block);
+        for (int64_t q = 0; q < num_queries; ++q) {
+            sums[q] =
+                vfmaq_f32(sums[q], vld1q_f32(queries + q * dim + i), block);
+        }
+    }
+    auto norm = vaddvq_f32(norms);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = vaddvq_f32(sums[q]);
+    }
+    for (; i < dim; ++i) {
+        auto value = ToFloat(vector[i]);
+        norm += value * value;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            dots[q] += queries[q * dim + i] * value;
+        }
+    }
+    return norm;
+}
+
+}  // namespace
+
+Kernels
+NeonKernels() {
+    return Kernels{"neon",
+                   Fp16ToFloatNeon,
+                   Bf16ToFloatNeon,
+                   FloatToFp16Neon,
+                   FloatToBf16Neon,
+                   DotsNeon<LoadFp16, Fp16ToFloat>,
+                   DotsNeon<LoadBf16, Bf16ToFloat>};
+}
+
+}  // namespace milvus::half_float
+
+#endif
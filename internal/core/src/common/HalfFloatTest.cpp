@@ -0,0 +1,138 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "common/HalfFloat.h"
+#include "common/HalfFloatKernels.h"
+
+using namespace milvus;
+
+namespace {
+
+// every kernel set this cpu runs
+std::vector<half_float::Kernels>
+AllKernels() {
+    std::vector<half_float::Kernels> kernels{half_float::NativeKernels()};
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+        __builtin_cpu_supports("f16c")) {
+        kernels.push_back(half_float::Avx2Kernels());
+    }
+#elif defined(__aarch64__)
+    kernels.push_back(half_float::NeonKernels());
+#endif
+    return kernels;
+}
+
+}  // namespace
+
+TEST(HalfFloatTest, Fp16RoundTripsEveryValue) {
+    std::vector<uint16_t> halves(1 << 16);
+    for (uint32_t i = 0; i < halves.size(); ++i) {
+        halves[i] = static_cast<uint16_t>(i);
+    }
+    for (const auto& kernels : AllKernels()) {
+        std::vector<float> floats(halves.size());
+        kernels.fp16_to_float(halves.data(), floats.data(), halves.size());
+        std::vector<uint16_t> back(halves.size());
+        kernels.float_to_fp16(floats.data(), back.data(), floats.size());
+        for (uint32_t i = 0; i < halves.size(); ++i) {
+            if (std::isnan(floats[i])) {
+                EXPECT_EQ(back[i] & 0x7C00, 0x7C00) << kernels.name;
+                continue;
+            }
+            ASSERT_EQ(back[i], halves[i]) << kernels.name << " " << i;
+        }
+        // 1 + 2^-11 is halfway between two fp16 values, it rounds to even
+        float halfway = 1.0f + std::ldexp(1.0f, -11);
+        uint16_t rounded;
+        kernels.float_to_fp16(&halfway, &rounded, 1);
+        EXPECT_EQ(rounded, 0x3C00) << kernels.name;
+        EXPECT_EQ(half_float::Fp16ToFloat(0x0001), std::ldexp(1.0f, -24));
+        EXPECT_EQ(half_float::Fp16ToFloat(0x7C00),
+                  std::numeric_limits<float>::infinity());
+    }
+}
+
+TEST(HalfFloatTest, Bf16RoundsToNearestEven) {
+    std::default_random_engine er(42);
+    std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+    std::vector<float> floats(1001);
+    for (auto& value : floats) {
+        value = dist(er);
+    }
+    floats[0] = std::numeric_limits<float>::quiet_NaN();
+    // halfway between an odd bfloat16 and the next one, which is even
+    floats[1] = half_float::BitsToFloat(0x3F818000u);
+    for (const auto& kernels : AllKernels()) {
+        std::vector<uint16_t> halves(floats.size());
+        kernels.float_to_bf16(floats.data(), halves.data(), floats.size());
+        std::vector<float> back(floats.size());
+        kernels.bf16_to_float(halves.data(), back.data(), halves.size());
+        EXPECT_TRUE(std::isnan(back[0])) << kernels.name;
+        EXPECT_EQ(halves[1], 0x3F82) << kernels.name;
+        for (size_t i = 2; i < floats.size(); ++i) {
+            EXPECT_EQ(halves[i], half_float::FloatToBf16(floats[i]));
+            EXPECT_NEAR(back[i], floats[i], std::abs(floats[i]) / 128);
+        }
+    }
+}
+
+TEST(HalfFloatTest, DotsMatchConvertedVectors) {
+    std::default_random_engine er(42);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    // a tail past the vector width
+    const int64_t dim = 37;
+    const int64_t num_queries = half_float::kMaxDotQueries;
+    std::vector<float> queries(num_queries * dim);
+    std::vector<float> vector(dim);
+    for (auto& value : queries) {
+        value = dist(er);
+    }
+    for (auto& value : vector) {
+        value = dist(er);
+    }
+    for (const auto& kernels : AllKernels()) {
+        for (auto bf16 : {false, true}) {
+            std::vector<uint16_t> halves(dim);
+            std::vector<float> converted(dim);
+            if (bf16) {
+                kernels.float_to_bf16(vector.data(), halves.data(), dim);
+                kernels.bf16_to_float(halves.data(), converted.data(), dim);
+            } else {
+                kernels.float_to_fp16(vector.data(), halves.data(), dim);
+                kernels.fp16_to_float(halves.data(), converted.data(), dim);
+            }
+            std::vector<float> dots(num_queries);
+            auto dots_kernel = bf16 ? kernels.bf16_dots : kernels.fp16_dots;
+            auto norm = dots_kernel(
+                queries.data(), num_queries, halves.data(), dim, dots.data());
+            float expected_norm = 0;
+            for (auto value : converted) {
+                expected_norm += value * value;
+            }
+            EXPECT_NEAR(norm, expected_norm, 1e-4) << kernels.name;
+            for (int64_t q = 0; q < num_queries; ++q) {
+                float expected = 0;
+                for (int64_t i = 0; i < dim; ++i) {
+                    expected += queries[q * dim + i] * converted[i];
+                }
+                EXPECT_NEAR(dots[q], expected, 1e-4) << kernels.name;
+            }
+        }
+    }
+}
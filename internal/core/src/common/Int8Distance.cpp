@@ -0,0 +1,161 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/Int8Distance.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "common/EasyAssert.h"
+#include "common/Int8DistanceKernels.h"
+
+#if defined(__aarch64__) && !defined(_MSC_VER)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace milvus {
+
+namespace int8_distance {
+
+namespace {
+
+// independent partial sums, so the loop vectorizes
+constexpr int64_t kLanes = 16;
+
+int32_t
+NativeDots(const int8_t* queries,
+           int64_t num_queries,
+           const int8_t* vector,
+           int64_t dim,
+           int32_t* dots) {
+    int32_t sums[kMaxDotQueries][kLanes] = {};
+    int32_t norms[kLanes] = {};
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        for (int64_t l = 0; l < kLanes; ++l) {
+            norms[l] += int32_t(vector[i + l]) * vector[i + l];
+        }
+        for (int64_t q = 0; q < num_queries; ++q) {
+            for (int64_t l = 0; l < kLanes; ++l) {
+                sums[q][l] += int32_t(queries[q * dim + i + l]) * vector[i + l];
+            }
+        }
+    }
+    int32_t norm = 0;
+    for (int64_t l = 0; l < kLanes; ++l) {
+        norm += norms[l];
+    }
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = 0;
+        for (int64_t l = 0; l < kLanes; ++l) {
+            dots[q] += sums[q][l];
+        }
+    }
+    for (; i < dim; ++i) {
+        norm += int32_t(vector[i]) * vector[i];
+        for (int64_t q = 0; q < num_queries; ++q) {
+            dots[q] += int32_t(queries[q * dim + i]) * vector[i];
+        }
+    }
+    return norm;
+}
+
+// set by SelectKernels, the preferred kernels until then
+std::atomic<const Kernels*> selected_kernels{nullptr};
+
+const Kernels&
+SelectedKernels() {
+    auto kernels = selected_kernels.load(std::memory_order_acquire);
+    return kernels != nullptr ? *kernels : SupportedKernels().front();
+}
+
+}  // namespace
+
+Kernels
+NativeKernels() {
+    return Kernels{"native", NativeDots};
+}
+
+const std::vector<Kernels>&
+SupportedKernels() {
+    static const std::vector<Kernels> kernels = [] {
+        std::vector<Kernels> kernels;
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+        if (__builtin_cpu_supports("avx512f") &&
+            __builtin_cpu_supports("avx512bw") &&
+            __builtin_cpu_supports("avx512vnni")) {
+            kernels.push_back(Avx512VnniKernels());
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            kernels.push_back(Avx2Kernels());
+        }
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+        if ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0) {
+            kernels.push_back(NeonDotProdKernels());
+        }
+#endif
+        kernels.push_back(NativeKernels());
+        return kernels;
+    }();
+    return kernels;
+}
+
+void
+SelectKernels(const std::string& name) {
+    for (const auto& kernels : SupportedKernels()) {
+        if (name == kernels.name) {
+            selected_kernels.store(&kernels, std::memory_order_release);
+            return;
+        }
+    }
+    ThrowInfo(InvalidParameter, "unsupported int8 distance kernels: {}", name);
+}
+
+}  // namespace int8_distance
+
+int32_t
+Int8Dots(const int8_t* queries,
+         int64_t num_queries,
+         const int8_t* vector,
+         int64_t dim,
+         int32_t* dots) {
+    constexpr auto kTile = int8_distance::kMaxDotQueries;
+    auto kernel = int8_distance::SelectedKernels().dots;
+    auto norm =
+        kernel(queries, std::min(num_queries, kTile), vector, dim, dots);
+    for (int64_t q = kTile; q < num_queries; q += kTile) {
+        kernel(queries + q * dim,
+               std::min(num_queries - q, kTile),
+               vector,
+               dim,
+               dots + q);
+    }
+    return norm;
+}
+
+int32_t
+Int8SquaredNorm(const int8_t* vector, int64_t dim) {
+    return int8_distance::SelectedKernels().dots(
+        nullptr, 0, vector, dim, nullptr);
+}
+
+const char*
+Int8InstructionSet() {
+    return int8_distance::SelectedKernels().name;
+}
+
+}  // namespace milvus
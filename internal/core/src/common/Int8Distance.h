@@ -0,0 +1,43 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace milvus {
+
+// dots[q] is the inner product of the int8 vector queries[q * dim, (q + 1)
+// * dim) with vector, exact in int32, with AVX-512 VNNI, AVX2 or the NEON
+// dot product where the cpu has them. Every query vector shares the loads
+// of vector. Returns the squared norm of vector, which L2 and cosine
+// distances need.
+int32_t
+Int8Dots(const int8_t* queries,
+         int64_t num_queries,
+         const int8_t* vector,
+         int64_t dim,
+         int32_t* dots);
+
+// the squared norm of an int8 vector
+int32_t
+Int8SquaredNorm(const int8_t* vector, int64_t dim);
+
+// the instruction set of Int8Dots, for the logs
+const char*
+Int8InstructionSet();
+
+}  // namespace milvus
@@ -0,0 +1,87 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compiled with -mavx2, only called once the cpu is checked.
+
+#include <immintrin.h>
+
+#include "common/Int8DistanceKernels.h"
+
+namespace milvus::int8_distance {
+
+namespace {
+
+constexpr int64_t kLanes = 16;
+
+inline __m256i
+Load(const int8_t* src) {
+    return _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+inline int32_t
+HorizontalSum(__m256i v) {
+    auto sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                             _mm256_extracti128_si256(v, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+int32_t
+DotsAvx2(const int8_t* queries,
+         int64_t num_queries,
+         const int8_t* vector,
+         int64_t dim,
+         int32_t* dots) {
+    // the int8 values are widened to int16, madd adds pairs of products
+    // into int32
+    __m256i sums[kMaxDotQueries];
+    for (auto& sum : sums) {
+        sum = _mm256_setzero_si256();
+    }
+    auto norms = _mm256_setzero_si256();
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        auto block = Load(vector + i);
+        norms = _mm256_add_epi32(norms, _mm256_madd_epi16(block, block));
+        for (int64_t q = 0; q < num_queries; ++q) {
+            sums[q] = _mm256_add_epi32(
+                sums[q],
+                _mm256_madd_epi16(Load(queries + q * dim + i), block));
+        }
+    }
+    auto norm = HorizontalSum(norms);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = HorizontalSum(sums[q]);
+    }
+    for (; i < dim; ++i) {
+        norm += int32_t(vector[i]) * vector[i];
+        for (int64_t q = 0; q < num_queries; ++q) {
+            dots[q] += int32_t(queries[q * dim + i]) * vector[i];
+        }
+    }
+    return norm;
+}
+
+}  // namespace
+
+Kernels
+Avx2Kernels() {
+    return Kernels{"avx2", DotsAvx2};
+}
+
+}  // namespace milvus::int8_distance
@@ -0,0 +1,75 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compiled with -mavx512f -mavx512bw -mavx512vnni, only called once the cpu
+// is checked.
+
+#include <immintrin.h>
+
+#include "common/Int8DistanceKernels.h"
+
+namespace milvus::int8_distance {
+
+namespace {
+
+constexpr int64_t kLanes = 64;
+
+int32_t
+DotsAvx512Vnni(const int8_t* queries,
+               int64_t num_queries,
+               const int8_t* vector,
+               int64_t dim,
+               int32_t* dots) {
+    // vpdpbusd multiplies unsigned by signed bytes: a left side shifted to
+    // unsigned by flipping its sign bit is 128 too large, which adds 128
+    // times the sum of the right side, subtracted at the end
+    const auto flip = _mm512_set1_epi8(static_cast<char>(0x80));
+    const auto ones = _mm512_set1_epi8(1);
+    __m512i sums[kMaxDotQueries];
+    for (auto& sum : sums) {
+        sum = _mm512_setzero_si512();
+    }
+    auto norms = _mm512_setzero_si512();
+    auto totals = _mm512_setzero_si512();
+    for (int64_t i = 0; i < dim; i += kLanes) {
+        // the masked tail loads zeros, which add nothing
+        auto mask = dim - i >= kLanes ? ~__mmask64(0)
+                                      : (__mmask64(1) << (dim - i)) - 1;
+        auto block = _mm512_maskz_loadu_epi8(mask, vector + i);
+        totals = _mm512_dpbusd_epi32(totals, ones, block);
+        norms =
+            _mm512_dpbusd_epi32(norms, _mm512_xor_si512(block, flip), block);
+        for (int64_t q = 0; q < num_queries; ++q) {
+            auto query = _mm512_maskz_loadu_epi8(mask, queries + q * dim + i);
+            sums[q] = _mm512_dpbusd_epi32(
+                sums[q], _mm512_xor_si512(query, flip), block);
+        }
+    }
+    auto bias = 128 * _mm512_reduce_add_epi32(totals);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = _mm512_reduce_add_epi32(sums[q]) - bias;
+    }
+    return _mm512_reduce_add_epi32(norms) - bias;
+}
+
+}  // namespace
+
+Kernels
+Avx512VnniKernels() {
+    return Kernels{"avx512_vnni", DotsAvx512Vnni};
+}
+
+}  // namespace milvus::int8_distance
@@ -0,0 +1,68 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// The instruction set variants behind common/Int8Distance.h.
+namespace milvus::int8_distance {
+
+// the most query vectors a dots kernel scores in one pass over a vector
+constexpr int64_t kMaxDotQueries = 4;
+
+struct Kernels {
+    const char* name;
+    // dots[q] is the inner product of queries[q * dim, (q + 1) * dim) with
+    // vector, for num_queries <= kMaxDotQueries, the return value the
+    // squared norm of vector
+    int32_t (*dots)(const int8_t* queries,
+                    int64_t num_queries,
+                    const int8_t* vector,
+                    int64_t dim,
+                    int32_t* dots);
+};
+
+Kernels
+NativeKernels();
+
+// the kernels this cpu runs, preferred first
+const std::vector<Kernels>&
+SupportedKernels();
+
+// points Int8Dots at the supported kernels of name, it calls the preferred
+// ones until then
+void
+SelectKernels(const std::string& name);
+
+#if defined(__x86_64__) || defined(_M_X64)
+Kernels
+Avx2Kernels();
+
+// AVX-512 VNNI
+Kernels
+Avx512VnniKernels();
+#endif
+
+#if defined(__aarch64__)
+// the NEON dot product extension
+Kernels
+NeonDotProdKernels();
+#endif
+
+}  // namespace milvus::int8_distance
@@ -0,0 +1,74 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compiled with -march=armv8.2-a+dotprod, only called once the cpu is
+// checked.
+
+#if defined(__aarch64__)
+
+#include <arm_neon.h>
+
+#include "common/Int8DistanceKernels.h"
+
+namespace milvus::int8_distance {
+
+namespace {
+
+constexpr int64_t kLanes = 16;
+
+int32_t
+DotsNeonDotProd(const int8_t* queries,
+                int64_t num_queries,
+                const int8_t* vector,
+                int64_t dim,
+                int32_t* dots) {
+    int32x4_t sums[kMaxDotQueries];
+    for (auto& sum : sums) {
+        sum = vdupq_n_s32(0);
+    }
+    auto norms = vdupq_n_s32(0);
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        auto block = vld1q_s8(vector + i);
+        norms = vdotq_s32(norms, block, block);
+        for (int64_t q = 0; q < num_queries; ++q) {
+            sums[q] =
+                vdotq_s32(sums[q], vld1q_s8(queries + q * dim + i), block);
+        }
+    }
+    auto norm = vaddvq_s32(norms);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        dots[q] = vaddvq_s32(sums[q]);
+    }
+    for (; i < dim; ++i) {
+        norm += int32_t(vector[i]) * vector[i];
+        for (int64_t q = 0; q < num_queries; ++q) {
+            dots[q] += int32_t(queries[q * dim + i]) * vector[i];
+        }
+    }
+    return norm;
+}
+
+}  // namespace
+
+Kernels
+NeonDotProdKernels() {
+    return Kernels{"neon_dotprod", DotsNeonDotProd};
+}
+
+}  // namespace milvus::int8_distance
+
+#endif
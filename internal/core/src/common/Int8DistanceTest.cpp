@@ -0,0 +1,103 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/Int8Distance.h"
+#include "common/Int8DistanceKernels.h"
+
+using namespace milvus;
+
+namespace {
+
+// every kernel set this cpu runs
+std::vector<int8_distance::Kernels>
+AllKernels() {
+    std::vector<int8_distance::Kernels> kernels{
+        int8_distance::NativeKernels()};
+#if (defined(__x86_64__) || defined(_M_X64)) && defined(__GNUC__)
+    if (__builtin_cpu_supports("avx2")) {
+        kernels.push_back(int8_distance::Avx2Kernels());
+    }
+    if (__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vnni")) {
+        kernels.push_back(int8_distance::Avx512VnniKernels());
+    }
+#endif
+    return kernels;
+}
+
+}  // namespace
+
+TEST(Int8DistanceTest, DotsAreExact) {
+    std::default_random_engine er(42);
+    std::uniform_int_distribution<int> dist(-128, 127);
+    const int64_t num_queries = int8_distance::kMaxDotQueries;
+    // below, at and past the vector widths, with tails
+    for (int64_t dim : {1, 15, 16, 64, 67, 200}) {
+        std::vector<int8_t> queries(num_queries * dim);
+        std::vector<int8_t> vector(dim);
+        for (auto& value : queries) {
+            value = static_cast<int8_t>(dist(er));
+        }
+        for (auto& value : vector) {
+            value = static_cast<int8_t>(dist(er));
+        }
+        // the extremes, where a shift to unsigned would overflow
+        vector[0] = -128;
+        queries[0] = -128;
+        int32_t expected_norm = 0;
+        for (auto value : vector) {
+            expected_norm += int32_t(value) * value;
+        }
+        for (const auto& kernels : AllKernels()) {
+            for (int64_t n = 0; n <= num_queries; ++n) {
+                std::vector<int32_t> dots(num_queries, -1);
+                auto norm = kernels.dots(
+                    queries.data(), n, vector.data(), dim, dots.data());
+                EXPECT_EQ(norm, expected_norm) << kernels.name << " " << dim;
+                for (int64_t q = 0; q < n; ++q) {
+                    int32_t expected = 0;
+                    for (int64_t i = 0; i < dim; ++i) {
+                        expected += int32_t(queries[q * dim + i]) * vector[i];
+                    }
+                    EXPECT_EQ(dots[q], expected) << kernels.name << " " << dim;
+                }
+            }
+        }
+    }
+}
+
+TEST(Int8DistanceTest, DotsTileQueries) {
+    const int64_t dim = 33;
+    const int64_t num_queries = 11;
+    std::vector<int8_t> queries(num_queries * dim);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        queries[i] = static_cast<int8_t>(i % 7 - 3);
+    }
+    std::vector<int8_t> vector(dim, 2);
+    std::vector<int32_t> dots(num_queries);
+    EXPECT_EQ(
+        Int8Dots(queries.data(), num_queries, vector.data(), dim, dots.data()),
+        4 * dim);
+    EXPECT_EQ(Int8SquaredNorm(vector.data(), dim), 4 * dim);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        int32_t expected = 0;
+        for (int64_t i = 0; i < dim; ++i) {
+            expected += 2 * queries[q * dim + i];
+        }
+        EXPECT_EQ(dots[q], expected);
+    }
+}
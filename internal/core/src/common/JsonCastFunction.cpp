@@ -89,6 +89,28 @@ JsonCastFunction::CastJsonValue(const JsonCastFunction& cast_function,
     return res;
 }
 
+template <typename T>
+std::optional<T>
+JsonCastFunction::CastJsonValue(const JsonCastFunction& cast_function,
+                                const simdjson::dom::element& value) {
+    AssertInfo(cast_function.match<T>(), "Type mismatch");
+
+    switch (value.type()) {
+        case simdjson::dom::element_type::STRING:
+            return cast_function.cast<T, std::string>(
+                std::string(value.get_string().value()));
+        case simdjson::dom::element_type::INT64:
+            return cast_function.cast<T, int64_t>(value.get_int64().value());
+        case simdjson::dom::element_type::UINT64:
+        case simdjson::dom::element_type::DOUBLE:
+            return cast_function.cast<T, double>(value.get_double().value());
+        case simdjson::dom::element_type::BOOL:
+            return cast_function.cast<T, bool>(value.get_bool().value());
+        default:
+            return std::nullopt;
+    }
+}
+
 template std::optional<bool>
 JsonCastFunction::CastJsonValue<bool>(const JsonCastFunction& cast_function,
                                       const Json& json,
@@ -110,4 +132,21 @@ JsonCastFunction::CastJsonValue<std::string>(
     const Json& json,
     const std::string& pointer);
 
+template std::optional<bool>
+JsonCastFunction::CastJsonValue<bool>(const JsonCastFunction& cast_function,
+                                      const simdjson::dom::element& value);
+
+template std::optional<int64_t>
+JsonCastFunction::CastJsonValue<int64_t>(const JsonCastFunction& cast_function,
+                                         const simdjson::dom::element& value);
+
+template std::optional<double>
+JsonCastFunction::CastJsonValue<double>(const JsonCastFunction& cast_function,
+                                        const simdjson::dom::element& value);
+
+template std::optional<std::string>
+JsonCastFunction::CastJsonValue<std::string>(
+    const JsonCastFunction& cast_function,
+    const simdjson::dom::element& value);
+
 }  // namespace milvus
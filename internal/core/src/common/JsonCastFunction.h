@@ -52,6 +52,12 @@ class JsonCastFunction {
                   const Json& json,
                   const std::string& pointer);
 
+    // the same for a value of a parsed json
+    template <typename T>
+    static std::optional<T>
+    CastJsonValue(const JsonCastFunction& cast_function,
+                  const simdjson::dom::element& value);
+
  private:
     JsonCastFunction(Type type) : cast_function_type_(type) {
     }
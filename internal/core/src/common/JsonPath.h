@@ -0,0 +1,211 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "common/Json.h"
+
+namespace milvus {
+
+// Typed values of a JSON path over a batch of rows, laid out by column, so
+// a predicate runs over them in a tight loop once every row is walked.
+template <typename T>
+struct JsonBatch {
+    enum Kind : uint8_t {
+        // the row holds no T at the path
+        kMissing = 0,
+        // values[i] holds it
+        kValue = 1,
+        // int64 only, the row holds a number that is no int64, in doubles[i]
+        kDouble = 2,
+        // the row was not asked for
+        kSkipped = 3,
+    };
+
+    void
+    resize(int64_t size) {
+        values.resize(size);
+        kinds.resize(size);
+        if constexpr (std::is_same_v<T, int64_t>) {
+            doubles.resize(size);
+        }
+    }
+
+    std::vector<T> values;
+    std::vector<double> doubles;
+    std::vector<uint8_t> kinds;
+};
+
+// A JSON pointer compiled once from the nested path of an expression. Rows
+// are walked by ready keys and array indices, with no pointer string to
+// split and unescape for each of them, and one walk reads a number both as
+// int64 and as double. A step follows simdjson's at_pointer: it indexes an
+// array when it is an array index, and names a field of an object.
+class JsonPath {
+ public:
+    JsonPath() = default;
+
+    explicit JsonPath(const std::vector<std::string>& nested_path) {
+        steps_.reserve(nested_path.size());
+        for (const auto& key : nested_path) {
+            steps_.push_back({key, ParseIndex(key)});
+        }
+    }
+
+    bool
+    empty() const {
+        return steps_.empty();
+    }
+
+    template <typename T>
+    value_result<T>
+    at(const Json& json) const {
+        if (steps_.empty()) {
+            return json.template at<T>("");
+        }
+        auto doc = json.doc();
+        if (doc.error()) {
+            return doc.error();
+        }
+        auto value = Find(doc.value_unsafe());
+        if (value.error()) {
+            return value.error();
+        }
+        return value.value_unsafe().template get<T>();
+    }
+
+    // Reads the path of rows [0, size) into batch. row(i) gives the Json
+    // of row i, or nullptr for a row that is not asked for.
+    template <typename T, typename RowFunc>
+    void
+    Extract(int64_t size, RowFunc&& row, JsonBatch<T>& batch) const {
+        static_assert(std::is_same_v<T, bool> || std::is_same_v<T, int64_t> ||
+                          std::is_same_v<T, double>,
+                      "only scalars outlive the parser state of their row");
+        batch.resize(size);
+        for (int64_t i = 0; i < size; ++i) {
+            const Json* json = row(i);
+            if (json == nullptr) {
+                batch.kinds[i] = JsonBatch<T>::kSkipped;
+                continue;
+            }
+            batch.kinds[i] = JsonBatch<T>::kMissing;
+            auto doc = json->doc();
+            if (doc.error()) {
+                continue;
+            }
+            if (steps_.empty()) {
+                Read(doc.value_unsafe(), batch, i);
+                continue;
+            }
+            auto value = Find(doc.value_unsafe());
+            if (!value.error()) {
+                Read(value.value_unsafe(), batch, i);
+            }
+        }
+    }
+
+ private:
+    struct Step {
+        std::string key_;
+        // -1 if key_ is no array index
+        int64_t index_;
+    };
+
+    // digits with no leading zero, as at_pointer takes an array index
+    static int64_t
+    ParseIndex(const std::string& key) {
+        if (key.empty() || key.size() > 18 ||
+            (key.size() > 1 && key[0] == '0')) {
+            return -1;
+        }
+        int64_t index = 0;
+        for (auto c : key) {
+            if (c < '0' || c > '9') {
+                return -1;
+            }
+            index = index * 10 + (c - '0');
+        }
+        return index;
+    }
+
+    template <typename Node>
+    static value_result<simdjson::ondemand::value>
+    Child(Node& node, const Step& step) {
+        simdjson::ondemand::json_type type;
+        SIMDJSON_TRY(node.type().get(type));
+        switch (type) {
+            case simdjson::ondemand::json_type::array: {
+                if (step.index_ < 0) {
+                    return simdjson::INCORRECT_TYPE;
+                }
+                simdjson::ondemand::array array;
+                SIMDJSON_TRY(node.get_array().get(array));
+                return array.at(step.index_);
+            }
+            case simdjson::ondemand::json_type::object: {
+                simdjson::ondemand::object object;
+                SIMDJSON_TRY(node.get_object().get(object));
+                return object.find_field(step.key_);
+            }
+            default:
+                return simdjson::NO_SUCH_FIELD;
+        }
+    }
+
+    value_result<simdjson::ondemand::value>
+    Find(simdjson::ondemand::document& doc) const {
+        auto value = Child(doc, steps_[0]);
+        for (size_t i = 1; i < steps_.size() && !value.error(); ++i) {
+            value = Child(value.value_unsafe(), steps_[i]);
+        }
+        return value;
+    }
+
+    // a failed read leaves the value unconsumed, so an int64 read that
+    // fails is retried as a double in place
+    template <typename Node, typename T>
+    static void
+    Read(Node& node, JsonBatch<T>& batch, int64_t i) {
+        if constexpr (std::is_same_v<T, bool>) {
+            bool value;
+            if (!node.get_bool().get(value)) {
+                batch.values[i] = value;
+                batch.kinds[i] = JsonBatch<T>::kValue;
+            }
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            if (!node.get_int64().get(batch.values[i])) {
+                batch.kinds[i] = JsonBatch<T>::kValue;
+            } else if (!node.get_double().get(batch.doubles[i])) {
+                batch.kinds[i] = JsonBatch<T>::kDouble;
+            }
+        } else {
+            if (!node.get_double().get(batch.values[i])) {
+                batch.kinds[i] = JsonBatch<T>::kValue;
+            }
+        }
+    }
+
+ private:
+    std::vector<Step> steps_;
+};
+
+}  // namespace milvus
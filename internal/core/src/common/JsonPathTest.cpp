@@ -0,0 +1,113 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/JsonPath.h"
+
+using namespace milvus;
+
+namespace {
+
+std::vector<Json>
+MakeRows(const std::vector<std::string>& texts) {
+    std::vector<Json> rows;
+    for (const auto& text : texts) {
+        rows.emplace_back(simdjson::padded_string(text));
+    }
+    return rows;
+}
+
+const std::vector<std::string> kTexts = {
+    R"({"a": {"b": 3}})",
+    R"({"a": {"b": 2.5}})",
+    R"({"a": {"b": true}})",
+    R"({"a": {"c": 1, "b": -7}})",
+    R"({"a": [10, 20]})",
+    R"({"a": {"0": 4, "b": 18446744073709551615}})",
+    R"({"a": "x"})",
+    R"([{"b": 1}])",
+    R"(5)",
+    R"({})",
+};
+
+template <typename T>
+void
+CheckAgainstPointer(const std::vector<std::string>& nested_path) {
+    auto rows = MakeRows(kTexts);
+    JsonPath path(nested_path);
+    auto pointer = Json::pointer(nested_path);
+
+    JsonBatch<T> batch;
+    path.Extract(
+        rows.size(),
+        [&](int64_t i) -> const Json* {
+            // every third row is not asked for
+            return i % 3 == 2 ? nullptr : &rows[i];
+        },
+        batch);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        auto expected = rows[i].template at<T>(pointer);
+        auto compiled = path.template at<T>(rows[i]);
+        // only whether a lookup fails is relied on, not its error code
+        ASSERT_EQ(!expected.error(), !compiled.error()) << kTexts[i];
+        if (!expected.error()) {
+            ASSERT_EQ(expected.value(), compiled.value());
+        }
+
+        if (i % 3 == 2) {
+            ASSERT_EQ(batch.kinds[i], JsonBatch<T>::kSkipped);
+            continue;
+        }
+        if (!expected.error()) {
+            ASSERT_EQ(batch.kinds[i], JsonBatch<T>::kValue) << kTexts[i];
+            ASSERT_EQ(batch.values[i], expected.value());
+            continue;
+        }
+        if constexpr (std::is_same_v<T, int64_t>) {
+            auto as_double = rows[i].template at<double>(pointer);
+            if (!as_double.error()) {
+                ASSERT_EQ(batch.kinds[i], JsonBatch<T>::kDouble) << kTexts[i];
+                ASSERT_EQ(batch.doubles[i], as_double.value());
+                continue;
+            }
+        }
+        ASSERT_EQ(batch.kinds[i], JsonBatch<T>::kMissing) << kTexts[i];
+    }
+}
+
+}  // namespace
+
+TEST(JsonPath, MatchesPointer) {
+    const std::vector<std::vector<std::string>> paths = {
+        {}, {"a"}, {"a", "b"}, {"a", "0"}, {"a", "1"}, {"0", "b"}, {"x"}};
+    for (const auto& path : paths) {
+        CheckAgainstPointer<int64_t>(path);
+        CheckAgainstPointer<double>(path);
+        CheckAgainstPointer<bool>(path);
+    }
+}
+
+TEST(JsonPath, EscapedKeys) {
+    auto rows = MakeRows({R"({"a/b": {"~c": 9}})"});
+    JsonPath path({"a/b", "~c"});
+    auto value = path.at<int64_t>(rows[0]);
+    ASSERT_FALSE(value.error());
+    ASSERT_EQ(value.value(), 9);
+}
@@ -0,0 +1,110 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/KernelRegistry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus {
+
+namespace {
+
+// timed runs of the workload per variant, after a warm up run
+constexpr int kBenchmarkRuns = 5;
+
+// how much faster than the variants preferred to it a variant has to be,
+// the timings of a short benchmark are noisy
+constexpr double kMinSpeedup = 1.05;
+
+}  // namespace
+
+KernelRegistry&
+KernelRegistry::Instance() {
+    static KernelRegistry instance;
+    return instance;
+}
+
+void
+KernelRegistry::Register(KernelFamily family) {
+    AssertInfo(!family.variants.empty(),
+               "kernel family {} has no variants",
+               family.name);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(
+        families_.begin(), families_.end(), [&](const KernelFamily& f) {
+            return f.name == family.name;
+        });
+    if (it != families_.end()) {
+        *it = std::move(family);
+    } else {
+        families_.push_back(std::move(family));
+    }
+}
+
+void
+KernelRegistry::Init(bool benchmark) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : families_) {
+        std::string variant;
+        if (benchmark && family.variants.size() > 1 && family.workload) {
+            variant = Benchmark(family);
+        } else {
+            variant = family.variants.front();
+            family.select(variant);
+        }
+        selections_[family.name] = variant;
+        LOG_INFO("kernel family {} dispatches to {}", family.name, variant);
+    }
+}
+
+std::map<std::string, std::string>
+KernelRegistry::Selections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return selections_;
+}
+
+std::string
+KernelRegistry::Benchmark(const KernelFamily& family) {
+    std::string best;
+    double best_seconds = std::numeric_limits<double>::max();
+    for (const auto& variant : family.variants) {
+        family.select(variant);
+        family.workload();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kBenchmarkRuns; ++i) {
+            family.workload();
+        }
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        LOG_INFO("kernel family {} variant {} took {} seconds",
+                 family.name,
+                 variant,
+                 elapsed.count());
+        if (best.empty() || elapsed.count() * kMinSpeedup < best_seconds) {
+            best = variant;
+            best_seconds = elapsed.count();
+        }
+    }
+    family.select(best);
+    return best;
+}
+
+}  // namespace milvus
@@ -0,0 +1,73 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace milvus {
+
+// A set of kernels with a variant per instruction set, as the int8 distance
+// or the minhash kernels, which are dispatched together.
+struct KernelFamily {
+    std::string name;
+    // the variants this cpu runs, preferred first
+    std::vector<std::string> variants;
+    // points the family at one of variants
+    std::function<void(const std::string&)> select;
+    // a short run of the kernels of the family, timed by the startup
+    // benchmark on every variant
+    std::function<void()> workload;
+};
+
+// Process-level registry of the kernel families. Every family starts with
+// its preferred variant, the widest instruction set the cpu has. Init picks
+// the variants once at startup, and with the benchmark it picks the fastest
+// variant of the family instead: on hosts lowering the frequency for
+// AVX-512, the AVX2 kernels may be faster.
+class KernelRegistry {
+ public:
+    static KernelRegistry&
+    Instance();
+
+    // replaces a registered family of the same name
+    void
+    Register(KernelFamily family);
+
+    void
+    Init(bool benchmark);
+
+    // the variant picked per family name, empty before Init
+    std::map<std::string, std::string>
+    Selections() const;
+
+ private:
+    KernelRegistry() = default;
+
+    // the fastest variant of family, which is left selected
+    static std::string
+    Benchmark(const KernelFamily& family);
+
+    mutable std::mutex mutex_;
+    std::vector<KernelFamily> families_;
+    std::map<std::string, std::string> selections_;
+};
+
+}  // namespace milvus
@@ -0,0 +1,70 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "common/KernelRegistry.h"
+
+using milvus::KernelFamily;
+using milvus::KernelRegistry;
+
+namespace {
+
+// a family whose "slow" variant sleeps in the workload, the selection is
+// shared as the registry outlives the tests
+KernelFamily
+FakeFamily(const std::string& name, std::shared_ptr<std::string> selected) {
+    return KernelFamily{
+        name,
+        {"slow", "fast"},
+        [selected](const std::string& variant) { *selected = variant; },
+        [selected] {
+            if (*selected == "slow") {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            }
+        }};
+}
+
+}  // namespace
+
+TEST(KernelRegistryTest, PreferredVariantWithoutBenchmark) {
+    auto& registry = KernelRegistry::Instance();
+    auto selected = std::make_shared<std::string>();
+    registry.Register(FakeFamily("fake_preferred", selected));
+    registry.Init(false);
+    EXPECT_EQ(*selected, "slow");
+    EXPECT_EQ(registry.Selections().at("fake_preferred"), "slow");
+}
+
+TEST(KernelRegistryTest, BenchmarkPicksFastestVariant) {
+    auto& registry = KernelRegistry::Instance();
+    auto selected = std::make_shared<std::string>();
+    registry.Register(FakeFamily("fake_benchmark", selected));
+    registry.Init(true);
+    EXPECT_EQ(*selected, "fast");
+    EXPECT_EQ(registry.Selections().at("fake_benchmark"), "fast");
+
+    // registering a family again replaces it
+    auto other = std::make_shared<std::string>();
+    registry.Register(FakeFamily("fake_benchmark", other));
+    registry.Init(false);
+    EXPECT_EQ(*other, "slow");
+    EXPECT_EQ(registry.Selections().at("fake_benchmark"), "slow");
+}
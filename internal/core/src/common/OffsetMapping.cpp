@@ -1,7 +1,87 @@
 #include "common/OffsetMapping.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include "common/BitUtil.h"
+
 namespace milvus {
 
+namespace {
+
+// n <= 64 bits of a bitmap of nbits bits from bit pos, low bit first
+uint64_t
+LoadBits(const uint8_t* data, int64_t nbits, int64_t pos, int64_t n) {
+    if (n == 0) {
+        return 0;
+    }
+    auto byte = pos >> 3;
+    auto shift = pos & 7;
+    auto nbytes = (nbits + 7) >> 3;
+    uint64_t value = 0;
+    std::memcpy(&value, data + byte, std::min<int64_t>(8, nbytes - byte));
+    value >>= shift;
+    if (shift != 0 && byte + 8 < nbytes) {
+        value |= uint64_t(data[byte + 8]) << (64 - shift);
+    }
+    return n == 64 ? value : value & ((uint64_t(1) << n) - 1);
+}
+
+// the word_idx-th 64 bits of a bitmap of nbits bits
+void
+StoreWord(uint8_t* data, int64_t nbits, int64_t word_idx, uint64_t value) {
+    auto byte = word_idx * 8;
+    auto nbytes = (nbits + 7) >> 3;
+    std::memcpy(data + byte, &value, std::min<int64_t>(8, nbytes - byte));
+}
+
+// appends bits to a zeroed bitmap, dropping those past its end
+class BitWriter {
+ public:
+    BitWriter(uint8_t* data, int64_t nbits) : data_(data), nbits_(nbits) {
+    }
+
+    void
+    Append(uint64_t value, int64_t n) {
+        if (n == 0) {
+            return;
+        }
+        word_ |= value << used_;
+        if (used_ + n < 64) {
+            used_ += n;
+            return;
+        }
+        Flush();
+        word_ = used_ == 0 ? 0 : value >> (64 - used_);
+        used_ = used_ + n - 64;
+    }
+
+    void
+    Finish() {
+        if (used_ > 0) {
+            Flush();
+        }
+    }
+
+ private:
+    void
+    Flush() {
+        if (word_idx_ * 64 < nbits_) {
+            StoreWord(data_, nbits_, word_idx_, word_);
+        }
+        ++word_idx_;
+    }
+
+ private:
+    uint8_t* data_;
+    int64_t nbits_;
+    int64_t word_idx_{0};
+    uint64_t word_{0};
+    int64_t used_{0};
+};
+
+}  // namespace
+
 void
 OffsetMapping::Build(const bool* valid_data,
                      int64_t total_count,
@@ -12,6 +92,9 @@ OffsetMapping::Build(const bool* valid_data,
     }
 
     std::unique_lock<std::shared_mutex> lck(mutex_);
+    if (start_logical < total_count_ || start_physical != valid_count_) {
+        ordered_ = false;
+    }
     enabled_ = true;
     total_count_ = start_logical + total_count;
 
@@ -71,6 +154,9 @@ OffsetMapping::BuildIncremental(const bool* valid_data,
     }
 
     std::unique_lock<std::shared_mutex> lck(mutex_);
+    if (start_logical < total_count_ || start_physical != valid_count_) {
+        ordered_ = false;
+    }
     enabled_ = true;
     total_count_ = start_logical + count;
 
@@ -167,6 +253,147 @@ OffsetMapping::IsValid(int64_t logical_offset) const {
     return GetPhysicalOffset(logical_offset) >= 0;
 }
 
+void
+OffsetMapping::GetPhysicalOffsets(const int64_t* logical_offsets,
+                                  int64_t count,
+                                  int64_t* physical_offsets) const {
+    std::shared_lock<std::shared_mutex> lck(mutex_);
+    for (int64_t i = 0; i < count; ++i) {
+        auto logical_offset = logical_offsets[i];
+        if (!enabled_) {
+            physical_offsets[i] = logical_offset;
+        } else if (use_map_) {
+            auto it = l2p_map_.find(static_cast<int32_t>(logical_offset));
+            physical_offsets[i] = it != l2p_map_.end() ? it->second : -1;
+        } else {
+            physical_offsets[i] =
+                logical_offset >= 0 &&
+                        logical_offset < static_cast<int64_t>(l2p_vec_.size())
+                    ? l2p_vec_[logical_offset]
+                    : -1;
+        }
+    }
+}
+
+void
+OffsetMapping::GetLogicalOffsets(const int64_t* physical_offsets,
+                                 int64_t count,
+                                 int64_t* logical_offsets) const {
+    std::shared_lock<std::shared_mutex> lck(mutex_);
+    for (int64_t i = 0; i < count; ++i) {
+        auto physical_offset = physical_offsets[i];
+        if (!enabled_) {
+            logical_offsets[i] = physical_offset;
+        } else if (use_map_) {
+            auto it = p2l_map_.find(static_cast<int32_t>(physical_offset));
+            logical_offsets[i] = it != p2l_map_.end() ? it->second : -1;
+        } else {
+            logical_offsets[i] =
+                physical_offset >= 0 &&
+                        physical_offset < static_cast<int64_t>(p2l_vec_.size())
+                    ? p2l_vec_[physical_offset]
+                    : -1;
+        }
+    }
+}
+
+uint64_t
+OffsetMapping::ValidMask(int64_t logical_begin, int64_t n) const {
+    if (!enabled_) {
+        return n == 64 ? ~uint64_t(0) : (uint64_t(1) << n) - 1;
+    }
+    uint64_t mask = 0;
+    if (use_map_) {
+        for (int64_t i = 0; i < n; ++i) {
+            if (l2p_map_.count(static_cast<int32_t>(logical_begin + i)) > 0) {
+                mask |= uint64_t(1) << i;
+            }
+        }
+        return mask;
+    }
+    auto end = std::min<int64_t>(logical_begin + n, l2p_vec_.size());
+    for (int64_t i = logical_begin; i < end; ++i) {
+        mask |= uint64_t(l2p_vec_[i] >= 0) << (i - logical_begin);
+    }
+    return mask;
+}
+
+void
+OffsetMapping::CompressLogicalToPhysical(const uint8_t* logical_bits,
+                                         int64_t logical_count,
+                                         uint8_t* physical_bits,
+                                         int64_t physical_count) const {
+    std::shared_lock<std::shared_mutex> lck(mutex_);
+    if (enabled_ && !ordered_) {
+        // physical offsets out of logical order, place each bit by itself
+        auto end = std::min(valid_count_, physical_count);
+        for (int64_t physical = 0; physical < end; ++physical) {
+            int64_t logical = -1;
+            if (use_map_) {
+                auto it = p2l_map_.find(static_cast<int32_t>(physical));
+                logical = it != p2l_map_.end() ? it->second : -1;
+            } else if (physical < static_cast<int64_t>(p2l_vec_.size())) {
+                logical = p2l_vec_[physical];
+            }
+            if (logical >= 0 && logical < logical_count &&
+                (logical_bits[logical >> 3] >> (logical & 7) & 1)) {
+                physical_bits[physical >> 3] |= uint8_t(1) << (physical & 7);
+            }
+        }
+        return;
+    }
+
+    BitWriter writer(physical_bits, physical_count);
+    for (int64_t begin = 0; begin < logical_count; begin += 64) {
+        auto n = std::min<int64_t>(64, logical_count - begin);
+        auto mask = ValidMask(begin, n);
+        auto bits = LoadBits(logical_bits, logical_count, begin, n);
+        writer.Append(bits::extractBits(bits, mask),
+                      __builtin_popcountll(mask));
+    }
+    writer.Finish();
+}
+
+void
+OffsetMapping::ExpandPhysicalToLogical(const uint8_t* physical_bits,
+                                       int64_t physical_count,
+                                       uint8_t* logical_bits,
+                                       int64_t logical_count) const {
+    std::shared_lock<std::shared_mutex> lck(mutex_);
+    if (enabled_ && !ordered_) {
+        // physical offsets out of logical order, place each bit by itself
+        std::memset(logical_bits, 0, (logical_count + 7) >> 3);
+        for (int64_t logical = 0; logical < logical_count; ++logical) {
+            int64_t physical = -1;
+            if (use_map_) {
+                auto it = l2p_map_.find(static_cast<int32_t>(logical));
+                physical = it != l2p_map_.end() ? it->second : -1;
+            } else if (logical < static_cast<int64_t>(l2p_vec_.size())) {
+                physical = l2p_vec_[logical];
+            }
+            if (physical >= 0 && physical < physical_count &&
+                (physical_bits[physical >> 3] >> (physical & 7) & 1)) {
+                logical_bits[logical >> 3] |= uint8_t(1) << (logical & 7);
+            }
+        }
+        return;
+    }
+
+    int64_t physical = 0;
+    for (int64_t begin = 0; begin < logical_count; begin += 64) {
+        auto n = std::min<int64_t>(64, logical_count - begin);
+        auto mask = ValidMask(begin, n);
+        int64_t valid = __builtin_popcountll(mask);
+        auto take = std::clamp<int64_t>(physical_count - physical, 0, valid);
+        auto bits = LoadBits(physical_bits, physical_count, physical, take);
+        StoreWord(logical_bits,
+                  logical_count,
+                  begin / 64,
+                  bits::depositBits(bits, mask));
+        physical += valid;
+    }
+}
+
 int64_t
 OffsetMapping::GetValidCount() const {
     std::shared_lock<std::shared_mutex> lck(mutex_);
@@ -60,6 +60,36 @@ class OffsetMapping {
     bool
     IsValid(int64_t logical_offset) const;
 
+    // Batch forms of GetPhysicalOffset and GetLogicalOffset, taking the
+    // lock once for all count offsets
+    void
+    GetPhysicalOffsets(const int64_t* logical_offsets,
+                       int64_t count,
+                       int64_t* physical_offsets) const;
+
+    void
+    GetLogicalOffsets(const int64_t* physical_offsets,
+                      int64_t count,
+                      int64_t* logical_offsets) const;
+
+    // Gathers the bits of the valid rows among the first logical_count
+    // logical rows into the first physical_count physical bits, 64 rows at a
+    // time with a bit extract. physical_bits must be zeroed.
+    void
+    CompressLogicalToPhysical(const uint8_t* logical_bits,
+                              int64_t logical_count,
+                              uint8_t* physical_bits,
+                              int64_t physical_count) const;
+
+    // Scatters the first physical_count physical bits to their logical rows
+    // with a bit deposit, so a kernel can run over the dense physical data
+    // and still produce a logical bitmap. Null rows come out cleared.
+    void
+    ExpandPhysicalToLogical(const uint8_t* physical_bits,
+                            int64_t physical_count,
+                            uint8_t* logical_bits,
+                            int64_t logical_count) const;
+
     // Get count of valid (non-null) elements
     int64_t
     GetValidCount() const;
@@ -76,9 +106,18 @@ class OffsetMapping {
     int64_t
     GetTotalCount() const;
 
+ private:
+    // valid rows among the n <= 64 logical rows from logical_begin, one bit
+    // per row; the caller holds the lock
+    uint64_t
+    ValidMask(int64_t logical_begin, int64_t n) const;
+
  private:
     bool enabled_{false};
     bool use_map_{false};  // true: use map for L2P, false: use vec
+    // whether physical offsets were handed out in logical order, so the
+    // physical offset of a valid row is the count of valid rows before it
+    bool ordered_{true};
 
     // Vec mode storage (uses int32_t to save memory)
     std::vector<int32_t> l2p_vec_;  // logical -> physical, -1 means null
@@ -0,0 +1,109 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/OffsetMapping.h"
+
+using namespace milvus;
+
+namespace {
+
+bool
+TestBit(const std::vector<uint8_t>& bits, int64_t i) {
+    return bits[i >> 3] >> (i & 7) & 1;
+}
+
+void
+SetBit(std::vector<uint8_t>& bits, int64_t i) {
+    bits[i >> 3] |= uint8_t(1) << (i & 7);
+}
+
+// checks the batch calls against GetPhysicalOffset row by row
+void
+CheckAgainstRowwise(const OffsetMapping& mapping, int64_t n) {
+    std::mt19937 rng(42);
+    std::vector<uint8_t> logical((n + 7) / 8);
+    for (int64_t i = 0; i < n; ++i) {
+        if (rng() % 2) {
+            SetBit(logical, i);
+        }
+    }
+
+    auto valid = mapping.GetValidCount();
+    std::vector<uint8_t> physical((valid + 7) / 8);
+    mapping.CompressLogicalToPhysical(
+        logical.data(), n, physical.data(), valid);
+    std::vector<uint8_t> expanded((n + 7) / 8, 0xff);
+    mapping.ExpandPhysicalToLogical(
+        physical.data(), valid, expanded.data(), n);
+
+    std::vector<int64_t> logical_offsets(n);
+    for (int64_t i = 0; i < n; ++i) {
+        logical_offsets[i] = i;
+    }
+    std::vector<int64_t> physical_offsets(n);
+    mapping.GetPhysicalOffsets(
+        logical_offsets.data(), n, physical_offsets.data());
+
+    for (int64_t i = 0; i < n; ++i) {
+        auto p = mapping.GetPhysicalOffset(i);
+        ASSERT_EQ(physical_offsets[i], p);
+        if (p < 0) {
+            ASSERT_FALSE(TestBit(expanded, i)) << i;
+            continue;
+        }
+        ASSERT_EQ(TestBit(physical, p), TestBit(logical, i)) << i;
+        ASSERT_EQ(TestBit(expanded, i), TestBit(logical, i)) << i;
+    }
+}
+
+}  // namespace
+
+TEST(OffsetMapping, BatchMatchesRowwise) {
+    for (int ratio : {1, 3, 20}) {
+        for (int64_t n : {1, 63, 64, 65, 1000}) {
+            std::mt19937 rng(n);
+            auto valid = std::make_unique<bool[]>(n);
+            for (int64_t i = 0; i < n; ++i) {
+                valid[i] = rng() % ratio == 0;
+            }
+            OffsetMapping mapping;
+            mapping.Build(valid.get(), n);
+            CheckAgainstRowwise(mapping, n);
+        }
+    }
+}
+
+TEST(OffsetMapping, OutOfOrderIncremental) {
+    // the second half arrives first, so physical order differs from
+    // logical order
+    const int64_t n = 200;
+    std::vector<uint8_t> valid(n);
+    for (int64_t i = 0; i < n; ++i) {
+        valid[i] = i % 3 != 0;
+    }
+    OffsetMapping mapping;
+    auto data = reinterpret_cast<const bool*>(valid.data());
+    mapping.BuildIncremental(data + n / 2, n / 2, n / 2, 0);
+    mapping.BuildIncremental(
+        data, n / 2, 0, mapping.GetNextPhysicalOffset());
+    CheckAgainstRowwise(mapping, n);
+}
@@ -0,0 +1,135 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/PackedIntegers.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+
+PackedIntegers::PackedIntegers(const uint64_t* values, int64_t size)
+    : size_(size) {
+    const auto num_blocks = (size + kBlockRows - 1) / kBlockRows;
+    blocks_.reserve(num_blocks);
+    for (int64_t b = 0; b < num_blocks; ++b) {
+        auto first = values + b * kBlockRows;
+        auto rows = std::min(kBlockRows, size - b * kBlockRows);
+        auto [min, max] = std::minmax_element(first, first + rows);
+        Block block;
+        block.base_ = *min;
+        const auto range = *max - *min;
+        block.width_ = range == 0 ? 0 : 64 - __builtin_clzll(range);
+        AssertInfo(words_.size() <= std::numeric_limits<uint32_t>::max(),
+                   "too many values to pack: {}",
+                   size);
+        block.word_offset_ = words_.size();
+        blocks_.push_back(block);
+        if (block.width_ == 0) {
+            continue;
+        }
+        // kBlockRows * width bits, the last block is padded to a full one
+        words_.resize(words_.size() + 2 * block.width_, 0);
+        auto words = words_.data() + block.word_offset_;
+        for (int64_t j = 0; j < rows; ++j) {
+            const auto offset = first[j] - block.base_;
+            const auto bit = j * block.width_;
+            const auto shift = bit & 63;
+            words[bit >> 6] |= offset << shift;
+            if (shift + block.width_ > 64) {
+                words[(bit >> 6) + 1] |= offset >> (64 - shift);
+            }
+        }
+    }
+}
+
+void
+PackedIntegers::Decode(int64_t begin, int64_t count, uint64_t* out) const {
+    AssertInfo(begin >= 0 && begin + count <= size_,
+               "decode [{}, {}) out of {} packed values",
+               begin,
+               begin + count,
+               size_);
+    auto i = begin;
+    const auto end = begin + count;
+    while (i < end) {
+        const auto& block = blocks_[i / kBlockRows];
+        const auto block_end =
+            std::min(end, (i / kBlockRows + 1) * kBlockRows);
+        if (block.width_ == 0) {
+            std::fill(out, out + (block_end - i), block.base_);
+        } else {
+            for (auto j = i; j < block_end; ++j) {
+                out[j - i] = block.base_ + Unpack(block, j % kBlockRows);
+            }
+        }
+        out += block_end - i;
+        i = block_end;
+    }
+}
+
+template <bool Greater>
+void
+PackedIntegers::Compare(uint64_t bound,
+                        int64_t begin,
+                        int64_t end,
+                        BitsetTypeView res) const {
+    AssertInfo(begin >= 0 && begin <= end && end <= size_,
+               "compare [{}, {}) out of {} packed values",
+               begin,
+               end,
+               size_);
+    auto i = begin;
+    while (i < end) {
+        const auto& block = blocks_[i / kBlockRows];
+        const auto block_end =
+            std::min(end, (i / kBlockRows + 1) * kBlockRows);
+        // the bound in the packed domain of the block
+        const uint64_t max_offset =
+            block.width_ == 64 ? std::numeric_limits<uint64_t>::max()
+                               : (uint64_t(1) << block.width_) - 1;
+        if (bound < block.base_ || bound - block.base_ >= max_offset) {
+            // every value of the block is on the same side of the bound
+            const bool greater = bound < block.base_;
+            for (auto j = i; j < block_end; ++j) {
+                res[j - begin] = greater == Greater;
+            }
+        } else {
+            const auto packed_bound = bound - block.base_;
+            for (auto j = i; j < block_end; ++j) {
+                const bool greater =
+                    Unpack(block, j % kBlockRows) > packed_bound;
+                res[j - begin] = greater == Greater;
+            }
+        }
+        i = block_end;
+    }
+}
+
+template void
+PackedIntegers::Compare<true>(uint64_t,
+                              int64_t,
+                              int64_t,
+                              BitsetTypeView) const;
+template void
+PackedIntegers::Compare<false>(uint64_t,
+                               int64_t,
+                               int64_t,
+                               BitsetTypeView) const;
+
+}  // namespace milvus
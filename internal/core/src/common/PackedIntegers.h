@@ -0,0 +1,123 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus {
+
+// Frame of reference bit packing of uint64 values. Rows are cut into blocks
+// of kBlockRows, each kept as its minimum and the offsets of its values from
+// it in just the bits the largest offset needs. A block of one repeated
+// value takes no bits at all, so runs cost only their block headers.
+//
+// Values are read in place, and a range of them compares with a bound in
+// the packed domain, without decoding it.
+class PackedIntegers {
+ public:
+    static constexpr int64_t kBlockRows = 128;
+
+    PackedIntegers() = default;
+
+    PackedIntegers(const uint64_t* values, int64_t size);
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
+    bool
+    empty() const {
+        return size_ == 0;
+    }
+
+    uint64_t
+    operator[](int64_t i) const {
+        const auto& block = blocks_[i / kBlockRows];
+        return block.base_ + Unpack(block, i % kBlockRows);
+    }
+
+    // values [begin, begin + count) to out
+    void
+    Decode(int64_t begin, int64_t count, uint64_t* out) const;
+
+    // bit i - begin of res is set if value i of [begin, end) is greater than
+    // bound, or for LessEqual not greater than it
+    void
+    GreaterThan(uint64_t bound,
+                int64_t begin,
+                int64_t end,
+                BitsetTypeView res) const {
+        Compare<true>(bound, begin, end, res);
+    }
+
+    void
+    LessEqual(uint64_t bound,
+              int64_t begin,
+              int64_t end,
+              BitsetTypeView res) const {
+        Compare<false>(bound, begin, end, res);
+    }
+
+    size_t
+    memory_size() const {
+        return blocks_.capacity() * sizeof(Block) +
+               words_.capacity() * sizeof(uint64_t);
+    }
+
+ private:
+    struct Block {
+        uint64_t base_;
+        // the first of the 2 * width_ words of the block
+        uint32_t word_offset_;
+        uint8_t width_;
+    };
+
+    uint64_t
+    Unpack(const Block& block, int64_t j) const {
+        const auto width = block.width_;
+        if (width == 0) {
+            return 0;
+        }
+        const uint64_t* words = words_.data() + block.word_offset_;
+        const auto bit = j * width;
+        const auto shift = bit & 63;
+        uint64_t value = words[bit >> 6] >> shift;
+        if (shift + width > 64) {
+            value |= words[(bit >> 6) + 1] << (64 - shift);
+        }
+        return width == 64 ? value : value & ((uint64_t(1) << width) - 1);
+    }
+
+    template <bool Greater>
+    void
+    Compare(uint64_t bound,
+            int64_t begin,
+            int64_t end,
+            BitsetTypeView res) const;
+
+ private:
+    int64_t size_{0};
+    std::vector<Block> blocks_;
+    std::vector<uint64_t> words_;
+};
+
+}  // namespace milvus
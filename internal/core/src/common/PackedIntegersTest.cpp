@@ -0,0 +1,88 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/PackedIntegers.h"
+
+using namespace milvus;
+
+namespace {
+
+void
+CheckPacked(const std::vector<uint64_t>& values) {
+    int64_t size = values.size();
+    PackedIntegers packed(values.data(), size);
+    ASSERT_EQ(packed.size(), size);
+    for (int64_t i = 0; i < size; ++i) {
+        ASSERT_EQ(packed[i], values[i]) << i;
+    }
+
+    int64_t begin = size / 3;
+    int64_t end = size - size / 5;
+    std::vector<uint64_t> decoded(end - begin);
+    packed.Decode(begin, end - begin, decoded.data());
+    for (int64_t i = begin; i < end; ++i) {
+        ASSERT_EQ(decoded[i - begin], values[i]) << i;
+    }
+
+    std::default_random_engine er(42);
+    for (int round = 0; round < 8; ++round) {
+        auto bound = values[er() % size] + (er() % 3) - 1;
+        BitsetType greater(end - begin);
+        BitsetType less_equal(end - begin);
+        packed.GreaterThan(bound, begin, end, greater.view());
+        packed.LessEqual(bound, begin, end, less_equal.view());
+        for (int64_t i = begin; i < end; ++i) {
+            ASSERT_EQ(greater[i - begin], values[i] > bound) << i;
+            ASSERT_EQ(less_equal[i - begin], values[i] <= bound) << i;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(PackedIntegersTest, RandomValues) {
+    std::default_random_engine er(42);
+    std::vector<uint64_t> values(1000);
+    for (auto& value : values) {
+        value = (static_cast<uint64_t>(er()) << 32) | er();
+    }
+    CheckPacked(values);
+}
+
+TEST(PackedIntegersTest, TimestampLikeValues) {
+    // batches of rows share a timestamp, the batches rarely go back
+    std::default_random_engine er(42);
+    std::vector<uint64_t> values(5000);
+    uint64_t ts = uint64_t(450000000000) << 18;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i % 300 == 0) {
+            ts += er() % (1 << 20);
+        }
+        values[i] = i % 997 == 0 ? ts - 5 : ts;
+    }
+    CheckPacked(values);
+
+    PackedIntegers packed(values.data(), values.size());
+    EXPECT_LT(packed.memory_size(), values.size() * sizeof(uint64_t) / 4);
+}
+
+TEST(PackedIntegersTest, ConstantValues) {
+    std::vector<uint64_t> values(300, 7);
+    CheckPacked(values);
+    PackedIntegers packed(values.data(), values.size());
+    // no bits but the block headers
+    EXPECT_LT(packed.memory_size(), 3 * 32);
+}
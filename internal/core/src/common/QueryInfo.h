@@ -25,6 +25,8 @@
 
 namespace milvus {
 
+class RangeSearchBound;
+
 struct SearchIteratorV2Info {
     std::string token = "";
     uint32_t batch_size = 0;
@@ -49,6 +51,8 @@ struct SearchInfo {
     bool strict_cast_{false};
     std::shared_ptr<const IArrayOffsets> array_offsets_{
         nullptr};  // For element-level search
+    // shared by the range searches of a request that may prune by it
+    std::shared_ptr<RangeSearchBound> range_search_bound_;
 
     bool
     element_level() const {
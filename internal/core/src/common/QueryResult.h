@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <map>
 #include <limits>
@@ -94,6 +95,128 @@ operator<<(std::ostream& os, const StorageCost& cost) {
     return os;
 }
 
+// execution profile of one operator of a search/query, the times are
+// measured on a sample of the operator calls and scaled to all of them
+struct OperatorStats {
+    std::string operator_type;
+    std::string plannode_id;
+    int32_t operator_id = 0;
+
+    int64_t calls = 0;
+    int64_t timed_calls = 0;
+    int64_t wall_ns = 0;
+    int64_t cpu_ns = 0;
+    int64_t input_rows = 0;
+    int64_t output_rows = 0;
+    int64_t input_batches = 0;
+    int64_t output_batches = 0;
+    // bytes pinned from the caching layer
+    int64_t pinned_bytes = 0;
+    // chunks the skip index ruled out
+    int64_t skipped_chunks = 0;
+    // the most memory the operator held at once
+    int64_t peak_memory_bytes = 0;
+    // hardware events, counted on the timed calls of a query sampled for
+    // them and scaled like the times
+    int64_t counted_calls = 0;
+    int64_t cycles = 0;
+    int64_t instructions = 0;
+    int64_t llc_misses = 0;
+    int64_t branch_misses = 0;
+
+    void
+    operator+=(const OperatorStats& rhs) {
+        calls += rhs.calls;
+        timed_calls += rhs.timed_calls;
+        wall_ns += rhs.wall_ns;
+        cpu_ns += rhs.cpu_ns;
+        input_rows += rhs.input_rows;
+        output_rows += rhs.output_rows;
+        input_batches += rhs.input_batches;
+        output_batches += rhs.output_batches;
+        pinned_bytes += rhs.pinned_bytes;
+        skipped_chunks += rhs.skipped_chunks;
+        peak_memory_bytes = std::max(peak_memory_bytes, rhs.peak_memory_bytes);
+        counted_calls += rhs.counted_calls;
+        cycles += rhs.cycles;
+        instructions += rhs.instructions;
+        llc_misses += rhs.llc_misses;
+        branch_misses += rhs.branch_misses;
+    }
+
+    int64_t
+    EstimatedWallNs() const {
+        return Scale(wall_ns);
+    }
+
+    int64_t
+    EstimatedCpuNs() const {
+        return Scale(cpu_ns);
+    }
+
+    int64_t
+    EstimatedEvents(int64_t counted) const {
+        if (counted_calls == 0) {
+            return 0;
+        }
+        return static_cast<int64_t>(static_cast<double>(counted) * calls /
+                                    counted_calls);
+    }
+
+    std::string
+    ToString() const {
+        auto result = fmt::format(
+            "{}[{}]: wall_ns: {}, cpu_ns: {}, rows: {} -> {}, batches: {} -> "
+            "{}, pinned_bytes: {}, skipped_chunks: {}, peak_memory_bytes: {}",
+            operator_type,
+            plannode_id,
+            EstimatedWallNs(),
+            EstimatedCpuNs(),
+            input_rows,
+            output_rows,
+            input_batches,
+            output_batches,
+            pinned_bytes,
+            skipped_chunks,
+            peak_memory_bytes);
+        if (counted_calls > 0) {
+            result += fmt::format(
+                ", cycles: {}, instructions: {}, llc_misses: {}, "
+                "branch_misses: {}",
+                EstimatedEvents(cycles),
+                EstimatedEvents(instructions),
+                EstimatedEvents(llc_misses),
+                EstimatedEvents(branch_misses));
+        }
+        return result;
+    }
+
+ private:
+    int64_t
+    Scale(int64_t sampled_ns) const {
+        if (timed_calls == 0) {
+            return 0;
+        }
+        return static_cast<int64_t>(static_cast<double>(sampled_ns) * calls /
+                                    timed_calls);
+    }
+};
+
+// operator stats of a task, in pipeline order
+using QueryProfile = std::vector<OperatorStats>;
+
+inline std::string
+ToString(const QueryProfile& profile) {
+    std::string result;
+    for (const auto& stats : profile) {
+        if (!result.empty()) {
+            result += "; ";
+        }
+        result += stats.ToString();
+    }
+    return result;
+}
+
 struct OffsetDisPair {
  private:
     std::pair<int64_t, float> off_dis_;
@@ -315,6 +438,9 @@ struct SearchResult {
     // first fill data during fillPrimaryKey, and then update data after reducing search results
     std::vector<PkType> primary_keys_;
     DataType pk_type_;
+    // PkHash of the VARCHAR primary_keys_, kept in their order until the
+    // results are refreshed after reducing; empty for INT64 pks
+    std::vector<uint64_t> pk_hashes_;
 
     // fill data during reducing search result
     std::vector<int64_t> result_offsets_;
@@ -332,6 +458,8 @@ struct SearchResult {
         vector_iterators_;
     // record the storage usage in search
     StorageCost search_storage_cost_;
+    // per operator execution profile of the search
+    QueryProfile search_profile_;
 
     bool element_level_{false};
     std::vector<int32_t> element_indices_;
@@ -370,6 +498,8 @@ struct RetrieveResult {
     bool has_more_result = true;
     // record the storage usage in retrieve
     StorageCost retrieve_storage_cost_;
+    // per operator execution profile of the retrieve
+    QueryProfile retrieve_profile_;
 };
 
 using RetrieveResultPtr = std::shared_ptr<RetrieveResult>;
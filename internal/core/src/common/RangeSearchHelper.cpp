@@ -9,10 +9,13 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cmath>
 #include <queue>
 #include <vector>
 #include <functional>
 
+#include "common/Consts.h"
 #include "common/Utils.h"
 #include "common/RangeSearchHelper.h"
 
@@ -55,11 +58,10 @@ ReGenRangeSearchResult(DatasetPtr data_set,
     auto id = GetDatasetIDs(data_set);
     auto dist = GetDatasetDistance(data_set);
 
-    // use p_id and p_dist to GenResultDataset after sorted
-    auto p_id = new int64_t[topk * nq];
-    auto p_dist = new float[topk * nq];
-    std::fill_n(p_id, topk * nq, -1);
-    std::fill_n(p_dist, topk * nq, std::numeric_limits<float>::max());
+    // fill p_id and p_dist after sorted
+    auto result = EmptyRangeSearchResult(topk, nq);
+    auto p_id = const_cast<int64_t*>(GetDatasetIDs(result));
+    auto p_dist = const_cast<float*>(GetDatasetDistance(result));
 
     /*
      *   get result for one nq
@@ -104,9 +106,97 @@ ReGenRangeSearchResult(DatasetPtr data_set,
             pq.pop();
         }
     }
+    return result;
+}
+
+DatasetPtr
+EmptyRangeSearchResult(int64_t topk, int64_t nq) {
+    auto p_id = new int64_t[topk * nq];
+    auto p_dist = new float[topk * nq];
+    std::fill_n(p_id, topk * nq, -1);
+    std::fill_n(p_dist, topk * nq, std::numeric_limits<float>::max());
     return GenResultDataset(nq, topk, p_id, p_dist);
 }
 
+RangeSearchBound::RangeSearchBound(int64_t num_queries,
+                                   int64_t topk,
+                                   const std::string& metric_type)
+    : topk_(topk),
+      larger_is_closer_(PositivelyRelated(metric_type)),
+      bounds_(num_queries) {
+    // no bound until the topk of a query is full
+    for (auto& bound : bounds_) {
+        bound.store(larger_is_closer_ ? -std::numeric_limits<float>::infinity()
+                                      : std::numeric_limits<float>::infinity());
+    }
+}
+
+void
+RangeSearchBound::Update(int64_t num_queries,
+                         int64_t topk,
+                         const int64_t* ids,
+                         const float* distances) {
+    if (topk != topk_ || num_queries != static_cast<int64_t>(bounds_.size()) ||
+        topk <= 0) {
+        return;
+    }
+    for (int64_t i = 0; i < num_queries; ++i) {
+        auto kth = (i + 1) * topk - 1;
+        if (ids[kth] == -1) {
+            continue;
+        }
+        auto distance = distances[kth];
+        auto& bound = bounds_[i];
+        auto current = bound.load();
+        while ((larger_is_closer_ ? distance > current : distance < current) &&
+               !bound.compare_exchange_weak(current, distance)) {
+        }
+    }
+}
+
+std::optional<float>
+RangeSearchBound::Radius() const {
+    // one radius serves all queries, the loosest of their bounds
+    auto loosest = larger_is_closer_ ? std::numeric_limits<float>::infinity()
+                                     : -std::numeric_limits<float>::infinity();
+    for (const auto& bound : bounds_) {
+        auto value = bound.load();
+        loosest = larger_is_closer_ ? std::min(loosest, value)
+                                    : std::max(loosest, value);
+    }
+    if (std::isinf(loosest)) {
+        return std::nullopt;
+    }
+    // the radius is exclusive, a tie with the kth may still place by its pk
+    return std::nextafter(loosest,
+                          larger_is_closer_
+                              ? -std::numeric_limits<float>::infinity()
+                              : std::numeric_limits<float>::infinity());
+}
+
+bool
+RangeSearchBound::Tighten(int64_t topk, knowhere::Json& search_params) const {
+    if (topk != topk_ || !search_params.contains(RADIUS)) {
+        return true;
+    }
+    auto bound = Radius();
+    if (!bound.has_value()) {
+        return true;
+    }
+    float radius = search_params[RADIUS];
+    radius = larger_is_closer_ ? std::max(radius, bound.value())
+                               : std::min(radius, bound.value());
+    if (search_params.contains(RANGE_FILTER)) {
+        float range_filter = search_params[RANGE_FILTER];
+        if (larger_is_closer_ ? radius >= range_filter
+                              : radius <= range_filter) {
+            return false;
+        }
+    }
+    search_params[RADIUS] = radius;
+    return true;
+}
+
 void
 CheckRangeSearchParam(float radius,
                       float range_filter,
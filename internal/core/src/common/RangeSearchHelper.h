@@ -11,11 +11,56 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <vector>
+
 #include <common/Types.h>
 
 namespace milvus {
 
+// The kth best distance found so far for every query of a range search over
+// the chunks and segments of a request. A result further than it can't enter
+// the topk of its query any more, so the chunks and segments searched later
+// shrink their radius to it and stop expanding past the topk already found.
+// Searches on other threads publish to it concurrently.
+class RangeSearchBound {
+ public:
+    RangeSearchBound(int64_t num_queries,
+                     int64_t topk,
+                     const std::string& metric_type);
+
+    // publishes the kth distances of the queries whose topk is full in ids
+    // and distances, laid out topk per query and best first; results of
+    // another shape are ignored
+    void
+    Update(int64_t num_queries,
+           int64_t topk,
+           const int64_t* ids,
+           const float* distances);
+
+    // the radius no result past which can place for any query, ties kept,
+    // nullopt while the topk of some query isn't full
+    std::optional<float>
+    Radius() const;
+
+    // narrows the radius of range search params of a topk search to Radius(),
+    // false when it crosses the range_filter and nothing can place any more
+    bool
+    Tighten(int64_t topk, knowhere::Json& search_params) const;
+
+ private:
+    const int64_t topk_;
+    const bool larger_is_closer_;
+    std::vector<std::atomic<float>> bounds_;
+};
+
+// the range search result of nq queries that found nothing
+DatasetPtr
+EmptyRangeSearchResult(int64_t topk, int64_t nq);
+
 DatasetPtr
 ReGenRangeSearchResult(DatasetPtr data_set,
                        int64_t topk,
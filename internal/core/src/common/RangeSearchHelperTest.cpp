@@ -178,3 +178,74 @@ TEST_P(RangeSearchSortTest, CheckRangeSearchSort) {
     delete[] p_id;
     delete[] p_dist;
 }
+
+TEST(RangeSearchBoundTest, TightensToTheLoosestFullTopk) {
+    const int64_t topk = 3;
+    // L2: smaller is closer, the second query's topk isn't full yet
+    milvus::RangeSearchBound bound(2, topk, knowhere::metric::L2);
+    std::vector<int64_t> ids = {1, 2, 3, 4, 5, -1};
+    std::vector<float> distances = {0.1f, 0.2f, 0.5f, 0.1f, 0.3f, 0};
+    bound.Update(2, topk, ids.data(), distances.data());
+    EXPECT_FALSE(bound.Radius().has_value());
+
+    ids[5] = 6;
+    distances[5] = 0.8f;
+    bound.Update(2, topk, ids.data(), distances.data());
+    ASSERT_TRUE(bound.Radius().has_value());
+    // a tie with the kth still passes the exclusive radius
+    EXPECT_GT(bound.Radius().value(), 0.8f);
+    EXPECT_LT(bound.Radius().value(), 0.8001f);
+
+    // a worse chunk doesn't loosen it, a shape of another topk is ignored
+    std::vector<float> worse = {1, 2, 3, 1, 2, 3};
+    bound.Update(2, topk, ids.data(), worse.data());
+    bound.Update(3, 2, ids.data(), distances.data());
+    EXPECT_LT(bound.Radius().value(), 0.8001f);
+
+    knowhere::Json params;
+    params[milvus::RADIUS] = 2.0f;
+    EXPECT_TRUE(bound.Tighten(topk, params));
+    EXPECT_FLOAT_EQ(params[milvus::RADIUS].get<float>(),
+                    bound.Radius().value());
+    // a radius tighter already stays
+    params[milvus::RADIUS] = 0.5f;
+    EXPECT_TRUE(bound.Tighten(topk, params));
+    EXPECT_FLOAT_EQ(params[milvus::RADIUS].get<float>(), 0.5f);
+    // nothing past the range filter can place
+    params[milvus::RADIUS] = 2.0f;
+    params[milvus::RANGE_FILTER] = 1.0f;
+    EXPECT_FALSE(bound.Tighten(topk, params));
+    EXPECT_TRUE(bound.Tighten(topk + 1, params));
+}
+
+TEST(RangeSearchBoundTest, LargerIsCloser) {
+    const int64_t topk = 2;
+    milvus::RangeSearchBound bound(1, topk, knowhere::metric::IP);
+    std::vector<int64_t> ids = {7, 8};
+    std::vector<float> distances = {0.9f, 0.6f};
+    bound.Update(1, topk, ids.data(), distances.data());
+    distances = {0.95f, 0.7f};
+    bound.Update(1, topk, ids.data(), distances.data());
+    ASSERT_TRUE(bound.Radius().has_value());
+    EXPECT_LT(bound.Radius().value(), 0.7f);
+    EXPECT_GT(bound.Radius().value(), 0.6999f);
+
+    knowhere::Json params;
+    params[milvus::RADIUS] = 0.1f;
+    params[milvus::RANGE_FILTER] = 1.0f;
+    EXPECT_TRUE(bound.Tighten(topk, params));
+    EXPECT_FLOAT_EQ(params[milvus::RADIUS].get<float>(),
+                    bound.Radius().value());
+    // a tie with the kth at the range filter may still place
+    params[milvus::RANGE_FILTER] = 0.7f;
+    params[milvus::RADIUS] = 0.1f;
+    EXPECT_TRUE(bound.Tighten(topk, params));
+    params[milvus::RANGE_FILTER] = 0.65f;
+    params[milvus::RADIUS] = 0.1f;
+    EXPECT_FALSE(bound.Tighten(topk, params));
+
+    auto empty = milvus::EmptyRangeSearchResult(topk, 3);
+    for (int64_t i = 0; i < 3 * topk; ++i) {
+        EXPECT_EQ(milvus::GetDatasetIDs(empty)[i], -1);
+    }
+}
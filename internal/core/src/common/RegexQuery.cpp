@@ -11,6 +11,8 @@
 
 #include <re2/re2.h>
 
+#include <cstring>
+
 #include "common/RegexQuery.h"
 
 namespace milvus {
@@ -84,4 +86,148 @@ extract_fixed_prefix_from_pattern(const std::string& pattern) {
     return prefix;
 }
 
+std::vector<std::string>
+split_by_wildcard(const std::string& pattern) {
+    std::vector<std::string> result;
+    std::string r;
+    r.reserve(pattern.size());
+    bool escape_mode = false;
+    for (char c : pattern) {
+        if (escape_mode) {
+            r += c;
+            escape_mode = false;
+        } else {
+            if (c == '\\') {
+                // consider case "\\%", we should reserve %
+                escape_mode = true;
+            } else if (c == '%' || c == '_') {
+                if (r.length() > 0) {
+                    result.push_back(r);
+                    r.clear();
+                }
+            } else {
+                r += c;
+            }
+        }
+    }
+    if (r.length() > 0) {
+        result.push_back(r);
+    }
+    return result;
+}
+
+namespace {
+
+// memmem is vectorized by the libc, std::string_view::find compares the
+// candidates of the first byte one by one.
+size_t
+find_literal(std::string_view haystack,
+             size_t pos,
+             const std::string& needle) {
+    auto found = memmem(haystack.data() + pos,
+                        haystack.size() - pos,
+                        needle.data(),
+                        needle.size());
+    if (found == nullptr) {
+        return std::string_view::npos;
+    }
+    return static_cast<const char*>(found) - haystack.data();
+}
+
+}  // namespace
+
+LikePatternMatcher::LikePatternMatcher(const std::string& pattern)
+    : pattern_(pattern) {
+    std::string segment;
+    bool escape_mode = false;
+    for (char c : pattern) {
+        if (escape_mode) {
+            segment += c;
+            min_length_++;
+            escape_mode = false;
+        } else if (c == '\\') {
+            escape_mode = true;
+        } else if (c == '%') {
+            segments_.push_back(std::move(segment));
+            segment.clear();
+        } else if (c == '_') {
+            has_single_wildcard_ = true;
+            min_length_++;
+        } else {
+            segment += c;
+            min_length_++;
+        }
+    }
+    // a trailing escape is dropped, as translate_pattern_match_to_regex does
+    segments_.push_back(std::move(segment));
+    if (has_single_wildcard_) {
+        segments_.clear();
+        literals_ = split_by_wildcard(pattern);
+    }
+}
+
+bool
+LikePatternMatcher::Match(std::string_view operand) {
+    if (!has_single_wildcard_) {
+        return MatchSegments(operand);
+    }
+    if (operand.size() < min_length_ || !ContainsLiterals(operand)) {
+        return false;
+    }
+    if (!regex_.has_value()) {
+        regex_.emplace(translate_pattern_match_to_regex(pattern_));
+    }
+    return (*regex_)(operand);
+}
+
+bool
+LikePatternMatcher::MatchSegments(std::string_view operand) const {
+    if (segments_.size() == 1) {
+        return operand == segments_.front();
+    }
+    const auto& front = segments_.front();
+    const auto& back = segments_.back();
+    if (operand.size() < front.size() + back.size() ||
+        operand.compare(0, front.size(), front) != 0 ||
+        operand.compare(operand.size() - back.size(), back.size(), back) !=
+            0) {
+        return false;
+    }
+    // taking the leftmost occurrence of each middle literal never loses a
+    // match, as % accepts whatever lies between them
+    auto middle = operand.substr(0, operand.size() - back.size());
+    size_t pos = front.size();
+    for (size_t i = 1; i + 1 < segments_.size(); ++i) {
+        const auto& segment = segments_[i];
+        if (segment.empty()) {
+            continue;
+        }
+        if (middle.size() - pos < segment.size()) {
+            return false;
+        }
+        auto found = find_literal(middle, pos, segment);
+        if (found == std::string_view::npos) {
+            return false;
+        }
+        pos = found + segment.size();
+    }
+    return true;
+}
+
+bool
+LikePatternMatcher::ContainsLiterals(std::string_view operand) const {
+    size_t pos = 0;
+    for (const auto& literal : literals_) {
+        if (operand.size() - pos < literal.size()) {
+            return false;
+        }
+        auto found = find_literal(operand, pos, literal);
+        if (found == std::string_view::npos) {
+            return false;
+        }
+        pos = found + literal.size();
+    }
+    return true;
+}
+
 }  // namespace milvus
@@ -11,10 +11,13 @@
 
 #pragma once
 
+#include <optional>
 #include <string>
+#include <string_view>
 #include <regex>
 #include <boost/regex.hpp>
 #include <utility>
+#include <vector>
 
 #include "common/EasyAssert.h"
 
@@ -79,4 +82,63 @@ RegexMatcher::operator()(const std::string_view& operand) {
 std::string
 extract_fixed_prefix_from_pattern(const std::string& pattern);
 
+// Split LIKE pattern into the literals between wildcards, in pattern order.
+// Every match contains them in this order without overlap.
+// Examples: "%foo%bar_" -> {"foo", "bar"}, "a\%b" -> {"a%b"}, "%" -> {}
+std::vector<std::string>
+split_by_wildcard(const std::string& pattern);
+
+// Evaluates a LIKE pattern without running a regex where possible.
+// Patterns made only of literals and % are decided by anchored compares and
+// in-order substring search. Patterns with _ first require their literals in
+// order and the minimum length, the regex only runs on those candidates and
+// is compiled on the first one.
+struct LikePatternMatcher {
+    template <typename T>
+    explicit LikePatternMatcher(const T& pattern) {
+        ThrowInfo(OpTypeInvalid,
+                  "pattern matching is only supported on string type");
+    }
+
+    explicit LikePatternMatcher(const std::string& pattern);
+
+    template <typename T>
+    inline bool
+    operator()(const T& operand) {
+        return false;
+    }
+
+ private:
+    bool
+    Match(std::string_view operand);
+
+    bool
+    MatchSegments(std::string_view operand) const;
+
+    bool
+    ContainsLiterals(std::string_view operand) const;
+
+ private:
+    std::string pattern_;
+    // literals separated by %, only used when the pattern has no _
+    std::vector<std::string> segments_;
+    // literals separated by % or _, the prefilter of patterns with _
+    std::vector<std::string> literals_;
+    bool has_single_wildcard_ = false;
+    size_t min_length_ = 0;
+    std::optional<RegexMatcher> regex_;
+};
+
+template <>
+inline bool
+LikePatternMatcher::operator()(const std::string& operand) {
+    return Match(operand);
+}
+
+template <>
+inline bool
+LikePatternMatcher::operator()(const std::string_view& operand) {
+    return Match(operand);
+}
+
 }  // namespace milvus
@@ -227,3 +227,66 @@ TEST(ExtractFixedPrefixTest, EmptyPattern) {
     // Empty pattern -> empty prefix
     EXPECT_EQ(extract_fixed_prefix_from_pattern(""), "");
 }
+
+TEST(SplitByWildcardTest, Literals) {
+    using namespace milvus;
+    EXPECT_EQ(split_by_wildcard("%foo%bar_"),
+              std::vector<std::string>({"foo", "bar"}));
+    EXPECT_EQ(split_by_wildcard("a\\%b_\\_c"),
+              std::vector<std::string>({"a%b", "_c"}));
+    EXPECT_TRUE(split_by_wildcard("%_%").empty());
+}
+
+TEST(LikePatternMatcherTest, PercentOnly) {
+    using namespace milvus;
+    LikePatternMatcher matcher(std::string("%foo%bar%"));
+    EXPECT_TRUE(matcher(std::string("foobar")));
+    EXPECT_TRUE(matcher(std::string_view("xxfooyybarzz")));
+    EXPECT_FALSE(matcher(std::string("barfoo")));
+    EXPECT_FALSE(matcher(std::string("fobar")));
+
+    LikePatternMatcher anchored(std::string("ab%ba"));
+    EXPECT_TRUE(anchored(std::string("abba")));
+    EXPECT_TRUE(anchored(std::string("ab\nba")));
+    // the prefix and the suffix can not share bytes
+    EXPECT_FALSE(anchored(std::string("aba")));
+    EXPECT_FALSE(anchored(std::string("abbax")));
+
+    LikePatternMatcher exact(std::string("a\\%b"));
+    EXPECT_TRUE(exact(std::string("a%b")));
+    EXPECT_FALSE(exact(std::string("axb")));
+
+    LikePatternMatcher any(std::string("%"));
+    EXPECT_TRUE(any(std::string("")));
+    EXPECT_TRUE(any(std::string("abc")));
+}
+
+TEST(LikePatternMatcherTest, SingleWildcard) {
+    using namespace milvus;
+    LikePatternMatcher matcher(std::string("%a_c%"));
+    EXPECT_TRUE(matcher(std::string("xabcx")));
+    EXPECT_TRUE(matcher(std::string_view("a\nc")));
+    EXPECT_FALSE(matcher(std::string("ac")));
+    EXPECT_FALSE(matcher(std::string("abbc")));
+
+    LikePatternMatcher length(std::string("___"));
+    EXPECT_TRUE(length(std::string("abc")));
+    EXPECT_FALSE(length(std::string("ab")));
+    EXPECT_FALSE(length(std::string("abcd")));
+}
+
+TEST(LikePatternMatcherTest, SameAsRegex) {
+    using namespace milvus;
+    std::vector<std::string> patterns = {
+        "", "%", "a%", "%a", "%a%", "a_%b", "_%_", "%ab%ba%", "a\\_%", "ab\\"};
+    std::vector<std::string> operands = {
+        "", "a", "b", "ab", "ba", "aab", "a_b", "abba", "abab", "a\\", "ab"};
+    for (const auto& pattern : patterns) {
+        LikePatternMatcher matcher(pattern);
+        RegexMatcher regex(translate_pattern_match_to_regex(pattern));
+        for (const auto& operand : operands) {
+            EXPECT_EQ(matcher(operand), regex(operand))
+                << pattern << " " << operand;
+        }
+    }
+}
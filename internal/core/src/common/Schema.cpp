@@ -63,6 +63,9 @@ Schema::ParseFrom(const milvus::proto::schema::CollectionSchema& schema_proto) {
         if (child.name() == namespace_field_name) {
             schema->set_namespace_field_id(field_id);
         }
+        if (child.is_partition_key()) {
+            schema->set_partition_key_field_id(field_id);
+        }
 
         auto [has_setting, enabled] =
             GetBoolFromRepeatedKVs(child.type_params(), MMAP_ENABLED_KEY);
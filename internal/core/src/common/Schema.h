@@ -285,6 +285,16 @@ class Schema {
         return this->namespace_field_id_opt_;
     }
 
+    void
+    set_partition_key_field_id(FieldId field_id) {
+        this->partition_key_field_id_opt_ = field_id;
+    }
+
+    std::optional<FieldId>
+    get_partition_key_field_id() const {
+        return this->partition_key_field_id_opt_;
+    }
+
     uint64_t
     get_schema_version() const {
         return this->schema_version_;
@@ -505,6 +515,7 @@ class Schema {
     std::optional<FieldId> primary_field_id_opt_;
     std::optional<FieldId> dynamic_field_id_opt_;
     std::optional<FieldId> namespace_field_id_opt_;
+    std::optional<FieldId> partition_key_field_id_opt_;
     std::optional<FieldId> ttl_field_id_opt_;
 
     // field partial load list
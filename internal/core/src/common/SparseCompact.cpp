@@ -0,0 +1,341 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/SparseCompact.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "common/EasyAssert.h"
+#include "common/HalfFloat.h"
+
+namespace milvus {
+
+namespace {
+
+constexpr uint32_t kCompactMagic = 0x31435053;  // "SPC1"
+// the width byte of a row packing its indices instead of their deltas
+constexpr uint8_t kAbsoluteIndices = 0x80;
+// an element of a row, the uint32 index then the float value
+constexpr size_t kElementSize = sizeof(uint32_t) + sizeof(float);
+
+struct CompactHeader {
+    uint32_t magic;
+    uint8_t codec;
+    uint8_t nullable;
+    uint16_t reserved;
+    int64_t row_nums;
+    uint64_t size;
+};
+
+void
+PutVarint(std::vector<char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+template <typename T>
+void
+PutRaw(std::vector<char>& out, const T* values, size_t n) {
+    auto bytes = reinterpret_cast<const char*>(values);
+    out.insert(out.end(), bytes, bytes + n * sizeof(T));
+}
+
+class Reader {
+ public:
+    Reader(const char* data, size_t size) : pos_(data), end_(data + size) {
+    }
+
+    uint64_t
+    Varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            auto byte = static_cast<uint8_t>(*Take(1));
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ThrowInfo(ErrorCode::UnexpectedError, "malformed compact sparse chunk");
+    }
+
+    const char*
+    Take(size_t n) {
+        AssertInfo(static_cast<size_t>(end_ - pos_) >= n,
+                   "truncated compact sparse chunk");
+        auto data = pos_;
+        pos_ += n;
+        return data;
+    }
+
+    template <typename T>
+    void
+    Raw(T* values, size_t n) {
+        std::memcpy(values, Take(n * sizeof(T)), n * sizeof(T));
+    }
+
+ private:
+    const char* pos_;
+    const char* end_;
+};
+
+int
+BitWidth(uint32_t value) {
+    return value == 0 ? 0 : 32 - __builtin_clz(value);
+}
+
+void
+PackBits(std::vector<char>& out, const uint32_t* values, size_t n, int width) {
+    uint64_t bits = 0;
+    int pending = 0;
+    for (size_t i = 0; i < n; ++i) {
+        bits |= static_cast<uint64_t>(values[i]) << pending;
+        pending += width;
+        while (pending >= 8) {
+            out.push_back(static_cast<char>(bits & 0xff));
+            bits >>= 8;
+            pending -= 8;
+        }
+    }
+    if (pending > 0) {
+        out.push_back(static_cast<char>(bits & 0xff));
+    }
+}
+
+void
+UnpackBits(Reader& reader, uint32_t* values, size_t n, int width) {
+    auto bytes = reinterpret_cast<const uint8_t*>(
+        reader.Take((n * width + 7) / 8));
+    uint64_t bits = 0;
+    int pending = 0;
+    const uint64_t mask = (uint64_t(1) << width) - 1;
+    for (size_t i = 0; i < n; ++i) {
+        while (pending < width) {
+            bits |= static_cast<uint64_t>(*bytes++) << pending;
+            pending += 8;
+        }
+        values[i] = static_cast<uint32_t>(bits & mask);
+        bits >>= width;
+        pending -= width;
+    }
+}
+
+}  // namespace
+
+std::vector<char>
+EncodeSparseChunk(const char* data,
+                  size_t size,
+                  int64_t row_nums,
+                  bool nullable,
+                  SparseValueCodec codec) {
+    auto null_bitmap_bytes = nullable ? (row_nums + 7) / 8 : 0;
+    auto offsets_ptr = data + null_bitmap_bytes;
+    AssertInfo(null_bitmap_bytes + sizeof(uint64_t) * (row_nums + 1) <= size,
+               "sparse chunk of {} rows is only {} bytes",
+               row_nums,
+               size);
+    std::vector<uint64_t> offsets(row_nums + 1);
+    std::memcpy(offsets.data(), offsets_ptr, offsets.size() * sizeof(uint64_t));
+    AssertInfo(offsets.back() <= size,
+               "sparse chunk rows end at {} past its size {}",
+               offsets.back(),
+               size);
+
+    std::vector<char> out;
+    out.reserve(size / 2);
+    CompactHeader header{kCompactMagic,
+                         static_cast<uint8_t>(codec),
+                         static_cast<uint8_t>(nullable),
+                         0,
+                         row_nums,
+                         size};
+    PutRaw(out, &header, 1);
+    out.insert(out.end(), data, data + null_bitmap_bytes);
+
+    std::vector<uint32_t> indices;
+    std::vector<float> values;
+    std::vector<float16> halves;
+    std::vector<uint8_t> quantized;
+    for (int64_t i = 0; i < row_nums; ++i) {
+        auto nnz = (offsets[i + 1] - offsets[i]) / kElementSize;
+        PutVarint(out, nnz);
+        if (nnz == 0) {
+            continue;
+        }
+        indices.resize(nnz);
+        values.resize(nnz);
+        auto row = data + offsets[i];
+        for (size_t j = 0; j < nnz; ++j) {
+            std::memcpy(&indices[j], row + j * kElementSize, sizeof(uint32_t));
+            std::memcpy(&values[j],
+                        row + j * kElementSize + sizeof(uint32_t),
+                        sizeof(float));
+        }
+
+        bool sorted = std::is_sorted(indices.begin(), indices.end());
+        if (sorted) {
+            for (size_t j = nnz - 1; j > 0; --j) {
+                indices[j] -= indices[j - 1];
+            }
+        }
+        auto packed = sorted ? indices.data() + 1 : indices.data();
+        auto packed_num = sorted ? nnz - 1 : nnz;
+        auto width =
+            packed_num == 0
+                ? 0
+                : BitWidth(*std::max_element(packed, packed + packed_num));
+        out.push_back(
+            static_cast<char>(sorted ? width : width | kAbsoluteIndices));
+        if (sorted) {
+            PutVarint(out, indices[0]);
+        }
+        PackBits(out, packed, packed_num, width);
+
+        switch (codec) {
+            case SparseValueCodec::FP32:
+                PutRaw(out, values.data(), nnz);
+                break;
+            case SparseValueCodec::FP16:
+                halves.resize(nnz);
+                FloatToHalf(values.data(), halves.data(), nnz);
+                PutRaw(out, halves.data(), nnz);
+                break;
+            case SparseValueCodec::UINT8: {
+                auto [min, max] =
+                    std::minmax_element(values.begin(), values.end());
+                float base = *min;
+                float scale = (*max - *min) / 255.0f;
+                quantized.resize(nnz);
+                for (size_t j = 0; j < nnz; ++j) {
+                    quantized[j] = scale > 0
+                                       ? static_cast<uint8_t>(std::lround(
+                                             (values[j] - base) / scale))
+                                       : 0;
+                }
+                PutRaw(out, &base, 1);
+                PutRaw(out, &scale, 1);
+                PutRaw(out, quantized.data(), nnz);
+                break;
+            }
+            default:
+                ThrowInfo(ErrorCode::UnexpectedError,
+                          "unknown sparse value codec {}",
+                          static_cast<int>(codec));
+        }
+    }
+    out.shrink_to_fit();
+    return out;
+}
+
+size_t
+SparseChunkDecodedSize(const char* compact, size_t compact_size) {
+    CompactHeader header;
+    Reader(compact, compact_size).Raw(&header, 1);
+    AssertInfo(header.magic == kCompactMagic, "not a compact sparse chunk");
+    return header.size;
+}
+
+void
+DecodeSparseChunk(const char* compact, size_t compact_size, char* data) {
+    Reader reader(compact, compact_size);
+    CompactHeader header;
+    reader.Raw(&header, 1);
+    AssertInfo(header.magic == kCompactMagic, "not a compact sparse chunk");
+    auto row_nums = header.row_nums;
+    auto codec = static_cast<SparseValueCodec>(header.codec);
+    auto null_bitmap_bytes = header.nullable ? (row_nums + 7) / 8 : 0;
+    reader.Raw(data, null_bitmap_bytes);
+
+    std::vector<uint64_t> offsets(row_nums + 1);
+    uint64_t offset = null_bitmap_bytes + sizeof(uint64_t) * (row_nums + 1);
+    std::vector<uint32_t> indices;
+    std::vector<float> values;
+    std::vector<float16> halves;
+    std::vector<uint8_t> quantized;
+    for (int64_t i = 0; i < row_nums; ++i) {
+        offsets[i] = offset;
+        auto nnz = reader.Varint();
+        if (nnz == 0) {
+            continue;
+        }
+        AssertInfo(offset + nnz * kElementSize <= header.size,
+                   "compact sparse chunk rows overflow its size {}",
+                   header.size);
+        indices.resize(nnz);
+        values.resize(nnz);
+
+        auto width_byte = static_cast<uint8_t>(*reader.Take(1));
+        bool sorted = (width_byte & kAbsoluteIndices) == 0;
+        int width = width_byte & ~kAbsoluteIndices;
+        AssertInfo(width <= 32, "malformed compact sparse chunk");
+        if (sorted) {
+            indices[0] = static_cast<uint32_t>(reader.Varint());
+            UnpackBits(reader, indices.data() + 1, nnz - 1, width);
+            for (size_t j = 1; j < nnz; ++j) {
+                indices[j] += indices[j - 1];
+            }
+        } else {
+            UnpackBits(reader, indices.data(), nnz, width);
+        }
+
+        switch (codec) {
+            case SparseValueCodec::FP32:
+                reader.Raw(values.data(), nnz);
+                break;
+            case SparseValueCodec::FP16:
+                halves.resize(nnz);
+                reader.Raw(halves.data(), nnz);
+                HalfToFloat(halves.data(), values.data(), nnz);
+                break;
+            case SparseValueCodec::UINT8: {
+                float base, scale;
+                reader.Raw(&base, 1);
+                reader.Raw(&scale, 1);
+                quantized.resize(nnz);
+                reader.Raw(quantized.data(), nnz);
+                for (size_t j = 0; j < nnz; ++j) {
+                    values[j] = base + quantized[j] * scale;
+                }
+                break;
+            }
+            default:
+                ThrowInfo(ErrorCode::UnexpectedError,
+                          "unknown sparse value codec {}",
+                          static_cast<int>(codec));
+        }
+
+        auto row = data + offset;
+        for (size_t j = 0; j < nnz; ++j) {
+            std::memcpy(row + j * kElementSize, &indices[j], sizeof(uint32_t));
+            std::memcpy(row + j * kElementSize + sizeof(uint32_t),
+                        &values[j],
+                        sizeof(float));
+        }
+        offset += nnz * kElementSize;
+    }
+    offsets[row_nums] = offset;
+    std::memcpy(data + null_bitmap_bytes,
+                offsets.data(),
+                offsets.size() * sizeof(uint64_t));
+    // the padding past the rows, if the writer left any
+    std::memset(data + offset, 0, header.size - offset);
+}
+
+}  // namespace milvus
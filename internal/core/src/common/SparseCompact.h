@@ -0,0 +1,61 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace milvus {
+
+// How the values of a compact sparse chunk are kept. FP32 is lossless,
+// FP16 rounds to half precision and UINT8 quantizes the values of a row
+// linearly between its min and max.
+enum class SparseValueCodec : uint8_t {
+    FP32 = 0,
+    FP16 = 1,
+    UINT8 = 2,
+};
+
+// The compact layout of a sparse float vector chunk, as written by
+// SparseFloatVectorChunkWriter: the null bitmap, the row offsets and the
+// (uint32 index, float value) elements of the rows.
+//
+// The compact chunk keeps the null bitmap and, per row, the element count,
+// the first index and the deltas of the next ones bit-packed at the width
+// of the largest delta, then the values by codec. A row of unsorted
+// indices packs the indices themselves. The offsets are not kept, they
+// follow from the element counts.
+//
+// The knowhere kernels read the rows in place, so a chunk is decoded back
+// as a whole before it is read.
+std::vector<char>
+EncodeSparseChunk(const char* data,
+                  size_t size,
+                  int64_t row_nums,
+                  bool nullable,
+                  SparseValueCodec codec);
+
+// the size of the chunk a compact chunk decodes to
+size_t
+SparseChunkDecodedSize(const char* compact, size_t compact_size);
+
+// Decodes a compact chunk into the SparseChunkDecodedSize bytes at data.
+void
+DecodeSparseChunk(const char* compact, size_t compact_size, char* data);
+
+}  // namespace milvus
@@ -0,0 +1,168 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "common/SparseCompact.h"
+
+using milvus::SparseValueCodec;
+
+namespace {
+
+using Row = std::vector<std::pair<uint32_t, float>>;
+
+// the layout of SparseFloatVectorChunkWriter, a null row has no elements
+std::vector<char>
+MakeChunk(const std::vector<Row>& rows,
+          const std::vector<bool>& valid,
+          size_t padding = 0) {
+    auto row_nums = rows.size();
+    auto bitmap_bytes = valid.empty() ? 0 : (row_nums + 7) / 8;
+    std::vector<uint64_t> offsets;
+    uint64_t offset = bitmap_bytes + sizeof(uint64_t) * (row_nums + 1);
+    for (auto& row : rows) {
+        offsets.push_back(offset);
+        offset += row.size() * 8;
+    }
+    offsets.push_back(offset);
+
+    std::vector<char> chunk(offset + padding, 0);
+    for (size_t i = 0; i < valid.size(); ++i) {
+        if (valid[i]) {
+            chunk[i / 8] |= static_cast<char>(1 << (i % 8));
+        }
+    }
+    std::memcpy(chunk.data() + bitmap_bytes,
+                offsets.data(),
+                offsets.size() * sizeof(uint64_t));
+    for (size_t i = 0; i < rows.size(); ++i) {
+        for (size_t j = 0; j < rows[i].size(); ++j) {
+            auto element = chunk.data() + offsets[i] + j * 8;
+            std::memcpy(element, &rows[i][j].first, sizeof(uint32_t));
+            std::memcpy(element + 4, &rows[i][j].second, sizeof(float));
+        }
+    }
+    return chunk;
+}
+
+std::vector<Row>
+MakeRows(size_t row_nums) {
+    std::mt19937 random(42);
+    std::vector<Row> rows(row_nums);
+    for (auto& row : rows) {
+        uint32_t index = random() % 64;
+        auto nnz = random() % 200;
+        for (size_t j = 0; j < nnz; ++j) {
+            index += 1 + random() % 300;
+            row.emplace_back(index, (random() % 10000) / 1000.0f);
+        }
+    }
+    return rows;
+}
+
+std::vector<char>
+RoundTrip(const std::vector<char>& chunk,
+          int64_t row_nums,
+          bool nullable,
+          SparseValueCodec codec,
+          size_t* compact_size = nullptr) {
+    auto compact = milvus::EncodeSparseChunk(
+        chunk.data(), chunk.size(), row_nums, nullable, codec);
+    if (compact_size != nullptr) {
+        *compact_size = compact.size();
+    }
+    EXPECT_EQ(milvus::SparseChunkDecodedSize(compact.data(), compact.size()),
+              chunk.size());
+    std::vector<char> decoded(chunk.size(), 1);
+    milvus::DecodeSparseChunk(compact.data(), compact.size(), decoded.data());
+    return decoded;
+}
+
+// the values of a chunk of rows, in row order
+std::vector<float>
+Values(const std::vector<char>& chunk, const std::vector<Row>& rows) {
+    std::vector<float> values;
+    uint64_t offset = sizeof(uint64_t) * (rows.size() + 1);
+    for (auto& row : rows) {
+        for (size_t j = 0; j < row.size(); ++j, offset += 8) {
+            float value;
+            std::memcpy(&value, chunk.data() + offset + 4, sizeof(float));
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(SparseCompactTest, Lossless) {
+    auto rows = MakeRows(500);
+    auto chunk = MakeChunk(rows, {});
+    size_t compact_size;
+    auto decoded = RoundTrip(
+        chunk, rows.size(), false, SparseValueCodec::FP32, &compact_size);
+    EXPECT_EQ(decoded, chunk);
+    EXPECT_LT(compact_size * 1.3, chunk.size());
+}
+
+TEST(SparseCompactTest, NullableAndPadded) {
+    std::vector<Row> rows{{{3, 1.0f}, {5, 2.0f}}, {}, {{0, 0.5f}}, {}};
+    std::vector<bool> valid{true, false, true, true};
+    auto chunk = MakeChunk(rows, valid, 64);
+    auto decoded = RoundTrip(chunk, rows.size(), true, SparseValueCodec::FP32);
+    EXPECT_EQ(decoded, chunk);
+}
+
+TEST(SparseCompactTest, UnsortedIndices) {
+    std::vector<Row> rows{{{900000, 1.0f}, {7, 2.0f}, {4000000000u, 3.0f}},
+                          {{1, 1.0f}, {1, 2.0f}},
+                          {{4000000000u, 1.0f}}};
+    auto chunk = MakeChunk(rows, {});
+    auto decoded = RoundTrip(chunk, rows.size(), false, SparseValueCodec::FP32);
+    EXPECT_EQ(decoded, chunk);
+}
+
+TEST(SparseCompactTest, QuantizedValues) {
+    auto rows = MakeRows(200);
+    auto chunk = MakeChunk(rows, {});
+    auto expected = Values(chunk, rows);
+    size_t fp16_size, uint8_size;
+
+    auto decoded = RoundTrip(
+        chunk, rows.size(), false, SparseValueCodec::FP16, &fp16_size);
+    // the indices and the layout are exact
+    auto index_bytes = sizeof(uint64_t) * (rows.size() + 1);
+    EXPECT_EQ(std::memcmp(decoded.data(), chunk.data(), index_bytes), 0);
+    auto values = Values(decoded, rows);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_NEAR(values[i], expected[i], std::abs(expected[i]) / 1024);
+    }
+
+    decoded = RoundTrip(
+        chunk, rows.size(), false, SparseValueCodec::UINT8, &uint8_size);
+    values = Values(decoded, rows);
+    for (size_t i = 0; i < values.size(); ++i) {
+        // a row spans [0, 10), a step of 10 / 255
+        EXPECT_NEAR(values[i], expected[i], 0.02f);
+    }
+    EXPECT_LT(uint8_size, fp16_size);
+    EXPECT_LT(fp16_size * 2, chunk.size());
+}
@@ -490,6 +490,8 @@ inline const char* const KMin = "min";
 inline const char* const KMax = "max";
 inline const char* const KCount = "count";
 inline const char* const KAvg = "avg";
+inline const char* const KApproxCountDistinct = "approx_count_distinct";
+inline const char* const KApproxPercentile = "approx_percentile";
 
 inline DataType
 GetAggResultType(std::string func_name, DataType input_type) {
@@ -517,7 +519,7 @@ GetAggResultType(std::string func_name, DataType input_type) {
             }
         }
     }
-    if (func_name == KAvg) {
+    if (func_name == KAvg || func_name == KApproxPercentile) {
         switch (input_type) {
             case DataType::INT8:
             case DataType::INT16:
@@ -561,6 +563,29 @@ GetAggResultType(std::string func_name, DataType input_type) {
     if (func_name == KCount) {
         return DataType::INT64;
     }
+    if (func_name == KApproxCountDistinct) {
+        switch (input_type) {
+            case DataType::BOOL:
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+            case DataType::INT64:
+            case DataType::FLOAT:
+            case DataType::DOUBLE:
+            case DataType::VARCHAR:
+            case DataType::STRING:
+            case DataType::TEXT:
+            case DataType::TIMESTAMPTZ: {
+                return DataType::INT64;
+            }
+            default: {
+                ThrowInfo(DataTypeInvalid,
+                          "Unsupported data type for {} aggregation: {}",
+                          func_name,
+                          input_type);
+            }
+        }
+    }
     ThrowInfo(OpTypeInvalid, "Unsupported func type:{}", func_name);
 }
 
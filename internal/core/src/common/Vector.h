@@ -230,6 +230,16 @@ class ColumnVector final : public SimpleVector {
         return is_bitmap_;
     }
 
+    // refills every bit of a bitmap column, so it can hold another batch
+    void
+    ResetBitmap(bool value, bool valid) {
+        AssertInfo(is_bitmap_, "Cannot reset non-bitmap column vector");
+        TargetBitmapView bitmap(GetRawData(), length_);
+        value ? bitmap.set() : bitmap.reset();
+        valid ? valid_values_.set() : valid_values_.reset();
+        null_count_ = std::nullopt;
+    }
+
     void
     resize(vector_size_t new_size, bool setNotNull = true) override {
         AssertInfo(!is_bitmap_, "Cannot resize bitmap column vector");
@@ -20,7 +20,15 @@
 #include "common/Tracer.h"
 #include "storage/ThreadPool.h"
 #include "log/Log.h"
+#include "exec/SharedFilterResults.h"
 #include "exec/expression/ExprCache.h"
+#include "futures/Executor.h"
+#include "monitor/PerfCounters.h"
+#include "segcore/CompressedCellTier.h"
+#include "segcore/HotCells.h"
+#include "segcore/ParquetMetaCache.h"
+#include "segcore/SearchCoalescer.h"
+#include "segcore/SearchResultCache.h"
 
 std::once_flag traceFlag;
 std::once_flag cpuNumFlag;
@@ -50,6 +58,16 @@ SetLowPriorityThreadCoreCoefficient(const float value) {
     milvus::SetLowPriorityThreadCoreCoefficient(value);
 }
 
+void
+SetThreadPoolWorkStealingEnable(bool val) {
+    milvus::SetThreadPoolWorkStealingEnable(val);
+}
+
+void
+SetSegmentAffinityEnable(bool val) {
+    milvus::futures::setSegmentAffinityEnabled(val);
+}
+
 void
 SetDefaultExprEvalBatchSize(int64_t val) {
     milvus::SetDefaultExecEvalExprBatchSize(val);
@@ -60,6 +78,21 @@ SetDefaultDeleteDumpBatchSize(int64_t val) {
     milvus::SetDefaultDeleteDumpBatchSize(val);
 }
 
+void
+SetDefaultAggSpillMemoryLimit(int64_t bytes) {
+    milvus::SetDefaultAggSpillMemoryLimit(bytes);
+}
+
+void
+SetDefaultExprEvalParallelDegree(int64_t val) {
+    milvus::SetDefaultExprEvalParallelDegree(val);
+}
+
+void
+SetDefaultExprEvalAdaptiveBatchSize(bool val) {
+    milvus::SetDefaultExprEvalAdaptiveBatchSize(val);
+}
+
 void
 SetDefaultOptimizeExprEnable(bool val) {
     milvus::SetDefaultOptimizeExprEnable(val);
@@ -80,6 +113,136 @@ SetDefaultEnableParquetStatsSkipIndex(bool val) {
     milvus::SetDefaultEnableParquetStatsSkipIndex(val);
 }
 
+void
+SetDefaultSkipIndexPageRows(int64_t val) {
+    milvus::SetDefaultSkipIndexPageRows(val);
+}
+
+void
+SetDefaultRemoteReadRangeSize(int64_t bytes) {
+    milvus::SetDefaultRemoteReadRangeSize(bytes);
+}
+
+void
+SetDefaultRemoteReadAheadRanges(int64_t val) {
+    milvus::SetDefaultRemoteReadAheadRanges(val);
+}
+
+void
+SetDefaultSegmentLoadMaxTasks(int64_t val) {
+    milvus::SetDefaultSegmentLoadMaxTasks(val);
+}
+
+void
+SetDefaultSegmentLoadMemoryBudget(int64_t bytes) {
+    milvus::SetDefaultSegmentLoadMemoryBudget(bytes);
+}
+
+void
+SetDefaultQueryMemoryBudget(int64_t bytes) {
+    milvus::SetDefaultQueryMemoryBudget(bytes);
+}
+
+void
+SetDefaultExecProfileSampleInterval(int64_t val) {
+    milvus::SetDefaultExecProfileSampleInterval(val);
+}
+
+void
+SetDefaultDictStringChunkMinRowsPerValue(int64_t val) {
+    milvus::SetDefaultDictStringChunkMinRowsPerValue(val);
+}
+
+void
+SetDefaultChunkHugePageEnabled(bool val) {
+    milvus::SetDefaultChunkHugePageEnabled(val);
+}
+
+void
+SetDefaultChunkNumaInterleaveEnabled(bool val) {
+    milvus::SetDefaultChunkNumaInterleaveEnabled(val);
+}
+
+void
+SetDefaultSearchPlanCacheCapacity(int64_t val) {
+    milvus::SetDefaultSearchPlanCacheCapacity(val);
+}
+
+void
+SetDefaultStreamedVectorIndexTrainRows(int64_t val) {
+    milvus::SetDefaultStreamedVectorIndexTrainRows(val);
+}
+
+void
+SetDefaultGeometryCacheDecodedCapacity(int64_t val) {
+    milvus::SetDefaultGeometryCacheDecodedCapacity(val);
+}
+
+void
+SetDefaultRescoreMaxTopkFactor(int64_t val) {
+    milvus::SetDefaultRescoreMaxTopkFactor(val);
+}
+
+void
+SetDefaultKmeansMiniBatchSize(int64_t val) {
+    milvus::SetDefaultKmeansMiniBatchSize(val);
+}
+
+void
+SetDefaultKmeansAssignParallelism(int64_t val) {
+    milvus::SetDefaultKmeansAssignParallelism(val);
+}
+
+void
+SetDefaultFilterSelectivitySampleRows(int64_t val) {
+    milvus::SetDefaultFilterSelectivitySampleRows(val);
+}
+
+void
+SetDefaultIterativeFilterMinPassRate(double val) {
+    milvus::SetDefaultIterativeFilterMinPassRate(val);
+}
+
+void
+SetDefaultIterativeFilterAutoPassRate(double val) {
+    milvus::SetDefaultIterativeFilterAutoPassRate(val);
+}
+
+void
+SetDefaultRandomSampleFilterFirstMaxFactor(double val) {
+    milvus::SetDefaultRandomSampleFilterFirstMaxFactor(val);
+}
+
+void
+SetDefaultNgramIndexBuildThreads(int64_t val) {
+    milvus::SetDefaultNgramIndexBuildThreads(val);
+}
+
+void
+SetDefaultQueryAsyncPreloadEnabled(bool val) {
+    milvus::SetDefaultQueryAsyncPreloadEnabled(val);
+}
+
+void
+SetDefaultJemallocArenaPartitionEnabled(bool val) {
+    milvus::SetDefaultJemallocArenaPartitionEnabled(val);
+}
+
+void
+SetDefaultJemallocTransientArenaDecayMs(int64_t val) {
+    milvus::SetDefaultJemallocTransientArenaDecayMs(val);
+}
+
+void
+SetDefaultPackedWriterAsyncMemoryLimit(int64_t val) {
+    milvus::SetDefaultPackedWriterAsyncMemoryLimit(val);
+}
+
+void
+SetDefaultInterimIndexDiskCacheEnabled(bool val) {
+    milvus::SetDefaultInterimIndexDiskCacheEnabled(val);
+}
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val) {
     milvus::SetEnableLatestDeleteSnapshotOptimization(val);
@@ -101,6 +264,63 @@ SetExprResCacheCapacityBytes(int64_t bytes) {
         static_cast<size_t>(bytes));
 }
 
+void
+SetSearchResCacheEnable(bool val) {
+    milvus::segcore::SearchResCacheManager::SetEnabled(val);
+}
+
+void
+SetSearchResCacheCapacityBytes(int64_t bytes) {
+    milvus::segcore::SearchResCacheManager::Instance().SetCapacityBytes(
+        static_cast<size_t>(bytes));
+}
+
+void
+SetSharedFilterResultEnable(bool val) {
+    milvus::exec::SharedFilterResults::SetEnabled(val);
+}
+
+void
+SetHardwareCounterSampleRatio(double ratio) {
+    milvus::monitor::PerfCounters::SetSampleRatio(ratio);
+}
+
+void
+SetHotCellSnapshot(const char* path, int64_t interval_seconds) {
+    milvus::segcore::HotCells::Instance().Start(
+        path, std::chrono::seconds(interval_seconds));
+}
+
+void
+SetCompressedCellTierCapacityBytes(int64_t bytes) {
+    milvus::segcore::CompressedCellTier::Instance().SetCapacityBytes(
+        static_cast<size_t>(bytes));
+}
+
+void
+SetCompressedCellTierSparseValueCodec(int32_t codec) {
+    auto& tier = milvus::segcore::CompressedCellTier::Instance();
+    if (codec < 0 ||
+        codec > static_cast<int32_t>(milvus::SparseValueCodec::UINT8)) {
+        LOG_WARN("unknown sparse value codec {}, kept {}",
+                 codec,
+                 static_cast<int>(tier.GetSparseValueCodec()));
+        return;
+    }
+    tier.SetSparseValueCodec(static_cast<milvus::SparseValueCodec>(codec));
+}
+
+void
+SetParquetMetaCacheCapacityBytes(int64_t bytes) {
+    milvus::segcore::ParquetMetaCache::Instance().SetCapacityBytes(
+        static_cast<size_t>(bytes));
+}
+
+void
+SetSearchCoalesceWindowMicros(int64_t window_us) {
+    milvus::segcore::SearchCoalescer::Instance().SetWindowMicros(window_us);
+}
+
 void
 InitTrace(CTraceConfig* config) {
     auto traceConfig = milvus::tracer::TraceConfig{config->exporter,
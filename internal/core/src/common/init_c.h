@@ -39,12 +39,28 @@ SetMiddlePriorityThreadCoreCoefficient(const float);
 void
 SetLowPriorityThreadCoreCoefficient(const float);
 
+void
+SetThreadPoolWorkStealingEnable(bool val);
+
+// Routes the work of a segment to the cores of one L3 cache
+void
+SetSegmentAffinityEnable(bool val);
+
 void
 SetDefaultExprEvalBatchSize(int64_t val);
 
 void
 SetDefaultDeleteDumpBatchSize(int64_t val);
 
+void
+SetDefaultAggSpillMemoryLimit(int64_t bytes);
+
+void
+SetDefaultExprEvalParallelDegree(int64_t val);
+
+void
+SetDefaultExprEvalAdaptiveBatchSize(bool val);
+
 void
 SetDefaultOptimizeExprEnable(bool val);
 
@@ -57,6 +73,84 @@ SetDefaultConfigParamTypeCheck(bool val);
 void
 SetDefaultEnableParquetStatsSkipIndex(bool val);
 
+void
+SetDefaultSkipIndexPageRows(int64_t val);
+
+void
+SetDefaultRemoteReadRangeSize(int64_t bytes);
+
+void
+SetDefaultRemoteReadAheadRanges(int64_t val);
+
+void
+SetDefaultSegmentLoadMaxTasks(int64_t val);
+
+void
+SetDefaultSegmentLoadMemoryBudget(int64_t bytes);
+
+void
+SetDefaultQueryMemoryBudget(int64_t bytes);
+
+void
+SetDefaultExecProfileSampleInterval(int64_t val);
+
+void
+SetDefaultDictStringChunkMinRowsPerValue(int64_t val);
+
+void
+SetDefaultChunkHugePageEnabled(bool val);
+
+void
+SetDefaultChunkNumaInterleaveEnabled(bool val);
+
+void
+SetDefaultSearchPlanCacheCapacity(int64_t val);
+
+void
+SetDefaultStreamedVectorIndexTrainRows(int64_t val);
+
+void
+SetDefaultGeometryCacheDecodedCapacity(int64_t val);
+
+void
+SetDefaultRescoreMaxTopkFactor(int64_t val);
+
+void
+SetDefaultKmeansMiniBatchSize(int64_t val);
+
+void
+SetDefaultKmeansAssignParallelism(int64_t val);
+
+void
+SetDefaultFilterSelectivitySampleRows(int64_t val);
+
+void
+SetDefaultIterativeFilterMinPassRate(double val);
+
+void
+SetDefaultIterativeFilterAutoPassRate(double val);
+
+void
+SetDefaultRandomSampleFilterFirstMaxFactor(double val);
+
+void
+SetDefaultNgramIndexBuildThreads(int64_t val);
+
+void
+SetDefaultQueryAsyncPreloadEnabled(bool val);
+
+void
+SetDefaultJemallocArenaPartitionEnabled(bool val);
+
+void
+SetDefaultJemallocTransientArenaDecayMs(int64_t val);
+
+void
+SetDefaultPackedWriterAsyncMemoryLimit(int64_t val);
+
+void
+SetDefaultInterimIndexDiskCacheEnabled(bool val);
+
 void
 SetEnableLatestDeleteSnapshotOptimization(bool val);
 
@@ -77,6 +171,43 @@ SetExprResCacheEnable(bool val);
 void
 SetExprResCacheCapacityBytes(int64_t bytes);
 
+// Search result cache
+void
+SetSearchResCacheEnable(bool val);
+
+void
+SetSearchResCacheCapacityBytes(int64_t bytes);
+
+// Filter results shared by the sub-requests of hybrid searches
+void
+SetSharedFilterResultEnable(bool val);
+
+// Share of the async cgo tasks whose hardware events are counted
+void
+SetHardwareCounterSampleRatio(double ratio);
+
+// Snapshot of the hot cells of the caching layer for warm restarts, an
+// empty path or a non-positive interval turns it off
+void
+SetHotCellSnapshot(const char* path, int64_t interval_seconds);
+
+// Memory budget of the evicted cells kept compressed, 0 turns it off
+void
+SetCompressedCellTierCapacityBytes(int64_t bytes);
+
+// Values of the evicted sparse vector cells: 0 fp32, 1 fp16, 2 uint8
+void
+SetCompressedCellTierSparseValueCodec(int32_t codec);
+
+// Memory budget of the cached parquet footers, 0 turns it off
+void
+SetParquetMetaCacheCapacityBytes(int64_t bytes);
+
+// Window in which the same searches of a segment are searched at once, 0
+// turns it off
+void
+SetSearchCoalesceWindowMicros(int64_t window_us);
+
 #ifdef __cplusplus
 };
 #endif
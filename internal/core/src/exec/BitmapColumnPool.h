@@ -0,0 +1,78 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common/Types.h"
+#include "common/Vector.h"
+
+namespace milvus::exec {
+
+// The bitmap result columns the expressions of a query allocate for every
+// batch. A column is handed out again once nothing but the pool references
+// it, so a query keeps reusing the buffers of its earlier batches instead
+// of allocating two bitmaps per expression per batch. The columns are
+// freed with the pool, when the query context goes away.
+class BitmapColumnPool {
+ public:
+    // covers the live batches of a deep expression tree, evaluated by a
+    // few threads
+    static constexpr size_t kMaxPooledColumns = 64;
+
+    // a bitmap column of size bits set to value, its valid bits set to
+    // valid
+    ColumnVectorPtr
+    Acquire(size_t size, bool value, bool valid) {
+        {
+            std::lock_guard lock(mutex_);
+            for (const auto& column : columns_) {
+                // only the pool hands out references, so a unique column
+                // stays ours once we copy it
+                if (column.use_count() == 1 && column->size() == size) {
+                    // the last holder's writes happen before its release
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    auto reused = column;
+                    reused->ResetBitmap(value, valid);
+                    return reused;
+                }
+            }
+        }
+        auto column = std::make_shared<ColumnVector>(TargetBitmap(size, value),
+                                                     TargetBitmap(size, valid));
+        std::lock_guard lock(mutex_);
+        if (columns_.size() < kMaxPooledColumns) {
+            columns_.push_back(column);
+        }
+        return column;
+    }
+
+    size_t
+    PooledColumns() const {
+        std::lock_guard lock(mutex_);
+        return columns_.size();
+    }
+
+ private:
+    mutable std::mutex mutex_;
+    std::vector<ColumnVectorPtr> columns_;
+};
+
+}  // namespace milvus::exec
@@ -0,0 +1,47 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include "exec/BitmapColumnPool.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+TEST(BitmapColumnPoolTest, ReusesReleasedColumns) {
+    BitmapColumnPool pool;
+    auto first = pool.Acquire(100, false, true);
+    auto raw = first->GetRawData();
+    TargetBitmapView(raw, 100).set(7);
+    first->nullAt(3);
+
+    // still referenced, so the pool allocates another one
+    auto second = pool.Acquire(100, false, true);
+    EXPECT_NE(second->GetRawData(), raw);
+    EXPECT_EQ(pool.PooledColumns(), 2);
+
+    first.reset();
+    auto reused = pool.Acquire(100, true, false);
+    EXPECT_EQ(reused->GetRawData(), raw);
+    EXPECT_EQ(pool.PooledColumns(), 2);
+    TargetBitmapView values(reused->GetRawData(), 100);
+    TargetBitmapView valid(reused->GetValidRawData(), 100);
+    EXPECT_EQ(values.count(), 100);
+    EXPECT_EQ(valid.count(), 0);
+    EXPECT_EQ(reused->nullCount(), 0);
+
+    // a released column of another size is left alone
+    reused.reset();
+    auto other = pool.Acquire(64, false, true);
+    EXPECT_NE(other->GetRawData(), raw);
+    EXPECT_EQ(other->size(), 64);
+    EXPECT_EQ(TargetBitmapView(other->GetRawData(), 64).count(), 0);
+}
@@ -16,6 +16,7 @@
 
 #include "Driver.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 
 #include <cassert>
@@ -28,8 +29,10 @@
 #include "exec/operator/IterativeFilterNode.h"
 #include "exec/operator/MvccNode.h"
 #include "exec/operator/Operator.h"
+#include "exec/operator/OperatorProfile.h"
 #include "exec/operator/RescoresNode.h"
 #include "exec/operator/VectorSearchNode.h"
+#include "exec/operator/OrderByNode.h"
 #include "exec/operator/RandomSampleNode.h"
 #include "exec/operator/ElementFilterNode.h"
 #include "exec/operator/ElementFilterBitsNode.h"
@@ -63,66 +66,72 @@ DriverFactory::CreateDriver(std::unique_ptr<DriverContext> ctx,
         if (auto filterbitsnode =
                 std::dynamic_pointer_cast<const plan::FilterBitsNode>(
                     plannode)) {
-            tracer::AddEvent("create_operator: FilterBitsNode");
+            tracer::AddEventFmt("create_operator: FilterBitsNode");
             operators.push_back(std::make_unique<PhyFilterBitsNode>(
                 id, ctx.get(), filterbitsnode));
         } else if (auto filternode =
                        std::dynamic_pointer_cast<const plan::FilterNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: FilterNode");
+            tracer::AddEventFmt("create_operator: FilterNode");
             operators.push_back(std::make_unique<PhyIterativeFilterNode>(
                 id, ctx.get(), filternode));
         } else if (auto mvccnode =
                        std::dynamic_pointer_cast<const plan::MvccNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: MvccNode");
+            tracer::AddEventFmt("create_operator: MvccNode");
             operators.push_back(
                 std::make_unique<PhyMvccNode>(id, ctx.get(), mvccnode));
         } else if (auto vectorsearchnode =
                        std::dynamic_pointer_cast<const plan::VectorSearchNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: VectorSearchNode");
+            tracer::AddEventFmt("create_operator: VectorSearchNode");
             operators.push_back(std::make_unique<PhyVectorSearchNode>(
                 id, ctx.get(), vectorsearchnode));
         } else if (auto searchGroupByNode =
                        std::dynamic_pointer_cast<const plan::SearchGroupByNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: SearchGroupByNode");
+            tracer::AddEventFmt("create_operator: SearchGroupByNode");
             operators.push_back(std::make_unique<PhySearchGroupByNode>(
                 id, ctx.get(), searchGroupByNode));
         } else if (auto queryGroupByNode =
                        std::dynamic_pointer_cast<const plan::AggregationNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: AggregationNode");
+            tracer::AddEventFmt("create_operator: AggregationNode");
             operators.push_back(std::make_unique<PhyAggregationNode>(
                 id, ctx.get(), queryGroupByNode));
         } else if (auto projectNode =
                        std::dynamic_pointer_cast<const plan::ProjectNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: ProjectNode");
+            tracer::AddEventFmt("create_operator: ProjectNode");
             operators.push_back(
                 std::make_unique<PhyProjectNode>(id, ctx.get(), projectNode));
         } else if (auto samplenode =
                        std::dynamic_pointer_cast<const plan::RandomSampleNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: RandomSampleNode");
+            tracer::AddEventFmt("create_operator: RandomSampleNode");
             operators.push_back(std::make_unique<PhyRandomSampleNode>(
                 id, ctx.get(), samplenode));
+        } else if (auto orderbynode =
+                       std::dynamic_pointer_cast<const plan::OrderByNode>(
+                           plannode)) {
+            tracer::AddEventFmt("create_operator: OrderByNode");
+            operators.push_back(std::make_unique<PhyOrderByNode>(
+                id, ctx.get(), orderbynode));
         } else if (auto rescoresnode =
                        std::dynamic_pointer_cast<const plan::RescoresNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: RescoresNode");
+            tracer::AddEventFmt("create_operator: RescoresNode");
             operators.push_back(
                 std::make_unique<PhyRescoresNode>(id, ctx.get(), rescoresnode));
         } else if (auto node =
                        std::dynamic_pointer_cast<const plan::ElementFilterNode>(
                            plannode)) {
-            tracer::AddEvent("create_operator: ElementFilterNode");
+            tracer::AddEventFmt("create_operator: ElementFilterNode");
             operators.push_back(
                 std::make_unique<PhyElementFilterNode>(id, ctx.get(), node));
         } else if (auto node = std::dynamic_pointer_cast<
                        const plan::ElementFilterBitsNode>(plannode)) {
-            tracer::AddEvent("create_operator: ElementFilterBitsNode");
+            tracer::AddEventFmt("create_operator: ElementFilterBitsNode");
             operators.push_back(std::make_unique<PhyElementFilterBitsNode>(
                 id, ctx.get(), node));
         } else {
@@ -222,6 +231,8 @@ Driver::Close() {
 
     for (auto& op : operators_) {
         op->Close();
+        op->stats().peak_memory_bytes = op->memory_tracker()->peak();
+        ctx_->task_->AddOperatorStats(op->stats());
     }
 
     closed_ = true;
@@ -266,6 +277,7 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
         initializeOperators();
         int num_operators = operators_.size();
         ContinueFuture future;
+        auto op_ctx = get_task()->query_context()->get_op_context();
 
         for (;;) {
             for (int32_t i = num_operators - 1; i >= 0; --i) {
@@ -299,8 +311,10 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                     if (needs_input) {
                         RowVectorPtr result;
                         {
+                            OperatorProfileScope profile(op->stats(), op_ctx);
                             CALL_OPERATOR(
                                 result = op->GetOutput(), op, "GetOutput");
+                            profile.RecordOutput(result);
                             if (result) {
                                 AssertInfo(
                                     result->size() > 0,
@@ -311,6 +325,9 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                             }
                         }
                         if (result) {
+                            OperatorProfileScope profile(next_op->stats(),
+                                                         op_ctx);
+                            profile.RecordInput(result);
                             CALL_OPERATOR(
                                 next_op->AddInput(result), next_op, "AddInput");
                             i += 2;
@@ -340,8 +357,10 @@ Driver::RunInternal(std::shared_ptr<Driver>& self,
                     }
                 } else {
                     {
+                        OperatorProfileScope profile(op->stats(), op_ctx);
                         CALL_OPERATOR(
                             result = op->GetOutput(), op, "GetOutput");
+                        profile.RecordOutput(result);
                         if (result) {
                             AssertInfo(
                                 result->size() > 0,
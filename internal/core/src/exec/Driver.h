@@ -68,6 +68,11 @@ enum class BlockingReason {
     /// Build operator is blocked waiting for all its peers to stop to run group
     /// spill on all of them.
     kWaitForSpill,
+    /// Blocked waiting for the caching layer to load the cells it reads.
+    kWaitForCache,
+    /// Blocked waiting for another search evaluating the same filter on the
+    /// segment, see SharedFilterResults.
+    kWaitForSharedFilter,
 };
 
 class Driver;
@@ -0,0 +1,86 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/FilterSelectivity.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+#include "exec/expression/EvalCtx.h"
+#include "exec/expression/Expr.h"
+
+namespace milvus::exec {
+
+std::optional<double>
+SampleFilterPassRate(const expr::TypedExprPtr& filter,
+                     QueryContext* query_context,
+                     int64_t num_samples) {
+    auto active_count = query_context->get_active_count();
+    if (num_samples <= 0 || active_count <= num_samples) {
+        return std::nullopt;
+    }
+
+    ExecContext exec_context(query_context);
+    ExprSet exprs(std::vector<expr::TypedExprPtr>{filter}, &exec_context);
+    for (const auto& expr : exprs.exprs()) {
+        if (!expr->SupportOffsetInput()) {
+            return std::nullopt;
+        }
+    }
+
+    // the same rows for every search on the segment, in row order so that
+    // the chunks are read front to back
+    std::mt19937_64 rng(query_context->get_segment()->get_segment_id());
+    std::uniform_int_distribution<int64_t> row(0, active_count - 1);
+    FixedVector<int32_t> offsets(num_samples);
+    for (auto& offset : offsets) {
+        offset = static_cast<int32_t>(row(rng));
+    }
+    std::sort(offsets.begin(), offsets.end());
+
+    EvalCtx eval_ctx(&exec_context, &offsets);
+    std::vector<VectorPtr> results;
+    exprs.Eval(0, 1, true, eval_ctx, results);
+    AssertInfo(results.size() == 1 && results[0] != nullptr,
+               "sampled filter result size should be one and not be nullptr");
+    auto col_vec = std::dynamic_pointer_cast<ColumnVector>(results[0]);
+    AssertInfo(col_vec != nullptr && col_vec->IsBitmap() &&
+                   col_vec->size() == num_samples,
+               "sampled filter result should be a bitmap of the samples");
+    TargetBitmapView passed(col_vec->GetRawData(), col_vec->size());
+    return static_cast<double>(passed.count()) / num_samples;
+}
+
+bool
+PreferIterativeFilter(bool iterative,
+                      double pass_rate,
+                      int64_t topk,
+                      int64_t active_count) {
+    // the iterators would be drained without filling the topk
+    if (pass_rate * active_count < topk) {
+        return false;
+    }
+    if (iterative) {
+        return pass_rate >= ITERATIVE_FILTER_MIN_PASS_RATE.load();
+    }
+    auto auto_pass_rate = ITERATIVE_FILTER_AUTO_PASS_RATE.load();
+    return auto_pass_rate > 0 && pass_rate >= auto_pass_rate;
+}
+
+}  // namespace milvus::exec
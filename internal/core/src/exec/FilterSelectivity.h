@@ -0,0 +1,45 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "exec/QueryContext.h"
+#include "expr/ITypeExpr.h"
+
+namespace milvus::exec {
+
+// The fraction of num_samples random active rows of the segment of
+// query_context that pass filter, the filter runs on their offsets only.
+// nullopt when num_samples covers the segment, whose bitset then costs about
+// as much, or when the filter can't take offsets.
+std::optional<double>
+SampleFilterPassRate(const expr::TypedExprPtr& filter,
+                     QueryContext* query_context,
+                     int64_t num_samples);
+
+// Whether a search for topk of active_count rows passing the filter at
+// pass_rate runs the iterative filter rather than searching on the bitset of
+// the filter, iterative the strategy of its plan.
+bool
+PreferIterativeFilter(bool iterative,
+                      double pass_rate,
+                      int64_t topk,
+                      int64_t active_count);
+
+}  // namespace milvus::exec
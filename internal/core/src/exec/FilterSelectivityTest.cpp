@@ -0,0 +1,83 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/Common.h"
+#include "exec/FilterSelectivity.h"
+#include "expr/ITypeExpr.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/storage_test_utils.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+TEST(FilterSelectivityTest, SampledPassRate) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+
+    const int64_t N = 20'000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    exec::QueryContext query_context(DEAFULT_QUERY_ID,
+                                     segment.get(),
+                                     N,
+                                     MAX_TIMESTAMP,
+                                     0,
+                                     0,
+                                     query::PlanOptions());
+
+    // i64 holds the row offsets, a tenth of the rows are below N / 10
+    proto::plan::GenericValue bound;
+    bound.set_int64_val(N / 10);
+    auto tenth = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64),
+        proto::plan::OpType::LessThan,
+        bound,
+        std::vector<proto::plan::GenericValue>{});
+    auto pass_rate = exec::SampleFilterPassRate(tenth, &query_context, 1024);
+    ASSERT_TRUE(pass_rate.has_value());
+    EXPECT_NEAR(pass_rate.value(), 0.1, 0.04);
+    // the same samples every time
+    EXPECT_EQ(exec::SampleFilterPassRate(tenth, &query_context, 1024),
+              pass_rate);
+
+    // samples covering the segment leave the bitset to the plan
+    EXPECT_FALSE(
+        exec::SampleFilterPassRate(tenth, &query_context, N).has_value());
+    EXPECT_FALSE(
+        exec::SampleFilterPassRate(tenth, &query_context, 0).has_value());
+}
+
+TEST(FilterSelectivityTest, PreferIterativeFilter) {
+    auto min_pass_rate = ITERATIVE_FILTER_MIN_PASS_RATE.load();
+    auto auto_pass_rate = ITERATIVE_FILTER_AUTO_PASS_RATE.load();
+
+    SetDefaultIterativeFilterMinPassRate(0.01);
+    SetDefaultIterativeFilterAutoPassRate(0);
+    EXPECT_TRUE(exec::PreferIterativeFilter(true, 0.5, 10, 100'000));
+    EXPECT_FALSE(exec::PreferIterativeFilter(true, 0.001, 10, 100'000));
+    // too few rows pass to fill the topk
+    EXPECT_FALSE(exec::PreferIterativeFilter(true, 0.5, 100, 150));
+    // without a hint only the auto pass rate turns the iterative filter on
+    EXPECT_FALSE(exec::PreferIterativeFilter(false, 0.95, 10, 100'000));
+    SetDefaultIterativeFilterAutoPassRate(0.9);
+    EXPECT_TRUE(exec::PreferIterativeFilter(false, 0.95, 10, 100'000));
+    EXPECT_FALSE(exec::PreferIterativeFilter(false, 0.5, 10, 100'000));
+
+    SetDefaultIterativeFilterMinPassRate(min_pass_rate);
+    SetDefaultIterativeFilterAutoPassRate(auto_pass_rate);
+}
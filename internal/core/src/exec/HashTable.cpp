@@ -23,8 +23,7 @@
 namespace milvus {
 namespace exec {
 void
-BaseHashTable::prepareForGroupProbe(HashLookup& lookup,
-                                    const RowVectorPtr& input) {
+BaseHashTable::setKeyColumns(HashLookup& lookup, const RowVectorPtr& input) {
     auto& hashers = lookup.hashers_;
     int numKeys = hashers.size();
     // set up column vector to each column
@@ -38,19 +37,90 @@ BaseHashTable::prepareForGroupProbe(HashLookup& lookup,
         hashers[i]->setColumnData(column_ptr);
     }
     lookup.reset(input->size());
+}
 
-    const auto mode = hashMode();
+void
+BaseHashTable::prepareForGroupProbe(HashLookup& lookup,
+                                    const RowVectorPtr& input) {
+    setKeyColumns(lookup, input);
+    auto& hashers = lookup.hashers_;
     for (auto i = 0; i < hashers.size(); i++) {
-        if (mode == BaseHashTable::HashMode::kHash) {
+        hashers[i]->hash(i > 0, lookup.hashes_);
+    }
+}
+
+void
+HashTable::prepareForGroupProbe(HashLookup& lookup,
+                                const RowVectorPtr& input) {
+    setKeyColumns(lookup, input);
+    auto& hashers = lookup.hashers_;
+    if (hashModeDecided_ && hashMode_ == HashMode::kHash) {
+        for (auto i = 0; i < hashers.size(); i++) {
             hashers[i]->hash(i > 0, lookup.hashes_);
-        } else {
-            ThrowInfo(
-                milvus::OpTypeInvalid,
-                "Not support target hashMode, only support kHash for now");
         }
+        return;
+    }
+    // the first batch picks the mode, later batches with keys outside the
+    // value id ranges widen the ranges and may change the mode
+    if (!hashModeDecided_ || !computeValueIds(lookup)) {
+        decideHashMode(lookup);
+        if (hashMode_ == HashMode::kHash) {
+            for (auto i = 0; i < hashers.size(); i++) {
+                hashers[i]->hash(i > 0, lookup.hashes_);
+            }
+            return;
+        }
+        const bool inRange = computeValueIds(lookup);
+        AssertInfo(inRange,
+                   "keys must be within the value id ranges after analyzing "
+                   "them");
     }
 }
 
+bool
+HashTable::computeValueIds(HashLookup& lookup) {
+    auto& hashers = lookup.hashers_;
+    for (auto i = 0; i < hashers.size(); i++) {
+        if (!hashers[i]->computeValueIds(
+                hashers[i]->columnData(), i > 0, lookup.hashes_)) {
+            return false;
+        }
+    }
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        lookup.normalizedKeys_.assign(lookup.hashes_.begin(),
+                                      lookup.hashes_.end());
+        for (auto& hash : lookup.hashes_) {
+            hash = mixNormalizedKey(hash);
+        }
+    }
+    return true;
+}
+
+void
+HashTable::decideHashMode(HashLookup& lookup) {
+    uint64_t rangeProduct = 1;
+    bool useValueIds = true;
+    for (auto& hasher : lookup.hashers_) {
+        hasher->analyze();
+        if (!hasher->mayUseValueIds()) {
+            useValueIds = false;
+            break;
+        }
+        const auto rangeSize = hasher->valueIdRangeSize(kValueRangeReservePct);
+        if (rangeProduct > kMaxNormalizedKeyRange / rangeSize) {
+            useValueIds = false;
+            break;
+        }
+        rangeProduct *= rangeSize;
+    }
+    auto mode = HashMode::kHash;
+    if (useValueIds) {
+        mode = rangeProduct <= kArrayHashMaxSize ? HashMode::kArray
+                                                 : HashMode::kNormalizedKey;
+    }
+    setHashMode(mode, lookup.hashes_.size());
+}
+
 class ProbeState {
  public:
     enum class Operation { kProbe, kInsert, kErase };
@@ -170,6 +240,27 @@ HashTable::allocateTables(uint64_t size) {
     std::memset(table_, 0, byteSize);
 }
 
+void
+HashTable::allocateArrayTable(uint64_t size) {
+    AssertInfo(size > 0 && size <= kArrayHashMaxSize,
+               "Size:{} for allocating array table must be in (0, {}]",
+               size,
+               kArrayHashMaxSize);
+    if (table_ != nullptr) {
+        ::operator delete(table_, std::align_val_t(64));
+        table_ = nullptr;
+    }
+    capacity_ = size;
+    const uint64_t byteSize = capacity_ * tableSlotSize();
+    // the array is indexed by value id, there are no buckets or tags
+    numBuckets_ = 0;
+    sizeMask_ = 0;
+    sizeBits_ = 0;
+    bucketOffsetMask_ = 0;
+    table_ = static_cast<char*>(::operator new(byteSize, std::align_val_t(64)));
+    std::memset(table_, 0, byteSize);
+}
+
 void
 HashTable::checkSizeAndAllocateTable(int32_t numNew) {
     AssertInfo(capacity_ == 0 || capacity_ > numDistinct_,
@@ -179,6 +270,78 @@ HashTable::checkSizeAndAllocateTable(int32_t numNew) {
     if (table_ == nullptr || capacity_ == 0) {
         const auto newSize = newHashTableEntriesNumber(numDistinct_, numNew);
         allocateTables(newSize);
+    } else if (numDistinct_ + numNew > rehashSize()) {
+        rehash(newHashTableEntriesNumber(numDistinct_, numNew));
+    }
+}
+
+int64_t
+HashTable::estimateGrowthBytes(int32_t numNew) const {
+    int64_t bytes = static_cast<int64_t>(numNew) * rows_->fixedRowSize();
+    if (hashMode_ == HashMode::kArray) {
+        // the array already has a slot for every possible key
+        return bytes;
+    }
+    if (table_ == nullptr || capacity_ == 0 ||
+        numDistinct_ + numNew > rehashSize()) {
+        // the old table is only freed after all groups are moved over
+        bytes += newHashTableEntriesNumber(numDistinct_, numNew) *
+                 tableSlotSize();
+    }
+    return bytes;
+}
+
+void
+HashTable::computeRowHashes(std::vector<uint64_t>& hashes) {
+    const auto& groups = rows_->allRows();
+    const auto numGroups = groups.size();
+    if (numGroups == 0) {
+        return;
+    }
+    // rows do not keep their hashes, recompute them from the stored keys
+    // so that the column data set up on hashers_ for the current input is
+    // left untouched
+    for (auto i = 0; i < hashers_.size(); i++) {
+        const auto type = hashers_[i]->ChannelDataType();
+        auto keys = std::make_shared<ColumnVector>(type, numGroups);
+        rows_->extractColumn(groups.data(), numGroups, i, keys);
+        if (hashMode_ == HashMode::kHash) {
+            hashers_[i]->hash(keys, i > 0, hashes);
+        } else {
+            const bool inRange =
+                hashers_[i]->computeValueIds(keys, i > 0, hashes);
+            AssertInfo(inRange,
+                       "stored keys of column {} must be within the value "
+                       "id range",
+                       i);
+        }
+    }
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        for (auto i = 0; i < numGroups; i++) {
+            RowContainer::normalizedKey(groups[i]) = hashes[i];
+            hashes[i] = mixNormalizedKey(hashes[i]);
+        }
+    }
+}
+
+void
+HashTable::rehash(uint64_t size) {
+    const auto& groups = rows_->allRows();
+    const auto numGroups = groups.size();
+    std::vector<uint64_t> hashes(numGroups);
+    computeRowHashes(hashes);
+    ++numRehashes_;
+    if (hashMode_ == HashMode::kArray) {
+        allocateArrayTable(size);
+        auto* table = reinterpret_cast<char**>(table_);
+        for (auto i = 0; i < numGroups; i++) {
+            table[hashes[i]] = groups[i];
+        }
+        return;
+    }
+    allocateTables(size);
+    for (auto i = 0; i < numGroups; i++) {
+        insertForRehash(hashes[i], groups[i]);
     }
 }
 
@@ -222,40 +385,133 @@ HashTable::insertEntry(milvus::exec::HashLookup& lookup,
     char* group = rows_->newRow();
     lookup.hits_[row] = group;
     storeKeys(lookup, row);
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        RowContainer::normalizedKey(group) = lookup.normalizedKeys_[row];
+    }
     storeRowPointer(index, lookup.hashes_[row], group);
     numDistinct_++;
     lookup.newGroups_.push_back(row);
     return group;
 }
 
+void
+HashTable::insertForRehash(uint64_t hash, char* group) {
+    auto bktOffset = bucketOffset(hash);
+    const auto kEmptyGroup = TagVector::broadcast(0);
+    for (int64_t numProbedBuckets = 0; numProbedBuckets < numBuckets_;
+         ++numProbedBuckets) {
+        uint16_t empty = milvus::toBitMask(loadTags(bktOffset) == kEmptyGroup) &
+                         ProbeState::kFullMask;
+        if (empty > 0) {
+            auto pos = milvus::bits::getAndClearLastSetBit(empty);
+            storeRowPointer(bktOffset + pos, hash, group);
+            return;
+        }
+        bktOffset = nextBucketOffset(bktOffset);
+    }
+    ThrowInfo(UnexpectedError,
+              "Slots in hash table is not enough for rehash, fail the request");
+}
+
+template <bool normalizedKeys>
 FOLLY_ALWAYS_INLINE void
-HashTable::fullProbe(HashLookup& lookup, ProbeState& state) {
+HashTable::fullProbe(HashLookup& lookup,
+                     ProbeState& state,
+                     bool insertNewGroups) {
     constexpr ProbeState::Operation op = ProbeState::Operation::kInsert;
     lookup.hits_[state.row()] = state.fullProbe<op>(
         *this,
         [&](char* group, int32_t row) {
-            return compareKeys(group, lookup, row);
+            if constexpr (normalizedKeys) {
+                // equal normalized keys mean equal keys
+                return RowContainer::normalizedKey(group) ==
+                       lookup.normalizedKeys_[row];
+            } else {
+                return compareKeys(group, lookup, row);
+            }
         },
-        [&](int32_t row, uint64_t index) {
+        [&](int32_t row, uint64_t index) -> char* {
+            if (!insertNewGroups) {
+                return nullptr;
+            }
             return insertEntry(lookup, index, row);
         });
 }
 
 void
-HashTable::groupProbe(milvus::exec::HashLookup& lookup) {
-    AssertInfo(hashMode_ == HashMode::kHash, "Only support kHash mode for now");
-    checkSizeAndAllocateTable(0);
+HashTable::arrayGroupProbe(HashLookup& lookup, bool insertNewGroups) {
+    AssertInfo(table_ != nullptr, "array table must be allocated");
+    auto* table = reinterpret_cast<char**>(table_);
+    for (int32_t row = 0; row < lookup.hashes_.size(); row++) {
+        const auto index = lookup.hashes_[row];
+        char* group = table[index];
+        lookup.hits_[row] = group;
+        if (group == nullptr && insertNewGroups) {
+            group = rows_->newRow();
+            lookup.hits_[row] = group;
+            storeKeys(lookup, row);
+            table[index] = group;
+            numDistinct_++;
+            lookup.newGroups_.push_back(row);
+        }
+    }
+}
+
+void
+HashTable::groupProbe(milvus::exec::HashLookup& lookup, bool insertNewGroups) {
+    if (hashMode_ == HashMode::kArray) {
+        arrayGroupProbe(lookup, insertNewGroups);
+        return;
+    }
+    checkSizeAndAllocateTable(insertNewGroups ? lookup.hashes_.size() : 0);
     ProbeState state;
+    if (hashMode_ == HashMode::kNormalizedKey) {
+        for (int32_t idx = 0; idx < lookup.hashes_.size(); idx++) {
+            state.preProbe(*this, lookup.hashes_[idx], idx);
+            state.firstProbe<ProbeState::Operation::kInsert>(*this);
+            fullProbe<true>(lookup, state, insertNewGroups);
+        }
+        return;
+    }
     for (int32_t idx = 0; idx < lookup.hashes_.size(); idx++) {
         state.preProbe(*this, lookup.hashes_[idx], idx);
         state.firstProbe<ProbeState::Operation::kInsert>(*this);
-        fullProbe(lookup, state);
+        fullProbe<false>(lookup, state, insertNewGroups);
     }
 }
 
 void
 HashTable::setHashMode(HashMode mode, int32_t numNew) {
-    // TODO set hash mode kArray/kHash/kNormalizedKey
+    AssertInfo(mode == HashMode::kHash || rows_->hasNormalizedKeys(),
+               "keys of this table can only be hashed");
+    hashModeDecided_ = true;
+    uint64_t rangeProduct = 1;
+    if (mode == HashMode::kHash) {
+        for (auto& hasher : hashers_) {
+            hasher->disableValueIds();
+        }
+    } else {
+        for (auto& hasher : hashers_) {
+            rangeProduct =
+                hasher->enableValueIds(rangeProduct, kValueRangeReservePct);
+        }
+    }
+    const auto oldMode = hashMode_;
+    hashMode_ = mode;
+    if (mode == HashMode::kArray) {
+        // also allocates the array for an empty table, groupProbe never
+        // resizes it
+        rehash(rangeProduct);
+        return;
+    }
+    if (table_ == nullptr) {
+        // allocated on the first groupProbe
+        return;
+    }
+    if (mode != oldMode || mode == HashMode::kNormalizedKey) {
+        // value ids of existing groups change with the ranges
+        rehash(newHashTableEntriesNumber(numDistinct_, numNew));
+    }
 }
 
 void
@@ -59,6 +59,11 @@ struct HashLookup {
     /// For groupProbe, row numbers for which a new entry was inserted (didn't
     /// exist before the groupProbe). Empty for joinProbe.
     std::vector<vector_size_t> newGroups_;
+
+    /// Normalized keys of the rows in kNormalizedKey mode, in which 'hashes'
+    /// holds the normalized keys mixed into hash numbers. Index is the row
+    /// number.
+    std::vector<uint64_t> normalizedKeys_;
 };
 
 class BaseHashTable {
@@ -142,18 +147,33 @@ class BaseHashTable {
     /// Populates 'hashes' and 'rows' fields in 'lookup' in preparation for
     /// 'groupProbe' call. Rehashes the table if necessary. Uses lookup.hashes to
     /// decode grouping keys from 'input'.
-    void
+    virtual void
     prepareForGroupProbe(HashLookup& lookup, const RowVectorPtr& input);
 
     /// Finds or creates a group for each key in 'lookup'. The keys are
-    /// returned in 'lookup.hits'.
+    /// returned in 'lookup.hits'. If 'insertNewGroups' is false, no group is
+    /// created and the hits of keys not in the table are set to nullptr.
     virtual void
-    groupProbe(HashLookup& lookup) = 0;
+    groupProbe(HashLookup& lookup, bool insertNewGroups = true) = 0;
 
     virtual void
     clear(bool freeTable = false) = 0;
 
+    /// Bytes held by the group rows and the table.
+    virtual int64_t
+    usedBytes() const = 0;
+
+    /// Upper bound of the bytes added by inserting 'numNew' new groups,
+    /// including a rehash if the table would need one.
+    virtual int64_t
+    estimateGrowthBytes(int32_t numNew) const = 0;
+
  protected:
+    /// Sets the key columns of 'input' on the hashers of 'lookup' and sizes
+    /// 'lookup' for 'input'.
+    static void
+    setKeyColumns(HashLookup& lookup, const RowVectorPtr& input);
+
     std::vector<std::unique_ptr<VectorHasher>> hashers_;
     std::unique_ptr<RowContainer> rows_;
 };
@@ -166,22 +186,54 @@ class HashTable : public BaseHashTable {
               const std::vector<Accumulator>& accumulators)
         : BaseHashTable(std::move(hashers)) {
         std::vector<DataType> keyTypes;
+        bool mayUseValueIds = !hashers_.empty();
         for (auto& hasher : hashers_) {
             keyTypes.push_back(hasher->ChannelDataType());
+            mayUseValueIds &=
+                VectorHasher::typeSupportValueIds(hasher->ChannelDataType());
         }
         hashMode_ = HashMode::kHash;
-        rows_ = std::make_unique<RowContainer>(keyTypes, accumulators);
+        // keys of other types can only be hashed, so the mode is decided
+        // right away
+        hashModeDecided_ = !mayUseValueIds;
+        rows_ = std::make_unique<RowContainer>(
+            keyTypes, accumulators, mayUseValueIds);
     };
 
     ~HashTable() override {
         clear();
     }
 
+    // Largest number of entries of a kArray table.
+    static constexpr uint64_t kArrayHashMaxSize = 1UL << 17;
+
+    // Largest product of key value ranges packed into a normalized key.
+    static constexpr uint64_t kMaxNormalizedKeyRange = 1UL << 62;
+
+    // Headroom in percent added to value ranges when picking a hash mode, so
+    // that a few new values do not force a rehash right away.
+    static constexpr int32_t kValueRangeReservePct = 50;
+
+    void
+    prepareForGroupProbe(HashLookup& lookup,
+                         const RowVectorPtr& input) override;
+
+    /// Switches to 'mode' and moves all groups over to the table of the new
+    /// mode. For kArray and kNormalizedKey, value ids are enabled on the
+    /// hashers using the value ranges they have seen so far.
     void
     setHashMode(HashMode mode, int32_t numNew) override;
 
     void
-    groupProbe(HashLookup& lookup) override;
+    groupProbe(HashLookup& lookup, bool insertNewGroups = true) override;
+
+    int64_t
+    usedBytes() const override {
+        return rows_->usedBytes() + capacity_ * tableSlotSize();
+    }
+
+    int64_t
+    estimateGrowthBytes(int32_t numNew) const override;
 
     // The table in non-kArray mode has a power of two number of buckets each with
     // 16 slots. Each slot has a 1 byte tag (a field of hash number) and a 48 bit
@@ -254,6 +306,11 @@ class HashTable : public BaseHashTable {
     bool
     compareKeys(const char* group, HashLookup& lookup, vector_size_t row);
 
+    static uint64_t
+    mixNormalizedKey(uint64_t normalizedKey) {
+        return milvus::bits::hashMix(kNormalizedKeySeed, normalizedKey);
+    }
+
     char*
     row(int64_t bucketOffset, int32_t slotIndex) const {
         return bucketAt(bucketOffset)->pointerAt(slotIndex);
@@ -284,15 +341,52 @@ class HashTable : public BaseHashTable {
     void
     allocateTables(uint64_t size);
 
+    template <bool normalizedKeys>
     void
-    fullProbe(HashLookup& lookup, ProbeState& state);
+    fullProbe(HashLookup& lookup, ProbeState& state, bool insertNewGroups);
+
+    // Finds or creates the groups of 'lookup' in the kArray table, where the
+    // value ids in lookup.hashes are direct indices.
+    void
+    arrayGroupProbe(HashLookup& lookup, bool insertNewGroups);
+
+    // Sets lookup.hashes to the value ids of the keys in kArray mode, or to
+    // the normalized keys in kNormalizedKey mode. Returns false if a key is
+    // outside the current value id ranges.
+    bool
+    computeValueIds(HashLookup& lookup);
+
+    // Looks at the keys in 'lookup' and picks the hash mode that fits the
+    // value ranges seen so far.
+    void
+    decideHashMode(HashLookup& lookup);
+
+    // Recomputes the hashes, value ids or normalized keys of all groups for
+    // the current mode.
+    void
+    computeRowHashes(std::vector<uint64_t>& hashes);
+
+    // Allocates a zeroed kArray table of 'size' group pointers.
+    void
+    allocateArrayTable(uint64_t size);
 
     void
     clear(bool freeTable = false) override;
 
+    // Allocates the table on first use and rehashes it if 'numNew' more
+    // groups would exceed the load factor.
     void
     checkSizeAndAllocateTable(int32_t numNew);
 
+    // Moves all groups into a new table of 'size' entries.
+    void
+    rehash(uint64_t size);
+
+    // Stores 'group' into the first empty slot for 'hash'. Only used for
+    // rehash, where all groups are known to be distinct.
+    void
+    insertForRehash(uint64_t hash, char* group);
+
     // Returns the number of entries after which the table gets rehashed.
     static uint64_t
     rehashSize(int64_t size) {
@@ -318,7 +412,12 @@ class HashTable : public BaseHashTable {
     }
 
  private:
+    static constexpr uint64_t kNormalizedKeySeed = 0x9e3779b97f4a7c15ULL;
+
     HashMode hashMode_ = HashMode::kHash;
+    // Whether the mode is final, either because the keys were analyzed or
+    // because kHash was forced.
+    bool hashModeDecided_ = false;
     int64_t bucketOffsetMask_{0};
     int64_t numBuckets_{0};
     int64_t numDistinct_{0};
@@ -0,0 +1,196 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+#include "exec/HashTable.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+namespace {
+
+using HashMode = BaseHashTable::HashMode;
+
+std::unique_ptr<HashTable>
+MakeTable(const std::vector<DataType>& key_types) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto i = 0; i < key_types.size(); i++) {
+        hashers.emplace_back(VectorHasher::create(key_types[i], i));
+    }
+    return std::make_unique<HashTable>(std::move(hashers),
+                                       std::vector<Accumulator>{});
+}
+
+// int64 keys, -1 stands for null
+ColumnVectorPtr
+MakeInt64Column(const std::vector<int64_t>& values) {
+    auto column =
+        std::make_shared<ColumnVector>(DataType::INT64, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        if (values[i] < 0) {
+            column->nullAt(i);
+        } else {
+            column->SetValueAt<int64_t>(i, values[i]);
+        }
+    }
+    return column;
+}
+
+ColumnVectorPtr
+MakeStringColumn(const std::vector<int64_t>& values) {
+    auto column =
+        std::make_shared<ColumnVector>(DataType::VARCHAR, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        column->SetValueAt<std::string>(i,
+                                        "key_" + std::to_string(values[i]));
+    }
+    return column;
+}
+
+RowVectorPtr
+MakeInput(std::vector<VectorPtr> columns) {
+    return std::make_shared<RowVector>(std::move(columns));
+}
+
+std::vector<int64_t>
+Range(int64_t begin, int64_t end) {
+    std::vector<int64_t> values;
+    for (auto value = begin; value < end; value++) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+std::vector<char*>
+Probe(HashTable& table, HashLookup& lookup, const RowVectorPtr& input) {
+    table.prepareForGroupProbe(lookup, input);
+    table.groupProbe(lookup);
+    return lookup.hits_;
+}
+
+HashMode
+ModeOf(const HashTable& table) {
+    return static_cast<const BaseHashTable&>(table).hashMode();
+}
+
+}  // namespace
+
+TEST(HashTableTest, SmallRangeUsesArray) {
+    auto table = MakeTable({DataType::INT64});
+    HashLookup lookup(table->hashers());
+    auto keys = Range(100, 1100);
+    keys.push_back(-1);
+    auto input = MakeInput({MakeInt64Column(keys)});
+
+    auto hits = Probe(*table, lookup, input);
+    EXPECT_EQ(ModeOf(*table), HashMode::kArray);
+    EXPECT_EQ(lookup.newGroups_.size(), keys.size());
+    EXPECT_EQ(std::set<char*>(hits.begin(), hits.end()).size(), keys.size());
+
+    // the same keys find the same groups, in whatever order they come
+    std::reverse(keys.begin(), keys.end());
+    auto reversed = MakeInput({MakeInt64Column(keys)});
+    auto again = Probe(*table, lookup, reversed);
+    EXPECT_TRUE(lookup.newGroups_.empty());
+    for (size_t i = 0; i < keys.size(); i++) {
+        EXPECT_EQ(again[i], hits[keys.size() - 1 - i]);
+    }
+}
+
+TEST(HashTableTest, MultipleKeysUseNormalizedKey) {
+    auto table = MakeTable({DataType::INT64, DataType::VARCHAR});
+    HashLookup lookup(table->hashers());
+    // 10000 x 15 combinations do not fit an array, but a normalized key
+    std::vector<int64_t> ints;
+    std::vector<int64_t> strs;
+    for (int64_t i = 0; i < 10000; i++) {
+        for (int64_t j = 0; j < 100; j += 7) {
+            ints.push_back(i);
+            strs.push_back(j);
+        }
+    }
+    auto input = MakeInput({MakeInt64Column(ints), MakeStringColumn(strs)});
+
+    auto hits = Probe(*table, lookup, input);
+    EXPECT_EQ(ModeOf(*table), HashMode::kNormalizedKey);
+    EXPECT_EQ(lookup.newGroups_.size(), ints.size());
+    EXPECT_EQ(std::set<char*>(hits.begin(), hits.end()).size(), ints.size());
+
+    auto again = Probe(*table, lookup, input);
+    EXPECT_TRUE(lookup.newGroups_.empty());
+    EXPECT_EQ(again, hits);
+}
+
+TEST(HashTableTest, WideRangeUsesHash) {
+    auto table = MakeTable({DataType::INT64});
+    HashLookup lookup(table->hashers());
+    std::vector<int64_t> keys{1, int64_t{1} << 50, 1, 7, int64_t{1} << 50};
+    auto input = MakeInput({MakeInt64Column(keys)});
+
+    auto hits = Probe(*table, lookup, input);
+    EXPECT_EQ(ModeOf(*table), HashMode::kHash);
+    EXPECT_EQ(lookup.newGroups_.size(), 3);
+    EXPECT_EQ(hits[0], hits[2]);
+    EXPECT_EQ(hits[1], hits[4]);
+    EXPECT_NE(hits[0], hits[3]);
+}
+
+TEST(HashTableTest, OutOfRangeKeysChangeMode) {
+    auto table = MakeTable({DataType::INT64});
+    HashLookup lookup(table->hashers());
+    auto small = MakeInput({MakeInt64Column(Range(0, 100))});
+    auto small_hits = Probe(*table, lookup, small);
+    EXPECT_EQ(ModeOf(*table), HashMode::kArray);
+
+    // the range now spans a million values, which only fits a normalized key
+    auto large = MakeInput({MakeInt64Column(Range(1'000'000, 1'000'100))});
+    Probe(*table, lookup, large);
+    EXPECT_EQ(ModeOf(*table), HashMode::kNormalizedKey);
+    EXPECT_EQ(lookup.newGroups_.size(), 100);
+
+    // groups inserted before the switch are kept
+    auto hits = Probe(*table, lookup, small);
+    EXPECT_TRUE(lookup.newGroups_.empty());
+    EXPECT_EQ(hits, small_hits);
+    EXPECT_EQ(table->rows()->allRows().size(), 200);
+
+    // forcing kHash also keeps the groups
+    table->forceGenericHashMode();
+    EXPECT_EQ(ModeOf(*table), HashMode::kHash);
+    hits = Probe(*table, lookup, small);
+    EXPECT_TRUE(lookup.newGroups_.empty());
+    EXPECT_EQ(hits, small_hits);
+}
+
+TEST(HashTableTest, UnsupportedKeyTypeUsesHash) {
+    auto table = MakeTable({DataType::DOUBLE});
+    HashLookup lookup(table->hashers());
+    auto column = std::make_shared<ColumnVector>(DataType::DOUBLE, 3);
+    column->SetValueAt<double>(0, 1.5);
+    column->SetValueAt<double>(1, 2.5);
+    column->SetValueAt<double>(2, 1.5);
+    auto input = MakeInput({column});
+
+    auto hits = Probe(*table, lookup, input);
+    EXPECT_EQ(ModeOf(*table), HashMode::kHash);
+    EXPECT_EQ(lookup.newGroups_.size(), 2);
+    EXPECT_EQ(hits[0], hits[2]);
+}
@@ -0,0 +1,177 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/MemoryTracker.h"
+
+#include <chrono>
+
+#include <folly/futures/FutureException.h>
+
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+
+namespace milvus::exec {
+
+MemoryTracker::MemoryTracker(std::string name,
+                             std::shared_ptr<MemoryTracker> parent,
+                             int64_t limit)
+    : name_(std::move(name)),
+      parent_(std::move(parent)),
+      own_limit_(limit),
+      limit_(&own_limit_) {
+}
+
+MemoryTracker::MemoryTracker(std::string name,
+                             const std::atomic<int64_t>* limit)
+    : name_(std::move(name)), limit_(limit) {
+}
+
+MemoryTracker::~MemoryTracker() {
+    auto used = used_.load();
+    if (parent_ != nullptr && used != 0) {
+        parent_->Release(used);
+    }
+}
+
+const std::shared_ptr<MemoryTracker>&
+MemoryTracker::Process() {
+    static const std::shared_ptr<MemoryTracker> process(
+        new MemoryTracker("process", &QUERY_MEMORY_BUDGET));
+    return process;
+}
+
+int64_t
+MemoryTracker::Add(int64_t bytes) {
+    return used_.fetch_add(bytes) + bytes;
+}
+
+void
+MemoryTracker::UpdatePeak(int64_t used) {
+    auto peak = peak_.load();
+    while (used > peak && !peak_.compare_exchange_weak(peak, used)) {
+    }
+}
+
+bool
+MemoryTracker::TryReserve(int64_t bytes) {
+    for (auto tracker = this; tracker != nullptr;
+         tracker = tracker->parent_.get()) {
+        auto used = tracker->Add(bytes);
+        auto limit = tracker->limit();
+        if (limit > 0 && used > limit) {
+            // give back what the trackers up to this one took
+            for (auto taken = this; taken != tracker->parent_.get();
+                 taken = taken->parent_.get()) {
+                taken->used_.fetch_sub(bytes);
+            }
+            return false;
+        }
+        tracker->UpdatePeak(used);
+    }
+    return true;
+}
+
+void
+MemoryTracker::Reserve(int64_t bytes) {
+    if (!TryReserve(bytes)) {
+        ThrowInfo(MemAllocateFailed,
+                  "{} can't reserve {} bytes, {} of {} bytes are in use",
+                  name_,
+                  bytes,
+                  used(),
+                  limit());
+    }
+}
+
+void
+MemoryTracker::Track(int64_t bytes) {
+    for (auto tracker = this; tracker != nullptr;
+         tracker = tracker->parent_.get()) {
+        tracker->UpdatePeak(tracker->Add(bytes));
+    }
+}
+
+void
+MemoryTracker::Release(int64_t bytes) {
+    for (auto tracker = this; tracker != nullptr;
+         tracker = tracker->parent_.get()) {
+        tracker->used_.fetch_sub(bytes);
+    }
+}
+
+bool
+MemoryReservation::TryResize(int64_t bytes) {
+    if (tracker_ == nullptr) {
+        bytes_ = bytes;
+        return true;
+    }
+    if (bytes > bytes_ && !tracker_->TryReserve(bytes - bytes_)) {
+        return false;
+    }
+    if (bytes < bytes_) {
+        tracker_->Release(bytes_ - bytes);
+    }
+    bytes_ = bytes;
+    return true;
+}
+
+void
+MemoryReservation::Resize(int64_t bytes) {
+    if (tracker_ != nullptr && bytes != bytes_) {
+        if (bytes > bytes_) {
+            tracker_->Track(bytes - bytes_);
+        } else {
+            tracker_->Release(bytes_ - bytes);
+        }
+    }
+    bytes_ = bytes;
+}
+
+void
+QueryAdmission::Enter(const milvus::OpContext* op_context) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // the memory of the running queries is released without a notify, the
+    // wait polls it
+    while (running_ > 0) {
+        auto budget = QUERY_MEMORY_BUDGET.load();
+        if (budget <= 0 || MemoryTracker::Process()->used() < budget) {
+            break;
+        }
+        if (op_context != nullptr &&
+            op_context->cancellation_token.isCancellationRequested()) {
+            throw folly::FutureCancellation();
+        }
+        cv_.wait_for(lock, std::chrono::milliseconds(10));
+    }
+    running_++;
+}
+
+void
+QueryAdmission::Leave() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_--;
+    }
+    cv_.notify_all();
+}
+
+int64_t
+QueryAdmission::Running() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+}  // namespace milvus::exec
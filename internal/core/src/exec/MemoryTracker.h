@@ -0,0 +1,185 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/OpContext.h"
+
+namespace milvus::exec {
+
+// Counts the bytes held by one scope of the query path: the process, a
+// query, an operator. Bytes taken on a tracker are taken on its parents
+// too. A checked reservation fails if it takes any tracker on the way past
+// its limit, the bytes already allocated are tracked unchecked.
+//
+// A tracker gives what it still holds back to its parents when it goes, so
+// the trackers of a query need no explicit release.
+class MemoryTracker {
+ public:
+    // limit 0 is none
+    MemoryTracker(std::string name,
+                  std::shared_ptr<MemoryTracker> parent,
+                  int64_t limit = 0);
+
+    ~MemoryTracker();
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker&
+    operator=(const MemoryTracker&) = delete;
+
+    // the root of the query trackers, limited by QUERY_MEMORY_BUDGET
+    static const std::shared_ptr<MemoryTracker>&
+    Process();
+
+    bool
+    TryReserve(int64_t bytes);
+
+    // throws MemAllocateFailed if TryReserve fails
+    void
+    Reserve(int64_t bytes);
+
+    void
+    Track(int64_t bytes);
+
+    void
+    Release(int64_t bytes);
+
+    int64_t
+    used() const {
+        return used_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    peak() const {
+        return peak_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    limit() const {
+        return limit_->load(std::memory_order_relaxed);
+    }
+
+    const std::string&
+    name() const {
+        return name_;
+    }
+
+ private:
+    MemoryTracker(std::string name, const std::atomic<int64_t>* limit);
+
+    // the used bytes after adding bytes
+    int64_t
+    Add(int64_t bytes);
+
+    void
+    UpdatePeak(int64_t used);
+
+    const std::string name_;
+    const std::shared_ptr<MemoryTracker> parent_;
+    std::atomic<int64_t> own_limit_{0};
+    const std::atomic<int64_t>* limit_;
+    std::atomic<int64_t> used_{0};
+    std::atomic<int64_t> peak_{0};
+};
+
+// Bytes held on a tracker for as long as the reservation lives, resized as
+// the structure it stands for grows or shrinks.
+class MemoryReservation {
+ public:
+    MemoryReservation() = default;
+
+    explicit MemoryReservation(std::shared_ptr<MemoryTracker> tracker)
+        : tracker_(std::move(tracker)) {
+    }
+
+    ~MemoryReservation() {
+        Resize(0);
+    }
+
+    MemoryReservation(const MemoryReservation&) = delete;
+    MemoryReservation&
+    operator=(const MemoryReservation&) = delete;
+
+    // false, keeping the reservation as is, if the tracker can't take the
+    // growth
+    bool
+    TryResize(int64_t bytes);
+
+    // unchecked, for bytes allocated already
+    void
+    Resize(int64_t bytes);
+
+    int64_t
+    bytes() const {
+        return bytes_;
+    }
+
+ private:
+    std::shared_ptr<MemoryTracker> tracker_;
+    int64_t bytes_{0};
+};
+
+// Holds queries back while the process tracker is at QUERY_MEMORY_BUDGET.
+// A query is always admitted when no other one runs, so none waits forever.
+class QueryAdmission {
+ public:
+    static QueryAdmission&
+    GetInstance() {
+        static QueryAdmission instance;
+        return instance;
+    }
+
+    // Blocks until the query may start, throws folly::FutureCancellation if
+    // op_context is cancelled meanwhile.
+    void
+    Enter(const milvus::OpContext* op_context);
+
+    void
+    Leave();
+
+    int64_t
+    Running() const;
+
+ private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    int64_t running_{0};
+};
+
+// Enter and Leave of a scope.
+class QueryAdmissionGuard {
+ public:
+    explicit QueryAdmissionGuard(const milvus::OpContext* op_context) {
+        QueryAdmission::GetInstance().Enter(op_context);
+    }
+
+    ~QueryAdmissionGuard() {
+        QueryAdmission::GetInstance().Leave();
+    }
+
+    QueryAdmissionGuard(const QueryAdmissionGuard&) = delete;
+    QueryAdmissionGuard&
+    operator=(const QueryAdmissionGuard&) = delete;
+};
+
+}  // namespace milvus::exec
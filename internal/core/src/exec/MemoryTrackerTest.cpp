@@ -0,0 +1,97 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <folly/futures/FutureException.h>
+
+#include "common/Common.h"
+#include "exec/MemoryTracker.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+TEST(MemoryTrackerTest, ChargesParentsAndRollsBack) {
+    auto query = std::make_shared<MemoryTracker>("query", nullptr, 100);
+    auto op = std::make_shared<MemoryTracker>("op", query, 80);
+
+    EXPECT_TRUE(op->TryReserve(60));
+    EXPECT_EQ(query->used(), 60);
+    // over the limit of the operator
+    EXPECT_FALSE(op->TryReserve(30));
+    EXPECT_EQ(op->used(), 60);
+    EXPECT_EQ(query->used(), 60);
+
+    auto other = std::make_shared<MemoryTracker>("other", query);
+    // over the limit of the query, the operator tracker takes nothing
+    EXPECT_FALSE(other->TryReserve(50));
+    EXPECT_EQ(other->used(), 0);
+    EXPECT_ANY_THROW(other->Reserve(50));
+
+    // tracked bytes are allocated already, they pass the limits
+    other->Track(50);
+    EXPECT_EQ(query->used(), 110);
+    EXPECT_EQ(query->peak(), 110);
+
+    other.reset();
+    op->Release(60);
+    EXPECT_EQ(query->used(), 0);
+    EXPECT_EQ(query->peak(), 110);
+    EXPECT_EQ(op->peak(), 60);
+}
+
+TEST(MemoryTrackerTest, ReservationResizes) {
+    auto query = std::make_shared<MemoryTracker>("query", nullptr, 100);
+    {
+        MemoryReservation reservation(query);
+        EXPECT_TRUE(reservation.TryResize(70));
+        EXPECT_FALSE(reservation.TryResize(120));
+        EXPECT_EQ(reservation.bytes(), 70);
+        EXPECT_TRUE(reservation.TryResize(20));
+        EXPECT_EQ(query->used(), 20);
+        reservation.Resize(150);
+        EXPECT_EQ(query->used(), 150);
+    }
+    EXPECT_EQ(query->used(), 0);
+    EXPECT_EQ(query->peak(), 150);
+}
+
+TEST(MemoryTrackerTest, AdmissionWaitsForBudget) {
+    auto budget = QUERY_MEMORY_BUDGET.load();
+    SetDefaultQueryMemoryBudget(100);
+    auto& admission = QueryAdmission::GetInstance();
+    auto query = std::make_shared<MemoryTracker>("query",
+                                                 MemoryTracker::Process());
+    {
+        // a query alone is always admitted
+        QueryAdmissionGuard first(nullptr);
+        query->Track(100);
+
+        folly::CancellationSource source;
+        milvus::OpContext cancelled(source.getToken());
+        source.requestCancellation();
+        EXPECT_THROW(admission.Enter(&cancelled), folly::FutureCancellation);
+
+        std::thread waiting([&] {
+            QueryAdmissionGuard second(nullptr);
+            EXPECT_EQ(admission.Running(), 2);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_EQ(admission.Running(), 1);
+        query->Release(100);
+        waiting.join();
+    }
+    EXPECT_EQ(admission.Running(), 0);
+    SetDefaultQueryMemoryBudget(budget);
+}
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,9 @@
 #include "common/Exception.h"
 #include "common/ArrayOffsets.h"
 #include "common/OpContext.h"
+#include "exec/BitmapColumnPool.h"
+#include "exec/MemoryTracker.h"
+#include "exec/SharedFilterResults.h"
 #include "segcore/SegmentInterface.h"
 
 namespace milvus::exec {
@@ -121,6 +125,23 @@ class QueryConfig : public MemConfig {
     static constexpr const char* kExprEvalBatchSize =
         "expression.eval_batch_size";
 
+    // Most threads a filter over one sealed segment is evaluated with.
+    static constexpr const char* kExprEvalParallelDegree =
+        "expression.eval_parallel_degree";
+
+    // Whether a filter tunes its batch size to the cost of its expressions,
+    // an explicit kExprEvalBatchSize turns it off.
+    static constexpr const char* kExprEvalAdaptiveBatchSize =
+        "expression.eval_adaptive_batch_size";
+
+    // Bytes a group-by aggregation may hold before spilling, 0 disables it.
+    static constexpr const char* kAggSpillMemoryLimit =
+        "aggregation.spill_memory_limit";
+
+    // Percentile in [0, 1] computed by approx_percentile, 0.5 by default.
+    static constexpr const char* kAggApproxPercentile =
+        "aggregation.approx_percentile";
+
     explicit QueryConfig(
         const std::unordered_map<std::string, std::string>& values)
         : MemConfig(values) {
@@ -138,6 +159,31 @@ class QueryConfig : public MemConfig {
         return BaseConfig::Get<int64_t>(kExprEvalBatchSize,
                                         EXEC_EVAL_EXPR_BATCH_SIZE.load());
     }
+
+    int64_t
+    get_expr_parallel_degree() const {
+        return BaseConfig::Get<int64_t>(kExprEvalParallelDegree,
+                                        EXEC_EVAL_EXPR_PARALLEL_DEGREE.load());
+    }
+
+    bool
+    get_expr_adaptive_batch_size() const {
+        return !IsValueExists(kExprEvalBatchSize) &&
+               BaseConfig::Get<bool>(kExprEvalAdaptiveBatchSize,
+                                     EXEC_EVAL_EXPR_ADAPTIVE_BATCH_SIZE.load());
+    }
+
+    int64_t
+    get_agg_spill_memory_limit() const {
+        return BaseConfig::Get<int64_t>(kAggSpillMemoryLimit,
+                                        EXEC_AGG_SPILL_MEMORY_LIMIT.load());
+    }
+
+    double
+    get_agg_approx_percentile() const {
+        return BaseConfig::Get<double>(kAggApproxPercentile,
+                                       DEFAULT_EXEC_AGG_APPROX_PERCENTILE);
+    }
 };
 
 class Context {
@@ -196,7 +242,9 @@ class QueryContext : public Context {
           query_config_(query_config),
           executor_(executor),
           consistency_level_(consistency_level),
-          plan_options_(plan_options) {
+          plan_options_(plan_options),
+          memory_tracker_(std::make_shared<MemoryTracker>(
+              "query " + query_id, MemoryTracker::Process())) {
     }
 
     folly::Executor*
@@ -224,6 +272,17 @@ class QueryContext : public Context {
         return segment_;
     }
 
+    void
+    set_segment_snapshot(
+        std::shared_ptr<const milvus::segcore::SealedCatalog> snapshot) {
+        segment_snapshot_ = std::move(snapshot);
+    }
+
+    const std::shared_ptr<const milvus::segcore::SealedCatalog>&
+    get_segment_snapshot() const {
+        return segment_snapshot_;
+    }
+
     milvus::Timestamp
     get_query_timestamp() {
         return query_timestamp_;
@@ -284,6 +343,16 @@ class QueryContext : public Context {
         return std::move(retrieve_result_);
     }
 
+    void
+    set_query_profile(QueryProfile&& profile) {
+        query_profile_ = std::move(profile);
+    }
+
+    QueryProfile&&
+    get_query_profile() {
+        return std::move(query_profile_);
+    }
+
     void
     set_op_context(milvus::OpContext* op_context) {
         op_context_ = op_context;
@@ -304,6 +373,41 @@ class QueryContext : public Context {
         return plan_options_;
     }
 
+    void
+    set_retrieve_limit(int64_t limit) {
+        retrieve_limit_ = limit;
+    }
+
+    // set when the filter of a retrieve may stop once this many rows pass
+    std::optional<int64_t>
+    get_retrieve_limit() const {
+        return retrieve_limit_;
+    }
+
+    void
+    set_shared_filter(std::shared_ptr<SharedFilterResults::Ticket> ticket) {
+        shared_filter_ = std::move(ticket);
+    }
+
+    // set when the search shares the result of its filter, masked by MVCC,
+    // with the concurrent searches of the same filter
+    const std::shared_ptr<SharedFilterResults::Ticket>&
+    get_shared_filter() const {
+        return shared_filter_;
+    }
+
+    void
+    set_filter_result_shared(bool shared) {
+        filter_result_shared_ = shared;
+    }
+
+    // whether the filter took the result of another search, MVCC has
+    // masked it already
+    bool
+    filter_result_shared() const {
+        return filter_result_shared_;
+    }
+
     void
     set_element_level_query(bool element_level) {
         element_level_query_ = element_level;
@@ -362,6 +466,16 @@ class QueryContext : public Context {
         return element_level_bitset_.has_value();
     }
 
+    BitmapColumnPool&
+    bitmap_column_pool() {
+        return bitmap_column_pool_;
+    }
+
+    const std::shared_ptr<MemoryTracker>&
+    memory_tracker() const {
+        return memory_tracker_;
+    }
+
  private:
     folly::Executor* executor_;
     //folly::Executor::KeepAlive<> executor_keepalive_;
@@ -383,19 +497,35 @@ class QueryContext : public Context {
     // used for store segment search/retrieve result
     milvus::SearchResult search_result_;
     milvus::RetrieveResult retrieve_result_;
+    // operator stats of the task run for this query
+    QueryProfile query_profile_;
 
     // used for save op context
     milvus::OpContext* op_context_{nullptr};
 
+    // the state of segment_ the tasks of the query read, taken when the
+    // first of them starts
+    std::shared_ptr<const milvus::segcore::SealedCatalog> segment_snapshot_;
+
     int32_t consistency_level_ = 0;
 
     query::PlanOptions plan_options_;
+    std::optional<int64_t> retrieve_limit_;
+    std::shared_ptr<SharedFilterResults::Ticket> shared_filter_;
+    bool filter_result_shared_{false};
 
     bool element_level_query_{false};
     std::string struct_name_;
     std::shared_ptr<const IArrayOffsets> array_offsets_{nullptr};
     int64_t active_element_count_{0};  // Total elements in active documents
     std::optional<TargetBitmap> element_level_bitset_;
+
+    // recycles the per batch result bitmaps of the expressions
+    BitmapColumnPool bitmap_column_pool_;
+
+    // the memory the operators of this query hold, under the process
+    // tracker
+    std::shared_ptr<MemoryTracker> memory_tracker_;
 };
 
 // Represent the state of one thread of query execution.
@@ -420,6 +550,17 @@ class ExecContext : public Context {
     QueryContext* query_context_;
 };
 
+/// @brief Throws folly::FutureCancellation if the operation has been
+/// cancelled, by its caller or at its deadline.
+/// @param op_context Pointer to OpContext (can be nullptr)
+inline void
+checkCancellation(const milvus::OpContext* op_context) {
+    if (op_context != nullptr &&
+        op_context->cancellation_token.isCancellationRequested()) {
+        throw folly::FutureCancellation();
+    }
+}
+
 /// @brief Helper function to check cancellation token and throw if cancelled.
 /// This function safely checks the cancellation token from QueryContext and throws
 /// folly::FutureCancellation if the operation has been cancelled.
@@ -429,11 +570,7 @@ checkCancellation(QueryContext* query_context) {
     if (query_context == nullptr) {
         return;
     }
-    auto* op_context = query_context->get_op_context();
-    if (op_context != nullptr &&
-        op_context->cancellation_token.isCancellationRequested()) {
-        throw folly::FutureCancellation();
-    }
+    checkCancellation(query_context->get_op_context());
 }
 
 }  // namespace milvus::exec
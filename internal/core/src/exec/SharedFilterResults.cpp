@@ -0,0 +1,139 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/SharedFilterResults.h"
+
+#include "common/EasyAssert.h"
+
+namespace milvus::exec {
+
+std::atomic<bool> SharedFilterResults::enabled_{false};
+
+SharedFilterResults::Ticket::~Ticket() {
+    if (!owner_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(entry_->mutex);
+        if (entry_->done) {
+            return;
+        }
+        entry_->done = true;
+    }
+    results_->Erase(key_, entry_);
+    entry_->promise.setValue();
+}
+
+ContinueFuture
+SharedFilterResults::Ticket::Wait() const {
+    return entry_->promise.getSemiFuture();
+}
+
+std::optional<SharedFilterResults::Result>
+SharedFilterResults::Ticket::Get() const {
+    std::lock_guard<std::mutex> lock(entry_->mutex);
+    return entry_->result;
+}
+
+void
+SharedFilterResults::Ticket::Publish(TargetBitmapView bitset,
+                                     TargetBitmapView valid_bitset) {
+    AssertInfo(owner_, "only the owner of a shared filter publishes it");
+    auto copy_bitset = std::make_shared<TargetBitmap>();
+    copy_bitset->append(bitset);
+    auto copy_valid_bitset = std::make_shared<TargetBitmap>();
+    copy_valid_bitset->append(valid_bitset);
+    {
+        std::lock_guard<std::mutex> lock(entry_->mutex);
+        AssertInfo(!entry_->done, "shared filter result published twice");
+        entry_->result =
+            Result{std::move(copy_bitset), std::move(copy_valid_bitset)};
+        entry_->done = true;
+        entry_->done_at = std::chrono::steady_clock::now();
+    }
+    entry_->promise.setValue();
+}
+
+SharedFilterResults&
+SharedFilterResults::Instance() {
+    static SharedFilterResults instance;
+    return instance;
+}
+
+void
+SharedFilterResults::SetEnabled(bool enabled) {
+    enabled_.store(enabled);
+}
+
+bool
+SharedFilterResults::IsEnabled() {
+    return enabled_.load();
+}
+
+std::shared_ptr<SharedFilterResults::Ticket>
+SharedFilterResults::Join(const Key& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    EraseExpired();
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        return std::make_shared<Ticket>(this, key, it->second, false);
+    }
+    if (entries_.size() >= kMaxEntries) {
+        return nullptr;
+    }
+    auto entry = std::make_shared<Entry>();
+    entries_.emplace(key, entry);
+    return std::make_shared<Ticket>(this, key, std::move(entry), true);
+}
+
+size_t
+SharedFilterResults::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void
+SharedFilterResults::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+void
+SharedFilterResults::Erase(const Key& key,
+                           const std::shared_ptr<Entry>& entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end() && it->second == entry) {
+        entries_.erase(it);
+    }
+}
+
+void
+SharedFilterResults::EraseExpired() {
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto& entry = *it->second;
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        if (entry.done &&
+            now - entry.done_at > std::chrono::milliseconds(kRetentionMs)) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace milvus::exec
@@ -0,0 +1,166 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <folly/futures/SharedPromise.h>
+
+#include "common/Promise.h"
+#include "common/Types.h"
+
+namespace milvus::exec {
+
+// Process-level sharing of the filter results of concurrent searches.
+//
+// The sub-requests of a hybrid search run the same filter on the same
+// segment at the same timestamp, one per vector field. Each would evaluate
+// the filter and mask it by MVCC and deletes again. The first search of a
+// key evaluates them and publishes the masked bitset, the searches joining
+// the key meanwhile wait for it, and the ones joining within kRetentionMs
+// after take it at once.
+//
+// The key names the segment, the filter and the rows the search sees: its
+// timestamp, collection ttl, active count and the deleted count of the
+// segment, so a shared bitset is exactly the one the search would compute.
+class SharedFilterResults {
+ public:
+    struct Key {
+        int64_t segment_id{0};
+        std::string signature;
+
+        bool
+        operator==(const Key& other) const {
+            return segment_id == other.segment_id &&
+                   signature == other.signature;
+        }
+    };
+
+    struct KeyHasher {
+        size_t
+        operator()(const Key& k) const noexcept {
+            return (std::hash<int64_t>{}(k.segment_id) * 1315423911u) ^
+                   std::hash<std::string>{}(k.signature);
+        }
+    };
+
+    struct Result {
+        std::shared_ptr<const TargetBitmap> bitset;
+        std::shared_ptr<const TargetBitmap> valid_bitset;
+    };
+
+ private:
+    struct Entry {
+        std::mutex mutex;
+        bool done{false};
+        // empty once done if the owner gave up
+        std::optional<Result> result;
+        std::chrono::steady_clock::time_point done_at;
+        folly::SharedPromise<folly::Unit> promise;
+    };
+
+ public:
+    // The part of one search in the result of its key. The owner evaluates
+    // the filter and publishes the result, the others wait for it. An owner
+    // destroyed before it publishes gives the key up, its waiters then
+    // evaluate the filter on their own.
+    class Ticket {
+     public:
+        Ticket(SharedFilterResults* results,
+               Key key,
+               std::shared_ptr<Entry> entry,
+               bool owner)
+            : results_(results),
+              key_(std::move(key)),
+              entry_(std::move(entry)),
+              owner_(owner) {
+        }
+
+        ~Ticket();
+
+        bool
+        owner() const {
+            return owner_;
+        }
+
+        // ready once the owner published or gave up
+        ContinueFuture
+        Wait() const;
+
+        // the published result, nullopt before or if the owner gave up
+        std::optional<Result>
+        Get() const;
+
+        // keeps a copy of the bitsets
+        void
+        Publish(TargetBitmapView bitset, TargetBitmapView valid_bitset);
+
+     private:
+        SharedFilterResults* results_;
+        Key key_;
+        std::shared_ptr<Entry> entry_;
+        bool owner_;
+    };
+
+    static SharedFilterResults&
+    Instance();
+    static void
+    SetEnabled(bool enabled);
+    static bool
+    IsEnabled();
+
+    // the ticket of the search for key, nullptr if kMaxEntries keys are
+    // already shared
+    std::shared_ptr<Ticket>
+    Join(const Key& key);
+
+    size_t
+    Size() const;
+
+    void
+    Clear();
+
+    // how long a published result is kept for the searches still to come
+    static constexpr int64_t kRetentionMs = 1000;
+    static constexpr size_t kMaxEntries = 256;
+
+ private:
+    SharedFilterResults() = default;
+
+    // drops the key of entry if it is still the one of entry
+    void
+    Erase(const Key& key, const std::shared_ptr<Entry>& entry);
+
+    // drops the results kept longer than kRetentionMs, caller holds mutex_
+    void
+    EraseExpired();
+
+    static std::atomic<bool> enabled_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, std::shared_ptr<Entry>, KeyHasher> entries_;
+};
+
+}  // namespace milvus::exec
@@ -0,0 +1,102 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Types.h"
+#include "exec/SharedFilterResults.h"
+
+using milvus::TargetBitmap;
+using milvus::TargetBitmapView;
+using milvus::exec::SharedFilterResults;
+
+class SharedFilterResultsTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        SharedFilterResults::Instance().Clear();
+    }
+
+    void
+    TearDown() override {
+        SharedFilterResults::Instance().Clear();
+    }
+};
+
+TEST_F(SharedFilterResultsTest, Publish) {
+    auto& results = SharedFilterResults::Instance();
+    SharedFilterResults::Key key{1, "a > 1|100|0|8|0"};
+    auto owner = results.Join(key);
+    ASSERT_NE(owner, nullptr);
+    EXPECT_TRUE(owner->owner());
+
+    auto waiter = results.Join(key);
+    ASSERT_NE(waiter, nullptr);
+    EXPECT_FALSE(waiter->owner());
+    auto future = waiter->Wait();
+    EXPECT_FALSE(future.isReady());
+    EXPECT_FALSE(waiter->Get().has_value());
+
+    // another segment or filter is a key of its own
+    EXPECT_TRUE(results.Join({2, key.signature})->owner());
+
+    TargetBitmap bitset(8);
+    bitset.set(3);
+    TargetBitmap valid_bitset(8, true);
+    owner->Publish(TargetBitmapView(bitset.data(), bitset.size()),
+                   TargetBitmapView(valid_bitset.data(), valid_bitset.size()));
+    owner.reset();
+    EXPECT_TRUE(future.isReady());
+    auto result = waiter->Get();
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->bitset->count(), 1);
+    EXPECT_TRUE((*result->bitset)[3]);
+    EXPECT_EQ(result->valid_bitset->count(), 8);
+
+    // the searches coming later take it at once
+    auto late = results.Join(key);
+    EXPECT_FALSE(late->owner());
+    EXPECT_TRUE(late->Wait().isReady());
+    EXPECT_TRUE(late->Get().has_value());
+}
+
+TEST_F(SharedFilterResultsTest, OwnerGivesUp) {
+    auto& results = SharedFilterResults::Instance();
+    SharedFilterResults::Key key{1, "a > 1|100|0|8|0"};
+    auto owner = results.Join(key);
+    auto waiter = results.Join(key);
+    auto future = waiter->Wait();
+
+    owner.reset();
+    EXPECT_TRUE(future.isReady());
+    EXPECT_FALSE(waiter->Get().has_value());
+    EXPECT_EQ(results.Size(), 0);
+
+    // the next search evaluates the filter again
+    EXPECT_TRUE(results.Join(key)->owner());
+}
+
+TEST_F(SharedFilterResultsTest, MaxEntries) {
+    auto& results = SharedFilterResults::Instance();
+    std::vector<std::shared_ptr<SharedFilterResults::Ticket>> owners;
+    for (size_t i = 0; i < SharedFilterResults::kMaxEntries; ++i) {
+        owners.push_back(results.Join({1, std::to_string(i)}));
+        ASSERT_NE(owners.back(), nullptr);
+    }
+    EXPECT_EQ(results.Join({1, "one more"}), nullptr);
+    owners.pop_back();
+    EXPECT_NE(results.Join({1, "one more"}), nullptr);
+}
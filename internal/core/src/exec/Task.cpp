@@ -16,6 +16,7 @@
 
 #include "Task.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 
 #include <boost/lexical_cast.hpp>
@@ -94,6 +95,19 @@ Task::SetError(const std::string& message) {
     }
 }
 
+void
+Task::AddOperatorStats(const OperatorStats& stats) {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (auto& merged : operator_stats_) {
+        if (merged.operator_id == stats.operator_id &&
+            merged.plannode_id == stats.plannode_id) {
+            merged += stats;
+            return;
+        }
+    }
+    operator_stats_.push_back(stats);
+}
+
 void
 Task::CreateDriversLocked(std::shared_ptr<Task>& self,
                           uint32_t split_group_id,
@@ -147,7 +161,9 @@ Task::Next(ContinueFuture* future) {
     AssertInfo(state_ == TaskState::kRunning,
                "Task has already finished processing.");
 
-    tracer::AutoSpan span("Task::Next", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("Task::Next", true);
+    segcore::ScopedSegmentSnapshot snapshot(
+        query_context_->get_segment(), query_context_->get_segment_snapshot());
     if (driver_factories_.empty()) {
         AssertInfo(
             consumer_supplier_ == nullptr,
@@ -201,15 +217,15 @@ Task::Next(ContinueFuture* future) {
             auto result = drivers_[i]->Next(blocking_state);
 
             if (result) {
-                tracer::AddEvent(
-                    fmt::format("driver_result_produced: driver_id={}, rows={}",
-                                i,
-                                result->childrens()[0]->size()));
+                tracer::AddEventFmt(
+                    "driver_result_produced: driver_id={}, rows={}",
+                    i,
+                    result->childrens()[0]->size());
                 return result;
             }
 
             if (blocking_state) {
-                tracer::AddEvent(fmt::format("driver_{}_blocked", i));
+                tracer::AddEventFmt("driver_{}_blocked", i);
                 futures[i] = blocking_state->future();
             }
 
@@ -218,9 +234,9 @@ Task::Next(ContinueFuture* future) {
             }
         }
 
-        tracer::AddEvent(fmt::format("iteration: runnable={}, blocked={}",
-                                     runnable_drivers,
-                                     blocked_drivers));
+        tracer::AddEventFmt("iteration: runnable={}, blocked={}",
+                            runnable_drivers,
+                            blocked_drivers);
 
         if (runnable_drivers == 0) {
             if (blocked_drivers > 0) {
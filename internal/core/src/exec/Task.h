@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "common/QueryResult.h"
 #include "common/Types.h"
 #include "exec/Driver.h"
 #include "exec/QueryContext.h"
@@ -63,6 +64,13 @@ class Task : public std::enable_shared_from_this<Task> {
           query_context_(std::move(query_ctx)),
           consumer_supplier_(std::move(consumer_supplier)),
           on_error_(on_error) {
+        // the operators read the segment as it was when the task started,
+        // not as a load or drop meanwhile leaves it
+        auto segment = query_context_->get_segment();
+        if (segment != nullptr &&
+            query_context_->get_segment_snapshot() == nullptr) {
+            query_context_->set_segment_snapshot(segment->snapshot());
+        }
     }
 
     ~Task() {
@@ -171,6 +179,17 @@ class Task : public std::enable_shared_from_this<Task> {
         Terminate(TaskState::kCanceled);
     }
 
+    // Merges the stats of an operator of a closing driver into the profile
+    // of the task, the drivers of a pipeline share their operator ids.
+    void
+    AddOperatorStats(const OperatorStats& stats);
+
+    QueryProfile
+    operator_stats() const {
+        std::lock_guard<std::mutex> l(mutex_);
+        return operator_stats_;
+    }
+
  private:
     std::string uuid_;
 
@@ -203,6 +222,8 @@ class Task : public std::enable_shared_from_this<Task> {
     uint32_t num_ungrouped_drivers_{0};
 
     uint32_t num_finished_drivers_{0};
+
+    QueryProfile operator_stats_;
 };
 
 }  // namespace exec
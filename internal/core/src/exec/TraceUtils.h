@@ -0,0 +1,70 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fmt/core.h>
+
+#include "common/Tracer.h"
+
+// Operators and expressions open a span and add events for every batch.
+// These wrappers do that work only when the query is sampled, so an
+// unsampled query pays neither the span nor the string formatting.
+namespace milvus::tracer {
+
+inline bool
+IsRootSpanRecording() {
+    auto span = GetRootSpan();
+    return span != nullptr && span->IsRecording();
+}
+
+// AddEvent with its label formatted only when the root span records
+template <typename... Args>
+inline void
+AddEventFmt(fmt::format_string<Args...> format, Args&&... args) {
+    if (IsRootSpanRecording()) {
+        AddEvent(fmt::format(format, std::forward<Args>(args)...));
+    }
+}
+
+// An AutoSpan under the root span, opened only when the root span records
+class LazyAutoSpan {
+ public:
+    explicit LazyAutoSpan(const char* name, bool is_root_span = false) {
+        auto root = GetRootSpan();
+        if (root != nullptr && root->IsRecording()) {
+            span_.emplace(std::string(name), root, is_root_span);
+        }
+    }
+
+    template <typename T>
+    void
+    SetAttribute(std::string_view key, const T& value) {
+        if (span_.has_value()) {
+            span_->GetSpan()->SetAttribute(key, value);
+        }
+    }
+
+ private:
+    std::optional<AutoSpan> span_;
+};
+
+}  // namespace milvus::tracer
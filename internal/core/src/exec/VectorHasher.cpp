@@ -15,6 +15,8 @@
 // limitations under the License.
 
 #include "VectorHasher.h"
+#include <algorithm>
+#include <limits>
 #include "common/float_util_c.h"
 #include <folly/Hash.h>
 #include "common/BitUtil.h"
@@ -68,9 +70,160 @@ VectorHasher::hashValues(const ColumnVectorPtr& column_data,
 
 void
 VectorHasher::hash(bool mix, std::vector<uint64_t>& result) {
+    hash(columnData(), mix, result);
+}
+
+void
+VectorHasher::hash(const ColumnVectorPtr& column,
+                   bool mix,
+                   std::vector<uint64_t>& result) {
     auto element_data_type = ChannelDataType();
     MILVUS_DYNAMIC_TYPE_DISPATCH(
-        hashValues, element_data_type, columnData(), mix, result.data());
+        hashValues, element_data_type, column, mix, result.data());
+}
+
+template <DataType Type>
+void
+VectorHasher::analyzeValues(const ColumnVectorPtr& column_data) {
+    if constexpr (Type == DataType::VARCHAR || Type == DataType::STRING) {
+        for (size_t row_idx = 0; row_idx < column_data->size(); ++row_idx) {
+            if (!column_data->ValidAt(row_idx)) {
+                continue;
+            }
+            const auto& value = column_data->ValueAt<std::string>(row_idx);
+            // ids start from 1, 0 is the null id
+            uniqueValues_.try_emplace(value, uniqueValues_.size() + 1);
+            if (uniqueValues_.size() > kMaxDistinct) {
+                distinctOverflow_ = true;
+                uniqueValues_.clear();
+                return;
+            }
+        }
+    } else if constexpr (Type == DataType::BOOL || Type == DataType::INT8 ||
+                         Type == DataType::INT16 || Type == DataType::INT32 ||
+                         Type == DataType::INT64) {
+        using T = typename TypeTraits<Type>::NativeType;
+        for (size_t row_idx = 0; row_idx < column_data->size(); ++row_idx) {
+            if (!column_data->ValidAt(row_idx)) {
+                continue;
+            }
+            const auto value =
+                static_cast<int64_t>(column_data->ValueAt<T>(row_idx));
+            if (!hasRange_) {
+                hasRange_ = true;
+                min_ = max_ = value;
+            } else {
+                min_ = std::min(min_, value);
+                max_ = std::max(max_, value);
+            }
+        }
+        if (hasRange_ && static_cast<__int128>(max_) - min_ >=
+                             static_cast<__int128>(kMaxRange)) {
+            rangeOverflow_ = true;
+        }
+    }
+}
+
+void
+VectorHasher::analyze() {
+    if (!mayUseValueIds()) {
+        return;
+    }
+    MILVUS_DYNAMIC_TYPE_DISPATCH(
+        analyzeValues, ChannelDataType(), columnData());
+}
+
+uint64_t
+VectorHasher::valueIdRangeSize(int32_t reservePct) const {
+    AssertInfo(mayUseValueIds(),
+               "values of key column {} cannot be mapped to value ids",
+               channel_idx_);
+    uint64_t numValues = 0;
+    if (isStringType()) {
+        numValues = uniqueValues_.size();
+    } else if (hasRange_) {
+        numValues = static_cast<uint64_t>(max_ - min_) + 1;
+    }
+    const uint64_t reserve = numValues * reservePct / 100;
+    // one more id for null
+    return std::min(numValues + reserve, kMaxRange) + 1;
+}
+
+uint64_t
+VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
+    rangeSize_ = valueIdRangeSize(reservePct);
+    if (!isStringType() && hasRange_) {
+        // spread the reserve evenly below and above the seen values, as long
+        // as that does not wrap around
+        const uint64_t numValues = static_cast<uint64_t>(max_ - min_) + 1;
+        const auto below =
+            static_cast<__int128>((rangeSize_ - 1 - numValues) / 2);
+        rangeMin_ = static_cast<__int128>(min_) - below <
+                            std::numeric_limits<int64_t>::min()
+                        ? std::numeric_limits<int64_t>::min()
+                        : static_cast<int64_t>(min_ - below);
+    }
+    multiplier_ = multiplier;
+    valueIdsEnabled_ = true;
+    return multiplier * rangeSize_;
+}
+
+template <DataType Type>
+bool
+VectorHasher::valueIds(const ColumnVectorPtr& column_data,
+                       bool mix,
+                       uint64_t* result) {
+    if constexpr (Type == DataType::VARCHAR || Type == DataType::STRING) {
+        for (size_t row_idx = 0; row_idx < column_data->size(); ++row_idx) {
+            uint64_t id = kNullValueId;
+            if (column_data->ValidAt(row_idx)) {
+                auto it = uniqueValues_.find(
+                    column_data->ValueAt<std::string>(row_idx));
+                if (it == uniqueValues_.end() || it->second >= rangeSize_) {
+                    return false;
+                }
+                id = it->second;
+            }
+            result[row_idx] =
+                mix ? result[row_idx] + id * multiplier_ : id * multiplier_;
+        }
+        return true;
+    } else if constexpr (Type == DataType::BOOL || Type == DataType::INT8 ||
+                         Type == DataType::INT16 || Type == DataType::INT32 ||
+                         Type == DataType::INT64) {
+        using T = typename TypeTraits<Type>::NativeType;
+        for (size_t row_idx = 0; row_idx < column_data->size(); ++row_idx) {
+            uint64_t id = kNullValueId;
+            if (column_data->ValidAt(row_idx)) {
+                const auto value =
+                    static_cast<int64_t>(column_data->ValueAt<T>(row_idx));
+                if (value < rangeMin_) {
+                    return false;
+                }
+                id = static_cast<uint64_t>(value) -
+                     static_cast<uint64_t>(rangeMin_) + 1;
+                if (id >= rangeSize_) {
+                    return false;
+                }
+            }
+            result[row_idx] =
+                mix ? result[row_idx] + id * multiplier_ : id * multiplier_;
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool
+VectorHasher::computeValueIds(const ColumnVectorPtr& column,
+                              bool mix,
+                              std::vector<uint64_t>& result) {
+    if (!valueIdsEnabled_) {
+        return false;
+    }
+    return MILVUS_DYNAMIC_TYPE_DISPATCH(
+        valueIds, ChannelDataType(), column, mix, result.data());
 }
 
 }  // namespace exec
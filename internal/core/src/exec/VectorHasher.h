@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include "common/Vector.h"
 #include "common/Types.h"
 #include "expr/ITypeExpr.h"
@@ -46,8 +49,24 @@ class VectorHasher {
     void
     hash(bool mix, std::vector<uint64_t>& result);
 
+    /// Hashes 'column' instead of the column data set on this hasher.
+    void
+    hash(const ColumnVectorPtr& column,
+         bool mix,
+         std::vector<uint64_t>& result);
+
     static constexpr uint64_t kNullHash = 1;
 
+    // Value id of null, non-null values are mapped to ids starting from 1.
+    static constexpr uint64_t kNullValueId = 0;
+
+    // Unique string values tracked before giving up on value ids.
+    static constexpr size_t kMaxDistinct = 100'000;
+
+    // Value ranges are never wider than this, so that the product of the
+    // ranges of a few keys still fits a normalized key.
+    static constexpr uint64_t kMaxRange = 1UL << 48;
+
     static bool
     typeSupportValueIds(DataType type) {
         switch (type) {
@@ -68,6 +87,42 @@ class VectorHasher {
     void
     hashValues(const ColumnVectorPtr& column_data, bool mix, uint64_t* result);
 
+    /// Accumulates the value range or the unique values of the column data
+    /// set on this hasher.
+    void
+    analyze();
+
+    /// Whether the values seen by analyze() can be mapped to value ids.
+    bool
+    mayUseValueIds() const {
+        return typeSupportValueIds(channel_type_) && !distinctOverflow_ &&
+               !rangeOverflow_;
+    }
+
+    /// Number of value ids, including the null id, to cover the values seen
+    /// by analyze() plus 'reservePct' percent of headroom for new values.
+    uint64_t
+    valueIdRangeSize(int32_t reservePct) const;
+
+    /// Starts mapping values to ids. The ids of this key are multiplied by
+    /// 'multiplier', so that the ids of several keys add up to a unique
+    /// normalized key. Returns 'multiplier' times the range size.
+    uint64_t
+    enableValueIds(uint64_t multiplier, int32_t reservePct);
+
+    void
+    disableValueIds() {
+        valueIdsEnabled_ = false;
+    }
+
+    /// Sets (or adds when 'mix' is true) the scaled value id of each row of
+    /// 'column' to 'result'. Returns false if a value falls outside the
+    /// enabled range, in which case 'result' is left partially updated.
+    bool
+    computeValueIds(const ColumnVectorPtr& column,
+                    bool mix,
+                    std::vector<uint64_t>& result);
+
     void
     setColumnData(const ColumnVectorPtr& column_data) {
         column_data_ = column_data;
@@ -79,9 +134,38 @@ class VectorHasher {
     }
 
  private:
+    template <DataType type>
+    void
+    analyzeValues(const ColumnVectorPtr& column_data);
+
+    template <DataType type>
+    bool
+    valueIds(const ColumnVectorPtr& column_data, bool mix, uint64_t* result);
+
+    bool
+    isStringType() const {
+        return channel_type_ == DataType::VARCHAR ||
+               channel_type_ == DataType::STRING;
+    }
+
     const column_index_t channel_idx_;
     const DataType channel_type_;
     ColumnVectorPtr column_data_;
+
+    // Statistics collected by analyze(). Integer keys keep their min and max,
+    // string keys keep their unique values, numbered in order of appearance.
+    bool hasRange_ = false;
+    int64_t min_ = 0;
+    int64_t max_ = 0;
+    bool rangeOverflow_ = false;
+    std::unordered_map<std::string, uint64_t> uniqueValues_;
+    bool distinctOverflow_ = false;
+
+    // The mapping in use once enableValueIds() was called.
+    bool valueIdsEnabled_ = false;
+    int64_t rangeMin_ = 0;
+    uint64_t rangeSize_ = 0;
+    uint64_t multiplier_ = 1;
 };
 
 std::vector<std::unique_ptr<VectorHasher>>
@@ -15,17 +15,17 @@
 // limitations under the License.
 
 #include "BinaryArithOpEvalRangeExpr.h"
+#include "exec/TraceUtils.h"
+#include "index/json_stats/JsonKeyStats.h"
 
 namespace milvus {
 namespace exec {
 
 void
 PhyBinaryArithOpEvalRangeExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyBinaryArithOpEvalRangeExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type",
-                                 static_cast<int>(expr_->column_.data_type_));
-    span.GetSpan()->SetAttribute("op_type", static_cast<int>(expr_->op_type_));
+    tracer::LazyAutoSpan span("PhyBinaryArithOpEvalRangeExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->column_.data_type_));
+    span.SetAttribute("op_type", static_cast<int>(expr_->op_type_));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
@@ -66,15 +66,15 @@ PhyBinaryArithOpEvalRangeExpr::Eval(EvalCtx& context, VectorPtr& result) {
             auto value_type = expr_->value_.val_case();
             switch (value_type) {
                 case proto::plan::GenericValue::ValCase::kBoolVal: {
-                    result = ExecRangeVisitorImplForJson<bool>(input);
+                    result = ExecRangeVisitorImplForJson<bool>(context);
                     break;
                 }
                 case proto::plan::GenericValue::ValCase::kInt64Val: {
-                    result = ExecRangeVisitorImplForJson<int64_t>(input);
+                    result = ExecRangeVisitorImplForJson<int64_t>(context);
                     break;
                 }
                 case proto::plan::GenericValue::ValCase::kFloatVal: {
-                    result = ExecRangeVisitorImplForJson<double>(input);
+                    result = ExecRangeVisitorImplForJson<double>(context);
                     break;
                 }
                 default: {
@@ -118,18 +118,27 @@ PhyBinaryArithOpEvalRangeExpr::Eval(EvalCtx& context, VectorPtr& result) {
 template <typename ValueType>
 VectorPtr
 PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForJson(
-    OffsetVector* input) {
+    EvalCtx& context) {
     using GetType = std::conditional_t<std::is_same_v<ValueType, std::string>,
                                        std::string_view,
                                        ValueType>;
+    auto* input = context.get_offset_input();
+    if constexpr (std::is_same_v<ValueType, int64_t> ||
+                  std::is_same_v<ValueType, double>) {
+        if (!has_offset_input_ &&
+            expr_->arith_op_type_ != proto::plan::ArithOpType::ArrayLength &&
+            CanUseJsonStats(context,
+                            expr_->column_.field_id_,
+                            expr_->column_.nested_path_)) {
+            return ExecRangeVisitorImplForJsonStats<ValueType>();
+        }
+    }
     auto real_batch_size =
         has_offset_input_ ? input->size() : GetNextBatchSize();
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -530,6 +539,267 @@ PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForJson(
     return res_vec;
 }
 
+namespace {
+
+// x <arith_op> right_operand <cmp_op> value with the types of the raw JSON
+// path, so integers divide as integers and doubles take fmod
+template <typename T, typename U>
+bool
+JsonArithCompare(T x,
+                 U right_operand,
+                 U value,
+                 proto::plan::ArithOpType arith_op,
+                 proto::plan::OpType cmp_op) {
+    decltype(x + right_operand) lhs;
+    switch (arith_op) {
+        case proto::plan::ArithOpType::Add:
+            lhs = x + right_operand;
+            break;
+        case proto::plan::ArithOpType::Sub:
+            lhs = x - right_operand;
+            break;
+        case proto::plan::ArithOpType::Mul:
+            lhs = x * right_operand;
+            break;
+        case proto::plan::ArithOpType::Div:
+            lhs = x / right_operand;
+            break;
+        case proto::plan::ArithOpType::Mod:
+            lhs = safe_mod(x, right_operand);
+            break;
+        default:
+            ThrowInfo(OpTypeInvalid,
+                      "unsupported arith type for binary arithmetic eval "
+                      "expr: {}",
+                      arith_op);
+    }
+    switch (cmp_op) {
+        case proto::plan::OpType::Equal:
+            return lhs == value;
+        case proto::plan::OpType::GreaterEqual:
+            return lhs >= value;
+        case proto::plan::OpType::GreaterThan:
+            return lhs > value;
+        case proto::plan::OpType::LessEqual:
+            return lhs <= value;
+        case proto::plan::OpType::LessThan:
+            return lhs < value;
+        default:
+            ThrowInfo(OpTypeInvalid,
+                      "unsupported operator type for binary arithmetic eval "
+                      "expr: {}",
+                      cmp_op);
+    }
+}
+
+// Add, Sub and Mul over a shredded column run in the SIMD kernels of the
+// bitset, Div and Mod keep the row by row semantics of JsonArithCompare
+template <typename T>
+void
+JsonArithCompareColumn(const T* src,
+                       size_t size,
+                       T right_operand,
+                       T value,
+                       proto::plan::ArithOpType arith_op,
+                       proto::plan::OpType cmp_op,
+                       TargetBitmapView res) {
+    milvus::bitset::ArithOpType simd_arith_op;
+    switch (arith_op) {
+        case proto::plan::ArithOpType::Add:
+            simd_arith_op = milvus::bitset::ArithOpType::Add;
+            break;
+        case proto::plan::ArithOpType::Sub:
+            simd_arith_op = milvus::bitset::ArithOpType::Sub;
+            break;
+        case proto::plan::ArithOpType::Mul:
+            simd_arith_op = milvus::bitset::ArithOpType::Mul;
+            break;
+        default:
+            for (size_t i = 0; i < size; ++i) {
+                res[i] = JsonArithCompare(
+                    src[i], right_operand, value, arith_op, cmp_op);
+            }
+            return;
+    }
+    milvus::bitset::CompareOpType simd_cmp_op;
+    switch (cmp_op) {
+        case proto::plan::OpType::Equal:
+            simd_cmp_op = milvus::bitset::CompareOpType::EQ;
+            break;
+        case proto::plan::OpType::GreaterEqual:
+            simd_cmp_op = milvus::bitset::CompareOpType::GE;
+            break;
+        case proto::plan::OpType::GreaterThan:
+            simd_cmp_op = milvus::bitset::CompareOpType::GT;
+            break;
+        case proto::plan::OpType::LessEqual:
+            simd_cmp_op = milvus::bitset::CompareOpType::LE;
+            break;
+        case proto::plan::OpType::LessThan:
+            simd_cmp_op = milvus::bitset::CompareOpType::LT;
+            break;
+        default:
+            ThrowInfo(OpTypeInvalid,
+                      "unsupported operator type for binary arithmetic eval "
+                      "expr: {}",
+                      cmp_op);
+    }
+    res.inplace_arith_compare<T>(
+        src, right_operand, value, size, simd_arith_op, simd_cmp_op);
+}
+
+}  // namespace
+
+template <typename ValueType>
+VectorPtr
+PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForJsonStats() {
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+
+    if (!arg_inited_) {
+        value_arg_.SetValue<ValueType>(expr_->value_);
+        right_operand_arg_.SetValue<ValueType>(expr_->right_operand_);
+        arg_inited_ = true;
+    }
+    auto value = value_arg_.GetValue<ValueType>();
+    auto right_operand = right_operand_arg_.GetValue<ValueType>();
+    auto arith_type = expr_->arith_op_type_;
+    if ((arith_type == proto::plan::ArithOpType::Div ||
+         arith_type == proto::plan::ArithOpType::Mod) &&
+        right_operand == 0) {
+        ThrowInfo(
+            ErrorCode::ExprInvalid,
+            "division or modulus by zero in JSON field arithmetic expression");
+    }
+    auto pointer = milvus::index::JsonPointer(expr_->column_.nested_path_);
+    // NotEqual is Equal flipped, which also matches the rows without a
+    // number at the path like the raw path does
+    bool not_equal = expr_->op_type_ == proto::plan::OpType::NotEqual;
+    auto op_type = not_equal ? proto::plan::OpType::Equal : expr_->op_type_;
+
+    if (cached_index_chunk_id_ != 0 &&
+        segment_->type() == SegmentType::Sealed) {
+        auto* segment = dynamic_cast<const segcore::SegmentSealed*>(segment_);
+        auto field_id = expr_->column_.field_id_;
+        auto index = segment->GetJsonStats(op_ctx_, field_id);
+        Assert(index.get() != nullptr);
+
+        cached_index_chunk_res_ = std::make_shared<TargetBitmap>(active_count_);
+        TargetBitmapView res_view(*cached_index_chunk_res_);
+
+        // process shredding data, an int64 column is computed in doubles
+        // against a double operand, like at<double> does in the raw path
+        auto try_execute = [&](milvus::index::JSONType json_type,
+                               auto col_type) {
+            using ColType = decltype(col_type);
+            using CalcType =
+                std::conditional_t<std::is_same_v<ColType, double> ||
+                                       std::is_same_v<ValueType, double>,
+                                   double,
+                                   int64_t>;
+            auto target_field = index->GetShreddingField(pointer, json_type);
+            if (target_field.empty()) {
+                return;
+            }
+            std::vector<CalcType> converted;
+            auto shredding_executor = [&converted,
+                                       value,
+                                       right_operand,
+                                       arith_type,
+                                       op_type](const ColType* src,
+                                                const bool* valid,
+                                                size_t size,
+                                                TargetBitmapView res,
+                                                TargetBitmapView valid_res) {
+                const CalcType* data = nullptr;
+                if constexpr (std::is_same_v<ColType, CalcType>) {
+                    data = src;
+                } else {
+                    converted.assign(src, src + size);
+                    data = converted.data();
+                }
+                JsonArithCompareColumn<CalcType>(data,
+                                                 size,
+                                                 CalcType(right_operand),
+                                                 CalcType(value),
+                                                 arith_type,
+                                                 op_type,
+                                                 res);
+                if (valid != nullptr) {
+                    for (size_t i = 0; i < size; ++i) {
+                        if (!valid[i]) {
+                            res[i] = valid_res[i] = false;
+                        }
+                    }
+                }
+            };
+            TargetBitmap col_res(active_count_, false);
+            TargetBitmap col_valid_res(active_count_, true);
+            index->ExecutorForShreddingData<ColType>(
+                op_ctx_,
+                target_field,
+                shredding_executor,
+                nullptr,
+                TargetBitmapView(col_res),
+                TargetBitmapView(col_valid_res));
+            res_view.inplace_or_with_count(TargetBitmapView(col_res),
+                                           active_count_);
+            LOG_DEBUG("using shredding data's field: {} count {}",
+                      target_field,
+                      col_res.count());
+        };
+        try_execute(milvus::index::JSONType::INT64, int64_t{});
+        try_execute(milvus::index::JSONType::DOUBLE, double{});
+
+        // process shared data, int32 and int64 values parse as int64 first
+        // so an int64 operand keeps the integer semantics
+        auto shared_executor =
+            [value, right_operand, arith_type, op_type, &res_view](
+                milvus::BsonView bson, uint32_t row_id, uint32_t value_offset) {
+                auto int_val = bson.ParseAsValueAtOffset<int64_t>(value_offset);
+                if (int_val.has_value()) {
+                    if constexpr (std::is_same_v<ValueType, int64_t>) {
+                        res_view[row_id] = JsonArithCompare(int_val.value(),
+                                                            right_operand,
+                                                            value,
+                                                            arith_type,
+                                                            op_type);
+                    } else {
+                        res_view[row_id] =
+                            JsonArithCompare(double(int_val.value()),
+                                             right_operand,
+                                             value,
+                                             arith_type,
+                                             op_type);
+                    }
+                    return;
+                }
+                auto val = bson.ParseAsValueAtOffset<double>(value_offset);
+                res_view[row_id] =
+                    val.has_value() && JsonArithCompare(val.value(),
+                                                        right_operand,
+                                                        value,
+                                                        arith_type,
+                                                        op_type);
+            };
+        index->ExecuteForSharedData(
+            op_ctx_, bson_index_, pointer, shared_executor);
+        if (not_equal) {
+            cached_index_chunk_res_->flip();
+        }
+        cached_index_chunk_id_ = 0;
+    }
+
+    TargetBitmap result;
+    result.append(
+        *cached_index_chunk_res_, current_data_global_pos_, real_batch_size);
+    MoveCursor();
+    return std::make_shared<ColumnVector>(std::move(result),
+                                          TargetBitmap(real_batch_size, true));
+}
+
 template <typename ValueType>
 VectorPtr
 PhyBinaryArithOpEvalRangeExpr::ExecRangeVisitorImplForArray(
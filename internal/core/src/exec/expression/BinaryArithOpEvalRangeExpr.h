@@ -25,6 +25,7 @@
 #include "exec/expression/Expr.h"
 #include "segcore/SegmentInterface.h"
 #include "exec/expression/Element.h"
+#include "index/json_stats/bson_inverted.h"
 
 namespace milvus {
 namespace exec {
@@ -535,7 +536,11 @@ class PhyBinaryArithOpEvalRangeExpr : public SegmentExpr {
 
     template <typename ValueType>
     VectorPtr
-    ExecRangeVisitorImplForJson(OffsetVector* input = nullptr);
+    ExecRangeVisitorImplForJson(EvalCtx& context);
+
+    template <typename ValueType>
+    VectorPtr
+    ExecRangeVisitorImplForJsonStats();
 
     template <typename ValueType>
     VectorPtr
@@ -557,6 +562,7 @@ class PhyBinaryArithOpEvalRangeExpr : public SegmentExpr {
     SingleElement right_operand_arg_;
     SingleElement value_arg_;
     bool arg_inited_{false};
+    PinWrapper<index::BsonInvertedIndex*> bson_index_{nullptr};
 };
 
 }  //namespace exec
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "BinaryRangeExpr.h"
+#include "exec/TraceUtils.h"
 #include <utility>
 
 #include "query/Utils.h"
@@ -24,10 +25,8 @@ namespace exec {
 
 void
 PhyBinaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyBinaryRangeFilterExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type",
-                                 static_cast<int>(expr_->column_.data_type_));
+    tracer::LazyAutoSpan span("PhyBinaryRangeFilterExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->column_.data_type_));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
@@ -67,9 +66,7 @@ PhyBinaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
         case DataType::VARCHAR: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 result = ExecRangeVisitorImpl<std::string>(context);
             } else {
                 result = ExecRangeVisitorImpl<std::string_view>(context);
@@ -332,9 +329,7 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -458,8 +453,43 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
             processed_size = ProcessDataChunksForElementLevel<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val1, val2);
         } else {
+            if (!candidate_pages_func_) {
+                candidate_pages_func_ =
+                    [val1, val2, lower_inclusive, upper_inclusive](
+                        const SkipIndex& skip_index,
+                        FieldId field_id,
+                        int64_t chunk_id) {
+                        return skip_index.GetCandidatePagesBinaryRange<T>(
+                            field_id,
+                            chunk_id,
+                            val1,
+                            val2,
+                            lower_inclusive,
+                            upper_inclusive);
+                    };
+            }
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                if (bitmap_input.empty()) {
+                    dict_match_func_ = [&](const std::string_view* dict,
+                                           int64_t size,
+                                           TargetBitmapView dict_res,
+                                           TargetBitmapView dict_valid_res) {
+                        auto cursor = processed_cursor;
+                        execute_sub_batch(dict,
+                                          nullptr,
+                                          nullptr,
+                                          size,
+                                          dict_res,
+                                          dict_valid_res,
+                                          val1,
+                                          val2);
+                        processed_cursor = cursor;
+                    };
+                }
+            }
             processed_size = ProcessDataChunks<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val1, val2);
+            dict_match_func_ = nullptr;
         }
     }
     AssertInfo(processed_size == real_batch_size,
@@ -483,14 +513,20 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJson(EvalCtx& context) {
         CanUseJsonStats(context, field_id, expr_->column_.nested_path_)) {
         return ExecRangeVisitorImplForJsonStats<ValueType>();
     }
+    if (!has_offset_input_) {
+        auto growing_stats =
+            GetGrowingJsonStats(context, field_id, expr_->column_.nested_path_);
+        if (growing_stats != nullptr) {
+            return ExecRangeVisitorImplForJsonGrowingStats<ValueType>(
+                *growing_stats);
+        }
+    }
     auto real_batch_size =
         has_offset_input_ ? input->size() : GetNextBatchSize();
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -626,7 +662,6 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJsonStats() {
     // This allows int64 values to be cast to double when ValueType is double.
     ValueType val1 = GetValueWithCastNumber<ValueType>(expr_->lower_val_);
     ValueType val2 = GetValueWithCastNumber<ValueType>(expr_->upper_val_);
-
     if (cached_index_chunk_id_ != 0 &&
         segment_->type() == SegmentType::Sealed) {
         auto* segment = dynamic_cast<const segcore::SegmentSealed*>(segment_);
@@ -644,37 +679,35 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJsonStats() {
         auto try_execute = [&](milvus::index::JSONType json_type,
                                TargetBitmapView& res_view,
                                TargetBitmapView& valid_res_view,
-                               auto GetType) {
+                               auto col_type) {
             auto target_field = index->GetShreddingField(pointer, json_type);
             if (!target_field.empty()) {
-                using ColType = decltype(GetType);
-                auto shredding_executor =
-                    [val1, val2, lower_inclusive, upper_inclusive](
-                        const ColType* src,
-                        const bool* valid,
-                        size_t size,
-                        TargetBitmapView res,
-                        TargetBitmapView valid_res) {
-                        for (size_t i = 0; i < size; ++i) {
-                            if (valid != nullptr && !valid[i]) {
-                                res[i] = valid_res[i] = false;
-                                continue;
-                            }
-                            if (lower_inclusive && upper_inclusive) {
-                                res[i] = src[i] >= val1 && src[i] <= val2;
-                            } else if (lower_inclusive && !upper_inclusive) {
-                                res[i] = src[i] >= val1 && src[i] < val2;
-                            } else if (!lower_inclusive && upper_inclusive) {
-                                res[i] = src[i] > val1 && src[i] <= val2;
-                            } else {
-                                res[i] = src[i] > val1 && src[i] < val2;
-                            }
-                        }
+                using ColType = decltype(col_type);
+                BinaryRangeShreddingExecutor<ColType, GetType>
+                    shredding_executor(
+                        val1, val2, lower_inclusive, upper_inclusive);
+                // int64 bounds compare to a double column as doubles, but
+                // double bounds do not truncate against an int64 column
+                std::function<bool(const SkipIndex&, FieldId, int)> skip_func;
+                if constexpr (std::is_same_v<ColType, GetType> ||
+                              std::is_same_v<ColType, double>) {
+                    skip_func = [&, lower_inclusive, upper_inclusive](
+                                    const SkipIndex& skip_index,
+                                    FieldId field_id,
+                                    int chunk_id) {
+                        return skip_index.CanSkipBinaryRange<ColType>(
+                            field_id,
+                            chunk_id,
+                            ColType(val1),
+                            ColType(val2),
+                            lower_inclusive,
+                            upper_inclusive);
                     };
+                }
                 index->ExecutorForShreddingData<ColType>(op_ctx_,
                                                          target_field,
                                                          shredding_executor,
-                                                         nullptr,
+                                                         skip_func,
                                                          res_view,
                                                          valid_res_view);
                 LOG_DEBUG("using shredding data's field: {} count {}",
@@ -785,6 +818,64 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJsonStats() {
                                           TargetBitmap(real_batch_size, true));
 }  // namespace exec
 
+template <typename ValueType>
+VectorPtr
+PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJsonGrowingStats(
+    const index::GrowingJsonKeyStats& stats) {
+    using GetType = std::conditional_t<std::is_same_v<ValueType, std::string>,
+                                       std::string_view,
+                                       ValueType>;
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+    auto pointer = milvus::index::JsonPointer(expr_->column_.nested_path_);
+    bool lower_inclusive = expr_->lower_inclusive_;
+    bool upper_inclusive = expr_->upper_inclusive_;
+    ValueType val1 = GetValueWithCastNumber<ValueType>(expr_->lower_val_);
+    ValueType val2 = GetValueWithCastNumber<ValueType>(expr_->upper_val_);
+    auto offset = current_data_global_pos_;
+
+    auto res_vec =
+        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
+                                       TargetBitmap(real_batch_size, true));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+
+    // a row has a value in one column at most, so the columns are evaluated
+    // apart and OR-ed
+    auto try_execute = [&](milvus::index::JSONType json_type, auto col_type) {
+        if (!stats.HasColumn(pointer, json_type)) {
+            return;
+        }
+        using ColType = decltype(col_type);
+        TargetBitmap col_res(real_batch_size, false);
+        TargetBitmap col_valid(real_batch_size, true);
+        BinaryRangeShreddingExecutor<ColType, ValueType> executor(
+            val1, val2, lower_inclusive, upper_inclusive);
+        stats.ExecutorForShreddingData<ColType>(pointer,
+                                                json_type,
+                                                offset,
+                                                real_batch_size,
+                                                executor,
+                                                TargetBitmapView(col_res),
+                                                TargetBitmapView(col_valid));
+        res.inplace_or(col_res, real_batch_size);
+    };
+
+    if constexpr (std::is_same_v<GetType, int64_t> ||
+                  std::is_same_v<GetType, double>) {
+        try_execute(milvus::index::JSONType::INT64, int64_t{});
+        try_execute(milvus::index::JSONType::DOUBLE, double{});
+    } else if constexpr (std::is_same_v<GetType, std::string_view>) {
+        try_execute(milvus::index::JSONType::STRING, std::string_view{});
+    }
+
+    stats.ApplyRowValid(offset, real_batch_size, res, valid_res);
+    MoveCursor();
+    return res_vec;
+}
+
 template <typename ValueType>
 VectorPtr
 PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForArray(EvalCtx& context) {
@@ -798,9 +889,7 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForArray(EvalCtx& context) {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -71,6 +71,20 @@ struct BinaryRangeElementFunc {
             return;
         }
 
+        // the range runs on the blocks holding undecided rows only, the
+        // data of the others is not read
+        if (ForEachActiveBlock(
+                bitmap_input, start_cursor, n, [&](size_t begin, size_t size) {
+                    WithinRange(val1, val2, src + begin, size, res + begin);
+                })) {
+            return;
+        }
+        WithinRange(val1, val2, src, n, res);
+    }
+
+ private:
+    void
+    WithinRange(T val1, T val2, const T* src, size_t n, TargetBitmapView res) {
         if constexpr (lower_inclusive && upper_inclusive) {
             res.inplace_within_range_val<T, milvus::bitset::RangeType::IncInc>(
                 val1, val2, src, n);
@@ -239,6 +253,74 @@ struct BinaryRangeIndexFunc {
     }
 };
 
+// Evaluates a range over a shredded JSON key column, typed ColType, of the
+// rows with bounds typed GetType, the executor of the json stats paths.
+template <typename ColType, typename GetType>
+class BinaryRangeShreddingExecutor {
+ public:
+    BinaryRangeShreddingExecutor(GetType val1,
+                                 GetType val2,
+                                 bool lower_inclusive,
+                                 bool upper_inclusive)
+        : val1_(val1),
+          val2_(val2),
+          lower_inclusive_(lower_inclusive),
+          upper_inclusive_(upper_inclusive),
+          range_type_(
+              lower_inclusive
+                  ? (upper_inclusive ? milvus::bitset::RangeType::IncInc
+                                     : milvus::bitset::RangeType::IncExc)
+                  : (upper_inclusive ? milvus::bitset::RangeType::ExcInc
+                                     : milvus::bitset::RangeType::ExcExc)) {
+    }
+
+    void
+    operator()(const ColType* src,
+               const bool* valid,
+               size_t size,
+               TargetBitmapView res,
+               TargetBitmapView valid_res) const {
+        // a numeric column compares to bounds of its own type in one SIMD
+        // pass, invalid rows are cleared afterwards
+        if constexpr (std::is_arithmetic_v<ColType> &&
+                      (std::is_same_v<ColType, GetType> ||
+                       std::is_same_v<ColType, double>)) {
+            res.inplace_within_range_val<ColType>(
+                ColType(val1_), ColType(val2_), src, size, range_type_);
+            if (valid != nullptr) {
+                for (size_t i = 0; i < size; ++i) {
+                    if (!valid[i]) {
+                        res[i] = valid_res[i] = false;
+                    }
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            if (valid != nullptr && !valid[i]) {
+                res[i] = valid_res[i] = false;
+                continue;
+            }
+            if (lower_inclusive_ && upper_inclusive_) {
+                res[i] = src[i] >= val1_ && src[i] <= val2_;
+            } else if (lower_inclusive_ && !upper_inclusive_) {
+                res[i] = src[i] >= val1_ && src[i] < val2_;
+            } else if (!lower_inclusive_ && upper_inclusive_) {
+                res[i] = src[i] > val1_ && src[i] <= val2_;
+            } else {
+                res[i] = src[i] > val1_ && src[i] < val2_;
+            }
+        }
+    }
+
+ private:
+    GetType val1_;
+    GetType val2_;
+    bool lower_inclusive_;
+    bool upper_inclusive_;
+    milvus::bitset::RangeType range_type_;
+};
+
 class PhyBinaryRangeFilterExpr : public SegmentExpr {
  public:
     PhyBinaryRangeFilterExpr(
@@ -318,6 +400,11 @@ class PhyBinaryRangeFilterExpr : public SegmentExpr {
     VectorPtr
     ExecRangeVisitorImplForJsonStats();
 
+    template <typename ValueType>
+    VectorPtr
+    ExecRangeVisitorImplForJsonGrowingStats(
+        const index::GrowingJsonKeyStats& stats);
+
     template <typename ValueType>
     VectorPtr
     ExecRangeVisitorImplForArray(EvalCtx& context);
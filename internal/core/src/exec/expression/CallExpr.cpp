@@ -19,6 +19,7 @@
 #include "exec/expression/CallExpr.h"
 #include "exec/expression/EvalCtx.h"
 #include "exec/expression/function/FunctionFactory.h"
+#include "exec/TraceUtils.h"
 
 #include <utility>
 #include <vector>
@@ -28,8 +29,8 @@ namespace exec {
 
 void
 PhyCallExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyCallExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("function_name", expr_->fun_name());
+    tracer::LazyAutoSpan span("PhyCallExpr::Eval", true);
+    span.SetAttribute("function_name", expr_->fun_name());
 
     auto offset_input = context.get_offset_input();
     SetHasOffsetInput(offset_input != nullptr);
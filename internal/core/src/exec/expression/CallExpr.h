@@ -61,6 +61,18 @@ class PhyCallExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetBatchSize(int64_t batch_size) override {
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
+    // functions run per row
+    ExprCostClass
+    GetCostClass() const override {
+        return ExprCostClass::kExpensive;
+    }
+
     void
     MoveCursor() override {
         if (!has_offset_input_) {
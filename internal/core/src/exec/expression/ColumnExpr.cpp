@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "ColumnExpr.h"
+#include "exec/TraceUtils.h"
 
 namespace milvus {
 namespace exec {
@@ -30,8 +31,8 @@ PhyColumnExpr::GetNextBatchSize() {
 
 void
 PhyColumnExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyColumnExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type", static_cast<int>(expr_->type()));
+    tracer::LazyAutoSpan span("PhyColumnExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->type()));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput(input != nullptr);
@@ -66,6 +66,17 @@ class PhyColumnExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetBatchSize(int64_t batch_size) override {
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
+    void
+    GatherDataFields(std::set<FieldId>& fields) const override {
+        fields.insert(expr_->GetColumn().field_id_);
+    }
+
     void
     MoveCursor() override {
         if (!has_offset_input_) {
@@ -16,6 +16,7 @@
 
 #include "CompareExpr.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 #include <optional>
 #include "query/Relational.h"
@@ -48,9 +49,7 @@ PhyCompareFilterExpr::ExecCompareExprDispatcher(OpType op, EvalCtx& context) {
             return nullptr;
         }
 
-        auto res_vec =
-            std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                           TargetBitmap(real_batch_size, true));
+        auto res_vec = context.AllocateBitmapColumn(real_batch_size);
         TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
         TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -215,11 +214,10 @@ PhyCompareFilterExpr::ExecCompareExprDispatcher(OpType op, EvalCtx& context) {
 
 void
 PhyCompareFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyCompareFilterExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("op_type", static_cast<int>(expr_->op_type_));
-    span.GetSpan()->SetAttribute("left_indexed", is_left_indexed_);
-    span.GetSpan()->SetAttribute("right_indexed", is_right_indexed_);
+    tracer::LazyAutoSpan span("PhyCompareFilterExpr::Eval", true);
+    span.SetAttribute("op_type", static_cast<int>(expr_->op_type_));
+    span.SetAttribute("left_indexed", is_left_indexed_);
+    span.SetAttribute("right_indexed", is_right_indexed_);
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
@@ -329,9 +327,7 @@ PhyCompareFilterExpr::ExecCompareRightType(EvalCtx& context) {
     }
 
     const auto& bitmap_input = context.get_bitmap_input();
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <fmt/core.h>
 #include <boost/variant.hpp>
 
@@ -186,6 +188,18 @@ class PhyCompareFilterExpr : public Expr {
                   : pos + batch_size_;
     }
 
+    void
+    SetBatchSize(int64_t batch_size) override {
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
+    void
+    GatherDataFields(std::set<FieldId>& fields) const override {
+        fields.insert(left_field_);
+        fields.insert(right_field_);
+    }
+
     void
     MoveCursor() override {
         if (!has_offset_input_) {
@@ -445,78 +459,88 @@ class PhyCompareFilterExpr : public Expr {
         return processed_size;
     }
 
+    // Fields in different column groups need not share chunk boundaries,
+    // so the rows are walked in windows that end wherever either column's
+    // chunk ends. Each window is contiguous in both columns and is compared
+    // by one vectorized call.
     template <typename T, typename U, typename FUNC, typename... ValTypes>
     int64_t
     ProcessBothDataChunksForMultipleChunk(FUNC func,
                                           TargetBitmapView res,
                                           TargetBitmapView valid_res,
                                           const ValTypes&... values) {
-        int64_t processed_size = 0;
-
-        // only call this function when left and right are not indexed, so they have the same number of chunks
-        for (size_t i = left_current_chunk_id_; i < left_num_chunk_; i++) {
-            auto pw_left = segment_chunk_reader_.segment_->chunk_data<T>(
-                op_ctx_, left_field_, i);
-            auto left_chunk = pw_left.get();
-            auto pw_right = segment_chunk_reader_.segment_->chunk_data<U>(
-                op_ctx_, right_field_, i);
-            auto right_chunk = pw_right.get();
-            auto data_pos =
-                (i == left_current_chunk_id_) ? left_current_chunk_pos_ : 0;
-            auto size = 0;
-            if (segment_chunk_reader_.segment_->type() ==
-                SegmentType::Growing) {
-                size =
-                    (i == (left_num_chunk_ - 1))
-                        ? (segment_chunk_reader_.active_count_ %
-                                       segment_chunk_reader_.SizePerChunk() ==
-                                   0
-                               ? segment_chunk_reader_.SizePerChunk() - data_pos
-                               : segment_chunk_reader_.active_count_ %
-                                         segment_chunk_reader_.SizePerChunk() -
-                                     data_pos)
-                        : segment_chunk_reader_.SizePerChunk() - data_pos;
-            } else {
-                size =
-                    segment_chunk_reader_.segment_->chunk_size(left_field_, i) -
-                    data_pos;
+        auto segment = segment_chunk_reader_.segment_;
+        auto chunk_rows = [&](FieldId field, int64_t chunk_id) -> int64_t {
+            if (segment->type() == SegmentType::Growing) {
+                auto size_per_chunk = segment_chunk_reader_.SizePerChunk();
+                return std::min(size_per_chunk,
+                                segment_chunk_reader_.active_count_ -
+                                    chunk_id * size_per_chunk);
             }
+            return segment->chunk_size(field, chunk_id);
+        };
 
-            if (processed_size + size >= batch_size_) {
-                size = batch_size_ - processed_size;
+        // only call this function when left and right are not indexed
+        const auto batch_rows = GetNextBatchSize();
+        int64_t processed_size = 0;
+        int64_t left_chunk_id = left_current_chunk_id_;
+        int64_t left_pos = left_current_chunk_pos_;
+        int64_t right_chunk_id = right_current_chunk_id_;
+        int64_t right_pos = right_current_chunk_pos_;
+        while (processed_size < batch_rows) {
+            auto left_rows = chunk_rows(left_field_, left_chunk_id);
+            if (left_pos >= left_rows) {
+                ++left_chunk_id;
+                left_pos = 0;
+                continue;
             }
+            auto right_rows = chunk_rows(right_field_, right_chunk_id);
+            if (right_pos >= right_rows) {
+                ++right_chunk_id;
+                right_pos = 0;
+                continue;
+            }
+            int64_t size = std::min({left_rows - left_pos,
+                                     right_rows - right_pos,
+                                     batch_rows - processed_size});
 
-            const T* left_data = left_chunk.data() + data_pos;
-            const U* right_data = right_chunk.data() + data_pos;
-            func(left_data,
-                 right_data,
+            auto pw_left =
+                segment->chunk_data<T>(op_ctx_, left_field_, left_chunk_id);
+            auto left_chunk = pw_left.get();
+            auto pw_right =
+                segment->chunk_data<U>(op_ctx_, right_field_, right_chunk_id);
+            auto right_chunk = pw_right.get();
+            func(left_chunk.data() + left_pos,
+                 right_chunk.data() + right_pos,
                  nullptr,
                  size,
                  res + processed_size,
                  values...);
+            // mask with valid_data
             const bool* left_valid_data = left_chunk.valid_data();
             const bool* right_valid_data = right_chunk.valid_data();
-            // mask with valid_data
-            for (int i = 0; i < size; ++i) {
-                if (left_valid_data && !left_valid_data[i + data_pos]) {
-                    res[processed_size + i] = false;
-                    valid_res[processed_size + i] = false;
-                    continue;
-                }
-                if (right_valid_data && !right_valid_data[i + data_pos]) {
-                    res[processed_size + i] = false;
-                    valid_res[processed_size + i] = false;
+            if (left_valid_data != nullptr || right_valid_data != nullptr) {
+                for (int64_t i = 0; i < size; ++i) {
+                    bool valid =
+                        (left_valid_data == nullptr ||
+                         left_valid_data[left_pos + i]) &&
+                        (right_valid_data == nullptr ||
+                         right_valid_data[right_pos + i]);
+                    if (!valid) {
+                        res[processed_size + i] = false;
+                        valid_res[processed_size + i] = false;
+                    }
                 }
             }
             processed_size += size;
-
-            if (processed_size >= batch_size_) {
-                left_current_chunk_id_ = i;
-                left_current_chunk_pos_ = data_pos + size;
-                break;
-            }
+            left_pos += size;
+            right_pos += size;
         }
 
+        left_current_chunk_id_ = left_chunk_id;
+        left_current_chunk_pos_ = left_pos;
+        right_current_chunk_id_ = right_chunk_id;
+        right_current_chunk_pos_ = right_pos;
         return processed_size;
     }
 
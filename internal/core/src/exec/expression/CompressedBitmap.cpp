@@ -0,0 +1,204 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/expression/CompressedBitmap.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+// a roaring run costs 4 bytes, stop collecting runs once the encoded
+// size is expected to reach half of the dense size
+constexpr size_t kBytesPerRun = 4;
+
+}  // namespace
+
+std::shared_ptr<const CompressedBitmap>
+CompressedBitmap::Encode(const std::shared_ptr<TargetBitmap>& bitmap) {
+    AssertInfo(bitmap != nullptr, "bitmap to compress is null");
+    auto res = std::shared_ptr<CompressedBitmap>(new CompressedBitmap());
+    res->size_ = bitmap->size();
+    AssertInfo(res->size_ <= std::numeric_limits<uint32_t>::max(),
+               "bitmap size {} exceeds roaring range",
+               res->size_);
+
+    auto dense_bytes = (res->size_ + 7) / 8;
+    auto ones = bitmap->count();
+    auto inverted = ones * 2 > res->size_;
+    auto max_runs = dense_bytes / 2 / kBytesPerRun;
+
+    // walk the runs of the minority bits, each step is a word-wise scan
+    roaring::Roaring runs;
+    size_t num_runs = 0;
+    bool compressible = true;
+    auto begin = bitmap->find_first(!inverted);
+    while (begin.has_value()) {
+        if (++num_runs > max_runs) {
+            compressible = false;
+            break;
+        }
+        auto end = bitmap->find_next(*begin, inverted);
+        auto end_pos = end.has_value() ? *end : res->size_;
+        runs.addRange(*begin, end_pos);
+        if (!end.has_value()) {
+            break;
+        }
+        begin = bitmap->find_next(*end, !inverted);
+    }
+
+    if (compressible) {
+        runs.runOptimize();
+        runs.shrinkToFit();
+        if (runs.getSizeInBytes() < dense_bytes) {
+            res->encoding_ = Encoding::kRoaring;
+            res->roaring_ = std::move(runs);
+            res->inverted_ = inverted;
+            return res;
+        }
+    }
+
+    res->encoding_ = Encoding::kDense;
+    res->dense_ = bitmap;
+    return res;
+}
+
+size_t
+CompressedBitmap::bytes() const {
+    if (encoding_ == Encoding::kDense) {
+        return (size_ + 7) / 8;
+    }
+    return roaring_.getSizeInBytes();
+}
+
+template <typename Func>
+void
+CompressedBitmap::ForEachRun(size_t offset, size_t len, Func&& func) const {
+    auto limit = offset + len;
+    auto it = roaring_.begin();
+    it.equalorlarger(static_cast<uint32_t>(offset));
+    auto end = roaring_.end();
+    while (it != end && *it < limit) {
+        size_t run_begin = *it;
+        size_t run_end = run_begin + 1;
+        // gallop to the end of the run, then narrow it down, each probe is
+        // a binary search in a run or array container and a word-wise scan
+        // in a bitset one, so a run costs O(log length) probes
+        size_t step = 1;
+        while (run_end < limit &&
+               roaring_.containsRange(run_end,
+                                      std::min(run_end + step, limit))) {
+            run_end = std::min(run_end + step, limit);
+            step *= 2;
+        }
+        for (step /= 2; step > 0 && run_end < limit; step /= 2) {
+            auto probe_end = std::min(run_end + step, limit);
+            if (roaring_.containsRange(run_end, probe_end)) {
+                run_end = probe_end;
+            }
+        }
+        func(run_begin, run_end);
+        if (run_end >= limit) {
+            break;
+        }
+        // run_end is clear, skip to the first stored value after it
+        it.equalorlarger(static_cast<uint32_t>(run_end));
+    }
+}
+
+std::shared_ptr<TargetBitmap>
+CompressedBitmap::Decode() const {
+    if (encoding_ == Encoding::kDense) {
+        return dense_;
+    }
+    auto res = std::make_shared<TargetBitmap>(size_);
+    DecodeInto(TargetBitmapView(*res), 0);
+    return res;
+}
+
+void
+CompressedBitmap::DecodeInto(TargetBitmapView out, size_t offset) const {
+    AssertInfo(offset + out.size() <= size_,
+               "decode range [{}, {}) exceeds bitmap size {}",
+               offset,
+               offset + out.size(),
+               size_);
+    if (encoding_ == Encoding::kDense) {
+        TargetBitmapView src(dense_->data(), offset, out.size());
+        out.reset();
+        out.inplace_or(src, out.size());
+        return;
+    }
+    if (inverted_) {
+        out.set();
+    } else {
+        out.reset();
+    }
+    ForEachRun(offset, out.size(), [&](size_t begin, size_t end) {
+        out.set(begin - offset, end - begin, !inverted_);
+    });
+}
+
+void
+CompressedBitmap::AndInto(TargetBitmapView out, size_t offset) const {
+    AssertInfo(offset + out.size() <= size_,
+               "and range [{}, {}) exceeds bitmap size {}",
+               offset,
+               offset + out.size(),
+               size_);
+    if (encoding_ == Encoding::kDense) {
+        TargetBitmapView src(dense_->data(), offset, out.size());
+        out.inplace_and(src, out.size());
+        return;
+    }
+    if (inverted_) {
+        // only the stored clear bits can reset bits of out
+        ForEachRun(offset, out.size(), [&](size_t begin, size_t end) {
+            out.reset(begin - offset, end - begin);
+        });
+        return;
+    }
+    // reset the gaps between the stored set bits
+    size_t cursor = offset;
+    ForEachRun(offset, out.size(), [&](size_t begin, size_t end) {
+        if (begin > cursor) {
+            out.reset(cursor - offset, begin - cursor);
+        }
+        cursor = end;
+    });
+    if (cursor < offset + out.size()) {
+        out.reset(cursor - offset, offset + out.size() - cursor);
+    }
+}
+
+void
+CompressedBitmap::AppendTo(TargetBitmap& out, size_t offset, size_t len) const {
+    if (encoding_ == Encoding::kDense) {
+        out.append(*dense_, offset, len);
+        return;
+    }
+    TargetBitmap slice(len);
+    DecodeInto(TargetBitmapView(slice), offset);
+    out.append(slice);
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,100 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <roaring/roaring.hh>
+
+#include "common/Types.h"
+
+namespace milvus {
+namespace exec {
+
+// Immutable bitmap with an encoding picked from its content, used to keep
+// cached expression results small.
+//
+// kDense keeps the original bitset. kRoaring keeps the runs of set bits in a
+// run-optimized roaring bitmap, which covers both sparse results (array
+// containers) and clustered results (run containers). When most bits are
+// set the clear bits are stored instead and `inverted_` is true.
+class CompressedBitmap {
+ public:
+    enum class Encoding : uint8_t {
+        kDense = 0,
+        kRoaring = 1,
+    };
+
+    // Pick the cheapest encoding for bitmap. The dense encoding shares the
+    // given bitmap instead of copying it.
+    static std::shared_ptr<const CompressedBitmap>
+    Encode(const std::shared_ptr<TargetBitmap>& bitmap);
+
+    Encoding
+    encoding() const {
+        return encoding_;
+    }
+
+    // number of bits
+    size_t
+    size() const {
+        return size_;
+    }
+
+    // approximate memory used by the encoded bits
+    size_t
+    bytes() const;
+
+    // Materialize the whole bitmap, the dense encoding returns the shared
+    // bitset without decoding.
+    std::shared_ptr<TargetBitmap>
+    Decode() const;
+
+    // out = bits[offset, offset + out.size())
+    void
+    DecodeInto(TargetBitmapView out, size_t offset = 0) const;
+
+    // out &= bits[offset, offset + out.size())
+    void
+    AndInto(TargetBitmapView out, size_t offset = 0) const;
+
+    // append bits[offset, offset + len) to out
+    void
+    AppendTo(TargetBitmap& out, size_t offset, size_t len) const;
+
+ private:
+    CompressedBitmap() = default;
+
+    // call func(begin, end) for every run [begin, end) of stored values
+    // intersecting [offset, offset + len), clipped to that range. A run is
+    // found by range probes, not by visiting each of its values.
+    template <typename Func>
+    void
+    ForEachRun(size_t offset, size_t len, Func&& func) const;
+
+ private:
+    Encoding encoding_{Encoding::kDense};
+    size_t size_{0};
+    std::shared_ptr<TargetBitmap> dense_;
+    roaring::Roaring roaring_;
+    bool inverted_{false};
+};
+
+}  // namespace exec
+}  // namespace milvus
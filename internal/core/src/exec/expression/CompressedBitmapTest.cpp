@@ -0,0 +1,146 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <utility>
+
+#include "exec/expression/CompressedBitmap.h"
+
+using milvus::TargetBitmap;
+using milvus::TargetBitmapView;
+using milvus::exec::CompressedBitmap;
+
+namespace {
+
+enum class Shape { Sparse, AlmostFull, Clustered, Random, Empty };
+
+std::shared_ptr<TargetBitmap>
+MakeBitmap(Shape shape, size_t n) {
+    std::mt19937 rng(42);
+    auto bitmap = std::make_shared<TargetBitmap>(n);
+    for (size_t i = 0; i < n; ++i) {
+        bool v = false;
+        switch (shape) {
+            case Shape::Sparse:
+                v = rng() % 1000 == 0;
+                break;
+            case Shape::AlmostFull:
+                v = rng() % 1000 != 0;
+                break;
+            case Shape::Clustered:
+                v = (i / 4096) % 2 == 0;
+                break;
+            case Shape::Random:
+                v = rng() % 2 == 0;
+                break;
+            case Shape::Empty:
+                break;
+        }
+        bitmap->set(i, v);
+    }
+    return bitmap;
+}
+
+}  // namespace
+
+class CompressedBitmapTest : public ::testing::TestWithParam<Shape> {};
+
+TEST_P(CompressedBitmapTest, DecodeAndIntersect) {
+    const size_t N = 100003;
+    auto bitmap = MakeBitmap(GetParam(), N);
+    auto compressed = CompressedBitmap::Encode(bitmap);
+    ASSERT_EQ(compressed->size(), N);
+    ASSERT_LE(compressed->bytes(), bitmap->size_in_bytes());
+    if (GetParam() == Shape::Random) {
+        ASSERT_EQ(compressed->encoding(), CompressedBitmap::Encoding::kDense);
+    }
+    if (GetParam() == Shape::Sparse || GetParam() == Shape::AlmostFull ||
+        GetParam() == Shape::Empty) {
+        ASSERT_EQ(compressed->encoding(), CompressedBitmap::Encoding::kRoaring);
+    }
+
+    auto decoded = compressed->Decode();
+    ASSERT_EQ(decoded->size(), N);
+    for (size_t i = 0; i < N; ++i) {
+        ASSERT_EQ((*decoded)[i], (*bitmap)[i]) << i;
+    }
+
+    for (size_t offset : {size_t(0), size_t(7), size_t(4099)}) {
+        auto len = N - offset - 3;
+
+        TargetBitmap anded(len);
+        anded.set();
+        compressed->AndInto(TargetBitmapView(anded), offset);
+
+        TargetBitmap appended;
+        appended.append(*bitmap, 0, 5);
+        compressed->AppendTo(appended, offset, len);
+        ASSERT_EQ(appended.size(), len + 5);
+
+        for (size_t i = 0; i < len; ++i) {
+            ASSERT_EQ(anded[i], (*bitmap)[offset + i]) << offset << " " << i;
+            ASSERT_EQ(appended[i + 5], (*bitmap)[offset + i])
+                << offset << " " << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(CompressedBitmapShapes,
+                         CompressedBitmapTest,
+                         ::testing::Values(Shape::Sparse,
+                                           Shape::AlmostFull,
+                                           Shape::Clustered,
+                                           Shape::Random,
+                                           Shape::Empty));
+
+TEST(CompressedBitmapRunsTest, LongRunsAcrossContainers) {
+    // roaring splits values in containers of 65536, the runs below cross
+    // their bounds and are clipped by the decoded ranges
+    const size_t N = 300000;
+    for (bool mostly_set : {false, true}) {
+        auto bitmap = std::make_shared<TargetBitmap>(N);
+        for (size_t i = 0; i < N; ++i) {
+            bool in_run = (i >= 60000 && i < 140000) || i == 150000 ||
+                          (i >= 196000 && i < 262200);
+            bitmap->set(i, in_run != mostly_set);
+        }
+        auto compressed = CompressedBitmap::Encode(bitmap);
+        ASSERT_EQ(compressed->encoding(), CompressedBitmap::Encoding::kRoaring);
+
+        auto decoded = compressed->Decode();
+        for (size_t i = 0; i < N; ++i) {
+            ASSERT_EQ((*decoded)[i], (*bitmap)[i]) << i;
+        }
+        for (auto [offset, len] : {std::pair<size_t, size_t>{100000, 40000},
+                                   {65536, 131072},
+                                   {139999, 10002},
+                                   {200000, 100000}}) {
+            TargetBitmap anded(len);
+            anded.set();
+            compressed->AndInto(TargetBitmapView(anded), offset);
+            TargetBitmap slice(len);
+            compressed->DecodeInto(TargetBitmapView(slice), offset);
+            for (size_t i = 0; i < len; ++i) {
+                ASSERT_EQ(anded[i], (*bitmap)[offset + i])
+                    << offset << " " << i;
+                ASSERT_EQ(slice[i], (*bitmap)[offset + i])
+                    << offset << " " << i;
+            }
+        }
+    }
+}
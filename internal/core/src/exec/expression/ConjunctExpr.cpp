@@ -15,10 +15,16 @@
 // limitations under the License.
 
 #include "ConjunctExpr.h"
+#include "exec/TraceUtils.h"
+#include "BinaryRangeExpr.h"
+#include "JsonContainsExpr.h"
+#include "TermExpr.h"
 #include "UnaryExpr.h"
 #include "LikeConjunctExpr.h"
 
 #include <algorithm>
+#include <chrono>
+
 #include "common/ValueOp.h"
 
 namespace milvus {
@@ -83,11 +89,112 @@ PhyConjunctFilterExpr::SkipFollowingExprs(int start) {
     }
 }
 
+SegmentExpr*
+PhyConjunctFilterExpr::SparseInput(size_t idx, EvalCtx& context) {
+    const auto& input = inputs_[idx];
+    if (!std::dynamic_pointer_cast<PhyUnaryRangeFilterExpr>(input) &&
+        !std::dynamic_pointer_cast<PhyTermFilterExpr>(input) &&
+        !std::dynamic_pointer_cast<PhyBinaryRangeFilterExpr>(input) &&
+        !std::dynamic_pointer_cast<PhyJsonContainsFilterExpr>(input)) {
+        return nullptr;
+    }
+    auto* segment_input = static_cast<SegmentExpr*>(input.get());
+    // an index answers a whole batch at once, the offsets path would read
+    // the raw data instead
+    if (!segment_input->SupportOffsetInput() || segment_input->CanUseIndex()) {
+        return nullptr;
+    }
+    auto* query_context = context.get_exec_context()->get_query_context();
+    if (query_context != nullptr && query_context->element_level_query()) {
+        return nullptr;
+    }
+    const auto& rows = context.get_bitmap_input();
+    if (rows.empty() ||
+        static_cast<int64_t>(rows.count()) * kSparseRowsRatio >
+            static_cast<int64_t>(rows.size())) {
+        return nullptr;
+    }
+    return segment_input;
+}
+
+VectorPtr
+PhyConjunctFilterExpr::EvalOnActiveRows(SegmentExpr* input,
+                                        EvalCtx& context,
+                                        size_t size) {
+    // the cursor of an input not evaluated yet is at the batch start
+    const auto batch_start = input->GetCurrentRows();
+    const auto& rows = context.get_bitmap_input();
+    OffsetVector offsets;
+    offsets.reserve(rows.count());
+    for (auto row = rows.find_first(); row.has_value();
+         row = rows.find_next(row.value())) {
+        offsets.push_back(static_cast<int32_t>(batch_start + row.value()));
+    }
+
+    context.clear_bitmap_input();
+    context.set_offset_input(&offsets);
+    VectorPtr sparse_result;
+    input->Eval(context, sparse_result);
+    context.set_offset_input(nullptr);
+    input->SetHasOffsetInput(false);
+    input->MoveCursor();
+
+    auto sparse_vec = GetColumnVector(sparse_result);
+    AssertInfo(sparse_vec->size() == offsets.size(),
+               "result size {} of an offsets input does not match {} offsets",
+               sparse_vec->size(),
+               offsets.size());
+    TargetBitmapView sparse_data(sparse_vec->GetRawData(), offsets.size());
+    TargetBitmapView sparse_valid(sparse_vec->GetValidRawData(),
+                                  offsets.size());
+    // true AND x and false OR x are x
+    auto result = context.AllocateBitmapColumn(size, is_and_);
+    TargetBitmapView data(result->GetRawData(), size);
+    TargetBitmapView valid(result->GetValidRawData(), size);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        auto row = offsets[i] - batch_start;
+        data[row] = sparse_data[i];
+        valid[row] = sparse_valid[i];
+    }
+    return result;
+}
+
+int64_t
+PhyConjunctFilterExpr::ActiveRows(const ColumnVectorPtr& vec) const {
+    TargetBitmapView data(vec->GetRawData(), vec->size());
+    auto true_rows = static_cast<int64_t>(data.count());
+    return is_and_ ? true_rows : static_cast<int64_t>(vec->size()) - true_rows;
+}
+
+void
+PhyConjunctFilterExpr::AdaptInputOrder() {
+    // cost per decided row, the +1 keeps an input deciding nothing last
+    auto score = [this](size_t idx) {
+        const auto& stats = input_stats_[idx];
+        return static_cast<double>(stats.nanos_) / (stats.decided_rows_ + 1);
+    };
+    auto unmeasured =
+        std::stable_partition(input_order_.begin(),
+                              input_order_.end(),
+                              [this](size_t idx) {
+                                  return input_stats_[idx].evals_ > 0;
+                              });
+    std::stable_sort(input_order_.begin(),
+                     unmeasured,
+                     [&score](size_t a, size_t b) {
+                         return score(a) < score(b);
+                     });
+    // the older batches weigh less, the data changes between chunks
+    for (auto& stats : input_stats_) {
+        stats.nanos_ /= 2;
+        stats.decided_rows_ /= 2;
+    }
+}
+
 void
 PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyConjunctFilterExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("is_and", is_and_);
+    tracer::LazyAutoSpan span("PhyConjunctFilterExpr::Eval", true);
+    span.SetAttribute("is_and", is_and_);
 
     if (input_order_.empty()) {
         input_order_.resize(inputs_.size());
@@ -115,11 +222,19 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         // Create PhyLikeConjunctExpr and add to inputs_ if we have >= 2 eligible
         if (ngram_exprs.size() >= 2) {
             auto active_count = ngram_exprs[0]->GetActiveCount();
-            auto like_conjunct = std::make_shared<PhyLikeConjunctExpr>(
-                std::move(ngram_exprs),
-                op_ctx_,
-                active_count,
-                context.get_query_config()->get_expr_batch_size());
+            // the conjunct may have moved past some batches already, the
+            // cursors of its inputs tell how far
+            auto start_pos = ngram_exprs[0]->GetCurrentRows();
+            auto batch_size =
+                batch_size_ > 0
+                    ? batch_size_
+                    : context.get_query_config()->get_expr_batch_size();
+            auto like_conjunct =
+                std::make_shared<PhyLikeConjunctExpr>(std::move(ngram_exprs),
+                                                      op_ctx_,
+                                                      active_count,
+                                                      batch_size,
+                                                      start_pos);
             inputs_.push_back(like_conjunct);
         } else {
             batch_ngram_indices_.clear();
@@ -136,7 +251,13 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
     }
 
+    input_stats_.resize(inputs_.size());
+    if (++num_batches_ % kAdaptInterval == 0) {
+        AdaptInputOrder();
+    }
+
     bool has_result = false;
+    int64_t active_rows = 0;
     for (size_t i = 0; i < input_order_.size(); ++i) {
         size_t idx = input_order_[i];
 
@@ -146,12 +267,28 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
 
         VectorPtr input_result;
-        inputs_[idx]->Eval(context, input_result);
+        const auto start = std::chrono::steady_clock::now();
+        auto* sparse_input = has_result && !has_input_offset
+                                 ? SparseInput(idx, context)
+                                 : nullptr;
+        if (sparse_input != nullptr) {
+            input_result = EvalOnActiveRows(
+                sparse_input, context, GetColumnVector(result)->size());
+        } else {
+            inputs_[idx]->Eval(context, input_result);
+        }
+        auto& stats = input_stats_[idx];
+        stats.evals_++;
+        stats.nanos_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
 
         if (!has_result) {
             result = input_result;
             has_result = true;
             auto all_flat_result = GetColumnVector(result);
+            active_rows = ActiveRows(all_flat_result);
+            stats.decided_rows_ += all_flat_result->size() - active_rows;
             if (CanSkipFollowingExprs(all_flat_result)) {
                 SkipFollowingExprs(i + 1);
                 ClearBitmapInput(context);
@@ -162,8 +299,10 @@ PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
         auto input_flat_result = GetColumnVector(input_result);
         auto all_flat_result = GetColumnVector(result);
-        auto active_rows =
+        auto rows_left =
             UpdateResult(input_flat_result, context, all_flat_result);
+        stats.decided_rows_ += active_rows - rows_left;
+        active_rows = rows_left;
         if (active_rows == 0) {
             SkipFollowingExprs(i + 1);
             ClearBitmapInput(context);
@@ -18,6 +18,7 @@
 
 #include <fmt/core.h>
 #include <set>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "common/OpContext.h"
@@ -79,6 +80,13 @@ class PhyConjunctFilterExpr : public Expr {
         }
     }
 
+    void
+    SetBatchSize(int64_t batch_size) override {
+        // kept for the like conjunct created on the first batch
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
     std::string
     ToString() const {
         if (!input_order_.empty()) {
@@ -213,6 +221,48 @@ class PhyConjunctFilterExpr : public Expr {
 
     void
     SkipFollowingExprs(int start);
+
+    // The input at idx as a SegmentExpr when it is better evaluated on the
+    // undecided rows alone, by their offsets: a few rows are left in the
+    // bitmap input and the input scans raw data, which it reads by offset
+    // as well as by batch.
+    SegmentExpr*
+    SparseInput(size_t idx, EvalCtx& context);
+
+    // Evaluates input on the rows set in the bitmap input of context only
+    // and spreads the result over the batch of size rows. The other rows
+    // take the value that leaves the conjunction as it is. The cursors of
+    // input move past the batch like after a dense Eval.
+    VectorPtr
+    EvalOnActiveRows(SegmentExpr* input, EvalCtx& context, size_t size);
+
+    // rows of vec whose result the following inputs may still change, true
+    // rows of an AND and false rows of an OR
+    int64_t
+    ActiveRows(const ColumnVectorPtr& vec) const;
+
+    // Re-sorts input_order_ by the measured cost per row an input decided,
+    // so the cheap and selective inputs run first and the others only see
+    // the rows those left undecided. Inputs never reached keep their
+    // compiled order after the measured ones.
+    void
+    AdaptInputOrder();
+
+    // what evaluating an input cost over the batches since the last adapt
+    struct InputStats {
+        int64_t evals_{0};
+        int64_t nanos_{0};
+        // rows the input took out of the active rows
+        int64_t decided_rows_{0};
+    };
+
+    // Batches between two AdaptInputOrder() calls.
+    static constexpr int64_t kAdaptInterval = 8;
+
+    // An input sees the undecided rows by offset once they are at most
+    // one in this many rows of the batch.
+    static constexpr int64_t kSparseRowsRatio = 64;
+
     // true if conjunction (and), false if disjunction (or).
     bool is_and_;
     std::vector<size_t> input_order_;
@@ -222,6 +272,11 @@ class PhyConjunctFilterExpr : public Expr {
     bool like_batch_initialized_{false};
     // Indices of expressions executed via batch ngram (to skip in normal iteration)
     std::set<size_t> batch_ngram_indices_;
+    // Batch size set with SetBatchSize(), 0 for the configured one
+    int64_t batch_size_{0};
+    // indexed like inputs_
+    std::vector<InputStats> input_stats_;
+    int64_t num_batches_{0};
 };
 }  //namespace exec
 }  // namespace milvus
@@ -73,6 +73,19 @@ class EvalCtx {
         bitmap_input_.clear();
     }
 
+    // a bitmap result column for a batch of size rows, recycled from the
+    // earlier batches of the query when there is one
+    ColumnVectorPtr
+    AllocateBitmapColumn(size_t size, bool value = false, bool valid = true) {
+        if (exec_ctx_ != nullptr && exec_ctx_->get_query_context() != nullptr) {
+            return exec_ctx_->get_query_context()
+                ->bitmap_column_pool()
+                .Acquire(size, value, valid);
+        }
+        return std::make_shared<ColumnVector>(TargetBitmap(size, value),
+                                              TargetBitmap(size, valid));
+    }
+
  private:
     ExecContext* exec_ctx_ = nullptr;
     // we may accept offsets array as input and do expr filtering on these data
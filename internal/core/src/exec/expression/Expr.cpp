@@ -18,6 +18,7 @@
 
 #include "common/EasyAssert.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "exec/expression/AlwaysTrueExpr.h"
 #include "exec/expression/BinaryArithOpEvalRangeExpr.h"
 #include "exec/expression/BinaryRangeExpr.h"
@@ -41,7 +42,13 @@
 #include "monitor/Monitor.h"
 #include "segcore/Utils.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace milvus {
 namespace exec {
 
@@ -51,7 +58,7 @@ ExprSet::Eval(int32_t begin,
               bool initialize,
               EvalCtx& context,
               std::vector<VectorPtr>& results) {
-    tracer::AutoSpan span("ExprSet::Eval", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("ExprSet::Eval", true);
 
     results.resize(exprs_.size());
     auto* exec_ctx = context.get_exec_context();
@@ -184,39 +191,437 @@ FlattenInput(const expr::TypedExprPtr& input,
     }
 }
 
+// A key equal for filters that select the same rows, when the whole filter
+// is made of exprs whose ToString() spells out every operand.
+static std::optional<std::string>
+FilterKey(const expr::TypedExprPtr& expr) {
+    if (std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(expr) ||
+        std::dynamic_pointer_cast<const expr::BinaryRangeFilterExpr>(expr) ||
+        std::dynamic_pointer_cast<const expr::TermFilterExpr>(expr) ||
+        std::dynamic_pointer_cast<const expr::NullExpr>(expr)) {
+        return expr->ToString();
+    }
+    if (std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(expr) ||
+        std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(expr)) {
+        for (auto& input : expr->inputs()) {
+            if (!FilterKey(input).has_value()) {
+                return std::nullopt;
+            }
+        }
+        return expr->ToString();
+    }
+    return std::nullopt;
+}
+
+// Plain scalar columns, where a range or a set of values means the same
+// whichever filter expr holds it.
+static bool
+IsRewritableColumn(const expr::ColumnInfo& column) {
+    if (!column.nested_path_.empty() || column.element_level_) {
+        return false;
+    }
+    return (IsNumericDataType(column.data_type_) &&
+            column.data_type_ != DataType::BOOL) ||
+           column.data_type_ == DataType::VARCHAR ||
+           column.data_type_ == DataType::STRING;
+}
+
+// `a > x and a < y` becomes `x < a < y`: the inputs of an and holding a
+// lower and an upper bound of one column are replaced by a single binary
+// range at the place of the first of them.
+static void
+MergeRangeInputs(std::vector<expr::TypedExprPtr>& flat) {
+    // the bound of each column waiting for its counterpart, by position
+    std::unordered_map<std::string, size_t> lowers;
+    std::unordered_map<std::string, size_t> uppers;
+    for (size_t i = 0; i < flat.size(); ++i) {
+        auto unary =
+            std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                flat[i]);
+        if (unary == nullptr || !unary->extra_values_.empty() ||
+            !IsRewritableColumn(unary->column_)) {
+            continue;
+        }
+        auto op = unary->op_type_;
+        auto is_lower = op == proto::plan::OpType::GreaterThan ||
+                        op == proto::plan::OpType::GreaterEqual;
+        auto is_upper = op == proto::plan::OpType::LessThan ||
+                        op == proto::plan::OpType::LessEqual;
+        if (!is_lower && !is_upper) {
+            continue;
+        }
+        auto key = unary->column_.ToString();
+        auto& waiting = is_lower ? uppers : lowers;
+        auto iter = waiting.find(key);
+        if (iter == waiting.end()) {
+            (is_lower ? lowers : uppers).emplace(key, i);
+            continue;
+        }
+        auto other =
+            std::static_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                flat[iter->second]);
+        if (other->val_.val_case() != unary->val_.val_case()) {
+            continue;
+        }
+        auto lower = is_lower ? unary : other;
+        auto upper = is_lower ? other : unary;
+        flat[iter->second] = std::make_shared<expr::BinaryRangeFilterExpr>(
+            unary->column_,
+            lower->val_,
+            upper->val_,
+            lower->op_type_ == proto::plan::OpType::GreaterEqual,
+            upper->op_type_ == proto::plan::OpType::LessEqual);
+        flat[i] = nullptr;
+        waiting.erase(iter);
+    }
+}
+
+// `a == x or a in [y, z]` becomes `a in [x, y, z]`: the equalities and
+// terms of an or on one column are merged into the first of them.
+static void
+MergeTermInputs(std::vector<expr::TypedExprPtr>& flat) {
+    struct Term {
+        size_t position_;
+        expr::ColumnInfo column_;
+        std::vector<proto::plan::GenericValue> vals_;
+        std::unordered_set<std::string> seen_;
+        size_t merged_{1};
+    };
+    std::unordered_map<std::string, Term> terms;
+    for (size_t i = 0; i < flat.size(); ++i) {
+        const expr::ColumnInfo* column = nullptr;
+        std::vector<proto::plan::GenericValue> vals;
+        if (auto unary =
+                std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                    flat[i])) {
+            if (unary->op_type_ != proto::plan::OpType::Equal ||
+                !unary->extra_values_.empty()) {
+                continue;
+            }
+            column = &unary->column_;
+            vals.push_back(unary->val_);
+        } else if (auto term =
+                       std::dynamic_pointer_cast<const expr::TermFilterExpr>(
+                           flat[i])) {
+            if (term->is_in_field_ || term->vals_.empty()) {
+                continue;
+            }
+            column = &term->column_;
+            vals = term->vals_;
+        } else {
+            continue;
+        }
+        if (!IsRewritableColumn(*column)) {
+            continue;
+        }
+        auto val_case = vals[0].val_case();
+        if (std::any_of(vals.begin(), vals.end(), [&](const auto& val) {
+                return val.val_case() != val_case;
+            })) {
+            continue;
+        }
+        auto key = column->ToString();
+        auto iter = terms.find(key);
+        if (iter == terms.end()) {
+            iter = terms.emplace(key, Term{i, *column}).first;
+        } else if (iter->second.vals_[0].val_case() != val_case) {
+            continue;
+        } else {
+            iter->second.merged_++;
+            flat[i] = nullptr;
+        }
+        auto& merged = iter->second;
+        for (auto& val : vals) {
+            if (merged.seen_.insert(val.SerializeAsString()).second) {
+                merged.vals_.push_back(std::move(val));
+            }
+        }
+    }
+    for (auto& [key, term] : terms) {
+        if (term.merged_ > 1) {
+            flat[term.position_] = std::make_shared<expr::TermFilterExpr>(
+                term.column_, term.vals_);
+        }
+    }
+}
+
+// `x <cmp> bound` on a column holding int64 values, nullptr if bound is
+// out of int64.
+static expr::TypedExprPtr
+CompareColumn(const expr::ColumnInfo& column,
+              proto::plan::OpType op,
+              __int128 bound) {
+    if (bound < std::numeric_limits<int64_t>::min() ||
+        bound > std::numeric_limits<int64_t>::max()) {
+        return nullptr;
+    }
+    proto::plan::GenericValue val;
+    val.set_int64_val(static_cast<int64_t>(bound));
+    return std::make_shared<expr::UnaryRangeFilterExpr>(column, op, val);
+}
+
+// `lower <= x < upper`, as a binary range where the column type has one.
+static expr::TypedExprPtr
+ColumnRange(const expr::ColumnInfo& column, __int128 lower, __int128 upper) {
+    auto lower_expr =
+        CompareColumn(column, proto::plan::OpType::GreaterEqual, lower);
+    auto upper_expr =
+        CompareColumn(column, proto::plan::OpType::LessThan, upper);
+    if (lower_expr == nullptr || upper_expr == nullptr) {
+        return nullptr;
+    }
+    if (column.data_type_ == DataType::TIMESTAMPTZ) {
+        return std::make_shared<expr::LogicalBinaryExpr>(
+            expr::LogicalBinaryExpr::OpType::And, lower_expr, upper_expr);
+    }
+    return std::make_shared<expr::BinaryRangeFilterExpr>(
+        column,
+        std::static_pointer_cast<const expr::UnaryRangeFilterExpr>(lower_expr)
+            ->val_,
+        std::static_pointer_cast<const expr::UnaryRangeFilterExpr>(upper_expr)
+            ->val_,
+        true,
+        false);
+}
+
+static __int128
+FloorDiv(__int128 a, __int128 b) {
+    auto q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+// Operands past it are not rewritten, so that the arithmetic of a value of
+// an int32 column never leaves int64.
+static constexpr int64_t kMaxArithOperand = int64_t(1) << 31;
+
+// `x <arith> c <cmp> v` on an integer column becomes a comparison of x with
+// a constant: add and sub shift v, mul and div by a positive c scale it
+// with the rounding of the integer arithmetic. The sums and products of
+// int64 columns may wrap, they are only rewritten for div.
+static expr::TypedExprPtr
+RewriteIntegerArith(const expr::BinaryArithOpEvalRangeExpr& arith) {
+    const auto& column = arith.column_;
+    auto type = column.data_type_;
+    auto arith_op = arith.arith_op_type_;
+    if (!(type == DataType::INT8 || type == DataType::INT16 ||
+          type == DataType::INT32 ||
+          (type == DataType::INT64 &&
+           arith_op == proto::plan::ArithOpType::Div))) {
+        return nullptr;
+    }
+    if (arith.value_.val_case() != proto::plan::GenericValue::kInt64Val ||
+        arith.right_operand_.val_case() !=
+            proto::plan::GenericValue::kInt64Val) {
+        return nullptr;
+    }
+    __int128 c = arith.right_operand_.int64_val();
+    __int128 v = arith.value_.int64_val();
+    if (c > kMaxArithOperand || c < -kMaxArithOperand) {
+        return nullptr;
+    }
+    auto cmp = arith.op_type_;
+    switch (arith_op) {
+        case proto::plan::ArithOpType::Add:
+            return CompareColumn(column, cmp, v - c);
+        case proto::plan::ArithOpType::Sub:
+            return CompareColumn(column, cmp, v + c);
+        case proto::plan::ArithOpType::Mul: {
+            if (c <= 0) {
+                return nullptr;
+            }
+            auto floor = FloorDiv(v, c);
+            auto exact = floor * c == v;
+            auto ceil = exact ? floor : floor + 1;
+            switch (cmp) {
+                case proto::plan::OpType::GreaterThan:
+                case proto::plan::OpType::LessEqual:
+                    return CompareColumn(column, cmp, floor);
+                case proto::plan::OpType::GreaterEqual:
+                case proto::plan::OpType::LessThan:
+                    return CompareColumn(column, cmp, ceil);
+                case proto::plan::OpType::Equal:
+                case proto::plan::OpType::NotEqual:
+                    return exact ? CompareColumn(column, cmp, floor) : nullptr;
+                default:
+                    return nullptr;
+            }
+        }
+        case proto::plan::ArithOpType::Div: {
+            if (c <= 0) {
+                return nullptr;
+            }
+            // the least x with x / c >= y, the quotient rounds toward zero
+            auto least = [c](__int128 y) {
+                return y > 0 ? y * c : (y - 1) * c + 1;
+            };
+            switch (cmp) {
+                case proto::plan::OpType::GreaterEqual:
+                    return CompareColumn(
+                        column, proto::plan::OpType::GreaterEqual, least(v));
+                case proto::plan::OpType::GreaterThan:
+                    return CompareColumn(column,
+                                         proto::plan::OpType::GreaterEqual,
+                                         least(v + 1));
+                case proto::plan::OpType::LessThan:
+                    return CompareColumn(
+                        column, proto::plan::OpType::LessThan, least(v));
+                case proto::plan::OpType::LessEqual:
+                    return CompareColumn(
+                        column, proto::plan::OpType::LessThan, least(v + 1));
+                case proto::plan::OpType::Equal:
+                    return ColumnRange(column, least(v), least(v + 1));
+                default:
+                    return nullptr;
+            }
+        }
+        default:
+            return nullptr;
+    }
+}
+
+// `ts + interval <cmp> v` becomes a comparison of ts with a constant when
+// the interval is a fixed number of seconds. Years and months span a
+// varying number of days. The column is truncated to whole seconds before
+// it is shifted, the bounds are rounded to whole seconds accordingly.
+static expr::TypedExprPtr
+RewriteTimestamptzArith(const expr::TimestamptzArithCompareExpr& arith) {
+    const auto& column = arith.column_;
+    if (column.data_type_ != DataType::TIMESTAMPTZ ||
+        arith.compare_value_.val_case() !=
+            proto::plan::GenericValue::kInt64Val) {
+        return nullptr;
+    }
+    __int128 v = arith.compare_value_.int64_val();
+    auto cmp = arith.compare_op_;
+    if (arith.arith_op_ == proto::plan::ArithOpType::Unknown) {
+        return CompareColumn(column, cmp, v);
+    }
+    const auto& interval = arith.interval_;
+    if ((arith.arith_op_ != proto::plan::ArithOpType::Add &&
+         arith.arith_op_ != proto::plan::ArithOpType::Sub) ||
+        interval.years() != 0 || interval.months() != 0) {
+        return nullptr;
+    }
+    constexpr int64_t kMicrosPerSecond = 1000000;
+    // each part is an int64, the sum does not leave int128
+    __int128 shift = __int128(interval.days()) * 86400 +
+                     __int128(interval.hours()) * 3600 +
+                     __int128(interval.minutes()) * 60 + interval.seconds();
+    if (arith.arith_op_ == proto::plan::ArithOpType::Sub) {
+        shift = -shift;
+    }
+    // the truncated ts compares to w as ts + interval compares to v
+    auto w = v - shift * kMicrosPerSecond;
+    auto floor = FloorDiv(w, kMicrosPerSecond) * kMicrosPerSecond;
+    auto ceil = floor == w ? floor : floor + kMicrosPerSecond;
+    auto next = floor + kMicrosPerSecond;
+    switch (cmp) {
+        case proto::plan::OpType::GreaterThan:
+            return CompareColumn(
+                column, proto::plan::OpType::GreaterEqual, next);
+        case proto::plan::OpType::GreaterEqual:
+            return CompareColumn(
+                column, proto::plan::OpType::GreaterEqual, ceil);
+        case proto::plan::OpType::LessThan:
+            return CompareColumn(column, proto::plan::OpType::LessThan, ceil);
+        case proto::plan::OpType::LessEqual:
+            return CompareColumn(column, proto::plan::OpType::LessThan, next);
+        case proto::plan::OpType::Equal:
+            return floor == w ? ColumnRange(column, w, next) : nullptr;
+        default:
+            return nullptr;
+    }
+}
+
+// Arithmetic filters are evaluated row by row and cannot use an index or
+// the skip index. The monotone ones are rewritten into a plain range on
+// the column. Returns expr itself when it is not one of them.
+static expr::TypedExprPtr
+RewriteArithInput(const expr::TypedExprPtr& expr) {
+    expr::TypedExprPtr rewritten;
+    if (auto arith =
+            std::dynamic_pointer_cast<const expr::BinaryArithOpEvalRangeExpr>(
+                expr)) {
+        if (arith->column_.nested_path_.empty() &&
+            !arith->column_.element_level_) {
+            rewritten = RewriteIntegerArith(*arith);
+        }
+    } else if (auto arith = std::dynamic_pointer_cast<
+                   const expr::TimestamptzArithCompareExpr>(expr)) {
+        if (arith->column_.nested_path_.empty() &&
+            !arith->column_.element_level_) {
+            rewritten = RewriteTimestamptzArith(*arith);
+        }
+    }
+    return rewritten != nullptr ? rewritten : expr;
+}
+
+// Rewrites the flattened inputs of an and or an or so each column is read
+// by fewer of them: arithmetic filters become plain ranges, repeated
+// filters are dropped, the bounds of a column are merged into a binary
+// range under an and, and its equalities into one term under an or.
+static void
+RewriteConjunctInputs(std::vector<expr::TypedExprPtr>& flat, bool is_and) {
+    std::unordered_set<std::string> seen;
+    for (auto& input : flat) {
+        input = RewriteArithInput(input);
+        auto key = FilterKey(input);
+        if (key.has_value() && !seen.insert(key.value()).second) {
+            input = nullptr;
+        }
+    }
+    flat.erase(std::remove(flat.begin(), flat.end(), nullptr), flat.end());
+    if (is_and) {
+        MergeRangeInputs(flat);
+    } else {
+        MergeTermInputs(flat);
+    }
+    flat.erase(std::remove(flat.begin(), flat.end(), nullptr), flat.end());
+}
+
 std::vector<ExprPtr>
 CompileInputs(const expr::TypedExprPtr& expr,
               QueryContext* context,
               const std::unordered_set<std::string>& flatten_cadidates) {
     std::vector<ExprPtr> compiled_inputs;
     auto flatten = ShouldFlatten(expr);
+    if (flatten.has_value()) {
+        std::vector<expr::TypedExprPtr> flat_exprs;
+        for (auto& input : expr->inputs()) {
+            FlattenInput(input, flatten.value(), flat_exprs);
+        }
+        if (OPTIMIZE_EXPR_ENABLED.load()) {
+            RewriteConjunctInputs(
+                flat_exprs,
+                std::static_pointer_cast<const expr::LogicalBinaryExpr>(expr)
+                        ->op_type_ == expr::LogicalBinaryExpr::OpType::And);
+        }
+        for (auto& flat_input : flat_exprs) {
+            compiled_inputs.push_back(CompileExpression(
+                flat_input, context, flatten_cadidates, false));
+        }
+        return compiled_inputs;
+    }
     for (auto& input : expr->inputs()) {
         if (dynamic_cast<const expr::InputTypeExpr*>(input.get())) {
             AssertInfo(
                 dynamic_cast<const expr::FieldAccessTypeExpr*>(expr.get()),
                 "An InputReference can only occur under a FieldReference");
         } else {
-            if (flatten.has_value()) {
-                std::vector<expr::TypedExprPtr> flat_exprs;
-                FlattenInput(input, flatten.value(), flat_exprs);
-                for (auto& flat_input : flat_exprs) {
-                    compiled_inputs.push_back(CompileExpression(
-                        flat_input, context, flatten_cadidates, false));
-                }
-            } else {
-                compiled_inputs.push_back(CompileExpression(
-                    input, context, flatten_cadidates, false));
-            }
+            compiled_inputs.push_back(
+                CompileExpression(input, context, flatten_cadidates, false));
         }
     }
     return compiled_inputs;
 }
 
 ExprPtr
-CompileExpression(const expr::TypedExprPtr& expr,
+CompileExpression(const expr::TypedExprPtr& source,
                   QueryContext* context,
                   const std::unordered_set<std::string>& flatten_candidates,
                   bool enable_constant_folding) {
+    const auto expr =
+        OPTIMIZE_EXPR_ENABLED.load() ? RewriteArithInput(source) : source;
     ExprPtr result;
     auto compiled_inputs = CompileInputs(expr, context, flatten_candidates);
 
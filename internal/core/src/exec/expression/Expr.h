@@ -17,10 +17,14 @@
 #pragma once
 
 #include <algorithm>
+#include <deque>
 #include <memory>
+#include <set>
 #include <string>
 #include <type_traits>
 
+#include <folly/executors/InlineExecutor.h>
+
 #include "common/Array.h"
 #include "common/ArrayOffsets.h"
 #include "common/FieldDataInterface.h"
@@ -29,6 +33,7 @@
 #include "common/Types.h"
 #include "exec/expression/EvalCtx.h"
 #include "exec/expression/Utils.h"
+#include "exec/operator/OperatorProfile.h"
 #include "exec/QueryContext.h"
 #include "expr/ITypeExpr.h"
 #include "index/Index.h"
@@ -43,6 +48,11 @@ namespace exec {
 
 enum class FilterType { sequential = 0, random = 1 };
 
+// Relative cost per row of evaluating an expression. Cheap expressions are
+// evaluated in larger batches to amortize the per batch overhead, expensive
+// ones in smaller batches to keep their working set in cache.
+enum class ExprCostClass { kCheap = 0, kModerate = 1, kExpensive = 2 };
+
 inline std::vector<PinWrapper<const index::IndexBase*>>
 PinIndex(milvus::OpContext* op_ctx,
          const segcore::SegmentInternalInterface* segment,
@@ -139,6 +149,47 @@ class Expr {
         namespace_skip_func_ = std::move(skip_namespace_func);
     }
 
+    // The most expensive cost class of the inputs, moderate for leaves that
+    // do not tell.
+    virtual ExprCostClass
+    GetCostClass() const {
+        if (inputs_.empty()) {
+            return ExprCostClass::kModerate;
+        }
+        auto cost = ExprCostClass::kCheap;
+        for (const auto& input : inputs_) {
+            cost = std::max(cost, input->GetCostClass());
+        }
+        return cost;
+    }
+
+    // Sets the number of rows of the following batches. Cursors keep their
+    // position, so this may be called between any two batches, but all
+    // expressions evaluated together must be set to the same size.
+    virtual void
+    SetBatchSize(int64_t batch_size) {
+        for (auto& input : inputs_) {
+            input->SetBatchSize(batch_size);
+        }
+    }
+
+    // Adds the fields whose raw data the expression reads to 'fields'.
+    virtual void
+    GatherDataFields(std::set<FieldId>& fields) const {
+        for (const auto& input : inputs_) {
+            input->GatherDataFields(fields);
+        }
+    }
+
+    // Starts loading the chunks the following batches will scan, adding a
+    // future for each load to 'futures' instead of waiting for it.
+    virtual void
+    PrefetchAsync(std::vector<ContinueFuture>& futures) {
+        for (auto& input : inputs_) {
+            input->PrefetchAsync(futures);
+        }
+    }
+
  protected:
     DataType type_;
     std::vector<std::shared_ptr<Expr>> inputs_;
@@ -191,6 +242,14 @@ class SegmentExpr : public Expr {
         InitSegmentExpr();
     }
 
+    ~SegmentExpr() override {
+        // the loads in flight use op_ctx_, which only lives as long as the
+        // query does
+        for (auto& prefetch : prefetches_) {
+            prefetch.future.wait();
+        }
+    }
+
     void
     InitSegmentExpr() {
         auto& schema = segment_->get_schema();
@@ -203,6 +262,19 @@ class SegmentExpr : public Expr {
             is_pk_field_ = true;
             pk_type_ = field_meta.get_data_type();
         }
+        // a segment keeping the rows of each partition key sets those of a
+        // tenant without reading the column
+        is_partition_key_field_ = !is_pk_field_ && nested_path_.empty() &&
+                                  segment_->has_partition_key_rows(field_id_);
+        is_default_value_field_ = segment_->is_default_value_field(field_id_);
+
+        // count the JSON paths filters read, for the layout of the JSON stats
+        auto& hints = segment_->GetJsonKeyLayoutHints();
+        if (hints != nullptr && field_type_ == DataType::JSON &&
+            !nested_path_.empty() && !PathContainsInteger(nested_path_)) {
+            hints->RecordQueriedPath(field_id_,
+                                     milvus::index::JsonPointer(nested_path_));
+        }
 
         pinned_index_ = PinIndex(op_ctx_,
                                  segment_,
@@ -229,6 +301,115 @@ class SegmentExpr : public Expr {
         return true;
     }
 
+    ExprCostClass
+    GetCostClass() const override {
+        auto cost = ExprCostClass::kCheap;
+        switch (field_type_) {
+            case DataType::BOOL:
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+            case DataType::INT64:
+            case DataType::FLOAT:
+            case DataType::DOUBLE:
+            case DataType::TIMESTAMPTZ:
+                break;
+            case DataType::VARCHAR:
+            case DataType::STRING:
+            case DataType::TEXT:
+                cost = ExprCostClass::kModerate;
+                break;
+            default:
+                // json, array and geometry values are parsed per row
+                cost = ExprCostClass::kExpensive;
+                break;
+        }
+        for (const auto& input : inputs_) {
+            cost = std::max(cost, input->GetCostClass());
+        }
+        return cost;
+    }
+
+    void
+    SetBatchSize(int64_t batch_size) override {
+        AssertInfo(batch_size > 0,
+                   "expr batch size should greater than zero, but now: {}",
+                   batch_size);
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
+    void
+    GatherDataFields(std::set<FieldId>& fields) const override {
+        if (segment_->HasFieldData(field_id_)) {
+            fields.insert(field_id_);
+        }
+        Expr::GatherDataFields(fields);
+    }
+
+    // the chunks the raw data scan would prefetch on its first batch, the
+    // rest are prefetched by PrefetchAhead as the scan moves
+    void
+    PrefetchAsync(std::vector<ContinueFuture>& futures) override {
+        if (!prefetched_ && !has_offset_input_ &&
+            !(SegmentExpr::CanUseIndex() && use_index_) &&
+            current_data_chunk_ < num_data_chunk_) {
+            auto end = std::min(current_data_chunk_ + prefetch_window_,
+                                num_data_chunk_);
+            std::vector<int64_t> pf_chunk_ids;
+            pf_chunk_ids.reserve(end - current_data_chunk_);
+            for (auto i = current_data_chunk_; i < end; i++) {
+                pf_chunk_ids.push_back(i);
+            }
+            futures.push_back(segment_->prefetch_chunks_async(
+                op_ctx_, field_id_, pf_chunk_ids));
+            // the caller waits for these before the first batch
+            prefetches_.push_back(
+                {current_data_chunk_, end, folly::makeFuture()});
+            prefetched_until_ = end;
+            prefetched_ = true;
+        }
+        Expr::PrefetchAsync(futures);
+    }
+
+    // Keeps the next prefetch_window_ chunks after chunk_id loading while
+    // chunk_id is computed on, so a scan over a lazily loaded field overlaps
+    // its reads with its compute. Reaching a chunk whose load is still in
+    // flight means the reads are slower than the compute, and the window
+    // doubles.
+    void
+    PrefetchAhead(int64_t chunk_id) {
+        if (chunk_id == prefetch_chunk_) {
+            return;
+        }
+        prefetch_chunk_ = chunk_id;
+        while (!prefetches_.empty() && prefetches_.front().end <= chunk_id) {
+            prefetches_.pop_front();
+        }
+        if (!prefetches_.empty() && prefetches_.front().begin <= chunk_id &&
+            !prefetches_.front().future.isReady()) {
+            prefetch_window_ =
+                std::min(prefetch_window_ * 2, kMaxPrefetchWindow);
+        }
+
+        auto begin = std::max(prefetched_until_, chunk_id);
+        auto end = std::min(chunk_id + 1 + prefetch_window_, num_data_chunk_);
+        if (begin >= end) {
+            return;
+        }
+        std::vector<int64_t> pf_chunk_ids;
+        pf_chunk_ids.reserve(end - begin);
+        for (auto i = begin; i < end; i++) {
+            pf_chunk_ids.push_back(i);
+        }
+        prefetches_.push_back(
+            {begin,
+             end,
+             segment_->prefetch_chunks_async(op_ctx_, field_id_, pf_chunk_ids)
+                 .via(&folly::InlineExecutor::instance())});
+        prefetched_until_ = end;
+    }
+
     void
     MoveCursorForDataMultipleChunk() {
         int64_t processed_size = 0;
@@ -332,25 +513,177 @@ class SegmentExpr : public Expr {
         }
     }
 
+    // Rows ruled out by the skip index: nulls are marked, and func is called
+    // without data to only move its cursors past the rows.
+    template <bool NeedSegmentOffsets, typename FUNC, typename... ValTypes>
+    void
+    SkipDataRows(FUNC& func,
+                 const bool* valid_data,
+                 const int32_t* segment_offsets,
+                 int64_t size,
+                 TargetBitmapView res,
+                 TargetBitmapView valid_res,
+                 const ValTypes&... values) {
+        ApplyValidData(valid_data, res, valid_res, size);
+        if constexpr (NeedSegmentOffsets) {
+            func(nullptr,
+                 nullptr,
+                 nullptr,
+                 segment_offsets,
+                 size,
+                 res,
+                 valid_res,
+                 values...);
+        } else {
+            func(nullptr, nullptr, nullptr, size, res, valid_res, values...);
+        }
+    }
+
+    // Whether the skip index rules out the whole chunk, counted in the
+    // profile of the running operator when it does.
+    bool
+    SkipChunk(
+        const std::function<bool(const milvus::SkipIndex&, FieldId, int)>&
+            skip_func,
+        const milvus::SkipIndex& skip_index,
+        int64_t chunk_id) const {
+        if (skip_func && skip_func(skip_index, field_id_, chunk_id)) {
+            RecordSkippedChunk();
+            return true;
+        }
+        return false;
+    }
+
+    // Matches rows [chunk_offset, chunk_offset + size) of a chunk by their
+    // dictionary codes, the dictionary being filtered by dict_match_func_
+    // once per chunk. Returns false if the chunk is not dictionary encoded.
+    bool
+    ProcessDictChunk(int64_t chunk_id,
+                     int64_t chunk_offset,
+                     int64_t size,
+                     TargetBitmapView res,
+                     TargetBitmapView valid_res) {
+        auto pw = segment_->dict_string_chunk(op_ctx_, field_id_, chunk_id);
+        auto chunk = pw.get();
+        if (chunk == nullptr) {
+            return false;
+        }
+        if (dict_match_chunk_ != chunk_id) {
+            const int64_t dict_size = chunk->DictSize();
+            std::vector<std::string_view> dict;
+            dict.reserve(dict_size);
+            for (int64_t code = 0; code < dict_size; ++code) {
+                dict.push_back(chunk->DictValue(code));
+            }
+            TargetBitmap matched(dict_size);
+            TargetBitmap valid(dict_size, true);
+            dict_match_func_(dict.data(),
+                             dict_size,
+                             TargetBitmapView(matched),
+                             TargetBitmapView(valid));
+            dict_matches_.resize(dict_size);
+            for (int64_t code = 0; code < dict_size; ++code) {
+                dict_matches_[code] = matched[code];
+            }
+            dict_match_chunk_ = chunk_id;
+        }
+
+        auto match = [&](const auto* codes) {
+            codes += chunk_offset;
+            for (int64_t i = 0; i < size; ++i) {
+                res[i] = dict_matches_[codes[i]];
+            }
+        };
+        switch (chunk->CodeWidth()) {
+            case 1:
+                match(static_cast<const uint8_t*>(chunk->Codes()));
+                break;
+            case 2:
+                match(static_cast<const uint16_t*>(chunk->Codes()));
+                break;
+            default:
+                match(static_cast<const uint32_t*>(chunk->Codes()));
+                break;
+        }
+        if (segment_->is_nullable(field_id_)) {
+            for (int64_t i = 0; i < size; ++i) {
+                if (!chunk->isValid(chunk_offset + i)) {
+                    res[i] = valid_res[i] = false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Splits rows [data_pos, data_pos + size) of a chunk into runs of pages
+    // the page zone maps of the skip index agree on, and calls
+    // visit(offset, rows, candidate) for each run in order, 'offset' being
+    // relative to data_pos. Without page zone maps the whole range is one
+    // candidate run.
+    template <typename VISIT>
+    void
+    VisitCandidatePages(int64_t chunk_id,
+                        int64_t data_pos,
+                        int64_t size,
+                        VISIT&& visit) {
+        if (!candidate_pages_func_) {
+            visit(0, size, true);
+            return;
+        }
+        if (candidate_pages_chunk_ != chunk_id) {
+            candidate_pages_ = candidate_pages_func_(
+                segment_->GetSkipIndex(), field_id_, chunk_id);
+            candidate_pages_chunk_ = chunk_id;
+        }
+        const auto page_rows = candidate_pages_.page_rows;
+        if (page_rows <= 0) {
+            visit(0, size, true);
+            return;
+        }
+        const auto& candidates = candidate_pages_.candidates;
+        auto is_candidate = [&](int64_t page) {
+            return page >= static_cast<int64_t>(candidates.size()) ||
+                   candidates[page];
+        };
+        int64_t begin = 0;
+        while (begin < size) {
+            const bool candidate = is_candidate((data_pos + begin) / page_rows);
+            auto end = begin;
+            while (end < size) {
+                const auto page = (data_pos + end) / page_rows;
+                if (is_candidate(page) != candidate) {
+                    break;
+                }
+                end = std::min(size, (page + 1) * page_rows - data_pos);
+            }
+            visit(begin, end - begin, candidate);
+            begin = end;
+        }
+    }
+
+    // Number of rows the cursor has moved past.
     int64_t
-    GetNextBatchSize() {
+    GetCurrentRows() {
         auto current_chunk = SegmentExpr::CanUseIndex() && use_index_
                                  ? current_index_chunk_
                                  : current_data_chunk_;
         auto current_chunk_pos = SegmentExpr::CanUseIndex() && use_index_
                                      ? current_index_chunk_pos_
                                      : current_data_chunk_pos_;
-        auto current_rows = 0;
         if (segment_->is_chunked()) {
-            current_rows =
-                SegmentExpr::CanUseIndex() && use_index_ &&
-                        segment_->type() == SegmentType::Sealed
-                    ? current_chunk_pos
-                    : segment_->num_rows_until_chunk(field_id_, current_chunk) +
-                          current_chunk_pos;
-        } else {
-            current_rows = current_chunk * size_per_chunk_ + current_chunk_pos;
+            return SegmentExpr::CanUseIndex() && use_index_ &&
+                           segment_->type() == SegmentType::Sealed
+                       ? current_chunk_pos
+                       : segment_->num_rows_until_chunk(field_id_,
+                                                        current_chunk) +
+                             current_chunk_pos;
         }
+        return current_chunk * size_per_chunk_ + current_chunk_pos;
+    }
+
+    int64_t
+    GetNextBatchSize() {
+        auto current_rows = GetCurrentRows();
         return current_rows + batch_size_ >= active_count_
                    ? active_count_ - current_rows
                    : batch_size_;
@@ -438,7 +771,7 @@ class SegmentExpr : public Expr {
         auto pw = segment_->get_batch_views<T>(
             op_ctx_, field_id_, 0, current_data_chunk_pos_, need_size);
         auto views_info = pw.get();
-        if ((!skip_func || !skip_func(skip_index, field_id_, 0)) &&
+        if (!SkipChunk(skip_func, skip_index, 0) &&
             (!namespace_skip_func_.has_value() ||
              !namespace_skip_func_.value()(0))) {
             // first is the raw data, second is valid_data
@@ -495,7 +828,7 @@ class SegmentExpr : public Expr {
         auto pw =
             segment_->get_views_by_offsets<T>(op_ctx_, field_id_, 0, *input);
         auto [data_vec, valid_data] = pw.get();
-        if ((!skip_func || !skip_func(skip_index, field_id_, 0)) &&
+        if (!SkipChunk(skip_func, skip_index, 0) &&
             (!namespace_skip_func_.has_value() ||
              !namespace_skip_func_.value()(0))) {
             func(data_vec.data(),
@@ -556,7 +889,7 @@ class SegmentExpr : public Expr {
         auto valid_result = index_ptr->IsNotNull();
         auto batch_size = input->size();
 
-        if ((!skip_func || !skip_func(skip_index, field_id_, 0)) &&
+        if (!SkipChunk(skip_func, skip_index, 0) &&
             (!namespace_skip_func_.has_value() ||
              !namespace_skip_func_.value()(0))) {
             for (auto i = 0; i < batch_size; ++i) {
@@ -611,73 +944,78 @@ class SegmentExpr : public Expr {
         // sealed segment
         if (segment_->type() == SegmentType::Sealed) {
             if (segment_->is_chunked()) {
-                if constexpr (std::is_same_v<T, std::string_view> ||
-                              std::is_same_v<T, Json> ||
-                              std::is_same_v<T, ArrayView>) {
-                    for (size_t i = 0; i < input->size(); ++i) {
-                        int64_t offset = (*input)[i];
-                        auto [chunk_id, chunk_offset] =
-                            segment_->get_chunk_by_offset(field_id_, offset);
+                // consecutive offsets in the same chunk make a run, the
+                // chunk is pinned once for all of them
+                OffsetVector chunk_offsets;
+                chunk_offsets.reserve(input->size());
+                while (processed_size < input->size()) {
+                    int64_t offset = (*input)[processed_size];
+                    auto [chunk_id, chunk_offset] =
+                        segment_->get_chunk_by_offset(field_id_, offset);
+                    auto chunk_begin = offset - chunk_offset;
+                    auto chunk_end =
+                        chunk_begin + segment_->chunk_size(field_id_, chunk_id);
+                    chunk_offsets.clear();
+                    for (auto i = processed_size; i < input->size(); ++i) {
+                        int64_t next = (*input)[i];
+                        if (next < chunk_begin || next >= chunk_end) {
+                            break;
+                        }
+                        chunk_offsets.push_back(
+                            static_cast<int32_t>(next - chunk_begin));
+                    }
+                    auto size = static_cast<int64_t>(chunk_offsets.size());
+                    auto skipped =
+                        SkipChunk(skip_func, skip_index, chunk_id) ||
+                        (namespace_skip_func_.has_value() &&
+                         namespace_skip_func_.value()(chunk_id));
+                    if constexpr (std::is_same_v<T, std::string_view> ||
+                                  std::is_same_v<T, Json> ||
+                                  std::is_same_v<T, ArrayView>) {
                         auto pw = segment_->get_views_by_offsets<T>(
-                            op_ctx_,
-                            field_id_,
-                            chunk_id,
-                            {int32_t(chunk_offset)});
+                            op_ctx_, field_id_, chunk_id, chunk_offsets);
                         auto [data_vec, valid_data] = pw.get();
-                        if ((!skip_func ||
-                             !skip_func(skip_index, field_id_, chunk_id)) &&
-                            (!namespace_skip_func_.has_value() ||
-                             !namespace_skip_func_.value()(chunk_id))) {
+                        if (!skipped) {
                             func.template operator()<FilterType::random>(
                                 data_vec.data(),
                                 valid_data.data(),
                                 nullptr,
-                                1,
+                                size,
                                 res + processed_size,
                                 valid_res + processed_size,
                                 values...);
                         } else {
-                            if (valid_data.size() > processed_size &&
-                                !valid_data[processed_size]) {
-                                res[processed_size] =
-                                    valid_res[processed_size] = false;
+                            for (int64_t j = 0; j < size; ++j) {
+                                if (j < valid_data.size() && !valid_data[j]) {
+                                    res[processed_size + j] =
+                                        valid_res[processed_size + j] = false;
+                                }
                             }
                         }
-                        processed_size++;
-                    }
-                    return input->size();
-                }
-                for (size_t i = 0; i < input->size(); ++i) {
-                    int64_t offset = (*input)[i];
-                    auto [chunk_id, chunk_offset] =
-                        segment_->get_chunk_by_offset(field_id_, offset);
-                    auto pw =
-                        segment_->chunk_data<T>(op_ctx_, field_id_, chunk_id);
-                    auto chunk = pw.get();
-                    const T* data = chunk.data() + chunk_offset;
-                    const bool* valid_data = chunk.valid_data();
-                    if (valid_data != nullptr) {
-                        valid_data += chunk_offset;
-                    }
-                    if ((!skip_func ||
-                         !skip_func(skip_index, field_id_, chunk_id)) &&
-                        (!namespace_skip_func_.has_value() ||
-                         !namespace_skip_func_.value()(chunk_id))) {
-                        func.template operator()<FilterType::random>(
-                            data,
-                            valid_data,
-                            nullptr,
-                            1,
-                            res + processed_size,
-                            valid_res + processed_size,
-                            values...);
                     } else {
-                        ApplyValidData(valid_data,
-                                       res + processed_size,
-                                       valid_res + processed_size,
-                                       1);
+                        auto pw = segment_->chunk_data<T>(
+                            op_ctx_, field_id_, chunk_id);
+                        auto chunk = pw.get();
+                        const bool* valid_data = chunk.valid_data();
+                        if (!skipped) {
+                            func.template operator()<FilterType::random>(
+                                chunk.data(),
+                                valid_data,
+                                chunk_offsets.data(),
+                                size,
+                                res + processed_size,
+                                valid_res + processed_size,
+                                values...);
+                        } else if (valid_data != nullptr) {
+                            for (int64_t j = 0; j < size; ++j) {
+                                if (!valid_data[chunk_offsets[j]]) {
+                                    res[processed_size + j] =
+                                        valid_res[processed_size + j] = false;
+                                }
+                            }
+                        }
                     }
-                    processed_size++;
+                    processed_size += size;
                 }
                 return input->size();
             } else {
@@ -691,7 +1029,7 @@ class SegmentExpr : public Expr {
                 auto chunk = pw.get();
                 const T* data = chunk.data();
                 const bool* valid_data = chunk.valid_data();
-                if ((!skip_func || !skip_func(skip_index, field_id_, 0)) &&
+                if (!SkipChunk(skip_func, skip_index, 0) &&
                     (!namespace_skip_func_.has_value() ||
                      !namespace_skip_func_.value()(0))) {
                     func.template operator()<FilterType::random>(data,
@@ -719,8 +1057,7 @@ class SegmentExpr : public Expr {
                 if (valid_data != nullptr) {
                     valid_data += chunk_offset;
                 }
-                if ((!skip_func ||
-                     !skip_func(skip_index, field_id_, chunk_id)) &&
+                if (!SkipChunk(skip_func, skip_index, chunk_id) &&
                     (!namespace_skip_func_.has_value() ||
                      !namespace_skip_func_.value()(chunk_id))) {
                     func.template operator()<FilterType::random>(
@@ -768,6 +1105,13 @@ class SegmentExpr : public Expr {
                           field_id_.get());
             }
 
+            std::vector<int64_t> doc_ids(element_ids->size());
+            std::vector<int32_t> element_indices(element_ids->size());
+            array_offsets->ElementIDsToRowIDs(element_ids->data(),
+                                              element_ids->size(),
+                                              doc_ids.data(),
+                                              element_indices.data());
+
             // Batch process consecutive elements belonging to the same chunk
             size_t processed_size = 0;
             size_t i = 0;
@@ -778,35 +1122,29 @@ class SegmentExpr : public Expr {
 
             while (i < element_ids->size()) {
                 // Start of a new chunk batch
-                int64_t element_id = (*element_ids)[i];
-                auto [doc_id, elem_idx] =
-                    array_offsets->ElementIDToRowID(element_id);
                 auto [chunk_id, chunk_offset] =
-                    segment_->get_chunk_by_offset(field_id_, doc_id);
+                    segment_->get_chunk_by_offset(field_id_, doc_ids[i]);
 
                 // Collect consecutive elements belonging to the same chunk
                 offsets.clear();
                 elem_indices.clear();
                 offsets.push_back(chunk_offset);
-                elem_indices.push_back(elem_idx);
+                elem_indices.push_back(element_indices[i]);
 
                 size_t batch_start = i;
                 i++;
 
                 // Look ahead for more elements in the same chunk
                 while (i < element_ids->size()) {
-                    int64_t next_element_id = (*element_ids)[i];
-                    auto [next_doc_id, next_elem_idx] =
-                        array_offsets->ElementIDToRowID(next_element_id);
                     auto [next_chunk_id, next_chunk_offset] =
-                        segment_->get_chunk_by_offset(field_id_, next_doc_id);
+                        segment_->get_chunk_by_offset(field_id_, doc_ids[i]);
 
                     if (next_chunk_id != chunk_id) {
                         break;  // Different chunk, process current batch
                     }
 
                     offsets.push_back(next_chunk_offset);
-                    elem_indices.push_back(next_elem_idx);
+                    elem_indices.push_back(element_indices[i]);
                     i++;
                 }
 
@@ -820,8 +1158,7 @@ class SegmentExpr : public Expr {
                 for (size_t j = 0; j < offsets.size(); j++) {
                     size_t result_idx = batch_start + j;
 
-                    if ((!skip_func ||
-                         !skip_func(skip_index, field_id_, chunk_id)) &&
+                    if (!SkipChunk(skip_func, skip_index, chunk_id) &&
                         (!namespace_skip_func_.has_value() ||
                          !namespace_skip_func_.value()(chunk_id))) {
                         // Extract element from ArrayView
@@ -860,11 +1197,16 @@ class SegmentExpr : public Expr {
             auto& skip_index = segment_->GetSkipIndex();
             size_t processed_size = 0;
 
-            for (size_t i = 0; i < element_ids->size(); i++) {
-                int64_t element_id = (*element_ids)[i];
+            std::vector<int64_t> doc_ids(element_ids->size());
+            std::vector<int32_t> element_indices(element_ids->size());
+            array_offsets->ElementIDsToRowIDs(element_ids->data(),
+                                              element_ids->size(),
+                                              doc_ids.data(),
+                                              element_indices.data());
 
-                auto [doc_id, elem_idx] =
-                    array_offsets->ElementIDToRowID(element_id);
+            for (size_t i = 0; i < element_ids->size(); i++) {
+                auto doc_id = doc_ids[i];
+                auto elem_idx = element_indices[i];
 
                 // Calculate chunk_id and chunk_offset for this doc
                 auto chunk_id = doc_id / size_per_chunk_;
@@ -880,8 +1222,7 @@ class SegmentExpr : public Expr {
                     valid_data += chunk_offset;
                 }
 
-                if ((!skip_func ||
-                     !skip_func(skip_index, field_id_, chunk_id)) &&
+                if (!SkipChunk(skip_func, skip_index, chunk_id) &&
                     (!namespace_skip_func_.has_value() ||
                      !namespace_skip_func_.value()(chunk_id))) {
                     // Extract element from Array
@@ -929,18 +1270,8 @@ class SegmentExpr : public Expr {
         int64_t processed_rows = 0;
         int64_t processed_elems = 0;
 
-        // Prefetch chunks to reduce cache miss latency
-        if (!prefetched_) {
-            std::vector<int64_t> pf_chunk_ids;
-            pf_chunk_ids.reserve(num_data_chunk_ - current_data_chunk_);
-            for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
-                pf_chunk_ids.push_back(i);
-            }
-            segment_->prefetch_chunks(op_ctx_, field_id_, pf_chunk_ids);
-            prefetched_ = true;
-        }
-
         for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
+            PrefetchAhead(i);
             auto data_pos =
                 i == current_data_chunk_ ? current_data_chunk_pos_ : 0;
             int64_t size = segment_->chunk_size(field_id_, i) - data_pos;
@@ -949,7 +1280,7 @@ class SegmentExpr : public Expr {
                 continue;
 
             auto& skip_index = segment_->GetSkipIndex();
-            if ((!skip_func || !skip_func(skip_index, field_id_, i)) &&
+            if (!SkipChunk(skip_func, skip_index, i) &&
                 (!namespace_skip_func_.has_value() ||
                  !namespace_skip_func_.value()(i))) {
                 if (segment_->type() == SegmentType::Sealed) {
@@ -1202,7 +1533,7 @@ class SegmentExpr : public Expr {
             if (valid_data != nullptr) {
                 valid_data += data_pos;
             }
-            if ((!skip_func || !skip_func(skip_index, field_id_, i)) &&
+            if (!SkipChunk(skip_func, skip_index, i) &&
                 (!namespace_skip_func_.has_value() ||
                  !namespace_skip_func_.value()(i))) {
                 const T* data = chunk.data() + data_pos;
@@ -1290,19 +1621,12 @@ class SegmentExpr : public Expr {
         TargetBitmapView valid_res,
         const ValTypes&... values) {
         int64_t processed_size = 0;
-
-        // prefetch chunks to reduce cache miss latency
-        if (!prefetched_) {
-            std::vector<int64_t> pf_chunk_ids;
-            pf_chunk_ids.reserve(num_data_chunk_ - current_data_chunk_);
-            for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
-                pf_chunk_ids.push_back(i);
-            }
-            segment_->prefetch_chunks(op_ctx_, field_id_, pf_chunk_ids);
-            prefetched_ = true;
-        }
+        // rows of dictionary encoded string chunks are matched by code
+        constexpr bool kMatchByDict =
+            std::is_same_v<T, std::string_view> && !NeedSegmentOffsets;
 
         for (size_t i = current_data_chunk_; i < num_data_chunk_; i++) {
+            PrefetchAhead(i);
             auto data_pos =
                 i == current_data_chunk_ ? current_data_chunk_pos_ : 0;
 
@@ -1320,7 +1644,7 @@ class SegmentExpr : public Expr {
                 segment_offsets_array[j] = static_cast<int32_t>(offset);
             }
             auto& skip_index = segment_->GetSkipIndex();
-            if ((!skip_func || !skip_func(skip_index, field_id_, i)) &&
+            if (!SkipChunk(skip_func, skip_index, i) &&
                 (!namespace_skip_func_.has_value() ||
                  !namespace_skip_func_.value()(i))) {
                 bool is_seal = false;
@@ -1328,30 +1652,83 @@ class SegmentExpr : public Expr {
                               std::is_same_v<T, Json> ||
                               std::is_same_v<T, ArrayView>) {
                     if (segment_->type() == SegmentType::Sealed) {
-                        // first is the raw data, second is valid_data
-                        // use valid_data to see if raw data is null
-                        auto pw = segment_->get_batch_views<T>(
-                            op_ctx_, field_id_, i, data_pos, size);
-                        auto [data_vec, valid_data] = pw.get();
-
-                        if constexpr (NeedSegmentOffsets) {
-                            func(data_vec.data(),
-                                 valid_data.data(),
-                                 nullptr,
-                                 segment_offsets_array.data(),
-                                 size,
-                                 res + processed_size,
-                                 valid_res + processed_size,
-                                 values...);
-                        } else {
-                            func(data_vec.data(),
-                                 valid_data.data(),
-                                 nullptr,
-                                 size,
-                                 res + processed_size,
-                                 valid_res + processed_size,
-                                 values...);
-                        }
+                        VisitCandidatePages(
+                            i,
+                            data_pos,
+                            size,
+                            [&](int64_t offset, int64_t rows, bool candidate) {
+                                auto run_res = res + processed_size + offset;
+                                auto run_valid_res =
+                                    valid_res + processed_size + offset;
+                                auto run_offsets =
+                                    segment_offsets_array.data() + offset;
+                                if (!candidate &&
+                                    !segment_->is_nullable(field_id_)) {
+                                    SkipDataRows<NeedSegmentOffsets>(
+                                        func,
+                                        nullptr,
+                                        run_offsets,
+                                        rows,
+                                        run_res,
+                                        run_valid_res,
+                                        values...);
+                                    return;
+                                }
+                                if constexpr (kMatchByDict) {
+                                    if (candidate && dict_match_func_ &&
+                                        ProcessDictChunk(i,
+                                                         data_pos + offset,
+                                                         rows,
+                                                         run_res,
+                                                         run_valid_res)) {
+                                        // only moves the cursor of func
+                                        func(nullptr,
+                                             nullptr,
+                                             nullptr,
+                                             rows,
+                                             run_res,
+                                             run_valid_res,
+                                             values...);
+                                        return;
+                                    }
+                                }
+                                // first is the raw data, second is valid_data
+                                // use valid_data to see if raw data is null
+                                auto pw = segment_->get_batch_views<T>(
+                                    op_ctx_,
+                                    field_id_,
+                                    i,
+                                    data_pos + offset,
+                                    rows);
+                                auto [data_vec, valid_data] = pw.get();
+                                if (!candidate) {
+                                    SkipDataRows<NeedSegmentOffsets>(
+                                        func,
+                                        valid_data.data(),
+                                        run_offsets,
+                                        rows,
+                                        run_res,
+                                        run_valid_res,
+                                        values...);
+                                } else if constexpr (NeedSegmentOffsets) {
+                                    func(data_vec.data(),
+                                         valid_data.data(),
+                                         nullptr,
+                                         run_offsets,
+                                         rows,
+                                         run_res,
+                                         run_valid_res,
+                                         values...);
+                                } else {
+                                    func(data_vec.data(),
+                                         valid_data.data(),
+                                         nullptr,
+                                         rows,
+                                         run_res,
+                                         run_valid_res,
+                                         values...);
+                                }
+                            });
 
                         is_seal = true;
                     }
@@ -1365,25 +1742,48 @@ class SegmentExpr : public Expr {
                         valid_data += data_pos;
                     }
 
-                    if constexpr (NeedSegmentOffsets) {
-                        // For GIS functions: construct segment offsets array
-                        func(data,
-                             valid_data,
-                             nullptr,
-                             segment_offsets_array.data(),
-                             size,
-                             res + processed_size,
-                             valid_res + processed_size,
-                             values...);
-                    } else {
-                        func(data,
-                             valid_data,
-                             nullptr,
-                             size,
-                             res + processed_size,
-                             valid_res + processed_size,
-                             values...);
-                    }
+                    VisitCandidatePages(
+                        i,
+                        data_pos,
+                        size,
+                        [&](int64_t offset, int64_t rows, bool candidate) {
+                            auto run_valid_data =
+                                valid_data == nullptr ? nullptr
+                                                      : valid_data + offset;
+                            auto run_res = res + processed_size + offset;
+                            auto run_valid_res =
+                                valid_res + processed_size + offset;
+                            // For GIS functions: segment offsets of the rows
+                            auto run_offsets =
+                                segment_offsets_array.data() + offset;
+                            if (!candidate) {
+                                SkipDataRows<NeedSegmentOffsets>(
+                                    func,
+                                    run_valid_data,
+                                    run_offsets,
+                                    rows,
+                                    run_res,
+                                    run_valid_res,
+                                    values...);
+                            } else if constexpr (NeedSegmentOffsets) {
+                                func(data + offset,
+                                     run_valid_data,
+                                     nullptr,
+                                     run_offsets,
+                                     rows,
+                                     run_res,
+                                     run_valid_res,
+                                     values...);
+                            } else {
+                                func(data + offset,
+                                     run_valid_data,
+                                     nullptr,
+                                     rows,
+                                     run_res,
+                                     run_valid_res,
+                                     values...);
+                            }
+                        });
                 }
             } else {
                 // Chunk is skipped by SkipIndex.
@@ -2034,25 +2434,63 @@ class SegmentExpr : public Expr {
                        .get() != nullptr;
     }
 
+    // if path contains integer, we can't use json stats such as "a.1.b", "a.1",
+    // because we can't know the integer is a key or a array indice
+    static bool
+    PathContainsInteger(const std::vector<std::string>& path) {
+        for (auto i = 0; i < path.size(); i++) {
+            if (milvus::IsInteger(path[i])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
     bool
     CanUseJsonStats(EvalCtx& context,
                     FieldId field_id,
                     const std::vector<std::string>& nested_path) const {
-        // if path contains integer, we can't use json stats such as "a.1.b", "a.1",
-        // because we can't know the integer is a key or a array indice
-        auto path_contains_integer = [](const std::vector<std::string>& path) {
-            for (auto i = 0; i < path.size(); i++) {
-                if (milvus::IsInteger(path[i])) {
-                    return true;
-                }
-            }
-            return false;
-        };
-
         // if path is empty, json stats can not know key name,
         // so we can't use json shredding data
         return PlanUseJsonStats(context) && HasJsonStats(field_id) &&
-               !nested_path.empty() && !path_contains_integer(nested_path);
+               !nested_path.empty() && !PathContainsInteger(nested_path);
+    }
+
+    // the growing json key stats holding every value at the path, or nullptr
+    std::shared_ptr<const index::GrowingJsonKeyStats>
+    GetGrowingJsonStats(EvalCtx& context,
+                        FieldId field_id,
+                        const std::vector<std::string>& nested_path) const {
+        if (segment_->type() != SegmentType::Growing ||
+            !PlanUseJsonStats(context) || nested_path.empty() ||
+            PathContainsInteger(nested_path)) {
+            return nullptr;
+        }
+        auto stats = segment_->GetGrowingJsonStats(field_id);
+        if (stats == nullptr ||
+            !stats->CoversPointer(milvus::index::JsonPointer(nested_path))) {
+            return nullptr;
+        }
+        return stats;
+    }
+
+    // the interim index of a growing segment covering every row of the next
+    // batch, or nullptr
+    template <typename T>
+    std::shared_ptr<const segcore::GrowingScalarIndex<T>>
+    GetGrowingScalarIndex() {
+        if (segment_->type() != SegmentType::Growing || has_offset_input_) {
+            return nullptr;
+        }
+        auto index =
+            std::dynamic_pointer_cast<const segcore::GrowingScalarIndex<T>>(
+                segment_->GetGrowingScalarIndex(field_id_));
+        if (index == nullptr ||
+            current_data_global_pos_ + GetNextBatchSize() >
+                index->IndexedRows()) {
+            return nullptr;
+        }
+        return index;
     }
 
     virtual bool
@@ -2065,6 +2503,9 @@ class SegmentExpr : public Expr {
     const FieldId field_id_;
     bool is_pk_field_{false};
     DataType pk_type_;
+    bool is_partition_key_field_{false};
+    // every row is the default value of the field, or null without one
+    bool is_default_value_field_{false};
     int64_t batch_size_;
 
     std::vector<std::string> nested_path_;
@@ -2078,6 +2519,35 @@ class SegmentExpr : public Expr {
     bool use_index_{true};
     // used for reducing cache miss latency in tiered storage
     bool prefetched_{false};
+    // Loads issued ahead of a raw data scan, one per range of chunks
+    // [begin, end), oldest first. Chunks up to prefetch_window_ after the
+    // one being computed on are kept loading.
+    struct ChunkPrefetch {
+        int64_t begin;
+        int64_t end;
+        folly::Future<folly::Unit> future;
+    };
+    static constexpr int64_t kMaxPrefetchWindow = 16;
+    std::deque<ChunkPrefetch> prefetches_;
+    int64_t prefetch_window_{2};
+    int64_t prefetched_until_{0};
+    int64_t prefetch_chunk_{-1};
+    // Candidate pages of a chunk by the page zone maps of the skip index,
+    // unset if the expression can not check pages. The result of the last
+    // chunk is cached, as a chunk usually spans several batches.
+    using CandidatePagesFunc = std::function<CandidatePages(
+        const milvus::SkipIndex&, FieldId, int64_t)>;
+    CandidatePagesFunc candidate_pages_func_;
+    int64_t candidate_pages_chunk_{-1};
+    CandidatePages candidate_pages_;
+    // Evaluates the filter over the dictionary of an encoded string chunk,
+    // set only for the calls the rows may be matched by code in. The matches
+    // of the last chunk are cached by code.
+    using DictMatchFunc = std::function<void(
+        const std::string_view*, int64_t, TargetBitmapView, TargetBitmapView)>;
+    DictMatchFunc dict_match_func_;
+    int64_t dict_match_chunk_{-1};
+    std::vector<uint8_t> dict_matches_;
     std::vector<PinWrapper<const index::IndexBase*>> pinned_index_{};
 
     int64_t active_count_{0};
@@ -16,6 +16,9 @@
 
 #include "exec/expression/ExprCache.h"
 
+#include "common/EasyAssert.h"
+#include "monitor/Monitor.h"
+
 namespace milvus {
 namespace exec {
 
@@ -55,25 +58,85 @@ ExprResCacheManager::GetCurrentBytes() const {
 
 size_t
 ExprResCacheManager::GetEntryCount() const {
-    return concurrent_map_.size();
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        count += shard.map.size();
+    }
+    return count;
+}
+
+ExprResCacheManager::Stats
+ExprResCacheManager::GetStats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.rejections = rejections_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ExprResCacheManager::Shard&
+ExprResCacheManager::GetShard(int64_t segment_id) {
+    return shards_[std::hash<int64_t>{}(segment_id) % kNumShards];
 }
 
 bool
 ExprResCacheManager::Get(const Key& key, Value& out_value) {
-    if (!IsEnabled()) {
+    CompressedValue compressed;
+    if (!Get(key, compressed)) {
         return false;
     }
+    out_value.result = compressed.result->Decode();
+    out_value.valid_result = compressed.valid_result
+                                 ? compressed.valid_result->Decode()
+                                 : nullptr;
+    out_value.active_count = compressed.active_count;
+    out_value.bytes = compressed.bytes;
+    return true;
+}
 
-    auto it = concurrent_map_.find(key);
-    if (it == concurrent_map_.end()) {
+bool
+ExprResCacheManager::GetPrefix(const Key& key,
+                               int64_t active_count,
+                               Value& out_value) {
+    if (!Get(key, out_value)) {
         return false;
     }
+    if (out_value.active_count > active_count) {
+        out_value.result->resize(active_count);
+        if (out_value.valid_result) {
+            out_value.valid_result->resize(active_count);
+        }
+        out_value.active_count = active_count;
+    }
+    return true;
+}
 
-    out_value = it->second.value;
+bool
+ExprResCacheManager::Get(const Key& key, CompressedValue& out_value) {
+    if (!IsEnabled()) {
+        return false;
+    }
+
+    auto& shard = GetShard(key.segment_id);
+    RecordAccess(shard, key);
     {
-        std::lock_guard<std::mutex> lru_lock(lru_mutex_);
-        lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_it);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            monitor::internal_core_expr_res_cache_miss.Increment();
+            return false;
+        }
+        out_value = it->second.value;
+        // avoid dirtying the cache line when the bit is already set
+        if (!it->second.referenced.load(std::memory_order_relaxed)) {
+            it->second.referenced.store(true, std::memory_order_relaxed);
+        }
     }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    monitor::internal_core_expr_res_cache_hit.Increment();
 
     LOG_DEBUG("get expr res cache, segment_id: {}, key: {}",
               key.segment_id,
@@ -87,36 +150,68 @@ ExprResCacheManager::Put(const Key& key, const Value& value) {
         return;
     }
 
-    size_t estimated_bytes = EstimateBytes(value);
-    auto stored_value = value;
-    stored_value.bytes = estimated_bytes;
+    AssertInfo(value.result != nullptr, "expr res cache value is null");
+    // encode outside of the shard lock
+    CompressedValue compressed;
+    compressed.result = CompressedBitmap::Encode(value.result);
+    if (value.valid_result) {
+        compressed.valid_result = CompressedBitmap::Encode(value.valid_result);
+    }
+    compressed.active_count = value.active_count;
+    Put(key, compressed);
+}
+
+void
+ExprResCacheManager::Put(const Key& key, const CompressedValue& value) {
+    if (!IsEnabled()) {
+        return;
+    }
 
-    auto it = concurrent_map_.find(key);
-    if (it != concurrent_map_.end()) {
-        auto old_bytes = it->second.value.bytes;
-        it->second.value = stored_value;
+    AssertInfo(value.result != nullptr, "expr res cache value is null");
+    CompressedValue stored_value = value;
+    size_t estimated_bytes = EstimateBytes(stored_value);
+    stored_value.bytes = estimated_bytes;
 
-        {
-            std::lock_guard<std::mutex> lru_lock(lru_mutex_);
-            lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_it);
-            current_bytes_.fetch_add(estimated_bytes - old_bytes);
+    auto shard_idx = std::hash<int64_t>{}(key.segment_id) % kNumShards;
+    auto& shard = shards_[shard_idx];
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (current_bytes_.load() + estimated_bytes > capacity_bytes_.load() &&
+            shard.map.find(key) == shard.map.end()) {
+            auto victim = NextVictim(shard);
+            if (victim != shard.map.end() &&
+                EstimateFrequency(shard, key) <
+                    EstimateFrequency(shard, victim->first)) {
+                rejections_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
         }
-    } else {
-        ListIt list_it;
-        {
-            std::lock_guard<std::mutex> lru_lock(lru_mutex_);
-            lru_list_.push_front(key);
-            list_it = lru_list_.begin();
-            current_bytes_.fetch_add(estimated_bytes);
+        auto [it, inserted] = shard.map.try_emplace(key);
+        auto& entry = it->second;
+        if (!inserted &&
+            entry.value.active_count > stored_value.active_count) {
+            entry.referenced.store(true, std::memory_order_relaxed);
+            return;
         }
-
-        Entry entry(stored_value, list_it);
-        concurrent_map_.emplace(key, std::move(entry));
+        if (inserted) {
+            entry.ring_it = shard.ring.insert(shard.ring.end(), key);
+            if (shard.hand == shard.ring.end()) {
+                shard.hand = entry.ring_it;
+            }
+        } else {
+            shard.bytes.fetch_sub(entry.value.bytes);
+            current_bytes_.fetch_sub(entry.value.bytes);
+            entry.referenced.store(true, std::memory_order_relaxed);
+        }
+        entry.value = std::move(stored_value);
+        shard.bytes.fetch_add(estimated_bytes);
+        current_bytes_.fetch_add(estimated_bytes);
     }
 
     if (current_bytes_.load() > capacity_bytes_.load()) {
-        EnsureCapacity();
+        EnsureCapacity(shard_idx);
     }
+    monitor::internal_core_expr_res_cache_bytes_all.Set(current_bytes_.load());
 
     LOG_DEBUG("put expr res cache, segment_id: {}, key: {}",
               key.segment_id,
@@ -125,57 +220,129 @@ ExprResCacheManager::Put(const Key& key, const Value& value) {
 
 void
 ExprResCacheManager::Clear() {
-    std::lock_guard<std::mutex> lru_lock(lru_mutex_);
-
-    concurrent_map_.clear();
-    lru_list_.clear();
-    current_bytes_.store(0);
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        current_bytes_.fetch_sub(shard.bytes.load());
+        shard.map.clear();
+        shard.ring.clear();
+        shard.hand = shard.ring.end();
+        shard.bytes.store(0);
+    }
+    monitor::internal_core_expr_res_cache_bytes_all.Set(current_bytes_.load());
 }
 
 size_t
-ExprResCacheManager::EstimateBytes(const Value& v) const {
+ExprResCacheManager::EstimateBytes(const CompressedValue& v) const {
     size_t bytes = sizeof(Value);
     if (v.result) {
-        bytes += (v.result->size() + 7) / 8;
+        bytes += v.result->bytes();
     }
     if (v.valid_result) {
-        bytes += (v.valid_result->size() + 7) / 8;
+        bytes += v.valid_result->bytes();
     }
     return bytes;
 }
 
 void
-ExprResCacheManager::EnsureCapacity() {
-    std::lock_guard<std::mutex> lru_lock(lru_mutex_);
-    while (current_bytes_.load() > capacity_bytes_.load() &&
-           !lru_list_.empty()) {
-        const auto& back_key = lru_list_.back();
-        auto it = concurrent_map_.find(back_key);
-        if (it != concurrent_map_.end()) {
-            current_bytes_.fetch_sub(it->second.value.bytes);
-            concurrent_map_.unsafe_erase(it);
+ExprResCacheManager::EraseEntry(
+    Shard& shard, std::unordered_map<Key, Entry, KeyHasher>::iterator map_it) {
+    auto ring_it = map_it->second.ring_it;
+    if (shard.hand == ring_it) {
+        shard.hand = shard.ring.erase(ring_it);
+    } else {
+        shard.ring.erase(ring_it);
+    }
+    if (shard.hand == shard.ring.end()) {
+        shard.hand = shard.ring.begin();
+    }
+    shard.bytes.fetch_sub(map_it->second.value.bytes);
+    current_bytes_.fetch_sub(map_it->second.value.bytes);
+    shard.map.erase(map_it);
+}
+
+std::unordered_map<ExprResCacheManager::Key,
+                   ExprResCacheManager::Entry,
+                   ExprResCacheManager::KeyHasher>::iterator
+ExprResCacheManager::NextVictim(Shard& shard) {
+    if (shard.ring.empty()) {
+        return shard.map.end();
+    }
+    // every entry is visited at most twice: the first pass clears the
+    // reference bits, so the sweep always terminates
+    while (true) {
+        if (shard.hand == shard.ring.end()) {
+            shard.hand = shard.ring.begin();
+        }
+        auto map_it = shard.map.find(*shard.hand);
+        AssertInfo(map_it != shard.map.end(),
+                   "expr res cache ring and map are inconsistent");
+        if (!map_it->second.referenced.exchange(false,
+                                                std::memory_order_relaxed)) {
+            return map_it;
+        }
+        ++shard.hand;
+    }
+}
+
+bool
+ExprResCacheManager::EvictOne(Shard& shard) {
+    auto victim = NextVictim(shard);
+    if (victim == shard.map.end()) {
+        return false;
+    }
+    EraseEntry(shard, victim);
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+    monitor::internal_core_expr_res_cache_eviction.Increment();
+    return true;
+}
+
+void
+ExprResCacheManager::RecordAccess(Shard& shard, const Key& key) {
+    auto hash = KeyHasher{}(key);
+    std::lock_guard<std::mutex> lock(shard.sketch_mutex);
+    shard.sketch.Increment(hash);
+}
+
+uint32_t
+ExprResCacheManager::EstimateFrequency(Shard& shard, const Key& key) {
+    auto hash = KeyHasher{}(key);
+    std::lock_guard<std::mutex> lock(shard.sketch_mutex);
+    return shard.sketch.Estimate(hash);
+}
+
+void
+ExprResCacheManager::EnsureCapacity(size_t first_shard) {
+    // evict from the shard which just grew first, then sweep the others
+    for (size_t i = 0; i < kNumShards; ++i) {
+        if (current_bytes_.load() <= capacity_bytes_.load()) {
+            break;
+        }
+        auto& shard = shards_[(first_shard + i) % kNumShards];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        while (current_bytes_.load() > capacity_bytes_.load() &&
+               EvictOne(shard)) {
         }
-        lru_list_.pop_back();
     }
 }
 
 size_t
 ExprResCacheManager::EraseSegment(int64_t segment_id) {
     size_t erased = 0;
-    std::lock_guard<std::mutex> lru_lock(lru_mutex_);
-    for (auto it = lru_list_.begin(); it != lru_list_.end();) {
-        if (it->segment_id == segment_id) {
-            auto map_it = concurrent_map_.find(*it);
-            if (map_it != concurrent_map_.end()) {
-                current_bytes_.fetch_sub(map_it->second.value.bytes);
-                concurrent_map_.unsafe_erase(map_it);
+    auto& shard = GetShard(segment_id);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.map.begin(); it != shard.map.end();) {
+            if (it->first.segment_id == segment_id) {
+                auto next = std::next(it);
+                EraseEntry(shard, it);
+                it = next;
+                ++erased;
+            } else {
+                ++it;
             }
-            it = lru_list_.erase(it);
-            ++erased;
-        } else {
-            ++it;
         }
     }
+    monitor::internal_core_expr_res_cache_bytes_all.Set(current_bytes_.load());
 
     LOG_INFO("erase segment cache, segment_id: {}, erased: {} entries",
              segment_id,
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <atomic>
@@ -25,17 +26,34 @@
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
-#include <tbb/concurrent_unordered_map.h>
 
+#include "common/FrequencySketch.h"
 #include "common/Types.h"
+#include "exec/expression/CompressedBitmap.h"
 #include "log/Log.h"
 
 namespace milvus {
 namespace exec {
 
-// Process-level LRU cache for expression result bitsets.
+// Process-level cache for expression result bitsets.
+//
+// Entries are spread over kNumShards shards keyed by segment id, every shard
+// guards its map with a shared mutex so lookups only take a shared lock.
+// Recency is tracked with a CLOCK (second-chance) ring per shard: a hit only
+// sets the reference bit of the entry, eviction sweeps the ring and drops the
+// first entry whose bit is clear.
+//
+// New entries are admitted by TinyLFU: every lookup is counted in a frequency
+// sketch of the shard, and an entry that would evict one looked up more
+// often than itself is rejected. A scan running many one-off filters thus
+// does not flush the results of the filters queried over and over.
+//
+// Bitsets are stored as CompressedBitmap, so nearly empty or nearly full
+// results only cost a few bytes of the capacity.
 class ExprResCacheManager {
  public:
+    static constexpr size_t kNumShards = 16;
+
     struct Key {
         int64_t segment_id{0};
         std::string signature;  // expr signature including parameters
@@ -63,6 +81,23 @@ class ExprResCacheManager {
         size_t bytes{0};  // approximate size in bytes
     };
 
+    // encoded form kept by the cache, byte accounting uses the encoded size
+    struct CompressedValue {
+        std::shared_ptr<const CompressedBitmap> result;
+        std::shared_ptr<const CompressedBitmap> valid_result;
+        int64_t active_count{0};
+        size_t bytes{0};
+    };
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        // entries not admitted as they were looked up less often than the
+        // entries they would have evicted
+        uint64_t rejections{0};
+    };
+
  public:
     static ExprResCacheManager&
     Instance();
@@ -81,15 +116,38 @@ class ExprResCacheManager {
     GetCurrentBytes() const;
     size_t
     GetEntryCount() const;
+    Stats
+    GetStats() const;
 
-    // Try to get cached value. If found, returns true and fills out_value.
+    // Try to get cached value. If found, returns true and fills out_value,
+    // encoded bitsets are decoded into newly allocated bitmaps.
     bool
     Get(const Key& key, Value& out_value);
 
+    // Same as above but hands out the encoded bitsets, callers decode or
+    // AND them into their own bitmaps without materializing a copy.
+    bool
+    Get(const Key& key, CompressedValue& out_value);
+
+    // Result of the first rows of a growing segment. Rows are only appended
+    // to a growing segment, so an entry cached at a smaller active count is
+    // the prefix of the current result and the caller only evaluates the
+    // rows after it. Fills out_value with the first
+    // min(cached, active_count) rows, out_value.active_count tells how many.
+    bool
+    GetPrefix(const Key& key, int64_t active_count, Value& out_value);
+
     // Insert or update cache entry. The provided value.result must be non-null.
+    // An entry is not replaced by one of a smaller active count, a query at
+    // an older timestamp does not shrink the prefix of the newer ones.
     void
     Put(const Key& key, const Value& value);
 
+    // Same as above for bitsets the caller already encoded, value.bytes is
+    // computed here.
+    void
+    Put(const Key& key, const CompressedValue& value);
+
     void
     Clear();
 
@@ -100,10 +158,60 @@ class ExprResCacheManager {
  private:
     ExprResCacheManager() = default;
 
+    struct Entry {
+        CompressedValue value;
+        std::list<Key>::iterator ring_it;
+        // second-chance bit, set by hits without taking the exclusive lock
+        std::atomic<bool> referenced{false};
+    };
+
+    // lookups a shard sketch is sized for
+    static constexpr size_t kSketchEntriesPerShard = 4096;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<Key, Entry, KeyHasher> map;
+        // CLOCK ring in insertion order, hand points to the next candidate
+        std::list<Key> ring;
+        std::list<Key>::iterator hand = ring.end();
+        std::atomic<size_t> bytes{0};
+        // lookups by key hash, guarded by sketch_mutex as lookups only hold
+        // the shared lock
+        std::mutex sketch_mutex;
+        FrequencySketch sketch{kSketchEntriesPerShard};
+    };
+
     size_t
-    EstimateBytes(const Value& v) const;
+    EstimateBytes(const CompressedValue& v) const;
+
+    Shard&
+    GetShard(int64_t segment_id);
+
+    // the entry CLOCK evicts next, clearing the reference bits it passes,
+    // or map.end() if the shard is empty. Caller must hold the exclusive lock.
+    std::unordered_map<Key, Entry, KeyHasher>::iterator
+    NextVictim(Shard& shard);
+
+    // evict one entry of the shard, caller must hold the shard exclusive lock.
+    // Returns false if the shard is empty.
+    bool
+    EvictOne(Shard& shard);
+
+    void
+    RecordAccess(Shard& shard, const Key& key);
+
+    uint32_t
+    EstimateFrequency(Shard& shard, const Key& key);
+
+    // erase the entry pointed by map_it, caller must hold the exclusive lock
+    void
+    EraseEntry(Shard& shard,
+               std::unordered_map<Key, Entry, KeyHasher>::iterator map_it);
+
+    // evict entries until current bytes fits the capacity, starting from
+    // the shard with index first_shard
     void
-    EnsureCapacity();
+    EnsureCapacity(size_t first_shard = 0);
 
  private:
     static std::atomic<bool> enabled_;
@@ -111,19 +219,12 @@ class ExprResCacheManager {
                                         1024ull};  // default 256MB
     std::atomic<size_t> current_bytes_{0};
 
-    mutable std::mutex lru_mutex_;
-    std::list<Key> lru_list_;
-    using ListIt = std::list<Key>::iterator;
-    struct Entry {
-        Value value;
-        ListIt lru_it;
-
-        Entry() = default;
-        Entry(const Value& v, ListIt it) : value(v), lru_it(it) {
-        }
-    };
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> rejections_{0};
 
-    tbb::concurrent_unordered_map<Key, Entry, KeyHasher> concurrent_map_;
+    std::array<Shard, kNumShards> shards_;
 };
 
 // Helper API: erase all cache for a given segment id, returns erased entry count
@@ -35,6 +35,17 @@ MakeBits(size_t n, bool v = true) {
     return b;
 }
 
+// alternating bits defeat the compressed encodings, so every entry costs
+// its dense size
+milvus::TargetBitmap
+MakeDenseBits(size_t n) {
+    milvus::TargetBitmap b(n);
+    for (size_t i = 0; i < n; i += 2) {
+        b.set(i);
+    }
+    return b;
+}
+
 }  // namespace
 
 TEST(ExprResCacheManagerTest, PutGetBasic) {
@@ -63,6 +74,58 @@ TEST(ExprResCacheManagerTest, PutGetBasic) {
     ExprResCacheManager::SetEnabled(false);
 }
 
+TEST(ExprResCacheManagerTest, GetPrefix) {
+    auto& mgr = ExprResCacheManager::Instance();
+    ExprResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(1ULL << 20);
+
+    ExprResCacheManager::Key k{123, "expr:grow"};
+    auto bits = MakeBits(100, false);
+    bits.set(10);
+    bits.set(90);
+    ExprResCacheManager::Value v;
+    v.result = std::make_shared<milvus::TargetBitmap>(bits.clone());
+    v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeBits(100));
+    v.active_count = 100;
+    mgr.Put(k, v);
+
+    // the segment grew, the cached rows are its prefix
+    ExprResCacheManager::Value got;
+    ASSERT_TRUE(mgr.GetPrefix(k, 150, got));
+    ASSERT_EQ(got.active_count, 100);
+    ASSERT_EQ(got.result->size(), 100);
+    ASSERT_EQ(got.result->count(), 2);
+
+    // a query at an older timestamp sees fewer rows
+    ASSERT_TRUE(mgr.GetPrefix(k, 50, got));
+    ASSERT_EQ(got.active_count, 50);
+    ASSERT_EQ(got.result->size(), 50);
+    ASSERT_EQ(got.valid_result->size(), 50);
+    ASSERT_EQ(got.result->count(), 1);
+
+    // and does not shrink the entry
+    mgr.Put(k, got);
+    ASSERT_TRUE(mgr.Get(k, got));
+    ASSERT_EQ(got.active_count, 100);
+
+    // the extended result replaces it
+    bits.resize(150, false);
+    bits.set(120);
+    v.result = std::make_shared<milvus::TargetBitmap>(bits.clone());
+    v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeBits(150));
+    v.active_count = 150;
+    mgr.Put(k, v);
+    ASSERT_TRUE(mgr.GetPrefix(k, 150, got));
+    ASSERT_EQ(got.active_count, 150);
+    ASSERT_EQ(got.result->count(), 3);
+
+    ASSERT_FALSE(mgr.GetPrefix({123, "expr:other"}, 150, got));
+
+    mgr.Clear();
+    ExprResCacheManager::SetEnabled(false);
+}
+
 TEST(ExprResCacheManagerTest, LruEvictionByCapacity) {
     auto& mgr = ExprResCacheManager::Instance();
     ExprResCacheManager::SetEnabled(true);
@@ -75,8 +138,8 @@ TEST(ExprResCacheManagerTest, LruEvictionByCapacity) {
     for (int i = 0; i < 3; ++i) {
         ExprResCacheManager::Key k{1, "expr:" + std::to_string(i)};
         ExprResCacheManager::Value v;
-        v.result = std::make_shared<milvus::TargetBitmap>(MakeBits(N));
-        v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeBits(N));
+        v.result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(N));
+        v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(N));
         mgr.Put(k, v);
     }
 
@@ -144,3 +207,166 @@ TEST(ExprResCacheManagerTest, EnableDisable) {
     mgr.Clear();
     ExprResCacheManager::SetEnabled(false);
 }
+
+TEST(ExprResCacheManagerTest, SecondChanceKeepsReferencedEntry) {
+    auto& mgr = ExprResCacheManager::Instance();
+    ExprResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(4300);
+
+    const size_t N = 8192;  // bits
+    auto make_value = [&]() {
+        ExprResCacheManager::Value v;
+        v.result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(N));
+        v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(N));
+        return v;
+    };
+    mgr.Put({1, "expr:0"}, make_value());
+    mgr.Put({1, "expr:1"}, make_value());
+
+    // touch expr:0 so that expr:1 becomes the eviction victim
+    ExprResCacheManager::Value out;
+    auto before = mgr.GetStats();
+    ASSERT_TRUE(mgr.Get({1, "expr:0"}, out));
+    mgr.Put({1, "expr:2"}, make_value());
+
+    ASSERT_TRUE(mgr.Get({1, "expr:0"}, out));
+    ASSERT_FALSE(mgr.Get({1, "expr:1"}, out));
+    ASSERT_TRUE(mgr.Get({1, "expr:2"}, out));
+
+    auto after = mgr.GetStats();
+    ASSERT_EQ(after.hits - before.hits, 3);
+    ASSERT_EQ(after.misses - before.misses, 1);
+    ASSERT_EQ(after.evictions - before.evictions, 1);
+    ASSERT_LE(mgr.GetCurrentBytes(), mgr.GetCapacityBytes());
+
+    // restore global state
+    mgr.Clear();
+    ExprResCacheManager::SetEnabled(false);
+}
+
+TEST(ExprResCacheManagerTest, AdmissionKeepsFrequentEntries) {
+    auto& mgr = ExprResCacheManager::Instance();
+    ExprResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(4300);
+
+    const size_t N = 8192;  // bits
+    auto make_value = [&]() {
+        ExprResCacheManager::Value v;
+        v.result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(N));
+        v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(N));
+        return v;
+    };
+    ExprResCacheManager::Value out;
+    for (int i = 0; i < 2; ++i) {
+        ExprResCacheManager::Key k{1, "hot:" + std::to_string(i)};
+        mgr.Put(k, make_value());
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_TRUE(mgr.Get(k, out));
+        }
+    }
+
+    // a scan of one-off filters, each looked up once before it is put
+    auto before = mgr.GetStats();
+    for (int i = 0; i < 10; ++i) {
+        ExprResCacheManager::Key k{1, "scan:" + std::to_string(i)};
+        ASSERT_FALSE(mgr.Get(k, out));
+        mgr.Put(k, make_value());
+    }
+    auto after = mgr.GetStats();
+    ASSERT_EQ(after.rejections - before.rejections, 10);
+    ASSERT_EQ(after.evictions - before.evictions, 0);
+    ASSERT_TRUE(mgr.Get({1, "hot:0"}, out));
+    ASSERT_TRUE(mgr.Get({1, "hot:1"}, out));
+
+    // restore global state
+    mgr.Clear();
+    ExprResCacheManager::SetEnabled(false);
+}
+
+TEST(ExprResCacheManagerTest, CapacitySharedAcrossShards) {
+    auto& mgr = ExprResCacheManager::Instance();
+    ExprResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(1ULL << 20);
+
+    ExprResCacheManager::Value v;
+    v.result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(1024));
+    v.valid_result = std::make_shared<milvus::TargetBitmap>(MakeDenseBits(1024));
+    for (int64_t seg = 0; seg < 64; ++seg) {
+        mgr.Put({seg, "sig"}, v);
+    }
+    ASSERT_EQ(mgr.GetEntryCount(), 64);
+
+    // shrink the capacity, entries are evicted from all shards
+    mgr.SetCapacityBytes(mgr.GetCurrentBytes() / 2);
+    ASSERT_LE(mgr.GetCurrentBytes(), mgr.GetCapacityBytes());
+    ASSERT_LT(mgr.GetEntryCount(), 64);
+
+    mgr.Clear();
+    ASSERT_EQ(mgr.GetCurrentBytes(), 0);
+    ASSERT_EQ(mgr.GetEntryCount(), 0);
+    ExprResCacheManager::SetEnabled(false);
+}
+
+TEST(ExprResCacheManagerTest, CompressedEntries) {
+    using milvus::exec::CompressedBitmap;
+    auto& mgr = ExprResCacheManager::Instance();
+    ExprResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(1ULL << 20);
+
+    const size_t N = 1 << 20;
+    auto sparse = std::make_shared<milvus::TargetBitmap>(N);
+    sparse->set(3);
+    sparse->set(N - 1);
+    auto full = std::make_shared<milvus::TargetBitmap>(MakeBits(N));
+    full->reset(100);
+
+    ExprResCacheManager::Value v;
+    v.result = sparse;
+    v.valid_result = full;
+    v.active_count = N;
+    mgr.Put({1, "sparse"}, v);
+    // a dense 1M-row entry costs 256KB, the encoded one a few bytes
+    ASSERT_LT(mgr.GetCurrentBytes(), 1024);
+
+    ExprResCacheManager::CompressedValue compressed;
+    ASSERT_TRUE(mgr.Get({1, "sparse"}, compressed));
+    ASSERT_EQ(compressed.result->encoding(),
+              CompressedBitmap::Encoding::kRoaring);
+    ASSERT_EQ(compressed.valid_result->encoding(),
+              CompressedBitmap::Encoding::kRoaring);
+
+    // AND into a caller owned batch without decoding the whole entry
+    milvus::TargetBitmap batch(MakeBits(16));
+    compressed.valid_result->AndInto(milvus::TargetBitmapView(batch), 90);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        ASSERT_EQ(batch[i], i != 10);
+    }
+
+    ExprResCacheManager::Value decoded;
+    ASSERT_TRUE(mgr.Get({1, "sparse"}, decoded));
+    ASSERT_EQ(decoded.result->size(), N);
+    ASSERT_EQ(decoded.result->count(), 2);
+    ASSERT_TRUE((*decoded.result)[3]);
+    ASSERT_TRUE((*decoded.result)[N - 1]);
+    ASSERT_EQ(decoded.valid_result->count(), N - 1);
+    ASSERT_FALSE((*decoded.valid_result)[100]);
+
+    // an entry encoded by the caller is stored as it is
+    ExprResCacheManager::CompressedValue encoded;
+    encoded.result = CompressedBitmap::Encode(sparse);
+    encoded.active_count = N;
+    mgr.Put({2, "encoded"}, encoded);
+    ExprResCacheManager::CompressedValue got;
+    ASSERT_TRUE(mgr.Get({2, "encoded"}, got));
+    ASSERT_EQ(got.result, encoded.result);
+    ASSERT_EQ(got.valid_result, nullptr);
+    ASSERT_GT(got.bytes, 0);
+
+    // restore global state
+    mgr.Clear();
+    ExprResCacheManager::SetEnabled(false);
+}
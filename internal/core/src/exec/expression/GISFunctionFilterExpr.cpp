@@ -37,11 +37,29 @@ namespace exec {
                 this->segment_->get_segment_id(), field_id_);               \
         if (geometry_cache) {                                               \
             auto cache_lock = geometry_cache->AcquireReadLock();            \
+            /* every predicate here implies overlapping envelopes, so */    \
+            /* GEOS only sees the rows whose box meets the query box */     \
+            auto query_envelope = GeometryEnvelope::Of(                     \
+                GetThreadLocalGEOSContext(), right_source.GetGeometry());   \
+            auto prefilter = !query_envelope.IsEmpty();                     \
+            std::vector<uint8_t> candidates;                                \
+            if (prefilter) {                                                \
+                candidates.resize(size);                                    \
+                geometry_cache->FilterByEnvelopeUnsafe(                     \
+                    segment_offsets,                                        \
+                    size,                                                   \
+                    query_envelope,                                         \
+                    candidates.data());                                     \
+            }                                                               \
             for (int i = 0; i < size; ++i) {                                \
                 if (valid_data != nullptr && !valid_data[i]) {              \
                     res[i] = valid_res[i] = false;                          \
                     continue;                                               \
                 }                                                           \
+                if (prefilter && !candidates[i]) {                          \
+                    res[i] = false;                                         \
+                    continue;                                               \
+                }                                                           \
                 auto absolute_offset = segment_offsets[i];                  \
                 auto cached_geometry =                                      \
                     geometry_cache->GetByOffsetUnsafe(absolute_offset);     \
@@ -212,9 +230,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
 
     if (expr_->op_ == proto::plan::GISFunctionFilterExpr_GISOp_STIsValid) {
         if (segment_->type() == SegmentType::Growing &&
-            !storage::MmapManager::GetInstance()
-                 .GetMmapConfig()
-                 .growing_enable_mmap) {
+            !GrowingStringChunkHoldsViews()) {
             GEOMETRY_EXECUTE_SUB_BATCH_UNARY(std::string, is_valid);
         } else {
             GEOMETRY_EXECUTE_SUB_BATCH_UNARY(std::string_view, is_valid);
@@ -231,9 +247,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
     switch (expr_->op_) {
         case proto::plan::GISFunctionFilterExpr_GISOp_Equals: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string, equals);
             } else {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string_view,
@@ -242,9 +256,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_Touches: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string,
                                                            touches);
             } else {
@@ -254,9 +266,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_Overlaps: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string,
                                                            overlaps);
             } else {
@@ -266,9 +276,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_Crosses: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string,
                                                            crosses);
             } else {
@@ -278,9 +286,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_Contains: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string,
                                                            contains);
             } else {
@@ -290,9 +296,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_Intersects: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string,
                                                            intersects);
             } else {
@@ -302,9 +306,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_Within: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string, within);
             } else {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON(std::string_view,
@@ -313,9 +315,7 @@ PhyGISFunctionFilterExpr::EvalForDataSegment() {
         }
         case proto::plan::GISFunctionFilterExpr_GISOp_DWithin: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 GEOMETRY_EXECUTE_SUB_BATCH_WITH_COMPARISON_DISTANCE(std::string,
                                                                     dwithin);
             } else {
@@ -10,8 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -43,7 +46,8 @@ BuildAndLoadJsonKeyStats(const std::vector<std::string>& json_strings,
                          int64_t segment_id,
                          int64_t field_id,
                          int64_t build_id,
-                         int64_t version_id) {
+                         int64_t version_id,
+                         const Config& extra_build_config = {}) {
     std::vector<milvus::Json> data;
     data.reserve(json_strings.size());
     for (const auto& s : json_strings) {
@@ -97,6 +101,9 @@ BuildAndLoadJsonKeyStats(const std::vector<std::string>& json_strings,
 
     Config build_config;
     build_config[INSERT_FILES_KEY] = std::vector<std::string>{log_path};
+    for (const auto& [key, value] : extra_build_config.items()) {
+        build_config[key] = value;
+    }
 
     auto builder = std::make_shared<JsonKeyStats>(ctx, false);
     builder->Build(build_config);
@@ -215,3 +222,169 @@ TEST(JsonContainsByStatsTest, BasicContainsAnyOnArray) {
         EXPECT_EQ(bool(result[i]), should_match);
     }
 }
+
+TEST(JsonArithByStatsTest, ArithCompareOnNumbers) {
+    auto schema = std::make_shared<Schema>();
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    auto segment = segcore::CreateSealedSegment(schema);
+
+    // ints, doubles, a missing key and a string at "a"
+    const int N = 4000;
+    std::vector<std::string> json_raw_data;
+    json_raw_data.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        switch (i % 4) {
+            case 0:
+                json_raw_data.emplace_back(fmt::format(R"({{"a": {}}})", i));
+                break;
+            case 1:
+                json_raw_data.emplace_back(
+                    fmt::format(R"({{"a": {}.5}})", i));
+                break;
+            case 2:
+                json_raw_data.emplace_back(R"({"b": 1})");
+                break;
+            case 3:
+                json_raw_data.emplace_back(R"({"a": "x"})");
+                break;
+        }
+    }
+
+    auto stats = BuildAndLoadJsonKeyStats(json_raw_data,
+                                          json_fid,
+                                          "/tmp/test-json-arith-by-stats",
+                                          1002,
+                                          2002,
+                                          3002,
+                                          json_fid.get(),
+                                          5002,
+                                          1);
+    segment->LoadJsonStats(json_fid, stats);
+
+    std::vector<milvus::Json> jsons;
+    for (auto& s : json_raw_data) {
+        jsons.emplace_back(simdjson::padded_string(s));
+    }
+    auto json_field =
+        std::make_shared<FieldData<milvus::Json>>(DataType::JSON, false);
+    json_field->add_json_data(jsons);
+    auto cm = milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+                  .GetRemoteChunkManager();
+    auto load_info = PrepareSingleFieldInsertBinlog(
+        0, 0, 0, json_fid.get(), {json_field}, cm);
+    segment->LoadFieldData(load_info);
+
+    auto check = [&](proto::plan::OpType op_type,
+                     proto::plan::ArithOpType arith_type,
+                     proto::plan::GenericValue right_operand,
+                     proto::plan::GenericValue value,
+                     std::function<bool(std::optional<double>)> expected) {
+        auto expr = std::make_shared<expr::BinaryArithOpEvalRangeExpr>(
+            expr::ColumnInfo(
+                json_fid, DataType::JSON, std::vector<std::string>{"a"}),
+            op_type,
+            arith_type,
+            value,
+            right_operand);
+        auto plan =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        auto result =
+            query::ExecuteQueryExpr(plan, segment.get(), N, MAX_TIMESTAMP);
+        ASSERT_EQ(result.size(), N);
+        for (int i = 0; i < N; ++i) {
+            std::optional<double> a;
+            if (i % 4 == 0) {
+                a = i;
+            } else if (i % 4 == 1) {
+                a = i + 0.5;
+            }
+            ASSERT_EQ(bool(result[i]), expected(a))
+                << expr->ToString() << " row " << i;
+        }
+    };
+    proto::plan::GenericValue int_value, double_value;
+
+    // integer operands keep the integer modulus
+    int_value.set_int64_val(3);
+    proto::plan::GenericValue one;
+    one.set_int64_val(1);
+    check(proto::plan::OpType::Equal,
+          proto::plan::ArithOpType::Mod,
+          int_value,
+          one,
+          [](std::optional<double> a) {
+              return a.has_value() && std::fmod(a.value(), 3) == 1;
+          });
+    int_value.set_int64_val(100);
+    check(proto::plan::OpType::GreaterThan,
+          proto::plan::ArithOpType::Add,
+          one,
+          int_value,
+          [](std::optional<double> a) {
+              return a.has_value() && a.value() + 1 > 100;
+          });
+    // rows without a number at the path are not equal
+    int_value.set_int64_val(10);
+    check(proto::plan::OpType::NotEqual,
+          proto::plan::ArithOpType::Sub,
+          one,
+          int_value,
+          [](std::optional<double> a) {
+              return !a.has_value() || a.value() - 1 != 10;
+          });
+    // a double operand computes the integers as doubles
+    double_value.set_float_val(2.0);
+    proto::plan::GenericValue limit;
+    limit.set_float_val(50.0);
+    check(proto::plan::OpType::LessThan,
+          proto::plan::ArithOpType::Mul,
+          double_value,
+          limit,
+          [](std::optional<double> a) {
+              return a.has_value() && a.value() * 2.0 < 50.0;
+          });
+}
+
+TEST(JsonKeyStatsLayoutTest, QueriedPathsReshapeLayout) {
+    const int N = 1000;
+    std::vector<std::string> json_raw_data;
+    json_raw_data.reserve(N);
+    for (int i = 0; i < N; ++i) {
+        std::string row = fmt::format(R"({{"all": {})", i);
+        if (i % 2 == 0) {
+            row += fmt::format(R"(, "common": {})", i);
+        }
+        if (i % 100 == 0) {
+            row += fmt::format(R"(, "rare": {})", i);
+        }
+        json_raw_data.push_back(row + "}");
+    }
+
+    auto build = [&](int64_t segment_id, const Config& config) {
+        return BuildAndLoadJsonKeyStats(json_raw_data,
+                                        FieldId(101),
+                                        "/tmp/test-json-stats-queried-paths",
+                                        1001,
+                                        2001,
+                                        segment_id,
+                                        101,
+                                        segment_id + 1000,
+                                        1,
+                                        config);
+    };
+
+    // the data alone shreds the frequent keys
+    auto stats = build(3001, {});
+    EXPECT_FALSE(stats->GetShreddingField("/all", JSONType::INT64).empty());
+    EXPECT_FALSE(stats->GetShreddingField("/common", JSONType::INT64).empty());
+    EXPECT_TRUE(stats->GetShreddingField("/rare", JSONType::INT64).empty());
+
+    // filters on the rare key promote it, the unread sparse key is demoted
+    Config config;
+    config[index::JSON_STATS_QUERIED_PATHS] =
+        std::string(R"({"/rare": 5, "/missing": 1})");
+    stats = build(3002, config);
+    EXPECT_FALSE(stats->GetShreddingField("/all", JSONType::INT64).empty());
+    EXPECT_TRUE(stats->GetShreddingField("/common", JSONType::INT64).empty());
+    EXPECT_FALSE(stats->GetShreddingField("/rare", JSONType::INT64).empty());
+}
@@ -15,19 +15,19 @@
 // limitations under the License.
 
 #include "JsonContainsExpr.h"
+#include "exec/TraceUtils.h"
 #include <cmath>
 #include <utility>
 #include "common/Types.h"
+#include "exec/expression/SortedSet.h"
 
 namespace milvus {
 namespace exec {
 
 void
 PhyJsonContainsFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyJsonContainsFilterExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type",
-                                 static_cast<int>(expr_->column_.data_type_));
+    tracer::LazyAutoSpan span("PhyJsonContainsFilterExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->column_.data_type_));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
@@ -44,9 +44,7 @@ PhyJsonContainsFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
                 TargetBitmap(real_batch_size, true),
                 TargetBitmap(real_batch_size, true));
         } else {
-            result = std::make_shared<ColumnVector>(
-                TargetBitmap(real_batch_size, false),
-                TargetBitmap(real_batch_size, true));
+            result = context.AllocateBitmapColumn(real_batch_size);
         }
         MoveCursor();
         return;
@@ -220,14 +218,18 @@ PhyJsonContainsFilterExpr::ExecArrayContains(EvalCtx& context) {
     AssertInfo(expr_->column_.nested_path_.size() == 0,
                "[ExecArrayContains]nested path must be null");
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
     if (!arg_inited_) {
         arg_set_ = std::make_shared<SortVectorElement<GetType>>(expr_->vals_);
+        if constexpr (!std::is_same_v<GetType, bool>) {
+            for (const auto& val : expr_->vals_) {
+                skip_values_.emplace_back(
+                    GetValueWithCastNumber<ExprValueType>(val));
+            }
+        }
         arg_inited_ = true;
     }
 
@@ -250,9 +252,24 @@ PhyJsonContainsFilterExpr::ExecArrayContains(EvalCtx& context) {
         }
         auto executor = [&](size_t i) {
             const auto& array = data[i];
-            for (int j = 0; j < array.length(); ++j) {
-                if (elements->In(array.template get_data<GetType>(j))) {
-                    return true;
+            if constexpr (std::is_same_v<GetType, bool>) {
+                for (int j = 0; j < array.length(); ++j) {
+                    if (elements->In(array.template get_data<GetType>(j))) {
+                        return true;
+                    }
+                }
+            } else {
+                // search the sorted values directly, with no variant to
+                // build and no virtual call per element
+                const auto& values =
+                    static_cast<const SortVectorElement<GetType>*>(
+                        elements.get())
+                        ->values_;
+                for (int j = 0; j < array.length(); ++j) {
+                    if (SortedContains(values,
+                                       array.template get_data<GetType>(j))) {
+                        return true;
+                    }
                 }
             }
             return false;
@@ -275,18 +292,28 @@ PhyJsonContainsFilterExpr::ExecArrayContains(EvalCtx& context) {
         processed_cursor += size;
     };
 
+    // a chunk whose elements hold none of the values has no match
+    std::function<bool(const SkipIndex&, FieldId, int)> skip_index_func;
+    if (!skip_values_.empty()) {
+        skip_index_func = [this](const SkipIndex& skip_index,
+                                 FieldId field_id,
+                                 int chunk_id) {
+            return skip_index.CanSkipIn(field_id, chunk_id, skip_values_);
+        };
+    }
+
     int64_t processed_size;
     if (has_offset_input_) {
         processed_size =
             ProcessDataByOffsets<milvus::ArrayView>(execute_sub_batch,
-                                                    std::nullptr_t{},
+                                                    skip_index_func,
                                                     input,
                                                     res,
                                                     valid_res,
                                                     arg_set_);
     } else {
         processed_size = ProcessDataChunks<milvus::ArrayView>(
-            execute_sub_batch, std::nullptr_t{}, res, valid_res, arg_set_);
+            execute_sub_batch, skip_index_func, res, valid_res, arg_set_);
     }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
@@ -318,9 +345,7 @@ PhyJsonContainsFilterExpr::ExecJsonContains(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -548,9 +573,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsArray(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -756,9 +779,7 @@ PhyJsonContainsFilterExpr::ExecArrayContainsAll(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -766,6 +787,10 @@ PhyJsonContainsFilterExpr::ExecArrayContainsAll(EvalCtx& context) {
         auto elements = std::make_shared<std::set<GetType>>();
         for (auto const& element : expr_->vals_) {
             elements->insert(GetValueWithCastNumber<GetType>(element));
+            if constexpr (!std::is_same_v<GetType, bool>) {
+                skip_values_.emplace_back(
+                    GetValueWithCastNumber<ExprValueType>(element));
+            }
         }
         arg_cached_set_ = elements;
         arg_inited_ = true;
@@ -773,10 +798,19 @@ PhyJsonContainsFilterExpr::ExecArrayContainsAll(EvalCtx& context) {
 
     auto elements =
         std::static_pointer_cast<std::set<GetType>>(arg_cached_set_);
+    // the values in order, for rows to be matched against without copying
+    // the set for each of them
+    using SortedValues =
+        std::conditional_t<std::is_same_v<GetType, bool>, int, GetType>;
+    std::vector<SortedValues> sorted_values;
+    if constexpr (!std::is_same_v<GetType, bool>) {
+        sorted_values.assign(elements->begin(), elements->end());
+    }
+    SortedSetCover<SortedValues> cover(sorted_values);
     int processed_cursor = 0;
     auto execute_sub_batch =
-        [&processed_cursor, &
-         bitmap_input ]<FilterType filter_type = FilterType::sequential>(
+        [&processed_cursor, &bitmap_input, &
+         cover ]<FilterType filter_type = FilterType::sequential>(
             const milvus::ArrayView* data,
             const bool* valid_data,
             const int32_t* offsets,
@@ -791,15 +825,25 @@ PhyJsonContainsFilterExpr::ExecArrayContainsAll(EvalCtx& context) {
             return;
         }
         auto executor = [&](size_t i) {
-            std::set<GetType> tmp_elements(elements);
-            // Note: array can only be iterated once
-            for (int j = 0; j < data[i].length(); ++j) {
-                tmp_elements.erase(data[i].template get_data<GetType>(j));
-                if (tmp_elements.size() == 0) {
-                    return true;
+            if constexpr (std::is_same_v<GetType, bool>) {
+                std::set<GetType> tmp_elements(elements);
+                // Note: array can only be iterated once
+                for (int j = 0; j < data[i].length(); ++j) {
+                    tmp_elements.erase(data[i].template get_data<GetType>(j));
+                    if (tmp_elements.size() == 0) {
+                        return true;
+                    }
                 }
+                return tmp_elements.size() == 0;
+            } else {
+                cover.Reset();
+                for (int j = 0; j < data[i].length(); ++j) {
+                    if (cover.Add(data[i].template get_data<GetType>(j))) {
+                        return true;
+                    }
+                }
+                return cover.Covered();
             }
-            return tmp_elements.size() == 0;
         };
         bool has_bitmap_input = !bitmap_input.empty();
         for (int i = 0; i < size; ++i) {
@@ -818,18 +862,28 @@ PhyJsonContainsFilterExpr::ExecArrayContainsAll(EvalCtx& context) {
         }
         processed_cursor += size;
     };
+    // a chunk whose elements miss one of the values has no match
+    std::function<bool(const SkipIndex&, FieldId, int)> skip_index_func;
+    if (!skip_values_.empty()) {
+        skip_index_func = [this](const SkipIndex& skip_index,
+                                 FieldId field_id,
+                                 int chunk_id) {
+            return skip_index.CanSkipAllOf(field_id, chunk_id, skip_values_);
+        };
+    }
+
     int64_t processed_size;
     if (has_offset_input_) {
         processed_size =
             ProcessDataByOffsets<milvus::ArrayView>(execute_sub_batch,
-                                                    std::nullptr_t{},
+                                                    skip_index_func,
                                                     input,
                                                     res,
                                                     valid_res,
                                                     *elements);
     } else {
         processed_size = ProcessDataChunks<milvus::ArrayView>(
-            execute_sub_batch, std::nullptr_t{}, res, valid_res, *elements);
+            execute_sub_batch, skip_index_func, res, valid_res, *elements);
     }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
@@ -860,9 +914,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAll(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -1100,9 +1152,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAllWithDiffType(EvalCtx& context) {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -1436,9 +1486,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAllArray(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -1649,9 +1697,7 @@ PhyJsonContainsFilterExpr::ExecJsonContainsWithDiffType(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
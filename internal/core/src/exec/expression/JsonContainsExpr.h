@@ -558,6 +558,8 @@ class PhyJsonContainsFilterExpr : public SegmentExpr {
     std::shared_ptr<MultiElement> arg_set_double_;
     std::shared_ptr<void>
         arg_cached_set_;  // For caching std::set<T> or std::vector<T>
+    // the values as skip index metrics of the array elements
+    std::vector<index::Metrics> skip_values_;
     PinWrapper<index::BsonInvertedIndex*> bson_index_{nullptr};
 };
 }  //namespace exec
@@ -24,11 +24,18 @@ PhyLikeConjunctExpr::PhyLikeConjunctExpr(
     std::vector<std::shared_ptr<PhyUnaryRangeFilterExpr>> ngram_exprs,
     milvus::OpContext* op_ctx,
     int64_t active_count,
-    int64_t batch_size)
+    int64_t batch_size,
+    int64_t start_pos)
     : Expr(DataType::BOOL, {}, "PhyLikeConjunctExpr", op_ctx),
       ngram_exprs_(std::move(ngram_exprs)),
       active_count_(active_count),
-      batch_size_(batch_size) {
+      batch_size_(batch_size),
+      current_pos_(start_pos) {
+}
+
+void
+PhyLikeConjunctExpr::MoveCursor() {
+    current_pos_ += GetNextBatchSize();
 }
 
 int64_t
@@ -35,11 +35,20 @@ class PhyLikeConjunctExpr : public Expr {
         std::vector<std::shared_ptr<PhyUnaryRangeFilterExpr>> ngram_exprs,
         milvus::OpContext* op_ctx,
         int64_t active_count,
-        int64_t batch_size);
+        int64_t batch_size,
+        int64_t start_pos);
 
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    MoveCursor() override;
+
+    void
+    SetBatchSize(int64_t batch_size) override {
+        batch_size_ = batch_size;
+    }
+
     std::string
     ToString() const override {
         return "PhyLikeConjunctExpr";
@@ -15,13 +15,14 @@
 // limitations under the License.
 
 #include "LogicalBinaryExpr.h"
+#include "exec/TraceUtils.h"
 
 namespace milvus {
 namespace exec {
 
 void
 PhyLogicalBinaryExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyLogicalBinaryExpr::Eval", tracer::GetRootSpan());
+    tracer::LazyAutoSpan span("PhyLogicalBinaryExpr::Eval");
 
     AssertInfo(
         inputs_.size() == 2,
@@ -15,13 +15,14 @@
 // limitations under the License.
 
 #include "LogicalUnaryExpr.h"
+#include "exec/TraceUtils.h"
 #include "common/ValueOp.h"
 namespace milvus {
 namespace exec {
 
 void
 PhyLogicalUnaryExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyLogicalUnaryExpr::Eval", tracer::GetRootSpan());
+    tracer::LazyAutoSpan span("PhyLogicalUnaryExpr::Eval");
 
     AssertInfo(inputs_.size() == 1,
                "logical unary expr must has one input, but now {}",
@@ -17,6 +17,7 @@
 #include "MatchExpr.h"
 #include <utility>
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "common/Types.h"
 
 namespace milvus {
@@ -192,7 +193,7 @@ DispatchMatchProcessing(bool use_offset_input,
 
 void
 PhyMatchFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyMatchFilterExpr::Eval", tracer::GetRootSpan());
+    tracer::LazyAutoSpan span("PhyMatchFilterExpr::Eval");
 
     auto input = context.get_offset_input();
     SetHasOffsetInput(input != nullptr);
@@ -49,6 +49,12 @@ class PhyMatchFilterExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetBatchSize(int64_t batch_size) override {
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
     void
     MoveCursor() override {
         if (!has_offset_input_) {
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "NullExpr.h"
+#include "exec/TraceUtils.h"
 #include <memory>
 #include <utility>
 #include "common/Array.h"
@@ -26,9 +27,8 @@ namespace exec {
 
 void
 PhyNullExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyNullExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type",
-                                 static_cast<int>(expr_->column_.data_type_));
+    tracer::LazyAutoSpan span("PhyNullExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->column_.data_type_));
 
     auto input = context.get_offset_input();
     auto data_type = expr_->column_.data_type_;
@@ -70,9 +70,7 @@ PhyNullExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
         case DataType::VARCHAR: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 result = ExecVisitorImpl<std::string>(input);
             } else {
                 result = ExecVisitorImpl<std::string_view>(input);
@@ -89,9 +87,7 @@ PhyNullExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
         case DataType::GEOMETRY: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 result = ExecVisitorImpl<std::string>(input);
             } else {
                 result = ExecVisitorImpl<std::string_view>(input);
@@ -0,0 +1,96 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace milvus {
+namespace exec {
+
+// Index of the first of the n sorted values that is not less than x. The
+// halving step is a conditional move rather than a branch, so searching
+// the elements of a row in turn costs no mispredictions.
+template <typename T>
+inline size_t
+BranchlessLowerBound(const T* values, size_t n, const T& x) {
+    if (n == 0) {
+        return 0;
+    }
+    const T* base = values;
+    while (n > 1) {
+        auto half = n / 2;
+        base = (base[half] < x) ? base + half : base;
+        n -= half;
+    }
+    return (base - values) + (*base < x);
+}
+
+template <typename T>
+inline bool
+SortedContains(const std::vector<T>& values, const T& x) {
+    auto i = BranchlessLowerBound(values.data(), values.size(), x);
+    return i < values.size() && values[i] == x;
+}
+
+// Tells whether the elements fed to Add cover every one of a sorted set of
+// unique values. Each value found is stamped with the current row, so
+// moving to the next row needs no clearing.
+template <typename T>
+class SortedSetCover {
+ public:
+    explicit SortedSetCover(const std::vector<T>& values)
+        : values_(values), stamps_(values.size(), 0) {
+    }
+
+    // starts a new row
+    void
+    Reset() {
+        if (++stamp_ == 0) {
+            std::fill(stamps_.begin(), stamps_.end(), 0);
+            stamp_ = 1;
+        }
+        covered_ = 0;
+    }
+
+    // true once every value is covered
+    bool
+    Add(const T& x) {
+        auto i = BranchlessLowerBound(values_.data(), values_.size(), x);
+        if (i < values_.size() && values_[i] == x && stamps_[i] != stamp_) {
+            stamps_[i] = stamp_;
+            ++covered_;
+        }
+        return covered_ == values_.size();
+    }
+
+    bool
+    Covered() const {
+        return covered_ == values_.size();
+    }
+
+ private:
+    const std::vector<T>& values_;
+    std::vector<uint32_t> stamps_;
+    uint32_t stamp_{0};
+    size_t covered_{0};
+};
+
+}  // namespace exec
+}  // namespace milvus
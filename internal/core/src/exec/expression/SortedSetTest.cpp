@@ -0,0 +1,68 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <string_view>
+#include <vector>
+
+#include "exec/expression/SortedSet.h"
+
+using milvus::exec::BranchlessLowerBound;
+using milvus::exec::SortedContains;
+using milvus::exec::SortedSetCover;
+
+TEST(SortedSet, LowerBound) {
+    std::mt19937 rng(42);
+    for (size_t n = 0; n < 70; ++n) {
+        std::vector<int64_t> values(n);
+        for (auto& v : values) {
+            v = rng() % 50;
+        }
+        std::sort(values.begin(), values.end());
+        for (int64_t x = -1; x <= 51; ++x) {
+            auto expected =
+                std::lower_bound(values.begin(), values.end(), x) -
+                values.begin();
+            ASSERT_EQ(BranchlessLowerBound(values.data(), n, x), expected);
+            ASSERT_EQ(SortedContains(values, x),
+                      std::binary_search(values.begin(), values.end(), x));
+        }
+    }
+}
+
+TEST(SortedSet, Cover) {
+    std::vector<std::string_view> values{"a", "c", "e"};
+    SortedSetCover<std::string_view> cover(values);
+
+    std::vector<std::vector<std::string_view>> rows{
+        {"e", "x", "a", "a", "c"}, {"a", "a", "a"}, {"c", "e"}, {}};
+    std::vector<bool> expected{true, false, false, false};
+    for (size_t i = 0; i < rows.size(); ++i) {
+        cover.Reset();
+        bool covered = false;
+        for (auto x : rows[i]) {
+            covered = cover.Add(x) || covered;
+        }
+        ASSERT_EQ(covered || cover.Covered(), expected[i]) << i;
+    }
+
+    std::vector<int64_t> none;
+    SortedSetCover<int64_t> empty(none);
+    empty.Reset();
+    ASSERT_TRUE(empty.Covered());
+}
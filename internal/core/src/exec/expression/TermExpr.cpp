@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "TermExpr.h"
+#include "exec/TraceUtils.h"
 #include <memory>
 #include <utility>
 #include "log/Log.h"
@@ -22,16 +23,18 @@
 namespace milvus {
 namespace exec {
 
+// longest list of numbers matched over a shredded JSON column with SIMD
+// equality passes, a longer one is cheaper to probe in the hash set
+constexpr size_t kMaxSimdJsonTerms = 16;
+
 void
 PhyTermFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyTermFilterExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type",
-                                 static_cast<int>(expr_->column_.data_type_));
+    tracer::LazyAutoSpan span("PhyTermFilterExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->column_.data_type_));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
-    if (is_pk_field_ && !has_offset_input_) {
+    if ((is_pk_field_ || is_partition_key_field_) && !has_offset_input_) {
         result = ExecPkTermImpl();
         return;
     }
@@ -70,9 +73,7 @@ PhyTermFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
         case DataType::VARCHAR: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 result = ExecVisitorImpl<std::string>(context);
             } else {
                 result = ExecVisitorImpl<std::string_view>(context);
@@ -143,17 +144,15 @@ template <typename T>
 bool
 PhyTermFilterExpr::CanSkipSegment() {
     const auto& skip_index = segment_->GetSkipIndex();
-    T min, max;
-    for (auto i = 0; i < expr_->vals_.size(); i++) {
-        auto val = GetValueFromProto<T>(expr_->vals_[i]);
-        max = i == 0 ? val : std::max(val, max);
-        min = i == 0 ? val : std::min(val, min);
+    std::vector<index::Metrics> vals;
+    vals.reserve(expr_->vals_.size());
+    for (const auto& val : expr_->vals_) {
+        vals.emplace_back(GetValueFromProto<T>(val));
     }
     auto can_skip = [&]() -> bool {
         bool res = false;
         for (int i = 0; i < num_data_chunk_; ++i) {
-            if (!skip_index.CanSkipBinaryRange<T>(
-                    field_id_, i, min, max, true, true)) {
+            if (!skip_index.CanSkipIn(field_id_, i, vals)) {
                 return false;
             } else {
                 res = true;
@@ -205,10 +204,31 @@ PhyTermFilterExpr::InitPkCacheOffset() {
     cached_bits_inited_ = true;
 }
 
+void
+PhyTermFilterExpr::InitPartitionKeyCacheOffset() {
+    std::vector<PkType> keys;
+    keys.reserve(expr_->vals_.size());
+    for (const auto& val : expr_->vals_) {
+        if (field_type_ == DataType::INT64) {
+            keys.emplace_back(GetValueFromProto<int64_t>(val));
+        } else {
+            keys.emplace_back(GetValueFromProto<std::string>(val));
+        }
+    }
+    cached_bits_.resize(active_count_, false);
+    auto cache_view = cached_bits_.view();
+    segment_->partition_key_rows(op_ctx_, field_id_, keys, cache_view);
+    cached_bits_inited_ = true;
+}
+
 VectorPtr
 PhyTermFilterExpr::ExecPkTermImpl() {
     if (!cached_bits_inited_) {
-        InitPkCacheOffset();
+        if (is_pk_field_) {
+            InitPkCacheOffset();
+        } else {
+            InitPartitionKeyCacheOffset();
+        }
     }
 
     auto real_batch_size = GetNextBatchSize();
@@ -266,9 +286,7 @@ PhyTermFilterExpr::ExecTermArrayVariableInField(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -360,9 +378,7 @@ PhyTermFilterExpr::ExecTermArrayFieldInVariable(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -462,9 +478,7 @@ PhyTermFilterExpr::ExecTermJsonVariableInField(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -605,11 +619,53 @@ PhyTermFilterExpr::ExecJsonInVariableByStats() {
             auto target_field = index->GetShreddingField(pointer, json_type);
             if (!target_field.empty()) {
                 using ColType = decltype(GetType);
-                auto shredding_executor = [this](const ColType* src,
-                                                 const bool* valid,
-                                                 size_t size,
-                                                 TargetBitmapView res,
-                                                 TargetBitmapView valid_res) {
+                // a short list of numbers is matched with one SIMD equality
+                // pass per value instead of a hash lookup per row
+                std::vector<ColType> simd_terms;
+                if constexpr (std::is_same_v<ColType, double>) {
+                    simd_terms = std::static_pointer_cast<SetElement<double>>(
+                                     arg_set_double_)
+                                     ->GetElements();
+                } else if constexpr (std::is_same_v<ColType, int64_t> &&
+                                     std::is_same_v<ValueType, int64_t>) {
+                    simd_terms = std::static_pointer_cast<SetElement<int64_t>>(
+                                     arg_set_)
+                                     ->GetElements();
+                }
+                if (simd_terms.size() > kMaxSimdJsonTerms) {
+                    simd_terms.clear();
+                }
+                auto shredding_executor = [this, &simd_terms](
+                                              const ColType* src,
+                                              const bool* valid,
+                                              size_t size,
+                                              TargetBitmapView res,
+                                              TargetBitmapView valid_res) {
+                    if constexpr (std::is_same_v<ColType, int64_t> ||
+                                  std::is_same_v<ColType, double>) {
+                        if (!simd_terms.empty()) {
+                            res.inplace_compare_val<ColType>(
+                                src,
+                                size,
+                                simd_terms[0],
+                                milvus::bitset::CompareOpType::EQ);
+                            for (size_t t = 1; t < simd_terms.size(); ++t) {
+                                res.inplace_compare_val_or<ColType>(
+                                    src,
+                                    size,
+                                    simd_terms[t],
+                                    milvus::bitset::CompareOpType::EQ);
+                            }
+                            if (valid != nullptr) {
+                                for (size_t i = 0; i < size; ++i) {
+                                    if (!valid[i]) {
+                                        res[i] = valid_res[i] = false;
+                                    }
+                                }
+                            }
+                            return;
+                        }
+                    }
                     for (size_t i = 0; i < size; ++i) {
                         if (valid != nullptr && !valid[i]) {
                             res[i] = valid_res[i] = false;
@@ -622,10 +678,34 @@ PhyTermFilterExpr::ExecJsonInVariableByStats() {
                         }
                     }
                 };
+                // the double column is tested with the double copy of the
+                // list, so int64 lists prune it too
+                std::function<bool(const SkipIndex&, FieldId, int)> skip_func;
+                if constexpr (!std::is_same_v<ColType, bool>) {
+                    auto in_values =
+                        std::make_shared<std::vector<index::Metrics>>();
+                    if constexpr (std::is_same_v<ColType, double>) {
+                        *in_values = SkipIndex::ToMetrics(
+                            std::static_pointer_cast<SetElement<double>>(
+                                arg_set_double_)
+                                ->GetElements());
+                    } else {
+                        *in_values = SkipIndex::ToMetrics(
+                            std::static_pointer_cast<SetElement<ValueType>>(
+                                arg_set_)
+                                ->GetElements());
+                    }
+                    skip_func = [in_values](const SkipIndex& skip_index,
+                                            FieldId field_id,
+                                            int chunk_id) {
+                        return skip_index.CanSkipIn(
+                            field_id, chunk_id, *in_values);
+                    };
+                }
                 index->ExecutorForShreddingData<ColType>(op_ctx_,
                                                          target_field,
                                                          shredding_executor,
-                                                         nullptr,
+                                                         skip_func,
                                                          res_view,
                                                          valid_res_view);
                 LOG_DEBUG("using shredding data's field: {} count {}",
@@ -741,9 +821,7 @@ PhyTermFilterExpr::ExecTermJsonFieldInVariable(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -943,13 +1021,11 @@ PhyTermFilterExpr::ExecVisitorImplForData(EvalCtx& context) {
         return nullptr;
     }
 
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
-    if (!arg_inited_) {
+    auto get_vals = [this]() {
         std::vector<T> vals;
         for (auto& val : expr_->vals_) {
             // Integral overflow process
@@ -960,10 +1036,28 @@ PhyTermFilterExpr::ExecVisitorImplForData(EvalCtx& context) {
                 vals.emplace_back(converted_val);
             }
         }
+        return vals;
+    };
+    if (!arg_inited_) {
+        auto vals = get_vals();
+        skip_in_values_ = SkipIndex::ToMetrics(vals);
         arg_set_ = std::make_shared<SetElement<T>>(vals);
         arg_inited_ = true;
     }
 
+    if constexpr (std::is_same_v<T, std::string> ||
+                  (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)) {
+        auto index = !expr_->column_.element_level_
+                         ? GetGrowingScalarIndex<T>()
+                         : nullptr;
+        if (index != nullptr &&
+            index->In(
+                get_vals(), current_data_global_pos_, real_batch_size, res)) {
+            MoveCursor();
+            return res_vec;
+        }
+    }
+
     int processed_cursor = 0;
     auto execute_sub_batch =
         [&processed_cursor, &
@@ -999,12 +1093,12 @@ PhyTermFilterExpr::ExecVisitorImplForData(EvalCtx& context) {
         processed_cursor += size;
     };
 
-    auto set = std::static_pointer_cast<SetElement<T>>(arg_set_);
-    auto skip_index_func =
-        [set](const SkipIndex& skip_index, FieldId field_id, int64_t chunk_id) {
-            return skip_index.CanSkipInQuery<T>(
-                field_id, chunk_id, set->GetElements());
-        };
+    // every value of the list is tested against the chunk metrics
+    auto skip_index_func = [this](const SkipIndex& skip_index,
+                                  FieldId field_id,
+                                  int64_t chunk_id) {
+        return skip_index.CanSkipIn(field_id, chunk_id, skip_in_values_);
+    };
 
     int64_t processed_size;
     if (has_offset_input_) {
@@ -1030,8 +1124,27 @@ PhyTermFilterExpr::ExecVisitorImplForData(EvalCtx& context) {
             processed_size = ProcessDataChunksForElementLevel<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, arg_set_);
         } else {
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                if (bitmap_input.empty()) {
+                    dict_match_func_ = [&](const std::string_view* dict,
+                                           int64_t size,
+                                           TargetBitmapView dict_res,
+                                           TargetBitmapView dict_valid_res) {
+                        auto cursor = processed_cursor;
+                        execute_sub_batch(dict,
+                                          nullptr,
+                                          nullptr,
+                                          size,
+                                          dict_res,
+                                          dict_valid_res,
+                                          arg_set_);
+                        processed_cursor = cursor;
+                    };
+                }
+            }
             processed_size = ProcessDataChunks<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, arg_set_);
+            dict_match_func_ = nullptr;
         }
     }
     AssertInfo(processed_size == real_batch_size,
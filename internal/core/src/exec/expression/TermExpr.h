@@ -100,6 +100,10 @@ class PhyTermFilterExpr : public SegmentExpr {
     void
     InitPkCacheOffset();
 
+    // the rows of the terms of a partition key field, kept by the segment
+    void
+    InitPartitionKeyCacheOffset();
+
     template <typename T>
     bool
     CanSkipSegment();
@@ -155,6 +159,8 @@ class PhyTermFilterExpr : public SegmentExpr {
     bool arg_inited_{false};
     std::shared_ptr<MultiElement> arg_set_;
     std::shared_ptr<MultiElement> arg_set_double_;
+    // arg_set_ as skip index metrics, converted once for all chunks
+    std::vector<index::Metrics> skip_in_values_;
     SingleElement arg_val_;
     int32_t consistency_level_ = 0;
     PinWrapper<index::BsonInvertedIndex*> bson_index_{nullptr};
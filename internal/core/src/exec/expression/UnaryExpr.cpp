@@ -15,10 +15,13 @@
 // limitations under the License.
 
 #include "UnaryExpr.h"
+#include "exec/TraceUtils.h"
+#include <functional>
 #include <optional>
 #include <boost/regex.hpp>
 #include "common/EasyAssert.h"
 #include "common/Json.h"
+#include "common/JsonPath.h"
 #include "common/Types.h"
 #include "exec/expression/ExprCache.h"
 #include "common/type_c.h"
@@ -28,6 +31,108 @@
 
 namespace milvus {
 namespace exec {
+namespace {
+
+bool
+IsJsonBatchCompareOp(proto::plan::OpType op_type) {
+    switch (op_type) {
+        case proto::plan::GreaterThan:
+        case proto::plan::GreaterEqual:
+        case proto::plan::LessThan:
+        case proto::plan::LessEqual:
+        case proto::plan::Equal:
+        case proto::plan::NotEqual:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// rows missing the value compare false, but for NotEqual true, and
+// skipped rows keep their bits
+template <typename T, typename Cmp>
+void
+CompareJsonBatch(const JsonBatch<T>& batch,
+                 const T& val,
+                 Cmp cmp,
+                 bool missing,
+                 TargetBitmapView res) {
+    for (size_t i = 0; i < batch.kinds.size(); ++i) {
+        switch (batch.kinds[i]) {
+            case JsonBatch<T>::kValue:
+                res[i] = cmp(batch.values[i], val);
+                break;
+            case JsonBatch<T>::kDouble:
+                res[i] = cmp(batch.doubles[i], val);
+                break;
+            case JsonBatch<T>::kMissing:
+                res[i] = missing;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+template <typename T>
+void
+CompareJsonBatch(const JsonBatch<T>& batch,
+                 const T& val,
+                 proto::plan::OpType op_type,
+                 TargetBitmapView res) {
+    switch (op_type) {
+        case proto::plan::GreaterThan:
+            return CompareJsonBatch(batch, val, std::greater<>{}, false, res);
+        case proto::plan::GreaterEqual:
+            return CompareJsonBatch(
+                batch, val, std::greater_equal<>{}, false, res);
+        case proto::plan::LessThan:
+            return CompareJsonBatch(batch, val, std::less<>{}, false, res);
+        case proto::plan::LessEqual:
+            return CompareJsonBatch(batch, val, std::less_equal<>{}, false, res);
+        case proto::plan::Equal:
+            return CompareJsonBatch(batch, val, std::equal_to<>{}, false, res);
+        case proto::plan::NotEqual:
+            return CompareJsonBatch(
+                batch, val, std::not_equal_to<>{}, true, res);
+        default:
+            ThrowInfo(OpTypeInvalid,
+                      "unsupported operator type for json batch compare: {}",
+                      op_type);
+    }
+}
+
+// the value every row of a default value field holds, or std::nullopt if
+// the field has no default and its rows are null
+template <typename T>
+std::optional<T>
+DefaultValueOf(const FieldMeta& field_meta) {
+    auto value = field_meta.default_value();
+    if (!value.has_value()) {
+        return std::nullopt;
+    }
+    if constexpr (std::is_same_v<T, bool>) {
+        return value->bool_data();
+    } else if constexpr (std::is_same_v<T, int8_t> ||
+                         std::is_same_v<T, int16_t> ||
+                         std::is_same_v<T, int32_t>) {
+        return static_cast<T>(value->int_data());
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+        return field_meta.get_data_type() == DataType::TIMESTAMPTZ
+                   ? value->timestamptz_data()
+                   : value->long_data();
+    } else if constexpr (std::is_same_v<T, float>) {
+        return value->float_data();
+    } else if constexpr (std::is_same_v<T, double>) {
+        return value->double_data();
+    } else {
+        static_assert(std::is_same_v<T, std::string>);
+        return value->string_data();
+    }
+}
+
+}  // namespace
+
 template <typename T>
 bool
 PhyUnaryRangeFilterExpr::CanUseIndexForArray() {
@@ -155,11 +260,9 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplArrayForIndex<proto::plan::Array>(
 
 void
 PhyUnaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span(
-        "PhyUnaryRangeFilterExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type",
-                                 static_cast<int>(expr_->column_.data_type_));
-    span.GetSpan()->SetAttribute("op_type", static_cast<int>(expr_->op_type_));
+    tracer::LazyAutoSpan span("PhyUnaryRangeFilterExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->column_.data_type_));
+    span.SetAttribute("op_type", static_cast<int>(expr_->op_type_));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
@@ -202,9 +305,7 @@ PhyUnaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
         }
         case DataType::VARCHAR: {
             if (segment_->type() == SegmentType::Growing &&
-                !storage::MmapManager::GetInstance()
-                     .GetMmapConfig()
-                     .growing_enable_mmap) {
+                !GrowingStringChunkHoldsViews()) {
                 result = ExecRangeVisitorImpl<std::string>(context);
             } else {
                 result = ExecRangeVisitorImpl<std::string_view>(context);
@@ -326,9 +427,7 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplArray(EvalCtx& context) {
     if (real_batch_size == 0) {
         return nullptr;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -681,6 +780,16 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
         CanUseJsonStats(context, field_id, expr_->column_.nested_path_)) {
         return ExecRangeVisitorImplJsonByStats<ExprValueType>();
     }
+    if constexpr (!std::is_same_v<ExprValueType, proto::plan::Array>) {
+        if (!has_offset_input_) {
+            auto growing_stats = GetGrowingJsonStats(
+                context, field_id, expr_->column_.nested_path_);
+            if (growing_stats != nullptr) {
+                return ExecRangeVisitorImplJsonByGrowingStats<ExprValueType>(
+                    *growing_stats);
+            }
+        }
+    }
 
     auto real_batch_size =
         has_offset_input_ ? input->size() : GetNextBatchSize();
@@ -692,9 +801,7 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
         value_arg_.SetValue<ExprValueType>(expr_->val_);
         arg_inited_ = true;
     }
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
 
@@ -732,9 +839,13 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
         res[i] = (cmp);                                             \
     } while (false)
 
+    // scalar comparisons read the path of a sub batch into columns first,
+    // then compare them in one pass
+    JsonPath json_path(expr_->column_.nested_path_);
+    JsonBatch<GetType> json_batch;
     int processed_cursor = 0;
     auto execute_sub_batch =
-        [ op_type, pointer, &processed_cursor, &
+        [ op_type, pointer, &json_path, &json_batch, &processed_cursor, &
           bitmap_input ]<FilterType filter_type = FilterType::sequential>(
             const milvus::Json* data,
             const bool* valid_data,
@@ -744,6 +855,35 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
             TargetBitmapView valid_res,
             ExprValueType val) {
         bool has_bitmap_input = !bitmap_input.empty();
+        if constexpr (std::is_same_v<GetType, bool> ||
+                      std::is_same_v<GetType, int64_t> ||
+                      std::is_same_v<GetType, double>) {
+            if (IsJsonBatchCompareOp(op_type)) {
+                const bool not_equal = op_type == proto::plan::NotEqual;
+                json_path.Extract(
+                    size,
+                    [&](int64_t i) -> const milvus::Json* {
+                        auto offset = i;
+                        if constexpr (filter_type == FilterType::random) {
+                            offset = (offsets) ? offsets[i] : i;
+                        }
+                        if (valid_data != nullptr && !valid_data[offset]) {
+                            res[i] = not_equal;
+                            valid_res[i] = false;
+                            return nullptr;
+                        }
+                        if (has_bitmap_input &&
+                            !bitmap_input[i + processed_cursor]) {
+                            return nullptr;
+                        }
+                        return &data[offset];
+                    },
+                    json_batch);
+                CompareJsonBatch(json_batch, val, op_type, res);
+                processed_cursor += size;
+                return;
+            }
+        }
         switch (op_type) {
             case proto::plan::GreaterThan: {
                 for (size_t i = 0; i < size; ++i) {
@@ -916,9 +1056,7 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson(EvalCtx& context) {
                 break;
             }
             case proto::plan::Match: {
-                PatternMatchTranslator translator;
-                auto regex_pattern = translator(val);
-                RegexMatcher matcher(regex_pattern);
+                LikePatternMatcher matcher(val);
                 for (size_t i = 0; i < size; ++i) {
                     auto offset = i;
                     if constexpr (filter_type == FilterType::random) {
@@ -1032,10 +1170,22 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJsonByStats() {
                 using ValType = decltype(ValType);
                 ShreddingExecutor<ColType, ValType> executor(
                     op_type, pointer, val);
+                // the executor compares in the column's type too
+                std::function<bool(const SkipIndex&, FieldId, int)> skip_func;
+                if constexpr (!std::is_same_v<ColType, bool>) {
+                    if (array_index == INVALID_ARRAY_INDEX) {
+                        skip_func = [op_type, &val](const SkipIndex& skip_index,
+                                                    FieldId field_id,
+                                                    int chunk_id) {
+                            return skip_index.CanSkipUnaryRange<ColType>(
+                                field_id, chunk_id, op_type, ColType(val));
+                        };
+                    }
+                }
                 index->ExecutorForShreddingData<ColType>(op_ctx_,
                                                          target_field,
                                                          executor,
-                                                         nullptr,
+                                                         skip_func,
                                                          res_view,
                                                          valid_res_view);
                 LOG_DEBUG(
@@ -1291,6 +1441,100 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJsonByStats() {
                                           TargetBitmap(real_batch_size, true));
 }
 
+template <typename ExprValueType>
+VectorPtr
+PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJsonByGrowingStats(
+    const index::GrowingJsonKeyStats& stats) {
+    using GetType =
+        std::conditional_t<std::is_same_v<ExprValueType, std::string>,
+                           std::string_view,
+                           ExprValueType>;
+    auto real_batch_size = GetNextBatchSize();
+    if (real_batch_size == 0) {
+        return nullptr;
+    }
+
+    auto pointer = milvus::index::JsonPointer(expr_->column_.nested_path_);
+    ExprValueType val = GetValueFromProto<ExprValueType>(expr_->val_);
+    // for NotEqual: compute Equal and flip the result, like the sealed stats
+    auto op_type = (expr_->op_type_ == proto::plan::OpType::NotEqual)
+                       ? proto::plan::OpType::Equal
+                       : expr_->op_type_;
+    auto offset = current_data_global_pos_;
+
+    auto res_vec =
+        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
+                                       TargetBitmap(real_batch_size, true));
+    TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
+    TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
+
+    // every column covers all the rows, rows without a value of its type are
+    // invalid there, so the columns are evaluated apart and OR-ed
+    auto try_execute = [&](milvus::index::JSONType json_type,
+                           auto col_type,
+                           auto val_type) {
+        if (!stats.HasColumn(pointer, json_type)) {
+            return;
+        }
+        using ColType = decltype(col_type);
+        using ValueType = decltype(val_type);
+        TargetBitmap col_res(real_batch_size, false);
+        TargetBitmap col_valid(real_batch_size, true);
+        if constexpr (std::is_same_v<ColType, int64_t> &&
+                      std::is_same_v<ValueType, double>) {
+            // compare in double like the raw path, not in the column's type
+            ShreddingExecutor<double, double> executor(op_type, pointer, val);
+            std::vector<double> values;
+            stats.ExecutorForShreddingData<int64_t>(
+                pointer,
+                json_type,
+                offset,
+                real_batch_size,
+                [&executor, &values](const int64_t* src,
+                                     const bool* valid,
+                                     size_t size,
+                                     TargetBitmapView res,
+                                     TargetBitmapView valid_res) {
+                    values.assign(src, src + size);
+                    executor(values.data(), valid, size, res, valid_res);
+                },
+                TargetBitmapView(col_res),
+                TargetBitmapView(col_valid));
+        } else {
+            ShreddingExecutor<ColType, ValueType> executor(
+                op_type, pointer, val);
+            stats.ExecutorForShreddingData<ColType>(
+                pointer,
+                json_type,
+                offset,
+                real_batch_size,
+                executor,
+                TargetBitmapView(col_res),
+                TargetBitmapView(col_valid));
+        }
+        res.inplace_or(col_res, real_batch_size);
+    };
+
+    if constexpr (std::is_same_v<GetType, bool>) {
+        try_execute(milvus::index::JSONType::BOOL, bool{}, bool{});
+    } else if constexpr (std::is_same_v<GetType, int64_t>) {
+        try_execute(milvus::index::JSONType::INT64, int64_t{}, int64_t{});
+        try_execute(milvus::index::JSONType::DOUBLE, double{}, int64_t{});
+    } else if constexpr (std::is_same_v<GetType, double>) {
+        try_execute(milvus::index::JSONType::DOUBLE, double{}, double{});
+        try_execute(milvus::index::JSONType::INT64, int64_t{}, double{});
+    } else {
+        try_execute(milvus::index::JSONType::STRING, GetType{}, GetType{});
+    }
+
+    if (expr_->op_type_ == proto::plan::OpType::NotEqual) {
+        res.flip();
+    }
+    stats.ApplyRowValid(offset, real_batch_size, res, valid_res);
+    MoveCursor();
+    return res_vec;
+}
+
 template <typename T>
 VectorPtr
 PhyUnaryRangeFilterExpr::ExecRangeVisitorImpl(EvalCtx& context) {
@@ -1311,8 +1555,12 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImpl(EvalCtx& context) {
         }
     }
 
-    if (!has_offset_input_ && is_pk_field_ && IsCompareOp(expr_->op_type_)) {
-        if (pk_type_ == DataType::VARCHAR) {
+    auto is_equality = expr_->op_type_ == proto::plan::Equal ||
+                       expr_->op_type_ == proto::plan::NotEqual;
+    if (!has_offset_input_ &&
+        ((is_pk_field_ && IsCompareOp(expr_->op_type_)) ||
+         (is_partition_key_field_ && is_equality))) {
+        if (field_type_ == DataType::VARCHAR) {
             return ExecRangeVisitorImplForPk<std::string_view>(context);
         } else {
             return ExecRangeVisitorImplForPk<int64_t>(context);
@@ -1353,11 +1601,19 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForPk(EvalCtx& context) {
 
         auto op_type = expr_->op_type_;
         PkType pk = value_arg_.GetValue<IndexInnerType>();
+        auto range = [&](proto::plan::OpType op) {
+            if (is_pk_field_) {
+                segment_->pk_range(op_ctx_, op, pk, cache_view);
+            } else {
+                segment_->partition_key_rows(
+                    op_ctx_, field_id_, {pk}, cache_view);
+            }
+        };
         if (op_type == proto::plan::NotEqual) {
-            segment_->pk_range(op_ctx_, proto::plan::Equal, pk, cache_view);
+            range(proto::plan::Equal);
             cache_view.flip();
         } else {
-            segment_->pk_range(op_ctx_, op_type, pk, cache_view);
+            range(op_type);
         }
     }
 
@@ -1549,13 +1805,27 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
         arg_inited_ = true;
     }
     IndexInnerType val = GetValueFromProto<IndexInnerType>(expr_->val_);
-    auto res_vec =
-        std::make_shared<ColumnVector>(TargetBitmap(real_batch_size, false),
-                                       TargetBitmap(real_batch_size, true));
+    auto res_vec = context.AllocateBitmapColumn(real_batch_size);
     TargetBitmapView res(res_vec->GetRawData(), real_batch_size);
     TargetBitmapView valid_res(res_vec->GetValidRawData(), real_batch_size);
     auto expr_type = expr_->op_type_;
 
+    if constexpr (std::is_same_v<T, std::string> ||
+                  (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)) {
+        auto index = IsCompareOp(expr_type) && !expr_->column_.element_level_
+                         ? GetGrowingScalarIndex<T>()
+                         : nullptr;
+        if (index != nullptr &&
+            index->Query(expr_type,
+                         val,
+                         current_data_global_pos_,
+                         real_batch_size,
+                         res)) {
+            MoveCursor();
+            return res_vec;
+        }
+    }
+
     size_t processed_cursor = 0;
     auto execute_sub_batch =
         [ expr_type, &processed_cursor, &
@@ -1713,6 +1983,37 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
         processed_cursor += size;
     };
 
+    if (is_default_value_field_ && !has_offset_input_ &&
+        bitmap_input.empty() && !expr_->column_.element_level_) {
+        // all rows hold the same value, so the predicate is evaluated once
+        // and its result filled in without reading any chunk
+        auto value =
+            DefaultValueOf<IndexInnerType>(segment_->get_schema()[field_id_]);
+        if (value.has_value()) {
+            T row(value.value());
+            TargetBitmap row_res(1);
+            TargetBitmap row_valid_res(1, true);
+            execute_sub_batch(&row,
+                              nullptr,
+                              nullptr,
+                              1,
+                              TargetBitmapView(row_res),
+                              TargetBitmapView(row_valid_res),
+                              val);
+            if (row_res[0]) {
+                res.set();
+            } else {
+                res.reset();
+            }
+            valid_res.set();
+        } else {
+            res.reset();
+            valid_res.reset();
+        }
+        MoveCursor();
+        return res_vec;
+    }
+
     auto skip_index_func = [expr_type, val](const SkipIndex& skip_index,
                                             FieldId field_id,
                                             int64_t chunk_id) {
@@ -1736,8 +2037,36 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData(EvalCtx& context) {
             processed_size = ProcessDataChunksForElementLevel<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val);
         } else {
+            if (!candidate_pages_func_) {
+                candidate_pages_func_ = [expr_type, val](
+                                            const SkipIndex& skip_index,
+                                            FieldId field_id,
+                                            int64_t chunk_id) {
+                    return skip_index.GetCandidatePagesUnaryRange<T>(
+                        field_id, chunk_id, expr_type, val);
+                };
+            }
+            if constexpr (std::is_same_v<T, std::string_view>) {
+                if (bitmap_input.empty()) {
+                    dict_match_func_ = [&](const std::string_view* dict,
+                                           int64_t size,
+                                           TargetBitmapView dict_res,
+                                           TargetBitmapView dict_valid_res) {
+                        auto cursor = processed_cursor;
+                        execute_sub_batch(dict,
+                                          nullptr,
+                                          nullptr,
+                                          size,
+                                          dict_res,
+                                          dict_valid_res,
+                                          val);
+                        processed_cursor = cursor;
+                    };
+                }
+            }
             processed_size = ProcessDataChunks<T>(
                 execute_sub_batch, skip_index_func, res, valid_res, val);
+            dict_match_func_ = nullptr;
         }
     }
     AssertInfo(processed_size == real_batch_size,
@@ -1808,21 +2137,23 @@ PhyUnaryRangeFilterExpr::ExecTextMatch() {
     }
     auto op_type = expr_->op_type_;
 
-    // Process-level LRU cache lookup by (segment_id, expr signature)
-    if (cached_match_res_ == nullptr &&
-        exec::ExprResCacheManager::IsEnabled() &&
-        segment_->type() == SegmentType::Sealed) {
+    // Process-level LRU cache lookup by (segment_id, expr signature), the
+    // encoded entry is kept and decoded a batch at a time
+    bool use_res_cache = exec::ExprResCacheManager::IsEnabled() &&
+                         segment_->type() == SegmentType::Sealed;
+    if (cached_match_encoded_ == nullptr && cached_match_res_ == nullptr &&
+        use_res_cache) {
         exec::ExprResCacheManager::Key key{segment_->get_segment_id(),
                                            this->ToString()};
-        exec::ExprResCacheManager::Value v;
+        exec::ExprResCacheManager::CompressedValue v;
         if (exec::ExprResCacheManager::Instance().Get(key, v)) {
-            cached_match_res_ = v.result;
-            cached_index_chunk_valid_res_ = v.valid_result;
-            AssertInfo(cached_match_res_->size() == active_count_,
+            AssertInfo(v.result->size() == active_count_,
                        "internal error: expr res cache size {} not equal "
                        "expect active count {}",
-                       cached_match_res_->size(),
+                       v.result->size(),
                        active_count_);
+            cached_match_encoded_ = v.result;
+            cached_match_valid_encoded_ = v.valid_result;
         }
     }
 
@@ -1852,7 +2183,7 @@ PhyUnaryRangeFilterExpr::ExecTextMatch() {
         return nullptr;
     }
 
-    if (cached_match_res_ == nullptr) {
+    if (cached_match_encoded_ == nullptr && cached_match_res_ == nullptr) {
         auto pw = segment_->GetTextIndex(op_ctx_, field_id_);
         auto index = pw.get();
         auto res = std::move(func(index, query));
@@ -1868,26 +2199,42 @@ PhyUnaryRangeFilterExpr::ExecTextMatch() {
             cached_index_chunk_valid_res_->append(tail);
         }
 
-        // Insert into process-level cache
-        if (exec::ExprResCacheManager::IsEnabled() &&
-            segment_->type() == SegmentType::Sealed) {
+        // Insert into process-level cache, the batches then read the same
+        // encoded bits a later hit would
+        if (use_res_cache) {
             exec::ExprResCacheManager::Key key{segment_->get_segment_id(),
                                                this->ToString()};
-            exec::ExprResCacheManager::Value v;
-            v.result = cached_match_res_;
-            v.valid_result = cached_index_chunk_valid_res_;
+            exec::ExprResCacheManager::CompressedValue v;
+            v.result = CompressedBitmap::Encode(cached_match_res_);
+            v.valid_result =
+                CompressedBitmap::Encode(cached_index_chunk_valid_res_);
             v.active_count = active_count_;
             exec::ExprResCacheManager::Instance().Put(key, v);
+            cached_match_encoded_ = std::move(v.result);
+            cached_match_valid_encoded_ = std::move(v.valid_result);
+            cached_match_res_ = nullptr;
+            cached_index_chunk_valid_res_ = nullptr;
         }
     }
 
     TargetBitmap result;
     TargetBitmap valid_result;
-    result.append(
-        *cached_match_res_, current_data_global_pos_, real_batch_size);
-    valid_result.append(*cached_index_chunk_valid_res_,
-                        current_data_global_pos_,
-                        real_batch_size);
+    if (cached_match_encoded_ != nullptr) {
+        result.resize(real_batch_size);
+        cached_match_encoded_->DecodeInto(TargetBitmapView(result),
+                                          current_data_global_pos_);
+        valid_result.resize(real_batch_size, true);
+        if (cached_match_valid_encoded_ != nullptr) {
+            cached_match_valid_encoded_->DecodeInto(
+                TargetBitmapView(valid_result), current_data_global_pos_);
+        }
+    } else {
+        result.append(
+            *cached_match_res_, current_data_global_pos_, real_batch_size);
+        valid_result.append(*cached_index_chunk_valid_res_,
+                            current_data_global_pos_,
+                            real_batch_size);
+    }
     MoveCursor();
     return std::make_shared<ColumnVector>(std::move(result),
                                           std::move(valid_result));
@@ -24,6 +24,7 @@
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "common/Vector.h"
+#include "exec/expression/CompressedBitmap.h"
 #include "exec/expression/Expr.h"
 #include "exec/expression/Element.h"
 #include "index/Meta.h"
@@ -68,9 +69,7 @@ UnaryCompare(const T& get_value, const U& val, proto::plan::OpType op_type) {
         case proto::plan::Match:
             if constexpr (std::is_same_v<U, std::string> ||
                           std::is_same_v<U, std::string_view>) {
-                PatternMatchTranslator translator;
-                auto regex_pattern = translator(val);
-                RegexMatcher matcher(regex_pattern);
+                LikePatternMatcher matcher(val);
                 return matcher(get_value);
             } else {
                 return false;
@@ -95,9 +94,7 @@ struct UnaryElementFuncForMatch {
             "this override operator() of UnaryElementFuncForMatch does "
             "not support FilterType::random");
 
-        PatternMatchTranslator translator;
-        auto regex_pattern = translator(val);
-        RegexMatcher matcher(regex_pattern);
+        LikePatternMatcher matcher(val);
 
         for (int i = 0; i < size; ++i) {
             res[i] = matcher(src[i]);
@@ -112,9 +109,7 @@ struct UnaryElementFuncForMatch {
                const TargetBitmap& bitmap_input,
                int start_cursor,
                const int32_t* offsets = nullptr) {
-        PatternMatchTranslator translator;
-        auto regex_pattern = translator(val);
-        RegexMatcher matcher(regex_pattern);
+        LikePatternMatcher matcher(val);
         bool has_bitmap_input = !bitmap_input.empty();
         for (int i = 0; i < size; ++i) {
             if (has_bitmap_input && !bitmap_input[i + start_cursor]) {
@@ -296,6 +291,18 @@ struct UnaryElementFunc {
             return;
         }
 
+        // the compare runs on the blocks holding undecided rows only, the
+        // data of the others is not read
+        if constexpr (filter_type == FilterType::sequential) {
+            auto compare_block = [&](size_t begin, size_t n) {
+                (*this)(src + begin, n, res + begin, val);
+            };
+            if (ForEachActiveBlock(
+                    bitmap_input, start_cursor, size, compare_block)) {
+                return;
+            }
+        }
+
         if constexpr (op == proto::plan::OpType::Equal) {
             res.inplace_compare_val<T, milvus::bitset::CompareOpType::EQ>(
                 src, size, val);
@@ -409,9 +416,7 @@ struct UnaryElementFuncForArray {
                         res[i] = false;
                         continue;
                     }
-                    PatternMatchTranslator translator;
-                    auto regex_pattern = translator(val);
-                    RegexMatcher matcher(regex_pattern);
+                    LikePatternMatcher matcher(val);
                     auto array_data =
                         src[offset].template get_data<GetType>(index);
                     res[i] = matcher(array_data);
@@ -467,9 +472,7 @@ struct UnaryIndexFuncForMatch {
                 }
                 return res;
             } else {
-                PatternMatchTranslator translator;
-                auto regex_pattern = translator(val);
-                RegexMatcher matcher(regex_pattern);
+                LikePatternMatcher matcher(val);
                 for (int64_t i = 0; i < cnt; i++) {
                     auto raw = index->Reverse_Lookup(i);
                     if (!raw.has_value()) {
@@ -611,9 +614,7 @@ BatchUnaryCompare(const T* src,
         case proto::plan::Match: {
             if constexpr (std::is_same_v<U, std::string> ||
                           std::is_same_v<U, std::string_view>) {
-                PatternMatchTranslator translator;
-                auto regex_pattern = translator(val);
-                RegexMatcher matcher(regex_pattern);
+                LikePatternMatcher matcher(val);
                 for (int i = 0; i < size; ++i) {
                     res[i] = matcher(src[i]);
                 }
@@ -791,6 +792,19 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
         return true;
     }
 
+    ExprCostClass
+    GetCostClass() const override {
+        switch (expr_->op_type_) {
+            case proto::plan::OpType::Match:
+            case proto::plan::OpType::InnerMatch:
+            case proto::plan::OpType::PostfixMatch:
+                // like patterns are matched row by row
+                return ExprCostClass::kExpensive;
+            default:
+                return SegmentExpr::GetCostClass();
+        }
+    }
+
     std::string
     ToString() const {
         return fmt::format("{}", expr_->ToString());
@@ -873,6 +887,11 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     VectorPtr
     ExecRangeVisitorImplJsonByStats();
 
+    template <typename ExprValueType>
+    VectorPtr
+    ExecRangeVisitorImplJsonByGrowingStats(
+        const index::GrowingJsonKeyStats& stats);
+
     template <typename T>
     VectorPtr
     ExecRangeVisitorImplForPk(EvalCtx& context);
@@ -927,6 +946,11 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     SingleElement value_arg_;
     PinWrapper<index::NgramInvertedIndex*> pinned_ngram_index_{nullptr};
     PinWrapper<index::BsonInvertedIndex*> bson_index_{nullptr};
+    // text match result in the encoding of the expr res cache, batches are
+    // decoded from it when it is set instead of from cached_match_res_
+    std::shared_ptr<const CompressedBitmap> cached_match_encoded_{nullptr};
+    std::shared_ptr<const CompressedBitmap> cached_match_valid_encoded_{
+        nullptr};
 };
 }  // namespace exec
 }  // namespace milvus
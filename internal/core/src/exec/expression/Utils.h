@@ -17,6 +17,7 @@
 #pragma once
 
 #include <algorithm>
+#include <optional>
 
 #include <fmt/core.h>
 
@@ -30,6 +31,45 @@
 namespace milvus {
 namespace exec {
 
+// Rows per block of ForEachActiveBlock().
+constexpr size_t kActiveBlockRows = 128;
+
+// Calls fn(begin, size) for each block of kActiveBlockRows rows of a batch
+// of size rows that starts at a row set in bitmap_input from start_cursor
+// on, the rows the conjunction evaluating the batch has not decided. Rows
+// out of the blocks are left alone. Returns false without calling fn when
+// the blocks would cover more than half of the batch, as one pass over it
+// is cheaper then.
+template <typename Fn>
+bool
+ForEachActiveBlock(const TargetBitmap& bitmap_input,
+                   size_t start_cursor,
+                   size_t size,
+                   Fn&& fn) {
+    if (bitmap_input.empty() || size < 4 * kActiveBlockRows) {
+        return false;
+    }
+    auto active = bitmap_input.view(start_cursor, size);
+    // the first active row at or past from
+    auto next_active = [&](size_t from) -> std::optional<size_t> {
+        return from == 0 ? active.find_first() : active.find_next(from - 1);
+    };
+    const size_t max_blocks = size / kActiveBlockRows / 2;
+    size_t blocks = 0;
+    for (auto row = next_active(0); row.has_value();
+         row = next_active(row.value() + kActiveBlockRows)) {
+        if (++blocks > max_blocks) {
+            return false;
+        }
+    }
+    for (auto row = next_active(0); row.has_value();
+         row = next_active(row.value() + kActiveBlockRows)) {
+        auto begin = row.value();
+        fn(begin, std::min(kActiveBlockRows, size - begin));
+    }
+    return true;
+}
+
 inline bool
 IsCompareOp(proto::plan::OpType op) {
     return op == proto::plan::OpType::Equal ||
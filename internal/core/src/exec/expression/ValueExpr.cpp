@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "ValueExpr.h"
+#include "exec/TraceUtils.h"
 #include "common/Vector.h"
 
 namespace milvus {
@@ -22,8 +23,8 @@ namespace exec {
 
 void
 PhyValueExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    tracer::AutoSpan span("PhyValueExpr::Eval", tracer::GetRootSpan(), true);
-    span.GetSpan()->SetAttribute("data_type", static_cast<int>(expr_->type()));
+    tracer::LazyAutoSpan span("PhyValueExpr::Eval", true);
+    span.SetAttribute("data_type", static_cast<int>(expr_->type()));
 
     auto input = context.get_offset_input();
     SetHasOffsetInput((input != nullptr));
@@ -49,6 +49,12 @@ class PhyValueExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetBatchSize(int64_t batch_size) override {
+        batch_size_ = batch_size;
+        Expr::SetBatchSize(batch_size);
+    }
+
     void
     MoveCursor() override {
         if (!has_offset_input_) {
@@ -80,7 +86,7 @@ class PhyValueExpr : public Expr {
     std::shared_ptr<const milvus::expr::ValueExpr> expr_;
     const int64_t active_count_;
     int64_t current_pos_{0};
-    const int64_t batch_size_;
+    int64_t batch_size_;
 };
 
 }  //namespace exec
@@ -17,6 +17,9 @@
 #include "exec/expression/function/FunctionFactory.h"
 #include "exec/expression/function/impl/StringFunctions.h"
 #include "log/Log.h"
+#include "exec/operator/query-agg/ApproxCountDistinctAggregate.h"
+#include "exec/operator/query-agg/ApproxPercentileAggregate.h"
+#include "exec/operator/query-agg/AvgAggregate.h"
 #include "exec/operator/query-agg/CountAggregateBase.h"
 #include "exec/operator/query-agg/MinAggregateBase.h"
 #include "exec/operator/query-agg/MaxAggregateBase.h"
@@ -59,6 +62,15 @@ FunctionFactory::RegisterAllFunctions() {
     RegisterFilterFunction("starts_with",
                            {DataType::VARCHAR, DataType::VARCHAR},
                            function::StartsWithVarchar);
+    RegisterFilterFunction("ends_with",
+                           {DataType::VARCHAR, DataType::VARCHAR},
+                           function::EndsWithVarchar);
+    RegisterFilterFunction("contains",
+                           {DataType::VARCHAR, DataType::VARCHAR},
+                           function::ContainsVarchar);
+    RegisterFilterFunction("regexp_like",
+                           {DataType::VARCHAR, DataType::VARCHAR},
+                           function::RegexpLikeVarchar);
     LOG_INFO("{} filter functions registered", GetFilterFunctionNum());
     RegisterAggregateFunction();
 }
@@ -78,6 +90,9 @@ FunctionFactory::RegisterAggregateFunction() {
     milvus::exec::registerMinAggregate();
     milvus::exec::registerMaxAggregate();
     milvus::exec::registerSumAggregate();
+    milvus::exec::registerAvgAggregate();
+    milvus::exec::registerApproxCountDistinctAggregate();
+    milvus::exec::registerApproxPercentileAggregate();
 }
 
 const FilterFunctionPtr
@@ -15,11 +15,81 @@
 // limitations under the License.
 #pragma once
 
+#include <optional>
+#include <string>
+
+#include "common/EasyAssert.h"
 #include "common/Vector.h"
+#include "exec/expression/function/FunctionFactory.h"
 
 namespace milvus::exec::expression::function {
 
 void
 CheckVarcharOrStringType(std::shared_ptr<SimpleVector>& vec);
 
+// Evaluates a predicate of a string column and a string argument over the
+// whole batch. make_matcher turns the argument into a callable on the
+// string, so a needle or a pattern is prepared once when the argument is a
+// constant, and once per run of equal arguments otherwise.
+template <typename MakeMatcher>
+void
+EvalVarcharPredicate(const RowVector& args,
+                     FilterFunctionReturn& result,
+                     MakeMatcher&& make_matcher) {
+    if (args.childrens().size() != 2) {
+        ThrowInfo(ExprInvalid,
+                  "invalid argument count, expect 2, actual {}",
+                  args.childrens().size());
+    }
+    auto strs = std::dynamic_pointer_cast<SimpleVector>(args.child(0));
+    Assert(strs != nullptr);
+    CheckVarcharOrStringType(strs);
+    auto patterns = std::dynamic_pointer_cast<SimpleVector>(args.child(1));
+    Assert(patterns != nullptr);
+    CheckVarcharOrStringType(patterns);
+
+    auto size = strs->size();
+    TargetBitmap bitmap(size, false);
+    TargetBitmap valid_bitmap(size, true);
+    auto str_at = [&](size_t i) -> const std::string& {
+        return *reinterpret_cast<std::string*>(
+            strs->RawValueAt(i, sizeof(std::string)));
+    };
+
+    auto constant =
+        std::dynamic_pointer_cast<ConstantVector<std::string>>(patterns);
+    if (constant != nullptr) {
+        if (constant->IsNull()) {
+            valid_bitmap.reset();
+        } else {
+            auto matcher = make_matcher(constant->GetValue());
+            for (size_t i = 0; i < size; ++i) {
+                if (strs->ValidAt(i)) {
+                    bitmap[i] = matcher(str_at(i));
+                } else {
+                    valid_bitmap[i] = false;
+                }
+            }
+        }
+    } else {
+        std::optional<decltype(make_matcher(std::string()))> matcher;
+        std::string last_pattern;
+        for (size_t i = 0; i < size; ++i) {
+            if (!strs->ValidAt(i) || !patterns->ValidAt(i)) {
+                valid_bitmap[i] = false;
+                continue;
+            }
+            const auto& pattern = *reinterpret_cast<std::string*>(
+                patterns->RawValueAt(i, sizeof(std::string)));
+            if (!matcher.has_value() || pattern != last_pattern) {
+                matcher.emplace(make_matcher(pattern));
+                last_pattern = pattern;
+            }
+            bitmap[i] = (*matcher)(str_at(i));
+        }
+    }
+    result = std::make_shared<ColumnVector>(std::move(bitmap),
+                                            std::move(valid_bitmap));
+}
+
 }  // namespace milvus::exec::expression::function
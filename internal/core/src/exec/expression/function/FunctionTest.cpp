@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <string>
 #include <vector>
 
 #include "common/Types.h"
@@ -237,3 +238,99 @@ TEST_F(FunctionTest, StartsWithIncorrectArgs) {
     milvus::RowVector three_args(arg_vec);
     EXPECT_ANY_THROW(StartsWithVarchar(three_args, result));
 }
+
+static void
+MatchConstantCheck(milvus::exec::expression::FilterFunctionPtr func,
+                   const std::vector<std::string>& strs,
+                   const std::string& pattern,
+                   const std::vector<bool>& expected) {
+    std::vector<milvus::VectorPtr> arg_vec;
+    auto col1 = std::make_shared<milvus::ColumnVector>(milvus::DataType::STRING,
+                                                       strs.size());
+    auto* col1_data = col1->RawAsValues<std::string>();
+    for (size_t i = 0; i < strs.size(); ++i) {
+        col1_data[i] = strs[i];
+    }
+    arg_vec.push_back(col1);
+    arg_vec.push_back(std::make_shared<milvus::ConstantVector<std::string>>(
+        milvus::DataType::STRING, strs.size(), pattern));
+    milvus::RowVector args(std::move(arg_vec));
+
+    VectorPtr result;
+    func(args, result);
+    auto result_vec = std::dynamic_pointer_cast<milvus::ColumnVector>(result);
+    ASSERT_NE(result_vec, nullptr);
+    TargetBitmapView bitmap(result_vec->GetRawData(), result_vec->size());
+    for (size_t i = 0; i < strs.size(); ++i) {
+        EXPECT_TRUE(result_vec->ValidAt(i)) << "i: " << i;
+        EXPECT_EQ(bitmap[i], expected[i]) << pattern << " on " << strs[i];
+    }
+}
+
+TEST_F(FunctionTest, EndsWithContainsRegexpLike) {
+    const std::vector<std::string> strs = {
+        "", "abc", "xxabc", "abcxx", "ab", "ABC"};
+    MatchConstantCheck(EndsWithVarchar,
+                       strs,
+                       "abc",
+                       {false, true, true, false, false, false});
+    MatchConstantCheck(
+        EndsWithVarchar, strs, "", {true, true, true, true, true, true});
+    MatchConstantCheck(ContainsVarchar,
+                       strs,
+                       "abc",
+                       {false, true, true, true, false, false});
+    MatchConstantCheck(
+        ContainsVarchar, strs, "", {true, true, true, true, true, true});
+    MatchConstantCheck(RegexpLikeVarchar,
+                       strs,
+                       "b.$",
+                       {false, true, true, false, false, false});
+    MatchConstantCheck(RegexpLikeVarchar,
+                       strs,
+                       "^[a-z]+$",
+                       {false, true, true, true, true, false});
+}
+
+TEST_F(FunctionTest, ContainsColumnVector) {
+    std::vector<milvus::VectorPtr> arg_vec;
+    auto col1 = std::make_shared<milvus::ColumnVector>(milvus::DataType::STRING,
+                                                       STARTS_WITH_ROW_COUNT);
+    InitStrsForStartWith(col1);
+    arg_vec.push_back(col1);
+
+    auto col2 = std::make_shared<milvus::ColumnVector>(milvus::DataType::STRING,
+                                                       STARTS_WITH_ROW_COUNT);
+    auto* col2_data = col2->RawAsValues<std::string>();
+    col2_data[0] = "23";
+    col2_data[1] = "1";
+    col2_data[3] = "bbb";
+    col2_data[4] = "bbb";
+    col2_data[5] = "";
+    col2_data[6] = "";
+    TargetBitmapView valid_bitmap_col2(col2->GetValidRawData(), col2->size());
+    valid_bitmap_col2[6] = false;
+    col2_data[7] = "12";
+    arg_vec.push_back(col2);
+    milvus::RowVector args(std::move(arg_vec));
+
+    bool valid[STARTS_WITH_ROW_COUNT] = {
+        true, true, false, true, true, true, false, true};
+    bool expected[STARTS_WITH_ROW_COUNT] = {
+        true, false, false, true, true, true, false, false};
+
+    VectorPtr result;
+    ContainsVarchar(args, result);
+    StartWithCheck(result, valid, expected);
+}
+
+TEST_F(FunctionTest, RegexpLikeInvalidPattern) {
+    std::vector<milvus::VectorPtr> arg_vec;
+    arg_vec.push_back(std::make_shared<milvus::ColumnVector>(
+        milvus::DataType::STRING, 4));
+    arg_vec.push_back(std::make_shared<milvus::ConstantVector<std::string>>(
+        milvus::DataType::STRING, 4, "(abc"));
+    milvus::RowVector args(std::move(arg_vec));
+    VectorPtr result;
+    EXPECT_ANY_THROW(RegexpLikeVarchar(args, result));
+}
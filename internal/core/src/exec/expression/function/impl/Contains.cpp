@@ -0,0 +1,45 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "exec/expression/function/FunctionImplUtils.h"
+#include "exec/expression/function/impl/StringFunctions.h"
+
+#include <string.h>
+#include <string>
+
+namespace milvus {
+namespace exec {
+namespace expression {
+namespace function {
+
+void
+ContainsVarchar(const RowVector& args, FilterFunctionReturn& result) {
+    EvalVarcharPredicate(args, result, [](const std::string& needle) {
+        // memmem scans for the needle's first bytes with vector compares
+        return [needle](const std::string& str) {
+            return needle.empty() ||
+                   memmem(str.data(),
+                          str.size(),
+                          needle.data(),
+                          needle.size()) != nullptr;
+        };
+    });
+}
+
+}  // namespace function
+}  // namespace expression
+}  // namespace exec
+}  // namespace milvus
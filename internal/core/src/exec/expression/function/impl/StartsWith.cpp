@@ -29,33 +29,12 @@ namespace function {
 
 void
 StartsWithVarchar(const RowVector& args, FilterFunctionReturn& result) {
-    if (args.childrens().size() != 2) {
-        ThrowInfo(ExprInvalid,
-                  "invalid argument count, expect 2, actual {}",
-                  args.childrens().size());
-    }
-    auto strs = std::dynamic_pointer_cast<SimpleVector>(args.child(0));
-    Assert(strs != nullptr);
-    CheckVarcharOrStringType(strs);
-    auto prefixes = std::dynamic_pointer_cast<SimpleVector>(args.child(1));
-    Assert(prefixes != nullptr);
-    CheckVarcharOrStringType(prefixes);
-
-    TargetBitmap bitmap(strs->size(), false);
-    TargetBitmap valid_bitmap(strs->size(), true);
-    for (size_t i = 0; i < strs->size(); ++i) {
-        if (strs->ValidAt(i) && prefixes->ValidAt(i)) {
-            auto* str_ptr = reinterpret_cast<std::string*>(
-                strs->RawValueAt(i, sizeof(std::string)));
-            auto* prefix_ptr = reinterpret_cast<std::string*>(
-                prefixes->RawValueAt(i, sizeof(std::string)));
-            bitmap.set(i, str_ptr->find(*prefix_ptr) == 0);
-        } else {
-            valid_bitmap[i] = false;
-        }
-    }
-    result = std::make_shared<ColumnVector>(std::move(bitmap),
-                                            std::move(valid_bitmap));
+    EvalVarcharPredicate(args, result, [](const std::string& prefix) {
+        return [prefix](const std::string& str) {
+            return str.size() >= prefix.size() &&
+                   str.compare(0, prefix.size(), prefix) == 0;
+        };
+    });
 }
 
 }  // namespace function
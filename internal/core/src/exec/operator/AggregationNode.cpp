@@ -39,8 +39,19 @@ PhyAggregationNode::initialize() {
     auto numHashers = hashers.size();
     std::vector<AggregateInfo> aggregateInfos =
         toAggregateInfo(*aggregationNode_, *operator_context_, numHashers);
-    grouping_set_ = std::make_unique<GroupingSet>(
-        input_type, std::move(hashers), std::move(aggregateInfos));
+    SpillConfig spill_config;
+    spill_config.memory_limit = operator_context_->get_exec_context()
+                                    ->get_query_config()
+                                    ->get_agg_spill_memory_limit();
+    if (spill_config.memory_limit > 0) {
+        spill_config.directory = DefaultSpillDirectory();
+    }
+    grouping_set_ = std::make_unique<GroupingSet>(input_type,
+                                                  std::move(hashers),
+                                                  std::move(aggregateInfos),
+                                                  std::move(spill_config),
+                                                  memory_tracker_);
+    stats_aggregation_ = SegmentStatsAggregation::create(*aggregationNode_);
     aggregationNode_.reset();
 }
 
@@ -52,14 +63,31 @@ PhyAggregationNode::AddInput(RowVectorPtr& input) {
 
 RowVectorPtr
 PhyAggregationNode::GetOutput() {
+    if (stats_aggregation_ != nullptr) {
+        // asked for output before any input, so when the segment stats
+        // answer, the source operators never run
+        auto stats_aggregation = std::move(stats_aggregation_);
+        auto query_context =
+            operator_context_->get_exec_context()->get_query_context();
+        output_ = stats_aggregation->getOutput(output_type_, query_context);
+        if (output_ != nullptr) {
+            finished_ = true;
+            numOutputRows_ += output_->size();
+            return output_;
+        }
+    }
     if (finished_ || !no_more_input_) {
         input_ = nullptr;
         return nullptr;
     }
-    DeferLambda([&]() { finished_ = true; });
+    // a spilled aggregation produces one batch per re-aggregated partition
+    bool hasData = false;
+    DeferLambda([&]() {
+        finished_ = !hasData || !grouping_set_->hasRemainingOutput();
+    });
     const auto outputRowCount = isGlobal_ ? 1 : grouping_set_->outputRowCount();
     output_ = std::make_shared<RowVector>(output_type_, outputRowCount);
-    const bool hasData = grouping_set_->getOutput(output_);
+    hasData = grouping_set_->getOutput(output_);
     if (!hasData) {
         return nullptr;
     }
@@ -17,6 +17,7 @@
 #pragma once
 #include "exec/operator/Operator.h"
 #include "exec/operator/query-agg/GroupingSet.h"
+#include "exec/operator/query-agg/SegmentStatsAggregation.h"
 #include "common/Types.h"
 
 namespace milvus {
@@ -71,6 +72,8 @@ class PhyAggregationNode : public Operator {
  private:
     RowVectorPtr output_;
     std::unique_ptr<GroupingSet> grouping_set_;
+    // tried once before any input, nullptr when the node can not use it
+    std::unique_ptr<SegmentStatsAggregation> stats_aggregation_;
     std::shared_ptr<const plan::AggregationNode> aggregationNode_;
     const bool isGlobal_;
 
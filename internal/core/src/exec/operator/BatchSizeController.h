@@ -0,0 +1,129 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "common/EasyAssert.h"
+#include "exec/expression/Expr.h"
+
+namespace milvus {
+namespace exec {
+
+/// Picks the number of rows an operator evaluates its expressions over per
+/// batch. The first batch size follows the cost class of the expressions,
+/// cheap ones get larger batches to amortize the per batch overhead and
+/// expensive ones smaller batches to keep the intermediate results in cache.
+/// When adaptive, the measured cost per row then retargets the batch size so
+/// that a batch takes about kTargetBatchNanos. Sizes stay within 1/8 and 8
+/// times the configured batch size.
+class BatchSizeController {
+ public:
+    static constexpr int64_t kTargetBatchNanos = 50'000;
+
+    BatchSizeController(int64_t base_batch_size,
+                        ExprCostClass cost_class,
+                        bool adaptive)
+        : adaptive_(adaptive),
+          min_batch_size_(std::max<int64_t>(1, base_batch_size / 8)),
+          max_batch_size_(base_batch_size * 8),
+          batch_size_(base_batch_size) {
+        AssertInfo(base_batch_size > 0,
+                   "expr batch size should be greater than zero, but got {}",
+                   base_batch_size);
+        if (!adaptive_) {
+            return;
+        }
+        switch (cost_class) {
+            case ExprCostClass::kCheap:
+                batch_size_ = Normalize(base_batch_size * 4);
+                break;
+            case ExprCostClass::kExpensive:
+                batch_size_ = Normalize(base_batch_size / 4);
+                break;
+            default:
+                break;
+        }
+    }
+
+    int64_t
+    batch_size() const {
+        return batch_size_;
+    }
+
+    int64_t
+    min_batch_size() const {
+        return min_batch_size_;
+    }
+
+    int64_t
+    max_batch_size() const {
+        return max_batch_size_;
+    }
+
+    bool
+    adaptive() const {
+        return adaptive_;
+    }
+
+    /// Records that a batch of 'rows' took 'nanos' to evaluate.
+    void
+    Record(int64_t rows, int64_t nanos) {
+        if (!adaptive_ || rows <= 0) {
+            return;
+        }
+        const auto sample = static_cast<double>(std::max<int64_t>(nanos, 1)) /
+                            static_cast<double>(rows);
+        nanos_per_row_ = nanos_per_row_ < 0
+                             ? sample
+                             : kSmoothing * sample +
+                                   (1 - kSmoothing) * nanos_per_row_;
+        const auto target =
+            Normalize(static_cast<int64_t>(kTargetBatchNanos / nanos_per_row_));
+        // small changes are noise, resizing is not free either
+        if (std::abs(target - batch_size_) * 4 > batch_size_) {
+            batch_size_ = target;
+        }
+    }
+
+ private:
+    // Weight of the latest batch in the moving average of the cost per row.
+    static constexpr double kSmoothing = 0.3;
+    static constexpr int64_t kAlignment = 64;
+
+    // Clamps to the bounds and rounds to whole bitset words.
+    int64_t
+    Normalize(int64_t batch_size) const {
+        batch_size = std::clamp(batch_size, min_batch_size_, max_batch_size_);
+        if (batch_size >= kAlignment) {
+            batch_size -= batch_size % kAlignment;
+        }
+        return batch_size;
+    }
+
+    const bool adaptive_;
+    const int64_t min_batch_size_;
+    const int64_t max_batch_size_;
+    int64_t batch_size_;
+    // moving average of the evaluation cost, negative until the first batch
+    double nanos_per_row_ = -1;
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -16,6 +16,7 @@
 
 #include "ElementFilterBitsNode.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 
 #include "monitor/Monitor.h"
@@ -59,8 +60,7 @@ PhyElementFilterBitsNode::GetOutput() {
 
     DeferLambda([&]() { is_finished_ = true; });
 
-    tracer::AutoSpan span(
-        "PhyElementFilterBitsNode::GetOutput", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyElementFilterBitsNode::GetOutput", true);
 
     std::chrono::high_resolution_clock::time_point start_time =
         std::chrono::high_resolution_clock::now();
@@ -107,19 +107,18 @@ PhyElementFilterBitsNode::GetOutput() {
                                                                  1000);
 
     auto filtered_count = expr_result.count();
-    tracer::AddEvent(
-        fmt::format("struct_name: {}, total_elements: {}, output_rows: {}, "
-                    "filtered: {}, cost_us: {}",
-                    struct_name_,
-                    array_offsets->GetTotalElementCount(),
-                    array_offsets->GetTotalElementCount() - filtered_count,
-                    filtered_count,
-                    total_cost));
+    tracer::AddEventFmt("struct_name: {}, total_elements: {}, output_rows: {}, "
+                        "filtered: {}, cost_us: {}",
+                        struct_name_,
+                        array_offsets->GetTotalElementCount(),
+                        array_offsets->GetTotalElementCount() - filtered_count,
+                        filtered_count,
+                        total_cost);
 
     std::vector<VectorPtr> col_res;
     col_res.push_back(std::make_shared<ColumnVector>(
         std::move(expr_result), std::move(valid_expr_result)));
-    return std::make_shared<RowVector>(col_res);
+    return std::make_shared<RowVector>(std::move(col_res));
 }
 
 std::pair<TargetBitmap, TargetBitmap>
@@ -127,9 +126,8 @@ PhyElementFilterBitsNode::EvaluateElementExpression(
     const TargetBitmapView& doc_bitset,
     const TargetBitmapView& doc_bitset_valid,
     const IArrayOffsets* array_offsets) {
-    tracer::AutoSpan span("PhyElementFilterBitsNode::EvaluateElementExpression",
-                          tracer::GetRootSpan(),
-                          true);
+    tracer::LazyAutoSpan span(
+        "PhyElementFilterBitsNode::EvaluateElementExpression", true);
     int64_t total_elements = query_context_->get_active_element_count();
 
     auto count = doc_bitset.count();
@@ -156,8 +154,8 @@ PhyElementFilterBitsNode::EvaluateElementExpression(
         FixedVector<int32_t> element_offsets =
             array_offsets->RowBitsetToElementOffsets(doc_bitset, 0);
 
-        tracer::AddEvent(fmt::format("offset_mode, input_elements: {}",
-                                     element_offsets.size()));
+        tracer::AddEventFmt("offset_mode, input_elements: {}",
+                            element_offsets.size());
 
         EvalCtx eval_ctx(operator_context_->get_exec_context(),
                          &element_offsets);
@@ -198,16 +196,14 @@ PhyElementFilterBitsNode::EvaluateElementExpression(
 
         bitset.flip();
 
-        tracer::AddEvent(
-            fmt::format("evaluated_elements: {}, total_elements: {}",
-                        element_offsets.size(),
-                        total_elements));
+        tracer::AddEventFmt("evaluated_elements: {}, total_elements: {}",
+                            element_offsets.size(),
+                            total_elements);
 
         return std::make_pair(std::move(bitset), std::move(valid_bitset));
     } else {
         // Full mode: evaluate on all elements, then AND with doc_bitset
-        tracer::AddEvent(
-            fmt::format("full_mode, total_elements: {}", total_elements));
+        tracer::AddEventFmt("full_mode, total_elements: {}", total_elements);
 
         EvalCtx eval_ctx(operator_context_->get_exec_context());
 
@@ -256,10 +252,9 @@ PhyElementFilterBitsNode::EvaluateElementExpression(
 
         eval_bitset.flip();
 
-        tracer::AddEvent(
-            fmt::format("evaluated_elements: {}, total_elements: {}",
-                        total_elements,
-                        total_elements));
+        tracer::AddEventFmt("evaluated_elements: {}, total_elements: {}",
+                            total_elements,
+                            total_elements);
 
         // Element filter targets individual elements within arrays.
         // While the array field itself can be nullable (handled by doc_bitset_valid),
@@ -16,6 +16,7 @@
 
 #include "ElementFilterNode.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "common/ElementFilterIterator.h"
 #include "monitor/Monitor.h"
 
@@ -50,8 +51,7 @@ PhyElementFilterNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyElementFilterNode::GetOutput", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyElementFilterNode::GetOutput", true);
 
     DeferLambda([&]() { is_finished_ = true; });
 
@@ -114,12 +114,12 @@ PhyElementFilterNode::GetOutput() {
         std::chrono::duration<double, std::micro>(end_time - start_time)
             .count();
 
-    tracer::AddEvent(
-        fmt::format("PhyElementFilterNode: wrapped {} iterators, struct_name: "
-                    "{}, cost_us: {}",
-                    wrapped_iterators.size(),
-                    struct_name_,
-                    cost));
+    tracer::AddEventFmt(
+        "PhyElementFilterNode: wrapped {} iterators, struct_name: "
+        "{}, cost_us: {}",
+        wrapped_iterators.size(),
+        struct_name_,
+        cost);
 
     // Pass through input to downstream
     return input_;
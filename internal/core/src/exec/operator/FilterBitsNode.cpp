@@ -15,12 +15,62 @@
 // limitations under the License.
 
 #include "FilterBitsNode.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <set>
+
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 #include "monitor/Monitor.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus {
 namespace exec {
+namespace {
+// Whether every row of the filter result only depends on the values of the
+// row, so the result of the rows a growing segment had stays the same as
+// rows are appended. Text and phrase matches score rows against the terms
+// of the whole segment, calls and the other filters are not checked.
+bool
+IsRowWise(const expr::TypedExprPtr& expr) {
+    if (auto unary =
+            std::dynamic_pointer_cast<const expr::UnaryRangeFilterExpr>(
+                expr)) {
+        if (unary->op_type_ == proto::plan::OpType::TextMatch ||
+            unary->op_type_ == proto::plan::OpType::PhraseMatch) {
+            return false;
+        }
+    } else if (!std::dynamic_pointer_cast<const expr::AlwaysTrueExpr>(expr) &&
+               !std::dynamic_pointer_cast<const expr::ExistsExpr>(expr) &&
+               !std::dynamic_pointer_cast<const expr::LogicalUnaryExpr>(
+                   expr) &&
+               !std::dynamic_pointer_cast<const expr::LogicalBinaryExpr>(
+                   expr) &&
+               !std::dynamic_pointer_cast<const expr::TermFilterExpr>(expr) &&
+               !std::dynamic_pointer_cast<const expr::BinaryRangeFilterExpr>(
+                   expr) &&
+               !std::dynamic_pointer_cast<
+                   const expr::BinaryArithOpEvalRangeExpr>(expr) &&
+               !std::dynamic_pointer_cast<
+                   const expr::TimestamptzArithCompareExpr>(expr) &&
+               !std::dynamic_pointer_cast<const expr::NullExpr>(expr) &&
+               !std::dynamic_pointer_cast<const expr::CompareExpr>(expr) &&
+               !std::dynamic_pointer_cast<const expr::JsonContainsExpr>(
+                   expr)) {
+        return false;
+    }
+    for (const auto& input : expr->inputs()) {
+        if (!IsRowWise(input)) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
 PhyFilterBitsNode::PhyFilterBitsNode(
     int32_t operator_id,
     DriverContext* driverctx,
@@ -35,8 +85,125 @@ PhyFilterBitsNode::PhyFilterBitsNode(
     std::vector<expr::TypedExprPtr> filters;
     filters.emplace_back(filter->filter());
     exprs_ = std::make_unique<ExprSet>(filters, exec_context);
+    filter_ = filter->filter();
     need_process_rows_ = query_context_->get_active_count();
     num_processed_rows_ = 0;
+    limit_ = query_context_->get_retrieve_limit();
+    if (limit_.has_value()) {
+        next_limit_check_ = limit_.value() + 1;
+    }
+
+    auto cost_class = ExprCostClass::kCheap;
+    std::set<FieldId> fields;
+    for (const auto& expr : exprs_->exprs()) {
+        cost_class = std::max(cost_class, expr->GetCostClass());
+        expr->GatherDataFields(fields);
+    }
+    const auto& config = query_context_->query_config();
+    batch_size_controller_ = std::make_unique<BatchSizeController>(
+        config->get_expr_batch_size(),
+        cost_class,
+        config->get_expr_adaptive_batch_size());
+    expr_batch_size_ = config->get_expr_batch_size();
+    if (batch_size_controller_->batch_size() != expr_batch_size_) {
+        expr_batch_size_ = batch_size_controller_->batch_size();
+        SetBatchSize(*exprs_, expr_batch_size_);
+    }
+
+    auto* segment = query_context_->get_segment();
+    if (batch_size_controller_->adaptive() && fields.size() == 1 &&
+        segment != nullptr && segment->type() == SegmentType::Sealed &&
+        segment->is_chunked() &&
+        segment->num_chunk_data(*fields.begin()) > 1) {
+        chunk_aligned_field_ = *fields.begin();
+    }
+
+    // a limit stops at the first rows, the result of the rest is not known
+    if (ExprResCacheManager::IsEnabled() && !limit_.has_value() &&
+        segment != nullptr && segment->type() == SegmentType::Growing &&
+        IsRowWise(filter_)) {
+        prefix_cache_key_ = ExprResCacheManager::Key{
+            segment->get_segment_id(), "filter_bits:" + filter_->ToString()};
+    }
+}
+
+BlockingReason
+PhyFilterBitsNode::IsBlocked(ContinueFuture* future) {
+    const auto& shared = query_context_->get_shared_filter();
+    if (shared != nullptr && !shared->owner() && !AllInputProcessed()) {
+        if (!shared_wait_issued_) {
+            shared_wait_issued_ = true;
+            auto shared_future = shared->Wait();
+            if (!shared_future.isReady()) {
+                tracer::AddEvent("wait_for_shared_filter");
+                *future = std::move(shared_future);
+                return BlockingReason::kWaitForSharedFilter;
+            }
+        }
+        if (shared->Get().has_value()) {
+            return BlockingReason::kNotBlocked;
+        }
+    }
+    if (prefetch_issued_ || AllInputProcessed()) {
+        return BlockingReason::kNotBlocked;
+    }
+    prefetch_issued_ = true;
+    std::vector<ContinueFuture> futures;
+    for (auto& expr : exprs_->exprs()) {
+        expr->PrefetchAsync(futures);
+    }
+    std::vector<ContinueFuture> pending;
+    for (auto& pending_future : futures) {
+        if (!pending_future.isReady()) {
+            pending.push_back(std::move(pending_future));
+        }
+    }
+    if (pending.empty()) {
+        return BlockingReason::kNotBlocked;
+    }
+    tracer::AddEventFmt("wait_for_cache: {} loads", pending.size());
+    // a failed load is raised again by the synchronous pin of the batch
+    *future = folly::collectAll(std::move(pending)).unit();
+    return BlockingReason::kWaitForCache;
+}
+
+void
+PhyFilterBitsNode::SetBatchSize(ExprSet& exprs, int64_t batch_size) {
+    for (auto& expr : exprs.exprs()) {
+        expr->SetBatchSize(batch_size);
+    }
+}
+
+int64_t
+PhyFilterBitsNode::NextBatchSize() const {
+    const auto rows_left = need_process_rows_ - num_processed_rows_;
+    auto batch_size =
+        std::min(batch_size_controller_->batch_size(), rows_left);
+    if (!chunk_aligned_field_.has_value() || batch_size == rows_left) {
+        return batch_size;
+    }
+    auto* segment = query_context_->get_segment();
+    const auto field_id = chunk_aligned_field_.value();
+    const auto chunk_id =
+        segment->get_chunk_by_offset(field_id, num_processed_rows_).first;
+    if (chunk_id + 1 >= segment->num_chunk_data(field_id)) {
+        return batch_size;
+    }
+    const auto chunk_rows_left =
+        segment->num_rows_until_chunk(field_id, chunk_id + 1) -
+        num_processed_rows_;
+    if (chunk_rows_left < batch_size) {
+        // a tiny batch before the chunk end costs more than the stitching
+        if (chunk_rows_left >= batch_size_controller_->min_batch_size()) {
+            return chunk_rows_left;
+        }
+    } else if (chunk_rows_left - batch_size <
+                   batch_size_controller_->min_batch_size() &&
+               chunk_rows_left <= batch_size_controller_->max_batch_size()) {
+        // absorb the tail of the chunk rather than leave a tiny batch
+        return chunk_rows_left;
+    }
+    return batch_size;
 }
 
 void
@@ -58,6 +225,204 @@ PhyFilterBitsNode::IsFinished() {
     return AllInputProcessed();
 }
 
+int64_t
+PhyFilterBitsNode::AppendResult(const std::vector<VectorPtr>& results,
+                                TargetBitmap& bitset,
+                                TargetBitmap& valid_bitset) {
+    AssertInfo(results.size() == 1 && results[0] != nullptr,
+               "PhyFilterBitsNode result size should be size one and not "
+               "be nullptr");
+
+    auto col_vec = std::dynamic_pointer_cast<ColumnVector>(results[0]);
+    if (col_vec == nullptr) {
+        ThrowInfo(ExprInvalid,
+                  "PhyFilterBitsNode result should be ColumnVector");
+    }
+    if (!col_vec->IsBitmap()) {
+        ThrowInfo(ExprInvalid, "PhyFilterBitsNode result should be bitmap");
+    }
+    auto col_vec_size = col_vec->size();
+    TargetBitmapView view(col_vec->GetRawData(), col_vec_size);
+    bitset.append(view);
+    TargetBitmapView valid_view(col_vec->GetValidRawData(), col_vec_size);
+    valid_bitset.append(valid_view);
+    return col_vec_size;
+}
+
+int64_t
+PhyFilterBitsNode::ParallelDegree() const {
+    auto* segment = query_context_->get_segment();
+    // a limit is met within the first batches, the morsels would evaluate
+    // the whole segment
+    if (segment == nullptr || segment->type() != SegmentType::Sealed ||
+        num_processed_rows_ != 0 || limit_.has_value()) {
+        return 1;
+    }
+    const auto& config = query_context_->query_config();
+    const auto batch_size = expr_batch_size_;
+    const auto num_morsels =
+        upper_div(upper_div(need_process_rows_, batch_size), kBatchesPerMorsel);
+    return std::max<int64_t>(
+        1, std::min<int64_t>(config->get_expr_parallel_degree(), num_morsels));
+}
+
+void
+PhyFilterBitsNode::EvalParallel(int64_t degree,
+                                TargetBitmap& bitset,
+                                TargetBitmap& valid_bitset) {
+    // morsels are fixed up front, so the batch size does not adapt here
+    const auto batch_size = expr_batch_size_;
+    const auto num_batches = upper_div(need_process_rows_, batch_size);
+    const auto num_morsels = upper_div(num_batches, kBatchesPerMorsel);
+    std::vector<TargetBitmap> morsel_bitsets(num_morsels);
+    std::vector<TargetBitmap> morsel_valid_bitsets(num_morsels);
+    std::atomic<int64_t> next_morsel{0};
+
+    // Morsels are claimed in increasing order, so every worker only ever
+    // moves its expression cursors forward, skipping the batches claimed by
+    // others without evaluating them.
+    auto run_worker = [&](ExprSet* exprs) {
+        EvalCtx eval_ctx(operator_context_->get_exec_context());
+        std::vector<VectorPtr> results;
+        int64_t batch = 0;
+        for (auto morsel = next_morsel++; morsel < num_morsels;
+             morsel = next_morsel++) {
+            milvus::exec::checkCancellation(query_context_);
+            const auto begin = morsel * kBatchesPerMorsel;
+            const auto end = std::min(begin + kBatchesPerMorsel, num_batches);
+            morsel_bitsets[morsel].reserve((end - begin) * batch_size);
+            morsel_valid_bitsets[morsel].reserve((end - begin) * batch_size);
+            for (; batch < begin; batch++) {
+                for (auto& expr : exprs->exprs()) {
+                    expr->MoveCursor();
+                }
+            }
+            for (; batch < end; batch++) {
+                exprs->Eval(0, 1, true, eval_ctx, results);
+                AppendResult(results,
+                             morsel_bitsets[morsel],
+                             morsel_valid_bitsets[morsel]);
+            }
+        }
+    };
+
+    // the calling thread works too, so the filter completes even if the
+    // pool has no idle worker
+    auto exec_context = operator_context_->get_exec_context();
+    const auto config_batch_size =
+        query_context_->query_config()->get_expr_batch_size();
+    std::vector<std::unique_ptr<ExprSet>> helper_exprs;
+    std::vector<std::future<void>> futures;
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+    for (auto i = 1; i < degree; i++) {
+        helper_exprs.emplace_back(std::make_unique<ExprSet>(
+            std::vector<expr::TypedExprPtr>{filter_}, exec_context));
+        if (expr_batch_size_ != config_batch_size) {
+            SetBatchSize(*helper_exprs.back(), expr_batch_size_);
+        }
+        futures.emplace_back(
+            pool.Submit(run_worker, helper_exprs.back().get()));
+    }
+    std::exception_ptr error;
+    try {
+        run_worker(exprs_.get());
+    } catch (...) {
+        error = std::current_exception();
+        // let the helpers stop at their next morsel
+        next_morsel = num_morsels;
+    }
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    for (auto i = 0; i < num_morsels; i++) {
+        bitset.append(morsel_bitsets[i]);
+        valid_bitset.append(morsel_valid_bitsets[i]);
+    }
+    tracer::AddEventFmt("parallel_degree: {}, morsels: {}",
+                        degree,
+                        num_morsels);
+}
+
+void
+PhyFilterBitsNode::TakeCachedPrefix(TargetBitmap& bitset,
+                                    TargetBitmap& valid_bitset) {
+    ExprResCacheManager::Value cached;
+    if (!ExprResCacheManager::Instance().GetPrefix(
+            prefix_cache_key_.value(), need_process_rows_, cached)) {
+        return;
+    }
+    const auto rows = cached.active_count;
+    if (rows == 0) {
+        return;
+    }
+    bitset.append(*cached.result);
+    if (cached.valid_result) {
+        valid_bitset.append(*cached.valid_result);
+    } else {
+        valid_bitset.resize(rows, true);
+    }
+    // one batch of the cached rows moves the cursors past them
+    SetBatchSize(*exprs_, rows);
+    for (auto& expr : exprs_->exprs()) {
+        expr->MoveCursor();
+    }
+    SetBatchSize(*exprs_, expr_batch_size_);
+    num_processed_rows_ = rows;
+    tracer::AddEventFmt("cached_prefix_rows: {}", rows);
+}
+
+bool
+PhyFilterBitsNode::LimitReached(const TargetBitmap& bitset) {
+    // the rows not evaluated yet count as filtered out
+    auto probe = bitset.clone();
+    probe.resize(need_process_rows_, false);
+    probe.flip();
+    TargetBitmapView view(probe.data(), probe.size());
+    auto* segment = query_context_->get_segment();
+    segment->mask_with_timestamps(view,
+                                  query_context_->get_query_timestamp(),
+                                  query_context_->get_collection_ttl());
+    segment->mask_with_delete(view,
+                              query_context_->get_active_count(),
+                              query_context_->get_query_timestamp());
+    return static_cast<int64_t>(probe.size() - probe.count()) >
+           limit_.value();
+}
+
+RowVectorPtr
+PhyFilterBitsNode::TakeSharedResult() {
+    const auto& shared = query_context_->get_shared_filter();
+    if (shared == nullptr || shared->owner()) {
+        return nullptr;
+    }
+    auto result = shared->Get();
+    if (!result.has_value()) {
+        // the search evaluating it gave up
+        return nullptr;
+    }
+    AssertInfo(result->bitset->size() == need_process_rows_,
+               "shared filter result of {} rows for {} rows",
+               result->bitset->size(),
+               need_process_rows_);
+    num_processed_rows_ = need_process_rows_;
+    query_context_->set_filter_result_shared(true);
+    tracer::AddEvent("shared_filter_result");
+    std::vector<VectorPtr> col_res;
+    col_res.push_back(std::make_shared<ColumnVector>(
+        result->bitset->clone(), result->valid_bitset->clone()));
+    return std::make_shared<RowVector>(std::move(col_res));
+}
+
 RowVectorPtr
 PhyFilterBitsNode::GetOutput() {
     milvus::exec::checkCancellation(query_context_);
@@ -66,42 +431,79 @@ PhyFilterBitsNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyFilterBitsNode::Execute", tracer::GetRootSpan(), true);
-    tracer::AddEvent(fmt::format("input_rows: {}", need_process_rows_));
+    if (auto shared_result = TakeSharedResult()) {
+        return shared_result;
+    }
+
+    tracer::LazyAutoSpan span("PhyFilterBitsNode::Execute", true);
+    tracer::AddEventFmt("input_rows: {}", need_process_rows_);
 
     std::chrono::high_resolution_clock::time_point scalar_start =
         std::chrono::high_resolution_clock::now();
 
     EvalCtx eval_ctx(operator_context_->get_exec_context());
 
+    // the batches are appended in place, without regrowing the bitsets
     TargetBitmap bitset;
     TargetBitmap valid_bitset;
+    bitset.reserve(need_process_rows_);
+    valid_bitset.reserve(need_process_rows_);
+    // the bitsets are allocated already, they count to the peak of the
+    // operator until they are handed on
+    MemoryReservation bitsets_memory(memory_tracker_);
+    bitsets_memory.Resize(2 * ((need_process_rows_ + 7) / 8));
+    // rows of a growing segment the cache had, -1 if it is not consulted
+    int64_t cached_rows = -1;
+    if (prefix_cache_key_.has_value() && num_processed_rows_ == 0) {
+        TakeCachedPrefix(bitset, valid_bitset);
+        cached_rows = num_processed_rows_;
+    }
+    const auto parallel_degree = ParallelDegree();
+    if (parallel_degree > 1) {
+        EvalParallel(parallel_degree, bitset, valid_bitset);
+        num_processed_rows_ = bitset.size();
+    }
     while (num_processed_rows_ < need_process_rows_) {
+        const auto batch_size = NextBatchSize();
+        if (batch_size != expr_batch_size_) {
+            expr_batch_size_ = batch_size;
+            SetBatchSize(*exprs_, expr_batch_size_);
+        }
+        const auto batch_start = std::chrono::steady_clock::now();
         exprs_->Eval(0, 1, true, eval_ctx, results_);
-
-        AssertInfo(results_.size() == 1 && results_[0] != nullptr,
-                   "PhyFilterBitsNode result size should be size one and not "
-                   "be nullptr");
-
-        if (auto col_vec =
-                std::dynamic_pointer_cast<ColumnVector>(results_[0])) {
-            if (col_vec->IsBitmap()) {
-                auto col_vec_size = col_vec->size();
-                TargetBitmapView view(col_vec->GetRawData(), col_vec_size);
-                bitset.append(view);
-                TargetBitmapView valid_view(col_vec->GetValidRawData(),
-                                            col_vec_size);
-                valid_bitset.append(valid_view);
-                num_processed_rows_ += col_vec_size;
-            } else {
-                ThrowInfo(ExprInvalid,
-                          "PhyFilterBitsNode result should be bitmap");
-            }
-        } else {
-            ThrowInfo(ExprInvalid,
-                      "PhyFilterBitsNode result should be ColumnVector");
+        const auto rows = AppendResult(results_, bitset, valid_bitset);
+        batch_size_controller_->Record(
+            rows,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - batch_start)
+                .count());
+        num_processed_rows_ += rows;
+        if (!limit_.has_value()) {
+            continue;
+        }
+        filter_hits_ += bitset.view(bitset.size() - rows, rows).count();
+        if (filter_hits_ < next_limit_check_) {
+            continue;
         }
+        if (LimitReached(bitset)) {
+            tracer::AddEventFmt("limit: {}, stopped at row: {}",
+                                limit_.value(),
+                                num_processed_rows_);
+            // the rest of the segment counts as filtered out
+            bitset.resize(need_process_rows_, false);
+            valid_bitset.resize(need_process_rows_, true);
+            num_processed_rows_ = need_process_rows_;
+            break;
+        }
+        next_limit_check_ = filter_hits_ * 2;
+    }
+    if (cached_rows >= 0 && cached_rows < need_process_rows_) {
+        ExprResCacheManager::Value value;
+        value.result = std::make_shared<TargetBitmap>(bitset.clone());
+        value.valid_result =
+            std::make_shared<TargetBitmap>(valid_bitset.clone());
+        value.active_count = need_process_rows_;
+        ExprResCacheManager::Instance().Put(prefix_cache_key_.value(), value);
     }
     bitset.flip();
     AssertInfo(bitset.size() == need_process_rows_,
@@ -126,11 +528,11 @@ PhyFilterBitsNode::GetOutput() {
     milvus::monitor::internal_core_search_latency_scalar.Observe(scalar_cost /
                                                                  1000);
 
-    tracer::AddEvent(fmt::format("output_rows: {}, filtered: {}",
-                                 need_process_rows_ - filtered_count,
-                                 filtered_count));
+    tracer::AddEventFmt("output_rows: {}, filtered: {}",
+                        need_process_rows_ - filtered_count,
+                        filtered_count);
 
-    return std::make_shared<RowVector>(col_res);
+    return std::make_shared<RowVector>(std::move(col_res));
 }
 
 }  // namespace exec
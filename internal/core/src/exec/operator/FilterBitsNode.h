@@ -17,10 +17,13 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "exec/Driver.h"
 #include "exec/expression/Expr.h"
+#include "exec/expression/ExprCache.h"
+#include "exec/operator/BatchSizeController.h"
 #include "exec/operator/Operator.h"
 #include "exec/QueryContext.h"
 
@@ -58,10 +61,12 @@ class PhyFilterBitsNode : public Operator {
         exprs_->Clear();
     }
 
+    // On the first call, starts loading the chunks the filter scans and
+    // blocks until the caching layer has them, so the driver does not wait
+    // for them one expression at a time inside GetOutput. A search sharing
+    // the filter result of another one waits for it instead.
     BlockingReason
-    IsBlocked(ContinueFuture* /* unused */) override {
-        return BlockingReason::kNotBlocked;
-    }
+    IsBlocked(ContinueFuture* future) override;
 
     bool
     AllInputProcessed();
@@ -72,10 +77,79 @@ class PhyFilterBitsNode : public Operator {
     }
 
  private:
+    // The result another search published for the filter, already masked
+    // by MVCC, nullptr if it is evaluated here.
+    RowVectorPtr
+    TakeSharedResult();
+
+    // Batches in the unit of work a thread claims when the filter is
+    // evaluated in parallel.
+    static constexpr int64_t kBatchesPerMorsel = 8;
+
+    // Appends the bitmap result of one batch, returns its size.
+    static int64_t
+    AppendResult(const std::vector<VectorPtr>& results,
+                 TargetBitmap& bitset,
+                 TargetBitmap& valid_bitset);
+
+    // Rows of the next serial batch. With adaptive batch sizes the batch is
+    // cut at the end of the current chunk of a filter reading one field, so
+    // that its expressions do not stitch two chunks together.
+    int64_t
+    NextBatchSize() const;
+
+    // Whether the rows passing the filter in 'bitset', the result of the
+    // batches so far, and then MVCC are more than the retrieve limit. The
+    // first limit of them are the result, the one past them tells the
+    // retrieve there are more.
+    bool
+    LimitReached(const TargetBitmap& bitset);
+
+    // Applies 'batch_size' to every expression of 'exprs'.
+    static void
+    SetBatchSize(ExprSet& exprs, int64_t batch_size);
+
+    // Seeds the bitsets with the cached result of the first rows of a
+    // growing segment and moves the expression cursors past them, so only
+    // the rows inserted since are evaluated.
+    void
+    TakeCachedPrefix(TargetBitmap& bitset, TargetBitmap& valid_bitset);
+
+    // Threads to evaluate the filter with, parallel evaluation is for sealed
+    // segments of at least two morsels only.
+    int64_t
+    ParallelDegree() const;
+
+    // Evaluates the filter over the whole segment with 'degree' threads,
+    // each running its own copy of the expressions over a disjoint set of
+    // morsels. The morsel results are concatenated in row order.
+    void
+    EvalParallel(int64_t degree,
+                 TargetBitmap& bitset,
+                 TargetBitmap& valid_bitset);
+
+    expr::TypedExprPtr filter_;
     std::unique_ptr<ExprSet> exprs_;
+    std::unique_ptr<BatchSizeController> batch_size_controller_;
+    // batch size the expressions of exprs_ currently use
+    int64_t expr_batch_size_;
+    // the only field read by the filter, set when batches follow its chunks
+    std::optional<FieldId> chunk_aligned_field_;
+    // the retrieve limit pushed down, the batches stop once it is reached
+    std::optional<int64_t> limit_;
+    // rows of the batches so far passing the filter
+    int64_t filter_hits_{0};
+    // filter_hits_ to check the limit again at, doubled after every miss so
+    // MVCC is applied a logarithmic number of times
+    int64_t next_limit_check_{0};
+    // the key a growing segment caches the unflipped result of the filter
+    // at, set when every row of the result only depends on the row itself
+    std::optional<ExprResCacheManager::Key> prefix_cache_key_;
     QueryContext* query_context_;
     int64_t num_processed_rows_;
     int64_t need_process_rows_;
+    bool prefetch_issued_{false};
+    bool shared_wait_issued_{false};
 };
 }  // namespace exec
 }  // namespace milvus
\ No newline at end of file
@@ -0,0 +1,519 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <optional>
+
+#include "common/Types.h"
+#include "exec/operator/BatchSizeController.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
+#include "query/ExecPlanNodeVisitor.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/storage_test_utils.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+BitsetType
+ExecuteFilter(const expr::TypedExprPtr& expr,
+              const SegmentInternalInterface* segment,
+              int64_t active_count,
+              std::unordered_map<std::string, std::string> config,
+              std::optional<int64_t> retrieve_limit = std::nullopt) {
+    auto plan_fragment = plan::PlanFragment(
+        std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr));
+    auto query_config = std::make_shared<exec::QueryConfig>(config);
+    auto query_context =
+        std::make_shared<exec::QueryContext>(DEAFULT_QUERY_ID,
+                                             segment,
+                                             active_count,
+                                             MAX_TIMESTAMP,
+                                             0,
+                                             0,
+                                             query::PlanOptions(),
+                                             query_config);
+    if (retrieve_limit.has_value()) {
+        query_context->set_retrieve_limit(retrieve_limit.value());
+    }
+    auto row =
+        query::ExecPlanNodeVisitor::ExecuteTask(plan_fragment, query_context);
+    auto column = std::dynamic_pointer_cast<ColumnVector>(row->child(0));
+    BitsetTypeView view(column->GetRawData(), column->size());
+    return BitsetType(view);
+}
+
+BitsetType
+ExecuteFilter(const expr::TypedExprPtr& expr,
+              const SegmentInternalInterface* segment,
+              int64_t active_count,
+              int64_t parallel_degree) {
+    // small batches so that the segment spans many morsels
+    return ExecuteFilter(expr,
+                         segment,
+                         active_count,
+                         {{exec::QueryConfig::kExprEvalBatchSize, "1000"},
+                          {exec::QueryConfig::kExprEvalParallelDegree,
+                           std::to_string(parallel_degree)}});
+}
+
+}  // namespace
+
+TEST(FilterBitsNodeTest, ParallelEvalMatchesSerial) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+    auto f64 = schema->AddDebugField("f64", DataType::DOUBLE);
+
+    // not a multiple of the batch size, the last batch is partial
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+
+    proto::plan::GenericValue low;
+    low.set_int64_val(-1000);
+    proto::plan::GenericValue high;
+    high.set_int64_val(1000);
+    auto range = std::make_shared<expr::BinaryRangeFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64), low, high, true, false);
+    proto::plan::GenericValue zero;
+    zero.set_float_val(0);
+    auto positive = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(f64, DataType::DOUBLE),
+        proto::plan::OpType::GreaterThan,
+        zero,
+        std::vector<proto::plan::GenericValue>{});
+    auto conjunct = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And, range, positive);
+
+    for (const auto& expr : std::vector<expr::TypedExprPtr>{range, conjunct}) {
+        auto expected = ExecuteFilter(expr, segment.get(), N, 1);
+        ASSERT_EQ(expected.size(), N);
+        for (auto degree : {2, 4, 16}) {
+            auto result = ExecuteFilter(expr, segment.get(), N, degree);
+            ASSERT_EQ(result.size(), N);
+            EXPECT_EQ(result.count(), expected.count()) << degree;
+            EXPECT_TRUE(result == expected) << degree;
+        }
+    }
+}
+
+TEST(FilterBitsNodeTest, AdaptiveBatchSizeMatchesFixed) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+    auto str = schema->AddDebugField("str", DataType::VARCHAR);
+
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+
+    proto::plan::GenericValue low;
+    low.set_int64_val(-1000);
+    proto::plan::GenericValue high;
+    high.set_int64_val(1000);
+    auto range = std::make_shared<expr::BinaryRangeFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64), low, high, true, false);
+    proto::plan::GenericValue prefix;
+    prefix.set_string_val("1");
+    auto like = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(str, DataType::VARCHAR),
+        proto::plan::OpType::PrefixMatch,
+        prefix,
+        std::vector<proto::plan::GenericValue>{});
+    auto conjunct = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::Or, like, range);
+
+    for (const auto& expr :
+         std::vector<expr::TypedExprPtr>{range, like, conjunct}) {
+        auto expected = ExecuteFilter(
+            expr,
+            segment.get(),
+            N,
+            {{exec::QueryConfig::kExprEvalBatchSize, "8192"}});
+        // small base batch sizes so that the adapted sizes vary a lot
+        for (auto base : {64, 1000, 8192}) {
+            EXEC_EVAL_EXPR_BATCH_SIZE.store(base);
+            auto result = ExecuteFilter(
+                expr,
+                segment.get(),
+                N,
+                {{exec::QueryConfig::kExprEvalAdaptiveBatchSize, "true"}});
+            ASSERT_EQ(result.size(), N);
+            EXPECT_TRUE(result == expected) << base;
+        }
+        EXEC_EVAL_EXPR_BATCH_SIZE.store(DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE);
+    }
+}
+
+TEST(FilterBitsNodeTest, AdaptiveConjunctOrderMatchesRows) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+    auto f64 = schema->AddDebugField("f64", DataType::DOUBLE);
+
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    auto f64_values = dataset.get_col<double>(f64);
+
+    // i64 is the row offset, the range drops most rows of the later batches
+    // so the inputs trade places once their costs are measured
+    proto::plan::GenericValue low;
+    low.set_int64_val(0);
+    proto::plan::GenericValue high;
+    high.set_int64_val(5000);
+    auto range = std::make_shared<expr::BinaryRangeFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64), low, high, true, false);
+    proto::plan::GenericValue zero;
+    zero.set_float_val(0);
+    auto positive = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(f64, DataType::DOUBLE),
+        proto::plan::OpType::GreaterThan,
+        zero,
+        std::vector<proto::plan::GenericValue>{});
+
+    for (auto op : {expr::LogicalBinaryExpr::OpType::And,
+                    expr::LogicalBinaryExpr::OpType::Or}) {
+        auto conjunct =
+            std::make_shared<expr::LogicalBinaryExpr>(op, positive, range);
+        auto result = ExecuteFilter(conjunct, segment.get(), N, 1);
+        ASSERT_EQ(result.size(), N);
+        for (int64_t i = 0; i < N; i++) {
+            auto in_range = i < 5000;
+            auto is_positive = f64_values[i] > 0;
+            auto expected = op == expr::LogicalBinaryExpr::OpType::And
+                                ? in_range && is_positive
+                                : in_range || is_positive;
+            // the result is flipped, set rows are filtered out
+            ASSERT_EQ(result[i], !expected) << i;
+        }
+    }
+}
+
+TEST(FilterBitsNodeTest, SparseConjunctInputMatchesRows) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+    auto f64 = schema->AddDebugField("f64", DataType::DOUBLE);
+
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    auto f64_values = dataset.get_col<double>(f64);
+
+    // i64 is the row offset, the term leaves a few rows of some batches for
+    // the range to see by offset
+    std::vector<int64_t> picked = {0, 3, 8191, 8192, 20000, 20001, N - 1};
+    std::vector<proto::plan::GenericValue> vals;
+    for (auto value : picked) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        vals.push_back(val);
+    }
+    auto term = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64), vals);
+    proto::plan::GenericValue zero;
+    zero.set_float_val(0);
+    auto positive = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(f64, DataType::DOUBLE),
+        proto::plan::OpType::GreaterThan,
+        zero,
+        std::vector<proto::plan::GenericValue>{});
+
+    auto conjunct = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And, term, positive);
+    auto result = ExecuteFilter(conjunct, segment.get(), N, 1);
+    ASSERT_EQ(result.size(), N);
+    for (int64_t i = 0; i < N; i++) {
+        auto expected =
+            std::find(picked.begin(), picked.end(), i) != picked.end() &&
+            f64_values[i] > 0;
+        // the result is flipped, set rows are filtered out
+        ASSERT_EQ(result[i], !expected) << i;
+    }
+}
+
+TEST(FilterBitsNodeTest, RewrittenConjunctMatchesRows) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+    auto f64 = schema->AddDebugField("f64", DataType::DOUBLE);
+
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    auto f64_values = dataset.get_col<double>(f64);
+
+    auto int64_val = [](int64_t value) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        return val;
+    };
+    auto i64_unary = [&](proto::plan::OpType op, int64_t value) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(i64, DataType::INT64),
+            op,
+            int64_val(value),
+            std::vector<proto::plan::GenericValue>{});
+    };
+    proto::plan::GenericValue zero;
+    zero.set_float_val(0);
+    auto positive = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(f64, DataType::DOUBLE),
+        proto::plan::OpType::GreaterThan,
+        zero,
+        std::vector<proto::plan::GenericValue>{});
+    auto logical = [](expr::LogicalBinaryExpr::OpType op,
+                      const expr::TypedExprPtr& left,
+                      const expr::TypedExprPtr& right) {
+        return std::make_shared<expr::LogicalBinaryExpr>(op, left, right);
+    };
+    using OpType = expr::LogicalBinaryExpr::OpType;
+
+    // i64 is the row offset. The bounds of i64 merge into a range, the
+    // repeated f64 filter is dropped and the equalities of i64 join the term.
+    auto range = logical(
+        OpType::And,
+        logical(OpType::And,
+                logical(OpType::And,
+                        i64_unary(proto::plan::OpType::GreaterThan, 1000),
+                        positive),
+                i64_unary(proto::plan::OpType::LessEqual, 3000)),
+        positive);
+    auto term = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64),
+        std::vector<proto::plan::GenericValue>{int64_val(7), int64_val(9)});
+    auto values = logical(OpType::Or,
+                          i64_unary(proto::plan::OpType::Equal, 5),
+                          logical(OpType::Or,
+                                  term,
+                                  i64_unary(proto::plan::OpType::Equal, 9)));
+    auto filter = logical(OpType::Or, range, values);
+
+    auto result = ExecuteFilter(filter, segment.get(), N, 1);
+    ASSERT_EQ(result.size(), N);
+    for (int64_t i = 0; i < N; i++) {
+        auto expected = (i > 1000 && i <= 3000 && f64_values[i] > 0) ||
+                        i == 5 || i == 7 || i == 9;
+        // the result is flipped, set rows are filtered out
+        ASSERT_EQ(result[i], !expected) << i;
+    }
+}
+
+TEST(FilterBitsNodeTest, RewrittenArithMatchesRows) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i32 = schema->AddDebugField("i32", DataType::INT32);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+    auto ts = schema->AddDebugField("ts", DataType::TIMESTAMPTZ);
+
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+
+    auto int64_val = [](int64_t value) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        return val;
+    };
+    auto apply = [](proto::plan::ArithOpType op, int64_t x, int64_t c) {
+        switch (op) {
+            case proto::plan::ArithOpType::Add:
+                return x + c;
+            case proto::plan::ArithOpType::Sub:
+                return x - c;
+            case proto::plan::ArithOpType::Mul:
+                return x * c;
+            default:
+                return x / c;
+        }
+    };
+    auto compare = [](proto::plan::OpType op, int64_t left, int64_t right) {
+        switch (op) {
+            case proto::plan::OpType::Equal:
+                return left == right;
+            case proto::plan::OpType::NotEqual:
+                return left != right;
+            case proto::plan::OpType::GreaterThan:
+                return left > right;
+            case proto::plan::OpType::GreaterEqual:
+                return left >= right;
+            case proto::plan::OpType::LessThan:
+                return left < right;
+            default:
+                return left <= right;
+        }
+    };
+
+    // i32 and i64 are the row offset. Negative bounds and quotients check
+    // the rounding toward zero of div.
+    struct Case {
+        FieldId field;
+        DataType type;
+        proto::plan::ArithOpType arith;
+        int64_t operand;
+        proto::plan::OpType cmp;
+        int64_t value;
+    };
+    using Arith = proto::plan::ArithOpType;
+    using Cmp = proto::plan::OpType;
+    std::vector<Case> cases{
+        {i32, DataType::INT32, Arith::Add, 5, Cmp::GreaterThan, 10'000},
+        {i32, DataType::INT32, Arith::Sub, 7, Cmp::LessEqual, 3},
+        {i32, DataType::INT32, Arith::Add, -5, Cmp::NotEqual, 100},
+        {i32, DataType::INT32, Arith::Mul, 3, Cmp::GreaterEqual, 1'000},
+        {i32, DataType::INT32, Arith::Mul, 3, Cmp::LessThan, 1'000},
+        {i32, DataType::INT32, Arith::Mul, 4, Cmp::Equal, 1'000},
+        {i32, DataType::INT32, Arith::Mul, -2, Cmp::LessThan, -1'000},
+        {i32, DataType::INT32, Arith::Div, 7, Cmp::Equal, 13},
+        {i32, DataType::INT32, Arith::Div, 7, Cmp::GreaterThan, -1},
+        {i64, DataType::INT64, Arith::Div, 10, Cmp::LessEqual, 0},
+        {i64, DataType::INT64, Arith::Div, 10, Cmp::GreaterEqual, 4'321},
+        {i64, DataType::INT64, Arith::Add, 1, Cmp::LessThan, 20},
+    };
+    for (const auto& c : cases) {
+        auto filter = std::make_shared<expr::BinaryArithOpEvalRangeExpr>(
+            expr::ColumnInfo(c.field, c.type),
+            c.cmp,
+            c.arith,
+            int64_val(c.value),
+            int64_val(c.operand));
+        auto result = ExecuteFilter(filter, segment.get(), N, 1);
+        ASSERT_EQ(result.size(), N);
+        for (int64_t i = 0; i < N; i++) {
+            auto expected =
+                compare(c.cmp, apply(c.arith, i, c.operand), c.value);
+            // the result is flipped, set rows are filtered out
+            ASSERT_EQ(result[i], !expected) << filter->ToString() << " " << i;
+        }
+    }
+
+    // the column is truncated to whole seconds before it is shifted
+    auto ts_values = dataset.get_col<int64_t>(ts);
+    auto shifted = [](int64_t us, int64_t seconds) {
+        auto floor = us >= 0 ? us / 1'000'000 : (us - 999'999) / 1'000'000;
+        return (floor + seconds) * 1'000'000;
+    };
+    struct TsCase {
+        proto::plan::ArithOpType arith;
+        int64_t days;
+        int64_t seconds;
+        proto::plan::OpType cmp;
+        int64_t value;
+    };
+    std::vector<TsCase> ts_cases{
+        {Arith::Unknown, 0, 0, Cmp::GreaterEqual, 30'000},
+        {Arith::Add, 1, 0, Cmp::GreaterThan, 86'400'000'000},
+        {Arith::Add, 1, 0, Cmp::GreaterEqual, 86'400'000'000},
+        {Arith::Sub, 0, 2, Cmp::Equal, -2'000'000},
+        {Arith::Add, 0, 30, Cmp::LessThan, 30'000'001},
+    };
+    for (const auto& c : ts_cases) {
+        proto::plan::Interval interval;
+        interval.set_days(c.days);
+        interval.set_seconds(c.seconds);
+        auto filter = std::make_shared<expr::TimestamptzArithCompareExpr>(
+            expr::ColumnInfo(ts, DataType::TIMESTAMPTZ),
+            c.arith,
+            interval,
+            c.cmp,
+            int64_val(c.value));
+        auto result = ExecuteFilter(filter, segment.get(), N, 1);
+        ASSERT_EQ(result.size(), N);
+        auto sign = c.arith == Arith::Sub ? -1 : 1;
+        for (int64_t i = 0; i < N; i++) {
+            auto left =
+                c.arith == Arith::Unknown
+                    ? ts_values[i]
+                    : shifted(ts_values[i],
+                              sign * (c.days * 86'400 + c.seconds));
+            ASSERT_EQ(result[i], !compare(c.cmp, left, c.value))
+                << filter->ToString() << " " << i;
+        }
+    }
+}
+
+TEST(FilterBitsNodeTest, RetrieveLimitStopsEarly) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto i64 = schema->AddDebugField("i64", DataType::INT64);
+
+    const int64_t N = 57'321;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+
+    // i64 is the row offset, the first batch has no hit
+    proto::plan::GenericValue bound;
+    bound.set_int64_val(1000);
+    auto range = std::make_shared<expr::UnaryRangeFilterExpr>(
+        expr::ColumnInfo(i64, DataType::INT64),
+        proto::plan::OpType::GreaterThan,
+        bound,
+        std::vector<proto::plan::GenericValue>{});
+
+    std::unordered_map<std::string, std::string> config = {
+        {exec::QueryConfig::kExprEvalBatchSize, "1000"}};
+    auto expected = ExecuteFilter(range, segment.get(), N, config);
+    for (int64_t limit : {1, 10, 100}) {
+        auto result = ExecuteFilter(range, segment.get(), N, config, limit);
+        ASSERT_EQ(result.size(), N);
+        // the first limit + 1 hits are kept, the rows evaluated past them
+        // may be kept too, all others are filtered out
+        int64_t hits = 0;
+        for (int64_t i = 0; i < N && hits <= limit; i++) {
+            ASSERT_EQ(result[i], expected[i]) << limit << " " << i;
+            hits += !expected[i];
+        }
+        ASSERT_GT(hits, limit);
+        EXPECT_GT(result.count(), expected.count()) << limit;
+    }
+}
+
+TEST(FilterBitsNodeTest, BatchSizeController) {
+    exec::BatchSizeController fixed(8192, exec::ExprCostClass::kCheap, false);
+    EXPECT_EQ(fixed.batch_size(), 8192);
+    fixed.Record(8192, 1);
+    EXPECT_EQ(fixed.batch_size(), 8192);
+
+    exec::BatchSizeController cheap(8192, exec::ExprCostClass::kCheap, true);
+    EXPECT_EQ(cheap.batch_size(), 4 * 8192);
+    exec::BatchSizeController expensive(
+        8192, exec::ExprCostClass::kExpensive, true);
+    EXPECT_EQ(expensive.batch_size(), 8192 / 4);
+
+    exec::BatchSizeController controller(
+        8192, exec::ExprCostClass::kModerate, true);
+    EXPECT_EQ(controller.batch_size(), 8192);
+    // 100ns a row, a batch should be about 500 rows
+    for (int i = 0; i < 20; i++) {
+        const auto rows = controller.batch_size();
+        controller.Record(rows, rows * 100);
+    }
+    EXPECT_EQ(controller.batch_size(), controller.min_batch_size());
+    // 1ns a row, capped at the largest batch size
+    for (int i = 0; i < 20; i++) {
+        const auto rows = controller.batch_size();
+        controller.Record(rows, rows);
+    }
+    EXPECT_EQ(controller.batch_size(), controller.max_batch_size());
+    EXPECT_EQ(controller.batch_size() % 64, 0);
+}
@@ -15,7 +15,11 @@
 // limitations under the License.
 
 #include "IterativeFilterNode.h"
+
+#include <algorithm>
+
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 
 #include "exec/Driver.h"
@@ -55,82 +59,33 @@ PhyIterativeFilterNode::IsFinished() {
     return is_finished_;
 }
 
-template <bool large_is_better>
-inline size_t
-find_binsert_position(const std::vector<float>& distances,
-                      size_t lo,
-                      size_t hi,
-                      float dist) {
-    while (lo < hi) {
-        size_t mid = lo + ((hi - lo) >> 1);
-        if constexpr (large_is_better) {
-            if (distances[mid] < dist) {
-                hi = mid;
-            } else {
-                lo = mid + 1;
-            }
-        } else {
-            if (distances[mid] > dist) {
-                hi = mid;
-            } else {
-                lo = mid + 1;
-            }
-        }
+namespace {
+
+// candidates pulled from an iterator at once, whatever the pass rate
+constexpr int64_t kMaxIterativeFilterBatchSize = 8192;
+
+struct IterativeFilterHit {
+    float distance_;
+    int64_t seg_offset_;
+    int32_t element_index_;
+};
+
+// enough candidates to fill the remaining slots at the pass rate observed so
+// far, smoothed so the first batches of a selective filter still grow
+int64_t
+NextIterativeFilterBatchSize(int64_t remaining,
+                             int64_t num_pulled,
+                             int64_t num_passed) {
+    if (num_pulled == 0) {
+        return remaining;
     }
-    return lo;
+    auto estimate = remaining * (num_pulled + 1) / (num_passed + 1);
+    return std::clamp(estimate,
+                      remaining,
+                      std::max(remaining, kMaxIterativeFilterBatchSize));
 }
 
-inline void
-insert_helper(milvus::SearchResult& search_result,
-              int& topk,
-              const bool large_is_better,
-              const FixedVector<float>& distances,
-              const FixedVector<int32_t>& offsets,
-              const int64_t nq_index,
-              const int64_t unity_topk,
-              const int i,
-              const IArrayOffsets* array_offsets = nullptr) {
-    auto pos = large_is_better
-                   ? find_binsert_position<true>(search_result.distances_,
-                                                 nq_index * unity_topk,
-                                                 nq_index * unity_topk + topk,
-                                                 distances[i])
-                   : find_binsert_position<false>(search_result.distances_,
-                                                  nq_index * unity_topk,
-                                                  nq_index * unity_topk + topk,
-                                                  distances[i]);
-
-    // For element-level: convert element_id to (doc_id, element_index)
-    int64_t doc_id;
-    int32_t elem_idx = -1;
-    if (array_offsets != nullptr) {
-        auto [doc, idx] = array_offsets->ElementIDToRowID(offsets[i]);
-        doc_id = doc;
-        elem_idx = idx;
-    } else {
-        doc_id = offsets[i];
-    }
-
-    if (topk > pos) {
-        std::memmove(&search_result.distances_[pos + 1],
-                     &search_result.distances_[pos],
-                     (topk - pos) * sizeof(float));
-        std::memmove(&search_result.seg_offsets_[pos + 1],
-                     &search_result.seg_offsets_[pos],
-                     (topk - pos) * sizeof(int64_t));
-        if (array_offsets != nullptr) {
-            std::memmove(&search_result.element_indices_[pos + 1],
-                         &search_result.element_indices_[pos],
-                         (topk - pos) * sizeof(int32_t));
-        }
-    }
-    search_result.seg_offsets_[pos] = doc_id;
-    if (array_offsets != nullptr) {
-        search_result.element_indices_[pos] = elem_idx;
-    }
-    search_result.distances_[pos] = distances[i];
-    ++topk;
-}
+}  // namespace
 
 RowVectorPtr
 PhyIterativeFilterNode::GetOutput() {
@@ -140,8 +95,7 @@ PhyIterativeFilterNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyIterativeFilterNode::Execute", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyIterativeFilterNode::Execute", true);
 
     DeferLambda([&]() { is_finished_ = true; });
 
@@ -219,19 +173,35 @@ PhyIterativeFilterNode::GetOutput() {
         }
 
         // Reuse memory allocation across batches and nqs
+        FixedVector<int32_t> offsets;
+        FixedVector<float> distances;
         FixedVector<int32_t> doc_offsets;
         std::vector<int64_t> element_to_doc_mapping;
+        std::vector<int32_t> element_indices;
         std::unordered_map<int64_t, bool> doc_eval_cache;
         std::unordered_set<int64_t> unique_doc_ids;
+        std::vector<IterativeFilterHit> hits;
+        hits.reserve(unity_topk);
 
         for (auto& iterator : search_result.vector_iterators_.value()) {
             EvalCtx eval_ctx(operator_context_->get_exec_context());
-            int topk = 0;
-            while (iterator->HasNext() && topk < unity_topk) {
-                FixedVector<int32_t> offsets;
-                FixedVector<float> distances;
-                // remain unfilled size as iterator batch size
-                int64_t batch_size = unity_topk - topk;
+            hits.clear();
+            int64_t num_pulled = 0;
+            int64_t num_passed = 0;
+            // keeps the candidates passing the filter in iterator order
+            auto add_hit = [&](size_t i, int64_t doc_id) {
+                int32_t elem_idx = element_level ? element_indices[i] : -1;
+                hits.push_back({distances[i], doc_id, elem_idx});
+                return static_cast<int64_t>(hits.size()) == unity_topk;
+            };
+            while (iterator->HasNext() &&
+                   static_cast<int64_t>(hits.size()) < unity_topk) {
+                int64_t remaining =
+                    unity_topk - static_cast<int64_t>(hits.size());
+                int64_t batch_size = NextIterativeFilterBatchSize(
+                    remaining, num_pulled, num_passed);
+                offsets.clear();
+                distances.clear();
                 offsets.reserve(batch_size);
                 distances.reserve(batch_size);
                 while (iterator->HasNext()) {
@@ -249,6 +219,7 @@ PhyIterativeFilterNode::GetOutput() {
                         break;
                     }
                 }
+                num_pulled += offsets.size();
 
                 // Clear but retain capacity
                 doc_offsets.clear();
@@ -259,14 +230,15 @@ PhyIterativeFilterNode::GetOutput() {
                 if (element_level) {
                     // 1. Convert element_ids to doc_ids and do filter on those doc_ids
                     // 2. element_ids with doc_ids that pass the filter are what we interested in
-                    element_to_doc_mapping.reserve(offsets.size());
-
-                    for (auto element_id : offsets) {
-                        auto [doc_id, elem_index] =
-                            array_offsets->ElementIDToRowID(element_id);
-                        element_to_doc_mapping.push_back(doc_id);
-                        unique_doc_ids.insert(doc_id);
-                    }
+                    element_to_doc_mapping.resize(offsets.size());
+                    element_indices.resize(offsets.size());
+                    array_offsets->ElementIDsToRowIDs(
+                        offsets.data(),
+                        offsets.size(),
+                        element_to_doc_mapping.data(),
+                        element_indices.data());
+                    unique_doc_ids.insert(element_to_doc_mapping.begin(),
+                                          element_to_doc_mapping.end());
 
                     doc_offsets.reserve(unique_doc_ids.size());
                     for (auto doc_id : unique_doc_ids) {
@@ -276,6 +248,8 @@ PhyIterativeFilterNode::GetOutput() {
                     doc_offsets = offsets;
                 }
 
+                // the whole batch is filtered at once, the hits past the
+                // topk are dropped afterwards
                 if (is_native_supported_) {
                     eval_ctx.set_offset_input(&doc_offsets);
                     std::vector<VectorPtr> results;
@@ -302,16 +276,8 @@ PhyIterativeFilterNode::GetOutput() {
                         for (size_t i = 0; i < offsets.size(); ++i) {
                             int64_t doc_id = element_to_doc_mapping[i];
                             if (doc_eval_cache[doc_id]) {
-                                insert_helper(search_result,
-                                              topk,
-                                              large_is_better,
-                                              distances,
-                                              offsets,
-                                              nq_index,
-                                              unity_topk,
-                                              i,
-                                              array_offsets.get());
-                                if (topk == unity_topk) {
+                                ++num_passed;
+                                if (add_hit(i, doc_id)) {
                                     break;
                                 }
                             }
@@ -319,42 +285,53 @@ PhyIterativeFilterNode::GetOutput() {
                     } else {
                         Assert(bitsetview.size() <= batch_size);
                         Assert(bitsetview.size() == offsets.size());
-                        for (auto i = 0; i < offsets.size(); ++i) {
-                            if (bitsetview[i]) {
-                                insert_helper(search_result,
-                                              topk,
-                                              large_is_better,
-                                              distances,
-                                              offsets,
-                                              nq_index,
-                                              unity_topk,
-                                              i);
-                                if (topk == unity_topk) {
-                                    break;
-                                }
+                        num_passed += bitsetview.count();
+                        for (auto i = bitsetview.find_first(); i.has_value();
+                             i = bitsetview.find_next(i.value())) {
+                            if (add_hit(i.value(), offsets[i.value()])) {
+                                break;
                             }
                         }
                     }
                 } else {
                     Assert(!element_level);
-                    for (auto i = 0; i < offsets.size(); ++i) {
+                    for (size_t i = 0; i < offsets.size(); ++i) {
                         if (bitset[offsets[i]] > 0) {
-                            insert_helper(search_result,
-                                          topk,
-                                          large_is_better,
-                                          distances,
-                                          offsets,
-                                          nq_index,
-                                          unity_topk,
-                                          i);
-                            if (topk == unity_topk) {
+                            ++num_passed;
+                            if (add_hit(i, offsets[i])) {
                                 break;
                             }
                         }
                     }
                 }
-                if (topk == unity_topk) {
-                    break;
+            }
+
+            // the iterator is only roughly ordered, sort the kept hits once;
+            // stable so that ties keep the iterator order
+            if (large_is_better) {
+                std::stable_sort(
+                    hits.begin(),
+                    hits.end(),
+                    [](const IterativeFilterHit& l,
+                       const IterativeFilterHit& r) {
+                        return l.distance_ > r.distance_;
+                    });
+            } else {
+                std::stable_sort(
+                    hits.begin(),
+                    hits.end(),
+                    [](const IterativeFilterHit& l,
+                       const IterativeFilterHit& r) {
+                        return l.distance_ < r.distance_;
+                    });
+            }
+            auto base = nq_index * unity_topk;
+            for (size_t i = 0; i < hits.size(); ++i) {
+                search_result.distances_[base + i] = hits[i].distance_;
+                search_result.seg_offsets_[base + i] = hits[i].seg_offset_;
+                if (element_level) {
+                    search_result.element_indices_[base + i] =
+                        hits[i].element_index_;
                 }
             }
             nq_index++;
@@ -370,9 +347,9 @@ PhyIterativeFilterNode::GetOutput() {
         scalar_cost / 1000);
 
     if (!is_native_supported_) {
-        tracer::AddEvent(fmt::format("total_processed: {}, matched: {}",
-                                     need_process_rows_,
-                                     need_process_rows_ - bitset.count()));
+        tracer::AddEventFmt("total_processed: {}, matched: {}",
+                            need_process_rows_,
+                            need_process_rows_ - bitset.count());
     }
 
     return input_;
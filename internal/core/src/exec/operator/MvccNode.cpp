@@ -16,6 +16,7 @@
 
 #include "MvccNode.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 #include <iostream>
 namespace milvus {
@@ -53,7 +54,7 @@ PhyMvccNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span("PhyMvccNode::Execute", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyMvccNode::Execute", true);
 
     if (active_count_ == 0) {
         is_finished_ = true;
@@ -64,7 +65,7 @@ PhyMvccNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AddEvent(fmt::format("input_rows: {}", active_count_));
+    tracer::AddEventFmt("input_rows: {}", active_count_);
     // the first vector is filtering result and second bitset is a valid bitset
     // if valid_bitset[i]==false, means result[i] is null
     auto col_input = is_source_node_ ? std::make_shared<ColumnVector>(
@@ -73,17 +74,32 @@ PhyMvccNode::GetOutput() {
                                      : GetColumnVector(input_);
 
     TargetBitmapView data(col_input->GetRawData(), col_input->size());
+    is_finished_ = true;
+    if (query_context->filter_result_shared()) {
+        // masked by the search which published it
+        return std::move(input_);
+    }
     // need to expose null?
     segment_->mask_with_timestamps(
         data, query_timestamp_, collection_ttl_timestamp_);
     segment_->mask_with_delete(data, active_count_, query_timestamp_);
-    is_finished_ = true;
+    const auto& shared = query_context->get_shared_filter();
+    if (shared != nullptr && shared->owner() && !is_source_node_) {
+        shared->Publish(
+            data,
+            TargetBitmapView(col_input->GetValidRawData(), col_input->size()));
+    }
 
     auto output_rows = active_count_ - data.count();
-    tracer::AddEvent(fmt::format(
-        "output_rows: {}, filtered: {}", output_rows, data.count()));
+    tracer::AddEventFmt("output_rows: {}, filtered: {}",
+                        output_rows,
+                        data.count());
 
-    // input_ have already been updated
+    // input_ have already been updated in place, hand it on rather than
+    // wrapping its column again
+    if (!is_source_node_ && input_->childrens().size() == 1) {
+        return std::move(input_);
+    }
     return std::make_shared<RowVector>(std::vector<VectorPtr>{col_input});
 }
 
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "common/EasyAssert.h"
+#include "common/QueryResult.h"
 #include "common/Types.h"
 #include "common/Vector.h"
 #include "exec/Driver.h"
@@ -100,7 +101,12 @@ class Operator {
              const std::string& operator_type)
         : operator_context_(std::make_unique<OperatorContext>(
               ctx, plannode_id, operator_id, operator_type)),
-          output_type_(output_type) {
+          output_type_(output_type),
+          memory_tracker_(std::make_shared<MemoryTracker>(
+              operator_type + " " + plannode_id, QueryMemoryTracker(ctx))) {
+        stats_.operator_type = operator_type;
+        stats_.plannode_id = plannode_id;
+        stats_.operator_id = operator_id;
     }
 
     virtual ~Operator() = default;
@@ -173,6 +179,19 @@ class Operator {
         return output_type_;
     }
 
+    /// Execution profile of the operator, filled in by the driver around
+    /// the GetOutput and AddInput calls.
+    OperatorStats&
+    stats() {
+        return stats_;
+    }
+
+    /// The memory the operator holds, under the tracker of its query.
+    const std::shared_ptr<MemoryTracker>&
+    memory_tracker() const {
+        return memory_tracker_;
+    }
+
  protected:
     std::unique_ptr<OperatorContext> operator_context_;
 
@@ -183,6 +202,20 @@ class Operator {
     bool no_more_input_{false};
 
     std::vector<VectorPtr> results_;
+
+    OperatorStats stats_;
+
+    std::shared_ptr<MemoryTracker> memory_tracker_;
+
+ private:
+    static std::shared_ptr<MemoryTracker>
+    QueryMemoryTracker(DriverContext* ctx) {
+        if (ctx == nullptr || ctx->task_ == nullptr ||
+            ctx->task_->query_context() == nullptr) {
+            return nullptr;
+        }
+        return ctx->task_->query_context()->memory_tracker();
+    }
 };
 
 class SourceOperator : public Operator {
@@ -0,0 +1,130 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <time.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include "common/Common.h"
+#include "common/OpContext.h"
+#include "common/QueryResult.h"
+#include "common/Vector.h"
+#include "monitor/PerfCounters.h"
+
+namespace milvus {
+namespace exec {
+
+// chunks the skip index ruled out on the calling thread, an operator call
+// runs its expressions on the driver thread, so the difference around the
+// call belongs to the operator
+inline thread_local int64_t skipped_chunks_on_thread = 0;
+
+inline void
+RecordSkippedChunk() {
+    skipped_chunks_on_thread++;
+}
+
+inline int64_t
+ThreadCpuNanos() {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+/// Profiles one call of an operator into its OperatorStats. Rows, batches,
+/// pinned bytes and skipped chunks are counted on every call, the two clocks
+/// are only read on the first call and then on one call in every
+/// EXEC_PROFILE_SAMPLE_INTERVAL, which keeps the overhead to a few atomic
+/// loads on most calls. The timed calls of a query sampled by a
+/// monitor::PerfCounters::SampleScope also count the hardware events.
+class OperatorProfileScope {
+ public:
+    OperatorProfileScope(OperatorStats& stats, milvus::OpContext* op_ctx)
+        : stats_(stats), op_ctx_(op_ctx) {
+        auto interval = EXEC_PROFILE_SAMPLE_INTERVAL.load();
+        timed_ = interval > 0 && stats_.calls % interval == 0;
+        stats_.calls++;
+        skipped_chunks_ = skipped_chunks_on_thread;
+        if (op_ctx_ != nullptr) {
+            pinned_bytes_ = op_ctx_->storage_usage.scanned_total_bytes.load();
+        }
+        if (timed_) {
+            stats_.timed_calls++;
+            counted_ = monitor::PerfCounters::Sampling() &&
+                       monitor::PerfCounters::Read(events_start_);
+            cpu_start_ = ThreadCpuNanos();
+            wall_start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~OperatorProfileScope() {
+        if (timed_) {
+            stats_.wall_ns +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - wall_start_)
+                    .count();
+            stats_.cpu_ns += ThreadCpuNanos() - cpu_start_;
+        }
+        monitor::PerfCounterValues events_end;
+        if (counted_ && monitor::PerfCounters::Read(events_end)) {
+            auto events = events_end - events_start_;
+            stats_.counted_calls++;
+            stats_.cycles += events.cycles;
+            stats_.instructions += events.instructions;
+            stats_.llc_misses += events.llc_misses;
+            stats_.branch_misses += events.branch_misses;
+        }
+        if (op_ctx_ != nullptr) {
+            stats_.pinned_bytes +=
+                op_ctx_->storage_usage.scanned_total_bytes.load() -
+                pinned_bytes_;
+        }
+        stats_.skipped_chunks += skipped_chunks_on_thread - skipped_chunks_;
+    }
+
+    void
+    RecordInput(const RowVectorPtr& input) {
+        if (input != nullptr) {
+            stats_.input_rows += input->size();
+            stats_.input_batches++;
+        }
+    }
+
+    void
+    RecordOutput(const RowVectorPtr& output) {
+        if (output != nullptr) {
+            stats_.output_rows += output->size();
+            stats_.output_batches++;
+        }
+    }
+
+ private:
+    OperatorStats& stats_;
+    milvus::OpContext* op_ctx_;
+    bool timed_;
+    bool counted_{false};
+    int64_t skipped_chunks_;
+    int64_t pinned_bytes_{0};
+    int64_t cpu_start_{0};
+    std::chrono::steady_clock::time_point wall_start_;
+    monitor::PerfCounterValues events_start_;
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,130 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/Common.h"
+#include "exec/operator/OperatorProfile.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+class OperatorProfileTest : public testing::Test {
+ protected:
+    void
+    SetUp() override {
+        sample_interval_ = EXEC_PROFILE_SAMPLE_INTERVAL.load();
+    }
+
+    void
+    TearDown() override {
+        EXEC_PROFILE_SAMPLE_INTERVAL.store(sample_interval_);
+    }
+
+    int64_t sample_interval_;
+};
+
+TEST_F(OperatorProfileTest, CountsEveryCallAndTimesSamples) {
+    EXEC_PROFILE_SAMPLE_INTERVAL.store(4);
+    auto rows = std::make_shared<RowVector>(std::vector<VectorPtr>{
+        std::make_shared<ColumnVector>(DataType::INT64, 100)});
+    OperatorStats stats;
+    for (int i = 0; i < 10; i++) {
+        OperatorProfileScope profile(stats, nullptr);
+        profile.RecordInput(rows);
+        if (i % 2 == 0) {
+            profile.RecordOutput(rows);
+            RecordSkippedChunk();
+        }
+    }
+    EXPECT_EQ(stats.calls, 10);
+    // the first call and then one in every four
+    EXPECT_EQ(stats.timed_calls, 3);
+    EXPECT_EQ(stats.input_rows, 1000);
+    EXPECT_EQ(stats.input_batches, 10);
+    EXPECT_EQ(stats.output_rows, 500);
+    EXPECT_EQ(stats.output_batches, 5);
+    EXPECT_EQ(stats.skipped_chunks, 5);
+    EXPECT_EQ(stats.pinned_bytes, 0);
+
+    // chunks skipped outside of a profiled call are not counted
+    RecordSkippedChunk();
+    EXPECT_EQ(stats.skipped_chunks, 5);
+}
+
+TEST_F(OperatorProfileTest, DisabledTiming) {
+    EXEC_PROFILE_SAMPLE_INTERVAL.store(0);
+    OperatorStats stats;
+    for (int i = 0; i < 3; i++) {
+        OperatorProfileScope profile(stats, nullptr);
+    }
+    EXPECT_EQ(stats.calls, 3);
+    EXPECT_EQ(stats.timed_calls, 0);
+    EXPECT_EQ(stats.EstimatedWallNs(), 0);
+    EXPECT_EQ(stats.EstimatedCpuNs(), 0);
+}
+
+TEST_F(OperatorProfileTest, ScalesSampledTimes) {
+    OperatorStats stats;
+    stats.calls = 10;
+    stats.timed_calls = 2;
+    stats.wall_ns = 200;
+    stats.cpu_ns = 100;
+    OperatorStats other = stats;
+    other.input_rows = 7;
+    stats += other;
+    EXPECT_EQ(stats.calls, 20);
+    EXPECT_EQ(stats.EstimatedWallNs(), 2000);
+    EXPECT_EQ(stats.EstimatedCpuNs(), 1000);
+    EXPECT_EQ(stats.input_rows, 7);
+}
+
+TEST_F(OperatorProfileTest, CountsHardwareEventsOfSampledQueries) {
+    EXEC_PROFILE_SAMPLE_INTERVAL.store(1);
+    auto ratio = monitor::PerfCounters::SampleRatio();
+    monitor::PerfCounters::SetSampleRatio(0);
+    OperatorStats stats;
+    {
+        monitor::PerfCounters::SampleScope query;
+        OperatorProfileScope profile(stats, nullptr);
+    }
+    EXPECT_EQ(stats.counted_calls, 0);
+    EXPECT_EQ(stats.ToString().find("cycles"), std::string::npos);
+
+    monitor::PerfCounters::SetSampleRatio(1);
+    {
+        monitor::PerfCounters::SampleScope query;
+        if (!query.sampled()) {
+            monitor::PerfCounters::SetSampleRatio(ratio);
+            GTEST_SKIP() << "hardware counters are not available";
+        }
+        for (int i = 0; i < 2; i++) {
+            OperatorProfileScope profile(stats, nullptr);
+            volatile int64_t sum = 0;
+            for (int j = 0; j < 100'000; j++) {
+                sum += j;
+            }
+        }
+        EXPECT_GT(query.Elapsed().instructions, 0);
+    }
+    monitor::PerfCounters::SetSampleRatio(ratio);
+    EXPECT_FALSE(monitor::PerfCounters::Sampling());
+    EXPECT_EQ(stats.counted_calls, 2);
+    EXPECT_GT(stats.instructions, 100'000);
+    // the unsampled call is scaled in
+    EXPECT_GT(stats.EstimatedEvents(stats.instructions), stats.instructions);
+    EXPECT_NE(stats.ToString().find("cycles"), std::string::npos);
+}
@@ -0,0 +1,283 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "OrderByNode.h"
+
+#include <algorithm>
+#include <queue>
+#include <type_traits>
+
+#include "exec/TraceUtils.h"
+#include "exec/expression/Utils.h"
+#include "index/ScalarIndexSort.h"
+#include "index/StringIndexSort.h"
+#include "segcore/Utils.h"
+
+namespace milvus {
+namespace exec {
+
+PhyOrderByNode::PhyOrderByNode(
+    int32_t operator_id,
+    DriverContext* ctx,
+    const std::shared_ptr<const plan::OrderByNode>& order_by_node)
+    : Operator(ctx,
+               order_by_node->output_type(),
+               operator_id,
+               order_by_node->id(),
+               "PhyOrderByNode"),
+      field_id_(order_by_node->field_id()),
+      data_type_(order_by_node->data_type()),
+      ascending_(order_by_node->ascending()),
+      limit_(order_by_node->limit()) {
+    auto query_context =
+        operator_context_->get_exec_context()->get_query_context();
+    segment_ = query_context->get_segment();
+    op_context_ = query_context->get_op_context();
+    active_count_ = query_context->get_active_count();
+    AssertInfo(segment_, "segment_ cannot be nullptr for OrderByNode");
+}
+
+void
+PhyOrderByNode::AddInput(RowVectorPtr& input) {
+    input_ = std::move(input);
+}
+
+template <typename Walk, typename IsNull>
+std::vector<int64_t>
+PhyOrderByNode::TakeInIndexOrder(const TargetBitmapView& filtered,
+                                 Walk&& walk,
+                                 IsNull&& is_null) const {
+    std::vector<int64_t> offsets;
+    auto take = [&](int64_t offset) {
+        if (offset < static_cast<int64_t>(filtered.size()) &&
+            !filtered[offset]) {
+            offsets.push_back(offset);
+        }
+        return static_cast<int64_t>(offsets.size()) < limit_;
+    };
+    walk(take);
+    // the index holds the valid values only, the null rows follow them
+    if (static_cast<int64_t>(offsets.size()) < limit_ &&
+        segment_->get_schema()[field_id_].is_nullable()) {
+        filtered.for_each_batch(
+            [&](const int64_t* rows, size_t count) {
+                for (size_t i = 0; i < count; i++) {
+                    if (is_null(rows[i]) && !take(rows[i])) {
+                        return false;
+                    }
+                }
+                return true;
+            },
+            false);
+    }
+    return offsets;
+}
+
+template <typename T>
+std::optional<std::vector<int64_t>>
+PhyOrderByNode::SelectBySortIndex(const TargetBitmapView& filtered) const {
+    if (segment_->type() != SegmentType::Sealed) {
+        return std::nullopt;
+    }
+    auto pinned_indexes = segment_->PinIndex(op_context_, field_id_);
+    for (const auto& pinned : pinned_indexes) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            // the posting lists of the sorted unique values, walked without
+            // decoding the strings
+            auto sorted =
+                dynamic_cast<const index::StringIndexSort*>(pinned.get());
+            if (sorted == nullptr || sorted->IsNestedIndex()) {
+                continue;
+            }
+            return TakeInIndexOrder(
+                filtered,
+                [&](auto& take) {
+                    sorted->ForEachRowInOrder(ascending_, take);
+                },
+                [&](int64_t offset) { return !sorted->IsValid(offset); });
+        } else {
+            auto sorted =
+                dynamic_cast<const index::ScalarIndexSort<T>*>(pinned.get());
+            if (sorted == nullptr) {
+                continue;
+            }
+            return TakeInIndexOrder(
+                filtered,
+                [&](auto& take) {
+                    if (ascending_) {
+                        for (auto it = sorted->begin(); it != sorted->end();) {
+                            if (!take((it++)->idx_)) {
+                                break;
+                            }
+                        }
+                    } else {
+                        for (auto it = sorted->end();
+                             it != sorted->begin();) {
+                            if (!take((--it)->idx_)) {
+                                break;
+                            }
+                        }
+                    }
+                },
+                [&](int64_t offset) {
+                    return !sorted->Reverse_Lookup(offset).has_value();
+                });
+        }
+    }
+    return std::nullopt;
+}
+
+template <typename T>
+std::vector<int64_t>
+PhyOrderByNode::SelectByHeap(const TargetBitmapView& filtered) const {
+    using Entry = std::pair<T, int64_t>;
+    // whether a comes before b in the output, equal values by offset
+    auto before = [this](const Entry& a, const Entry& b) {
+        if (a.first < b.first || b.first < a.first) {
+            return ascending_ == (a.first < b.first);
+        }
+        return a.second < b.second;
+    };
+    // the top is the last row kept, the one a row before it replaces
+    std::priority_queue<Entry, std::vector<Entry>, decltype(before)> heap(
+        before);
+    std::vector<int64_t> nulls;
+    filtered.for_each_batch(
+        [&](const int64_t* rows, size_t count) {
+            TargetBitmap valid_map(count);
+            auto field_data = segcore::bulk_script_field_data(op_context_,
+                                                              field_id_,
+                                                              data_type_,
+                                                              rows,
+                                                              count,
+                                                              segment_,
+                                                              valid_map,
+                                                              true);
+            auto values = static_cast<const T*>(field_data->Data());
+            for (size_t i = 0; i < count; i++) {
+                if (!valid_map[i]) {
+                    if (static_cast<int64_t>(nulls.size()) < limit_) {
+                        nulls.push_back(rows[i]);
+                    }
+                    continue;
+                }
+                Entry entry(values[i], rows[i]);
+                if (static_cast<int64_t>(heap.size()) < limit_) {
+                    heap.push(std::move(entry));
+                } else if (before(entry, heap.top())) {
+                    heap.pop();
+                    heap.push(std::move(entry));
+                }
+            }
+            return true;
+        },
+        false);
+
+    std::vector<int64_t> offsets(heap.size());
+    for (auto i = offsets.size(); i > 0; i--) {
+        offsets[i - 1] = heap.top().second;
+        heap.pop();
+    }
+    for (auto offset : nulls) {
+        if (static_cast<int64_t>(offsets.size()) == limit_) {
+            break;
+        }
+        offsets.push_back(offset);
+    }
+    return offsets;
+}
+
+template <typename T>
+std::vector<int64_t>
+PhyOrderByNode::SelectRows(const TargetBitmapView& filtered) const {
+    auto offsets = SelectBySortIndex<T>(filtered);
+    if (offsets.has_value()) {
+        tracer::AddEventFmt("order_by: sort index");
+        return std::move(offsets.value());
+    }
+    return SelectByHeap<T>(filtered);
+}
+
+RowVectorPtr
+PhyOrderByNode::GetOutput() {
+    auto* query_context =
+        operator_context_->get_exec_context()->get_query_context();
+    milvus::exec::checkCancellation(query_context);
+
+    if (is_finished_ || input_ == nullptr) {
+        return nullptr;
+    }
+
+    tracer::LazyAutoSpan span("PhyOrderByNode::Execute", true);
+
+    auto input_col = GetColumnVector(input_);
+    TargetBitmapView filtered(input_col->GetRawData(), input_col->size());
+    std::vector<int64_t> offsets;
+    switch (data_type_) {
+        case DataType::BOOL:
+            offsets = SelectRows<bool>(filtered);
+            break;
+        case DataType::INT8:
+            offsets = SelectRows<int8_t>(filtered);
+            break;
+        case DataType::INT16:
+            offsets = SelectRows<int16_t>(filtered);
+            break;
+        case DataType::INT32:
+            offsets = SelectRows<int32_t>(filtered);
+            break;
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            offsets = SelectRows<int64_t>(filtered);
+            break;
+        case DataType::FLOAT:
+            offsets = SelectRows<float>(filtered);
+            break;
+        case DataType::DOUBLE:
+            offsets = SelectRows<double>(filtered);
+            break;
+        case DataType::VARCHAR:
+        case DataType::STRING:
+            offsets = SelectRows<std::string>(filtered);
+            break;
+        default:
+            ThrowInfo(DataTypeInvalid,
+                      "order by is not supported on data type {}",
+                      data_type_);
+    }
+    tracer::AddEventFmt("order_by_count: {}, active_count: {}",
+                        offsets.size(),
+                        active_count_);
+
+    is_finished_ = true;
+    if (offsets.empty()) {
+        return nullptr;
+    }
+    auto output =
+        std::make_shared<ColumnVector>(DataType::INT64, offsets.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        output->SetValueAt<int64_t>(i, offsets[i]);
+    }
+    return std::make_shared<RowVector>(std::vector<VectorPtr>{output});
+}
+
+bool
+PhyOrderByNode::IsFinished() {
+    return is_finished_;
+}
+
+}  // namespace exec
+}  // namespace milvus
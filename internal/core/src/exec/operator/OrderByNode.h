@@ -0,0 +1,105 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "exec/operator/Operator.h"
+
+namespace milvus {
+namespace exec {
+
+class PhyOrderByNode : public Operator {
+ public:
+    PhyOrderByNode(
+        int32_t operator_id,
+        DriverContext* ctx,
+        const std::shared_ptr<const plan::OrderByNode>& order_by_node);
+
+    bool
+    IsFilter() const override {
+        return false;
+    }
+
+    bool
+    NeedInput() const override {
+        return !input_;
+    }
+
+    void
+    AddInput(RowVectorPtr& input) override;
+
+    RowVectorPtr
+    GetOutput() override;
+
+    bool
+    IsFinished() override;
+
+    void
+    Close() override {
+    }
+
+    BlockingReason
+    IsBlocked(ContinueFuture* /* unused */) override {
+        return BlockingReason::kNotBlocked;
+    }
+
+    virtual std::string
+    ToString() const override {
+        return "PhyOrderByNode";
+    }
+
+ private:
+    // The offsets of the first limit_ rows filtered does not filter out, in
+    // the order of the field.
+    template <typename T>
+    std::vector<int64_t>
+    SelectRows(const TargetBitmapView& filtered) const;
+
+    // Walks a sort index of the field from the wanted end, nullopt if the
+    // segment has no such index.
+    template <typename T>
+    std::optional<std::vector<int64_t>>
+    SelectBySortIndex(const TargetBitmapView& filtered) const;
+
+    // Takes the rows walk(take) hands in index order, then the null rows
+    // is_null tells apart. walk stops once take returns false.
+    template <typename Walk, typename IsNull>
+    std::vector<int64_t>
+    TakeInIndexOrder(const TargetBitmapView& filtered,
+                     Walk&& walk,
+                     IsNull&& is_null) const;
+
+    // Reads the values of the rows in batches and keeps the limit_ best in a
+    // heap.
+    template <typename T>
+    std::vector<int64_t>
+    SelectByHeap(const TargetBitmapView& filtered) const;
+
+    const segcore::SegmentInternalInterface* segment_;
+    OpContext* op_context_;
+    FieldId field_id_;
+    DataType data_type_;
+    bool ascending_;
+    int64_t limit_;
+    int64_t active_count_{0};
+    bool is_finished_{false};
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,168 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+
+#include "common/Types.h"
+#include "index/ScalarIndexSort.h"
+#include "index/StringIndexSort.h"
+#include "plan/PlanNode.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/cachinglayer_test_utils.h"
+#include "test_utils/storage_test_utils.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+// whether to order by a sort index or by reading the values
+class OrderByNodeTest : public ::testing::TestWithParam<bool> {};
+
+INSTANTIATE_TEST_SUITE_P(OrderByNodeTest,
+                         OrderByNodeTest,
+                         ::testing::Values(false, true));
+
+TEST_P(OrderByNodeTest, FirstRowsInOrder) {
+    bool with_index = GetParam();
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto value_fid = schema->AddDebugField("value", DataType::INT64);
+
+    const int64_t N = 3000;
+    auto dataset = DataGen(schema, N);
+    auto size = dataset.raw_->mutable_fields_data()->size();
+    auto value_col = dataset.raw_->mutable_fields_data()
+                         ->at(size - 1)
+                         .mutable_scalars()
+                         ->mutable_long_data()
+                         ->mutable_data();
+    for (int i = 0; i < N; ++i) {
+        value_col->at(i) = (i * 7919) % 1000;
+    }
+    auto values = dataset.get_col<int64_t>(value_fid);
+
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    if (with_index) {
+        auto index = milvus::index::CreateScalarIndexSort<int64_t>();
+        index->Build(N, values.data());
+        LoadIndexInfo load_index_info;
+        load_index_info.field_id = value_fid.get();
+        load_index_info.field_type = DataType::INT64;
+        load_index_info.index_params = GenIndexParams(index.get());
+        load_index_info.cache_index =
+            CreateTestCacheIndex("test", std::move(index));
+        segment->LoadIndex(load_index_info);
+    }
+
+    const int64_t limit = 10;
+    for (bool ascending : {true, false}) {
+        auto plan = std::make_unique<query::RetrievePlan>(schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        auto mvcc = std::make_shared<plan::MvccNode>(
+            plan::GetNextPlanNodeId(), std::vector<plan::PlanNodePtr>{});
+        plan->plan_node_->plannodes_ = std::make_shared<plan::OrderByNode>(
+            plan::GetNextPlanNodeId(),
+            value_fid,
+            DataType::INT64,
+            ascending,
+            limit,
+            std::vector<plan::PlanNodePtr>{mvcc});
+        plan->plan_node_->limit_ = limit;
+        plan->field_ids_ = {value_fid};
+
+        auto retrieve_results = segment->Retrieve(
+            nullptr, plan.get(), 100000000, DEFAULT_MAX_OUTPUT_SIZE, false);
+        ASSERT_EQ(retrieve_results->fields_data_size(), 1);
+        auto& field = retrieve_results->fields_data(0);
+        ASSERT_EQ(field.scalars().long_data().data_size(), limit);
+
+        auto expected = values;
+        if (ascending) {
+            std::sort(expected.begin(), expected.end());
+        } else {
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+        }
+        for (int64_t i = 0; i < limit; ++i) {
+            EXPECT_EQ(field.scalars().long_data().data(i), expected[i]);
+        }
+    }
+}
+
+TEST_P(OrderByNodeTest, FirstStringRowsInOrder) {
+    bool with_index = GetParam();
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk_fid);
+    auto value_fid = schema->AddDebugField("value", DataType::VARCHAR);
+
+    const int64_t N = 3000;
+    auto dataset = DataGen(schema, N);
+    auto size = dataset.raw_->mutable_fields_data()->size();
+    auto value_col = dataset.raw_->mutable_fields_data()
+                         ->at(size - 1)
+                         .mutable_scalars()
+                         ->mutable_string_data()
+                         ->mutable_data();
+    for (int i = 0; i < N; ++i) {
+        value_col->at(i) = fmt::format("value_{:04d}", (i * 7919) % 1000);
+    }
+    auto values = dataset.get_col<std::string>(value_fid);
+
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    if (with_index) {
+        auto index = milvus::index::CreateStringIndexSort();
+        index->Build(N, values.data());
+        LoadIndexInfo load_index_info;
+        load_index_info.field_id = value_fid.get();
+        load_index_info.field_type = DataType::VARCHAR;
+        load_index_info.index_params = GenIndexParams(index.get());
+        load_index_info.cache_index =
+            CreateTestCacheIndex("test", std::move(index));
+        segment->LoadIndex(load_index_info);
+    }
+
+    const int64_t limit = 10;
+    for (bool ascending : {true, false}) {
+        auto plan = std::make_unique<query::RetrievePlan>(schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        auto mvcc = std::make_shared<plan::MvccNode>(
+            plan::GetNextPlanNodeId(), std::vector<plan::PlanNodePtr>{});
+        plan->plan_node_->plannodes_ = std::make_shared<plan::OrderByNode>(
+            plan::GetNextPlanNodeId(),
+            value_fid,
+            DataType::VARCHAR,
+            ascending,
+            limit,
+            std::vector<plan::PlanNodePtr>{mvcc});
+        plan->plan_node_->limit_ = limit;
+        plan->field_ids_ = {value_fid};
+
+        auto retrieve_results = segment->Retrieve(
+            nullptr, plan.get(), 100000000, DEFAULT_MAX_OUTPUT_SIZE, false);
+        ASSERT_EQ(retrieve_results->fields_data_size(), 1);
+        auto& field = retrieve_results->fields_data(0);
+        ASSERT_EQ(field.scalars().string_data().data_size(), limit);
+
+        auto expected = values;
+        if (ascending) {
+            std::sort(expected.begin(), expected.end());
+        } else {
+            std::sort(expected.begin(), expected.end(), std::greater<>());
+        }
+        for (int64_t i = 0; i < limit; ++i) {
+            EXPECT_EQ(field.scalars().string_data().data(i), expected[i]);
+        }
+    }
+}
@@ -16,6 +16,7 @@
 
 #include "RandomSampleNode.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 
 #include "exec/expression/Utils.h"
@@ -40,6 +41,15 @@ PhyRandomSampleNode::PhyRandomSampleNode(
                         ->get_query_context()
                         ->get_active_count();
     is_source_node_ = random_sample_node->sources().size() == 0;
+    if (random_sample_node->filter() != nullptr) {
+        std::vector<expr::TypedExprPtr> filters{random_sample_node->filter()};
+        filter_exprs_ = std::make_unique<ExprSet>(
+            filters, operator_context_->get_exec_context());
+        for (const auto& expr : filter_exprs_->exprs()) {
+            is_native_supported_ =
+                is_native_supported_ && expr->SupportOffsetInput();
+        }
+    }
 }
 
 void
@@ -88,6 +98,114 @@ PhyRandomSampleNode::Sample(const uint32_t N, const float factor) {
     return StandardSample(N, M, gen);
 }
 
+void
+PhyRandomSampleNode::SampleFilteredRows(const ColumnVectorPtr& input_col) {
+    TargetBitmapView input_data(input_col->GetRawData(), input_col->size());
+    // note: false means the elemnt is hit
+    size_t input_false_count = input_data.size() - input_data.count();
+
+    if (input_false_count > 0) {
+        FixedVector<uint32_t> pos{};
+        pos.reserve(input_false_count);
+        auto value = input_data.find_first(false);
+        while (value.has_value()) {
+            auto offset = value.value();
+            pos.push_back(offset);
+            value = input_data.find_next(offset, false);
+        }
+        assert(pos.size() == input_false_count);
+
+        input_data.set();
+        auto sampled = Sample(input_false_count, factor_);
+        assert(sampled.back() < input_false_count);
+        for (auto i = 0; i < sampled.size(); ++i) {
+            input_data[pos[sampled[i]]] = false;
+        }
+    }
+}
+
+ColumnVectorPtr
+PhyRandomSampleNode::EvalFilter() {
+    EvalCtx eval_ctx(operator_context_->get_exec_context());
+    TargetBitmap bitset;
+    TargetBitmap valid_bitset;
+    bitset.reserve(active_count_);
+    valid_bitset.reserve(active_count_);
+    std::vector<VectorPtr> results;
+    while (static_cast<int64_t>(bitset.size()) < active_count_) {
+        filter_exprs_->Eval(0, 1, true, eval_ctx, results);
+        AssertInfo(results.size() == 1 && results[0] != nullptr,
+                   "PhyRandomSampleNode filter result size should be size "
+                   "one and not be nullptr");
+        auto col_vec = std::dynamic_pointer_cast<ColumnVector>(results[0]);
+        AssertInfo(col_vec != nullptr && col_vec->IsBitmap(),
+                   "PhyRandomSampleNode filter result should be bitmap");
+        bitset.append(
+            TargetBitmapView(col_vec->GetRawData(), col_vec->size()));
+        valid_bitset.append(
+            TargetBitmapView(col_vec->GetValidRawData(), col_vec->size()));
+    }
+    Assert(static_cast<int64_t>(bitset.size()) == active_count_);
+    bitset.flip();
+    return std::make_shared<ColumnVector>(std::move(bitset),
+                                          std::move(valid_bitset));
+}
+
+ColumnVectorPtr
+PhyRandomSampleNode::DrawThenFilter() {
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    // the rows skipped before the next drawn row
+    std::geometric_distribution<int64_t> skip(factor_);
+    auto batch_size =
+        operator_context_->get_exec_context()->get_query_config()
+            ->get_expr_batch_size();
+
+    auto output = std::make_shared<ColumnVector>(
+        TargetBitmap(active_count_, true), TargetBitmap(active_count_, true));
+    TargetBitmapView data(output->GetRawData(), output->size());
+    EvalCtx eval_ctx(operator_context_->get_exec_context());
+    OffsetVector offsets;
+    std::vector<VectorPtr> results;
+    int64_t num_drawn = 0;
+    int64_t num_passed = 0;
+    int64_t next = skip(gen);
+    while (next < active_count_) {
+        offsets.clear();
+        while (next < active_count_ &&
+               static_cast<int64_t>(offsets.size()) < batch_size) {
+            offsets.push_back(static_cast<int32_t>(next));
+            next += 1 + skip(gen);
+        }
+        num_drawn += offsets.size();
+        eval_ctx.set_offset_input(&offsets);
+        filter_exprs_->Eval(0, 1, true, eval_ctx, results);
+        AssertInfo(results.size() == 1 && results[0] != nullptr,
+                   "PhyRandomSampleNode filter result size should be size "
+                   "one and not be nullptr");
+        auto col_vec = std::dynamic_pointer_cast<ColumnVector>(results[0]);
+        AssertInfo(col_vec != nullptr && col_vec->IsBitmap() &&
+                       col_vec->size() == offsets.size(),
+                   "PhyRandomSampleNode filter result should be a bitmap "
+                   "of the drawn rows");
+        TargetBitmapView passed(col_vec->GetRawData(), col_vec->size());
+        passed.for_each_batch([&](const int64_t* indices, size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                data[offsets[indices[i]]] = false;
+            }
+            num_passed += n;
+            return true;
+        });
+    }
+    tracer::AddEventFmt("drawn_count: {}, passed_count: {}",
+                        num_drawn,
+                        num_passed);
+    if (num_passed == 0) {
+        return nullptr;
+    }
+    return output;
+}
+
 RowVectorPtr
 PhyRandomSampleNode::GetOutput() {
     auto* query_context =
@@ -98,8 +216,7 @@ PhyRandomSampleNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyRandomSampleNode::Execute", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyRandomSampleNode::Execute", true);
 
     if (!is_source_node_ && input_ == nullptr) {
         return nullptr;
@@ -110,38 +227,26 @@ PhyRandomSampleNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AddEvent(fmt::format(
-        "sample_factor: {}, active_count: {}", factor_, active_count_));
+    tracer::AddEventFmt("sample_factor: {}, active_count: {}",
+                        factor_,
+                        active_count_);
 
     std::chrono::high_resolution_clock::time_point start =
         std::chrono::high_resolution_clock::now();
 
     RowVectorPtr result = nullptr;
-    if (!is_source_node_) {
-        auto input_col = GetColumnVector(input_);
-        TargetBitmapView input_data(input_col->GetRawData(), input_col->size());
-        // note: false means the elemnt is hit
-        size_t input_false_count = input_data.size() - input_data.count();
-
-        if (input_false_count > 0) {
-            FixedVector<uint32_t> pos{};
-            pos.reserve(input_false_count);
-            auto value = input_data.find_first(false);
-            while (value.has_value()) {
-                auto offset = value.value();
-                pos.push_back(offset);
-                value = input_data.find_next(offset, false);
-            }
-            assert(pos.size() == input_false_count);
-
-            input_data.set();
-            auto sampled = Sample(input_false_count, factor_);
-            assert(sampled.back() < input_false_count);
-            for (auto i = 0; i < sampled.size(); ++i) {
-                input_data[pos[sampled[i]]] = false;
-            }
+    if (filter_exprs_ != nullptr) {
+        ColumnVectorPtr output_col =
+            is_native_supported_ ? DrawThenFilter() : nullptr;
+        if (output_col == nullptr) {
+            output_col = EvalFilter();
+            SampleFilteredRows(output_col);
         }
-
+        result =
+            std::make_shared<RowVector>(std::vector<VectorPtr>{output_col});
+    } else if (!is_source_node_) {
+        auto input_col = GetColumnVector(input_);
+        SampleFilteredRows(input_col);
         result = std::make_shared<RowVector>(std::vector<VectorPtr>{input_col});
     } else {
         auto sample_output = std::make_shared<ColumnVector>(
@@ -183,9 +288,9 @@ PhyRandomSampleNode::GetOutput() {
         TargetBitmapView result_data(result_col->GetRawData(),
                                      result_col->size());
         auto sampled_count = result_col->size() - result_data.count();
-        tracer::AddEvent(fmt::format("sampled_count: {}, total_count: {}",
-                                     sampled_count,
-                                     active_count_));
+        tracer::AddEventFmt("sampled_count: {}, total_count: {}",
+                            sampled_count,
+                            active_count_);
     }
 
     is_finished_ = true;
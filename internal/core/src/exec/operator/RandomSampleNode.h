@@ -18,6 +18,7 @@
 
 #include <random>
 
+#include "exec/expression/Expr.h"
 #include "exec/operator/Operator.h"
 
 namespace milvus {
@@ -79,6 +80,25 @@ class PhyRandomSampleNode : public Operator {
     static FixedVector<uint32_t>
     Sample(const uint32_t N, const float factor);
 
+    // Keeps a sample of the rows input_col does not filter out, filtering out
+    // the others.
+    void
+    SampleFilteredRows(const ColumnVectorPtr& input_col);
+
+    // Evaluates the filter of the node on every row.
+    ColumnVectorPtr
+    EvalFilter();
+
+    // Draws every row with probability factor_, skipping a geometrically
+    // distributed count of rows between two draws, and evaluates the filter on
+    // the drawn rows only. Returns nullptr when no drawn row passes the filter,
+    // the rows passing it are then sampled from the whole segment.
+    ColumnVectorPtr
+    DrawThenFilter();
+
+    // set when the node evaluates the filter itself
+    std::unique_ptr<ExprSet> filter_exprs_;
+    bool is_native_supported_{true};
     float factor_{0};
     int64_t active_count_{0};
     bool is_finished_{false};
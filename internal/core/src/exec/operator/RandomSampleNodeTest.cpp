@@ -167,4 +167,60 @@ TEST(RandomSampleTest, SampleWithEmptyInput) {
     int data_size = field.scalars().long_data().data_size();
 
     assert(data_size == 0);
-}
\ No newline at end of file
+}
+TEST(RandomSampleTest, DrawThenFilter) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    schema->set_primary_field_id(fid_64);
+    auto fid_int = schema->AddDebugField("integer", DataType::INT64);
+
+    const int64_t N = 30000;
+    auto dataset = DataGen(schema, N);
+    auto size = dataset.raw_->mutable_fields_data()->size();
+    auto i64_col = dataset.raw_->mutable_fields_data()
+                       ->at(size - 1)
+                       .mutable_scalars()
+                       ->mutable_long_data()
+                       ->mutable_data();
+    for (int i = 0; i < N; ++i) {
+        i64_col->at(i) = i % 3;
+    }
+    // a single row matches 7
+    i64_col->at(N / 2) = 7;
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+
+    auto retrieve = [&](int64_t value) {
+        milvus::proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        auto expr = std::make_shared<milvus::expr::UnaryRangeFilterExpr>(
+            milvus::expr::ColumnInfo(
+                fid_int, DataType::INT64, std::vector<std::string>()),
+            OpType::Equal,
+            val,
+            std::vector<proto::plan::GenericValue>{});
+        plan::PlanNodePtr sample_node =
+            std::make_shared<plan::RandomSampleNode>(
+                DEFAULT_PLANNODE_ID, 0.01, expr);
+        auto plan = std::make_unique<query::RetrievePlan>(schema);
+        plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+        plan->plan_node_->plannodes_ = std::make_shared<plan::MvccNode>(
+            "1000", std::vector<plan::PlanNodePtr>{sample_node});
+        plan->field_ids_ = {fid_int};
+        auto retrieve_results = RetrieveWithDefaultOutputSizeAndLargeTimestamp(
+            segment.get(), plan.get());
+        return retrieve_results->fields_data(0).scalars().long_data();
+    };
+
+    // every row is drawn at 0.01, about 100 of the 10000 matching rows
+    auto sampled = retrieve(1);
+    for (int i = 0; i < sampled.data_size(); i++) {
+        ASSERT_EQ(sampled.data(i), 1);
+    }
+    EXPECT_GT(sampled.data_size(), 40);
+    EXPECT_LT(sampled.data_size(), 160);
+
+    // the single matching row is likely not drawn, it is still sampled
+    auto single = retrieve(7);
+    ASSERT_EQ(single.data_size(), 1);
+    EXPECT_EQ(single.data(0), 7);
+}
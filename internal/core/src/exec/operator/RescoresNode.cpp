@@ -15,9 +15,12 @@
 // limitations under the License.
 
 #include "RescoresNode.h"
+#include "common/Common.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "common/EasyAssert.h"
 #include "fmt/format.h"
+#include <algorithm>
 #include <cstddef>
 #include "exec/operator/Utils.h"
 #include "log/Log.h"
@@ -37,8 +40,43 @@ PhyRescoresNode::PhyRescoresNode(
                "PhyRescoresNode") {
     scorers_ = scorer->scorers();
     option_ = scorer->option();
+    boost_bounds_ = BoostBounds();
 };
 
+std::optional<std::pair<float, float>>
+PhyRescoresNode::BoostBounds() const {
+    // the merged scores of the offsets some scorer matched, by interval
+    // arithmetic over the score range of every scorer
+    auto function_multiply =
+        option_->function_mode() == proto::plan::FunctionModeMultiply;
+    float min_boost = function_multiply ? 1.0f : 0.0f;
+    float max_boost = min_boost;
+    for (const auto& scorer : scorers_) {
+        auto [min_score, max_score] = scorer->score_range();
+        if (function_multiply) {
+            if (min_score < 0) {
+                return std::nullopt;
+            }
+            min_boost *= std::min(1.0f, min_score);
+            max_boost *= std::max(1.0f, max_score);
+        } else {
+            min_boost += std::min(0.0f, min_score);
+            max_boost += std::max(0.0f, max_score);
+        }
+    }
+    // the offsets none matched keep their distance
+    auto boost_multiply =
+        option_->boost_mode() == proto::plan::BoostModeMultiply;
+    auto identity = boost_multiply ? 1.0f : 0.0f;
+    min_boost = std::min(min_boost, identity);
+    max_boost = std::max(max_boost, identity);
+    // a negative factor would turn the order of the distances around
+    if (boost_multiply && min_boost < 0) {
+        return std::nullopt;
+    }
+    return std::make_pair(min_boost, max_boost);
+}
+
 void
 PhyRescoresNode::AddInput(RowVectorPtr& input) {
     input_ = std::move(input);
@@ -59,8 +97,7 @@ PhyRescoresNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyRescoresNode::Execute", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyRescoresNode::Execute", true);
 
     DeferLambda([&]() { is_finished_ = true; });
 
@@ -71,8 +108,60 @@ PhyRescoresNode::GetOutput() {
     std::chrono::high_resolution_clock::time_point scalar_start =
         std::chrono::high_resolution_clock::now();
 
-    auto query_info = exec_context->get_query_config();
     milvus::SearchResult search_result = query_context_->get_search_result();
+    knowhere::MetricType metric_type = query_context_->get_metric_type();
+    bool large_is_better = PositivelyRelated(metric_type);
+
+    // Rescoring moves a distance by at most the boost bounds, so a row the
+    // search did not return can only enter the topk if its best possible
+    // final score beats the topk-th rescored one. Fetch more rows until no
+    // unfetched one can, or the fetch limit is reached.
+    auto topk = search_result.unity_topK_;
+    auto fetch_topk = topk;
+    auto max_fetch_topk =
+        CanFetchBeyondTopk(query_context_->get_search_info(), search_result)
+            ? std::min(topk * std::max<int64_t>(RESCORE_MAX_TOPK_FACTOR, 1),
+                       query_context_->get_active_count())
+            : topk;
+    std::vector<std::optional<float>> last_fetched;
+    while (true) {
+        if (fetch_topk < max_fetch_topk) {
+            last_fetched = LastFetched(search_result, large_is_better);
+        }
+        auto rescored_count = Rescore(search_result, large_is_better);
+        tracer::AddEventFmt("rescored_count: {}", rescored_count);
+        if (fetch_topk >= max_fetch_topk ||
+            TopkIsFinal(search_result, topk, last_fetched, large_is_better)) {
+            break;
+        }
+        fetch_topk = std::min(fetch_topk * 2, max_fetch_topk);
+        auto fetched = FetchTopk(fetch_topk);
+        if (!fetched.has_value()) {
+            break;
+        }
+        search_result = std::move(fetched.value());
+    }
+    if (search_result.unity_topK_ > topk) {
+        TruncateTopk(search_result, topk);
+    }
+    query_context_->set_search_result(std::move(search_result));
+
+    std::chrono::high_resolution_clock::time_point scalar_end =
+        std::chrono::high_resolution_clock::now();
+    double scalar_cost =
+        std::chrono::duration<double, std::micro>(scalar_end - scalar_start)
+            .count();
+    milvus::monitor::internal_core_search_latency_rescore.Observe(scalar_cost /
+                                                                  1000);
+
+    return input_;
+};
+
+size_t
+PhyRescoresNode::Rescore(milvus::SearchResult& search_result,
+                         bool large_is_better) {
+    ExecContext* exec_context = operator_context_->get_exec_context();
+    auto query_context_ = exec_context->get_query_context();
     auto segment = query_context_->get_segment();
     auto op_context = query_context_->get_op_context();
 
@@ -94,12 +183,11 @@ PhyRescoresNode::GetOutput() {
 
     // skip rescore if result was empty
     if (offsets.empty()) {
-        query_context_->set_search_result(std::move(search_result));
-        return input_;
+        return 0;
     }
 
-    std::vector<std::optional<float>> boost_scores(offsets.size());
     auto function_mode = option_->function_mode();
+    rescores::BoostScores boost_scores(offsets.size(), function_mode);
 
     for (auto& scorer : scorers_) {
         auto filter = scorer->filter();
@@ -181,17 +269,17 @@ PhyRescoresNode::GetOutput() {
     switch (boost_mode) {
         case proto::plan::BoostModeMultiply:
             for (auto i = 0; i < offsets.size(); i++) {
-                if (boost_scores[i].has_value()) {
+                if (boost_scores.valid[i]) {
                     search_result.distances_[offset_idx[i]] *=
-                        boost_scores[i].value();
+                        boost_scores.scores[i];
                 }
             }
             break;
         case proto::plan::BoostModeSum:
             for (auto i = 0; i < offsets.size(); i++) {
-                if (boost_scores[i].has_value()) {
+                if (boost_scores.valid[i]) {
                     search_result.distances_[offset_idx[i]] +=
-                        boost_scores[i].value();
+                        boost_scores.scores[i];
                 }
             }
 
@@ -201,22 +289,141 @@ PhyRescoresNode::GetOutput() {
                       fmt::format("unknown boost boost mode: {}", boost_mode));
     }
 
-    knowhere::MetricType metric_type = query_context_->get_metric_type();
-    bool large_is_better = PositivelyRelated(metric_type);
     sort_search_result(search_result, large_is_better);
-    query_context_->set_search_result(std::move(search_result));
+    return offsets.size();
+}
 
-    std::chrono::high_resolution_clock::time_point scalar_end =
-        std::chrono::high_resolution_clock::now();
-    double scalar_cost =
-        std::chrono::duration<double, std::micro>(scalar_end - scalar_start)
-            .count();
-    milvus::monitor::internal_core_search_latency_rescore.Observe(scalar_cost /
-                                                                  1000);
+bool
+PhyRescoresNode::CanFetchBeyondTopk(const SearchInfo& search_info,
+                                    const milvus::SearchResult& search_result) {
+    // iterators, range search and element level results are not a plain
+    // topk to fetch more of
+    return boost_bounds_.has_value() && !UseVectorIterator(search_info) &&
+           !search_info.iterator_v2_info_.has_value() &&
+           !search_info.search_params_.contains(knowhere::meta::RADIUS) &&
+           !search_result.HasIterators() && !search_result.element_level_ &&
+           search_result.unity_topK_ > 0;
+}
 
-    tracer::AddEvent(fmt::format("rescored_count: {}", offsets.size()));
+std::vector<std::optional<float>>
+PhyRescoresNode::LastFetched(const milvus::SearchResult& search_result,
+                             bool large_is_better) {
+    auto topk = search_result.unity_topK_;
+    std::vector<std::optional<float>> last_fetched(search_result.total_nq_);
+    for (int64_t q = 0; q < search_result.total_nq_; q++) {
+        auto begin = q * topk;
+        // fewer rows than asked for, every row was fetched
+        if (search_result.seg_offsets_[begin + topk - 1] < 0) {
+            continue;
+        }
+        auto last = search_result.distances_[begin];
+        for (auto i = begin; i < begin + topk; i++) {
+            last = large_is_better
+                       ? std::min(last, search_result.distances_[i])
+                       : std::max(last, search_result.distances_[i]);
+        }
+        last_fetched[q] = last;
+    }
+    return last_fetched;
+}
 
-    return input_;
-};
+bool
+PhyRescoresNode::TopkIsFinal(
+    const milvus::SearchResult& search_result,
+    int64_t topk,
+    const std::vector<std::optional<float>>& last_fetched,
+    bool large_is_better) {
+    auto [min_boost, max_boost] = boost_bounds_.value();
+    auto multiply = option_->boost_mode() == proto::plan::BoostModeMultiply;
+    for (int64_t q = 0; q < search_result.total_nq_; q++) {
+        if (!last_fetched[q].has_value()) {
+            continue;
+        }
+        // the unfetched rows are no better than the last fetched one, and
+        // the boost is monotonic in the distance
+        auto last = last_fetched[q].value();
+        auto kth = search_result.distances_[q * search_result.unity_topK_ +
+                                            topk - 1];
+        if (large_is_better) {
+            auto best_unfetched = multiply ? std::max(last * min_boost,
+                                                      last * max_boost)
+                                           : last + max_boost;
+            if (kth < best_unfetched) {
+                return false;
+            }
+        } else {
+            auto best_unfetched = multiply ? std::min(last * min_boost,
+                                                      last * max_boost)
+                                           : last + min_boost;
+            if (kth > best_unfetched) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::optional<milvus::SearchResult>
+PhyRescoresNode::FetchTopk(int64_t topk) {
+    ExecContext* exec_context = operator_context_->get_exec_context();
+    auto query_context_ = exec_context->get_query_context();
+    auto search_info = query_context_->get_search_info();
+    search_info.topk_ = topk;
+    // search lists no shorter than the topk, as the index asks
+    for (const auto& key : {"ef", "search_list"}) {
+        if (search_info.search_params_.contains(key) &&
+            search_info.search_params_[key].is_number_integer() &&
+            search_info.search_params_[key].get<int64_t>() < topk) {
+            search_info.search_params_[key] = topk;
+        }
+    }
+
+    auto col_input = GetColumnVector(input_);
+    milvus::BitsetView bitset((uint8_t*)col_input->GetRawData(),
+                              col_input->size());
+    auto& ph = query_context_->get_placeholder_group()->at(0);
+    milvus::SearchResult search_result;
+    try {
+        query_context_->get_segment()->vector_search(
+            search_info,
+            ph.get_blob(),
+            ph.get_offsets(),
+            ph.num_of_queries_,
+            query_context_->get_query_timestamp(),
+            bitset,
+            query_context_->get_op_context(),
+            search_result);
+    } catch (const std::exception& e) {
+        LOG_WARN("rescore keeps the rows it has, fetching topk {} failed: {}",
+                 topk,
+                 e.what());
+        return std::nullopt;
+    }
+    search_result.total_data_cnt_ = bitset.size();
+    search_result.element_level_ = ph.element_level_;
+    return search_result;
+}
+
+void
+PhyRescoresNode::TruncateTopk(milvus::SearchResult& search_result,
+                              int64_t topk) {
+    auto fetched_topk = search_result.unity_topK_;
+    std::vector<float> distances;
+    std::vector<int64_t> seg_offsets;
+    distances.reserve(search_result.total_nq_ * topk);
+    seg_offsets.reserve(search_result.total_nq_ * topk);
+    for (int64_t q = 0; q < search_result.total_nq_; q++) {
+        auto begin = q * fetched_topk;
+        distances.insert(distances.end(),
+                         search_result.distances_.begin() + begin,
+                         search_result.distances_.begin() + begin + topk);
+        seg_offsets.insert(seg_offsets.end(),
+                           search_result.seg_offsets_.begin() + begin,
+                           search_result.seg_offsets_.begin() + begin + topk);
+    }
+    search_result.distances_ = std::move(distances);
+    search_result.seg_offsets_ = std::move(seg_offsets);
+    search_result.unity_topK_ = topk;
+}
 
 }  // namespace milvus::exec
\ No newline at end of file
@@ -17,7 +17,10 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "exec/Driver.h"
 #include "exec/expression/Expr.h"
@@ -71,8 +74,43 @@ class PhyRescoresNode : public Operator {
     }
 
  private:
+    // [min, max] of what rescoring multiplies or adds a distance by,
+    // nullopt if it can turn the order of the distances around
+    std::optional<std::pair<float, float>>
+    BoostBounds() const;
+
+    // boosts the rows of search_result and sorts them again, returns the
+    // number of rows rescored
+    size_t
+    Rescore(milvus::SearchResult& search_result, bool large_is_better);
+
+    bool
+    CanFetchBeyondTopk(const SearchInfo& search_info,
+                       const milvus::SearchResult& search_result);
+
+    // the worst distance fetched for each query, nullopt for a query with
+    // fewer rows than its topk
+    std::vector<std::optional<float>>
+    LastFetched(const milvus::SearchResult& search_result,
+                bool large_is_better);
+
+    // whether no row past the fetched ones could be boosted into the topk
+    bool
+    TopkIsFinal(const milvus::SearchResult& search_result,
+                int64_t topk,
+                const std::vector<std::optional<float>>& last_fetched,
+                bool large_is_better);
+
+    // searches the segment again for topk rows, nullopt if it fails
+    std::optional<milvus::SearchResult>
+    FetchTopk(int64_t topk);
+
+    void
+    TruncateTopk(milvus::SearchResult& search_result, int64_t topk);
+
     std::vector<std::shared_ptr<rescores::Scorer>> scorers_;
     const proto::plan::ScoreOption* option_;
+    std::optional<std::pair<float, float>> boost_bounds_;
     bool is_finished_{false};
 };
 }  // namespace milvus::exec
@@ -15,6 +15,7 @@
 // limitations under the License.
 
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 #include "SearchGroupByNode.h"
 #include "exec/operator/search-groupby/SearchGroupByOperator.h"
@@ -49,15 +50,14 @@ PhySearchGroupByNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyGroupByNode::Execute", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyGroupByNode::Execute", true);
 
     DeferLambda([&]() { is_finished_ = true; });
     if (input_ == nullptr) {
         return nullptr;
     }
 
-    tracer::AddEvent(fmt::format("group_size: {}", search_info_.group_size_));
+    tracer::AddEventFmt("group_size: {}", search_info_.group_size_);
 
     std::chrono::high_resolution_clock::time_point vector_start =
         std::chrono::high_resolution_clock::now();
@@ -87,8 +87,8 @@ PhySearchGroupByNode::GetOutput() {
                    search_result.group_by_values_.value().size(),
                    search_result.seg_offsets_.size());
     }
-    tracer::AddEvent(
-        fmt::format("grouped_results: {}", search_result.seg_offsets_.size()));
+    tracer::AddEventFmt("grouped_results: {}",
+                        search_result.seg_offsets_.size());
 
     query_context_->set_search_result(std::move(search_result));
     std::chrono::high_resolution_clock::time_point vector_end =
@@ -16,6 +16,7 @@
 
 #include "VectorSearchNode.h"
 #include "common/Tracer.h"
+#include "exec/TraceUtils.h"
 #include "fmt/format.h"
 #include "common/ArrayOffsets.h"
 #include "exec/operator/Utils.h"
@@ -64,16 +65,15 @@ PhyVectorSearchNode::GetOutput() {
         return nullptr;
     }
 
-    tracer::AutoSpan span(
-        "PhyVectorSearchNode::Execute", tracer::GetRootSpan(), true);
+    tracer::LazyAutoSpan span("PhyVectorSearchNode::Execute", true);
 
     DeferLambda([&]() { is_finished_ = true; });
     if (input_ == nullptr) {
         return nullptr;
     }
 
-    span.GetSpan()->SetAttribute("search_type", search_info_.metric_type_);
-    span.GetSpan()->SetAttribute("topk", search_info_.topk_);
+    span.SetAttribute("search_type", search_info_.metric_type_);
+    span.SetAttribute("topk", search_info_.topk_);
 
     std::chrono::high_resolution_clock::time_point vector_start =
         std::chrono::high_resolution_clock::now();
@@ -111,7 +111,7 @@ PhyVectorSearchNode::GetOutput() {
         std::vector<VectorPtr> col_res;
         col_res.push_back(std::make_shared<ColumnVector>(
             std::move(element_bitset), std::move(valid_element_bitset)));
-        input_ = std::make_shared<RowVector>(col_res);
+        input_ = std::make_shared<RowVector>(std::move(col_res));
     }
 
     milvus::SearchResult search_result;
@@ -129,21 +129,27 @@ PhyVectorSearchNode::GetOutput() {
     milvus::BitsetView final_view((uint8_t*)col_input->GetRawData(),
                                   col_input->size());
     auto op_context = query_context_->get_op_context();
-    // todo(SpadeA): need to pass element_level to make check more rigorously?
-    segment_->vector_search(search_info_,
-                            src_data,
-                            src_offsets,
-                            num_queries,
-                            query_timestamp_,
-                            final_view,
-                            op_context,
-                            search_result);
+    if (!ph.texts_.empty()) {
+        segment_->text_match_search(
+            search_info_, ph.texts_, final_view, op_context, search_result);
+    } else {
+        // todo(SpadeA): need to pass element_level to make check more
+        // rigorously?
+        segment_->vector_search(search_info_,
+                                src_data,
+                                src_offsets,
+                                num_queries,
+                                query_timestamp_,
+                                final_view,
+                                op_context,
+                                search_result);
+    }
 
     search_result.total_data_cnt_ = final_view.size();
     search_result.element_level_ = ph.element_level_;
 
-    span.GetSpan()->SetAttribute(
-        "result_count", static_cast<int>(search_result.seg_offsets_.size()));
+    span.SetAttribute("result_count",
+                      static_cast<int>(search_result.seg_offsets_.size()));
 
     query_context_->set_search_result(std::move(search_result));
     std::chrono::high_resolution_clock::time_point vector_end =
@@ -77,6 +77,45 @@ class Aggregate {
     virtual void
     extractValues(char** groups, int32_t numGroups, VectorPtr* result) = 0;
 
+    /// Type of the intermediate results written by extractAccumulators() and
+    /// merged by addIntermediateResults(). Aggregates whose final value is
+    /// not mergeable keep their serialized state in a VARCHAR column.
+    virtual DataType
+    intermediateType() const {
+        return result_type_;
+    }
+
+    /// Writes the mergeable state of each of 'groups' into 'result', so that
+    /// partial aggregations can be combined later on without the raw rows.
+    virtual void
+    extractAccumulators(char** groups, int32_t numGroups, VectorPtr* result) {
+        extractValues(groups, numGroups, result);
+    }
+
+    /// Merges the intermediate results in 'input', row i into groups[i].
+    virtual void
+    addIntermediateResults(char** groups,
+                           int numGroups,
+                           const std::vector<VectorPtr>& input) {
+        ThrowInfo(OpTypeInvalid,
+                  "aggregate does not support merging intermediate results");
+    }
+
+    /// Merges all intermediate results in 'input' into 'group'.
+    virtual void
+    addSingleGroupIntermediateResults(char* group,
+                                      const std::vector<VectorPtr>& input) {
+        ThrowInfo(OpTypeInvalid,
+                  "aggregate does not support merging intermediate results");
+    }
+
+    /// Frees the memory the accumulators of 'groups' hold outside of the
+    /// group rows. Called once before the rows are freed, only for
+    /// aggregates that are not fixed size.
+    virtual void
+    destroy(folly::Range<char**> groups) {
+    }
+
     template <typename T>
     T*
     value(char* group) const {
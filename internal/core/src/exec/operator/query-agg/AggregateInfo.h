@@ -31,6 +31,14 @@ struct AggregateInfo {
 
     /// Index of the result column in the output RowVector.
     column_index_t output_;
+
+    /// True if the input columns hold intermediate results of partial
+    /// aggregations to merge, instead of raw values.
+    bool intermediate_input_{false};
+
+    /// True to output the intermediate results, see
+    /// Aggregate::extractAccumulators(), instead of the final values.
+    bool intermediate_output_{false};
 };
 
 std::vector<AggregateInfo>
@@ -0,0 +1,215 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <xsimd/xsimd.hpp>
+
+#include "common/BitUtil.h"
+#include "common/Types.h"
+#include "common/Utils.h"
+#include "common/Vector.h"
+
+// Column-at-a-time building blocks for the numeric aggregates. Rows are
+// walked 64 at a time along the validity bitmap of the input column, so that
+// runs without nulls are handed over as dense ranges of raw values and only
+// the words with nulls fall back to row-by-row updates.
+namespace milvus {
+namespace exec {
+
+constexpr vector_size_t kRowsPerValidWord = 64;
+
+/// Returns the validity bits of rows [begin, begin + 64) of a column with
+/// 'size' rows, bit i being row begin + i. Rows past the end read as nulls.
+/// 'begin' must be a multiple of 64.
+inline uint64_t
+loadValidWord(const uint8_t* validBytes,
+              vector_size_t begin,
+              vector_size_t size) {
+    const auto* bytes = validBytes + begin / 8;
+    if (begin + kRowsPerValidWord <= size) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+    // the bitmap may end with a partial word
+    uint64_t word = 0;
+    const auto numRows = size - begin;
+    for (auto i = 0; i < (numRows + 7) / 8; i++) {
+        word |= static_cast<uint64_t>(bytes[i]) << (i * 8);
+    }
+    return word & milvus::bits::lowMask(numRows);
+}
+
+/// Calls 'dense(begin, end)' for each maximal run of valid rows made of
+/// whole words of the validity bitmap of 'column', and 'sparse(row)' for
+/// each valid row of the words that have nulls.
+template <typename Dense, typename Sparse>
+inline void
+forEachValidRun(const ColumnVectorPtr& column, Dense dense, Sparse sparse) {
+    const vector_size_t size = column->size();
+    const auto* validBytes =
+        static_cast<const uint8_t*>(column->GetValidRawData());
+    vector_size_t runBegin = 0;
+    vector_size_t begin = 0;
+    for (; begin < size; begin += kRowsPerValidWord) {
+        const auto numRows = std::min(kRowsPerValidWord, size - begin);
+        auto word = loadValidWord(validBytes, begin, size);
+        if (word == milvus::bits::lowMask(numRows)) {
+            continue;
+        }
+        if (runBegin < begin) {
+            dense(runBegin, begin);
+        }
+        while (word) {
+            sparse(begin + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+        runBegin = begin + numRows;
+    }
+    if (runBegin < size) {
+        dense(runBegin, size);
+    }
+}
+
+/// Number of valid rows of 'column'.
+inline int64_t
+countValid(const ColumnVectorPtr& column) {
+    const vector_size_t size = column->size();
+    const auto* validBytes =
+        static_cast<const uint8_t*>(column->GetValidRawData());
+    int64_t count = 0;
+    for (vector_size_t begin = 0; begin < size; begin += kRowsPerValidWord) {
+        count += __builtin_popcountll(loadValidWord(validBytes, begin, size));
+    }
+    return count;
+}
+
+/// Sum of values[begin, end) as TData. Integer sums are overflow checked
+/// unless 'Overflow' is true, the same way as adding them one by one.
+template <typename TData, typename TValue, bool Overflow>
+inline TData
+sumRun(const TValue* values, vector_size_t begin, vector_size_t end) {
+    using Batch = xsimd::batch<TData>;
+    constexpr vector_size_t kLanes = Batch::size;
+    if constexpr (std::is_floating_point_v<TData> &&
+                  std::is_same_v<TData, TValue>) {
+        Batch lanes(TData(0));
+        auto row = begin;
+        for (; row + kLanes <= end; row += kLanes) {
+            lanes += Batch::load_unaligned(values + row);
+        }
+        auto sum = xsimd::reduce_add(lanes);
+        for (; row < end; row++) {
+            sum += values[row];
+        }
+        return sum;
+    } else if constexpr (std::is_same_v<TData, int64_t> &&
+                         std::is_same_v<TValue, int64_t>) {
+        Batch lanes(TData(0));
+        // sign bit set in a lane once an addition overflowed in it
+        Batch overflow(TData(0));
+        auto row = begin;
+        for (; row + kLanes <= end; row += kLanes) {
+            const auto batch = Batch::load_unaligned(values + row);
+            // lanes wrap around on overflow
+            const auto sum = lanes + batch;
+            if constexpr (!Overflow) {
+                overflow |= (lanes ^ sum) & (batch ^ sum);
+            }
+            lanes = sum;
+        }
+        if constexpr (!Overflow) {
+            if (xsimd::any(overflow < Batch(TData(0)))) {
+                // redo the run in row order to fail the same way as the
+                // scalar update does
+                TData sum = 0;
+                for (auto i = begin; i < end; i++) {
+                    sum = checkPlus(sum, values[i]);
+                }
+                return sum;
+            }
+        }
+        alignas(Batch::arch_type::alignment()) TData parts[kLanes];
+        lanes.store_aligned(parts);
+        TData sum = 0;
+        for (auto i = 0; i < kLanes; i++) {
+            sum = Overflow ? sum + parts[i] : checkPlus(sum, parts[i]);
+        }
+        for (; row < end; row++) {
+            sum = Overflow ? sum + values[row] : checkPlus(sum, values[row]);
+        }
+        return sum;
+    } else {
+        // widening sums, a run of narrow integers cannot overflow int64 and
+        // floats are summed as doubles
+        TData sum = 0;
+        for (auto row = begin; row < end; row++) {
+            sum += values[row];
+        }
+        return sum;
+    }
+}
+
+/// Minimum (or maximum if 'isMin' is false) of values[begin, end), or
+/// 'identity' if none of them compares below (above) it, e.g. all are NaN.
+template <typename T, bool isMin>
+inline T
+minMaxRun(const T* values, vector_size_t begin, vector_size_t end, T identity) {
+    auto better = [](auto candidate, auto current) {
+        if constexpr (isMin) {
+            return candidate < current;
+        } else {
+            return candidate > current;
+        }
+    };
+    auto result = identity;
+    auto row = begin;
+    if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+        using Batch = xsimd::batch<T>;
+        constexpr vector_size_t kLanes = Batch::size;
+        if (end - begin >= kLanes) {
+            Batch lanes(identity);
+            for (; row + kLanes <= end; row += kLanes) {
+                const auto batch = Batch::load_unaligned(values + row);
+                // select keeps the lane on NaN, like the scalar compare
+                lanes = xsimd::select(better(batch, lanes), batch, lanes);
+            }
+            alignas(Batch::arch_type::alignment()) T parts[kLanes];
+            lanes.store_aligned(parts);
+            for (auto i = 0; i < kLanes; i++) {
+                if (better(parts[i], result)) {
+                    result = parts[i];
+                }
+            }
+        }
+    }
+    for (; row < end; row++) {
+        if (better(values[row], result)) {
+            result = values[row];
+        }
+    }
+    return result;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,222 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "exec/operator/query-agg/AggregateKernels.h"
+#include "exec/operator/query-agg/CountAggregateBase.h"
+#include "exec/operator/query-agg/GroupingSet.h"
+#include "exec/operator/query-agg/MaxAggregateBase.h"
+#include "exec/operator/query-agg/MinAggregateBase.h"
+#include "exec/operator/query-agg/SumAggregateBase.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+namespace {
+
+// every 'null_every'-th row is null, 0 for no nulls
+ColumnVectorPtr
+MakeColumn(const std::vector<int64_t>& values, int null_every) {
+    auto column =
+        std::make_shared<ColumnVector>(DataType::INT64, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        column->SetValueAt<int64_t>(i, values[i]);
+        if (null_every > 0 && i % null_every == 0) {
+            column->nullAt(i);
+        }
+    }
+    return column;
+}
+
+std::vector<int64_t>
+RandomValues(size_t size) {
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int64_t> dist(-1'000'000, 1'000'000);
+    std::vector<int64_t> values(size);
+    for (auto& value : values) {
+        value = dist(gen);
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST(AggregateKernelsTest, ForEachValidRunVisitsValidRows) {
+    // sizes around word boundaries, with no, sparse and dense nulls
+    for (auto size : {0, 1, 63, 64, 65, 200, 1000}) {
+        for (auto null_every : {0, 1, 3, 150}) {
+            auto column = MakeColumn(std::vector<int64_t>(size), null_every);
+            std::vector<int> visits(size);
+            forEachValidRun(
+                column,
+                [&](vector_size_t begin, vector_size_t end) {
+                    EXPECT_LT(begin, end);
+                    for (auto i = begin; i < end; i++) {
+                        visits[i]++;
+                    }
+                },
+                [&](vector_size_t row) { visits[row]++; });
+            int64_t num_valid = 0;
+            for (auto i = 0; i < size; i++) {
+                const bool valid = column->ValidAt(i);
+                EXPECT_EQ(visits[i], valid ? 1 : 0) << size << " " << i;
+                num_valid += valid;
+            }
+            EXPECT_EQ(countValid(column), num_valid);
+        }
+    }
+}
+
+TEST(AggregateKernelsTest, SumRun) {
+    auto values = RandomValues(1001);
+    int64_t expected = 0;
+    for (auto i = 3; i < values.size(); i++) {
+        expected += values[i];
+    }
+    EXPECT_EQ((sumRun<int64_t, int64_t, false>(values.data(), 3, 1001)),
+              expected);
+
+    std::vector<int32_t> narrow(values.begin(), values.end());
+    EXPECT_EQ((sumRun<int64_t, int32_t, false>(narrow.data(), 3, 1001)),
+              expected);
+
+    std::vector<double> doubles(values.begin(), values.end());
+    EXPECT_DOUBLE_EQ((sumRun<double, double, false>(doubles.data(), 3, 1001)),
+                     static_cast<double>(expected));
+
+    // checked sums fail on overflow, unchecked ones wrap around
+    std::vector<int64_t> large(16, std::numeric_limits<int64_t>::max() / 4);
+    EXPECT_ANY_THROW((sumRun<int64_t, int64_t, false>(large.data(), 0, 16)));
+    EXPECT_NO_THROW((sumRun<int64_t, int64_t, true>(large.data(), 0, 16)));
+}
+
+TEST(AggregateKernelsTest, MinMaxRun) {
+    auto values = RandomValues(999);
+    const auto [min, max] = std::minmax_element(values.begin(), values.end());
+    EXPECT_EQ((minMaxRun<int64_t, true>(values.data(),
+                                        0,
+                                        values.size(),
+                                        std::numeric_limits<int64_t>::max())),
+              *min);
+    EXPECT_EQ(
+        (minMaxRun<int64_t, false>(values.data(),
+                                   0,
+                                   values.size(),
+                                   std::numeric_limits<int64_t>::lowest())),
+        *max);
+
+    // NaN never wins a compare, like in the row by row update
+    std::vector<double> doubles(40, std::nan(""));
+    doubles[17] = -2.5;
+    doubles[33] = 4.0;
+    EXPECT_EQ((minMaxRun<double, true>(doubles.data(),
+                                       0,
+                                       doubles.size(),
+                                       std::numeric_limits<double>::max())),
+              -2.5);
+    EXPECT_EQ((minMaxRun<double, false>(doubles.data(),
+                                        0,
+                                        doubles.size(),
+                                        std::numeric_limits<double>::lowest())),
+              4.0);
+}
+
+TEST(AggregateKernelsTest, GlobalAndGroupedAggregatesAgree) {
+    registerCountAggregate();
+    registerSumAggregate();
+    registerMinAggregate();
+    registerMaxAggregate();
+    auto values = RandomValues(5000);
+    // one key column with 10 groups followed by the values with some nulls
+    auto keys = std::make_shared<ColumnVector>(DataType::INT64, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+        keys->SetValueAt<int64_t>(i, i % 10);
+    }
+    auto input = std::make_shared<RowVector>(
+        std::vector<VectorPtr>{keys, MakeColumn(values, 7)});
+    auto input_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "value"},
+        std::vector<DataType>{DataType::INT64, DataType::INT64});
+
+    auto make_aggregates = [](column_index_t first_output) {
+        std::vector<AggregateInfo> aggregates;
+        for (const auto& name : {KCount, KSum, KMin, KMax}) {
+            AggregateInfo info;
+            info.function_ =
+                Aggregate::create(name, {DataType::INT64}, QueryConfig{});
+            info.input_column_idxes_ = {1};
+            info.output_ = first_output + aggregates.size();
+            aggregates.emplace_back(std::move(info));
+        }
+        return aggregates;
+    };
+    const std::vector<DataType> output_types(5, DataType::INT64);
+    const std::vector<std::string> output_names{"k", "c", "s", "mn", "mx"};
+
+    GroupingSet global(input_type, {}, make_aggregates(0));
+    global.addInput(input);
+    auto global_output = std::make_shared<RowVector>(
+        std::make_shared<RowType>(
+            std::vector<std::string>(output_names.begin() + 1,
+                                     output_names.end()),
+            std::vector<DataType>(4, DataType::INT64)),
+        1);
+    ASSERT_TRUE(global.getOutput(global_output));
+
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+    GroupingSet grouped(input_type, std::move(hashers), make_aggregates(1));
+    grouped.addInput(input);
+    auto grouped_output = std::make_shared<RowVector>(
+        std::make_shared<RowType>(output_names, output_types),
+        grouped.outputRowCount());
+    ASSERT_TRUE(grouped.getOutput(grouped_output));
+    ASSERT_EQ(grouped_output->size(), 10);
+
+    auto column = [](const RowVectorPtr& output, int i) {
+        return std::dynamic_pointer_cast<ColumnVector>(output->child(i));
+    };
+    int64_t count = 0;
+    int64_t sum = 0;
+    auto min = std::numeric_limits<int64_t>::max();
+    auto max = std::numeric_limits<int64_t>::lowest();
+    for (auto i = 0; i < grouped_output->size(); i++) {
+        count += column(grouped_output, 1)->ValueAt<int64_t>(i);
+        sum += column(grouped_output, 2)->ValueAt<int64_t>(i);
+        min = std::min(min, column(grouped_output, 3)->ValueAt<int64_t>(i));
+        max = std::max(max, column(grouped_output, 4)->ValueAt<int64_t>(i));
+    }
+    EXPECT_EQ(column(global_output, 0)->ValueAt<int64_t>(0), count);
+    EXPECT_EQ(column(global_output, 1)->ValueAt<int64_t>(0), sum);
+    EXPECT_EQ(column(global_output, 2)->ValueAt<int64_t>(0), min);
+    EXPECT_EQ(column(global_output, 3)->ValueAt<int64_t>(0), max);
+
+    int64_t expected_count = 0;
+    int64_t expected_sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i % 7 != 0) {
+            expected_count++;
+            expected_sum += values[i];
+        }
+    }
+    EXPECT_EQ(count, expected_count);
+    EXPECT_EQ(sum, expected_sum);
+}
@@ -0,0 +1,275 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "common/Utils.h"
+#include "exec/operator/query-agg/ApproxCountDistinctAggregate.h"
+#include "exec/operator/query-agg/ApproxPercentileAggregate.h"
+#include "exec/operator/query-agg/AvgAggregate.h"
+#include "exec/operator/query-agg/GroupingSet.h"
+#include "exec/operator/query-agg/HyperLogLog.h"
+#include "exec/operator/query-agg/KllSketch.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+namespace {
+
+uint64_t
+Hash(int64_t value) {
+    return milvus::bits::hashMix(0x5bd1e9955bd1e995ULL,
+                                 folly::hasher<int64_t>{}(value));
+}
+
+// rank of 'value' among sorted 'values' as a fraction
+double
+Rank(const std::vector<double>& sorted, double value) {
+    return static_cast<double>(
+               std::lower_bound(sorted.begin(), sorted.end(), value) -
+               sorted.begin()) /
+           sorted.size();
+}
+
+ColumnVectorPtr
+Column(const RowVectorPtr& output, int i) {
+    return std::dynamic_pointer_cast<ColumnVector>(output->child(i));
+}
+
+AggregateInfo
+MakeAggregate(const std::string& name,
+              column_index_t input,
+              column_index_t output,
+              bool intermediate_input,
+              bool intermediate_output) {
+    AggregateInfo info;
+    info.function_ = Aggregate::create(name, {DataType::INT64}, QueryConfig{});
+    info.input_column_idxes_ = {input};
+    info.output_ = output;
+    info.intermediate_input_ = intermediate_input;
+    info.intermediate_output_ = intermediate_output;
+    return info;
+}
+
+}  // namespace
+
+TEST(ApproxAggregatesTest, HyperLogLogEstimate) {
+    for (int64_t num_distinct : {0, 10, 1000, 100'000}) {
+        HyperLogLog sketch;
+        for (int repeat = 0; repeat < 3; repeat++) {
+            for (int64_t i = 0; i < num_distinct; i++) {
+                sketch.insertHash(Hash(i));
+            }
+        }
+        EXPECT_NEAR(sketch.cardinality(),
+                    num_distinct,
+                    std::max(1.0, num_distinct * 0.05))
+            << num_distinct;
+    }
+}
+
+TEST(ApproxAggregatesTest, HyperLogLogMergeAndSerialize) {
+    HyperLogLog all;
+    HyperLogLog left;
+    HyperLogLog right;
+    for (int64_t i = 0; i < 50'000; i++) {
+        all.insertHash(Hash(i));
+        // the halves overlap in 10000 values
+        (i < 30'000 ? left : right).insertHash(Hash(i));
+        if (i >= 20'000 && i < 30'000) {
+            right.insertHash(Hash(i));
+        }
+    }
+    left.merge(right);
+    EXPECT_EQ(left.cardinality(), all.cardinality());
+
+    std::string serialized;
+    left.serialize(serialized);
+    EXPECT_EQ(HyperLogLog::deserialize(serialized).cardinality(),
+              all.cardinality());
+    EXPECT_ANY_THROW(HyperLogLog::deserialize(serialized.substr(1)));
+    EXPECT_ANY_THROW(left.merge(HyperLogLog(8)));
+}
+
+TEST(ApproxAggregatesTest, KllSketchQuantiles) {
+    std::mt19937 gen(11);
+    std::normal_distribution<double> dist(0, 100);
+    std::vector<double> values(200'000);
+    KllSketch all;
+    KllSketch parts[4];
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = dist(gen);
+        all.insert(values[i]);
+        parts[i % 4].insert(values[i]);
+    }
+    for (int i = 1; i < 4; i++) {
+        parts[0].merge(parts[i]);
+    }
+    std::string serialized;
+    parts[0].serialize(serialized);
+    auto merged = KllSketch::deserialize(serialized);
+    EXPECT_EQ(merged.count(), values.size());
+    EXPECT_EQ(all.count(), values.size());
+
+    std::sort(values.begin(), values.end());
+    for (double fraction : {0.01, 0.25, 0.5, 0.9, 0.99}) {
+        EXPECT_NEAR(Rank(values, all.quantile(fraction)), fraction, 0.02);
+        EXPECT_NEAR(Rank(values, merged.quantile(fraction)), fraction, 0.02);
+    }
+    EXPECT_LE(all.quantile(0), all.quantile(1));
+    // far fewer items than inputs are kept
+    EXPECT_LT(all.heapBytes(), values.size() * sizeof(double) / 50);
+    EXPECT_ANY_THROW(KllSketch::deserialize(serialized.substr(0, 30)));
+}
+
+TEST(ApproxAggregatesTest, PartialAndFinalAggregation) {
+    registerAvgAggregate();
+    registerApproxCountDistinctAggregate();
+    registerApproxPercentileAggregate();
+    const std::vector<std::string> names{
+        KAvg, KApproxCountDistinct, KApproxPercentile};
+    constexpr int64_t kNumKeys = 10;
+    constexpr int64_t kRowsPerBatch = 4000;
+
+    // two partial aggregations over key, value with every 5th value null
+    std::vector<RowVectorPtr> partials;
+    for (int batch = 0; batch < 2; batch++) {
+        auto keys =
+            std::make_shared<ColumnVector>(DataType::INT64, kRowsPerBatch);
+        auto values =
+            std::make_shared<ColumnVector>(DataType::INT64, kRowsPerBatch);
+        for (int64_t i = 0; i < kRowsPerBatch; i++) {
+            const auto row = batch * kRowsPerBatch + i;
+            keys->SetValueAt<int64_t>(i, row % kNumKeys);
+            values->SetValueAt<int64_t>(i, row);
+            if (row % 5 == 0) {
+                values->nullAt(i);
+            }
+        }
+        auto input_type = std::make_shared<RowType>(
+            std::vector<std::string>{"key", "value"},
+            std::vector<DataType>{DataType::INT64, DataType::INT64});
+        std::vector<AggregateInfo> aggregates;
+        std::vector<DataType> output_types{DataType::INT64};
+        for (const auto& name : names) {
+            aggregates.emplace_back(MakeAggregate(
+                name, 1, 1 + aggregates.size(), false, true));
+            output_types.push_back(
+                aggregates.back().function_->intermediateType());
+        }
+        std::vector<std::unique_ptr<VectorHasher>> hashers;
+        hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+        GroupingSet partial(
+            input_type, std::move(hashers), std::move(aggregates));
+        partial.addInput(std::make_shared<RowVector>(
+            std::vector<VectorPtr>{keys, values}));
+        auto output = std::make_shared<RowVector>(
+            std::make_shared<RowType>(
+                std::vector<std::string>{"key", "avg", "acd", "ap"},
+                output_types),
+            partial.outputRowCount());
+        ASSERT_TRUE(partial.getOutput(output));
+        ASSERT_EQ(output->size(), kNumKeys);
+        EXPECT_EQ(Column(output, 1)->type(), DataType::VARCHAR);
+        partials.push_back(output);
+    }
+
+    // merge both partials per key and into a single global group
+    auto intermediate_type = std::make_shared<RowType>(
+        std::vector<std::string>{"key", "avg", "acd", "ap"},
+        std::vector<DataType>{DataType::INT64,
+                              DataType::VARCHAR,
+                              DataType::VARCHAR,
+                              DataType::VARCHAR});
+    auto make_final = [&](column_index_t first_output) {
+        std::vector<AggregateInfo> aggregates;
+        for (const auto& name : names) {
+            aggregates.emplace_back(MakeAggregate(name,
+                                                  1 + aggregates.size(),
+                                                  first_output +
+                                                      aggregates.size(),
+                                                  true,
+                                                  false));
+        }
+        return aggregates;
+    };
+    const std::vector<DataType> final_types{
+        DataType::DOUBLE, DataType::INT64, DataType::DOUBLE};
+
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+    GroupingSet grouped(intermediate_type, std::move(hashers), make_final(1));
+    GroupingSet global(intermediate_type, {}, make_final(0));
+    for (const auto& partial : partials) {
+        grouped.addInput(partial);
+        global.addInput(partial);
+    }
+    auto grouped_output = std::make_shared<RowVector>(
+        std::make_shared<RowType>(
+            std::vector<std::string>{"key", "avg", "acd", "ap"},
+            std::vector<DataType>{DataType::INT64,
+                                  DataType::DOUBLE,
+                                  DataType::INT64,
+                                  DataType::DOUBLE}),
+        grouped.outputRowCount());
+    ASSERT_TRUE(grouped.getOutput(grouped_output));
+    ASSERT_EQ(grouped_output->size(), kNumKeys);
+    auto global_output = std::make_shared<RowVector>(
+        std::make_shared<RowType>(
+            std::vector<std::string>{"avg", "acd", "ap"}, final_types),
+        1);
+    ASSERT_TRUE(global.getOutput(global_output));
+
+    // key k holds the rows k, k + 10, ... below 8000 except multiples of 5
+    constexpr int64_t kNumRows = 2 * kRowsPerBatch;
+    for (int64_t i = 0; i < kNumKeys; i++) {
+        const auto key = Column(grouped_output, 0)->ValueAt<int64_t>(i);
+        if (key % 5 == 0) {
+            EXPECT_FALSE(Column(grouped_output, 1)->ValidAt(i));
+            EXPECT_EQ(Column(grouped_output, 2)->ValueAt<int64_t>(i), 0);
+            EXPECT_FALSE(Column(grouped_output, 3)->ValidAt(i));
+            continue;
+        }
+        const int64_t count = kNumRows / kNumKeys;
+        const double avg = key + (count - 1) * kNumKeys / 2.0;
+        EXPECT_DOUBLE_EQ(Column(grouped_output, 1)->ValueAt<double>(i), avg);
+        EXPECT_NEAR(
+            Column(grouped_output, 2)->ValueAt<int64_t>(i), count, count / 20);
+        EXPECT_NEAR(Column(grouped_output, 3)->ValueAt<double>(i),
+                    avg,
+                    kNumRows * 0.02);
+    }
+
+    double sum = 0;
+    int64_t count = 0;
+    for (int64_t row = 0; row < kNumRows; row++) {
+        if (row % 5 != 0) {
+            sum += row;
+            count++;
+        }
+    }
+    EXPECT_DOUBLE_EQ(Column(global_output, 0)->ValueAt<double>(0),
+                     sum / count);
+    EXPECT_NEAR(
+        Column(global_output, 1)->ValueAt<int64_t>(0), count, count / 20);
+    EXPECT_NEAR(Column(global_output, 2)->ValueAt<double>(0),
+                kNumRows / 2.0,
+                kNumRows * 0.02);
+}
@@ -0,0 +1,74 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ApproxCountDistinctAggregate.h"
+#include "common/Utils.h"
+#include "log/Log.h"
+
+namespace milvus {
+namespace exec {
+
+void
+registerApproxCountDistinctAggregate() {
+    const std::string name = milvus::KApproxCountDistinct;
+    exec::registerAggregateFunction(
+        name,
+        [name](const std::vector<DataType>& argumentTypes,
+               const QueryConfig& /*config*/) -> std::unique_ptr<Aggregate> {
+            AssertInfo(argumentTypes.size() == 1,
+                       "function:{} only accept one argument",
+                       name);
+            auto inputType = argumentTypes[0];
+            switch (inputType) {
+                case DataType::BOOL:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<bool>>();
+                case DataType::INT8:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int8_t>>();
+                case DataType::INT16:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int16_t>>();
+                case DataType::INT32:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int32_t>>();
+                case DataType::INT64:
+                case DataType::TIMESTAMPTZ:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<int64_t>>();
+                case DataType::FLOAT:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<float>>();
+                case DataType::DOUBLE:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<double>>();
+                case DataType::VARCHAR:
+                case DataType::STRING:
+                case DataType::TEXT:
+                    return std::make_unique<
+                        ApproxCountDistinctAggregate<std::string>>();
+                default:
+                    ThrowInfo(DataTypeInvalid,
+                              "Unknown input type for {} aggregation {}",
+                              name,
+                              GetDataTypeName(inputType));
+            }
+        });
+    LOG_INFO("Registered Approx Count Distinct Aggregate Function");
+}
+
+}  // namespace exec
+}  // namespace milvus
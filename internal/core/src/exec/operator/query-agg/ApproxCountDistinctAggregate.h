@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#pragma once
+
+#include <folly/Hash.h>
+
+#include "AggregateKernels.h"
+#include "HyperLogLog.h"
+#include "SketchAggregate.h"
+#include "common/BitUtil.h"
+#include "common/float_util_c.h"
+
+namespace milvus {
+namespace exec {
+
+/// approx_count_distinct over a column of TInput, estimated with a
+/// HyperLogLog sketch per group. Nulls are not counted and a group without
+/// any non-null input counts 0, like count.
+template <typename TInput>
+class ApproxCountDistinctAggregate final
+    : public SketchAggregate<HyperLogLog> {
+    static constexpr uint64_t kHashSeed = 0x5bd1e9955bd1e995ULL;
+
+ public:
+    ApproxCountDistinctAggregate() : SketchAggregate(DataType::INT64) {
+    }
+
+    void
+    extractValues(char** groups,
+                  int32_t numGroups,
+                  VectorPtr* result) override {
+        auto result_column = resizeResult(result, numGroups);
+        auto* raw = result_column->RawAsValues<int64_t>();
+        for (auto i = 0; i < numGroups; i++) {
+            auto* state = sketch(groups[i]);
+            result_column->clearNullAt(i);
+            raw[i] = state == nullptr ? 0 : state->cardinality();
+        }
+    }
+
+    void
+    addRawInput(char** groups,
+                int numGroups,
+                const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* values = column->RawAsValues<TInput>();
+        auto insert = [&](vector_size_t row) {
+            ensureSketch(groups[row]).insertHash(hashValue(values[row]));
+        };
+        forEachValidRun(
+            column,
+            [&](vector_size_t begin, vector_size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    insert(i);
+                }
+            },
+            insert);
+    }
+
+    void
+    addSingleGroupRawInput(char* group,
+                           const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* values = column->RawAsValues<TInput>();
+        HyperLogLog* state = nullptr;
+        auto insert = [&](vector_size_t row) {
+            if (state == nullptr) {
+                state = &ensureSketch(group);
+            }
+            state->insertHash(hashValue(values[row]));
+        };
+        forEachValidRun(
+            column,
+            [&](vector_size_t begin, vector_size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    insert(i);
+                }
+            },
+            insert);
+    }
+
+ private:
+    // HyperLogLog takes the register index from the high bits, so the value
+    // hash is mixed once more to spread weak hashes of small integers.
+    static uint64_t
+    hashValue(const TInput& value) {
+        uint64_t hash;
+        if constexpr (std::is_floating_point_v<TInput>) {
+            hash = NaNAwareHash<TInput>{}(value);
+        } else {
+            hash = folly::hasher<TInput>{}(value);
+        }
+        return milvus::bits::hashMix(kHashSeed, hash);
+    }
+};
+
+void
+registerApproxCountDistinctAggregate();
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,68 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ApproxPercentileAggregate.h"
+#include "common/Utils.h"
+#include "log/Log.h"
+
+namespace milvus {
+namespace exec {
+
+void
+registerApproxPercentileAggregate() {
+    const std::string name = milvus::KApproxPercentile;
+    exec::registerAggregateFunction(
+        name,
+        [name](const std::vector<DataType>& argumentTypes,
+               const QueryConfig& config) -> std::unique_ptr<Aggregate> {
+            AssertInfo(argumentTypes.size() == 1,
+                       "function:{} only accept one argument",
+                       name);
+            // aggregate inputs are columns only, the percentile comes with
+            // the query config
+            const auto percentile = config.get_agg_approx_percentile();
+            auto inputType = argumentTypes[0];
+            switch (inputType) {
+                case DataType::INT8:
+                    return std::make_unique<ApproxPercentileAggregate<int8_t>>(
+                        percentile);
+                case DataType::INT16:
+                    return std::make_unique<
+                        ApproxPercentileAggregate<int16_t>>(percentile);
+                case DataType::INT32:
+                    return std::make_unique<
+                        ApproxPercentileAggregate<int32_t>>(percentile);
+                case DataType::INT64:
+                    return std::make_unique<
+                        ApproxPercentileAggregate<int64_t>>(percentile);
+                case DataType::FLOAT:
+                    return std::make_unique<ApproxPercentileAggregate<float>>(
+                        percentile);
+                case DataType::DOUBLE:
+                    return std::make_unique<ApproxPercentileAggregate<double>>(
+                        percentile);
+                default:
+                    ThrowInfo(DataTypeInvalid,
+                              "Unknown input type for {} aggregation {}",
+                              name,
+                              GetDataTypeName(inputType));
+            }
+        });
+    LOG_INFO("Registered Approx Percentile Aggregate Function");
+}
+
+}  // namespace exec
+}  // namespace milvus
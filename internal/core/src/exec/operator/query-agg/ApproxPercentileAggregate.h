@@ -0,0 +1,115 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#pragma once
+
+#include <cmath>
+
+#include "AggregateKernels.h"
+#include "KllSketch.h"
+#include "SketchAggregate.h"
+
+namespace milvus {
+namespace exec {
+
+/// approx_percentile over a numeric column, estimated with a KLL sketch per
+/// group. The percentile in [0, 1] is fixed per aggregate, NaN inputs are
+/// skipped like nulls and a group without any input is null.
+template <typename TInput>
+class ApproxPercentileAggregate final : public SketchAggregate<KllSketch> {
+ public:
+    explicit ApproxPercentileAggregate(double percentile)
+        : SketchAggregate(DataType::DOUBLE), percentile_(percentile) {
+        AssertInfo(percentile >= 0 && percentile <= 1,
+                   "approx_percentile percentile must be in [0, 1], got {}",
+                   percentile);
+    }
+
+    void
+    extractValues(char** groups,
+                  int32_t numGroups,
+                  VectorPtr* result) override {
+        auto result_column = resizeResult(result, numGroups);
+        auto* raw = result_column->RawAsValues<double>();
+        for (auto i = 0; i < numGroups; i++) {
+            auto* state = sketch(groups[i]);
+            if (state == nullptr || state->count() == 0) {
+                result_column->nullAt(i);
+            } else {
+                result_column->clearNullAt(i);
+                raw[i] = state->quantile(percentile_);
+            }
+        }
+    }
+
+    void
+    addRawInput(char** groups,
+                int numGroups,
+                const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* values = column->RawAsValues<TInput>();
+        auto insert = [&](vector_size_t row) {
+            if (!isNaN(values[row])) {
+                ensureSketch(groups[row]).insert(values[row]);
+            }
+        };
+        forEachValidRun(
+            column,
+            [&](vector_size_t begin, vector_size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    insert(i);
+                }
+            },
+            insert);
+    }
+
+    void
+    addSingleGroupRawInput(char* group,
+                           const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* values = column->RawAsValues<TInput>();
+        KllSketch* state = nullptr;
+        auto insert = [&](vector_size_t row) {
+            if (isNaN(values[row])) {
+                return;
+            }
+            if (state == nullptr) {
+                state = &ensureSketch(group);
+            }
+            state->insert(values[row]);
+        };
+        forEachValidRun(
+            column,
+            [&](vector_size_t begin, vector_size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    insert(i);
+                }
+            },
+            insert);
+    }
+
+ private:
+    static bool
+    isNaN(TInput value) {
+        if constexpr (std::is_floating_point_v<TInput>) {
+            return std::isnan(value);
+        } else {
+            return false;
+        }
+    }
+
+    const double percentile_;
+};
+
+void
+registerApproxPercentileAggregate();
+
+}  // namespace exec
+}  // namespace milvus
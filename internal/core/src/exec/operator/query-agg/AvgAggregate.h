@@ -0,0 +1,205 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#pragma once
+
+#include <cstring>
+
+#include "Aggregate.h"
+#include "AggregateKernels.h"
+
+namespace milvus {
+namespace exec {
+
+/// avg over a numeric column. The accumulator keeps the sum and the count of
+/// the non-null inputs, the intermediate result is both packed in a VARCHAR so
+/// that partial averages can be merged exactly.
+template <typename TInput>
+class AvgAggregate final : public Aggregate {
+    struct SumCount {
+        double sum;
+        int64_t count;
+    };
+
+ public:
+    AvgAggregate() : Aggregate(DataType::DOUBLE) {
+    }
+
+    int32_t
+    accumulatorFixedWidthSize() const override {
+        return sizeof(SumCount);
+    }
+
+    int32_t
+    accumulatorAlignmentSize() const override {
+        return static_cast<int32_t>(alignof(SumCount));
+    }
+
+    DataType
+    intermediateType() const override {
+        return DataType::VARCHAR;
+    }
+
+    void
+    extractValues(char** groups,
+                  int32_t numGroups,
+                  VectorPtr* result) override {
+        auto result_column = resizeResult(result, numGroups);
+        auto* raw = result_column->RawAsValues<double>();
+        for (auto i = 0; i < numGroups; i++) {
+            char* group = groups[i];
+            const auto& state = *value<SumCount>(group);
+            if (isNull(group) || state.count == 0) {
+                result_column->nullAt(i);
+            } else {
+                result_column->clearNullAt(i);
+                raw[i] = state.sum / state.count;
+            }
+        }
+    }
+
+    void
+    extractAccumulators(char** groups,
+                        int32_t numGroups,
+                        VectorPtr* result) override {
+        auto result_column = resizeResult(result, numGroups);
+        auto* raw = result_column->RawAsValues<std::string>();
+        for (auto i = 0; i < numGroups; i++) {
+            char* group = groups[i];
+            if (isNull(group)) {
+                result_column->nullAt(i);
+            } else {
+                result_column->clearNullAt(i);
+                raw[i].assign(reinterpret_cast<const char*>(
+                                  value<SumCount>(group)),
+                              sizeof(SumCount));
+            }
+        }
+    }
+
+    void
+    addRawInput(char** groups,
+                int numGroups,
+                const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* values = column->RawAsValues<TInput>();
+        auto update = [&](vector_size_t row) {
+            clearNull(groups[row]);
+            auto& state = *value<SumCount>(groups[row]);
+            state.sum += values[row];
+            state.count++;
+        };
+        forEachValidRun(
+            column,
+            [&](vector_size_t begin, vector_size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    update(i);
+                }
+            },
+            update);
+    }
+
+    void
+    addSingleGroupRawInput(char* group,
+                           const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* values = column->RawAsValues<TInput>();
+        auto& state = *value<SumCount>(group);
+        const auto count = state.count;
+        forEachValidRun(
+            column,
+            [&](vector_size_t begin, vector_size_t end) {
+                state.sum += sumRun<double, TInput, true>(values, begin, end);
+                state.count += end - begin;
+            },
+            [&](vector_size_t row) {
+                state.sum += values[row];
+                state.count++;
+            });
+        if (state.count != count) {
+            clearNull(group);
+        }
+    }
+
+    void
+    addIntermediateResults(char** groups,
+                           int numGroups,
+                           const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* states = column->RawAsValues<std::string>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (column->ValidAt(i)) {
+                mergeState(groups[i], states[i]);
+            }
+        }
+    }
+
+    void
+    addSingleGroupIntermediateResults(
+        char* group, const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* states = column->RawAsValues<std::string>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (column->ValidAt(i)) {
+                mergeState(group, states[i]);
+            }
+        }
+    }
+
+    void
+    initializeNewGroupsInternal(
+        char** groups, folly::Range<const vector_size_t*> indices) override {
+        setAllNulls(groups, indices);
+        for (auto i : indices) {
+            *value<SumCount>(groups[i]) = SumCount{0, 0};
+        }
+    }
+
+ private:
+    static ColumnVectorPtr
+    inputColumn(const std::vector<VectorPtr>& input) {
+        AssertInfo(input.size() == 1,
+                   "avg aggregate expects exactly one input column");
+        auto column = std::dynamic_pointer_cast<ColumnVector>(input[0]);
+        AssertInfo(column != nullptr,
+                   "avg aggregate input must be of type ColumnVector");
+        return column;
+    }
+
+    static ColumnVectorPtr
+    resizeResult(VectorPtr* result, int32_t numGroups) {
+        auto result_column = std::dynamic_pointer_cast<ColumnVector>(*result);
+        AssertInfo(result_column != nullptr,
+                   "input vector for extracting aggregation must be of Type "
+                   "ColumnVector");
+        result_column->resize(numGroups);
+        return result_column;
+    }
+
+    void
+    mergeState(char* group, const std::string& serialized) {
+        AssertInfo(serialized.size() == sizeof(SumCount),
+                   "avg intermediate result must be {} bytes, got {}",
+                   sizeof(SumCount),
+                   serialized.size());
+        SumCount other;
+        std::memcpy(&other, serialized.data(), sizeof(SumCount));
+        clearNull(group);
+        auto& state = *value<SumCount>(group);
+        state.sum += other.sum;
+        state.count += other.count;
+    }
+};
+
+void
+registerAvgAggregate();
+
+}  // namespace exec
+}  // namespace milvus
@@ -49,11 +49,14 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
             input_column = std::dynamic_pointer_cast<ColumnVector>(input[0]);
             AssertInfo(input_column != nullptr,
                        "input[0] must be ColumnVector for count aggregation");
-            for (auto i = 0; i < input_column->size(); i++) {
-                if (input_column->ValidAt(i)) {
-                    addToGroup(groups[i], 1);
-                }
-            }
+            forEachValidRun(
+                input_column,
+                [&](vector_size_t begin, vector_size_t end) {
+                    for (auto i = begin; i < end; i++) {
+                        addToGroup(groups[i], 1);
+                    }
+                },
+                [&](vector_size_t row) { addToGroup(groups[row], 1); });
             return;
         }
         for (auto i = 0; i < numGroups; i++) {
@@ -76,11 +79,7 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
             BitsetTypeView view(column->GetRawData(), column->size());
             addToGroup(group, view.size() - view.count());
         } else {
-            for (auto i = 0; i < column->size(); i++) {
-                if (column->ValidAt(i)) {
-                    addToGroup(group, 1);
-                }
-            }
+            addToGroup(group, countValid(column));
         }
     }
 
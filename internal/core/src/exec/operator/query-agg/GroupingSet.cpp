@@ -16,6 +16,7 @@
 
 #include "GroupingSet.h"
 #include "common/Utils.h"
+#include "log/Log.h"
 #include "SumAggregateBase.h"
 
 namespace milvus {
@@ -24,10 +25,17 @@ GroupingSet::~GroupingSet() {
     if (isGlobal_ && lookup_) {
         AssertInfo(lookup_->hits_.size() == 1,
                    "GlobalAggregation should have exactly one output line");
+        for (auto& aggregate : aggregates_) {
+            if (!aggregate.function_->isFixedSize()) {
+                aggregate.function_->destroy(folly::Range<char**>(
+                    lookup_->hits_.data(), lookup_->hits_.size()));
+            }
+        }
         // globalAggregationBuffer_ is automatically cleaned up by unique_ptr
         // No need to manually delete[] or set to nullptr
         lookup_->hits_[0] = nullptr;
     }
+    RemoveSpillFiles(pendingPartitions_);
 }
 
 void
@@ -102,7 +110,11 @@ GroupingSet::addGlobalAggregationInput(const milvus::RowVectorPtr& input) {
     for (auto i = 0; i < aggregates_.size(); i++) {
         auto& function = aggregates_[i].function_;
         populateTempVectors(i, input);
-        function->addSingleGroupRawInput(group, tempVectors_);
+        if (aggregates_[i].intermediate_input_) {
+            function->addSingleGroupIntermediateResults(group, tempVectors_);
+        } else {
+            function->addSingleGroupRawInput(group, tempVectors_);
+        }
     }
     tempVectors_.clear();
 }
@@ -116,7 +128,11 @@ GroupingSet::getGlobalAggregationOutput(milvus::RowVectorPtr& result) {
     for (auto i = 0; i < aggregates_.size(); i++) {
         auto& function = aggregates_[i].function_;
         auto resultVector = result->child(aggregates_[i].output_);
-        function->extractValues(groups, 1, &resultVector);
+        if (aggregates_[i].intermediate_output_) {
+            function->extractAccumulators(groups, 1, &resultVector);
+        } else {
+            function->extractValues(groups, 1, &resultVector);
+        }
     }
     return true;
 }
@@ -131,12 +147,68 @@ GroupingSet::getOutput(milvus::RowVectorPtr& result) {
     if (!hash_table_) {
         return false;
     }
-    const auto& all_rows = hash_table_->rows()->allRows();
-    if (!all_rows.empty()) {
-        extractGroups(result);
-        return true;
+    for (;;) {
+        if (!tableOutputDone_) {
+            tableOutputDone_ = true;
+            finishSpill();
+            if (!hash_table_->rows()->allRows().empty()) {
+                extractGroups(result);
+                return true;
+            }
+        }
+        if (pendingPartitions_.empty()) {
+            return false;
+        }
+        auto partition = std::move(pendingPartitions_.back());
+        pendingPartitions_.pop_back();
+        aggregateSpilledPartition(std::move(partition));
+    }
+}
+
+bool
+GroupingSet::hasRemainingOutput() const {
+    if (isGlobal_ || !hash_table_) {
+        return false;
+    }
+    return !tableOutputDone_ || spiller_ != nullptr ||
+           !pendingPartitions_.empty();
+}
+
+void
+GroupingSet::finishSpill() {
+    if (spiller_ == nullptr) {
+        return;
+    }
+    auto partitions = spiller_->finish();
+    numSpilledRows_ += spiller_->spilledRows();
+    spiller_.reset();
+    pendingPartitions_.insert(pendingPartitions_.end(),
+                              std::make_move_iterator(partitions.begin()),
+                              std::make_move_iterator(partitions.end()));
+}
+
+void
+GroupingSet::aggregateSpilledPartition(SpillPartition partition) {
+    AssertInfo(spiller_ == nullptr,
+               "the previous table must finish spilling before the next "
+               "partition is aggregated");
+    // the hashers were moved into the old table, build a fresh set for the
+    // new one
+    for (const auto& hasher : hash_table_->hashers()) {
+        hashers_.emplace_back(VectorHasher::create(hasher->ChannelDataType(),
+                                                   hasher->ChannelIndex()));
+    }
+    lookup_.reset();
+    hash_table_.reset();
+    createHashTable();
+    tableOutputDone_ = false;
+    spillStartBit_ = Spiller::nextStartBit(partition.start_bit,
+                                           spillConfig_.num_partition_bits);
+
+    SpillPartitionReader reader(std::move(partition), inputTypes_);
+    while (auto batch = reader.next()) {
+        addInputForActiveRows(batch);
     }
-    return false;
 }
 
 std::vector<Accumulator>
@@ -151,7 +223,32 @@ GroupingSet::accumulators() {
 
 void
 GroupingSet::ensureInputFits(const RowVectorPtr& input) {
-    //TODO memory check
+    // an empty table always takes the groups of one batch, so that every
+    // spill level makes progress even if the limit is tiny
+    if (spiller_ != nullptr || spillConfig_.memory_limit <= 0 ||
+        spillStartBit_ < 0 || hash_table_->rows()->allRows().empty()) {
+        return;
+    }
+    const auto usedBytes = hash_table_->usedBytes();
+    const auto growthBytes = hash_table_->estimateGrowthBytes(input->size());
+    if (usedBytes + growthBytes <= spillConfig_.memory_limit &&
+        memory_.TryResize(usedBytes + growthBytes)) {
+        return;
+    }
+    LOG_INFO(
+        "group-by aggregation holds {} bytes in {} groups, may grow {} bytes "
+        "over the limit {} or the query memory budget, start spilling new "
+        "groups at hash bit {}",
+        usedBytes,
+        hash_table_->rows()->allRows().size(),
+        growthBytes,
+        spillConfig_.memory_limit,
+        spillStartBit_);
+    // spill partitions are picked by hash bits, value ids do not spread over
+    // them
+    hash_table_->forceGenericHashMode();
+    spiller_ =
+        std::make_unique<Spiller>(spillConfig_, inputTypes_, spillStartBit_);
 }
 
 void
@@ -170,8 +267,13 @@ GroupingSet::extractGroups(const milvus::RowVectorPtr& result) {
     for (auto i = 0; i < aggregates_.size(); i++) {
         auto& function = aggregates_[i].function_;
         auto aggregateVector = result->child(totalKeys + i);
-        function->extractValues(
-            groups_range.data(), groups_range.size(), &aggregateVector);
+        if (aggregates_[i].intermediate_output_) {
+            function->extractAccumulators(
+                groups_range.data(), groups_range.size(), &aggregateVector);
+        } else {
+            function->extractValues(
+                groups_range.data(), groups_range.size(), &aggregateVector);
+        }
     }
 }
 
@@ -185,7 +287,45 @@ GroupingSet::addInputForActiveRows(const RowVectorPtr& input) {
     }
     ensureInputFits(input);
     hash_table_->prepareForGroupProbe(*lookup_, input);
-    hash_table_->groupProbe(*lookup_);
+    if (spiller_ != nullptr) {
+        spillNewGroups(input);
+    } else {
+        hash_table_->groupProbe(*lookup_);
+        updateAggregates(input);
+    }
+    memory_.Resize(hash_table_->usedBytes());
+}
+
+void
+GroupingSet::spillNewGroups(const RowVectorPtr& input) {
+    hash_table_->groupProbe(*lookup_, false);
+    auto& hits = lookup_->hits_;
+    std::vector<vector_size_t> newGroupRows;
+    std::vector<vector_size_t> existingRows;
+    for (auto i = 0; i < hits.size(); i++) {
+        if (hits[i] == nullptr) {
+            newGroupRows.push_back(i);
+        } else {
+            existingRows.push_back(i);
+        }
+    }
+    if (newGroupRows.empty()) {
+        updateAggregates(input);
+        return;
+    }
+    spiller_->spill(input, lookup_->hashes_, newGroupRows);
+    if (existingRows.empty()) {
+        return;
+    }
+    for (auto i = 0; i < existingRows.size(); i++) {
+        hits[i] = hits[existingRows[i]];
+    }
+    hits.resize(existingRows.size());
+    updateAggregates(GatherRows(input, existingRows));
+}
+
+void
+GroupingSet::updateAggregates(const RowVectorPtr& input) {
     auto& hits = lookup_->hits_;
     auto* groups = hits.data();
     auto numGroups = hits.size();
@@ -196,7 +336,11 @@ GroupingSet::addInputForActiveRows(const RowVectorPtr& input) {
             function->initializeNewGroups(groups, newGroups);
         }
         populateTempVectors(i, input);
-        function->addRawInput(groups, numGroups, tempVectors_);
+        if (aggregates_[i].intermediate_input_) {
+            function->addIntermediateResults(groups, numGroups, tempVectors_);
+        } else {
+            function->addRawInput(groups, numGroups, tempVectors_);
+        }
     }
     tempVectors_.clear();
 }
@@ -218,7 +362,7 @@ GroupingSet::populateTempVectors(int32_t aggregateIndex,
 
 int32_t
 GroupingSet::outputRowCount() const {
-    return lookup_->newGroups_.size();
+    return hash_table_ ? hash_table_->rows()->allRows().size() : 0;
 }
 
 void
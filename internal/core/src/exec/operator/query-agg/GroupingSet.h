@@ -19,8 +19,10 @@
 #include "exec/VectorHasher.h"
 #include "AggregateInfo.h"
 #include "exec/HashTable.h"
+#include "exec/MemoryTracker.h"
 #include "plan/PlanNode.h"
 #include "RowContainer.h"
+#include "Spiller.h"
 
 namespace milvus {
 namespace exec {
@@ -29,9 +31,19 @@ class GroupingSet {
  public:
     GroupingSet(const RowTypePtr& input_type,
                 std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-                std::vector<AggregateInfo>&& aggregates)
-        : hashers_(std::move(hashers)), aggregates_(std::move(aggregates)) {
+                std::vector<AggregateInfo>&& aggregates,
+                SpillConfig spill_config = {},
+                std::shared_ptr<MemoryTracker> memory_tracker = nullptr)
+        : hashers_(std::move(hashers)),
+          aggregates_(std::move(aggregates)),
+          spillConfig_(std::move(spill_config)),
+          spillStartBit_(
+              Spiller::firstStartBit(spillConfig_.num_partition_bits)),
+          memory_(std::move(memory_tracker)) {
         isGlobal_ = hashers_.empty();
+        for (auto i = 0; i < input_type->column_count(); i++) {
+            inputTypes_.push_back(input_type->column_type(i));
+        }
     }
 
     ~GroupingSet();
@@ -54,15 +66,23 @@ class GroupingSet {
     std::vector<Accumulator>
     accumulators();
 
-    // Checks if input will fit in the existing memory and increases reservation
-    // if not. If reservation cannot be increased, spills enough to make 'input'
-    // fit.
+    // Checks if the groups 'input' may add still fit in the spill memory
+    // limit. If not, starts spilling: from then on rows of groups already in
+    // the hash table keep being aggregated in memory while rows of new groups
+    // are written to disk, partitioned by hash.
     void
     ensureInputFits(const RowVectorPtr& input);
 
+    // Produces one batch of groups: first the groups held in memory, then the
+    // groups of each spilled partition, which is re-aggregated on its own.
+    // Returns false once all groups are produced.
     bool
     getOutput(RowVectorPtr& result);
 
+    // Whether getOutput has batches left to produce.
+    bool
+    hasRemainingOutput() const;
+
     void
     extractGroups(const RowVectorPtr& result);
 
@@ -75,7 +95,29 @@ class GroupingSet {
     int32_t
     outputRowCount() const;
 
+    int64_t
+    numSpilledRows() const {
+        return numSpilledRows_;
+    }
+
  private:
+    void
+    updateAggregates(const RowVectorPtr& input);
+
+    // Spills the rows of 'input' the probe did not find a group for and
+    // aggregates the others.
+    void
+    spillNewGroups(const RowVectorPtr& input);
+
+    // Hands the partitions of the active spiller over to pendingPartitions_.
+    void
+    finishSpill();
+
+    // Replaces the hash table with an empty one and aggregates 'partition'
+    // into it.
+    void
+    aggregateSpilledPartition(SpillPartition partition);
+
     bool isGlobal_;
 
     std::vector<std::unique_ptr<VectorHasher>> hashers_;
@@ -87,6 +129,20 @@ class GroupingSet {
     std::unique_ptr<HashLookup> lookup_;
     uint64_t numInputRows_ = 0;
 
+    const SpillConfig spillConfig_;
+    std::vector<DataType> inputTypes_;
+    // Start bit of the partitions the hash table spills into, -1 once the
+    // hash bits are used up and the table can only grow in memory.
+    int32_t spillStartBit_;
+    std::unique_ptr<Spiller> spiller_;
+    std::vector<SpillPartition> pendingPartitions_;
+    int64_t numSpilledRows_ = 0;
+    // The bytes of the hash table on the tracker of the operator. Growth the
+    // tracker refuses starts spilling like the spill memory limit does.
+    MemoryReservation memory_;
+    // Whether the groups in the current hash table have been produced.
+    bool tableOutputDone_ = false;
+
     // RAII-managed buffer for global aggregation to ensure exception safety
     std::unique_ptr<char[]> globalAggregationBuffer_;
 
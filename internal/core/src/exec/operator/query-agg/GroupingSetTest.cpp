@@ -0,0 +1,264 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <random>
+
+#include "common/Utils.h"
+#include "exec/QueryContext.h"
+#include "exec/operator/query-agg/GroupingSet.h"
+#include "exec/operator/query-agg/Spiller.h"
+#include "exec/operator/query-agg/SumAggregateBase.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+namespace {
+
+// null keys are represented by std::nullopt
+using GroupResult = std::map<std::optional<int64_t>, int64_t>;
+
+RowVectorPtr
+MakeBatch(const std::vector<std::optional<int64_t>>& keys,
+          const std::vector<int64_t>& values) {
+    auto key_column =
+        std::make_shared<ColumnVector>(DataType::INT64, keys.size());
+    auto value_column =
+        std::make_shared<ColumnVector>(DataType::INT64, values.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (keys[i].has_value()) {
+            key_column->SetValueAt<int64_t>(i, keys[i].value());
+        } else {
+            key_column->nullAt(i);
+        }
+        value_column->SetValueAt<int64_t>(i, values[i]);
+    }
+    return std::make_shared<RowVector>(
+        std::vector<VectorPtr>{key_column, value_column});
+}
+
+RowTypePtr
+InputType() {
+    return std::make_shared<RowType>(
+        std::vector<std::string>{"key", "value"},
+        std::vector<DataType>{DataType::INT64, DataType::INT64});
+}
+
+}  // namespace
+
+class GroupingSetSpillTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        registerSumAggregate();
+        spill_dir_ =
+            (std::filesystem::temp_directory_path() / "grouping_set_test")
+                .string();
+        std::filesystem::remove_all(spill_dir_);
+
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int64_t> key_dist(0, kNumKeys - 1);
+        for (int batch = 0; batch < kNumBatches; batch++) {
+            std::vector<std::optional<int64_t>> keys;
+            std::vector<int64_t> values;
+            for (int i = 0; i < kBatchSize; i++) {
+                auto key = key_dist(gen);
+                // a few null keys to make sure the null group survives a spill
+                if (key % 997 == 0) {
+                    keys.emplace_back(std::nullopt);
+                } else {
+                    keys.emplace_back(key);
+                }
+                values.push_back(i % 7);
+                expected_[keys.back()] += values.back();
+            }
+            batches_.push_back(MakeBatch(keys, values));
+        }
+    }
+
+    void
+    TearDown() override {
+        std::filesystem::remove_all(spill_dir_);
+    }
+
+    GroupResult
+    RunGroupBy(int64_t memory_limit,
+               int64_t& num_spilled_rows,
+               int& num_batches) {
+        SpillConfig config;
+        config.directory = spill_dir_;
+        config.memory_limit = memory_limit;
+
+        std::vector<std::unique_ptr<VectorHasher>> hashers;
+        hashers.emplace_back(VectorHasher::create(DataType::INT64, 0));
+        std::vector<AggregateInfo> aggregates(1);
+        aggregates[0].function_ =
+            Aggregate::create(KSum, {DataType::INT64}, QueryConfig{});
+        aggregates[0].input_column_idxes_ = {1};
+        aggregates[0].output_ = 1;
+
+        GroupingSet grouping_set(
+            InputType(), std::move(hashers), std::move(aggregates), config);
+        for (const auto& batch : batches_) {
+            grouping_set.addInput(batch);
+        }
+
+        GroupResult result;
+        num_batches = 0;
+        do {
+            auto output = std::make_shared<RowVector>(
+                InputType(), grouping_set.outputRowCount());
+            if (!grouping_set.getOutput(output)) {
+                break;
+            }
+            num_batches++;
+            auto keys =
+                std::dynamic_pointer_cast<ColumnVector>(output->child(0));
+            auto sums =
+                std::dynamic_pointer_cast<ColumnVector>(output->child(1));
+            for (size_t i = 0; i < output->size(); i++) {
+                std::optional<int64_t> key;
+                if (keys->ValidAt(i)) {
+                    key = keys->ValueAt<int64_t>(i);
+                }
+                // every group must be produced exactly once
+                EXPECT_EQ(result.count(key), 0);
+                result[key] = sums->ValueAt<int64_t>(i);
+            }
+        } while (grouping_set.hasRemainingOutput());
+        num_spilled_rows = grouping_set.numSpilledRows();
+        return result;
+    }
+
+    static constexpr int kNumKeys = 20000;
+    static constexpr int kNumBatches = 16;
+    static constexpr int kBatchSize = 4096;
+
+    std::string spill_dir_;
+    std::vector<RowVectorPtr> batches_;
+    GroupResult expected_;
+};
+
+TEST_F(GroupingSetSpillTest, NoSpillWithoutLimit) {
+    int64_t num_spilled_rows = 0;
+    int num_batches = 0;
+    auto result = RunGroupBy(0, num_spilled_rows, num_batches);
+    EXPECT_EQ(num_spilled_rows, 0);
+    EXPECT_EQ(num_batches, 1);
+    EXPECT_EQ(result, expected_);
+}
+
+TEST_F(GroupingSetSpillTest, SpillAndReaggregate) {
+    int64_t num_spilled_rows = 0;
+    int num_batches = 0;
+    // enough for a few thousand groups, far less than all of them
+    auto result = RunGroupBy(256 << 10, num_spilled_rows, num_batches);
+    EXPECT_GT(num_spilled_rows, 0);
+    EXPECT_GT(num_batches, 1);
+    EXPECT_EQ(result, expected_);
+    // all spill files are consumed
+    EXPECT_TRUE(std::filesystem::is_empty(spill_dir_));
+}
+
+TEST_F(GroupingSetSpillTest, RecursiveSpill) {
+    int64_t num_spilled_rows = 0;
+    int num_batches = 0;
+    // every table only keeps the groups of its first batch, so partitions
+    // spill again into the next level
+    auto result = RunGroupBy(1, num_spilled_rows, num_batches);
+    EXPECT_GT(num_spilled_rows, 0);
+    EXPECT_GT(num_batches, 9);
+    EXPECT_EQ(result, expected_);
+    EXPECT_TRUE(std::filesystem::is_empty(spill_dir_));
+}
+
+TEST(SpillerTest, PartitionRoundTrip) {
+    auto spill_dir =
+        (std::filesystem::temp_directory_path() / "spiller_test").string();
+    std::filesystem::remove_all(spill_dir);
+    SpillConfig config;
+    config.directory = spill_dir;
+    config.num_partition_bits = 2;
+    const std::vector<DataType> types{DataType::INT64, DataType::VARCHAR};
+    const auto start_bit = Spiller::firstStartBit(config.num_partition_bits);
+
+    const int num_rows = 1000;
+    auto ints = std::make_shared<ColumnVector>(DataType::INT64, num_rows);
+    auto strs = std::make_shared<ColumnVector>(DataType::VARCHAR, num_rows);
+    std::vector<uint64_t> hashes(num_rows);
+    std::vector<vector_size_t> rows;
+    for (int i = 0; i < num_rows; i++) {
+        ints->SetValueAt<int64_t>(i, i);
+        if (i % 10 == 0) {
+            strs->nullAt(i);
+        } else {
+            strs->SetValueAt<std::string>(i, "str_" + std::to_string(i));
+        }
+        hashes[i] = static_cast<uint64_t>(i % 4) << start_bit | i;
+        // leave out every third row
+        if (i % 3 != 0) {
+            rows.push_back(i);
+        }
+    }
+    auto input =
+        std::make_shared<RowVector>(std::vector<VectorPtr>{ints, strs});
+
+    Spiller spiller(config, types, start_bit);
+    spiller.spill(input, hashes, rows);
+    auto partitions = spiller.finish();
+    ASSERT_EQ(partitions.size(), 4);
+    EXPECT_EQ(spiller.spilledRows(), rows.size());
+
+    size_t num_read = 0;
+    for (auto& partition : partitions) {
+        auto path = partition.path;
+        std::optional<uint64_t> partition_bits;
+        {
+            SpillPartitionReader reader(partition, types);
+            while (auto batch = reader.next()) {
+                auto read_ints =
+                    std::dynamic_pointer_cast<ColumnVector>(batch->child(0));
+                auto read_strs =
+                    std::dynamic_pointer_cast<ColumnVector>(batch->child(1));
+                for (size_t i = 0; i < batch->size(); i++) {
+                    auto row = read_ints->ValueAt<int64_t>(i);
+                    EXPECT_NE(row % 3, 0);
+                    // all rows of a partition share the partition bits
+                    auto bits = (hashes[row] >> start_bit) & 3;
+                    if (!partition_bits.has_value()) {
+                        partition_bits = bits;
+                    }
+                    EXPECT_EQ(bits, partition_bits.value());
+                    if (row % 10 == 0) {
+                        EXPECT_FALSE(read_strs->ValidAt(i));
+                    } else {
+                        EXPECT_EQ(read_strs->ValueAt<std::string>(i),
+                                  "str_" + std::to_string(row));
+                    }
+                    num_read++;
+                }
+            }
+        }
+        // the reader removes the partition once it is done
+        EXPECT_FALSE(std::filesystem::exists(path));
+    }
+    EXPECT_EQ(num_read, rows.size());
+    std::filesystem::remove_all(spill_dir);
+}
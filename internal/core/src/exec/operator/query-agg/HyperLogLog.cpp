@@ -0,0 +1,114 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HyperLogLog.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+// Bias correction constant of the raw estimate for m registers.
+double
+alpha(size_t m) {
+    switch (m) {
+        case 16:
+            return 0.673;
+        case 32:
+            return 0.697;
+        case 64:
+            return 0.709;
+        default:
+            return 0.7213 / (1 + 1.079 / m);
+    }
+}
+
+}  // namespace
+
+HyperLogLog::HyperLogLog(int8_t index_bits)
+    : index_bits_(index_bits), registers_(size_t{1} << index_bits, 0) {
+    AssertInfo(index_bits >= kMinIndexBits && index_bits <= kMaxIndexBits,
+               "HyperLogLog index bits must be in [{}, {}], got {}",
+               kMinIndexBits,
+               kMaxIndexBits,
+               index_bits);
+}
+
+void
+HyperLogLog::insertHash(uint64_t hash) {
+    const auto index = hash >> (64 - index_bits_);
+    // rank of the first set bit in the remaining bits, counting from 1
+    const auto rest = hash << index_bits_;
+    const uint8_t rank =
+        rest == 0 ? 64 - index_bits_ + 1 : __builtin_clzll(rest) + 1;
+    registers_[index] = std::max(registers_[index], rank);
+}
+
+void
+HyperLogLog::merge(const HyperLogLog& other) {
+    AssertInfo(index_bits_ == other.index_bits_,
+               "cannot merge HyperLogLog sketches of {} and {} index bits",
+               index_bits_,
+               other.index_bits_);
+    for (size_t i = 0; i < registers_.size(); i++) {
+        registers_[i] = std::max(registers_[i], other.registers_[i]);
+    }
+}
+
+int64_t
+HyperLogLog::cardinality() const {
+    const auto m = registers_.size();
+    double sum = 0;
+    size_t zeros = 0;
+    for (auto value : registers_) {
+        sum += std::ldexp(1.0, -value);
+        zeros += value == 0;
+    }
+    auto estimate = alpha(m) * m * m / sum;
+    // linear counting is more accurate while many registers are empty
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * std::log(static_cast<double>(m) / zeros);
+    }
+    return std::llround(estimate);
+}
+
+void
+HyperLogLog::serialize(std::string& out) const {
+    out.push_back(static_cast<char>(index_bits_));
+    out.append(reinterpret_cast<const char*>(registers_.data()),
+               registers_.size());
+}
+
+HyperLogLog
+HyperLogLog::deserialize(std::string_view data) {
+    AssertInfo(!data.empty(), "empty HyperLogLog sketch");
+    HyperLogLog sketch(static_cast<int8_t>(data[0]));
+    AssertInfo(data.size() == 1 + sketch.registers_.size(),
+               "HyperLogLog sketch of {} index bits must be {} bytes, got {}",
+               sketch.index_bits_,
+               1 + sketch.registers_.size(),
+               data.size());
+    std::copy(data.begin() + 1, data.end(), sketch.registers_.begin());
+    return sketch;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,76 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace milvus {
+namespace exec {
+
+/// Dense HyperLogLog sketch for approximate distinct counts. There are
+/// 2^index_bits one byte registers, the standard error of the estimate is
+/// about 1.04 / sqrt(2^index_bits), 2.3% for the default of 11 bits.
+/// Sketches with the same number of index bits merge into the sketch of the
+/// union of their inputs.
+class HyperLogLog {
+ public:
+    static constexpr int8_t kDefaultIndexBits = 11;
+    static constexpr int8_t kMinIndexBits = 4;
+    static constexpr int8_t kMaxIndexBits = 16;
+
+    explicit HyperLogLog(int8_t index_bits = kDefaultIndexBits);
+
+    /// Adds a 64 bit hash of a value. The hash must be well mixed, all of
+    /// its bits are used.
+    void
+    insertHash(uint64_t hash);
+
+    void
+    merge(const HyperLogLog& other);
+
+    /// Estimated number of distinct hashes inserted.
+    int64_t
+    cardinality() const;
+
+    int8_t
+    indexBits() const {
+        return index_bits_;
+    }
+
+    /// Appends the sketch to 'out'.
+    void
+    serialize(std::string& out) const;
+
+    static HyperLogLog
+    deserialize(std::string_view data);
+
+    /// Bytes held by the sketch outside of the object itself.
+    size_t
+    heapBytes() const {
+        return registers_.capacity();
+    }
+
+ private:
+    int8_t index_bits_;
+    std::vector<uint8_t> registers_;
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,201 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "KllSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "common/EasyAssert.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+template <typename T>
+void
+append(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T
+read(std::string_view data, size_t& offset) {
+    AssertInfo(offset + sizeof(T) <= data.size(),
+               "truncated KLL sketch of {} bytes",
+               data.size());
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+}  // namespace
+
+KllSketch::KllSketch(uint32_t k) : k_(k), levels_(1) {
+    AssertInfo(k >= kMinLevelCapacity,
+               "KLL sketch k must be at least {}, got {}",
+               kMinLevelCapacity,
+               k);
+}
+
+uint32_t
+KllSketch::levelCapacity(size_t level) const {
+    // capacities shrink by 2/3 from the top level down
+    const auto depth = levels_.size() - level - 1;
+    const auto capacity =
+        static_cast<uint32_t>(std::ceil(k_ * std::pow(2.0 / 3.0, depth)));
+    return std::max(capacity, kMinLevelCapacity);
+}
+
+uint32_t
+KllSketch::nextRandomBit() {
+    // xorshift64
+    random_state_ ^= random_state_ << 13;
+    random_state_ ^= random_state_ >> 7;
+    random_state_ ^= random_state_ << 17;
+    return random_state_ & 1;
+}
+
+void
+KllSketch::insert(double value) {
+    levels_[0].push_back(value);
+    count_++;
+    if (levels_[0].size() >= levelCapacity(0)) {
+        compress();
+    }
+}
+
+void
+KllSketch::compress() {
+    // levels_ grows while compacting, so do not hold on to references
+    for (size_t level = 0; level < levels_.size(); level++) {
+        if (levels_[level].size() < levelCapacity(level)) {
+            continue;
+        }
+        if (level + 1 == levels_.size()) {
+            levels_.emplace_back();
+        }
+        auto items = std::move(levels_[level]);
+        levels_[level].clear();
+        std::sort(items.begin(), items.end());
+        // an odd item out stays at its level
+        if (items.size() % 2 == 1) {
+            levels_[level].push_back(items.back());
+            items.pop_back();
+        }
+        auto& next = levels_[level + 1];
+        for (size_t i = nextRandomBit(); i < items.size(); i += 2) {
+            next.push_back(items[i]);
+        }
+    }
+}
+
+void
+KllSketch::merge(const KllSketch& other) {
+    AssertInfo(k_ == other.k_,
+               "cannot merge KLL sketches with k {} and {}",
+               k_,
+               other.k_);
+    if (levels_.size() < other.levels_.size()) {
+        levels_.resize(other.levels_.size());
+    }
+    for (size_t level = 0; level < other.levels_.size(); level++) {
+        levels_[level].insert(levels_[level].end(),
+                              other.levels_[level].begin(),
+                              other.levels_[level].end());
+    }
+    count_ += other.count_;
+    compress();
+}
+
+double
+KllSketch::quantile(double fraction) const {
+    AssertInfo(count_ > 0, "quantile of an empty KLL sketch");
+    std::vector<std::pair<double, uint64_t>> weighted;
+    uint64_t total_weight = 0;
+    for (size_t level = 0; level < levels_.size(); level++) {
+        const uint64_t weight = uint64_t{1} << level;
+        for (auto value : levels_[level]) {
+            weighted.emplace_back(value, weight);
+            total_weight += weight;
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+    const auto rank = std::clamp(fraction, 0.0, 1.0) * total_weight;
+    uint64_t cumulative = 0;
+    for (const auto& [value, weight] : weighted) {
+        cumulative += weight;
+        if (cumulative >= rank) {
+            return value;
+        }
+    }
+    return weighted.back().first;
+}
+
+size_t
+KllSketch::heapBytes() const {
+    size_t bytes = levels_.capacity() * sizeof(std::vector<double>);
+    for (const auto& level : levels_) {
+        bytes += level.capacity() * sizeof(double);
+    }
+    return bytes;
+}
+
+void
+KllSketch::serialize(std::string& out) const {
+    append(out, k_);
+    append(out, count_);
+    append(out, random_state_);
+    append(out, static_cast<uint32_t>(levels_.size()));
+    for (const auto& level : levels_) {
+        append(out, static_cast<uint32_t>(level.size()));
+        out.append(reinterpret_cast<const char*>(level.data()),
+                   level.size() * sizeof(double));
+    }
+}
+
+KllSketch
+KllSketch::deserialize(std::string_view data) {
+    size_t offset = 0;
+    KllSketch sketch(read<uint32_t>(data, offset));
+    sketch.count_ = read<int64_t>(data, offset);
+    sketch.random_state_ = read<uint64_t>(data, offset);
+    const auto num_levels = read<uint32_t>(data, offset);
+    AssertInfo(num_levels > 0 && num_levels <= 64,
+               "invalid number of levels {} in KLL sketch",
+               num_levels);
+    sketch.levels_.resize(num_levels);
+    for (auto& level : sketch.levels_) {
+        const auto size = read<uint32_t>(data, offset);
+        AssertInfo(offset + size * sizeof(double) <= data.size(),
+                   "truncated KLL sketch of {} bytes",
+                   data.size());
+        level.resize(size);
+        std::memcpy(level.data(), data.data() + offset, size * sizeof(double));
+        offset += size * sizeof(double);
+    }
+    AssertInfo(offset == data.size(),
+               "{} trailing bytes after KLL sketch",
+               data.size() - offset);
+    return sketch;
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,89 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace milvus {
+namespace exec {
+
+/// KLL quantile sketch (Karnin, Lang, Liberty) over doubles. Items live in
+/// levels of compactors, an item at level h stands for 2^h inputs. A full
+/// level is sorted and every other item is promoted to the next level, so the
+/// sketch keeps O(k) items and its rank error is about 1.7 / k, 0.85% for the
+/// default k. Sketches merge into the sketch of the union of their inputs.
+class KllSketch {
+ public:
+    static constexpr uint32_t kDefaultK = 200;
+
+    explicit KllSketch(uint32_t k = kDefaultK);
+
+    void
+    insert(double value);
+
+    void
+    merge(const KllSketch& other);
+
+    /// Value at 'fraction' of the inputs in sorted order, e.g. 0.5 for the
+    /// median. The sketch must not be empty.
+    double
+    quantile(double fraction) const;
+
+    /// Number of inputs.
+    int64_t
+    count() const {
+        return count_;
+    }
+
+    /// Appends the sketch to 'out'.
+    void
+    serialize(std::string& out) const;
+
+    static KllSketch
+    deserialize(std::string_view data);
+
+    /// Bytes held by the sketch outside of the object itself.
+    size_t
+    heapBytes() const;
+
+ private:
+    // Smallest capacity of a level.
+    static constexpr uint32_t kMinLevelCapacity = 8;
+
+    uint32_t
+    levelCapacity(size_t level) const;
+
+    // Compacts full levels bottom up.
+    void
+    compress();
+
+    // A pseudo random bit, picking whether the odd or the even items of a
+    // compacted level are promoted.
+    uint32_t
+    nextRandomBit();
+
+    uint32_t k_;
+    int64_t count_ = 0;
+    uint64_t random_state_ = 0x2545f4914f6cdd1dULL;
+    std::vector<std::vector<double>> levels_;
+};
+
+}  // namespace exec
+}  // namespace milvus
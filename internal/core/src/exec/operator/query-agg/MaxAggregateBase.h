@@ -63,8 +63,17 @@ class MaxAggregateBase
     void
     addSingleGroupRawInput(char* group,
                            const std::vector<VectorPtr>& input) override {
-        BaseAggregate::template updateOneGroup<TAccumulator>(
-            group, input[0], &updateSingleValue<TAccumulator>);
+        BaseAggregate::template reduceOneGroup<TAccumulator>(
+            group,
+            input[0],
+            [](const TInput* values, vector_size_t begin, vector_size_t end) {
+                return minMaxRun<TAccumulator, false>(
+                    values,
+                    begin,
+                    end,
+                    std::numeric_limits<TAccumulator>::lowest());
+            },
+            &updateSingleValue<TAccumulator>);
     }
 
     void
@@ -22,7 +22,8 @@ namespace milvus {
 namespace exec {
 
 RowContainer::RowContainer(const std::vector<DataType>& keyTypes,
-                           const std::vector<Accumulator>& accumulators)
+                           const std::vector<Accumulator>& accumulators,
+                           bool hasNormalizedKeys)
     : keyTypes_(keyTypes), accumulators_(accumulators) {
     int32_t offset = 0;
     bool isVariableWidth = false;
@@ -68,6 +69,10 @@ RowContainer::RowContainer(const std::vector<DataType>& keyTypes,
     for (auto i = 0; i < offsets_.size(); i++) {
         rowColumns_.emplace_back(offsets_[i], firstAggregateOffset * 8 + i);
     }
+    if (hasNormalizedKeys) {
+        normalizedKeySize_ =
+            milvus::bits::roundUp(sizeof(uint64_t), alignment_);
+    }
 }
 
 RowContainer::~RowContainer() {
@@ -82,7 +87,8 @@ RowContainer::initializeRow(char* row) {
 
 char*
 RowContainer::newRow() {
-    char* row = new char[fixedRowSize_];
+    char* row = new char[normalizedKeySize_ + fixedRowSize_] +
+                normalizedKeySize_;
     rows_.emplace_back(row);
     ++numRows_;
     return initializeRow(row);
@@ -113,7 +119,10 @@ Accumulator::Accumulator(bool isFixedSize, int32_t fixedSize, int32_t alignment)
 }
 
 Accumulator::Accumulator(milvus::exec::Aggregate* aggregate)
-    : isFixedSize_(false), fixedSize_(0), alignment_(0) {
+    : isFixedSize_(false),
+      fixedSize_(0),
+      alignment_(0),
+      aggregate_(aggregate) {
     AssertInfo(aggregate != nullptr,
                "Input aggregate for accumulator cannot be nullptr!");
     isFixedSize_ = aggregate->isFixedSize();
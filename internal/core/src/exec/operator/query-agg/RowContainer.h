@@ -47,10 +47,18 @@ class Accumulator {
         return fixedSize_;
     }
 
+    /// The aggregate to destroy the accumulators with, nullptr if the
+    /// accumulator was not created from an aggregate.
+    Aggregate*
+    aggregate() const {
+        return aggregate_;
+    }
+
  private:
     bool isFixedSize_;
     int32_t fixedSize_;
     int32_t alignment_;
+    Aggregate* aggregate_ = nullptr;
 };
 
 /// Packed representation of offset, null byte offset and null mask for
@@ -88,8 +96,11 @@ class RowColumn {
 
 class RowContainer {
  public:
+    /// If 'hasNormalizedKeys' is true, every row is preceded by a 64 bit
+    /// normalized key slot, see normalizedKey().
     RowContainer(const std::vector<DataType>& keyTypes,
-                 const std::vector<Accumulator>& accumulators);
+                 const std::vector<Accumulator>& accumulators,
+                 bool hasNormalizedKeys = false);
 
     ~RowContainer();
 
@@ -102,6 +113,18 @@ class RowContainer {
         return keyTypes_;
     }
 
+    bool
+    hasNormalizedKeys() const {
+        return normalizedKeySize_ > 0;
+    }
+
+    /// The normalized key of 'row', stored right in front of the row. Only
+    /// valid if the container was created with normalized keys.
+    static inline uint64_t&
+    normalizedKey(char* row) {
+        return reinterpret_cast<uint64_t*>(row)[-1];
+    }
+
     const RowColumn&
     columnAt(int32_t column_idx) const {
         return rowColumns_[column_idx];
@@ -251,8 +274,10 @@ class RowContainer {
             if constexpr (std::is_same_v<T, std::string>) {
                 // the string object and also the underlying char array are both allocated on the heap
                 // must call clear method to deallocate these memory allocated for varchar type to avoid memory leak
-                *reinterpret_cast<std::string**>(group + offset) =
+                auto* str =
                     new std::string(*static_cast<std::string*>(raw_val_ptr));
+                stringBytes_ += sizeof(std::string) + str->capacity();
+                *reinterpret_cast<std::string**>(group + offset) = str;
             } else {
                 *reinterpret_cast<T*>(group + offset) =
                     *(static_cast<T*>(raw_val_ptr));
@@ -389,6 +414,12 @@ class RowContainer {
 
     void
     clear() {
+        for (const auto& accumulator : accumulators_) {
+            if (!accumulator.isFixedSize() && accumulator.aggregate()) {
+                accumulator.aggregate()->destroy(
+                    folly::Range<char**>(rows_.data(), rows_.size()));
+            }
+        }
         for (auto row : rows_) {
             for (auto i = 0; i < variable_offsets_.size(); i++) {
                 auto& off = variable_offsets_[i];
@@ -402,10 +433,23 @@ class RowContainer {
                     *reinterpret_cast<std::string**>(row + off) = nullptr;
                 }
             }
-            delete[] row;
+            delete[](row - normalizedKeySize_);
         }
         rows_.clear();
         numRows_ = 0;
+        stringBytes_ = 0;
+    }
+
+    /// Bytes held by the rows, including the out of line string keys.
+    int64_t
+    usedBytes() const {
+        return numRows_ * (fixedRowSize_ + normalizedKeySize_) +
+               stringBytes_ + rows_.capacity() * sizeof(char*);
+    }
+
+    int32_t
+    fixedRowSize() const {
+        return fixedRowSize_;
     }
 
     char*
@@ -424,9 +468,14 @@ class RowContainer {
 
     // for rows containing variable width fields, we store row size at the end of the row
     uint32_t rowSizeOffset_ = 0;
+    // Bytes reserved in front of each row for its normalized key, rounded up
+    // to the row alignment. 0 if there are no normalized keys.
+    uint32_t normalizedKeySize_ = 0;
     int alignment_ = 1;
     std::vector<Accumulator> accumulators_;
     uint64_t numRows_ = 0;
+    // Bytes of the std::string objects allocated for variable width keys.
+    int64_t stringBytes_ = 0;
     std::vector<char*> rows_{};
 };
 
@@ -0,0 +1,273 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#include "SegmentStatsAggregation.h"
+
+#include <algorithm>
+#include <optional>
+
+#include "common/Utils.h"
+#include "index/ScalarIndexSort.h"
+#include "index/SkipIndex.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+// true if the rows reach the aggregation straight from the segment, through
+// nothing but mvcc and projection
+bool
+readsWholeSegment(const plan::PlanNodePtr& node) {
+    if (std::dynamic_pointer_cast<const plan::MvccNode>(node) == nullptr &&
+        std::dynamic_pointer_cast<const plan::ProjectNode>(node) == nullptr) {
+        return false;
+    }
+    for (const auto& source : node->sources()) {
+        if (!readsWholeSegment(source)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+isIntegerType(DataType dataType) {
+    switch (dataType) {
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32:
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// The least, or with isMax the greatest, value of the field over the rows
+// below activeCount not set in deleted. nullopt if every such row is null.
+template <typename T>
+std::optional<T>
+fieldExtreme(const segcore::SegmentInternalInterface* segment,
+             OpContext* opContext,
+             FieldId fieldId,
+             bool isMax,
+             int64_t activeCount,
+             const TargetBitmap& deleted) {
+    auto visible = [&](int64_t offset) {
+        return offset < activeCount && !deleted[offset];
+    };
+
+    // a sort index holds the valid values in order, its first and last
+    // visible entries are the answer
+    auto pinnedIndexes = segment->PinIndex(opContext, fieldId);
+    for (const auto& pinned : pinnedIndexes) {
+        auto sorted =
+            dynamic_cast<const index::ScalarIndexSort<T>*>(pinned.get());
+        if (sorted == nullptr) {
+            continue;
+        }
+        if (isMax) {
+            for (auto it = sorted->end(); it != sorted->begin();) {
+                --it;
+                if (visible(it->idx_)) {
+                    return it->a_;
+                }
+            }
+        } else {
+            for (auto it = sorted->begin(); it != sorted->end(); ++it) {
+                if (visible(it->idx_)) {
+                    return it->a_;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    // otherwise the skip index has the min and max of each chunk, which hold
+    // unless the chunk has deleted rows or rows past activeCount
+    std::optional<T> result;
+    auto take = [&](T value) {
+        if (!result.has_value() ||
+            (isMax ? *result < value : value < *result)) {
+            result = value;
+        }
+    };
+    const auto& skipIndex = segment->GetSkipIndex();
+    auto numChunks = segment->num_chunk_data(fieldId);
+    for (int64_t chunkId = 0; chunkId < numChunks; chunkId++) {
+        auto begin = segment->num_rows_until_chunk(fieldId, chunkId);
+        auto chunkSize = segment->chunk_size(fieldId, chunkId);
+        auto end = std::min(begin + chunkSize, activeCount);
+        if (begin >= end) {
+            break;
+        }
+        auto firstDeleted =
+            begin == 0 ? deleted.find_first() : deleted.find_next(begin - 1);
+        bool intact = end == begin + chunkSize &&
+                      (!firstDeleted.has_value() || *firstDeleted >= end);
+        if (intact) {
+            auto minMax = skipIndex.GetMinMax<T>(fieldId, chunkId);
+            if (minMax.has_value()) {
+                take(isMax ? minMax->second : minMax->first);
+                continue;
+            }
+        }
+        auto pinnedChunk = segment->chunk_data<T>(opContext, fieldId, chunkId);
+        auto span = pinnedChunk.get();
+        auto validData = span.valid_data();
+        for (int64_t i = 0; i < end - begin; i++) {
+            if ((validData == nullptr || validData[i]) &&
+                !deleted[begin + i]) {
+                take(span.data()[i]);
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void
+setExtreme(ColumnVector& column,
+           const segcore::SegmentInternalInterface* segment,
+           OpContext* opContext,
+           FieldId fieldId,
+           bool isMax,
+           int64_t activeCount,
+           const TargetBitmap& deleted) {
+    auto value = fieldExtreme<T>(
+        segment, opContext, fieldId, isMax, activeCount, deleted);
+    if (value.has_value()) {
+        column.SetValueAt<T>(0, *value);
+    } else {
+        column.nullAt(0);
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<SegmentStatsAggregation>
+SegmentStatsAggregation::create(const plan::AggregationNode& aggregationNode) {
+    if (!aggregationNode.GroupingKeys().empty()) {
+        return nullptr;
+    }
+    for (const auto& source : aggregationNode.sources()) {
+        if (!readsWholeSegment(source)) {
+            return nullptr;
+        }
+    }
+    std::vector<StatsAggregate> aggregates;
+    for (const auto& aggregate : aggregationNode.aggregates()) {
+        const auto& call = aggregate.call_;
+        const auto& inputs = call->inputs();
+        if (call->fun_name() == KCount && inputs.empty()) {
+            aggregates.push_back({Kind::kCount, FieldId(0), DataType::NONE});
+            continue;
+        }
+        if ((call->fun_name() != KMin && call->fun_name() != KMax) ||
+            inputs.size() != 1 || !isIntegerType(aggregate.resultType_)) {
+            return nullptr;
+        }
+        auto field =
+            std::dynamic_pointer_cast<const expr::FieldAccessTypeExpr>(
+                inputs[0]);
+        if (field == nullptr) {
+            return nullptr;
+        }
+        aggregates.push_back(
+            {call->fun_name() == KMax ? Kind::kMax : Kind::kMin,
+             field->field_id(),
+             aggregate.resultType_});
+    }
+    return std::unique_ptr<SegmentStatsAggregation>(
+        new SegmentStatsAggregation(std::move(aggregates)));
+}
+
+RowVectorPtr
+SegmentStatsAggregation::getOutput(const RowTypePtr& outputType,
+                                   QueryContext* queryContext) const {
+    auto segment = queryContext->get_segment();
+    auto queryTimestamp = queryContext->get_query_timestamp();
+    auto activeCount = queryContext->get_active_count();
+    if (activeCount > 0 &&
+        !segment->all_visible_at(queryTimestamp,
+                                 queryContext->get_collection_ttl())) {
+        return nullptr;
+    }
+    for (const auto& aggregate : aggregates_) {
+        if (aggregate.kind_ != Kind::kCount &&
+            segment->type() != SegmentType::Sealed) {
+            return nullptr;
+        }
+    }
+
+    // only the deletes hide rows below activeCount now
+    TargetBitmap deleted(activeCount);
+    if (activeCount > 0) {
+        BitsetTypeView deletedView(deleted.data(), activeCount);
+        segment->mask_with_delete(deletedView, activeCount, queryTimestamp);
+    }
+
+    auto output = std::make_shared<RowVector>(outputType, 1);
+    auto opContext = queryContext->get_op_context();
+    for (size_t i = 0; i < aggregates_.size(); i++) {
+        const auto& aggregate = aggregates_[i];
+        auto column = std::dynamic_pointer_cast<ColumnVector>(output->child(i));
+        if (aggregate.kind_ == Kind::kCount) {
+            column->SetValueAt<int64_t>(0, activeCount - deleted.count());
+            continue;
+        }
+        bool isMax = aggregate.kind_ == Kind::kMax;
+        switch (aggregate.dataType_) {
+            case DataType::INT8:
+                setExtreme<int8_t>(*column,
+                                   segment,
+                                   opContext,
+                                   aggregate.fieldId_,
+                                   isMax,
+                                   activeCount,
+                                   deleted);
+                break;
+            case DataType::INT16:
+                setExtreme<int16_t>(*column,
+                                    segment,
+                                    opContext,
+                                    aggregate.fieldId_,
+                                    isMax,
+                                    activeCount,
+                                    deleted);
+                break;
+            case DataType::INT32:
+                setExtreme<int32_t>(*column,
+                                    segment,
+                                    opContext,
+                                    aggregate.fieldId_,
+                                    isMax,
+                                    activeCount,
+                                    deleted);
+                break;
+            default:
+                setExtreme<int64_t>(*column,
+                                    segment,
+                                    opContext,
+                                    aggregate.fieldId_,
+                                    isMax,
+                                    activeCount,
+                                    deleted);
+                break;
+        }
+    }
+    return output;
+}
+
+}  // namespace exec
+}  // namespace milvus
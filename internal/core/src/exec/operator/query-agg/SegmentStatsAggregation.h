@@ -0,0 +1,59 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/Types.h"
+#include "common/Vector.h"
+#include "exec/QueryContext.h"
+#include "plan/PlanNode.h"
+
+namespace milvus {
+namespace exec {
+
+/// A global aggregation of count(*), min and max over a segment read with no
+/// filter, answered from the row count, the delete record, the sort indexes
+/// and the skip index of the segment instead of from its rows. Only the
+/// chunks holding deleted rows are scanned for min and max.
+class SegmentStatsAggregation {
+ public:
+    /// nullptr unless every aggregate of the global aggregation node is
+    /// count(*), or min or max of an integer field, and the node reads the
+    /// segment through no filter or sample.
+    static std::unique_ptr<SegmentStatsAggregation>
+    create(const plan::AggregationNode& aggregationNode);
+
+    /// The one output row, nullptr if the segment has to be aggregated row
+    /// by row: some of its rows are hidden by the query timestamp or the
+    /// collection ttl, or it is a growing segment asked for min or max.
+    RowVectorPtr
+    getOutput(const RowTypePtr& outputType, QueryContext* queryContext) const;
+
+ private:
+    enum class Kind { kCount, kMin, kMax };
+
+    struct StatsAggregate {
+        Kind kind_;
+        FieldId fieldId_;
+        DataType dataType_;
+    };
+
+    explicit SegmentStatsAggregation(std::vector<StatsAggregate>&& aggregates)
+        : aggregates_(std::move(aggregates)) {
+    }
+
+    std::vector<StatsAggregate> aggregates_;
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -11,11 +11,15 @@
 #pragma once
 
 #include "Aggregate.h"
+#include "AggregateKernels.h"
 namespace milvus {
 namespace exec {
 template <typename TInput, typename TAccumulator, typename TResult>
 class SimpleNumericAggregate : public exec::Aggregate {
  protected:
+    // Rows ahead of the current one whose group row is prefetched.
+    static constexpr vector_size_t kPrefetchDistance = 8;
+
     explicit SimpleNumericAggregate(DataType resultType)
         : Aggregate(resultType) {
     }
@@ -82,6 +86,44 @@ class SimpleNumericAggregate : public exec::Aggregate {
         }
     }
 
+    // Folds the whole input column into 'group'. 'reduceRun(values, begin,
+    // end)' reduces a run of valid raw values to one TData, which is then
+    // merged into the accumulator with 'updateSingleValue' like a single
+    // value.
+    template <typename TData = TResult,
+              typename TValue = TInput,
+              typename ReduceRun,
+              typename UpdateSingle>
+    void
+    reduceOneGroup(char* group,
+                   const VectorPtr& vector,
+                   ReduceRun reduceRun,
+                   UpdateSingle updateSingleValue) {
+        auto column_data = std::dynamic_pointer_cast<ColumnVector>(vector);
+        AssertInfo(
+            column_data != nullptr,
+            "input column data for upgrading groups should not be nullptr");
+        const auto* values = column_data->RawAsValues<TValue>();
+        auto& result = *Aggregate::value<TData>(group);
+        bool hasValue = false;
+        forEachValidRun(
+            column_data,
+            [&](vector_size_t begin, vector_size_t end) {
+                updateSingleValue(result, reduceRun(values, begin, end));
+                hasValue = true;
+            },
+            [&](vector_size_t row) {
+                updateSingleValue(result, TData(values[row]));
+                hasValue = true;
+            });
+        if (hasValue) {
+            Aggregate::clearNull(group);
+        }
+    }
+
+    // Updates groups[i] with row i of the input column. Rows are visited
+    // along the validity bitmap, so that runs without nulls go through a
+    // tight loop over the raw values.
     template <bool tableHasNulls,
               typename TData = TResult,
               typename TValue = TInput,
@@ -94,10 +136,23 @@ class SimpleNumericAggregate : public exec::Aggregate {
         AssertInfo(
             column_data != nullptr,
             "input column data for upgrading groups should not be nullptr");
-        for (auto i = 0; i < column_data->size(); i++) {
-            updateOneGroupAtIndex<tableHasNulls, TData, TValue>(
-                groups[i], column_data, i, updateSingleValue);
-        }
+        const auto* values = column_data->RawAsValues<TValue>();
+        forEachValidRun(
+            column_data,
+            [&](vector_size_t begin, vector_size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    // group rows are scattered over the heap
+                    if (i + kPrefetchDistance < end) {
+                        __builtin_prefetch(groups[i + kPrefetchDistance]);
+                    }
+                    updateNonNullValue<tableHasNulls, TData>(
+                        groups[i], TData(values[i]), updateSingleValue);
+                }
+            },
+            [&](vector_size_t row) {
+                updateNonNullValue<tableHasNulls, TData>(
+                    groups[row], TData(values[row]), updateSingleValue);
+            });
     }
 
     template <bool tableHasNulls,
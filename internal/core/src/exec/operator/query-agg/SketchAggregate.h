@@ -0,0 +1,167 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#pragma once
+
+#include <string>
+#include <utility>
+
+#include "Aggregate.h"
+
+namespace milvus {
+namespace exec {
+
+/// Base of aggregates whose accumulator is a heap allocated mergeable sketch,
+/// e.g. HyperLogLog. The group row holds a TSketch* that stays nullptr until
+/// the group sees its first non-null input. Intermediate results are the
+/// serialized sketches in a VARCHAR column, TSketch must provide merge(),
+/// serialize(std::string&) and a static deserialize(std::string_view).
+template <typename TSketch>
+class SketchAggregate : public Aggregate {
+ protected:
+    explicit SketchAggregate(DataType resultType) : Aggregate(resultType) {
+    }
+
+ public:
+    int32_t
+    accumulatorFixedWidthSize() const override {
+        return sizeof(TSketch*);
+    }
+
+    int32_t
+    accumulatorAlignmentSize() const override {
+        return static_cast<int32_t>(alignof(TSketch*));
+    }
+
+    bool
+    isFixedSize() const override {
+        return false;
+    }
+
+    DataType
+    intermediateType() const override {
+        return DataType::VARCHAR;
+    }
+
+    void
+    extractAccumulators(char** groups,
+                        int32_t numGroups,
+                        VectorPtr* result) override {
+        auto result_column = resizeResult(result, numGroups);
+        auto* raw = result_column->RawAsValues<std::string>();
+        for (auto i = 0; i < numGroups; i++) {
+            auto* state = sketch(groups[i]);
+            if (state == nullptr) {
+                result_column->nullAt(i);
+            } else {
+                result_column->clearNullAt(i);
+                raw[i].clear();
+                state->serialize(raw[i]);
+            }
+        }
+    }
+
+    void
+    addIntermediateResults(char** groups,
+                           int numGroups,
+                           const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* states = column->RawAsValues<std::string>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (column->ValidAt(i)) {
+                mergeSketch(groups[i], states[i]);
+            }
+        }
+    }
+
+    void
+    addSingleGroupIntermediateResults(
+        char* group, const std::vector<VectorPtr>& input) override {
+        auto column = inputColumn(input);
+        const auto* states = column->RawAsValues<std::string>();
+        for (auto i = 0; i < column->size(); i++) {
+            if (column->ValidAt(i)) {
+                mergeSketch(group, states[i]);
+            }
+        }
+    }
+
+    void
+    destroy(folly::Range<char**> groups) override {
+        for (auto* group : groups) {
+            auto& state = *value<TSketch*>(group);
+            delete state;
+            state = nullptr;
+        }
+    }
+
+    void
+    initializeNewGroupsInternal(
+        char** groups, folly::Range<const vector_size_t*> indices) override {
+        setAllNulls(groups, indices);
+        for (auto i : indices) {
+            *value<TSketch*>(groups[i]) = nullptr;
+        }
+    }
+
+ protected:
+    TSketch*
+    sketch(char* group) const {
+        return *value<TSketch*>(group);
+    }
+
+    // Sketch of 'group', constructed from 'args' on first use.
+    template <typename... Args>
+    TSketch&
+    ensureSketch(char* group, Args&&... args) {
+        auto& state = *value<TSketch*>(group);
+        if (state == nullptr) {
+            state = new TSketch(std::forward<Args>(args)...);
+            clearNull(group);
+        }
+        return *state;
+    }
+
+    static ColumnVectorPtr
+    inputColumn(const std::vector<VectorPtr>& input) {
+        AssertInfo(input.size() == 1,
+                   "sketch aggregate expects exactly one input column");
+        auto column = std::dynamic_pointer_cast<ColumnVector>(input[0]);
+        AssertInfo(column != nullptr,
+                   "sketch aggregate input must be of type ColumnVector");
+        return column;
+    }
+
+    static ColumnVectorPtr
+    resizeResult(VectorPtr* result, int32_t numGroups) {
+        auto result_column = std::dynamic_pointer_cast<ColumnVector>(*result);
+        AssertInfo(result_column != nullptr,
+                   "input vector for extracting aggregation must be of Type "
+                   "ColumnVector");
+        result_column->resize(numGroups);
+        return result_column;
+    }
+
+ private:
+    void
+    mergeSketch(char* group, const std::string& serialized) {
+        auto other = TSketch::deserialize(serialized);
+        auto& state = *value<TSketch*>(group);
+        if (state == nullptr) {
+            state = new TSketch(std::move(other));
+            clearNull(group);
+        } else {
+            state->merge(other);
+        }
+    }
+};
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,381 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Spiller.h"
+
+#include <unistd.h>
+#include <atomic>
+#include <filesystem>
+
+#include "arrow/api.h"
+#include "arrow/io/file.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "fmt/format.h"
+#include "log/Log.h"
+#include "storage/LocalChunkManagerSingleton.h"
+
+namespace milvus {
+namespace exec {
+
+namespace {
+
+template <DataType Type>
+constexpr bool
+IsSpillableType() {
+    return Type != DataType::NONE && Type != DataType::ROW &&
+           Type != DataType::JSON && Type != DataType::ARRAY;
+}
+
+template <DataType Type>
+std::shared_ptr<arrow::DataType>
+ToArrowType() {
+    if constexpr (!IsSpillableType<Type>()) {
+        ThrowInfo(DataTypeInvalid,
+                  "Cannot spill complex data type:[ROW/JSON/ARRAY] for now");
+    } else {
+        using T = typename TypeTraits<Type>::NativeType;
+        return arrow::CTypeTraits<T>::type_singleton();
+    }
+}
+
+template <DataType Type>
+std::shared_ptr<arrow::Array>
+ToArrowArray(const ColumnVectorPtr& column,
+             const std::vector<vector_size_t>& rows) {
+    if constexpr (!IsSpillableType<Type>()) {
+        ThrowInfo(DataTypeInvalid,
+                  "Cannot spill complex data type:[ROW/JSON/ARRAY] for now");
+    } else {
+        using T = typename TypeTraits<Type>::NativeType;
+        typename arrow::CTypeTraits<T>::BuilderType builder;
+        auto status = builder.Reserve(rows.size());
+        AssertInfo(status.ok(), status.ToString());
+        for (auto row : rows) {
+            status = column->ValidAt(row)
+                         ? builder.Append(column->ValueAt<T>(row))
+                         : builder.AppendNull();
+            AssertInfo(status.ok(), status.ToString());
+        }
+        std::shared_ptr<arrow::Array> array;
+        status = builder.Finish(&array);
+        AssertInfo(status.ok(), status.ToString());
+        return array;
+    }
+}
+
+template <DataType Type>
+VectorPtr
+FromArrowArray(const std::shared_ptr<arrow::Array>& array) {
+    if constexpr (!IsSpillableType<Type>()) {
+        ThrowInfo(DataTypeInvalid,
+                  "Cannot spill complex data type:[ROW/JSON/ARRAY] for now");
+    } else {
+        using T = typename TypeTraits<Type>::NativeType;
+        using ArrayType = typename arrow::CTypeTraits<T>::ArrayType;
+        auto typed = std::static_pointer_cast<ArrayType>(array);
+        auto column = std::make_shared<ColumnVector>(Type, array->length());
+        for (int64_t i = 0; i < array->length(); i++) {
+            if (typed->IsNull(i)) {
+                column->nullAt(i);
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                column->SetValueAt<T>(i, typed->GetString(i));
+            } else {
+                column->SetValueAt<T>(i, typed->Value(i));
+            }
+        }
+        return column;
+    }
+}
+
+template <DataType Type>
+VectorPtr
+GatherColumn(const ColumnVectorPtr& column,
+             const std::vector<vector_size_t>& rows) {
+    if constexpr (!IsSpillableType<Type>()) {
+        ThrowInfo(DataTypeInvalid,
+                  "Cannot gather complex data type:[ROW/JSON/ARRAY] for now");
+    } else {
+        using T = typename TypeTraits<Type>::NativeType;
+        auto result = std::make_shared<ColumnVector>(Type, rows.size());
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (column->ValidAt(rows[i])) {
+                result->SetValueAt<T>(i, column->ValueAt<T>(rows[i]));
+            } else {
+                result->nullAt(i);
+            }
+        }
+        return result;
+    }
+}
+
+ColumnVectorPtr
+AsColumn(const VectorPtr& vector) {
+    auto column = std::dynamic_pointer_cast<ColumnVector>(vector);
+    AssertInfo(column != nullptr && !column->IsBitmap(),
+               "Only scalar column vectors can be spilled");
+    return column;
+}
+
+}  // namespace
+
+std::string
+DefaultSpillDirectory() {
+    auto lcm = storage::LocalChunkManagerSingleton::GetInstance()
+                   .GetChunkManager();
+    std::filesystem::path root = lcm != nullptr
+                                     ? std::filesystem::path(lcm->GetRootPath())
+                                     : std::filesystem::temp_directory_path();
+    return (root / "agg_spill").string();
+}
+
+RowVectorPtr
+GatherRows(const RowVectorPtr& input, const std::vector<vector_size_t>& rows) {
+    std::vector<VectorPtr> children;
+    children.reserve(input->childrens().size());
+    for (const auto& child : input->childrens()) {
+        auto column = AsColumn(child);
+        children.emplace_back(MILVUS_DYNAMIC_TYPE_DISPATCH(
+            GatherColumn, column->type(), column, rows));
+    }
+    return std::make_shared<RowVector>(std::move(children));
+}
+
+Spiller::Spiller(const SpillConfig& config,
+                 std::vector<DataType> types,
+                 int32_t start_bit)
+    : config_(config),
+      types_(std::move(types)),
+      start_bit_(start_bit),
+      prefix_([&]() {
+          static std::atomic<uint64_t> next_id{0};
+          return fmt::format("{}/{}_{}_{}",
+                             config.directory,
+                             getpid(),
+                             next_id.fetch_add(1),
+                             start_bit);
+      }()) {
+    AssertInfo(config_.num_partition_bits > 0 &&
+                   start_bit_ + config_.num_partition_bits <= 64,
+               "invalid spill partition bits, start_bit:{}, num_bits:{}",
+               start_bit_,
+               config_.num_partition_bits);
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    fields.reserve(types_.size());
+    for (size_t i = 0; i < types_.size(); i++) {
+        fields.emplace_back(arrow::field(
+            fmt::format("c{}", i),
+            MILVUS_DYNAMIC_TYPE_DISPATCH(ToArrowType, types_[i])));
+    }
+    schema_ = arrow::schema(std::move(fields));
+    partitions_.resize(1 << config_.num_partition_bits);
+    partition_rows_.resize(partitions_.size());
+    std::error_code ec;
+    std::filesystem::create_directories(config_.directory, ec);
+    if (ec) {
+        ThrowInfo(FileCreateFailed,
+                  "failed to create spill directory {}: {}",
+                  config_.directory,
+                  ec.message());
+    }
+}
+
+Spiller::~Spiller() {
+    if (finished_) {
+        return;
+    }
+    for (auto& partition : partitions_) {
+        if (partition.writer != nullptr) {
+            auto status = partition.writer->Close();
+            (void)status;
+            status = partition.file->Close();
+            (void)status;
+            std::error_code ec;
+            std::filesystem::remove(partition.path, ec);
+        }
+    }
+}
+
+void
+Spiller::open(Partition& partition, int32_t index) {
+    partition.path = fmt::format("{}_{}.arrow", prefix_, index);
+    auto file = arrow::io::FileOutputStream::Open(partition.path);
+    if (!file.ok()) {
+        ThrowInfo(FileOpenFailed,
+                  "failed to open spill file {}: {}",
+                  partition.path,
+                  file.status().ToString());
+    }
+    partition.file = file.ValueUnsafe();
+    auto writer = arrow::ipc::MakeStreamWriter(partition.file, schema_);
+    AssertInfo(writer.ok(), writer.status().ToString());
+    partition.writer = writer.ValueUnsafe();
+}
+
+void
+Spiller::close(Partition& partition) {
+    auto status = partition.writer->Close();
+    if (status.ok()) {
+        status = partition.file->Close();
+    }
+    if (!status.ok()) {
+        ThrowInfo(FileWriteFailed,
+                  "failed to close spill file {}: {}",
+                  partition.path,
+                  status.ToString());
+    }
+}
+
+void
+Spiller::spill(const RowVectorPtr& input,
+               const std::vector<uint64_t>& hashes,
+               const std::vector<vector_size_t>& rows) {
+    AssertInfo(!finished_, "spiller has been finished");
+    AssertInfo(input->childrens().size() == types_.size(),
+               "spilled input has {} columns, expected {}",
+               input->childrens().size(),
+               types_.size());
+    const uint64_t mask = partitions_.size() - 1;
+    for (auto& partition_rows : partition_rows_) {
+        partition_rows.clear();
+    }
+    for (auto row : rows) {
+        partition_rows_[(hashes[row] >> start_bit_) & mask].push_back(row);
+    }
+
+    for (size_t i = 0; i < partitions_.size(); i++) {
+        const auto& partition_rows = partition_rows_[i];
+        if (partition_rows.empty()) {
+            continue;
+        }
+        auto& partition = partitions_[i];
+        if (partition.writer == nullptr) {
+            open(partition, i);
+        }
+        std::vector<std::shared_ptr<arrow::Array>> arrays;
+        arrays.reserve(types_.size());
+        for (size_t col = 0; col < types_.size(); col++) {
+            auto column = AsColumn(input->child(col));
+            arrays.emplace_back(MILVUS_DYNAMIC_TYPE_DISPATCH(
+                ToArrowArray, types_[col], column, partition_rows));
+        }
+        auto batch = arrow::RecordBatch::Make(
+            schema_, partition_rows.size(), std::move(arrays));
+        auto status = partition.writer->WriteRecordBatch(*batch);
+        if (!status.ok()) {
+            ThrowInfo(FileWriteFailed,
+                      "failed to write spill file {}: {}",
+                      partition.path,
+                      status.ToString());
+        }
+        partition.num_rows += partition_rows.size();
+        spilled_rows_ += partition_rows.size();
+    }
+}
+
+std::vector<SpillPartition>
+Spiller::finish() {
+    AssertInfo(!finished_, "spiller has been finished");
+    std::vector<SpillPartition> result;
+    for (auto& partition : partitions_) {
+        if (partition.writer == nullptr) {
+            continue;
+        }
+        close(partition);
+        std::error_code ec;
+        auto size = std::filesystem::file_size(partition.path, ec);
+        if (!ec) {
+            spilled_bytes_ += size;
+        }
+        result.push_back({partition.path, start_bit_, partition.num_rows});
+    }
+    finished_ = true;
+    partitions_.clear();
+    LOG_INFO("spilled {} rows ({} bytes) into {} partitions at bit {}",
+             spilled_rows_,
+             spilled_bytes_,
+             result.size(),
+             start_bit_);
+    return result;
+}
+
+SpillPartitionReader::SpillPartitionReader(SpillPartition partition,
+                                           std::vector<DataType> types)
+    : partition_(std::move(partition)), types_(std::move(types)) {
+    auto file = arrow::io::ReadableFile::Open(partition_.path);
+    if (!file.ok()) {
+        ThrowInfo(FileOpenFailed,
+                  "failed to open spill file {}: {}",
+                  partition_.path,
+                  file.status().ToString());
+    }
+    auto reader =
+        arrow::ipc::RecordBatchStreamReader::Open(file.ValueUnsafe());
+    if (!reader.ok()) {
+        ThrowInfo(FileReadFailed,
+                  "failed to read spill file {}: {}",
+                  partition_.path,
+                  reader.status().ToString());
+    }
+    reader_ = reader.ValueUnsafe();
+}
+
+SpillPartitionReader::~SpillPartitionReader() {
+    reader_.reset();
+    RemoveSpillFiles({partition_});
+}
+
+RowVectorPtr
+SpillPartitionReader::next() {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    auto status = reader_->ReadNext(&batch);
+    if (!status.ok()) {
+        ThrowInfo(FileReadFailed,
+                  "failed to read spill file {}: {}",
+                  partition_.path,
+                  status.ToString());
+    }
+    if (batch == nullptr) {
+        return nullptr;
+    }
+    AssertInfo(static_cast<size_t>(batch->num_columns()) == types_.size(),
+               "spilled batch has {} columns, expected {}",
+               batch->num_columns(),
+               types_.size());
+    std::vector<VectorPtr> children;
+    children.reserve(types_.size());
+    for (size_t i = 0; i < types_.size(); i++) {
+        children.emplace_back(MILVUS_DYNAMIC_TYPE_DISPATCH(
+            FromArrowArray, types_[i], batch->column(i)));
+    }
+    return std::make_shared<RowVector>(std::move(children));
+}
+
+void
+RemoveSpillFiles(const std::vector<SpillPartition>& partitions) {
+    for (const auto& partition : partitions) {
+        std::error_code ec;
+        std::filesystem::remove(partition.path, ec);
+        if (ec) {
+            LOG_WARN("failed to remove spill file {}: {}",
+                     partition.path,
+                     ec.message());
+        }
+    }
+}
+
+}  // namespace exec
+}  // namespace milvus
@@ -0,0 +1,164 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/io/type_fwd.h"
+#include "arrow/ipc/type_fwd.h"
+#include "arrow/type_fwd.h"
+#include "common/Types.h"
+#include "common/Vector.h"
+
+namespace milvus {
+namespace exec {
+
+struct SpillConfig {
+    // Directory the spill files are created in.
+    std::string directory;
+
+    // Bytes of group rows plus hash table a GroupingSet may hold before it
+    // starts spilling rows of new groups. 0 disables spilling.
+    int64_t memory_limit = 0;
+
+    // Number of hash bits used to fan out one spill level.
+    int32_t num_partition_bits = 3;
+};
+
+/// One spilled hash partition: an Arrow IPC stream of raw input rows whose
+/// hashes share the same bits in [start_bit, start_bit + num_bits).
+struct SpillPartition {
+    std::string path;
+    int32_t start_bit;
+    int64_t num_rows;
+};
+
+/// Returns the default spill directory: a sub directory of the local chunk
+/// manager root path, or of the system temp directory when the local chunk
+/// manager is not initialized.
+std::string
+DefaultSpillDirectory();
+
+/// Copies the rows at 'rows' of 'input' into a new RowVector.
+RowVectorPtr
+GatherRows(const RowVectorPtr& input, const std::vector<vector_size_t>& rows);
+
+/// Writes raw input rows into 2^num_partition_bits files partitioned by hash
+/// bits. The partitions of one level use the bits right below the ones used by
+/// the level above, and none of them overlap the bits the hash table uses for
+/// bucket offsets and tags, so that a partition spreads evenly over the table
+/// when it is re-aggregated.
+class Spiller {
+ public:
+    Spiller(const SpillConfig& config,
+            std::vector<DataType> types,
+            int32_t start_bit);
+
+    ~Spiller();
+
+    /// The start bit of the partitions of the first spill level.
+    static int32_t
+    firstStartBit(int32_t num_partition_bits) {
+        return 64 - num_partition_bits;
+    }
+
+    /// Returns the start bit for the level below the one starting at
+    /// 'start_bit', or -1 if the hash has no more bits to partition by.
+    static int32_t
+    nextStartBit(int32_t start_bit, int32_t num_partition_bits) {
+        auto next = start_bit - num_partition_bits;
+        return next >= kMinStartBit ? next : -1;
+    }
+
+    /// Appends the rows at 'rows' of 'input' to the partitions picked by
+    /// 'hashes', which is indexed by row number.
+    void
+    spill(const RowVectorPtr& input,
+          const std::vector<uint64_t>& hashes,
+          const std::vector<vector_size_t>& rows);
+
+    /// Closes all files and hands over the non-empty partitions. The caller
+    /// owns the returned files afterwards.
+    std::vector<SpillPartition>
+    finish();
+
+    int64_t
+    spilledRows() const {
+        return spilled_rows_;
+    }
+
+    int64_t
+    spilledBytes() const {
+        return spilled_bytes_;
+    }
+
+ private:
+    // Bits below 45 are used by HashTable for bucket offsets and tags.
+    static constexpr int32_t kMinStartBit = 45;
+
+    struct Partition {
+        std::string path;
+        std::shared_ptr<arrow::io::FileOutputStream> file;
+        std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
+        int64_t num_rows = 0;
+    };
+
+    void
+    open(Partition& partition, int32_t index);
+
+    void
+    close(Partition& partition);
+
+    const SpillConfig config_;
+    const std::vector<DataType> types_;
+    const int32_t start_bit_;
+    const std::string prefix_;
+    std::shared_ptr<arrow::Schema> schema_;
+    std::vector<Partition> partitions_;
+    std::vector<std::vector<vector_size_t>> partition_rows_;
+    int64_t spilled_rows_ = 0;
+    int64_t spilled_bytes_ = 0;
+    bool finished_ = false;
+};
+
+/// Reads back one spilled partition batch by batch and removes the file once
+/// the reader is destroyed.
+class SpillPartitionReader {
+ public:
+    SpillPartitionReader(SpillPartition partition, std::vector<DataType> types);
+
+    ~SpillPartitionReader();
+
+    /// Returns the next spilled batch, or nullptr once the partition is
+    /// drained.
+    RowVectorPtr
+    next();
+
+ private:
+    const SpillPartition partition_;
+    const std::vector<DataType> types_;
+    std::shared_ptr<arrow::RecordBatchReader> reader_;
+};
+
+/// Removes the files of 'partitions', ignoring errors.
+void
+RemoveSpillFiles(const std::vector<SpillPartition>& partitions);
+
+}  // namespace exec
+}  // namespace milvus
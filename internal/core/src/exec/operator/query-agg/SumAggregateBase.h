@@ -58,8 +58,11 @@ class SumAggregateBase
     void
     addSingleGroupRawInput(char* group,
                            const std::vector<VectorPtr>& input) override {
-        BaseAggregate::template updateOneGroup<TAccumulator>(
-            group, input[0], &updateSingleValue<TAccumulator>);
+        BaseAggregate::template reduceOneGroup<TAccumulator>(
+            group,
+            input[0],
+            &sumRun<TAccumulator, TInput, Overflow>,
+            &updateSingleValue<TAccumulator>);
     }
 
     void
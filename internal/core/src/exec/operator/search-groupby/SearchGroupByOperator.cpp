@@ -14,6 +14,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #include "SearchGroupByOperator.h"
+
+#include <algorithm>
+
 #include "common/Consts.h"
 #include "query/Utils.h"
 #include "common/JsonUtils.h"
@@ -21,6 +24,9 @@
 namespace milvus {
 namespace exec {
 
+// iterator results a group by search fetches the group values of at once
+constexpr int64_t kMaxGroupByBatchSize = 4096;
+
 void
 SearchGroupBy(milvus::OpContext* op_ctx,
               const std::vector<std::shared_ptr<VectorIterator>>& iterators,
@@ -361,19 +367,40 @@ GroupIteratorResult(const std::shared_ptr<VectorIterator>& iterator,
     //2. do iteration until fill the whole map or run out of all data
     //note it may enumerate all data inside a segment and can block following
     //query and search possibly
+    //the group values are fetched a batch of iterator results at a time,
+    //the first batch is the fewest rows that can fill the map and the
+    //batches double from there
     std::vector<std::tuple<int64_t, float, std::optional<T>>> res;
+    std::vector<int64_t> batch_offsets;
+    std::vector<float> batch_distances;
+    std::vector<std::optional<T>> batch_values;
+    int64_t batch_size = std::clamp<int64_t>(topK, 1, kMaxGroupByBatchSize);
     while (iterator->HasNext() && !groupMap.IsGroupResEnough()) {
-        auto offset_dis_pair = iterator->Next();
-        AssertInfo(
-            offset_dis_pair.has_value(),
-            "Wrong state! iterator cannot return valid result whereas it still"
-            "tells hasNext, terminate groupBy operation");
-        auto offset = offset_dis_pair.value().first;
-        auto dis = offset_dis_pair.value().second;
-        std::optional<T> row_data = data_getter->Get(offset);
-        if (groupMap.Push(row_data)) {
-            res.emplace_back(offset, dis, row_data);
+        batch_offsets.clear();
+        batch_distances.clear();
+        while (iterator->HasNext() && batch_offsets.size() < batch_size) {
+            auto offset_dis_pair = iterator->Next();
+            AssertInfo(offset_dis_pair.has_value(),
+                       "Wrong state! iterator cannot return valid result "
+                       "whereas it still"
+                       "tells hasNext, terminate groupBy operation");
+            batch_offsets.push_back(offset_dis_pair.value().first);
+            batch_distances.push_back(offset_dis_pair.value().second);
+        }
+        batch_values.resize(batch_offsets.size());
+        data_getter->BulkGet(
+            batch_offsets.data(), batch_offsets.size(), batch_values.data());
+        for (size_t i = 0; i < batch_offsets.size(); ++i) {
+            if (groupMap.IsGroupResEnough()) {
+                break;
+            }
+            if (groupMap.Push(batch_values[i])) {
+                res.emplace_back(batch_offsets[i],
+                                 batch_distances[i],
+                                 std::move(batch_values[i]));
+            }
         }
+        batch_size = std::min(batch_size * 2, kMaxGroupByBatchSize);
     }
 
     //3. sorted based on distances and metrics
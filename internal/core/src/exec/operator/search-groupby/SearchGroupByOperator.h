@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 #include <type_traits>
+#include <vector>
 
 #include "cachinglayer/CacheSlot.h"
 #include "common/Json.h"
@@ -96,6 +98,12 @@ class DataGetter {
     virtual std::optional<T>
     Get(int64_t idx) const = 0;
 
+    // the values of count rows at once, one virtual call for the batch
+    virtual void
+    BulkGet(const int64_t* offsets,
+            int64_t count,
+            std::optional<T>* values) const = 0;
+
  protected:
     std::optional<std::string> json_path_;
     bool specific_json_type_ = false;
@@ -134,12 +142,10 @@ class GrowingDataGetter : public DataGetter<OutputType> {
             return std::nullopt;
         }
         if constexpr (std::is_same_v<InnerRawType, std::string>) {
-            if (growing_raw_data_->is_mmap()) {
-                // when scalar data is mapped, it's needed to get the scalar data view and reconstruct string from the view
-                return std::optional<std::string>(
-                    growing_raw_data_->view_element(idx));
-            }
-            return growing_raw_data_->operator[](idx);
+            // mapped or arena backed strings are held as views, so the
+            // string is rebuilt from the view of the row
+            return std::optional<std::string>(
+                growing_raw_data_->view_element(idx));
         } else if constexpr (std::is_same_v<InnerRawType, milvus::Json>) {
             auto parse_json_doc =
                 [&](milvus::Json& json_val) -> std::optional<OutputType> {
@@ -164,6 +170,15 @@ class GrowingDataGetter : public DataGetter<OutputType> {
         }
     }
 
+    void
+    BulkGet(const int64_t* offsets,
+            int64_t count,
+            std::optional<OutputType>* values) const override {
+        for (int64_t i = 0; i < count; ++i) {
+            values[i] = GrowingDataGetter::Get(offsets[i]);
+        }
+    }
+
  protected:
     const segcore::ConcurrentVector<InnerRawType>* growing_raw_data_;
     segcore::ThreadSafeValidDataPtr valid_data_;
@@ -188,6 +203,9 @@ class SealedDataGetter : public DataGetter<OutputType> {
         int64_t,
         PinWrapper<std::pair<std::vector<milvus::Json>, FixedVector<bool>>>>
         json_pw_map;
+    // pinning a chunk for every row costs more than reading the value
+    mutable std::unordered_map<int64_t, PinWrapper<Span<InnerRawType>>>
+        span_pw_map;
 
  public:
     SealedDataGetter(milvus::OpContext* op_ctx,
@@ -255,9 +273,15 @@ class SealedDataGetter : public DataGetter<OutputType> {
                     std::is_same_v<OutputType, InnerRawType>,
                     "OutputType and InnerRawType must be the same for "
                     "non-json/string field group by");
-                auto pw = segment_.chunk_data<InnerRawType>(
-                    op_ctx_, field_id_, chunk_id);
-                auto& span = pw.get();
+                auto it = span_pw_map.find(chunk_id);
+                if (it == span_pw_map.end()) {
+                    it = span_pw_map
+                             .emplace(chunk_id,
+                                      segment_.chunk_data<InnerRawType>(
+                                          op_ctx_, field_id_, chunk_id))
+                             .first;
+                }
+                auto& span = it->second.get();
                 if (span.valid_data() && !span.valid_data()[inner_offset]) {
                     return std::nullopt;
                 }
@@ -276,6 +300,15 @@ class SealedDataGetter : public DataGetter<OutputType> {
             return raw.value();
         }
     }
+
+    void
+    BulkGet(const int64_t* offsets,
+            int64_t count,
+            std::optional<OutputType>* values) const override {
+        for (int64_t i = 0; i < count; ++i) {
+            values[i] = SealedDataGetter::Get(offsets[i]);
+        }
+    }
 };
 
 template <typename OutputType, typename InnerRawType = OutputType>
@@ -339,47 +372,87 @@ GroupIteratorsByType(
     const knowhere::MetricType& metrics_type,
     std::vector<size_t>& topk_per_nq_prefix_sum);
 
+// Counts the rows kept per group. There are at most group_capacity groups,
+// so the open addressing table is sized once, never rehashes and a probe
+// stops at the latest at an empty slot; a row takes a single probe.
 template <typename T>
 struct GroupByMap {
  private:
-    std::unordered_map<std::optional<T>, int> group_map_{};
+    std::vector<T> keys_;
+    // rows kept for the key of each slot, 0 for an empty slot
+    std::vector<int> counts_;
+    size_t mask_{0};
+    int null_count_{0};
+    int group_count_{0};
     int group_capacity_{0};
     int group_size_{0};
     int enough_group_count_{0};
     bool strict_group_size_{false};
 
+    size_t
+    Probe(const T& key) const {
+        // fibonacci hashing spreads the identity hash of the integers
+        auto slot = (std::hash<T>{}(key) * 0x9E3779B97F4A7C15ULL) >> 32;
+        while (true) {
+            slot &= mask_;
+            if (counts_[slot] == 0 || keys_[slot] == key) {
+                return slot;
+            }
+            ++slot;
+        }
+    }
+
  public:
     GroupByMap(int group_capacity,
                int group_size,
                bool strict_group_size = false)
         : group_capacity_(group_capacity),
           group_size_(group_size),
-          strict_group_size_(strict_group_size){};
+          strict_group_size_(strict_group_size) {
+        size_t num_slots = 2;
+        while (num_slots < 2 * static_cast<size_t>(group_capacity_)) {
+            num_slots <<= 1;
+        }
+        keys_.resize(num_slots);
+        counts_.resize(num_slots, 0);
+        mask_ = num_slots - 1;
+    };
     bool
     IsGroupResEnough() {
         bool enough = false;
         if (strict_group_size_) {
-            enough = group_map_.size() == group_capacity_ &&
+            enough = group_count_ == group_capacity_ &&
                      enough_group_count_ == group_capacity_;
         } else {
-            enough = group_map_.size() == group_capacity_;
+            enough = group_count_ == group_capacity_;
         }
         return enough;
     }
     bool
     Push(const std::optional<T>& t) {
-        if (group_map_.size() >= group_capacity_ &&
-            group_map_.find(t) == group_map_.end()) {
-            return false;
+        size_t slot = 0;
+        int* count = &null_count_;
+        if (t.has_value()) {
+            slot = Probe(t.value());
+            count = &counts_[slot];
+        }
+        if (*count == 0) {
+            if (group_count_ >= group_capacity_) {
+                return false;
+            }
+            if (t.has_value()) {
+                keys_[slot] = t.value();
+            }
+            ++group_count_;
         }
-        if (group_map_[t] >= group_size_) {
+        if (*count >= group_size_) {
             //we ignore following input no matter the distance as knowhere::iterator doesn't guarantee
             //strictly increase/decreasing distance output
             //but this should not be a very serious influence to overall recall rate
             return false;
         }
-        group_map_[t] += 1;
-        if (group_map_[t] >= group_size_) {
+        *count += 1;
+        if (*count >= group_size_) {
             enough_group_count_ += 1;
         }
         return true;
@@ -387,7 +460,7 @@ struct GroupByMap {
 
     int
     GetGroupCount() const {
-        return group_map_.size();
+        return group_count_;
     }
 
     int
@@ -0,0 +1,101 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+
+#include "exec/operator/search-groupby/SearchGroupByOperator.h"
+
+using namespace milvus;
+using namespace milvus::exec;
+
+namespace {
+
+// GroupByMap::Push as it was over a std::map
+template <typename T>
+class ReferenceGroupByMap {
+ public:
+    ReferenceGroupByMap(int group_capacity, int group_size)
+        : group_capacity_(group_capacity), group_size_(group_size) {
+    }
+
+    bool
+    Push(const std::optional<T>& t) {
+        if (GroupCount() >= group_capacity_ &&
+            groups_.find(t) == groups_.end()) {
+            return false;
+        }
+        if (groups_[t] >= group_size_) {
+            return false;
+        }
+        groups_[t] += 1;
+        enough_group_count_ += groups_[t] >= group_size_;
+        return true;
+    }
+
+    int
+    GroupCount() const {
+        return groups_.size();
+    }
+
+    std::map<std::optional<T>, int> groups_;
+    int group_capacity_;
+    int group_size_;
+    int enough_group_count_{0};
+};
+
+template <typename T, typename Gen>
+void
+CheckMatchesReference(Gen gen) {
+    std::mt19937 rng(42);
+    for (int group_capacity : {1, 3, 10, 100}) {
+        for (int group_size : {1, 2, 5}) {
+            for (bool strict : {false, true}) {
+                GroupByMap<T> map(group_capacity, group_size, strict);
+                ReferenceGroupByMap<T> reference(group_capacity, group_size);
+                for (int i = 0; i < 2000; ++i) {
+                    std::optional<T> key;
+                    if (rng() % 10 != 0) {
+                        key = gen(rng);
+                    }
+                    ASSERT_EQ(map.Push(key), reference.Push(key));
+                    ASSERT_EQ(map.GetGroupCount(), reference.GroupCount());
+                    ASSERT_EQ(map.GetEnoughGroupCount(),
+                              reference.enough_group_count_);
+                }
+                EXPECT_EQ(map.IsGroupResEnough(),
+                          (strict ? reference.enough_group_count_
+                                  : reference.GroupCount()) == group_capacity);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(SearchGroupByTest, GroupByMapMatchesReference) {
+    CheckMatchesReference<int64_t>(
+        [](std::mt19937& rng) { return static_cast<int64_t>(rng() % 300); });
+    // keys sharing their low bits
+    CheckMatchesReference<int64_t>([](std::mt19937& rng) {
+        return static_cast<int64_t>(rng() % 300) << 32;
+    });
+    CheckMatchesReference<int8_t>(
+        [](std::mt19937& rng) { return static_cast<int8_t>(rng()); });
+    CheckMatchesReference<bool>(
+        [](std::mt19937& rng) { return rng() % 2 == 0; });
+    CheckMatchesReference<std::string>([](std::mt19937& rng) {
+        return std::string(rng() % 40, 'a' + rng() % 5);
+    });
+}
@@ -18,6 +18,7 @@
 
 #include <fmt/core.h>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -247,6 +248,14 @@ class ITypeExpr {
     virtual void
     GatherInfo(ExprInfo& info) const {};
 
+    // collects the fields the expression reads, its inputs included
+    virtual void
+    GatherFields(std::set<FieldId>& fields) const {
+        for (const auto& input : inputs_) {
+            input->GatherFields(fields);
+        }
+    }
+
  protected:
     DataType type_;
     std::vector<std::shared_ptr<const ITypeExpr>> inputs_;
@@ -304,6 +313,11 @@ class FieldAccessTypeExpr : public ITypeExpr {
         return name_;
     }
 
+    FieldId
+    field_id() const {
+        return field_id_;
+    }
+
     std::string
     ToString() const override {
         if (inputs_.empty()) {
@@ -349,6 +363,12 @@ class ColumnExpr : public ITypeExpr {
         return column_;
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::stringstream ss;
@@ -418,6 +438,12 @@ class UnaryRangeFilterExpr : public ITypeFilterExpr {
           extra_values_(extra_values) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::stringstream ss;
@@ -490,6 +516,12 @@ class ExistsExpr : public ITypeFilterExpr {
         : ITypeFilterExpr(), column_(column) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         return "{Exists Expression - Column: " + column_.ToString() + "}";
@@ -548,6 +580,12 @@ class TermFilterExpr : public ITypeFilterExpr {
           is_in_field_(is_in_field) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::string values;
@@ -646,6 +684,12 @@ class BinaryRangeFilterExpr : public ITypeFilterExpr {
           upper_inclusive_(upper_inclusive) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::stringstream ss;
@@ -688,6 +732,12 @@ class BinaryArithOpEvalRangeExpr : public ITypeFilterExpr {
           value_(value) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::stringstream ss;
@@ -723,6 +773,12 @@ class TimestamptzArithCompareExpr : public ITypeFilterExpr {
           compare_value_(compare_value) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::stringstream ss;
@@ -748,6 +804,12 @@ class NullExpr : public ITypeFilterExpr {
         : ITypeFilterExpr(), column_(column), op_(op) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         return fmt::format("NullExpr:[Column: {}, Operator: {} ",
@@ -814,6 +876,12 @@ class CompareExpr : public ITypeFilterExpr {
           op_type_(op_type) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(left_field_id_);
+        fields.insert(right_field_id_);
+    }
+
     std::string
     ToString() const override {
         std::string opTypeString;
@@ -848,6 +916,12 @@ class GISFunctionFilterExpr : public ITypeFilterExpr {
           op_(op),
           geometry_wkt_(geometry_wkt),
           distance_(distance){};
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         if (op_ == proto::plan::GISFunctionFilterExpr_GISOp_DWithin) {
@@ -887,6 +961,12 @@ class JsonContainsExpr : public ITypeFilterExpr {
           vals_(std::move(vals)) {
     }
 
+    void
+    GatherFields(std::set<FieldId>& fields) const override {
+        fields.insert(column_.field_id_);
+        ITypeExpr::GatherFields(fields);
+    }
+
     std::string
     ToString() const override {
         std::string values;
@@ -0,0 +1,104 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "CompletionQueue.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include "common/EasyAssert.h"
+
+namespace milvus::futures {
+
+CompletionQueue::CompletionQueue() {
+#ifdef __linux__
+    read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    AssertInfo(read_fd_ >= 0,
+               "failed to create the eventfd of a completion queue: {}",
+               strerror(errno));
+    write_fd_ = read_fd_;
+#else
+    int fds[2];
+    AssertInfo(pipe(fds) == 0,
+               "failed to create the pipe of a completion queue: {}",
+               strerror(errno));
+    for (auto fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+#endif
+}
+
+CompletionQueue::~CompletionQueue() {
+    close(read_fd_);
+    if (write_fd_ != read_fd_) {
+        close(write_fd_);
+    }
+}
+
+void
+CompletionQueue::post(uint64_t id) {
+    queue_.enqueue(id);
+    // only the post finding nothing left to drain signals, the drainer
+    // takes the ids posted meanwhile along
+    if (pending_.fetch_add(1) <= 0) {
+        signal();
+    }
+}
+
+int64_t
+CompletionQueue::drain(uint64_t* ids, int64_t max) {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    clearSignal();
+    int64_t n = 0;
+    while (n < max && queue_.try_dequeue(ids[n])) {
+        ++n;
+    }
+    // the posts of the ids left did not signal, as they found ids to drain
+    if (pending_.fetch_sub(n) - n > 0) {
+        signal();
+    }
+    return n;
+}
+
+void
+CompletionQueue::signal() {
+#ifdef __linux__
+    uint64_t one = 1;
+#else
+    char one = 1;
+#endif
+    // a full counter or pipe is readable already
+    auto ret = write(write_fd_, &one, sizeof(one));
+    (void)ret;
+}
+
+void
+CompletionQueue::clearSignal() {
+#ifdef __linux__
+    uint64_t count;
+    auto ret = read(read_fd_, &count, sizeof(count));
+    (void)ret;
+#else
+    char buf[64];
+    while (read(read_fd_, buf, sizeof(buf)) > 0) {
+    }
+#endif
+}
+
+};  // namespace milvus::futures
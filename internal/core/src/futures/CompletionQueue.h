@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <folly/concurrency/UnboundedQueue.h>
+
+namespace milvus::futures {
+
+/// @brief CompletionQueue collects the ids of ready futures, so the cgo
+/// caller waits on one file descriptor and drains many completions per
+/// call instead of waiting on every future.
+/// Futures post from any thread into a lock-free queue. The descriptor
+/// turns readable when a completion is posted to an empty queue, and stays
+/// readable while completions are left after a drain.
+class CompletionQueue {
+ public:
+    CompletionQueue();
+
+    CompletionQueue(const CompletionQueue&) = delete;
+
+    CompletionQueue&
+    operator=(const CompletionQueue&) = delete;
+
+    ~CompletionQueue();
+
+    /// @brief the descriptor to poll for readability, an eventfd on linux.
+    int
+    fd() const {
+        return read_fd_;
+    }
+
+    /// @brief post the id of a ready future.
+    void
+    post(uint64_t id);
+
+    /// @brief move up to max posted ids into ids, the oldest first.
+    /// Drains are serialized, one drain runs at a time.
+    /// @return the number of ids moved.
+    int64_t
+    drain(uint64_t* ids, int64_t max);
+
+ private:
+    void
+    signal();
+
+    void
+    clearSignal();
+
+    folly::UMPSCQueue<uint64_t, false> queue_;
+    // the ids posted and not drained yet, below zero while a drain has taken
+    // ids whose posts are not counted yet
+    std::atomic<int64_t> pending_{0};
+    std::mutex drain_mutex_;
+    int read_fd_{-1};
+    int write_fd_{-1};
+};
+
+};  // namespace milvus::futures
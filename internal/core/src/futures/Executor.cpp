@@ -9,9 +9,22 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <atomic>
 #include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <folly/executors/thread_factory/InitThreadFactory.h>
+#include <folly/hash/Hash.h>
+
 #include "Executor.h"
 #include "common/Common.h"
+#include "log/Log.h"
 #include "monitor/Monitor.h"
 
 namespace milvus::futures {
@@ -28,4 +41,158 @@ getGlobalCPUExecutor() {
     return &executor;
 }
 
+namespace {
+
+std::atomic<bool> segment_affinity_enabled{false};
+
+// the pools of the L3 cache domains, their threads pinned to the cores of
+// the domain; none on a machine of a single domain
+const std::vector<std::unique_ptr<folly::CPUThreadPoolExecutor>>&
+getDomainExecutors() {
+    static auto executors = []() {
+        std::vector<std::unique_ptr<folly::CPUThreadPoolExecutor>> executors;
+        auto domains = getL3CacheDomains();
+        if (domains.size() <= 1) {
+            LOG_INFO("segment affinity needs more than one L3 cache, {} found",
+                     domains.size());
+            return executors;
+        }
+        for (size_t i = 0; i < domains.size(); ++i) {
+            auto cpus = domains[i];
+            auto factory = std::make_shared<folly::InitThreadFactory>(
+                std::make_shared<folly::NamedThreadFactory>(
+                    "MILVUS_L3_" + std::to_string(i) + "_"),
+                [cpus]() {
+                    cpu_set_t set;
+                    CPU_ZERO(&set);
+                    for (auto cpu : cpus) {
+                        CPU_SET(cpu, &set);
+                    }
+                    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+                });
+            executors.push_back(std::make_unique<folly::CPUThreadPoolExecutor>(
+                cpus.size(),
+                folly::CPUThreadPoolExecutor::makeDefaultPriorityQueue(
+                    kNumPriority),
+                std::move(factory)));
+            LOG_INFO("segment affinity pool {} of {} cpus", i, cpus.size());
+        }
+        return executors;
+    }();
+    return executors;
+}
+
+}  // namespace
+
+std::vector<std::vector<int>>
+getL3CacheDomains() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    bool restricted = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    auto num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+
+    std::vector<int> all;
+    // the cpus of a domain by the shared_cpu_list of its cache
+    std::map<std::string, std::vector<int>> domains;
+    for (int cpu = 0; cpu < num_cpus && cpu < CPU_SETSIZE; ++cpu) {
+        if (restricted && !CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        all.push_back(cpu);
+        auto dir =
+            "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/";
+        for (int index = 0;; ++index) {
+            auto cache = dir + "index" + std::to_string(index);
+            std::ifstream level_file(cache + "/level");
+            int level;
+            if (!(level_file >> level)) {
+                break;
+            }
+            std::ifstream shared_file(cache + "/shared_cpu_list");
+            std::string shared;
+            if (level == 3 && shared_file >> shared) {
+                domains[shared].push_back(cpu);
+                break;
+            }
+        }
+    }
+
+    size_t found = 0;
+    for (auto& [_, cpus] : domains) {
+        found += cpus.size();
+    }
+    if (all.empty()) {
+        return {};
+    }
+    if (found != all.size()) {
+        return {all};
+    }
+    std::vector<std::vector<int>> result;
+    for (auto& [_, cpus] : domains) {
+        result.push_back(std::move(cpus));
+    }
+    return result;
+}
+
+void
+setSegmentAffinityEnabled(bool enabled) {
+    segment_affinity_enabled.store(enabled);
+    LOG_INFO("set segment affinity enabled: {}", enabled);
+}
+
+folly::CPUThreadPoolExecutor*
+getSegmentCPUExecutor(int64_t segment_id) {
+    if (!segment_affinity_enabled.load()) {
+        return getGlobalCPUExecutor();
+    }
+    auto& executors = getDomainExecutors();
+    if (executors.empty()) {
+        return getGlobalCPUExecutor();
+    }
+    std::vector<size_t> pending(executors.size());
+    std::vector<size_t> threads(executors.size());
+    for (size_t i = 0; i < executors.size(); ++i) {
+        pending[i] = executors[i]->getPendingTaskCount();
+        threads[i] = executors[i]->numThreads();
+    }
+    auto domain = pickSegmentDomain(segment_id, pending, threads);
+    auto home = segmentDomain(segment_id, executors.size());
+    if (domain == static_cast<size_t>(home)) {
+        monitor::internal_core_segment_affinity_count_local.Increment();
+    } else {
+        monitor::internal_core_segment_affinity_count_spill.Increment();
+    }
+    return executors[domain].get();
+}
+
+int
+segmentDomain(int64_t segment_id, int num_domains) {
+    // the segment ids are allocated in sequence, mixed before the jump
+    uint64_t key = folly::hash::twang_mix64(static_cast<uint64_t>(segment_id));
+    int64_t domain = -1;
+    int64_t next = 0;
+    while (next < num_domains) {
+        domain = next;
+        key = key * 2862933555777941757ULL + 1;
+        next = static_cast<int64_t>((domain + 1) *
+                                    (static_cast<double>(1LL << 31) /
+                                     static_cast<double>((key >> 33) + 1)));
+    }
+    return static_cast<int>(domain);
+}
+
+size_t
+pickSegmentDomain(int64_t segment_id,
+                  const std::vector<size_t>& pending,
+                  const std::vector<size_t>& threads) {
+    auto home = static_cast<size_t>(segmentDomain(segment_id, pending.size()));
+    auto least = home;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i] < pending[least]) {
+            least = i;
+        }
+    }
+    return pending[home] > pending[least] + threads[home] ? least : home;
+}
+
 };  // namespace milvus::futures
\ No newline at end of file
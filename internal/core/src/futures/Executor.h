@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/task_queue/PriorityLifoSemMPMCQueue.h>
 #include <folly/system/HardwareConcurrency.h>
@@ -27,4 +29,35 @@ const int HIGH = 0;
 folly::CPUThreadPoolExecutor*
 getGlobalCPUExecutor();
 
+// The cpus of each L3 cache of the machine the process may run on, read
+// from sysfs. A single domain of all cpus if the caches are not reported.
+std::vector<std::vector<int>>
+getL3CacheDomains();
+
+// Turns routing the work of a segment to the cores of an L3 cache on or
+// off, off by default.
+void
+setSegmentAffinityEnabled(bool enabled);
+
+// The executor for the work of a segment. With segment affinity on and
+// more than one L3 cache, it is the pool of the cores of the cache the
+// segment id hashes to, so the repeated queries of a segment find its
+// index and pks warm in that cache. Otherwise it is the global executor.
+folly::CPUThreadPoolExecutor*
+getSegmentCPUExecutor(int64_t segment_id);
+
+// The domain of a segment among num_domains by jump consistent hash: a
+// change of the count only moves the segments it has to.
+int
+segmentDomain(int64_t segment_id, int num_domains);
+
+// The domain to run the work of a segment given the tasks pending and the
+// threads of every domain. It is the domain of the segment unless that one
+// has a backlog of more than its threads over the least busy domain, which
+// then takes the work.
+size_t
+pickSegmentDomain(int64_t segment_id,
+                  const std::vector<size_t>& pending,
+                  const std::vector<size_t>& threads);
+
 };  // namespace milvus::futures
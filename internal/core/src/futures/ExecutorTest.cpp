@@ -0,0 +1,68 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include "futures/Executor.h"
+#include <set>
+#include <vector>
+
+using namespace milvus::futures;
+
+TEST(Executor, SegmentDomain) {
+    constexpr int kSegments = 10000;
+    std::vector<int> counts(4);
+    for (int64_t segment_id = 0; segment_id < kSegments; ++segment_id) {
+        auto domain = segmentDomain(segment_id, 4);
+        ASSERT_GE(domain, 0);
+        ASSERT_LT(domain, 4);
+        ++counts[domain];
+        // a segment stays on its domain, or moves to the one added
+        auto grown = segmentDomain(segment_id, 5);
+        EXPECT_TRUE(grown == domain || grown == 4);
+        EXPECT_EQ(segmentDomain(segment_id, 1), 0);
+    }
+    for (auto count : counts) {
+        EXPECT_GT(count, kSegments / 4 * 0.9);
+        EXPECT_LT(count, kSegments / 4 * 1.1);
+    }
+}
+
+TEST(Executor, PickSegmentDomain) {
+    int64_t segment_id = 42;
+    auto home = static_cast<size_t>(segmentDomain(segment_id, 2));
+    auto other = 1 - home;
+    std::vector<size_t> threads{8, 8};
+    std::vector<size_t> pending(2);
+
+    pending[home] = 8;
+    pending[other] = 0;
+    EXPECT_EQ(pickSegmentDomain(segment_id, pending, threads), home);
+    // a backlog above the threads of the domain spills to the other one
+    pending[home] = 9;
+    EXPECT_EQ(pickSegmentDomain(segment_id, pending, threads), other);
+    pending[other] = 4;
+    EXPECT_EQ(pickSegmentDomain(segment_id, pending, threads), home);
+}
+
+TEST(Executor, L3CacheDomains) {
+    std::set<int> cpus;
+    for (auto& domain : getL3CacheDomains()) {
+        EXPECT_FALSE(domain.empty());
+        for (auto cpu : domain) {
+            EXPECT_TRUE(cpus.insert(cpu).second);
+        }
+    }
+    EXPECT_FALSE(cpus.empty());
+
+    // off, the work of every segment runs on the global executor
+    setSegmentAffinityEnabled(false);
+    EXPECT_EQ(getSegmentCPUExecutor(1), getGlobalCPUExecutor());
+}
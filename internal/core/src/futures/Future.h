@@ -14,14 +14,20 @@
 #include <stdlib.h>
 #include <common/EasyAssert.h>
 #include <folly/CancellationToken.h>
+#include <folly/executors/InlineExecutor.h>
 #include <folly/futures/Future.h>
 #include <folly/futures/SharedPromise.h>
 #include "future_c_types.h"
+#include "CompletionQueue.h"
+#include "Executor.h"
 #include "LeakyResult.h"
 #include "Ready.h"
 #include "pb/cgo_msg.pb.h"
 #include <chrono>
+#include <optional>
 #include "monitor/Monitor.h"
+#include "monitor/PerfCounters.h"
+#include "monitor/jemalloc_arena.h"
 
 namespace milvus::futures {
 
@@ -45,11 +51,16 @@ class Metrics {
         operator=(const ExecutionGuard&&) = delete;
 
         ~ExecutionGuard() {
+            if (perf_scope_.sampled()) {
+                milvus::monitor::ObserveCgoPerfCounters(perf_scope_.Elapsed());
+            }
             metrics_.executeDone();
         }
 
      private:
         Metrics& metrics_;
+        // samples the hardware events of the task, and of its operators
+        milvus::monitor::PerfCounters::SampleScope perf_scope_;
     };
 
     explicit Metrics()
@@ -148,6 +159,11 @@ class IFuture {
     virtual void
     registerReadyCallback(CUnlockGoMutexFn unlockFn, CLockedGoMutex* mutex) = 0;
 
+    /// @brief post id into queue when the future is ready or has been ready.
+    /// the queue must outlive the future.
+    virtual void
+    registerCompletion(CompletionQueue* queue, uint64_t id) = 0;
+
     /// @brief get the result of the future. it must be called if future is ready.
     /// the first element of the pair is the result,
     /// the second element of the pair is the exception.
@@ -173,6 +189,26 @@ throwIfCancelled(const folly::CancellationToken& token) {
     }
 }
 
+using Deadline = std::chrono::steady_clock::time_point;
+
+/// @brief no deadline.
+constexpr Deadline kNoDeadline = Deadline::max();
+
+/// @brief a task submitted closer than this to its deadline runs at LOW
+/// priority, behind the tasks likely to finish in time.
+constexpr std::chrono::milliseconds kNearDeadline{50};
+
+/// @brief the deadline of a request with timeout_ms milliseconds left,
+/// kNoDeadline if timeout_ms is not positive.
+static inline Deadline
+deadlineAfter(int64_t timeout_ms) {
+    if (timeout_ms <= 0) {
+        return kNoDeadline;
+    }
+    return std::chrono::steady_clock::now() +
+           std::chrono::milliseconds(timeout_ms);
+}
+
 /// @brief Future is a class that bound a future with a result for
 /// using by cgo.
 /// @tparam R is the return type of the producer function.
@@ -182,23 +218,86 @@ class Future : public IFuture {
     /// @brief do a async operation which will produce a result.
     /// fn returns pointer to R (leaked, default memory allocator) if it is success, otherwise it will throw a exception.
     /// returned result or exception will be handled by consumer side.
+    /// fn is cancelled once the deadline passes, and never starts if it has
+    /// passed already.
     template <typename Fn,
               typename = std::enable_if<
                   std::is_invocable_r_v<R*, Fn, folly::CancellationToken>>>
     static std::unique_ptr<Future<R>>
     async(folly::Executor::KeepAlive<> executor,
           int priority,
-          Fn&& fn) noexcept {
+          Fn&& fn,
+          Deadline deadline = kNoDeadline) noexcept {
         auto future = std::make_unique<Future<R>>();
         // setup the interrupt handler for the promise.
         future->setInterruptHandler();
+        if (deadline != kNoDeadline) {
+            auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= Deadline::duration::zero()) {
+                // drop the expired task without queueing it.
+                future->metrics_.withEarlyCancel();
+                future->promise_->setException(folly::FutureCancellation());
+                future->registerConsumeCallback(executor, priority);
+                return future;
+            }
+            if (left < kNearDeadline) {
+                priority = ExecutePriority::LOW;
+            }
+            future->setDeadlineTimer(left);
+        }
         // start async function.
-        future->asyncProduce(executor, priority, std::forward<Fn>(fn));
+        future->asyncProduce(
+            executor, priority, folly::makeSemiFuture(), std::forward<Fn>(fn));
         // register consume callback function.
         future->registerConsumeCallback(executor, priority);
         return future;
     }
 
+    /// @brief like `async`, but fn starts only once the future returned by
+    /// prepare is ready. prepare runs on the executor first and issues the
+    /// loads fn will wait on, no thread is held while they are in flight.
+    /// An error of prepare fails the future without running fn.
+    template <typename Prepare,
+              typename Fn,
+              typename = std::enable_if<
+                  std::is_invocable_r_v<folly::SemiFuture<folly::Unit>,
+                                        Prepare,
+                                        folly::CancellationToken> &&
+                  std::is_invocable_r_v<R*, Fn, folly::CancellationToken>>>
+    static std::unique_ptr<Future<R>>
+    asyncAfter(folly::Executor::KeepAlive<> executor,
+               int priority,
+               Prepare&& prepare,
+               Fn&& fn,
+               Deadline deadline = kNoDeadline) noexcept {
+        auto future = std::make_unique<Future<R>>();
+        future->setInterruptHandler();
+        if (deadline != kNoDeadline) {
+            auto left = deadline - std::chrono::steady_clock::now();
+            if (left <= Deadline::duration::zero()) {
+                future->metrics_.withEarlyCancel();
+                future->promise_->setException(folly::FutureCancellation());
+                future->registerConsumeCallback(executor, priority);
+                return future;
+            }
+            if (left < kNearDeadline) {
+                priority = ExecutePriority::LOW;
+            }
+            future->setDeadlineTimer(left);
+        }
+        auto prepared =
+            folly::makeSemiFuture()
+                .via(executor, priority)
+                .thenValue([prepare = std::forward<Prepare>(prepare),
+                            token = future->cancellation_source_.getToken()](
+                               folly::Unit) mutable { return prepare(token); })
+                .semi();
+        future->asyncProduce(
+            executor, priority, std::move(prepared), std::forward<Fn>(fn));
+        future->registerConsumeCallback(executor, priority);
+        return future;
+    }
+
     /// use `async`.
     Future()
         : metrics_(),
@@ -217,6 +316,12 @@ class Future : public IFuture {
     Future&
     operator=(Future<R>&&) noexcept = default;
 
+    ~Future() override {
+        if (deadline_timer_.has_value() && deadline_timer_->valid()) {
+            deadline_timer_->cancel();
+        }
+    }
+
     /// @brief see `IFuture::cancel`
     void
     cancel() noexcept override {
@@ -231,6 +336,12 @@ class Future : public IFuture {
             [unlockFn = unlockFn, mutex = mutex]() { unlockFn(mutex); });
     }
 
+    /// @brief see `IFuture::registerCompletion`
+    void
+    registerCompletion(CompletionQueue* queue, uint64_t id) noexcept override {
+        ready_->callOrRegisterCallback([queue, id]() { queue->post(id); });
+    }
+
     /// @brief see `IFuture::isReady`
     bool
     isReady() noexcept override {
@@ -264,13 +375,31 @@ class Future : public IFuture {
         });
     }
 
-    /// @brief do the R produce operation in async way.
+    /// @brief cancel the async function once left has elapsed.
+    void
+    setDeadlineTimer(std::chrono::steady_clock::duration left) {
+        auto inline_executor =
+            folly::getKeepAliveToken(folly::InlineExecutor::instance());
+        deadline_timer_ =
+            folly::futures::sleep(
+                std::chrono::duration_cast<folly::HighResDuration>(left))
+                .via(std::move(inline_executor))
+                .thenValue([cancellation_source = cancellation_source_](
+                               folly::Unit) {
+                    cancellation_source.requestCancellation();
+                });
+    }
+
+    /// @brief do the R produce operation in async way, once after is ready.
     template <typename Fn,
               typename... Args,
               typename = std::enable_if<
                   std::is_invocable_r_v<R*, Fn, folly::CancellationToken>>>
     void
-    asyncProduce(folly::Executor::KeepAlive<> executor, int priority, Fn&& fn) {
+    asyncProduce(folly::Executor::KeepAlive<> executor,
+                 int priority,
+                 folly::SemiFuture<folly::Unit> after,
+                 Fn&& fn) {
         // start produce process async.
         auto cancellation_token = cancellation_source_.getToken();
         auto runner = [fn = std::forward<Fn>(fn),
@@ -285,6 +414,9 @@ class Future : public IFuture {
             // start the execution guard.
             Metrics<std::chrono::microseconds>::ExecutionGuard executionGuard(
                 metrics_);
+            // the futures run the queries
+            milvus::monitor::BindThreadToArena(
+                milvus::monitor::JemallocArena::kQuery);
 
             try {
                 return fn(cancellation_token);
@@ -299,8 +431,14 @@ class Future : public IFuture {
         // the runner is executed may be executed in different thread.
         // so manage the promise with shared_ptr.
         auto thenRunner = [promise = promise_, runner = std::move(runner)](
-                              auto&&) { promise->setWith(std::move(runner)); };
-        folly::makeSemiFuture().via(executor, priority).then(thenRunner);
+                              folly::Try<folly::Unit>&& prepared) {
+            if (prepared.hasException()) {
+                promise->setException(std::move(prepared.exception()));
+                return;
+            }
+            promise->setWith(std::move(runner));
+        };
+        std::move(after).via(executor, priority).then(thenRunner);
     }
 
     /// @brief async consume the result of the future.
@@ -341,5 +479,7 @@ class Future : public IFuture {
     std::shared_ptr<Ready<LeakyResult<R>>> ready_;
     std::shared_ptr<folly::SharedPromise<R*>> promise_;
     folly::CancellationSource cancellation_source_;
+    // cancels the source at the deadline, if there is one.
+    std::optional<folly::Future<folly::Unit>> deadline_timer_;
 };
 };  // namespace milvus::futures
\ No newline at end of file
@@ -12,8 +12,13 @@
 #include <gtest/gtest.h>
 #include "futures/Future.h"
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include <poll.h>
 #include <stdlib.h>
+#include <set>
+#include <thread>
+#include <vector>
 #include <mutex>
+#include <atomic>
 #include <exception>
 
 using namespace milvus::futures;
@@ -208,4 +213,199 @@ TEST(Futures, Future) {
         ASSERT_EQ(s.error_code, milvus::FollyCancel);
         free((char*)(s.error_msg));
     }
-}
\ No newline at end of file
+}
+TEST(Futures, FutureDeadline) {
+    folly::CPUThreadPoolExecutor executor(2);
+    auto wait = [](milvus::futures::Future<int>& future) {
+        std::mutex mu;
+        mu.lock();
+        future.registerReadyCallback(
+            [](CLockedGoMutex* mutex) { ((std::mutex*)(mutex))->unlock(); },
+            (CLockedGoMutex*)(&mu));
+        mu.lock();
+        return future.leakyGet();
+    };
+
+    // an expired task never starts.
+    {
+        std::atomic<bool> started{false};
+        auto future = milvus::futures::Future<int>::async(
+            &executor,
+            0,
+            [&started](folly::CancellationToken token) {
+                started = true;
+                return new int(1);
+            },
+            std::chrono::steady_clock::now() - std::chrono::seconds(1));
+        auto [r, s] = wait(*future);
+        ASSERT_EQ(r, nullptr);
+        ASSERT_EQ(s.error_code, milvus::FollyCancel);
+        ASSERT_FALSE(started);
+        free((char*)(s.error_msg));
+    }
+
+    // a running task is cancelled at its deadline.
+    {
+        auto future = milvus::futures::Future<int>::async(
+            &executor,
+            0,
+            [](folly::CancellationToken token) {
+                for (int i = 0; i < 100; i++) {
+                    milvus::futures::throwIfCancelled(token);
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                }
+                return new int(1);
+            },
+            milvus::futures::deadlineAfter(200));
+        auto [r, s] = wait(*future);
+        ASSERT_EQ(r, nullptr);
+        ASSERT_EQ(s.error_code, milvus::FollyCancel);
+        free((char*)(s.error_msg));
+    }
+
+    // a task done in time keeps its result.
+    {
+        auto future = milvus::futures::Future<int>::async(
+            &executor,
+            0,
+            [](folly::CancellationToken token) { return new int(1); },
+            milvus::futures::deadlineAfter(10000));
+        auto [r, s] = wait(*future);
+        ASSERT_NE(r, nullptr);
+        ASSERT_EQ(*(int*)(r), 1);
+        delete (int*)(r);
+    }
+}
+TEST(Futures, FutureAfter) {
+    folly::CPUThreadPoolExecutor executor(1);
+    auto wait = [](milvus::futures::Future<int>& future) {
+        std::mutex mu;
+        mu.lock();
+        future.registerReadyCallback(
+            [](CLockedGoMutex* mutex) { ((std::mutex*)(mutex))->unlock(); },
+            (CLockedGoMutex*)(&mu));
+        mu.lock();
+        return future.leakyGet();
+    };
+
+    // the only thread runs other tasks while the prepared loads are pending.
+    {
+        folly::Promise<folly::Unit> load;
+        auto loaded = load.getSemiFuture();
+        auto future = milvus::futures::Future<int>::asyncAfter(
+            &executor,
+            0,
+            [&loaded](folly::CancellationToken token) {
+                return std::move(loaded);
+            },
+            [](folly::CancellationToken token) { return new int(1); });
+        auto other = milvus::futures::Future<int>::async(
+            &executor, 0, [](folly::CancellationToken token) {
+                return new int(2);
+            });
+        auto [o, os] = wait(*other);
+        ASSERT_NE(o, nullptr);
+        ASSERT_EQ(*(int*)(o), 2);
+        delete (int*)(o);
+        ASSERT_FALSE(future->isReady());
+
+        load.setValue();
+        auto [r, s] = wait(*future);
+        ASSERT_NE(r, nullptr);
+        ASSERT_EQ(*(int*)(r), 1);
+        delete (int*)(r);
+    }
+
+    // a failed prepare fails the task, which never starts.
+    {
+        std::atomic<bool> started{false};
+        auto future = milvus::futures::Future<int>::asyncAfter(
+            &executor,
+            0,
+            [](folly::CancellationToken token) {
+                return folly::makeSemiFuture<folly::Unit>(
+                    std::runtime_error("load failed"));
+            },
+            [&started](folly::CancellationToken token) {
+                started = true;
+                return new int(1);
+            });
+        auto [r, s] = wait(*future);
+        ASSERT_EQ(r, nullptr);
+        ASSERT_EQ(s.error_code, milvus::UnexpectedError);
+        ASSERT_FALSE(started);
+        free((char*)(s.error_msg));
+    }
+}
+
+TEST(Futures, CompletionQueue) {
+    CompletionQueue queue;
+    auto wait_readable = [&queue]() {
+        struct pollfd pfd = {queue.fd(), POLLIN, 0};
+        return poll(&pfd, 1, 10000) == 1;
+    };
+
+    // nothing posted, nothing to read.
+    uint64_t ids[16];
+    struct pollfd pfd = {queue.fd(), POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 0), 0);
+    ASSERT_EQ(queue.drain(ids, 16), 0);
+
+    // the posts of many threads are drained in batches.
+    const size_t threads = 4;
+    const size_t per_thread = 1000;
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < threads; t++) {
+        producers.emplace_back([&queue, t]() {
+            for (size_t i = 0; i < per_thread; i++) {
+                queue.post(t * per_thread + i);
+            }
+        });
+    }
+    std::set<uint64_t> drained;
+    while (drained.size() < threads * per_thread) {
+        ASSERT_TRUE(wait_readable());
+        int64_t n;
+        while ((n = queue.drain(ids, 16)) > 0) {
+            drained.insert(ids, ids + n);
+        }
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    ASSERT_EQ(drained.size(), threads * per_thread);
+    ASSERT_EQ(*drained.rbegin(), threads * per_thread - 1);
+    ASSERT_EQ(poll(&pfd, 1, 0), 0);
+}
+
+TEST(Futures, FutureCompletion) {
+    folly::CPUThreadPoolExecutor executor(4);
+    CompletionQueue queue;
+    const size_t count = 100;
+    std::vector<std::unique_ptr<Future<int>>> futures;
+    for (size_t i = 0; i < count; i++) {
+        futures.push_back(Future<int>::async(
+            &executor, 0, [i](folly::CancellationToken token) {
+                return new int(i);
+            }));
+        futures.back()->registerCompletion(&queue, i);
+    }
+
+    std::set<uint64_t> drained;
+    uint64_t ids[16];
+    while (drained.size() < count) {
+        struct pollfd pfd = {queue.fd(), POLLIN, 0};
+        ASSERT_EQ(poll(&pfd, 1, 10000), 1);
+        int64_t n;
+        while ((n = queue.drain(ids, 16)) > 0) {
+            for (int64_t j = 0; j < n; j++) {
+                ASSERT_TRUE(futures[ids[j]]->isReady());
+                auto [r, s] = futures[ids[j]]->leakyGet();
+                ASSERT_EQ(*(int*)(r), static_cast<int>(ids[j]));
+                delete (int*)(r);
+                drained.insert(ids[j]);
+            }
+        }
+    }
+    ASSERT_EQ(drained.size(), count);
+}
@@ -47,6 +47,43 @@ future_leak_and_get(CFuture* future, void** result) {
     return s;
 }
 
+extern "C" void
+future_register_completion(CFuture* future,
+                           CCompletionQueue* queue,
+                           uint64_t id) {
+    static_cast<milvus::futures::IFuture*>(static_cast<void*>(future))
+        ->registerCompletion(
+            static_cast<milvus::futures::CompletionQueue*>(
+                static_cast<void*>(queue)),
+            id);
+}
+
+extern "C" CCompletionQueue*
+completion_queue_create() {
+    return static_cast<CCompletionQueue*>(
+        static_cast<void*>(new milvus::futures::CompletionQueue()));
+}
+
+extern "C" int
+completion_queue_fd(CCompletionQueue* queue) {
+    return static_cast<milvus::futures::CompletionQueue*>(
+               static_cast<void*>(queue))
+        ->fd();
+}
+
+extern "C" int64_t
+completion_queue_drain(CCompletionQueue* queue, uint64_t* ids, int64_t max) {
+    return static_cast<milvus::futures::CompletionQueue*>(
+               static_cast<void*>(queue))
+        ->drain(ids, max);
+}
+
+extern "C" void
+completion_queue_destroy(CCompletionQueue* queue) {
+    delete static_cast<milvus::futures::CompletionQueue*>(
+        static_cast<void*>(queue));
+}
+
 extern "C" void
 future_destroy(CFuture* future) {
     milvus::futures::IFuture::releaseLeakedFuture(
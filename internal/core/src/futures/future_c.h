@@ -32,6 +32,28 @@ future_register_ready_callback(CFuture* future,
 CStatus
 future_leak_and_get(CFuture* future, void** result);
 
+// posts id into queue once the future is ready, the queue must outlive the
+// future.
+void
+future_register_completion(CFuture* future,
+                           CCompletionQueue* queue,
+                           uint64_t id);
+
+CCompletionQueue*
+completion_queue_create();
+
+// the descriptor turning readable when completions are posted.
+int
+completion_queue_fd(CCompletionQueue* queue);
+
+// moves up to max posted ids into ids and returns how many, one drain runs
+// at a time.
+int64_t
+completion_queue_drain(CCompletionQueue* queue, uint64_t* ids, int64_t max);
+
+void
+completion_queue_destroy(CCompletionQueue* queue);
+
 // TODO: only for testing, add test macro for this function.
 CFuture*
 future_create_test_case(int interval, int loop_cnt, int caseNo);
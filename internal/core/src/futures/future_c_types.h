@@ -21,6 +21,8 @@ typedef struct CLockedGoMutex CLockedGoMutex;
 
 typedef void (*CUnlockGoMutexFn)(CLockedGoMutex* mutex);
 
+typedef struct CCompletionQueue CCompletionQueue;
+
 #ifdef __cplusplus
 }
 #endif
@@ -307,14 +307,39 @@ BitmapIndex<T>::Load(const BinarySet& binary_set, const Config& config) {
     LoadWithoutAssemble(binary_set, config);
 }
 
+template <typename T>
+void
+BitmapIndex<T>::SetBits(const roaring::Roaring& bitmap, TargetBitmap& res) {
+    // the iterator decodes a container at a time into the batch instead of
+    // being stepped row by row
+    constexpr uint32_t kBatchSize = 256;
+    uint32_t rows[kBatchSize];
+    roaring::api::roaring_uint32_iterator_t it;
+    roaring::api::roaring_iterator_init(&bitmap.roaring, &it);
+    while (auto n = roaring::api::roaring_uint32_iterator_read(
+               &it, rows, kBatchSize)) {
+        for (uint32_t i = 0; i < n; ++i) {
+            res.set(rows[i]);
+        }
+    }
+}
+
+template <typename T>
+std::optional<size_t>
+BitmapIndex<T>::FindMmapKey(const T& value) const {
+    auto it = std::lower_bound(mmap_keys_.begin(), mmap_keys_.end(), value);
+    if (it == mmap_keys_.end() || value < *it) {
+        return std::nullopt;
+    }
+    return it - mmap_keys_.begin();
+}
+
 template <typename T>
 TargetBitmap
 BitmapIndex<T>::ConvertRoaringToBitset(const roaring::Roaring& values) {
     AssertInfo(total_num_rows_ != 0, "total num rows should not be 0");
     TargetBitmap res(total_num_rows_, false);
-    for (const auto& val : values) {
-        res.set(val);
-    }
+    SetBits(values, res);
     return res;
 }
 
@@ -362,9 +387,7 @@ BitmapIndex<T>::DeserializeIndexData(const uint8_t* data_ptr,
         } else {
             data_[key] = value;
         }
-        for (const auto& v : value) {
-            valid_bitset_.set(v);
-        }
+        SetBits(value, valid_bitset_);
     }
 }
 
@@ -373,10 +396,9 @@ void
 BitmapIndex<T>::BuildOffsetCache() {
     if (is_mmap_) {
         mmap_offsets_cache_.resize(total_num_rows_);
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             ++it) {
-            for (const auto& v : it->second) {
-                mmap_offsets_cache_[v] = it;
+        for (size_t i = 0; i < mmap_bitmaps_.size(); ++i) {
+            for (const auto& v : mmap_bitmaps_[i]) {
+                mmap_offsets_cache_[v] = i;
             }
         }
     } else {
@@ -425,9 +447,7 @@ BitmapIndex<std::string>::DeserializeIndexData(const uint8_t* data_ptr,
         } else {
             data_[key] = value;
         }
-        for (const auto& v : value) {
-            valid_bitset_.set(v);
-        }
+        SetBits(value, valid_bitset_);
     }
 }
 
@@ -465,7 +485,9 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
         std::filesystem::path(file_name).parent_path());
 
     auto file_offset = 0;
-    std::map<T, std::pair<int32_t, int32_t>> bitmaps;
+    // (key, (offset, size)) of the frozen bitmaps in the file
+    std::vector<std::pair<T, std::pair<int32_t, int32_t>>> bitmaps;
+    bitmaps.reserve(index_length);
     {
         auto file_writer = storage::FileWriter(
             file_name, storage::io::GetPriorityFromLoadPriority(priority));
@@ -475,9 +497,7 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
             roaring::Roaring value;
             value =
                 roaring::Roaring::read(reinterpret_cast<const char*>(data_ptr));
-            for (const auto& v : value) {
-                valid_bitset_.set(v);
-            }
+            SetBits(value, valid_bitset_);
 
             // convert roaring vaule to frozen mode
             int32_t frozen_size = value.getFrozenSizeInBytes();
@@ -487,7 +507,7 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
             value.writeFrozen(reinterpret_cast<char*>(buf.data()));
 
             file_writer.Write(buf.data(), aligned_size);
-            bitmaps[key] = {file_offset, frozen_size};
+            bitmaps.push_back({std::move(key), {file_offset, frozen_size}});
 
             file_offset += aligned_size;
             data_ptr += value.getSizeInBytes();
@@ -508,11 +528,20 @@ BitmapIndex<T>::MMapIndexData(const std::string& file_name,
     mmap_size_ = file_offset;
     this->mmap_file_raii_ = std::make_unique<MmapFileRAII>(file_name);
 
+    // serialized from an ordered map, so the keys are in order already
+    std::sort(bitmaps.begin(),
+              bitmaps.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.first < rhs.first;
+              });
     char* ptr = mmap_data_;
-    for (const auto& [key, value] : bitmaps) {
+    mmap_keys_.reserve(bitmaps.size());
+    mmap_bitmaps_.reserve(bitmaps.size());
+    for (auto& [key, value] : bitmaps) {
         const auto& [offset, size] = value;
-        bitmap_info_map_[key] =
-            roaring::Roaring::frozenView(ptr + offset, size);
+        mmap_keys_.push_back(std::move(key));
+        mmap_bitmaps_.push_back(
+            roaring::Roaring::frozenView(ptr + offset, size));
     }
     is_mmap_ = true;
 }
@@ -604,12 +633,9 @@ BitmapIndex<T>::In(const size_t n, const T* values) {
 
     if (is_mmap_) {
         for (size_t i = 0; i < n; ++i) {
-            auto val = values[i];
-            auto it = bitmap_info_map_.find(val);
-            if (it != bitmap_info_map_.end()) {
-                for (const auto& v : it->second) {
-                    res.set(v);
-                }
+            auto pos = FindMmapKey(values[i]);
+            if (pos.has_value()) {
+                SetBits(mmap_bitmaps_[pos.value()], res);
             }
         }
         return res;
@@ -619,9 +645,7 @@ BitmapIndex<T>::In(const size_t n, const T* values) {
             auto val = values[i];
             auto it = data_.find(val);
             if (it != data_.end()) {
-                for (const auto& v : it->second) {
-                    res.set(v);
-                }
+                SetBits(it->second, res);
             }
         }
     } else {
@@ -645,10 +669,9 @@ BitmapIndex<T>::NotIn(const size_t n, const T* values) {
     if (is_mmap_) {
         TargetBitmap res(total_num_rows_, true);
         for (int i = 0; i < n; ++i) {
-            auto val = values[i];
-            auto it = bitmap_info_map_.find(val);
-            if (it != bitmap_info_map_.end()) {
-                for (const auto& v : it->second) {
+            auto pos = FindMmapKey(values[i]);
+            if (pos.has_value()) {
+                for (const auto& v : mmap_bitmaps_[pos.value()]) {
                     res.reset(v);
                 }
             }
@@ -793,44 +816,24 @@ BitmapIndex<T>::RangeForMmap(const T value, const OpType op) {
     if (ShouldSkip(value, value, op)) {
         return res;
     }
-    auto lb = bitmap_info_map_.begin();
-    auto ub = bitmap_info_map_.end();
+    auto lb = mmap_keys_.begin();
+    auto ub = mmap_keys_.end();
 
     switch (op) {
         case OpType::LessThan: {
-            ub = std::lower_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            ub = std::lower_bound(mmap_keys_.begin(), mmap_keys_.end(), value);
             break;
         }
         case OpType::LessEqual: {
-            ub = std::upper_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            ub = std::upper_bound(mmap_keys_.begin(), mmap_keys_.end(), value);
             break;
         }
         case OpType::GreaterThan: {
-            lb = std::upper_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            lb = std::upper_bound(mmap_keys_.begin(), mmap_keys_.end(), value);
             break;
         }
         case OpType::GreaterEqual: {
-            lb = std::lower_bound(bitmap_info_map_.begin(),
-                                  bitmap_info_map_.end(),
-                                  std::make_pair(value, TargetBitmap()),
-                                  [](const auto& lhs, const auto& rhs) {
-                                      return lhs.first < rhs.first;
-                                  });
+            lb = std::lower_bound(mmap_keys_.begin(), mmap_keys_.end(), value);
             break;
         }
         default: {
@@ -839,10 +842,9 @@ BitmapIndex<T>::RangeForMmap(const T value, const OpType op) {
         }
     }
 
-    for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
+    auto end = ub - mmap_keys_.begin();
+    for (auto i = lb - mmap_keys_.begin(); i < end; i++) {
+        SetBits(mmap_bitmaps_[i], res);
     }
     return res;
 }
@@ -904,9 +906,7 @@ BitmapIndex<T>::RangeForRoaring(const T value, const OpType op) {
     }
 
     for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
+        SetBits(lb->second, res);
     }
     return res;
 }
@@ -1007,45 +1007,18 @@ BitmapIndex<T>::RangeForMmap(const T lower_value,
         return res;
     }
 
-    auto lb = bitmap_info_map_.begin();
-    auto ub = bitmap_info_map_.end();
-
-    if (lb_inclusive) {
-        lb = std::lower_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(lower_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    } else {
-        lb = std::upper_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(lower_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    }
-
-    if (ub_inclusive) {
-        ub = std::upper_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(upper_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    } else {
-        ub = std::lower_bound(bitmap_info_map_.begin(),
-                              bitmap_info_map_.end(),
-                              std::make_pair(upper_value, TargetBitmap()),
-                              [](const auto& lhs, const auto& rhs) {
-                                  return lhs.first < rhs.first;
-                              });
-    }
+    auto keys_begin = mmap_keys_.begin();
+    auto keys_end = mmap_keys_.end();
+    auto lb = lb_inclusive
+                  ? std::lower_bound(keys_begin, keys_end, lower_value)
+                  : std::upper_bound(keys_begin, keys_end, lower_value);
+    auto ub = ub_inclusive
+                  ? std::upper_bound(keys_begin, keys_end, upper_value)
+                  : std::lower_bound(keys_begin, keys_end, upper_value);
 
-    for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
+    auto end = ub - keys_begin;
+    for (auto i = lb - keys_begin; i < end; i++) {
+        SetBits(mmap_bitmaps_[i], res);
     }
     return res;
 }
@@ -1105,9 +1078,7 @@ BitmapIndex<T>::RangeForRoaring(const T lower_value,
     }
 
     for (; lb != ub; lb++) {
-        for (const auto& v : lb->second) {
-            res.set(v);
-        }
+        SetBits(lb->second, res);
     }
     return res;
 }
@@ -1117,7 +1088,7 @@ T
 BitmapIndex<T>::Reverse_Lookup_InCache(size_t idx) const {
     if (is_mmap_) {
         Assert(build_mode_ == BitmapIndexBuildMode::ROARING);
-        return mmap_offsets_cache_[idx]->first;
+        return mmap_keys_[mmap_offsets_cache_[idx]];
     }
 
     if (build_mode_ == BitmapIndexBuildMode::ROARING) {
@@ -1143,10 +1114,9 @@ BitmapIndex<T>::Reverse_Lookup(size_t idx) const {
     }
 
     if (is_mmap_) {
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             it++) {
-            if (it->second.contains(idx)) {
-                return it->first;
+        for (size_t i = 0; i < mmap_bitmaps_.size(); i++) {
+            if (mmap_bitmaps_[i].contains(idx)) {
+                return mmap_keys_[i];
             }
         }
     } else {
@@ -1215,9 +1185,9 @@ BitmapIndex<T>::ShouldSkip(const T lower_value,
     };
 
     if (is_mmap_) {
-        if (!bitmap_info_map_.empty()) {
-            auto lower_bound = bitmap_info_map_.begin()->first;
-            auto upper_bound = bitmap_info_map_.rbegin()->first;
+        if (!mmap_keys_.empty()) {
+            auto lower_bound = mmap_keys_.front();
+            auto upper_bound = mmap_keys_.back();
             bool should_skip = skip(op, lower_bound, upper_bound);
             return should_skip;
         }
@@ -1257,13 +1227,9 @@ BitmapIndex<std::string>::Query(const DatasetPtr& dataset) {
     auto val = dataset->Get<std::string>(MATCH_VALUE);
     TargetBitmap res(total_num_rows_, false);
     if (is_mmap_) {
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             ++it) {
-            const auto& key = it->first;
-            if (milvus::query::Match(key, val, op)) {
-                for (const auto& v : it->second) {
-                    res.set(v);
-                }
+        for (size_t i = 0; i < mmap_keys_.size(); ++i) {
+            if (milvus::query::Match(mmap_keys_[i], val, op)) {
+                SetBits(mmap_bitmaps_[i], res);
             }
         }
         return res;
@@ -1272,9 +1238,7 @@ BitmapIndex<std::string>::Query(const DatasetPtr& dataset) {
         for (auto it = data_.begin(); it != data_.end(); ++it) {
             const auto& key = it->first;
             if (milvus::query::Match(key, val, op)) {
-                for (const auto& v : it->second) {
-                    res.set(v);
-                }
+                SetBits(it->second, res);
             }
         }
     } else {
@@ -1304,13 +1268,9 @@ BitmapIndex<std::string>::RegexQuery(const std::string& regex_pattern) {
     RegexMatcher matcher(regex_pattern);
     TargetBitmap res(total_num_rows_, false);
     if (is_mmap_) {
-        for (auto it = bitmap_info_map_.begin(); it != bitmap_info_map_.end();
-             ++it) {
-            const auto& key = it->first;
-            if (matcher(key)) {
-                for (const auto& v : it->second) {
-                    res.set(v);
-                }
+        for (size_t i = 0; i < mmap_keys_.size(); ++i) {
+            if (matcher(mmap_keys_[i])) {
+                SetBits(mmap_bitmaps_[i], res);
             }
         }
         return res;
@@ -1319,9 +1279,7 @@ BitmapIndex<std::string>::RegexQuery(const std::string& regex_pattern) {
         for (auto it = data_.begin(); it != data_.end(); ++it) {
             const auto& key = it->first;
             if (matcher(key)) {
-                for (const auto& v : it->second) {
-                    res.set(v);
-                }
+                SetBits(it->second, res);
             }
         }
     } else {
@@ -18,7 +18,9 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 #include <roaring/roaring.hh>
 
 #include "common/RegexQuery.h"
@@ -125,17 +127,16 @@ class BitmapIndex : public ScalarIndex<T> {
         if (is_mmap_) {
             // mmap mode
             total += mmap_size_;
-            // bitmap_info_map_ overhead (keys and roaring metadata in memory)
-            size_t num_entries = bitmap_info_map_.size();
+            // mmap_keys_ and the roaring metadata of mmap_bitmaps_
+            size_t num_entries = mmap_keys_.size();
             if constexpr (std::is_same_v<T, std::string>) {
-                for (const auto& [key, bitmap] : bitmap_info_map_) {
+                for (const auto& key : mmap_keys_) {
                     total += key.capacity();
                 }
             } else {
                 total += num_entries * sizeof(T);
             }
-            // roaring metadata + map node overhead per entry
-            total += num_entries * (sizeof(roaring::Roaring) + 40);
+            total += num_entries * sizeof(roaring::Roaring);
         } else if (build_mode_ == BitmapIndexBuildMode::ROARING) {
             // data_: map<T, roaring::Roaring>
             for (const auto& [key, bitmap] : data_) {
@@ -235,7 +236,7 @@ class BitmapIndex : public ScalarIndex<T> {
     int64_t
     Cardinality() {
         if (is_mmap_) {
-            return bitmap_info_map_.size();
+            return mmap_keys_.size();
         }
 
         if (build_mode_ == BitmapIndexBuildMode::ROARING) {
@@ -285,6 +286,14 @@ class BitmapIndex : public ScalarIndex<T> {
     TargetBitmap
     ConvertRoaringToBitset(const roaring::Roaring& values);
 
+    // sets the rows of bitmap in res, decoding a batch of rows at a time
+    static void
+    SetBits(const roaring::Roaring& bitmap, TargetBitmap& res);
+
+    // the position of value in mmap_keys_
+    std::optional<size_t>
+    FindMmapKey(const T& value) const;
+
     TargetBitmap
     RangeForRoaring(T value, OpType op);
 
@@ -330,7 +339,10 @@ class BitmapIndex : public ScalarIndex<T> {
     bool is_mmap_{false};
     char* mmap_data_;
     int64_t mmap_size_;
-    std::map<T, roaring::Roaring> bitmap_info_map_;
+    // mmap mode: the keys in order, with their frozen bitmaps pointing into
+    // mmap_data_ at the same positions
+    std::vector<T> mmap_keys_;
+    std::vector<roaring::Roaring> mmap_bitmaps_;
     size_t total_num_rows_{0};
     proto::schema::FieldSchema schema_;
     bool use_offset_cache_{false};
@@ -338,8 +350,8 @@ class BitmapIndex : public ScalarIndex<T> {
         data_offsets_cache_;
     std::vector<typename std::map<T, TargetBitmap>::iterator>
         bitsets_offsets_cache_;
-    std::vector<typename std::map<T, roaring::Roaring>::iterator>
-        mmap_offsets_cache_;
+    // the position in mmap_keys_ of the key of each row
+    std::vector<uint32_t> mmap_offsets_cache_;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
 
     // generate valid_bitset to speed up NotIn and IsNull and IsNotNull operate
@@ -680,6 +680,16 @@ TYPED_TEST_P(BitmapIndexTestV3, IsNotNullFuncTest) {
     this->TestIsNotNullFunc();
 }
 
+TYPED_TEST_P(BitmapIndexTestV3, ReverseLookupFuncTest) {
+    auto index_ptr =
+        dynamic_cast<index::BitmapIndex<TypeParam>*>(this->index_.get());
+    for (size_t i = 0; i < this->nb_; i += 97) {
+        auto value = index_ptr->Reverse_Lookup(i);
+        ASSERT_TRUE(value.has_value());
+        ASSERT_EQ(value.value(), this->data_[i]) << i;
+    }
+}
+
 using BitmapType =
     testing::Types<int8_t, int16_t, int32_t, int64_t, std::string>;
 
@@ -690,7 +700,8 @@ REGISTER_TYPED_TEST_SUITE_P(BitmapIndexTestV3,
                             CompareValFuncTest,
                             TestRangeCompareFuncTest,
                             IsNullFuncTest,
-                            IsNotNullFuncTest);
+                            IsNotNullFuncTest,
+                            ReverseLookupFuncTest);
 
 INSTANTIATE_TYPED_TEST_SUITE_P(BitmapIndexE2ECheck_Mmap,
                                BitmapIndexTestV3,
@@ -0,0 +1,56 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "index/DiskAnnCacheBudget.h"
+
+#include <algorithm>
+
+namespace milvus::index {
+
+DiskAnnCacheBudget&
+DiskAnnCacheBudget::GetInstance() {
+    static DiskAnnCacheBudget instance;
+    return instance;
+}
+
+void
+DiskAnnCacheBudget::SetCapacity(uint64_t bytes) {
+    std::lock_guard lock(mutex_);
+    capacity_ = bytes;
+}
+
+uint64_t
+DiskAnnCacheBudget::Acquire(uint64_t bytes) {
+    std::lock_guard lock(mutex_);
+    if (capacity_ > 0) {
+        bytes = std::min(bytes, capacity_ - std::min(capacity_, used_));
+    }
+    used_ += bytes;
+    return bytes;
+}
+
+void
+DiskAnnCacheBudget::Release(uint64_t bytes) {
+    std::lock_guard lock(mutex_);
+    used_ -= std::min(used_, bytes);
+}
+
+uint64_t
+DiskAnnCacheBudget::Used() const {
+    std::lock_guard lock(mutex_);
+    return used_;
+}
+
+}  // namespace milvus::index
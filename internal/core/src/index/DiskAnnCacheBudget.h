@@ -0,0 +1,54 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace milvus::index {
+
+// Node-wide budget of the DiskANN node caches, which keep the graph nodes
+// most visited by sample queries in memory so searches skip their SSD
+// reads. Every DiskANN index asks for its search_cache_budget_gb on load
+// and gets at most what the loaded indexes left, so the caches of all the
+// segments of a node share one memory budget instead of each segment
+// sizing its own.
+class DiskAnnCacheBudget {
+ public:
+    static DiskAnnCacheBudget&
+    GetInstance();
+
+    // 0 means no node-wide limit
+    void
+    SetCapacity(uint64_t bytes);
+
+    // the bytes granted out of the requested ones
+    uint64_t
+    Acquire(uint64_t bytes);
+
+    void
+    Release(uint64_t bytes);
+
+    uint64_t
+    Used() const;
+
+ private:
+    mutable std::mutex mutex_;
+    uint64_t capacity_{0};
+    uint64_t used_{0};
+};
+
+}  // namespace milvus::index
@@ -0,0 +1,43 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <gtest/gtest.h>
+
+#include "index/DiskAnnCacheBudget.h"
+
+using milvus::index::DiskAnnCacheBudget;
+
+TEST(DiskAnnCacheBudget, SharedAcrossIndexes) {
+    auto& budget = DiskAnnCacheBudget::GetInstance();
+    budget.SetCapacity(100);
+    auto base = budget.Used();
+    ASSERT_EQ(base, 0);
+
+    ASSERT_EQ(budget.Acquire(60), 60);
+    // the second index gets what the first one left
+    ASSERT_EQ(budget.Acquire(60), 40);
+    ASSERT_EQ(budget.Acquire(10), 0);
+    budget.Release(60);
+    ASSERT_EQ(budget.Acquire(10), 10);
+    budget.Release(40);
+    budget.Release(10);
+    ASSERT_EQ(budget.Used(), 0);
+
+    // without a capacity every request is granted
+    budget.SetCapacity(0);
+    ASSERT_EQ(budget.Acquire(1000), 1000);
+    budget.Release(1000);
+    ASSERT_EQ(budget.Used(), 0);
+}
@@ -0,0 +1,82 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/FieldQueryStats.h"
+
+#include <mutex>
+
+namespace milvus::index {
+
+FieldQueryStats&
+FieldQueryStats::GetInstance() {
+    static FieldQueryStats instance;
+    return instance;
+}
+
+FieldQueryStats::Entry&
+FieldQueryStats::GetOrCreate(int64_t collection_id, int64_t field_id) {
+    Key key{collection_id, field_id};
+    {
+        std::shared_lock lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto& entry = entries_[key];
+    if (entry == nullptr) {
+        entry = std::make_unique<Entry>();
+    }
+    return *entry;
+}
+
+void
+FieldQueryStats::RecordPoint(int64_t collection_id, int64_t field_id) {
+    GetOrCreate(collection_id, field_id)
+        .point_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+FieldQueryStats::RecordRange(int64_t collection_id, int64_t field_id) {
+    GetOrCreate(collection_id, field_id)
+        .range_.fetch_add(1, std::memory_order_relaxed);
+}
+
+FieldQueryStats::Counts
+FieldQueryStats::Get(int64_t collection_id, int64_t field_id) const {
+    std::shared_lock lock(mutex_);
+    auto it = entries_.find(Key{collection_id, field_id});
+    if (it == entries_.end()) {
+        return {};
+    }
+    Counts counts;
+    counts.point_ = it->second->point_.load(std::memory_order_relaxed);
+    counts.range_ = it->second->range_.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void
+FieldQueryStats::Clear() {
+    // entries are never erased, Record may still hold one
+    std::shared_lock lock(mutex_);
+    for (auto& [key, entry] : entries_) {
+        entry->point_.store(0, std::memory_order_relaxed);
+        entry->range_.store(0, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace milvus::index
@@ -0,0 +1,70 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+
+namespace milvus::index {
+
+// The kinds of filters the scalar indexes of a field served in this process,
+// by collection and field. HybridScalarIndex records them as it serves
+// queries and reads them back when it picks the internal index of a build.
+class FieldQueryStats {
+ public:
+    struct Counts {
+        // In, NotIn and equality queries
+        int64_t point_{0};
+        // Range and the other ordered queries
+        int64_t range_{0};
+    };
+
+    static FieldQueryStats&
+    GetInstance();
+
+    void
+    RecordPoint(int64_t collection_id, int64_t field_id);
+
+    void
+    RecordRange(int64_t collection_id, int64_t field_id);
+
+    Counts
+    Get(int64_t collection_id, int64_t field_id) const;
+
+    void
+    Clear();
+
+ private:
+    struct Entry {
+        std::atomic<int64_t> point_{0};
+        std::atomic<int64_t> range_{0};
+    };
+    using Key = std::pair<int64_t, int64_t>;
+
+    Entry&
+    GetOrCreate(int64_t collection_id, int64_t field_id);
+
+ private:
+    mutable std::shared_mutex mutex_;
+    std::map<Key, std::unique_ptr<Entry>> entries_;
+};
+
+}  // namespace milvus::index
@@ -46,16 +46,54 @@ HybridScalarIndex<T>::HybridScalarIndex(
     internal_index_type_ = ScalarIndexType::NONE;
 }
 
+// queries seen on a field before they move the index choice of its builds
+constexpr int64_t kMinQueriesForWorkload = 64;
+
+template <typename T>
+size_t
+HybridScalarIndex<T>::BitmapCardinalityLimit() const {
+    size_t limit = bitmap_index_cardinality_limit_;
+    if (!file_manager_context_.Valid()) {
+        return limit;
+    }
+    auto counts = FieldQueryStats::GetInstance().Get(
+        file_manager_context_.fieldDataMeta.collection_id,
+        file_manager_context_.fieldDataMeta.field_id);
+    auto total = counts.point_ + counts.range_;
+    if (total < kMinQueriesForWorkload) {
+        return limit;
+    }
+    // a range ORs the bitmaps of all the values it covers, while the sort
+    // index answers it with two binary searches and a copy of the rows
+    if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+        if (counts.range_ * 4 >= total * 3) {
+            LOG_DEBUG("range queries dominate field {}, build stl sort",
+                      file_manager_context_.fieldDataMeta.field_id);
+            return 0;
+        }
+    }
+    // an In is a lookup and an OR of a bitmap per value, keep the bitmap up
+    // to twice the cardinality while those dominate
+    if (counts.point_ * 4 >= total * 3) {
+        LOG_DEBUG("point queries dominate field {}, raise bitmap limit to {}",
+                  file_manager_context_.fieldDataMeta.field_id,
+                  limit * 2);
+        return limit * 2;
+    }
+    return limit;
+}
+
 template <typename T>
 ScalarIndexType
 HybridScalarIndex<T>::SelectIndexBuildType(size_t n, const T* values) {
+    auto limit = BitmapCardinalityLimit();
     std::set<T> distinct_vals;
     for (size_t i = 0; i < n; i++) {
         distinct_vals.insert(values[i]);
     }
 
     // Decide whether to select bitmap index or inverted sort
-    if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+    if (distinct_vals.size() >= limit) {
         if constexpr (std::is_integral_v<T>) {
             internal_index_type_ = ScalarIndexType::STLSORT;
         } else {
@@ -71,16 +109,17 @@ template <>
 ScalarIndexType
 HybridScalarIndex<std::string>::SelectIndexBuildType(
     size_t n, const std::string* values) {
+    auto limit = BitmapCardinalityLimit();
     std::set<std::string> distinct_vals;
     for (size_t i = 0; i < n; i++) {
         distinct_vals.insert(values[i]);
-        if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+        if (distinct_vals.size() >= limit) {
             break;
         }
     }
 
     // Decide whether to select bitmap index or inverted index
-    if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+    if (distinct_vals.size() >= limit) {
         internal_index_type_ = ScalarIndexType::INVERTED;
     } else {
         internal_index_type_ = ScalarIndexType::BITMAP;
@@ -92,20 +131,21 @@ template <typename T>
 ScalarIndexType
 HybridScalarIndex<T>::SelectBuildTypeForPrimitiveType(
     const std::vector<FieldDataPtr>& field_datas) {
+    auto limit = BitmapCardinalityLimit();
     std::set<T> distinct_vals;
     for (const auto& data : field_datas) {
         auto slice_row_num = data->get_num_rows();
         for (size_t i = 0; i < slice_row_num; ++i) {
             auto val = reinterpret_cast<const T*>(data->RawValue(i));
             distinct_vals.insert(*val);
-            if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+            if (distinct_vals.size() >= limit) {
                 break;
             }
         }
     }
 
     // Decide whether to select bitmap index or inverted sort
-    if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+    if (distinct_vals.size() >= limit) {
         if constexpr (std::is_integral_v<T>) {
             internal_index_type_ = ScalarIndexType::STLSORT;
         } else {
@@ -121,20 +161,21 @@ template <>
 ScalarIndexType
 HybridScalarIndex<std::string>::SelectBuildTypeForPrimitiveType(
     const std::vector<FieldDataPtr>& field_datas) {
+    auto limit = BitmapCardinalityLimit();
     std::set<std::string> distinct_vals;
     for (const auto& data : field_datas) {
         auto slice_row_num = data->get_num_rows();
         for (size_t i = 0; i < slice_row_num; ++i) {
             auto val = reinterpret_cast<const std::string*>(data->RawValue(i));
             distinct_vals.insert(*val);
-            if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+            if (distinct_vals.size() >= limit) {
                 break;
             }
         }
     }
 
     // Decide whether to select bitmap index or inverted sort
-    if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+    if (distinct_vals.size() >= limit) {
         internal_index_type_ = ScalarIndexType::INVERTED;
     } else {
         internal_index_type_ = ScalarIndexType::BITMAP;
@@ -146,6 +187,7 @@ template <typename T>
 ScalarIndexType
 HybridScalarIndex<T>::SelectBuildTypeForArrayType(
     const std::vector<FieldDataPtr>& field_datas) {
+    auto limit = BitmapCardinalityLimit();
     std::set<T> distinct_vals;
     for (const auto& data : field_datas) {
         auto slice_row_num = data->get_num_rows();
@@ -157,14 +199,14 @@ HybridScalarIndex<T>::SelectBuildTypeForArrayType(
                 distinct_vals.insert(val);
 
                 // Limit the bitmap index cardinality because of memory usage
-                if (distinct_vals.size() > bitmap_index_cardinality_limit_) {
+                if (distinct_vals.size() > limit) {
                     break;
                 }
             }
         }
     }
     // Decide whether to select bitmap index or inverted index
-    if (distinct_vals.size() >= bitmap_index_cardinality_limit_) {
+    if (distinct_vals.size() >= limit) {
         internal_index_type_ = ScalarIndexType::INVERTED;
     } else {
         internal_index_type_ = ScalarIndexType::BITMAP;
@@ -22,6 +22,7 @@
 
 #include "index/ScalarIndex.h"
 #include "index/BitmapIndex.h"
+#include "index/FieldQueryStats.h"
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexMarisa.h"
 #include "index/InvertedIndexTantivy.h"
@@ -81,11 +82,13 @@ class HybridScalarIndex : public ScalarIndex<T> {
 
     const TargetBitmap
     In(size_t n, const T* values) override {
+        RecordPointQuery();
         return internal_index_->In(n, values);
     }
 
     const TargetBitmap
     NotIn(size_t n, const T* values) override {
+        RecordPointQuery();
         return internal_index_->NotIn(n, values);
     }
 
@@ -101,6 +104,12 @@ class HybridScalarIndex : public ScalarIndex<T> {
 
     const TargetBitmap
     Query(const DatasetPtr& dataset) override {
+        auto op = dataset->Get<OpType>(OPERATOR_TYPE);
+        if (op == OpType::Equal || op == OpType::NotEqual) {
+            RecordPointQuery();
+        } else {
+            RecordRangeQuery();
+        }
         return internal_index_->Query(dataset);
     }
 
@@ -131,6 +140,7 @@ class HybridScalarIndex : public ScalarIndex<T> {
 
     const TargetBitmap
     Range(T value, OpType op) override {
+        RecordRangeQuery();
         return internal_index_->Range(value, op);
     }
 
@@ -139,6 +149,7 @@ class HybridScalarIndex : public ScalarIndex<T> {
           bool lb_inclusive,
           T upper_bound_value,
           bool ub_inclusive) override {
+        RecordRangeQuery();
         return internal_index_->Range(
             lower_bound_value, lb_inclusive, upper_bound_value, ub_inclusive);
     }
@@ -148,6 +159,13 @@ class HybridScalarIndex : public ScalarIndex<T> {
         return internal_index_->Reverse_Lookup(offset);
     }
 
+    void
+    Reverse_Lookup_Batch(const int64_t* offsets,
+                         int64_t count,
+                         std::optional<T>* values) const override {
+        internal_index_->Reverse_Lookup_Batch(offsets, count, values);
+    }
+
     int64_t
     Size() override {
         return internal_index_->Size();
@@ -175,6 +193,31 @@ class HybridScalarIndex : public ScalarIndex<T> {
     Upload(const Config& config = {}) override;
 
  private:
+    void
+    RecordPointQuery() const {
+        if (!file_manager_context_.Valid()) {
+            return;
+        }
+        FieldQueryStats::GetInstance().RecordPoint(
+            file_manager_context_.fieldDataMeta.collection_id,
+            file_manager_context_.fieldDataMeta.field_id);
+    }
+
+    void
+    RecordRangeQuery() const {
+        if (!file_manager_context_.Valid()) {
+            return;
+        }
+        FieldQueryStats::GetInstance().RecordRange(
+            file_manager_context_.fieldDataMeta.collection_id,
+            file_manager_context_.fieldDataMeta.field_id);
+    }
+
+    // the cardinality below which bitmap is built, moved from
+    // bitmap_index_cardinality_limit_ by the queries seen on the field
+    size_t
+    BitmapCardinalityLimit() const;
+
     ScalarIndexType
     SelectBuildTypeForPrimitiveType(
         const std::vector<FieldDataPtr>& field_datas);
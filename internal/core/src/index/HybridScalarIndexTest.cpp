@@ -822,3 +822,46 @@ INSTANTIATE_TYPED_TEST_SUITE_P(HybridIndexE2ECheck_HasLackNullBinlog,
 INSTANTIATE_TYPED_TEST_SUITE_P(HybridIndexE2ECheck_HasLackDefaultValueBinlog,
                                HybridIndexTestV4,
                                BitmapType);
+
+TEST(HybridScalarIndexSelectTest, FollowsFieldQueries) {
+    storage::StorageConfig storage_config;
+    storage_config.storage_type = "local";
+    storage_config.root_path = "/tmp/test-hybrid-index-select/";
+    auto chunk_manager = storage::CreateChunkManager(storage_config);
+    auto fs = storage::InitArrowFileSystem(storage_config);
+    auto new_index = [&](int64_t field_id) {
+        storage::FieldDataMeta field_meta{901, 2, 3, field_id};
+        field_meta.field_schema.set_data_type(proto::schema::DataType::Int64);
+        storage::FileManagerContext ctx(
+            field_meta, storage::IndexMeta{}, chunk_manager, fs);
+        return std::make_unique<HybridScalarIndex<int64_t>>(0, ctx);
+    };
+    FieldQueryStats::GetInstance().Clear();
+
+    // below the cardinality limit, until ranges dominate the field
+    auto low = GenerateData<int64_t>(10000, 10);
+    auto index = new_index(101);
+    index->Build(low.size(), low.data());
+    ASSERT_EQ(index->internal_index_type_, ScalarIndexType::BITMAP);
+    for (int i = 0; i < 100; i++) {
+        index->Range(5, OpType::LessThan);
+    }
+    index = new_index(101);
+    index->Build(low.size(), low.data());
+    EXPECT_EQ(index->internal_index_type_, ScalarIndexType::STLSORT);
+
+    // above the cardinality limit, until In dominates the field
+    auto high = GenerateData<int64_t>(10000, 150);
+    index = new_index(102);
+    index->Build(high.size(), high.data());
+    ASSERT_EQ(index->internal_index_type_, ScalarIndexType::STLSORT);
+    for (int i = 0; i < 100; i++) {
+        index->In(1, high.data());
+    }
+    index = new_index(102);
+    index->Build(high.size(), high.data());
+    EXPECT_EQ(index->internal_index_type_, ScalarIndexType::BITMAP);
+
+    FieldQueryStats::GetInstance().Clear();
+    boost::filesystem::remove_all(chunk_manager->GetRootPath());
+}
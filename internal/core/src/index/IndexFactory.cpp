@@ -101,6 +101,27 @@ IndexFactory::CreatePrimitiveScalarIndex<std::string>(
 #endif
 }
 
+void
+IndexFactory::SetMmapLoadIndexTypes(
+    const std::vector<std::string>& index_types) {
+    std::unique_lock lock(mmap_load_mutex_);
+    mmap_load_index_types_ =
+        std::unordered_set<std::string>(index_types.begin(), index_types.end());
+}
+
+bool
+IndexFactory::UseMmapLoad(const std::string& index_type,
+                          bool mmap_enable) const {
+    if (!knowhere::KnowhereCheck::SupportMmapIndexTypeCheck(index_type)) {
+        return false;
+    }
+    if (mmap_enable) {
+        return true;
+    }
+    std::shared_lock lock(mmap_load_mutex_);
+    return mmap_load_index_types_.count(index_type) > 0;
+}
+
 LoadResourceRequest
 IndexFactory::IndexLoadResource(
     DataType field_type,
@@ -146,8 +167,7 @@ IndexFactory::VecIndexLoadResource(
     std::string index_type = index_params.at("index_type");
 
     bool mmaped = false;
-    if (mmap_enable &&
-        knowhere::KnowhereCheck::SupportMmapIndexTypeCheck(index_type)) {
+    if (UseMmapLoad(index_type, mmap_enable)) {
         config["enable_mmap"] = true;
         mmaped = true;
     }
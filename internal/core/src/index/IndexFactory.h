@@ -20,6 +20,8 @@
 #include <string>
 #include <mutex>
 #include <shared_mutex>
+#include <unordered_set>
+#include <vector>
 
 #include "common/JsonCastType.h"
 #include "common/Types.h"
@@ -54,6 +56,18 @@ class IndexFactory {
         return instance;
     }
 
+    // Vector index types loaded from a memory mapped local file even when
+    // mmap is not enabled for their field. Knowhere runs them on views of
+    // the serialized index, so loading is a download and an mmap instead of
+    // a deserialization into the heap, and the page cache may reclaim them.
+    void
+    SetMmapLoadIndexTypes(const std::vector<std::string>& index_types);
+
+    // whether an index of the type is loaded memory mapped, mmap_enable
+    // being the setting of its field
+    bool
+    UseMmapLoad(const std::string& index_type, bool mmap_enable) const;
+
     LoadResourceRequest
     IndexLoadResource(DataType field_type,
                       DataType element_type,
@@ -164,6 +178,9 @@ class IndexFactory {
     CreatePrimitiveScalarIndex(const CreateIndexInfo& create_index_info,
                                const storage::FileManagerContext& file_manager =
                                    storage::FileManagerContext());
+
+    mutable std::shared_mutex mmap_load_mutex_;
+    std::unordered_set<std::string> mmap_load_index_types_;
 };
 
 }  // namespace milvus::index
@@ -27,11 +27,11 @@ inline void
 apply_hits_with_callback(
     milvus::TargetBitmap& bitset,
     const std::function<void(size_t /* offset */)>& callback) {
-    std::optional<size_t> result = bitset.find_first();
-    while (result.has_value()) {
-        size_t offset = result.value();
-        callback(offset);
-        result = bitset.find_next(offset);
-    }
+    bitset.for_each_batch([&](const int64_t* offsets, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            callback(offsets[i]);
+        }
+        return true;
+    });
 }
 }  // namespace milvus::index
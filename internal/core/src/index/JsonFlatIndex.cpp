@@ -21,56 +21,55 @@ namespace milvus::index {
 void
 JsonFlatIndex::build_index_for_json(
     const std::vector<std::shared_ptr<FieldDataBase>>& field_datas) {
-    int64_t offset = 0;
-    auto tokens = parse_json_pointer(nested_path_);
-    // Scratch buffer for nested JSON serialization - reused across iterations
-    // to avoid repeated heap allocations
-    simdjson::padded_string scratch_buffer(256);
-    for (const auto& data : field_datas) {
-        auto n = data->get_num_rows();
-        for (int i = 0; i < n; i++) {
-            if (schema_.nullable() && !data->is_valid(i)) {
-                null_offset_.push_back(offset);
-                wrapper_->add_json_array_data(nullptr, 0, offset++);
-                continue;
-            }
-            auto json = static_cast<const Json*>(data->RawValue(i));
-            auto exists = path_exists(json->dom_doc(), tokens);
-            if (!exists || !json->exist(nested_path_)) {
-                wrapper_->add_json_array_data(nullptr, 0, offset++);
-                continue;
-            }
+    FeedJsonRows(field_datas, {this});
+}
 
-            if (nested_path_ == "") {
-                wrapper_->add_json_data(json, 1, offset++);
-            } else {
-                auto doc = json->doc();
-                auto res = doc.at_pointer(nested_path_);
-                auto err = res.error();
-                if (err != simdjson::SUCCESS) {
-                    wrapper_->add_json_array_data(nullptr, 0, offset++);
-                } else {
-                    auto str_result = simdjson::to_json_string(res.value());
-                    if (str_result.error() != simdjson::SUCCESS) {
-                        wrapper_->add_json_array_data(nullptr, 0, offset++);
-                        continue;
-                    }
-                    std::string_view str = str_result.value();
-                    // Resize scratch buffer if needed (with some growth factor)
-                    // Need space for str.size() + 1 for null terminator
-                    if (scratch_buffer.size() < str.size() + 1) {
-                        scratch_buffer =
-                            simdjson::padded_string((str.size() + 1) * 2);
-                    }
-                    std::memcpy(scratch_buffer.data(), str.data(), str.size());
-                    // Add null terminator - required for C string FFI to Rust
-                    scratch_buffer.data()[str.size()] = '\0';
-                    // Create Json referencing scratch buffer (non-owning)
-                    Json subpath_json(scratch_buffer.data(), str.size());
-                    wrapper_->add_json_data(&subpath_json, 1, offset++);
-                }
-            }
-        }
+void
+JsonFlatIndex::AddJsonRow(const Json& json,
+                          const simdjson::dom::element* doc,
+                          int64_t offset) {
+    if (doc == nullptr) {
+        null_offset_.push_back(offset);
+        wrapper_->add_json_array_data(nullptr, 0, offset);
+        return;
+    }
+    if (!path_exists(*doc, tokens_)) {
+        wrapper_->add_json_array_data(nullptr, 0, offset);
+        return;
+    }
+    auto value = doc->at_pointer(nested_path_);
+    if (value.error() != simdjson::SUCCESS || IsJsonValueEmpty(value.value())) {
+        wrapper_->add_json_array_data(nullptr, 0, offset);
+        return;
+    }
+
+    if (nested_path_ == "") {
+        wrapper_->add_json_data(&json, 1, offset);
+        return;
+    }
+    // the raw text of the value, as the document has it
+    auto json_doc = json.doc();
+    auto res = json_doc.at_pointer(nested_path_);
+    if (res.error() != simdjson::SUCCESS) {
+        wrapper_->add_json_array_data(nullptr, 0, offset);
+        return;
+    }
+    auto str_result = simdjson::to_json_string(res.value());
+    if (str_result.error() != simdjson::SUCCESS) {
+        wrapper_->add_json_array_data(nullptr, 0, offset);
+        return;
+    }
+    std::string_view str = str_result.value();
+    // Resize scratch buffer if needed (with some growth factor)
+    // Need space for str.size() + 1 for null terminator
+    if (scratch_buffer_.size() < str.size() + 1) {
+        scratch_buffer_ = simdjson::padded_string((str.size() + 1) * 2);
     }
+    std::memcpy(scratch_buffer_.data(), str.data(), str.size());
+    // Add null terminator - required for C string FFI to Rust
+    scratch_buffer_.data()[str.size()] = '\0';
+    // Create Json referencing scratch buffer (non-owning)
+    Json subpath_json(scratch_buffer_.data(), str.size());
+    wrapper_->add_json_data(&subpath_json, 1, offset);
 }
 }  // namespace milvus::index
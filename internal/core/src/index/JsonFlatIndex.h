@@ -18,7 +18,9 @@
 #include "index/Index.h"
 #include "index/InvertedIndexTantivy.h"
 #include "index/InvertedIndexUtil.h"
+#include "index/JsonIndexBuilder.h"
 #include "index/ScalarIndex.h"
+#include "common/JsonUtils.h"
 #include "log/Log.h"
 namespace milvus::index {
 
@@ -180,7 +182,8 @@ class JsonFlatIndexQueryExecutor : public InvertedIndexTantivy<T> {
 // JsonFlatIndex is not bound to any specific type,
 // we need to reuse InvertedIndexTantivy's Build and Load implementation, so we specify the template parameter as std::string
 // JsonFlatIndex should not be used to execute queries, use JsonFlatIndexQueryExecutor instead
-class JsonFlatIndex : public InvertedIndexTantivy<std::string> {
+class JsonFlatIndex : public InvertedIndexTantivy<std::string>,
+                      public JsonRowSink {
     template <typename T>
     friend class JsonFlatIndexQueryExecutor;
 
@@ -194,13 +197,19 @@ class JsonFlatIndex : public InvertedIndexTantivy<std::string> {
         const int64_t tantivy_index_version = TANTIVY_INDEX_LATEST_VERSION)
         : InvertedIndexTantivy<std::string>(
               tantivy_index_version, ctx, false, false),
-          nested_path_(nested_path) {
+          nested_path_(nested_path),
+          tokens_(parse_json_pointer(nested_path)) {
     }
 
     void
     build_index_for_json(const std::vector<std::shared_ptr<FieldDataBase>>&
                              field_datas) override;
 
+    void
+    AddJsonRow(const Json& json,
+               const simdjson::dom::element* doc,
+               int64_t offset) override;
+
     template <typename T>
     std::shared_ptr<JsonFlatIndexQueryExecutor<T>>
     create_executor(std::string json_path) const {
@@ -236,6 +245,10 @@ class JsonFlatIndex : public InvertedIndexTantivy<std::string> {
 
  private:
     std::string nested_path_;
+    std::vector<std::string> tokens_;
+    // Scratch buffer for nested JSON serialization - reused across rows
+    // to avoid repeated heap allocations
+    simdjson::padded_string scratch_buffer_ = simdjson::padded_string(256);
 };
 
 template <typename T>
@@ -9,92 +9,231 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <string>
 #include <string_view>
+#include "common/EasyAssert.h"
 #include "common/JsonUtils.h"
 #include "index/JsonIndexBuilder.h"
+#include "index/Utils.h"
 #include "simdjson/error.h"
 
 namespace milvus::index {
 
+namespace {
+
+// rows parsed before the sinks take them
+constexpr int64_t kJsonRowBatchSize = 1024;
+
+// the sink of ProcessJsonFieldData
 template <typename T>
-void
-ProcessJsonFieldData(
-    const std::vector<std::shared_ptr<FieldDataBase>>& field_datas,
-    const proto::schema::FieldSchema& schema,
-    const std::string& nested_path,
-    const JsonCastType& cast_type,
-    JsonCastFunction cast_function,
-    JsonDataAdder<T> data_adder,
-    JsonNullAdder null_adder,
-    JsonNonExistAdder non_exist_adder,
-    JsonErrorRecorder error_recorder) {
-    int64_t offset = 0;
-    using SIMDJSON_T =
-        std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+class JsonFieldDataSink : public JsonRowSink {
+ public:
+    JsonFieldDataSink(const JsonPathReader<T>& reader,
+                      const std::string& nested_path,
+                      JsonDataAdder<T> data_adder,
+                      JsonNullAdder null_adder,
+                      JsonNonExistAdder non_exist_adder,
+                      JsonErrorRecorder error_recorder)
+        : reader_(reader),
+          nested_path_(nested_path),
+          data_adder_(std::move(data_adder)),
+          null_adder_(std::move(null_adder)),
+          non_exist_adder_(std::move(non_exist_adder)),
+          error_recorder_(std::move(error_recorder)) {
+    }
 
-    auto tokens = parse_json_pointer(nested_path);
+    void
+    AddJsonRow(const Json& json,
+               const simdjson::dom::element* doc,
+               int64_t offset) override {
+        if (doc == nullptr) {
+            non_exist_adder_(offset);
+            null_adder_(offset);
+            data_adder_(nullptr, 0, offset);
+            return;
+        }
+        values_.clear();
+        auto error = reader_.Read(*doc, values_);
+        if (error != simdjson::SUCCESS) {
+            error_recorder_(json, nested_path_, error);
+        }
+        if (error == simdjson::NO_SUCH_FIELD) {
+            non_exist_adder_(offset);
+            data_adder_(nullptr, 0, offset);
+            return;
+        }
+        data_adder_(values_.data(), values_.size(), offset);
+    }
 
-    bool is_array = cast_type.data_type() == JsonCastType::DataType::ARRAY;
+ private:
+    const JsonPathReader<T>& reader_;
+    const std::string& nested_path_;
+    JsonDataAdder<T> data_adder_;
+    JsonNullAdder null_adder_;
+    JsonNonExistAdder non_exist_adder_;
+    JsonErrorRecorder error_recorder_;
+    folly::fbvector<T> values_;
+};
 
-    for (const auto& data : field_datas) {
-        auto n = data->get_num_rows();
-        for (int64_t i = 0; i < n; i++) {
-            auto json_column = static_cast<const Json*>(data->RawValue(i));
-            if (schema.nullable() && !data->is_valid(i)) {
-                non_exist_adder(offset);
-                null_adder(offset);
-                data_adder(nullptr, 0, offset++);
-                continue;
-            }
+}  // namespace
 
-            auto exists = path_exists(json_column->dom_doc(), tokens);
-            if (!exists || !json_column->exist(nested_path)) {
-                error_recorder(
-                    *json_column, nested_path, simdjson::NO_SUCH_FIELD);
-                non_exist_adder(offset);
-                data_adder(nullptr, 0, offset++);
-                continue;
+bool
+IsJsonValueEmpty(const simdjson::dom::element& value) {
+    switch (value.type()) {
+        case simdjson::dom::element_type::NULL_VALUE:
+            return true;
+        case simdjson::dom::element_type::OBJECT:
+            for (auto field : value.get_object().value()) {
+                if (!IsJsonValueEmpty(field.value)) {
+                    return false;
+                }
+            }
+            return true;
+        case simdjson::dom::element_type::ARRAY:
+            for (auto element : value.get_array().value()) {
+                if (!IsJsonValueEmpty(element)) {
+                    return false;
+                }
             }
+            return true;
+        default:
+            return false;
+    }
+}
+
+void
+FeedJsonRows(const std::vector<std::shared_ptr<FieldDataBase>>& field_datas,
+             const std::vector<JsonRowSink*>& sinks) {
+    // the documents are reused across batches, keeping their buffers
+    std::vector<simdjson::dom::document> docs(kJsonRowBatchSize);
+    std::vector<simdjson::dom::element> roots(kJsonRowBatchSize);
+    std::vector<uint8_t> is_null(kJsonRowBatchSize);
 
-            folly::fbvector<T> values;
-            if (is_array) {
-                auto doc = json_column->dom_doc();
-                auto array_res = doc.at_pointer(nested_path).get_array();
-                if (array_res.error() != simdjson::SUCCESS) {
-                    error_recorder(
-                        *json_column, nested_path, array_res.error());
-                } else {
-                    auto array_values = array_res.value();
-                    for (auto value : array_values) {
-                        auto val = value.template get<SIMDJSON_T>();
-
-                        if (val.error() == simdjson::SUCCESS) {
-                            values.push_back(static_cast<T>(val.value()));
-                        }
+    int64_t offset = 0;
+    for (const auto& data : field_datas) {
+        auto n = data->get_num_rows();
+        for (int64_t begin = 0; begin < n; begin += kJsonRowBatchSize) {
+            auto size = std::min(kJsonRowBatchSize, n - begin);
+            auto parts = std::clamp<size_t>(ParallelWorkers(), 1, size);
+            ParallelRun(parts, [&](size_t part) {
+                thread_local simdjson::dom::parser parser;
+                for (auto i = size * part / parts;
+                     i < size * (part + 1) / parts;
+                     i++) {
+                    auto row = begin + i;
+                    is_null[i] = data->IsNullable() && !data->is_valid(row);
+                    if (is_null[i]) {
+                        continue;
                     }
+                    auto json = static_cast<const Json*>(data->RawValue(row));
+                    // it's always safe to read the padding, as a Json is
+                    // allocated with it
+                    auto root = parser.parse_into_document(
+                        docs[i],
+                        reinterpret_cast<const uint8_t*>(json->c_str()),
+                        json->size(),
+                        false);
+                    AssertInfo(root.error() == simdjson::SUCCESS,
+                               "failed to parse the json {}: {}",
+                               json->data(),
+                               simdjson::error_message(root.error()));
+                    roots[i] = root.value();
                 }
-            } else {
-                if (cast_function.match<T>()) {
-                    auto res = JsonCastFunction::CastJsonValue<T>(
-                        cast_function, *json_column, nested_path);
-                    if (res.has_value()) {
-                        values.push_back(res.value());
-                    }
-                } else {
-                    value_result<SIMDJSON_T> res =
-                        json_column->at<SIMDJSON_T>(nested_path);
-                    if (res.error() != simdjson::SUCCESS) {
-                        error_recorder(*json_column, nested_path, res.error());
-                    } else {
-                        values.push_back(static_cast<T>(res.value()));
-                    }
+            });
+            ParallelRun(sinks.size(), [&](size_t s) {
+                for (int64_t i = 0; i < size; i++) {
+                    auto json = static_cast<const Json*>(
+                        data->RawValue(begin + i));
+                    sinks[s]->AddJsonRow(
+                        *json, is_null[i] ? nullptr : &roots[i], offset + i);
                 }
-            }
+            });
+            offset += size;
+        }
+    }
+    for (auto sink : sinks) {
+        sink->FinishJsonRows();
+    }
+}
+
+template <typename T>
+JsonPathReader<T>::JsonPathReader(const std::string& nested_path,
+                                  const JsonCastType& cast_type,
+                                  const JsonCastFunction& cast_function)
+    : nested_path_(nested_path),
+      tokens_(parse_json_pointer(nested_path)),
+      is_array_(cast_type.data_type() == JsonCastType::DataType::ARRAY),
+      cast_function_(cast_function) {
+}
 
-            data_adder(values.data(), values.size(), offset++);
+template <typename T>
+simdjson::error_code
+JsonPathReader<T>::Read(const simdjson::dom::element& doc,
+                        folly::fbvector<T>& values) const {
+    using SIMDJSON_T =
+        std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+    if (!path_exists(doc, tokens_)) {
+        return simdjson::NO_SUCH_FIELD;
+    }
+    auto value = doc.at_pointer(nested_path_);
+    if (value.error() != simdjson::SUCCESS || IsJsonValueEmpty(value.value())) {
+        return simdjson::NO_SUCH_FIELD;
+    }
+
+    if (is_array_) {
+        auto array_res = value.get_array();
+        if (array_res.error() != simdjson::SUCCESS) {
+            return array_res.error();
+        }
+        for (auto element : array_res.value()) {
+            auto val = element.template get<SIMDJSON_T>();
+            if (val.error() == simdjson::SUCCESS) {
+                values.push_back(static_cast<T>(val.value()));
+            }
         }
+    } else if (cast_function_.match<T>()) {
+        auto res =
+            JsonCastFunction::CastJsonValue<T>(cast_function_, value.value());
+        if (res.has_value()) {
+            values.push_back(res.value());
+        }
+    } else {
+        auto res = value.template get<SIMDJSON_T>();
+        if (res.error() != simdjson::SUCCESS) {
+            return res.error();
+        }
+        values.push_back(static_cast<T>(res.value()));
     }
+    return simdjson::SUCCESS;
+}
+
+template class JsonPathReader<bool>;
+template class JsonPathReader<int64_t>;
+template class JsonPathReader<double>;
+template class JsonPathReader<std::string>;
+
+template <typename T>
+void
+ProcessJsonFieldData(
+    const std::vector<std::shared_ptr<FieldDataBase>>& field_datas,
+    const proto::schema::FieldSchema& schema,
+    const std::string& nested_path,
+    const JsonCastType& cast_type,
+    JsonCastFunction cast_function,
+    JsonDataAdder<T> data_adder,
+    JsonNullAdder null_adder,
+    JsonNonExistAdder non_exist_adder,
+    JsonErrorRecorder error_recorder) {
+    JsonPathReader<T> reader(nested_path, cast_type, cast_function);
+    JsonFieldDataSink<T> sink(reader,
+                              nested_path,
+                              std::move(data_adder),
+                              std::move(null_adder),
+                              std::move(non_exist_adder),
+                              std::move(error_recorder));
+    FeedJsonRows(field_datas, {&sink});
 }
 
 template void
@@ -11,6 +11,8 @@
 
 #pragma once
 #include <functional>
+#include <vector>
+#include "common/FieldDataInterface.h"
 #include "common/JsonCastType.h"
 #include "common/JsonCastFunction.h"
 #include "common/Json.h"
@@ -29,7 +31,64 @@ using JsonErrorRecorder = std::function<void(const Json& json,
 using JsonNullAdder = std::function<void(int64_t offset)>;
 using JsonNonExistAdder = std::function<void(int64_t offset)>;
 
-// A helper function for processing json data for building inverted index
+// An index built from the rows of a JSON field, see FeedJsonRows.
+class JsonRowSink {
+ public:
+    virtual ~JsonRowSink() = default;
+
+    // Takes the rows one at a time in offset order. doc is the parsed json,
+    // nullptr for a null row.
+    virtual void
+    AddJsonRow(const Json& json,
+               const simdjson::dom::element* doc,
+               int64_t offset) = 0;
+
+    // Called once every row is taken.
+    virtual void
+    FinishJsonRows() {
+    }
+};
+
+// Feeds the rows of a JSON field to the indexes built on it, parsing each
+// document once for all of them. The rows are parsed a batch at a time,
+// then the sinks take the batch at once, each on its own thread.
+void
+FeedJsonRows(const std::vector<std::shared_ptr<FieldDataBase>>& field_datas,
+             const std::vector<JsonRowSink*>& sinks);
+
+// Reads the values an index of nested_path takes from a parsed json.
+template <typename T>
+class JsonPathReader {
+ public:
+    JsonPathReader(const std::string& nested_path,
+                   const JsonCastType& cast_type,
+                   const JsonCastFunction& cast_function);
+
+    // Appends the values at the path to values. NO_SUCH_FIELD if the path
+    // is missing or holds nothing but nulls, another error if a value
+    // doesn't read as T, the values read so far are kept then.
+    simdjson::error_code
+    Read(const simdjson::dom::element& doc,
+         folly::fbvector<T>& values) const;
+
+ private:
+    std::string nested_path_;
+    std::vector<std::string> tokens_;
+    bool is_array_;
+    JsonCastFunction cast_function_;
+};
+
+extern template class JsonPathReader<bool>;
+extern template class JsonPathReader<int64_t>;
+extern template class JsonPathReader<double>;
+extern template class JsonPathReader<std::string>;
+
+// Whether value holds nothing but nulls, like isObjectEmpty.
+bool
+IsJsonValueEmpty(const simdjson::dom::element& value);
+
+// A helper function for processing json data for building inverted index,
+// a FeedJsonRows of a single sink.
 template <typename T>
 void
 ProcessJsonFieldData(
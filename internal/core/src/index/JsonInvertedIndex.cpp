@@ -46,28 +46,32 @@ JsonInvertedIndex<T>::build_index_for_json(
     const std::vector<std::shared_ptr<FieldDataBase>>& field_datas) {
     LOG_INFO("Start to build json inverted index for field: {}", nested_path_);
 
-    ProcessJsonFieldData<T>(
-        field_datas,
-        this->schema_,
-        nested_path_,
-        cast_type_,
-        cast_function_,
-        // add data
-        [this](const T* data, int64_t size, int64_t offset) {
-            this->wrapper_->template add_array_data<T>(data, size, offset);
-        },
-        // handle null
-        [this](int64_t offset) { this->null_offset_.push_back(offset); },
-        // handle non exist
-        [this](int64_t offset) { this->non_exist_offsets_.push_back(offset); },
-        // handle error
-        [this](const Json& json,
-               const std::string& nested_path,
-               simdjson::error_code error) {
-            this->error_recorder_.Record(json, nested_path, error);
-        });
+    FeedJsonRows(field_datas, {this});
+}
 
-    error_recorder_.PrintErrStats();
+template <typename T>
+void
+JsonInvertedIndex<T>::AddJsonRow(const Json& json,
+                                 const simdjson::dom::element* doc,
+                                 int64_t offset) {
+    if (doc == nullptr) {
+        non_exist_offsets_.push_back(offset);
+        this->null_offset_.push_back(offset);
+        this->wrapper_->template add_array_data<T>(nullptr, 0, offset);
+        return;
+    }
+    row_values_.clear();
+    auto error = path_reader_.Read(*doc, row_values_);
+    if (error != simdjson::SUCCESS) {
+        error_recorder_.Record(json, nested_path_, error);
+    }
+    if (error == simdjson::NO_SUCH_FIELD) {
+        non_exist_offsets_.push_back(offset);
+        this->wrapper_->template add_array_data<T>(nullptr, 0, offset);
+        return;
+    }
+    this->wrapper_->template add_array_data<T>(
+        row_values_.data(), row_values_.size(), offset);
 }
 
 template <typename T>
@@ -17,6 +17,7 @@
 #include "common/JsonCastFunction.h"
 #include "common/JsonCastType.h"
 #include "index/InvertedIndexTantivy.h"
+#include "index/JsonIndexBuilder.h"
 #include "index/ScalarIndex.h"
 #include "storage/FileManager.h"
 #include "boost/filesystem.hpp"
@@ -75,7 +76,8 @@ class JsonInvertedIndexParseErrorRecorder {
 };
 
 template <typename T>
-class JsonInvertedIndex : public index::InvertedIndexTantivy<T> {
+class JsonInvertedIndex : public index::InvertedIndexTantivy<T>,
+                          public JsonRowSink {
  public:
     JsonInvertedIndex(
         const JsonCastType& cast_type,
@@ -86,7 +88,8 @@ class JsonInvertedIndex : public index::InvertedIndexTantivy<T> {
             JsonCastFunction::FromString("unknown"))
         : nested_path_(nested_path),
           cast_type_(cast_type),
-          cast_function_(cast_function) {
+          cast_function_(cast_function),
+          path_reader_(nested_path, cast_type, cast_function) {
         this->schema_ = ctx.fieldDataMeta.field_schema;
         this->mem_file_manager_ =
             std::make_shared<storage::MemFileManagerImpl>(ctx);
@@ -113,6 +116,16 @@ class JsonInvertedIndex : public index::InvertedIndexTantivy<T> {
     build_index_for_json(const std::vector<std::shared_ptr<FieldDataBase>>&
                              field_datas) override;
 
+    void
+    AddJsonRow(const Json& json,
+               const simdjson::dom::element* doc,
+               int64_t offset) override;
+
+    void
+    FinishJsonRows() override {
+        error_recorder_.PrintErrStats();
+    }
+
     void
     finish() {
         this->wrapper_->finish();
@@ -185,6 +198,9 @@ class JsonInvertedIndex : public index::InvertedIndexTantivy<T> {
     JsonInvertedIndexParseErrorRecorder error_recorder_;
     JsonCastType cast_type_;
     JsonCastFunction cast_function_;
+    JsonPathReader<T> path_reader_;
+    // the values of the row AddJsonRow takes
+    folly::fbvector<T> row_values_;
 
     // Stores the offsets of rows in which this JSON path does not exist.
     // This includes rows that are null, does not have this JSON path, or have
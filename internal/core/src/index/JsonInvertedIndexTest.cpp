@@ -280,3 +280,77 @@ TEST(JsonIndexTest, TestJsonCast) {
         }
     }
 }
+
+TEST(JsonIndexTest, TestBuildIndexesInOnePass) {
+    std::vector<std::string> json_raw_data = {
+        R"({"a": 1.0, "b": "x"})",
+        R"({"a": 2})",
+        R"({"b": "y"})",
+        R"({"a": null, "b": {}})",
+        R"({"a": "z", "b": ["x"]})",
+    };
+
+    auto schema = std::make_shared<Schema>();
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    auto create_index = [&](const std::string& json_path,
+                            const std::string& cast_type,
+                            int64_t build_id) {
+        auto file_manager_ctx = storage::FileManagerContext();
+        file_manager_ctx.fieldDataMeta.field_schema.set_data_type(
+            milvus::proto::schema::JSON);
+        file_manager_ctx.fieldDataMeta.field_schema.set_fieldid(
+            json_fid.get());
+        file_manager_ctx.fieldDataMeta.field_id = json_fid.get();
+        file_manager_ctx.indexMeta.build_id = build_id;
+        return index::IndexFactory::GetInstance().CreateJsonIndex(
+            index::CreateIndexInfo{
+                .index_type = index::INVERTED_INDEX_TYPE,
+                .json_cast_type = JsonCastType::FromString(cast_type),
+                .json_path = json_path,
+            },
+            file_manager_ctx);
+    };
+    auto a_index = std::unique_ptr<JsonInvertedIndex<double>>(
+        static_cast<JsonInvertedIndex<double>*>(
+            create_index("/a", "DOUBLE", 1).release()));
+    auto b_index = std::unique_ptr<JsonInvertedIndex<std::string>>(
+        static_cast<JsonInvertedIndex<std::string>*>(
+            create_index("/b", "VARCHAR", 2).release()));
+
+    std::vector<milvus::Json> jsons;
+    for (auto& json : json_raw_data) {
+        jsons.push_back(milvus::Json(simdjson::padded_string(json)));
+    }
+    auto json_field =
+        std::make_shared<FieldData<milvus::Json>>(DataType::JSON, false);
+    json_field->add_json_data(jsons);
+
+    FeedJsonRows({json_field}, {a_index.get(), b_index.get()});
+    a_index->finish();
+    a_index->create_reader(milvus::index::SetBitsetSealed);
+    b_index->finish();
+    b_index->create_reader(milvus::index::SetBitsetSealed);
+
+    auto a_exists = a_index->Exists();
+    auto b_exists = b_index->Exists();
+    for (size_t i = 0; i < json_raw_data.size(); i++) {
+        EXPECT_EQ(a_exists[i], i == 0 || i == 1 || i == 4);
+        EXPECT_EQ(b_exists[i], i == 0 || i == 2 || i == 4);
+    }
+
+    double a = 1.0;
+    auto a_in = a_index->In(1, &a);
+    EXPECT_EQ(a_in.count(), 1);
+    EXPECT_TRUE(a_in[0]);
+    std::string b = "x";
+    auto b_in = b_index->In(1, &b);
+    EXPECT_EQ(b_in.count(), 1);
+    EXPECT_TRUE(b_in[0]);
+
+    auto a_errors = a_index->GetErrorRecorder().GetErrorMap();
+    EXPECT_EQ(a_errors[simdjson::error_code::NO_SUCH_FIELD].count, 2);
+    EXPECT_EQ(a_errors[simdjson::error_code::INCORRECT_TYPE].count, 1);
+    auto b_errors = b_index->GetErrorRecorder().GetErrorMap();
+    EXPECT_EQ(b_errors[simdjson::error_code::NO_SUCH_FIELD].count, 2);
+    EXPECT_EQ(b_errors[simdjson::error_code::INCORRECT_TYPE].count, 1);
+}
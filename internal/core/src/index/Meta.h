@@ -59,6 +59,9 @@ constexpr const char* MIN_GRAM = "min_gram";
 constexpr const char* MAX_GRAM = "max_gram";
 
 constexpr const char* JSON_KEY_STATS_INDEX_TYPE = "JsonKeyStats";
+// JSON object of the JSON pointers filters evaluated on the field to their
+// hit counts, shapes the key layout of the JSON stats build
+constexpr const char* JSON_STATS_QUERIED_PATHS = "json_stats_queried_paths";
 // index meta
 constexpr const char* COLLECTION_ID = "collection_id";
 constexpr const char* PARTITION_ID = "partition_id";
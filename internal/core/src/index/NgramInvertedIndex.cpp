@@ -11,8 +11,11 @@
 
 #include "index/NgramInvertedIndex.h"
 
+#include <algorithm>
 #include <chrono>
 
+#include "common/Common.h"
+#include "common/RegexQuery.h"
 #include "exec/expression/Expr.h"
 #include "index/JsonIndexBuilder.h"
 
@@ -58,8 +61,17 @@ NgramInvertedIndex::NgramInvertedIndex(const storage::FileManagerContext& ctx,
         d_type_ = TantivyDataType::Keyword;
         std::string field_name =
             std::to_string(disk_file_manager_->GetFieldDataMeta().field_id);
+        // every thread indexes the rows it takes into a segment of its own,
+        // the segments are merged when the build finishes
+        auto num_threads = static_cast<uintptr_t>(
+            std::max<int64_t>(NGRAM_INDEX_BUILD_THREADS.load(), 1));
         wrapper_ = std::make_shared<TantivyIndexWrapper>(
-            field_name.c_str(), path_.c_str(), min_gram_, max_gram_);
+            field_name.c_str(),
+            path_.c_str(),
+            min_gram_,
+            max_gram_,
+            num_threads,
+            num_threads * tantivy::MEMORY_BUDGET_PER_THREAD_IN_BYTES);
     }
 }
 
@@ -273,36 +285,6 @@ NgramInvertedIndex::Load(milvus::tracer::TraceContext ctx,
         "load ngram index done for field id:{} with dir:{}", field_id_, path_);
 }
 
-std::vector<std::string>
-split_by_wildcard(const std::string& literal) {
-    std::vector<std::string> result;
-    std::string r;
-    r.reserve(literal.size());
-    bool escape_mode = false;
-    for (char c : literal) {
-        if (escape_mode) {
-            r += c;
-            escape_mode = false;
-        } else {
-            if (c == '\\') {
-                // consider case "\\%", we should reserve %
-                escape_mode = true;
-            } else if (c == '%' || c == '_') {
-                if (r.length() > 0) {
-                    result.push_back(r);
-                    r.clear();
-                }
-            } else {
-                r += c;
-            }
-        }
-    }
-    if (r.length() > 0) {
-        result.push_back(r);
-    }
-    return result;
-}
-
 bool
 NgramInvertedIndex::CanHandleLiteral(const std::string& literal,
                                      proto::plan::OpType op_type) const {
@@ -553,9 +535,7 @@ NgramInvertedIndex::ExecutePhase2(const std::string& literal,
                 break;
             }
             case proto::plan::OpType::Match: {
-                PatternMatchTranslator translator;
-                auto regex_pattern = translator(literal);
-                RegexMatcher matcher(regex_pattern);
+                LikePatternMatcher matcher(literal);
                 apply_predicate([&matcher, this](const milvus::Json& data) {
                     auto x =
                         data.template at<std::string_view>(this->nested_path_);
@@ -606,9 +586,7 @@ NgramInvertedIndex::ExecutePhase2(const std::string& literal,
                 break;
             }
             case proto::plan::OpType::Match: {
-                PatternMatchTranslator translator;
-                auto regex_pattern = translator(literal);
-                RegexMatcher matcher(regex_pattern);
+                LikePatternMatcher matcher(literal);
                 apply_predicate([&matcher](const std::string_view& data) {
                     return matcher(data);
                 });
@@ -12,16 +12,184 @@
 #include "common/EasyAssert.h"
 #include "log/Log.h"
 #include "pb/plan.pb.h"
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include "common/FieldDataInterface.h"
+#include "index/Utils.h"
 #include "RTreeIndexWrapper.h"
 #include "RTreeIndexSerialization.h"
 
 namespace milvus::index {
 
+namespace {
+
+// nested collections deeper than this are left to GEOS
+constexpr int kMaxWkbDepth = 32;
+
+// rows per task of the parallel envelope pass of a bulk load
+constexpr int64_t kEnvelopeBlockRows = 4096;
+
+constexpr bool kLittleEndianHost =
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+inline double
+LoadDouble(const uint8_t* pos, bool swap) {
+    uint64_t bits;
+    std::memcpy(&bits, pos, sizeof(bits));
+    if (swap) {
+        bits = __builtin_bswap64(bits);
+    }
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Walks the coordinates of a WKB geometry and keeps their bounds.
+class WkbEnvelopeReader {
+ public:
+    WkbEnvelopeReader(const uint8_t* wkb, size_t len)
+        : pos_(wkb), end_(wkb + len) {
+    }
+
+    bool
+    Read(int depth) {
+        if (end_ - pos_ < 5) {
+            return false;
+        }
+        auto byte_order = *pos_++;
+        if (byte_order > 1) {
+            return false;
+        }
+        swap_ = (byte_order == 1) != kLittleEndianHost;
+        uint32_t type;
+        if (!Next(type)) {
+            return false;
+        }
+        // extended WKB flags, then ISO dimension offsets of 1000
+        bool has_z = type & 0x80000000u;
+        bool has_m = type & 0x40000000u;
+        uint32_t srid;
+        if ((type & 0x20000000u) && !Next(srid)) {
+            return false;
+        }
+        type &= 0x0fffffffu;
+        auto iso_dims = type / 1000;
+        type %= 1000;
+        if (iso_dims > 3) {
+            return false;
+        }
+        has_z = has_z || iso_dims == 1 || iso_dims == 3;
+        has_m = has_m || iso_dims >= 2;
+        size_t point_bytes = (2 + has_z + has_m) * sizeof(double);
+
+        uint32_t num = 0;
+        switch (type) {
+            case 1:  // Point
+                return Points(1, point_bytes);
+            case 2:  // LineString
+                return Next(num) && Points(num, point_bytes);
+            case 3: {  // Polygon
+                if (!Next(num)) {
+                    return false;
+                }
+                for (uint32_t ring = 0; ring < num; ++ring) {
+                    uint32_t num_points;
+                    if (!Next(num_points) || !Points(num_points, point_bytes)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            case 4:  // MultiPoint
+            case 5:  // MultiLineString
+            case 6:  // MultiPolygon
+            case 7: {  // GeometryCollection
+                if (depth >= kMaxWkbDepth || !Next(num)) {
+                    return false;
+                }
+                for (uint32_t i = 0; i < num; ++i) {
+                    if (!Read(depth + 1)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    double min_x_ = std::numeric_limits<double>::infinity();
+    double min_y_ = std::numeric_limits<double>::infinity();
+    double max_x_ = -std::numeric_limits<double>::infinity();
+    double max_y_ = -std::numeric_limits<double>::infinity();
+
+ private:
+    bool
+    Next(uint32_t& value) {
+        if (end_ - pos_ < static_cast<ptrdiff_t>(sizeof(value))) {
+            return false;
+        }
+        std::memcpy(&value, pos_, sizeof(value));
+        if (swap_) {
+            value = __builtin_bswap32(value);
+        }
+        pos_ += sizeof(value);
+        return true;
+    }
+
+    bool
+    Points(uint32_t num, size_t point_bytes) {
+        if (static_cast<size_t>(end_ - pos_) / point_bytes < num) {
+            return false;
+        }
+        // branch free, so the loop vectorizes; NaN coordinates, as of
+        // POINT EMPTY, compare false and leave the bounds as they are
+        for (uint32_t i = 0; i < num; ++i, pos_ += point_bytes) {
+            auto x = LoadDouble(pos_, swap_);
+            auto y = LoadDouble(pos_ + sizeof(double), swap_);
+            min_x_ = x < min_x_ ? x : min_x_;
+            max_x_ = x > max_x_ ? x : max_x_;
+            min_y_ = y < min_y_ ? y : min_y_;
+            max_y_ = y > max_y_ ? y : max_y_;
+        }
+        return true;
+    }
+
+    const uint8_t* pos_;
+    const uint8_t* end_;
+    bool swap_ = false;
+};
+
+}  // namespace
+
+bool
+ReadWkbEnvelope(const uint8_t* wkb,
+                size_t len,
+                double& minX,
+                double& minY,
+                double& maxX,
+                double& maxY) {
+    if (wkb == nullptr) {
+        return false;
+    }
+    WkbEnvelopeReader reader(wkb, len);
+    if (!reader.Read(0) || !(reader.min_x_ <= reader.max_x_) ||
+        !(reader.min_y_ <= reader.max_y_)) {
+        return false;
+    }
+    minX = reader.min_x_;
+    minY = reader.min_y_;
+    maxX = reader.max_x_;
+    maxY = reader.max_y_;
+    return true;
+}
+
 RTreeIndexWrapper::RTreeIndexWrapper(std::string& path, bool is_build_mode)
     : index_path_(path), is_build_mode_(is_build_mode) {
     if (is_build_mode_) {
@@ -46,7 +214,15 @@ RTreeIndexWrapper::add_geometry(const uint8_t* wkb_data,
 
     AssertInfo(is_build_mode_, "Cannot add geometry in load mode");
 
-    // Parse WKB data using GEOS for consistency
+    double minX, minY, maxX, maxY;
+    if (ReadWkbEnvelope(wkb_data, len, minX, minY, maxX, maxY)) {
+        Value val(Box(Point(minX, minY), Point(maxX, maxY)), row_offset);
+        values_.push_back(val);
+        rtree_.insert(val);
+        return;
+    }
+
+    // Parse WKB data using GEOS for what the reader leaves
     GEOSContextHandle_t ctx = GEOS_init_r();
     if (ctx == nullptr) {
         LOG_ERROR("Failed to initialize GEOS context for row {}", row_offset);
@@ -70,7 +246,6 @@ RTreeIndexWrapper::add_geometry(const uint8_t* wkb_data,
     }
 
     // Get bounding box
-    double minX, minY, maxX, maxY;
     get_bounding_box(geom, ctx, minX, minY, maxX, maxY);
 
     // Create Boost box and insert
@@ -95,27 +270,38 @@ RTreeIndexWrapper::bulk_load_from_field_data(
 
     AssertInfo(is_build_mode_, "Cannot bulk load in load mode");
 
-    // Initialize GEOS context for bulk operations
-    GEOSContextHandle_t ctx = GEOS_init_r();
-    if (ctx == nullptr) {
-        LOG_ERROR("Failed to initialize GEOS context for bulk load");
-        return;
-    }
-
-    GEOSWKBReader* reader = GEOSWKBReader_create_r(ctx);
-    if (reader == nullptr) {
-        GEOS_finish_r(ctx);
-        LOG_ERROR("Failed to create GEOS WKB reader for bulk load");
-        return;
+    // the envelopes are read in blocks of rows in parallel, each block
+    // keeping its values in row order
+    struct Block {
+        size_t field_data;
+        int64_t begin;
+        int64_t end;
+        int64_t offset;
+    };
+    std::vector<Block> blocks;
+    int64_t absolute_offset = 0;
+    for (size_t f = 0; f < field_datas.size(); ++f) {
+        const auto n = field_datas[f]->get_num_rows();
+        for (int64_t begin = 0; begin < n; begin += kEnvelopeBlockRows) {
+            blocks.push_back({f,
+                              begin,
+                              std::min(n, begin + kEnvelopeBlockRows),
+                              absolute_offset + begin});
+        }
+        absolute_offset += n;
     }
 
-    std::vector<Value> local_values;
-    local_values.reserve(1024);
-    int64_t absolute_offset = 0;
-    for (const auto& fd : field_datas) {
-        const auto n = fd->get_num_rows();
-        for (int64_t i = 0; i < n; ++i, ++absolute_offset) {
-            const bool is_nullable_effective = nullable || fd->IsNullable();
+    std::vector<std::vector<Value>> block_values(blocks.size());
+    ParallelRun(blocks.size(), [&](size_t b) {
+        const auto& block = blocks[b];
+        const auto& fd = field_datas[block.field_data];
+        const bool is_nullable_effective = nullable || fd->IsNullable();
+        // GEOS only for what ReadWkbEnvelope leaves, set up on first use
+        GEOSContextHandle_t ctx = nullptr;
+        GEOSWKBReader* reader = nullptr;
+        auto& values = block_values[b];
+        values.reserve(block.end - block.begin);
+        for (int64_t i = block.begin; i < block.end; ++i) {
             if (is_nullable_effective && !fd->is_valid(i)) {
                 continue;
             }
@@ -124,29 +310,53 @@ RTreeIndexWrapper::bulk_load_from_field_data(
             if (wkb_str == nullptr || wkb_str->empty()) {
                 continue;
             }
-
-            GEOSGeometry* geom = GEOSWKBReader_read_r(
-                ctx,
-                reader,
-                reinterpret_cast<const unsigned char*>(wkb_str->data()),
-                wkb_str->size());
-            if (geom == nullptr) {
-                continue;
-            }
+            const auto* wkb =
+                reinterpret_cast<const unsigned char*>(wkb_str->data());
 
             double minX, minY, maxX, maxY;
-            get_bounding_box(geom, ctx, minX, minY, maxX, maxY);
-            GEOSGeom_destroy_r(ctx, geom);
+            if (!ReadWkbEnvelope(
+                    wkb, wkb_str->size(), minX, minY, maxX, maxY)) {
+                if (ctx == nullptr) {
+                    ctx = GEOS_init_r();
+                    if (ctx != nullptr) {
+                        reader = GEOSWKBReader_create_r(ctx);
+                    }
+                }
+                GEOSGeometry* geom =
+                    reader == nullptr ? nullptr
+                                      : GEOSWKBReader_read_r(
+                                            ctx, reader, wkb, wkb_str->size());
+                if (geom == nullptr) {
+                    continue;
+                }
+                get_bounding_box(geom, ctx, minX, minY, maxX, maxY);
+                GEOSGeom_destroy_r(ctx, geom);
+            }
 
             Box box(Point(minX, minY), Point(maxX, maxY));
-            local_values.emplace_back(box, absolute_offset);
+            values.emplace_back(box, block.offset + (i - block.begin));
         }
-    }
+        if (reader != nullptr) {
+            GEOSWKBReader_destroy_r(ctx, reader);
+        }
+        if (ctx != nullptr) {
+            GEOS_finish_r(ctx);
+        }
+    });
 
-    // Clean up GEOS resources
-    GEOSWKBReader_destroy_r(ctx, reader);
-    GEOS_finish_r(ctx);
+    size_t total = 0;
+    for (const auto& values : block_values) {
+        total += values.size();
+    }
+    std::vector<Value> local_values;
+    local_values.reserve(total);
+    for (auto& values : block_values) {
+        local_values.insert(local_values.end(), values.begin(), values.end());
+        std::vector<Value>().swap(values);
+    }
     values_.swap(local_values);
+    // the range constructor packs the tree bottom up, sorting and tiling
+    // the boxes like STR, instead of inserting them one by one
     rtree_ = RTree(values_.begin(), values_.end());
     LOG_INFO("R-Tree bulk load (Boost) completed with {} entries",
              values_.size());
@@ -30,6 +30,22 @@ namespace milvus::index {
 namespace bg = boost::geometry;
 namespace bgi = boost::geometry::index;
 
+/**
+ * @brief Bounding box of a WKB geometry read straight from its bytes, without
+ *        building a GEOS geometry. Reads ISO and extended WKB of points, line
+ *        strings, polygons, their multi variants and collections in either
+ *        byte order.
+ * @return false for what it does not read (curves, surfaces, empty or
+ *         malformed geometries), which are left to GEOS
+ */
+bool
+ReadWkbEnvelope(const uint8_t* wkb,
+                size_t len,
+                double& minX,
+                double& minY,
+                double& maxX,
+                double& maxY);
+
 /**
  * @brief Wrapper class for boost R-Tree functionality
  * 
@@ -207,4 +207,59 @@ TEST_F(RTreeIndexWrapperTest, TestInvalidWKB) {
     wrapper.add_geometry(invalid_wkb.data(), invalid_wkb.size(), 0);
 
     wrapper.finish();
-}
\ No newline at end of file
+}
+TEST_F(RTreeIndexWrapperTest, TestReadWkbEnvelopeMatchesGeos) {
+    std::vector<std::string> wkts = {
+        "POINT (1.5 -2)",
+        "POINT Z (1 2 3)",
+        "LINESTRING (0 0, 3 4, -1 2)",
+        "POLYGON ((0 0, 10 0, 10 10, 0 10, 0 0), (2 2, 3 2, 3 3, 2 2))",
+        "MULTIPOINT ((1 1), (-4 7))",
+        "MULTILINESTRING ((0 0, 1 1), (5 5, 6 -6))",
+        "MULTIPOLYGON (((0 0, 1 0, 1 1, 0 0)), ((20 20, 21 20, 21 22, 20 20)))",
+        "GEOMETRYCOLLECTION (POINT (9 9), LINESTRING (-3 0, 0 -3))",
+    };
+    GEOSWKBWriter* writer = GEOSWKBWriter_create_r(ctx_);
+    GEOSWKBWriter_setOutputDimension_r(ctx_, writer, 3);
+    for (const auto& wkt : wkts) {
+        milvus::Geometry geom(ctx_, wkt.c_str());
+        double geos_min_x, geos_min_y, geos_max_x, geos_max_y;
+        GEOSGeom_getXMin_r(ctx_, geom.GetGeometry(), &geos_min_x);
+        GEOSGeom_getYMin_r(ctx_, geom.GetGeometry(), &geos_min_y);
+        GEOSGeom_getXMax_r(ctx_, geom.GetGeometry(), &geos_max_x);
+        GEOSGeom_getYMax_r(ctx_, geom.GetGeometry(), &geos_max_y);
+        // both byte orders
+        for (int byte_order : {GEOS_WKB_NDR, GEOS_WKB_XDR}) {
+            GEOSWKBWriter_setByteOrder_r(ctx_, writer, byte_order);
+            size_t size = 0;
+            auto wkb = GEOSWKBWriter_write_r(
+                ctx_, writer, geom.GetGeometry(), &size);
+            ASSERT_NE(wkb, nullptr);
+            double min_x, min_y, max_x, max_y;
+            ASSERT_TRUE(milvus::index::ReadWkbEnvelope(
+                wkb, size, min_x, min_y, max_x, max_y))
+                << wkt;
+            EXPECT_EQ(min_x, geos_min_x) << wkt;
+            EXPECT_EQ(min_y, geos_min_y) << wkt;
+            EXPECT_EQ(max_x, geos_max_x) << wkt;
+            EXPECT_EQ(max_y, geos_max_y) << wkt;
+            // truncated bytes are left to GEOS
+            EXPECT_FALSE(milvus::index::ReadWkbEnvelope(
+                wkb, size - 1, min_x, min_y, max_x, max_y))
+                << wkt;
+            GEOSFree_r(ctx_, wkb);
+        }
+    }
+    GEOSWKBWriter_destroy_r(ctx_, writer);
+
+    milvus::Geometry empty(ctx_, "POINT EMPTY");
+    auto empty_wkb = empty.to_wkb_string();
+    double min_x, min_y, max_x, max_y;
+    EXPECT_FALSE(milvus::index::ReadWkbEnvelope(
+        reinterpret_cast<const uint8_t*>(empty_wkb.data()),
+        empty_wkb.size(),
+        min_x,
+        min_y,
+        max_x,
+        max_y));
+}
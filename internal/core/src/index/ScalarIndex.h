@@ -128,6 +128,17 @@ class ScalarIndex : public IndexBase {
     virtual std::optional<T>
     Reverse_Lookup(size_t offset) const = 0;
 
+    // Reverse_Lookup of count rows at once, values[i] is the value of row
+    // offsets[i]. Indexes that share work between rows override it.
+    virtual void
+    Reverse_Lookup_Batch(const int64_t* offsets,
+                         int64_t count,
+                         std::optional<T>* values) const {
+        for (int64_t i = 0; i < count; ++i) {
+            values[i] = Reverse_Lookup(offsets[i]);
+        }
+    }
+
     virtual const TargetBitmap
     Query(const DatasetPtr& dataset);
 
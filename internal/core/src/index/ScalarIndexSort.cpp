@@ -98,13 +98,14 @@ ScalarIndexSort<T>::Build(size_t n, const T* values, const bool* valid_data) {
         }
     }
 
-    std::sort(data_.begin(), data_.end());
+    ParallelSort(data_.begin(), data_.end());
     for (size_t i = 0; i < data_.size(); ++i) {
         idx_to_offsets_[data_[i].idx_] = i;
     }
     is_built_ = true;
 
     setup_data_pointers();
+    BuildFences();
     ComputeByteSize();
 }
 
@@ -142,7 +143,7 @@ ScalarIndexSort<T>::BuildWithFieldData(
             offset++;
         }
     }
-    std::sort(data_.begin(), data_.end());
+    ParallelSort(data_.begin(), data_.end());
     idx_to_offsets_.resize(total_num_rows_);
     for (size_t i = 0; i < length; ++i) {
         // TODO: there is an existing bug here, data_[i].idx_ is out of range, should be fixed
@@ -154,6 +155,7 @@ ScalarIndexSort<T>::BuildWithFieldData(
     is_built_ = true;
 
     setup_data_pointers();
+    BuildFences();
     ComputeByteSize();
 }
 
@@ -195,7 +197,7 @@ ScalarIndexSort<T>::BuildWithArrayDataNested(
             }
         }
     }
-    std::sort(data_.begin(), data_.end());
+    ParallelSort(data_.begin(), data_.end());
     idx_to_offsets_.resize(total_num_rows_);
     for (size_t i = 0; i < total_num_rows_; ++i) {
         idx_to_offsets_[data_[i].idx_] = i;
@@ -203,6 +205,7 @@ ScalarIndexSort<T>::BuildWithArrayDataNested(
     is_built_ = true;
 
     setup_data_pointers();
+    BuildFences();
 }
 
 template <typename T>
@@ -335,6 +338,7 @@ ScalarIndexSort<T>::LoadWithoutAssemble(const BinarySet& index_binary,
     }
 
     setup_data_pointers();
+    BuildFences();
 
     auto index_num_rows = index_binary.GetByName("index_num_rows");
     if (index_num_rows) {
@@ -390,16 +394,50 @@ ScalarIndexSort<T>::Load(milvus::tracer::TraceContext ctx,
     LoadWithoutAssemble(binary_set, config);
 }
 
+template <typename T>
+void
+ScalarIndexSort<T>::BuildFences() {
+    fences_.clear();
+    fences_.reserve((size_ + kFenceStride - 1) / kFenceStride);
+    for (size_t i = 0; i < size_; i += kFenceStride) {
+        fences_.push_back(data_ptr_[i].a_);
+    }
+}
+
+template <typename T>
+const IndexStructure<T>*
+ScalarIndexSort<T>::LowerBound(T value) const {
+    // fence j is the first value of block j, the bound is in the block before
+    // the first fence not below value, or at that fence
+    size_t block =
+        std::lower_bound(fences_.begin(), fences_.end(), value) -
+        fences_.begin();
+    size_t first = block == 0 ? 0 : (block - 1) * kFenceStride;
+    auto last = std::min(block * kFenceStride, size_);
+    return std::lower_bound(
+        begin() + first, begin() + last, IndexStructure<T>(value));
+}
+
+template <typename T>
+const IndexStructure<T>*
+ScalarIndexSort<T>::UpperBound(T value) const {
+    size_t block =
+        std::upper_bound(fences_.begin(), fences_.end(), value) -
+        fences_.begin();
+    size_t first = block == 0 ? 0 : (block - 1) * kFenceStride;
+    auto last = std::min(block * kFenceStride, size_);
+    return std::upper_bound(
+        begin() + first, begin() + last, IndexStructure<T>(value));
+}
+
 template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::In(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
     TargetBitmap bitset(Count());
     for (size_t i = 0; i < n; ++i) {
-        auto lb =
-            std::lower_bound(begin(), end(), IndexStructure<T>(*(values + i)));
-        auto ub =
-            std::upper_bound(begin(), end(), IndexStructure<T>(*(values + i)));
+        auto lb = LowerBound(*(values + i));
+        auto ub = UpperBound(*(values + i));
         for (; lb < ub; ++lb) {
             if (lb->a_ != *(values + i)) {
                 LOG_ERROR(
@@ -420,10 +458,8 @@ ScalarIndexSort<T>::NotIn(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
     TargetBitmap bitset(Count(), true);
     for (size_t i = 0; i < n; ++i) {
-        auto lb =
-            std::lower_bound(begin(), end(), IndexStructure<T>(*(values + i)));
-        auto ub =
-            std::upper_bound(begin(), end(), IndexStructure<T>(*(values + i)));
+        auto lb = LowerBound(*(values + i));
+        auto ub = UpperBound(*(values + i));
         for (; lb < ub; ++lb) {
             if (lb->a_ != *(values + i)) {
                 LOG_ERROR(
@@ -471,16 +507,16 @@ ScalarIndexSort<T>::Range(const T value, const OpType op) {
     }
     switch (op) {
         case OpType::LessThan:
-            ub = std::lower_bound(begin(), end(), IndexStructure<T>(value));
+            ub = LowerBound(value);
             break;
         case OpType::LessEqual:
-            ub = std::upper_bound(begin(), end(), IndexStructure<T>(value));
+            ub = UpperBound(value);
             break;
         case OpType::GreaterThan:
-            lb = std::upper_bound(begin(), end(), IndexStructure<T>(value));
+            lb = UpperBound(value);
             break;
         case OpType::GreaterEqual:
-            lb = std::lower_bound(begin(), end(), IndexStructure<T>(value));
+            lb = LowerBound(value);
             break;
         default:
             ThrowInfo(OpTypeInvalid,
@@ -532,18 +568,14 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
     auto lb = begin();
     auto ub = end();
     if (lb_inclusive) {
-        lb = std::lower_bound(
-            begin(), end(), IndexStructure<T>(lower_bound_value));
+        lb = LowerBound(lower_bound_value);
     } else {
-        lb = std::upper_bound(
-            begin(), end(), IndexStructure<T>(lower_bound_value));
+        lb = UpperBound(lower_bound_value);
     }
     if (ub_inclusive) {
-        ub = std::upper_bound(
-            begin(), end(), IndexStructure<T>(upper_bound_value));
+        ub = UpperBound(upper_bound_value);
     } else {
-        ub = std::lower_bound(
-            begin(), end(), IndexStructure<T>(upper_bound_value));
+        ub = LowerBound(upper_bound_value);
     }
 
     size_t hit_count = ub - lb;
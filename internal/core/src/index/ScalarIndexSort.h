@@ -135,6 +135,8 @@ class ScalarIndexSort : public ScalarIndex<T> {
         // valid_bitset_: TargetBitmap
         total += valid_bitset_.size_in_bytes();
 
+        total += fences_.capacity() * sizeof(T);
+
         if (is_mmap_) {
             // mmap mode: add mmap size and filepath
             total += mmap_size_;
@@ -164,6 +166,18 @@ class ScalarIndexSort : public ScalarIndex<T> {
     bool
     ShouldSkip(const T lower_value, const T upper_value, const OpType op);
 
+    // samples every kFenceStride-th value of the sorted data into fences_
+    void
+    BuildFences();
+
+    // std::lower_bound and std::upper_bound of value in [begin(), end()), the
+    // fences narrow the search to a block before it reads the data
+    const IndexStructure<T>*
+    LowerBound(T value) const;
+
+    const IndexStructure<T>*
+    UpperBound(T value) const;
+
  public:
     const IndexStructure<T>*
     GetData() {
@@ -247,6 +261,12 @@ class ScalarIndexSort : public ScalarIndex<T> {
     mutable const IndexStructure<T>* end_ptr_ = nullptr;
     mutable size_t size_ = 0;
 
+    // a block of entries spans a few cache lines, and the fences of even a
+    // large index stay in cache, so a search misses it a few times instead
+    // of at every halving of the data
+    static constexpr size_t kFenceStride = 64;
+    std::vector<T> fences_;
+
     std::chrono::time_point<std::chrono::system_clock> index_build_begin_;
 };
 
@@ -88,4 +88,50 @@ TEST(StlSortIndexTest, TestIn) {
 
     test_stlsort_for_range(
         data, DataType::INT64, true, exec_expr, expected_result);
-}
\ No newline at end of file
+}
+TEST(StlSortIndexTest, TestBoundsAcrossBlocks) {
+    using IndexPtr = std::shared_ptr<ScalarIndexSort<int64_t>>;
+    // runs of equal values longer than a block, and sizes around one
+    for (size_t nb : {1, 63, 64, 65, 1000}) {
+        std::vector<int64_t> data(nb);
+        for (size_t i = 0; i < nb; i++) {
+            data[i] = static_cast<int64_t>((i * 7919) % nb) / 97;
+        }
+        for (bool enable_mmap : {false, true}) {
+            for (int64_t value = -1; value <= 12; value++) {
+                std::vector<bool> expected_less(nb);
+                std::vector<bool> expected_range(nb);
+                std::vector<bool> expected_in(nb);
+                for (size_t i = 0; i < nb; i++) {
+                    expected_less[i] = data[i] < value;
+                    expected_range[i] = value < data[i] && data[i] <= value + 3;
+                    expected_in[i] = data[i] == value;
+                }
+                test_stlsort_for_range(
+                    data,
+                    DataType::INT64,
+                    enable_mmap,
+                    [&](const IndexPtr& index) {
+                        return index->Range(value, OpType::LessThan);
+                    },
+                    expected_less);
+                test_stlsort_for_range(
+                    data,
+                    DataType::INT64,
+                    enable_mmap,
+                    [&](const IndexPtr& index) {
+                        return index->Range(value, false, value + 3, true);
+                    },
+                    expected_range);
+                test_stlsort_for_range(
+                    data,
+                    DataType::INT64,
+                    enable_mmap,
+                    [&](const IndexPtr& index) {
+                        return index->In(1, &value);
+                    },
+                    expected_in);
+            }
+        }
+    }
+}
@@ -11,8 +11,14 @@
 
 #include "SkipIndex.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include "cachinglayer/CacheSlot.h"
 #include "cachinglayer/Utils.h"
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+#include "common/File.h"
 
 namespace milvus {
 
@@ -34,6 +40,66 @@ SkipIndex::GetFieldChunkMetrics(milvus::FieldId field_id, int chunk_id) const {
         &defaultFieldChunkMetrics);
 }
 
+CandidatePages
+SkipIndex::GetCandidatePages(FieldId field_id,
+                             int64_t chunk_id,
+                             const PageSkipFunc& can_skip) const {
+    CandidatePages result;
+    auto pw = GetFieldChunkMetrics(field_id, chunk_id);
+    const auto& page_metrics = pw.get()->GetPageMetrics();
+    if (page_metrics == nullptr) {
+        return result;
+    }
+    const auto& pages = page_metrics->pages;
+    result.page_rows = page_metrics->page_rows;
+    result.candidates = TargetBitmap(pages.size(), true);
+    for (size_t i = 0; i < pages.size(); i++) {
+        if (can_skip(*pages[i])) {
+            result.candidates[i] = false;
+        }
+    }
+    return result;
+}
+
+void
+SkipIndex::LoadSkipFromFile(int64_t segment_id,
+                            milvus::FieldId field_id,
+                            milvus::DataType data_type,
+                            const std::string& path) {
+    auto file = File::Open(path, O_RDONLY);
+    struct stat st;
+    if (fstat(file.Descriptor(), &st) != 0) {
+        ThrowInfo(FileReadFailed,
+                  "failed to stat skip index stats {}: {}",
+                  path,
+                  strerror(errno));
+    }
+    const auto size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+        file.Close();
+        LoadSkipFromSerialized(
+            segment_id, field_id, data_type, nullptr, 0, nullptr);
+        return;
+    }
+    auto data =
+        mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.Descriptor(), 0);
+    file.Close();
+    if (data == MAP_FAILED) {
+        ThrowInfo(FileReadFailed,
+                  "failed to mmap skip index stats {}: {}",
+                  path,
+                  strerror(errno));
+    }
+    std::shared_ptr<const void> mapping(
+        data, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+    LoadSkipFromSerialized(segment_id,
+                           field_id,
+                           data_type,
+                           static_cast<const uint8_t*>(data),
+                           size,
+                           std::move(mapping));
+}
+
 std::vector<std::pair<milvus::cachinglayer::cid_t,
                       std::unique_ptr<index::FieldChunkMetrics>>>
 FieldChunkMetricsTranslator::get_cells(
@@ -43,9 +109,14 @@ FieldChunkMetricsTranslator::get_cells(
                           std::unique_ptr<index::FieldChunkMetrics>>>
         cells;
     cells.reserve(cids.size());
+    const auto page_rows = SKIPINDEX_PAGE_ROWS.load();
     for (auto chunk_id : cids) {
         auto pw = column_->GetChunk(nullptr, chunk_id);
         auto chunk_metrics = builder_.Build(data_type_, pw.get());
+        if (page_rows > 0) {
+            chunk_metrics->SetPageMetrics(
+                builder_.BuildPages(data_type_, pw.get(), page_rows));
+        }
         cells.emplace_back(chunk_id, std::move(chunk_metrics));
     }
     return cells;
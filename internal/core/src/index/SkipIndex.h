@@ -12,6 +12,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 
 #include "cachinglayer/CacheSlot.h"
@@ -25,6 +26,16 @@
 #include "index/skipindex_stats/SkipIndexStats.h"
 
 namespace milvus {
+
+// Pages of a chunk that may hold rows passing a filter, see
+// SkipIndex::GetCandidatePages().
+struct CandidatePages {
+    // 0 if the chunk has no page metrics, then every row is a candidate
+    int64_t page_rows = 0;
+    // bit i is unset if page i holds no passing row
+    TargetBitmap candidates;
+};
+
 class FieldChunkMetricsTranslatorFromStatistics
     : public cachinglayer::Translator<index::FieldChunkMetrics> {
  public:
@@ -46,6 +57,26 @@ class FieldChunkMetricsTranslatorFromStatistics
         }
     }
 
+    // Cells from 'size' bytes of index::SerializeSkipIndexStats() output,
+    // bloom filters are probed in place while 'owner' keeps 'data' alive.
+    FieldChunkMetricsTranslatorFromStatistics(
+        int64_t segment_id,
+        FieldId field_id,
+        milvus::DataType data_type,
+        const uint8_t* data,
+        size_t size,
+        std::shared_ptr<const void> owner)
+        : key_(fmt::format("skip_seg_{}_f_{}", segment_id, field_id.get())),
+          data_type_(data_type),
+          meta_(cachinglayer::StorageType::MEMORY,
+                milvus::cachinglayer::CellIdMappingMode::IDENTICAL,
+                milvus::cachinglayer::CellDataType::OTHER,
+                CacheWarmupPolicy::CacheWarmupPolicy_Disable,
+                false),
+          cells_(index::LoadSkipIndexStats(
+              data_type, data, size, std::move(owner))) {
+    }
+
     size_t
     num_cells() const override {
         return cells_.size();
@@ -78,7 +109,9 @@ class FieldChunkMetricsTranslatorFromStatistics
             cells;
         cells.reserve(cids.size());
         for (auto cid : cids) {
-            cells.emplace_back(cid, cells_[cid]->Clone());
+            auto cell = cells_[cid]->Clone();
+            cell->SetPageMetrics(cells_[cid]->GetPageMetrics());
+            cells.emplace_back(cid, std::move(cell));
         }
         return cells;
     }
@@ -235,6 +268,67 @@ class SkipIndex {
         return false;
     }
 
+    // Candidate pages of the chunk for 'field op_type val'.
+    template <typename T>
+    std::enable_if_t<SkipIndex::IsAllowedType<T>::value, CandidatePages>
+    GetCandidatePagesUnaryRange(FieldId field_id,
+                                int64_t chunk_id,
+                                OpType op_type,
+                                const T& val) const {
+        const index::Metrics metrics{val};
+        return GetCandidatePages(
+            field_id, chunk_id, [&](const index::FieldChunkMetrics& page) {
+                return page.CanSkipUnaryRange(op_type, metrics);
+            });
+    }
+
+    template <typename T>
+    std::enable_if_t<!SkipIndex::IsAllowedType<T>::value, CandidatePages>
+    GetCandidatePagesUnaryRange(FieldId field_id,
+                                int64_t chunk_id,
+                                OpType op_type,
+                                const T& val) const {
+        return {};
+    }
+
+    // Candidate pages of the chunk for 'lower_val < field < upper_val'.
+    template <typename T>
+    std::enable_if_t<SkipIndex::IsAllowedType<T>::value, CandidatePages>
+    GetCandidatePagesBinaryRange(FieldId field_id,
+                                 int64_t chunk_id,
+                                 const T& lower_val,
+                                 const T& upper_val,
+                                 bool lower_inclusive,
+                                 bool upper_inclusive) const {
+        const index::Metrics lower{lower_val};
+        const index::Metrics upper{upper_val};
+        return GetCandidatePages(
+            field_id, chunk_id, [&](const index::FieldChunkMetrics& page) {
+                return page.CanSkipBinaryRange(
+                    lower, upper, lower_inclusive, upper_inclusive);
+            });
+    }
+
+    template <typename T>
+    std::enable_if_t<!SkipIndex::IsAllowedType<T>::value, CandidatePages>
+    GetCandidatePagesBinaryRange(FieldId field_id,
+                                 int64_t chunk_id,
+                                 const T& lower_val,
+                                 const T& upper_val,
+                                 bool lower_inclusive,
+                                 bool upper_inclusive) const {
+        return {};
+    }
+
+    // Pages of the chunk that 'can_skip' does not rule out, checked against
+    // the metrics of every page.
+    using PageSkipFunc = std::function<bool(const index::FieldChunkMetrics&)>;
+
+    CandidatePages
+    GetCandidatePages(FieldId field_id,
+                      int64_t chunk_id,
+                      const PageSkipFunc& can_skip) const;
+
     template <typename T>
     std::enable_if_t<SkipIndex::IsAllowedType<T>::arith_value, bool>
     CanSkipBinaryArithRange(FieldId field_id,
@@ -312,14 +406,7 @@ class SkipIndex {
     CanSkipInQuery(FieldId field_id,
                    int64_t chunk_id,
                    const std::vector<T>& values) const {
-        auto pw = GetFieldChunkMetrics(field_id, chunk_id);
-        auto field_chunk_metrics = pw.get();
-        auto vals = std::vector<index::Metrics>{};
-        vals.reserve(values.size());
-        for (const auto& v : values) {
-            vals.emplace_back(v);
-        }
-        return field_chunk_metrics->CanSkipIn(vals);
+        return CanSkipIn(field_id, chunk_id, ToMetrics(values));
     }
 
     template <typename T>
@@ -330,6 +417,64 @@ class SkipIndex {
         return false;
     }
 
+    // Same as CanSkipInQuery() with the values converted already, for callers
+    // that test one list against many chunks.
+    bool
+    CanSkipIn(FieldId field_id,
+              int64_t chunk_id,
+              const std::vector<index::Metrics>& values) const {
+        auto pw = GetFieldChunkMetrics(field_id, chunk_id);
+        return pw.get()->CanSkipIn(values);
+    }
+
+    // Whether some of 'values' is in no row of the chunk, the chunk can not
+    // hold rows with all of them then.
+    bool
+    CanSkipAllOf(FieldId field_id,
+                 int64_t chunk_id,
+                 const std::vector<index::Metrics>& values) const {
+        auto pw = GetFieldChunkMetrics(field_id, chunk_id);
+        for (const auto& v : values) {
+            if (pw.get()->CanSkipUnaryRange(OpType::Equal, v)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The metrics of the chunk pinned once, for callers probing it with many
+    // values one at a time.
+    cachinglayer::PinWrapper<const index::FieldChunkMetrics*>
+    PinFieldChunkMetrics(FieldId field_id, int64_t chunk_id) const {
+        return GetFieldChunkMetrics(field_id, chunk_id);
+    }
+
+    // The least and greatest values of the chunk, nullopt without metrics
+    // of them.
+    template <typename T>
+    std::optional<std::pair<T, T>>
+    GetMinMax(FieldId field_id, int64_t chunk_id) const {
+        auto pw = GetFieldChunkMetrics(field_id, chunk_id);
+        auto min_max = pw.get()->GetMinMax();
+        if (!min_max.has_value() ||
+            !std::holds_alternative<T>(min_max->first)) {
+            return std::nullopt;
+        }
+        return std::make_pair(std::get<T>(min_max->first),
+                              std::get<T>(min_max->second));
+    }
+
+    template <typename T>
+    static std::vector<index::Metrics>
+    ToMetrics(const std::vector<T>& values) {
+        std::vector<index::Metrics> metrics;
+        metrics.reserve(values.size());
+        for (const auto& v : values) {
+            metrics.emplace_back(v);
+        }
+        return metrics;
+    }
+
     void
     LoadSkip(int64_t segment_id,
              milvus::FieldId field_id,
@@ -362,6 +507,34 @@ class SkipIndex {
         fieldChunkMetrics_[field_id] = std::move(cache_slot);
     }
 
+    // Loads metrics serialized by index::SerializeSkipIndexStats(), see
+    // FieldChunkMetricsTranslatorFromStatistics.
+    void
+    LoadSkipFromSerialized(int64_t segment_id,
+                           milvus::FieldId field_id,
+                           milvus::DataType data_type,
+                           const uint8_t* data,
+                           size_t size,
+                           std::shared_ptr<const void> owner) {
+        auto translator =
+            std::make_unique<FieldChunkMetricsTranslatorFromStatistics>(
+                segment_id, field_id, data_type, data, size, std::move(owner));
+        auto cache_slot = cachinglayer::Manager::GetInstance()
+                              .CreateCacheSlot<index::FieldChunkMetrics>(
+                                  std::move(translator));
+
+        std::unique_lock lck(mutex_);
+        fieldChunkMetrics_[field_id] = std::move(cache_slot);
+    }
+
+    // Maps the serialized metrics at 'path' read only, the bloom filters
+    // keep the mapping alive.
+    void
+    LoadSkipFromFile(int64_t segment_id,
+                     milvus::FieldId field_id,
+                     milvus::DataType data_type,
+                     const std::string& path);
+
  private:
     OpType
     FlipComparisonOperator(OpType op) const {
@@ -17,8 +17,10 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <stdlib.h>
 #include <stdio.h>
@@ -68,14 +70,9 @@ StringIndexMarisa::ComputeByteSize() {
     // str_ids_: vector<int64_t>
     total += str_ids_.capacity() * sizeof(int64_t);
 
-    // str_ids_to_offsets_: map<size_t, vector<size_t>>
-    for (const auto& [key, vec] : str_ids_to_offsets_) {
-        total += sizeof(size_t);                   // key
-        total += vec.capacity() * sizeof(size_t);  // vector capacity
-        total += sizeof(std::vector<size_t>);      // vector object overhead
-    }
-    // Map node overhead (rough estimate: ~40 bytes per node for std::map)
-    total += str_ids_to_offsets_.size() * 40;
+    // key_rows_begin_ and key_rows_
+    total += key_rows_begin_.capacity() * sizeof(size_t);
+    total += key_rows_.capacity() * sizeof(int32_t);
 
     cached_byte_size_ = total;
 }
@@ -92,11 +89,9 @@ StringIndexMarisa::CalculateTotalSize() const {
     // Size of str_ids_ vector (main data structure)
     size += str_ids_.size() * sizeof(int64_t);
 
-    // Size of str_ids_to_offsets_ map data
-    for (const auto& [key, vec] : str_ids_to_offsets_) {
-        size += sizeof(size_t);               // key
-        size += vec.size() * sizeof(size_t);  // vector data
-    }
+    // Size of the rows of each key
+    size += key_rows_begin_.size() * sizeof(size_t);
+    size += key_rows_.size() * sizeof(int32_t);
 
     return size;
 }
@@ -153,7 +148,7 @@ StringIndexMarisa::BuildWithFieldData(
         }
     }
 
-    // fill str_ids_to_offsets_
+    // fill the rows of each key
     fill_offsets();
 
     built_ = true;
@@ -309,10 +304,7 @@ StringIndexMarisa::In(size_t n, const std::string* values) {
         auto str = values[i];
         auto str_id = lookup(str);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset[offset] = true;
-            }
+            set_rows(str_id, bitset);
         }
     }
     return bitset;
@@ -326,10 +318,7 @@ StringIndexMarisa::NotIn(size_t n, const std::string* values) {
         auto str = values[i];
         auto str_id = lookup(str);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset[offset] = false;
-            }
+            set_rows(str_id, bitset, false);
         }
     }
     // NotIn(null) and In(null) is both false, need to mask with IsNotNull operate
@@ -491,10 +480,7 @@ StringIndexMarisa::Range(std::string value, OpType op) {
     }
 
     for (const auto str_id : ids) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
-            bitset[offset] = true;
-        }
+        set_rows(str_id, bitset);
     }
     return bitset;
 }
@@ -545,10 +531,7 @@ StringIndexMarisa::Range(std::string lower_bound_value,
         }
     }
     for (const auto str_id : ids) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
-            bitset[offset] = true;
-        }
+        set_rows(str_id, bitset);
     }
 
     return bitset;
@@ -561,10 +544,7 @@ StringIndexMarisa::PrefixMatch(std::string_view prefix) {
     TargetBitmap bitset(str_ids_.size());
     auto matched = prefix_match(prefix);
     for (const auto str_id : matched) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
-            bitset[offset] = true;
-        }
+        set_rows(str_id, bitset);
     }
     return bitset;
 }
@@ -587,12 +567,34 @@ StringIndexMarisa::fill_str_ids(size_t n,
 
 void
 StringIndexMarisa::fill_offsets() {
+    // a counting sort of the rows by key id, null rows are left out
+    key_rows_begin_.assign(trie_.num_keys() + 1, 0);
+    for (auto str_id : str_ids_) {
+        if (str_id >= 0) {
+            ++key_rows_begin_[str_id + 1];
+        }
+    }
+    std::partial_sum(key_rows_begin_.begin(),
+                     key_rows_begin_.end(),
+                     key_rows_begin_.begin());
+    key_rows_.resize(key_rows_begin_.back());
+    std::vector<size_t> next(key_rows_begin_.begin(),
+                             key_rows_begin_.end() - 1);
     for (size_t offset = 0; offset < str_ids_.size(); offset++) {
         auto str_id = str_ids_[offset];
-        if (str_ids_to_offsets_.find(str_id) == str_ids_to_offsets_.end()) {
-            str_ids_to_offsets_[str_id] = std::vector<size_t>{};
+        if (str_id >= 0) {
+            key_rows_[next[str_id]++] = static_cast<int32_t>(offset);
         }
-        str_ids_to_offsets_[str_id].push_back(offset);
+    }
+}
+
+void
+StringIndexMarisa::set_rows(size_t str_id,
+                            TargetBitmap& bitset,
+                            bool value) const {
+    for (auto i = key_rows_begin_[str_id]; i < key_rows_begin_[str_id + 1];
+         ++i) {
+        bitset[key_rows_[i]] = value;
     }
 }
 
@@ -634,6 +636,41 @@ StringIndexMarisa::Reverse_Lookup(size_t offset) const {
     return std::string(agent.key().ptr(), agent.key().length());
 }
 
+void
+StringIndexMarisa::Reverse_Lookup_Batch(
+    const int64_t* offsets,
+    int64_t count,
+    std::optional<std::string>* values) const {
+    tracer::AutoSpan span("StringIndexMarisa::Reverse_Lookup_Batch",
+                          tracer::GetRootSpan());
+    // (key id, i) of the rows that are not null
+    std::vector<std::pair<int64_t, int64_t>> keys;
+    keys.reserve(count);
+    for (int64_t i = 0; i < count; ++i) {
+        AssertInfo(offsets[i] >= 0 &&
+                       static_cast<size_t>(offsets[i]) < str_ids_.size(),
+                   "out of range of total count");
+        auto str_id = str_ids_[offsets[i]];
+        if (str_id < 0) {
+            values[i] = std::nullopt;
+        } else {
+            keys.emplace_back(str_id, i);
+        }
+    }
+    // rows of the same key are looked up once, and the keys in id order
+    // walk neighbouring parts of the trie in turn
+    std::sort(keys.begin(), keys.end());
+    marisa::Agent agent;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        if (k == 0 || keys[k].first != keys[k - 1].first) {
+            agent.set_query(static_cast<size_t>(keys[k].first));
+            trie_.reverse_lookup(agent);
+        }
+        values[keys[k].second].emplace(agent.key().ptr(),
+                                       agent.key().length());
+    }
+}
+
 bool
 StringIndexMarisa::in_lexicographic_order() {
     // by default, marisa trie uses `MARISA_WEIGHT_ORDER` to build trie
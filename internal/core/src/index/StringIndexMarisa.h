@@ -20,7 +20,6 @@
 #include "index/StringIndex.h"
 #include <string>
 #include <vector>
-#include <map>
 #include <memory>
 #include "storage/MemFileManagerImpl.h"
 
@@ -95,6 +94,12 @@ class StringIndexMarisa : public StringIndex {
     std::optional<std::string>
     Reverse_Lookup(size_t offset) const override;
 
+    // looks each distinct key up once, in key id order
+    void
+    Reverse_Lookup_Batch(const int64_t* offsets,
+                         int64_t count,
+                         std::optional<std::string>* values) const override;
+
     IndexStatsPtr
     Upload(const Config& config = {}) override;
 
@@ -110,6 +115,10 @@ class StringIndexMarisa : public StringIndex {
     void
     fill_offsets();
 
+    // sets the rows of str_id in bitset to value
+    void
+    set_rows(size_t str_id, TargetBitmap& bitset, bool value = true) const;
+
     // get str_id by str, if str not found, -1 was returned.
     size_t
     lookup(const std::string_view str);
@@ -137,7 +146,10 @@ class StringIndexMarisa : public StringIndex {
     Config config_;
     marisa::Trie trie_;
     std::vector<int64_t> str_ids_;  // used to retrieve.
-    std::map<size_t, std::vector<size_t>> str_ids_to_offsets_;
+    // the rows of key id k, ascending, are
+    // key_rows_[key_rows_begin_[k], key_rows_begin_[k + 1])
+    std::vector<size_t> key_rows_begin_;
+    std::vector<int32_t> key_rows_;
     bool built_ = false;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     int64_t total_size_ = 0;  // Cached total size to avoid runtime calculation
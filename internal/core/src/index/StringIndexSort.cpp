@@ -454,6 +454,13 @@ StringIndexSort::Reverse_Lookup(size_t offset) const {
         offset, total_num_rows_, valid_bitset_, idx_to_offsets_);
 }
 
+void
+StringIndexSort::ForEachRowInOrder(
+    bool ascending, const std::function<bool(int64_t)>& func) const {
+    assert(impl_ != nullptr);
+    impl_->ForEachRowInOrder(ascending, func);
+}
+
 int64_t
 StringIndexSort::Size() {
     return total_size_;
@@ -494,31 +501,195 @@ StringIndexSort::ComputeByteSize() {
     cached_byte_size_ = total;
 }
 
+namespace {
+
+void
+WriteVarint(std::vector<uint8_t>& out, size_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+size_t
+ReadVarint(const uint8_t*& ptr) {
+    size_t value = 0;
+    for (int shift = 0;; shift += 7) {
+        auto byte = *ptr++;
+        value |= static_cast<size_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            return value;
+        }
+    }
+}
+
+}  // namespace
+
 void
-StringIndexSortMemoryImpl::BuildFromMap(
-    std::map<std::string, PostingList>&& map,
+FrontCodedStrings::Append(std::string_view value) {
+    if (size_ % kBlockSize == 0) {
+        AssertInfo(data_.size() <= std::numeric_limits<uint32_t>::max(),
+                   "front coded strings exceed {} bytes",
+                   std::numeric_limits<uint32_t>::max());
+        block_offsets_.push_back(static_cast<uint32_t>(data_.size()));
+        WriteVarint(data_, value.size());
+        data_.insert(data_.end(), value.begin(), value.end());
+    } else {
+        auto mismatch = std::mismatch(
+            last_.begin(), last_.end(), value.begin(), value.end());
+        auto shared = mismatch.first - last_.begin();
+        WriteVarint(data_, shared);
+        WriteVarint(data_, value.size() - shared);
+        data_.insert(data_.end(), value.begin() + shared, value.end());
+    }
+    last_.assign(value);
+    ++size_;
+}
+
+void
+FrontCodedStrings::Finish() {
+    std::string().swap(last_);
+    data_.shrink_to_fit();
+    block_offsets_.shrink_to_fit();
+}
+
+void
+FrontCodedStrings::Clear() {
+    data_.clear();
+    block_offsets_.clear();
+    size_ = 0;
+    last_.clear();
+}
+
+const uint8_t*
+FrontCodedStrings::DecodeNext(const uint8_t* ptr,
+                              bool head,
+                              std::string& value) {
+    if (head) {
+        auto len = ReadVarint(ptr);
+        value.assign(reinterpret_cast<const char*>(ptr), len);
+        return ptr + len;
+    }
+    auto shared = ReadVarint(ptr);
+    auto len = ReadVarint(ptr);
+    value.resize(shared);
+    value.append(reinterpret_cast<const char*>(ptr), len);
+    return ptr + len;
+}
+
+std::string_view
+FrontCodedStrings::Head(size_t block) const {
+    auto ptr = data_.data() + block_offsets_[block];
+    auto len = ReadVarint(ptr);
+    return {reinterpret_cast<const char*>(ptr), len};
+}
+
+std::string
+FrontCodedStrings::Get(size_t idx) const {
+    AssertInfo(idx < size_, "index {} out of {} strings", idx, size_);
+    std::string value;
+    auto ptr = data_.data() + block_offsets_[idx / kBlockSize];
+    for (size_t i = 0; i <= idx % kBlockSize; ++i) {
+        ptr = DecodeNext(ptr, i == 0, value);
+    }
+    return value;
+}
+
+size_t
+FrontCodedStrings::FindBlock(std::string_view value, bool upper) const {
+    size_t left = 0, right = block_offsets_.size();
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        auto head = Head(mid);
+        if (upper ? head <= value : head < value) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+size_t
+FrontCodedStrings::Bound(std::string_view value, bool upper) const {
+    auto block = FindBlock(value, upper);
+    if (block == 0) {
+        return 0;
+    }
+    // the bound is in the block before, or is the head of this one
+    auto begin = (block - 1) * kBlockSize;
+    auto end = std::min(begin + kBlockSize, size_);
+    auto bound = end;
+    ForEach(begin, end, [&](size_t idx, const std::string& str) {
+        if (bound == end && (upper ? str > value : str >= value)) {
+            bound = idx;
+        }
+    });
+    return bound;
+}
+
+size_t
+FrontCodedStrings::LowerBound(std::string_view value) const {
+    return Bound(value, false);
+}
+
+size_t
+FrontCodedStrings::UpperBound(std::string_view value) const {
+    return Bound(value, true);
+}
+
+size_t
+FrontCodedStrings::Find(std::string_view value) const {
+    auto block = FindBlock(value, true);
+    if (block == 0) {
+        return size_;
+    }
+    auto begin = (block - 1) * kBlockSize;
+    auto found = size_;
+    ForEach(begin, begin + kBlockSize, [&](size_t idx, const std::string& str) {
+        if (str == value) {
+            found = idx;
+        }
+    });
+    return found;
+}
+
+size_t
+FrontCodedStrings::ByteSize() const {
+    return data_.capacity() + block_offsets_.capacity() * sizeof(uint32_t) +
+           last_.capacity();
+}
+
+void
+StringIndexSortMemoryImpl::BuildFromEntries(
+    std::vector<Entry>&& entries,
     size_t total_num_rows,
     std::vector<int32_t>& idx_to_offsets) {
-    unique_values_.clear();
+    // sorting by (value, row id) groups the rows of a value in order
+    ParallelSort(entries.begin(), entries.end());
+
+    unique_values_.Clear();
     posting_lists_.clear();
-    unique_values_.reserve(map.size());
-    posting_lists_.reserve(map.size());
 
     // Initialize idx_to_offsets
     idx_to_offsets.resize(total_num_rows);
     std::fill(idx_to_offsets.begin(), idx_to_offsets.end(), -1);
 
-    // Convert map to vectors (map is already sorted)
     size_t unique_idx = 0;
-    for (auto& [value, posting_list] : map) {
-        // Map each row_id to its unique value index
-        for (uint32_t row_id : posting_list) {
-            idx_to_offsets[row_id] = unique_idx;
+    for (size_t i = 0; i < entries.size(); ++unique_idx) {
+        auto value = entries[i].first;
+        PostingList posting_list;
+        for (; i < entries.size() && entries[i].first == value; ++i) {
+            // Map each row_id to its unique value index
+            idx_to_offsets[entries[i].second] = unique_idx;
+            posting_list.push_back(entries[i].second);
         }
-        unique_values_.push_back(std::move(value));
+        unique_values_.Append(value);
         posting_lists_.push_back(std::move(posting_list));
-        unique_idx++;
     }
+    unique_values_.Finish();
+    posting_lists_.shrink_to_fit();
 }
 
 void
@@ -528,17 +699,17 @@ StringIndexSortMemoryImpl::BuildFromRawData(
     const bool* valid_data,
     TargetBitmap& valid_bitset,
     std::vector<int32_t>& idx_to_offsets) {
-    // Use map to collect unique values and their posting lists
-    std::map<std::string, PostingList> map;
+    std::vector<Entry> entries;
+    entries.reserve(n);
 
     for (size_t i = 0; i < n; ++i) {
         if (!valid_data || valid_data[i]) {
-            map[values[i]].push_back(static_cast<uint32_t>(i));
+            entries.emplace_back(values[i], static_cast<uint32_t>(i));
             valid_bitset.set(i);
         }
     }
 
-    BuildFromMap(std::move(map), n, idx_to_offsets);
+    BuildFromEntries(std::move(entries), n, idx_to_offsets);
 }
 
 void
@@ -547,9 +718,8 @@ StringIndexSortMemoryImpl::BuildFromFieldData(
     size_t total_num_rows,
     TargetBitmap& valid_bitset,
     std::vector<int32_t>& idx_to_offsets) {
-    // Use map to collect unique values and their posting lists
-    // std::map is sorted
-    std::map<std::string, PostingList> map;
+    std::vector<Entry> entries;
+    entries.reserve(total_num_rows);
 
     size_t row_id = 0;
     for (const auto& field_data : field_datas) {
@@ -558,14 +728,14 @@ StringIndexSortMemoryImpl::BuildFromFieldData(
             if (field_data->is_valid(i)) {
                 auto value = reinterpret_cast<const std::string*>(
                     field_data->RawValue(i));
-                map[*value].push_back(static_cast<int32_t>(row_id));
+                entries.emplace_back(*value, static_cast<uint32_t>(row_id));
                 valid_bitset.set(row_id);
             }
             row_id++;
         }
     }
 
-    BuildFromMap(std::move(map), total_num_rows, idx_to_offsets);
+    BuildFromEntries(std::move(entries), total_num_rows, idx_to_offsets);
 }
 
 void
@@ -574,9 +744,8 @@ StringIndexSortMemoryImpl::BuildFromArrayDataNested(
     size_t total_num_rows,
     TargetBitmap& valid_bitset,
     std::vector<int32_t>& idx_to_offsets) {
-    // Use map to collect unique values and their posting lists
-    // std::map is sorted
-    std::map<std::string, PostingList> map;
+    std::vector<Entry> entries;
+    entries.reserve(total_num_rows);
     size_t element_id = 0;
     for (const auto& field_data : field_datas) {
         auto n = field_data->get_num_rows();
@@ -586,14 +755,16 @@ StringIndexSortMemoryImpl::BuildFromArrayDataNested(
                 continue;
             }
             for (int64_t j = 0; j < array_column[i].length(); j++) {
-                auto value = array_column[i].get_data<std::string>(j);
-                map[value].push_back(static_cast<int32_t>(element_id));
+                // views into the array data, alive during the build
+                auto value = array_column[i].get_data<std::string_view>(j);
+                entries.emplace_back(value,
+                                     static_cast<uint32_t>(element_id));
                 valid_bitset.set(element_id);
                 element_id++;
             }
         }
     }
-    BuildFromMap(std::move(map), total_num_rows, idx_to_offsets);
+    BuildFromEntries(std::move(entries), total_num_rows, idx_to_offsets);
 }
 
 size_t
@@ -604,10 +775,11 @@ StringIndexSortMemoryImpl::GetSerializedSize() const {
     total_size += unique_values_.size() * sizeof(uint32_t);
 
     // String data section
-    for (size_t i = 0; i < unique_values_.size(); ++i) {
-        total_size += sizeof(uint32_t);          // str_len
-        total_size += unique_values_[i].size();  // string content
-    }
+    unique_values_.ForEach(
+        0, unique_values_.size(), [&](size_t, const std::string& value) {
+            total_size += sizeof(uint32_t);  // str_len
+            total_size += value.size();      // string content
+        });
 
     // Posting list offsets array
     total_size += posting_lists_.size() * sizeof(uint32_t);
@@ -643,17 +815,18 @@ StringIndexSortMemoryImpl::SerializeToBinary(uint8_t* ptr,
     string_offsets.reserve(unique_count);
 
     // Write string data section
-    for (size_t i = 0; i < unique_values_.size(); ++i) {
-        string_offsets.push_back(
-            static_cast<uint32_t>(offset - string_data_start));
-
-        // Write string length and content
-        uint32_t str_len = static_cast<uint32_t>(unique_values_[i].size());
-        memcpy(ptr + offset, &str_len, sizeof(uint32_t));
-        offset += sizeof(uint32_t);
-        memcpy(ptr + offset, unique_values_[i].data(), str_len);
-        offset += str_len;
-    }
+    unique_values_.ForEach(
+        0, unique_values_.size(), [&](size_t, const std::string& value) {
+            string_offsets.push_back(
+                static_cast<uint32_t>(offset - string_data_start));
+
+            // Write string length and content
+            uint32_t str_len = static_cast<uint32_t>(value.size());
+            memcpy(ptr + offset, &str_len, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            memcpy(ptr + offset, value.data(), str_len);
+            offset += str_len;
+        });
 
     // Write string offsets back
     memcpy(ptr + string_offsets_start,
@@ -707,9 +880,8 @@ StringIndexSortMemoryImpl::LoadFromBinary(
                "Failed to find 'index_data' in binary_set");
 
     auto parsed = ParseBinaryData(index_data->data.get(), index_data->size);
-    unique_values_.clear();
+    unique_values_.Clear();
     posting_lists_.clear();
-    unique_values_.reserve(parsed.unique_count);
     posting_lists_.reserve(parsed.unique_count);
 
     std::fill(idx_to_offsets.begin(), idx_to_offsets.end(), -1);
@@ -723,7 +895,8 @@ StringIndexSortMemoryImpl::LoadFromBinary(
         uint32_t str_len;
         memcpy(&str_len, str_ptr, sizeof(uint32_t));
         str_ptr += sizeof(uint32_t);
-        std::string value(reinterpret_cast<const char*>(str_ptr), str_len);
+        std::string_view value(reinterpret_cast<const char*>(str_ptr),
+                               str_len);
 
         // Read posting list
         const uint8_t* post_list_ptr =
@@ -752,17 +925,17 @@ StringIndexSortMemoryImpl::LoadFromBinary(
             idx_to_offsets[row_id] = unique_idx;
         }
 
-        unique_values_.push_back(std::move(value));
+        unique_values_.Append(value);
         posting_lists_.push_back(std::move(posting_list));
     }
+    unique_values_.Finish();
 }
 
 size_t
 StringIndexSortMemoryImpl::FindValueIndex(const std::string& value) const {
-    auto it =
-        std::lower_bound(unique_values_.begin(), unique_values_.end(), value);
-    if (it != unique_values_.end() && *it == value) {
-        return std::distance(unique_values_.begin(), it);
+    size_t idx = unique_values_.Find(value);
+    if (idx < unique_values_.size()) {
+        return idx;
     }
     return std::numeric_limits<size_t>::max();
 }
@@ -827,30 +1000,18 @@ StringIndexSortMemoryImpl::Range(std::string value,
     size_t end_idx = unique_values_.size();
 
     switch (op) {
-        case OpType::GreaterThan: {
-            auto it = std::upper_bound(
-                unique_values_.begin(), unique_values_.end(), value);
-            start_idx = std::distance(unique_values_.begin(), it);
+        case OpType::GreaterThan:
+            start_idx = unique_values_.UpperBound(value);
             break;
-        }
-        case OpType::GreaterEqual: {
-            auto it = std::lower_bound(
-                unique_values_.begin(), unique_values_.end(), value);
-            start_idx = std::distance(unique_values_.begin(), it);
+        case OpType::GreaterEqual:
+            start_idx = unique_values_.LowerBound(value);
             break;
-        }
-        case OpType::LessThan: {
-            auto it = std::lower_bound(
-                unique_values_.begin(), unique_values_.end(), value);
-            end_idx = std::distance(unique_values_.begin(), it);
+        case OpType::LessThan:
+            end_idx = unique_values_.LowerBound(value);
             break;
-        }
-        case OpType::LessEqual: {
-            auto it = std::upper_bound(
-                unique_values_.begin(), unique_values_.end(), value);
-            end_idx = std::distance(unique_values_.begin(), it);
+        case OpType::LessEqual:
+            end_idx = unique_values_.UpperBound(value);
             break;
-        }
         default:
             ThrowInfo(
                 milvus::OpTypeInvalid,
@@ -876,22 +1037,12 @@ StringIndexSortMemoryImpl::Range(std::string lower_bound_value,
                                  size_t total_num_rows) {
     TargetBitmap bitset(total_num_rows, false);
 
-    auto start_it = lb_inclusive ? std::lower_bound(unique_values_.begin(),
-                                                    unique_values_.end(),
-                                                    lower_bound_value)
-                                 : std::upper_bound(unique_values_.begin(),
-                                                    unique_values_.end(),
-                                                    lower_bound_value);
-
-    auto end_it = ub_inclusive ? std::upper_bound(unique_values_.begin(),
-                                                  unique_values_.end(),
-                                                  upper_bound_value)
-                               : std::lower_bound(unique_values_.begin(),
-                                                  unique_values_.end(),
-                                                  upper_bound_value);
-
-    size_t start_idx = std::distance(unique_values_.begin(), start_it);
-    size_t end_idx = std::distance(unique_values_.begin(), end_it);
+    size_t start_idx = lb_inclusive
+                           ? unique_values_.LowerBound(lower_bound_value)
+                           : unique_values_.UpperBound(lower_bound_value);
+    size_t end_idx = ub_inclusive
+                         ? unique_values_.UpperBound(upper_bound_value)
+                         : unique_values_.LowerBound(upper_bound_value);
 
     for (size_t i = start_idx; i < end_idx; ++i) {
         const auto& posting_list = posting_lists_[i];
@@ -928,9 +1079,7 @@ StringIndexSortMemoryImpl::FindPrefixRange(const std::string& prefix) const {
     }
 
     // Binary search for start: first value >= prefix
-    auto start_it =
-        std::lower_bound(unique_values_.begin(), unique_values_.end(), prefix);
-    size_t start_idx = std::distance(unique_values_.begin(), start_it);
+    size_t start_idx = unique_values_.LowerBound(prefix);
 
     // Compute "next prefix" for end boundary: "abc" -> "abd"
     // Range is [prefix, next_prefix), all strings starting with prefix
@@ -949,9 +1098,7 @@ StringIndexSortMemoryImpl::FindPrefixRange(const std::string& prefix) const {
     size_t end_idx;
     if (has_next) {
         // Binary search for end: first value >= next_prefix
-        auto end_it = std::lower_bound(
-            unique_values_.begin(), unique_values_.end(), next_prefix);
-        end_idx = std::distance(unique_values_.begin(), end_it);
+        end_idx = unique_values_.LowerBound(next_prefix);
     } else {
         // All chars are 0xFF, no upper bound
         end_idx = unique_values_.size();
@@ -993,14 +1140,17 @@ StringIndexSortMemoryImpl::PatternMatch(const std::string& pattern,
     if (op == proto::plan::OpType::PostfixMatch ||
         op == proto::plan::OpType::InnerMatch) {
         // Iterate over all unique values
-        for (size_t idx = 0; idx < unique_values_.size(); ++idx) {
-            if (MatchValue(unique_values_[idx], pattern, op)) {
-                const auto& posting_list = posting_lists_[idx];
-                for (uint32_t row_id : posting_list) {
-                    bitset[row_id] = true;
+        unique_values_.ForEach(
+            0,
+            unique_values_.size(),
+            [&](size_t idx, const std::string& value) {
+                if (MatchValue(value, pattern, op)) {
+                    const auto& posting_list = posting_lists_[idx];
+                    for (uint32_t row_id : posting_list) {
+                        bitset[row_id] = true;
+                    }
                 }
-            }
-        }
+            });
         return bitset;
     }
 
@@ -1010,21 +1160,20 @@ StringIndexSortMemoryImpl::PatternMatch(const std::string& pattern,
     // Find the range of unique values to check
     auto [start_idx, end_idx] = FindPrefixRange(prefix);
 
-    // Build regex matcher
-    PatternMatchTranslator translator;
-    auto regex_pattern = translator(pattern);
-    RegexMatcher matcher(regex_pattern);
+    // Build LIKE matcher
+    LikePatternMatcher matcher(pattern);
 
     // Iterate over unique values in range (each value checked only once)
-    for (size_t idx = start_idx; idx < end_idx; ++idx) {
-        if (matcher(unique_values_[idx])) {
-            // Match found, set all row IDs in posting list
-            const auto& posting_list = posting_lists_[idx];
-            for (uint32_t row_id : posting_list) {
-                bitset[row_id] = true;
+    unique_values_.ForEach(
+        start_idx, end_idx, [&](size_t idx, const std::string& value) {
+            if (matcher(value)) {
+                // Match found, set all row IDs in posting list
+                const auto& posting_list = posting_lists_[idx];
+                for (uint32_t row_id : posting_list) {
+                    bitset[row_id] = true;
+                }
             }
-        }
-    }
+        });
 
     return bitset;
 }
@@ -1042,21 +1191,33 @@ StringIndexSortMemoryImpl::Reverse_Lookup(
     if (offset < idx_to_offsets.size()) {
         size_t unique_idx = idx_to_offsets[offset];
         if (unique_idx < unique_values_.size()) {
-            return unique_values_[unique_idx];
+            return unique_values_.Get(unique_idx);
         }
     }
 
     return std::nullopt;
 }
 
+void
+StringIndexSortMemoryImpl::ForEachRowInOrder(
+    bool ascending, const std::function<bool(int64_t)>& func) const {
+    auto n = posting_lists_.size();
+    for (size_t i = 0; i < n; ++i) {
+        const auto& posting_list = posting_lists_[ascending ? i : n - 1 - i];
+        for (auto row_id : posting_list) {
+            if (!func(row_id)) {
+                return;
+            }
+        }
+    }
+}
+
 int64_t
 StringIndexSortMemoryImpl::Size() {
     size_t size = 0;
 
-    // Size of unique values (actual string data)
-    for (const auto& str : unique_values_) {
-        size += str.size();
-    }
+    // Size of unique values (front coded string data)
+    size += unique_values_.DataSize();
 
     // Size of posting lists (actual ID data)
     for (const auto& list : posting_lists_) {
@@ -1070,17 +1231,8 @@ int64_t
 StringIndexSortMemoryImpl::ByteSize() const {
     int64_t total = 0;
 
-    // unique_values_: vector<string>
-    // sizeof(std::string) includes the SSO buffer
-    // For heap-allocated strings (capacity > SSO threshold), we need to add external buffer
-    const size_t sso_threshold = GetStringSSOThreshold();
-    total += unique_values_.capacity() * sizeof(std::string);
-    for (const auto& str : unique_values_) {
-        // Only add capacity for heap-allocated strings (non-SSO)
-        if (str.capacity() > sso_threshold) {
-            total += str.capacity();
-        }
-    }
+    // unique_values_: front coded buffer and block offsets
+    total += unique_values_.ByteSize();
 
     // posting_lists_: vector<PostingList>
     // PostingList is folly::small_vector<uint32_t, 4>
@@ -1429,10 +1581,8 @@ StringIndexSortMmapImpl::PatternMatch(const std::string& pattern,
     // Find the range of unique values to check
     auto [start_idx, end_idx] = FindPrefixRange(prefix);
 
-    // Build regex matcher
-    PatternMatchTranslator translator;
-    auto regex_pattern = translator(pattern);
-    RegexMatcher matcher(regex_pattern);
+    // Build LIKE matcher
+    LikePatternMatcher matcher(pattern);
 
     // Iterate over unique values in range (each value checked only once)
     for (size_t idx = start_idx; idx < end_idx; ++idx) {
@@ -1473,6 +1623,19 @@ StringIndexSortMmapImpl::Reverse_Lookup(
     return std::nullopt;
 }
 
+void
+StringIndexSortMmapImpl::ForEachRowInOrder(
+    bool ascending, const std::function<bool(int64_t)>& func) const {
+    for (size_t i = 0; i < unique_count_; ++i) {
+        auto entry = GetEntry(ascending ? i : unique_count_ - 1 - i);
+        for (size_t j = 0; j < entry.get_posting_list_len(); ++j) {
+            if (!func(entry.get_row_id(j))) {
+                return;
+            }
+        }
+    }
+}
+
 int64_t
 StringIndexSortMmapImpl::Size() {
     return mmap_size_;
@@ -17,10 +17,12 @@
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <map>
 #include <cstring>
 #include <sys/mman.h>
@@ -138,6 +140,18 @@ class StringIndexSort : public StringIndex {
     std::optional<std::string>
     Reverse_Lookup(size_t offset) const override;
 
+    // Calls func with the offsets of the valid rows in the order of their
+    // values, rows of equal values by offset, until it returns false. The
+    // values are not decoded.
+    void
+    ForEachRowInOrder(bool ascending,
+                      const std::function<bool(int64_t)>& func) const;
+
+    bool
+    IsValid(size_t offset) const {
+        return offset < valid_bitset_.size() && valid_bitset_[offset];
+    }
+
     int64_t
     Size() override;
 
@@ -227,6 +241,11 @@ class StringIndexSortImpl {
                    const TargetBitmap& valid_bitset,
                    const std::vector<int32_t>& idx_to_offsets) const = 0;
 
+    // walks the posting lists of the sorted unique values
+    virtual void
+    ForEachRowInOrder(bool ascending,
+                      const std::function<bool(int64_t)>& func) const = 0;
+
     virtual int64_t
     Size() = 0;
 
@@ -235,6 +254,98 @@ class StringIndexSortImpl {
     ByteSize() const = 0;
 };
 
+// Sorted strings front coded in blocks of kBlockSize: the first string of
+// a block is stored whole, the others as the length of the prefix shared
+// with the string before and the rest of their bytes. Lengths are varints.
+// A search bisects the block heads, which are read in place, and decodes a
+// single block, so shared prefixes such as those of URLs and paths are
+// stored once per block.
+class FrontCodedStrings {
+ public:
+    static constexpr size_t kBlockSize = 16;
+
+    // values must be appended in ascending order
+    void
+    Append(std::string_view value);
+
+    // drops the state kept for appending and trims the buffers
+    void
+    Finish();
+
+    void
+    Clear();
+
+    size_t
+    size() const {
+        return size_;
+    }
+
+    std::string
+    Get(size_t idx) const;
+
+    // the index of value, or size() if it is absent
+    size_t
+    Find(std::string_view value) const;
+
+    size_t
+    LowerBound(std::string_view value) const;
+
+    size_t
+    UpperBound(std::string_view value) const;
+
+    // calls func(idx, value) for the strings in [begin, end) in order
+    template <typename Func>
+    void
+    ForEach(size_t begin, size_t end, Func func) const {
+        end = std::min(end, size_);
+        if (begin >= end) {
+            return;
+        }
+        // blocks are contiguous, decoding runs on into the next one
+        std::string value;
+        auto block = begin / kBlockSize;
+        auto ptr = data_.data() + block_offsets_[block];
+        for (auto idx = block * kBlockSize; idx < end; ++idx) {
+            ptr = DecodeNext(ptr, idx % kBlockSize == 0, value);
+            if (idx >= begin) {
+                func(idx, static_cast<const std::string&>(value));
+            }
+        }
+    }
+
+    // bytes of the encoded strings
+    size_t
+    DataSize() const {
+        return data_.size();
+    }
+
+    size_t
+    ByteSize() const;
+
+ private:
+    // decodes the string following value, the head of a block if head is
+    // set, into value and returns the position after it
+    static const uint8_t*
+    DecodeNext(const uint8_t* ptr, bool head, std::string& value);
+
+    std::string_view
+    Head(size_t block) const;
+
+    // the first block whose head is not less than value, or greater than
+    // it if upper is set
+    size_t
+    FindBlock(std::string_view value, bool upper) const;
+
+    size_t
+    Bound(std::string_view value, bool upper) const;
+
+    std::vector<uint8_t> data_;
+    std::vector<uint32_t> block_offsets_;
+    size_t size_ = 0;
+    // the last appended string, while building
+    std::string last_;
+};
+
 class StringIndexSortMemoryImpl : public StringIndexSortImpl {
  public:
     using PostingList = folly::small_vector<uint32_t, 4>;
@@ -315,6 +426,10 @@ class StringIndexSortMemoryImpl : public StringIndexSortImpl {
                    const TargetBitmap& valid_bitset,
                    const std::vector<int32_t>& idx_to_offsets) const override;
 
+    void
+    ForEachRowInOrder(bool ascending,
+                      const std::function<bool(int64_t)>& func) const override;
+
     int64_t
     Size() override;
 
@@ -336,14 +451,17 @@ class StringIndexSortMemoryImpl : public StringIndexSortImpl {
                const std::string& pattern,
                proto::plan::OpType op) const;
 
+    // (value, row id) of every valid row, the values owned by the caller
+    using Entry = std::pair<std::string_view, uint32_t>;
+
     void
-    BuildFromMap(std::map<std::string, PostingList>&& unique_map,
-                 size_t total_num_rows,
-                 std::vector<int32_t>& idx_to_offsets);
+    BuildFromEntries(std::vector<Entry>&& entries,
+                     size_t total_num_rows,
+                     std::vector<int32_t>& idx_to_offsets);
 
     // Keep unique_values_ and posting_lists_ separated for cache efficiency
     // Sorted unique values
-    std::vector<std::string> unique_values_;
+    FrontCodedStrings unique_values_;
     // Corresponding posting lists
     std::vector<PostingList> posting_lists_;
 };
@@ -447,6 +565,10 @@ class StringIndexSortMmapImpl : public StringIndexSortImpl {
                    const TargetBitmap& valid_bitset,
                    const std::vector<int32_t>& idx_to_offsets) const override;
 
+    void
+    ForEachRowInOrder(bool ascending,
+                      const std::function<bool(int64_t)>& func) const override;
+
     int64_t
     Size() override;
 
@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <boost/filesystem.hpp>
 
 #include "index/StringIndexSort.h"
@@ -607,6 +609,60 @@ TEST(StringIndexSortStandaloneTest, StringIndexSortSerialization) {
     }
 }
 
+TEST(StringIndexSortStandaloneTest, SharedPrefixesAcrossBlocks) {
+    // urls sharing long prefixes, spanning many front coded blocks
+    std::vector<std::string> test_data;
+    std::default_random_engine er(42);
+    for (int i = 0; i < 1000; ++i) {
+        test_data.push_back("https://example.com/path/" +
+                            std::to_string(er() % 300) + "/item" +
+                            std::to_string(er() % 4));
+    }
+    test_data.push_back("");
+    auto n = test_data.size();
+
+    auto index = milvus::index::CreateStringIndexSort({});
+    index->Build(n, test_data.data());
+    auto binary_set = index->Serialize({});
+    auto loaded = milvus::index::CreateStringIndexSort({});
+    loaded->Load(binary_set);
+    milvus::Config mmap_config;
+    mmap_config[milvus::index::MMAP_FILE_PATH] =
+        "/tmp/test_string_index_sort_shared_prefixes.idx";
+    auto mmap_index = milvus::index::CreateStringIndexSort({});
+    mmap_index->Load(binary_set, mmap_config);
+
+    auto sorted = test_data;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    std::vector<std::string> probes = {"", "https://", "zzz"};
+    for (size_t i = 0; i < sorted.size(); i += 7) {
+        probes.push_back(sorted[i]);
+        probes.push_back(sorted[i] + "0");
+        probes.push_back(sorted[i].substr(0, sorted[i].size() / 2));
+    }
+
+    for (const auto& probe : probes) {
+        for (auto* idx : {index.get(), loaded.get(), mmap_index.get()}) {
+            auto in = idx->In(1, &probe);
+            auto less = idx->Range(probe, milvus::OpType::LessThan);
+            auto greater = idx->Range(probe, milvus::OpType::GreaterEqual);
+            auto prefix = idx->PrefixMatch(probe);
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(in[i], test_data[i] == probe);
+                ASSERT_EQ(less[i], test_data[i] < probe);
+                ASSERT_EQ(greater[i], test_data[i] >= probe);
+                ASSERT_EQ(prefix[i], test_data[i].rfind(probe, 0) == 0);
+            }
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(index->Reverse_Lookup(i).value(), test_data[i]);
+        ASSERT_EQ(loaded->Reverse_Lookup(i).value(), test_data[i]);
+    }
+    std::remove("/tmp/test_string_index_sort_shared_prefixes.idx");
+}
+
 // ============== PatternMatch Tests ==============
 
 using milvus::proto::plan::OpType;
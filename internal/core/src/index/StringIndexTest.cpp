@@ -213,6 +213,38 @@ TEST_F(StringIndexMarisaTest, PrefixMatch) {
     }
 }
 
+TEST_F(StringIndexMarisaTest, ReverseBatch) {
+    auto index = milvus::index::CreateStringIndexMarisa();
+    // repeated strings, every third row null
+    std::vector<std::string> values(nb);
+    FixedVector<bool> valid(nb);
+    for (int i = 0; i < nb; i++) {
+        values[i] = strs[i % 7];
+        valid[i] = i % 3 != 0;
+    }
+    index->Build(nb, values.data(), valid.data());
+
+    std::vector<int64_t> offsets;
+    for (int64_t i = nb - 1; i >= 0; i -= 2) {
+        offsets.push_back(i);
+        offsets.push_back((i * 13) % nb);
+    }
+    std::vector<std::optional<std::string>> raws(offsets.size());
+    index->Reverse_Lookup_Batch(offsets.data(), offsets.size(), raws.data());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        ASSERT_EQ(raws[i], index->Reverse_Lookup(offsets[i]));
+        ASSERT_EQ(raws[i].has_value(), bool(valid[offsets[i]]));
+        if (raws[i].has_value()) {
+            ASSERT_EQ(raws[i].value(), values[offsets[i]]);
+        }
+    }
+
+    auto bitset = index->PrefixMatch(strs[0]);
+    for (int i = 0; i < nb; i++) {
+        ASSERT_EQ(bitset[i], valid[i] && values[i].rfind(strs[0], 0) == 0);
+    }
+}
+
 TEST_F(StringIndexMarisaTest, IsNull) {
     auto index = milvus::index::CreateStringIndexMarisa();
     index->Build(nb, strs.data());
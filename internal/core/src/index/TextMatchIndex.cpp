@@ -36,6 +36,7 @@ TextMatchIndex::TextMatchIndex(int64_t commit_interval_in_ms,
         analyzer_name,
         analyzer_params);
     set_is_growing(true);
+    indexer_ = std::thread(&TextMatchIndex::RunIndexer, this);
 }
 
 TextMatchIndex::TextMatchIndex(const std::string& path,
@@ -93,6 +94,15 @@ TextMatchIndex::TextMatchIndex(const storage::FileManagerContext& ctx)
     d_type_ = TantivyDataType::Text;
 }
 
+TextMatchIndex::~TextMatchIndex() {
+    if (indexer_.joinable()) {
+        PendingTexts stop;
+        stop.stop_ = true;
+        pending_.enqueue(std::move(stop));
+        indexer_.join();
+    }
+}
+
 IndexStatsPtr
 TextMatchIndex::Upload(const Config& config) {
     finish();
@@ -219,9 +229,55 @@ TextMatchIndex::AddTextsGrowing(size_t n,
             }
         }
     }
-    wrapper_->add_data(texts, n, offset_begin);
-    if (shouldTriggerCommit()) {
-        Commit();
+    if (n == 0) {
+        return;
+    }
+    PendingTexts pending;
+    pending.texts_.assign(texts, texts + n);
+    pending.offset_begin_ = offset_begin;
+    pending_.enqueue(std::move(pending));
+}
+
+void
+TextMatchIndex::RunIndexer() {
+    bool uncommitted = false;
+    while (true) {
+        PendingTexts pending;
+        bool dequeued = true;
+        if (uncommitted) {
+            dequeued = pending_.try_dequeue_until(
+                pending,
+                last_commit_time_.load() +
+                    std::chrono::milliseconds(commit_interval_in_ms_));
+        } else {
+            pending_.dequeue(pending);
+        }
+        if (dequeued) {
+            if (pending.stop_) {
+                return;
+            }
+            try {
+                wrapper_->add_data(pending.texts_.data(),
+                                   pending.texts_.size(),
+                                   pending.offset_begin_);
+                uncommitted = true;
+            } catch (std::exception& e) {
+                LOG_ERROR("failed to index {} texts from offset {}: {}",
+                          pending.texts_.size(),
+                          pending.offset_begin_,
+                          e.what());
+            }
+        }
+        // the texts queued until the commit is due go into the same commit
+        if (uncommitted && (!dequeued || shouldTriggerCommit())) {
+            try {
+                Commit();
+                Reload();
+            } catch (std::exception& e) {
+                LOG_ERROR("failed to commit text index: {}", e.what());
+            }
+            uncommitted = false;
+        }
     }
 }
 
@@ -277,19 +333,15 @@ TextMatchIndex::shouldTriggerCommit() {
 
 void
 TextMatchIndex::Commit() {
-    std::unique_lock<std::mutex> lck(mtx_, std::defer_lock);
-    if (lck.try_lock()) {
-        wrapper_->commit();
-        last_commit_time_.store(stdclock::now());
-    }
+    std::unique_lock<std::mutex> lck(mtx_);
+    wrapper_->commit();
+    last_commit_time_.store(stdclock::now());
 }
 
 void
 TextMatchIndex::Reload() {
-    std::unique_lock<std::mutex> lck(mtx_, std::defer_lock);
-    if (lck.try_lock()) {
-        wrapper_->reload();
-    }
+    std::unique_lock<std::mutex> lck(mtx_);
+    wrapper_->reload();
 }
 
 void
@@ -307,11 +359,6 @@ TargetBitmap
 TextMatchIndex::MatchQuery(const std::string& query,
                            uint32_t min_should_match) {
     tracer::AutoSpan span("TextMatchIndex::MatchQuery", tracer::GetRootSpan());
-    if (shouldTriggerCommit()) {
-        Commit();
-        Reload();
-    }
-
     TargetBitmap bitset{static_cast<size_t>(Count())};
     // The count operation of tantivy may be get older cnt if the index is committed with new tantivy segment.
     // So we cannot use the count operation to get the total count for bitmap.
@@ -324,11 +371,6 @@ TargetBitmap
 TextMatchIndex::PhraseMatchQuery(const std::string& query, uint32_t slop) {
     tracer::AutoSpan span("TextMatchIndex::PhraseMatchQuery",
                           tracer::GetRootSpan());
-    if (shouldTriggerCommit()) {
-        Commit();
-        Reload();
-    }
-
     TargetBitmap bitset{static_cast<size_t>(Count())};
     // The count operation of tantivy may be get older cnt if the index is committed with new tantivy segment.
     // So we cannot use the count operation to get the total count for bitmap.
@@ -337,4 +379,29 @@ TextMatchIndex::PhraseMatchQuery(const std::string& query, uint32_t slop) {
     return bitset;
 }
 
+void
+TextMatchIndex::MatchTopK(const std::vector<std::string>& queries,
+                          int64_t topk,
+                          const SegmentBm25Stats& stats,
+                          const BitsetView& bitset,
+                          SearchResult& result) {
+    tracer::AutoSpan span("TextMatchIndex::MatchTopK", tracer::GetRootSpan());
+    auto nq = static_cast<int64_t>(queries.size());
+    result.total_nq_ = nq;
+    result.unity_topK_ = topk;
+    result.seg_offsets_.assign(nq * topk, INVALID_SEG_OFFSET);
+    result.distances_.assign(nq * topk, 0.0f);
+    for (int64_t i = 0; i < nq; ++i) {
+        auto num =
+            wrapper_->match_query_topk(queries[i],
+                                       topk,
+                                       stats,
+                                       bitset.data(),
+                                       bitset.size(),
+                                       result.seg_offsets_.data() + i * topk,
+                                       result.distances_.data() + i * topk);
+        AssertInfo(num <= topk, "too many text match hits: {}", num);
+    }
+}
+
 }  // namespace milvus::index
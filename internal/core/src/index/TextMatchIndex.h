@@ -12,9 +12,14 @@
 #pragma once
 
 #include <string>
+#include <thread>
+#include <vector>
 #include <boost/filesystem.hpp>
+#include <folly/concurrency/UnboundedQueue.h>
 
 #include "cachinglayer/Manager.h"
+#include "common/BitsetView.h"
+#include "common/QueryResult.h"
 #include "index/InvertedIndexTantivy.h"
 #include "index/IndexStats.h"
 
@@ -23,7 +28,9 @@ namespace milvus::index {
 using stdclock = std::chrono::high_resolution_clock;
 class TextMatchIndex : public InvertedIndexTantivy<std::string> {
  public:
-    // for growing segment.
+    // for growing segment. The texts are indexed and committed by a thread
+    // of the index, so they are searchable about commit_interval_in_ms
+    // after they are added.
     explicit TextMatchIndex(int64_t commit_interval_in_ms,
                             const char* unique_id,
                             const char* analyzer_name,
@@ -43,6 +50,8 @@ class TextMatchIndex : public InvertedIndexTantivy<std::string> {
     // for loading built index
     explicit TextMatchIndex(const storage::FileManagerContext& ctx);
 
+    ~TextMatchIndex() override;
+
  public:
     IndexStatsPtr
     Upload(const Config& config) override;
@@ -57,6 +66,7 @@ class TextMatchIndex : public InvertedIndexTantivy<std::string> {
     void
     AddNullSealed(int64_t offset);
 
+    // queues the texts for the indexing thread and returns
     void
     AddTextsGrowing(size_t n,
                     const std::string* texts,
@@ -89,14 +99,43 @@ class TextMatchIndex : public InvertedIndexTantivy<std::string> {
     TargetBitmap
     PhraseMatchQuery(const std::string& query, uint32_t slop);
 
+    // Fills result with the topk rows of each of queries matching any of
+    // its tokens scored best by BM25 over stats, the best first. The rows
+    // set in bitset, deleted or filtered out, and those past its end are
+    // skipped. Unlike scoring the bitset of MatchQuery, the docs not
+    // reaching the topk are mostly skipped by block-max WAND.
+    void
+    MatchTopK(const std::vector<std::string>& queries,
+              int64_t topk,
+              const SegmentBm25Stats& stats,
+              const BitsetView& bitset,
+              SearchResult& result);
+
  private:
     bool
     shouldTriggerCommit();
 
+    // the loop of indexer_: adds the queued texts as they come and commits
+    // and reloads once commit_interval_in_ms_ passed since the last commit
+    void
+    RunIndexer();
+
+ private:
+    struct PendingTexts {
+        std::vector<std::string> texts_;
+        int64_t offset_begin_{0};
+        // wakes the indexer up to exit
+        bool stop_{false};
+    };
+
  private:
     mutable std::mutex mtx_;
     std::atomic<stdclock::time_point> last_commit_time_;
     int64_t commit_interval_in_ms_;
+
+    // growing only, many inserting threads and the indexer
+    folly::UMPSCQueue<PendingTexts, true> pending_;
+    std::thread indexer_;
 };
 
 class TextMatchIndexHolder {
@@ -222,6 +222,109 @@ TEST(TextMatch, Index) {
     }
 }
 
+TEST(TextMatch, MatchTopK) {
+    using Index = index::TextMatchIndex;
+    auto index = std::make_unique<Index>(std::numeric_limits<int64_t>::max(),
+                                         "unique_id",
+                                         "milvus_tokenizer",
+                                         "{}");
+    index->CreateReader(milvus::index::SetBitsetSealed);
+    index->AddTextSealed("football", true, 0);
+    index->AddTextSealed("", false, 1);
+    index->AddTextSealed("swimming, football, swimming", true, 2);
+    for (int64_t i = 3; i < 100; ++i) {
+        index->AddTextSealed("football, basketball", true, i);
+    }
+    index->Commit();
+    index->Reload();
+
+    TargetBitmap none(100);
+    SegmentBm25Stats index_stats{0, 0};
+
+    // the rare token ranks its doc first
+    SearchResult result;
+    index->MatchTopK({"swimming football"}, 2, index_stats, none, result);
+    ASSERT_EQ(result.total_nq_, 1);
+    ASSERT_EQ(result.unity_topK_, 2);
+    ASSERT_EQ(result.seg_offsets_.size(), 2);
+    ASSERT_EQ(result.seg_offsets_[0], 2);
+    ASSERT_NE(result.seg_offsets_[1], INVALID_SEG_OFFSET);
+    ASSERT_GE(result.distances_[0], result.distances_[1]);
+
+    // a deleted or filtered out row is skipped
+    TargetBitmap excluded(100);
+    excluded.set(2);
+    index->MatchTopK({"swimming football"}, 2, index_stats, excluded, result);
+    ASSERT_NE(result.seg_offsets_[0], 2);
+    ASSERT_NE(result.seg_offsets_[1], 2);
+
+    // the stats of the segment weigh the terms
+    index->MatchTopK({"swimming"}, 1, index_stats, none, result);
+    auto index_score = result.distances_[0];
+    index->MatchTopK({"swimming"}, 1, {100000, 2}, none, result);
+    ASSERT_GT(result.distances_[0], index_score);
+
+    // the shorter of the docs with one football ranks first
+    index->MatchTopK({"football"}, 1, index_stats, none, result);
+    ASSERT_EQ(result.seg_offsets_[0], 0);
+
+    // fewer hits than topk, one result row per query
+    index->MatchTopK({"swimming", "nothing"}, 10, index_stats, none, result);
+    ASSERT_EQ(result.total_nq_, 2);
+    ASSERT_EQ(result.seg_offsets_.size(), 20);
+    ASSERT_EQ(result.seg_offsets_[0], 2);
+    ASSERT_EQ(result.seg_offsets_[1], INVALID_SEG_OFFSET);
+    ASSERT_EQ(result.seg_offsets_[10], INVALID_SEG_OFFSET);
+
+    // the rows past the end of the bitset aren't visible yet
+    index->MatchTopK({"swimming"}, 1, index_stats, TargetBitmap(2), result);
+    ASSERT_EQ(result.seg_offsets_[0], INVALID_SEG_OFFSET);
+}
+
+TEST(TextMatch, GrowingIndexCommitsInBackground) {
+    using Index = index::TextMatchIndex;
+    auto index =
+        std::make_unique<Index>(50, "unique_id", "milvus_tokenizer", "{}");
+    index->Commit();
+    index->CreateReader(milvus::index::SetBitsetGrowing);
+
+    // searchable once the indexer committed them, with no commit here
+    auto wait_for_match = [&](size_t expected_size) {
+        auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (true) {
+            auto res = index->MatchQuery("football", 1);
+            if (res.size() >= expected_size && res[expected_size - 1]) {
+                return res;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) {
+                ADD_FAILURE() << "texts not searchable in time";
+                return res;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    };
+
+    std::vector<std::string> texts = {
+        "football, basketball", "", "swimming, football"};
+    bool valids[] = {true, false, true};
+    index->AddTextsGrowing(texts.size(), texts.data(), valids, 0);
+    auto res = wait_for_match(3);
+    ASSERT_EQ(res.size(), 3);
+    ASSERT_TRUE(res[0]);
+    ASSERT_FALSE(res[1]);
+    ASSERT_TRUE(res[2]);
+
+    // the batches of later inserts go into later commits
+    std::vector<std::string> more = {"tennis", "football"};
+    index->AddTextsGrowing(1, more.data(), nullptr, 3);
+    index->AddTextsGrowing(1, more.data() + 1, nullptr, 4);
+    res = wait_for_match(5);
+    ASSERT_EQ(res.size(), 5);
+    ASSERT_FALSE(res[3]);
+    ASSERT_TRUE(res[4]);
+}
+
 TEST(TextMatch, GrowingNaive) {
     auto schema = GenTestSchema();
     auto seg = CreateGrowingSegment(schema, empty_index_meta);
@@ -495,6 +598,73 @@ TEST(TextMatch, SealedNaive) {
     }
 }
 
+TEST(TextMatch, SealedTopKSearch) {
+    auto schema = GenTestSchema();
+    std::vector<std::string> raw_str = {"football, basketball",
+                                        "swimming, football",
+                                        "swimming",
+                                        "pingpang"};
+
+    int64_t N = 4;
+    uint64_t seed = 19190504;
+    auto raw_data = DataGen(schema, N, seed);
+    auto str_col = raw_data.raw_->mutable_fields_data()
+                       ->at(1)
+                       .mutable_scalars()
+                       ->mutable_string_data()
+                       ->mutable_data();
+    for (int64_t i = 0; i < N; i++) {
+        str_col->at(i) = raw_str[i];
+    }
+
+    auto seg = CreateSealedWithFieldDataLoaded(schema, raw_data);
+    seg->CreateTextIndex(FieldId(101));
+
+    auto search = [&](const std::string& filter) {
+        proto::plan::PlanNode plan_node;
+        auto anns = plan_node.mutable_vector_anns();
+        anns->set_field_id(101);
+        anns->set_placeholder_tag("$0");
+        auto query_info = anns->mutable_query_info();
+        query_info->set_topk(2);
+        query_info->set_metric_type(knowhere::metric::BM25);
+        query_info->set_search_params("{}");
+        query_info->set_round_decimal(-1);
+        if (!filter.empty()) {
+            auto column_info = test::GenColumnInfo(
+                101, proto::schema::DataType::VarChar, false, false);
+            auto unary_range_expr =
+                test::GenUnaryRangeExpr(OpType::TextMatch, filter);
+            unary_range_expr->set_allocated_column_info(column_info);
+            anns->mutable_predicates()->set_allocated_unary_range_expr(
+                unary_range_expr);
+        }
+        auto plan = CreateSearchPlanFromPlanNode(schema, plan_node);
+
+        proto::common::PlaceholderGroup ph_group_raw;
+        auto ph = ph_group_raw.add_placeholders();
+        ph->set_tag("$0");
+        ph->set_type(proto::common::PlaceholderType::VarChar);
+        ph->add_values("swimming");
+        auto ph_group =
+            ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+        return seg->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    };
+
+    // the shorter of the rows with the token ranks first
+    auto result = search("");
+    ASSERT_EQ(result->total_nq_, 1);
+    ASSERT_EQ(result->unity_topK_, 2);
+    ASSERT_EQ(result->seg_offsets_[0], 2);
+    ASSERT_EQ(result->seg_offsets_[1], 1);
+    ASSERT_GT(result->distances_[0], result->distances_[1]);
+
+    // the rows the filter drops aren't scored
+    result = search("football");
+    ASSERT_EQ(result->seg_offsets_[0], 1);
+    ASSERT_EQ(result->seg_offsets_[1], INVALID_SEG_OFFSET);
+}
+
 TEST(TextMatch, SealedNaiveNullable) {
     auto schema = GenTestSchema({}, true);
     std::vector<std::string> raw_str = {
@@ -15,7 +15,9 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <condition_variable>
 #include <cstring>
 #include <filesystem>
 #include <string>
@@ -24,6 +26,8 @@
 #include <vector>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <unistd.h>
 #include <google/protobuf/text_format.h>
 
@@ -34,6 +38,7 @@
 #include "common/Slice.h"
 #include "index/Utils.h"
 #include "index/Meta.h"
+#include "storage/ThreadPools.h"
 #include "storage/Util.h"
 #include "knowhere/comp/index_param.h"
 
@@ -438,4 +443,72 @@ CheckAndUpdateKnowhereRangeSearchParam(const SearchInfo& search_info,
     return true;
 }
 
+size_t
+ParallelWorkers() {
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::MIDDLE);
+    return static_cast<size_t>(std::max(pool.GetMaxThreadNum(), 0)) + 1;
+}
+
+void
+ParallelRun(size_t n, const std::function<void(size_t)>& task) {
+    if (n <= 1) {
+        if (n == 1) {
+            task(0);
+        }
+        return;
+    }
+    // shared with the helpers, which may only start after the run is over
+    struct State {
+        std::function<void(size_t)> task_;
+        size_t n_;
+        std::atomic<size_t> next_{0};
+        std::mutex mutex_;
+        std::condition_variable done_cv_;
+        size_t done_{0};
+        std::exception_ptr error_;
+    };
+    auto state = std::make_shared<State>();
+    state->task_ = task;
+    state->n_ = n;
+    // claims tasks until none is left, once one failed the rest are only
+    // counted
+    auto work = [state]() {
+        for (auto i = state->next_++; i < state->n_; i = state->next_++) {
+            std::exception_ptr error;
+            bool failed;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex_);
+                failed = state->error_ != nullptr;
+            }
+            if (!failed) {
+                try {
+                    state->task_(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(state->mutex_);
+            if (error != nullptr && state->error_ == nullptr) {
+                state->error_ = error;
+            }
+            if (++state->done_ == state->n_) {
+                state->done_cv_.notify_all();
+            }
+        }
+    };
+
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::MIDDLE);
+    auto helpers = std::min(n, ParallelWorkers()) - 1;
+    for (size_t i = 0; i < helpers; ++i) {
+        pool.Submit(work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex_);
+    state->done_cv_.wait(lock, [&]() { return state->done_ == n; });
+    if (state->error_ != nullptr) {
+        std::rethrow_exception(state->error_);
+    }
+}
+
 }  // namespace milvus::index
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <unordered_map>
 #include <vector>
 #include <stdio.h>
@@ -253,4 +255,52 @@ GetStringSSOThreshold() {
     return threshold;
 }
 
+// Runs task(i) for every i in [0, n) on the calling thread and on idle
+// workers of the MIDDLE pool, and returns once all are done, rethrowing the
+// first failure. The caller claims tasks too, so a busy pool only makes it
+// run serially.
+void
+ParallelRun(size_t n, const std::function<void(size_t)>& task);
+
+// the number of threads ParallelRun may spread tasks over
+size_t
+ParallelWorkers();
+
+// ranges shorter than this per worker are sorted on the calling thread
+constexpr size_t kParallelSortMinChunk = 1 << 16;
+
+// std::sort of [first, last) that sorts chunks in parallel and merges them
+// pairwise, in parallel as well, for large ranges
+template <typename RandomIt, typename Compare = std::less<>>
+void
+ParallelSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    auto n = static_cast<size_t>(last - first);
+    auto chunks = std::min(ParallelWorkers(), n / kParallelSortMinChunk);
+    if (chunks < 2) {
+        std::sort(first, last, comp);
+        return;
+    }
+    std::vector<size_t> bounds(chunks + 1);
+    for (size_t i = 0; i <= chunks; ++i) {
+        bounds[i] = n * i / chunks;
+    }
+    ParallelRun(chunks, [&](size_t i) {
+        std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    });
+    for (size_t width = 1; width < chunks; width *= 2) {
+        auto merges = (chunks + 2 * width - 1) / (2 * width);
+        ParallelRun(merges, [&](size_t m) {
+            auto low = 2 * m * width;
+            auto mid = std::min(low + width, chunks);
+            auto high = std::min(low + 2 * width, chunks);
+            if (mid < high) {
+                std::inplace_merge(first + bounds[low],
+                                   first + bounds[mid],
+                                   first + bounds[high],
+                                   comp);
+            }
+        });
+    }
+}
+
 }  // namespace milvus::index
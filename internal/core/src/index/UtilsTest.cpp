@@ -15,14 +15,20 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <cstdint>
 #include <fcntl.h>
 #include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <utility>
+#include <vector>
 
 #include "common/Common.h"
 #include "index/Utils.h"
@@ -132,4 +138,42 @@ TEST(UtilIndex, TestGetValueFromConfigWithoutTypeCheck) {
     ASSERT_FALSE(e_value.has_value());
     auto f_value = GetValueFromConfig<bool>(cfg, "f");
     ASSERT_FALSE(f_value.has_value());
-}
\ No newline at end of file
+}
+TEST(UtilIndex, ParallelRunRunsEveryTask) {
+    std::vector<std::atomic<int>> runs(1000);
+    ParallelRun(runs.size(), [&](size_t i) { runs[i]++; });
+    for (const auto& run : runs) {
+        ASSERT_EQ(run.load(), 1);
+    }
+
+    EXPECT_THROW(ParallelRun(100,
+                             [](size_t i) {
+                                 if (i == 42) {
+                                     throw std::runtime_error("failed");
+                                 }
+                             }),
+                 std::runtime_error);
+}
+
+TEST(UtilIndex, ParallelSortMatchesSort) {
+    std::default_random_engine er(42);
+    for (size_t n : {size_t(0),
+                     size_t(1),
+                     kParallelSortMinChunk - 1,
+                     5 * kParallelSortMinChunk + 17}) {
+        std::vector<std::pair<int64_t, int32_t>> values(n);
+        for (size_t i = 0; i < n; ++i) {
+            // many duplicates, ties are broken by the second member
+            values[i] = {static_cast<int64_t>(er() % 1000),
+                         static_cast<int32_t>(i)};
+        }
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+        ParallelSort(values.begin(), values.end());
+        ASSERT_EQ(values, expected) << n;
+
+        ParallelSort(values.begin(), values.end(), std::greater<>());
+        std::reverse(expected.begin(), expected.end());
+        ASSERT_EQ(values, expected) << n;
+    }
+}
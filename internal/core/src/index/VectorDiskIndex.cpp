@@ -20,6 +20,7 @@
 #include "common/Types.h"
 #include "common/Utils.h"
 #include "config/ConfigKnowhere.h"
+#include "index/DiskAnnCacheBudget.h"
 #include "index/Meta.h"
 #include "index/Utils.h"
 #include "storage/LocalChunkManagerSingleton.h"
@@ -76,6 +77,11 @@ VectorDiskAnnIndex<T>::VectorDiskAnnIndex(
     }
 }
 
+template <typename T>
+VectorDiskAnnIndex<T>::~VectorDiskAnnIndex() {
+    DiskAnnCacheBudget::GetInstance().Release(cache_budget_bytes_);
+}
+
 template <typename T>
 void
 VectorDiskAnnIndex<T>::Load(const BinarySet& binary_set /* not used */,
@@ -391,6 +397,11 @@ VectorDiskAnnIndex<T>::Query(const DatasetPtr dataset,
     auto final = [&] {
         if (CheckAndUpdateKnowhereRangeSearchParam(
                 search_info, topk, GetMetricType(), search_config)) {
+            // the topk may be full with closer results of the request already
+            const auto& bound = search_info.range_search_bound_;
+            if (bound != nullptr && !bound->Tighten(topk, search_config)) {
+                return EmptyRangeSearchResult(topk, num_rows);
+            }
             auto res =
                 index_.RangeSearch(dataset, search_config, bitset, op_context);
             if (!res.has_value()) {
@@ -399,8 +410,15 @@ VectorDiskAnnIndex<T>::Query(const DatasetPtr dataset,
                                       KnowhereStatusString(res.error()),
                                       res.what()));
             }
-            return ReGenRangeSearchResult(
+            auto result = ReGenRangeSearchResult(
                 res.value(), topk, num_rows, GetMetricType());
+            if (bound != nullptr) {
+                bound->Update(num_rows,
+                              topk,
+                              GetDatasetIDs(result),
+                              GetDatasetDistance(result));
+            }
+            return result;
         } else {
             auto res =
                 index_.Search(dataset, search_config, bitset, op_context);
@@ -522,6 +540,21 @@ VectorDiskAnnIndex<T>::update_load_json(const Config& config) {
         if (beamwidth.has_value()) {
             search_beamwidth_ = std::atoi(beamwidth.value().c_str());
         }
+
+        // the node cache comes out of the budget shared by the node
+        if (load_config.contains(DISK_ANN_SEARCH_CACHE_BUDGET)) {
+            const auto& value = load_config[DISK_ANN_SEARCH_CACHE_BUDGET];
+            auto budget_gb = value.is_string()
+                                 ? std::stod(value.get<std::string>())
+                                 : value.get<double>();
+            constexpr double kGB = 1024.0 * 1024.0 * 1024.0;
+            auto& budget = DiskAnnCacheBudget::GetInstance();
+            budget.Release(cache_budget_bytes_);
+            cache_budget_bytes_ =
+                budget.Acquire(static_cast<uint64_t>(budget_gb * kGB));
+            load_config[DISK_ANN_SEARCH_CACHE_BUDGET] =
+                cache_budget_bytes_ / kGB;
+        }
     }
 
     if (config.contains(MMAP_FILE_PATH)) {
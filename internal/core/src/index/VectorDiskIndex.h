@@ -35,6 +35,8 @@ class VectorDiskAnnIndex : public VectorIndex {
         const storage::FileManagerContext& file_manager_context =
             storage::FileManagerContext());
 
+    ~VectorDiskAnnIndex() override;
+
     BinarySet
     Serialize(const Config& config) override {  // deprecated
         BinarySet binary_set;
@@ -103,6 +105,8 @@ class VectorDiskAnnIndex : public VectorIndex {
     knowhere::Index<knowhere::IndexNode> index_;
     std::shared_ptr<storage::DiskFileManagerImpl> file_manager_;
     uint32_t search_beamwidth_ = 8;
+    // node cache bytes taken from DiskAnnCacheBudget
+    uint64_t cache_budget_bytes_ = 0;
     // used for embedding list only
     DataType elem_type_;
 };
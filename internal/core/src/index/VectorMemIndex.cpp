@@ -17,6 +17,7 @@
 #include "index/VectorMemIndex.h"
 
 #include <unistd.h>
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <filesystem>
@@ -228,6 +229,7 @@ VectorMemIndex<T>::Load(milvus::tracer::TraceContext ctx,
 
     LOG_INFO("load index files: {}", index_files.value().size());
     std::map<std::string, IndexDataCodec> index_data_codecs{};
+    BinarySet binary_set;
     // try to read slice meta first
     std::string slice_meta_filepath;
     for (auto& file : pending_index_files) {
@@ -275,28 +277,31 @@ VectorMemIndex<T>::Load(milvus::tracer::TraceContext ctx,
                     batch.push_back(index_file_prefix + file_name);
                 }
 
-                auto batch_data =
-                    file_manager_->LoadIndexToMemory(batch, load_priority);
-                int64_t payload_size = 0;
-                index_data_codecs.insert({prefix, IndexDataCodec{}});
-                auto& index_data_codec = index_data_codecs.at(prefix);
-                for (const auto& file_path : batch) {
-                    const std::string file_name =
-                        file_path.substr(file_path.find_last_of('/') + 1);
-                    AssertInfo(batch_data.find(file_name) != batch_data.end(),
-                               "lost index slice data: {}",
-                               file_name);
-                    payload_size += batch_data[file_name]->PayloadSize();
-                    index_data_codec.codecs_.push_back(
-                        std::move(batch_data[file_name]));
-                }
+                // slices are copied into the assembled binary as they
+                // arrive, so only the slices in flight are held twice
+                auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[total_len]);
+                size_t payload_size = 0;
+                file_manager_->StreamIndexToMemory(
+                    batch,
+                    load_priority,
+                    [&](size_t idx, std::unique_ptr<storage::DataCodec> data) {
+                        auto size = static_cast<size_t>(data->PayloadSize());
+                        AssertInfo(payload_size + size <= total_len,
+                                   "index slice {} exceeds the index len {}",
+                                   batch[idx],
+                                   total_len);
+                        std::memcpy(buf.get() + payload_size,
+                                    data->PayloadData(),
+                                    size);
+                        payload_size += size;
+                    });
                 for (auto& file : batch) {
                     pending_index_files.erase(file);
                 }
                 AssertInfo(
                     payload_size == total_len,
                     "index len is inconsistent after disassemble and assemble");
-                index_data_codec.size_ = payload_size;
+                binary_set.Append(prefix, buf, total_len);
             }
         }
 
@@ -319,7 +324,6 @@ VectorMemIndex<T>::Load(milvus::tracer::TraceContext ctx,
     }
 
     LOG_INFO("construct binary set...");
-    BinarySet binary_set;
     AssembleIndexDatas(index_data_codecs, binary_set);
     // clear index_data_codecs to free memory early
     index_data_codecs.clear();
@@ -357,11 +361,120 @@ VectorMemIndex<T>::BuildWithDataset(const DatasetPtr& dataset,
     SetDim(index_.Dim());
 }
 
+template <typename T>
+bool
+VectorMemIndex<T>::CanBuildStreamed(const Config& config) const {
+    if (STREAMED_VECTOR_INDEX_TRAIN_ROWS.load() <= 0 ||
+        elem_type_ != DataType::NONE || IndexIsSparse(GetIndexType())) {
+        return false;
+    }
+    // the indexes taking more vectors once trained
+    static const std::vector<IndexType> streamed_index_types{
+        knowhere::IndexEnum::INDEX_FAISS_IVFFLAT,
+        knowhere::IndexEnum::INDEX_FAISS_IVFPQ,
+        knowhere::IndexEnum::INDEX_FAISS_IVFSQ8,
+        knowhere::IndexEnum::INDEX_HNSW,
+    };
+    if (std::find(streamed_index_types.begin(),
+                  streamed_index_types.end(),
+                  GetIndexType()) == streamed_index_types.end()) {
+        return false;
+    }
+    // storage v2 reads and the scalar info of opt fields need all rows
+    auto storage_version =
+        GetValueFromConfig<int64_t>(config, STORAGE_VERSION_KEY).value_or(0);
+    return storage_version != STORAGE_V2 && storage_version != STORAGE_V3 &&
+           !GetValueFromConfig<OptFieldT>(config, VEC_OPT_FIELDS).has_value();
+}
+
+template <typename T>
+void
+VectorMemIndex<T>::BuildStreamed(const Config& config,
+                                 const Config& build_config) {
+    auto train_rows = STREAMED_VECTOR_INDEX_TRAIN_ROWS.load();
+    bool built = false;
+    bool nullable = false;
+    int64_t dim = 0;
+    std::vector<uint8_t> valid_data;
+    std::vector<FieldDataPtr> pending;
+    int64_t pending_rows = 0;
+
+    // builds on the pending field datas, or adds them once built
+    auto flush = [&]() {
+        int64_t total_size = 0;
+        for (const auto& data : pending) {
+            total_size += data->DataSize();
+        }
+        auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[total_size]);
+        int64_t offset = 0;
+        for (auto& data : pending) {
+            std::memcpy(buf.get() + offset, data->Data(), data->DataSize());
+            offset += data->DataSize();
+            data.reset();
+        }
+        auto dataset = GenDataset(pending_rows, dim, buf.get());
+        LOG_INFO("{} {} vectors into memory index, build_id: {}",
+                 built ? "stream" : "build on",
+                 pending_rows,
+                 config.value("build_id", "unknown"));
+        if (built) {
+            AddWithDataset(dataset, build_config);
+        } else {
+            BuildWithDataset(dataset, build_config);
+            built = true;
+        }
+        pending.clear();
+        pending_rows = 0;
+    };
+
+    file_manager_->StreamRawDataToMemory(
+        config, [&](std::vector<FieldDataPtr>&& batch) {
+            for (auto& data : batch) {
+                AssertInfo(dim == 0 || dim == data->get_dim(),
+                           "inconsistent dim value between field datas!");
+                dim = data->get_dim();
+                auto rows = data->get_num_rows();
+                nullable = nullable || data->IsNullable();
+                auto src_bitmap = data->IsNullable() ? data->ValidData()
+                                                     : nullptr;
+                for (int64_t i = 0; i < rows; ++i) {
+                    valid_data.push_back(src_bitmap == nullptr ||
+                                         ((src_bitmap[i >> 3] >> (i & 7)) & 1));
+                }
+                pending_rows += data->get_valid_rows();
+                pending.push_back(std::move(data));
+            }
+            if (built || pending_rows >= train_rows) {
+                flush();
+            }
+        });
+    if (!built || !pending.empty()) {
+        flush();
+    }
+
+    if (nullable) {
+        auto total_num_rows = static_cast<int64_t>(valid_data.size());
+        std::unique_ptr<bool[]> valid(new bool[total_num_rows]);
+        for (int64_t i = 0; i < total_num_rows; ++i) {
+            valid[i] = valid_data[i] != 0;
+        }
+        BuildValidData(valid.get(), total_num_rows);
+    }
+}
+
 template <typename T>
 void
 VectorMemIndex<T>::Build(const Config& config) {
     LOG_INFO("start build memory index, build_id: {}",
              config.value("build_id", "unknown"));
+    if (CanBuildStreamed(config)) {
+        Config build_config;
+        build_config.update(config);
+        build_config.erase(INSERT_FILES_KEY);
+        build_config.erase(VEC_OPT_FIELDS);
+        BuildStreamed(config, build_config);
+        return;
+    }
     auto field_datas = file_manager_->CacheRawDataToMemory(config);
     LOG_INFO("CacheRawDataToMemory success, build_id: {}",
              config.value("build_id", "unknown"));
@@ -555,6 +668,11 @@ VectorMemIndex<T>::Query(const DatasetPtr dataset,
         auto index_type = GetIndexType();
         if (CheckAndUpdateKnowhereRangeSearchParam(
                 search_info, topk, GetMetricType(), search_conf)) {
+            // the topk may be full with closer results of the request already
+            const auto& bound = search_info.range_search_bound_;
+            if (bound != nullptr && !bound->Tighten(topk, search_conf)) {
+                return EmptyRangeSearchResult(topk, num_vectors);
+            }
             milvus::tracer::AddEvent("start_knowhere_index_range_search");
             auto res =
                 index_.RangeSearch(dataset, search_conf, bitset, op_context);
@@ -568,6 +686,12 @@ VectorMemIndex<T>::Query(const DatasetPtr dataset,
             auto result = ReGenRangeSearchResult(
                 res.value(), topk, num_vectors, GetMetricType());
             milvus::tracer::AddEvent("finish_ReGenRangeSearchResult");
+            if (bound != nullptr) {
+                bound->Update(num_vectors,
+                              topk,
+                              GetDatasetIDs(result),
+                              GetDatasetDistance(result));
+            }
             return result;
         } else {
             milvus::tracer::AddEvent("start_knowhere_index_search");
@@ -746,18 +870,18 @@ void VectorMemIndex<T>::LoadFromFile(const Config& config) {
         for (auto& item : meta_data[META]) {
             std::string prefix = item[NAME];
             int slice_num = item[SLICE_NUM];
-            auto total_len = static_cast<size_t>(item[TOTAL_LEN]);
-            auto HandleBatch = [&](int index) {
-                auto start_load2_mem = std::chrono::system_clock::now();
-                auto batch_data =
-                    file_manager_->LoadIndexToMemory(batch, load_priority);
-                load_duration_sum +=
-                    (std::chrono::system_clock::now() - start_load2_mem);
-                for (int j = index - batch.size() + 1; j <= index; j++) {
-                    std::string file_name = GenSlicedFileName(prefix, j);
-                    AssertInfo(batch_data.find(file_name) != batch_data.end(),
-                               "lost index slice data");
-                    auto&& data = batch_data[file_name];
+            for (auto i = 0; i < slice_num; ++i) {
+                std::string file_name = GenSlicedFileName(prefix, i);
+                batch.push_back(index_file_prefix + file_name);
+            }
+            // slices are written out as they arrive, while the next ones
+            // are still downloading
+            auto start_load2_mem = std::chrono::system_clock::now();
+            std::chrono::duration<double> write_duration{0};
+            file_manager_->StreamIndexToMemory(
+                batch,
+                load_priority,
+                [&](size_t, std::unique_ptr<storage::DataCodec> data) {
                     auto start_write_file = std::chrono::system_clock::now();
                     if (prefix == knowhere::meta::EMB_LIST_META &&
                         embedding_list_meta_writer_ptr) {
@@ -771,25 +895,16 @@ void VectorMemIndex<T>::LoadFromFile(const Config& config) {
                         file_writer.Write(data->PayloadData(),
                                           data->PayloadSize());
                     }
-                    write_disk_duration_sum +=
+                    write_duration +=
                         (std::chrono::system_clock::now() - start_write_file);
-                }
-                for (auto& file : batch) {
-                    pending_index_files.erase(file);
-                }
-                batch.clear();
-            };
-
-            for (auto i = 0; i < slice_num; ++i) {
-                std::string file_name = GenSlicedFileName(prefix, i);
-                batch.push_back(index_file_prefix + file_name);
-                if (batch.size() >= parallel_degree) {
-                    HandleBatch(i);
-                }
-            }
-            if (batch.size() > 0) {
-                HandleBatch(slice_num - 1);
+                });
+            load_duration_sum += (std::chrono::system_clock::now() -
+                                  start_load2_mem - write_duration);
+            write_disk_duration_sum += write_duration;
+            for (auto& file : batch) {
+                pending_index_files.erase(file);
             }
+            batch.clear();
         }
     }
     if (!pending_index_files.empty()) {
@@ -886,6 +1001,46 @@ void VectorMemIndex<T>::LoadFromFile(const Config& config) {
             .count());
 }
 
+template <typename T>
+void
+VectorMemIndex<T>::SaveToFile(const std::string& filepath) {
+    knowhere::BinarySet binary_set;
+    auto stat = index_.Serialize(binary_set);
+    if (stat != knowhere::Status::success) {
+        ThrowInfo(ErrorCode::UnexpectedError,
+                  "failed to serialize index: {}",
+                  KnowhereStatusString(stat));
+    }
+    auto binaries = binary_set.binary_map_;
+    AssertInfo(binaries.size() == 1,
+               "index of {} binaries cannot be saved to one file",
+               binaries.size());
+
+    std::filesystem::create_directories(
+        std::filesystem::path(filepath).parent_path());
+    auto file_writer =
+        storage::FileWriter(filepath, storage::io::Priority::LOW);
+    auto& binary = binaries.begin()->second;
+    file_writer.Write(binary->data.get(), binary->size);
+    file_writer.Finish();
+}
+
+template <typename T>
+void
+VectorMemIndex<T>::LoadFromLocalFile(const std::string& filepath,
+                                     const Config& config) {
+    auto conf = config;
+    conf[ENABLE_MMAP] = true;
+    auto stat = index_.DeserializeFromFile(filepath, conf);
+    if (stat != knowhere::Status::success) {
+        ThrowInfo(ErrorCode::UnexpectedError,
+                  "failed to Deserialize index from {}: {}",
+                  filepath,
+                  KnowhereStatusString(stat));
+    }
+    SetDim(index_.Dim());
+}
+
 template class VectorMemIndex<float>;
 template class VectorMemIndex<bin1>;
 template class VectorMemIndex<float16>;
@@ -99,6 +99,17 @@ class VectorMemIndex : public VectorIndex {
                     const knowhere::Json& json,
                     const BitsetView& bitset) const override;
 
+    // writes the knowhere index to filepath in the layout LoadFromFile
+    // leaves behind, without the valid data of a nullable field, at the low
+    // io priority
+    void
+    SaveToFile(const std::string& filepath);
+
+    // mmaps the index SaveToFile wrote to filepath, the file is kept when
+    // the index is released
+    void
+    LoadFromLocalFile(const std::string& filepath, const Config& config = {});
+
  protected:
     virtual void
     LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
@@ -107,6 +118,16 @@ class VectorMemIndex : public VectorIndex {
     void
     LoadFromFile(const Config& config);
 
+    // whether Build may stream the binlogs, see BuildStreamed
+    bool
+    CanBuildStreamed(const Config& config) const;
+
+    // builds on the first STREAMED_VECTOR_INDEX_TRAIN_ROWS rows of the
+    // binlogs and adds the rest batch by batch as they are fetched, so the
+    // raw vectors are never all in memory at once
+    void
+    BuildStreamed(const Config& config, const Config& build_config);
+
  protected:
     Config config_;
     knowhere::Index<knowhere::IndexNode> index_;
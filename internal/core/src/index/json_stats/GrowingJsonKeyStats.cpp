@@ -0,0 +1,379 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/json_stats/GrowingJsonKeyStats.h"
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus::index {
+
+void
+JsonKeyLayoutHints::Update(FieldId field_id, std::vector<JsonKey> keys) {
+    std::unique_lock lock(mutex_);
+    // the latest loaded stats follow the current data best
+    keys_[field_id] = std::move(keys);
+}
+
+std::vector<JsonKey>
+JsonKeyLayoutHints::Get(FieldId field_id) const {
+    std::shared_lock lock(mutex_);
+    auto it = keys_.find(field_id);
+    if (it == keys_.end()) {
+        return {};
+    }
+    return it->second;
+}
+
+void
+JsonKeyLayoutHints::RecordQueriedPath(FieldId field_id,
+                                      const std::string& pointer) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = queried_paths_.find(field_id);
+        if (it != queried_paths_.end()) {
+            auto path_it = it->second.find(pointer);
+            if (path_it != it->second.end()) {
+                path_it->second->fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto& paths = queried_paths_[field_id];
+    auto& hits = paths[pointer];
+    if (hits == nullptr) {
+        if (paths.size() > kMaxQueriedPaths) {
+            paths.erase(pointer);
+            return;
+        }
+        hits = std::make_unique<std::atomic<int64_t>>(0);
+    }
+    hits->fetch_add(1, std::memory_order_relaxed);
+}
+
+std::map<std::string, int64_t>
+JsonKeyLayoutHints::GetQueriedPaths(FieldId field_id) const {
+    std::shared_lock lock(mutex_);
+    std::map<std::string, int64_t> result;
+    auto it = queried_paths_.find(field_id);
+    if (it == queried_paths_.end()) {
+        return result;
+    }
+    for (const auto& [pointer, hits] : it->second) {
+        result[pointer] = hits->load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+namespace {
+
+bool
+IsGrowingShreddingType(JSONType type) {
+    return type == JSONType::INT64 || type == JSONType::DOUBLE ||
+           type == JSONType::BOOL || type == JSONType::STRING;
+}
+
+// the column type of a value, UNKNOWN when no column can hold it and NONE
+// for JSON null
+JSONType
+GetShreddingType(const simdjson::dom::element& element) {
+    switch (element.type()) {
+        case simdjson::dom::element_type::INT64:
+            return JSONType::INT64;
+        case simdjson::dom::element_type::DOUBLE:
+            return JSONType::DOUBLE;
+        case simdjson::dom::element_type::BOOL:
+            return JSONType::BOOL;
+        case simdjson::dom::element_type::STRING:
+            return JSONType::STRING;
+        case simdjson::dom::element_type::NULL_VALUE:
+            return JSONType::NONE;
+        default:
+            // uint64 above the int64 range, arrays and objects
+            return JSONType::UNKNOWN;
+    }
+}
+
+// the values of one column for a batch of rows
+struct ColumnBuffer {
+    ColumnBuffer(JSONType type, int64_t count)
+        : type_(type), valid_(new bool[count]()) {
+        switch (type) {
+            case JSONType::INT64:
+                int64s_.resize(count);
+                break;
+            case JSONType::DOUBLE:
+                doubles_.resize(count);
+                break;
+            case JSONType::BOOL:
+                bools_.reset(new bool[count]());
+                break;
+            default:
+                strings_.resize(count);
+                break;
+        }
+    }
+
+    void
+    Set(int64_t i, const simdjson::dom::element& element) {
+        valid_[i] = true;
+        switch (type_) {
+            case JSONType::INT64:
+                int64s_[i] = element.get_int64().value();
+                break;
+            case JSONType::DOUBLE:
+                doubles_[i] = element.get_double().value();
+                break;
+            case JSONType::BOOL:
+                bools_[i] = element.get_bool().value();
+                break;
+            default:
+                strings_[i] = std::string(element.get_string().value());
+                break;
+        }
+    }
+
+    const void*
+    Data() const {
+        switch (type_) {
+            case JSONType::INT64:
+                return int64s_.data();
+            case JSONType::DOUBLE:
+                return doubles_.data();
+            case JSONType::BOOL:
+                return bools_.get();
+            default:
+                return strings_.data();
+        }
+    }
+
+    JSONType type_;
+    std::unique_ptr<bool[]> valid_;
+    std::vector<int64_t> int64s_;
+    std::vector<double> doubles_;
+    std::unique_ptr<bool[]> bools_;
+    std::vector<std::string> strings_;
+};
+
+}  // namespace
+
+GrowingJsonKeyStats::Column::Column(JSONType type, int64_t size_per_chunk)
+    : type_(type), valid_(size_per_chunk) {
+    switch (type) {
+        case JSONType::INT64:
+            values_ = std::make_unique<segcore::ConcurrentVector<int64_t>>(
+                size_per_chunk);
+            break;
+        case JSONType::DOUBLE:
+            values_ = std::make_unique<segcore::ConcurrentVector<double>>(
+                size_per_chunk);
+            break;
+        case JSONType::BOOL:
+            values_ = std::make_unique<segcore::ConcurrentVector<bool>>(
+                size_per_chunk);
+            break;
+        case JSONType::STRING:
+            values_ = std::make_unique<segcore::ConcurrentVector<std::string>>(
+                size_per_chunk);
+            break;
+        default:
+            ThrowInfo(ErrorCode::UnexpectedError,
+                      "unsupported json type {} for growing json stats",
+                      ToString(type));
+    }
+}
+
+const GrowingJsonKeyStats::Column*
+GrowingJsonKeyStats::PointerColumns::Find(JSONType type) const {
+    for (const auto& column : columns_) {
+        if (column->type_ == type) {
+            return column.get();
+        }
+    }
+    return nullptr;
+}
+
+GrowingJsonKeyStats::GrowingJsonKeyStats(FieldId field_id,
+                                         JsonKeyLayoutHintsPtr hints,
+                                         int64_t size_per_chunk)
+    : field_id_(field_id),
+      hints_(std::move(hints)),
+      size_per_chunk_(size_per_chunk) {
+    AssertInfo(size_per_chunk_ > 0 && size_per_chunk_ != MAX_ROW_COUNT,
+               "growing json stats need fixed size chunks, got {}",
+               size_per_chunk_);
+}
+
+void
+GrowingJsonKeyStats::Init() {
+    auto keys = hints_ != nullptr ? hints_->Get(field_id_)
+                                  : std::vector<JsonKey>{};
+    size_t num_columns = 0;
+    for (const auto& key : keys) {
+        // the root has no key name for the filters to use
+        if (key.key_.empty() || !IsGrowingShreddingType(key.type_) ||
+            num_columns >= kMaxShreddingColumns) {
+            continue;
+        }
+        auto& pointer = pointers_[key.key_];
+        if (pointer == nullptr) {
+            pointer = std::make_unique<PointerColumns>();
+        }
+        if (pointer->Find(key.type_) == nullptr) {
+            pointer->columns_.push_back(
+                std::make_unique<Column>(key.type_, size_per_chunk_));
+            num_columns++;
+        }
+    }
+    LOG_INFO("growing json stats of field {} shreds {} columns of {} keys",
+             field_id_.get(),
+             num_columns,
+             pointers_.size());
+}
+
+void
+GrowingJsonKeyStats::AddRows(
+    int64_t offset,
+    int64_t count,
+    const segcore::ConcurrentVector<Json>& data,
+    const segcore::ThreadSafeValidDataPtr& valid_data) {
+    std::call_once(init_flag_, [this, &valid_data]() {
+        Init();
+        if (valid_data != nullptr) {
+            row_valid_ = std::make_unique<segcore::ConcurrentVector<bool>>(
+                size_per_chunk_);
+        }
+        initialized_.store(true, std::memory_order_release);
+    });
+    if (count == 0) {
+        return;
+    }
+
+    std::unique_ptr<bool[]> row_valid(new bool[count]);
+    for (int64_t i = 0; i < count; ++i) {
+        row_valid[i] =
+            valid_data == nullptr || valid_data->is_valid(offset + i);
+    }
+    if (row_valid_ != nullptr) {
+        row_valid_->set_data_raw(offset, row_valid.get(), count);
+    }
+    if (pointers_.empty()) {
+        return;
+    }
+
+    // one buffer per column, in the order of pointers_
+    std::vector<std::unique_ptr<ColumnBuffer>> buffers;
+    for (const auto& [_, columns] : pointers_) {
+        for (const auto& column : columns->columns_) {
+            buffers.push_back(
+                std::make_unique<ColumnBuffer>(column->type_, count));
+        }
+    }
+    std::vector<int64_t> uncaptured_rows(pointers_.size(), 0);
+    for (int64_t i = 0; i < count; ++i) {
+        if (!row_valid[i]) {
+            continue;
+        }
+        // the DOM of the row is parsed once for all the pointers
+        auto doc = data[offset + i].dom_doc();
+        if (doc.error()) {
+            continue;
+        }
+        size_t pointer_idx = 0;
+        size_t buffer_idx = 0;
+        for (const auto& [pointer, columns] : pointers_) {
+            auto num_columns = columns->columns_.size();
+            auto element = doc.value().at_pointer(pointer);
+            if (!element.error()) {
+                auto type = GetShreddingType(element.value());
+                bool captured = type == JSONType::NONE;
+                for (size_t c = 0; c < num_columns && !captured; ++c) {
+                    if (columns->columns_[c]->type_ == type) {
+                        buffers[buffer_idx + c]->Set(i, element.value());
+                        captured = true;
+                    }
+                }
+                if (!captured) {
+                    uncaptured_rows[pointer_idx]++;
+                }
+            }
+            pointer_idx++;
+            buffer_idx += num_columns;
+        }
+    }
+
+    size_t pointer_idx = 0;
+    size_t buffer_idx = 0;
+    for (const auto& [_, columns] : pointers_) {
+        for (auto& column : columns->columns_) {
+            const auto& buffer = buffers[buffer_idx++];
+            column->values_->set_data_raw(offset, buffer->Data(), count);
+            column->valid_.set_data_raw(offset, buffer->valid_.get(), count);
+        }
+        columns->uncaptured_rows_ += uncaptured_rows[pointer_idx++];
+    }
+}
+
+bool
+GrowingJsonKeyStats::CoversPointer(const std::string& pointer) const {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    auto it = pointers_.find(pointer);
+    return it != pointers_.end() && it->second->uncaptured_rows_.load() == 0;
+}
+
+bool
+GrowingJsonKeyStats::HasColumn(const std::string& pointer,
+                               JSONType type) const {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return false;
+    }
+    auto it = pointers_.find(pointer);
+    return it != pointers_.end() && it->second->Find(type) != nullptr;
+}
+
+void
+GrowingJsonKeyStats::ApplyRowValid(int64_t offset,
+                                   int64_t size,
+                                   TargetBitmapView res,
+                                   TargetBitmapView valid_res) const {
+    if (!initialized_.load(std::memory_order_acquire) ||
+        row_valid_ == nullptr) {
+        return;
+    }
+    int64_t processed_size = 0;
+    while (processed_size < size) {
+        auto row = offset + processed_size;
+        auto chunk_id = row / size_per_chunk_;
+        auto chunk_offset = row % size_per_chunk_;
+        auto chunk_size =
+            std::min(size - processed_size, size_per_chunk_ - chunk_offset);
+        auto valid =
+            static_cast<const bool*>(row_valid_->get_chunk_data(chunk_id)) +
+            chunk_offset;
+        for (int64_t i = 0; i < chunk_size; ++i) {
+            if (!valid[i]) {
+                res[processed_size + i] = false;
+                valid_res[processed_size + i] = false;
+            }
+        }
+        processed_size += chunk_size;
+    }
+}
+
+}  // namespace milvus::index
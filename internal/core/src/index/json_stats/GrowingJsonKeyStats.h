@@ -0,0 +1,222 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/Types.h"
+#include "index/json_stats/utils.h"
+#include "segcore/ConcurrentVector.h"
+
+namespace milvus::index {
+
+/**
+ * The JSON key layout feedback of a collection, shared by its segments.
+ *
+ * Sealed segments publish the typed keys the JSON key stats they load
+ * shredded, growing segments shred the same keys while rows are inserted.
+ * Filters count the JSON pointers they evaluate, the counts are handed to
+ * the next JSON stats build, see JSON_STATS_QUERIED_PATHS.
+ */
+class JsonKeyLayoutHints {
+ public:
+    void
+    Update(FieldId field_id, std::vector<JsonKey> keys);
+
+    std::vector<JsonKey>
+    Get(FieldId field_id) const;
+
+    void
+    RecordQueriedPath(FieldId field_id, const std::string& pointer);
+
+    // pointer -> times filters evaluated it
+    std::map<std::string, int64_t>
+    GetQueriedPaths(FieldId field_id) const;
+
+    // pointers beyond this many per field are not counted
+    static constexpr size_t kMaxQueriedPaths = 1024;
+
+ private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<FieldId, std::vector<JsonKey>> keys_;
+    std::unordered_map<
+        FieldId,
+        std::unordered_map<std::string, std::unique_ptr<std::atomic<int64_t>>>>
+        queried_paths_;
+};
+
+using JsonKeyLayoutHintsPtr = std::shared_ptr<JsonKeyLayoutHints>;
+
+/**
+ * JSON key stats of a growing segment. The keys are fixed from the layout
+ * hints when the first rows are added, and every added row is shredded into
+ * one append only column per typed key, so filters on those keys read the
+ * columns instead of parsing the rows.
+ *
+ * Only int64, double, bool and string keys are shredded. JSON null counts as
+ * a missing value, like the filters treat it.
+ */
+class GrowingJsonKeyStats {
+ public:
+    GrowingJsonKeyStats(FieldId field_id,
+                        JsonKeyLayoutHintsPtr hints,
+                        int64_t size_per_chunk);
+
+    // Shreds rows [offset, offset + count) of the JSON column, called by
+    // every insert before its rows become visible. Inserts run concurrently
+    // with distinct offsets.
+    void
+    AddRows(int64_t offset,
+            int64_t count,
+            const segcore::ConcurrentVector<Json>& data,
+            const segcore::ThreadSafeValidDataPtr& valid_data);
+
+    // Whether every value at the pointer landed in one of its columns, so a
+    // row missing from all of them holds no value at the pointer
+    bool
+    CoversPointer(const std::string& pointer) const;
+
+    bool
+    HasColumn(const std::string& pointer, JSONType type) const;
+
+    /**
+     * Runs func over rows [offset, offset + size) of the column of the
+     * pointer and type, chunk by chunk, with the arguments the executors of
+     * JsonKeyStats::ExecutorForShreddingData take:
+     * func(const T* values, const bool* valid, size, res, valid_res).
+     * T is int64_t, double, bool or std::string_view.
+     */
+    template <typename T, typename FUNC>
+    void
+    ExecutorForShreddingData(const std::string& pointer,
+                             JSONType type,
+                             int64_t offset,
+                             int64_t size,
+                             FUNC func,
+                             TargetBitmapView res,
+                             TargetBitmapView valid_res) const;
+
+    // clears the result of the rows whose JSON is null
+    void
+    ApplyRowValid(int64_t offset,
+                  int64_t size,
+                  TargetBitmapView res,
+                  TargetBitmapView valid_res) const;
+
+    // at most this many hinted keys are shredded
+    static constexpr size_t kMaxShreddingColumns = 128;
+
+ private:
+    struct Column {
+        Column(JSONType type, int64_t size_per_chunk);
+
+        JSONType type_;
+        std::unique_ptr<segcore::VectorBase> values_;
+        segcore::ConcurrentVector<bool> valid_;
+    };
+
+    struct PointerColumns {
+        std::vector<std::unique_ptr<Column>> columns_;
+        // values at the pointer of a type without a column
+        std::atomic<int64_t> uncaptured_rows_{0};
+
+        const Column*
+        Find(JSONType type) const;
+    };
+
+    void
+    Init();
+
+    FieldId field_id_;
+    JsonKeyLayoutHintsPtr hints_;
+    int64_t size_per_chunk_;
+    std::once_flag init_flag_;
+    // set once the pointers are fixed, they are read without a lock after
+    std::atomic<bool> initialized_{false};
+    std::map<std::string, std::unique_ptr<PointerColumns>> pointers_;
+    // whether the JSON of the row is not null, only if the field is nullable
+    std::unique_ptr<segcore::ConcurrentVector<bool>> row_valid_;
+};
+
+template <typename T, typename FUNC>
+void
+GrowingJsonKeyStats::ExecutorForShreddingData(
+    const std::string& pointer,
+    JSONType type,
+    int64_t offset,
+    int64_t size,
+    FUNC func,
+    TargetBitmapView res,
+    TargetBitmapView valid_res) const {
+    if (!initialized_.load(std::memory_order_acquire)) {
+        return;
+    }
+    auto it = pointers_.find(pointer);
+    if (it == pointers_.end()) {
+        return;
+    }
+    auto column = it->second->Find(type);
+    if (column == nullptr) {
+        return;
+    }
+    std::vector<std::string_view> views;
+    int64_t processed_size = 0;
+    while (processed_size < size) {
+        auto row = offset + processed_size;
+        auto chunk_id = row / size_per_chunk_;
+        auto chunk_offset = row % size_per_chunk_;
+        auto chunk_size =
+            std::min(size - processed_size, size_per_chunk_ - chunk_offset);
+        auto valid = static_cast<const bool*>(
+                         column->valid_.get_chunk_data(chunk_id)) +
+                     chunk_offset;
+        if constexpr (std::is_same_v<T, std::string_view>) {
+            auto strings = static_cast<const segcore::ConcurrentVector<
+                std::string>*>(column->values_.get());
+            views.resize(chunk_size);
+            for (int64_t i = 0; i < chunk_size; ++i) {
+                views[i] = strings->view_element(row + i);
+            }
+            func(views.data(),
+                 valid,
+                 chunk_size,
+                 res + processed_size,
+                 valid_res + processed_size);
+        } else {
+            auto values = static_cast<const T*>(
+                              column->values_->get_chunk_data(chunk_id)) +
+                          chunk_offset;
+            func(values,
+                 valid,
+                 chunk_size,
+                 res + processed_size,
+                 valid_res + processed_size);
+        }
+        processed_size += chunk_size;
+    }
+}
+
+}  // namespace milvus::index
@@ -0,0 +1,174 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/Types.h"
+#include "index/json_stats/GrowingJsonKeyStats.h"
+#include "segcore/ConcurrentVector.h"
+
+using namespace milvus;
+using namespace milvus::index;
+
+namespace {
+
+constexpr int64_t kSizePerChunk = 4;
+
+std::vector<Json>
+MakeRows(const std::vector<std::string>& rows) {
+    std::vector<Json> jsons;
+    for (const auto& row : rows) {
+        jsons.emplace_back(simdjson::padded_string(row));
+    }
+    return jsons;
+}
+
+// the rows of the column whose value satisfies pred
+template <typename T, typename Pred>
+TargetBitmap
+Evaluate(const GrowingJsonKeyStats& stats,
+         const std::string& pointer,
+         JSONType type,
+         int64_t size,
+         Pred pred) {
+    TargetBitmap res(size, false);
+    TargetBitmap valid_res(size, true);
+    stats.ExecutorForShreddingData<T>(
+        pointer,
+        type,
+        0,
+        size,
+        [&pred](const T* src,
+                const bool* valid,
+                size_t n,
+                TargetBitmapView res,
+                TargetBitmapView valid_res) {
+            for (size_t i = 0; i < n; ++i) {
+                res[i] = valid[i] && pred(src[i]);
+            }
+        },
+        TargetBitmapView(res),
+        TargetBitmapView(valid_res));
+    stats.ApplyRowValid(
+        0, size, TargetBitmapView(res), TargetBitmapView(valid_res));
+    return res;
+}
+
+}  // namespace
+
+TEST(GrowingJsonKeyStatsTest, ShredsHintedKeys) {
+    FieldId field_id(101);
+    auto hints = std::make_shared<JsonKeyLayoutHints>();
+    hints->Update(field_id,
+                  {JsonKey("/a", JSONType::INT64),
+                   JsonKey("/a", JSONType::DOUBLE),
+                   JsonKey("/b", JSONType::STRING),
+                   JsonKey("/c", JSONType::BOOL)});
+    GrowingJsonKeyStats stats(field_id, hints, kSizePerChunk);
+
+    auto rows = MakeRows({R"({"a": 1, "b": "x", "c": true})",
+                          R"({"a": 2.5, "b": "y"})",
+                          R"({"a": null, "c": false})",
+                          R"({"b": "xz"})",
+                          R"({"a": 7, "b": "x", "c": true})",
+                          R"({})"});
+    int64_t n = rows.size();
+    segcore::ConcurrentVector<Json> data(kSizePerChunk);
+    data.set_data_raw(0, rows.data(), n);
+    FixedVector<bool> valid = {true, true, true, true, true, false};
+    auto valid_data =
+        std::make_shared<segcore::ThreadSafeValidData>(std::move(valid));
+
+    // rows from two inserts, the second one across a chunk boundary
+    stats.AddRows(0, 3, data, valid_data);
+    stats.AddRows(3, n - 3, data, valid_data);
+
+    EXPECT_TRUE(stats.CoversPointer("/a"));
+    EXPECT_TRUE(stats.CoversPointer("/b"));
+    EXPECT_FALSE(stats.CoversPointer("/d"));
+    EXPECT_TRUE(stats.HasColumn("/a", JSONType::DOUBLE));
+    EXPECT_FALSE(stats.HasColumn("/b", JSONType::INT64));
+
+    auto ints = Evaluate<int64_t>(
+        stats, "/a", JSONType::INT64, n, [](int64_t v) { return v > 1; });
+    std::vector<bool> expected_ints = {false, false, false, false, true, false};
+    auto doubles = Evaluate<double>(
+        stats, "/a", JSONType::DOUBLE, n, [](double v) { return v > 1; });
+    std::vector<bool> expected_doubles = {
+        false, true, false, false, false, false};
+    auto strings = Evaluate<std::string_view>(
+        stats, "/b", JSONType::STRING, n, [](std::string_view v) {
+            return v.substr(0, 1) == "x";
+        });
+    std::vector<bool> expected_strings = {
+        true, false, false, true, true, false};
+    auto bools = Evaluate<bool>(
+        stats, "/c", JSONType::BOOL, n, [](bool v) { return !v; });
+    std::vector<bool> expected_bools = {
+        false, false, true, false, false, false};
+    for (int64_t i = 0; i < n; ++i) {
+        EXPECT_EQ(ints[i], expected_ints[i]) << i;
+        EXPECT_EQ(doubles[i], expected_doubles[i]) << i;
+        EXPECT_EQ(strings[i], expected_strings[i]) << i;
+        EXPECT_EQ(bools[i], expected_bools[i]) << i;
+    }
+}
+
+TEST(GrowingJsonKeyStatsTest, UncapturedTypeStopsCovering) {
+    FieldId field_id(101);
+    auto hints = std::make_shared<JsonKeyLayoutHints>();
+    hints->Update(field_id, {JsonKey("/a", JSONType::INT64)});
+    GrowingJsonKeyStats stats(field_id, hints, kSizePerChunk);
+
+    auto rows = MakeRows({R"({"a": 1})", R"({"a": "1"})"});
+    segcore::ConcurrentVector<Json> data(kSizePerChunk);
+    data.set_data_raw(0, rows.data(), rows.size());
+
+    stats.AddRows(0, 1, data, nullptr);
+    EXPECT_TRUE(stats.CoversPointer("/a"));
+    // a string at the pointer has no column to land in
+    stats.AddRows(1, 1, data, nullptr);
+    EXPECT_FALSE(stats.CoversPointer("/a"));
+}
+
+TEST(GrowingJsonKeyStatsTest, NoHintsNoColumns) {
+    FieldId field_id(101);
+    GrowingJsonKeyStats stats(
+        field_id, std::make_shared<JsonKeyLayoutHints>(), kSizePerChunk);
+
+    auto rows = MakeRows({R"({"a": 1})"});
+    segcore::ConcurrentVector<Json> data(kSizePerChunk);
+    data.set_data_raw(0, rows.data(), rows.size());
+    stats.AddRows(0, 1, data, nullptr);
+
+    EXPECT_FALSE(stats.CoversPointer("/a"));
+    EXPECT_FALSE(stats.HasColumn("/a", JSONType::INT64));
+}
+
+TEST(GrowingJsonKeyStatsTest, CountsQueriedPaths) {
+    JsonKeyLayoutHints hints;
+    FieldId field_id(101);
+    hints.RecordQueriedPath(field_id, "/a");
+    hints.RecordQueriedPath(field_id, "/a");
+    hints.RecordQueriedPath(field_id, "/b/c");
+    hints.RecordQueriedPath(FieldId(102), "/a");
+
+    auto paths = hints.GetQueriedPaths(field_id);
+    ASSERT_EQ(paths.size(), 2);
+    EXPECT_EQ(paths["/a"], 2);
+    EXPECT_EQ(paths["/b/c"], 1);
+    EXPECT_TRUE(hints.GetQueriedPaths(FieldId(103)).empty());
+}
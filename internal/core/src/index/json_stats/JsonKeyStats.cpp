@@ -276,6 +276,11 @@ JsonKeyStats::ClassifyJsonKeyLayoutType(
         group_hit_rows[json_key.key_] += key_stats_info.hit_row_num_;
     }
 
+    auto query_hits = [&](const JsonKey& key) -> int64_t {
+        auto it = queried_paths_.find(key.key_);
+        return it == queried_paths_.end() ? 0 : it->second;
+    };
+
     auto ClassifyKey = [&](const JsonKey& key,
                            const KeyStatsInfo& info) -> JsonKeyLayoutType {
         // for null/object, must be classified as shared
@@ -286,7 +291,14 @@ JsonKeyStats::ClassifyJsonKeyLayoutType(
         float hit_ratio = float(info.hit_row_num_) / num_rows_;
         if (info.hit_row_num_ == num_rows_) {
             return JsonKeyLayoutType::TYPED;
-        } else if (hit_ratio >= shredding_ratio_threshold_) {
+        }
+        // with query feedback, filtered keys get a column however rare they
+        // are, and the sparse columns of keys no filter reads are dropped
+        if (!queried_paths_.empty()) {
+            return query_hits(key) > 0 ? JsonKeyLayoutType::DYNAMIC
+                                       : JsonKeyLayoutType::SHARED;
+        }
+        if (hit_ratio >= shredding_ratio_threshold_) {
             return JsonKeyLayoutType::DYNAMIC;
         } else {
             return JsonKeyLayoutType::SHARED;
@@ -333,9 +345,10 @@ JsonKeyStats::ClassifyJsonKeyLayoutType(
     }
 
     if (column_path_num > max_shredding_columns_) {
-        // sort by hit rows in descending order to find the least hit rows
+        // sort by query hits and then hit rows to find the least used keys,
         // move them to shared column
-        std::vector<std::pair<JsonKey, int32_t>> key_hit_rows;
+        std::vector<std::pair<JsonKey, std::pair<int64_t, int32_t>>>
+            key_hit_rows;
         for (const auto& [json_key, key_stats_info] : infos) {
             auto it = types.find(json_key);
             if (it != types.end() &&
@@ -343,8 +356,10 @@ JsonKeyStats::ClassifyJsonKeyLayoutType(
                  it->second == JsonKeyLayoutType::TYPED_NOT_ALL ||
                  it->second == JsonKeyLayoutType::DYNAMIC_ONLY ||
                  it->second == JsonKeyLayoutType::DYNAMIC)) {
-                key_hit_rows.emplace_back(json_key,
-                                          key_stats_info.hit_row_num_);
+                key_hit_rows.emplace_back(
+                    json_key,
+                    std::make_pair(query_hits(json_key),
+                                   key_stats_info.hit_row_num_));
             }
         }
 
@@ -716,6 +731,27 @@ JsonKeyStats::Build(const Config& config) {
         field_datas.insert(field_datas.begin(), field_data);
     }
 
+    auto queried_paths =
+        GetValueFromConfig<std::string>(config, JSON_STATS_QUERIED_PATHS);
+    if (queried_paths.has_value() && !queried_paths.value().empty()) {
+        auto paths = nlohmann::json::parse(queried_paths.value(),
+                                           nullptr,
+                                           /*allow_exceptions=*/false);
+        AssertInfo(paths.is_object(),
+                   "invalid {} for segment {}: {}",
+                   JSON_STATS_QUERIED_PATHS,
+                   segment_id_,
+                   queried_paths.value());
+        for (const auto& [path, hits] : paths.items()) {
+            if (hits.is_number_integer() && hits.get<int64_t>() > 0) {
+                queried_paths_[path] = hits.get<int64_t>();
+            }
+        }
+        LOG_INFO("build json stats with {} queried paths for segment {}",
+                 queried_paths_.size(),
+                 segment_id_);
+    }
+
     BuildWithFieldData(field_datas, schema_.nullable());
     auto end_time = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1038,6 +1074,23 @@ JsonKeyStats::LoadColumnGroup(int64_t column_group_id,
             field_id_,
             segment_id_);
         shredding_columns_[field_meta.get_name().get()] = column;
+
+        // min/max per chunk lets filters on the hot paths skip chunks,
+        // arrays are bson binaries and get none
+        const auto field_name = field_meta.get_name().get();
+        switch (shred_field_data_type_map_[field_name]) {
+            case JSONType::INT64:
+            case JSONType::DOUBLE:
+            case JSONType::STRING:
+                skip_index_.LoadSkip(segment_id_,
+                                     inner_field_id,
+                                     field_meta.get_data_type(),
+                                     column);
+                shredding_field_ids_[field_name] = inner_field_id;
+                break;
+            default:
+                break;
+        }
     }
     shared_column_ = shredding_columns_.at(shared_column_field_name_);
 }
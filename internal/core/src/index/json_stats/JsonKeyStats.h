@@ -240,8 +240,8 @@ class JsonKeyStats : public ScalarIndex<std::string> {
         // path is field_name in shredding_columns_
         const std::string& path,
         FUNC func,
-        std::function<bool(const milvus::SkipIndex&, std::string, int)>
-            skip_func,
+        // called with the inner field id of the shredding column
+        std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
         TargetBitmapView res,
         TargetBitmapView valid_res,
         ValTypes... values) {
@@ -253,11 +253,16 @@ class JsonKeyStats : public ScalarIndex<std::string> {
         auto column = shredding_columns_[path];
         auto num_data_chunk = column->num_chunks();
         auto num_rows = column->NumRows();
+        auto shredding_field_id = shredding_field_ids_.find(path);
+        if (shredding_field_id == shredding_field_ids_.end()) {
+            skip_func = nullptr;
+        }
 
         for (size_t i = 0; i < num_data_chunk; i++) {
             auto chunk_size = column->chunk_row_nums(i);
 
-            if (!skip_func || !skip_func(skip_index_, path, i)) {
+            if (!skip_func ||
+                !skip_func(skip_index_, shredding_field_id->second, i)) {
                 if constexpr (std::is_same_v<T, std::string_view>) {
                     // first is the raw data, second is valid_data
                     // use valid_data to see if raw data is null
@@ -388,6 +393,36 @@ class JsonKeyStats : public ScalarIndex<std::string> {
         return JSONType::UNKNOWN;
     }
 
+    // the typed keys with a shredded column of a primitive type, the layout
+    // hint growing segments shred on insert
+    std::vector<JsonKey>
+    GetShreddedKeys() const {
+        std::vector<JsonKey> keys;
+        for (const auto& [pointer, field_names] : key_field_map_) {
+            for (const auto& field : field_names) {
+                auto it = shred_field_data_type_map_.find(field);
+                if (it != shred_field_data_type_map_.end() &&
+                    field != shared_column_field_name_ &&
+                    IsPrimitiveJsonType(it->second) &&
+                    it->second != JSONType::NONE) {
+                    keys.push_back(JsonKey(pointer, it->second));
+                }
+            }
+        }
+        if (!keys.empty()) {
+            return keys;
+        }
+        // stats built in this process and not loaded from files
+        for (const auto& [key, layout_type] : key_types_) {
+            if (layout_type != JsonKeyLayoutType::SHARED &&
+                IsPrimitiveJsonType(key.type_) &&
+                key.type_ != JSONType::NONE) {
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+
  private:
     void
     CollectSingleJsonStatsInfo(const char* json_str,
@@ -639,6 +674,8 @@ class JsonKeyStats : public ScalarIndex<std::string> {
     int64_t max_shredding_columns_;
     double shredding_ratio_threshold_;
     int64_t write_batch_size_;
+    // json_path -> times filters evaluated it, from the query nodes
+    std::unordered_map<std::string, int64_t> queried_paths_;
 
     std::map<JsonKey, JsonKeyLayoutType> key_types_;
     std::set<JsonKey> shared_keys_;
@@ -669,7 +706,10 @@ class JsonKeyStats : public ScalarIndex<std::string> {
 
     std::string shared_column_field_name_;
     std::shared_ptr<milvus::ChunkedColumnInterface> shared_column_;
+    // chunk metrics of the typed shredding columns, keyed by inner field id
     SkipIndex skip_index_;
+    // field_name -> inner field id, for the columns in skip_index_
+    std::unordered_map<std::string, FieldId> shredding_field_ids_;
 
     // Meta file for storing layout type map and other metadata
     JsonStatsMeta json_stats_meta_;
@@ -16,10 +16,338 @@
 
 #include "index/skipindex_stats/SkipIndexStats.h"
 #include <cstring>
+#include "common/EasyAssert.h"
 #include "parquet/types.h"
 
 namespace milvus::index {
 
+namespace {
+
+constexpr size_t kBinaryAlignment = BLOOM_FILTER_BINARY_ALIGNMENT;
+
+void
+PadTo(std::string& out, size_t begin, size_t alignment) {
+    const auto misalignment = (out.size() - begin) % alignment;
+    if (misalignment != 0) {
+        out.append(alignment - misalignment, '\0');
+    }
+}
+
+// Reads a record, offsets are relative to its start.
+class BinaryReader {
+ public:
+    BinaryReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+    }
+
+    template <typename T>
+    T
+    Read() {
+        T value;
+        std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string
+    ReadString() {
+        const auto length = Read<uint32_t>();
+        return std::string(reinterpret_cast<const char*>(Take(length)),
+                           length);
+    }
+
+    void
+    Align(size_t alignment) {
+        const auto misalignment = offset_ % alignment;
+        if (misalignment != 0) {
+            Take(alignment - misalignment);
+        }
+    }
+
+    const uint8_t*
+    Take(size_t size) {
+        if (size > size_ - offset_) {
+            ThrowInfo(DataFormatBroken,
+                      "truncated skip index stats, need {} bytes at offset {} "
+                      "of {}",
+                      size,
+                      offset_,
+                      size_);
+        }
+        auto data = data_ + offset_;
+        offset_ += size;
+        return data;
+    }
+
+ private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
+BloomFilterPtr
+ReadBloomFilter(BinaryReader& reader,
+                const std::shared_ptr<const void>& owner) {
+    const auto size = reader.Read<uint64_t>();
+    reader.Align(kBinaryAlignment);
+    try {
+        return BloomFilterFromBinary(reader.Take(size), size, owner);
+    } catch (const std::runtime_error& e) {
+        ThrowInfo(DataFormatBroken, "{}", e.what());
+    }
+}
+
+template <typename T>
+std::unique_ptr<FieldChunkMetrics>
+ReadIntMetrics(BinaryReader& reader,
+               uint8_t bloom_filters,
+               const std::shared_ptr<const void>& owner) {
+    auto min = reader.Read<T>();
+    auto max = reader.Read<T>();
+    BloomFilterPtr bloom_filter = nullptr;
+    if (bloom_filters & 1) {
+        bloom_filter = ReadBloomFilter(reader, owner);
+    }
+    return std::make_unique<IntFieldChunkMetrics<T>>(min, max, bloom_filter);
+}
+
+template <typename T>
+std::unique_ptr<FieldChunkMetrics>
+ReadFloatMetrics(BinaryReader& reader) {
+    auto min = reader.Read<T>();
+    auto max = reader.Read<T>();
+    return std::make_unique<FloatFieldChunkMetrics<T>>(min, max);
+}
+
+std::unique_ptr<FieldChunkMetrics>
+FieldChunkMetricsFromBinary(const uint8_t* data,
+                            size_t size,
+                            const std::shared_ptr<const void>& owner) {
+    BinaryReader reader(data, size);
+    const auto header = reader.Read<FieldChunkMetricsBinaryHeader>();
+    if (header.version > FIELD_CHUNK_METRICS_BINARY_VERSION) {
+        ThrowInfo(DataFormatBroken,
+                  "unsupported skip index stats version {}",
+                  header.version);
+    }
+    if (!header.has_value) {
+        return std::make_unique<NoneFieldChunkMetrics>();
+    }
+    switch (static_cast<FieldChunkMetricsType>(header.type)) {
+        case FieldChunkMetricsType::BOOLEAN: {
+            auto has_true = reader.Read<bool>();
+            auto has_false = reader.Read<bool>();
+            return std::make_unique<BooleanFieldChunkMetrics>(has_true,
+                                                              has_false);
+        }
+        case FieldChunkMetricsType::INT: {
+            switch (header.value_size) {
+                case sizeof(int8_t):
+                    return ReadIntMetrics<int8_t>(
+                        reader, header.bloom_filters, owner);
+                case sizeof(int16_t):
+                    return ReadIntMetrics<int16_t>(
+                        reader, header.bloom_filters, owner);
+                case sizeof(int32_t):
+                    return ReadIntMetrics<int32_t>(
+                        reader, header.bloom_filters, owner);
+                case sizeof(int64_t):
+                    return ReadIntMetrics<int64_t>(
+                        reader, header.bloom_filters, owner);
+                default:
+                    break;
+            }
+            break;
+        }
+        case FieldChunkMetricsType::FLOAT: {
+            switch (header.value_size) {
+                case sizeof(float):
+                    return ReadFloatMetrics<float>(reader);
+                case sizeof(double):
+                    return ReadFloatMetrics<double>(reader);
+                default:
+                    break;
+            }
+            break;
+        }
+        case FieldChunkMetricsType::STRING: {
+            auto min = reader.ReadString();
+            auto max = reader.ReadString();
+            BloomFilterPtr bloom_filter = nullptr;
+            if (header.bloom_filters & 1) {
+                bloom_filter = ReadBloomFilter(reader, owner);
+            }
+            BloomFilterPtr ngram_bloom_filter = nullptr;
+            if (header.bloom_filters & 2) {
+                ngram_bloom_filter = ReadBloomFilter(reader, owner);
+            }
+            return std::make_unique<StringFieldChunkMetrics>(
+                std::move(min),
+                std::move(max),
+                bloom_filter,
+                ngram_bloom_filter);
+        }
+        default:
+            return std::make_unique<NoneFieldChunkMetrics>();
+    }
+    ThrowInfo(DataFormatBroken,
+              "invalid value size {} of skip index stats type {}",
+              header.value_size,
+              header.type);
+}
+
+std::unique_ptr<FieldChunkMetrics>
+FieldChunkMetricsFromJson(DataType data_type, const nlohmann::json& data) {
+    switch (data_type) {
+        case DataType::BOOL:
+            return NewFieldMetrics<bool>(data);
+        case DataType::INT8:
+            return NewFieldMetrics<int8_t>(data);
+        case DataType::INT16:
+            return NewFieldMetrics<int16_t>(data);
+        case DataType::INT32:
+            return NewFieldMetrics<int32_t>(data);
+        case DataType::INT64:
+            return NewFieldMetrics<int64_t>(data);
+        case DataType::FLOAT:
+            return NewFieldMetrics<float>(data);
+        case DataType::DOUBLE:
+            return NewFieldMetrics<double>(data);
+        case DataType::VARCHAR:
+        case DataType::STRING:
+            return NewFieldMetrics<std::string>(data);
+        default:
+            return std::make_unique<NoneFieldChunkMetrics>();
+    }
+}
+
+template <typename T>
+bool
+HasMagic(const uint8_t* data, size_t size, uint32_t magic) {
+    T header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    return header.magic == magic;
+}
+
+}  // namespace
+
+void
+AppendMetricsBinaryHeader(std::string& out,
+                          FieldChunkMetricsType type,
+                          uint8_t value_size,
+                          bool has_value,
+                          uint8_t bloom_filters) {
+    FieldChunkMetricsBinaryHeader header{};
+    header.magic = FIELD_CHUNK_METRICS_BINARY_MAGIC;
+    header.version = FIELD_CHUNK_METRICS_BINARY_VERSION;
+    header.type = static_cast<uint8_t>(type);
+    header.value_size = value_size;
+    header.has_value = has_value;
+    header.bloom_filters = bloom_filters;
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void
+AppendMetricsBinaryBloomFilter(std::string& out,
+                               size_t record_begin,
+                               const BloomFilter& bloom_filter) {
+    const auto size_offset = out.size();
+    AppendMetricsBinaryValue(out, uint64_t{0});
+    PadTo(out, record_begin, kBinaryAlignment);
+    const auto begin = out.size();
+    bloom_filter.Serialize(out);
+    const uint64_t size = out.size() - begin;
+    std::memcpy(out.data() + size_offset, &size, sizeof(size));
+}
+
+std::unique_ptr<FieldChunkMetrics>
+LoadFieldChunkMetrics(DataType data_type,
+                      const uint8_t* data,
+                      size_t size,
+                      std::shared_ptr<const void> owner) {
+    if (HasMagic<FieldChunkMetricsBinaryHeader>(
+            data, size, FIELD_CHUNK_METRICS_BINARY_MAGIC)) {
+        return FieldChunkMetricsFromBinary(data, size, owner);
+    }
+    return FieldChunkMetricsFromJson(data_type,
+                                     nlohmann::json::parse(data, data + size));
+}
+
+std::string
+SerializeSkipIndexStats(
+    const std::vector<std::unique_ptr<FieldChunkMetrics>>& cells) {
+    SkipIndexStatsBinaryHeader header{};
+    header.magic = SKIP_INDEX_STATS_BINARY_MAGIC;
+    header.version = SKIP_INDEX_STATS_BINARY_VERSION;
+    header.num_cells = cells.size();
+    std::string out(reinterpret_cast<const char*>(&header), sizeof(header));
+    const auto offsets_begin = out.size();
+    out.resize(offsets_begin + (cells.size() + 1) * sizeof(uint64_t));
+    std::vector<uint64_t> offsets;
+    offsets.reserve(cells.size() + 1);
+    for (const auto& cell : cells) {
+        PadTo(out, 0, kBinaryAlignment);
+        offsets.push_back(out.size());
+        cell->Serialize(out);
+    }
+    offsets.push_back(out.size());
+    std::memcpy(out.data() + offsets_begin,
+                offsets.data(),
+                offsets.size() * sizeof(uint64_t));
+    return out;
+}
+
+std::vector<std::unique_ptr<FieldChunkMetrics>>
+LoadSkipIndexStats(DataType data_type,
+                   const uint8_t* data,
+                   size_t size,
+                   std::shared_ptr<const void> owner) {
+    std::vector<std::unique_ptr<FieldChunkMetrics>> cells;
+    if (size == 0) {
+        return cells;
+    }
+    if (!HasMagic<SkipIndexStatsBinaryHeader>(
+            data, size, SKIP_INDEX_STATS_BINARY_MAGIC)) {
+        for (const auto& cell : nlohmann::json::parse(data, data + size)) {
+            cells.emplace_back(FieldChunkMetricsFromJson(data_type, cell));
+        }
+        return cells;
+    }
+    BinaryReader reader(data, size);
+    const auto header = reader.Read<SkipIndexStatsBinaryHeader>();
+    if (header.version > SKIP_INDEX_STATS_BINARY_VERSION) {
+        ThrowInfo(DataFormatBroken,
+                  "unsupported skip index stats version {}",
+                  header.version);
+    }
+    if (header.num_cells >= size / sizeof(uint64_t)) {
+        ThrowInfo(DataFormatBroken,
+                  "invalid number of skip index stats cells {} in {} bytes",
+                  header.num_cells,
+                  size);
+    }
+    std::vector<uint64_t> offsets(header.num_cells + 1);
+    std::memcpy(offsets.data(),
+                reader.Take(offsets.size() * sizeof(uint64_t)),
+                offsets.size() * sizeof(uint64_t));
+    cells.reserve(header.num_cells);
+    for (size_t i = 0; i < header.num_cells; i++) {
+        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > size) {
+            ThrowInfo(DataFormatBroken,
+                      "invalid offsets [{}, {}) of skip index stats cell {} "
+                      "in {} bytes",
+                      offsets[i],
+                      offsets[i + 1],
+                      i,
+                      size);
+        }
+        cells.emplace_back(FieldChunkMetricsFromBinary(
+            data + offsets[i], offsets[i + 1] - offsets[i], owner));
+    }
+    return cells;
+}
+
 std::unique_ptr<FieldChunkMetrics>
 SkipIndexStatsBuilder::Build(
     DataType data_type,
@@ -144,59 +472,128 @@ SkipIndexStatsBuilder::Build(
 
 std::unique_ptr<FieldChunkMetrics>
 SkipIndexStatsBuilder::Build(DataType data_type, const Chunk* chunk) const {
+    if (chunk == nullptr) {
+        return std::make_unique<NoneFieldChunkMetrics>();
+    }
+    return Build(data_type, chunk, 0, chunk->RowNums());
+}
+
+std::shared_ptr<const FieldPageMetrics>
+SkipIndexStatsBuilder::BuildPages(DataType data_type,
+                                  const Chunk* chunk,
+                                  int64_t page_rows) const {
+    // no page level filter reads arrays
+    if (chunk == nullptr || page_rows <= 0 || chunk->RowNums() <= page_rows ||
+        data_type == DataType::ARRAY) {
+        return nullptr;
+    }
+    // a bloom filter per page would cost more than the reads it saves
+    SkipIndexStatsBuilder page_builder;
+    auto page_metrics = std::make_shared<FieldPageMetrics>();
+    page_metrics->page_rows = page_rows;
+    const auto num_rows = chunk->RowNums();
+    page_metrics->pages.reserve((num_rows + page_rows - 1) / page_rows);
+    for (int64_t begin = 0; begin < num_rows; begin += page_rows) {
+        page_metrics->pages.emplace_back(page_builder.Build(
+            data_type, chunk, begin, std::min(begin + page_rows, num_rows)));
+    }
+    return page_metrics;
+}
+
+std::unique_ptr<FieldChunkMetrics>
+SkipIndexStatsBuilder::Build(DataType data_type,
+                             const Chunk* chunk,
+                             int64_t begin,
+                             int64_t end) const {
     auto none_ptr = std::make_unique<NoneFieldChunkMetrics>();
-    if (chunk == nullptr || chunk->RowNums() == 0) {
+    if (begin >= end) {
         return none_ptr;
     }
-    if (data_type == DataType::VARCHAR) {
+    if (IsStringDataType(data_type)) {
         auto string_chunk = static_cast<const StringChunk*>(chunk);
-        metricsInfo<std::string> info = ProcessStringFieldMetrics(string_chunk);
+        metricsInfo<std::string> info =
+            ProcessStringFieldMetrics(string_chunk, begin, end);
         return LoadMetrics<std::string>(info);
     }
+    if (data_type == DataType::ARRAY) {
+        // metrics of the elements, in the types array filters compare in
+        auto array_chunk = static_cast<const ArrayChunk*>(chunk);
+        switch (array_chunk->element_type()) {
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+            case DataType::INT64:
+                return LoadMetrics<int64_t>(
+                    ProcessArrayElementMetrics<int64_t>(
+                        array_chunk, begin, end));
+            case DataType::FLOAT:
+            case DataType::DOUBLE:
+                return LoadMetrics<double>(
+                    ProcessArrayElementMetrics<double>(
+                        array_chunk, begin, end));
+            case DataType::VARCHAR:
+            case DataType::STRING:
+                return LoadMetrics<std::string>(
+                    ProcessArrayElementMetrics<std::string>(
+                        array_chunk, begin, end));
+            default:
+                return none_ptr;
+        }
+    }
     auto fixed_chunk = static_cast<const FixedWidthChunk*>(chunk);
     auto span = fixed_chunk->Span();
 
     const void* chunk_data = span.data();
     const bool* valid_data = span.valid_data();
-    int64_t count = span.row_count();
+    if (valid_data != nullptr) {
+        valid_data += begin;
+    }
+    int64_t count = end - begin;
     switch (data_type) {
         case DataType::BOOL: {
-            const bool* typedData = static_cast<const bool*>(chunk_data);
+            const bool* typedData =
+                static_cast<const bool*>(chunk_data) + begin;
             auto info = ProcessFieldMetrics<bool>(typedData, valid_data, count);
             return LoadMetrics<bool>(info);
         }
         case DataType::INT8: {
-            const int8_t* typedData = static_cast<const int8_t*>(chunk_data);
+            const int8_t* typedData =
+                static_cast<const int8_t*>(chunk_data) + begin;
             auto info =
                 ProcessFieldMetrics<int8_t>(typedData, valid_data, count);
             return LoadMetrics<int8_t>(info);
         }
         case DataType::INT16: {
-            const int16_t* typedData = static_cast<const int16_t*>(chunk_data);
+            const int16_t* typedData =
+                static_cast<const int16_t*>(chunk_data) + begin;
             auto info =
                 ProcessFieldMetrics<int16_t>(typedData, valid_data, count);
             return LoadMetrics<int16_t>(info);
         }
         case DataType::INT32: {
-            const int32_t* typedData = static_cast<const int32_t*>(chunk_data);
+            const int32_t* typedData =
+                static_cast<const int32_t*>(chunk_data) + begin;
             auto info =
                 ProcessFieldMetrics<int32_t>(typedData, valid_data, count);
             return LoadMetrics<int32_t>(info);
         }
         case DataType::INT64: {
-            const int64_t* typedData = static_cast<const int64_t*>(chunk_data);
+            const int64_t* typedData =
+                static_cast<const int64_t*>(chunk_data) + begin;
             auto info =
                 ProcessFieldMetrics<int64_t>(typedData, valid_data, count);
             return LoadMetrics<int64_t>(info);
         }
         case DataType::FLOAT: {
-            const float* typedData = static_cast<const float*>(chunk_data);
+            const float* typedData =
+                static_cast<const float*>(chunk_data) + begin;
             auto info =
                 ProcessFieldMetrics<float>(typedData, valid_data, count);
             return LoadMetrics<float>(info);
         }
         case DataType::DOUBLE: {
-            const double* typedData = static_cast<const double*>(chunk_data);
+            const double* typedData =
+                static_cast<const double*>(chunk_data) + begin;
             auto info =
                 ProcessFieldMetrics<double>(typedData, valid_data, count);
             return LoadMetrics<double>(info);
@@ -204,4 +601,4 @@ SkipIndexStatsBuilder::Build(DataType data_type, const Chunk* chunk) const {
     }
     return none_ptr;
 }
-}  // namespace milvus::index
\ No newline at end of file
+}  // namespace milvus::index
@@ -17,9 +17,11 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -99,6 +101,65 @@ StringToFieldChunkMetricsType(std::string_view name) {
     return FieldChunkMetricsType::NONE;
 }
 
+// Binary layout of one FieldChunkMetrics: a FieldChunkMetricsBinaryHeader,
+// the min and max values, then the bloom filters. A bloom filter is its size
+// as uint64 followed by BloomFilter::Serialize() at the next 64 byte aligned
+// offset of the record, so that it loads in place from a record that is 64
+// byte aligned itself.
+constexpr uint32_t FIELD_CHUNK_METRICS_BINARY_MAGIC = 0x314d434d;  // "MCM1"
+constexpr uint16_t FIELD_CHUNK_METRICS_BINARY_VERSION = 1;
+
+// Binary layout of the metrics of all chunks of a field: a
+// SkipIndexStatsBinaryHeader, num_cells + 1 uint64 record offsets, then the
+// records, each at a 64 byte aligned offset.
+constexpr uint32_t SKIP_INDEX_STATS_BINARY_MAGIC = 0x3149534d;  // "MSI1"
+constexpr uint16_t SKIP_INDEX_STATS_BINARY_VERSION = 1;
+
+struct FieldChunkMetricsBinaryHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t type;        // FieldChunkMetricsType
+    uint8_t value_size;  // bytes of a numeric min and max
+    uint8_t has_value;
+    uint8_t bloom_filters;  // bit 0: bloom filter, bit 1: ngram bloom filter
+    uint8_t reserved[6];
+};
+static_assert(sizeof(FieldChunkMetricsBinaryHeader) == 16);
+
+struct SkipIndexStatsBinaryHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved0;
+    uint64_t num_cells;
+};
+static_assert(sizeof(SkipIndexStatsBinaryHeader) == 16);
+
+void
+AppendMetricsBinaryHeader(std::string& out,
+                          FieldChunkMetricsType type,
+                          uint8_t value_size,
+                          bool has_value,
+                          uint8_t bloom_filters);
+
+template <typename T>
+inline void
+AppendMetricsBinaryValue(std::string& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+inline void
+AppendMetricsBinaryValue(std::string& out, const std::string& value) {
+    AppendMetricsBinaryValue(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+// 'record_begin' is the offset of the record in 'out'.
+void
+AppendMetricsBinaryBloomFilter(std::string& out,
+                               size_t record_begin,
+                               const BloomFilter& bloom_filter);
+
 template <typename T>
 inline bool
 RangeShouldSkip(const T& value,
@@ -155,6 +216,8 @@ RangeShouldSkip(const T& lower_val,
     return should_skip;
 }
 
+struct FieldPageMetrics;
+
 class FieldChunkMetrics {
  public:
     FieldChunkMetrics() = default;
@@ -182,6 +245,13 @@ class FieldChunkMetrics {
         return false;
     }
 
+    // The least and greatest values of the chunk, nullopt if the metrics
+    // keep no min and max or the chunk has no value.
+    virtual std::optional<std::pair<Metrics, Metrics>>
+    GetMinMax() const {
+        return std::nullopt;
+    }
+
     cachinglayer::ResourceUsage
     CellByteSize() const {
         return cell_size_;
@@ -195,9 +265,34 @@ class FieldChunkMetrics {
     virtual nlohmann::json
     ToJson() const = 0;
 
+    // Appends the binary layout of the metrics to 'out'.
+    virtual void
+    Serialize(std::string& out) const = 0;
+
+    // Zone maps of the pages of the chunk, nullptr without them.
+    const std::shared_ptr<const FieldPageMetrics>&
+    GetPageMetrics() const {
+        return page_metrics_;
+    }
+
+    void
+    SetPageMetrics(std::shared_ptr<const FieldPageMetrics> page_metrics) {
+        page_metrics_ = std::move(page_metrics);
+    }
+
  protected:
     bool has_value_{false};
     cachinglayer::ResourceUsage cell_size_ = {0, 0};
+    // shared by the clones of the cell
+    std::shared_ptr<const FieldPageMetrics> page_metrics_;
+};
+
+// Metrics of consecutive ranges of page_rows rows of a chunk, page i covers
+// rows [i * page_rows, (i + 1) * page_rows). Pages narrow what a filter reads
+// inside a chunk whose own min and max span most of the values.
+struct FieldPageMetrics {
+    int64_t page_rows = 0;
+    std::vector<std::unique_ptr<FieldChunkMetrics>> pages;
 };
 
 class NoneFieldChunkMetrics : public FieldChunkMetrics {
@@ -239,6 +334,11 @@ class NoneFieldChunkMetrics : public FieldChunkMetrics {
         j["type"] = FieldChunkMetricsTypeToString(GetMetricsType());
         return j;
     }
+
+    void
+    Serialize(std::string& out) const override {
+        AppendMetricsBinaryHeader(out, GetMetricsType(), 0, false, 0);
+    }
 };
 
 class BooleanFieldChunkMetrics : public FieldChunkMetrics {
@@ -303,6 +403,16 @@ class BooleanFieldChunkMetrics : public FieldChunkMetrics {
         return j;
     }
 
+    void
+    Serialize(std::string& out) const override {
+        AppendMetricsBinaryHeader(
+            out, GetMetricsType(), sizeof(bool), this->has_value_, 0);
+        if (this->has_value_) {
+            AppendMetricsBinaryValue(out, has_true_);
+            AppendMetricsBinaryValue(out, has_false_);
+        }
+    }
+
  private:
     bool has_true_ = false;
     bool has_false_ = false;
@@ -346,18 +456,13 @@ class FloatFieldChunkMetrics : public FieldChunkMetrics {
                 return false;  // Mixed types in IN list, cannot evaluate
             }
         }
-        T typed_min = std::get<T>(values[0]);
-        T typed_max = std::get<T>(values[0]);
+        // every value on its own, the hull of a sparse list rarely misses
         for (const auto& v : values) {
-            const T& current_val = std::get<T>(v);
-            if (current_val < typed_min) {
-                typed_min = current_val;
-            }
-            if (current_val > typed_max) {
-                typed_max = current_val;
+            if (!RangeShouldSkip(std::get<T>(v), min_, max_, OpType::Equal)) {
+                return false;
             }
         }
-        return RangeShouldSkip(typed_min, typed_max, min_, max_, true, true);
+        return true;
     }
 
     bool
@@ -387,6 +492,14 @@ class FloatFieldChunkMetrics : public FieldChunkMetrics {
         return FieldChunkMetricsType::FLOAT;
     }
 
+    std::optional<std::pair<Metrics, Metrics>>
+    GetMinMax() const override {
+        if (!this->has_value_) {
+            return std::nullopt;
+        }
+        return std::make_pair(Metrics{min_}, Metrics{max_});
+    }
+
     nlohmann::json
     ToJson() const override {
         nlohmann::json j;
@@ -398,6 +511,16 @@ class FloatFieldChunkMetrics : public FieldChunkMetrics {
         return j;
     }
 
+    void
+    Serialize(std::string& out) const override {
+        AppendMetricsBinaryHeader(
+            out, GetMetricsType(), sizeof(T), this->has_value_, 0);
+        if (this->has_value_) {
+            AppendMetricsBinaryValue(out, min_);
+            AppendMetricsBinaryValue(out, max_);
+        }
+    }
+
  private:
     T min_;
     T max_;
@@ -426,6 +549,14 @@ class IntFieldChunkMetrics : public FieldChunkMetrics {
         return FieldChunkMetricsType::INT;
     }
 
+    std::optional<std::pair<Metrics, Metrics>>
+    GetMinMax() const override {
+        if (!this->has_value_) {
+            return std::nullopt;
+        }
+        return std::make_pair(Metrics{min_}, Metrics{max_});
+    }
+
     bool
     CanSkipUnaryRange(OpType op_type, const Metrics& val) const override {
         if (!this->has_value_) {
@@ -453,24 +584,14 @@ class IntFieldChunkMetrics : public FieldChunkMetrics {
                 return false;
             }
         }
-        if (!bloom_filter_) {
-            T typed_min = std::get<T>(values[0]);
-            T typed_max = std::get<T>(values[0]);
-            for (const auto& v : values) {
-                const T& current_val = std::get<T>(v);
-                if (current_val < typed_min) {
-                    typed_min = current_val;
-                }
-                if (current_val > typed_max) {
-                    typed_max = current_val;
-                }
-            }
-            return RangeShouldSkip(
-                typed_min, typed_max, min_, max_, true, true);
-        }
+        // every value on its own, min/max first as it is the cheaper test
         for (const auto& v : values) {
             const T& current_val = std::get<T>(v);
-            if (bloom_filter_->Test(
+            if (RangeShouldSkip(current_val, min_, max_, OpType::Equal)) {
+                continue;
+            }
+            if (!bloom_filter_ ||
+                bloom_filter_->Test(
                     reinterpret_cast<const uint8_t*>(&current_val),
                     sizeof(current_val))) {
                 return false;
@@ -518,6 +639,24 @@ class IntFieldChunkMetrics : public FieldChunkMetrics {
         return j;
     }
 
+    void
+    Serialize(std::string& out) const override {
+        const auto record_begin = out.size();
+        const bool has_bloom_filter = this->has_value_ && bloom_filter_;
+        AppendMetricsBinaryHeader(out,
+                                  GetMetricsType(),
+                                  sizeof(T),
+                                  this->has_value_,
+                                  has_bloom_filter ? 1 : 0);
+        if (this->has_value_) {
+            AppendMetricsBinaryValue(out, min_);
+            AppendMetricsBinaryValue(out, max_);
+        }
+        if (has_bloom_filter) {
+            AppendMetricsBinaryBloomFilter(out, record_begin, *bloom_filter_);
+        }
+    }
+
  private:
     T min_;
     T max_;
@@ -618,25 +757,14 @@ class StringFieldChunkMetrics : public FieldChunkMetrics {
             }
             string_values.push_back(*sv);
         }
-        if (!bloom_filter_) {
-            std::string_view min, max;
-            for (auto v : string_values) {
-                if (min.empty() || v < min) {
-                    min = v;
-                }
-                if (max.empty() || v > max) {
-                    max = v;
-                }
-            }
-            return RangeShouldSkip(min,
-                                   max,
-                                   std::string_view(min_),
-                                   std::string_view(max_),
-                                   true,
-                                   true);
-        }
+        // every value on its own, min/max first as it is the cheaper test
+        const std::string_view min(min_);
+        const std::string_view max(max_);
         for (auto v : string_values) {
-            if (bloom_filter_->Test(v)) {
+            if (RangeShouldSkip(v, min, max, OpType::Equal)) {
+                continue;
+            }
+            if (!bloom_filter_ || bloom_filter_->Test(v)) {
                 return false;
             }
         }
@@ -686,6 +814,31 @@ class StringFieldChunkMetrics : public FieldChunkMetrics {
         return j;
     }
 
+    void
+    Serialize(std::string& out) const override {
+        const auto record_begin = out.size();
+        const bool has_bloom_filter = this->has_value_ && bloom_filter_;
+        const bool has_ngram_bloom_filter =
+            this->has_value_ && ngram_bloom_filter_;
+        AppendMetricsBinaryHeader(
+            out,
+            GetMetricsType(),
+            0,
+            this->has_value_,
+            (has_bloom_filter ? 1 : 0) | (has_ngram_bloom_filter ? 2 : 0));
+        if (this->has_value_) {
+            AppendMetricsBinaryValue(out, min_);
+            AppendMetricsBinaryValue(out, max_);
+        }
+        if (has_bloom_filter) {
+            AppendMetricsBinaryBloomFilter(out, record_begin, *bloom_filter_);
+        }
+        if (has_ngram_bloom_filter) {
+            AppendMetricsBinaryBloomFilter(
+                out, record_begin, *ngram_bloom_filter_);
+        }
+    }
+
     static std::optional<std::string_view>
     ExtractStringView(const Metrics& val) {
         if (std::holds_alternative<std::string_view>(val)) {
@@ -768,6 +921,27 @@ NewFieldMetrics(const nlohmann::json& data) {
     return none_metrics;
 }
 
+// Loads metrics written by FieldChunkMetrics::Serialize(), bloom filters
+// reference 'data' in place when 'owner' keeps it alive. Metrics older
+// versions wrote as JSON text are parsed as such, which needs 'data_type'.
+std::unique_ptr<FieldChunkMetrics>
+LoadFieldChunkMetrics(DataType data_type,
+                      const uint8_t* data,
+                      size_t size,
+                      std::shared_ptr<const void> owner = nullptr);
+
+// Serializes the metrics of every chunk of a field.
+std::string
+SerializeSkipIndexStats(
+    const std::vector<std::unique_ptr<FieldChunkMetrics>>& cells);
+
+// Loads what SerializeSkipIndexStats() wrote, or a JSON array of metrics.
+std::vector<std::unique_ptr<FieldChunkMetrics>>
+LoadSkipIndexStats(DataType data_type,
+                   const uint8_t* data,
+                   size_t size,
+                   std::shared_ptr<const void> owner = nullptr);
+
 class SkipIndexStatsBuilder {
  public:
     SkipIndexStatsBuilder() = default;
@@ -777,6 +951,11 @@ class SkipIndexStatsBuilder {
         if (enable_bloom_filter.has_value()) {
             enable_bloom_filter_ = *enable_bloom_filter;
         }
+        auto bloom_filter_type =
+            GetValueFromConfig<std::string>(config, "bloom_filter_type");
+        if (bloom_filter_type.has_value()) {
+            bloom_filter_type_ = StringToBFType(*bloom_filter_type);
+        }
     }
 
     std::unique_ptr<FieldChunkMetrics>
@@ -791,7 +970,21 @@ class SkipIndexStatsBuilder {
     std::unique_ptr<FieldChunkMetrics>
     Build(DataType data_type, const Chunk* chunk) const;
 
+    // Metrics of every page_rows rows of 'chunk', nullptr if the chunk fits
+    // in a single page. Pages keep no bloom filters.
+    std::shared_ptr<const FieldPageMetrics>
+    BuildPages(DataType data_type,
+               const Chunk* chunk,
+               int64_t page_rows) const;
+
  private:
+    // Metrics of rows [begin, end) of 'chunk'.
+    std::unique_ptr<FieldChunkMetrics>
+    Build(DataType data_type,
+          const Chunk* chunk,
+          int64_t begin,
+          int64_t end) const;
+
     template <typename T>
     struct metricsInfo {
         int64_t total_rows_ = 0;
@@ -1002,17 +1195,19 @@ class SkipIndexStatsBuilder {
     }
 
     metricsInfo<std::string>
-    ProcessStringFieldMetrics(const StringChunk* chunk) const {
+    ProcessStringFieldMetrics(const StringChunk* chunk,
+                              int64_t begin,
+                              int64_t end) const {
         // all captured by reference
         bool has_first_valid = false;
-        int64_t total_rows = chunk->RowNums();
+        int64_t total_rows = end - begin;
         int64_t null_count = 0;
         std::string_view min;
         std::string_view max;
         ankerl::unordered_dense::set<std::string_view> unique_values;
         ankerl::unordered_dense::set<std::string> ngram_values;
 
-        for (int64_t i = 0; i < total_rows; ++i) {
+        for (int64_t i = begin; i < end; ++i) {
             bool is_valid = chunk->isValid(i);
             if (!is_valid) {
                 null_count++;
@@ -1050,6 +1245,46 @@ class SkipIndexStatsBuilder {
                 std::move(ngram_values)};
     }
 
+    // Metrics of the elements of the arrays in rows [begin, end), as if every
+    // element was a row. Null rows and empty arrays add no element.
+    template <typename T>
+    metricsInfo<T>
+    ProcessArrayElementMetrics(const ArrayChunk* chunk,
+                               int64_t begin,
+                               int64_t end) const {
+        using ElementType = MetricsDataType<T>;
+        std::vector<ElementType> elements;
+        for (int64_t i = begin; i < end; ++i) {
+            if (!chunk->isValid(i)) {
+                continue;
+            }
+            auto view = chunk->View(i);
+            for (int j = 0; j < view.length(); ++j) {
+                elements.push_back(view.template get_data<ElementType>(j));
+            }
+        }
+        if constexpr (!std::is_same_v<T, std::string>) {
+            return ProcessFieldMetrics<T>(
+                elements.data(), nullptr, elements.size());
+        } else {
+            metricsInfo<std::string> info;
+            info.total_rows_ = elements.size();
+            for (size_t i = 0; i < elements.size(); ++i) {
+                const auto value = elements[i];
+                if (i == 0 || value < info.min_) {
+                    info.min_ = value;
+                }
+                if (i == 0 || value > info.max_) {
+                    info.max_ = value;
+                }
+                if (enable_bloom_filter_) {
+                    info.unique_values_.insert(value);
+                }
+            }
+            return info;
+        }
+    }
+
     template <typename T>
     std::unique_ptr<FieldChunkMetrics>
     LoadMetrics(const metricsInfo<T>& info) const {
@@ -1085,7 +1320,7 @@ class SkipIndexStatsBuilder {
             BloomFilterPtr bloom_filter =
                 NewBloomFilterWithType(info.unique_values_.size(),
                                        DEFAULT_BLOOM_FILTER_FALSE_POSITIVE_RATE,
-                                       BFType::Blocked);
+                                       bloom_filter_type_);
             if constexpr (std::is_same_v<T, std::string>) {
                 for (const auto& val : info.unique_values_) {
                     bloom_filter->Add(val);
@@ -1097,7 +1332,7 @@ class SkipIndexStatsBuilder {
                 BloomFilterPtr ngram_bloom_filter = NewBloomFilterWithType(
                     info.ngram_values_.size(),
                     DEFAULT_BLOOM_FILTER_FALSE_POSITIVE_RATE,
-                    BFType::Blocked);
+                    bloom_filter_type_);
                 for (const auto& ngram : info.ngram_values_) {
                     ngram_bloom_filter->Add(std::string_view(ngram));
                 }
@@ -1119,6 +1354,8 @@ class SkipIndexStatsBuilder {
 
  private:
     bool enable_bloom_filter_ = false;
+    // SplitBlock probes a single cache line per key
+    BFType bloom_filter_type_ = BFType::Blocked;
 };
 
 }  // namespace milvus::index
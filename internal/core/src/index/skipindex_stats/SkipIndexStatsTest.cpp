@@ -1095,3 +1095,253 @@ TEST_F(SkipIndexStatsBuilderTest,
     ASSERT_TRUE(
         metrics->CanSkipUnaryRange(OpType::PostfixMatch, std::string("xyz")));
 }
+
+TEST(SkipIndexStatsBinaryTest, RoundTrip) {
+    auto bloom_filter = NewBloomFilterWithType(100, 0.01, BFType::Blocked);
+    auto ngram_bloom_filter =
+        NewBloomFilterWithType(100, 0.01, BFType::Blocked);
+    for (int64_t v : {10, 20, 30}) {
+        bloom_filter->Add(reinterpret_cast<const uint8_t*>(&v), sizeof(v));
+    }
+    ngram_bloom_filter->Add("app");
+
+    std::vector<std::unique_ptr<FieldChunkMetrics>> cells;
+    cells.emplace_back(std::make_unique<IntFieldChunkMetrics<int64_t>>(
+        10, 30, bloom_filter));
+    cells.emplace_back(std::make_unique<NoneFieldChunkMetrics>());
+    cells.emplace_back(std::make_unique<FloatFieldChunkMetrics<double>>(
+        -1.5, 2.5));
+    cells.emplace_back(std::make_unique<BooleanFieldChunkMetrics>(true, false));
+    cells.emplace_back(std::make_unique<StringFieldChunkMetrics>(
+        "apple", "banana", nullptr, ngram_bloom_filter));
+
+    auto buffer =
+        std::make_shared<std::string>(SerializeSkipIndexStats(cells));
+    auto loaded =
+        LoadSkipIndexStats(DataType::INT64,
+                           reinterpret_cast<const uint8_t*>(buffer->data()),
+                           buffer->size(),
+                           buffer);
+    ASSERT_EQ(loaded.size(), cells.size());
+    for (size_t i = 0; i < cells.size(); i++) {
+        EXPECT_EQ(loaded[i]->GetMetricsType(), cells[i]->GetMetricsType());
+    }
+    for (size_t i : {1, 2, 3}) {
+        EXPECT_EQ(loaded[i]->ToJson(), cells[i]->ToJson()) << i;
+    }
+
+    // min and max
+    EXPECT_TRUE(loaded[0]->CanSkipUnaryRange(OpType::GreaterThan, int64_t(30)));
+    EXPECT_FALSE(loaded[0]->CanSkipUnaryRange(OpType::LessThan, int64_t(11)));
+    EXPECT_TRUE(loaded[2]->CanSkipUnaryRange(OpType::LessThan, -1.5));
+    // bloom filters, probed in the serialized buffer
+    for (int64_t v : {10, 20, 30}) {
+        EXPECT_FALSE(loaded[0]->CanSkipUnaryRange(OpType::Equal, v));
+    }
+    EXPECT_EQ(loaded[0]->CanSkipUnaryRange(OpType::Equal, int64_t(15)),
+              cells[0]->CanSkipUnaryRange(OpType::Equal, int64_t(15)));
+    EXPECT_FALSE(loaded[4]->CanSkipUnaryRange(OpType::InnerMatch,
+                                              std::string("app")));
+    EXPECT_TRUE(loaded[3]->CanSkipIn({false, false}) ==
+                cells[3]->CanSkipIn({false, false}));
+}
+
+TEST(SkipIndexStatsBinaryTest, JsonFallback) {
+    nlohmann::json json = nlohmann::json::array();
+    json.push_back(FloatFieldChunkMetrics<float>(1.0f, 2.0f).ToJson());
+    json.push_back(NoneFieldChunkMetrics().ToJson());
+    auto text = json.dump();
+    auto loaded = LoadSkipIndexStats(
+        DataType::FLOAT,
+        reinterpret_cast<const uint8_t*>(text.data()),
+        text.size());
+    ASSERT_EQ(loaded.size(), 2);
+    EXPECT_EQ(loaded[0]->GetMetricsType(), FieldChunkMetricsType::FLOAT);
+    EXPECT_TRUE(loaded[0]->CanSkipUnaryRange(OpType::GreaterThan, 2.0f));
+    EXPECT_EQ(loaded[1]->GetMetricsType(), FieldChunkMetricsType::NONE);
+
+    auto record = std::string();
+    loaded[0]->Serialize(record);
+    auto metrics = LoadFieldChunkMetrics(
+        DataType::FLOAT,
+        reinterpret_cast<const uint8_t*>(record.data()),
+        record.size());
+    EXPECT_EQ(metrics->ToJson(), loaded[0]->ToJson());
+
+    record.resize(record.size() - 1);
+    EXPECT_ANY_THROW(LoadFieldChunkMetrics(
+        DataType::FLOAT,
+        reinterpret_cast<const uint8_t*>(record.data()),
+        record.size()));
+}
+
+TEST_F(SkipIndexStatsBuilderTest, BuildPagesFromChunk) {
+    auto make_chunk = [](const auto& field_data, DataType data_type) {
+        storage::InsertEventData event_data;
+        auto payload_reader =
+            std::make_shared<milvus::storage::PayloadReader>(field_data);
+        event_data.payload_reader = payload_reader;
+        auto ser_data = event_data.Serialize();
+        auto buffer = std::make_shared<arrow::io::BufferReader>(
+            ser_data.data() + 2 * sizeof(milvus::Timestamp),
+            ser_data.size() - 2 * sizeof(milvus::Timestamp));
+
+        parquet::arrow::FileReaderBuilder reader_builder;
+        EXPECT_TRUE(reader_builder.Open(buffer).ok());
+        std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
+        EXPECT_TRUE(reader_builder.Build(&arrow_reader).ok());
+
+        std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+        EXPECT_TRUE(arrow_reader->GetRecordBatchReader(&rb_reader).ok());
+
+        FieldMeta field_meta(FieldName("a"),
+                             milvus::FieldId(1),
+                             data_type,
+                             false,
+                             std::nullopt);
+        arrow::ArrayVector array_vec = read_single_column_batches(rb_reader);
+        return create_chunk(field_meta, array_vec);
+    };
+
+    // INT64, sorted, 10 pages of 100 rows
+    {
+        FixedVector<int64_t> data(1000);
+        for (int64_t i = 0; i < 1000; i++) {
+            data[i] = i;
+        }
+        auto field_data = milvus::storage::CreateFieldData(
+            storage::DataType::INT64, DataType::NONE);
+        field_data->FillFieldData(data.data(), data.size());
+        auto chunk = make_chunk(field_data, DataType::INT64);
+
+        EXPECT_EQ(builder_->BuildPages(DataType::INT64, chunk.get(), 0),
+                  nullptr);
+        EXPECT_EQ(builder_->BuildPages(DataType::INT64, chunk.get(), 1000),
+                  nullptr);
+
+        auto page_metrics =
+            builder_->BuildPages(DataType::INT64, chunk.get(), 100);
+        ASSERT_NE(page_metrics, nullptr);
+        EXPECT_EQ(page_metrics->page_rows, 100);
+        ASSERT_EQ(page_metrics->pages.size(), 10);
+        for (int64_t i = 0; i < 10; i++) {
+            const auto& page = page_metrics->pages[i];
+            EXPECT_EQ(page->CanSkipUnaryRange(OpType::Equal, int64_t(350)),
+                      i != 3);
+            EXPECT_EQ(page->CanSkipUnaryRange(OpType::GreaterThan,
+                                              int64_t(899)),
+                      i != 9);
+            EXPECT_EQ(page->CanSkipBinaryRange(
+                          int64_t(150), int64_t(250), true, false),
+                      i != 1 && i != 2);
+        }
+
+        // the last page is partial
+        page_metrics = builder_->BuildPages(DataType::INT64, chunk.get(), 300);
+        ASSERT_NE(page_metrics, nullptr);
+        ASSERT_EQ(page_metrics->pages.size(), 4);
+        EXPECT_FALSE(page_metrics->pages[3]->CanSkipUnaryRange(
+            OpType::Equal, int64_t(999)));
+        EXPECT_TRUE(page_metrics->pages[3]->CanSkipUnaryRange(
+            OpType::LessThan, int64_t(900)));
+    }
+
+    // VARCHAR
+    {
+        FixedVector<std::string> data = {
+            "apple", "banana", "cherry", "date", "melon", "peach"};
+        auto field_data = milvus::storage::CreateFieldData(
+            storage::DataType::VARCHAR, DataType::NONE);
+        field_data->FillFieldData(data.data(), data.size());
+        auto chunk = make_chunk(field_data, DataType::STRING);
+
+        auto page_metrics =
+            builder_->BuildPages(DataType::VARCHAR, chunk.get(), 2);
+        ASSERT_NE(page_metrics, nullptr);
+        ASSERT_EQ(page_metrics->pages.size(), 3);
+        EXPECT_FALSE(page_metrics->pages[1]->CanSkipUnaryRange(
+            OpType::Equal, std::string("date")));
+        EXPECT_TRUE(page_metrics->pages[0]->CanSkipUnaryRange(
+            OpType::Equal, std::string("date")));
+        EXPECT_TRUE(page_metrics->pages[2]->CanSkipUnaryRange(
+            OpType::LessThan, std::string("melon")));
+    }
+}
+
+TEST_F(SkipIndexStatsBuilderTest, InQueryTestsEveryValue) {
+    // without a bloom filter, only min/max tell
+    SkipIndexStatsBuilder builder;
+    auto schema = arrow::schema({arrow::field("col", arrow::int64())});
+    arrow::Int64Builder array_builder;
+    for (int64_t i = 400; i <= 600; ++i) {
+        ASSERT_TRUE(array_builder.Append(i).ok());
+    }
+    std::shared_ptr<arrow::Array> array;
+    ASSERT_TRUE(array_builder.Finish(&array).ok());
+    auto batch = arrow::RecordBatch::Make(schema, array->length(), {array});
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches = {batch};
+
+    auto metrics = builder.Build(batches, 0, arrow::Type::INT64);
+    ASSERT_NE(metrics, nullptr);
+    // the hull [0, 1000] covers the chunk, no value is in it
+    std::vector<Metrics> in_values1 = {int64_t(0), int64_t(1000)};
+    EXPECT_TRUE(metrics->CanSkipIn(in_values1));
+    std::vector<Metrics> in_values2 = {int64_t(0), int64_t(500)};
+    EXPECT_FALSE(metrics->CanSkipIn(in_values2));
+}
+
+TEST_F(SkipIndexStatsBuilderTest, BuildFromArrayChunk) {
+    auto make_array = [](std::vector<int64_t> values) {
+        milvus::proto::schema::ScalarField field;
+        for (auto v : values) {
+            field.mutable_long_data()->add_data(v);
+        }
+        return Array(field);
+    };
+    FixedVector<Array> data = {
+        make_array({1, 5}), make_array({}), make_array({20, 9})};
+    auto field_data = milvus::storage::CreateFieldData(
+        storage::DataType::ARRAY, DataType::NONE);
+    field_data->FillFieldData(data.data(), data.size());
+
+    storage::InsertEventData event_data;
+    auto payload_reader =
+        std::make_shared<milvus::storage::PayloadReader>(field_data);
+    event_data.payload_reader = payload_reader;
+    auto ser_data = event_data.Serialize();
+    auto buffer = std::make_shared<arrow::io::BufferReader>(
+        ser_data.data() + 2 * sizeof(milvus::Timestamp),
+        ser_data.size() - 2 * sizeof(milvus::Timestamp));
+
+    parquet::arrow::FileReaderBuilder reader_builder;
+    ASSERT_TRUE(reader_builder.Open(buffer).ok());
+    std::unique_ptr<parquet::arrow::FileReader> arrow_reader;
+    ASSERT_TRUE(reader_builder.Build(&arrow_reader).ok());
+
+    std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+    ASSERT_TRUE(arrow_reader->GetRecordBatchReader(&rb_reader).ok());
+
+    FieldMeta field_meta(FieldName("a"),
+                         milvus::FieldId(1),
+                         DataType::ARRAY,
+                         DataType::INT64,
+                         false,
+                         std::nullopt);
+    arrow::ArrayVector array_vec = read_single_column_batches(rb_reader);
+    auto chunk = create_chunk(field_meta, array_vec);
+
+    // metrics of the elements, not of the rows
+    auto metrics = builder_->Build(DataType::ARRAY, chunk.get());
+    ASSERT_NE(metrics, nullptr);
+    EXPECT_EQ(metrics->GetMetricsType(), FieldChunkMetricsType::INT);
+    EXPECT_FALSE(metrics->CanSkipUnaryRange(OpType::Equal, int64_t(20)));
+    EXPECT_TRUE(metrics->CanSkipUnaryRange(OpType::Equal, int64_t(21)));
+    EXPECT_TRUE(metrics->CanSkipUnaryRange(OpType::GreaterThan, int64_t(20)));
+    std::vector<Metrics> in_values1 = {int64_t(0), int64_t(30)};
+    EXPECT_TRUE(metrics->CanSkipIn(in_values1));
+    std::vector<Metrics> in_values2 = {int64_t(0), int64_t(9)};
+    EXPECT_FALSE(metrics->CanSkipIn(in_values2));
+
+    EXPECT_EQ(builder_->BuildPages(DataType::ARRAY, chunk.get(), 1),
+              nullptr);
+}
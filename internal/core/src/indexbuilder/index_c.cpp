@@ -39,6 +39,7 @@
 #include "index/Meta.h"
 #include "index/json_stats/JsonKeyStats.h"
 #include "milvus-storage/filesystem/fs.h"
+#include "monitor/jemalloc_arena.h"
 #include "monitor/scope_metric.h"
 
 using namespace milvus;
@@ -193,6 +194,8 @@ CreateIndex(CIndex* res_index,
             const uint8_t* serialized_build_index_info,
             const uint64_t len) {
     SCOPE_CGO_CALL_METRIC();
+    milvus::monitor::ScopedJemallocArena arena(
+        milvus::monitor::JemallocArena::kIndexBuild);
 
     try {
         auto build_index_info =
@@ -307,6 +310,8 @@ BuildJsonKeyIndex(ProtoLayoutInterface result,
                   const uint8_t* serialized_build_index_info,
                   const uint64_t len) {
     SCOPE_CGO_CALL_METRIC();
+    milvus::monitor::ScopedJemallocArena arena(
+        milvus::monitor::JemallocArena::kIndexBuild);
 
     try {
         auto build_index_info =
@@ -419,6 +424,8 @@ BuildTextIndex(ProtoLayoutInterface result,
                const uint8_t* serialized_build_index_info,
                const uint64_t len) {
     SCOPE_CGO_CALL_METRIC();
+    milvus::monitor::ScopedJemallocArena arena(
+        milvus::monitor::JemallocArena::kIndexBuild);
 
     try {
         auto build_index_info =
@@ -54,6 +54,10 @@ SelectHashFunction(HashFunction hash_type) {
     }
 }
 
+// base hashes per tile of texts, 256KB so a tile stays in L2 while every
+// group of 8 hash functions passes over it
+constexpr int64_t kRotationTileHashes = 1 << 15;
+
 // ComputeBatchRotation implementation
 void
 ComputeBatchRotation(const uint64_t* base_hashes,
@@ -63,34 +67,46 @@ ComputeBatchRotation(const uint64_t* base_hashes,
                      const uint64_t* perm_b,
                      int32_t num_hashes,
                      uint32_t* signatures) {
-    int32_t base_hash_offset = 0;
-
-    for (int32_t text_idx = 0; text_idx < num_texts; text_idx++) {
-        uint32_t* sig = signatures + text_idx * num_hashes;
-        int32_t shingle_count = shingle_counts[text_idx];
-
-        for (int32_t i = 0; i < num_hashes; i++) {
-            sig[i] = MAX_HASH_32;
+    int64_t base_hash_offset = 0;
+    int32_t tile_begin = 0;
+    while (tile_begin < num_texts) {
+        // at least one text per tile, however long
+        int32_t tile_end = tile_begin + 1;
+        int64_t tile_hashes = shingle_counts[tile_begin];
+        while (tile_end < num_texts &&
+               tile_hashes + shingle_counts[tile_end] <= kRotationTileHashes) {
+            tile_hashes += shingle_counts[tile_end++];
         }
+        const uint64_t* tile_base = base_hashes + base_hash_offset;
+        const int32_t* tile_counts = shingle_counts + tile_begin;
+        int32_t tile_texts = tile_end - tile_begin;
+        uint32_t* tile_sigs =
+            signatures + static_cast<int64_t>(tile_begin) * num_hashes;
 
         int32_t i = 0;
         for (; i + 8 <= num_hashes; i += 8) {
             // Use function pointer for SIMD dispatch
-            linear_and_find_min_batch8_impl(base_hashes + base_hash_offset,
-                                            shingle_count,
-                                            perm_a + i,
-                                            perm_b + i,
-                                            sig + i);
+            linear_and_find_min_batch8_multi_impl(tile_base,
+                                                  tile_counts,
+                                                  tile_texts,
+                                                  perm_a + i,
+                                                  perm_b + i,
+                                                  tile_sigs + i,
+                                                  num_hashes);
         }
         for (; i < num_hashes; i++) {
-            // Use function pointer for SIMD dispatch
-            sig[i] = linear_and_find_min_impl(base_hashes + base_hash_offset,
-                                              shingle_count,
-                                              perm_a[i],
-                                              perm_b[i]);
+            const uint64_t* base = tile_base;
+            for (int32_t t = 0; t < tile_texts; t++) {
+                // Use function pointer for SIMD dispatch
+                tile_sigs[static_cast<int64_t>(t) * num_hashes + i] =
+                    linear_and_find_min_impl(
+                        base, tile_counts[t], perm_a[i], perm_b[i]);
+                base += tile_counts[t];
+            }
         }
 
-        base_hash_offset += shingle_count;
+        base_hash_offset += tile_hashes;
+        tile_begin = tile_end;
     }
 }
 }  // namespace
@@ -136,8 +152,13 @@ HashNGramWindow(const char** texts,
     } else {
         auto* tokenizer =
             static_cast<milvus::tantivy::Tokenizer*>(tokenizer_ptr);
-        std::vector<char> shingle_buffer;
-        shingle_buffer.reserve(1000);
+        // the tokens of a text back to back, token i at
+        // [token_offsets[i], token_offsets[i + 1]), so a shingle is a slice
+        // of token_bytes and is hashed without copying
+        std::vector<char> token_bytes;
+        std::vector<size_t> token_offsets;
+        token_bytes.reserve(1000);
+        token_offsets.reserve(128);
 
         for (int32_t text_idx = 0; text_idx < num_texts; text_idx++) {
             // TODO: optimize to avoid copying text into std::string
@@ -145,13 +166,17 @@ HashNGramWindow(const char** texts,
                 std::string(texts[text_idx], text_lengths[text_idx]));
 
             auto* ts = token_stream.get();
-            std::vector<const char*> tokens;
-            tokens.reserve(128);
+            token_bytes.clear();
+            token_offsets.assign(1, 0);
             while (ts->advance()) {
-                tokens.push_back(ts->get_token_no_copy());
+                const char* token = ts->get_token_no_copy();
+                token_bytes.insert(
+                    token_bytes.end(), token, token + std::strlen(token));
+                token_offsets.push_back(token_bytes.size());
             }
 
-            int32_t token_count = static_cast<int32_t>(tokens.size());
+            int32_t token_count =
+                static_cast<int32_t>(token_offsets.size()) - 1;
 
             if (token_count == 0) {
                 hash_counts[text_idx] = 0;
@@ -159,30 +184,18 @@ HashNGramWindow(const char** texts,
             }
 
             if (token_count < shingle_size) {
-                shingle_buffer.clear();
-                for (int32_t i = 0; i < token_count; i++) {
-                    const char* token = tokens[i];
-                    size_t len = std::strlen(token);
-                    shingle_buffer.insert(
-                        shingle_buffer.end(), token, token + len);
-                }
                 all_base_hashes.push_back(
-                    hash_func(shingle_buffer.data(), shingle_buffer.size()));
+                    hash_func(token_bytes.data(), token_bytes.size()));
                 hash_counts[text_idx] = 1;
             } else {
                 int32_t num_shingles = token_count - shingle_size + 1;
                 hash_counts[text_idx] = num_shingles;
 
                 for (int32_t i = 0; i < num_shingles; i++) {
-                    shingle_buffer.clear();
-                    for (int32_t j = 0; j < shingle_size; j++) {
-                        const char* token = tokens[i + j];
-                        size_t len = std::strlen(token);
-                        shingle_buffer.insert(
-                            shingle_buffer.end(), token, token + len);
-                    }
-                    all_base_hashes.push_back(hash_func(shingle_buffer.data(),
-                                                        shingle_buffer.size()));
+                    auto begin = token_offsets[i];
+                    auto end = token_offsets[i + shingle_size];
+                    all_base_hashes.push_back(
+                        hash_func(token_bytes.data() + begin, end - begin));
                 }
             }
         }
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "MinHashHook.h"
+
+#include <atomic>
 #include "fusion_compute/fusion_compute_native.h"
 #include "log/Log.h"
 
@@ -41,9 +43,35 @@ namespace minhash {
 LinearAndFindMinFunc linear_and_find_min_impl = linear_and_find_min_native;
 LinearAndFindMinBatch8Func linear_and_find_min_batch8_impl =
     linear_and_find_min_batch8_native;
+LinearAndFindMinBatch8MultiFunc linear_and_find_min_batch8_multi_impl =
+    linear_and_find_min_batch8_multi_native;
 
 namespace {
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || \
+    defined(_M_ARM64)
+// for the instruction sets without a multi text kernel, runs the selected
+// batch8 kernel text by text
+void
+linear_and_find_min_batch8_multi_by_text(const uint64_t* base,
+                                         const int32_t* shingle_counts,
+                                         int32_t num_texts,
+                                         const uint64_t* perm_a,
+                                         const uint64_t* perm_b,
+                                         uint32_t* sig,
+                                         size_t sig_stride) {
+    for (int32_t t = 0; t < num_texts; t++) {
+        uint32_t* text_sig = sig + t * sig_stride;
+        for (int k = 0; k < 8; k++) {
+            text_sig[k] = MAX_HASH_32;
+        }
+        linear_and_find_min_batch8_impl(
+            base, shingle_counts[t], perm_a, perm_b, text_sig);
+        base += shingle_counts[t];
+    }
+}
+#endif
+
 #if defined(__x86_64__) || defined(_M_X64)
 bool
 cpu_support_avx512() {
@@ -105,47 +133,87 @@ cpu_support_neon() {
 
 }  // anonymous namespace
 
-void
-minhash_hook_init() {
-    static bool initialized = false;
-    if (initialized) {
-        return;
-    }
-    initialized = true;
+// set once the hooks point at kernels
+static std::atomic<bool> hooks_set{false};
 
+std::vector<std::string>
+minhash_instruction_sets() {
+    std::vector<std::string> instruction_sets;
 #if defined(__x86_64__) || defined(_M_X64)
     if (cpu_support_avx512()) {
+        instruction_sets.emplace_back("avx512");
+    }
+    if (cpu_support_avx2()) {
+        instruction_sets.emplace_back("avx2");
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    if (cpu_support_sve()) {
+        instruction_sets.emplace_back("sve");
+    }
+    if (cpu_support_neon()) {
+        instruction_sets.emplace_back("neon");
+    }
+#endif
+    instruction_sets.emplace_back("native");
+    return instruction_sets;
+}
+
+void
+minhash_hook_set(const std::string& instruction_set) {
+#if defined(__x86_64__) || defined(_M_X64)
+    if (instruction_set == "avx512") {
         linear_and_find_min_impl = linear_and_find_min_avx512;
         linear_and_find_min_batch8_impl = linear_and_find_min_batch8_avx512;
+        linear_and_find_min_batch8_multi_impl =
+            linear_and_find_min_batch8_multi_avx512;
         LOG_INFO("MinHash initialized with AVX512 instruction set");
-    } else if (cpu_support_avx2()) {
+        hooks_set.store(true);
+        return;
+    }
+    if (instruction_set == "avx2") {
         linear_and_find_min_impl = linear_and_find_min_avx2;
         linear_and_find_min_batch8_impl = linear_and_find_min_batch8_avx2;
+        linear_and_find_min_batch8_multi_impl =
+            linear_and_find_min_batch8_multi_by_text;
         LOG_INFO("MinHash initialized with AVX2 instruction set");
-    } else {
-        linear_and_find_min_impl = linear_and_find_min_native;
-        linear_and_find_min_batch8_impl = linear_and_find_min_batch8_native;
-        LOG_INFO("MinHash initialized with native (scalar) instruction set");
+        hooks_set.store(true);
+        return;
     }
 #elif defined(__aarch64__) || defined(_M_ARM64)
-    if (cpu_support_sve()) {
+    if (instruction_set == "sve") {
         linear_and_find_min_impl = linear_and_find_min_sve;
         linear_and_find_min_batch8_impl = linear_and_find_min_batch8_sve;
+        linear_and_find_min_batch8_multi_impl =
+            linear_and_find_min_batch8_multi_by_text;
         LOG_INFO("MinHash initialized with SVE instruction set");
-    } else if (cpu_support_neon()) {
+        hooks_set.store(true);
+        return;
+    }
+    if (instruction_set == "neon") {
         linear_and_find_min_impl = linear_and_find_min_neon;
         linear_and_find_min_batch8_impl = linear_and_find_min_batch8_neon;
+        linear_and_find_min_batch8_multi_impl =
+            linear_and_find_min_batch8_multi_by_text;
         LOG_INFO("MinHash initialized with NEON instruction set");
-    } else {
-        linear_and_find_min_impl = linear_and_find_min_native;
-        linear_and_find_min_batch8_impl = linear_and_find_min_batch8_native;
-        LOG_INFO("MinHash initialized with native (scalar) instruction set");
+        hooks_set.store(true);
+        return;
     }
-#else
+#endif
     linear_and_find_min_impl = linear_and_find_min_native;
     linear_and_find_min_batch8_impl = linear_and_find_min_batch8_native;
+    linear_and_find_min_batch8_multi_impl =
+        linear_and_find_min_batch8_multi_native;
     LOG_INFO("MinHash initialized with native (scalar) instruction set");
-#endif
+    hooks_set.store(true);
+}
+
+void
+minhash_hook_init() {
+    // keeps the choice of the kernel registry made at startup
+    if (hooks_set.load()) {
+        return;
+    }
+    minhash_hook_set(minhash_instruction_sets().front());
 }
 
 }  // namespace minhash
@@ -14,6 +14,8 @@
 #include "fusion_compute/fusion_compute_native.h"
 #include <cstdint>
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace milvus {
 namespace minhash {
@@ -30,14 +32,32 @@ using LinearAndFindMinBatch8Func = void (*)(const uint64_t* base,
                                             const uint64_t* perm_b,
                                             uint32_t* sig);
 
+using LinearAndFindMinBatch8MultiFunc = void (*)(const uint64_t* base,
+                                                 const int32_t* shingle_counts,
+                                                 int32_t num_texts,
+                                                 const uint64_t* perm_a,
+                                                 const uint64_t* perm_b,
+                                                 uint32_t* sig,
+                                                 size_t sig_stride);
+
 // Global function pointers - initialized at runtime to appropriate implementations
 extern LinearAndFindMinFunc linear_and_find_min_impl;
 extern LinearAndFindMinBatch8Func linear_and_find_min_batch8_impl;
+extern LinearAndFindMinBatch8MultiFunc linear_and_find_min_batch8_multi_impl;
 
 // Initialize SIMD level based on runtime CPU detection
 // This function sets the global function pointers
 void
 minhash_hook_init();
 
+// The instruction sets this CPU runs the kernels with, widest first
+std::vector<std::string>
+minhash_instruction_sets();
+
+// Point the global function pointers at the kernels of one of
+// minhash_instruction_sets(), minhash_hook_init keeps the choice
+void
+minhash_hook_set(const std::string& instruction_set);
+
 }  // namespace minhash
 }  // namespace milvus
@@ -73,5 +73,26 @@ linear_and_find_min_batch8_native(const uint64_t* base,
     }
 }
 
+// The signatures of num_texts texts for 8 hash functions. The base hashes of
+// the texts are consecutive in base, text t writes sig[t * sig_stride, +8).
+static inline void
+linear_and_find_min_batch8_multi_native(const uint64_t* base,
+                                        const int32_t* shingle_counts,
+                                        int32_t num_texts,
+                                        const uint64_t* perm_a,
+                                        const uint64_t* perm_b,
+                                        uint32_t* sig,
+                                        size_t sig_stride) {
+    for (int32_t t = 0; t < num_texts; t++) {
+        uint32_t* text_sig = sig + t * sig_stride;
+        for (int k = 0; k < 8; k++) {
+            text_sig[k] = MAX_HASH_32;
+        }
+        linear_and_find_min_batch8_native(
+            base, shingle_counts[t], perm_a, perm_b, text_sig);
+        base += shingle_counts[t];
+    }
+}
+
 }  // namespace minhash
 }  // namespace milvus
@@ -17,22 +17,18 @@
 namespace milvus {
 namespace minhash {
 
-// AVX512 optimized rotation-based batch MinHash computation
-// Processes 8 hash functions at once using rotation optimization
-// find min((a* base + b) % MERSENNE_PRIME & MAX_HASH_MASK) for each base value
-// batch process 8 functions in parallel
-void
-linear_and_find_min_batch8_avx512(const uint64_t* base,
-                                  size_t shingle_count,
-                                  const uint64_t* perm_a,
-                                  const uint64_t* perm_b,
-                                  uint32_t* sig) {
-    __m512i vec_a =
-        _mm512_loadu_si512((__m512i*)perm_a);  // params a of 8 linear functions
-    __m512i vec_b =
-        _mm512_loadu_si512((__m512i*)perm_b);  // params b of 8 linear functions
-    __m512i vec_min = _mm512_cvtepu32_epi64(_mm256_loadu_si256((__m256i*)sig));
-
+namespace {
+
+// folds the 8 linear functions of vec_a and vec_b over the base hashes into
+// vec_min, rotating the hashes so each lane meets all of them
+inline __m512i
+min_over_shingles_avx512(const uint64_t* base,
+                         size_t shingle_count,
+                         __m512i vec_a,
+                         __m512i vec_b,
+                         __m512i vec_min) {
+    // the masked results are 32 bit already, so they need no narrowing
+    // before the min
     __m512i vec_mersenne = _mm512_set1_epi64(MERSENNE_PRIME);
     __m512i vec_mask = _mm512_set1_epi64(MAX_HASH_MASK);
     size_t j = 0;
@@ -62,10 +58,7 @@ linear_and_find_min_batch8_avx512(const uint64_t* base,
                     vec_result, mask_ge, vec_result, vec_mersenne);
 
                 vec_result = _mm512_and_si512(vec_result, vec_mask);
-                __m256i vec_perm_32 = _mm512_cvtepi64_epi32(vec_result);
-                __m512i vec_perm_64 = _mm512_cvtepu32_epi64(vec_perm_32);
-
-                vec_min = _mm512_min_epu64(vec_min, vec_perm_64);
+                vec_min = _mm512_min_epu64(vec_min, vec_result);
                 vec_hashes1 = _mm512_alignr_epi64(vec_hashes1, vec_hashes1, 1);
             }
             // Process next 8 hashes
@@ -82,10 +75,7 @@ linear_and_find_min_batch8_avx512(const uint64_t* base,
                     vec_result, mask_ge, vec_result, vec_mersenne);
 
                 vec_result = _mm512_and_si512(vec_result, vec_mask);
-                __m256i vec_perm_32 = _mm512_cvtepi64_epi32(vec_result);
-                __m512i vec_perm_64 = _mm512_cvtepu32_epi64(vec_perm_32);
-
-                vec_min = _mm512_min_epu64(vec_min, vec_perm_64);
+                vec_min = _mm512_min_epu64(vec_min, vec_result);
                 vec_hashes2 = _mm512_alignr_epi64(vec_hashes2, vec_hashes2, 1);
             }
         }
@@ -111,10 +101,7 @@ linear_and_find_min_batch8_avx512(const uint64_t* base,
                 vec_result, mask_ge, vec_result, vec_mersenne);
 
             vec_result = _mm512_and_si512(vec_result, vec_mask);
-            __m256i vec_perm_32 = _mm512_cvtepi64_epi32(vec_result);
-            __m512i vec_perm_64 = _mm512_cvtepu32_epi64(vec_perm_32);
-
-            vec_min = _mm512_min_epu64(vec_min, vec_perm_64);
+            vec_min = _mm512_min_epu64(vec_min, vec_result);
             vec_hashes = _mm512_alignr_epi64(vec_hashes, vec_hashes, 1);
         }
     }
@@ -133,17 +120,61 @@ linear_and_find_min_batch8_avx512(const uint64_t* base,
             vec_result, mask_ge, vec_result, vec_mersenne);
 
         vec_result = _mm512_and_si512(vec_result, vec_mask);
-        __m256i vec_perm_32 = _mm512_cvtepi64_epi32(vec_result);
-        __m512i vec_perm_64 = _mm512_cvtepu32_epi64(vec_perm_32);
-
-        vec_min = _mm512_min_epu64(vec_min, vec_perm_64);
+        vec_min = _mm512_min_epu64(vec_min, vec_result);
     }
 
+    return vec_min;
+}
+
+}  // namespace
+
+// AVX512 optimized rotation-based batch MinHash computation
+// Processes 8 hash functions at once using rotation optimization
+// find min((a* base + b) % MERSENNE_PRIME & MAX_HASH_MASK) for each base value
+// batch process 8 functions in parallel
+void
+linear_and_find_min_batch8_avx512(const uint64_t* base,
+                                  size_t shingle_count,
+                                  const uint64_t* perm_a,
+                                  const uint64_t* perm_b,
+                                  uint32_t* sig) {
+    __m512i vec_a =
+        _mm512_loadu_si512((__m512i*)perm_a);  // params a of 8 linear functions
+    __m512i vec_b =
+        _mm512_loadu_si512((__m512i*)perm_b);  // params b of 8 linear functions
+    __m512i vec_min = _mm512_cvtepu32_epi64(_mm256_loadu_si256((__m256i*)sig));
+
+    vec_min =
+        min_over_shingles_avx512(base, shingle_count, vec_a, vec_b, vec_min);
+
     // Store results back to signature
     __m256i result_32 = _mm512_cvtepi64_epi32(vec_min);
     _mm256_storeu_si256((__m256i*)sig, result_32);
 }
 
+// Multi text variant of the above: the coefficients stay in registers while
+// the texts stream through, one store per text
+void
+linear_and_find_min_batch8_multi_avx512(const uint64_t* base,
+                                        const int32_t* shingle_counts,
+                                        int32_t num_texts,
+                                        const uint64_t* perm_a,
+                                        const uint64_t* perm_b,
+                                        uint32_t* sig,
+                                        size_t sig_stride) {
+    __m512i vec_a = _mm512_loadu_si512((__m512i*)perm_a);
+    __m512i vec_b = _mm512_loadu_si512((__m512i*)perm_b);
+    __m512i vec_max = _mm512_set1_epi64(MAX_HASH_32);
+    for (int32_t t = 0; t < num_texts; t++) {
+        size_t shingle_count = shingle_counts[t];
+        __m512i vec_min = min_over_shingles_avx512(
+            base, shingle_count, vec_a, vec_b, vec_max);
+        _mm256_storeu_si256((__m256i*)(sig + t * sig_stride),
+                            _mm512_cvtepi64_epi32(vec_min));
+        base += shingle_count;
+    }
+}
+
 // AVX512 optimized linear_and_find_min for single hash function
 // Processes base hashes in chunks of 8 using SIMD
 uint32_t
@@ -24,6 +24,15 @@ linear_and_find_min_batch8_avx512(const uint64_t* base,
                                   const uint64_t* perm_b,
                                   uint32_t* sig);
 
+void
+linear_and_find_min_batch8_multi_avx512(const uint64_t* base,
+                                        const int32_t* shingle_counts,
+                                        int32_t num_texts,
+                                        const uint64_t* perm_a,
+                                        const uint64_t* perm_b,
+                                        uint32_t* sig,
+                                        size_t sig_stride);
+
 uint32_t
 linear_and_find_min_avx512(const uint64_t* base,
                            size_t shingle_count,
@@ -15,6 +15,10 @@
 // limitations under the License.
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <string_view>
+
 #include "common/Array.h"
 #include "common/VectorTrait.h"
 #include "common/Utils.h"
@@ -131,6 +135,77 @@ VariableLengthChunk<std::string>::set(
     }
 }
 
+/**
+ * @brief StringArenaChunk
+ *
+ * In-memory string chunk of growing segments. Every set copies its rows
+ * into one arena the chunk owns and keeps a std::string_view per row, so a
+ * row costs its bytes and a view rather than a std::string and a heap
+ * allocation of its own. Readers see the rows as the mmap chunk gives them.
+ */
+struct StringArenaChunk {
+ public:
+    StringArenaChunk() = delete;
+    explicit StringArenaChunk(const uint64_t size)
+        : size_(size), data_(size) {
+    }
+
+    void
+    set(const std::string* src,
+        uint32_t begin,
+        uint32_t length,
+        const std::optional<CheckDataValid>& check_data_valid = std::nullopt) {
+        AssertInfo(
+            begin + length <= size_,
+            "failed to set a chunk with length: {} from begin {}, size={}",
+            length,
+            begin,
+            size_);
+        size_t total_size = 0;
+        for (auto i = 0; i < length; i++) {
+            total_size += src[i].size();
+        }
+        char* buf = nullptr;
+        if (total_size > 0) {
+            auto arena = std::make_unique<char[]>(total_size);
+            buf = arena.get();
+            // writers of disjoint rows only share the arena list
+            std::lock_guard<std::mutex> lck(mutex_);
+            arenas_.push_back(std::move(arena));
+        }
+        for (size_t i = 0, offset = 0; i < length; i++) {
+            if (src[i].empty()) {
+                data_[i + begin] = std::string_view("");
+                continue;
+            }
+            std::memcpy(buf + offset, src[i].data(), src[i].size());
+            data_[i + begin] = std::string_view(buf + offset, src[i].size());
+            offset += src[i].size();
+        }
+    }
+
+    const std::string_view&
+    view(const int i) const {
+        return data_[i];
+    }
+
+    void*
+    data() {
+        return data_.data();
+    }
+
+    size_t
+    size() {
+        return size_;
+    }
+
+ private:
+    int64_t size_ = 0;
+    FixedVector<std::string_view> data_;
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<char[]>> arenas_;
+};
+
 // Template specialization for sparse vector
 template <>
 inline void
@@ -15,6 +15,12 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 #include "common/Utils.h"
 #include "common/Span.h"
 #include "mmap/ChunkData.h"
@@ -63,6 +69,12 @@ class ChunkVectorBase {
 template <typename Type>
 using ChunkVectorPtr = std::unique_ptr<ChunkVectorBase<Type>>;
 
+// Chunks are appended under mutex_, readers find them through directory_
+// without taking any lock: a new chunk is put in the directory before
+// counter_ covers it, and a full directory is copied into one twice its size
+// before that one is published. The replaced directories are kept until
+// clear(), together they are smaller than the live one, so a reader still
+// holding one never sees freed memory.
 template <typename Type,
           typename ChunkImpl = FixedVector<Type>,
           bool IsMmap = false>
@@ -73,9 +85,13 @@ class ThreadSafeChunkVector : public ChunkVectorBase<Type> {
         mmap_descriptor_ = descriptor;
     }
 
+    // chunks keeping views of rows whose bytes they hold elsewhere
+    static constexpr bool kViewChunk =
+        IsMmap || std::is_same_v<ChunkImpl, StringArenaChunk>;
+
     void
     emplace_to_at_least(int64_t chunk_num, int64_t chunk_size) override {
-        std::unique_lock<std::shared_mutex> lck(this->mutex_);
+        std::lock_guard<std::mutex> lck(mutex_);
         if (chunk_num <= this->counter_) {
             return;
         }
@@ -85,7 +101,23 @@ class ThreadSafeChunkVector : public ChunkVectorBase<Type> {
             } else {
                 vec_.emplace_back(chunk_size);
             }
-            ++this->counter_;
+            auto chunk_id = vec_.size() - 1;
+            if (directories_.empty() ||
+                directories_.back().size() <= chunk_id) {
+                std::vector<ChunkImpl*> directory(
+                    std::max<size_t>(kMinDirectorySize, 2 * chunk_id));
+                if (!directories_.empty()) {
+                    std::copy(directories_.back().begin(),
+                              directories_.back().end(),
+                              directory.begin());
+                }
+                directories_.push_back(std::move(directory));
+            }
+            // deque keeps its elements in place when growing at the back
+            directories_.back()[chunk_id] = &vec_.back();
+            directory_.store(directories_.back().data(),
+                             std::memory_order_release);
+            this->counter_.fetch_add(1, std::memory_order_release);
         }
     }
 
@@ -96,31 +128,33 @@ class ThreadSafeChunkVector : public ChunkVectorBase<Type> {
         const Type* data,
         int64_t length,
         const std::optional<CheckDataValid>& check_data_valid) override {
-        std::unique_lock<std::shared_mutex> lck(mutex_);
         AssertInfo(chunk_id < this->counter_,
                    fmt::format("index out of range, index={}, counter_={}",
                                chunk_id,
                                this->counter_));
-        if constexpr (!IsMmap || !IsVariableType<Type>) {
-            auto ptr = (Type*)vec_[chunk_id].data();
+        auto& chunk = get_chunk(chunk_id);
+        // writers own disjoint rows of the chunk, no lock needed
+        if constexpr (!kViewChunk || !IsVariableType<Type>) {
+            auto ptr = (Type*)chunk.data();
             AssertInfo(
-                offset + length <= vec_[chunk_id].size(),
+                offset + length <= chunk.size(),
                 fmt::format(
                     "index out of chunk range, offset={}, length={}, size={}",
                     offset,
                     length,
-                    vec_[chunk_id].size()));
+                    chunk.size()));
             std::copy_n(data, length, ptr + offset);
         } else {
-            vec_[chunk_id].set(data, offset, length, check_data_valid);
+            // set gets the row buffers from the mmap chunk manager or the
+            // arena of the chunk, both serialize the allocations themselves
+            chunk.set(data, offset, length, check_data_valid);
         }
     }
 
     ChunkViewType<Type>
     view_element(int64_t chunk_id, int64_t chunk_offset) override {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
-        auto& chunk = vec_[chunk_id];
-        if constexpr (IsMmap) {
+        auto& chunk = get_chunk(chunk_id);
+        if constexpr (kViewChunk) {
             return chunk.view(chunk_offset);
         } else if constexpr (std::is_same_v<std::string, Type>) {
             return std::string_view(chunk[chunk_offset].data(),
@@ -149,35 +183,35 @@ class ThreadSafeChunkVector : public ChunkVectorBase<Type> {
 
     void*
     get_chunk_data(int64_t index) override {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
         AssertInfo(index < this->counter_,
                    fmt::format("index out of range, index={}, counter_={}",
                                index,
                                this->counter_));
-        return vec_[index].data();
+        return get_chunk(index).data();
     }
 
     int64_t
     get_chunk_size(int64_t index) override {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
         AssertInfo(index < this->counter_,
                    fmt::format("index out of range, index={}, counter_={}",
                                index,
                                this->counter_));
-        return vec_[index].size();
+        return get_chunk(index).size();
     }
 
+    // not safe against concurrent readers
     void
     clear() override {
-        std::unique_lock<std::shared_mutex> lck(mutex_);
+        std::lock_guard<std::mutex> lck(mutex_);
         this->counter_ = 0;
+        directory_.store(nullptr, std::memory_order_release);
+        directories_.clear();
         vec_.clear();
     }
 
     int64_t
     get_element_size() override {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
-        if constexpr (IsMmap && std::is_same_v<std::string, Type>) {
+        if constexpr (kViewChunk && std::is_same_v<std::string, Type>) {
             return sizeof(ChunkViewType<Type>);
         }
         return sizeof(Type);
@@ -185,18 +219,16 @@ class ThreadSafeChunkVector : public ChunkVectorBase<Type> {
 
     int64_t
     get_element_offset(int64_t index) override {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
         int64_t offset = 0;
         for (int i = 0; i < index; i++) {
-            offset += vec_[i].size();
+            offset += get_chunk(i).size();
         }
         return offset;
     }
 
     SpanBase
     get_span(int64_t chunk_id) override {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
-        if constexpr (IsMmap && std::is_same_v<std::string, Type>) {
+        if constexpr (kViewChunk && std::is_same_v<std::string, Type>) {
             return SpanBase(get_chunk_data(chunk_id),
                             get_chunk_size(chunk_id),
                             sizeof(ChunkViewType<Type>));
@@ -213,9 +245,22 @@ class ThreadSafeChunkVector : public ChunkVectorBase<Type> {
     }
 
  private:
-    mutable std::shared_mutex mutex_;
+    static constexpr size_t kMinDirectorySize = 16;
+
+    // chunk_id must be below counter_
+    ChunkImpl&
+    get_chunk(int64_t chunk_id) {
+        return *directory_.load(std::memory_order_acquire)[chunk_id];
+    }
+
+ private:
+    // serializes appending chunks
+    std::mutex mutex_;
     storage::MmapChunkDescriptorPtr mmap_descriptor_ = nullptr;
     std::deque<ChunkImpl> vec_;
+    // every directory so far, the last one is published in directory_
+    std::vector<std::vector<ChunkImpl*>> directories_;
+    std::atomic<ChunkImpl**> directory_{nullptr};
 };
 
 template <typename Type>
@@ -234,11 +279,28 @@ SelectChunkVectorPtr(storage::MmapChunkDescriptorPtr& mmap_descriptor) {
             return std::make_unique<
                 ThreadSafeChunkVector<Type, VariableLengthChunk<Type>, true>>(
                 mmap_descriptor);
-        } else {
-            return std::make_unique<ThreadSafeChunkVector<Type>>();
         }
+        if constexpr (std::is_same_v<Type, std::string>) {
+            if (segcore::SegcoreConfig::default_config()
+                    .get_enable_growing_string_arena()) {
+                return std::make_unique<
+                    ThreadSafeChunkVector<Type, StringArenaChunk>>();
+            }
+        }
+        return std::make_unique<ThreadSafeChunkVector<Type>>();
     } else {
         return std::make_unique<ThreadSafeChunkVector<Type>>();
     }
 }
+
+// Whether growing string columns hold std::string_view rows, mapped or in
+// arenas, so their chunk data is to be read as views, not as std::string.
+inline bool
+GrowingStringChunkHoldsViews() {
+    return storage::MmapManager::GetInstance()
+               .GetMmapConfig()
+               .growing_enable_mmap ||
+           segcore::SegcoreConfig::default_config()
+               .get_enable_growing_string_arena();
+}
 }  // namespace milvus
\ No newline at end of file
@@ -563,3 +563,33 @@ TEST_F(ChunkVectorTest, QueryWithMmap) {
 //         }
 //     }
 // }
+
+TEST(ChunkVectorArenaTest, StringArena) {
+    auto& config = SegcoreConfig::default_config();
+    config.set_enable_growing_string_arena(true);
+    ASSERT_TRUE(GrowingStringChunkHoldsViews());
+
+    const int64_t size_per_chunk = 64;
+    ConcurrentVector<std::string> vec(size_per_chunk);
+    config.set_enable_growing_string_arena(false);
+
+    std::vector<std::string> rows(200);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        // empty, short and past the small string buffer
+        rows[i] = std::string(i % 40, 'a' + i % 26);
+    }
+    // two batches, the second starting inside a chunk
+    vec.set_data_raw(0, rows.data(), 100);
+    vec.set_data_raw(100, rows.data() + 100, 100);
+
+    ASSERT_EQ(vec.num_chunk(), 4);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ASSERT_EQ(vec.view_element(i), rows[i]);
+    }
+    auto span = vec.get_span_base(1);
+    ASSERT_EQ(span.element_sizeof(), sizeof(std::string_view));
+    auto views = static_cast<const std::string_view*>(span.data());
+    for (int64_t i = 0; i < size_per_chunk; ++i) {
+        ASSERT_EQ(views[i], rows[size_per_chunk + i]);
+    }
+}
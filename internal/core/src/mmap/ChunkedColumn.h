@@ -18,6 +18,7 @@
 #include <folly/io/IOBuf.h>
 #include <sys/mman.h>
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -35,6 +36,7 @@
 #include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
 #include "common/Span.h"
+#include "segcore/HotCells.h"
 #include "segcore/storagev1translator/ChunkTranslator.h"
 #include "cachinglayer/Translator.h"
 #include "mmap/ChunkedColumnInterface.h"
@@ -126,16 +128,19 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
         num_rows_ = GetNumRowsUntilChunk().back();
     }
 
-    virtual ~ChunkedColumnBase() = default;
+    ~ChunkedColumnBase() override {
+        RetireCompressedCells();
+    }
 
     void
     ManualEvictCache() const override {
+        RetireCompressedCells();
         slot_->ManualEvictAll();
     }
 
     PinWrapper<const char*>
     DataOfChunk(milvus::OpContext* op_ctx, int chunk_id) const override {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
         return PinWrapper<const char*>(ca, chunk->Data());
     }
@@ -147,7 +152,7 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
         }
         auto [chunk_id, offset_in_chunk] = GetChunkIDByOffset(offset);
         auto ca = SemiInlineGet(
-            slot_->PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
+            PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
         auto chunk = ca->get_cell_of(chunk_id);
         return chunk->isValid(offset_in_chunk);
     }
@@ -170,7 +175,7 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
         }
         // nullable:
         if (offsets == nullptr) {
-            auto ca = SemiInlineGet(slot_->PinAllCells(op_ctx));
+            auto ca = SemiInlineGet(PinAllCells(op_ctx));
             for (int64_t i = 0; i < num_rows_; i++) {
                 auto [cid, offset_in_chunk] = GetChunkIDByOffset(i);
                 auto chunk = ca->get_cell_of(cid);
@@ -179,7 +184,7 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
             }
         } else {
             auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-            auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+            auto ca = SemiInlineGet(PinCells(op_ctx, cids));
             for (int64_t i = 0; i < count; i++) {
                 auto chunk = ca->get_cell_of(cids[i]);
                 auto valid = chunk->isValid(offsets_in_chunk[i]);
@@ -223,7 +228,26 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
     void
     PrefetchChunks(milvus::OpContext* op_ctx,
                    const std::vector<int64_t>& chunk_ids) const override {
-        SemiInlineGet(slot_->PinCells(op_ctx, chunk_ids));
+        auto ca = SemiInlineGet(PinCells(op_ctx, chunk_ids));
+        ReadAheadChunks(ca, chunk_ids);
+    }
+
+    void
+    TrackHotCells(const std::string& key) override {
+        access_counts_ =
+            segcore::HotCells::Instance().Register(key, num_chunks_);
+        if (access_counts_ != nullptr) {
+            segcore::WarmUpHotCells(key, slot_);
+        }
+    }
+
+    ContinueFuture
+    PrefetchChunksAsync(milvus::OpContext* op_ctx,
+                        const std::vector<int64_t>& chunk_ids) const override {
+        // the cells stay cached after the pin is dropped, until evicted
+        return PinCells(op_ctx, chunk_ids)
+            .deferValue(
+                [chunk_ids](auto&& ca) { ReadAheadChunks(ca, chunk_ids); });
     }
 
     PinWrapper<SpanBase>
@@ -340,14 +364,14 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
 
     PinWrapper<Chunk*>
     GetChunk(milvus::OpContext* op_ctx, int64_t chunk_id) const override {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
         return PinWrapper<Chunk*>(ca, chunk);
     }
 
     std::vector<PinWrapper<Chunk*>>
     GetAllChunks(milvus::OpContext* op_ctx) const override {
-        auto ca = SemiInlineGet(slot_->PinAllCells(op_ctx));
+        auto ca = SemiInlineGet(PinAllCells(op_ctx));
         std::vector<PinWrapper<Chunk*>> ret;
         ret.reserve(num_chunks_);
         for (size_t i = 0; i < num_chunks_; i++) {
@@ -374,7 +398,7 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
         if (!nullable_) {
             return;
         }
-        auto ca = SemiInlineGet(slot_->PinAllCells(op_ctx));
+        auto ca = SemiInlineGet(PinAllCells(op_ctx));
         int64_t logical_offset = 0;
         valid_data_.resize(num_rows_);
         valid_count_per_chunk_.resize(num_chunks_);
@@ -397,11 +421,121 @@ class ChunkedColumnBase : public ChunkedColumnInterface {
     }
 
  protected:
+    // the prefetched chunks are wanted by the next batches of a scan, so the
+    // file backed ones are read into the page cache ahead of it
+    static void
+    ReadAheadChunks(const std::shared_ptr<CellAccessor<Chunk>>& ca,
+                    const std::vector<int64_t>& chunk_ids) {
+        for (auto chunk_id : chunk_ids) {
+            auto chunk = ca->get_cell_of(chunk_id);
+            chunk->WillNeed(chunk->RawData(), chunk->Size());
+        }
+    }
+
+    // The advice of a chunk follows how its column is mostly read: whole
+    // chunks by scans (Span, StringViews, ArrayViews) or scattered rows by
+    // the bulk fetches of output fields. A column read both ways keeps the
+    // advice of the dominant one rather than flipping it on every read.
+    int
+    AccessAdvice() const {
+        return random_reads_.load(std::memory_order_relaxed) >
+                       sequential_reads_.load(std::memory_order_relaxed)
+                   ? MADV_RANDOM
+                   : MADV_SEQUENTIAL;
+    }
+
+    void
+    AdviseSequentialRead(const Chunk* chunk) const {
+        sequential_reads_.fetch_add(1, std::memory_order_relaxed);
+        chunk->Advise(AccessAdvice());
+    }
+
+    void
+    AdviseRandomRead(const Chunk* chunk) const {
+        random_reads_.fetch_add(1, std::memory_order_relaxed);
+        chunk->Advise(AccessAdvice());
+    }
+
+    // a fetch of scattered fixed size rows reads their pages ahead in one go,
+    // a run of rows on adjacent pages as one range. Walks the rows in order,
+    // see GatherOrder().
+    void
+    AdviseRandomRows(const std::shared_ptr<CellAccessor<Chunk>>& ca,
+                     const std::vector<milvus::cachinglayer::cid_t>& cids,
+                     const std::vector<int64_t>& offsets_in_chunk,
+                     const std::vector<int64_t>& order,
+                     size_t row_size) const {
+        random_reads_.fetch_add(1, std::memory_order_relaxed);
+        auto advice = AccessAdvice();
+        const Chunk* run_chunk = nullptr;
+        const char* run_begin = nullptr;
+        const char* run_end = nullptr;
+        for (size_t k = 0; k < cids.size(); k++) {
+            auto i = order.empty() ? k : order[k];
+            auto chunk = ca->get_cell_of(cids[i]);
+            auto value = chunk->ValueAt(offsets_in_chunk[i]);
+            if (chunk == run_chunk && value >= run_begin &&
+                value <= run_end + READ_AHEAD_GAP) {
+                run_end = std::max(run_end, value + row_size);
+                continue;
+            }
+            if (run_chunk != nullptr) {
+                run_chunk->WillNeed(run_begin, run_end - run_begin);
+            }
+            chunk->Advise(advice);
+            run_chunk = chunk;
+            run_begin = value;
+            run_end = value + row_size;
+        }
+        // a single row faults in no slower than it is read ahead
+        if (run_chunk != nullptr && cids.size() > 1) {
+            run_chunk->WillNeed(run_begin, run_end - run_begin);
+        }
+    }
+
+    // the chunks evicted from here on are not wanted back, they are freed
+    // instead of kept in the compressed tier
+    void
+    RetireCompressedCells() const {
+        auto meta = static_cast<milvus::segcore::storagev1translator::CTMeta*>(
+            slot_->meta());
+        if (meta->compressed_source_ != nullptr) {
+            meta->compressed_source_->retired.store(true);
+            segcore::CompressedCellTier::Instance().EraseSource(
+                meta->compressed_source_->key);
+        }
+    }
+
+    auto
+    PinCells(milvus::OpContext* op_ctx, std::vector<cid_t> cids) const {
+        if (access_counts_ != nullptr) {
+            access_counts_->Add(cids);
+        }
+        return slot_->PinCells(op_ctx, std::move(cids));
+    }
+
+    auto
+    PinAllCells(milvus::OpContext* op_ctx) const {
+        if (access_counts_ != nullptr) {
+            access_counts_->AddAll();
+        }
+        return slot_->PinAllCells(op_ctx);
+    }
+
+    // rows closer than this share a read ahead range
+    static constexpr ptrdiff_t READ_AHEAD_GAP = 4096;
+    // how many rows ahead a gather prefetches into the cache
+    static constexpr int64_t GATHER_PREFETCH_DISTANCE = 8;
+
     bool nullable_{false};
     DataType data_type_{DataType::NONE};
     size_t num_rows_{0};
     size_t num_chunks_{0};
     mutable std::shared_ptr<CacheSlot<Chunk>> slot_;
+    // the pins of the cells, when the column is tracked for the hot cells
+    std::shared_ptr<segcore::CellAccessCounts> access_counts_;
+    mutable std::atomic<int64_t> sequential_reads_{0};
+    mutable std::atomic<int64_t> random_reads_{0};
 };
 
 class ChunkedColumn : public ChunkedColumnBase {
@@ -418,9 +552,47 @@ class ChunkedColumn : public ChunkedColumnBase {
                 const int64_t* offsets,
                 int64_t count) override {
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+        auto ca = SemiInlineGet(PinCells(op_ctx, cids));
+        random_reads_.fetch_add(1, std::memory_order_relaxed);
+        auto advice = AccessAdvice();
         for (int64_t i = 0; i < count; i++) {
-            fn(ca->get_cell_of(cids[i])->ValueAt(offsets_in_chunk[i]), i);
+            auto chunk = ca->get_cell_of(cids[i]);
+            chunk->Advise(advice);
+            fn(chunk->ValueAt(offsets_in_chunk[i]), i);
+        }
+    }
+
+    // Copies the fixed size rows at offsets by copy(i, value), i being the
+    // position in offsets. The rows are visited in (chunk, offset) order so
+    // a chunk is looked up once per run and read forward, with the rows a
+    // few steps ahead prefetched.
+    template <typename Copy>
+    void
+    GatherRows(milvus::OpContext* op_ctx,
+               const int64_t* offsets,
+               int64_t count,
+               size_t row_size,
+               Copy&& copy) const {
+        auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
+        auto ca = SemiInlineGet(PinCells(op_ctx, cids));
+        auto order = GatherOrder(cids, offsets_in_chunk);
+        AdviseRandomRows(ca, cids, offsets_in_chunk, order, row_size);
+        auto position = [&order](int64_t k) {
+            return order.empty() ? k : order[k];
+        };
+        const Chunk* chunk = nullptr;
+        for (int64_t k = 0; k < count; k++) {
+            auto i = position(k);
+            if (chunk == nullptr || cids[i] != cids[position(k - 1)]) {
+                chunk = ca->get_cell_of(cids[i]);
+            }
+            if (k + GATHER_PREFETCH_DISTANCE < count) {
+                auto ahead = position(k + GATHER_PREFETCH_DISTANCE);
+                if (cids[ahead] == cids[i]) {
+                    __builtin_prefetch(chunk->ValueAt(offsets_in_chunk[ahead]));
+                }
+            }
+            copy(i, chunk->ValueAt(offsets_in_chunk[i]));
         }
     }
 
@@ -431,15 +603,15 @@ class ChunkedColumn : public ChunkedColumnBase {
                              const int64_t* offsets,
                              int64_t count) {
         static_assert(std::is_fundamental_v<S> && std::is_fundamental_v<T>);
-        auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
         auto typed_dst = static_cast<T*>(dst);
-        for (int64_t i = 0; i < count; i++) {
-            auto chunk = ca->get_cell_of(cids[i]);
-            auto value = chunk->ValueAt(offsets_in_chunk[i]);
-            typed_dst[i] =
-                *static_cast<const S*>(static_cast<const void*>(value));
-        }
+        GatherRows(op_ctx,
+                   offsets,
+                   count,
+                   sizeof(S),
+                   [typed_dst](int64_t i, const char* value) {
+                       typed_dst[i] = *static_cast<const S*>(
+                           static_cast<const void*>(value));
+                   });
     }
 
     void
@@ -515,20 +687,23 @@ class ChunkedColumn : public ChunkedColumnBase {
                       const int64_t* offsets,
                       int64_t element_sizeof,
                       int64_t count) override {
-        auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
         auto dst_vec = reinterpret_cast<char*>(dst);
-        for (int64_t i = 0; i < count; i++) {
-            auto chunk = ca->get_cell_of(cids[i]);
-            auto value = chunk->ValueAt(offsets_in_chunk[i]);
-            memcpy(dst_vec + i * element_sizeof, value, element_sizeof);
-        }
+        GatherRows(op_ctx,
+                   offsets,
+                   count,
+                   element_sizeof,
+                   [dst_vec, element_sizeof](int64_t i, const char* value) {
+                       memcpy(dst_vec + i * element_sizeof,
+                              value,
+                              element_sizeof);
+                   });
     }
 
     PinWrapper<SpanBase>
     Span(milvus::OpContext* op_ctx, int64_t chunk_id) const override {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
+        AdviseSequentialRead(chunk);
         return PinWrapper<SpanBase>(
             ca, static_cast<FixedWidthChunk*>(chunk)->Span());
     }
@@ -551,8 +726,9 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
                 int64_t chunk_id,
                 std::optional<std::pair<int64_t, int64_t>> offset_len =
                     std::nullopt) const override {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
+        AdviseSequentialRead(chunk);
         return PinWrapper<
             std::pair<std::vector<std::string_view>, FixedVector<bool>>>(
             ca, static_cast<StringChunk*>(chunk)->StringViews(offset_len));
@@ -562,8 +738,9 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
     StringViewsByOffsets(milvus::OpContext* op_ctx,
                          int64_t chunk_id,
                          const FixedVector<int32_t>& offsets) const override {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
+        AdviseRandomRead(chunk);
         return PinWrapper<
             std::pair<std::vector<std::string_view>, FixedVector<bool>>>(
             ca, static_cast<StringChunk*>(chunk)->ViewsByOffsets(offsets));
@@ -580,7 +757,7 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
                       "ChunkedVariableColumn<std::string>");
         }
         if (offsets == nullptr) {
-            auto ca = SemiInlineGet(slot_->PinAllCells(op_ctx));
+            auto ca = SemiInlineGet(PinAllCells(op_ctx));
             for (int64_t i = 0; i < num_rows_; i++) {
                 auto [cid, offset_in_chunk] = GetChunkIDByOffset(i);
                 auto chunk = ca->get_cell_of(cid);
@@ -592,7 +769,7 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
             }
         } else {
             auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-            auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+            auto ca = SemiInlineGet(PinCells(op_ctx, cids));
             for (int64_t i = 0; i < count; i++) {
                 auto chunk = ca->get_cell_of(cids[i]);
                 auto valid =
@@ -619,7 +796,7 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
             return;
         }
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+        auto ca = SemiInlineGet(PinCells(op_ctx, cids));
         for (int64_t i = 0; i < count; i++) {
             auto chunk = ca->get_cell_of(cids[i]);
             auto valid = nullable_ ? chunk->isValid(offsets_in_chunk[i]) : true;
@@ -642,7 +819,7 @@ class ChunkedVariableColumn : public ChunkedColumnBase {
                    "row_offsets and value_offsets must be provided");
 
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(row_offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+        auto ca = SemiInlineGet(PinCells(op_ctx, cids));
         for (int64_t i = 0; i < count; i++) {
             auto chunk = ca->get_cell_of(cids[i]);
             auto str_view = static_cast<StringChunk*>(chunk)->operator[](
@@ -668,7 +845,7 @@ class ChunkedArrayColumn : public ChunkedColumnBase {
                 const int64_t* offsets,
                 int64_t count) const override {
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+        auto ca = SemiInlineGet(PinCells(op_ctx, cids));
         for (int64_t i = 0; i < count; i++) {
             auto view = static_cast<ArrayChunk*>(ca->get_cell_of(cids[i]))
                             ->View(offsets_in_chunk[i]);
@@ -682,8 +859,9 @@ class ChunkedArrayColumn : public ChunkedColumnBase {
                std::optional<std::pair<int64_t, int64_t>> offset_len =
                    std::nullopt) const override {
         auto ca = SemiInlineGet(
-            slot_->PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
+            PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
         auto chunk = ca->get_cell_of(chunk_id);
+        AdviseSequentialRead(chunk);
         return PinWrapper<std::pair<std::vector<ArrayView>, FixedVector<bool>>>(
             ca, static_cast<ArrayChunk*>(chunk)->Views(offset_len));
     }
@@ -692,8 +870,9 @@ class ChunkedArrayColumn : public ChunkedColumnBase {
     ArrayViewsByOffsets(milvus::OpContext* op_ctx,
                         int64_t chunk_id,
                         const FixedVector<int32_t>& offsets) const override {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
+        AdviseRandomRead(chunk);
         return PinWrapper<std::pair<std::vector<ArrayView>, FixedVector<bool>>>(
             ca, static_cast<ArrayChunk*>(chunk)->ViewsByOffsets(offsets));
     }
@@ -712,7 +891,7 @@ class ChunkedVectorArrayColumn : public ChunkedColumnBase {
                       const int64_t* offsets,
                       int64_t count) const override {
         auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, cids));
+        auto ca = SemiInlineGet(PinCells(op_ctx, cids));
         for (int64_t i = 0; i < count; i++) {
             auto array =
                 static_cast<VectorArrayChunk*>(ca->get_cell_of(cids[i]))
@@ -728,7 +907,7 @@ class ChunkedVectorArrayColumn : public ChunkedColumnBase {
                      std::optional<std::pair<int64_t, int64_t>> offset_len =
                          std::nullopt) const override {
         auto ca = SemiInlineGet(
-            slot_->PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
+            PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
         auto chunk = ca->get_cell_of(chunk_id);
         return PinWrapper<
             std::pair<std::vector<VectorArrayView>, FixedVector<bool>>>(
@@ -739,7 +918,7 @@ class ChunkedVectorArrayColumn : public ChunkedColumnBase {
     VectorArrayOffsets(milvus::OpContext* op_ctx,
                        int64_t chunk_id) const override {
         auto ca = SemiInlineGet(
-            slot_->PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
+            PinCells(op_ctx, {static_cast<cid_t>(chunk_id)}));
         auto chunk = ca->get_cell_of(chunk_id);
         return PinWrapper<const size_t*>(
             ca, static_cast<VectorArrayChunk*>(chunk)->Offsets());
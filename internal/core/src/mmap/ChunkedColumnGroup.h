@@ -35,6 +35,7 @@
 #include "common/OpContext.h"
 #include "common/Span.h"
 #include "mmap/ChunkedColumnInterface.h"
+#include "segcore/HotCells.h"
 #include "segcore/storagev2translator/GroupCTMeta.h"
 
 namespace milvus {
@@ -60,6 +61,17 @@ class ChunkedColumnGroup {
         slot_->ManualEvictAll();
     }
 
+    // counts the pins of the group chunks under key, the key of the
+    // translator, and warms up the chunks the hot cell snapshot names
+    void
+    TrackHotCells(const std::string& key) {
+        access_counts_ =
+            segcore::HotCells::Instance().Register(key, num_chunks_);
+        if (access_counts_ != nullptr) {
+            segcore::WarmUpHotCells(key, slot_);
+        }
+    }
+
     // Get the number of group chunks
     size_t
     num_chunks() const {
@@ -68,7 +80,7 @@ class ChunkedColumnGroup {
 
     PinWrapper<GroupChunk*>
     GetGroupChunk(milvus::OpContext* op_ctx, int64_t chunk_id) const {
-        auto ca = SemiInlineGet(slot_->PinCells(op_ctx, {chunk_id}));
+        auto ca = SemiInlineGet(PinCells(op_ctx, {chunk_id}));
         auto chunk = ca->get_cell_of(chunk_id);
         return PinWrapper<GroupChunk*>(ca, chunk);
     }
@@ -76,12 +88,18 @@ class ChunkedColumnGroup {
     std::shared_ptr<CellAccessor<GroupChunk>>
     GetGroupChunks(milvus::OpContext* op_ctx,
                    const std::vector<int64_t>& chunk_ids) {
-        return SemiInlineGet(slot_->PinCells(op_ctx, chunk_ids));
+        return SemiInlineGet(PinCells(op_ctx, chunk_ids));
+    }
+
+    ContinueFuture
+    PrefetchGroupChunksAsync(milvus::OpContext* op_ctx,
+                             const std::vector<int64_t>& chunk_ids) {
+        return PinCells(op_ctx, chunk_ids).deferValue([](auto&&) {});
     }
 
     std::vector<PinWrapper<GroupChunk*>>
     GetAllGroupChunks(milvus::OpContext* op_ctx) {
-        auto ca = SemiInlineGet(slot_->PinAllCells(op_ctx));
+        auto ca = SemiInlineGet(PinAllCells(op_ctx));
         std::vector<PinWrapper<GroupChunk*>> ret;
         ret.reserve(num_chunks_);
         for (size_t i = 0; i < num_chunks_; i++) {
@@ -168,9 +186,27 @@ class ChunkedColumnGroup {
     }
 
  protected:
+    auto
+    PinCells(milvus::OpContext* op_ctx, std::vector<cid_t> cids) const {
+        if (access_counts_ != nullptr) {
+            access_counts_->Add(cids);
+        }
+        return slot_->PinCells(op_ctx, std::move(cids));
+    }
+
+    auto
+    PinAllCells(milvus::OpContext* op_ctx) const {
+        if (access_counts_ != nullptr) {
+            access_counts_->AddAll();
+        }
+        return slot_->PinAllCells(op_ctx);
+    }
+
     mutable std::shared_ptr<CacheSlot<GroupChunk>> slot_;
     size_t num_chunks_{0};
     size_t num_rows_{0};
+    // the pins of the group chunks, when the group is tracked
+    std::shared_ptr<segcore::CellAccessCounts> access_counts_;
 };
 
 class ProxyChunkColumn : public ChunkedColumnInterface {
@@ -269,6 +305,12 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
         group_->GetGroupChunks(op_ctx, chunk_ids);
     }
 
+    ContinueFuture
+    PrefetchChunksAsync(milvus::OpContext* op_ctx,
+                        const std::vector<int64_t>& chunk_ids) const override {
+        return group_->PrefetchGroupChunksAsync(op_ctx, chunk_ids);
+    }
+
     PinWrapper<SpanBase>
     Span(milvus::OpContext* op_ctx, int64_t chunk_id) const override {
         if (!IsChunkedColumnDataType(data_type_)) {
@@ -431,6 +473,29 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
         }
     }
 
+    // copies the fixed size rows at offsets by copy(i, value) in (chunk,
+    // offset) order, like ChunkedColumn::GatherRows
+    template <typename Copy>
+    void
+    GatherRows(milvus::OpContext* op_ctx,
+               const int64_t* offsets,
+               int64_t count,
+               Copy&& copy) const {
+        auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
+        auto ca = group_->GetGroupChunks(op_ctx, cids);
+        auto order = GatherOrder(cids, offsets_in_chunk);
+        const Chunk* chunk = nullptr;
+        milvus::cachinglayer::cid_t chunk_id = 0;
+        for (int64_t k = 0; k < count; k++) {
+            auto i = order.empty() ? k : order[k];
+            if (chunk == nullptr || cids[i] != chunk_id) {
+                chunk_id = cids[i];
+                chunk = ca->get_cell_of(chunk_id)->GetChunk(field_id_).get();
+            }
+            copy(i, chunk->ValueAt(offsets_in_chunk[i]));
+        }
+    }
+
     template <typename S, typename T>
     void
     BulkPrimitiveValueAtImpl(milvus::OpContext* op_ctx,
@@ -438,16 +503,14 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
                              const int64_t* offsets,
                              int64_t count) {
         static_assert(std::is_fundamental_v<S> && std::is_fundamental_v<T>);
-        auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = group_->GetGroupChunks(op_ctx, cids);
         auto typed_dst = static_cast<T*>(dst);
-        for (int64_t i = 0; i < count; i++) {
-            auto* group_chunk = ca->get_cell_of(cids[i]);
-            auto chunk = group_chunk->GetChunk(field_id_);
-            auto value = chunk->ValueAt(offsets_in_chunk[i]);
-            typed_dst[i] =
-                *static_cast<const S*>(static_cast<const void*>(value));
-        }
+        GatherRows(op_ctx,
+                   offsets,
+                   count,
+                   [typed_dst](int64_t i, const char* value) {
+                       typed_dst[i] = *static_cast<const S*>(
+                           static_cast<const void*>(value));
+                   });
     }
 
     void
@@ -523,15 +586,15 @@ class ProxyChunkColumn : public ChunkedColumnInterface {
                       const int64_t* offsets,
                       int64_t element_sizeof,
                       int64_t count) override {
-        auto [cids, offsets_in_chunk] = ToChunkIdAndOffset(offsets, count);
-        auto ca = group_->GetGroupChunks(op_ctx, cids);
         auto dst_vec = reinterpret_cast<char*>(dst);
-        for (int64_t i = 0; i < count; i++) {
-            auto* group_chunk = ca->get_cell_of(cids[i]);
-            auto chunk = group_chunk->GetChunk(field_id_);
-            auto value = chunk->ValueAt(offsets_in_chunk[i]);
-            memcpy(dst_vec + i * element_sizeof, value, element_sizeof);
-        }
+        GatherRows(op_ctx,
+                   offsets,
+                   count,
+                   [dst_vec, element_sizeof](int64_t i, const char* value) {
+                       memcpy(dst_vec + i * element_sizeof,
+                              value,
+                              element_sizeof);
+                   });
     }
 
     void
@@ -15,8 +15,13 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include "cachinglayer/CacheSlot.h"
 #include "common/Chunk.h"
+#include "common/Promise.h"
 #include "common/OffsetMapping.h"
 #include "common/bson_view.h"
 namespace milvus {
@@ -77,6 +82,22 @@ class ChunkedColumnInterface {
     PrefetchChunks(milvus::OpContext* op_ctx,
                    const std::vector<int64_t>& chunk_ids) const = 0;
 
+    // starts loading the chunks without waiting for them, the future is
+    // ready once they are cached
+    virtual ContinueFuture
+    PrefetchChunksAsync(milvus::OpContext* op_ctx,
+                        const std::vector<int64_t>& chunk_ids) const {
+        PrefetchChunks(op_ctx, chunk_ids);
+        return folly::makeSemiFuture();
+    }
+
+    // counts the pins of the cells under key, the key of the translator of
+    // the column, for the hot cell snapshot, and warms up the cells a
+    // snapshot of the previous process names for it
+    virtual void
+    TrackHotCells(const std::string& key) {
+    }
+
     virtual PinWrapper<
         std::pair<std::vector<std::string_view>, FixedVector<bool>>>
     StringViews(milvus::OpContext* op_ctx,
@@ -303,6 +324,32 @@ class ChunkedColumnInterface {
         }
         return std::make_pair(std::move(cids), std::move(offsets_in_chunk));
     }
+
+    // The positions of the rows sorted by (chunk, offset in chunk), or empty
+    // when they come in that order already. A gather walking this order pins
+    // each chunk once and reads it forward, the topk offsets of a search are
+    // in the order of their distances instead.
+    static std::vector<int64_t>
+    GatherOrder(const std::vector<milvus::cachinglayer::cid_t>& cids,
+                const std::vector<int64_t>& offsets_in_chunk) {
+        auto before = [&](int64_t a, int64_t b) {
+            return cids[a] < cids[b] ||
+                   (cids[a] == cids[b] &&
+                    offsets_in_chunk[a] < offsets_in_chunk[b]);
+        };
+        int64_t count = cids.size();
+        int64_t i = 1;
+        while (i < count && !before(i, i - 1)) {
+            i++;
+        }
+        if (i >= count) {
+            return {};
+        }
+        std::vector<int64_t> order(count);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), before);
+        return order;
+    }
 };
 
 }  // namespace milvus
@@ -9,6 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <numeric>
+#include <random>
+
 #include <cachinglayer/Translator.h>
 #include "common/Chunk.h"
 #include "gtest/gtest.h"
@@ -49,4 +53,53 @@ TEST(test_chunked_column, test_get_chunkid) {
         }
     }
 }
+
+TEST(test_chunked_column, test_bulk_value_at_keeps_offsets_order) {
+    std::vector<int64_t> num_rows_per_chunk = {10, 20, 30};
+    std::vector<std::vector<int64_t>> data;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    int64_t num_rows = 0;
+    for (auto row_num : num_rows_per_chunk) {
+        auto& values = data.emplace_back(row_num);
+        std::iota(values.begin(), values.end(), num_rows);
+        num_rows += row_num;
+        auto chunk_mmap_guard =
+            std::make_shared<ChunkMmapGuard>(nullptr, 0, "");
+        chunks.push_back(std::make_unique<FixedWidthChunk>(
+            row_num,
+            1,
+            reinterpret_cast<char*>(values.data()),
+            row_num * sizeof(int64_t),
+            sizeof(int64_t),
+            false,
+            chunk_mmap_guard));
+    }
+    auto translator = std::make_unique<TestChunkTranslator>(
+        num_rows_per_chunk, "test", std::move(chunks));
+    FieldMeta field_meta(
+        FieldName("test"), FieldId(1), DataType::INT64, false, std::nullopt);
+    auto slot =
+        cachinglayer::Manager::GetInstance().CreateCacheSlot<milvus::Chunk>(
+            std::move(translator), nullptr);
+    ChunkedColumn column(std::move(slot), field_meta);
+
+    // topk offsets come in the order of their distances, with repeats
+    std::vector<int64_t> offsets(num_rows);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    std::default_random_engine er(42);
+    std::shuffle(offsets.begin(), offsets.end(), er);
+    offsets.push_back(offsets[3]);
+    std::vector<int64_t> values(offsets.size());
+    column.BulkPrimitiveValueAt(
+        nullptr, values.data(), offsets.data(), offsets.size(), false);
+    EXPECT_EQ(values, offsets);
+
+    std::vector<int64_t> vectors(offsets.size());
+    column.BulkVectorValueAt(nullptr,
+                             vectors.data(),
+                             offsets.data(),
+                             sizeof(int64_t),
+                             offsets.size());
+    EXPECT_EQ(vectors, offsets);
+}
 }  // namespace milvus
@@ -130,6 +130,54 @@ DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_deserialize_duration,
                             internal_storage_load_duration,
                             deserializeDurationLabels)
 
+// local disk rate limiter metrics
+std::map<std::string, std::string> rateLimitReadLabels{{"type", "read"}};
+std::map<std::string, std::string> rateLimitWriteLabels{{"type", "write"}};
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_storage_rate_limit_wait,
+    "[cpp]milliseconds local disk io waits for the rate limiter")
+DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_rate_limit_wait_read,
+                            internal_storage_rate_limit_wait,
+                            rateLimitReadLabels)
+DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_rate_limit_wait_write,
+                            internal_storage_rate_limit_wait,
+                            rateLimitWriteLabels)
+
+std::map<std::string, std::string> fsCacheHitLabels{{"type", "hit"}};
+std::map<std::string, std::string> fsCacheMissLabels{{"type", "miss"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_storage_fs_cache_count,
+    "[cpp]count of filesystem cache lookups, a hit reuses the connections")
+DEFINE_PROMETHEUS_COUNTER(internal_storage_fs_cache_count_hit,
+                          internal_storage_fs_cache_count,
+                          fsCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_storage_fs_cache_count_miss,
+                          internal_storage_fs_cache_count,
+                          fsCacheMissLabels)
+std::map<std::string, std::string> fsCacheCreateLabels{{"type", "create"}};
+std::map<std::string, std::string> fsCacheWarmupLabels{{"type", "warmup"}};
+DEFINE_PROMETHEUS_HISTOGRAM_FAMILY(
+    internal_storage_fs_cache_wait,
+    "[cpp]milliseconds to create and warm up a cached filesystem")
+DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_fs_cache_wait_create,
+                            internal_storage_fs_cache_wait,
+                            fsCacheCreateLabels)
+DEFINE_PROMETHEUS_HISTOGRAM(internal_storage_fs_cache_wait_warmup,
+                            internal_storage_fs_cache_wait,
+                            fsCacheWarmupLabels)
+
+std::map<std::string, std::string> hedgedReadHedgeLabels{{"type", "hedge"}};
+std::map<std::string, std::string> hedgedReadRetryLabels{{"type", "retry"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_storage_hedged_read_count,
+    "[cpp]count of the extra requests sent for slow or failed remote reads")
+DEFINE_PROMETHEUS_COUNTER(internal_storage_hedged_read_count_hedge,
+                          internal_storage_hedged_read_count,
+                          hedgedReadHedgeLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_storage_hedged_read_count_retry,
+                          internal_storage_hedged_read_count,
+                          hedgedReadRetryLabels)
+
 // json stats metrics
 std::map<std::string, std::string> invertedIndexLatencyLabels{
     {"type", "inverted_index_latency"}};
@@ -154,6 +202,138 @@ DEFINE_PROMETHEUS_HISTOGRAM(internal_json_stats_latency_load,
                             internal_json_stats_latency,
                             loadLatencyLabels)
 
+// expr result cache metrics
+std::map<std::string, std::string> exprResCacheHitLabels{{"type", "hit"}};
+std::map<std::string, std::string> exprResCacheMissLabels{{"type", "miss"}};
+std::map<std::string, std::string> exprResCacheEvictionLabels{
+    {"type", "eviction"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_core_expr_res_cache_total,
+                                 "[cpp]count of expr result cache operation")
+DEFINE_PROMETHEUS_COUNTER(internal_core_expr_res_cache_hit,
+                          internal_core_expr_res_cache_total,
+                          exprResCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_expr_res_cache_miss,
+                          internal_core_expr_res_cache_total,
+                          exprResCacheMissLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_expr_res_cache_eviction,
+                          internal_core_expr_res_cache_total,
+                          exprResCacheEvictionLabels)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_core_expr_res_cache_bytes,
+                               "[cpp]bytes used by expr result cache")
+DEFINE_PROMETHEUS_GAUGE(internal_core_expr_res_cache_bytes_all,
+                        internal_core_expr_res_cache_bytes,
+                        {})
+
+// search result cache metrics, sharing the labels of the expr result cache
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_core_search_res_cache_total,
+                                 "[cpp]count of search result cache operation")
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_res_cache_hit,
+                          internal_core_search_res_cache_total,
+                          exprResCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_res_cache_miss,
+                          internal_core_search_res_cache_total,
+                          exprResCacheMissLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_res_cache_eviction,
+                          internal_core_search_res_cache_total,
+                          exprResCacheEvictionLabels)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(internal_core_search_res_cache_bytes,
+                               "[cpp]bytes used by search result cache")
+DEFINE_PROMETHEUS_GAUGE(internal_core_search_res_cache_bytes_all,
+                        internal_core_search_res_cache_bytes,
+                        {})
+
+// compressed cell tier metrics, a miss is a cell loaded from storage
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_compressed_cell_tier_total,
+    "[cpp]count of compressed cell tier operation")
+DEFINE_PROMETHEUS_COUNTER(internal_core_compressed_cell_tier_hit,
+                          internal_core_compressed_cell_tier_total,
+                          exprResCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_compressed_cell_tier_miss,
+                          internal_core_compressed_cell_tier_total,
+                          exprResCacheMissLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_compressed_cell_tier_eviction,
+                          internal_core_compressed_cell_tier_total,
+                          exprResCacheEvictionLabels)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_core_compressed_cell_tier_bytes,
+    "[cpp]bytes of the cells kept compressed in memory")
+DEFINE_PROMETHEUS_GAUGE(internal_core_compressed_cell_tier_bytes_all,
+                        internal_core_compressed_cell_tier_bytes,
+                        {})
+
+// parquet footer cache metrics, a miss is a footer read from storage
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_core_parquet_meta_cache_total,
+                                 "[cpp]count of parquet meta cache operation")
+DEFINE_PROMETHEUS_COUNTER(internal_core_parquet_meta_cache_hit,
+                          internal_core_parquet_meta_cache_total,
+                          exprResCacheHitLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_parquet_meta_cache_miss,
+                          internal_core_parquet_meta_cache_total,
+                          exprResCacheMissLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_parquet_meta_cache_eviction,
+                          internal_core_parquet_meta_cache_total,
+                          exprResCacheEvictionLabels)
+DEFINE_PROMETHEUS_GAUGE_FAMILY(
+    internal_core_parquet_meta_cache_bytes,
+    "[cpp]bytes of the parquet footers cached in memory")
+DEFINE_PROMETHEUS_GAUGE(internal_core_parquet_meta_cache_bytes_all,
+                        internal_core_parquet_meta_cache_bytes,
+                        {})
+
+// search coalescing metrics, a batch is searched for its searches
+std::map<std::string, std::string> searchCoalesceBatchLabels{
+    {"type", "batch"}};
+std::map<std::string, std::string> searchCoalesceSearchLabels{
+    {"type", "search"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_search_coalesce_count,
+    "[cpp]count of the searches of a segment coalesced into one")
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_coalesce_count_batch,
+                          internal_core_search_coalesce_count,
+                          searchCoalesceBatchLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_search_coalesce_count_search,
+                          internal_core_search_coalesce_count,
+                          searchCoalesceSearchLabels)
+
+// segment affinity metrics, a spill runs on another L3 cache than the
+// segment's own
+std::map<std::string, std::string> segmentAffinityLocalLabels{
+    {"type", "local"}};
+std::map<std::string, std::string> segmentAffinitySpillLabels{
+    {"type", "spill"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(
+    internal_core_segment_affinity_count,
+    "[cpp]count of the segment tasks routed to an L3 cache domain")
+DEFINE_PROMETHEUS_COUNTER(internal_core_segment_affinity_count_local,
+                          internal_core_segment_affinity_count,
+                          segmentAffinityLocalLabels)
+DEFINE_PROMETHEUS_COUNTER(internal_core_segment_affinity_count_spill,
+                          internal_core_segment_affinity_count,
+                          segmentAffinitySpillLabels)
+
+prometheus::Gauge&
+internal_core_kernel_variant(const std::string& family,
+                             const std::string& variant) {
+    static auto& gauges =
+        prometheus::BuildGauge()
+            .Name("internal_core_kernel_variant")
+            .Help("[cpp]kernel variant picked for a kernel family")
+            .Register(getPrometheusClient().GetRegistry());
+    return gauges.Add({{"family", family}, {"variant", variant}});
+}
+
+prometheus::Gauge&
+internal_core_jemalloc_arena_bytes(const std::string& arena,
+                                   const std::string& kind) {
+    static auto& gauges =
+        prometheus::BuildGauge()
+            .Name("internal_core_jemalloc_arena_bytes")
+            .Help("[cpp]bytes in the jemalloc arena of a subsystem")
+            .Register(getPrometheusClient().GetRegistry());
+    return gauges.Add({{"arena", arena}, {"kind", kind}});
+}
+
 // search latency metrics
 std::map<std::string, std::string> scalarLatencyLabels{
     {"type", "scalar_latency"}};
@@ -306,4 +486,32 @@ DEFINE_PROMETHEUS_GAUGE(internal_cgo_executing_task_total_all,
                         internal_cgo_executing_task_total,
                         {});
 
+// hardware events of the sampled async cgo tasks, the ratios of the events
+// (instructions per cycle, misses per instruction) are what matters
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_cgo_hw_sampled_task_total,
+                                 "[cpp]async cgo tasks sampled for hw events");
+DEFINE_PROMETHEUS_COUNTER(internal_cgo_hw_sampled_task_total_all,
+                          internal_cgo_hw_sampled_task_total,
+                          {});
+std::map<std::string, std::string> hwCyclesLabels{{"event", "cycles"}};
+std::map<std::string, std::string> hwInstructionsLabels{
+    {"event", "instructions"}};
+std::map<std::string, std::string> hwLlcMissesLabels{{"event", "llc_misses"}};
+std::map<std::string, std::string> hwBranchMissesLabels{
+    {"event", "branch_misses"}};
+DEFINE_PROMETHEUS_COUNTER_FAMILY(internal_cgo_hw_events_total,
+                                 "[cpp]hw events of sampled async cgo tasks");
+DEFINE_PROMETHEUS_COUNTER(internal_cgo_hw_events_cycles,
+                          internal_cgo_hw_events_total,
+                          hwCyclesLabels);
+DEFINE_PROMETHEUS_COUNTER(internal_cgo_hw_events_instructions,
+                          internal_cgo_hw_events_total,
+                          hwInstructionsLabels);
+DEFINE_PROMETHEUS_COUNTER(internal_cgo_hw_events_llc_misses,
+                          internal_cgo_hw_events_total,
+                          hwLlcMissesLabels);
+DEFINE_PROMETHEUS_COUNTER(internal_cgo_hw_events_branch_misses,
+                          internal_cgo_hw_events_total,
+                          hwBranchMissesLabels);
+
 }  // namespace milvus::monitor
@@ -55,6 +55,21 @@ DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_download_duration);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_write_disk_duration);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_deserialize_duration);
 
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_storage_rate_limit_wait);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_rate_limit_wait_read);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_rate_limit_wait_write);
+
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_storage_fs_cache_count);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_fs_cache_count_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_fs_cache_count_miss);
+DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_storage_fs_cache_wait);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_fs_cache_wait_create);
+DECLARE_PROMETHEUS_HISTOGRAM(internal_storage_fs_cache_wait_warmup);
+
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_storage_hedged_read_count);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_hedged_read_count_hedge);
+DECLARE_PROMETHEUS_COUNTER(internal_storage_hedged_read_count_retry);
+
 // mmap metrics
 DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_mmap_allocated_space_bytes);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_mmap_allocated_space_bytes_anon);
@@ -96,6 +111,13 @@ DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_cgo_inflight_task_total);
 DECLARE_PROMETHEUS_GAUGE(internal_cgo_inflight_task_total_all);
 DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_cgo_executing_task_total);
 DECLARE_PROMETHEUS_GAUGE(internal_cgo_executing_task_total_all);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_cgo_hw_sampled_task_total);
+DECLARE_PROMETHEUS_COUNTER(internal_cgo_hw_sampled_task_total_all);
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_cgo_hw_events_total);
+DECLARE_PROMETHEUS_COUNTER(internal_cgo_hw_events_cycles);
+DECLARE_PROMETHEUS_COUNTER(internal_cgo_hw_events_instructions);
+DECLARE_PROMETHEUS_COUNTER(internal_cgo_hw_events_llc_misses);
+DECLARE_PROMETHEUS_COUNTER(internal_cgo_hw_events_branch_misses);
 
 // json stats metrics
 DECLARE_PROMETHEUS_HISTOGRAM_FAMILY(internal_json_stats_latency);
@@ -104,4 +126,58 @@ DECLARE_PROMETHEUS_HISTOGRAM(internal_json_stats_latency_shredding);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_json_stats_latency_shared);
 DECLARE_PROMETHEUS_HISTOGRAM(internal_json_stats_latency_load);
 
+// expr result cache metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_expr_res_cache_total);
+DECLARE_PROMETHEUS_COUNTER(internal_core_expr_res_cache_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_core_expr_res_cache_miss);
+DECLARE_PROMETHEUS_COUNTER(internal_core_expr_res_cache_eviction);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_core_expr_res_cache_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_core_expr_res_cache_bytes_all);
+
+// search result cache metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_search_res_cache_total);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_res_cache_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_res_cache_miss);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_res_cache_eviction);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_core_search_res_cache_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_core_search_res_cache_bytes_all);
+
+// compressed cell tier metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_compressed_cell_tier_total);
+DECLARE_PROMETHEUS_COUNTER(internal_core_compressed_cell_tier_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_core_compressed_cell_tier_miss);
+DECLARE_PROMETHEUS_COUNTER(internal_core_compressed_cell_tier_eviction);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_core_compressed_cell_tier_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_core_compressed_cell_tier_bytes_all);
+
+// parquet footer cache metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_parquet_meta_cache_total);
+DECLARE_PROMETHEUS_COUNTER(internal_core_parquet_meta_cache_hit);
+DECLARE_PROMETHEUS_COUNTER(internal_core_parquet_meta_cache_miss);
+DECLARE_PROMETHEUS_COUNTER(internal_core_parquet_meta_cache_eviction);
+DECLARE_PROMETHEUS_GAUGE_FAMILY(internal_core_parquet_meta_cache_bytes);
+DECLARE_PROMETHEUS_GAUGE(internal_core_parquet_meta_cache_bytes_all);
+
+// search coalescing metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_search_coalesce_count);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_coalesce_count_batch);
+DECLARE_PROMETHEUS_COUNTER(internal_core_search_coalesce_count_search);
+
+// segment affinity metrics
+DECLARE_PROMETHEUS_COUNTER_FAMILY(internal_core_segment_affinity_count);
+DECLARE_PROMETHEUS_COUNTER(internal_core_segment_affinity_count_local);
+DECLARE_PROMETHEUS_COUNTER(internal_core_segment_affinity_count_spill);
+
+// kernel dispatch metrics, the gauge of the variant picked for a kernel
+// family is 1
+prometheus::Gauge&
+internal_core_kernel_variant(const std::string& family,
+                             const std::string& variant);
+
+// jemalloc arena metrics, bytes of kind (allocated, active, resident or
+// fragmentation) in the arena of a subsystem
+prometheus::Gauge&
+internal_core_jemalloc_arena_bytes(const std::string& arena,
+                                   const std::string& kind);
+
 }  // namespace milvus::monitor
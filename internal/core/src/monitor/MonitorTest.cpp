@@ -10,10 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <string>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 
 #include "monitor/monitor_c.h"
+#include "monitor/scope_metric.h"
 #include "monitor/Monitor.h"
 
 using namespace std;
@@ -77,4 +79,29 @@ TEST_F(MonitorTest, GetCoreMetrics) {
         EXPECT_EQ(
             0, strncmp(currentLine, familyName.c_str(), familyName.length()));
     }
-}
\ No newline at end of file
+}
+
+static void
+ScopeMetricTestCall() {
+    SCOPE_CGO_CALL_METRIC();
+}
+
+TEST_F(MonitorTest, ScopeMetricMergedOnScrape) {
+    for (int i = 0; i < 3; i++) {
+        ScopeMetricTestCall();
+    }
+    // the calls of an exited thread are still merged
+    std::thread thread([]() {
+        for (int i = 0; i < 2; i++) {
+            ScopeMetricTestCall();
+        }
+    });
+    thread.join();
+
+    auto metrics = GetCoreMetrics();
+    std::string text(metrics);
+    free(metrics);
+    EXPECT_NE(text.find("milvus_cgocall_duration_seconds_count{func=\""
+                        "ScopeMetricTestCall\"} 5"),
+              std::string::npos);
+}
@@ -0,0 +1,201 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "monitor/PerfCounters.h"
+
+#include <array>
+#include <cerrno>
+#include <functional>
+#include <random>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "log/Log.h"
+#include "monitor/Monitor.h"
+
+namespace milvus::monitor {
+
+std::atomic<double> PerfCounters::sample_ratio_{0};
+
+namespace {
+
+constexpr size_t kNumEvents = 4;
+
+// The counter group of one thread.
+class ThreadGroup {
+ public:
+    ThreadGroup() {
+        ok_ = Open();
+    }
+
+    ~ThreadGroup() {
+        Close();
+    }
+
+    bool
+    Read(PerfCounterValues& values) const {
+#if defined(__linux__)
+        if (!ok_) {
+            return false;
+        }
+        // PERF_FORMAT_GROUP with the enabled and running times
+        struct {
+            uint64_t nr;
+            uint64_t time_enabled;
+            uint64_t time_running;
+            uint64_t values[kNumEvents];
+        } buf;
+        if (::read(fds_[0], &buf, sizeof(buf)) != sizeof(buf) ||
+            buf.nr != kNumEvents || buf.time_running == 0) {
+            return false;
+        }
+        // the group was multiplexed with other events part of the time
+        auto scale = static_cast<double>(buf.time_enabled) / buf.time_running;
+        auto scaled = [&](size_t i) {
+            return static_cast<int64_t>(buf.values[i] * scale);
+        };
+        values = {scaled(0), scaled(1), scaled(2), scaled(3)};
+        return true;
+#else
+        return false;
+#endif
+    }
+
+ private:
+    bool
+    Open() {
+#if defined(__linux__)
+        static constexpr std::array<uint64_t, kNumEvents> kEvents{
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (size_t i = 0; i < kNumEvents; i++) {
+            struct perf_event_attr attr {};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = kEvents[i];
+            // the leader starts the whole group once all are open
+            attr.disabled = i == 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP |
+                               PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            auto fd = syscall(__NR_perf_event_open,
+                              &attr,
+                              0,
+                              -1,
+                              i == 0 ? -1 : fds_[0],
+                              PERF_FLAG_FD_CLOEXEC);
+            if (fd < 0) {
+                LOG_DEBUG("hardware counters unavailable, errno: {}", errno);
+                Close();
+                return false;
+            }
+            fds_[i] = static_cast<int>(fd);
+        }
+        ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void
+    Close() {
+#if defined(__linux__)
+        for (auto& fd : fds_) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    std::array<int, kNumEvents> fds_{-1, -1, -1, -1};
+    bool ok_{false};
+};
+
+thread_local bool sampling_on_thread = false;
+
+}  // namespace
+
+void
+PerfCounters::SetSampleRatio(double ratio) {
+    sample_ratio_.store(ratio);
+    LOG_INFO("set hardware counter sample ratio: {}", ratio);
+}
+
+double
+PerfCounters::SampleRatio() {
+    return sample_ratio_.load(std::memory_order_relaxed);
+}
+
+bool
+PerfCounters::Read(PerfCounterValues& values) {
+    thread_local ThreadGroup group;
+    return group.Read(values);
+}
+
+bool
+PerfCounters::Sampling() {
+    return sampling_on_thread;
+}
+
+PerfCounters::SampleScope::SampleScope() {
+    auto ratio = SampleRatio();
+    if (ratio <= 0 || sampling_on_thread) {
+        return;
+    }
+    thread_local std::minstd_rand random(
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    if (std::uniform_real_distribution<double>(0, 1)(random) >= ratio) {
+        return;
+    }
+    if (Read(start_)) {
+        sampled_ = true;
+        sampling_on_thread = true;
+    }
+}
+
+PerfCounters::SampleScope::~SampleScope() {
+    if (sampled_) {
+        sampling_on_thread = false;
+    }
+}
+
+PerfCounterValues
+PerfCounters::SampleScope::Elapsed() const {
+    PerfCounterValues now;
+    if (!sampled_ || !Read(now)) {
+        return {};
+    }
+    return now - start_;
+}
+
+void
+ObserveCgoPerfCounters(const PerfCounterValues& values) {
+    internal_cgo_hw_sampled_task_total_all.Increment();
+    internal_cgo_hw_events_cycles.Increment(values.cycles);
+    internal_cgo_hw_events_instructions.Increment(values.instructions);
+    internal_cgo_hw_events_llc_misses.Increment(values.llc_misses);
+    internal_cgo_hw_events_branch_misses.Increment(values.branch_misses);
+}
+
+}  // namespace milvus::monitor
@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace milvus::monitor {
+
+// Hardware events counted on one thread.
+struct PerfCounterValues {
+    int64_t cycles{0};
+    int64_t instructions{0};
+    int64_t llc_misses{0};
+    int64_t branch_misses{0};
+
+    PerfCounterValues&
+    operator+=(const PerfCounterValues& rhs) {
+        cycles += rhs.cycles;
+        instructions += rhs.instructions;
+        llc_misses += rhs.llc_misses;
+        branch_misses += rhs.branch_misses;
+        return *this;
+    }
+
+    PerfCounterValues
+    operator-(const PerfCounterValues& rhs) const {
+        return {cycles - rhs.cycles,
+                instructions - rhs.instructions,
+                llc_misses - rhs.llc_misses,
+                branch_misses - rhs.branch_misses};
+    }
+};
+
+// The hardware counters of the calling thread, a perf_event_open group of
+// cycles, instructions, last level cache misses and branch misses counted
+// in user space. The group of a thread is opened on its first read and
+// kept for the life of the thread.
+//
+// A read is a syscall, so only a SampleRatio() share of the cgo tasks is
+// sampled: a SampleScope decides it for the work of the calling thread,
+// and the operator profiles of a sampled task read the counters on their
+// timed calls. Where the kernel denies the counters (perf_event_paranoid,
+// containers without CAP_PERFMON) or the platform has none, nothing is
+// sampled.
+class PerfCounters {
+ public:
+    // the share of the cgo tasks sampled, 0 turns sampling off
+    static void
+    SetSampleRatio(double ratio);
+
+    static double
+    SampleRatio();
+
+    // the counts of the calling thread so far, false if it has no counters
+    static bool
+    Read(PerfCounterValues& values);
+
+    // whether the work on the calling thread is sampled
+    static bool
+    Sampling();
+
+    // Samples the work done on the calling thread while it lives, with
+    // SampleRatio() chance. A nested scope belongs to the outer one.
+    class SampleScope {
+     public:
+        SampleScope();
+        ~SampleScope();
+
+        SampleScope(const SampleScope&) = delete;
+        SampleScope&
+        operator=(const SampleScope&) = delete;
+
+        bool
+        sampled() const {
+            return sampled_;
+        }
+
+        // the counts since the scope started, zero if it is not sampled
+        PerfCounterValues
+        Elapsed() const;
+
+     private:
+        bool sampled_{false};
+        PerfCounterValues start_;
+    };
+
+ private:
+    static std::atomic<double> sample_ratio_;
+};
+
+// Adds the counts of a sampled async cgo task to the prometheus counters.
+void
+ObserveCgoPerfCounters(const PerfCounterValues& values);
+
+}  // namespace milvus::monitor
@@ -0,0 +1,254 @@
+// Copyright 2025 Zilliz
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "monitor/jemalloc_arena.h"
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#endif
+
+#include "common/Common.h"
+#include "log/Log.h"
+#include "monitor/Monitor.h"
+
+namespace milvus::monitor {
+
+namespace {
+
+const char* const kArenaNames[JEMALLOC_ARENA_COUNT] = {
+    "load", "index_build", "query"};
+
+// the jemalloc index of the arena per subsystem, -1 until created
+std::atomic<int64_t> arena_indexes[JEMALLOC_ARENA_COUNT] = {-1, -1, -1};
+std::mutex create_mutex;
+
+// the subsystem the calling thread is bound to, -1 if none
+thread_local int bound_subsystem = -1;
+
+// the arena of subsystem, created on first use, -1 if it can't be created
+int64_t
+ArenaIndex(mallctl_t mallctl_fn, JemallocArena subsystem) {
+    auto& index = arena_indexes[static_cast<int>(subsystem)];
+    auto value = index.load(std::memory_order_acquire);
+    if (value >= 0) {
+        return value;
+    }
+    std::lock_guard<std::mutex> lock(create_mutex);
+    value = index.load(std::memory_order_relaxed);
+    if (value >= 0) {
+        return value;
+    }
+    unsigned created = 0;
+    size_t sz = sizeof(created);
+    if (mallctl_fn("arenas.create", &created, &sz, nullptr, 0) != 0) {
+        LOG_WARN("failed to create the jemalloc arena of {}",
+                 kArenaNames[static_cast<int>(subsystem)]);
+        return -1;
+    }
+    if (subsystem != JemallocArena::kQuery) {
+        // the buffers of loads and builds are transient, their dirty pages
+        // are purged soon instead of kept for reuse
+        ssize_t dirty_ms = JEMALLOC_TRANSIENT_ARENA_DECAY_MS.load();
+        ssize_t muzzy_ms = 0;
+        auto prefix = "arena." + std::to_string(created);
+        mallctl_fn((prefix + ".dirty_decay_ms").c_str(),
+                   nullptr,
+                   nullptr,
+                   &dirty_ms,
+                   sizeof(dirty_ms));
+        mallctl_fn((prefix + ".muzzy_decay_ms").c_str(),
+                   nullptr,
+                   nullptr,
+                   &muzzy_ms,
+                   sizeof(muzzy_ms));
+    }
+    LOG_INFO("created jemalloc arena {} for {}",
+             created,
+             kArenaNames[static_cast<int>(subsystem)]);
+    index.store(created, std::memory_order_release);
+    return created;
+}
+
+template <typename T>
+bool
+ReadArenaStat(mallctl_t mallctl_fn,
+              int64_t index,
+              const char* name,
+              T& value) {
+    auto key = "stats.arenas." + std::to_string(index) + "." + name;
+    size_t sz = sizeof(value);
+    return mallctl_fn(key.c_str(), &value, &sz, nullptr, 0) == 0;
+}
+
+// the stats of the arena index, the stats epoch must be refreshed before
+JemallocStats
+ArenaStats(mallctl_t mallctl_fn, int64_t index) {
+    JemallocStats stats;
+    std::memset(&stats, 0, sizeof(JemallocStats));
+    size_t page = 0;
+    size_t sz = sizeof(page);
+    size_t pactive = 0;
+    size_t small_allocated = 0;
+    size_t large_allocated = 0;
+    size_t base = 0;
+    size_t resident = 0;
+    size_t mapped = 0;
+    size_t retained = 0;
+    if (mallctl_fn("arenas.page", &page, &sz, nullptr, 0) != 0 ||
+        !ReadArenaStat(mallctl_fn, index, "pactive", pactive) ||
+        !ReadArenaStat(
+            mallctl_fn, index, "small.allocated", small_allocated) ||
+        !ReadArenaStat(
+            mallctl_fn, index, "large.allocated", large_allocated) ||
+        !ReadArenaStat(mallctl_fn, index, "base", base) ||
+        !ReadArenaStat(mallctl_fn, index, "resident", resident) ||
+        !ReadArenaStat(mallctl_fn, index, "mapped", mapped) ||
+        !ReadArenaStat(mallctl_fn, index, "retained", retained)) {
+        return stats;
+    }
+    auto allocated = small_allocated + large_allocated;
+    auto active = pactive * page;
+    stats.allocated = allocated;
+    stats.active = active;
+    stats.metadata = base;
+    stats.resident = resident;
+    stats.mapped = mapped;
+    stats.retained = retained;
+    stats.fragmentation = (active > allocated) ? (active - allocated) : 0;
+    stats.overhead = (resident > active) ? (resident - active) : 0;
+    stats.success = true;
+    return stats;
+}
+
+}  // namespace
+
+mallctl_t
+GetMallctl() {
+#ifdef __linux__
+    static mallctl_t fn = (mallctl_t)dlsym(RTLD_DEFAULT, "mallctl");
+    return fn;
+#else
+    return nullptr;
+#endif
+}
+
+void
+BindThreadToArena(JemallocArena subsystem) {
+    if (bound_subsystem == static_cast<int>(subsystem) ||
+        !JEMALLOC_ARENA_PARTITION_ENABLED.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto mallctl_fn = GetMallctl();
+    if (mallctl_fn == nullptr) {
+        return;
+    }
+    auto index = ArenaIndex(mallctl_fn, subsystem);
+    if (index < 0) {
+        return;
+    }
+    unsigned arena = index;
+    if (mallctl_fn("thread.arena", nullptr, nullptr, &arena, sizeof(arena)) ==
+        0) {
+        bound_subsystem = static_cast<int>(subsystem);
+    }
+}
+
+ScopedJemallocArena::ScopedJemallocArena(JemallocArena subsystem) {
+    if (!JEMALLOC_ARENA_PARTITION_ENABLED.load(std::memory_order_relaxed)) {
+        return;
+    }
+    auto mallctl_fn = GetMallctl();
+    if (mallctl_fn == nullptr) {
+        return;
+    }
+    auto index = ArenaIndex(mallctl_fn, subsystem);
+    if (index < 0) {
+        return;
+    }
+    unsigned arena = index;
+    size_t sz = sizeof(former_);
+    if (mallctl_fn("thread.arena", &former_, &sz, &arena, sizeof(arena)) ==
+        0) {
+        former_subsystem_ = bound_subsystem;
+        bound_subsystem = static_cast<int>(subsystem);
+        bound_ = true;
+    }
+}
+
+ScopedJemallocArena::~ScopedJemallocArena() {
+    if (!bound_) {
+        return;
+    }
+    GetMallctl()(
+        "thread.arena", nullptr, nullptr, &former_, sizeof(former_));
+    bound_subsystem = former_subsystem_;
+}
+
+void
+RefreshJemallocArenaMetrics() {
+    auto mallctl_fn = GetMallctl();
+    if (mallctl_fn == nullptr) {
+        return;
+    }
+    for (int i = 0; i < JEMALLOC_ARENA_COUNT; ++i) {
+        auto index = arena_indexes[i].load(std::memory_order_acquire);
+        if (index < 0) {
+            continue;
+        }
+        auto stats = ArenaStats(mallctl_fn, index);
+        if (!stats.success) {
+            continue;
+        }
+        internal_core_jemalloc_arena_bytes(kArenaNames[i], "allocated")
+            .Set(stats.allocated);
+        internal_core_jemalloc_arena_bytes(kArenaNames[i], "active")
+            .Set(stats.active);
+        internal_core_jemalloc_arena_bytes(kArenaNames[i], "resident")
+            .Set(stats.resident);
+        internal_core_jemalloc_arena_bytes(kArenaNames[i], "fragmentation")
+            .Set(stats.fragmentation);
+    }
+}
+
+}  // namespace milvus::monitor
+
+JemallocStats
+GetJemallocArenaStats(enum JemallocArenaSubsystem subsystem) {
+    JemallocStats stats;
+    std::memset(&stats, 0, sizeof(JemallocStats));
+    auto mallctl_fn = milvus::monitor::GetMallctl();
+    if (mallctl_fn == nullptr || subsystem < 0 ||
+        subsystem >= JEMALLOC_ARENA_COUNT) {
+        return stats;
+    }
+    auto index = milvus::monitor::arena_indexes[subsystem].load(
+        std::memory_order_acquire);
+    if (index < 0) {
+        return stats;
+    }
+    uint64_t epoch = 1;
+    size_t epoch_sz = sizeof(epoch);
+    if (mallctl_fn("epoch", &epoch, &epoch_sz, &epoch, epoch_sz) != 0) {
+        return stats;
+    }
+    return milvus::monitor::ArenaStats(mallctl_fn, index);
+}
@@ -0,0 +1,70 @@
+// Copyright 2025 Zilliz
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+#include "monitor/jemalloc_stats_c.h"
+
+namespace milvus::monitor {
+
+// jemalloc mallctl function type
+typedef int (*mallctl_t)(const char*, void*, size_t*, void*, size_t);
+
+// mallctl of the jemalloc loaded into the process, nullptr if jemalloc is
+// not loaded (e.g., via LD_PRELOAD)
+mallctl_t
+GetMallctl();
+
+// The subsystems whose allocations go to arenas of their own, so the large
+// transient buffers of loads and index builds do not fragment the arenas of
+// the small allocations of queries, and their pages go back to the OS soon
+// after a load wave.
+enum class JemallocArena : int {
+    kLoad = JEMALLOC_ARENA_LOAD,
+    kIndexBuild = JEMALLOC_ARENA_INDEX_BUILD,
+    kQuery = JEMALLOC_ARENA_QUERY,
+};
+
+// Routes the allocations of the calling thread to the arena of subsystem,
+// which is created on first use. Does nothing unless arena partitioning is
+// enabled and jemalloc is loaded. Cheap once the thread is bound.
+void
+BindThreadToArena(JemallocArena subsystem);
+
+// Binds the calling thread to the arena of subsystem for a scope, the
+// thread goes back to its former arena after.
+class ScopedJemallocArena {
+ public:
+    explicit ScopedJemallocArena(JemallocArena subsystem);
+
+    ScopedJemallocArena(const ScopedJemallocArena&) = delete;
+    ScopedJemallocArena&
+    operator=(const ScopedJemallocArena&) = delete;
+
+    ~ScopedJemallocArena();
+
+ private:
+    bool bound_{false};
+    unsigned former_{0};
+    int former_subsystem_{-1};
+};
+
+// Sets the per arena gauges from the current jemalloc stats, the stats
+// epoch must be refreshed before.
+void
+RefreshJemallocArenaMetrics();
+
+}  // namespace milvus::monitor
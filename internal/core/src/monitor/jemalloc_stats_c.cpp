@@ -17,24 +17,9 @@
 #include <cstddef>
 #include <cstring>
 
-#ifdef __linux__
-#include <dlfcn.h>
-#endif
-
-// jemalloc mallctl function type
-typedef int (*mallctl_t)(const char*, void*, size_t*, void*, size_t);
-
-// get mallctl function pointer at runtime via dlsym
-// Returns nullptr if jemalloc is not loaded (e.g., via LD_PRELOAD)
-static mallctl_t
-get_mallctl() {
-#ifdef __linux__
-    static mallctl_t fn = (mallctl_t)dlsym(RTLD_DEFAULT, "mallctl");
-    return fn;
-#else
-    return nullptr;
-#endif
-}
+#include "monitor/jemalloc_arena.h"
+
+using milvus::monitor::mallctl_t;
 
 JemallocStats
 GetJemallocStats() {
@@ -42,7 +27,7 @@ GetJemallocStats() {
     std::memset(&stats, 0, sizeof(JemallocStats));
     stats.success = false;
 
-    mallctl_t mallctl_fn = get_mallctl();
+    mallctl_t mallctl_fn = milvus::monitor::GetMallctl();
     if (mallctl_fn == nullptr) {
         // jemalloc is not available, return zeros
         return stats;
@@ -109,5 +94,8 @@ GetJemallocStats() {
 
     stats.success = true;
 
+    // the epoch is fresh, export the stats of the subsystem arenas along
+    milvus::monitor::RefreshJemallocArenaMetrics();
+
     return stats;
 }
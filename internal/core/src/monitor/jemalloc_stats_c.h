@@ -44,6 +44,19 @@ typedef struct {
 JemallocStats
 GetJemallocStats();
 
+// the subsystems with arenas of their own, see monitor/jemalloc_arena.h
+enum JemallocArenaSubsystem {
+    JEMALLOC_ARENA_LOAD = 0,
+    JEMALLOC_ARENA_INDEX_BUILD = 1,
+    JEMALLOC_ARENA_QUERY = 2,
+    JEMALLOC_ARENA_COUNT = 3,
+};
+
+// the stats of the arena of a subsystem, metadata holds the base bytes of
+// the arena. success is false if the arena is not created.
+JemallocStats
+GetJemallocArenaStats(enum JemallocArenaSubsystem subsystem);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,9 +13,11 @@
 
 #include "monitor_c.h"
 #include "common/PrometheusClient.h"
+#include "monitor/scope_metric.h"
 
 char*
 GetCoreMetrics() {
+    milvus::monitor::FlushScopeMetrics();
     auto str = milvus::monitor::getPrometheusClient().GetMetrics();
     auto len = str.length();
     char* res = static_cast<char*>(malloc(len + 1));
@@ -1,6 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <iostream>
+#include <vector>
 #include "log/Log.h"
 #include "Monitor.h"
 #include "scope_metric.h"
@@ -24,34 +29,194 @@ const prometheus::Histogram::BucketBoundaries cgoCallDurationbuckets = {
     std::chrono::duration<float>(std::chrono::seconds(10)).count(),
 };
 
-// One histogram per function name (label)
-static inline prometheus::Histogram&
-GetHistogram(std::string&& func) {
-    static auto& hist_family =
-        prometheus::BuildHistogram()
-            .Name("milvus_cgocall_duration_seconds")
-            .Help("Duration of cgo-exposed functions")
-            .Register(getPrometheusClient().GetRegistry());
-
-    // default buckets: [0.005, 0.01, ..., 1.0]
-    return hist_family.Add({{"func", func}}, cgoCallDurationbuckets);
+namespace {
+
+constexpr size_t kNumBuckets = 15;  // the boundaries above and +Inf
+
+struct FuncCounters {
+    std::array<std::atomic<uint64_t>, kNumBuckets> buckets{};
+    std::atomic<uint64_t> sum_ticks{0};
+};
+
+// The counters of the cgo calls made on one thread. Only that thread adds
+// to them, FlushScopeMetrics takes them with exchanges, so neither side
+// locks on the call path.
+struct ThreadCounters {
+    std::array<std::atomic<FuncCounters*>, FuncMetricId::kMaxFuncMetrics>
+        funcs{};
+    // set on thread exit, the counters are freed by the next flush
+    std::atomic<bool> retired{false};
+
+    ~ThreadCounters() {
+        for (auto& func : funcs) {
+            delete func.load();
+        }
+    }
+};
+
+struct ThreadCountersHolder {
+    std::shared_ptr<ThreadCounters> counters;
+
+    ~ThreadCountersHolder() {
+        if (counters != nullptr) {
+            counters->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+class ScopeMetricRegistry {
+ public:
+    static ScopeMetricRegistry&
+    GetInstance() {
+        static ScopeMetricRegistry instance;
+        return instance;
+    }
+
+    size_t
+    Register(const char* func) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // the last id is shared by the functions beyond the limit
+        auto id = std::min(histograms_.size(),
+                           FuncMetricId::kMaxFuncMetrics - 1);
+        if (id == histograms_.size()) {
+            auto name =
+                id == FuncMetricId::kMaxFuncMetrics - 1 ? "other" : func;
+            histograms_.push_back(
+                &family_.Add({{"func", name}}, cgoCallDurationbuckets));
+        }
+        return id;
+    }
+
+    ThreadCounters&
+    Local() {
+        thread_local ThreadCountersHolder holder;
+        if (holder.counters == nullptr) {
+            holder.counters = std::make_shared<ThreadCounters>();
+            std::lock_guard<std::mutex> lock(mutex_);
+            threads_.push_back(holder.counters);
+        }
+        return *holder.counters;
+    }
+
+    size_t
+    Bucket(uint64_t ticks) const {
+        return std::lower_bound(
+                   bucket_ticks_.begin(), bucket_ticks_.end(), ticks) -
+               bucket_ticks_.begin();
+    }
+
+    void
+    Flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::vector<double>> increments(
+            histograms_.size(), std::vector<double>(kNumBuckets, 0));
+        std::vector<uint64_t> sum_ticks(histograms_.size(), 0);
+        std::vector<bool> observed(histograms_.size(), false);
+        for (auto it = threads_.begin(); it != threads_.end();) {
+            auto& counters = **it;
+            // read before draining, so that a retired thread has made its
+            // last additions when it is dropped
+            auto retired = counters.retired.load(std::memory_order_acquire);
+            for (size_t id = 0; id < histograms_.size(); id++) {
+                auto func = counters.funcs[id].load(std::memory_order_acquire);
+                if (func == nullptr) {
+                    continue;
+                }
+                for (size_t i = 0; i < kNumBuckets; i++) {
+                    auto count = func->buckets[i].exchange(
+                        0, std::memory_order_relaxed);
+                    if (count > 0) {
+                        increments[id][i] += count;
+                        observed[id] = true;
+                    }
+                }
+                sum_ticks[id] +=
+                    func->sum_ticks.exchange(0, std::memory_order_relaxed);
+            }
+            it = retired ? threads_.erase(it) : it + 1;
+        }
+        for (size_t id = 0; id < histograms_.size(); id++) {
+            if (observed[id]) {
+                histograms_[id]->ObserveMultiple(
+                    increments[id], sum_ticks[id] / ticks_per_second_);
+            }
+        }
+    }
+
+ private:
+    ScopeMetricRegistry()
+        : family_(prometheus::BuildHistogram()
+                      .Name("milvus_cgocall_duration_seconds")
+                      .Help("Duration of cgo-exposed functions")
+                      .Register(getPrometheusClient().GetRegistry())),
+          ticks_per_second_(TicksPerSecond()) {
+        for (auto bound : cgoCallDurationbuckets) {
+            bucket_ticks_.push_back(
+                static_cast<uint64_t>(bound * ticks_per_second_));
+        }
+    }
+
+    prometheus::Family<prometheus::Histogram>& family_;
+    const double ticks_per_second_;
+    // upper bounds of the buckets in ticks
+    std::vector<uint64_t> bucket_ticks_;
+
+    std::mutex mutex_;
+    std::vector<prometheus::Histogram*> histograms_;
+    std::vector<std::shared_ptr<ThreadCounters>> threads_;
+};
+
+}  // namespace
+
+double
+TicksPerSecond() {
+    static const double ticks_per_second = [] {
+#if defined(__x86_64__) || defined(__aarch64__)
+        // a couple of milliseconds against the steady clock is enough for
+        // the bucket boundaries
+        auto start = std::chrono::steady_clock::now();
+        auto start_ticks = ReadTicks();
+        auto end = start;
+        do {
+            end = std::chrono::steady_clock::now();
+        } while (end - start < std::chrono::milliseconds(2));
+        auto ticks = ReadTicks() - start_ticks;
+        return ticks / std::chrono::duration<double>(end - start).count();
+#else
+        return 1e9;
+#endif
+    }();
+    return ticks_per_second;
 }
 
-FuncScopeMetric::FuncScopeMetric(const char* f)
-    : func_(f), start_(std::chrono::high_resolution_clock::now()) {
+FuncMetricId::FuncMetricId(const char* func)
+    : id_(ScopeMetricRegistry::GetInstance().Register(func)), name_(func) {
 }
 
 FuncScopeMetric::~FuncScopeMetric() {
-    auto end = std::chrono::high_resolution_clock::now();
-    double duration_sec = std::chrono::duration<double>(end - start_).count();
+    auto ticks = ReadTicks() - start_;
+    auto& registry = ScopeMetricRegistry::GetInstance();
+    auto& counters = registry.Local();
+    auto& slot = counters.funcs[id_.id()];
+    auto func = slot.load(std::memory_order_relaxed);
+    if (func == nullptr) {
+        func = new FuncCounters();
+        slot.store(func, std::memory_order_release);
+    }
+    func->buckets[registry.Bucket(ticks)].fetch_add(
+        1, std::memory_order_relaxed);
+    func->sum_ticks.fetch_add(ticks, std::memory_order_relaxed);
 
+    auto duration_sec = ticks / TicksPerSecond();
     if (duration_sec > 1.0) {
         LOG_INFO("[CGO Call] slow function {} done with duration {}s",
-                 func_,
+                 id_.name(),
                  duration_sec);
     }
-    // record prometheus metric
-    auto& hist = GetHistogram(std::move(func_));
-    hist.Observe(duration_sec);
+}
+
+void
+FlushScopeMetrics() {
+    ScopeMetricRegistry::GetInstance().Flush();
 }
 }  // namespace milvus::monitor
\ No newline at end of file
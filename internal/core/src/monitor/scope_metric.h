@@ -12,22 +12,84 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
-#define SCOPE_CGO_CALL_METRIC() \
-    ::milvus::monitor::FuncScopeMetric _scope_metric(__func__)
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+// The metric id of a function is registered once, on its first call, so a
+// call only reads the tick counter twice and bumps per-thread counters.
+#define SCOPE_CGO_CALL_METRIC()                                       \
+    static const ::milvus::monitor::FuncMetricId _scope_metric_id{    \
+        __func__};                                                    \
+    ::milvus::monitor::FuncScopeMetric _scope_metric(_scope_metric_id)
 
 namespace milvus::monitor {
 
+// Cheap monotonic tick counter: the TSC on x86, the virtual counter on arm,
+// and the steady clock in nanoseconds elsewhere.
+inline uint64_t
+ReadTicks() {
+#if defined(__x86_64__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+// ReadTicks() ticks per second, measured once against the steady clock
+double
+TicksPerSecond();
+
+class FuncMetricId {
+ public:
+    // Registers the histogram of 'func', which must outlive the process
+    // (__func__ does). At most kMaxFuncMetrics functions get their own
+    // histogram, the others share the last one.
+    explicit FuncMetricId(const char* func);
+
+    size_t
+    id() const {
+        return id_;
+    }
+
+    const char*
+    name() const {
+        return name_;
+    }
+
+    static constexpr size_t kMaxFuncMetrics = 256;
+
+ private:
+    size_t id_;
+    const char* name_;
+};
+
 class FuncScopeMetric {
  public:
-    FuncScopeMetric(const char* f);
+    explicit FuncScopeMetric(const FuncMetricId& id)
+        : id_(id), start_(ReadTicks()) {
+    }
 
     ~FuncScopeMetric();
 
  private:
-    std::string func_;
-    std::chrono::high_resolution_clock::time_point start_;
+    const FuncMetricId& id_;
+    uint64_t start_;
 };
 
-}  // namespace milvus::monitor
\ No newline at end of file
+// Merges the per-thread histograms of the cgo calls into the prometheus
+// ones, called before the metrics are serialized.
+void
+FlushScopeMetrics();
+
+}  // namespace milvus::monitor
@@ -388,6 +388,17 @@ class RandomSampleNode : public PlanNode {
         : PlanNode(id), factor_(factor), sources_(std::move(sources)) {
     }
 
+    // samples the rows first and evaluates the filter on the sampled rows
+    RandomSampleNode(const PlanNodeId& id,
+                     float factor,
+                     expr::TypedExprPtr filter)
+        : PlanNode(id), factor_(factor), filter_(std::move(filter)) {
+        AssertInfo(
+            filter_->type() == DataType::BOOL,
+            fmt::format("Filter expression must be of type BOOLEAN, Got {}",
+                        filter_->type()));
+    }
+
     RowTypePtr
     output_type() const override {
         return RowType::None;
@@ -405,17 +416,113 @@ class RandomSampleNode : public PlanNode {
 
     std::string
     ToString() const override {
+        if (filter_ != nullptr) {
+            return fmt::format("RandomSampleNode:[factor:{}, filter_expr:{}]",
+                               factor_,
+                               filter_->ToString());
+        }
         return fmt::format("RandomSampleNode:[factor:{}]", factor_);
     }
 
+    expr::ExprInfo
+    GatherInfo() const override {
+        expr::ExprInfo info;
+        if (filter_ != nullptr) {
+            filter_->GatherInfo(info);
+        }
+        return info;
+    }
+
     float
     factor() const {
         return factor_;
     }
 
+    // nullptr unless the node evaluates the filter itself
+    const expr::TypedExprPtr&
+    filter() const {
+        return filter_;
+    }
+
  private:
     float factor_;
     const std::vector<PlanNodePtr> sources_;
+    const expr::TypedExprPtr filter_;
+};
+
+// Keeps the limit rows that its source does not filter out with the least
+// values of a scalar field, or the greatest unless ascending. The output is
+// a single INT64 column of their segment offsets, in order. Null values
+// sort last.
+class OrderByNode : public PlanNode {
+ public:
+    OrderByNode(const PlanNodeId& id,
+                FieldId field_id,
+                DataType data_type,
+                bool ascending,
+                int64_t limit,
+                std::vector<PlanNodePtr> sources = std::vector<PlanNodePtr>{})
+        : PlanNode(id),
+          field_id_(field_id),
+          data_type_(data_type),
+          ascending_(ascending),
+          limit_(limit),
+          sources_(std::move(sources)) {
+        AssertInfo(limit_ > 0, "order by needs a positive limit: {}", limit_);
+    }
+
+    RowTypePtr
+    output_type() const override {
+        return RowType::None;
+    }
+
+    std::vector<PlanNodePtr>
+    sources() const override {
+        return sources_;
+    }
+
+    std::string_view
+    name() const override {
+        return "OrderByNode";
+    }
+
+    std::string
+    ToString() const override {
+        return fmt::format(
+            "OrderByNode:[field_id:{}, ascending:{}, limit:{}, "
+            "source_node:{}]",
+            field_id_.get(),
+            ascending_,
+            limit_,
+            SourceToString());
+    }
+
+    FieldId
+    field_id() const {
+        return field_id_;
+    }
+
+    DataType
+    data_type() const {
+        return data_type_;
+    }
+
+    bool
+    ascending() const {
+        return ascending_;
+    }
+
+    int64_t
+    limit() const {
+        return limit_;
+    }
+
+ private:
+    const FieldId field_id_;
+    const DataType data_type_;
+    const bool ascending_;
+    const int64_t limit_;
+    const std::vector<PlanNodePtr> sources_;
 };
 
 class VectorSearchNode : public PlanNode {
@@ -52,6 +52,7 @@ CachedSearchIterator::InitializeChunkedIterators(
     const milvus::DataType& data_type,
     const GetChunkDataFunc& get_chunk_data) {
     int64_t offset = 0;
+    exact_order_ = true;
     chunked_heaps_.resize(nq_);
     for (int64_t chunk_id = 0; chunk_id < num_chunks_; ++chunk_id) {
         auto [chunk_data, chunk_size] = get_chunk_data(chunk_id);
@@ -203,12 +204,21 @@ CachedSearchIterator::GetNextValidResult(
     const std::optional<float>& radius,
     const std::optional<float>& range_filter) {
     auto& iterator = iterators_[iterator_idx];
-    while (iterator->HasNext()) {
+    while (iterator != nullptr && iterator->HasNext()) {
         auto result = ConvertIteratorResult(iterator->Next());
         if (IsValid(result, last_bound, radius, range_filter)) {
             return result;
         }
+        // brute force iterators yield in order, nothing after this result
+        // is within the radius
+        if (exact_order_ && radius.has_value() &&
+            result.first >= radius.value()) {
+            break;
+        }
     }
+    // a finished iterator frees the distances it computed for its chunk, so
+    // the chunks done with do not hold memory until the search ends
+    iterator.reset();
     return std::nullopt;
 }
 
@@ -266,12 +276,13 @@ CachedSearchIterator::GetBatchedNextResults(size_t query_idx,
     rst.reserve(batch_size_);
 
     if (num_chunks_ == 1) {
-        auto& iterator = iterators_[query_idx];
-        while (iterator->HasNext() && rst.size() < batch_size_) {
-            auto result = ConvertIteratorResult(iterator->Next());
-            if (IsValid(result, last_bound, radius, range_filter)) {
-                rst.emplace_back(result);
+        while (rst.size() < batch_size_) {
+            auto result = GetNextValidResult(
+                query_idx, last_bound, radius, range_filter);
+            if (!result.has_value()) {
+                break;
             }
+            rst.emplace_back(result.value());
         }
     } else {
         MergeChunksResults(query_idx, last_bound, radius, range_filter, rst);
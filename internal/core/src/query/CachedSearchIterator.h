@@ -85,6 +85,9 @@ class CachedSearchIterator {
     int64_t batch_size_ = 0;
     std::vector<knowhere::IndexNode::IteratorPtr> iterators_;
     int8_t sign_ = 1;
+    // brute force iterators yield their chunk in exact distance order, index
+    // iterators only roughly
+    bool exact_order_ = false;
     size_t num_chunks_ = 1;
     size_t nq_ = 0;
 
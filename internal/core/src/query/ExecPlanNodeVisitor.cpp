@@ -19,9 +19,14 @@
 #include "query/SubSearchResult.h"
 #include "query/Utils.h"
 #include "segcore/SegmentGrowing.h"
+#include "common/Common.h"
 #include "common/Json.h"
+#include "common/RangeSearchHelper.h"
 #include "log/Log.h"
 #include "plan/PlanNode.h"
+#include "exec/FilterSelectivity.h"
+#include "exec/MemoryTracker.h"
+#include "exec/SharedFilterResults.h"
 #include "exec/Task.h"
 #include "segcore/SegmentInterface.h"
 #include "segcore/Utils.h"
@@ -50,12 +55,22 @@ ExecPlanNodeVisitor::ExecuteTask(
               query_context->get_active_count(),
               query_context->get_query_timestamp());
 
+    // waits while the running queries hold the query memory budget
+    milvus::exec::QueryAdmissionGuard admission(
+        query_context->get_op_context());
     auto task =
         milvus::exec::Task::Create(DEFAULT_TASK_ID, plan, 0, query_context);
     RowVectorPtr ret = nullptr;
     int64_t processed_num = 0;
     for (;;) {
-        auto result = task->Next();
+        auto future = ContinueFuture::makeEmpty();
+        auto result = task->Next(&future);
+        if (!result && future.valid()) {
+            // the drivers are waiting for the caching layer, their loads run
+            // concurrently meanwhile
+            future.wait();
+            continue;
+        }
         if (!result) {
             if (ret && !ret->childrens().empty()) {
                 auto first_column =
@@ -100,9 +115,66 @@ ExecPlanNodeVisitor::ExecuteTask(
     span.GetSpan()->SetAttribute("total_rows", processed_num);
     span.GetSpan()->SetAttribute("matched_rows",
                                  ret ? processed_num - ret->nullCount() : 0);
+
+    auto profile = task->operator_stats();
+    for (const auto& stats : profile) {
+        span.GetSpan()->SetAttribute(
+            fmt::format("operator_{}", stats.operator_id), stats.ToString());
+    }
+    LOG_DEBUG("task profile: {}", ToString(profile));
+    auto peak_memory = query_context->memory_tracker()->peak();
+    span.GetSpan()->SetAttribute("peak_memory_bytes", peak_memory);
+    LOG_DEBUG("task peak memory: {} bytes", peak_memory);
+    query_context->set_query_profile(std::move(profile));
     return ret;
 }
 
+std::shared_ptr<RangeSearchBound>
+ExecPlanNodeVisitor::NewRangeSearchBound(
+    const VectorPlanNode& node, const PlaceholderGroup& placeholder_group) {
+    const auto& search_info = node.search_info_;
+    // grouped, iterated, element level, rescored and rounded results are
+    // not ranked by the distances the range search returns
+    if (!search_info.search_params_.contains(RADIUS) ||
+        search_info.round_decimal_ != -1 ||
+        search_info.group_by_field_id_.has_value() ||
+        search_info.iterative_filter_execution ||
+        search_info.iterator_v2_info_.has_value() ||
+        search_info.element_level() ||
+        std::dynamic_pointer_cast<const plan::RescoresNode>(
+            node.plannodes_) != nullptr ||
+        placeholder_group.size() != 1 ||
+        placeholder_group.at(0).element_level_) {
+        return nullptr;
+    }
+    return std::make_shared<RangeSearchBound>(
+        placeholder_group.at(0).num_of_queries_,
+        search_info.topk_,
+        search_info.metric_type_);
+}
+
+// the filter of a search whose bitset is masked by MVCC and searched on as
+// it is, nullptr for the other plans
+static expr::TypedExprPtr
+pre_filter_of(const plan::PlanNodePtr& plannodes) {
+    auto node = plannodes;
+    while (node != nullptr &&
+           std::dynamic_pointer_cast<plan::VectorSearchNode>(node) == nullptr) {
+        auto sources = node->sources();
+        node = sources.size() == 1 ? sources[0] : nullptr;
+    }
+    if (node == nullptr || node->sources().size() != 1) {
+        return nullptr;
+    }
+    auto mvcc = std::dynamic_pointer_cast<plan::MvccNode>(node->sources()[0]);
+    if (mvcc == nullptr || mvcc->sources().size() != 1) {
+        return nullptr;
+    }
+    auto filter =
+        std::dynamic_pointer_cast<plan::FilterBitsNode>(mvcc->sources()[0]);
+    return filter == nullptr ? nullptr : filter->filter();
+}
+
 std::unique_ptr<RetrieveResult>
 wrap_num_entities(int64_t cnt) {
     auto retrieve_result = std::make_unique<RetrieveResult>();
@@ -253,8 +325,18 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
     auto op_context = milvus::OpContext(cancel_token_);
     query_context->set_op_context(&op_context);
 
+    // A plain filtered retrieve keeps the first rows that pass, when the
+    // segment picks them in row order the filter may stop once it has them
+    auto mvcc = std::dynamic_pointer_cast<plan::MvccNode>(node.plannodes_);
+    if (mvcc != nullptr && mvcc->sources().size() == 1 &&
+        std::dynamic_pointer_cast<plan::FilterBitsNode>(mvcc->sources()[0]) &&
+        node.limit_ > 0 && segment->find_first_in_row_order()) {
+        query_context->set_retrieve_limit(node.limit_);
+    }
+
     // Do task execution
     auto result = ExecuteTask(plan, query_context);
+    retrieve_result.retrieve_profile_ = query_context->get_query_profile();
     setupRetrieveResult(result, op_context, node, retrieve_result, segment);
 }
 
@@ -276,7 +358,18 @@ ExecPlanNodeVisitor::setupRetrieveResult(
     AssertInfo(first_column,
                "children inside row vector must be of column vector for now");
     tmp_retrieve_result.total_data_cnt_ = first_column->size();
-    if (first_column->IsBitmap()) {
+    if (std::dynamic_pointer_cast<plan::OrderByNode>(node.plannodes_)) {
+        // the order by node has already picked the rows, in order
+        auto order_by_count = first_column->size();
+        auto offsets = static_cast<const int64_t*>(first_column->GetRawData());
+        tmp_retrieve_result.total_data_cnt_ =
+            segment->get_active_count(timestamp_);
+        tmp_retrieve_result.result_offsets_.assign(offsets,
+                                                   offsets + order_by_count);
+        tmp_retrieve_result.has_more_result =
+            static_cast<int64_t>(order_by_count) == node.limit_;
+        retrieve_result_opt_ = std::move(tmp_retrieve_result);
+    } else if (first_column->IsBitmap()) {
         tracer::AutoSpan _("Find Limit Pk", tracer::GetRootSpan());
         BitsetTypeView view(first_column->GetRawData(), first_column->size());
         auto results_pair = segment->find_first(node.limit_, view);
@@ -327,9 +420,6 @@ ExecPlanNodeVisitor::visit(VectorPlanNode& node) {
         return;
     }
 
-    // Construct plan fragment
-    auto plan = plan::PlanFragment(node.plannodes_);
-
     // Set query context
     auto query_context =
         std::make_shared<milvus::exec::QueryContext>(DEAFULT_QUERY_ID,
@@ -340,13 +430,62 @@ ExecPlanNodeVisitor::visit(VectorPlanNode& node) {
                                                      consistency_level_,
                                                      node.plan_options_);
 
-    query_context->set_search_info(node.search_info_);
-    query_context->set_placeholder_group(placeholder_group_);
-
     // Set op context to query context
     auto op_context = milvus::OpContext(cancel_token_);
     query_context->set_op_context(&op_context);
 
+    // Pick the filter strategy of the segment by how many rows pass
+    auto plannodes = node.plannodes_;
+    auto search_info = node.search_info_;
+    // the chunks of the segment prune by each other at least
+    if (search_info.range_search_bound_ == nullptr) {
+        search_info.range_search_bound_ =
+            NewRangeSearchBound(node, *placeholder_group_);
+    }
+    if (node.alternative_plannodes_ != nullptr) {
+        auto pass_rate = exec::SampleFilterPassRate(
+            node.filter_expr_,
+            query_context.get(),
+            FILTER_SELECTIVITY_SAMPLE_ROWS.load());
+        if (pass_rate.has_value()) {
+            auto iterative = search_info.iterative_filter_execution;
+            if (exec::PreferIterativeFilter(iterative,
+                                            pass_rate.value(),
+                                            search_info.topk_,
+                                            active_count) != iterative) {
+                plannodes = node.alternative_plannodes_;
+                search_info.iterative_filter_execution = !iterative;
+            }
+            tracer::AddEvent(
+                fmt::format("filter pass rate: {}, iterative filter: {}",
+                            pass_rate.value(),
+                            search_info.iterative_filter_execution));
+        }
+    }
+
+    // the sub-requests of a hybrid search evaluate their common filter once
+    if (exec::SharedFilterResults::IsEnabled() &&
+        !search_info.iterative_filter_execution) {
+        if (auto filter = pre_filter_of(plannodes)) {
+            exec::SharedFilterResults::Key key{
+                segment->get_segment_id(),
+                fmt::format("{}|{}|{}|{}|{}",
+                            filter->ToString(),
+                            timestamp_,
+                            collection_ttl_timestamp_,
+                            active_count,
+                            segment->get_deleted_count())};
+            query_context->set_shared_filter(
+                exec::SharedFilterResults::Instance().Join(key));
+        }
+    }
+
+    // Construct plan fragment
+    auto plan = plan::PlanFragment(plannodes);
+
+    query_context->set_search_info(search_info);
+    query_context->set_placeholder_group(placeholder_group_);
+
     // Do plan fragment task work
     auto result = ExecuteTask(plan, query_context);
 
@@ -356,6 +495,7 @@ ExecPlanNodeVisitor::visit(VectorPlanNode& node) {
         op_context.storage_usage.scanned_cold_bytes.load();
     search_result_opt_->search_storage_cost_.scanned_total_bytes =
         op_context.storage_usage.scanned_total_bytes.load();
+    search_result_opt_->search_profile_ = query_context->get_query_profile();
 }
 
 }  // namespace milvus::query
@@ -99,6 +99,12 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     ExecuteTask(plan::PlanFragment& plan,
                 std::shared_ptr<milvus::exec::QueryContext> query_context);
 
+    // a bound for the chunks and segments the range search of node runs on
+    // to share, null unless its topk ranks the raw distances alone
+    static std::shared_ptr<RangeSearchBound>
+    NewRangeSearchBound(const VectorPlanNode& node,
+                        const PlaceholderGroup& placeholder_group);
+
     void
     setupRetrieveResult(const RowVectorPtr& result,
                         const OpContext& op_context,
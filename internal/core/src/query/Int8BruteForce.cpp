@@ -0,0 +1,152 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "query/Int8BruteForce.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "common/Int8Distance.h"
+#include "common/Utils.h"
+#include "index/Utils.h"
+#include "knowhere/comp/index_param.h"
+
+namespace milvus::query {
+
+namespace {
+
+// rows a parallel task scores
+constexpr int64_t kRowsPerTask = 1024;
+
+enum class Metric { kL2, kIP, kCosine };
+
+// the best (key, row) pairs of a query, the smaller key the better, the
+// worst on top
+class TopK {
+ public:
+    explicit TopK(int64_t topk) : topk_(topk) {
+        heap_.reserve(topk);
+    }
+
+    void
+    Push(float key, int64_t row) {
+        if (static_cast<int64_t>(heap_.size()) < topk_) {
+            heap_.emplace_back(key, row);
+            std::push_heap(heap_.begin(), heap_.end());
+        } else if (topk_ > 0 && key < heap_.front().first) {
+            std::pop_heap(heap_.begin(), heap_.end());
+            heap_.back() = {key, row};
+            std::push_heap(heap_.begin(), heap_.end());
+        }
+    }
+
+    std::vector<std::pair<float, int64_t>>&
+    pairs() {
+        return heap_;
+    }
+
+ private:
+    const int64_t topk_;
+    std::vector<std::pair<float, int64_t>> heap_;
+};
+
+}  // namespace
+
+bool
+Int8BruteForceSupported(const MetricType& metric_type) {
+    return IsMetricType(metric_type, knowhere::metric::L2) ||
+           IsMetricType(metric_type, knowhere::metric::IP) ||
+           IsMetricType(metric_type, knowhere::metric::COSINE);
+}
+
+void
+Int8BruteForceSearch(const dataset::SearchDataset& query_ds,
+                     const dataset::RawDataset& raw_ds,
+                     const BitsetView& bitset,
+                     SubSearchResult& sub_result) {
+    auto metric = Metric::kCosine;
+    if (IsMetricType(query_ds.metric_type, knowhere::metric::L2)) {
+        metric = Metric::kL2;
+    } else if (IsMetricType(query_ds.metric_type, knowhere::metric::IP)) {
+        metric = Metric::kIP;
+    }
+    auto dim = raw_ds.dim;
+    auto num_queries = query_ds.num_queries;
+    auto num_rows = raw_ds.num_raw_data;
+    auto topk = query_ds.topk;
+    auto queries = static_cast<const int8_t*>(query_ds.query_data);
+    auto rows = static_cast<const int8_t*>(raw_ds.raw_data);
+
+    std::vector<int32_t> query_norms(num_queries);
+    for (int64_t q = 0; q < num_queries; ++q) {
+        query_norms[q] = Int8SquaredNorm(queries + q * dim, dim);
+    }
+
+    // found[task * num_queries + q]
+    auto num_tasks = (num_rows + kRowsPerTask - 1) / kRowsPerTask;
+    std::vector<TopK> found(num_tasks * num_queries, TopK(topk));
+    index::ParallelRun(num_tasks, [&](size_t task) {
+        std::vector<int32_t> dots(num_queries);
+        auto end = std::min<int64_t>(num_rows, (task + 1) * kRowsPerTask);
+        for (int64_t r = task * kRowsPerTask; r < end; ++r) {
+            if (!bitset.empty() && bitset.test(raw_ds.begin_id + r)) {
+                continue;
+            }
+            auto row = rows + r * dim;
+            auto norm = Int8Dots(queries, num_queries, row, dim, dots.data());
+            for (int64_t q = 0; q < num_queries; ++q) {
+                float key;
+                switch (metric) {
+                    case Metric::kL2:
+                        // exact in integers, the sum of the squares fits
+                        key = static_cast<float>(int64_t(query_norms[q]) +
+                                                 norm - 2 * int64_t(dots[q]));
+                        break;
+                    case Metric::kIP:
+                        key = -static_cast<float>(dots[q]);
+                        break;
+                    case Metric::kCosine: {
+                        auto norms = static_cast<float>(query_norms[q]) * norm;
+                        key = norms > 0 ? -dots[q] / std::sqrt(norms) : 0;
+                        break;
+                    }
+                }
+                found[task * num_queries + q].Push(key, r);
+            }
+        }
+    });
+
+    index::ParallelRun(num_queries, [&](size_t q) {
+        std::vector<std::pair<float, int64_t>> ranked;
+        for (int64_t task = 0; task < num_tasks; ++task) {
+            auto& pairs = found[task * num_queries + q].pairs();
+            ranked.insert(ranked.end(), pairs.begin(), pairs.end());
+        }
+        auto count = std::min<int64_t>(topk, ranked.size());
+        std::partial_sort(
+            ranked.begin(), ranked.begin() + count, ranked.end());
+        for (int64_t k = 0; k < count; ++k) {
+            sub_result.get_offsets()[q * topk + k] =
+                raw_ds.begin_id + ranked[k].second;
+            sub_result.get_distances()[q * topk + k] =
+                metric == Metric::kL2 ? ranked[k].first : -ranked[k].first;
+        }
+    });
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,41 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "query/SubSearchResult.h"
+#include "query/helper.h"
+
+namespace milvus::query {
+
+// whether Int8BruteForceSearch scores the metric: L2, IP and COSINE
+bool
+Int8BruteForceSupported(const MetricType& metric_type);
+
+// Brute force top-k search of int8 query vectors against the int8 vectors
+// of raw_ds. Every row is scored against a tile of queries at a time on its
+// int8 elements, exact in int32, rows in parallel. The distances are the
+// ones knowhere returns: squared L2, IP and cosine. Rows set in bitset at
+// begin_id + row are left out.
+void
+Int8BruteForceSearch(const dataset::SearchDataset& query_ds,
+                     const dataset::RawDataset& raw_ds,
+                     const BitsetView& bitset,
+                     SubSearchResult& sub_result);
+
+}  // namespace milvus::query
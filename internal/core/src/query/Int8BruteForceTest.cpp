@@ -0,0 +1,115 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "knowhere/comp/index_param.h"
+#include "query/Int8BruteForce.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+namespace {
+
+constexpr int64_t kDim = 37;
+
+float
+Distance(const MetricType& metric, const int8_t* left, const int8_t* right) {
+    float dot = 0, left_norm = 0, right_norm = 0, l2 = 0;
+    for (int64_t i = 0; i < kDim; ++i) {
+        dot += float(left[i]) * right[i];
+        left_norm += float(left[i]) * left[i];
+        right_norm += float(right[i]) * right[i];
+        l2 += (float(left[i]) - right[i]) * (float(left[i]) - right[i]);
+    }
+    if (metric == knowhere::metric::L2) {
+        return l2;
+    }
+    if (metric == knowhere::metric::IP) {
+        return dot;
+    }
+    return dot / std::sqrt(left_norm * right_norm);
+}
+
+}  // namespace
+
+TEST(Int8BruteForceTest, MatchesScalarDistances) {
+    std::default_random_engine er(42);
+    std::uniform_int_distribution<int> dist(-128, 127);
+    // past a parallel task of rows
+    int64_t num_rows = 2500;
+    int64_t begin_id = 100;
+    int64_t num_queries = 6;
+    std::vector<int8_t> rows(num_rows * kDim);
+    std::vector<int8_t> queries(num_queries * kDim);
+    for (auto& value : rows) {
+        value = static_cast<int8_t>(dist(er));
+    }
+    for (auto& value : queries) {
+        value = static_cast<int8_t>(dist(er));
+    }
+    BitsetType filtered(begin_id + num_rows);
+    for (int64_t r = 0; r < num_rows; r += 3) {
+        filtered[begin_id + r] = true;
+    }
+    BitsetView bitset(filtered);
+
+    int64_t topk = 20;
+    dataset::RawDataset raw_ds{begin_id, kDim, num_rows, rows.data()};
+    for (const auto& metric : {knowhere::metric::L2,
+                               knowhere::metric::IP,
+                               knowhere::metric::COSINE}) {
+        ASSERT_TRUE(Int8BruteForceSupported(metric));
+        dataset::SearchDataset query_ds{
+            metric, num_queries, topk, -1, kDim, queries.data()};
+        SubSearchResult sub_result(num_queries, topk, metric, -1);
+        Int8BruteForceSearch(query_ds, raw_ds, bitset, sub_result);
+
+        bool smaller_better = metric == knowhere::metric::L2;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            std::vector<float> expected;
+            for (int64_t r = 0; r < num_rows; ++r) {
+                if (!filtered[begin_id + r]) {
+                    expected.push_back(Distance(metric,
+                                                queries.data() + q * kDim,
+                                                rows.data() + r * kDim));
+                }
+            }
+            if (smaller_better) {
+                std::sort(expected.begin(), expected.end());
+            } else {
+                std::sort(expected.rbegin(), expected.rend());
+            }
+            for (int64_t k = 0; k < topk; ++k) {
+                auto offset = sub_result.get_offsets()[q * topk + k];
+                auto r = offset - begin_id;
+                ASSERT_GE(r, 0);
+                ASSERT_LT(r, num_rows);
+                EXPECT_FALSE(filtered[offset]);
+                auto distance = sub_result.get_distances()[q * topk + k];
+                EXPECT_NEAR(distance, expected[k], 1e-4 * std::abs(distance));
+                EXPECT_NEAR(distance,
+                            Distance(metric,
+                                     queries.data() + q * kDim,
+                                     rows.data() + r * kDim),
+                            1e-4 * std::abs(distance));
+            }
+        }
+    }
+    EXPECT_FALSE(Int8BruteForceSupported(knowhere::metric::HAMMING));
+}
@@ -0,0 +1,283 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "query/MaxSim.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/EasyAssert.h"
+#include "common/HalfFloat.h"
+#include "common/Utils.h"
+#include "index/Utils.h"
+#include "knowhere/comp/index_param.h"
+
+namespace milvus::query {
+
+namespace {
+
+// independent partial sums, so the loops below vectorize
+constexpr int64_t kLanes = 8;
+// query vectors scored against a row vector while it is in registers
+constexpr int64_t kQueryTile = 4;
+// rows a parallel task scores
+constexpr int64_t kRowsPerTask = 64;
+
+// the IP of kTile query vectors with one row vector
+template <int64_t kTile>
+void
+TileDot(const float* queries, const float* row, int64_t dim, float* dots) {
+    float sums[kTile][kLanes] = {};
+    int64_t i = 0;
+    for (; i + kLanes <= dim; i += kLanes) {
+        for (int64_t t = 0; t < kTile; ++t) {
+            for (int64_t l = 0; l < kLanes; ++l) {
+                sums[t][l] += queries[t * dim + i + l] * row[i + l];
+            }
+        }
+    }
+    for (int64_t t = 0; t < kTile; ++t) {
+        float dot = 0;
+        for (int64_t l = 0; l < kLanes; ++l) {
+            dot += sums[t][l];
+        }
+        for (int64_t j = i; j < dim; ++j) {
+            dot += queries[t * dim + j] * row[j];
+        }
+        dots[t] = dot;
+    }
+}
+
+// the vectors [begin, end) as floats, each scaled to unit length for cosine
+template <typename T>
+void
+ToFloat(const T* vectors,
+        int64_t begin,
+        int64_t end,
+        int64_t dim,
+        bool normalize,
+        std::vector<float>& out) {
+    out.resize((end - begin) * dim);
+    if constexpr (std::is_same_v<T, float>) {
+        std::copy(vectors + begin * dim, vectors + end * dim, out.data());
+    } else {
+        HalfToFloat(vectors + begin * dim, out.data(), (end - begin) * dim);
+    }
+    for (int64_t v = begin; v < end; ++v) {
+        auto dst = out.data() + (v - begin) * dim;
+        float norm = 0;
+        for (int64_t i = 0; i < dim; ++i) {
+            norm += dst[i] * dst[i];
+        }
+        if (normalize && norm > 0) {
+            auto scale = 1.0f / std::sqrt(norm);
+            for (int64_t i = 0; i < dim; ++i) {
+                dst[i] *= scale;
+            }
+        }
+    }
+}
+
+// MaxSimBest over half precision row vectors, scored on their elements
+// with fp32 accumulators rather than converted first. dots is scratch.
+template <typename T>
+void
+MaxSimBestHalf(const float* queries,
+               int64_t num_queries,
+               const T* row,
+               int64_t num_row_vectors,
+               int64_t dim,
+               bool normalize,
+               float* best,
+               std::vector<float>& dots) {
+    std::fill_n(best, num_queries, std::numeric_limits<float>::lowest());
+    dots.resize(num_queries);
+    for (int64_t v = 0; v < num_row_vectors; ++v) {
+        auto norm =
+            HalfDots(queries, num_queries, row + v * dim, dim, dots.data());
+        auto scale = normalize && norm > 0 ? 1.0f / std::sqrt(norm) : 1.0f;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            best[q] = std::max(best[q], dots[q] * scale);
+        }
+    }
+}
+
+template <typename T>
+void
+MaxSimSearchImpl(const dataset::SearchDataset& query_ds,
+                 const dataset::RawDataset& raw_ds,
+                 bool cosine,
+                 const BitsetView& bitset,
+                 SubSearchResult& sub_result) {
+    auto dim = raw_ds.dim;
+    auto num_queries = query_ds.num_queries;
+    auto num_rows = raw_ds.num_raw_data;
+    auto query_offsets = query_ds.query_offsets;
+    auto row_offsets = raw_ds.raw_data_offsets;
+    auto rows = static_cast<const T*>(raw_ds.raw_data);
+
+    std::vector<float> queries;
+    ToFloat(static_cast<const T*>(query_ds.query_data),
+            0,
+            query_offsets[num_queries],
+            dim,
+            cosine,
+            queries);
+
+    // scores[q * num_rows + row], NaN for the rows left out
+    std::vector<float> scores(num_queries * num_rows);
+    auto num_tasks = (num_rows + kRowsPerTask - 1) / kRowsPerTask;
+    index::ParallelRun(num_tasks, [&](size_t task) {
+        // the row as floats, or the dots of a half precision row vector
+        std::vector<float> row;
+        std::vector<float> best(query_offsets[num_queries]);
+        auto end = std::min<int64_t>(num_rows, (task + 1) * kRowsPerTask);
+        for (int64_t r = task * kRowsPerTask; r < end; ++r) {
+            bool skip =
+                row_offsets[r] == row_offsets[r + 1] ||
+                (!bitset.empty() && bitset.test(raw_ds.begin_id + r));
+            if (skip) {
+                for (int64_t q = 0; q < num_queries; ++q) {
+                    scores[q * num_rows + r] =
+                        std::numeric_limits<float>::quiet_NaN();
+                }
+                continue;
+            }
+            if constexpr (std::is_same_v<T, float>) {
+                ToFloat(rows,
+                        row_offsets[r],
+                        row_offsets[r + 1],
+                        dim,
+                        cosine,
+                        row);
+                MaxSimBest(queries.data(),
+                           query_offsets[num_queries],
+                           row.data(),
+                           row_offsets[r + 1] - row_offsets[r],
+                           dim,
+                           best.data());
+            } else {
+                MaxSimBestHalf(queries.data(),
+                               query_offsets[num_queries],
+                               rows + row_offsets[r] * dim,
+                               row_offsets[r + 1] - row_offsets[r],
+                               dim,
+                               cosine,
+                               best.data(),
+                               row);
+            }
+            for (int64_t q = 0; q < num_queries; ++q) {
+                float score = 0;
+                for (auto v = query_offsets[q]; v < query_offsets[q + 1];
+                     ++v) {
+                    score += best[v];
+                }
+                scores[q * num_rows + r] = score;
+            }
+        }
+    });
+
+    auto topk = query_ds.topk;
+    index::ParallelRun(num_queries, [&](size_t q) {
+        std::vector<std::pair<float, int64_t>> ranked;
+        ranked.reserve(num_rows);
+        for (int64_t r = 0; r < num_rows; ++r) {
+            auto score = scores[q * num_rows + r];
+            if (!std::isnan(score)) {
+                ranked.emplace_back(-score, r);
+            }
+        }
+        auto found = std::min<int64_t>(topk, ranked.size());
+        std::partial_sort(
+            ranked.begin(), ranked.begin() + found, ranked.end());
+        for (int64_t k = 0; k < found; ++k) {
+            sub_result.get_offsets()[q * topk + k] =
+                raw_ds.begin_id + ranked[k].second;
+            sub_result.get_distances()[q * topk + k] = -ranked[k].first;
+        }
+    });
+}
+
+}  // namespace
+
+bool
+MaxSimSupported(const MetricType& metric_type, DataType element_type) {
+    return (IsMetricType(metric_type, knowhere::metric::MAX_SIM_IP) ||
+            IsMetricType(metric_type, knowhere::metric::MAX_SIM_COSINE)) &&
+           (element_type == DataType::VECTOR_FLOAT ||
+            element_type == DataType::VECTOR_FLOAT16 ||
+            element_type == DataType::VECTOR_BFLOAT16);
+}
+
+void
+MaxSimBest(const float* queries,
+           int64_t num_queries,
+           const float* row,
+           int64_t num_row_vectors,
+           int64_t dim,
+           float* best) {
+    std::fill_n(best, num_queries, std::numeric_limits<float>::lowest());
+    float dots[kQueryTile];
+    int64_t q = 0;
+    for (; q + kQueryTile <= num_queries; q += kQueryTile) {
+        for (int64_t v = 0; v < num_row_vectors; ++v) {
+            TileDot<kQueryTile>(queries + q * dim, row + v * dim, dim, dots);
+            for (int64_t t = 0; t < kQueryTile; ++t) {
+                best[q + t] = std::max(best[q + t], dots[t]);
+            }
+        }
+    }
+    for (; q < num_queries; ++q) {
+        for (int64_t v = 0; v < num_row_vectors; ++v) {
+            TileDot<1>(queries + q * dim, row + v * dim, dim, dots);
+            best[q] = std::max(best[q], dots[0]);
+        }
+    }
+}
+
+void
+MaxSimSearch(const dataset::SearchDataset& query_ds,
+             const dataset::RawDataset& raw_ds,
+             DataType element_type,
+             const BitsetView& bitset,
+             SubSearchResult& sub_result) {
+    AssertInfo(query_ds.query_offsets != nullptr &&
+                   raw_ds.raw_data_offsets != nullptr,
+               "max sim search needs the offsets of the embedding lists");
+    bool cosine =
+        IsMetricType(query_ds.metric_type, knowhere::metric::MAX_SIM_COSINE);
+    switch (element_type) {
+        case DataType::VECTOR_FLOAT:
+            return MaxSimSearchImpl<float>(
+                query_ds, raw_ds, cosine, bitset, sub_result);
+        case DataType::VECTOR_FLOAT16:
+            return MaxSimSearchImpl<float16>(
+                query_ds, raw_ds, cosine, bitset, sub_result);
+        case DataType::VECTOR_BFLOAT16:
+            return MaxSimSearchImpl<bfloat16>(
+                query_ds, raw_ds, cosine, bitset, sub_result);
+        default:
+            ThrowInfo(ErrorCode::Unsupported,
+                      "max sim search does not support element type {}",
+                      element_type);
+    }
+}
+
+}  // namespace milvus::query
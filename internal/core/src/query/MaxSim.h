@@ -0,0 +1,57 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "query/SubSearchResult.h"
+#include "query/helper.h"
+
+namespace milvus::query {
+
+// whether MaxSimSearch scores the metric over embedding lists of the element
+// type: MAX_SIM_IP and MAX_SIM_COSINE over float, float16 and bfloat16
+bool
+MaxSimSupported(const MetricType& metric_type, DataType element_type);
+
+// best[q] = the best IP of query vector q with any of the num_row_vectors
+// row vectors, for num_queries query vectors of dim floats
+void
+MaxSimBest(const float* queries,
+           int64_t num_queries,
+           const float* row,
+           int64_t num_row_vectors,
+           int64_t dim,
+           float* best);
+
+// Brute force search of the query embedding lists against the embedding
+// lists of raw_ds, offsets into raw_ds.raw_data in raw_ds.raw_data_offsets.
+// A row scores the sum over the vectors of a query of their best IP, or
+// cosine, with a vector of the row. Float rows are scored against a tile of
+// query vectors at a time, half precision rows the same on their own
+// elements, without a conversion, rows in parallel. Rows set in bitset at
+// begin_id + row and empty rows are left out.
+void
+MaxSimSearch(const dataset::SearchDataset& query_ds,
+             const dataset::RawDataset& raw_ds,
+             DataType element_type,
+             const BitsetView& bitset,
+             SubSearchResult& sub_result);
+
+}  // namespace milvus::query
@@ -0,0 +1,149 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "knowhere/comp/index_param.h"
+#include "query/MaxSim.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+namespace {
+
+constexpr int64_t kDim = 19;
+
+float
+Dot(const float* left, const float* right) {
+    float dot = 0;
+    for (int64_t i = 0; i < kDim; ++i) {
+        dot += left[i] * right[i];
+    }
+    return dot;
+}
+
+std::vector<float>
+GenVectors(int64_t num_vectors, std::default_random_engine& er) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::vector<float> vectors(num_vectors * kDim);
+    for (auto& value : vectors) {
+        value = dist(er);
+    }
+    return vectors;
+}
+
+}  // namespace
+
+TEST(MaxSimTest, BestMatchesScalar) {
+    std::default_random_engine er(42);
+    // a full tile of query vectors and a tail
+    int64_t num_queries = 7;
+    int64_t num_row_vectors = 5;
+    auto queries = GenVectors(num_queries, er);
+    auto row = GenVectors(num_row_vectors, er);
+    std::vector<float> best(num_queries);
+    MaxSimBest(queries.data(),
+               num_queries,
+               row.data(),
+               num_row_vectors,
+               kDim,
+               best.data());
+    for (int64_t q = 0; q < num_queries; ++q) {
+        float expected = Dot(queries.data() + q * kDim, row.data());
+        for (int64_t v = 1; v < num_row_vectors; ++v) {
+            expected = std::max(expected,
+                                Dot(queries.data() + q * kDim,
+                                    row.data() + v * kDim));
+        }
+        EXPECT_NEAR(best[q], expected, 1e-5);
+    }
+}
+
+TEST(MaxSimTest, SearchRanksRowsBySummedBest) {
+    std::default_random_engine er(42);
+    int64_t num_rows = 200;
+    int64_t begin_id = 1000;
+    std::vector<size_t> row_offsets = {0};
+    for (int64_t r = 0; r < num_rows; ++r) {
+        // every 17th row is empty
+        row_offsets.push_back(row_offsets.back() + (r % 17 == 3 ? 0 : r % 6));
+    }
+    auto rows = GenVectors(row_offsets.back(), er);
+    std::vector<size_t> query_offsets = {0, 3, 8};
+    auto queries = GenVectors(query_offsets.back(), er);
+
+    BitsetType filtered(begin_id + num_rows);
+    for (int64_t r = 0; r < num_rows; r += 4) {
+        filtered[begin_id + r] = true;
+    }
+    BitsetView bitset(filtered);
+
+    int64_t topk = 10;
+    dataset::RawDataset raw_ds{
+        begin_id, kDim, num_rows, rows.data(), row_offsets.data()};
+    auto metric = knowhere::metric::MAX_SIM_IP;
+    dataset::SearchDataset query_ds{metric,
+                                    2,
+                                    topk,
+                                    -1,
+                                    kDim,
+                                    queries.data(),
+                                    query_offsets.data()};
+    ASSERT_TRUE(MaxSimSupported(metric, DataType::VECTOR_FLOAT));
+    SubSearchResult sub_result(2, topk, metric, -1);
+    MaxSimSearch(
+        query_ds, raw_ds, DataType::VECTOR_FLOAT, bitset, sub_result);
+
+    for (int64_t q = 0; q < 2; ++q) {
+        std::vector<float> expected;
+        for (int64_t r = 0; r < num_rows; ++r) {
+            if (filtered[begin_id + r] ||
+                row_offsets[r] == row_offsets[r + 1]) {
+                continue;
+            }
+            float score = 0;
+            for (auto v = query_offsets[q]; v < query_offsets[q + 1];
+                 ++v) {
+                float best = Dot(queries.data() + v * kDim,
+                                 rows.data() + row_offsets[r] * kDim);
+                for (auto u = row_offsets[r] + 1; u < row_offsets[r + 1];
+                     ++u) {
+                    best = std::max(best,
+                                    Dot(queries.data() + v * kDim,
+                                        rows.data() + u * kDim));
+                }
+                score += best;
+            }
+            expected.push_back(score);
+        }
+        std::sort(expected.rbegin(), expected.rend());
+        for (int64_t k = 0; k < topk; ++k) {
+            auto offset = sub_result.get_offsets()[q * topk + k];
+            auto r = offset - begin_id;
+            ASSERT_GE(r, 0);
+            ASSERT_LT(r, num_rows);
+            EXPECT_FALSE(filtered[offset]);
+            EXPECT_NE(row_offsets[r], row_offsets[r + 1]);
+            EXPECT_NEAR(
+                sub_result.get_distances()[q * topk + k], expected[k], 1e-4);
+        }
+    }
+    EXPECT_FALSE(MaxSimSupported(knowhere::metric::MAX_SIM_IP,
+                                 DataType::VECTOR_INT8));
+    EXPECT_FALSE(MaxSimSupported(knowhere::metric::MAX_SIM_L2,
+                                 DataType::VECTOR_FLOAT));
+}
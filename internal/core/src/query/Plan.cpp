@@ -95,6 +95,8 @@ ParsePlaceholderGroup(const Plan* plan,
     milvus::proto::common::PlaceholderGroup ph_group;
     auto ok = ph_group.ParseFromArray(blob, blob_len);
     Assert(ok);
+    result->signature_ = std::hash<std::string_view>{}(
+        std::string_view(reinterpret_cast<const char*>(blob), blob_len));
     for (auto& ph : ph_group.placeholders()) {
         Placeholder element;
         element.tag_ = ph.tag();
@@ -110,8 +112,10 @@ ParsePlaceholderGroup(const Plan* plan,
                    static_cast<DataType>(ph.type()));
         element.num_of_queries_ = ph.values_size();
         AssertInfo(element.num_of_queries_ > 0, "must have queries");
-        if (ph.type() ==
-            milvus::proto::common::PlaceholderType::SparseFloatVector) {
+        if (ph.type() == milvus::proto::common::PlaceholderType::VarChar) {
+            element.texts_.assign(ph.values().begin(), ph.values().end());
+        } else if (ph.type() ==
+                   milvus::proto::common::PlaceholderType::SparseFloatVector) {
             element.sparse_matrix_ =
                 SparseBytesToRows(ph.values(), /*validate=*/true);
         } else {
@@ -194,7 +198,10 @@ CreateSearchPlanByExpr(SchemaPtr schema,
     // Note: serialized_expr_plan is of binary format
     proto::plan::PlanNode plan_node;
     ParsePlanNodeProto(plan_node, serialized_expr_plan, size);
-    return ProtoParser(std::move(schema)).CreatePlan(plan_node);
+    auto plan = ProtoParser(std::move(schema)).CreatePlan(plan_node);
+    plan->signature_ = std::hash<std::string_view>{}(std::string_view(
+        static_cast<const char*>(serialized_expr_plan), size));
+    return plan;
 }
 
 std::unique_ptr<Plan>
@@ -203,6 +210,18 @@ CreateSearchPlanFromPlanNode(SchemaPtr schema,
     return ProtoParser(std::move(schema)).CreatePlan(plan_node);
 }
 
+std::unique_ptr<Plan>
+CopySearchPlan(const Plan& plan) {
+    auto res = std::make_unique<Plan>(plan.schema_);
+    res->plan_node_ = std::make_unique<VectorPlanNode>(*plan.plan_node_);
+    res->tag2field_ = plan.tag2field_;
+    res->target_entries_ = plan.target_entries_;
+    res->target_dynamic_fields_ = plan.target_dynamic_fields_;
+    res->extra_info_opt_ = plan.extra_info_opt_;
+    res->signature_ = plan.signature_;
+    return res;
+}
+
 std::unique_ptr<RetrievePlan>
 CreateRetrievePlanByExpr(SchemaPtr schema,
                          const void* serialized_expr_plan,
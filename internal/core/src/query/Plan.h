@@ -41,6 +41,11 @@ std::unique_ptr<Plan>
 CreateSearchPlanFromPlanNode(SchemaPtr schema,
                              const proto::plan::PlanNode& plan_node);
 
+// a copy of plan with its own search info, sharing the plan node tree that
+// the executions only read
+std::unique_ptr<Plan>
+CopySearchPlan(const Plan& plan);
+
 std::unique_ptr<PlaceholderGroup>
 ParsePlaceholderGroup(const Plan* plan,
                       const uint8_t* blob,
@@ -0,0 +1,73 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "query/PlanCache.h"
+
+#include "common/Common.h"
+#include "query/PlanImpl.h"
+
+namespace milvus::query {
+
+std::unique_ptr<Plan>
+SearchPlanCache::GetOrCreate(const SchemaPtr& schema,
+                             const void* serialized_expr_plan,
+                             int64_t size) {
+    auto capacity = SEARCH_PLAN_CACHE_CAPACITY.load();
+    if (capacity <= 0) {
+        {
+            std::lock_guard lock(mutex_);
+            Shrink(0);
+        }
+        return CreateSearchPlanByExpr(schema, serialized_expr_plan, size);
+    }
+    std::string_view key(static_cast<const char*>(serialized_expr_plan),
+                         size);
+    {
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->second->schema_ == schema) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return CopySearchPlan(*it->second->plan_);
+        }
+    }
+
+    // parsed out of the lock, concurrent misses of a key may both parse it
+    std::shared_ptr<const Plan> plan =
+        CreateSearchPlanByExpr(schema, serialized_expr_plan, size);
+    auto res = CopySearchPlan(*plan);
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        it->second->schema_ = schema;
+        it->second->plan_ = std::move(plan);
+        return res;
+    }
+    lru_.push_front(Entry{std::string(key), schema, std::move(plan)});
+    entries_.emplace(lru_.front().key_, lru_.begin());
+    Shrink(capacity);
+    return res;
+}
+
+void
+SearchPlanCache::Shrink(size_t capacity) {
+    while (lru_.size() > capacity) {
+        entries_.erase(lru_.back().key_);
+        lru_.pop_back();
+    }
+}
+
+}  // namespace milvus::query
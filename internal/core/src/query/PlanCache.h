@@ -0,0 +1,71 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "common/Schema.h"
+#include "query/Plan.h"
+
+namespace milvus::query {
+
+// LRU of the search plans of a collection by their serialized bytes. Requests
+// repeating a filter template only differ in their placeholder group, which
+// is parsed per request anyway, so a hit copies the cached plan instead of
+// parsing the proto and its expressions again. A plan is only reused for the
+// schema it was parsed with.
+class SearchPlanCache {
+ public:
+    // a plan of serialized_expr_plan for schema, each call gets its own copy
+    std::unique_ptr<Plan>
+    GetOrCreate(const SchemaPtr& schema,
+                const void* serialized_expr_plan,
+                int64_t size);
+
+    size_t
+    Size() const {
+        std::lock_guard lock(mutex_);
+        return lru_.size();
+    }
+
+ private:
+    struct Entry {
+        std::string key_;
+        SchemaPtr schema_;
+        std::shared_ptr<const Plan> plan_;
+    };
+    using EntryList = std::list<Entry>;
+
+    // evicts the least recently used entries past capacity, under mutex_
+    void
+    Shrink(size_t capacity);
+
+ private:
+    mutable std::mutex mutex_;
+    // most recently used first
+    EntryList lru_;
+    // keys point into the entries of lru_
+    std::unordered_map<std::string_view, EntryList::iterator> entries_;
+};
+
+}  // namespace milvus::query
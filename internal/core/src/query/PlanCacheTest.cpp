@@ -0,0 +1,106 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "common/Common.h"
+#include "query/PlanCache.h"
+#include "query/PlanImpl.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+namespace {
+
+SchemaPtr
+MakeSchema() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}
+
+std::string
+SerializedPlan(const Schema& schema, int64_t topk) {
+    proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(proto::plan::VectorType::FloatVector);
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(schema.get_field_id(FieldName("fakevec")).get());
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(topk);
+    query_info->set_round_decimal(3);
+    query_info->set_metric_type("L2");
+    query_info->set_search_params(R"({"nprobe": 10})");
+    return plan_node.SerializeAsString();
+}
+
+}  // namespace
+
+TEST(SearchPlanCacheTest, HitsCopyThePlan) {
+    auto schema = MakeSchema();
+    auto plan_str = SerializedPlan(*schema, 10);
+    SearchPlanCache cache;
+
+    auto plan = cache.GetOrCreate(schema, plan_str.data(), plan_str.size());
+    auto hit = cache.GetOrCreate(schema, plan_str.data(), plan_str.size());
+    ASSERT_EQ(cache.Size(), 1);
+    ASSERT_NE(plan->plan_node_.get(), hit->plan_node_.get());
+    EXPECT_EQ(GetTopK(hit.get()), 10);
+    EXPECT_EQ(hit->tag2field_, plan->tag2field_);
+    EXPECT_EQ(hit->plan_node_->plannodes_, plan->plan_node_->plannodes_);
+    // the caches of the results of a plan key on its signature
+    EXPECT_NE(hit->signature_, 0);
+    EXPECT_EQ(hit->signature_, plan->signature_);
+
+    // the search info of a copy is its own
+    hit->plan_node_->search_info_.metric_type_ = "IP";
+    auto next = cache.GetOrCreate(schema, plan_str.data(), plan_str.size());
+    EXPECT_EQ(next->plan_node_->search_info_.metric_type_, "L2");
+
+    // another schema parses the plan again
+    auto other = MakeSchema();
+    auto reparsed = cache.GetOrCreate(other, plan_str.data(), plan_str.size());
+    ASSERT_EQ(cache.Size(), 1);
+    EXPECT_EQ(reparsed->schema_, other);
+    EXPECT_NE(reparsed->plan_node_->plannodes_, plan->plan_node_->plannodes_);
+}
+
+TEST(SearchPlanCacheTest, EvictsLeastRecentlyUsed) {
+    auto schema = MakeSchema();
+    auto capacity = SEARCH_PLAN_CACHE_CAPACITY.load();
+    SetDefaultSearchPlanCacheCapacity(2);
+    SearchPlanCache cache;
+
+    auto first = SerializedPlan(*schema, 1);
+    auto first_plan = cache.GetOrCreate(schema, first.data(), first.size());
+    for (int64_t topk = 2; topk <= 3; ++topk) {
+        cache.GetOrCreate(schema, first.data(), first.size());
+        auto plan_str = SerializedPlan(*schema, topk);
+        auto plan = cache.GetOrCreate(schema, plan_str.data(), plan_str.size());
+        EXPECT_EQ(GetTopK(plan.get()), topk);
+    }
+    ASSERT_EQ(cache.Size(), 2);
+    // the first plan stayed in use, so topk 2 was evicted
+    auto hit = cache.GetOrCreate(schema, first.data(), first.size());
+    EXPECT_EQ(hit->plan_node_->plannodes_,
+              first_plan->plan_node_->plannodes_);
+
+    SetDefaultSearchPlanCacheCapacity(0);
+    auto plan = cache.GetOrCreate(schema, first.data(), first.size());
+    EXPECT_EQ(cache.Size(), 0);
+    EXPECT_EQ(GetTopK(plan.get()), 1);
+    SetDefaultSearchPlanCacheCapacity(capacity);
+}
@@ -59,6 +59,8 @@ struct Plan {
     std::map<std::string, FieldId> tag2field_;  // PlaceholderName -> FieldId
     std::vector<FieldId> target_entries_;
     std::vector<std::string> target_dynamic_fields_;
+    // hash of the serialized plan, 0 if the plan was not deserialized
+    uint64_t signature_{0};
     void
     check_identical(Plan& other);
 
@@ -78,11 +80,13 @@ struct Placeholder {
     // dynamic. This change will likely affect lots of code, thus I'll do it in
     // a separate PR, and use dim=0 for sparse float vector searches for now.
 
-    // only one of blob_ and sparse_matrix_ should be set. blob_ is used for
-    // dense vector search and sparse_matrix_ is for sparse vector search.
+    // only one of blob_, sparse_matrix_ and texts_ should be set. blob_ is
+    // used for dense vector search, sparse_matrix_ is for sparse vector
+    // search and texts_ for the BM25 text match search of a VARCHAR field.
     aligned_vector<char> blob_;
     std::unique_ptr<knowhere::sparse::SparseRow<SparseValueType>[]>
         sparse_matrix_;
+    std::vector<std::string> texts_;
     // offsets for embedding list
     aligned_vector<size_t> offsets_;
     bool element_level_{false};
@@ -130,6 +134,9 @@ using PlanPtr = std::unique_ptr<Plan>;
 
 struct PlaceholderGroup : std::vector<Placeholder> {
     using std::vector<Placeholder>::vector;
+
+    // hash of the serialized group, 0 if the group was not deserialized
+    uint64_t signature_{0};
 };
 
 }  // namespace milvus::query
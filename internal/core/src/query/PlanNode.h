@@ -14,6 +14,7 @@
 #include <any>
 #include <memory>
 #include <optional>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -22,6 +23,9 @@
 namespace milvus::plan {
 class PlanNode;
 };
+namespace milvus::expr {
+class ITypeExpr;
+};
 namespace milvus::query {
 
 class PlanNodeVisitor;
@@ -38,6 +42,8 @@ struct PlanNode {
     accept(PlanNodeVisitor&) = 0;
 
     PlanOptions plan_options_;
+    // the fields the filter of the plan reads
+    std::set<FieldId> filter_fields_;
 };
 
 using PlanNodePtr = std::unique_ptr<PlanNode>;
@@ -50,6 +56,11 @@ struct VectorPlanNode : PlanNode {
     SearchInfo search_info_;
     std::string placeholder_tag_;
     std::shared_ptr<milvus::plan::PlanNode> plannodes_;
+    // plannodes_ with the other strategy for filter_expr_, the iterative
+    // filter for a bitset filtered search and the other way round, null when
+    // the strategy is fixed
+    std::shared_ptr<milvus::plan::PlanNode> alternative_plannodes_;
+    std::shared_ptr<const milvus::expr::ITypeExpr> filter_expr_;
 };
 
 struct RetrievePlanNode : PlanNode {
@@ -15,9 +15,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "common/Common.h"
 #include "common/Geometry.h"
 #include "common/Consts.h"
 #include "common/Types.h"
@@ -166,20 +168,27 @@ BuildFilterAndSampleNodes(const proto::plan::QueryPlanNode& query,
                           const planpb::PlanNode& plan_node_proto,
                           const SchemaPtr& schema,
                           const std::vector<plan::PlanNodePtr>& sources,
-                          ProtoParser* parser) {
+                          ProtoParser* parser,
+                          std::set<FieldId>& filter_fields) {
     if (!query.has_predicates()) {
         return nullptr;
     }
 
-    auto parse_expr_to_filter_node =
-        [&](const proto::plan::Expr& predicate_proto) -> plan::PlanNodePtr {
+    auto parse_expr = [&](const proto::plan::Expr& predicate_proto) {
         auto expr = parser->ParseExprs(predicate_proto);
         if (plan_node_proto.has_namespace_()) {
             expr = MergeExprWithNamespace(
                 schema, expr, plan_node_proto.namespace_());
         }
+        expr->GatherFields(filter_fields);
+        return expr;
+    };
+    auto parse_expr_to_filter_node =
+        [&](const proto::plan::Expr& predicate_proto) -> plan::PlanNodePtr {
         return std::make_shared<plan::FilterBitsNode>(
-            milvus::plan::GetNextPlanNodeId(), expr, sources);
+            milvus::plan::GetNextPlanNodeId(),
+            parse_expr(predicate_proto),
+            sources);
     };
 
     auto* predicate_proto = &query.predicates();
@@ -188,6 +197,15 @@ BuildFilterAndSampleNodes(const proto::plan::QueryPlanNode& query,
         // like "`predicate expression` && random_sample(...)". Extract it to construct
         // FilterBitsNode and make it be executed before RandomSampleNode.
         auto& sample_expr = predicate_proto->random_sample_expr();
+        // a small sample evaluates the filter on the sampled rows only
+        if (sample_expr.has_predicate() &&
+            sample_expr.sample_factor() <=
+                RANDOM_SAMPLE_FILTER_FIRST_MAX_FACTOR.load()) {
+            return std::make_shared<plan::RandomSampleNode>(
+                milvus::plan::GetNextPlanNodeId(),
+                sample_expr.sample_factor(),
+                parse_expr(sample_expr.predicate()));
+        }
         plan::PlanNodePtr filter_node = nullptr;
         if (sample_expr.has_predicate()) {
             filter_node = parse_expr_to_filter_node(sample_expr.predicate());
@@ -343,6 +361,32 @@ BuildProjectAndAggregationNodes(
         std::move(aggregates),
         agg_sources);
 }
+
+// the search of a doc level filter by the iterative filter, candidates are
+// filtered as they come from the vector iterators
+plan::PlanNodePtr
+IterativeFilterSearchNodes(const expr::TypedExprPtr& filter) {
+    plan::PlanNodePtr plannode =
+        std::make_shared<plan::MvccNode>(plan::GetNextPlanNodeId());
+    plannode = std::make_shared<plan::VectorSearchNode>(
+        plan::GetNextPlanNodeId(), std::vector<plan::PlanNodePtr>{plannode});
+    return std::make_shared<plan::FilterNode>(
+        plan::GetNextPlanNodeId(),
+        filter,
+        std::vector<plan::PlanNodePtr>{plannode});
+}
+
+// the search of a doc level filter on the bitset of the whole segment
+plan::PlanNodePtr
+FilterBitsSearchNodes(const expr::TypedExprPtr& filter) {
+    plan::PlanNodePtr plannode =
+        std::make_shared<plan::FilterBitsNode>(plan::GetNextPlanNodeId(),
+                                               filter);
+    plannode = std::make_shared<plan::MvccNode>(
+        plan::GetNextPlanNodeId(), std::vector<plan::PlanNodePtr>{plannode});
+    return std::make_shared<plan::VectorSearchNode>(
+        plan::GetNextPlanNodeId(), std::vector<plan::PlanNodePtr>{plannode});
+}
 }  // namespace
 
 std::unique_ptr<VectorPlanNode>
@@ -390,6 +434,12 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
                     schema, doc_expr, plan_node_proto.namespace_());
             }
         }
+        if (element_expr) {
+            element_expr->GatherFields(plan_node->filter_fields_);
+        }
+        if (doc_expr) {
+            doc_expr->GatherFields(plan_node->filter_fields_);
+        }
 
         bool is_iterative =
             plan_node->search_info_.iterative_filter_execution &&
@@ -463,6 +513,29 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
                 milvus::plan::GetNextPlanNodeId(), sources);
             sources = std::vector<milvus::plan::PlanNodePtr>{plannode};
         }
+
+        // a doc level filter without group by may run either way, the
+        // executor takes the other plan when the pass rate of the filter on
+        // a segment favors it. An explicit hint other than the iterative
+        // filter keeps the bitset, so do range search, which has no
+        // iterative filter, materialized views, which tune the bitset
+        // search, and the text match search of a VARCHAR field, which skips
+        // the rows of the bitset while it scores.
+        const auto& search_info = plan_node->search_info_;
+        bool hinted = !anns_proto.query_info().hints().empty() ||
+                      search_info.search_params_.contains(HINTS);
+        bool text_search = IsStringDataType(
+            schema->operator[](search_info.field_id_).get_data_type());
+        if (!is_element_level && doc_expr && !text_search &&
+            search_info.group_by_field_id_ == std::nullopt &&
+            !search_info.search_params_.contains(RADIUS) &&
+            !search_info.materialized_view_involved &&
+            (is_iterative || !hinted)) {
+            plan_node->filter_expr_ = doc_expr;
+            plan_node->alternative_plannodes_ =
+                is_iterative ? FilterBitsSearchNodes(doc_expr)
+                             : IterativeFilterSearchNodes(doc_expr);
+        }
     } else {
         // no filter, force set iterative filter hint to false, go with normal vector search path
         plan_node->search_info_.iterative_filter_execution = false;
@@ -488,6 +561,15 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
             scorers.push_back(ParseScorer(function));
         }
 
+        if (plan_node->alternative_plannodes_ != nullptr) {
+            plan_node->alternative_plannodes_ =
+                std::make_shared<milvus::plan::RescoresNode>(
+                    milvus::plan::GetNextPlanNodeId(),
+                    scorers,
+                    plan_node_proto.score_option(),
+                    std::vector<milvus::plan::PlanNodePtr>{
+                        plan_node->alternative_plannodes_});
+        }
         plannode = std::make_shared<milvus::plan::RescoresNode>(
             milvus::plan::GetNextPlanNodeId(),
             std::move(scorers),
@@ -522,6 +604,7 @@ ProtoParser::RetrievePlanNodeFromProto(
                     expr = MergeExprWithNamespace(
                         schema, expr, plan_node_proto.namespace_());
                 }
+                expr->GatherFields(node->filter_fields_);
                 return std::make_shared<plan::FilterBitsNode>(
                     milvus::plan::GetNextPlanNodeId(), expr);
             }();
@@ -536,8 +619,12 @@ ProtoParser::RetrievePlanNodeFromProto(
             auto& query = plan_node_proto.query();
 
             // 1. Build FilterBitsNode and RandomSampleNode if needed
-            auto filter_node = BuildFilterAndSampleNodes(
-                query, plan_node_proto, schema, sources, this);
+            auto filter_node = BuildFilterAndSampleNodes(query,
+                                                         plan_node_proto,
+                                                         schema,
+                                                         sources,
+                                                         this,
+                                                         node->filter_fields_);
             if (filter_node) {
                 plannode = filter_node;
                 sources = std::vector<milvus::plan::PlanNodePtr>{plannode};
@@ -1058,6 +1145,10 @@ ProtoParser::ParseScorer(const proto::plan::ScoreFunction& function) {
 
     switch (function.type()) {
         case proto::plan::FunctionTypeWeight:
+            if (rescores::DecayScorer::IsDecay(function.params())) {
+                return std::make_shared<rescores::DecayScorer>(
+                    expr, function.weight(), function.params());
+            }
             return std::make_shared<rescores::WeightScorer>(expr,
                                                             function.weight());
         case proto::plan::FunctionTypeRandom:
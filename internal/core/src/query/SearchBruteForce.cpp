@@ -20,13 +20,48 @@
 #include "common/Utils.h"
 #include "common/Tracer.h"
 #include "common/Types.h"
+#include "index/Utils.h"
 #include "knowhere/comp/brute_force.h"
 #include "knowhere/comp/index_param.h"
 #include "knowhere/index/index_node.h"
 #include "log/Log.h"
+#include "query/Int8BruteForce.h"
+#include "query/MaxSim.h"
+#include "segcore/GrowingSparseInvertedIndex.h"
 
 namespace milvus::query {
 
+namespace {
+
+// grouping the rows by dim reads every row once, about what one query
+// scoring the rows one by one does; from this many queries on the posting
+// lists pay for themselves
+constexpr int64_t kSparsePostingsMinQueries = 8;
+
+// the queries share posting lists built from the rows, each one adds up the
+// lists of its own dims
+void
+SparsePostingsSearch(const dataset::SearchDataset& query_ds,
+                     const dataset::RawDataset& raw_ds,
+                     const segcore::SparseScorer& scorer,
+                     const BitsetView& bitset,
+                     SubSearchResult& sub_result) {
+    segcore::SparsePostings postings(
+        static_cast<const segcore::SparseRowType*>(raw_ds.raw_data),
+        raw_ds.num_raw_data);
+    auto queries =
+        static_cast<const segcore::SparseRowType*>(query_ds.query_data);
+    auto topk = query_ds.topk;
+    index::ParallelRun(query_ds.num_queries, [&](size_t q) {
+        segcore::SparseTopK found(topk);
+        postings.Search(queries[q], scorer, bitset, raw_ds.begin_id, found);
+        found.Dump(sub_result.get_offsets() + q * topk,
+                   sub_result.get_distances() + q * topk);
+    });
+}
+
+}  // namespace
+
 void
 CheckBruteForceSearchParam(const FieldMeta& field,
                            const SearchInfo& search_info) {
@@ -158,6 +193,9 @@ BruteForceSearch(const dataset::SearchDataset& query_ds,
     sub_result.mutable_offsets().resize(nq * topk);
     sub_result.mutable_distances().resize(nq * topk);
 
+    bool embedding_list = data_type == DataType::VECTOR_ARRAY &&
+                          raw_ds.raw_data_offsets != nullptr &&
+                          query_ds.query_offsets != nullptr;
     // For vector array (embedding list), element type is used to determine how to operate search.
     if (data_type == DataType::VECTOR_ARRAY) {
         AssertInfo(element_type != DataType::NONE,
@@ -175,6 +213,12 @@ BruteForceSearch(const dataset::SearchDataset& query_ds,
                                   search_cfg[RANGE_FILTER],
                                   search_info.metric_type_);
         }
+        // the chunks and segments searched before may have filled the topk
+        // with closer results
+        const auto& bound = search_info.range_search_bound_;
+        if (bound != nullptr && !bound->Tighten(topk, search_cfg)) {
+            return sub_result;
+        }
         knowhere::expected<knowhere::DataSetPtr> res;
         if (data_type == DataType::VECTOR_FLOAT) {
             res = knowhere::BruteForce::RangeSearch<float>(
@@ -214,9 +258,17 @@ BruteForceSearch(const dataset::SearchDataset& query_ds,
         std::copy_n(GetDatasetIDs(result), nq * topk, sub_result.get_offsets());
         std::copy_n(
             GetDatasetDistance(result), nq * topk, sub_result.get_distances());
+        if (bound != nullptr) {
+            bound->Update(
+                nq, topk, sub_result.get_ids(), sub_result.get_distances());
+        }
     } else {
         knowhere::Status stat;
-        if (data_type == DataType::VECTOR_FLOAT) {
+        if (embedding_list &&
+            MaxSimSupported(query_ds.metric_type, element_type)) {
+            MaxSimSearch(query_ds, raw_ds, element_type, bitset, sub_result);
+            stat = knowhere::Status::success;
+        } else if (data_type == DataType::VECTOR_FLOAT) {
             stat = knowhere::BruteForce::SearchWithBuf<float>(
                 base_dataset,
                 query_dataset,
@@ -253,14 +305,25 @@ BruteForceSearch(const dataset::SearchDataset& query_ds,
                 bitset,
                 op_context);
         } else if (data_type == DataType::VECTOR_SPARSE_U32_F32) {
-            stat = knowhere::BruteForce::SearchSparseWithBuf(
-                base_dataset,
-                query_dataset,
-                sub_result.mutable_offsets().data(),
-                sub_result.mutable_distances().data(),
-                search_cfg,
-                bitset,
-                op_context);
+            auto scorer = segcore::SparseScorer::Of(search_cfg);
+            if (scorer.has_value() && nq >= kSparsePostingsMinQueries) {
+                SparsePostingsSearch(
+                    query_ds, raw_ds, scorer.value(), bitset, sub_result);
+                stat = knowhere::Status::success;
+            } else {
+                stat = knowhere::BruteForce::SearchSparseWithBuf(
+                    base_dataset,
+                    query_dataset,
+                    sub_result.mutable_offsets().data(),
+                    sub_result.mutable_distances().data(),
+                    search_cfg,
+                    bitset,
+                    op_context);
+            }
+        } else if (data_type == DataType::VECTOR_INT8 &&
+                   Int8BruteForceSupported(query_ds.metric_type)) {
+            Int8BruteForceSearch(query_ds, raw_ds, bitset, sub_result);
+            stat = knowhere::Status::success;
         } else if (data_type == DataType::VECTOR_INT8) {
             stat = knowhere::BruteForce::SearchWithBuf<int8>(
                 base_dataset,
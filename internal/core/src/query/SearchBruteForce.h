@@ -24,6 +24,11 @@ void
 CheckBruteForceSearchParam(const FieldMeta& field,
                            const SearchInfo& search_info);
 
+// the knowhere config of a brute force search
+knowhere::Json
+PrepareBFSearchParams(const SearchInfo& search_info,
+                      const std::map<std::string, std::string>& index_info);
+
 SubSearchResult
 BruteForceSearch(const dataset::SearchDataset& query_ds,
                  const dataset::RawDataset& raw_ds,
@@ -15,7 +15,11 @@
 #include "common/Types.h"
 #include "common/Utils.h"
 #include "SearchOnGrowing.h"
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
+#include <memory>
 #include "knowhere/comp/index_param.h"
 #include "knowhere/config.h"
 #include "log/Log.h"
@@ -23,10 +27,75 @@
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnIndex.h"
 #include "query/Utils.h"
+#include "exec/QueryContext.h"
 #include "exec/operator/Utils.h"
 
 namespace milvus::query {
 
+namespace {
+
+// consecutive chunks smaller than this are copied into one buffer and
+// searched by one brute force call, which loads the queries once for all of
+// them and saves merging a result per chunk
+constexpr size_t kFusedSearchBytes = 4 << 20;
+
+// bytes of a row of a fixed width dense vector, 0 for the other types
+size_t
+DenseVectorRowBytes(DataType data_type, int64_t dim) {
+    switch (data_type) {
+        case DataType::VECTOR_FLOAT:
+            return GetVecRowSize<float>(dim);
+        case DataType::VECTOR_FLOAT16:
+            return GetVecRowSize<float16>(dim);
+        case DataType::VECTOR_BFLOAT16:
+            return GetVecRowSize<bfloat16>(dim);
+        case DataType::VECTOR_BINARY:
+            return GetVecRowSize<bin1>(dim);
+        case DataType::VECTOR_INT8:
+            return GetVecRowSize<int8>(dim);
+        default:
+            return 0;
+    }
+}
+
+// Runs the first query of a search sampled by the recall tuner at every
+// candidate nprobe, unfiltered, and records the recall of each against the
+// exhaustive probe of the index.
+void
+CalibrateNprobe(segcore::RecallTuner& tuner,
+                const index::VectorIndex& index,
+                const SearchInfo& search_conf,
+                dataset::SearchDataset search_dataset,
+                milvus::OpContext* op_context) {
+    search_dataset.num_queries = 1;
+    SearchInfo conf;
+    conf.topk_ = search_conf.topk_;
+    conf.round_decimal_ = search_conf.round_decimal_;
+    conf.field_id_ = search_conf.field_id_;
+    conf.metric_type_ = search_conf.metric_type_;
+    conf.search_params_ = search_conf.search_params_;
+    auto search = [&](int64_t nprobe) {
+        conf.search_params_[knowhere::indexparam::NPROBE] =
+            std::to_string(nprobe);
+        SearchResult result;
+        SearchOnIndex(
+            search_dataset, index, conf, BitsetView(), op_context, result);
+        return result.seg_offsets_;
+    };
+    const auto& candidates = tuner.Candidates();
+    auto exact = search(candidates.back());
+    for (size_t i = 0; i + 1 < candidates.size(); ++i) {
+        auto recall =
+            segcore::RecallTuner::Recall(exact, search(candidates[i]));
+        if (!recall.has_value()) {
+            return;
+        }
+        tuner.Observe(candidates[i], recall.value());
+    }
+}
+
+}  // namespace
+
 void
 FloatSegmentIndexSearch(const segcore::SegmentGrowingImpl& segment,
                         const SearchInfo& info,
@@ -68,6 +137,16 @@ FloatSegmentIndexSearch(const segcore::SegmentGrowingImpl& segment,
                       op_context,
                       search_result,
                       is_sparse);
+
+        // range searches have no topk recall
+        auto& tuner = field_indexing.get_recall_tuner();
+        if (!is_sparse &&
+            segcore::VecIndexConfig::GetRecallTarget(info).has_value() &&
+            !search_conf.search_params_.contains(RADIUS) &&
+            tuner.ShouldSample()) {
+            CalibrateNprobe(
+                tuner, *vec_index, search_conf, search_dataset, op_context);
+        }
     }
 }
 
@@ -99,6 +178,26 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
     auto metric_type = info.metric_type_;
     auto round_decimal = info.round_decimal_;
 
+    // without the avgdl of the collection BM25 takes the one the segment
+    // keeps up to date as rows arrive
+    auto sparse_index = segment.GetGrowingSparseInvertedIndex(vecfield_id);
+    if (sparse_index != nullptr && metric_type == knowhere::metric::BM25 &&
+        !info.search_params_.contains(knowhere::meta::BM25_AVGDL) &&
+        sparse_index->AvgRowLen() > 0) {
+        auto bm25_info = info;
+        bm25_info.search_params_[knowhere::meta::BM25_AVGDL] =
+            sparse_index->AvgRowLen();
+        return SearchOnGrowing(segment,
+                               bm25_info,
+                               query_data,
+                               query_offsets,
+                               num_queries,
+                               timestamp,
+                               bitset,
+                               op_context,
+                               search_result);
+    }
+
     // step 2: small indexing search
     if (segment.get_indexing_record().SyncDataWithIndex(field.get_id())) {
         AssertInfo(
@@ -209,8 +308,150 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
             embedding_search = true;
         }
 
+        // the full chunks are ranked on the SQ8 mirror and refined on the
+        // raw vectors, the brute force below covers the open chunk
+        auto mirror = segment.GetGrowingVectorMirror(vecfield_id);
+        if (mirror != nullptr && data_type == DataType::VECTOR_FLOAT &&
+            !offset_mapping.IsEnabled() && query_offsets == nullptr &&
+            !milvus::exec::UseVectorIterator(info) &&
+            !info.search_params_.contains(knowhere::meta::RADIUS) &&
+            segcore::GrowingVectorMirror::Supports(metric_type)) {
+            // only whole chunks, the brute force resumes at a chunk start
+            auto full_rows =
+                active_count / vec_size_per_chunk * vec_size_per_chunk;
+            auto mirrored_rows = std::min(mirror->MirroredRows(), full_rows);
+            if (mirrored_rows > 0) {
+                auto refine_ratio = std::max(
+                    1.0f,
+                    segcore::SegcoreConfig::default_config()
+                        .get_refine_ratio());
+                auto num_candidates =
+                    static_cast<int64_t>(std::ceil(topk * refine_ratio));
+                SubSearchResult sub_qr(
+                    num_queries, topk, metric_type, round_decimal);
+                mirror->Search(static_cast<const float*>(query_data),
+                               num_queries,
+                               topk,
+                               num_candidates,
+                               metric_type,
+                               search_bitset,
+                               mirrored_rows,
+                               sub_qr.get_offsets(),
+                               sub_qr.get_distances());
+                sub_qr.round_values();
+                final_qr.merge(sub_qr);
+                current_chunk_id = mirrored_rows / vec_size_per_chunk;
+            }
+        }
+
+        // the full chunks of a MinHash field are searched through the LSH
+        // buckets, the brute force below covers the open chunk
+        auto lsh = segment.GetGrowingMinHashLSH(vecfield_id);
+        if (lsh != nullptr && data_type == DataType::VECTOR_BINARY &&
+            IsMetricType(metric_type, knowhere::metric::MHJACCARD) &&
+            !offset_mapping.IsEnabled() && query_offsets == nullptr &&
+            !milvus::exec::UseVectorIterator(info) &&
+            !info.search_params_.contains(knowhere::meta::RADIUS)) {
+            auto full_rows =
+                active_count / vec_size_per_chunk * vec_size_per_chunk;
+            auto indexed_rows = std::min(lsh->IndexedRows(), full_rows);
+            if (indexed_rows > 0) {
+                SubSearchResult sub_qr(
+                    num_queries, topk, metric_type, round_decimal);
+                lsh->Search(static_cast<const uint8_t*>(query_data),
+                            num_queries,
+                            topk,
+                            search_bitset,
+                            indexed_rows,
+                            sub_qr.get_offsets(),
+                            sub_qr.get_distances());
+                sub_qr.round_values();
+                final_qr.merge(sub_qr);
+                current_chunk_id = indexed_rows / vec_size_per_chunk;
+            }
+        }
+
+        // the full chunks of an IP or BM25 sparse field are searched on its
+        // posting lists, the brute force below covers the open chunk
+        auto sparse_scorer =
+            sparse_index == nullptr
+                ? std::nullopt
+                : segcore::SparseScorer::Of(
+                      PrepareBFSearchParams(info, index_info));
+        if (sparse_scorer.has_value() &&
+            data_type == DataType::VECTOR_SPARSE_U32_F32 &&
+            !offset_mapping.IsEnabled() &&
+            !milvus::exec::UseVectorIterator(info) &&
+            !info.search_params_.contains(knowhere::meta::RADIUS)) {
+            auto full_rows =
+                active_count / vec_size_per_chunk * vec_size_per_chunk;
+            auto indexed_rows =
+                std::min(sparse_index->IndexedRows(), full_rows);
+            if (indexed_rows > 0) {
+                SubSearchResult sub_qr(
+                    num_queries, topk, metric_type, round_decimal);
+                sparse_index->Search(
+                    static_cast<const segcore::SparseRowType*>(query_data),
+                    num_queries,
+                    topk,
+                    sparse_scorer.value(),
+                    search_bitset,
+                    indexed_rows,
+                    sub_qr.get_offsets(),
+                    sub_qr.get_distances());
+                sub_qr.round_values();
+                final_qr.merge(sub_qr);
+                current_chunk_id = indexed_rows / vec_size_per_chunk;
+            }
+        }
+
+        auto row_bytes = DenseVectorRowBytes(data_type, dim);
+        int64_t chunks_per_search = 1;
+        if (row_bytes > 0 && !milvus::exec::UseVectorIterator(info)) {
+            chunks_per_search = std::max<int64_t>(
+                1, kFusedSearchBytes / (vec_size_per_chunk * row_bytes));
+        }
+        std::unique_ptr<uint8_t[]> fused_buf;
+
         for (int chunk_id = current_chunk_id; chunk_id < max_chunk;
              ++chunk_id) {
+            milvus::exec::checkCancellation(op_context);
+            auto fused_end =
+                std::min<int64_t>(chunk_id + chunks_per_search, max_chunk);
+            if (fused_end - chunk_id > 1) {
+                auto row_begin = chunk_id * vec_size_per_chunk;
+                auto row_end =
+                    std::min(active_count, fused_end * vec_size_per_chunk);
+                if (fused_buf == nullptr) {
+                    fused_buf = std::make_unique<uint8_t[]>(
+                        chunks_per_search * vec_size_per_chunk * row_bytes);
+                }
+                auto dst = fused_buf.get();
+                for (auto id = chunk_id; id < fused_end; ++id) {
+                    auto rows =
+                        std::min(active_count, (id + 1) * vec_size_per_chunk) -
+                        id * vec_size_per_chunk;
+                    memcpy(dst,
+                           vec_ptr->get_chunk_data(id),
+                           rows * row_bytes);
+                    dst += rows * row_bytes;
+                }
+                // the loop steps on to fused_end
+                chunk_id = fused_end - 1;
+                query::dataset::RawDataset fused_data{
+                    row_begin, dim, row_end - row_begin, fused_buf.get()};
+                auto sub_qr = BruteForceSearch(search_dataset,
+                                               fused_data,
+                                               info,
+                                               index_info,
+                                               search_bitset,
+                                               data_type,
+                                               element_type,
+                                               op_context);
+                final_qr.merge(sub_qr);
+                continue;
+            }
+
             auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
 
             auto row_begin = chunk_id * vec_size_per_chunk;
@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <string>
 
 #include "bitset/detail/element_wise.h"
@@ -25,7 +26,9 @@
 #include "query/SearchOnSealed.h"
 #include "query/Utils.h"
 #include "query/helper.h"
+#include "exec/QueryContext.h"
 #include "exec/operator/Utils.h"
+#include "index/Utils.h"
 
 namespace milvus::query {
 
@@ -125,19 +128,11 @@ SearchOnSealedIndex(const Schema& schema,
                 std::move(search_result.seg_offsets_);
             search_result.seg_offsets_.resize(element_ids.size());
             search_result.element_indices_.resize(element_ids.size());
-
-            for (size_t i = 0; i < element_ids.size(); i++) {
-                if (element_ids[i] == INVALID_SEG_OFFSET) {
-                    search_result.seg_offsets_[i] = INVALID_SEG_OFFSET;
-                    search_result.element_indices_[i] = -1;
-                } else {
-                    auto [doc_id, elem_index] =
-                        search_info.array_offsets_->ElementIDToRowID(
-                            element_ids[i]);
-                    search_result.seg_offsets_[i] = doc_id;
-                    search_result.element_indices_[i] = elem_index;
-                }
-            }
+            search_info.array_offsets_->ElementIDsToRowIDs(
+                element_ids.data(),
+                element_ids.size(),
+                search_result.seg_offsets_.data(),
+                search_result.element_indices_.data());
             search_result.element_level_ = true;
         }
     }
@@ -228,12 +223,10 @@ SearchOnSealedColumn(const Schema& schema,
         data_type = element_type;
     }
 
-    auto offset = 0;
-    auto vector_chunks = column->GetAllChunks(op_context);
+    // the rows, or the elements for element-level search, before each chunk
     const auto& valid_count_per_chunk = column->GetValidCountPerChunk();
+    std::vector<int64_t> chunk_begins(num_chunk + 1, 0);
     for (int i = 0; i < num_chunk; ++i) {
-        auto pw = vector_chunks[i];
-        auto vec_data = pw.get()->Data();
         auto chunk_size = column->chunk_row_nums(i);
         if (offset_mapping.IsEnabled() && !valid_count_per_chunk.empty()) {
             chunk_size = valid_count_per_chunk[i];
@@ -245,9 +238,17 @@ SearchOnSealedColumn(const Schema& schema,
             // offsets[row_count] gives total element count in this chunk
             chunk_size = elem_offsets_pw.get()[chunk_size];
         }
+        chunk_begins[i + 1] = chunk_begins[i] + chunk_size;
+    }
 
+    auto search_chunk = [&](int64_t i, SubSearchResult& qr) {
+        milvus::exec::checkCancellation(op_context);
+        auto pw = column->GetChunk(op_context, i);
         auto raw_dataset =
-            query::dataset::RawDataset{offset, dim, chunk_size, vec_data};
+            query::dataset::RawDataset{chunk_begins[i],
+                                       dim,
+                                       chunk_begins[i + 1] - chunk_begins[i],
+                                       pw.get()->Data()};
 
         PinWrapper<const size_t*> offsets_pw;
         if (data_type == DataType::VECTOR_ARRAY) {
@@ -270,7 +271,7 @@ SearchOnSealedColumn(const Schema& schema,
                                                            index_info,
                                                            search_bitview,
                                                            data_type);
-            final_qr.merge(sub_qr);
+            qr.merge(sub_qr);
         } else {
             auto sub_qr = BruteForceSearch(query_dataset,
                                            raw_dataset,
@@ -280,9 +281,42 @@ SearchOnSealedColumn(const Schema& schema,
                                            data_type,
                                            element_type,
                                            op_context);
-            final_qr.merge(sub_qr);
+            qr.merge(sub_qr);
+        }
+    };
+
+    if (milvus::exec::UseVectorIterator(search_info)) {
+        // the iterators are kept in chunk order
+        for (int i = 0; i < num_chunk; ++i) {
+            search_chunk(i, final_qr);
+        }
+    } else {
+        // the chunks not cached yet load while the cached ones are searched
+        std::vector<int64_t> chunk_ids(num_chunk);
+        std::iota(chunk_ids.begin(), chunk_ids.end(), 0);
+        auto prefetch = column->PrefetchChunksAsync(op_context, chunk_ids);
+
+        // every task searches a run of chunks into its own result
+        auto num_tasks = std::min<int64_t>(num_chunk, index::ParallelWorkers());
+        std::vector<SubSearchResult> task_qrs;
+        task_qrs.reserve(num_tasks);
+        for (int64_t t = 0; t < num_tasks; ++t) {
+            task_qrs.emplace_back(num_queries,
+                                  search_info.topk_,
+                                  search_info.metric_type_,
+                                  search_info.round_decimal_);
+        }
+        index::ParallelRun(num_tasks, [&](size_t t) {
+            auto task = static_cast<int64_t>(t);
+            auto end = num_chunk * (task + 1) / num_tasks;
+            for (auto i = num_chunk * task / num_tasks; i < end; ++i) {
+                search_chunk(i, task_qrs[task]);
+            }
+        });
+        std::move(prefetch).get();
+        for (auto& task_qr : task_qrs) {
+            final_qr.merge(task_qr);
         }
-        offset += chunk_size;
     }
     if (milvus::exec::UseVectorIterator(search_info)) {
         bool larger_is_closer = PositivelyRelated(search_info.metric_type_);
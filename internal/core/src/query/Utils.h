@@ -13,6 +13,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "common/BitsetView.h"
 #include "common/OffsetMapping.h"
@@ -23,15 +24,13 @@ namespace milvus::query {
 inline TargetBitmap
 TransformBitset(const BitsetView& bitset,
                 const milvus::OffsetMapping& mapping) {
-    TargetBitmap result;
-    auto count = mapping.GetValidCount();
-    result.resize(count);
-    for (int64_t physical_idx = 0; physical_idx < count; physical_idx++) {
-        auto logical_idx = mapping.GetLogicalOffset(physical_idx);
-        if (logical_idx >= 0 &&
-            logical_idx < static_cast<int64_t>(bitset.size())) {
-            result[physical_idx] = bitset.test(logical_idx);
-        }
+    TargetBitmap result(mapping.GetValidCount(), false);
+    if (!bitset.empty()) {
+        mapping.CompressLogicalToPhysical(
+            bitset.data(),
+            bitset.size(),
+            reinterpret_cast<uint8_t*>(result.data()),
+            result.size());
     }
     return result;
 }
@@ -39,9 +38,12 @@ TransformBitset(const BitsetView& bitset,
 inline void
 TransformOffset(std::vector<int64_t>& seg_offsets,
                 const milvus::OffsetMapping& mapping) {
-    for (auto& seg_offset : seg_offsets) {
-        if (seg_offset >= 0) {
-            seg_offset = mapping.GetLogicalOffset(seg_offset);
+    std::vector<int64_t> logical_offsets(seg_offsets.size());
+    mapping.GetLogicalOffsets(
+        seg_offsets.data(), seg_offsets.size(), logical_offsets.data());
+    for (size_t i = 0; i < seg_offsets.size(); ++i) {
+        if (seg_offsets[i] >= 0) {
+            seg_offsets[i] = logical_offsets[i];
         }
     }
 }
@@ -17,6 +17,7 @@
 #ifndef _MURMURHASH3_H_
 #define _MURMURHASH3_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -37,6 +38,12 @@ MurmurHash3_x64_128(const void* key, int len, uint32_t seed, void* out);
 uint64_t
 MurmurHash3_x64_64_Special(const uint64_t key, const uint64_t seed);
 
+void
+MurmurHash3_x64_64_Special_Batch(const uint64_t* keys,
+                                 size_t n,
+                                 const uint64_t seed,
+                                 uint64_t* out);
+
 //-----------------------------------------------------------------------------
 
 #ifdef __cplusplus
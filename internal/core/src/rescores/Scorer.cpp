@@ -14,9 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <map>
 #include <optional>
 #include <random>
+#include <string>
 #include "common/Types.h"
 #include "expr/ITypeExpr.h"
 #include "Scorer.h"
@@ -26,64 +30,141 @@
 
 namespace milvus::rescores {
 
-void
-WeightScorer::batch_score(milvus::OpContext* op_ctx,
-                          const segcore::SegmentInternalInterface* segment,
-                          const proto::plan::FunctionMode& mode,
-                          const FixedVector<int32_t>& offsets,
-                          const TargetBitmapView& bitmap,
-                          std::vector<std::optional<float>>& boost_scores) {
+namespace {
+
+// mask[i] = filter result of offsets[i], from a bitmap aligned with offsets
+FixedVector<uint8_t>
+MaskOf(const FixedVector<int32_t>& offsets, const TargetBitmapView& bitmap) {
     Assert(bitmap.size() == offsets.size());
-    for (auto i = 0; i < offsets.size(); i++) {
-        if (bitmap[i] > 0) {
-            set_score(boost_scores[i], mode);
-        }
+    FixedVector<uint8_t> mask(offsets.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        mask[i] = bitmap[i];
     }
+    return mask;
 }
 
-void
-WeightScorer::batch_score(milvus::OpContext* op_ctx,
-                          const segcore::SegmentInternalInterface* segment,
-                          const proto::plan::FunctionMode& mode,
-                          const FixedVector<int32_t>& offsets,
-                          const TargetBitmap& bitmap,
-                          std::vector<std::optional<float>>& boost_scores) {
+// mask[i] = filter result of offsets[i], from a bitmap over the segment
+FixedVector<uint8_t>
+MaskOf(const FixedVector<int32_t>& offsets, const TargetBitmap& bitmap) {
     auto bitmap_size = bitmap.size();
-    for (auto i = 0; i < offsets.size(); i++) {
+    FixedVector<uint8_t> mask(offsets.size(), 0);
+    for (size_t i = 0; i < offsets.size(); i++) {
         auto offset = offsets[i];
         // Bounds check: offset must be within bitmap size.
         // Race condition: text index may lag behind vector index,
         // causing offsets to reference rows not yet in text index.
+        // If offset is out of bounds, treat as "no match" (don't apply boost)
         if (offset >= 0 && static_cast<size_t>(offset) < bitmap_size) {
-            if (bitmap[offset] > 0) {
-                set_score(boost_scores[i], mode);
+            mask[i] = bitmap[offset];
+        }
+    }
+    return mask;
+}
+
+// merges value_of(i) into the score of offset i where mask[i]. Scores start
+// at the identity of the mode, so both loops are a branch free masked
+// multiply or add that vectorizes.
+template <typename ValueOf>
+void
+MergeMasked(const proto::plan::FunctionMode& mode,
+            const FixedVector<uint8_t>& mask,
+            ValueOf value_of,
+            BoostScores& boost_scores) {
+    auto size = mask.size();
+    auto scores = boost_scores.scores.data();
+    switch (mode) {
+        case proto::plan::FunctionModeMultiply:
+            for (size_t i = 0; i < size; i++) {
+                scores[i] *= mask[i] ? value_of(i) : 1.0f;
             }
+            break;
+        case proto::plan::FunctionModeSum:
+            for (size_t i = 0; i < size; i++) {
+                scores[i] += mask[i] ? value_of(i) : 0.0f;
+            }
+            break;
+        default:
+            ThrowInfo(ErrorCode::UnexpectedError,
+                      fmt::format("unknown boost function mode: {}:{}",
+                                  proto::plan::FunctionMode_Name(mode),
+                                  mode));
+    }
+    for (size_t i = 0; i < size; i++) {
+        if (mask[i]) {
+            boost_scores.valid.set(i);
         }
-        // If offset is out of bounds, treat as "no match" (don't apply boost)
     }
-};
+}
+
+double
+ParseDouble(const std::map<std::string, std::string>& param_map,
+            const std::string& key,
+            std::optional<double> default_value = std::nullopt) {
+    auto it = param_map.find(key);
+    if (it == param_map.end()) {
+        AssertInfo(default_value.has_value(),
+                   "decay function param {} is required",
+                   key);
+        return default_value.value();
+    }
+    try {
+        return std::stod(it->second);
+    } catch (const std::exception& e) {
+        ThrowInfo(ErrorCode::InvalidParameter,
+                  "parse decay function param {} failed: {}",
+                  key,
+                  e.what());
+    }
+}
+
+}  // namespace
+
+BoostScores::BoostScores(size_t size, const proto::plan::FunctionMode& mode)
+    : scores(size,
+             mode == proto::plan::FunctionModeMultiply ? 1.0f : 0.0f),
+      valid(size) {
+}
 
 void
 WeightScorer::batch_score(milvus::OpContext* op_ctx,
                           const segcore::SegmentInternalInterface* segment,
                           const proto::plan::FunctionMode& mode,
                           const FixedVector<int32_t>& offsets,
-                          std::vector<std::optional<float>>& boost_scores) {
-    for (auto i = 0; i < offsets.size(); i++) {
-        set_score(boost_scores[i], mode);
-    }
+                          const TargetBitmapView& bitmap,
+                          BoostScores& boost_scores) {
+    MergeMasked(
+        mode,
+        MaskOf(offsets, bitmap),
+        [this](size_t) { return weight_; },
+        boost_scores);
+}
+
+void
+WeightScorer::batch_score(milvus::OpContext* op_ctx,
+                          const segcore::SegmentInternalInterface* segment,
+                          const proto::plan::FunctionMode& mode,
+                          const FixedVector<int32_t>& offsets,
+                          const TargetBitmap& bitmap,
+                          BoostScores& boost_scores) {
+    MergeMasked(
+        mode,
+        MaskOf(offsets, bitmap),
+        [this](size_t) { return weight_; },
+        boost_scores);
 };
 
 void
-WeightScorer::set_score(std::optional<float>& score,
-                        const proto::plan::FunctionMode& mode) {
-    if (!score.has_value()) {
-        score = std::make_optional(weight_);
-    } else {
-        score = std::make_optional(
-            function_score_merge(score.value(), weight_, mode));
-    }
-}
+WeightScorer::batch_score(milvus::OpContext* op_ctx,
+                          const segcore::SegmentInternalInterface* segment,
+                          const proto::plan::FunctionMode& mode,
+                          const FixedVector<int32_t>& offsets,
+                          BoostScores& boost_scores) {
+    MergeMasked(
+        mode,
+        FixedVector<uint8_t>(offsets.size(), 1),
+        [this](size_t) { return weight_; },
+        boost_scores);
+};
 
 void
 RandomScorer::batch_score(milvus::OpContext* op_ctx,
@@ -91,26 +172,9 @@ RandomScorer::batch_score(milvus::OpContext* op_ctx,
                           const proto::plan::FunctionMode& mode,
                           const FixedVector<int32_t>& offsets,
                           const TargetBitmapView& bitmap,
-                          std::vector<std::optional<float>>& boost_scores) {
-    Assert(bitmap.size() == offsets.size());
-    FixedVector<int64_t> target_offsets;
-    FixedVector<int> idx;
-    target_offsets.reserve(offsets.size());
-    idx.reserve(offsets.size());
-
-    for (auto i = 0; i < offsets.size(); i++) {
-        if (bitmap[i] > 0) {
-            target_offsets.push_back(static_cast<int64_t>(offsets[i]));
-            idx.push_back(i);
-        }
-    }
-
-    // skip if empty
-    if (target_offsets.empty()) {
-        return;
-    }
-
-    random_score(op_ctx, segment, mode, target_offsets, &idx, boost_scores);
+                          BoostScores& boost_scores) {
+    random_score(
+        op_ctx, segment, mode, offsets, MaskOf(offsets, bitmap), boost_scores);
 }
 
 void
@@ -119,25 +183,9 @@ RandomScorer::batch_score(milvus::OpContext* op_ctx,
                           const proto::plan::FunctionMode& mode,
                           const FixedVector<int32_t>& offsets,
                           const TargetBitmap& bitmap,
-                          std::vector<std::optional<float>>& boost_scores) {
-    FixedVector<int64_t> target_offsets;
-    FixedVector<int> idx;
-    target_offsets.reserve(offsets.size());
-    idx.reserve(offsets.size());
-
-    for (auto i = 0; i < offsets.size(); i++) {
-        if (bitmap[offsets[i]] > 0) {
-            target_offsets.push_back(static_cast<int64_t>(offsets[i]));
-            idx.push_back(i);
-        }
-    }
-
-    // skip if empty
-    if (target_offsets.empty()) {
-        return;
-    }
-
-    random_score(op_ctx, segment, mode, target_offsets, &idx, boost_scores);
+                          BoostScores& boost_scores) {
+    random_score(
+        op_ctx, segment, mode, offsets, MaskOf(offsets, bitmap), boost_scores);
 }
 
 void
@@ -145,25 +193,40 @@ RandomScorer::batch_score(milvus::OpContext* op_ctx,
                           const segcore::SegmentInternalInterface* segment,
                           const proto::plan::FunctionMode& mode,
                           const FixedVector<int32_t>& offsets,
-                          std::vector<std::optional<float>>& boost_scores) {
-    FixedVector<int64_t> target_offsets;
-    target_offsets.reserve(offsets.size());
-
-    for (int offset : offsets) {
-        target_offsets.push_back(static_cast<int64_t>(offset));
-    }
-
-    random_score(op_ctx, segment, mode, target_offsets, nullptr, boost_scores);
+                          BoostScores& boost_scores) {
+    random_score(op_ctx,
+                 segment,
+                 mode,
+                 offsets,
+                 FixedVector<uint8_t>(offsets.size(), 1),
+                 boost_scores);
 }
 
 void
 RandomScorer::random_score(milvus::OpContext* op_ctx,
                            const segcore::SegmentInternalInterface* segment,
                            const proto::plan::FunctionMode& mode,
-                           const FixedVector<int64_t>& target_offsets,
-                           const FixedVector<int>* idx,
-                           std::vector<std::optional<float>>& boost_scores) {
+                           const FixedVector<int32_t>& offsets,
+                           const FixedVector<uint8_t>& mask,
+                           BoostScores& boost_scores) {
+    // hash keys of all offsets, the unmatched ones are hashed and dropped
+    FixedVector<uint64_t> keys(offsets.size(), 0);
     if (field_.get() != -1) {
+        FixedVector<int64_t> target_offsets;
+        FixedVector<int> idx;
+        target_offsets.reserve(offsets.size());
+        idx.reserve(offsets.size());
+        for (size_t i = 0; i < offsets.size(); i++) {
+            if (mask[i]) {
+                target_offsets.push_back(static_cast<int64_t>(offsets[i]));
+                idx.push_back(i);
+            }
+        }
+        // skip if empty
+        if (target_offsets.empty()) {
+            return;
+        }
+
         auto array = segment->bulk_subscript(
             op_ctx, field_, target_offsets.data(), target_offsets.size());
         AssertInfo(array->has_scalars(), "seed field must be scalar");
@@ -171,40 +234,201 @@ RandomScorer::random_score(milvus::OpContext* op_ctx,
                    "now only support int64 field as seed");
         // TODO: Support varchar and int32 field as random field.
 
-        auto data = array->scalars().long_data();
+        const auto& data = array->scalars().long_data();
         for (int i = 0; i < data.data_size(); i++) {
-            auto a = data.data()[i];
-            auto random_score =
-                hash_to_double(MurmurHash3_x64_64_Special(a, seed_));
-            if (idx == nullptr) {
-                set_score(random_score, boost_scores[i], mode);
-            } else {
-                set_score(random_score, boost_scores[idx->at(i)], mode);
-            }
+            keys[idx[i]] = static_cast<uint64_t>(data.data()[i]);
         }
     } else {
         // if not set field, use offset and seed to hash.
-        for (int i = 0; i < target_offsets.size(); i++) {
-            double random_score = hash_to_double(MurmurHash3_x64_64_Special(
-                target_offsets[i] + segment->get_segment_id(), seed_));
-            if (idx == nullptr) {
-                set_score(random_score, boost_scores[i], mode);
-            } else {
-                set_score(random_score, boost_scores[idx->at(i)], mode);
-            }
+        auto segment_id = segment->get_segment_id();
+        for (size_t i = 0; i < offsets.size(); i++) {
+            keys[i] = static_cast<uint64_t>(offsets[i] + segment_id);
+        }
+    }
+
+    FixedVector<uint64_t> hashes(offsets.size());
+    MurmurHash3_x64_64_Special_Batch(
+        keys.data(), keys.size(), seed_, hashes.data());
+    MergeMasked(
+        mode,
+        mask,
+        [&](size_t i) {
+            return static_cast<float>(hash_to_double(hashes[i])) * weight_;
+        },
+        boost_scores);
+}
+
+DecayScorer::DecayScorer(expr::TypedExprPtr& filter,
+                         float weight,
+                         const ProtoParams& params)
+    : filter_(filter), weight_(weight) {
+    auto param_map = RepeatedKeyValToMap(params);
+    auto function = param_map["function"];
+    if (function == "gauss") {
+        function_ = Function::Gauss;
+    } else if (function == "exp") {
+        function_ = Function::Exp;
+    } else if (function == "linear") {
+        function_ = Function::Linear;
+    } else {
+        ThrowInfo(ErrorCode::InvalidParameter,
+                  "unknown decay function: {}",
+                  function);
+    }
+
+    auto it = param_map.find("field_id");
+    AssertInfo(it != param_map.end(), "decay function needs a field");
+    try {
+        field_ = FieldId(std::stoll(it->second));
+    } catch (const std::exception& e) {
+        ThrowInfo(ErrorCode::InvalidParameter,
+                  "parse decay function field ID failed: {}",
+                  e.what());
+    }
+    origin_ = ParseDouble(param_map, "origin");
+    scale_ = ParseDouble(param_map, "scale");
+    offset_ = ParseDouble(param_map, "offset", offset_);
+    decay_ = ParseDouble(param_map, "decay", decay_);
+    if (!(scale_ > 0) || !(offset_ >= 0) || !(decay_ > 0 && decay_ < 1)) {
+        ThrowInfo(ErrorCode::InvalidParameter,
+                  "invalid decay function params, scale: {}, offset: {}, "
+                  "decay: {}",
+                  scale_,
+                  offset_,
+                  decay_);
+    }
+}
+
+bool
+DecayScorer::IsDecay(const ProtoParams& params) {
+    for (const auto& param : params) {
+        if (param.key() == "function") {
+            return true;
         }
     }
+    return false;
+}
+
+double
+DecayScorer::Decay(Function function,
+                   double value,
+                   double origin,
+                   double scale,
+                   double offset,
+                   double decay) {
+    auto distance = std::max(0.0, std::abs(value - origin) - offset);
+    switch (function) {
+        case Function::Gauss:
+            return std::exp(std::log(decay) * distance * distance /
+                            (scale * scale));
+        case Function::Exp:
+            return std::exp(std::log(decay) * distance / scale);
+        case Function::Linear: {
+            auto zero_at = scale / (1 - decay);
+            return std::max(0.0, (zero_at - distance) / zero_at);
+        }
+        default:
+            ThrowInfo(ErrorCode::UnexpectedError, "unknown decay function");
+    }
+}
+
+void
+DecayScorer::batch_score(milvus::OpContext* op_ctx,
+                         const segcore::SegmentInternalInterface* segment,
+                         const proto::plan::FunctionMode& mode,
+                         const FixedVector<int32_t>& offsets,
+                         const TargetBitmapView& bitmap,
+                         BoostScores& boost_scores) {
+    decay_score(
+        op_ctx, segment, mode, offsets, MaskOf(offsets, bitmap), boost_scores);
+}
+
+void
+DecayScorer::batch_score(milvus::OpContext* op_ctx,
+                         const segcore::SegmentInternalInterface* segment,
+                         const proto::plan::FunctionMode& mode,
+                         const FixedVector<int32_t>& offsets,
+                         const TargetBitmap& bitmap,
+                         BoostScores& boost_scores) {
+    decay_score(
+        op_ctx, segment, mode, offsets, MaskOf(offsets, bitmap), boost_scores);
+}
+
+void
+DecayScorer::batch_score(milvus::OpContext* op_ctx,
+                         const segcore::SegmentInternalInterface* segment,
+                         const proto::plan::FunctionMode& mode,
+                         const FixedVector<int32_t>& offsets,
+                         BoostScores& boost_scores) {
+    decay_score(op_ctx,
+                segment,
+                mode,
+                offsets,
+                FixedVector<uint8_t>(offsets.size(), 1),
+                boost_scores);
 }
 
 void
-RandomScorer::set_score(float random_value,
-                        std::optional<float>& score,
-                        const proto::plan::FunctionMode& mode) {
-    if (!score.has_value()) {
-        score = std::make_optional(random_value * weight_);
+DecayScorer::decay_score(milvus::OpContext* op_ctx,
+                         const segcore::SegmentInternalInterface* segment,
+                         const proto::plan::FunctionMode& mode,
+                         const FixedVector<int32_t>& offsets,
+                         const FixedVector<uint8_t>& mask,
+                         BoostScores& boost_scores) {
+    FixedVector<int64_t> target_offsets;
+    FixedVector<int> idx;
+    target_offsets.reserve(offsets.size());
+    idx.reserve(offsets.size());
+    for (size_t i = 0; i < offsets.size(); i++) {
+        if (mask[i]) {
+            target_offsets.push_back(static_cast<int64_t>(offsets[i]));
+            idx.push_back(i);
+        }
+    }
+    // skip if empty
+    if (target_offsets.empty()) {
+        return;
+    }
+
+    auto array = segment->bulk_subscript(
+        op_ctx, field_, target_offsets.data(), target_offsets.size());
+    AssertInfo(array->has_scalars(), "decay field must be scalar");
+    const auto& scalars = array->scalars();
+    FixedVector<double> values(target_offsets.size());
+    auto copy_values = [&](const auto& data) {
+        AssertInfo(data.data_size() == static_cast<int>(values.size()),
+                   "decay field returned {} values for {} offsets",
+                   data.data_size(),
+                   values.size());
+        std::copy(data.data().begin(), data.data().end(), values.begin());
+    };
+    if (scalars.has_int_data()) {
+        copy_values(scalars.int_data());
+    } else if (scalars.has_long_data()) {
+        copy_values(scalars.long_data());
+    } else if (scalars.has_float_data()) {
+        copy_values(scalars.float_data());
+    } else if (scalars.has_double_data()) {
+        copy_values(scalars.double_data());
     } else {
-        score = std::make_optional(function_score_merge(
-            score.value(), (random_value * weight_), mode));
+        ThrowInfo(ErrorCode::InvalidParameter,
+                  "decay function only supports numeric fields");
+    }
+
+    // null values get no boost
+    auto matched = mask;
+    FixedVector<float> boosts(offsets.size(), 0.0f);
+    const auto& valid_data = array->valid_data();
+    for (size_t j = 0; j < values.size(); j++) {
+        if (!valid_data.empty() && !valid_data[j]) {
+            matched[idx[j]] = 0;
+            continue;
+        }
+        boosts[idx[j]] = static_cast<float>(
+            Decay(function_, values[j], origin_, scale_, offset_, decay_) *
+            weight_);
     }
+    MergeMasked(
+        mode, matched, [&](size_t i) { return boosts[i]; }, boost_scores);
 }
 }  // namespace milvus::rescores
\ No newline at end of file
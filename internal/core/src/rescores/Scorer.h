@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <exception>
+#include <utility>
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "expr/ITypeExpr.h"
@@ -26,6 +28,17 @@
 #include "common/protobuf_utils.h"
 
 namespace milvus::rescores {
+
+// Boost scores of the rescored offsets, columnar: scores[i] counts only if
+// valid[i], an offset no scorer matched keeps the identity of the function
+// mode, so a scorer merges into every matched offset the same way.
+struct BoostScores {
+    BoostScores(size_t size, const proto::plan::FunctionMode& mode);
+
+    FixedVector<float> scores;
+    TargetBitmap valid;
+};
+
 class Scorer {
  public:
     virtual ~Scorer() = default;
@@ -41,7 +54,7 @@ class Scorer {
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
                 const TargetBitmapView& bitmap,
-                std::vector<std::optional<float>>& boost_scores) = 0;
+                BoostScores& boost_scores) = 0;
 
     // score by bitmap
     // filter result of offset[i] was bitmap[offset[i]]
@@ -52,7 +65,7 @@ class Scorer {
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
                 const TargetBitmap& bitmap,
-                std::vector<std::optional<float>>& boost_scores) = 0;
+                BoostScores& boost_scores) = 0;
 
     // score for all offset
     // used when no filter
@@ -61,10 +74,15 @@ class Scorer {
                 const segcore::SegmentInternalInterface* segment,
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
-                std::vector<std::optional<float>>& boost_scores) = 0;
+                BoostScores& boost_scores) = 0;
 
     virtual float
     weight() = 0;
+
+    // [min, max] of the value merged into a matched offset, what bounds the
+    // final score of an offset before it is rescored
+    virtual std::pair<float, float>
+    score_range() = 0;
 };
 
 class WeightScorer : public Scorer {
@@ -83,7 +101,7 @@ class WeightScorer : public Scorer {
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
                 const TargetBitmapView& bitmap,
-                std::vector<std::optional<float>>& boost_scores) override;
+                BoostScores& boost_scores) override;
 
     void
     batch_score(milvus::OpContext* op_ctx,
@@ -91,25 +109,26 @@ class WeightScorer : public Scorer {
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
                 const TargetBitmap& bitmap,
-                std::vector<std::optional<float>>& boost_scores) override;
+                BoostScores& boost_scores) override;
 
     void
     batch_score(milvus::OpContext* op_ctx,
                 const segcore::SegmentInternalInterface* segment,
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
-                std::vector<std::optional<float>>& boost_scores) override;
+                BoostScores& boost_scores) override;
 
     float
     weight() override {
         return weight_;
     }
 
- private:
-    void
-    set_score(std::optional<float>& old_score,
-              const proto::plan::FunctionMode& mode);
+    std::pair<float, float>
+    score_range() override {
+        return {weight_, weight_};
+    }
 
+ private:
     expr::TypedExprPtr filter_;
     float weight_;
 };
@@ -157,7 +176,7 @@ class RandomScorer : public Scorer {
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
                 const TargetBitmapView& bitmap,
-                std::vector<std::optional<float>>& boost_scores) override;
+                BoostScores& boost_scores) override;
 
     void
     batch_score(milvus::OpContext* op_ctx,
@@ -165,37 +184,122 @@ class RandomScorer : public Scorer {
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
                 const TargetBitmap& bitmap,
-                std::vector<std::optional<float>>& boost_scores) override;
+                BoostScores& boost_scores) override;
 
     void
     batch_score(milvus::OpContext* op_ctx,
                 const segcore::SegmentInternalInterface* segment,
                 const proto::plan::FunctionMode& mode,
                 const FixedVector<int32_t>& offsets,
-                std::vector<std::optional<float>>& boost_scores) override;
+                BoostScores& boost_scores) override;
 
     float
     weight() override {
         return weight_;
     }
 
- private:
-    void
-    set_score(float random_value,
-              std::optional<float>& old_score,
-              const proto::plan::FunctionMode& mode);
+    // random values are in [0, 1)
+    std::pair<float, float>
+    score_range() override {
+        return {std::min(0.0f, weight_), std::max(0.0f, weight_)};
+    }
 
+ private:
+    // merges random_value * weight into boost_scores where mask[i]
     void
     random_score(milvus::OpContext* op_ctx,
                  const segcore::SegmentInternalInterface* segment,
                  const proto::plan::FunctionMode& mode,
-                 const FixedVector<int64_t>& target_offsets,
-                 const FixedVector<int>* idx,
-                 std::vector<std::optional<float>>& boost_scores);
+                 const FixedVector<int32_t>& offsets,
+                 const FixedVector<uint8_t>& mask,
+                 BoostScores& boost_scores);
 
     expr::TypedExprPtr filter_;
     float weight_;
     int64_t seed_;
     FieldId field_;
 };
+
+// Decays the boost with the distance of a numeric field from an origin, as
+// gauss, exp or linear: 1 within offset of the origin, decay at scale past
+// it. Picked for a weight function whose params name a decay function.
+class DecayScorer : public Scorer {
+ public:
+    enum class Function { Gauss, Exp, Linear };
+
+    DecayScorer(expr::TypedExprPtr& filter,
+                float weight,
+                const ProtoParams& params);
+
+    // whether a weight function's params ask for a decay
+    static bool
+    IsDecay(const ProtoParams& params);
+
+    // the decay of a value, computed like batch_score does
+    static double
+    Decay(Function function,
+          double value,
+          double origin,
+          double scale,
+          double offset,
+          double decay);
+
+    expr::TypedExprPtr
+    filter() override {
+        return filter_;
+    }
+
+    void
+    batch_score(milvus::OpContext* op_ctx,
+                const segcore::SegmentInternalInterface* segment,
+                const proto::plan::FunctionMode& mode,
+                const FixedVector<int32_t>& offsets,
+                const TargetBitmapView& bitmap,
+                BoostScores& boost_scores) override;
+
+    void
+    batch_score(milvus::OpContext* op_ctx,
+                const segcore::SegmentInternalInterface* segment,
+                const proto::plan::FunctionMode& mode,
+                const FixedVector<int32_t>& offsets,
+                const TargetBitmap& bitmap,
+                BoostScores& boost_scores) override;
+
+    void
+    batch_score(milvus::OpContext* op_ctx,
+                const segcore::SegmentInternalInterface* segment,
+                const proto::plan::FunctionMode& mode,
+                const FixedVector<int32_t>& offsets,
+                BoostScores& boost_scores) override;
+
+    float
+    weight() override {
+        return weight_;
+    }
+
+    // decays are in [0, 1]
+    std::pair<float, float>
+    score_range() override {
+        return {std::min(0.0f, weight_), std::max(0.0f, weight_)};
+    }
+
+ private:
+    // merges decay * weight into boost_scores where mask[i]
+    void
+    decay_score(milvus::OpContext* op_ctx,
+                const segcore::SegmentInternalInterface* segment,
+                const proto::plan::FunctionMode& mode,
+                const FixedVector<int32_t>& offsets,
+                const FixedVector<uint8_t>& mask,
+                BoostScores& boost_scores);
+
+    expr::TypedExprPtr filter_;
+    float weight_;
+    Function function_;
+    FieldId field_;
+    double origin_;
+    double scale_;
+    double offset_ = 0;
+    double decay_ = 0.5;
+};
 }  // namespace milvus::rescores
\ No newline at end of file
@@ -0,0 +1,113 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "rescores/Murmur3.h"
+#include "rescores/Scorer.h"
+
+using namespace milvus;
+using namespace milvus::rescores;
+
+TEST(Scorer, BatchMurmurMatchesScalar) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> keys(1000);
+    for (auto& key : keys) {
+        key = rng();
+    }
+    std::vector<uint64_t> hashes(keys.size());
+    for (uint64_t seed : {uint64_t{0}, uint64_t{123}, rng()}) {
+        MurmurHash3_x64_64_Special_Batch(
+            keys.data(), keys.size(), seed, hashes.data());
+        for (size_t i = 0; i < keys.size(); i++) {
+            ASSERT_EQ(hashes[i], MurmurHash3_x64_64_Special(keys[i], seed));
+        }
+    }
+}
+
+TEST(Scorer, WeightMergesMaskedScores) {
+    FixedVector<int32_t> offsets = {0, 5, 9, 3};
+    TargetBitmap matched(offsets.size());
+    matched.set(1);
+    matched.set(3);
+    TargetBitmapView view(matched.data(), matched.size());
+    // over the segment: offsets 0 and 9, 42 lies past the bitmap
+    TargetBitmap segment_matched(10);
+    segment_matched.set(0);
+    segment_matched.set(9);
+    FixedVector<int32_t> lagging = {0, 5, 9, 42};
+
+    WeightScorer twice(nullptr, 2.0f);
+    WeightScorer thrice(nullptr, 3.0f);
+    for (auto mode :
+         {proto::plan::FunctionModeMultiply, proto::plan::FunctionModeSum}) {
+        BoostScores boost_scores(offsets.size(), mode);
+        twice.batch_score(nullptr, nullptr, mode, offsets, view, boost_scores);
+        thrice.batch_score(
+            nullptr, nullptr, mode, lagging, segment_matched, boost_scores);
+        // the first merge into an offset sets its score
+        std::vector<float> expected = {3.0f, 2.0f, 3.0f, 2.0f};
+        for (size_t i = 0; i < offsets.size(); i++) {
+            EXPECT_TRUE(boost_scores.valid[i]);
+            EXPECT_FLOAT_EQ(boost_scores.scores[i], expected[i]);
+        }
+
+        twice.batch_score(nullptr, nullptr, mode, offsets, boost_scores);
+        for (size_t i = 0; i < offsets.size(); i++) {
+            EXPECT_FLOAT_EQ(boost_scores.scores[i],
+                            mode == proto::plan::FunctionModeMultiply
+                                ? expected[i] * 2.0f
+                                : expected[i] + 2.0f);
+        }
+    }
+
+    // offsets no scorer matched stay unset
+    BoostScores boost_scores(offsets.size(), proto::plan::FunctionModeSum);
+    twice.batch_score(nullptr,
+                      nullptr,
+                      proto::plan::FunctionModeSum,
+                      offsets,
+                      view,
+                      boost_scores);
+    EXPECT_FALSE(boost_scores.valid[0]);
+    EXPECT_FALSE(boost_scores.valid[2]);
+}
+
+TEST(Scorer, DecayFunctions) {
+    using Function = DecayScorer::Function;
+    for (auto function : {Function::Gauss, Function::Exp, Function::Linear}) {
+        // 1 within offset of the origin, decay at scale past the offset
+        EXPECT_DOUBLE_EQ(
+            DecayScorer::Decay(function, 10.0, 10.0, 5.0, 2.0, 0.5), 1.0);
+        EXPECT_DOUBLE_EQ(
+            DecayScorer::Decay(function, 8.5, 10.0, 5.0, 2.0, 0.5), 1.0);
+        EXPECT_NEAR(
+            DecayScorer::Decay(function, 17.0, 10.0, 5.0, 2.0, 0.5), 0.5, 1e-9);
+        EXPECT_NEAR(
+            DecayScorer::Decay(function, 3.0, 10.0, 5.0, 2.0, 0.5), 0.5, 1e-9);
+        // decreasing with the distance
+        EXPECT_LT(DecayScorer::Decay(function, 20.0, 10.0, 5.0, 2.0, 0.5),
+                  DecayScorer::Decay(function, 15.0, 10.0, 5.0, 2.0, 0.5));
+    }
+    EXPECT_NEAR(DecayScorer::Decay(Function::Gauss, 10.0, 0, 5.0, 0, 0.5),
+                0.0625,
+                1e-9);
+    EXPECT_NEAR(
+        DecayScorer::Decay(Function::Exp, 10.0, 0, 5.0, 0, 0.5), 0.25, 1e-9);
+    // linear reaches 0 at scale / (1 - decay) and stays there
+    EXPECT_DOUBLE_EQ(
+        DecayScorer::Decay(Function::Linear, 10.0, 0, 5.0, 0, 0.5), 0.0);
+    EXPECT_DOUBLE_EQ(
+        DecayScorer::Decay(Function::Linear, 30.0, 0, 5.0, 0, 0.5), 0.0);
+}
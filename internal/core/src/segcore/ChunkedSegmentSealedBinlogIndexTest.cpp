@@ -11,14 +11,17 @@
 
 #include <gtest/gtest.h>
 #include <boost/format.hpp>
+#include <filesystem>
 #include <optional>
 
+#include "common/Common.h"
 #include "index/IndexFactory.h"
 #include "index/VectorIndex.h"
 #include "pb/plan.pb.h"
 #include "query/Plan.h"
 #include "segcore/segcore_init_c.h"
 #include "segcore/SegmentSealed.h"
+#include "storage/LocalChunkManagerSingleton.h"
 #include "expr/ITypeExpr.h"
 #include "plan/PlanNode.h"
 
@@ -1295,4 +1298,70 @@ TEST_P(BinlogIndexTest, LoadBinlogWithoutIndexMeta) {
     EXPECT_FALSE(segment->HasIndex(vec_field_id));
     EXPECT_EQ(segment->get_row_count(), data_n);
     EXPECT_TRUE(segment->HasFieldData(vec_field_id));
-}
\ No newline at end of file
+}
+TEST_P(BinlogIndexTest, InterimIndexDiskCache) {
+    IndexMetaPtr collection_index_meta = GetCollectionIndexMeta(index_type);
+    auto& segcore_config = milvus::segcore::SegcoreConfig::default_config();
+    segcore_config.set_enable_interim_segment_index(true);
+    if (dense_vec_intermin_index_type.has_value()) {
+        segcore_config.set_dense_vector_intermin_index_type(
+            dense_vec_intermin_index_type.value());
+    }
+    segcore_config.set_nprobe(16);
+    milvus::SetDefaultInterimIndexDiskCacheEnabled(true);
+    auto field_cache_dir =
+        std::filesystem::path(
+            milvus::storage::LocalChunkManagerSingleton::GetInstance()
+                .GetChunkManager()
+                ->GetRootPath()) /
+        "interim_index" / std::to_string(kSegmentID) /
+        std::to_string(vec_field_id.get());
+    std::filesystem::remove_all(field_cache_dir);
+
+    auto num_queries = std::min(10, static_cast<int>(valid_count));
+    milvus::proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(DataTypeToVectorType(data_type));
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(vec_field_id.get());
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(topk);
+    query_info->set_round_decimal(3);
+    query_info->set_metric_type(metric_type);
+    query_info->set_search_params(R"({"nprobe": 16})");
+    auto plan_str = plan_node.SerializeAsString();
+    auto ph_group_raw = CreatePlaceholderGroupForVectorType(
+        data_type, num_queries, data_d, GetQueryData(num_queries));
+    auto plan = milvus::query::CreateSearchPlanByExpr(
+        schema, plan_str.data(), plan_str.size());
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    // the first load builds the index and keeps it on disk
+    segment = CreateSealedSegment(schema, collection_index_meta, kSegmentID);
+    LoadOtherFields();
+    LoadVectorField();
+    if (num_queries == 0 || !segment->HasIndex(vec_field_id)) {
+        milvus::SetDefaultInterimIndexDiskCacheEnabled(false);
+        return;
+    }
+    auto built_sr = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    ASSERT_TRUE(std::filesystem::exists(field_cache_dir));
+    auto num_files =
+        std::distance(std::filesystem::directory_iterator(field_cache_dir),
+                      std::filesystem::directory_iterator());
+    EXPECT_EQ(num_files, 1);
+
+    // a load of the same binlogs mmaps it
+    segment = CreateSealedSegment(schema, collection_index_meta, kSegmentID);
+    LoadOtherFields();
+    LoadVectorField();
+    EXPECT_TRUE(segment->HasIndex(vec_field_id));
+    auto loaded_sr =
+        segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+    EXPECT_EQ(loaded_sr->seg_offsets_, built_sr->seg_offsets_);
+    EXPECT_EQ(loaded_sr->distances_, built_sr->distances_);
+
+    milvus::SetDefaultInterimIndexDiskCacheEnabled(false);
+    std::filesystem::remove_all(field_cache_dir);
+}
@@ -60,8 +60,11 @@
 #include "log/Log.h"
 #include "pb/schema.pb.h"
 #include "query/SearchOnSealed.h"
+#include "segcore/SearchResultCache.h"
+#include "segcore/SegmentGrowingImpl.h"
 #include "segcore/storagev1translator/ChunkTranslator.h"
 #include "segcore/storagev1translator/DefaultValueChunkTranslator.h"
+#include "segcore/storagev1translator/InMemoryChunkTranslator.h"
 #include "segcore/storagev2translator/GroupChunkTranslator.h"
 #include "mmap/ChunkedColumnInterface.h"
 #include "mmap/ChunkedColumnGroup.h"
@@ -121,6 +124,7 @@ ChunkedSegmentSealedImpl::LoadVecIndex(const LoadIndexInfo& info) {
     auto metric_type = info.index_params.at("metric_type");
 
     std::unique_lock lck(mutex_);
+    ++generation_;
     AssertInfo(
         !get_bit(index_ready_bitset_, field_id),
         "vector index has been exist at " + std::to_string(field_id.get()));
@@ -142,7 +146,7 @@ ChunkedSegmentSealedImpl::LoadVecIndex(const LoadIndexInfo& info) {
             info.dim);
 
     if (request.has_raw_data && get_bit(field_data_ready_bitset_, field_id)) {
-        fields_.rlock()->at(field_id)->ManualEvictCache();
+        catalog()->fields.at(field_id)->ManualEvictCache();
     }
     if (get_bit(binlog_index_bitset_, field_id)) {
         set_bit(binlog_index_bitset_, field_id, false);
@@ -180,6 +184,7 @@ ChunkedSegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
     }
 
     std::unique_lock lck(mutex_);
+    ++generation_;
     AssertInfo(
         !get_bit(index_ready_bitset_, field_id),
         "scalar index has been exist at " + std::to_string(field_id.get()));
@@ -189,13 +194,10 @@ ChunkedSegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
         if (auto it = info.index_params.find(index::INDEX_TYPE);
             it != info.index_params.end() &&
             it->second == index::NGRAM_INDEX_TYPE) {
-            auto ngram_indexings = ngram_indexings_.wlock();
-            if (ngram_indexings->find(field_id) == ngram_indexings->end()) {
-                (*ngram_indexings)[field_id] =
-                    std::unordered_map<std::string, index::CacheIndexBasePtr>();
-            }
-            (*ngram_indexings)[field_id][path] =
-                std::move(const_cast<LoadIndexInfo&>(info).cache_index);
+            update_catalog([&](SealedCatalog& catalog) {
+                catalog.ngram_indexings[field_id][path] =
+                    std::move(const_cast<LoadIndexInfo&>(info).cache_index);
+            });
             return;
         } else {
             JsonIndex index;
@@ -210,20 +212,18 @@ ChunkedSegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
         }
     }
 
-    if (auto it = info.index_params.find(index::INDEX_TYPE);
-        it != info.index_params.end() &&
-        it->second == index::NGRAM_INDEX_TYPE) {
-        auto [scalar_indexings, ngram_fields] =
-            lock(folly::wlock(scalar_indexings_), folly::wlock(ngram_fields_));
-        ngram_fields->insert(field_id);
-        scalar_indexings->insert(
-            {field_id,
-             std::move(const_cast<LoadIndexInfo&>(info).cache_index)});
-    } else {
-        scalar_indexings_.wlock()->insert(
+    auto it = info.index_params.find(index::INDEX_TYPE);
+    auto is_ngram = it != info.index_params.end() &&
+                    it->second == index::NGRAM_INDEX_TYPE;
+    // the index and its ngram mark are published together
+    update_catalog([&](SealedCatalog& catalog) {
+        if (is_ngram) {
+            catalog.ngram_fields.insert(field_id);
+        }
+        catalog.scalar_indexings.insert(
             {field_id,
              std::move(const_cast<LoadIndexInfo&>(info).cache_index)});
-    }
+    });
 
     LoadResourceRequest request =
         milvus::index::IndexFactory::GetInstance().ScalarIndexLoadResource(
@@ -241,7 +241,7 @@ ChunkedSegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
         !is_pk) {
         // We do not erase the primary key field: if insert record is evicted from memory, when reloading it'll
         // need the pk field again.
-        fields_.rlock()->at(field_id)->ManualEvictCache();
+        catalog()->fields.at(field_id)->ManualEvictCache();
     }
     LOG_INFO(
         "Has load scalar index done, fieldID:{}. segmentID:{}, has_raw_data:{}",
@@ -264,6 +264,260 @@ ChunkedSegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& load_info,
     }
 }
 
+namespace {
+
+// an arrow buffer over a chunk of a growing segment, keeping it alive
+class GrowingChunkBuffer : public arrow::Buffer {
+ public:
+    GrowingChunkBuffer(const void* data,
+                       int64_t size,
+                       std::shared_ptr<const void> owner)
+        : arrow::Buffer(static_cast<const uint8_t*>(data), size),
+          owner_(std::move(owner)) {
+    }
+
+ private:
+    std::shared_ptr<const void> owner_;
+};
+
+// The arrow type whose values buffer is laid out as a growing chunk of the
+// field, nullptr if the chunk has to be copied: the nullable fields, whose
+// chunks start with a bitmap, booleans, bit packed in arrow, and the
+// variable width types.
+std::shared_ptr<arrow::DataType>
+BorrowableArrowType(const FieldMeta& field_meta) {
+    if (field_meta.is_nullable()) {
+        return nullptr;
+    }
+    switch (field_meta.get_data_type()) {
+        case DataType::INT8:
+            return arrow::int8();
+        case DataType::INT16:
+            return arrow::int16();
+        case DataType::INT32:
+            return arrow::int32();
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            return arrow::int64();
+        case DataType::FLOAT:
+            return arrow::float32();
+        case DataType::DOUBLE:
+            return arrow::float64();
+        case DataType::VECTOR_FLOAT:
+            return arrow::fixed_size_binary(field_meta.get_dim() *
+                                            sizeof(float));
+        case DataType::VECTOR_BINARY:
+            return arrow::fixed_size_binary(field_meta.get_dim() / 8);
+        case DataType::VECTOR_FLOAT16:
+        case DataType::VECTOR_BFLOAT16:
+            return arrow::fixed_size_binary(field_meta.get_dim() * 2);
+        case DataType::VECTOR_INT8:
+            return arrow::fixed_size_binary(field_meta.get_dim());
+        default:
+            return nullptr;
+    }
+}
+
+// Copies rows values of a growing chunk into an arrow array, valid is
+// nullptr for a field without nulls and begin is the offset of the chunk.
+template <typename Builder, typename T, typename Append>
+std::shared_ptr<arrow::Array>
+CopyGrowingRows(const void* chunk,
+                const ThreadSafeValidData* valid,
+                int64_t begin,
+                int64_t rows,
+                Append append) {
+    Builder builder;
+    auto values = static_cast<const T*>(chunk);
+    for (int64_t i = 0; i < rows; ++i) {
+        auto status = valid != nullptr && !valid->is_valid(begin + i)
+                          ? builder.AppendNull()
+                          : append(builder, values[i]);
+        AssertInfo(status.ok(),
+                   "append to arrow builder failed: {}",
+                   status.ToString());
+    }
+    std::shared_ptr<arrow::Array> array;
+    auto status = builder.Finish(&array);
+    AssertInfo(
+        status.ok(), "finish arrow builder failed: {}", status.ToString());
+    return array;
+}
+
+std::shared_ptr<arrow::Array>
+CopyGrowingChunk(const FieldMeta& field_meta,
+                 const void* chunk,
+                 const ThreadSafeValidData* valid,
+                 int64_t begin,
+                 int64_t rows) {
+    auto append = [](auto& builder, const auto& value) {
+        return builder.Append(value);
+    };
+    switch (field_meta.get_data_type()) {
+        case DataType::BOOL:
+            return CopyGrowingRows<arrow::BooleanBuilder, bool>(
+                chunk, valid, begin, rows, append);
+        case DataType::INT8:
+            return CopyGrowingRows<arrow::Int8Builder, int8_t>(
+                chunk, valid, begin, rows, append);
+        case DataType::INT16:
+            return CopyGrowingRows<arrow::Int16Builder, int16_t>(
+                chunk, valid, begin, rows, append);
+        case DataType::INT32:
+            return CopyGrowingRows<arrow::Int32Builder, int32_t>(
+                chunk, valid, begin, rows, append);
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ:
+            return CopyGrowingRows<arrow::Int64Builder, int64_t>(
+                chunk, valid, begin, rows, append);
+        case DataType::FLOAT:
+            return CopyGrowingRows<arrow::FloatBuilder, float>(
+                chunk, valid, begin, rows, append);
+        case DataType::DOUBLE:
+            return CopyGrowingRows<arrow::DoubleBuilder, double>(
+                chunk, valid, begin, rows, append);
+        case DataType::VARCHAR:
+        case DataType::STRING:
+        case DataType::TEXT:
+            return CopyGrowingRows<arrow::StringBuilder, std::string>(
+                chunk, valid, begin, rows, append);
+        case DataType::JSON:
+            return CopyGrowingRows<arrow::BinaryBuilder, Json>(
+                chunk,
+                valid,
+                begin,
+                rows,
+                [](arrow::BinaryBuilder& builder, const Json& value) {
+                    return builder.Append(value.data());
+                });
+        case DataType::ARRAY:
+            return CopyGrowingRows<arrow::BinaryBuilder, Array>(
+                chunk,
+                valid,
+                begin,
+                rows,
+                [](arrow::BinaryBuilder& builder, const Array& value) {
+                    return builder.Append(
+                        value.output_data().SerializeAsString());
+                });
+        default:
+            ThrowInfo(NotImplemented,
+                      "field {} of type {} can't be taken from a growing "
+                      "segment, load it from storage",
+                      field_meta.get_id().get(),
+                      field_meta.get_data_type());
+    }
+}
+
+// the binlogs a field is loaded from, they are never rewritten so they tell
+// whether an interim index kept on disk was built on the same rows
+std::string
+BinlogDataVersion(const std::vector<std::string>& sorted_files) {
+    std::string version;
+    for (const auto& file : sorted_files) {
+        version.append(file).push_back(',');
+    }
+    return version;
+}
+
+}  // namespace
+
+void
+ChunkedSegmentSealedImpl::LoadFromGrowing(
+    std::shared_ptr<const SegmentGrowingImpl> growing,
+    milvus::OpContext* op_ctx) {
+    SCOPE_CGO_CALL_METRIC();
+
+    auto num_rows = growing->get_row_count();
+    AssertInfo(num_rows > 0, "The row count of growing segment is 0");
+    AssertInfo(!num_rows_.has_value() || num_rows_ == num_rows,
+               "num_rows_ is set but not equal to the growing row count");
+    const auto& insert_record = growing->get_insert_record();
+    auto size_per_chunk = growing->size_per_chunk();
+    auto num_chunks = upper_div(num_rows, size_per_chunk);
+
+    std::vector<Timestamp> timestamps(num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        timestamps[i] = insert_record.timestamps_[i];
+    }
+    init_timestamp_index(timestamps, num_rows);
+    ++system_ready_count_;
+    {
+        std::unique_lock lck(mutex_);
+        ++generation_;
+        update_row_count(num_rows);
+    }
+
+    for (const auto& [field_id, field_meta] : schema_->get_fields()) {
+        if (SystemProperty::Instance().IsSystem(field_id) ||
+            !insert_record.is_data_exist(field_id)) {
+            continue;
+        }
+        auto data = insert_record.get_data_base(field_id);
+        AssertInfo(!data->is_mapping_storage(),
+                   "field {} keeps the rows of its nulls apart, load it "
+                   "from storage",
+                   field_id.get());
+        auto valid = field_meta.is_nullable()
+                         ? insert_record.get_valid_data(field_id)
+                         : nullptr;
+        auto borrow_type = BorrowableArrowType(field_meta);
+        auto row_bytes =
+            borrow_type == nullptr
+                ? 0
+                : std::static_pointer_cast<arrow::FixedWidthType>(borrow_type)
+                          ->bit_width() /
+                      8;
+
+        std::vector<arrow::ArrayVector> cells;
+        cells.reserve(num_chunks);
+        for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+            auto begin = chunk_id * size_per_chunk;
+            auto rows = std::min(size_per_chunk, num_rows - begin);
+            auto chunk = data->get_chunk_data(chunk_id);
+            std::shared_ptr<arrow::Array> array;
+            if (borrow_type != nullptr) {
+                auto buffer = std::make_shared<GrowingChunkBuffer>(
+                    chunk, rows * row_bytes, growing);
+                array = arrow::MakeArray(arrow::ArrayData::Make(
+                    borrow_type, rows, {nullptr, std::move(buffer)}, 0));
+            } else {
+                array = CopyGrowingChunk(
+                    field_meta, chunk, valid.get(), begin, rows);
+            }
+            cells.push_back({std::move(array)});
+        }
+
+        auto [field_has_warmup, field_warmup_policy] =
+            schema_->WarmupPolicy(field_id,
+                                  IsVectorDataType(field_meta.get_data_type()),
+                                  /*is_index=*/false);
+        std::unique_ptr<Translator<milvus::Chunk>> translator =
+            std::make_unique<storagev1translator::InMemoryChunkTranslator>(
+                get_segment_id(),
+                field_meta,
+                std::move(cells),
+                field_has_warmup ? field_warmup_policy : "");
+        auto slot = cachinglayer::Manager::GetInstance().CreateCacheSlot(
+            std::move(translator), op_ctx);
+        auto data_type = field_meta.get_data_type();
+        auto column =
+            MakeChunkedColumnBase(data_type, std::move(slot), field_meta);
+        load_field_data_common(field_id,
+                               column,
+                               num_rows,
+                               data_type,
+                               false,
+                               false,
+                               std::nullopt,
+                               op_ctx);
+    }
+    LOG_INFO("segment {} takes {} rows from growing segment {}",
+             get_segment_id(),
+             num_rows,
+             growing->get_segment_id());
+}
+
 std::optional<ChunkedSegmentSealedImpl::ParquetStatistics>
 parse_parquet_statistics(
     const std::vector<std::shared_ptr<parquet::FileMetaData>>& file_metas,
@@ -373,8 +627,10 @@ ChunkedSegmentSealedImpl::load_column_group_data_internal(
 
         auto file_metas = translator->parquet_file_metas();
         auto field_id_mapping = translator->field_id_mapping();
+        auto hot_cells_key = translator->key();
         auto chunked_column_group =
             std::make_shared<ChunkedColumnGroup>(std::move(translator));
+        chunked_column_group->TrackHotCells(hot_cells_key);
 
         // Create ProxyChunkColumn for each field in this column group
         for (const auto& field_id : milvus_field_ids) {
@@ -396,7 +652,8 @@ ChunkedSegmentSealedImpl::load_column_group_data_internal(
                 info.enable_mmap,
                 true,
                 ENABLE_PARQUET_STATS_SKIP_INDEX ? statistics_opt : std::nullopt,
-                op_ctx);
+                op_ctx,
+                BinlogDataVersion(insert_files));
             if (field_id == TimestampFieldID) {
                 auto timestamp_proxy_column = get_column(TimestampFieldID);
                 AssertInfo(timestamp_proxy_column != nullptr,
@@ -501,6 +758,11 @@ ChunkedSegmentSealedImpl::load_field_data_internal(
             }
 
             storage::SortByPath(file_infos);
+            std::vector<std::string> file_paths;
+            file_paths.reserve(file_infos.size());
+            for (const auto& file_info : file_infos) {
+                file_paths.push_back(file_info.file_path);
+            }
 
             auto field_meta = schema_->operator[](field_id);
             std::unique_ptr<Translator<milvus::Chunk>> translator =
@@ -515,10 +777,12 @@ ChunkedSegmentSealedImpl::load_field_data_internal(
                     info.warmup_policy);
 
             auto data_type = field_meta.get_data_type();
+            auto hot_cells_key = translator->key();
             auto slot = cachinglayer::Manager::GetInstance().CreateCacheSlot(
                 std::move(translator), op_ctx);
             auto column =
                 MakeChunkedColumnBase(data_type, std::move(slot), field_meta);
+            column->TrackHotCells(hot_cells_key);
 
             load_field_data_common(field_id,
                                    column,
@@ -527,7 +791,8 @@ ChunkedSegmentSealedImpl::load_field_data_internal(
                                    info.enable_mmap,
                                    false,
                                    std::nullopt,
-                                   op_ctx);
+                                   op_ctx,
+                                   BinlogDataVersion(file_paths));
         }
     }
 }
@@ -573,6 +838,7 @@ ChunkedSegmentSealedImpl::load_system_field_internal(
     }
     {
         std::unique_lock lck(mutex_);
+        ++generation_;
         update_row_count(num_rows);
     }
 }
@@ -675,6 +941,38 @@ ChunkedSegmentSealedImpl::prefetch_chunks(
     }
 }
 
+ContinueFuture
+ChunkedSegmentSealedImpl::prefetch_chunks_async(
+    milvus::OpContext* op_ctx,
+    FieldId field_id,
+    const std::vector<int64_t>& chunk_ids) const {
+    std::shared_lock lck(mutex_);
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Can't get bitset element at " + std::to_string(field_id.get()));
+    if (auto column = get_column(field_id)) {
+        return column->PrefetchChunksAsync(op_ctx, chunk_ids);
+    }
+    return folly::makeSemiFuture();
+}
+
+PinWrapper<const StringChunk*>
+ChunkedSegmentSealedImpl::dict_string_chunk(milvus::OpContext* op_ctx,
+                                            FieldId field_id,
+                                            int64_t chunk_id) const {
+    std::shared_lock lck(mutex_);
+    auto column = get_column(field_id);
+    if (column == nullptr ||
+        !IsStringDataType(schema_->operator[](field_id).get_data_type())) {
+        return PinWrapper<const StringChunk*>(nullptr);
+    }
+    lck.unlock();
+    return column->GetChunk(op_ctx, chunk_id)
+        .transform<const StringChunk*>([](Chunk*&& chunk) {
+            auto string_chunk = static_cast<const StringChunk*>(chunk);
+            return string_chunk->IsDictEncoded() ? string_chunk : nullptr;
+        });
+}
+
 PinWrapper<SpanBase>
 ChunkedSegmentSealedImpl::chunk_data_impl(milvus::OpContext* op_ctx,
                                           FieldId field_id,
@@ -773,21 +1071,16 @@ ChunkedSegmentSealedImpl::chunk_array_views_by_offsets(
 PinWrapper<index::NgramInvertedIndex*>
 ChunkedSegmentSealedImpl::GetNgramIndex(milvus::OpContext* op_ctx,
                                         FieldId field_id) const {
-    std::shared_lock lck(mutex_);
-    auto [scalar_indexings, ngram_fields] =
-        lock(folly::rlock(scalar_indexings_), folly::rlock(ngram_fields_));
-
-    auto has = ngram_fields->find(field_id);
-    if (has == ngram_fields->end()) {
+    auto catalog = this->catalog();
+    if (catalog->ngram_fields.count(field_id) == 0) {
         return PinWrapper<index::NgramInvertedIndex*>(nullptr);
     }
 
-    auto iter = scalar_indexings->find(field_id);
-    if (iter == scalar_indexings->end()) {
+    auto iter = catalog->scalar_indexings.find(field_id);
+    if (iter == catalog->scalar_indexings.end()) {
         return PinWrapper<index::NgramInvertedIndex*>(nullptr);
     }
     auto slot = iter->second.get();
-    lck.unlock();
 
     auto ca = SemiInlineGet(slot->PinCells(op_ctx, {0}));
     auto index = dynamic_cast<index::NgramInvertedIndex*>(ca->get_cell_of(0));
@@ -802,26 +1095,23 @@ ChunkedSegmentSealedImpl::GetNgramIndexForJson(
     milvus::OpContext* op_ctx,
     FieldId field_id,
     const std::string& nested_path) const {
-    std::shared_lock lck(mutex_);
-    return ngram_indexings_.withRLock([&](auto& ngram_indexings) {
-        auto iter = ngram_indexings.find(field_id);
-        if (iter == ngram_indexings.end() ||
-            iter->second.find(nested_path) == iter->second.end()) {
-            return PinWrapper<index::NgramInvertedIndex*>(nullptr);
-        }
-
-        auto slot = iter->second.at(nested_path).get();
-
-        auto ca = SemiInlineGet(slot->PinCells(op_ctx, {0}));
-        auto index =
-            dynamic_cast<index::NgramInvertedIndex*>(ca->get_cell_of(0));
-        AssertInfo(index != nullptr,
-                   "ngram index cache for json is corrupted, field_id: {}, "
-                   "nested_path: {}",
-                   field_id.get(),
-                   nested_path);
-        return PinWrapper<index::NgramInvertedIndex*>(ca, index);
-    });
+    auto catalog = this->catalog();
+    auto iter = catalog->ngram_indexings.find(field_id);
+    if (iter == catalog->ngram_indexings.end() ||
+        iter->second.find(nested_path) == iter->second.end()) {
+        return PinWrapper<index::NgramInvertedIndex*>(nullptr);
+    }
+
+    auto slot = iter->second.at(nested_path).get();
+
+    auto ca = SemiInlineGet(slot->PinCells(op_ctx, {0}));
+    auto index = dynamic_cast<index::NgramInvertedIndex*>(ca->get_cell_of(0));
+    AssertInfo(index != nullptr,
+               "ngram index cache for json is corrupted, field_id: {}, "
+               "nested_path: {}",
+               field_id.get(),
+               nested_path);
+    return PinWrapper<index::NgramInvertedIndex*>(ca, index);
 }
 
 int64_t
@@ -950,15 +1240,14 @@ ChunkedSegmentSealedImpl::FilterVectorValidOffsets(milvus::OpContext* op_ctx,
             result.valid_data = std::make_unique<bool[]>(count);
             result.valid_offsets.reserve(count);
 
+            std::vector<int64_t> physical_offsets(count);
+            vec_index->GetOffsetMapping().GetPhysicalOffsets(
+                seg_offsets, count, physical_offsets.data());
             for (int64_t i = 0; i < count; ++i) {
-                bool is_valid = vec_index->IsRowValid(seg_offsets[i]);
+                bool is_valid = physical_offsets[i] >= 0;
                 result.valid_data[i] = is_valid;
                 if (is_valid) {
-                    int64_t physical_offset =
-                        vec_index->GetPhysicalOffset(seg_offsets[i]);
-                    if (physical_offset >= 0) {
-                        result.valid_offsets.push_back(physical_offset);
-                    }
+                    result.valid_offsets.push_back(physical_offsets[i]);
                 }
             }
             result.valid_count = result.valid_offsets.size();
@@ -969,16 +1258,14 @@ ChunkedSegmentSealedImpl::FilterVectorValidOffsets(milvus::OpContext* op_ctx,
             result.valid_data = std::make_unique<bool[]>(count);
             result.valid_offsets.reserve(count);
 
-            const auto& offset_mapping = column->GetOffsetMapping();
+            std::vector<int64_t> physical_offsets(count);
+            column->GetOffsetMapping().GetPhysicalOffsets(
+                seg_offsets, count, physical_offsets.data());
             for (int64_t i = 0; i < count; ++i) {
-                bool is_valid = offset_mapping.IsValid(seg_offsets[i]);
+                bool is_valid = physical_offsets[i] >= 0;
                 result.valid_data[i] = is_valid;
                 if (is_valid) {
-                    int64_t physical_offset =
-                        offset_mapping.GetPhysicalOffset(seg_offsets[i]);
-                    if (physical_offset >= 0) {
-                        result.valid_offsets.push_back(physical_offset);
-                    }
+                    result.valid_offsets.push_back(physical_offsets[i]);
                 }
             }
             result.valid_count = result.valid_offsets.size();
@@ -1050,8 +1337,12 @@ ChunkedSegmentSealedImpl::DropFieldData(const FieldId field_id) {
                "Dropping system field is not supported, field id: {}",
                field_id.get());
     std::unique_lock<std::shared_mutex> lck(mutex_);
+    ++generation_;
     if (get_bit(field_data_ready_bitset_, field_id)) {
-        fields_.wlock()->erase(field_id);
+        update_catalog([&](SealedCatalog& catalog) {
+            catalog.fields.erase(field_id);
+            catalog.default_value_fields.erase(field_id);
+        });
         set_bit(field_data_ready_bitset_, field_id, false);
     }
     if (get_bit(binlog_index_bitset_, field_id)) {
@@ -1069,10 +1360,11 @@ ChunkedSegmentSealedImpl::DropIndex(const FieldId field_id) {
     AssertInfo(!field_meta.is_vector(), "vector field cannot drop index");
 
     std::unique_lock lck(mutex_);
-    auto [scalar_indexings, ngram_fields] =
-        lock(folly::wlock(scalar_indexings_), folly::wlock(ngram_fields_));
-    scalar_indexings->erase(field_id);
-    ngram_fields->erase(field_id);
+    ++generation_;
+    update_catalog([&](SealedCatalog& catalog) {
+        catalog.scalar_indexings.erase(field_id);
+        catalog.ngram_fields.erase(field_id);
+    });
 
     set_bit(index_ready_bitset_, field_id, false);
 }
@@ -1081,6 +1373,7 @@ void
 ChunkedSegmentSealedImpl::DropJSONIndex(const FieldId field_id,
                                         const std::string& nested_path) {
     std::unique_lock lck(mutex_);
+    ++generation_;
     json_indices.withWLock([&](auto& vec) {
         vec.erase(std::remove_if(vec.begin(),
                                  vec.end(),
@@ -1091,12 +1384,12 @@ ChunkedSegmentSealedImpl::DropJSONIndex(const FieldId field_id,
                   vec.end());
     });
 
-    ngram_indexings_.withWLock([&](auto& ngram_indexings) {
-        auto iter = ngram_indexings.find(field_id);
-        if (iter != ngram_indexings.end()) {
+    update_catalog([&](SealedCatalog& catalog) {
+        auto iter = catalog.ngram_indexings.find(field_id);
+        if (iter != catalog.ngram_indexings.end()) {
             iter->second.erase(nested_path);
             if (iter->second.empty()) {
-                ngram_indexings.erase(iter);
+                catalog.ngram_indexings.erase(iter);
             }
         }
     });
@@ -1188,14 +1481,8 @@ ChunkedSegmentSealedImpl::search_batch_pks(
         callback) const {
     // handle unsorted case
     if (!is_sorted_by_pk_) {
-        for (size_t i = 0; i < pks.size(); i++) {
-            auto timestamp = get_timestamp(i);
-            auto offsets =
-                insert_record_.search_pk(pks[i], timestamp, include_same_ts);
-            for (auto offset : offsets) {
-                callback(offset, timestamp);
-            }
-        }
+        insert_record_.search_pks_batch(
+            pks, get_timestamp, include_same_ts, callback);
         return;
     }
 
@@ -1204,72 +1491,23 @@ ChunkedSegmentSealedImpl::search_batch_pks(
     auto pk_column = get_column(pk_field_id);
     AssertInfo(pk_column != nullptr, "primary key column not loaded");
 
-    auto all_chunk_pins = pk_column->GetAllChunks(nullptr);
-
-    auto timestamp_hit = include_same_ts
-                             ? [](const Timestamp& ts1,
-                                  const Timestamp& ts2) { return ts1 <= ts2; }
-                             : [](const Timestamp& ts1, const Timestamp& ts2) {
-                                   return ts1 < ts2;
-                               };
-
     switch (schema_->get_fields().at(pk_field_id).get_data_type()) {
         case DataType::INT64: {
-            auto num_chunk = pk_column->num_chunks();
-            for (int i = 0; i < num_chunk; ++i) {
-                auto pw = all_chunk_pins[i];
-                auto src =
-                    reinterpret_cast<const int64_t*>(pw.get()->RawData());
-                auto chunk_row_num = pk_column->chunk_row_nums(i);
-                for (size_t j = 0; j < pks.size(); j++) {
-                    // get int64 pks
-                    auto target = std::get<int64_t>(pks[j]);
-                    auto timestamp = get_timestamp(j);
-                    auto it = std::lower_bound(
-                        src,
-                        src + chunk_row_num,
-                        target,
-                        [](const int64_t& elem, const int64_t& value) {
-                            return elem < value;
-                        });
-                    auto num_rows_until_chunk =
-                        pk_column->GetNumRowsUntilChunk(i);
-                    for (; it != src + chunk_row_num && *it == target; ++it) {
-                        auto offset = it - src + num_rows_until_chunk;
-                        if (timestamp_hit(insert_record_.timestamps_[offset],
-                                          timestamp)) {
-                            callback(SegOffset(offset), timestamp);
-                        }
-                    }
-                }
-            }
-
+            search_sorted_batch_pks_impl<int64_t>(pks,
+                                                  get_timestamp,
+                                                  include_same_ts,
+                                                  callback,
+                                                  pk_field_id,
+                                                  pk_column);
             break;
         }
         case DataType::VARCHAR: {
-            auto num_chunk = pk_column->num_chunks();
-            for (int i = 0; i < num_chunk; ++i) {
-                // TODO @xiaocai2333, @sunby: chunk need to record the min/max.
-                auto num_rows_until_chunk = pk_column->GetNumRowsUntilChunk(i);
-                auto pw = all_chunk_pins[i];
-                auto string_chunk = static_cast<StringChunk*>(pw.get());
-                for (size_t j = 0; j < pks.size(); ++j) {
-                    // get varchar pks
-                    auto& target = std::get<std::string>(pks[j]);
-                    auto timestamp = get_timestamp(j);
-                    auto offset = string_chunk->binary_search_string(target);
-                    for (; offset != -1 && offset < string_chunk->RowNums() &&
-                           string_chunk->operator[](offset) == target;
-                         ++offset) {
-                        auto segment_offset = offset + num_rows_until_chunk;
-                        if (timestamp_hit(
-                                insert_record_.timestamps_[segment_offset],
-                                timestamp)) {
-                            callback(SegOffset(segment_offset), timestamp);
-                        }
-                    }
-                }
-            }
+            search_sorted_batch_pks_impl<std::string>(pks,
+                                                      get_timestamp,
+                                                      include_same_ts,
+                                                      callback,
+                                                      pk_field_id,
+                                                      pk_column);
             break;
         }
         default: {
@@ -1371,6 +1609,57 @@ ChunkedSegmentSealedImpl::pk_binary_range(milvus::OpContext* op_ctx,
     }
 }
 
+bool
+ChunkedSegmentSealedImpl::has_partition_key_rows(FieldId field_id) const {
+    if (schema_->get_partition_key_field_id() != field_id &&
+        schema_->get_namespace_field_id() != field_id) {
+        return false;
+    }
+    const auto& field_meta = schema_->operator[](field_id);
+    return !field_meta.is_nullable() &&
+           (field_meta.get_data_type() == DataType::INT64 ||
+            field_meta.get_data_type() == DataType::VARCHAR) &&
+           get_column(field_id) != nullptr;
+}
+
+void
+ChunkedSegmentSealedImpl::partition_key_rows(milvus::OpContext* op_ctx,
+                                             FieldId field_id,
+                                             const std::vector<PkType>& keys,
+                                             BitsetTypeView& bitset) const {
+    AssertInfo(has_partition_key_rows(field_id),
+               "segment {} keeps no rows of partition key field {}",
+               id_,
+               field_id.get());
+    auto column = get_column(field_id);
+    AssertInfo(column != nullptr,
+               "partition key field {} not loaded",
+               field_id.get());
+
+    std::shared_ptr<const PartitionKeyRows> rows;
+    {
+        // the first filter builds them, the others wait for it
+        std::lock_guard lck(partition_key_rows_mutex_);
+        auto& entry = partition_key_rows_[field_id];
+        if (entry.rows_ == nullptr || entry.column_.lock() != column) {
+            entry.rows_ = std::make_shared<const PartitionKeyRows>(
+                op_ctx,
+                *column,
+                schema_->operator[](field_id).get_data_type());
+            entry.column_ = column;
+            LOG_INFO(
+                "segment {} keeps the rows of {} partition keys of field {} "
+                "in {} runs",
+                id_,
+                entry.rows_->num_keys(),
+                field_id.get(),
+                entry.rows_->num_runs());
+        }
+        rows = entry.rows_;
+    }
+    rows->Set(keys, bitset);
+}
+
 std::pair<std::vector<OffsetMap::OffsetType>, bool>
 ChunkedSegmentSealedImpl::find_first(int64_t limit,
                                      const BitsetTypeView& bitset) const {
@@ -1381,7 +1670,6 @@ ChunkedSegmentSealedImpl::find_first(int64_t limit,
         limit = num_rows_.value();
     }
 
-    int64_t hit_num = 0;  // avoid counting the number everytime.
     auto size = bitset.size();
     int64_t cnt = size - bitset.count();
     auto more_hit_than_limit = cnt > limit;
@@ -1389,20 +1677,16 @@ ChunkedSegmentSealedImpl::find_first(int64_t limit,
     std::vector<int64_t> seg_offsets;
     seg_offsets.reserve(limit);
 
-    int64_t offset = 0;
-    std::optional<size_t> result = bitset.find_first(false);
-    while (result.has_value() && hit_num < limit) {
-        hit_num++;
-        seg_offsets.push_back(result.value());
-        offset = result.value();
-        if (offset >= size) {
-            // In fact, this case won't happen on sealed segments.
-            continue;
-        }
-        result = bitset.find_next(offset, false);
-    }
+    // the offsets are extracted a block of bits at a time
+    bitset.for_each_batch(
+        [&](const int64_t* offsets, size_t n) {
+            n = std::min<size_t>(n, limit - seg_offsets.size());
+            seg_offsets.insert(seg_offsets.end(), offsets, offsets + n);
+            return static_cast<int64_t>(seg_offsets.size()) < limit;
+        },
+        false);
 
-    return {seg_offsets, more_hit_than_limit && result.has_value()};
+    return {seg_offsets, more_hit_than_limit};
 }
 
 ChunkedSegmentSealedImpl::ChunkedSegmentSealedImpl(
@@ -1415,9 +1699,7 @@ ChunkedSegmentSealedImpl::ChunkedSegmentSealedImpl(
       field_data_ready_bitset_(schema->size()),
       index_ready_bitset_(schema->size()),
       binlog_index_bitset_(schema->size()),
-      ngram_fields_(std::unordered_set<FieldId>(schema->size())),
-      scalar_indexings_(std::unordered_map<FieldId, index::CacheIndexBasePtr>(
-          schema->size())),
+      catalog_(std::make_shared<const SealedCatalog>()),
       insert_record_(*schema, MAX_ROW_COUNT),
       segment_load_info_(milvus::proto::segcore::SegmentLoadInfo(), schema),
       schema_(schema),
@@ -1455,6 +1737,57 @@ ChunkedSegmentSealedImpl::~ChunkedSegmentSealedImpl() {
         auto mm = storage::MmapManager::GetInstance().GetMmapChunkManager();
         mm->UnRegister(mmap_descriptor_);
     }
+
+    // a segment reloaded with this id starts over at generation 0
+    SearchResCacheManager::Instance().EraseSegment(get_segment_id());
+}
+
+std::unique_ptr<SearchResult>
+ChunkedSegmentSealedImpl::Search(
+    const query::Plan* plan,
+    const query::PlaceholderGroup* placeholder_group,
+    Timestamp timestamp,
+    const folly::CancellationToken& cancel_token,
+    int32_t consistency_level,
+    Timestamp collection_ttl) const {
+    if (!SearchResCacheManager::IsEnabled() || plan->signature_ == 0 ||
+        placeholder_group->signature_ == 0) {
+        return SegmentInternalInterface::Search(plan,
+                                                placeholder_group,
+                                                timestamp,
+                                                cancel_token,
+                                                consistency_level,
+                                                collection_ttl);
+    }
+
+    auto& cache = SearchResCacheManager::Instance();
+    SearchResCacheManager::Key key{
+        get_segment_id(),
+        plan->signature_,
+        placeholder_group->signature_,
+        SearchResCacheManager::TsBucket(timestamp),
+        SearchResCacheManager::TsBucket(collection_ttl)};
+    // taken before the search: a result racing with a write is cached under
+    // the watermark before the write, which no later search has
+    SearchResCacheManager::Watermark watermark{
+        generation_.load(), static_cast<int64_t>(deleted_record_.size())};
+    if (auto cached = cache.Get(key, watermark)) {
+        auto results = std::make_unique<SearchResult>();
+        SearchResCacheManager::Restore(*cached, *results);
+        results->segment_ = (void*)this;
+        return results;
+    }
+
+    auto results = SegmentInternalInterface::Search(plan,
+                                                    placeholder_group,
+                                                    timestamp,
+                                                    cancel_token,
+                                                    consistency_level,
+                                                    collection_ttl);
+    if (auto value = SearchResCacheManager::Capture(*results)) {
+        cache.Put(key, watermark, std::move(value));
+    }
+    return results;
 }
 
 void
@@ -1467,17 +1800,13 @@ ChunkedSegmentSealedImpl::bulk_subscript(milvus::OpContext* op_ctx,
                "System field isn't ready when do bulk_insert, segID:{}",
                id_);
     switch (system_type) {
-        case SystemFieldType::Timestamp:
-            AssertInfo(insert_record_.timestamps_.num_chunk() == 1,
-                       "num chunk of timestamp not equal to 1 for "
-                       "sealed segment");
-            bulk_subscript_impl<Timestamp>(
-                op_ctx,
-                this->insert_record_.timestamps_.get_chunk_data(0),
-                seg_offsets,
-                count,
-                static_cast<Timestamp*>(output));
+        case SystemFieldType::Timestamp: {
+            auto dst = static_cast<Timestamp*>(output);
+            for (int64_t i = 0; i < count; ++i) {
+                dst[i] = insert_record_.timestamps_[seg_offsets[i]];
+            }
             break;
+        }
         case SystemFieldType::RowId:
             ThrowInfo(ErrorCode::Unsupported, "RowId retrieve not supported");
             break;
@@ -1497,7 +1826,7 @@ ChunkedSegmentSealedImpl::bulk_subscript(milvus::OpContext* op_ctx,
                                          TargetBitmap& valid_map,
                                          bool small_int_raw_type) const {
     auto& field_meta = schema_->operator[](field_id);
-    // DO NOT directly access the column by map like: `fields_.at(field_id)->Data()`,
+    // DO NOT directly access the column by map like: `fields.at(field_id)->Data()`,
     // we have to clone the shared pointer, to make sure it won't get released
     // if segment released
     auto column = get_column(field_id);
@@ -1764,18 +2093,17 @@ void
 ChunkedSegmentSealedImpl::ClearData() {
     {
         std::unique_lock lck(mutex_);
+        ++generation_;
         field_data_ready_bitset_.reset();
         index_ready_bitset_.reset();
         binlog_index_bitset_.reset();
         index_has_raw_data_.clear();
         system_ready_count_ = 0;
         num_rows_ = std::nullopt;
-        ngram_fields_.wlock()->clear();
-        scalar_indexings_.wlock()->clear();
+        std::atomic_store(&catalog_,
+                          std::make_shared<const SealedCatalog>());
         vector_indexings_.clear();
-        ngram_indexings_.wlock()->clear();
         insert_record_.clear();
-        fields_.wlock()->clear();
         variable_fields_avg_size_.clear();
         stats_.mem_size = 0;
     }
@@ -1804,6 +2132,7 @@ ChunkedSegmentSealedImpl::CreateTextIndex(FieldId field_id,
                       "ChunkedSegmentSealedImpl::CreateTextIndex()");
 
     std::unique_lock lck(mutex_);
+    ++generation_;
 
     const auto& field_meta = schema_->operator[](field_id);
     auto& cfg = storage::MmapManager::GetInstance().GetMmapConfig();
@@ -1842,15 +2171,12 @@ ChunkedSegmentSealedImpl::CreateTextIndex(FieldId field_id,
                     index->AddTextSealed(std::string(value), is_valid, offset);
                 });
         } else {  // fetch raw data from index.
-            auto field_index_iter =
-                scalar_indexings_.withRLock([&](auto& mapping) {
-                    auto iter = mapping.find(field_id);
-                    AssertInfo(iter != mapping.end(),
-                               "failed to create text index, neither "
-                               "raw data nor "
-                               "index are found");
-                    return iter;
-                });
+            auto catalog = this->catalog();
+            auto field_index_iter = catalog->scalar_indexings.find(field_id);
+            AssertInfo(field_index_iter != catalog->scalar_indexings.end(),
+                       "failed to create text index, neither "
+                       "raw data nor "
+                       "index are found");
             auto accessor =
                 SemiInlineGet(field_index_iter->second->PinCells(nullptr, {0}));
             auto ptr = accessor->get_cell_of(0);
@@ -1900,6 +2226,7 @@ ChunkedSegmentSealedImpl::LoadTextIndex(
     CheckCancellation(op_ctx, id_, "ChunkedSegmentSealedImpl::LoadTextIndex()");
 
     std::unique_lock lck(mutex_);
+    ++generation_;
 
     milvus::storage::FieldDataMeta field_data_meta{info_proto->collectionid(),
                                                    info_proto->partitionid(),
@@ -1958,7 +2285,7 @@ ChunkedSegmentSealedImpl::get_raw_data(milvus::OpContext* op_ctx,
                                        const FieldMeta& field_meta,
                                        const int64_t* seg_offsets,
                                        int64_t count) const {
-    // DO NOT directly access the column by map like: `fields_.at(field_id)->Data()`,
+    // DO NOT directly access the column by map like: `fields.at(field_id)->Data()`,
     // we have to clone the shared pointer,
     // to make sure it won't get released if segment released
     auto column = get_column(field_id);
@@ -2374,9 +2701,8 @@ ChunkedSegmentSealedImpl::HasRawData(int64_t field_id) const {
     } else if (IsJsonDataType(field_meta.get_data_type())) {
         return get_bit(field_data_ready_bitset_, fieldID);
     } else {
-        auto has_scalar_index = scalar_indexings_.withRLock([&](auto& mapping) {
-            return mapping.find(fieldID) != mapping.end();
-        });
+        auto has_scalar_index =
+            catalog()->scalar_indexings.count(fieldID) > 0;
         if (has_scalar_index) {
             AssertInfo(
                 index_has_raw_data_.find(fieldID) != index_has_raw_data_.end(),
@@ -2458,6 +2784,7 @@ void
 ChunkedSegmentSealedImpl::LoadSegmentMeta(
     const proto::segcore::LoadSegmentMeta& segment_meta) {
     std::unique_lock lck(mutex_);
+    ++generation_;
     std::vector<int64_t> slice_lengths;
     for (auto& info : segment_meta.metas()) {
         slice_lengths.push_back(info.row_count());
@@ -2476,31 +2803,49 @@ void
 ChunkedSegmentSealedImpl::mask_with_timestamps(BitsetTypeView& bitset_chunk,
                                                Timestamp timestamp,
                                                Timestamp collection_ttl) const {
-    // TODO change the
-    AssertInfo(insert_record_.timestamps_.num_chunk() == 1,
-               "num chunk not equal to 1 for sealed segment");
-    auto timestamps_data =
-        (const milvus::Timestamp*)insert_record_.timestamps_.get_chunk_data(0);
-    auto timestamps_data_size = insert_record_.timestamps_.get_chunk_size(0);
+    // the timestamps are compared packed, like TimestampIndex does on the
+    // raw ones. Decided rows are set straight into bitset_chunk, and of the
+    // undecided slice only the pages whose min and max timestamps straddle
+    // the bound are compared, through a mask of their own.
+    using PageState = TimestampIndex::PageState;
+    const auto& timestamps = insert_record_.timestamps_;
+    const auto& timestamp_index = insert_record_.timestamp_index_;
+    auto timestamps_data_size = timestamps.size();
+    const int64_t size =
+        std::min<int64_t>(bitset_chunk.size(), timestamps_data_size);
     if (collection_ttl > 0) {
-        auto range =
-            insert_record_.timestamp_index_.get_active_range(collection_ttl);
+        auto range = timestamp_index.get_active_range(collection_ttl);
         if (range.first == range.second &&
             range.first == timestamps_data_size) {
             bitset_chunk.set();
             return;
-        } else {
-            auto ttl_mask = TimestampIndex::GenerateTTLBitset(
-                timestamps_data, timestamps_data_size, collection_ttl, range);
-            bitset_chunk |= ttl_mask;
         }
+        // rows [0, beg) are expired, rows [end, size) are not
+        auto beg = std::min(range.first, size);
+        auto end = std::min(range.second, size);
+        bitset_chunk.set(0, beg);
+        timestamp_index.for_each_page_run(
+            collection_ttl,
+            beg,
+            end,
+            [&](int64_t run_beg, int64_t run_end, PageState state) {
+                if (state == PageState::AllLessEqual) {
+                    bitset_chunk.set(run_beg, run_end - run_beg);
+                } else if (state == PageState::Straddling) {
+                    BitsetType ttl_mask(run_end - run_beg);
+                    timestamps.LessEqual(
+                        collection_ttl, run_beg, run_end, ttl_mask.view());
+                    bitset_chunk.view(run_beg, run_end - run_beg)
+                        .inplace_or(ttl_mask, run_end - run_beg);
+                }
+            });
     }
 
     AssertInfo(timestamps_data_size == get_row_count(),
                fmt::format("Timestamp size not equal to row count: {}, {}",
                            timestamps_data_size,
                            get_row_count()));
-    auto range = insert_record_.timestamp_index_.get_active_range(timestamp);
+    auto range = timestamp_index.get_active_range(timestamp);
 
     // range == (size_, size_) and size_ is this->timestamps_.size().
     // it means these data are all useful, we don't need to update bitset_chunk.
@@ -2515,14 +2860,44 @@ ChunkedSegmentSealedImpl::mask_with_timestamps(BitsetTypeView& bitset_chunk,
         bitset_chunk.set();
         return;
     }
-    auto mask = TimestampIndex::GenerateBitset(
-        timestamp, range, timestamps_data, timestamps_data_size);
-    bitset_chunk |= mask;
+    // rows [end, size) are inserted after timestamp
+    auto beg = std::min(range.first, size);
+    auto end = std::min(range.second, size);
+    bitset_chunk.set(end, size - end);
+    timestamp_index.for_each_page_run(
+        timestamp,
+        beg,
+        end,
+        [&](int64_t run_beg, int64_t run_end, PageState state) {
+            if (state == PageState::AllGreater) {
+                bitset_chunk.set(run_beg, run_end - run_beg);
+            } else if (state == PageState::Straddling) {
+                BitsetType mask(run_end - run_beg);
+                timestamps.GreaterThan(
+                    timestamp, run_beg, run_end, mask.view());
+                bitset_chunk.view(run_beg, run_end - run_beg)
+                    .inplace_or(mask, run_end - run_beg);
+            }
+        });
 }
 
 bool
-ChunkedSegmentSealedImpl::generate_interim_index(const FieldId field_id,
-                                                 int64_t num_rows) {
+ChunkedSegmentSealedImpl::all_visible_at(Timestamp timestamp,
+                                         Timestamp collection_ttl) const {
+    const auto& timestamp_index = insert_record_.timestamp_index_;
+    int64_t size = insert_record_.timestamps_.size();
+    // get_active_range() leaves rows [0, beg) not greater than the bound and
+    // rows [end, size) greater than it
+    if (timestamp_index.get_active_range(timestamp).first != size) {
+        return false;
+    }
+    return collection_ttl == 0 ||
+           timestamp_index.get_active_range(collection_ttl).second == 0;
+}
+
+bool
+ChunkedSegmentSealedImpl::generate_interim_index(
+    const FieldId field_id, int64_t num_rows, const std::string& data_version) {
     if (col_index_meta_ == nullptr || !col_index_meta_->HasField(field_id)) {
         return false;
     }
@@ -2594,6 +2969,7 @@ ChunkedSegmentSealedImpl::generate_interim_index(const FieldId field_id,
 
         if (enable_binlog_index()) {
             std::unique_lock lck(mutex_);
+            ++generation_;
 
             std::unique_ptr<
                 milvus::cachinglayer::Translator<milvus::index::IndexBase>>
@@ -2608,7 +2984,8 @@ ChunkedSegmentSealedImpl::generate_interim_index(const FieldId field_id,
                         build_config,
                         dim,
                         is_sparse,
-                        field_meta.get_data_type());
+                        field_meta.get_data_type(),
+                        data_version);
 
             auto interim_index_cache_slot =
                 milvus::cachinglayer::Manager::GetInstance().CreateCacheSlot(
@@ -2676,25 +3053,26 @@ ChunkedSegmentSealedImpl::load_field_data_common(
     bool enable_mmap,
     bool is_proxy_column,
     std::optional<ParquetStatistics> statistics,
-    milvus::OpContext* op_ctx) {
+    milvus::OpContext* op_ctx,
+    const std::string& data_version) {
     {
         std::unique_lock lck(mutex_);
+        ++generation_;
         AssertInfo(SystemProperty::Instance().IsSystem(field_id) ||
                        !get_bit(field_data_ready_bitset_, field_id),
                    "non system field {} data already loaded",
                    field_id.get());
-        bool already_exists = false;
-        fields_.withRLock([&](auto& fields) {
-            already_exists = fields.find(field_id) != fields.end();
+        AssertInfo(catalog()->fields.count(field_id) == 0,
+                   "field {} column already exists",
+                   field_id.get());
+        update_catalog([&](SealedCatalog& catalog) {
+            catalog.fields.emplace(field_id, column);
         });
-        AssertInfo(
-            !already_exists, "field {} column already exists", field_id.get());
-        fields_.wlock()->emplace(field_id, column);
         if (enable_mmap) {
             mmap_field_ids_.insert(field_id);
         }
     }
-    // system field only needs to emplace column to fields_ map
+    // system field only needs to emplace column to the catalog
     if (SystemProperty::Instance().IsSystem(field_id)) {
         return;
     }
@@ -2722,6 +3100,9 @@ ChunkedSegmentSealedImpl::load_field_data_common(
         } else {
             LoadSkipIndex(field_id, data_type, column);
         }
+    } else if (data_type == DataType::ARRAY) {
+        // parquet keeps no statistics for the elements of a list
+        LoadSkipIndex(field_id, data_type, column);
     }
 
     // set pks to offset
@@ -2734,13 +3115,15 @@ ChunkedSegmentSealedImpl::load_field_data_common(
         insert_record_.seal_pks();
     }
 
-    bool generated_interim_index = generate_interim_index(field_id, num_rows);
+    bool generated_interim_index =
+        generate_interim_index(field_id, num_rows, data_version);
 
     std::string struct_name;
     const FieldMeta* field_meta_ptr = nullptr;
 
     {
         std::unique_lock lck(mutex_);
+        ++generation_;
         AssertInfo(!get_bit(field_data_ready_bitset_, field_id),
                    "field {} data already loaded",
                    field_id.get());
@@ -2784,6 +3167,7 @@ ChunkedSegmentSealedImpl::load_field_data_common(
             ArrayOffsetsSealed::BuildFromSegment(this, *field_meta_ptr);
 
         std::unique_lock lck(mutex_);
+        ++generation_;
         // Double-check after re-acquiring lock
         auto it = struct_to_array_offsets_.find(struct_name);
         if (it == struct_to_array_offsets_.end()) {
@@ -2808,6 +3192,7 @@ ChunkedSegmentSealedImpl::init_timestamp_index(
 
     // use special index
     std::unique_lock lck(mutex_);
+    ++generation_;
     AssertInfo(insert_record_.timestamps_.empty(), "already exists");
     insert_record_.init_timestamps(timestamps, index);
     stats_.mem_size += sizeof(Timestamp) * num_rows;
@@ -2816,6 +3201,7 @@ ChunkedSegmentSealedImpl::init_timestamp_index(
 void
 ChunkedSegmentSealedImpl::Reopen(SchemaPtr sch) {
     std::unique_lock lck(mutex_);
+    ++generation_;
 
     field_data_ready_bitset_.resize(sch->size());
     index_ready_bitset_.resize(sch->size());
@@ -2835,6 +3221,7 @@ ChunkedSegmentSealedImpl::Reopen(
     SegmentLoadInfo new_seg_load_info(new_load_info, schema_);
 
     std::unique_lock lck(mutex_);
+    ++generation_;
     SegmentLoadInfo current(segment_load_info_);
     segment_load_info_ = new_seg_load_info;
     lck.unlock();
@@ -2853,20 +3240,28 @@ ChunkedSegmentSealedImpl::ApplyLoadDiff(SegmentLoadInfo& segment_load_info,
                                         milvus::OpContext* op_ctx) {
     // TODO: pass trace_ctx separately when needed
     milvus::tracer::TraceContext trace_ctx;
+    SegmentLoadPlanner planner(id_);
+    FieldLoadTasks field_tasks;
     if (!diff.indexes_to_load.empty()) {
-        LoadBatchIndexes(trace_ctx, diff.indexes_to_load, op_ctx);
+        LoadBatchIndexes(
+            trace_ctx, diff.indexes_to_load, planner, field_tasks, op_ctx);
     }
 
     // reload fields
+    std::vector<SegmentLoadPlanner::TaskId> reload_tasks;
     if (!diff.fields_to_reload.empty()) {
-        ReloadColumns(diff.fields_to_reload, op_ctx);
+        reload_tasks = ReloadColumns(diff.fields_to_reload, planner, op_ctx);
     }
 
     // drop index, must after reload binlog
-    if (!diff.indexes_to_drop.empty()) {
-        for (auto field_id : diff.indexes_to_drop) {
-            DropIndex(field_id);
-        }
+    for (auto field_id : diff.indexes_to_drop) {
+        auto task = planner.AddTask(
+            fmt::format("drop index {}", field_id.get()),
+            LoadTaskPriority::SYSTEM,
+            0,
+            [this, field_id]() { DropIndex(field_id); },
+            reload_tasks);
+        field_tasks[field_id].push_back(task);
     }
 
     // load column groups
@@ -2884,6 +3279,8 @@ ChunkedSegmentSealedImpl::ApplyLoadDiff(SegmentLoadInfo& segment_load_info,
                              properties,
                              diff.column_groups_to_load,
                              true,
+                             planner,
+                             field_tasks,
                              op_ctx);
         }
         if (!diff.column_groups_to_lazyload.empty()) {
@@ -2891,15 +3288,21 @@ ChunkedSegmentSealedImpl::ApplyLoadDiff(SegmentLoadInfo& segment_load_info,
                              properties,
                              diff.column_groups_to_lazyload,
                              false,
+                             planner,
+                             field_tasks,
                              op_ctx);
         }
     }
 
     // load field binlog
     if (!diff.binlogs_to_load.empty()) {
-        LoadBatchFieldData(trace_ctx, diff.binlogs_to_load, op_ctx);
+        LoadBatchFieldData(
+            trace_ctx, diff.binlogs_to_load, planner, field_tasks, op_ctx);
     }
 
+    LOG_INFO("segment {} plans {} load tasks", id_, planner.TaskCount());
+    planner.Run(ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE));
+
     // fill default values for fields without data sources (schema evolution)
     if (!diff.fields_to_fill_default.empty()) {
         FillDefaultValueFields(diff.fields_to_fill_default);
@@ -2957,7 +3360,10 @@ ChunkedSegmentSealedImpl::fill_empty_field(const FieldMeta& field_meta) {
         column->BuildValidRowIds(nullptr);
     }
 
-    fields_.wlock()->emplace(field_id, column);
+    update_catalog([&](SealedCatalog& catalog) {
+        catalog.fields.emplace(field_id, column);
+        catalog.default_value_fields.insert(field_id);
+    });
     set_bit(field_data_ready_bitset_, field_id, true);
     LOG_INFO(
         "fill empty field {} (data type {}) for growing segment {} "
@@ -2971,6 +3377,7 @@ void
 ChunkedSegmentSealedImpl::FillDefaultValueFields(
     const std::vector<FieldId>& field_ids) {
     std::unique_lock lck(mutex_);
+    ++generation_;
     for (const auto& field_id : field_ids) {
         // Skip if field data already loaded
         if (get_bit(field_data_ready_bitset_, field_id)) {
@@ -3036,6 +3443,7 @@ void
 ChunkedSegmentSealedImpl::SetLoadInfo(
     const proto::segcore::SegmentLoadInfo& load_info) {
     std::unique_lock lck(mutex_);
+    ++generation_;
     segment_load_info_ = SegmentLoadInfo(load_info, schema_);
     LOG_INFO(
         "SetLoadInfo for segment {}, num_rows: {}, index count: {}, "
@@ -3052,35 +3460,48 @@ ChunkedSegmentSealedImpl::LoadColumnGroups(
     const std::shared_ptr<milvus_storage::api::Properties>& properties,
     std::vector<std::pair<int, std::vector<FieldId>>>& cg_field_ids,
     bool eager_load,
+    SegmentLoadPlanner& planner,
+    const FieldLoadTasks& field_tasks,
     milvus::OpContext* op_ctx) {
-    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
-    std::vector<std::future<void>> load_group_futures;
     for (const auto& pair : cg_field_ids) {
         auto cg_index = pair.first;
         const auto& field_ids = pair.second;
-        auto future = pool.Submit([this,
-                                   column_groups,
-                                   properties,
-                                   cg_index,
-                                   field_ids,
-                                   eager_load,
-                                   op_ctx]() {
-            // Early exit if cancelled while queued
-            CheckCancellation(op_ctx,
-                              id_,
-                              cg_index,
-                              "ChunkedSegmentSealedImpl::LoadColumnGroup()");
-            LoadColumnGroup(column_groups,
-                            properties,
-                            cg_index,
-                            field_ids,
-                            eager_load,
-                            op_ctx);
-        });
-        load_group_futures.emplace_back(std::move(future));
+        std::vector<SegmentLoadPlanner::TaskId> dependencies;
+        for (const auto& field_id : field_ids) {
+            auto iter = field_tasks.find(field_id);
+            if (iter != field_tasks.end()) {
+                dependencies.insert(dependencies.end(),
+                                    iter->second.begin(),
+                                    iter->second.end());
+            }
+        }
+        // the size of a column group is not known before it is opened
+        planner.AddTask(
+            fmt::format("column group {}", cg_index),
+            load_task_priority(field_ids, false),
+            0,
+            [this,
+             column_groups,
+             properties,
+             cg_index,
+             field_ids,
+             eager_load,
+             op_ctx]() {
+                // Early exit if cancelled while queued
+                CheckCancellation(
+                    op_ctx,
+                    id_,
+                    cg_index,
+                    "ChunkedSegmentSealedImpl::LoadColumnGroup()");
+                LoadColumnGroup(column_groups,
+                                properties,
+                                cg_index,
+                                field_ids,
+                                eager_load,
+                                op_ctx);
+            },
+            dependencies);
     }
-
-    storage::WaitAllFutures(load_group_futures);
 }
 
 void
@@ -3171,8 +3592,10 @@ ChunkedSegmentSealedImpl::LoadColumnGroup(
             segment_load_info_.GetPriority(),
             eager_load,
             warmup_policy);
+    auto hot_cells_key = translator->key();
     auto chunked_column_group =
         std::make_shared<ChunkedColumnGroup>(std::move(translator));
+    chunked_column_group->TrackHotCells(hot_cells_key);
 
     // Create ProxyChunkColumn for each field
     for (const auto& field_id : milvus_field_ids) {
@@ -3190,7 +3613,8 @@ ChunkedSegmentSealedImpl::LoadColumnGroup(
             true,
             std::
                 nullopt,  // manifest cannot provide parquet skip index directly
-            op_ctx);
+            op_ctx,
+            fmt::format("{}#{}", segment_load_info_.GetManifestPath(), index));
         if (field_id == TimestampFieldID) {
             auto timestamp_proxy_column = get_column(TimestampFieldID);
             AssertInfo(timestamp_proxy_column != nullptr,
@@ -3222,28 +3646,32 @@ ChunkedSegmentSealedImpl::LoadColumnGroup(
     }
 }
 
-void
+std::vector<SegmentLoadPlanner::TaskId>
 ChunkedSegmentSealedImpl::ReloadColumns(const std::vector<FieldId>& field_ids,
+                                        SegmentLoadPlanner& planner,
                                         milvus::OpContext* op_ctx) {
-    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
-    std::vector<std::future<void>> reload_futures;
+    std::vector<SegmentLoadPlanner::TaskId> reload_tasks;
     for (auto& field_id : field_ids) {
-        auto future = pool.Submit([this, field_id, op_ctx]() {
-            auto column = get_column(field_id);
-            AssertInfo(column != nullptr,
-                       "cannot reload non-existing field column {}",
-                       field_id.get());
-            auto num_chunks = column->num_chunks();
-            std::vector<int64_t> chunk_ids(num_chunks);
-            for (int64_t chunk_id = 0; chunk_id < num_chunks; chunk_id++) {
-                chunk_ids[chunk_id] = chunk_id;
-            }
-            column->PrefetchChunks(op_ctx, chunk_ids);
-        });
-        reload_futures.push_back(std::move(future));
+        auto task = planner.AddTask(
+            fmt::format("reload field {}", field_id.get()),
+            load_task_priority({field_id}, false),
+            0,
+            [this, field_id, op_ctx]() {
+                auto column = get_column(field_id);
+                AssertInfo(column != nullptr,
+                           "cannot reload non-existing field column {}",
+                           field_id.get());
+                auto num_chunks = column->num_chunks();
+                std::vector<int64_t> chunk_ids(num_chunks);
+                for (int64_t chunk_id = 0; chunk_id < num_chunks;
+                     chunk_id++) {
+                    chunk_ids[chunk_id] = chunk_id;
+                }
+                column->PrefetchChunks(op_ctx, chunk_ids);
+            });
+        reload_tasks.push_back(task);
     }
-
-    storage::WaitAllFutures(reload_futures);
+    return reload_tasks;
 }
 
 void
@@ -3251,43 +3679,47 @@ ChunkedSegmentSealedImpl::LoadBatchIndexes(
     milvus::tracer::TraceContext& trace_ctx,
     std::unordered_map<FieldId, std::vector<LoadIndexInfo>>&
         field_id_to_index_info,
+    SegmentLoadPlanner& planner,
+    FieldLoadTasks& field_tasks,
     milvus::OpContext* op_ctx) {
     auto num_rows = segment_load_info_.GetNumOfRows();
-    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
-    std::vector<std::future<void>> load_index_futures;
-    load_index_futures.reserve(field_id_to_index_info.size());
-
     for (auto& pair : field_id_to_index_info) {
         auto field_id = pair.first;
         auto& index_infos = pair.second;
+        auto priority = load_task_priority({field_id}, true);
         for (auto& load_index_info : index_infos) {
             auto* load_index_info_ptr = &load_index_info;
-            auto future = pool.Submit([this,
-                                       trace_ctx,
-                                       field_id,
-                                       load_index_info_ptr,
-                                       num_rows,
-                                       op_ctx]() mutable -> void {
-                // Early exit if cancelled while queued
-                CheckCancellation(op_ctx, id_, field_id.get(), "LoadIndex");
-
-                LOG_INFO("Loading index for segment {} field {} with {} files",
-                         id_,
-                         field_id.get(),
-                         load_index_info_ptr->index_files.size());
+            auto task = planner.AddTask(
+                fmt::format("index {} of field {}",
+                            load_index_info.index_id,
+                            field_id.get()),
+                priority,
+                load_index_info.index_size,
+                [this,
+                 trace_ctx,
+                 field_id,
+                 load_index_info_ptr,
+                 num_rows,
+                 op_ctx]() mutable -> void {
+                    // Early exit if cancelled while queued
+                    CheckCancellation(
+                        op_ctx, id_, field_id.get(), "LoadIndex");
 
-                // Download & compose index
-                LoadIndexData(trace_ctx, load_index_info_ptr, op_ctx);
+                    LOG_INFO(
+                        "Loading index for segment {} field {} with {} files",
+                        id_,
+                        field_id.get(),
+                        load_index_info_ptr->index_files.size());
 
-                // Load index into segment
-                LoadIndex(*load_index_info_ptr);
-            });
+                    // Download & compose index
+                    LoadIndexData(trace_ctx, load_index_info_ptr, op_ctx);
 
-            load_index_futures.push_back(std::move(future));
+                    // Load index into segment
+                    LoadIndex(*load_index_info_ptr);
+                });
+            field_tasks[field_id].push_back(task);
         }
     }
-
-    storage::WaitAllFutures(load_index_futures);
 }
 
 void
@@ -3295,16 +3727,17 @@ ChunkedSegmentSealedImpl::LoadBatchFieldData(
     milvus::tracer::TraceContext& trace_ctx,
     std::vector<std::pair<std::vector<FieldId>, proto::segcore::FieldBinlog>>&
         field_binlog_to_load,
+    SegmentLoadPlanner& planner,
+    const FieldLoadTasks& field_tasks,
     milvus::OpContext* op_ctx) {
     LOG_INFO("Loading field binlog for {} fields in segment {}",
              field_binlog_to_load.size(),
              id_);
 
-    std::map<FieldId, LoadFieldDataInfo> field_data_to_load;
-    for (auto& [field_ids, field_binlog] : field_binlog_to_load) {
-        LoadFieldDataInfo load_field_data_info;
-        load_field_data_info.storage_version =
-            segment_load_info_.GetStorageVersion();
+    // group id -> the binlogs to load, the last one of a group wins
+    std::map<int64_t, size_t> groups_to_load;
+    for (size_t i = 0; i < field_binlog_to_load.size(); i++) {
+        auto& [field_ids, field_binlog] = field_binlog_to_load[i];
         // when child fields specified, field id is group id, child field ids are actual id values here
         if (field_binlog.child_fields_size() > 0) {
             field_ids.reserve(field_binlog.child_fields_size());
@@ -3314,116 +3747,162 @@ ChunkedSegmentSealedImpl::LoadBatchFieldData(
         } else {
             field_ids.emplace_back(field_binlog.fieldid());
         }
+        groups_to_load[field_binlog.fieldid()] = i;
+    }
 
-        bool index_has_raw_data = true;
-        bool has_mmap_setting = false;
-        bool mmap_enabled = false;
-        bool is_vector = false;
+    for (const auto& [group_id, i] : groups_to_load) {
+        const auto* field_ids = &field_binlog_to_load[i].first;
+        const auto* field_binlog = &field_binlog_to_load[i].second;
 
-        bool has_warmup_setting = false;
-        bool warmup_sync = false;
-        for (const auto& child_field_id : field_ids) {
-            auto& field_meta = schema_->operator[](child_field_id);
-            if (IsVectorDataType(field_meta.get_data_type())) {
-                is_vector = true;
+        std::vector<SegmentLoadPlanner::TaskId> dependencies;
+        for (const auto& field_id : *field_ids) {
+            auto iter = field_tasks.find(field_id);
+            if (iter != field_tasks.end()) {
+                dependencies.insert(dependencies.end(),
+                                    iter->second.begin(),
+                                    iter->second.end());
             }
+        }
+        int64_t memory_size = 0;
+        for (const auto& binlog : field_binlog->binlogs()) {
+            memory_size += binlog.memory_size();
+        }
+
+        // whether the index has raw data is only known once the indexes of
+        // the fields are loaded, so the load info is built in the task
+        auto group_id_copy = group_id;
+        planner.AddTask(
+            fmt::format("binlog of field {}", group_id),
+            load_task_priority(*field_ids, false),
+            memory_size,
+            [this, field_ids, field_binlog, group_id_copy, op_ctx]() {
+                // Early exit if cancelled while queued
+                CheckCancellation(op_ctx,
+                                  id_,
+                                  group_id_copy,
+                                  "ChunkedSegmentSealedImpl::LoadFieldData()");
+                auto load_field_data_info =
+                    build_load_field_data_info(*field_ids, *field_binlog);
+                if (load_field_data_info.has_value()) {
+                    LoadFieldData(load_field_data_info.value(), op_ctx);
+                }
+            },
+            dependencies);
+    }
+}
+
+std::optional<LoadFieldDataInfo>
+ChunkedSegmentSealedImpl::build_load_field_data_info(
+    const std::vector<FieldId>& field_ids,
+    const proto::segcore::FieldBinlog& field_binlog) {
+    LoadFieldDataInfo load_field_data_info;
+    load_field_data_info.storage_version =
+        segment_load_info_.GetStorageVersion();
+
+    bool index_has_raw_data = true;
+    bool has_mmap_setting = false;
+    bool mmap_enabled = false;
+    bool is_vector = false;
 
-            // if field has mmap setting, use it
-            // - mmap setting at collection level, then all field are the same
-            // - mmap setting at field level, we define that as long as one field shall be mmap, then whole group shall be mmaped
-            auto [field_has_setting, field_mmap_enabled] =
-                schema_->MmapEnabled(child_field_id);
-            has_mmap_setting = has_mmap_setting || field_has_setting;
-            mmap_enabled = mmap_enabled || field_mmap_enabled;
+    bool has_warmup_setting = false;
+    bool warmup_sync = false;
+    for (const auto& child_field_id : field_ids) {
+        auto& field_meta = schema_->operator[](child_field_id);
+        if (IsVectorDataType(field_meta.get_data_type())) {
+            is_vector = true;
+        }
 
+        // if field has mmap setting, use it
+        // - mmap setting at collection level, then all field are the same
+        // - mmap setting at field level, we define that as long as one field shall be mmap, then whole group shall be mmaped
+        auto [field_has_setting, field_mmap_enabled] =
+            schema_->MmapEnabled(child_field_id);
+        has_mmap_setting = has_mmap_setting || field_has_setting;
+        mmap_enabled = mmap_enabled || field_mmap_enabled;
+
+        {
+            // indexes of other fields may be loading concurrently
+            std::shared_lock lck(mutex_);
             auto iter = index_has_raw_data_.find(child_field_id);
             if (iter != index_has_raw_data_.end()) {
                 index_has_raw_data = index_has_raw_data && iter->second;
             } else {
                 index_has_raw_data = false;
             }
-
-            auto [field_has_warmup, field_warmup_policy] =
-                schema_->WarmupPolicy(
-                    child_field_id,
-                    IsVectorDataType(field_meta.get_data_type()),
-                    /*is_index=*/false);
-            if (field_has_warmup) {
-                has_warmup_setting = true;
-                warmup_sync = warmup_sync || (field_warmup_policy == "sync");
-            }
         }
 
-        auto group_id = field_binlog.fieldid();
-        // Skip if this field has an index with raw data
-        if (index_has_raw_data) {
-            LOG_INFO(
-                "Skip loading fielddata for segment {} group {} because "
-                "index "
-                "has raw data",
-                id_,
-                group_id);
-            continue;
+        auto [field_has_warmup, field_warmup_policy] = schema_->WarmupPolicy(
+            child_field_id,
+            IsVectorDataType(field_meta.get_data_type()),
+            /*is_index=*/false);
+        if (field_has_warmup) {
+            has_warmup_setting = true;
+            warmup_sync = warmup_sync || (field_warmup_policy == "sync");
         }
+    }
 
-        // Build FieldBinlogInfo
-        FieldBinlogInfo field_binlog_info;
-        field_binlog_info.field_id = group_id;
-
-        // Calculate total row count and collect binlog paths
-        int64_t total_entries = 0;
-        auto binlog_count = field_binlog.binlogs().size();
-        field_binlog_info.insert_files.reserve(binlog_count);
-        field_binlog_info.entries_nums.reserve(binlog_count);
-        field_binlog_info.memory_sizes.reserve(binlog_count);
-        for (const auto& binlog : field_binlog.binlogs()) {
-            field_binlog_info.insert_files.push_back(binlog.log_path());
-            field_binlog_info.entries_nums.push_back(binlog.entries_num());
-            field_binlog_info.memory_sizes.push_back(binlog.memory_size());
-            total_entries += binlog.entries_num();
-        }
-        field_binlog_info.row_count = total_entries;
-
-        auto& mmap_config = storage::MmapManager::GetInstance().GetMmapConfig();
-        auto global_use_mmap = is_vector
-                                   ? mmap_config.GetVectorFieldEnableMmap()
-                                   : mmap_config.GetScalarFieldEnableMmap();
-        field_binlog_info.enable_mmap =
-            has_mmap_setting ? mmap_enabled : global_use_mmap;
-
-        // Determine group warmup policy: use per-field settings if any,
-        // otherwise fall back to global warmup policy
-        field_binlog_info.warmup_policy =
-            has_warmup_setting ? (warmup_sync ? "sync" : "disable") : "";
-
-        // Store in map
-        load_field_data_info.field_infos[group_id] = field_binlog_info;
-
-        field_data_to_load[FieldId(group_id)] = load_field_data_info;
-    }
-
-    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
-    std::vector<std::future<void>> load_field_futures;
-    load_field_futures.reserve(field_data_to_load.size());
-
-    for (const auto& [field_id, load_field_data_info] : field_data_to_load) {
-        // Create local copies to capture in lambda (C++17 compatible)
-        const auto field_data = load_field_data_info;
-        const auto captured_field_id = field_id;
-        auto future = pool.Submit(
-            [this, field_data, captured_field_id, op_ctx]() -> void {
-                // Early exit if cancelled while queued
-                CheckCancellation(op_ctx,
-                                  id_,
-                                  captured_field_id.get(),
-                                  "ChunkedSegmentSealedImpl::LoadFieldData()");
-                LoadFieldData(field_data, op_ctx);
-            });
+    auto group_id = field_binlog.fieldid();
+    // Skip if this field has an index with raw data
+    if (index_has_raw_data) {
+        LOG_INFO(
+            "Skip loading fielddata for segment {} group {} because "
+            "index "
+            "has raw data",
+            id_,
+            group_id);
+        return std::nullopt;
+    }
 
-        load_field_futures.push_back(std::move(future));
+    // Build FieldBinlogInfo
+    FieldBinlogInfo field_binlog_info;
+    field_binlog_info.field_id = group_id;
+
+    // Calculate total row count and collect binlog paths
+    int64_t total_entries = 0;
+    auto binlog_count = field_binlog.binlogs().size();
+    field_binlog_info.insert_files.reserve(binlog_count);
+    field_binlog_info.entries_nums.reserve(binlog_count);
+    field_binlog_info.memory_sizes.reserve(binlog_count);
+    for (const auto& binlog : field_binlog.binlogs()) {
+        field_binlog_info.insert_files.push_back(binlog.log_path());
+        field_binlog_info.entries_nums.push_back(binlog.entries_num());
+        field_binlog_info.memory_sizes.push_back(binlog.memory_size());
+        total_entries += binlog.entries_num();
     }
+    field_binlog_info.row_count = total_entries;
+
+    auto& mmap_config = storage::MmapManager::GetInstance().GetMmapConfig();
+    auto global_use_mmap = is_vector ? mmap_config.GetVectorFieldEnableMmap()
+                                     : mmap_config.GetScalarFieldEnableMmap();
+    field_binlog_info.enable_mmap =
+        has_mmap_setting ? mmap_enabled : global_use_mmap;
+
+    // Determine group warmup policy: use per-field settings if any,
+    // otherwise fall back to global warmup policy
+    field_binlog_info.warmup_policy =
+        has_warmup_setting ? (warmup_sync ? "sync" : "disable") : "";
 
-    storage::WaitAllFutures(load_field_futures);
+    load_field_data_info.field_infos[group_id] = field_binlog_info;
+    return load_field_data_info;
+}
+
+LoadTaskPriority
+ChunkedSegmentSealedImpl::load_task_priority(
+    const std::vector<FieldId>& field_ids, bool is_index) const {
+    auto primary_field_id = schema_->get_primary_field_id();
+    bool is_vector = false;
+    for (const auto& field_id : field_ids) {
+        if (SystemProperty::Instance().IsSystem(field_id) ||
+            field_id == primary_field_id) {
+            return LoadTaskPriority::SYSTEM;
+        }
+        is_vector = is_vector || schema_->operator[](field_id).is_vector();
+    }
+    if (is_vector) {
+        return LoadTaskPriority::VECTOR;
+    }
+    return is_index ? LoadTaskPriority::SCALAR_INDEX
+                    : LoadTaskPriority::SCALAR_DATA;
 }
 
 void
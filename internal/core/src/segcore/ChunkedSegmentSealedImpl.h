@@ -16,8 +16,11 @@
 #include <folly/Synchronized.h>
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -36,6 +39,7 @@
 #include "cachinglayer/CacheSlot.h"
 #include "parquet/statistics.h"
 #include "segcore/IndexConfigGenerator.h"
+#include "segcore/PartitionKeyRows.h"
 #include "segcore/SegcoreConfig.h"
 #include "folly/concurrency/ConcurrentHashMap.h"
 #include "index/json_stats/JsonKeyStats.h"
@@ -43,15 +47,38 @@
 #include "pb/common.pb.h"
 #include "milvus-storage/reader.h"
 #include "segcore/SegmentLoadInfo.h"
+#include "segcore/SegmentLoadPlanner.h"
 
 namespace milvus::segcore {
 
+class SegmentGrowingImpl;
+
 namespace storagev1translator {
 class InsertRecordTranslator;
 }
 
 using namespace milvus::cachinglayer;
 
+// The columns and scalar indexes of a sealed segment. A published catalog
+// is never changed: a load or drop copies it, changes the copy and
+// publishes the copy, so a reader takes one snapshot without a lock and
+// works on it while the segment changes.
+struct SealedCatalog {
+    std::unordered_map<FieldId, std::shared_ptr<ChunkedColumnInterface>>
+        fields;
+    // fields filled by fill_empty_field, all rows of which are the default
+    std::unordered_set<FieldId> default_value_fields;
+    // scalar field index
+    std::unordered_map<FieldId, index::CacheIndexBasePtr> scalar_indexings;
+    // fields that has ngram index
+    std::unordered_set<FieldId> ngram_fields;
+    // ngram indexings for json type
+    std::unordered_map<
+        FieldId,
+        std::unordered_map<std::string, index::CacheIndexBasePtr>>
+        ngram_indexings;
+};
+
 class ChunkedSegmentSealedImpl : public SegmentSealed {
  public:
     using ParquetStatistics = std::vector<std::shared_ptr<parquet::Statistics>>;
@@ -61,11 +88,31 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                                       int64_t segment_id,
                                       bool is_sorted_by_pk = false);
     ~ChunkedSegmentSealedImpl() override;
+
+    using SegmentInternalInterface::Search;
+
+    // serves the repeated searches from the SearchResCacheManager when it
+    // is enabled
+    std::unique_ptr<SearchResult>
+    Search(const query::Plan* plan,
+           const query::PlaceholderGroup* placeholder_group,
+           Timestamp timestamp,
+           const folly::CancellationToken& cancel_token,
+           int32_t consistency_level,
+           Timestamp collection_ttl) const override;
+
     void
     LoadIndex(const LoadIndexInfo& info) override;
     void
     LoadFieldData(const LoadFieldDataInfo& info,
                   milvus::OpContext* op_ctx = nullptr) override;
+    // Fills the segment with the rows of growing, a segment flushed as this
+    // one, from memory rather than from its binlogs. The chunks of the fixed
+    // width fields without nulls are borrowed as they are, which keeps
+    // growing alive, the other fields are copied. Indexes load as usual.
+    void
+    LoadFromGrowing(std::shared_ptr<const SegmentGrowingImpl> growing,
+                    milvus::OpContext* op_ctx = nullptr);
     void
     LoadDeletedRecord(const LoadDeletedRecordInfo& info) override;
     void
@@ -90,16 +137,15 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     PinIndex(milvus::OpContext* op_ctx,
              FieldId field_id,
              bool include_ngram = false) const override {
-        auto [scalar_indexings, ngram_fields] =
-            lock(folly::rlock(scalar_indexings_), folly::rlock(ngram_fields_));
+        auto catalog = this->catalog();
         if (!include_ngram) {
-            if (ngram_fields->find(field_id) != ngram_fields->end()) {
+            if (catalog->ngram_fields.count(field_id) > 0) {
                 return {};
             }
         }
 
-        auto iter = scalar_indexings->find(field_id);
-        if (iter == scalar_indexings->end()) {
+        auto iter = catalog->scalar_indexings.find(field_id);
+        if (iter == catalog->scalar_indexings.end()) {
             return {};
         }
         auto ca = SemiInlineGet(iter->second->PinCells(op_ctx, {0}));
@@ -148,6 +194,9 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     void
     LoadJsonStats(FieldId field_id,
                   std::shared_ptr<index::JsonKeyStats> stats) override {
+        if (json_key_layout_hints_ != nullptr && stats != nullptr) {
+            json_key_layout_hints_->Update(field_id, stats->GetShreddedKeys());
+        }
         std::unique_lock lck(mutex_);
         json_stats_[field_id] = stats;
     }
@@ -185,7 +234,7 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                     std::function<void(milvus::Json, size_t, bool)> fn,
                     const int64_t* offsets,
                     int64_t count) const override {
-        auto column = fields_.rlock()->at(field_id);
+        auto column = catalog()->fields.at(field_id);
         column->BulkRawJsonAt(op_ctx, fn, offsets, count);
     }
 
@@ -247,6 +296,15 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                     bool upper_inclusive,
                     BitsetTypeView& bitset) const override;
 
+    bool
+    has_partition_key_rows(FieldId field_id) const override;
+
+    void
+    partition_key_rows(milvus::OpContext* op_ctx,
+                       FieldId field_id,
+                       const std::vector<PkType>& keys,
+                       BitsetTypeView& bitset) const override;
+
     std::unique_ptr<DataArray>
     get_vector(milvus::OpContext* op_ctx,
                FieldId field_id,
@@ -304,6 +362,11 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     std::pair<std::vector<OffsetMap::OffsetType>, bool>
     find_first(int64_t limit, const BitsetTypeView& bitset) const override;
 
+    bool
+    find_first_in_row_order() const override {
+        return is_sorted_by_pk_;
+    }
+
     // Calculate: output[i] = Vec[seg_offset[i]]
     // where Vec is determined from field_offset
     std::unique_ptr<DataArray>
@@ -323,6 +386,11 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     bool
     is_mmap_field(FieldId id) const override;
 
+    bool
+    is_default_value_field(FieldId field_id) const override {
+        return catalog()->default_value_fields.count(field_id) > 0;
+    }
+
     void
     ClearData() override;
 
@@ -337,6 +405,17 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                     FieldId field_id,
                     const std::vector<int64_t>& chunk_ids) const override;
 
+    ContinueFuture
+    prefetch_chunks_async(
+        milvus::OpContext* op_ctx,
+        FieldId field_id,
+        const std::vector<int64_t>& chunk_ids) const override;
+
+    PinWrapper<const StringChunk*>
+    dict_string_chunk(milvus::OpContext* op_ctx,
+                      FieldId field_id,
+                      int64_t chunk_id) const override;
+
  protected:
     // blob and row_count
     PinWrapper<SpanBase>
@@ -404,9 +483,9 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     int64_t
     get_active_count(Timestamp ts) const override;
 
-    const ConcurrentVector<Timestamp>&
-    get_timestamps() const override {
-        return insert_record_.timestamps_;
+    Timestamp
+    get_timestamp(int64_t offset) const override {
+        return insert_record_.timestamps_[offset];
     }
 
     // Load Geometry cache for a field
@@ -644,6 +723,119 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
         }
     }
 
+    // Merge-joins a delete batch against the sorted pk column. The batch is
+    // sorted once, then each chunk takes the part of it within its first and
+    // last pk and gallops forward from the last match, so a batch costs
+    // about one pass over the chunks it overlaps rather than a binary search
+    // of every chunk per pk. The pks the bloom filter of a chunk rules out
+    // are not searched.
+    template <typename PK>
+    void
+    search_sorted_batch_pks_impl(
+        const std::vector<PkType>& pks,
+        const std::function<Timestamp(const size_t idx)>& get_timestamp,
+        bool include_same_ts,
+        const std::function<void(const SegOffset offset, const Timestamp ts)>&
+            callback,
+        FieldId pk_field_id,
+        const std::shared_ptr<ChunkedColumnInterface>& pk_column) const {
+        using PKViewType = std::conditional_t<std::is_same_v<PK, int64_t>,
+                                              int64_t,
+                                              std::string_view>;
+        auto pk_at = [&](size_t idx) -> PKViewType {
+            return std::get<PK>(pks[idx]);
+        };
+
+        // stable, so the equal pks keep their order in the batch
+        std::vector<size_t> order(pks.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return pk_at(a) < pk_at(b);
+        });
+
+        auto all_chunk_pins = pk_column->GetAllChunks(nullptr);
+        auto num_chunk = pk_column->num_chunks();
+        for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+            int64_t chunk_row_num = pk_column->chunk_row_nums(chunk_id);
+            if (chunk_row_num == 0) {
+                continue;
+            }
+            auto pw = all_chunk_pins[chunk_id];
+            auto value_at = [&](int64_t offset) -> PKViewType {
+                if constexpr (std::is_same_v<PK, int64_t>) {
+                    auto src =
+                        reinterpret_cast<const int64_t*>(pw.get()->RawData());
+                    return src[offset];
+                } else {
+                    auto string_chunk = static_cast<StringChunk*>(pw.get());
+                    return string_chunk->operator[](offset);
+                }
+            };
+
+            // the chunk is sorted, only the pks within it are searched
+            auto first = value_at(0);
+            auto last = value_at(chunk_row_num - 1);
+            auto begin = std::lower_bound(
+                order.begin(),
+                order.end(),
+                first,
+                [&](size_t idx, PKViewType v) { return pk_at(idx) < v; });
+            auto end = std::upper_bound(
+                begin, order.end(), last, [&](PKViewType v, size_t idx) {
+                    return v < pk_at(idx);
+                });
+            if (begin == end) {
+                continue;
+            }
+
+            auto metrics =
+                skip_index_.PinFieldChunkMetrics(pk_field_id, chunk_id);
+            auto num_rows_until_chunk =
+                pk_column->GetNumRowsUntilChunk(chunk_id);
+            // every row before pos is less than the pks left in the batch
+            int64_t pos = 0;
+            for (auto it = begin; it != end; ++it) {
+                auto target = pk_at(*it);
+                if (metrics.get()->CanSkipUnaryRange(
+                        proto::plan::OpType::Equal, index::Metrics{target})) {
+                    continue;
+                }
+                if (value_at(pos) < target) {
+                    // gallop until a row not less than target, then binary
+                    // search between the last two steps
+                    int64_t low = pos;
+                    int64_t step = 1;
+                    while (low + step < chunk_row_num &&
+                           value_at(low + step) < target) {
+                        low += step;
+                        step *= 2;
+                    }
+                    int64_t high = std::min(low + step, chunk_row_num);
+                    ++low;
+                    while (low < high) {
+                        auto mid = low + (high - low) / 2;
+                        if (value_at(mid) < target) {
+                            low = mid + 1;
+                        } else {
+                            high = mid;
+                        }
+                    }
+                    pos = low;
+                }
+                auto timestamp = get_timestamp(*it);
+                for (auto offset = pos;
+                     offset < chunk_row_num && value_at(offset) == target;
+                     ++offset) {
+                    auto segment_offset = offset + num_rows_until_chunk;
+                    auto ts = insert_record_.timestamps_[segment_offset];
+                    if (include_same_ts ? ts <= timestamp : ts < timestamp) {
+                        callback(SegOffset(segment_offset), timestamp);
+                    }
+                }
+            }
+        }
+    }
+
     // Binary search to find lower_bound of pk in pk_column starting from from_chunk_id
     // Returns: (chunk_id, in_chunk_offset, exists)
     //   - chunk_id: the chunk containing the first value >= pk
@@ -932,6 +1124,10 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                          Timestamp timestamp,
                          Timestamp collection_ttl) const override;
 
+    bool
+    all_visible_at(Timestamp timestamp,
+                   Timestamp collection_ttl) const override;
+
     void
     vector_search(SearchInfo& search_info,
                   const void* query_data,
@@ -961,8 +1157,12 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     void
     LoadScalarIndex(const LoadIndexInfo& info);
 
+    // data_version names the binlogs of the field, the interim index is kept
+    // in the local disk cache under it, empty keeps it in memory only
     bool
-    generate_interim_index(const FieldId field_id, int64_t num_rows);
+    generate_interim_index(const FieldId field_id,
+                           int64_t num_rows,
+                           const std::string& data_version = "");
 
     void
     fill_empty_field(const FieldMeta& field_meta);
@@ -991,10 +1191,25 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     load_column_group_data_internal(const LoadFieldDataInfo& load_info,
                                     milvus::OpContext* op_ctx = nullptr);
 
+    // field id -> the load tasks that must be done before its data loads
+    using FieldLoadTasks =
+        std::unordered_map<FieldId, std::vector<SegmentLoadPlanner::TaskId>>;
+
+    LoadTaskPriority
+    load_task_priority(const std::vector<FieldId>& field_ids,
+                       bool is_index) const;
+
+    // Returns nullopt if the indexes of the fields hold their raw data.
+    std::optional<LoadFieldDataInfo>
+    build_load_field_data_info(const std::vector<FieldId>& field_ids,
+                               const proto::segcore::FieldBinlog& field_binlog);
+
     void
     LoadBatchIndexes(milvus::tracer::TraceContext& trace_ctx,
                      std::unordered_map<FieldId, std::vector<LoadIndexInfo>>&
                          field_id_to_index_info,
+                     SegmentLoadPlanner& planner,
+                     FieldLoadTasks& field_tasks,
                      milvus::OpContext* op_ctx = nullptr);
 
     void
@@ -1002,6 +1217,8 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
                        std::vector<std::pair<std::vector<FieldId>,
                                              proto::segcore::FieldBinlog>>&
                            field_binlog_to_load,
+                       SegmentLoadPlanner& planner,
+                       const FieldLoadTasks& field_tasks,
                        milvus::OpContext* op_ctx = nullptr);
 
     void
@@ -1010,6 +1227,8 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
         const std::shared_ptr<milvus_storage::api::Properties>& properties,
         std::vector<std::pair<int, std::vector<FieldId>>>& cg_field_ids,
         bool eager_load,
+        SegmentLoadPlanner& planner,
+        const FieldLoadTasks& field_tasks,
         milvus::OpContext* op_ctx = nullptr);
 
     /**
@@ -1038,10 +1257,13 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
      * @brief Reloads columns from the specified field IDs
      *
      * @param field_ids_to_reload A vector of field IDs to reload
+     * @param planner The planner the reload tasks are added to
      * @param op_ctx The operation context
+     * @return The ids of the reload tasks
      */
-    void
+    std::vector<SegmentLoadPlanner::TaskId>
     ReloadColumns(const std::vector<FieldId>& field_ids_to_reload,
+                  SegmentLoadPlanner& planner,
                   milvus::OpContext* op_ctx = nullptr);
 
     /**
@@ -1051,6 +1273,11 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
      * updating the segment's loaded fields and indexes accordingly. It handles
      * incremental updates during segment reopen operations.
      *
+     * All the index, column group and binlog fetches run as one DAG of a
+     * SegmentLoadPlanner: the data of a field waits only for the index and
+     * index drop tasks of the same field, and the system and filter fields
+     * are started first.
+     *
      * @param segment_load_info The segment load information to be updated
      * @param load_diff The differences to apply, containing fields and indexes to add/remove
      * @param op_ctx The operation context
@@ -1069,24 +1296,48 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
         bool enable_mmap,
         bool is_proxy_column,
         std::optional<ParquetStatistics> statistics = {},
-        milvus::OpContext* op_ctx = nullptr);
+        milvus::OpContext* op_ctx = nullptr,
+        const std::string& data_version = "");
 
     std::shared_ptr<ChunkedColumnInterface>
     get_column(FieldId field_id) const {
-        std::shared_ptr<ChunkedColumnInterface> res;
-        fields_.withRLock([&](auto& fields) {
-            auto it = fields.find(field_id);
-            if (it != fields.end()) {
-                res = it->second;
-            }
-        });
-        return res;
+        auto catalog = this->catalog();
+        auto it = catalog->fields.find(field_id);
+        if (it != catalog->fields.end()) {
+            return it->second;
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<const SealedCatalog>
+    snapshot() const override {
+        return std::atomic_load(&catalog_);
+    }
+
+    // the catalog the running Task took when it started, the published one
+    // outside a Task; kept as it is by whoever holds it
+    std::shared_ptr<const SealedCatalog>
+    catalog() const {
+        if (auto bound = ScopedSegmentSnapshot::Current(this)) {
+            return *bound;
+        }
+        return snapshot();
     }
 
  private:
     // InsertRecord needs to pin pk column.
     friend class storagev1translator::InsertRecordTranslator;
 
+    // publishes a copy of the catalog changed by fn, under mutex_
+    template <typename Fn>
+    void
+    update_catalog(Fn&& fn) {
+        auto next = std::make_shared<SealedCatalog>(*snapshot());
+        fn(*next);
+        std::shared_ptr<const SealedCatalog> published = std::move(next);
+        std::atomic_store(&catalog_, published);
+    }
+
     // mmap descriptor, used in chunk cache
     storage::MmapChunkDescriptorPtr mmap_descriptor_ = nullptr;
     // segment loading state
@@ -1102,18 +1353,9 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     // TODO: generate index for scalar
     std::optional<int64_t> num_rows_;
 
-    // ngram indexings for json type
-    folly::Synchronized<std::unordered_map<
-        FieldId,
-        std::unordered_map<std::string, index::CacheIndexBasePtr>>>
-        ngram_indexings_;
-
-    // fields that has ngram index
-    folly::Synchronized<std::unordered_set<FieldId>> ngram_fields_;
+    // columns and scalar indexes, replaced by update_catalog
+    std::shared_ptr<const SealedCatalog> catalog_;
 
-    // scalar field index
-    folly::Synchronized<std::unordered_map<FieldId, index::CacheIndexBasePtr>>
-        scalar_indexings_;
     // vector field index
     SealedIndexingRecord vector_indexings_;
 
@@ -1123,15 +1365,16 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     // deleted pks
     mutable DeletedRecord<true> deleted_record_;
 
+    // bumped by every writer under mutex_, the cached search results of an
+    // older generation are stale
+    std::atomic<uint64_t> generation_{0};
+
     LoadFieldDataInfo field_data_info_;
 
     SegmentLoadInfo segment_load_info_;
 
     SchemaPtr schema_;
     int64_t id_;
-    mutable folly::Synchronized<
-        std::unordered_map<FieldId, std::shared_ptr<ChunkedColumnInterface>>>
-        fields_;
     std::unordered_set<FieldId> mmap_field_ids_;
 
     // only useful in binlog
@@ -1146,6 +1389,16 @@ class ChunkedSegmentSealedImpl : public SegmentSealed {
     // 1. will skip index loading for primary key field
     bool is_sorted_by_pk_ = false;
 
+    // the rows of each partition key, built on the first filter on the key
+    // and rebuilt when its column is loaded again
+    struct PartitionKeyRowsEntry {
+        std::weak_ptr<ChunkedColumnInterface> column_;
+        std::shared_ptr<const PartitionKeyRows> rows_;
+    };
+    mutable std::mutex partition_key_rows_mutex_;
+    mutable std::unordered_map<FieldId, PartitionKeyRowsEntry>
+        partition_key_rows_;
+
     // milvus storage internal api reader instance
     std::unique_ptr<milvus_storage::api::Reader> reader_;
 
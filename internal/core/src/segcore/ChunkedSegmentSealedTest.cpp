@@ -44,6 +44,7 @@
 #include "segcore/SegmentInterface.h"
 #include "segcore/SegmentSealed.h"
 #include "segcore/ChunkedSegmentSealedImpl.h"
+#include "segcore/SegmentGrowingImpl.h"
 #include "storage/RemoteChunkManagerSingleton.h"
 
 #include "segcore/Types.h"
@@ -652,6 +653,59 @@ TEST_P(TestChunkSegment, TestCompareExpr) {
     ASSERT_EQ(chunk_num * test_data_count, final.count());
 }
 
+TEST_P(TestChunkSegment, TestIndexPinnedAcrossDrop) {
+    auto fid = fields.at("int64");
+    auto file_manager_ctx = storage::FileManagerContext();
+    file_manager_ctx.fieldDataMeta.field_schema.set_data_type(
+        milvus::proto::schema::Int64);
+    file_manager_ctx.fieldDataMeta.field_schema.set_fieldid(fid.get());
+    file_manager_ctx.fieldDataMeta.field_id = fid.get();
+    milvus::storage::IndexMeta index_meta;
+    index_meta.field_id = fid.get();
+    index_meta.build_id = rand();
+    index_meta.index_version = rand();
+    file_manager_ctx.indexMeta = index_meta;
+    index::CreateIndexInfo create_index_info;
+    create_index_info.field_type = DataType::INT64;
+    create_index_info.index_type = index::ASCENDING_SORT;
+    auto index = index::IndexFactory::GetInstance().CreateScalarIndex(
+        create_index_info, file_manager_ctx);
+    std::vector<int64_t> data(test_data_count * chunk_num);
+    for (int i = 0; i < chunk_num; i++) {
+        auto pw = segment->chunk_data<int64_t>(nullptr, fid, i);
+        auto d = pw.get();
+        std::copy(d.data(),
+                  d.data() + test_data_count,
+                  data.begin() + i * test_data_count);
+    }
+    index->BuildWithRawDataForUT(data.size(), data.data());
+    segcore::LoadIndexInfo load_index_info;
+    load_index_info.index_params = GenIndexParams(index.get());
+    load_index_info.cache_index =
+        CreateTestCacheIndex("test", std::move(index));
+    load_index_info.field_id = fid.get();
+    segment->LoadIndex(load_index_info);
+
+    auto pinned = segment->PinIndex(nullptr, fid);
+    ASSERT_EQ(pinned.size(), 1);
+    auto snapshot = segment->snapshot();
+    // a pinned index outlives its drop, later pins no longer find it
+    segment->DropIndex(fid);
+    ASSERT_TRUE(segment->PinIndex(nullptr, fid).empty());
+    {
+        // a task keeps reading the segment as it was when it started
+        segcore::ScopedSegmentSnapshot scope(segment.get(), snapshot);
+        ASSERT_EQ(segment->PinIndex(nullptr, fid).size(), 1);
+    }
+    ASSERT_TRUE(segment->PinIndex(nullptr, fid).empty());
+    auto sorted =
+        dynamic_cast<const index::ScalarIndex<int64_t>*>(pinned[0].get());
+    ASSERT_NE(sorted, nullptr);
+    for (size_t i = 0; i < data.size(); i += 97) {
+        ASSERT_EQ(sorted->Reverse_Lookup(i), data[i]);
+    }
+}
+
 TEST_P(TestChunkSegment, TestPkRange) {
     using namespace milvus::segcore;
     bool pk_is_string = GetParam();
@@ -708,6 +762,197 @@ TEST_P(TestChunkSegment, TestPkRange) {
     }
 }
 
+TEST_P(TestChunkSegment, TestSearchBatchPks) {
+    using namespace milvus::segcore;
+    bool pk_is_string = GetParam();
+    auto segment_impl = dynamic_cast<ChunkedSegmentSealedImpl*>(segment.get());
+    ASSERT_NE(segment_impl, nullptr);
+
+    std::vector<std::string> str_data;
+    for (int i = 0; i < test_data_count * chunk_num; i++) {
+        str_data.push_back("test" + std::to_string(i));
+    }
+    std::sort(str_data.begin(), str_data.end());
+
+    // unsorted, across both chunks, with duplicates and absent pks; the
+    // row of a present pk is its offset
+    std::vector<int64_t> offsets = {15000, 3, 9999, 10000, 3, 19999, 0, 42};
+    std::vector<PkType> pks;
+    for (auto offset : offsets) {
+        if (pk_is_string) {
+            pks.emplace_back(str_data[offset]);
+        } else {
+            pks.emplace_back(offset);
+        }
+    }
+    if (pk_is_string) {
+        pks.emplace_back(std::string("a"));
+        pks.emplace_back(std::string("test10000a"));
+        pks.emplace_back(std::string("zzz"));
+    } else {
+        pks.emplace_back(int64_t(-1));
+        pks.emplace_back(int64_t(999999));
+    }
+
+    std::vector<int64_t> hits;
+    segment_impl->search_batch_pks(
+        pks,
+        [](size_t) { return Timestamp(MAX_TIMESTAMP); },
+        false,
+        [&](SegOffset offset, Timestamp) { hits.push_back(offset.get()); });
+    std::sort(hits.begin(), hits.end());
+    std::sort(offsets.begin(), offsets.end());
+    EXPECT_EQ(hits, offsets);
+
+    // a row inserted at the delete timestamp is deleted with
+    // include_same_ts only, the timestamp of a row is its offset
+    if (!pk_is_string) {
+        for (bool include_same_ts : {false, true}) {
+            hits.clear();
+            segment_impl->search_batch_pks(
+                {PkType(int64_t(15000))},
+                [](size_t) { return Timestamp(15000); },
+                include_same_ts,
+                [&](SegOffset offset, Timestamp) {
+                    hits.push_back(offset.get());
+                });
+            EXPECT_EQ(hits.size(), include_same_ts ? 1 : 0);
+        }
+    }
+}
+
+TEST(test_chunk_segment, TestPartitionKeyRows) {
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64, false);
+    auto tenant_fid = schema->AddDebugField("tenant", DataType::INT64, false);
+    schema->AddField(FieldName("ts"),
+                     TimestampFieldID,
+                     DataType::INT64,
+                     false,
+                     std::nullopt);
+    schema->set_primary_field_id(pk_fid);
+    schema->set_partition_key_field_id(tenant_fid);
+    auto segment = CreateSealedSegment(
+        schema, nullptr, -1, SegcoreConfig::default_config(), true);
+    ASSERT_FALSE(segment->has_partition_key_rows(tenant_fid));
+
+    // 13 tenants writing 7 rows at a time, in two chunks
+    const int64_t N = 2002;
+    const int chunk_num = 2;
+    std::unordered_map<FieldId, std::vector<int64_t>> columns;
+    for (int64_t i = 0; i < N; ++i) {
+        columns[pk_fid].push_back(i);
+        columns[tenant_fid].push_back(i / 7 % 13);
+        columns[TimestampFieldID].push_back(i);
+    }
+    auto cm = milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+                  .GetRemoteChunkManager();
+    for (auto& [fid, values] : columns) {
+        std::vector<FieldDataPtr> field_datas;
+        for (int chunk_id = 0; chunk_id < chunk_num; ++chunk_id) {
+            auto field_data =
+                std::make_shared<FieldData<int64_t>>(DataType::INT64, false);
+            field_data->FillFieldData(values.data() + chunk_id * N / chunk_num,
+                                      N / chunk_num);
+            field_datas.push_back(field_data);
+        }
+        auto load_info = PrepareSingleFieldInsertBinlog(kCollectionID,
+                                                        kPartitionID,
+                                                        kSegmentID,
+                                                        fid.get(),
+                                                        field_datas,
+                                                        cm);
+        segment->LoadFieldData(load_info);
+    }
+    ASSERT_TRUE(segment->has_partition_key_rows(tenant_fid));
+    ASSERT_FALSE(segment->has_partition_key_rows(pk_fid));
+
+    auto value = [](int64_t v) {
+        proto::plan::GenericValue value;
+        value.set_int64_val(v);
+        return value;
+    };
+    auto column = expr::ColumnInfo(tenant_fid, DataType::INT64);
+    std::vector<expr::TypedExprPtr> exprs = {
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column, proto::plan::OpType::Equal, value(5)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column, proto::plan::OpType::NotEqual, value(5)),
+        std::make_shared<expr::TermFilterExpr>(
+            column,
+            std::vector<proto::plan::GenericValue>{
+                value(1), value(12), value(100)})};
+    std::vector<std::function<bool(int64_t)>> expected = {
+        [](int64_t tenant) { return tenant == 5; },
+        [](int64_t tenant) { return tenant != 5; },
+        [](int64_t tenant) { return tenant == 1 || tenant == 12; }};
+
+    for (size_t e = 0; e < exprs.size(); ++e) {
+        auto plan = std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID,
+                                                           exprs[e]);
+        auto bitset =
+            query::ExecuteQueryExpr(plan, segment.get(), N, MAX_TIMESTAMP);
+        for (int64_t i = 0; i < N; ++i) {
+            ASSERT_EQ(bitset[i], expected[e](columns[tenant_fid][i]))
+                << "expr: " << e << ", i: " << i;
+        }
+    }
+}
+
+TEST(test_chunk_segment, TestLoadFromGrowing) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::INT64);
+    auto vec_fid = schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR);
+    auto nullable_fid = schema->AddDebugField("int32", DataType::INT32, true);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(pk_fid);
+
+    // several chunks, the last one partial
+    auto config = SegcoreConfig::default_config();
+    config.set_chunk_rows(64);
+    const int64_t N = 300;
+    auto dataset = DataGen(schema, N);
+    std::shared_ptr<SegmentGrowingImpl> growing =
+        std::make_shared<SegmentGrowingImpl>(
+            schema, empty_index_meta, config, 1);
+    growing->PreInsert(N);
+    growing->Insert(0,
+                    N,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    auto sealed = CreateSealedSegment(schema, empty_index_meta);
+    auto sealed_impl = dynamic_cast<ChunkedSegmentSealedImpl*>(sealed.get());
+    ASSERT_NE(sealed_impl, nullptr);
+    sealed_impl->LoadFromGrowing(growing);
+    ASSERT_EQ(sealed->get_row_count(), N);
+
+    std::vector<int64_t> offsets(N);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    for (auto fid : {pk_fid, vec_fid, str_fid, nullable_fid, json_fid}) {
+        auto expected =
+            growing->bulk_subscript(nullptr, fid, offsets.data(), N);
+        auto actual = sealed->bulk_subscript(nullptr, fid, offsets.data(), N);
+        EXPECT_EQ(actual->SerializeAsString(), expected->SerializeAsString())
+            << "field " << fid.get();
+    }
+
+    // the vector chunks are borrowed, the segment keeps growing alive
+    std::weak_ptr<SegmentGrowingImpl> weak = growing;
+    growing.reset();
+    EXPECT_FALSE(weak.expired());
+    auto pks = dataset.get_col<int64_t>(pk_fid);
+    EXPECT_TRUE(sealed->Contain(PkType(pks[N - 1])));
+    sealed.reset();
+    EXPECT_TRUE(weak.expired());
+}
+
 TEST(TestTTLFieldFilter, TestMaskWithTTLField) {
     using namespace milvus::segcore;
 
@@ -968,3 +1213,32 @@ TEST(TestTTLFieldFilter, TestMaskWithNullableTTLField) {
 
     EXPECT_EQ(expired_count, test_data_count / 4);
 }
+
+TEST(test_chunk_segment, TestMaskWithTimestamps) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+
+    const int64_t N = 10'000;
+    auto dataset = segcore::DataGen(schema, N);
+    auto segment = CreateSealedWithFieldDataLoaded(schema, dataset);
+    const auto& timestamps = dataset.timestamps_;
+
+    for (Timestamp ttl : {Timestamp(0), Timestamp(1), Timestamp(N / 3)}) {
+        for (Timestamp query_ts :
+             {Timestamp(0), Timestamp(N / 2), Timestamp(N + 1)}) {
+            BitsetType bitset(N);
+            // rows set before are kept
+            bitset.set(N - 1);
+            BitsetTypeView view(bitset.data(), N);
+            segment->mask_with_timestamps(view, query_ts, ttl);
+            for (int64_t i = 0; i < N; i++) {
+                auto expected = timestamps[i] > query_ts ||
+                                (ttl > 0 && timestamps[i] <= ttl) ||
+                                i == N - 1;
+                ASSERT_EQ(bitset[i], expected)
+                    << ttl << " " << query_ts << " " << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,78 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/ClusteringCentroid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/Utils.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// knowhere computes in float, the bounds give way by this much relatively
+constexpr double kRelaxation = 1e-4;
+
+}  // namespace
+
+std::optional<float>
+BestDistanceBound(const MetricType& metric_type,
+                  const float* query,
+                  const ClusteringCentroid& ball) {
+    double dot = 0;
+    double query_norm = 0;
+    double centroid_norm = 0;
+    double squared_distance = 0;
+    for (size_t i = 0; i < ball.centroid_.size(); ++i) {
+        double q = query[i];
+        double c = ball.centroid_[i];
+        dot += q * c;
+        query_norm += q * q;
+        centroid_norm += c * c;
+        squared_distance += (q - c) * (q - c);
+    }
+    query_norm = std::sqrt(query_norm);
+    centroid_norm = std::sqrt(centroid_norm);
+    double radius = ball.radius_;
+
+    if (IsMetricType(metric_type, knowhere::metric::L2)) {
+        // knowhere L2 is the squared distance
+        auto nearest = std::max(0.0, std::sqrt(squared_distance) - radius);
+        return nearest * nearest * (1 - kRelaxation);
+    }
+    if (IsMetricType(metric_type, knowhere::metric::IP)) {
+        // <q, x> = <q, c> + <q, x - c> <= <q, c> + |q| r
+        auto largest = dot + query_norm * radius;
+        return largest + std::abs(largest) * kRelaxation + kRelaxation;
+    }
+    if (IsMetricType(metric_type, knowhere::metric::COSINE)) {
+        // the vectors of a ball off the origin lie within asin(r / |c|)
+        // of its centroid direction
+        if (query_norm == 0 || centroid_norm <= radius) {
+            return 1.0f;
+        }
+        auto angle = std::acos(
+            std::clamp(dot / (query_norm * centroid_norm), -1.0, 1.0));
+        auto spread = std::asin(radius / centroid_norm);
+        auto largest = std::cos(std::max(0.0, angle - spread));
+        return std::min(1.0, largest + kRelaxation);
+    }
+    return std::nullopt;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,46 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// A ball holding every vector of a float vector field of a segment. The
+// segments a clustering compaction writes hold one cluster each, so the
+// centroid of the cluster and the furthest distance of a member to it make
+// a tight ball, and a search can tell that no row of such a segment beats
+// what it already found.
+struct ClusteringCentroid {
+    std::vector<float> centroid_;
+    // the L2 distance, not squared, of the furthest vector to the centroid
+    float radius_{0};
+};
+
+// the best metric_type distance any vector of the ball can have to query,
+// the smallest for L2 and the largest for IP and COSINE, slightly relaxed
+// for float rounding. nullopt for the other metrics.
+std::optional<float>
+BestDistanceBound(const MetricType& metric_type,
+                  const float* query,
+                  const ClusteringCentroid& ball);
+
+}  // namespace milvus::segcore
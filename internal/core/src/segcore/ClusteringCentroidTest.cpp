@@ -0,0 +1,111 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "knowhere/comp/index_param.h"
+#include "segcore/ClusteringCentroid.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+double
+Distance(const MetricType& metric_type,
+         const float* x,
+         const float* y,
+         int dim) {
+    double dot = 0, x_norm = 0, y_norm = 0, l2 = 0;
+    for (int i = 0; i < dim; ++i) {
+        dot += x[i] * y[i];
+        x_norm += x[i] * x[i];
+        y_norm += y[i] * y[i];
+        l2 += (x[i] - y[i]) * (x[i] - y[i]);
+    }
+    if (metric_type == knowhere::metric::L2) {
+        return l2;
+    }
+    if (metric_type == knowhere::metric::IP) {
+        return dot;
+    }
+    return dot / std::sqrt(x_norm * y_norm);
+}
+
+}  // namespace
+
+TEST(ClusteringCentroid, BoundsEveryVectorOfTheBall) {
+    int dim = 16;
+    std::default_random_engine er(42);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    ClusteringCentroid ball;
+    for (int i = 0; i < dim; ++i) {
+        ball.centroid_.push_back(5.0f + normal(er));
+    }
+    ball.radius_ = 2.0f;
+    // vectors inside the ball, some on its surface
+    std::vector<std::vector<float>> members;
+    for (int n = 0; n < 2000; ++n) {
+        std::vector<float> direction(dim);
+        double norm = 0;
+        for (auto& value : direction) {
+            value = normal(er);
+            norm += value * value;
+        }
+        auto scale = ball.radius_ * (n % 4 == 0 ? 1.0f : unit(er)) /
+                     static_cast<float>(std::sqrt(norm));
+        std::vector<float> member(dim);
+        for (int i = 0; i < dim; ++i) {
+            member[i] = ball.centroid_[i] + direction[i] * scale * 0.9999f;
+        }
+        members.push_back(std::move(member));
+    }
+
+    for (MetricType metric_type : {knowhere::metric::L2,
+                                   knowhere::metric::IP,
+                                   knowhere::metric::COSINE}) {
+        bool smaller_is_better = metric_type == knowhere::metric::L2;
+        for (int q = 0; q < 20; ++q) {
+            std::vector<float> query(dim);
+            for (auto& value : query) {
+                value = 3 * normal(er);
+            }
+            auto bound = BestDistanceBound(metric_type, query.data(), ball);
+            ASSERT_TRUE(bound.has_value());
+            for (const auto& member : members) {
+                auto distance =
+                    Distance(metric_type, query.data(), member.data(), dim);
+                if (smaller_is_better) {
+                    EXPECT_LE(bound.value(), distance) << metric_type;
+                } else {
+                    EXPECT_GE(bound.value(), distance) << metric_type;
+                }
+            }
+        }
+    }
+
+    // far away queries are bounded away from the ball
+    std::vector<float> far(dim, -20.0f);
+    EXPECT_GT(BestDistanceBound(knowhere::metric::L2, far.data(), ball).value(),
+              1000.0f);
+    EXPECT_LT(
+        BestDistanceBound(knowhere::metric::COSINE, far.data(), ball).value(),
+        0.0f);
+    EXPECT_FALSE(BestDistanceBound(knowhere::metric::HAMMING, far.data(), ball)
+                     .has_value());
+}
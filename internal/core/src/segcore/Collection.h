@@ -17,6 +17,9 @@
 
 #include "common/Schema.h"
 #include "common/IndexMeta.h"
+#include "index/json_stats/GrowingJsonKeyStats.h"
+#include "query/PlanCache.h"
+#include "segcore/FieldAccessStats.h"
 
 namespace milvus::segcore {
 
@@ -70,6 +73,23 @@ class Collection {
         index_meta_ = index_meta;
     }
 
+    // shared by the segments of the collection, see JsonKeyLayoutHints
+    const index::JsonKeyLayoutHintsPtr&
+    get_json_key_layout_hints() const {
+        return json_key_layout_hints_;
+    }
+
+    // counted by the plans created from the collection
+    const FieldAccessStatsPtr&
+    get_field_access_stats() const {
+        return field_access_stats_;
+    }
+
+    query::SearchPlanCache&
+    get_search_plan_cache() {
+        return search_plan_cache_;
+    }
+
     const std::string_view
     get_collection_name() {
         return collection_name_;
@@ -80,6 +100,11 @@ class Collection {
     SchemaPtr schema_;
     std::shared_mutex schema_mutex_;
     IndexMetaPtr index_meta_;
+    index::JsonKeyLayoutHintsPtr json_key_layout_hints_ =
+        std::make_shared<index::JsonKeyLayoutHints>();
+    FieldAccessStatsPtr field_access_stats_ =
+        std::make_shared<FieldAccessStats>();
+    query::SearchPlanCache search_plan_cache_;
 };
 
 using CollectionPtr = std::unique_ptr<Collection>;
@@ -0,0 +1,301 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/CompressedCellTier.h"
+
+#include <lz4.h>
+
+#include <cstdlib>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "monitor/Monitor.h"
+#include "storage/ThreadPools.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the memory of a resident cell, handed to the tier when it is dropped
+class EvictionOwner {
+ public:
+    EvictionOwner(std::shared_ptr<CompressedCellSource> source,
+                  cachinglayer::cid_t cid,
+                  const char* data,
+                  size_t size,
+                  int64_t row_nums,
+                  std::shared_ptr<const void> memory)
+        : source_(std::move(source)),
+          cid_(cid),
+          data_(data),
+          size_(size),
+          row_nums_(row_nums),
+          memory_(std::move(memory)) {
+    }
+
+    // The caching layer may evict on the thread of a pin, the compression
+    // runs on the LOW pool. The memory is freed once it is done.
+    ~EvictionOwner() {
+        if (source_->retired.load()) {
+            return;
+        }
+        auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::LOW);
+        pool.Submit([source = std::move(source_),
+                     cid = cid_,
+                     data = data_,
+                     size = size_,
+                     row_nums = row_nums_,
+                     memory = std::move(memory_)]() {
+            if (source->retired.load()) {
+                return;
+            }
+            auto& tier = CompressedCellTier::Instance();
+            if (source->sparse) {
+                tier.PutSparse(
+                    source->key, cid, data, size, row_nums, source->nullable);
+            } else {
+                tier.Put(source->key, cid, data, size, row_nums);
+            }
+        });
+    }
+
+ private:
+    std::shared_ptr<CompressedCellSource> source_;
+    cachinglayer::cid_t cid_;
+    const char* data_;
+    size_t size_;
+    int64_t row_nums_;
+    std::shared_ptr<const void> memory_;
+};
+
+}  // namespace
+
+CompressedCellTier&
+CompressedCellTier::Instance() {
+    static CompressedCellTier instance;
+    return instance;
+}
+
+void
+CompressedCellTier::SetCapacityBytes(size_t capacity_bytes) {
+    capacity_bytes_.store(capacity_bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (current_bytes_.load() > capacity_bytes && !lru_.empty()) {
+        EraseLocked(entries_.find(lru_.front()));
+        monitor::internal_core_compressed_cell_tier_eviction.Increment();
+    }
+    monitor::internal_core_compressed_cell_tier_bytes_all.Set(
+        current_bytes_.load());
+    LOG_INFO("set compressed cell tier capacity: {} bytes", capacity_bytes);
+}
+
+size_t
+CompressedCellTier::GetCapacityBytes() const {
+    return capacity_bytes_.load();
+}
+
+size_t
+CompressedCellTier::GetCurrentBytes() const {
+    return current_bytes_.load();
+}
+
+size_t
+CompressedCellTier::GetEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+void
+CompressedCellTier::SetSparseValueCodec(SparseValueCodec codec) {
+    sparse_codec_.store(codec);
+}
+
+SparseValueCodec
+CompressedCellTier::GetSparseValueCodec() const {
+    return sparse_codec_.load();
+}
+
+bool
+CompressedCellTier::Put(const std::string& key,
+                        cachinglayer::cid_t cid,
+                        const char* data,
+                        size_t size,
+                        int64_t row_nums) {
+    auto capacity = capacity_bytes_.load();
+    if (capacity == 0 || size == 0 || size > LZ4_MAX_INPUT_SIZE) {
+        return false;
+    }
+    std::vector<char> buffer(LZ4_compressBound(static_cast<int>(size)));
+    auto compressed_size =
+        LZ4_compress_default(data,
+                             buffer.data(),
+                             static_cast<int>(size),
+                             static_cast<int>(buffer.size()));
+    if (compressed_size <= 0 ||
+        compressed_size * kMinCompressionRatio > size) {
+        return false;
+    }
+    Entry entry;
+    entry.compressed.assign(buffer.data(), buffer.data() + compressed_size);
+    entry.size = size;
+    entry.row_nums = row_nums;
+    return Keep(key, cid, std::move(entry));
+}
+
+bool
+CompressedCellTier::PutSparse(const std::string& key,
+                              cachinglayer::cid_t cid,
+                              const char* data,
+                              size_t size,
+                              int64_t row_nums,
+                              bool nullable) {
+    if (capacity_bytes_.load() == 0 || size == 0) {
+        return false;
+    }
+    Entry entry;
+    entry.compressed = EncodeSparseChunk(
+        data, size, row_nums, nullable, sparse_codec_.load());
+    if (entry.compressed.size() * kMinSparseCompressionRatio > size) {
+        return false;
+    }
+    entry.size = size;
+    entry.row_nums = row_nums;
+    entry.sparse = true;
+    return Keep(key, cid, std::move(entry));
+}
+
+bool
+CompressedCellTier::Keep(const std::string& key,
+                         cachinglayer::cid_t cid,
+                         Entry entry) {
+    auto capacity = capacity_bytes_.load();
+    auto compressed_size = entry.compressed.size();
+    if (compressed_size > capacity) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Key entry_key{key, cid};
+    auto it = entries_.find(entry_key);
+    if (it != entries_.end()) {
+        EraseLocked(it);
+    }
+    while (current_bytes_.load() + compressed_size > capacity &&
+           !lru_.empty()) {
+        EraseLocked(entries_.find(lru_.front()));
+        monitor::internal_core_compressed_cell_tier_eviction.Increment();
+    }
+    entry.lru_it = lru_.insert(lru_.end(), entry_key);
+    entries_.emplace(std::move(entry_key), std::move(entry));
+    current_bytes_.fetch_add(compressed_size);
+    monitor::internal_core_compressed_cell_tier_bytes_all.Set(
+        current_bytes_.load());
+    return true;
+}
+
+std::optional<CompressedCellTier::Cell>
+CompressedCellTier::Take(const std::string& key, cachinglayer::cid_t cid) {
+    Entry entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find({key, cid});
+        if (it == entries_.end()) {
+            monitor::internal_core_compressed_cell_tier_miss.Increment();
+            return std::nullopt;
+        }
+        auto node = entries_.extract(it);
+        current_bytes_.fetch_sub(node.mapped().compressed.size());
+        lru_.erase(node.mapped().lru_it);
+        entry = std::move(node.mapped());
+        monitor::internal_core_compressed_cell_tier_bytes_all.Set(
+            current_bytes_.load());
+    }
+    auto aligned_size = (entry.size + kAlignment - 1) & ~(kAlignment - 1);
+    auto data =
+        static_cast<char*>(std::aligned_alloc(kAlignment, aligned_size));
+    AssertInfo(data != nullptr,
+               "failed to allocate {} bytes for a compressed cell",
+               aligned_size);
+    Cell cell{
+        std::shared_ptr<char>(data, std::free), entry.size, entry.row_nums};
+    if (entry.sparse) {
+        DecodeSparseChunk(
+            entry.compressed.data(), entry.compressed.size(), data);
+    } else {
+        auto decompressed =
+            LZ4_decompress_safe(entry.compressed.data(),
+                                data,
+                                static_cast<int>(entry.compressed.size()),
+                                static_cast<int>(entry.size));
+        AssertInfo(decompressed == static_cast<int>(entry.size),
+                   "failed to decompress cell {} of {}",
+                   cid,
+                   key);
+    }
+    monitor::internal_core_compressed_cell_tier_hit.Increment();
+    return cell;
+}
+
+size_t
+CompressedCellTier::CompressedBytes(const std::string& key,
+                                    cachinglayer::cid_t cid) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find({key, cid});
+    return it == entries_.end() ? 0 : it->second.compressed.size();
+}
+
+void
+CompressedCellTier::EraseSource(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->first.source == key) {
+            EraseLocked(it++);
+        } else {
+            ++it;
+        }
+    }
+    monitor::internal_core_compressed_cell_tier_bytes_all.Set(
+        current_bytes_.load());
+}
+
+void
+CompressedCellTier::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    current_bytes_.store(0);
+    monitor::internal_core_compressed_cell_tier_bytes_all.Set(0);
+}
+
+void
+CompressedCellTier::EraseLocked(
+    std::unordered_map<Key, Entry, KeyHasher>::iterator it) {
+    current_bytes_.fetch_sub(it->second.compressed.size());
+    lru_.erase(it->second.lru_it);
+    entries_.erase(it);
+}
+
+std::shared_ptr<const void>
+CompressedCellTier::KeepOnEviction(std::shared_ptr<CompressedCellSource> source,
+                                   cachinglayer::cid_t cid,
+                                   const char* data,
+                                   size_t size,
+                                   int64_t row_nums,
+                                   std::shared_ptr<const void> memory) {
+    return std::make_shared<EvictionOwner>(
+        std::move(source), cid, data, size, row_nums, std::move(memory));
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,194 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cachinglayer/Utils.h"
+#include "common/SparseCompact.h"
+
+namespace milvus::segcore {
+
+// The cells of one translator the tier may keep, under its key.
+struct CompressedCellSource {
+    explicit CompressedCellSource(std::string key,
+                                  bool sparse = false,
+                                  bool nullable = false)
+        : key(std::move(key)), sparse(sparse), nullable(nullable) {
+    }
+
+    const std::string key;
+    // the cells are sparse float vector chunks, kept in their compact
+    // layout rather than LZ4-compressed
+    const bool sparse;
+    const bool nullable;
+    // set once the cells are not wanted back, as their column was dropped
+    // or released to an index holding the raw data, then the evicted cells
+    // are freed as before
+    std::atomic<bool> retired{false};
+};
+
+// Process-level tier of evicted cells, kept LZ4-compressed in memory.
+//
+// The caching layer either holds a cell or has evicted it, and an evicted
+// raw scalar chunk is read from remote storage again on its next pin. The
+// memory of the in-memory chunks of a translator taking part is handed to
+// the tier when the caching layer evicts them: a LOW pool task compresses
+// the chunk, keeps it if it shrinks by kMinCompressionRatio at least, and
+// frees the chunk. The next load of the cell decompresses it instead of
+// reading the storage, and takes it out of the tier as it is resident
+// again.
+//
+// A sparse float vector chunk is kept in the compact layout of
+// EncodeSparseChunk instead, its values by the sparse value codec of the
+// tier, if it shrinks by kMinSparseCompressionRatio at least.
+//
+// The compressed cells have a budget of their own, apart from the cache
+// capacity, and the least recently kept cells are dropped to stay in it.
+// A capacity of 0 turns the tier off for the translators created after.
+class CompressedCellTier {
+ public:
+    struct Cell {
+        std::shared_ptr<char> data;
+        size_t size{0};
+        int64_t row_nums{0};
+    };
+
+    static CompressedCellTier&
+    Instance();
+
+    void
+    SetCapacityBytes(size_t capacity_bytes);
+    size_t
+    GetCapacityBytes() const;
+    size_t
+    GetCurrentBytes() const;
+    size_t
+    GetEntryCount() const;
+
+    // FP32 by default, so a sparse cell loads back unchanged; the lossy
+    // codecs keep about twice as many evicted sparse cells
+    void
+    SetSparseValueCodec(SparseValueCodec codec);
+    SparseValueCodec
+    GetSparseValueCodec() const;
+
+    // Compresses the size bytes at data as cell cid of key, false if the
+    // cell was not kept as it compresses poorly or exceeds the capacity.
+    bool
+    Put(const std::string& key,
+        cachinglayer::cid_t cid,
+        const char* data,
+        size_t size,
+        int64_t row_nums);
+
+    // Put for the size bytes of a sparse float vector chunk at data.
+    bool
+    PutSparse(const std::string& key,
+              cachinglayer::cid_t cid,
+              const char* data,
+              size_t size,
+              int64_t row_nums,
+              bool nullable);
+
+    // the decompressed cell, nullopt if the tier does not keep it
+    std::optional<Cell>
+    Take(const std::string& key, cachinglayer::cid_t cid);
+
+    // the compressed size of a kept cell, 0 if it is not kept
+    size_t
+    CompressedBytes(const std::string& key, cachinglayer::cid_t cid) const;
+
+    void
+    EraseSource(const std::string& key);
+
+    void
+    Clear();
+
+    // Wraps memory, holding the size bytes at data of cell cid, into an
+    // owner which hands the cell to the tier once it is dropped, unless
+    // source was retired.
+    static std::shared_ptr<const void>
+    KeepOnEviction(std::shared_ptr<CompressedCellSource> source,
+                   cachinglayer::cid_t cid,
+                   const char* data,
+                   size_t size,
+                   int64_t row_nums,
+                   std::shared_ptr<const void> memory);
+
+    static constexpr double kMinCompressionRatio = 1.5;
+    // the compact layout of fp32 values shrinks the indices only
+    static constexpr double kMinSparseCompressionRatio = 1.2;
+    // the alignment of the decompressed cells, as of the chunk targets
+    static constexpr size_t kAlignment = 64;
+
+ private:
+    CompressedCellTier() = default;
+
+    struct Key {
+        std::string source;
+        cachinglayer::cid_t cid{0};
+
+        bool
+        operator==(const Key& other) const {
+            return cid == other.cid && source == other.source;
+        }
+    };
+
+    struct KeyHasher {
+        size_t
+        operator()(const Key& k) const noexcept {
+            return std::hash<std::string>{}(k.source) * 1315423911u ^
+                   std::hash<int64_t>{}(k.cid);
+        }
+    };
+
+    struct Entry {
+        std::vector<char> compressed;
+        size_t size{0};
+        int64_t row_nums{0};
+        bool sparse{false};
+        std::list<Key>::iterator lru_it;
+    };
+
+    // keeps entry as cell cid of key, false if it exceeds the capacity
+    bool
+    Keep(const std::string& key, cachinglayer::cid_t cid, Entry entry);
+
+    // drops an entry, caller holds mutex_
+    void
+    EraseLocked(std::unordered_map<Key, Entry, KeyHasher>::iterator it);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Entry, KeyHasher> entries_;
+    // least recently kept first
+    std::list<Key> lru_;
+    std::atomic<size_t> capacity_bytes_{0};
+    std::atomic<size_t> current_bytes_{0};
+    std::atomic<SparseValueCodec> sparse_codec_{SparseValueCodec::FP32};
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,190 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "segcore/CompressedCellTier.h"
+
+using milvus::segcore::CompressedCellSource;
+using milvus::segcore::CompressedCellTier;
+
+namespace {
+
+// a column of small ints, as raw scalar chunks mostly are
+std::vector<char>
+MakeColumn(size_t rows) {
+    std::vector<int64_t> values(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        values[i] = static_cast<int64_t>(i % 100);
+    }
+    std::vector<char> bytes(rows * sizeof(int64_t));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    return bytes;
+}
+
+// a sparse float vector chunk of rows of sorted indices
+std::vector<char>
+MakeSparseChunk(size_t rows, size_t nnz) {
+    auto rows_offset = sizeof(uint64_t) * (rows + 1);
+    std::vector<char> chunk(rows_offset + rows * nnz * 8);
+    for (size_t i = 0; i <= rows; ++i) {
+        uint64_t offset = rows_offset + i * nnz * 8;
+        std::memcpy(chunk.data() + i * sizeof(uint64_t), &offset, 8);
+    }
+    std::mt19937 random(42);
+    for (size_t i = 0; i < rows * nnz; ++i) {
+        uint32_t index = (i % nnz) * 100 + random() % 100;
+        float value = (random() % 1000) / 100.0f;
+        std::memcpy(chunk.data() + rows_offset + i * 8, &index, 4);
+        std::memcpy(chunk.data() + rows_offset + i * 8 + 4, &value, 4);
+    }
+    return chunk;
+}
+
+}  // namespace
+
+class CompressedCellTierTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        CompressedCellTier::Instance().Clear();
+        CompressedCellTier::Instance().SetCapacityBytes(1 << 20);
+    }
+
+    void
+    TearDown() override {
+        CompressedCellTier::Instance().Clear();
+        CompressedCellTier::Instance().SetCapacityBytes(0);
+    }
+};
+
+TEST_F(CompressedCellTierTest, PutAndTake) {
+    auto& tier = CompressedCellTier::Instance();
+    auto column = MakeColumn(10000);
+    ASSERT_TRUE(
+        tier.Put("seg_1_f_100", 3, column.data(), column.size(), 10000));
+    EXPECT_EQ(tier.GetEntryCount(), 1);
+    auto compressed_bytes = tier.CompressedBytes("seg_1_f_100", 3);
+    EXPECT_GT(compressed_bytes, 0);
+    EXPECT_LT(compressed_bytes, column.size() / 2);
+    EXPECT_EQ(tier.GetCurrentBytes(), compressed_bytes);
+    EXPECT_EQ(tier.CompressedBytes("seg_1_f_100", 4), 0);
+    EXPECT_FALSE(tier.Take("seg_1_f_100", 4).has_value());
+
+    auto cell = tier.Take("seg_1_f_100", 3);
+    ASSERT_TRUE(cell.has_value());
+    EXPECT_EQ(cell->size, column.size());
+    EXPECT_EQ(cell->row_nums, 10000);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(cell->data.get()) %
+                  CompressedCellTier::kAlignment,
+              0);
+    EXPECT_EQ(std::memcmp(cell->data.get(), column.data(), column.size()), 0);
+    // the cell is resident again
+    EXPECT_EQ(tier.GetEntryCount(), 0);
+    EXPECT_EQ(tier.GetCurrentBytes(), 0);
+    EXPECT_FALSE(tier.Take("seg_1_f_100", 3).has_value());
+}
+
+TEST_F(CompressedCellTierTest, RejectsIncompressibleCells) {
+    std::vector<char> noise(64 * 1024);
+    std::mt19937 random(42);
+    for (auto& byte : noise) {
+        byte = static_cast<char>(random());
+    }
+    auto& tier = CompressedCellTier::Instance();
+    EXPECT_FALSE(tier.Put("seg_1_f_100", 0, noise.data(), noise.size(), 1));
+    EXPECT_EQ(tier.GetEntryCount(), 0);
+}
+
+TEST_F(CompressedCellTierTest, Capacity) {
+    auto& tier = CompressedCellTier::Instance();
+    auto column = MakeColumn(10000);
+    ASSERT_TRUE(tier.Put("seg_1_f_100", 0, column.data(), column.size(), 1));
+    auto cell_bytes = tier.GetCurrentBytes();
+    tier.SetCapacityBytes(cell_bytes * 2);
+    ASSERT_TRUE(tier.Put("seg_1_f_100", 1, column.data(), column.size(), 1));
+    // the least recently kept cell makes room
+    ASSERT_TRUE(tier.Put("seg_2_f_100", 0, column.data(), column.size(), 1));
+    EXPECT_EQ(tier.GetEntryCount(), 2);
+    EXPECT_EQ(tier.CompressedBytes("seg_1_f_100", 0), 0);
+    EXPECT_GT(tier.CompressedBytes("seg_1_f_100", 1), 0);
+    EXPECT_LE(tier.GetCurrentBytes(), tier.GetCapacityBytes());
+
+    tier.EraseSource("seg_1_f_100");
+    EXPECT_EQ(tier.GetEntryCount(), 1);
+    EXPECT_EQ(tier.GetCurrentBytes(), cell_bytes);
+
+    tier.SetCapacityBytes(0);
+    EXPECT_EQ(tier.GetEntryCount(), 0);
+    EXPECT_FALSE(tier.Put("seg_1_f_100", 0, column.data(), column.size(), 1));
+}
+
+TEST_F(CompressedCellTierTest, KeepOnEviction) {
+    auto& tier = CompressedCellTier::Instance();
+    auto column = std::make_shared<std::vector<char>>(MakeColumn(10000));
+    auto source = std::make_shared<CompressedCellSource>("seg_1_f_100");
+
+    auto owner = CompressedCellTier::KeepOnEviction(
+        source, 5, column->data(), column->size(), 10000, column);
+    std::weak_ptr<std::vector<char>> memory = column;
+    column.reset();
+    EXPECT_FALSE(memory.expired());
+    owner.reset();
+    // the eviction is compressed in the background, then the memory freed
+    for (int i = 0; i < 500 && !memory.expired(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(memory.expired());
+    auto cell = tier.Take("seg_1_f_100", 5);
+    ASSERT_TRUE(cell.has_value());
+    EXPECT_EQ(cell->row_nums, 10000);
+
+    // the cells of a retired source are freed at once
+    source->retired.store(true);
+    column = std::make_shared<std::vector<char>>(MakeColumn(10000));
+    owner = CompressedCellTier::KeepOnEviction(
+        source, 6, column->data(), column->size(), 10000, column);
+    memory = column;
+    column.reset();
+    owner.reset();
+    EXPECT_TRUE(memory.expired());
+    EXPECT_EQ(tier.GetEntryCount(), 0);
+}
+
+TEST_F(CompressedCellTierTest, SparseCells) {
+    auto& tier = CompressedCellTier::Instance();
+    auto chunk = MakeSparseChunk(100, 50);
+    ASSERT_TRUE(tier.PutSparse(
+        "seg_1_f_101", 0, chunk.data(), chunk.size(), 100, false));
+    auto fp32_bytes = tier.CompressedBytes("seg_1_f_101", 0);
+    EXPECT_LT(fp32_bytes * CompressedCellTier::kMinSparseCompressionRatio,
+              chunk.size());
+    auto cell = tier.Take("seg_1_f_101", 0);
+    ASSERT_TRUE(cell.has_value());
+    ASSERT_EQ(cell->size, chunk.size());
+    EXPECT_EQ(std::memcmp(cell->data.get(), chunk.data(), chunk.size()), 0);
+
+    tier.SetSparseValueCodec(milvus::SparseValueCodec::FP16);
+    ASSERT_TRUE(tier.PutSparse(
+        "seg_1_f_101", 0, chunk.data(), chunk.size(), 100, false));
+    EXPECT_LT(tier.CompressedBytes("seg_1_f_101", 0), fp32_bytes);
+    tier.SetSparseValueCodec(milvus::SparseValueCodec::FP32);
+}
@@ -0,0 +1,417 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+namespace milvus::segcore {
+
+// B+-tree of unique keys with optimistic lock coupling: every node carries a
+// version that is odd while a writer holds the node. Readers never lock, they
+// read a node, check its version did not move and restart otherwise. Writers
+// lock the nodes they change, splitting full nodes on the way down so a split
+// never climbs back up. Keys only ever get inserted, and nodes are not freed
+// before Clear(), so a stale pointer still points to a live node.
+//
+// Leaves are linked left to right for scans. A scan sees every key inserted
+// before it started, keys inserted during the scan may or may not show up.
+template <typename Key>
+class ConcurrentBTree {
+    static_assert(std::is_trivially_copyable_v<Key>,
+                  "keys are read while writers may be changing them");
+
+ public:
+    ConcurrentBTree() : root_(NewLeaf()) {
+    }
+
+    ConcurrentBTree(const ConcurrentBTree&) = delete;
+    ConcurrentBTree&
+    operator=(const ConcurrentBTree&) = delete;
+
+    ~ConcurrentBTree() {
+        Free(root_.load(std::memory_order_relaxed));
+    }
+
+    void
+    Insert(const Key& key) {
+        for (size_t restarts = 0; !TryInsert(key); ++restarts) {
+            Backoff(restarts);
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // calls visit(key) for the keys not less than from in ascending order,
+    // until visit returns false
+    template <typename Visit>
+    void
+    Scan(const Key& from, Visit&& visit) const {
+        Key keys[kLeafCapacity];
+        size_t n = 0;
+        const Leaf* next = nullptr;
+        for (size_t restarts = 0; !TryCopyFirstLeaf(from, keys, n, next);
+             ++restarts) {
+            Backoff(restarts);
+        }
+        size_t begin = std::lower_bound(keys, keys + n, from) - keys;
+        for (auto i = begin; i < n; ++i) {
+            if (!visit(keys[i])) {
+                return;
+            }
+        }
+        while (next != nullptr) {
+            auto leaf = next;
+            for (size_t restarts = 0; !TryCopyLeaf(leaf, keys, n, next);
+                 ++restarts) {
+                Backoff(restarts);
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (!visit(keys[i])) {
+                    return;
+                }
+            }
+        }
+    }
+
+    bool
+    Empty() const {
+        return Size() == 0;
+    }
+
+    size_t
+    Size() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    size_t
+    MemorySize() const {
+        return memory_size_.load(std::memory_order_relaxed);
+    }
+
+    // not safe against concurrent inserts or scans
+    void
+    Clear() {
+        Free(root_.load(std::memory_order_relaxed));
+        size_.store(0, std::memory_order_relaxed);
+        memory_size_.store(0, std::memory_order_relaxed);
+        root_.store(NewLeaf(), std::memory_order_release);
+    }
+
+ private:
+    // a node of either kind fits in a few cache lines
+    static constexpr size_t kNodeBytes = 512;
+    static constexpr size_t kLeafCapacity = kNodeBytes / sizeof(Key);
+    static constexpr size_t kInnerCapacity =
+        kNodeBytes / (sizeof(Key) + sizeof(void*));
+    static_assert(kLeafCapacity >= 4 && kInnerCapacity >= 4,
+                  "key too large for the node size");
+
+    struct Node {
+        explicit Node(bool is_leaf) : is_leaf_(is_leaf) {
+        }
+
+        std::atomic<uint64_t> version_{0};
+        std::atomic<uint16_t> count_{0};
+        const bool is_leaf_;
+    };
+
+    struct Leaf : Node {
+        Leaf() : Node(true) {
+        }
+
+        Key keys_[kLeafCapacity];
+        std::atomic<const Leaf*> next_{nullptr};
+    };
+
+    // children_[i] holds the keys in [keys_[i - 1], keys_[i])
+    struct Inner : Node {
+        Inner() : Node(false) {
+            std::fill(children_, children_ + kInnerCapacity + 1, nullptr);
+        }
+
+        Key keys_[kInnerCapacity];
+        Node* children_[kInnerCapacity + 1];
+    };
+
+    Leaf*
+    NewLeaf() {
+        memory_size_.fetch_add(sizeof(Leaf), std::memory_order_relaxed);
+        return new Leaf();
+    }
+
+    Inner*
+    NewInner() {
+        memory_size_.fetch_add(sizeof(Inner), std::memory_order_relaxed);
+        return new Inner();
+    }
+
+    static void
+    Free(Node* node) {
+        if (!node->is_leaf_) {
+            auto inner = static_cast<Inner*>(node);
+            for (size_t i = 0; i <= Count(inner); ++i) {
+                Free(inner->children_[i]);
+            }
+            delete inner;
+        } else {
+            delete static_cast<Leaf*>(node);
+        }
+    }
+
+    static void
+    Backoff(size_t restarts) {
+        if (restarts >= 16) {
+            std::this_thread::yield();
+        }
+    }
+
+    // the count as seen by an optimistic reader, may be garbage until the
+    // version is validated, but never out of bounds
+    static size_t
+    Count(const Leaf* leaf) {
+        return std::min<size_t>(
+            leaf->count_.load(std::memory_order_relaxed), kLeafCapacity);
+    }
+
+    static size_t
+    Count(const Inner* inner) {
+        return std::min<size_t>(
+            inner->count_.load(std::memory_order_relaxed), kInnerCapacity);
+    }
+
+    static bool
+    ReadLock(const Node* node, uint64_t& version) {
+        version = node->version_.load(std::memory_order_acquire);
+        return (version & 1) == 0;
+    }
+
+    // true when nothing changed the node since ReadLock returned version
+    static bool
+    Validate(const Node* node, uint64_t version) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return node->version_.load(std::memory_order_relaxed) == version;
+    }
+
+    static bool
+    Upgrade(Node* node, uint64_t version) {
+        return node->version_.compare_exchange_strong(
+            version, version + 1, std::memory_order_acquire);
+    }
+
+    static void
+    Unlock(Node* node) {
+        node->version_.fetch_add(1, std::memory_order_release);
+    }
+
+    static size_t
+    ChildIndex(const Inner* inner, const Key& key) {
+        return std::upper_bound(
+                   inner->keys_, inner->keys_ + Count(inner), key) -
+               inner->keys_;
+    }
+
+    bool
+    TryInsert(const Key& key) {
+        Node* node = root_.load(std::memory_order_acquire);
+        uint64_t version;
+        if (!ReadLock(node, version) ||
+            node != root_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        Inner* parent = nullptr;
+        uint64_t parent_version = 0;
+        while (!node->is_leaf_) {
+            auto inner = static_cast<Inner*>(node);
+            if (Count(inner) == kInnerCapacity) {
+                if (!LockForSplit(parent, parent_version, inner, version)) {
+                    return false;
+                }
+                Key separator;
+                auto right = SplitInner(inner, separator);
+                Publish(parent, inner, separator, right);
+                return false;
+            }
+            Node* child = inner->children_[ChildIndex(inner, key)];
+            uint64_t child_version;
+            if (child == nullptr || !ReadLock(child, child_version) ||
+                !Validate(inner, version)) {
+                return false;
+            }
+            parent = inner;
+            parent_version = version;
+            node = child;
+            version = child_version;
+        }
+
+        auto leaf = static_cast<Leaf*>(node);
+        if (Count(leaf) == kLeafCapacity) {
+            if (!LockForSplit(parent, parent_version, leaf, version)) {
+                return false;
+            }
+            Key separator;
+            auto right = SplitLeaf(leaf, key, separator);
+            Publish(parent, leaf, separator, right);
+            return false;
+        }
+        if (!Upgrade(leaf, version)) {
+            return false;
+        }
+        auto count = Count(leaf);
+        auto pos = std::lower_bound(leaf->keys_, leaf->keys_ + count, key) -
+                   leaf->keys_;
+        std::copy_backward(
+            leaf->keys_ + pos, leaf->keys_ + count, leaf->keys_ + count + 1);
+        leaf->keys_[pos] = key;
+        leaf->count_.store(count + 1, std::memory_order_relaxed);
+        Unlock(leaf);
+        return true;
+    }
+
+    // locks the full node and its parent, which has room for the separator
+    // since full inner nodes get split on the way down
+    bool
+    LockForSplit(Inner* parent,
+                 uint64_t parent_version,
+                 Node* node,
+                 uint64_t version) {
+        if (parent != nullptr && !Upgrade(parent, parent_version)) {
+            return false;
+        }
+        if (!Upgrade(node, version)) {
+            if (parent != nullptr) {
+                Unlock(parent);
+            }
+            return false;
+        }
+        if (parent == nullptr &&
+            node != root_.load(std::memory_order_acquire)) {
+            // another writer grew the tree above the node
+            Unlock(node);
+            return false;
+        }
+        return true;
+    }
+
+    // links right into parent, or into a new root, and releases the locks
+    void
+    Publish(Inner* parent, Node* left, const Key& separator, Node* right) {
+        if (parent == nullptr) {
+            auto root = NewInner();
+            root->keys_[0] = separator;
+            root->children_[0] = left;
+            root->children_[1] = right;
+            root->count_.store(1, std::memory_order_relaxed);
+            root_.store(root, std::memory_order_release);
+        } else {
+            auto count = Count(parent);
+            auto pos = ChildIndex(parent, separator);
+            std::copy_backward(parent->keys_ + pos,
+                               parent->keys_ + count,
+                               parent->keys_ + count + 1);
+            std::copy_backward(parent->children_ + pos + 1,
+                               parent->children_ + count + 1,
+                               parent->children_ + count + 2);
+            parent->keys_[pos] = separator;
+            parent->children_[pos + 1] = right;
+            parent->count_.store(count + 1, std::memory_order_relaxed);
+        }
+        Unlock(left);
+        if (parent != nullptr) {
+            Unlock(parent);
+        }
+    }
+
+    Leaf*
+    SplitLeaf(Leaf* leaf, const Key& key, Key& separator) {
+        auto count = Count(leaf);
+        // appends, as with auto ids, keep the left leaf full
+        auto split =
+            leaf->keys_[count - 1] < key ? count - 1 : count / 2;
+        auto right = NewLeaf();
+        std::copy(
+            leaf->keys_ + split, leaf->keys_ + count, right->keys_);
+        right->count_.store(count - split, std::memory_order_relaxed);
+        right->next_.store(leaf->next_.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+        // scans may reach right as soon as it is linked
+        leaf->next_.store(right, std::memory_order_release);
+        leaf->count_.store(split, std::memory_order_relaxed);
+        separator = right->keys_[0];
+        return right;
+    }
+
+    Inner*
+    SplitInner(Inner* inner, Key& separator) {
+        auto count = Count(inner);
+        auto mid = count / 2;
+        auto right = NewInner();
+        separator = inner->keys_[mid];
+        std::copy(inner->keys_ + mid + 1,
+                  inner->keys_ + count,
+                  right->keys_);
+        std::copy(inner->children_ + mid + 1,
+                  inner->children_ + count + 1,
+                  right->children_);
+        right->count_.store(count - mid - 1, std::memory_order_relaxed);
+        inner->count_.store(mid, std::memory_order_relaxed);
+        return right;
+    }
+
+    // copies the leaf which holds the first key not less than from
+    bool
+    TryCopyFirstLeaf(const Key& from,
+                     Key* keys,
+                     size_t& n,
+                     const Leaf*& next) const {
+        const Node* node = root_.load(std::memory_order_acquire);
+        uint64_t version;
+        if (!ReadLock(node, version)) {
+            return false;
+        }
+        while (!node->is_leaf_) {
+            auto inner = static_cast<const Inner*>(node);
+            const Node* child = inner->children_[ChildIndex(inner, from)];
+            uint64_t child_version;
+            if (child == nullptr || !ReadLock(child, child_version) ||
+                !Validate(inner, version)) {
+                return false;
+            }
+            node = child;
+            version = child_version;
+        }
+        return TryCopyLeaf(static_cast<const Leaf*>(node), keys, n, next);
+    }
+
+    static bool
+    TryCopyLeaf(const Leaf* leaf, Key* keys, size_t& n, const Leaf*& next) {
+        uint64_t version;
+        if (!ReadLock(leaf, version)) {
+            return false;
+        }
+        n = Count(leaf);
+        std::copy(leaf->keys_, leaf->keys_ + n, keys);
+        next = leaf->next_.load(std::memory_order_acquire);
+        return Validate(leaf, version);
+    }
+
+ private:
+    // ahead of root_, the constructor counts the first leaf
+    std::atomic<size_t> size_{0};
+    std::atomic<size_t> memory_size_{0};
+    std::atomic<Node*> root_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,136 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "segcore/ConcurrentBTree.h"
+#include "segcore/InsertRecord.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+TEST(ConcurrentBTreeTest, ScanFrom) {
+    ConcurrentBTree<int64_t> tree;
+    std::set<int64_t> expected;
+    std::default_random_engine er(42);
+    for (int i = 0; i < 10000; i++) {
+        auto key = static_cast<int64_t>(er() % 100000);
+        if (expected.insert(key).second) {
+            tree.Insert(key);
+        }
+    }
+    ASSERT_EQ(tree.Size(), expected.size());
+
+    for (int64_t from : {-1L, 0L, 500L, 99999L, 100000L}) {
+        std::vector<int64_t> keys;
+        tree.Scan(from, [&](int64_t key) {
+            keys.push_back(key);
+            return keys.size() < 100;
+        });
+        std::vector<int64_t> expected_keys(expected.lower_bound(from),
+                                           expected.end());
+        expected_keys.resize(std::min<size_t>(expected_keys.size(), 100));
+        ASSERT_EQ(keys, expected_keys) << from;
+    }
+}
+
+TEST(ConcurrentBTreeTest, ConcurrentInsertAndScan) {
+    ConcurrentBTree<int64_t> tree;
+    constexpr int64_t kWriters = 4;
+    constexpr int64_t kKeysPerWriter = 50000;
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> unordered{0};
+
+    std::vector<std::thread> writers;
+    for (int64_t w = 0; w < kWriters; w++) {
+        writers.emplace_back([&tree, w]() {
+            for (int64_t i = 0; i < kKeysPerWriter; i++) {
+                tree.Insert(i * kWriters + w);
+            }
+        });
+    }
+    std::thread reader([&]() {
+        while (!stop.load()) {
+            int64_t prev = -1;
+            tree.Scan(0, [&](int64_t key) {
+                if (key <= prev) {
+                    unordered++;
+                }
+                prev = key;
+                return true;
+            });
+        }
+    });
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    stop.store(true);
+    reader.join();
+
+    EXPECT_EQ(unordered.load(), 0);
+    ASSERT_EQ(tree.Size(), kWriters * kKeysPerWriter);
+    int64_t expected = 0;
+    tree.Scan(0, [&](int64_t key) {
+        EXPECT_EQ(key, expected);
+        expected++;
+        return true;
+    });
+    EXPECT_EQ(expected, kWriters * kKeysPerWriter);
+}
+
+TEST(ConcurrentBTreeTest, OffsetBTreeMapMatchesOrderedMap) {
+    OffsetOrderedMap<int64_t> map;
+    OffsetBTreeMap btree_map;
+    std::default_random_engine er(42);
+    int64_t num = 2000;
+    for (int64_t i = 0; i < num; i++) {
+        // duplicated pks, as upserts leave them in growing segments
+        auto pk = static_cast<int64_t>(er() % 500);
+        map.insert(pk, i);
+        btree_map.insert(pk, i);
+    }
+
+    BitsetType filtered(num);
+    for (int64_t i = 0; i < num; i += 3) {
+        filtered[i] = true;
+    }
+    BitsetTypeView filtered_view(filtered.data(), num);
+    for (int64_t limit : {0L, 10L, Unlimited}) {
+        ASSERT_EQ(map.find_first(limit, filtered_view),
+                  btree_map.find_first(limit, filtered_view))
+            << limit;
+    }
+
+    for (int64_t pk : {-1L, 0L, 123L, 499L, 500L}) {
+        ASSERT_EQ(map.contain(pk), btree_map.contain(pk));
+        ASSERT_EQ(map.find(pk), btree_map.find(pk));
+        for (auto op : {proto::plan::OpType::Equal,
+                        proto::plan::OpType::GreaterEqual,
+                        proto::plan::OpType::GreaterThan,
+                        proto::plan::OpType::LessEqual,
+                        proto::plan::OpType::LessThan}) {
+            BitsetType expected(num);
+            BitsetType res(num);
+            BitsetTypeView expected_view(expected.data(), num);
+            BitsetTypeView res_view(res.data(), num);
+            auto condition = [](int64_t offset) { return offset % 2 == 0; };
+            map.find_range(pk, op, expected_view, condition);
+            btree_map.find_range(pk, op, res_view, condition);
+            ASSERT_TRUE(expected == res) << pk << " " << op;
+        }
+    }
+}
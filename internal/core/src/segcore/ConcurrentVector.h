@@ -14,6 +14,7 @@
 #include <fmt/core.h>
 #include <tbb/concurrent_vector.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <deque>
@@ -38,66 +39,70 @@
 
 namespace milvus::segcore {
 
+// Valid bits of a nullable field, appended under mutex_ and read without a
+// lock. Rows are published through data_ptr_ and length_; when the buffer
+// has to grow, the bits move to one of twice the capacity and the old one is
+// kept in retired_, so a reader still using it reads the same bits.
 class ThreadSafeValidData {
  public:
     explicit ThreadSafeValidData() = default;
     explicit ThreadSafeValidData(FixedVector<bool> data)
         : data_(std::move(data)) {
+        publish(data_.size());
     }
 
     void
     set_data_raw(const std::vector<FieldDataPtr>& datas) {
-        std::unique_lock<std::shared_mutex> lck(mutex_);
+        std::lock_guard<std::mutex> lck(mutex_);
         auto total = 0;
         for (auto& field_data : datas) {
             total += field_data->get_num_rows();
         }
-        if (length_ + total > data_.size()) {
-            data_.resize(length_ + total);
-        }
+        auto length = length_.load(std::memory_order_relaxed);
+        reserve(length + total);
 
         for (auto& field_data : datas) {
             auto num_row = field_data->get_num_rows();
             for (size_t i = 0; i < num_row; i++) {
-                data_[length_ + i] = field_data->is_valid(i);
+                data_[length + i] = field_data->is_valid(i);
             }
-            length_ += num_row;
+            length += num_row;
         }
+        publish(length);
     }
 
     void
     set_data_raw(size_t num_rows,
                  const DataArray* data,
                  const FieldMeta& field_meta) {
-        std::unique_lock<std::shared_mutex> lck(mutex_);
+        std::lock_guard<std::mutex> lck(mutex_);
         if (field_meta.is_nullable()) {
-            if (length_ + num_rows > data_.size()) {
-                data_.resize(length_ + num_rows);
-            }
+            auto length = length_.load(std::memory_order_relaxed);
+            reserve(length + num_rows);
             auto src = data->valid_data().data();
-            std::copy_n(src, num_rows, data_.data() + length_);
-            length_ += num_rows;
+            std::copy_n(src, num_rows, data_.data() + length);
+            publish(length + num_rows);
         }
     }
 
     bool
     is_valid(size_t offset) const {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
-        AssertInfo(offset < length_,
+        auto length = length_.load(std::memory_order_acquire);
+        AssertInfo(offset < length,
                    "offset out of range, offset={}, length_={}",
                    offset,
-                   length_);
-        return data_[offset];
+                   length);
+        return data_ptr_.load(std::memory_order_acquire)[offset];
     }
 
     bool*
     get_chunk_data(size_t offset) {
-        std::shared_lock<std::shared_mutex> lck(mutex_);
-        AssertInfo(offset < length_,
+        auto length = length_.load(std::memory_order_acquire);
+        AssertInfo(offset < length,
                    "offset out of range, offset={}, length_={}",
                    offset,
-                   length_);
-        return &data_[offset];
+                   length);
+        return data_ptr_.load(std::memory_order_acquire) + offset;
     }
 
     const FixedVector<bool>&
@@ -106,10 +111,35 @@ class ThreadSafeValidData {
     }
 
  private:
-    mutable std::shared_mutex mutex_{};
+    // makes room for size rows without moving the published ones
+    void
+    reserve(size_t size) {
+        if (size > data_.capacity()) {
+            FixedVector<bool> grown;
+            grown.reserve(std::max(size, 2 * data_.capacity()));
+            grown.assign(data_.begin(), data_.end());
+            retired_.push_back(std::move(data_));
+            data_ = std::move(grown);
+        }
+        if (size > data_.size()) {
+            data_.resize(size);
+        }
+    }
+
+    void
+    publish(size_t length) {
+        data_ptr_.store(data_.data(), std::memory_order_release);
+        length_.store(length, std::memory_order_release);
+    }
+
+ private:
+    // serializes appends
+    std::mutex mutex_;
     FixedVector<bool> data_;
+    std::vector<FixedVector<bool>> retired_;
+    std::atomic<bool*> data_ptr_{nullptr};
     // number of actual elements
-    size_t length_{0};
+    std::atomic<size_t> length_{0};
 };
 using ThreadSafeValidDataPtr = std::shared_ptr<ThreadSafeValidData>;
 
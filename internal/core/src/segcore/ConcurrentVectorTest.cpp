@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
 #include <random>
 #include <string>
 #include <thread>
@@ -110,3 +112,39 @@ TEST(ConcurrentVector, TestAckSingle) {
     }
     EXPECT_EQ(ack.GetAck(), N);
 }
+
+TEST(ConcurrentVector, TestReadWhileGrowing) {
+    // small chunks, so the chunk directory grows many times
+    constexpr int64_t size_per_chunk = 4;
+    constexpr int64_t N = 20000;
+    ConcurrentVector<int64_t> c_vec(size_per_chunk);
+    std::atomic<int64_t> ack_counter = 0;
+    std::atomic<bool> stop = false;
+    std::atomic<int64_t> mismatches = 0;
+
+    std::thread reader([&]() {
+        while (!stop.load()) {
+            auto acked = ack_counter.load();
+            for (auto i = std::max<int64_t>(0, acked - 64); i < acked; ++i) {
+                auto chunk = static_cast<const int64_t*>(
+                    c_vec.get_chunk_data(i / size_per_chunk));
+                if (chunk[i % size_per_chunk] != i * 3) {
+                    mismatches++;
+                }
+            }
+        }
+    });
+    for (int64_t i = 0; i < N; ++i) {
+        int64_t value = i * 3;
+        c_vec.set_data_raw(i, &value, 1);
+        ack_counter.store(i + 1);
+    }
+    stop.store(true);
+    reader.join();
+
+    EXPECT_EQ(mismatches.load(), 0);
+    ASSERT_EQ(c_vec.num_chunk(), N / size_per_chunk);
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(c_vec[i], i * 3);
+    }
+}
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -68,12 +69,14 @@ struct DeleteSnapshot {
 template <bool is_sealed = false>
 class DeletedRecord {
  public:
+    // calls cb with every row pks[i] deletes at timestamps[i]
+    using SearchPkFunc = std::function<void(
+        const std::vector<PkType>& pks,
+        const Timestamp* timestamps,
+        std::function<void(SegOffset offset, Timestamp ts)> cb)>;
+
     DeletedRecord(InsertRecord<is_sealed>* insert_record,
-                  std::function<void(
-                      const std::vector<PkType>& pks,
-                      const Timestamp* timestamps,
-                      std::function<void(SegOffset offset, Timestamp ts)> cb)>
-                      search_pk_func,
+                  SearchPkFunc search_pk_func,
                   int64_t segment_id)
         : insert_record_(insert_record),
           search_pk_func_(std::move(search_pk_func)),
@@ -102,24 +105,63 @@ class DeletedRecord {
             return;
         }
 
+        auto min_deleted_ts =
+            *std::min_element(timestamps, timestamps + pks.size());
         auto max_deleted_ts = InternalPush(pks, timestamps);
 
         if (max_deleted_ts > max_load_timestamp_) {
             max_load_timestamp_ = max_deleted_ts;
         }
 
-        //TODO: add support for dump snapshot when load finished
+        // delta logs are not ordered against each other, a checkpoint whose
+        // cursor lies after the smallest timestamp of this batch no longer
+        // covers every entry before the cursor, drop it and dump again so
+        // queries on loaded segments start from a checkpoint instead of
+        // walking all deletes
+        TruncateSnapshots(min_deleted_ts);
+        DumpSnapshot();
+
+        if (ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION.load()) {
+            UpdateLatestSnapshot(max_deleted_ts);
+        }
     }
 
     // stream push delete timestamps should be sorted outside of the interface
     // considering concurrent query and push
     void
     StreamPush(const std::vector<PkType>& pks, const Timestamp* timestamps) {
+        StreamPush(pks, timestamps, search_pk_func_);
+    }
+
+    // like StreamPush, with the rows of the deletes found by the caller,
+    // offsets[i] the rows pks[i] deletes
+    void
+    StreamPushOffsets(const std::vector<PkType>& pks,
+                      const Timestamp* timestamps,
+                      const std::vector<std::vector<int64_t>>& offsets) {
+        StreamPush(
+            pks,
+            timestamps,
+            [&offsets](const std::vector<PkType>& pks,
+                       const Timestamp* timestamps,
+                       std::function<void(SegOffset offset, Timestamp ts)> cb) {
+                for (size_t i = 0; i < pks.size(); ++i) {
+                    for (auto offset : offsets[i]) {
+                        cb(SegOffset(offset), timestamps[i]);
+                    }
+                }
+            });
+    }
+
+    void
+    StreamPush(const std::vector<PkType>& pks,
+               const Timestamp* timestamps,
+               const SearchPkFunc& search_pk_func) {
         if (pks.empty()) {
             return;
         }
 
-        auto max_ts = InternalPush(pks, timestamps);
+        auto max_ts = InternalPush(pks, timestamps, search_pk_func);
 
         if (ENABLE_LATEST_DELETE_SNAPSHOT_OPTIMIZATION.load()) {
             UpdateLatestSnapshot(max_ts);
@@ -133,6 +175,13 @@ class DeletedRecord {
 
     Timestamp
     InternalPush(const std::vector<PkType>& pks, const Timestamp* timestamps) {
+        return InternalPush(pks, timestamps, search_pk_func_);
+    }
+
+    Timestamp
+    InternalPush(const std::vector<PkType>& pks,
+                 const Timestamp* timestamps,
+                 const SearchPkFunc& search_pk_func) {
         int64_t removed_num = 0;
         int64_t mem_add = 0;
         Timestamp max_timestamp = 0;
@@ -144,7 +193,7 @@ class DeletedRecord {
                 max_timestamp = deleted_ts;
             }
         }
-        search_pk_func_(
+        search_pk_func(
             pks,
             timestamps,
             [&](const SegOffset offset, const Timestamp delete_ts) {
@@ -208,6 +257,17 @@ class DeletedRecord {
     UpdateLatestSnapshot(Timestamp new_max_ts) {
         std::lock_guard<std::mutex> lock(snapshot_update_mutex_);
 
+        // deleted_mask_ holds every delete pushed so far, so the snapshot
+        // timestamp must never move backwards, otherwise a stream delete
+        // older than the loaded ones would expose newer deletes to old queries
+        auto current = std::atomic_load(&latest_snapshot_);
+        if (current && current->max_ts > new_max_ts) {
+            new_max_ts = current->max_ts;
+        }
+        if (max_load_timestamp_ > new_max_ts) {
+            new_max_ts = max_load_timestamp_;
+        }
+
         auto new_snapshot =
             std::make_shared<const DeleteSnapshot>(new_max_ts, deleted_mask_);
 
@@ -240,21 +300,22 @@ class DeletedRecord {
         SortedDeleteList::iterator next_iter;
         {
             std::shared_lock<std::shared_mutex> lock(snap_lock_);
-            // find last meeted snapshot
-            if (!snapshots_.empty()) {
-                int loc = snapshots_.size() - 1;
-                while (loc >= 0 && snapshots_[loc].first > query_timestamp) {
-                    loc--;
-                }
-                if (loc >= 0) {
-                    // use lower_bound to relocate the iterator in current accessor
-                    next_iter = accessor.lower_bound(snap_next_pos_[loc]);
-                    auto or_size =
-                        std::min(snapshots_[loc].second.size(), bitset.size());
-                    bitset.inplace_or_with_count(snapshots_[loc].second,
-                                                 or_size);
-                    hit_snapshot = true;
-                }
+            // find last meeted snapshot, snapshots are ordered by timestamp
+            auto upper = std::upper_bound(
+                snapshots_.begin(),
+                snapshots_.end(),
+                query_timestamp,
+                [](Timestamp ts, const std::pair<Timestamp, BitsetType>& snap) {
+                    return ts < snap.first;
+                });
+            if (upper != snapshots_.begin()) {
+                auto loc = std::distance(snapshots_.begin(), upper) - 1;
+                // use lower_bound to relocate the iterator in current accessor
+                next_iter = accessor.lower_bound(snap_next_pos_[loc]);
+                auto or_size =
+                    std::min(snapshots_[loc].second.size(), bitset.size());
+                bitset.inplace_or_with_count(snapshots_[loc].second, or_size);
+                hit_snapshot = true;
             }
         }
 
@@ -325,12 +386,17 @@ class DeletedRecord {
                         snapshots_.back().second = std::move(bitmap.clone());
                         Assert(it != accessor.end() && it.good());
                         snap_next_pos_.back() = *it;
+                        snap_entry_counts_.back() =
+                            dumped_entry_count_.load() + DELETE_DUMP_BATCH_SIZE;
                     } else {
                         // add new snapshot
                         snapshots_.push_back(
                             std::make_pair(dump_ts, bitmap.clone()));
                         Assert(it != accessor.end() && it.good());
                         snap_next_pos_.push_back(*it);
+                        snap_entry_counts_.push_back(
+                            dumped_entry_count_.load() +
+                            DELETE_DUMP_BATCH_SIZE);
                     }
                 }
 
@@ -349,6 +415,32 @@ class DeletedRecord {
         }
     }
 
+    // drop snapshots which may miss entries with timestamp >= min_ts,
+    // the following DumpSnapshot rebuilds them from the last valid one
+    void
+    TruncateSnapshots(Timestamp min_ts) {
+        std::unique_lock<std::shared_mutex> lock(snap_lock_);
+        size_t keep = 0;
+        while (keep < snap_next_pos_.size() &&
+               snap_next_pos_[keep].first < min_ts) {
+            keep++;
+        }
+        if (keep == snapshots_.size()) {
+            return;
+        }
+        LOG_INFO(
+            "truncate delete record snapshots from {} to {} at ts: {} for "
+            "segment: {}",
+            snapshots_.size(),
+            keep,
+            min_ts,
+            segment_id_);
+        snapshots_.resize(keep);
+        snap_next_pos_.resize(keep);
+        snap_entry_counts_.resize(keep);
+        dumped_entry_count_.store(keep == 0 ? 0 : snap_entry_counts_.back());
+    }
+
     int64_t
     size() const {
         SortedDeleteList::Accessor accessor(deleted_lists_);
@@ -381,10 +473,7 @@ class DeletedRecord {
     std::atomic<int64_t> mem_size_ = 0;
     std::conditional_t<is_sealed, InsertRecordSealed, InsertRecordGrowing>*
         insert_record_;
-    std::function<void(const std::vector<PkType>& pks,
-                       const Timestamp* timestamps,
-                       std::function<void(SegOffset offset, Timestamp ts)>)>
-        search_pk_func_;
+    SearchPkFunc search_pk_func_;
     int64_t segment_id_{0};
     std::shared_ptr<SortedDeleteList> deleted_lists_;
     // max timestamp of deleted records which replayed in load process
@@ -399,6 +488,8 @@ class DeletedRecord {
     // next delete record position that follows every snapshot
     // store position (timestamp, offset)
     std::vector<std::pair<Timestamp, Offset>> snap_next_pos_;
+    // number of delete entries covered by every snapshot
+    std::vector<int64_t> snap_entry_counts_;
     // total number of delete entries that have been incorporated into snapshots
     std::atomic<int64_t> dumped_entry_count_{0};
     // estimated memory size of DeletedRecord, only used for sealed segment
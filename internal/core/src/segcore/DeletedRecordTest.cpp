@@ -854,3 +854,79 @@ TEST(DeleteMVCC, SnapshotDumpProgress) {
     ASSERT_EQ(2, snapshots.size());
     ASSERT_EQ(20000, snapshots[1].second.count());
 }
+
+TEST(DeleteMVCC, LoadPushUnorderedBatchesRebuildSnapshot) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto origin_batch_size = DELETE_DUMP_BATCH_SIZE.load();
+    DELETE_DUMP_BATCH_SIZE.store(10);
+
+    const int N = 200;
+    InsertRecord<false> insert_record(*schema, N);
+    DeletedRecord<false> delete_record(
+        &insert_record,
+        [&insert_record](
+            const std::vector<PkType>& pks,
+            const Timestamp* timestamps,
+            std::function<void(const SegOffset offset, const Timestamp ts)>
+                cb) {
+            for (size_t i = 0; i < pks.size(); ++i) {
+                auto timestamp = timestamps[i];
+                auto offsets = insert_record.search_pk(pks[i], timestamp);
+                for (auto offset : offsets) {
+                    cb(offset, timestamp);
+                }
+            }
+        },
+        0);
+
+    // insert pk=i at ts=0
+    std::vector<int64_t> age_data(N);
+    std::vector<Timestamp> tss(N, 0);
+    for (int i = 0; i < N; ++i) {
+        age_data[i] = i;
+        insert_record.insert_pk(age_data[i], i);
+    }
+    auto insert_offset = insert_record.reserved.fetch_add(N);
+    insert_record.timestamps_.set_data_raw(insert_offset, tss.data(), N);
+    auto field_data = insert_record.get_data_base(i64_fid);
+    field_data->set_data_raw(insert_offset, age_data.data(), N);
+    insert_record.ack_responder_.AddSegment(insert_offset, insert_offset + N);
+
+    // delete pk=i at ts=i+1, the second delta log holds older deletes
+    auto load_range = [&](int begin, int end) {
+        std::vector<Timestamp> delete_ts;
+        std::vector<PkType> delete_pk;
+        for (int i = begin; i < end; ++i) {
+            delete_pk.emplace_back(age_data[i]);
+            delete_ts.emplace_back(i + 1);
+        }
+        delete_record.LoadPush(delete_pk, delete_ts.data());
+    };
+    load_range(N / 2, N);
+    ASSERT_FALSE(delete_record.get_snapshots().empty());
+    load_range(0, N / 2);
+    auto snapshots = delete_record.get_snapshots();
+    ASSERT_FALSE(snapshots.empty());
+    ASSERT_LT(snapshots.front().first, Timestamp(N / 2));
+
+    for (Timestamp query_ts = 0; query_ts <= N + 1; ++query_ts) {
+        BitsetType bitsets(N);
+        BitsetTypeView bitsets_view(bitsets);
+        delete_record.Query(bitsets_view, N, query_ts);
+        for (int i = 0; i < N; ++i) {
+            ASSERT_EQ(bitsets_view[i], Timestamp(i + 1) <= query_ts)
+                << "query_ts: " << query_ts << ", offset: " << i;
+        }
+    }
+
+    DELETE_DUMP_BATCH_SIZE.store(origin_batch_size);
+}
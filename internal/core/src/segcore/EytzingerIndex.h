@@ -0,0 +1,153 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace milvus::segcore {
+
+// Search tree over a sorted sequence of int64 keys, e.g. the pks of a sealed
+// segment. Every kBlockSize-th key is kept in Eytzinger (BFS) order, so the
+// top levels of every lookup share cache lines and the lower levels are
+// prefetched ahead of the comparisons. A lookup narrows the sequence down to
+// one block, the caller finishes with a search in that block of its data.
+//
+// A binary search over 10M keys takes ~23 cache misses, the tree takes a
+// few for the levels not in cache plus one or two for the block.
+class EytzingerIndex {
+ public:
+    static constexpr size_t kBlockSize = 16;
+
+    // get_key(i) is the i-th key of the sorted sequence of size keys
+    template <typename GetKey>
+    void
+    Build(size_t size, GetKey&& get_key) {
+        size_ = size;
+        auto num_samples = (size + kBlockSize - 1) / kBlockSize;
+        // 1-based, slot 0 is unused
+        keys_.assign(num_samples + 1, 0);
+        ranks_.assign(num_samples + 1, 0);
+        uint32_t rank = 0;
+        Fill(1, get_key, rank);
+    }
+
+    void
+    clear() {
+        size_ = 0;
+        keys_.clear();
+        keys_.shrink_to_fit();
+        ranks_.clear();
+        ranks_.shrink_to_fit();
+    }
+
+    bool
+    empty() const {
+        return size_ == 0;
+    }
+
+    size_t
+    memory_size() const {
+        return keys_.capacity() * sizeof(int64_t) +
+               ranks_.capacity() * sizeof(uint32_t);
+    }
+
+    // [begin, end) of the sequence holding the first key not less than
+    // target, which is end itself when the block has no such key
+    std::pair<size_t, size_t>
+    Block(int64_t target) const {
+        size_t k = 1;
+        while (k < keys_.size()) {
+            __builtin_prefetch(keys_.data() + k * kPrefetchStride);
+            k = 2 * k + (keys_[k] < target);
+        }
+        return BlockOfLeaf(k);
+    }
+
+    // Block for targets[0, n), with the searches of kBatchSize targets
+    // stepping through the tree together so their cache misses overlap.
+    // prefetch(begin) is called for the blocks of a batch before
+    // visit(i, begin, end) is called for each of them in order.
+    template <typename Prefetch, typename Visit>
+    void
+    BlockBatch(const int64_t* targets,
+               size_t n,
+               Prefetch&& prefetch,
+               Visit&& visit) const {
+        size_t nodes[kBatchSize];
+        std::pair<size_t, size_t> blocks[kBatchSize];
+        for (size_t base = 0; base < n; base += kBatchSize) {
+            auto batch = std::min(kBatchSize, n - base);
+            std::fill(nodes, nodes + batch, 1);
+            bool walking = true;
+            while (walking) {
+                walking = false;
+                for (size_t i = 0; i < batch; ++i) {
+                    auto k = nodes[i];
+                    if (k < keys_.size()) {
+                        __builtin_prefetch(keys_.data() +
+                                           k * kPrefetchStride);
+                        nodes[i] = 2 * k + (keys_[k] < targets[base + i]);
+                        walking = true;
+                    }
+                }
+            }
+            for (size_t i = 0; i < batch; ++i) {
+                blocks[i] = BlockOfLeaf(nodes[i]);
+                prefetch(blocks[i].first);
+            }
+            for (size_t i = 0; i < batch; ++i) {
+                visit(base + i, blocks[i].first, blocks[i].second);
+            }
+        }
+    }
+
+ private:
+    // the descendants three levels down fill one cache line
+    static constexpr size_t kPrefetchStride = 8;
+    static constexpr size_t kBatchSize = 8;
+
+    template <typename GetKey>
+    void
+    Fill(size_t k, GetKey& get_key, uint32_t& rank) {
+        if (k >= keys_.size()) {
+            return;
+        }
+        // in-order traversal hands out the samples in sorted order
+        Fill(2 * k, get_key, rank);
+        keys_[k] = get_key(rank * kBlockSize);
+        ranks_[k] = rank++;
+        Fill(2 * k + 1, get_key, rank);
+    }
+
+    std::pair<size_t, size_t>
+    BlockOfLeaf(size_t k) const {
+        // undo the right turns taken after the last left turn, which lands on
+        // the first sample not less than the target
+        k >>= __builtin_ffsll(~static_cast<long long>(k));
+        size_t rank = k == 0 ? keys_.size() - 1 : ranks_[k];
+        if (rank == 0) {
+            return {0, 0};
+        }
+        return {(rank - 1) * kBlockSize, std::min(rank * kBlockSize, size_)};
+    }
+
+ private:
+    size_t size_ = 0;
+    std::vector<int64_t> keys_;
+    std::vector<uint32_t> ranks_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,174 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/FieldAccessStats.h"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+#include "common/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the root of i, compressing the path
+int
+FindRoot(std::vector<int>& parents, int i) {
+    while (parents[i] != i) {
+        parents[i] = parents[parents[i]];
+        i = parents[i];
+    }
+    return i;
+}
+
+}  // namespace
+
+void
+FieldAccessStats::Record(const std::set<FieldId>& filter_fields,
+                         const std::vector<FieldId>& output_fields,
+                         std::optional<FieldId> vector_field) {
+    std::set<FieldId> read(filter_fields.begin(), filter_fields.end());
+    read.insert(output_fields.begin(), output_fields.end());
+    if (vector_field.has_value()) {
+        read.insert(vector_field.value());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_queries_;
+    for (auto field_id : filter_fields) {
+        ++counts_[{field_id, FieldAccess::kFilter}];
+    }
+    for (auto field_id : std::set<FieldId>(output_fields.begin(),
+                                           output_fields.end())) {
+        ++counts_[{field_id, FieldAccess::kOutput}];
+    }
+    if (vector_field.has_value()) {
+        ++counts_[{vector_field.value(), FieldAccess::kVector}];
+    }
+    for (auto a = read.begin(); a != read.end(); ++a) {
+        for (auto b = a; b != read.end(); ++b) {
+            ++co_counts_[{*a, *b}];
+        }
+    }
+}
+
+int64_t
+FieldAccessStats::NumQueries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_queries_;
+}
+
+int64_t
+FieldAccessStats::Count(FieldId field_id, FieldAccess access) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = counts_.find({field_id, access});
+    return it == counts_.end() ? 0 : it->second;
+}
+
+int64_t
+FieldAccessStats::CoCount(FieldId a, FieldId b) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = co_counts_.find({std::min(a, b), std::max(a, b)});
+    return it == co_counts_.end() ? 0 : it->second;
+}
+
+std::vector<std::vector<int>>
+FieldAccessStats::ProposeColumnGroups(
+    const std::vector<FieldId>& fields,
+    const std::vector<int64_t>& row_sizes) const {
+    AssertInfo(fields.size() == row_sizes.size(),
+               "{} fields with {} row sizes",
+               fields.size(),
+               row_sizes.size());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (num_queries_ == 0) {
+        return {};
+    }
+    auto co_count = [&](FieldId a, FieldId b) -> int64_t {
+        auto it = co_counts_.find({std::min(a, b), std::max(a, b)});
+        return it == co_counts_.end() ? 0 : it->second;
+    };
+    int n = fields.size();
+    std::vector<int64_t> reads(n);
+    std::vector<bool> searched(n);
+    for (int i = 0; i < n; ++i) {
+        reads[i] = co_count(fields[i], fields[i]);
+        searched[i] = counts_.count({fields[i], FieldAccess::kVector}) > 0;
+    }
+
+    // every field starts alone, the hot ones merge by affinity
+    std::vector<int> parents(n);
+    std::iota(parents.begin(), parents.end(), 0);
+    auto is_cold = [&](int i) {
+        return reads[i] < num_queries_ * kColdQueryRatio;
+    };
+    std::vector<std::tuple<double, int, int>> affinities;
+    for (int i = 0; i < n; ++i) {
+        if (searched[i] || is_cold(i)) {
+            continue;
+        }
+        for (int j = i + 1; j < n; ++j) {
+            if (searched[j] || is_cold(j)) {
+                continue;
+            }
+            auto affinity =
+                static_cast<double>(co_count(fields[i], fields[j])) /
+                std::max(reads[i], reads[j]);
+            if (affinity >= kMinAffinity) {
+                affinities.emplace_back(affinity, i, j);
+            }
+        }
+    }
+    std::stable_sort(
+        affinities.begin(), affinities.end(), [](const auto& a, const auto& b) {
+            return std::get<0>(a) > std::get<0>(b);
+        });
+    for (const auto& [affinity, i, j] : affinities) {
+        parents[FindRoot(parents, i)] = FindRoot(parents, j);
+    }
+
+    // the narrow cold fields share the group of the first of them
+    int narrow_cold = -1;
+    for (int i = 0; i < n; ++i) {
+        if (searched[i] || !is_cold(i) || row_sizes[i] >= kWideRowSize) {
+            continue;
+        }
+        if (narrow_cold < 0) {
+            narrow_cold = i;
+        } else {
+            parents[i] = narrow_cold;
+        }
+    }
+
+    // groups in the order of their first field
+    std::vector<std::vector<int>> groups;
+    std::map<int, size_t> group_of_root;
+    for (int i = 0; i < n; ++i) {
+        auto root = FindRoot(parents, i);
+        auto it = group_of_root.find(root);
+        if (it == group_of_root.end()) {
+            it = group_of_root.emplace(root, groups.size()).first;
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(i);
+    }
+    return groups;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,94 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// how a query reads a field
+enum class FieldAccess : uint8_t {
+    kFilter = 0,
+    kOutput = 1,
+    kVector = 2,
+};
+
+/**
+ * The field co-access statistics of a collection, counted once per query
+ * plan: the fields its filter evaluates, the fields it outputs and the
+ * vector field it searches.
+ *
+ * ProposeColumnGroups turns them into a column group layout for the next
+ * StorageV2 writes of the collection. Fields mostly read by the same
+ * queries share a group, searched vector fields and rarely read wide
+ * fields get a group of their own, and the other rarely read fields share
+ * one, so the row groups a query reads carry few columns it does not need.
+ */
+class FieldAccessStats {
+ public:
+    void
+    Record(const std::set<FieldId>& filter_fields,
+           const std::vector<FieldId>& output_fields,
+           std::optional<FieldId> vector_field);
+
+    int64_t
+    NumQueries() const;
+
+    // queries reading field_id the way of access
+    int64_t
+    Count(FieldId field_id, FieldAccess access) const;
+
+    // queries reading both fields in any way, the queries reading the field
+    // for a == b
+    int64_t
+    CoCount(FieldId a, FieldId b) const;
+
+    // Column groups of fields, with row_sizes[i] the average bytes of a row
+    // of fields[i], as lists of indexes into fields ordered by their first
+    // index. Empty before any query was recorded.
+    std::vector<std::vector<int>>
+    ProposeColumnGroups(const std::vector<FieldId>& fields,
+                        const std::vector<int64_t>& row_sizes) const;
+
+    // fields read by fewer of the queries are cold
+    static constexpr double kColdQueryRatio = 0.01;
+    // cold fields with wider rows get a group of their own
+    static constexpr int64_t kWideRowSize = 1024;
+    // hot fields share a group once this share of the queries reading
+    // either reads both
+    static constexpr double kMinAffinity = 0.5;
+
+ private:
+    mutable std::mutex mutex_;
+    int64_t num_queries_{0};
+    std::map<std::pair<FieldId, FieldAccess>, int64_t> counts_;
+    // keyed by the ordered pair of fields
+    std::map<std::pair<FieldId, FieldId>, int64_t> co_counts_;
+};
+
+using FieldAccessStatsPtr = std::shared_ptr<FieldAccessStats>;
+
+}  // namespace milvus::segcore
@@ -0,0 +1,70 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "segcore/FieldAccessStats.h"
+
+using milvus::FieldId;
+using milvus::segcore::FieldAccess;
+using milvus::segcore::FieldAccessStats;
+
+TEST(FieldAccessStats, Record) {
+    FieldAccessStats stats;
+    stats.Record({FieldId(100)}, {FieldId(100), FieldId(101)}, FieldId(102));
+    stats.Record({FieldId(100)}, {}, std::nullopt);
+
+    EXPECT_EQ(stats.NumQueries(), 2);
+    EXPECT_EQ(stats.Count(FieldId(100), FieldAccess::kFilter), 2);
+    EXPECT_EQ(stats.Count(FieldId(100), FieldAccess::kOutput), 1);
+    EXPECT_EQ(stats.Count(FieldId(102), FieldAccess::kVector), 1);
+    EXPECT_EQ(stats.Count(FieldId(101), FieldAccess::kFilter), 0);
+    EXPECT_EQ(stats.CoCount(FieldId(100), FieldId(100)), 2);
+    EXPECT_EQ(stats.CoCount(FieldId(101), FieldId(100)), 1);
+    EXPECT_EQ(stats.CoCount(FieldId(101), FieldId(102)), 1);
+}
+
+TEST(FieldAccessStats, ProposeColumnGroups) {
+    FieldAccessStats stats;
+    std::vector<FieldId> fields{FieldId(100),
+                                FieldId(101),
+                                FieldId(102),
+                                FieldId(103),
+                                FieldId(104),
+                                FieldId(105),
+                                FieldId(106)};
+    std::vector<int64_t> row_sizes{8, 8, 512, 16, 4096, 8, 4};
+    EXPECT_TRUE(stats.ProposeColumnGroups(fields, row_sizes).empty());
+
+    // 100 and 102 filtered together, 101 output alone, 103 searched, the
+    // rest never read
+    for (int i = 0; i < 100; ++i) {
+        stats.Record({FieldId(100), FieldId(102)}, {}, FieldId(103));
+        stats.Record({}, {FieldId(101)}, std::nullopt);
+    }
+    auto groups = stats.ProposeColumnGroups(fields, row_sizes);
+    std::vector<std::vector<int>> expected{{0, 2}, {1}, {3}, {4}, {5, 6}};
+    EXPECT_EQ(groups, expected);
+
+    // once 101 is mostly read with 100 and 102 they share a group
+    for (int i = 0; i < 300; ++i) {
+        stats.Record(
+            {FieldId(100), FieldId(102)}, {FieldId(101)}, std::nullopt);
+    }
+    groups = stats.ProposeColumnGroups(fields, row_sizes);
+    expected = {{0, 1, 2}, {3}, {4}, {5, 6}};
+    EXPECT_EQ(groups, expected);
+}
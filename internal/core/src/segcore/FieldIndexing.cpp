@@ -28,6 +28,7 @@
 #include "index/RTreeIndex.h"
 #include "storage/FileManager.h"
 #include "storage/LocalChunkManagerSingleton.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 using std::unique_ptr;
@@ -403,6 +404,16 @@ VectorFieldIndexing::AppendSegmentIndexDense(int64_t reserved_offset,
     } else {
         vec_length = dim * sizeof(bfloat16);
     }
+    if (!built_ && valid_data.empty() &&
+        segcore_config_.get_enable_interim_index_async_build()) {
+        // the first build takes long enough to stall the insert that crosses
+        // the threshold, so it runs on the pool over a copy of the rows.
+        // Searches stay brute force until the index catches up.
+        if (!building_.exchange(true)) {
+            BuildInBackground(field_raw_data, vec_length, build_threshold);
+        }
+        return;
+    }
     if (!built_) {
         const void* data_ptr;
         std::unique_ptr<char[]> data_buf;
@@ -464,6 +475,22 @@ VectorFieldIndexing::AppendSegmentIndexDense(int64_t reserved_offset,
             sync_with_index_.store(true);
             return;
         }
+        if (add_count > size) {
+            // rows inserted while the index was built in the background are
+            // only in the raw data
+            try {
+                AddRawRows(field_raw_data,
+                           index_cur_.load(),
+                           reserved_offset,
+                           vec_length,
+                           conf);
+            } catch (SegcoreError& error) {
+                LOG_ERROR("growing index add error: {}", error.what());
+                recreate_index(get_data_type(), field_raw_data);
+                return;
+            }
+            add_count = size;
+        }
         auto data_ptr = static_cast<const char*>(data_source) +
                         (total_count - add_count) * vec_length;
         auto dataset = knowhere::GenDataSet(add_count, dim, data_ptr);
@@ -514,6 +541,73 @@ VectorFieldIndexing::AppendSegmentIndexDense(int64_t reserved_offset,
     }
 }
 
+VectorFieldIndexing::~VectorFieldIndexing() {
+    if (build_future_.valid()) {
+        build_future_.wait();
+    }
+}
+
+// copies rows [begin, end) of the raw data out of its chunks
+static std::unique_ptr<char[]>
+CopyRawRows(const VectorBase* field_raw_data,
+            int64_t begin,
+            int64_t end,
+            size_t vec_length) {
+    auto size_per_chunk = field_raw_data->get_size_per_chunk();
+    auto buf = std::make_unique<char[]>((end - begin) * vec_length);
+    for (auto row = begin; row < end;) {
+        auto chunk_id = row / size_per_chunk;
+        auto chunk_end = std::min(end, (chunk_id + 1) * size_per_chunk);
+        auto chunk_data = static_cast<const char*>(
+            field_raw_data->get_chunk_data(chunk_id));
+        std::memcpy(buf.get() + (row - begin) * vec_length,
+                    chunk_data + (row - chunk_id * size_per_chunk) * vec_length,
+                    (chunk_end - row) * vec_length);
+        row = chunk_end;
+    }
+    return buf;
+}
+
+void
+VectorFieldIndexing::BuildInBackground(const VectorBase* field_raw_data,
+                                       size_t vec_length,
+                                       int64_t build_threshold) {
+    // copied here, as the raw data is not to be read off the insert path
+    std::shared_ptr<char[]> data_buf =
+        CopyRawRows(field_raw_data, 0, build_threshold, vec_length);
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::LOW);
+    build_future_ = pool.Submit([this,
+                                 field_raw_data,
+                                 data_buf,
+                                 build_threshold]() {
+        auto conf = get_build_params(get_data_type());
+        auto dataset =
+            knowhere::GenDataSet(build_threshold, get_dim(), data_buf.get());
+        try {
+            index_->BuildWithDataset(dataset, conf);
+            index_cur_.store(build_threshold);
+            built_.store(true);
+        } catch (SegcoreError& error) {
+            LOG_ERROR("growing index build error: {}", error.what());
+            recreate_index(get_data_type(), field_raw_data);
+            // the next insert tries again
+            building_.store(false);
+        }
+    });
+}
+
+void
+VectorFieldIndexing::AddRawRows(const VectorBase* field_raw_data,
+                                int64_t begin,
+                                int64_t end,
+                                size_t vec_length,
+                                const knowhere::Json& conf) {
+    auto buf = CopyRawRows(field_raw_data, begin, end, vec_length);
+    auto dataset = knowhere::GenDataSet(end - begin, get_dim(), buf.get());
+    index_->AddWithDataset(dataset, conf);
+    index_cur_.fetch_add(end - begin);
+}
+
 knowhere::Json
 VectorFieldIndexing::get_build_params(DataType data_type) const {
     auto config = config_->GetBuildBaseParams(data_type);
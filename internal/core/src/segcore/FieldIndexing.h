@@ -13,6 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <optional>
 #include <map>
 #include <memory>
@@ -267,6 +268,8 @@ class VectorFieldIndexing : public FieldIndexing {
                                  const SegcoreConfig& segcore_config,
                                  const VectorBase* field_raw_data);
 
+    ~VectorFieldIndexing() override;
+
     void
     AppendSegmentIndexDense(int64_t reserved_offset,
                             int64_t size,
@@ -330,6 +333,11 @@ class VectorFieldIndexing : public FieldIndexing {
     bool
     has_raw_data() const override;
 
+    RecallTuner&
+    get_recall_tuner() const {
+        return config_->GetRecallTuner();
+    }
+
     knowhere::Json
     get_build_params(DataType data_type) const;
 
@@ -339,10 +347,29 @@ class VectorFieldIndexing : public FieldIndexing {
  private:
     void
     recreate_index(DataType data_type, const VectorBase* field_raw_data);
+
+    // builds the index over the first build_threshold rows on the pool,
+    // setting built_ once done
+    void
+    BuildInBackground(const VectorBase* field_raw_data,
+                      size_t vec_length,
+                      int64_t build_threshold);
+
+    // adds rows [begin, end) of the raw data to the index
+    void
+    AddRawRows(const VectorBase* field_raw_data,
+               int64_t begin,
+               int64_t end,
+               size_t vec_length,
+               const knowhere::Json& conf);
+
     // current number of rows in index.
     std::atomic<idx_t> index_cur_ = 0;
     // whether the growing index has been built.
     std::atomic<bool> built_;
+    // whether the index is being built in the background, or has been
+    std::atomic<bool> building_ = false;
+    std::future<void> build_future_;
     // whether all insertd data has been added to growing index and can be
     // searched.
     std::atomic<bool> sync_with_index_;
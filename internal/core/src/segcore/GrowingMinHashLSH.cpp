@@ -0,0 +1,218 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/GrowingMinHashLSH.h"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "xxhash.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// independent partial counts, so the loop below vectorizes
+constexpr int64_t kLanes = 8;
+
+template <typename T>
+int64_t
+CountEqual(const T* left, const T* right, int64_t num_elements) {
+    int64_t counts[kLanes] = {};
+    int64_t i = 0;
+    for (; i + kLanes <= num_elements; i += kLanes) {
+        for (int64_t l = 0; l < kLanes; ++l) {
+            counts[l] += left[i + l] == right[i + l];
+        }
+    }
+    for (; i < num_elements; ++i) {
+        counts[0] += left[i] == right[i];
+    }
+    return std::accumulate(counts, counts + kLanes, int64_t{0});
+}
+
+}  // namespace
+
+GrowingMinHashLSH::GrowingMinHashLSH(const VectorBase* data,
+                                     int64_t dim,
+                                     int64_t size_per_chunk,
+                                     int64_t element_bit_width,
+                                     int64_t num_bands)
+    : data_(data),
+      row_bytes_(dim / 8),
+      size_per_chunk_(size_per_chunk),
+      element_bytes_(element_bit_width / 8),
+      num_elements_(element_bit_width > 0 ? dim / element_bit_width : 0),
+      num_bands_(num_bands) {
+    AssertInfo(data_ != nullptr, "growing minhash lsh needs the raw data");
+    AssertInfo(element_bit_width == 32 || element_bit_width == 64,
+               "invalid minhash element bit width {}",
+               element_bit_width);
+    AssertInfo(num_elements_ > 0 && dim % element_bit_width == 0,
+               "dim {} is not a multiple of the minhash element bit width {}",
+               dim,
+               element_bit_width);
+    AssertInfo(num_bands_ > 0 && num_bands_ <= num_elements_,
+               "invalid minhash lsh band {} for {} elements",
+               num_bands_,
+               num_elements_);
+    AssertInfo(size_per_chunk_ > 0 && size_per_chunk_ != MAX_ROW_COUNT,
+               "growing minhash lsh needs fixed size chunks, got {}",
+               size_per_chunk_);
+}
+
+const uint8_t*
+GrowingMinHashLSH::Raw(int64_t row) const {
+    auto chunk = static_cast<const uint8_t*>(
+        data_->get_chunk_data(row / size_per_chunk_));
+    return chunk + (row % size_per_chunk_) * row_bytes_;
+}
+
+void
+GrowingMinHashLSH::BandKeys(const uint8_t* signature, uint64_t* keys) const {
+    for (int64_t band = 0; band < num_bands_; ++band) {
+        // the bands split the elements as evenly as they can
+        auto begin = band * num_elements_ / num_bands_;
+        auto end = (band + 1) * num_elements_ / num_bands_;
+        keys[band] = XXH3_64bits(signature + begin * element_bytes_,
+                                 (end - begin) * element_bytes_);
+    }
+}
+
+float
+GrowingMinHashLSH::Similarity(const uint8_t* left,
+                              const uint8_t* right) const {
+    int64_t equal =
+        element_bytes_ == sizeof(uint32_t)
+            ? CountEqual(reinterpret_cast<const uint32_t*>(left),
+                         reinterpret_cast<const uint32_t*>(right),
+                         num_elements_)
+            : CountEqual(reinterpret_cast<const uint64_t*>(left),
+                         reinterpret_cast<const uint64_t*>(right),
+                         num_elements_);
+    return static_cast<float>(equal) / num_elements_;
+}
+
+void
+GrowingMinHashLSH::Build(int64_t num_rows) {
+    auto num_chunks = num_rows / size_per_chunk_;
+    if (num_chunks <= indexed_chunks_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard lock(build_mutex_);
+    std::vector<uint64_t> keys(num_bands_ * size_per_chunk_);
+    std::vector<std::pair<uint64_t, uint32_t>> bucket;
+    bucket.reserve(size_per_chunk_);
+    for (auto chunk_id = static_cast<int64_t>(chunks_.size());
+         chunk_id < num_chunks;
+         ++chunk_id) {
+        for (int64_t i = 0; i < size_per_chunk_; ++i) {
+            BandKeys(Raw(chunk_id * size_per_chunk_ + i),
+                     keys.data() + i * num_bands_);
+        }
+        Chunk chunk;
+        chunk.keys_.reserve(num_bands_ * size_per_chunk_);
+        chunk.rows_.reserve(num_bands_ * size_per_chunk_);
+        for (int64_t band = 0; band < num_bands_; ++band) {
+            bucket.clear();
+            for (int64_t i = 0; i < size_per_chunk_; ++i) {
+                bucket.emplace_back(keys[i * num_bands_ + band], i);
+            }
+            std::sort(bucket.begin(), bucket.end());
+            for (const auto& [key, row] : bucket) {
+                chunk.keys_.push_back(key);
+                chunk.rows_.push_back(row);
+            }
+        }
+        chunks_.push_back(std::move(chunk));
+        indexed_chunks_.store(chunk_id + 1, std::memory_order_release);
+    }
+    LOG_DEBUG("growing minhash lsh covers {} chunks of {} rows",
+              num_chunks,
+              size_per_chunk_);
+}
+
+size_t
+GrowingMinHashLSH::MemorySize() const {
+    size_t size = 0;
+    auto num_chunks = indexed_chunks_.load(std::memory_order_acquire);
+    for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+        const auto& chunk = chunks_[chunk_id];
+        size += chunk.keys_.capacity() * sizeof(uint64_t) +
+                chunk.rows_.capacity() * sizeof(uint32_t);
+    }
+    return size;
+}
+
+void
+GrowingMinHashLSH::Search(const uint8_t* queries,
+                          int64_t num_queries,
+                          int64_t topk,
+                          const BitsetView& bitset,
+                          int64_t num_rows,
+                          int64_t* offsets,
+                          float* distances) const {
+    num_rows = std::min(num_rows, IndexedRows());
+    auto num_chunks = num_rows / size_per_chunk_;
+    std::vector<uint64_t> keys(num_bands_);
+    std::vector<int64_t> candidates;
+    // (similarity, row), most similar first once sorted
+    std::vector<std::pair<float, int64_t>> ranked;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query = queries + q * row_bytes_;
+        BandKeys(query, keys.data());
+
+        candidates.clear();
+        for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+            const auto& chunk = chunks_[chunk_id];
+            for (int64_t band = 0; band < num_bands_; ++band) {
+                auto band_begin =
+                    chunk.keys_.begin() + band * size_per_chunk_;
+                auto [first, last] = std::equal_range(
+                    band_begin, band_begin + size_per_chunk_, keys[band]);
+                for (auto it = first; it != last; ++it) {
+                    candidates.push_back(
+                        chunk_id * size_per_chunk_ +
+                        chunk.rows_[it - chunk.keys_.begin()]);
+                }
+            }
+        }
+        // a row colliding in several bands is ranked once
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                         candidates.end());
+
+        ranked.clear();
+        for (auto row : candidates) {
+            if (!bitset.empty() && bitset.test(row)) {
+                continue;
+            }
+            ranked.emplace_back(-Similarity(query, Raw(row)), row);
+        }
+        auto found = std::min<int64_t>(topk, ranked.size());
+        std::partial_sort(
+            ranked.begin(), ranked.begin() + found, ranked.end());
+        for (int64_t i = 0; i < found; ++i) {
+            offsets[q * topk + i] = ranked[i].second;
+            distances[q * topk + i] = -ranked[i].first;
+        }
+    }
+}
+
+}  // namespace milvus::segcore
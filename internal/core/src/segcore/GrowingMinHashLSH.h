@@ -0,0 +1,109 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <tbb/concurrent_vector.h>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "segcore/ConcurrentVector.h"
+
+namespace milvus::segcore {
+
+// Banded LSH over the MinHash signatures of a binary vector field of a
+// growing segment: the elements of a signature are cut into num_bands bands
+// and every band is hashed into a bucket. Like GrowingVectorMirror it covers
+// the full chunks, the open chunk is left to the brute force search.
+//
+// A search takes the rows sharing a bucket with the query in any band and
+// ranks them by the fraction of equal elements, the MHJACCARD estimate, so
+// it reads the signatures of the colliding rows only.
+class GrowingMinHashLSH {
+ public:
+    // dim is in bits, element_bit_width the bits of a signature element
+    GrowingMinHashLSH(const VectorBase* data,
+                      int64_t dim,
+                      int64_t size_per_chunk,
+                      int64_t element_bit_width,
+                      int64_t num_bands);
+
+    // hashes the chunks completed by the first num_rows rows
+    void
+    Build(int64_t num_rows);
+
+    // rows [0, IndexedRows()) are in the buckets
+    int64_t
+    IndexedRows() const {
+        return indexed_chunks_.load(std::memory_order_acquire) *
+               size_per_chunk_;
+    }
+
+    size_t
+    MemorySize() const;
+
+    // the topk of rows [0, num_rows) not set in bitset for each query, among
+    // the rows colliding with it in a band. Writes offsets[q * topk ...] and
+    // distances[q * topk ...] most similar first and leaves the slots past
+    // the found rows as they are.
+    void
+    Search(const uint8_t* queries,
+           int64_t num_queries,
+           int64_t topk,
+           const BitsetView& bitset,
+           int64_t num_rows,
+           int64_t* offsets,
+           float* distances) const;
+
+ private:
+    struct Chunk {
+        // bucket keys band by band, each band sorted
+        std::vector<uint64_t> keys_;
+        // the chunk offset of the row of each key
+        std::vector<uint32_t> rows_;
+    };
+
+    const uint8_t*
+    Raw(int64_t row) const;
+
+    // the bucket key of every band of a signature
+    void
+    BandKeys(const uint8_t* signature, uint64_t* keys) const;
+
+    float
+    Similarity(const uint8_t* left, const uint8_t* right) const;
+
+ private:
+    const VectorBase* data_;
+    const int64_t row_bytes_;
+    const int64_t size_per_chunk_;
+    const int64_t element_bytes_;
+    const int64_t num_elements_;
+    const int64_t num_bands_;
+    std::mutex build_mutex_;
+    tbb::concurrent_vector<Chunk> chunks_;
+    std::atomic<int64_t> indexed_chunks_{0};
+};
+
+using GrowingMinHashLSHPtr = std::shared_ptr<GrowingMinHashLSH>;
+
+}  // namespace milvus::segcore
@@ -0,0 +1,130 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "segcore/ConcurrentVector.h"
+#include "segcore/GrowingMinHashLSH.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kNumElements = 64;
+constexpr int64_t kDim = kNumElements * 32;
+constexpr int64_t kNumBands = 16;
+constexpr int64_t kSizePerChunk = 128;
+
+// rows of near duplicates: row i copies the signature of cluster i % 8 and
+// changes a few of its elements
+std::vector<uint32_t>
+GenSignatures(int64_t num_rows, std::default_random_engine& er) {
+    std::vector<uint32_t> clusters(8 * kNumElements);
+    for (auto& value : clusters) {
+        value = er();
+    }
+    std::vector<uint32_t> signatures(num_rows * kNumElements);
+    for (int64_t row = 0; row < num_rows; ++row) {
+        auto signature = signatures.data() + row * kNumElements;
+        std::copy_n(
+            clusters.data() + row % 8 * kNumElements, kNumElements, signature);
+        for (int i = 0; i < 4; ++i) {
+            signature[er() % kNumElements] = er();
+        }
+    }
+    return signatures;
+}
+
+}  // namespace
+
+TEST(GrowingMinHashLSHTest, IndexesFullChunks) {
+    std::default_random_engine er(42);
+    auto signatures = GenSignatures(2 * kSizePerChunk + 7, er);
+    ConcurrentVector<BinaryVector> data(kDim, kSizePerChunk);
+    data.set_data_raw(0, signatures.data(), 2 * kSizePerChunk + 7);
+    GrowingMinHashLSH lsh(&data, kDim, kSizePerChunk, 32, kNumBands);
+    lsh.Build(kSizePerChunk - 1);
+    EXPECT_EQ(lsh.IndexedRows(), 0);
+    lsh.Build(2 * kSizePerChunk + 7);
+    EXPECT_EQ(lsh.IndexedRows(), 2 * kSizePerChunk);
+    EXPECT_GT(lsh.MemorySize(), 2 * kSizePerChunk * kNumBands);
+
+    EXPECT_ANY_THROW(
+        GrowingMinHashLSH(&data, kDim, kSizePerChunk, 16, kNumBands));
+    EXPECT_ANY_THROW(
+        GrowingMinHashLSH(&data, kDim, kSizePerChunk, 32, kNumElements + 1));
+}
+
+TEST(GrowingMinHashLSHTest, SearchMatchesBruteForceOnCandidates) {
+    int64_t num_rows = 4 * kSizePerChunk;
+    int64_t topk = 10;
+    std::default_random_engine er(42);
+    auto signatures = GenSignatures(num_rows, er);
+    ConcurrentVector<BinaryVector> data(kDim, kSizePerChunk);
+    data.set_data_raw(0, signatures.data(), num_rows);
+    GrowingMinHashLSH lsh(&data, kDim, kSizePerChunk, 32, kNumBands);
+    lsh.Build(num_rows);
+
+    BitsetType filtered(num_rows);
+    for (int64_t i = 0; i < num_rows; i += 5) {
+        filtered[i] = true;
+    }
+    BitsetView bitset(filtered);
+
+    // the first rows of every cluster, and a signature colliding with none
+    int64_t num_queries = 9;
+    std::vector<uint32_t> queries(signatures.begin(),
+                                  signatures.begin() + 8 * kNumElements);
+    for (int64_t i = 0; i < kNumElements; ++i) {
+        queries.push_back(er());
+    }
+    std::vector<int64_t> offsets(num_queries * topk, INVALID_SEG_OFFSET);
+    std::vector<float> distances(num_queries * topk, 0);
+    lsh.Search(reinterpret_cast<const uint8_t*>(queries.data()),
+               num_queries,
+               topk,
+               bitset,
+               num_rows,
+               offsets.data(),
+               distances.data());
+
+    for (int64_t q = 0; q < 8; ++q) {
+        auto query = queries.data() + q * kNumElements;
+        float prev = 1.0f;
+        for (int64_t k = 0; k < topk; ++k) {
+            auto offset = offsets[q * topk + k];
+            ASSERT_NE(offset, INVALID_SEG_OFFSET);
+            ASSERT_FALSE(filtered[offset]);
+            // near duplicates of the query only, with the exact estimate
+            EXPECT_EQ(offset % 8, q);
+            auto row = signatures.data() + offset * kNumElements;
+            int64_t equal = 0;
+            for (int64_t i = 0; i < kNumElements; ++i) {
+                equal += query[i] == row[i];
+            }
+            EXPECT_FLOAT_EQ(distances[q * topk + k],
+                            static_cast<float>(equal) / kNumElements);
+            EXPECT_LE(distances[q * topk + k], prev);
+            prev = distances[q * topk + k];
+        }
+    }
+    // the query without a collision finds nothing
+    for (int64_t k = 0; k < topk; ++k) {
+        EXPECT_EQ(offsets[8 * topk + k], INVALID_SEG_OFFSET);
+    }
+}
@@ -0,0 +1,282 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/GrowingScalarIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// setting a matched row costs about as much as comparing this many rows in a
+// scan
+constexpr int64_t kScanCostFactor = 4;
+
+}  // namespace
+
+template <typename T>
+GrowingScalarIndex<T>::GrowingScalarIndex(const VectorBase* data,
+                                          int64_t size_per_chunk)
+    : data_(data), size_per_chunk_(size_per_chunk) {
+    AssertInfo(data_ != nullptr, "growing scalar index needs the raw data");
+    AssertInfo(size_per_chunk_ > 0 && size_per_chunk_ != MAX_ROW_COUNT,
+               "growing scalar index needs fixed size chunks, got {}",
+               size_per_chunk_);
+    AssertInfo(size_per_chunk_ <= std::numeric_limits<int32_t>::max(),
+               "chunk of {} rows is too large for growing scalar index",
+               size_per_chunk_);
+}
+
+template <typename T>
+typename GrowingScalarIndex<T>::ViewType
+GrowingScalarIndex<T>::Value(int64_t chunk_id, int32_t chunk_offset) const {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return static_cast<const ConcurrentVector<std::string>*>(data_)
+            ->view_element(chunk_id * size_per_chunk_ + chunk_offset);
+    } else {
+        return static_cast<const T*>(data_->get_chunk_data(chunk_id))
+            [chunk_offset];
+    }
+}
+
+template <typename T>
+void
+GrowingScalarIndex<T>::Build(int64_t num_rows) {
+    auto num_chunks = num_rows / size_per_chunk_;
+    if (num_chunks <= indexed_chunks_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard lock(build_mutex_);
+    for (auto chunk_id = static_cast<int64_t>(runs_.size());
+         chunk_id < num_chunks;
+         ++chunk_id) {
+        Run run;
+        run.offsets_.resize(size_per_chunk_);
+        std::iota(run.offsets_.begin(), run.offsets_.end(), 0);
+        if constexpr (std::is_floating_point_v<T>) {
+            // NaN breaks the ordering, keep it out of the run
+            auto nan_begin = std::stable_partition(
+                run.offsets_.begin(),
+                run.offsets_.end(),
+                [this, chunk_id](int32_t offset) {
+                    return !std::isnan(Value(chunk_id, offset));
+                });
+            run.nan_offsets_.assign(nan_begin, run.offsets_.end());
+            run.offsets_.erase(nan_begin, run.offsets_.end());
+        }
+        std::sort(run.offsets_.begin(),
+                  run.offsets_.end(),
+                  [this, chunk_id](int32_t left, int32_t right) {
+                      return Value(chunk_id, left) < Value(chunk_id, right);
+                  });
+        runs_.push_back(std::move(run));
+        indexed_chunks_.store(chunk_id + 1, std::memory_order_release);
+    }
+    LOG_DEBUG("growing scalar index covers {} chunks of {} rows",
+              num_chunks,
+              size_per_chunk_);
+}
+
+template <typename T>
+typename GrowingScalarIndex<T>::Range
+GrowingScalarIndex<T>::EqualRange(int64_t chunk_id, const T& val) const {
+    const auto& offsets = runs_[chunk_id].offsets_;
+    auto lower = std::lower_bound(
+        offsets.begin(),
+        offsets.end(),
+        val,
+        [this, chunk_id](int32_t offset, const T& value) {
+            return Value(chunk_id, offset) < value;
+        });
+    auto upper = std::upper_bound(
+        lower,
+        offsets.end(),
+        val,
+        [this, chunk_id](const T& value, int32_t offset) {
+            return value < Value(chunk_id, offset);
+        });
+    return {static_cast<size_t>(lower - offsets.begin()),
+            static_cast<size_t>(upper - offsets.begin())};
+}
+
+template <typename T>
+typename GrowingScalarIndex<T>::Range
+GrowingScalarIndex<T>::CompareRange(int64_t chunk_id,
+                                    proto::plan::OpType op,
+                                    const T& val) const {
+    auto size = runs_[chunk_id].offsets_.size();
+    auto [lower, upper] = EqualRange(chunk_id, val);
+    switch (op) {
+        case proto::plan::OpType::GreaterThan:
+            return {upper, size};
+        case proto::plan::OpType::GreaterEqual:
+            return {lower, size};
+        case proto::plan::OpType::LessThan:
+            return {0, lower};
+        case proto::plan::OpType::LessEqual:
+            return {0, upper};
+        case proto::plan::OpType::Equal:
+        case proto::plan::OpType::NotEqual:
+            return {lower, upper};
+        default:
+            ThrowInfo(OpTypeInvalid,
+                      "unsupported op {} for growing scalar index",
+                      op);
+    }
+}
+
+template <typename T>
+template <typename GetRanges>
+bool
+GrowingScalarIndex<T>::SetRanges(int64_t offset,
+                                 int64_t size,
+                                 TargetBitmapView res,
+                                 GetRanges&& get_ranges) const {
+    AssertInfo(offset + size <= IndexedRows(),
+               "rows [{}, {}) are not covered by growing scalar index",
+               offset,
+               offset + size);
+    if (size == 0) {
+        return true;
+    }
+    auto first_chunk = offset / size_per_chunk_;
+    auto last_chunk = (offset + size - 1) / size_per_chunk_;
+    std::vector<std::vector<Range>> chunk_ranges;
+    int64_t matched = 0;
+    for (auto chunk_id = first_chunk; chunk_id <= last_chunk; ++chunk_id) {
+        chunk_ranges.push_back(get_ranges(chunk_id));
+        for (const auto& [lower, upper] : chunk_ranges.back()) {
+            matched += upper - lower;
+        }
+        if (matched * kScanCostFactor > size) {
+            return false;
+        }
+    }
+    for (auto chunk_id = first_chunk; chunk_id <= last_chunk; ++chunk_id) {
+        const auto& offsets = runs_[chunk_id].offsets_;
+        // the rows of the chunk and the results, relative to the chunk
+        auto chunk_begin = chunk_id * size_per_chunk_;
+        auto begin = std::max(offset, chunk_begin) - chunk_begin;
+        auto end = std::min(offset + size, chunk_begin + size_per_chunk_) -
+                   chunk_begin;
+        auto res_begin = chunk_begin - offset;
+        for (const auto& [lower, upper] :
+             chunk_ranges[chunk_id - first_chunk]) {
+            for (auto i = lower; i < upper; ++i) {
+                auto chunk_offset = offsets[i];
+                if (chunk_offset >= begin && chunk_offset < end) {
+                    res[res_begin + chunk_offset] = true;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool
+GrowingScalarIndex<T>::Query(proto::plan::OpType op,
+                             const T& val,
+                             int64_t offset,
+                             int64_t size,
+                             TargetBitmapView res) const {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(val)) {
+            // nothing compares true with NaN, leave it to the scan
+            return false;
+        }
+    }
+    auto done = SetRanges(offset, size, res, [&](int64_t chunk_id) {
+        return std::vector<Range>{CompareRange(chunk_id, op, val)};
+    });
+    if (done && op == proto::plan::OpType::NotEqual) {
+        // NaN rows are not in the runs, so they stay set
+        res.flip();
+    }
+    return done;
+}
+
+template <typename T>
+bool
+GrowingScalarIndex<T>::In(const std::vector<T>& vals,
+                          int64_t offset,
+                          int64_t size,
+                          TargetBitmapView res) const {
+    return SetRanges(offset, size, res, [&](int64_t chunk_id) {
+        std::vector<Range> ranges;
+        ranges.reserve(vals.size());
+        for (const auto& val : vals) {
+            if constexpr (std::is_floating_point_v<T>) {
+                if (std::isnan(val)) {
+                    continue;
+                }
+            }
+            auto range = EqualRange(chunk_id, val);
+            if (range.first < range.second) {
+                ranges.push_back(range);
+            }
+        }
+        return ranges;
+    });
+}
+
+GrowingScalarIndexPtr
+CreateGrowingScalarIndex(const FieldMeta& field_meta,
+                         const VectorBase* data,
+                         int64_t size_per_chunk) {
+    switch (field_meta.get_data_type()) {
+        case DataType::INT8:
+            return std::make_shared<GrowingScalarIndex<int8_t>>(
+                data, size_per_chunk);
+        case DataType::INT16:
+            return std::make_shared<GrowingScalarIndex<int16_t>>(
+                data, size_per_chunk);
+        case DataType::INT32:
+            return std::make_shared<GrowingScalarIndex<int32_t>>(
+                data, size_per_chunk);
+        case DataType::INT64:
+            return std::make_shared<GrowingScalarIndex<int64_t>>(
+                data, size_per_chunk);
+        case DataType::FLOAT:
+            return std::make_shared<GrowingScalarIndex<float>>(
+                data, size_per_chunk);
+        case DataType::DOUBLE:
+            return std::make_shared<GrowingScalarIndex<double>>(
+                data, size_per_chunk);
+        case DataType::VARCHAR:
+            return std::make_shared<GrowingScalarIndex<std::string>>(
+                data, size_per_chunk);
+        default:
+            return nullptr;
+    }
+}
+
+template class GrowingScalarIndex<int8_t>;
+template class GrowingScalarIndex<int16_t>;
+template class GrowingScalarIndex<int32_t>;
+template class GrowingScalarIndex<int64_t>;
+template class GrowingScalarIndex<float>;
+template class GrowingScalarIndex<double>;
+template class GrowingScalarIndex<std::string>;
+
+}  // namespace milvus::segcore
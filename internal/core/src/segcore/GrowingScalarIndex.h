@@ -0,0 +1,137 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <tbb/concurrent_vector.h>
+
+#include "common/FieldMeta.h"
+#include "common/Types.h"
+#include "pb/plan.pb.h"
+#include "segcore/ConcurrentVector.h"
+
+namespace milvus::segcore {
+
+// Interim index of a scalar field of a growing segment. The rows of every
+// full chunk are indexed once the chunk is complete, the rows of the open
+// chunk are left to the scan.
+class GrowingScalarIndexBase {
+ public:
+    virtual ~GrowingScalarIndexBase() = default;
+
+    // indexes the chunks completed by the first num_rows rows
+    virtual void
+    Build(int64_t num_rows) = 0;
+
+    // rows [0, IndexedRows()) are covered by the index
+    virtual int64_t
+    IndexedRows() const = 0;
+};
+
+using GrowingScalarIndexPtr = std::shared_ptr<GrowingScalarIndexBase>;
+
+// One sorted run per chunk: the chunk offsets of the rows ordered by value.
+// Values are read back from the raw data, so a run costs 4 bytes a row. T is
+// std::string for VARCHAR.
+//
+// The queries set the matching rows of [offset, offset + size) and return
+// false without touching res when the runs match too many rows to beat a
+// scan of the range.
+template <typename T>
+class GrowingScalarIndex : public GrowingScalarIndexBase {
+ public:
+    GrowingScalarIndex(const VectorBase* data, int64_t size_per_chunk);
+
+    void
+    Build(int64_t num_rows) override;
+
+    int64_t
+    IndexedRows() const override {
+        return indexed_chunks_.load(std::memory_order_acquire) *
+               size_per_chunk_;
+    }
+
+    // op is one of the compare ops, Equal, NotEqual and the range ops
+    bool
+    Query(proto::plan::OpType op,
+          const T& val,
+          int64_t offset,
+          int64_t size,
+          TargetBitmapView res) const;
+
+    bool
+    In(const std::vector<T>& vals,
+       int64_t offset,
+       int64_t size,
+       TargetBitmapView res) const;
+
+ private:
+    struct Run {
+        // chunk offsets sorted by value, NaNs excluded
+        std::vector<int32_t> offsets_;
+        // chunk offsets of NaN values, only NotEqual matches them
+        std::vector<int32_t> nan_offsets_;
+    };
+
+    using ViewType = std::conditional_t<std::is_same_v<T, std::string>,
+                                        std::string_view,
+                                        T>;
+    // a range [first, second) of Run::offsets_
+    using Range = std::pair<size_t, size_t>;
+
+    ViewType
+    Value(int64_t chunk_id, int32_t chunk_offset) const;
+
+    Range
+    EqualRange(int64_t chunk_id, const T& val) const;
+
+    Range
+    CompareRange(int64_t chunk_id, proto::plan::OpType op, const T& val) const;
+
+    // calls ranges(chunk_id) for each chunk overlapping the rows and sets
+    // the offsets in the returned ranges, unless they match too many rows
+    template <typename GetRanges>
+    bool
+    SetRanges(int64_t offset,
+              int64_t size,
+              TargetBitmapView res,
+              GetRanges&& ranges) const;
+
+ private:
+    const VectorBase* data_;
+    const int64_t size_per_chunk_;
+    std::mutex build_mutex_;
+    tbb::concurrent_vector<Run> runs_;
+    std::atomic<int64_t> indexed_chunks_{0};
+};
+
+// the interim index for the field, nullptr when it has none
+GrowingScalarIndexPtr
+CreateGrowingScalarIndex(const FieldMeta& field_meta,
+                         const VectorBase* data,
+                         int64_t size_per_chunk);
+
+}  // namespace milvus::segcore
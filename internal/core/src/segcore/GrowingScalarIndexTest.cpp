@@ -0,0 +1,147 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "common/Types.h"
+#include "segcore/ConcurrentVector.h"
+#include "segcore/GrowingScalarIndex.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kSizePerChunk = 8;
+
+}  // namespace
+
+TEST(GrowingScalarIndexTest, IndexesFullChunks) {
+    ConcurrentVector<int64_t> data(kSizePerChunk);
+    GrowingScalarIndex<int64_t> index(&data, kSizePerChunk);
+
+    std::vector<int64_t> values(3 * kSizePerChunk);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = i % 12;
+    }
+    data.set_data_raw(0, values.data(), kSizePerChunk + 3);
+    index.Build(kSizePerChunk + 3);
+    EXPECT_EQ(index.IndexedRows(), kSizePerChunk);
+
+    data.set_data_raw(kSizePerChunk + 3,
+                      values.data() + kSizePerChunk + 3,
+                      values.size() - kSizePerChunk - 3);
+    index.Build(values.size());
+    EXPECT_EQ(index.IndexedRows(), values.size());
+
+    // a batch across a chunk boundary
+    int64_t offset = 5;
+    int64_t size = 2 * kSizePerChunk;
+    TargetBitmap res(size, false);
+    ASSERT_TRUE(index.Query(
+        proto::plan::OpType::Equal, 3, offset, size, TargetBitmapView(res)));
+    for (int64_t i = 0; i < size; ++i) {
+        EXPECT_EQ(res[i], values[offset + i] == 3) << i;
+    }
+
+    TargetBitmap in_res(size, false);
+    ASSERT_TRUE(index.In({1, 7}, offset, size, TargetBitmapView(in_res)));
+    for (int64_t i = 0; i < size; ++i) {
+        EXPECT_EQ(in_res[i],
+                  values[offset + i] == 1 || values[offset + i] == 7)
+            << i;
+    }
+
+    TargetBitmap not_res(size, false);
+    ASSERT_TRUE(index.Query(proto::plan::OpType::NotEqual,
+                            3,
+                            offset,
+                            size,
+                            TargetBitmapView(not_res)));
+    for (int64_t i = 0; i < size; ++i) {
+        EXPECT_EQ(not_res[i], values[offset + i] != 3) << i;
+    }
+}
+
+TEST(GrowingScalarIndexTest, WideRangeFallsBackToScan) {
+    ConcurrentVector<int32_t> data(kSizePerChunk);
+    GrowingScalarIndex<int32_t> index(&data, kSizePerChunk);
+    std::vector<int32_t> values(kSizePerChunk);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = i;
+    }
+    data.set_data_raw(0, values.data(), values.size());
+    index.Build(values.size());
+
+    TargetBitmap res(kSizePerChunk, false);
+    EXPECT_FALSE(index.Query(proto::plan::OpType::GreaterEqual,
+                             0,
+                             0,
+                             kSizePerChunk,
+                             TargetBitmapView(res)));
+    EXPECT_TRUE(res.none());
+
+    EXPECT_TRUE(index.Query(proto::plan::OpType::GreaterThan,
+                            kSizePerChunk - 2,
+                            0,
+                            kSizePerChunk,
+                            TargetBitmapView(res)));
+    EXPECT_EQ(res.count(), 1);
+    EXPECT_TRUE(res[kSizePerChunk - 1]);
+}
+
+TEST(GrowingScalarIndexTest, NaNOnlyMatchesNotEqual) {
+    ConcurrentVector<double> data(kSizePerChunk);
+    GrowingScalarIndex<double> index(&data, kSizePerChunk);
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> values = {1, nan, 2, 1, 3, 4, 5, 6};
+    data.set_data_raw(0, values.data(), values.size());
+    index.Build(values.size());
+
+    TargetBitmap res(kSizePerChunk, false);
+    ASSERT_TRUE(index.Query(proto::plan::OpType::NotEqual,
+                            1,
+                            0,
+                            kSizePerChunk,
+                            TargetBitmapView(res)));
+    for (int64_t i = 0; i < kSizePerChunk; ++i) {
+        EXPECT_EQ(res[i], values[i] != 1) << i;
+    }
+
+    TargetBitmap nan_res(kSizePerChunk, false);
+    EXPECT_FALSE(index.Query(proto::plan::OpType::Equal,
+                             nan,
+                             0,
+                             kSizePerChunk,
+                             TargetBitmapView(nan_res)));
+}
+
+TEST(GrowingScalarIndexTest, VarcharEquality) {
+    ConcurrentVector<std::string> data(kSizePerChunk);
+    GrowingScalarIndex<std::string> index(&data, kSizePerChunk);
+    std::vector<std::string> values = {
+        "b", "a", "c", "b", "d", "e", "f", "g", "b", "h"};
+    data.set_data_raw(0, values.data(), values.size());
+    index.Build(values.size());
+    EXPECT_EQ(index.IndexedRows(), kSizePerChunk);
+
+    TargetBitmap res(kSizePerChunk, false);
+    ASSERT_TRUE(
+        index.In({"b", "x"}, 0, kSizePerChunk, TargetBitmapView(res)));
+    for (int64_t i = 0; i < kSizePerChunk; ++i) {
+        EXPECT_EQ(res[i], values[i] == "b") << i;
+    }
+}
@@ -0,0 +1,333 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/GrowingSparseInvertedIndex.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+
+#include "common/EasyAssert.h"
+#include "knowhere/comp/index_param.h"
+#include "log/Log.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+float
+ConfigFloat(const knowhere::Json& search_cfg, const std::string& key) {
+    if (!search_cfg.contains(key) || !search_cfg[key].is_number()) {
+        return std::numeric_limits<float>::quiet_NaN();
+    }
+    return search_cfg[key].get<float>();
+}
+
+}  // namespace
+
+std::optional<SparseScorer>
+SparseScorer::Of(const knowhere::Json& search_cfg) {
+    if (!search_cfg.contains(knowhere::meta::METRIC_TYPE)) {
+        return std::nullopt;
+    }
+    auto metric = search_cfg[knowhere::meta::METRIC_TYPE].get<std::string>();
+    SparseScorer scorer;
+    if (IsMetricType(metric, knowhere::metric::IP)) {
+        return scorer;
+    }
+    if (!IsMetricType(metric, knowhere::metric::BM25)) {
+        return std::nullopt;
+    }
+    auto k1 = ConfigFloat(search_cfg, knowhere::meta::BM25_K1);
+    auto b = ConfigFloat(search_cfg, knowhere::meta::BM25_B);
+    auto avgdl = ConfigFloat(search_cfg, knowhere::meta::BM25_AVGDL);
+    // NaN fails the comparisons too
+    if (!(k1 >= 0) || !(b >= 0) || !(avgdl > 0)) {
+        return std::nullopt;
+    }
+    scorer.bm25_ = true;
+    scorer.k1_plus_1_ = k1 + 1;
+    scorer.norm_base_ = k1 * (1 - b);
+    scorer.norm_per_len_ = k1 * b / avgdl;
+    return scorer;
+}
+
+void
+SparseTopK::Push(float score, int64_t offset) {
+    if (score <= Threshold()) {
+        return;
+    }
+    if (static_cast<int64_t>(heap_.size()) == topk_) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+        heap_.pop_back();
+    }
+    heap_.emplace_back(score, offset);
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+}
+
+void
+SparseTopK::Dump(int64_t* offsets, float* distances) {
+    std::sort_heap(heap_.begin(), heap_.end(), std::greater<>());
+    for (size_t i = 0; i < heap_.size(); ++i) {
+        distances[i] = heap_[i].first;
+        offsets[i] = heap_[i].second;
+    }
+}
+
+SparsePostings::SparsePostings(const SparseRowType* rows, int64_t num_rows)
+    : num_rows_(num_rows), row_lens_(num_rows, 0) {
+    AssertInfo(num_rows <= std::numeric_limits<uint32_t>::max(),
+               "too many rows for sparse postings: {}",
+               num_rows);
+    // the list size of every dim, then the list of every dim
+    std::unordered_map<uint32_t, uint32_t> lists;
+    size_t num_postings = 0;
+    for (int64_t row = 0; row < num_rows; ++row) {
+        for (size_t i = 0; i < rows[row].size(); ++i) {
+            auto element = rows[row][i];
+            ++lists[element.id];
+            row_lens_[row] += element.val;
+        }
+        num_postings += rows[row].size();
+    }
+    dims_.reserve(lists.size());
+    for (const auto& [dim, _] : lists) {
+        dims_.push_back(dim);
+    }
+    std::sort(dims_.begin(), dims_.end());
+    list_begins_.resize(dims_.size() + 1, 0);
+    for (size_t list = 0; list < dims_.size(); ++list) {
+        auto& value = lists[dims_[list]];
+        list_begins_[list + 1] = list_begins_[list] + value;
+        value = list;
+    }
+
+    rows_.resize(num_postings);
+    values_.resize(num_postings);
+    max_values_.resize(dims_.size(), 0);
+    min_row_lens_.resize(dims_.size(), std::numeric_limits<float>::max());
+    std::vector<uint32_t> ends(list_begins_.begin(), list_begins_.end() - 1);
+    for (int64_t row = 0; row < num_rows; ++row) {
+        for (size_t i = 0; i < rows[row].size(); ++i) {
+            auto element = rows[row][i];
+            auto list = lists[element.id];
+            auto posting = ends[list]++;
+            rows_[posting] = row;
+            values_[posting] = element.val;
+            max_values_[list] = std::max<float>(max_values_[list], element.val);
+            min_row_lens_[list] = std::min(min_row_lens_[list], row_lens_[row]);
+        }
+    }
+}
+
+void
+SparsePostings::Search(const SparseRowType& query,
+                       const SparseScorer& scorer,
+                       const BitsetView& bitset,
+                       int64_t row_begin,
+                       SparseTopK& topk) const {
+    struct Term {
+        // no row of the list scores more for the term
+        float bound;
+        float weight;
+        uint32_t list;
+    };
+    std::vector<Term> terms;
+    auto dim = dims_.begin();
+    for (size_t i = 0; i < query.size() && dim != dims_.end(); ++i) {
+        auto element = query[i];
+        dim = std::lower_bound(dim, dims_.end(), element.id);
+        if (element.val <= 0 || dim == dims_.end() || *dim != element.id) {
+            continue;
+        }
+        uint32_t list = dim - dims_.begin();
+        terms.push_back(
+            {scorer.Score(element.val, max_values_[list], min_row_lens_[list]),
+             element.val,
+             list});
+    }
+    std::sort(terms.begin(), terms.end(), [](const Term& l, const Term& r) {
+        return l.bound < r.bound;
+    });
+    // bounds_below[t] bounds the score of terms [0, t)
+    std::vector<float> bounds_below(terms.size() + 1, 0);
+    for (size_t t = 0; t < terms.size(); ++t) {
+        bounds_below[t + 1] = bounds_below[t] + terms[t].bound;
+    }
+    // a row only in the lists [0, essential) can't beat the threshold
+    size_t essential = 0;
+    while (essential < terms.size() &&
+           bounds_below[essential + 1] <= topk.Threshold()) {
+        ++essential;
+    }
+    if (essential == terms.size()) {
+        return;
+    }
+
+    // the lists of the query dims added up dim by dim
+    thread_local std::vector<float> scores;
+    thread_local std::vector<uint8_t> seen;
+    thread_local std::vector<uint32_t> touched;
+    if (static_cast<int64_t>(scores.size()) < num_rows_) {
+        scores.resize(num_rows_, 0);
+        seen.resize(num_rows_, 0);
+    }
+    touched.clear();
+    for (auto t = essential; t < terms.size(); ++t) {
+        const auto& term = terms[t];
+        for (auto p = list_begins_[term.list]; p < list_begins_[term.list + 1];
+             ++p) {
+            auto row = rows_[p];
+            if (!seen[row]) {
+                seen[row] = 1;
+                touched.push_back(row);
+            }
+            scores[row] +=
+                scorer.Score(term.weight, values_[p], row_lens_[row]);
+        }
+    }
+
+    for (auto row : touched) {
+        auto score = scores[row];
+        scores[row] = 0;
+        seen[row] = 0;
+        auto offset = row_begin + row;
+        if (!bitset.empty() && bitset.test(offset)) {
+            continue;
+        }
+        // probe the other lists, the most promising first, while the row
+        // can still enter
+        bool pruned = false;
+        for (auto t = essential; t-- > 0;) {
+            if (score + bounds_below[t + 1] <= topk.Threshold()) {
+                pruned = true;
+                break;
+            }
+            const auto& term = terms[t];
+            auto begin = rows_.begin() + list_begins_[term.list];
+            auto end = rows_.begin() + list_begins_[term.list + 1];
+            auto it = std::lower_bound(begin, end, row);
+            if (it != end && *it == row) {
+                score += scorer.Score(
+                    term.weight, values_[it - rows_.begin()], row_lens_[row]);
+            }
+        }
+        if (!pruned) {
+            topk.Push(score, offset);
+        }
+    }
+}
+
+size_t
+SparsePostings::MemorySize() const {
+    return (dims_.capacity() + list_begins_.capacity() + rows_.capacity()) *
+               sizeof(uint32_t) +
+           (values_.capacity() + max_values_.capacity() +
+            min_row_lens_.capacity() + row_lens_.capacity()) *
+               sizeof(float);
+}
+
+GrowingSparseInvertedIndex::GrowingSparseInvertedIndex(const VectorBase* data,
+                                                       int64_t size_per_chunk)
+    : data_(data), size_per_chunk_(size_per_chunk) {
+    AssertInfo(data_ != nullptr,
+               "growing sparse inverted index needs the raw data");
+    AssertInfo(size_per_chunk_ > 0 && size_per_chunk_ != MAX_ROW_COUNT,
+               "growing sparse inverted index needs fixed size chunks, got {}",
+               size_per_chunk_);
+}
+
+void
+GrowingSparseInvertedIndex::Build(int64_t num_rows) {
+    auto num_chunks = num_rows / size_per_chunk_;
+    if (num_rows <= measured_rows_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard lock(build_mutex_);
+    double total_row_len = total_row_len_.load(std::memory_order_relaxed);
+    for (auto row = measured_rows_.load(std::memory_order_relaxed);
+         row < num_rows;
+         ++row) {
+        auto chunk = static_cast<const SparseRowType*>(
+            data_->get_chunk_data(row / size_per_chunk_));
+        const auto& sparse_row = chunk[row % size_per_chunk_];
+        for (size_t i = 0; i < sparse_row.size(); ++i) {
+            total_row_len += sparse_row[i].val;
+        }
+    }
+    total_row_len_.store(total_row_len, std::memory_order_relaxed);
+    measured_rows_.store(std::max(measured_rows_.load(), num_rows),
+                         std::memory_order_release);
+
+    if (num_chunks <= static_cast<int64_t>(chunks_.size())) {
+        return;
+    }
+    for (auto chunk_id = static_cast<int64_t>(chunks_.size());
+         chunk_id < num_chunks;
+         ++chunk_id) {
+        chunks_.emplace_back(
+            static_cast<const SparseRowType*>(data_->get_chunk_data(chunk_id)),
+            size_per_chunk_);
+        indexed_chunks_.store(chunk_id + 1, std::memory_order_release);
+    }
+    LOG_DEBUG("growing sparse inverted index covers {} chunks of {} rows",
+              num_chunks,
+              size_per_chunk_);
+}
+
+float
+GrowingSparseInvertedIndex::AvgRowLen() const {
+    auto num_rows = measured_rows_.load(std::memory_order_acquire);
+    if (num_rows == 0) {
+        return 0;
+    }
+    return total_row_len_.load(std::memory_order_relaxed) / num_rows;
+}
+
+size_t
+GrowingSparseInvertedIndex::MemorySize() const {
+    size_t size = 0;
+    auto num_chunks = indexed_chunks_.load(std::memory_order_acquire);
+    for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+        size += chunks_[chunk_id].MemorySize();
+    }
+    return size;
+}
+
+void
+GrowingSparseInvertedIndex::Search(const SparseRowType* queries,
+                                   int64_t num_queries,
+                                   int64_t topk,
+                                   const SparseScorer& scorer,
+                                   const BitsetView& bitset,
+                                   int64_t num_rows,
+                                   int64_t* offsets,
+                                   float* distances) const {
+    num_rows = std::min(num_rows, IndexedRows());
+    auto num_chunks = num_rows / size_per_chunk_;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        // the threshold of the chunks before prunes the chunks after
+        SparseTopK found(topk);
+        for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+            chunks_[chunk_id].Search(
+                queries[q], scorer, bitset, chunk_id * size_per_chunk_, found);
+        }
+        found.Dump(offsets + q * topk, distances + q * topk);
+    }
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,185 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <tbb/concurrent_vector.h>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "common/Utils.h"
+#include "knowhere/config.h"
+#include "segcore/ConcurrentVector.h"
+
+namespace milvus::segcore {
+
+using SparseRowType = knowhere::sparse::SparseRow<SparseValueType>;
+
+// The score a query weight and a row value add to the IP or BM25 distance
+// of a row. BM25 takes the length of the row, the sum of its values, and
+// folds k1, b and avgdl into a length norm of two constants up front.
+class SparseScorer {
+ public:
+    // nullopt for the metrics scored elsewhere and if a BM25 parameter is
+    // missing from the brute force search config
+    static std::optional<SparseScorer>
+    Of(const knowhere::Json& search_cfg);
+
+    float
+    Score(float weight, float value, float row_len) const {
+        if (!bm25_) {
+            return weight * value;
+        }
+        return weight * k1_plus_1_ * value /
+               (value + norm_base_ + norm_per_len_ * row_len);
+    }
+
+ private:
+    SparseScorer() = default;
+
+    bool bm25_ = false;
+    // k1 + 1, k1 * (1 - b) and k1 * b / avgdl
+    float k1_plus_1_ = 0;
+    float norm_base_ = 0;
+    float norm_per_len_ = 0;
+};
+
+// the best (score, offset) pairs seen so far by a query, the worst on top
+class SparseTopK {
+ public:
+    explicit SparseTopK(int64_t topk) : topk_(topk) {
+    }
+
+    // a row must score above this to enter
+    float
+    Threshold() const {
+        return static_cast<int64_t>(heap_.size()) < topk_
+                   ? 0
+                   : heap_.front().first;
+    }
+
+    void
+    Push(float score, int64_t offset);
+
+    // writes the found rows most similar first and leaves the slots past
+    // them as they are
+    void
+    Dump(int64_t* offsets, float* distances);
+
+ private:
+    const int64_t topk_;
+    std::vector<std::pair<float, int64_t>> heap_;
+};
+
+// The rows of a run of sparse vectors grouped by dim, each posting list in
+// row order, so a query adds up the lists of its dims instead of visiting
+// every row. A list keeps the largest value and the shortest row of its
+// postings: MaxScore leaves out the lists whose bounds add up to no more
+// than the current topk threshold and only probes them for the rows the
+// others found.
+class SparsePostings {
+ public:
+    SparsePostings(const SparseRowType* rows, int64_t num_rows);
+
+    // pushes the rows scoring above zero, offset by row_begin, that are not
+    // set in bitset at row_begin + row
+    void
+    Search(const SparseRowType& query,
+           const SparseScorer& scorer,
+           const BitsetView& bitset,
+           int64_t row_begin,
+           SparseTopK& topk) const;
+
+    size_t
+    MemorySize() const;
+
+ private:
+    const int64_t num_rows_;
+    // the list of dims_[i] is postings [list_begins_[i], list_begins_[i + 1])
+    std::vector<uint32_t> dims_;
+    std::vector<uint32_t> list_begins_;
+    std::vector<uint32_t> rows_;
+    std::vector<float> values_;
+    std::vector<float> max_values_;
+    std::vector<float> min_row_lens_;
+    std::vector<float> row_lens_;
+};
+
+// SparsePostings over the full chunks of a sparse vector field of a growing
+// segment. Like GrowingMinHashLSH a chunk is indexed once it is complete,
+// the open chunk is left to the brute force search.
+class GrowingSparseInvertedIndex {
+ public:
+    GrowingSparseInvertedIndex(const VectorBase* data, int64_t size_per_chunk);
+
+    // indexes the chunks completed by the first num_rows rows
+    void
+    Build(int64_t num_rows);
+
+    // rows [0, IndexedRows()) are in the postings
+    int64_t
+    IndexedRows() const {
+        return indexed_chunks_.load(std::memory_order_acquire) *
+               size_per_chunk_;
+    }
+
+    size_t
+    MemorySize() const;
+
+    // the mean length of the rows Build has seen, open chunk included, 0
+    // before the first row. The BM25 avgdl of the segment.
+    float
+    AvgRowLen() const;
+
+    // the topk of rows [0, num_rows) not set in bitset for each query.
+    // Writes offsets[q * topk ...] and distances[q * topk ...] most similar
+    // first and leaves the slots past the found rows as they are.
+    void
+    Search(const SparseRowType* queries,
+           int64_t num_queries,
+           int64_t topk,
+           const SparseScorer& scorer,
+           const BitsetView& bitset,
+           int64_t num_rows,
+           int64_t* offsets,
+           float* distances) const;
+
+ private:
+    const VectorBase* data_;
+    const int64_t size_per_chunk_;
+    std::mutex build_mutex_;
+    tbb::concurrent_vector<SparsePostings> chunks_;
+    std::atomic<int64_t> indexed_chunks_{0};
+    // the length sum of rows [0, measured_rows_), the sum is updated first
+    // so a reader at most overestimates the mean by the rows in flight
+    std::atomic<double> total_row_len_{0};
+    std::atomic<int64_t> measured_rows_{0};
+};
+
+using GrowingSparseInvertedIndexPtr =
+    std::shared_ptr<GrowingSparseInvertedIndex>;
+
+}  // namespace milvus::segcore
@@ -0,0 +1,248 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "knowhere/comp/index_param.h"
+#include "segcore/ConcurrentVector.h"
+#include "segcore/GrowingSparseInvertedIndex.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kSizePerChunk = 128;
+
+// rows of a few dims out of 200, the first dims common and the rest rare
+std::vector<SparseRowType>
+GenRows(int64_t num_rows, std::default_random_engine& er) {
+    std::vector<SparseRowType> rows;
+    rows.reserve(num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        std::vector<uint32_t> dims;
+        for (int64_t n = er() % 12; n > 0; --n) {
+            auto dim = er() % 200;
+            dims.push_back(er() % 2 ? dim % 20 : dim);
+        }
+        std::sort(dims.begin(), dims.end());
+        dims.erase(std::unique(dims.begin(), dims.end()), dims.end());
+        SparseRowType row(dims.size());
+        for (size_t j = 0; j < dims.size(); ++j) {
+            row.set_at(j, dims[j], 0.1f + (er() % 100) / 10.0f);
+        }
+        rows.push_back(std::move(row));
+    }
+    return rows;
+}
+
+float
+RowLen(const SparseRowType& row) {
+    float len = 0;
+    for (size_t i = 0; i < row.size(); ++i) {
+        len += row[i].val;
+    }
+    return len;
+}
+
+// the score of every row, 0 for the rows sharing no dim with the query
+std::vector<float>
+ExpectedScores(const std::vector<SparseRowType>& rows,
+               const SparseRowType& query,
+               const SparseScorer& scorer) {
+    std::vector<float> scores(rows.size(), 0);
+    for (size_t r = 0; r < rows.size(); ++r) {
+        const auto& row = rows[r];
+        for (size_t i = 0; i < row.size(); ++i) {
+            for (size_t j = 0; j < query.size(); ++j) {
+                if (row[i].id == query[j].id) {
+                    scores[r] +=
+                        scorer.Score(query[j].val, row[i].val, RowLen(row));
+                }
+            }
+        }
+    }
+    return scores;
+}
+
+void
+CheckTopK(const std::vector<float>& expected,
+          const BitsetType& filtered,
+          int64_t topk,
+          const int64_t* offsets,
+          const float* distances) {
+    std::vector<float> kept;
+    for (size_t r = 0; r < expected.size(); ++r) {
+        if (!filtered[r] && expected[r] > 0) {
+            kept.push_back(expected[r]);
+        }
+    }
+    std::sort(kept.rbegin(), kept.rend());
+    auto found = std::min<int64_t>(topk, kept.size());
+    for (int64_t k = 0; k < found; ++k) {
+        ASSERT_NE(offsets[k], INVALID_SEG_OFFSET);
+        ASSERT_FALSE(filtered[offsets[k]]);
+        EXPECT_NEAR(distances[k], expected[offsets[k]], 1e-3);
+        // the same scores as the exact topk, whatever rows the ties pick
+        EXPECT_NEAR(distances[k], kept[k], 1e-3);
+    }
+    for (int64_t k = found; k < topk; ++k) {
+        EXPECT_EQ(offsets[k], INVALID_SEG_OFFSET);
+    }
+}
+
+std::vector<SparseScorer>
+Scorers() {
+    knowhere::Json ip;
+    ip[knowhere::meta::METRIC_TYPE] = knowhere::metric::IP;
+    knowhere::Json bm25;
+    bm25[knowhere::meta::METRIC_TYPE] = knowhere::metric::BM25;
+    bm25[knowhere::meta::BM25_K1] = 1.2f;
+    bm25[knowhere::meta::BM25_B] = 0.75f;
+    bm25[knowhere::meta::BM25_AVGDL] = 20.0f;
+    return {SparseScorer::Of(ip).value(), SparseScorer::Of(bm25).value()};
+}
+
+}  // namespace
+
+TEST(GrowingSparseInvertedIndexTest, ScorerNeedsBM25Params) {
+    knowhere::Json cfg;
+    EXPECT_FALSE(SparseScorer::Of(cfg).has_value());
+    cfg[knowhere::meta::METRIC_TYPE] = knowhere::metric::L2;
+    EXPECT_FALSE(SparseScorer::Of(cfg).has_value());
+    cfg[knowhere::meta::METRIC_TYPE] = knowhere::metric::BM25;
+    cfg[knowhere::meta::BM25_K1] = 1.2f;
+    cfg[knowhere::meta::BM25_B] = 0.75f;
+    EXPECT_FALSE(SparseScorer::Of(cfg).has_value());
+    cfg[knowhere::meta::BM25_AVGDL] = 10.0f;
+    auto scorer = SparseScorer::Of(cfg);
+    ASSERT_TRUE(scorer.has_value());
+    // a row of the average length scores tf * (k1 + 1) / (tf + k1)
+    EXPECT_FLOAT_EQ(scorer->Score(2.0f, 3.0f, 10.0f),
+                    2.0f * 3.0f * 2.2f / (3.0f + 1.2f));
+}
+
+TEST(GrowingSparseInvertedIndexTest, PostingsMatchBruteForce) {
+    int64_t num_rows = 1000;
+    int64_t topk = 10;
+    std::default_random_engine er(42);
+    auto rows = GenRows(num_rows, er);
+    auto queries = GenRows(20, er);
+    // rows past row_begin are offsets past it in the bitset
+    int64_t row_begin = 100;
+    SparsePostings postings(rows.data(), num_rows);
+    EXPECT_GT(postings.MemorySize(), size_t{0});
+
+    BitsetType filtered(row_begin + num_rows);
+    for (int64_t i = 0; i < row_begin + num_rows; i += 3) {
+        filtered[i] = true;
+    }
+    BitsetView bitset(filtered);
+    BitsetType shifted(num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        shifted[i] = filtered[row_begin + i];
+    }
+
+    for (const auto& scorer : Scorers()) {
+        for (const auto& query : queries) {
+            SparseTopK found(topk);
+            postings.Search(query, scorer, bitset, row_begin, found);
+            std::vector<int64_t> offsets(topk, INVALID_SEG_OFFSET);
+            std::vector<float> distances(topk, 0);
+            found.Dump(offsets.data(), distances.data());
+            for (auto& offset : offsets) {
+                if (offset != INVALID_SEG_OFFSET) {
+                    ASSERT_GE(offset, row_begin);
+                    offset -= row_begin;
+                }
+            }
+            CheckTopK(ExpectedScores(rows, query, scorer),
+                      shifted,
+                      topk,
+                      offsets.data(),
+                      distances.data());
+        }
+    }
+}
+
+TEST(GrowingSparseInvertedIndexTest, IndexesFullChunks) {
+    int64_t num_rows = 3 * kSizePerChunk + 7;
+    int64_t topk = 5;
+    std::default_random_engine er(42);
+    auto rows = GenRows(num_rows, er);
+    ConcurrentVector<SparseFloatVector> data(kSizePerChunk);
+    data.set_data_raw(0, rows.data(), num_rows);
+    GrowingSparseInvertedIndex index(&data, kSizePerChunk);
+    index.Build(kSizePerChunk - 1);
+    EXPECT_EQ(index.IndexedRows(), 0);
+    index.Build(num_rows);
+    EXPECT_EQ(index.IndexedRows(), 3 * kSizePerChunk);
+    EXPECT_GT(index.MemorySize(), size_t{0});
+
+    BitsetType filtered(num_rows);
+    for (int64_t i = 0; i < num_rows; i += 4) {
+        filtered[i] = true;
+    }
+    BitsetView bitset(filtered);
+    auto queries = GenRows(8, er);
+    // the rows past the indexed chunks are left to the brute force
+    std::vector<SparseRowType> indexed(rows.begin(),
+                                       rows.begin() + index.IndexedRows());
+    for (const auto& scorer : Scorers()) {
+        std::vector<int64_t> offsets(queries.size() * topk, INVALID_SEG_OFFSET);
+        std::vector<float> distances(queries.size() * topk, 0);
+        index.Search(queries.data(),
+                     queries.size(),
+                     topk,
+                     scorer,
+                     bitset,
+                     num_rows,
+                     offsets.data(),
+                     distances.data());
+        for (size_t q = 0; q < queries.size(); ++q) {
+            CheckTopK(ExpectedScores(indexed, queries[q], scorer),
+                      filtered,
+                      topk,
+                      offsets.data() + q * topk,
+                      distances.data() + q * topk);
+        }
+    }
+}
+
+TEST(GrowingSparseInvertedIndexTest, AvgRowLenCoversOpenChunk) {
+    int64_t num_rows = kSizePerChunk + 30;
+    std::default_random_engine er(42);
+    auto rows = GenRows(num_rows, er);
+    ConcurrentVector<SparseFloatVector> data(kSizePerChunk);
+    data.set_data_raw(0, rows.data(), num_rows);
+    GrowingSparseInvertedIndex index(&data, kSizePerChunk);
+    EXPECT_EQ(index.AvgRowLen(), 0);
+
+    double total = 0;
+    for (int64_t end : {int64_t{10}, kSizePerChunk + 1, num_rows}) {
+        index.Build(end);
+        total = 0;
+        for (int64_t i = 0; i < end; ++i) {
+            total += RowLen(rows[i]);
+        }
+        EXPECT_NEAR(index.AvgRowLen(), total / end, 1e-3);
+    }
+    EXPECT_EQ(index.IndexedRows(), kSizePerChunk);
+    // a shorter prefix than seen before changes nothing
+    index.Build(5);
+    EXPECT_NEAR(index.AvgRowLen(), total / num_rows, 1e-3);
+}
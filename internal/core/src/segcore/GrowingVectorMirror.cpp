@@ -0,0 +1,291 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/GrowingVectorMirror.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "common/EasyAssert.h"
+#include "common/Utils.h"
+#include "log/Log.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+constexpr float kMaxCode = 255.0f;
+
+// independent partial sums, so the loops below vectorize
+constexpr int64_t kLanes = 8;
+
+float
+WeightedL2(const float* query,
+           const float* weights,
+           const uint8_t* codes,
+           int64_t dim) {
+    float sums[kLanes] = {};
+    int64_t d = 0;
+    for (; d + kLanes <= dim; d += kLanes) {
+        for (int64_t l = 0; l < kLanes; ++l) {
+            auto diff = query[d + l] - static_cast<float>(codes[d + l]);
+            sums[l] += weights[d + l] * diff * diff;
+        }
+    }
+    for (; d < dim; ++d) {
+        auto diff = query[d] - static_cast<float>(codes[d]);
+        sums[0] += weights[d] * diff * diff;
+    }
+    float sum = 0;
+    for (auto partial : sums) {
+        sum += partial;
+    }
+    return sum;
+}
+
+float
+CodeIP(const float* query, const uint8_t* codes, int64_t dim) {
+    float sums[kLanes] = {};
+    int64_t d = 0;
+    for (; d + kLanes <= dim; d += kLanes) {
+        for (int64_t l = 0; l < kLanes; ++l) {
+            sums[l] += query[d + l] * static_cast<float>(codes[d + l]);
+        }
+    }
+    for (; d < dim; ++d) {
+        sums[0] += query[d] * static_cast<float>(codes[d]);
+    }
+    float sum = 0;
+    for (auto partial : sums) {
+        sum += partial;
+    }
+    return sum;
+}
+
+float
+RawIP(const float* left, const float* right, int64_t dim) {
+    float sum = 0;
+    for (int64_t d = 0; d < dim; ++d) {
+        sum += left[d] * right[d];
+    }
+    return sum;
+}
+
+float
+RawL2(const float* left, const float* right, int64_t dim) {
+    float sum = 0;
+    for (int64_t d = 0; d < dim; ++d) {
+        auto diff = left[d] - right[d];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+}  // namespace
+
+GrowingVectorMirror::GrowingVectorMirror(const VectorBase* data,
+                                         int64_t dim,
+                                         int64_t size_per_chunk)
+    : data_(data), dim_(dim), size_per_chunk_(size_per_chunk) {
+    AssertInfo(data_ != nullptr, "growing vector mirror needs the raw data");
+    AssertInfo(dim_ > 0, "invalid dim {} for growing vector mirror", dim_);
+    AssertInfo(size_per_chunk_ > 0 && size_per_chunk_ != MAX_ROW_COUNT,
+               "growing vector mirror needs fixed size chunks, got {}",
+               size_per_chunk_);
+}
+
+bool
+GrowingVectorMirror::Supports(const MetricType& metric_type) {
+    return IsMetricType(metric_type, knowhere::metric::L2) ||
+           IsMetricType(metric_type, knowhere::metric::IP) ||
+           IsMetricType(metric_type, knowhere::metric::COSINE);
+}
+
+const float*
+GrowingVectorMirror::Raw(int64_t row) const {
+    auto chunk = static_cast<const float*>(
+        data_->get_chunk_data(row / size_per_chunk_));
+    return chunk + (row % size_per_chunk_) * dim_;
+}
+
+void
+GrowingVectorMirror::Train() {
+    min_.assign(dim_, std::numeric_limits<float>::max());
+    std::vector<float> max(dim_, std::numeric_limits<float>::lowest());
+    for (int64_t row = 0; row < size_per_chunk_; ++row) {
+        auto vec = Raw(row);
+        for (int64_t d = 0; d < dim_; ++d) {
+            min_[d] = std::min(min_[d], vec[d]);
+            max[d] = std::max(max[d], vec[d]);
+        }
+    }
+    scale_.resize(dim_);
+    for (int64_t d = 0; d < dim_; ++d) {
+        scale_[d] = (max[d] - min_[d]) / kMaxCode;
+    }
+}
+
+void
+GrowingVectorMirror::Build(int64_t num_rows) {
+    auto num_chunks = num_rows / size_per_chunk_;
+    if (num_chunks <= mirrored_chunks_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::lock_guard lock(build_mutex_);
+    if (min_.empty()) {
+        Train();
+    }
+    for (auto chunk_id = static_cast<int64_t>(chunks_.size());
+         chunk_id < num_chunks;
+         ++chunk_id) {
+        Chunk chunk;
+        chunk.codes_.resize(size_per_chunk_ * dim_);
+        chunk.norms_.resize(size_per_chunk_);
+        for (int64_t i = 0; i < size_per_chunk_; ++i) {
+            auto vec = Raw(chunk_id * size_per_chunk_ + i);
+            auto codes = chunk.codes_.data() + i * dim_;
+            for (int64_t d = 0; d < dim_; ++d) {
+                // later chunks may leave the trained range, clamp them
+                auto code = scale_[d] > 0
+                                ? std::round((vec[d] - min_[d]) / scale_[d])
+                                : 0.0f;
+                codes[d] =
+                    static_cast<uint8_t>(std::clamp(code, 0.0f, kMaxCode));
+            }
+            chunk.norms_[i] = std::sqrt(RawIP(vec, vec, dim_));
+        }
+        chunks_.push_back(std::move(chunk));
+        mirrored_chunks_.store(chunk_id + 1, std::memory_order_release);
+    }
+    LOG_DEBUG("growing vector mirror covers {} chunks of {} rows",
+              num_chunks,
+              size_per_chunk_);
+}
+
+size_t
+GrowingVectorMirror::MemorySize() const {
+    size_t size = (min_.capacity() + scale_.capacity()) * sizeof(float);
+    auto num_chunks = mirrored_chunks_.load(std::memory_order_acquire);
+    for (int64_t chunk_id = 0; chunk_id < num_chunks; ++chunk_id) {
+        const auto& chunk = chunks_[chunk_id];
+        size += chunk.codes_.capacity() +
+                chunk.norms_.capacity() * sizeof(float);
+    }
+    return size;
+}
+
+void
+GrowingVectorMirror::Search(const float* queries,
+                            int64_t num_queries,
+                            int64_t topk,
+                            int64_t num_candidates,
+                            const MetricType& metric_type,
+                            const BitsetView& bitset,
+                            int64_t num_rows,
+                            int64_t* offsets,
+                            float* distances) const {
+    AssertInfo(Supports(metric_type),
+               "growing vector mirror does not support metric {}",
+               metric_type);
+    num_rows = std::min(num_rows, MirroredRows());
+    num_candidates = std::max(num_candidates, topk);
+    auto is_l2 = IsMetricType(metric_type, knowhere::metric::L2);
+    auto is_cosine = IsMetricType(metric_type, knowhere::metric::COSINE);
+
+    // the query in code space: (q - min) / scale with weights scale^2 for
+    // L2, q * scale for IP, so no row is decoded
+    std::vector<float> coded_query(dim_);
+    std::vector<float> weights(dim_);
+    // (score, row), the worst candidate on top
+    std::priority_queue<std::pair<float, int64_t>> candidates;
+    std::vector<std::pair<float, int64_t>> refined;
+    for (int64_t q = 0; q < num_queries; ++q) {
+        auto query = queries + q * dim_;
+        float bias = 0;
+        for (int64_t d = 0; d < dim_; ++d) {
+            if (is_l2) {
+                // a constant dim adds the same to every row
+                coded_query[d] =
+                    scale_[d] > 0 ? (query[d] - min_[d]) / scale_[d] : 0;
+                weights[d] = scale_[d] * scale_[d];
+            } else {
+                coded_query[d] = query[d] * scale_[d];
+                bias += query[d] * min_[d];
+            }
+        }
+
+        for (int64_t row = 0; row < num_rows; ++row) {
+            if (!bitset.empty() && bitset.test(row)) {
+                continue;
+            }
+            const auto& chunk = chunks_[row / size_per_chunk_];
+            auto chunk_offset = row % size_per_chunk_;
+            auto codes = chunk.codes_.data() + chunk_offset * dim_;
+            // smaller is nearer
+            float score;
+            if (is_l2) {
+                score = WeightedL2(
+                    coded_query.data(), weights.data(), codes, dim_);
+            } else {
+                score = -(bias + CodeIP(coded_query.data(), codes, dim_));
+                if (is_cosine) {
+                    auto norm = chunk.norms_[chunk_offset];
+                    score = norm > 0 ? score / norm : 0;
+                }
+            }
+            if (static_cast<int64_t>(candidates.size()) < num_candidates) {
+                candidates.emplace(score, row);
+            } else if (score < candidates.top().first) {
+                candidates.pop();
+                candidates.emplace(score, row);
+            }
+        }
+
+        refined.clear();
+        auto query_norm = is_cosine ? std::sqrt(RawIP(query, query, dim_)) : 0;
+        while (!candidates.empty()) {
+            auto row = candidates.top().second;
+            candidates.pop();
+            auto vec = Raw(row);
+            float distance;
+            if (is_l2) {
+                distance = RawL2(query, vec, dim_);
+            } else {
+                distance = RawIP(query, vec, dim_);
+                if (is_cosine) {
+                    auto norm =
+                        query_norm * chunks_[row / size_per_chunk_]
+                                         .norms_[row % size_per_chunk_];
+                    distance = norm > 0 ? distance / norm : 0;
+                }
+            }
+            refined.emplace_back(is_l2 ? distance : -distance, row);
+        }
+        auto found = std::min<int64_t>(topk, refined.size());
+        std::partial_sort(
+            refined.begin(), refined.begin() + found, refined.end());
+        for (int64_t i = 0; i < found; ++i) {
+            offsets[q * topk + i] = refined[i].second;
+            distances[q * topk + i] =
+                is_l2 ? refined[i].first : -refined[i].first;
+        }
+    }
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,107 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <tbb/concurrent_vector.h>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "segcore/ConcurrentVector.h"
+
+namespace milvus::segcore {
+
+// SQ8 copy of a float vector field of a growing segment: a byte per
+// dimension, scaled to the per dimension range of the first chunk. Like
+// GrowingScalarIndex it covers the full chunks, the open chunk is left to
+// the brute force search.
+//
+// A search scans the codes for the nearest candidates of every query and
+// refines them on the raw floats, so the distances it returns are exact and
+// a query reads a quarter of the bytes of the raw scan.
+class GrowingVectorMirror {
+ public:
+    GrowingVectorMirror(const VectorBase* data,
+                        int64_t dim,
+                        int64_t size_per_chunk);
+
+    // encodes the chunks completed by the first num_rows rows
+    void
+    Build(int64_t num_rows);
+
+    // rows [0, MirroredRows()) are covered by the codes
+    int64_t
+    MirroredRows() const {
+        return mirrored_chunks_.load(std::memory_order_acquire) *
+               size_per_chunk_;
+    }
+
+    size_t
+    MemorySize() const;
+
+    // the metrics the codes can rank by
+    static bool
+    Supports(const MetricType& metric_type);
+
+    // the topk of rows [0, num_rows) not set in bitset for each query,
+    // refined from the num_candidates nearest by code. Writes
+    // offsets[q * topk ...] and distances[q * topk ...] best first and leaves
+    // the slots past the found rows as they are.
+    void
+    Search(const float* queries,
+           int64_t num_queries,
+           int64_t topk,
+           int64_t num_candidates,
+           const MetricType& metric_type,
+           const BitsetView& bitset,
+           int64_t num_rows,
+           int64_t* offsets,
+           float* distances) const;
+
+ private:
+    struct Chunk {
+        std::vector<uint8_t> codes_;
+        // norms of the raw vectors, for cosine
+        std::vector<float> norms_;
+    };
+
+    const float*
+    Raw(int64_t row) const;
+
+    void
+    Train();
+
+ private:
+    const VectorBase* data_;
+    const int64_t dim_;
+    const int64_t size_per_chunk_;
+    // set by the first Build, read only after mirrored_chunks_ is published
+    std::vector<float> min_;
+    std::vector<float> scale_;
+    std::mutex build_mutex_;
+    tbb::concurrent_vector<Chunk> chunks_;
+    std::atomic<int64_t> mirrored_chunks_{0};
+};
+
+using GrowingVectorMirrorPtr = std::shared_ptr<GrowingVectorMirror>;
+
+}  // namespace milvus::segcore
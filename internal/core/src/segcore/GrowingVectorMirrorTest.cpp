@@ -0,0 +1,144 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "segcore/ConcurrentVector.h"
+#include "segcore/GrowingVectorMirror.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kDim = 19;
+constexpr int64_t kSizePerChunk = 256;
+
+// the smaller the nearer, as the mirror ranks
+float
+Score(const MetricType& metric_type, const float* query, const float* vec) {
+    float l2 = 0, ip = 0, query_norm = 0, vec_norm = 0;
+    for (int64_t d = 0; d < kDim; ++d) {
+        l2 += (query[d] - vec[d]) * (query[d] - vec[d]);
+        ip += query[d] * vec[d];
+        query_norm += query[d] * query[d];
+        vec_norm += vec[d] * vec[d];
+    }
+    if (metric_type == knowhere::metric::L2) {
+        return l2;
+    }
+    if (metric_type == knowhere::metric::IP) {
+        return -ip;
+    }
+    return -ip / std::sqrt(query_norm * vec_norm);
+}
+
+}  // namespace
+
+TEST(GrowingVectorMirrorTest, MirrorsFullChunks) {
+    ConcurrentVector<FloatVector> data(kDim, kSizePerChunk);
+    GrowingVectorMirror mirror(&data, kDim, kSizePerChunk);
+    std::vector<float> vecs((2 * kSizePerChunk + 7) * kDim, 1.0f);
+    data.set_data_raw(0, vecs.data(), kSizePerChunk - 1);
+    mirror.Build(kSizePerChunk - 1);
+    EXPECT_EQ(mirror.MirroredRows(), 0);
+
+    data.set_data_raw(kSizePerChunk - 1,
+                      vecs.data() + (kSizePerChunk - 1) * kDim,
+                      kSizePerChunk + 8);
+    mirror.Build(2 * kSizePerChunk + 7);
+    EXPECT_EQ(mirror.MirroredRows(), 2 * kSizePerChunk);
+    EXPECT_GT(mirror.MemorySize(), 2 * kSizePerChunk * kDim);
+}
+
+TEST(GrowingVectorMirrorTest, RefinedSearchMatchesBruteForce) {
+    int64_t num_rows = 4 * kSizePerChunk;
+    int64_t num_queries = 8;
+    int64_t topk = 10;
+    std::default_random_engine er(42);
+    std::normal_distribution<float> dist;
+    std::vector<float> vecs(num_rows * kDim);
+    for (auto& value : vecs) {
+        value = dist(er);
+    }
+    std::vector<float> queries(num_queries * kDim);
+    for (auto& value : queries) {
+        value = dist(er);
+    }
+
+    ConcurrentVector<FloatVector> data(kDim, kSizePerChunk);
+    data.set_data_raw(0, vecs.data(), num_rows);
+    GrowingVectorMirror mirror(&data, kDim, kSizePerChunk);
+    mirror.Build(num_rows);
+
+    BitsetType filtered(num_rows);
+    for (int64_t i = 0; i < num_rows; i += 5) {
+        filtered[i] = true;
+    }
+    BitsetView bitset(filtered);
+
+    for (const MetricType& metric_type : {knowhere::metric::L2,
+                                          knowhere::metric::IP,
+                                          knowhere::metric::COSINE}) {
+        std::vector<int64_t> offsets(num_queries * topk, INVALID_SEG_OFFSET);
+        std::vector<float> distances(num_queries * topk);
+        mirror.Search(queries.data(),
+                      num_queries,
+                      topk,
+                      3 * topk,
+                      metric_type,
+                      bitset,
+                      num_rows,
+                      offsets.data(),
+                      distances.data());
+
+        int64_t hits = 0;
+        for (int64_t q = 0; q < num_queries; ++q) {
+            auto query = queries.data() + q * kDim;
+            std::vector<std::pair<float, int64_t>> expected;
+            for (int64_t row = 0; row < num_rows; ++row) {
+                if (!filtered[row]) {
+                    expected.emplace_back(
+                        Score(metric_type, query, vecs.data() + row * kDim),
+                        row);
+                }
+            }
+            std::sort(expected.begin(), expected.end());
+            for (int64_t k = 0; k < topk; ++k) {
+                auto offset = offsets[q * topk + k];
+                ASSERT_NE(offset, INVALID_SEG_OFFSET);
+                ASSERT_FALSE(filtered[offset]);
+                // distances are exact, in the order of the metric
+                auto score =
+                    Score(metric_type, query, vecs.data() + offset * kDim);
+                auto distance = distances[q * topk + k];
+                EXPECT_NEAR(score,
+                            metric_type == knowhere::metric::L2 ? distance
+                                                                : -distance,
+                            1e-4)
+                    << metric_type;
+                for (int64_t j = 0; j < topk; ++j) {
+                    hits += expected[j].second == offset;
+                }
+            }
+        }
+        EXPECT_GE(hits, num_queries * topk * 9 / 10) << metric_type;
+    }
+}
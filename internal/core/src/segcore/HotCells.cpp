@@ -0,0 +1,199 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/HotCells.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace milvus::segcore {
+
+namespace {
+
+constexpr const char* kSnapshotHeader = "# milvus hot cells v1";
+
+}  // namespace
+
+std::atomic<bool> HotCells::enabled_{false};
+
+HotCells&
+HotCells::Instance() {
+    static HotCells instance;
+    return instance;
+}
+
+HotCells::~HotCells() {
+    Stop();
+}
+
+void
+HotCells::SetEnabled(bool enabled) {
+    enabled_.store(enabled);
+}
+
+bool
+HotCells::IsEnabled() {
+    return enabled_.load();
+}
+
+void
+HotCells::Start(const std::string& path, std::chrono::seconds interval) {
+    Stop();
+    if (path.empty() || interval.count() <= 0) {
+        SetEnabled(false);
+        return;
+    }
+    if (Load(path)) {
+        LOG_INFO("read hot cell snapshot {}", path);
+    }
+    SetEnabled(true);
+    stopping_ = false;
+    snapshotter_ = std::thread([this, path, interval]() {
+        std::unique_lock<std::mutex> lock(snapshot_mutex_);
+        while (!snapshot_cv_.wait_for(
+            lock, interval, [this]() { return stopping_; })) {
+            lock.unlock();
+            if (!Save(path)) {
+                LOG_WARN("failed to write hot cell snapshot {}", path);
+            }
+            lock.lock();
+        }
+    });
+    LOG_INFO("hot cell snapshot {} every {}s", path, interval.count());
+}
+
+void
+HotCells::Stop() {
+    if (!snapshotter_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        stopping_ = true;
+    }
+    snapshot_cv_.notify_all();
+    snapshotter_.join();
+}
+
+std::shared_ptr<CellAccessCounts>
+HotCells::Register(const std::string& key, size_t num_cells) {
+    if (!IsEnabled()) {
+        return nullptr;
+    }
+    auto counts = std::make_shared<CellAccessCounts>(key, num_cells);
+    std::lock_guard<std::mutex> lock(mutex_);
+    registered_.emplace_back(counts);
+    return counts;
+}
+
+bool
+HotCells::Save(const std::string& path) {
+    // a key registered twice, by a reopened segment, sums its counts
+    std::map<std::pair<std::string, cachinglayer::cid_t>, int64_t> counts;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto live = registered_.begin();
+        for (auto& weak : registered_) {
+            auto slot_counts = weak.lock();
+            if (slot_counts == nullptr) {
+                continue;
+            }
+            for (size_t cid = 0; cid < slot_counts->num_cells(); ++cid) {
+                auto count = slot_counts->Halve(cid);
+                if (count > 0) {
+                    counts[{slot_counts->key(), cid}] += count;
+                }
+            }
+            *live++ = std::move(weak);
+        }
+        registered_.erase(live, registered_.end());
+    }
+
+    std::vector<std::tuple<int64_t, std::string, cachinglayer::cid_t>> cells;
+    cells.reserve(counts.size());
+    for (auto& [cell, count] : counts) {
+        cells.emplace_back(count, cell.first, cell.second);
+    }
+    std::stable_sort(
+        cells.begin(), cells.end(), [](const auto& a, const auto& b) {
+            return std::get<0>(a) > std::get<0>(b);
+        });
+    if (cells.size() > kMaxCells) {
+        cells.resize(kMaxCells);
+    }
+
+    auto tmp_path = path + ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::trunc);
+        out << kSnapshotHeader << '\n';
+        for (auto& [count, key, cid] : cells) {
+            out << count << ' ' << cid << ' ' << key << '\n';
+        }
+        out.flush();
+        if (!out) {
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+    }
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool
+HotCells::Load(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line) || line != kSnapshotHeader) {
+        return false;
+    }
+    std::unordered_map<std::string, std::vector<cachinglayer::cid_t>> warm;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        int64_t count;
+        cachinglayer::cid_t cid;
+        std::string key;
+        if (fields >> count >> cid >> key) {
+            warm[key].push_back(cid);
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    warm_ = std::move(warm);
+    return true;
+}
+
+std::vector<cachinglayer::cid_t>
+HotCells::TakeWarmCells(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = warm_.find(key);
+    if (it == warm_.end()) {
+        return {};
+    }
+    auto cids = std::move(it->second);
+    warm_.erase(it);
+    return cids;
+}
+
+void
+HotCells::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    registered_.clear();
+    warm_.clear();
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,203 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "cachinglayer/CacheSlot.h"
+#include "cachinglayer/Utils.h"
+#include "log/Log.h"
+#include "storage/ThreadPools.h"
+
+namespace milvus::segcore {
+
+// The pins of the cells of one cache slot, counted without a lock.
+class CellAccessCounts {
+ public:
+    CellAccessCounts(std::string key, size_t num_cells)
+        : key_(std::move(key)), counts_(num_cells) {
+    }
+
+    const std::string&
+    key() const {
+        return key_;
+    }
+
+    size_t
+    num_cells() const {
+        return counts_.size();
+    }
+
+    // a run of the same cell, as a gather pins it per row, counts once
+    void
+    Add(const std::vector<cachinglayer::cid_t>& cids) {
+        for (size_t i = 0; i < cids.size(); ++i) {
+            if ((i == 0 || cids[i] != cids[i - 1]) && cids[i] >= 0 &&
+                cids[i] < static_cast<cachinglayer::cid_t>(counts_.size())) {
+                counts_[cids[i]].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void
+    AddAll() {
+        for (auto& count : counts_) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    int64_t
+    Get(cachinglayer::cid_t cid) const {
+        return counts_[cid].load(std::memory_order_relaxed);
+    }
+
+    // halves the count of cid, returns the count before
+    int64_t
+    Halve(cachinglayer::cid_t cid) {
+        auto count = Get(cid);
+        counts_[cid].fetch_sub(count - count / 2, std::memory_order_relaxed);
+        return count;
+    }
+
+ private:
+    std::string key_;
+    std::vector<std::atomic<int64_t>> counts_;
+};
+
+/**
+ * The hot cell set of the caching layer, kept across restarts.
+ *
+ * The columns of sealed segments register their cache slot under the key
+ * of its translator, which names the segment and the field or column group
+ * and so stays the same when the segment is loaded again, and count the
+ * cells they pin. Every snapshot interval the counts are written to local
+ * disk, hottest cell first, and halved so a snapshot follows the recent
+ * traffic.
+ *
+ * A restarted node reads the snapshot of the previous process. A column
+ * registering a key of it prefetches its cells in the snapshot order on
+ * the LOW pool, so the cells the queries read most are cached first and
+ * the loads of the queries keep their priority.
+ */
+class HotCells {
+ public:
+    static HotCells&
+    Instance();
+
+    static void
+    SetEnabled(bool enabled);
+
+    static bool
+    IsEnabled();
+
+    // Reads the snapshot at path, if any, and writes it every interval.
+    // An empty path or interval stops the snapshots and the tracking.
+    void
+    Start(const std::string& path, std::chrono::seconds interval);
+
+    void
+    Stop();
+
+    // the counts of the cells of a slot, nullptr if tracking is off
+    std::shared_ptr<CellAccessCounts>
+    Register(const std::string& key, size_t num_cells);
+
+    // Writes the cells pinned since the last snapshot, hottest first, and
+    // halves their counts. The file at path is replaced at once, false if
+    // it could not be written.
+    bool
+    Save(const std::string& path);
+
+    // Reads a snapshot written by Save, false if there is none.
+    bool
+    Load(const std::string& path);
+
+    // the cells of key in the snapshot read, hottest first; a key is taken
+    // once
+    std::vector<cachinglayer::cid_t>
+    TakeWarmCells(const std::string& key);
+
+    void
+    Clear();
+
+    // a snapshot keeps no more cells
+    static constexpr size_t kMaxCells = 1 << 20;
+    // cells prefetched by one pin of a warm up
+    static constexpr size_t kWarmBatch = 8;
+
+ private:
+    HotCells() = default;
+    ~HotCells();
+
+    static std::atomic<bool> enabled_;
+
+    std::mutex mutex_;
+    std::vector<std::weak_ptr<CellAccessCounts>> registered_;
+    std::unordered_map<std::string, std::vector<cachinglayer::cid_t>> warm_;
+
+    std::mutex snapshot_mutex_;
+    std::condition_variable snapshot_cv_;
+    bool stopping_{false};
+    std::thread snapshotter_;
+};
+
+// Prefetches the cells the snapshot names for key on the LOW pool, in
+// batches of kWarmBatch. The warm up stops at the first batch the cache
+// does not take, or once the slot was released.
+template <typename CellT>
+void
+WarmUpHotCells(const std::string& key,
+               std::shared_ptr<cachinglayer::CacheSlot<CellT>> slot) {
+    auto cids = HotCells::Instance().TakeWarmCells(key);
+    if (cids.empty()) {
+        return;
+    }
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::LOW);
+    pool.Submit([key, slot = std::move(slot), cids = std::move(cids)]() {
+        for (size_t i = 0; i < cids.size(); i += HotCells::kWarmBatch) {
+            if (slot.use_count() == 1) {
+                return;
+            }
+            auto end = std::min(cids.size(), i + HotCells::kWarmBatch);
+            std::vector<cachinglayer::cid_t> batch(cids.begin() + i,
+                                                   cids.begin() + end);
+            try {
+                SemiInlineGet(slot->PinCells(nullptr, std::move(batch)));
+            } catch (std::exception& e) {
+                LOG_WARN("warm up of {} stopped at cell {} of {}: {}",
+                         key,
+                         i,
+                         cids.size(),
+                         e.what());
+                return;
+            }
+        }
+    });
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,103 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "segcore/HotCells.h"
+
+using milvus::cachinglayer::cid_t;
+using milvus::segcore::HotCells;
+
+class HotCellsTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        HotCells::Instance().Clear();
+        HotCells::SetEnabled(true);
+        path_ = (std::filesystem::temp_directory_path() / "hot_cells_test")
+                    .string();
+    }
+
+    void
+    TearDown() override {
+        HotCells::SetEnabled(false);
+        HotCells::Instance().Clear();
+        std::filesystem::remove(path_);
+    }
+
+    std::string path_;
+};
+
+TEST_F(HotCellsTest, SaveAndLoad) {
+    auto& hot_cells = HotCells::Instance();
+    auto a = hot_cells.Register("seg_1_f_100", 4);
+    auto b = hot_cells.Register("seg_2_cg_0", 2);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    a->Add({2, 2, 2, 0});
+    a->Add({2});
+    a->AddAll();
+    b->Add({1, 1, 1});
+    b->Add({1});
+    b->Add({1});
+    // out of range cells are not counted
+    a->Add({-1, 4});
+
+    ASSERT_TRUE(hot_cells.Save(path_));
+    // the counts are halved for the next snapshot
+    EXPECT_EQ(a->Get(2), 1);
+    EXPECT_EQ(a->Get(0), 1);
+    EXPECT_EQ(b->Get(0), 0);
+
+    hot_cells.Clear();
+    ASSERT_TRUE(hot_cells.Load(path_));
+    EXPECT_EQ(hot_cells.TakeWarmCells("seg_1_f_100"),
+              (std::vector<cid_t>{2, 0, 1, 3}));
+    EXPECT_EQ(hot_cells.TakeWarmCells("seg_2_cg_0"), (std::vector<cid_t>{1}));
+    // a key is warmed up once
+    EXPECT_TRUE(hot_cells.TakeWarmCells("seg_1_f_100").empty());
+    EXPECT_TRUE(hot_cells.TakeWarmCells("seg_3_f_100").empty());
+}
+
+TEST_F(HotCellsTest, ReleasedSlots) {
+    auto& hot_cells = HotCells::Instance();
+    auto released = hot_cells.Register("seg_1_f_100", 1);
+    released->AddAll();
+    released.reset();
+    auto reopened = hot_cells.Register("seg_2_f_100", 1);
+    reopened->AddAll();
+    ASSERT_TRUE(hot_cells.Save(path_));
+
+    ASSERT_TRUE(hot_cells.Load(path_));
+    EXPECT_TRUE(hot_cells.TakeWarmCells("seg_1_f_100").empty());
+    EXPECT_EQ(hot_cells.TakeWarmCells("seg_2_f_100"),
+              (std::vector<cid_t>{0}));
+}
+
+TEST_F(HotCellsTest, Disabled) {
+    HotCells::SetEnabled(false);
+    EXPECT_EQ(HotCells::Instance().Register("seg_1_f_100", 1), nullptr);
+}
+
+TEST_F(HotCellsTest, NoSnapshot) {
+    auto& hot_cells = HotCells::Instance();
+    EXPECT_FALSE(hot_cells.Load(path_));
+    std::ofstream(path_) << "not a snapshot\n";
+    EXPECT_FALSE(hot_cells.Load(path_));
+}
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "IndexConfigGenerator.h"
+#include "common/Consts.h"
 #include "knowhere/comp/index_param.h"
 #include "log/Log.h"
 
@@ -21,7 +22,8 @@ VecIndexConfig::VecIndexConfig(const int64_t max_index_row_cout,
                                const bool is_sparse)
     : max_index_row_count_(max_index_row_cout),
       config_(config),
-      is_sparse_(is_sparse) {
+      is_sparse_(is_sparse),
+      tuner_(config.get_nlist(), config.get_nprobe()) {
     origin_index_type_ = index_meta_.GetIndexType();
     metric_type_ = index_meta_.GeMetricType();
     // For Dense vector, use IVFFLAT_CC/SCANN_with_data_view_refiner(DVR) as the growing and temp index type.
@@ -139,7 +141,26 @@ VecIndexConfig::GetSearchConf(const SearchInfo& searchInfo) {
         searchParam.search_params_[knowhere::meta::BM25_AVGDL] =
             searchInfo.search_params_[knowhere::meta::BM25_AVGDL];
     }
+
+    auto recall_target = GetRecallTarget(searchInfo);
+    if (recall_target.has_value() && !is_sparse_) {
+        searchParam.search_params_[knowhere::indexparam::NPROBE] =
+            std::to_string(tuner_.Pick(recall_target.value()));
+    }
     return searchParam;
 }
 
+std::optional<double>
+VecIndexConfig::GetRecallTarget(const SearchInfo& searchInfo) {
+    auto it = searchInfo.search_params_.find(RECALL_TARGET);
+    if (it == searchInfo.search_params_.end() || !it->is_number()) {
+        return std::nullopt;
+    }
+    auto target = it->get<double>();
+    if (target <= 0 || target > 1) {
+        return std::nullopt;
+    }
+    return target;
+}
+
 }  // namespace milvus::segcore
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "SegcoreConfig.h"
 #include "common/QueryInfo.h"
 #include "common/type_c.h"
+#include "segcore/RecallTuner.h"
 
 namespace milvus::segcore {
 
@@ -52,9 +53,20 @@ class VecIndexConfig {
     knowhere::Json
     GetBuildBaseParams(DataType data_type);
 
+    // with a recall target in searchInfo, the nprobe is the one the recall
+    // tuner picks for it
     SearchInfo
     GetSearchConf(const SearchInfo& searchInfo);
 
+    RecallTuner&
+    GetRecallTuner() noexcept {
+        return tuner_;
+    }
+
+    // the recall_target search param, nullopt without one in (0, 1]
+    static std::optional<double>
+    GetRecallTarget(const SearchInfo& searchInfo);
+
  private:
     const SegcoreConfig& config_;
 
@@ -71,5 +83,7 @@ class VecIndexConfig {
     knowhere::Json build_params_;
 
     knowhere::Json search_params_;
+
+    RecallTuner tuner_;
 };
 }  // namespace milvus::segcore
\ No newline at end of file
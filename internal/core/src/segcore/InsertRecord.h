@@ -13,6 +13,8 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -23,12 +25,15 @@
 
 #include "TimestampIndex.h"
 #include "common/EasyAssert.h"
+#include "common/PackedIntegers.h"
 #include "common/Schema.h"
 #include "common/TrackingStdAllocator.h"
 #include "common/Types.h"
 #include "mmap/ChunkedColumn.h"
 #include "segcore/AckResponder.h"
+#include "segcore/ConcurrentBTree.h"
 #include "segcore/ConcurrentVector.h"
+#include "segcore/EytzingerIndex.h"
 #include <type_traits>
 
 namespace milvus::segcore {
@@ -51,6 +56,17 @@ class OffsetMap {
     virtual std::vector<int64_t>
     find(const PkType& pk) const = 0;
 
+    // calls fn(i, offset) for every offset of pks[i], in the order of pks
+    virtual void
+    find_batch(const std::vector<PkType>& pks,
+               const std::function<void(size_t, int64_t)>& fn) const {
+        for (size_t i = 0; i < pks.size(); ++i) {
+            for (auto offset : find(pks[i])) {
+                fn(i, offset);
+            }
+        }
+    }
+
     virtual void
     find_range(const PkType& pk,
                proto::plan::OpType op,
@@ -60,6 +76,14 @@ class OffsetMap {
     virtual void
     insert(const PkType& pk, int64_t offset) = 0;
 
+    // inserts offset for pk and returns the offsets pk had before
+    virtual std::vector<int64_t>
+    find_and_insert(const PkType& pk, int64_t offset) {
+        auto offsets = find(pk);
+        insert(pk, offset);
+        return offsets;
+    }
+
     virtual void
     seal() = 0;
 
@@ -169,6 +193,16 @@ class OffsetOrderedMap : public OffsetMap {
         map_[std::get<T>(pk)].emplace_back(offset);
     }
 
+    std::vector<int64_t>
+    find_and_insert(const PkType& pk, int64_t offset) override {
+        std::unique_lock<std::shared_mutex> lck(mtx_);
+
+        auto& offsets = map_[std::get<T>(pk)];
+        std::vector<int64_t> former(offsets.begin(), offsets.end());
+        offsets.emplace_back(offset);
+        return former;
+    }
+
     void
     seal() override {
         ThrowInfo(
@@ -244,18 +278,187 @@ class OffsetOrderedMap : public OffsetMap {
     mutable std::shared_mutex mtx_;
 };
 
+// Growing segment index of int64 pks, keyed by (pk, offset) in a
+// ConcurrentBTree so inserts and lookups never wait on each other. An entry
+// takes 16 bytes in the leaves, the offsets of a pk are in ascending order.
+class OffsetBTreeMap : public OffsetMap {
+ public:
+    bool
+    contain(const PkType& pk) const override {
+        auto target = std::get<int64_t>(pk);
+        bool found = false;
+        tree_.Scan(Entry::First(target), [&](const Entry& entry) {
+            found = entry.pk == target;
+            return false;
+        });
+        return found;
+    }
+
+    std::vector<int64_t>
+    find(const PkType& pk) const override {
+        auto target = std::get<int64_t>(pk);
+        std::vector<int64_t> offset_vector;
+        tree_.Scan(Entry::First(target), [&](const Entry& entry) {
+            if (entry.pk != target) {
+                return false;
+            }
+            offset_vector.push_back(entry.offset);
+            return true;
+        });
+        return offset_vector;
+    }
+
+    void
+    find_range(const PkType& pk,
+               proto::plan::OpType op,
+               BitsetTypeView& bitset,
+               Condition condition) const override {
+        auto target = std::get<int64_t>(pk);
+        auto from = Entry::First(std::numeric_limits<int64_t>::min());
+        if (op == proto::plan::OpType::Equal ||
+            op == proto::plan::OpType::GreaterEqual) {
+            from = Entry::First(target);
+        } else if (op == proto::plan::OpType::GreaterThan) {
+            from = Entry::Last(target);
+        } else if (op != proto::plan::OpType::LessEqual &&
+                   op != proto::plan::OpType::LessThan) {
+            ThrowInfo(ErrorCode::Unsupported,
+                      fmt::format("unsupported op type {}", op));
+        }
+        // whether the entries from pk on are past the range
+        auto past = [op, target](int64_t pk) {
+            switch (op) {
+                case proto::plan::OpType::Equal:
+                    return pk != target;
+                case proto::plan::OpType::LessEqual:
+                    return pk > target;
+                case proto::plan::OpType::LessThan:
+                    return pk >= target;
+                default:
+                    return false;
+            }
+        };
+        tree_.Scan(from, [&](const Entry& entry) {
+            if (past(entry.pk)) {
+                return false;
+            }
+            if (condition(entry.offset) && entry.offset < bitset.size()) {
+                bitset[entry.offset] = true;
+            }
+            return true;
+        });
+    }
+
+    void
+    insert(const PkType& pk, int64_t offset) override {
+        tree_.Insert(Entry{std::get<int64_t>(pk), offset});
+    }
+
+    void
+    seal() override {
+        ThrowInfo(
+            NotImplemented,
+            "OffsetBTreeMap used for growing segment could not be sealed.");
+    }
+
+    bool
+    empty() const override {
+        return tree_.Empty();
+    }
+
+    std::pair<std::vector<OffsetMap::OffsetType>, bool>
+    find_first(int64_t limit, const BitsetTypeView& bitset) const override {
+        if (limit == Unlimited || limit == NoLimit) {
+            limit = tree_.Size();
+        }
+        int64_t hit_num = 0;
+        auto size = bitset.size();
+        int64_t cnt = size - bitset.count();
+        limit = std::min(limit, cnt);
+        std::vector<int64_t> seg_offsets;
+        seg_offsets.reserve(limit);
+
+        // the offsets of one pk, the latest one not filtered out is taken
+        std::vector<int64_t> offsets;
+        bool has_more = false;
+        auto take_latest = [&]() {
+            for (auto it = offsets.rbegin(); it != offsets.rend(); ++it) {
+                auto seg_offset = *it;
+                if (seg_offset >= size) {
+                    // Frequently concurrent insert/query will cause this case.
+                    continue;
+                }
+                if (!bitset[seg_offset]) {
+                    seg_offsets.push_back(seg_offset);
+                    hit_num++;
+                    break;
+                }
+            }
+            offsets.clear();
+        };
+        int64_t current_pk = 0;
+        tree_.Scan(Entry::First(std::numeric_limits<int64_t>::min()),
+                   [&](const Entry& entry) {
+                       if (offsets.empty() || entry.pk != current_pk) {
+                           if (!offsets.empty()) {
+                               take_latest();
+                           }
+                           if (hit_num >= limit) {
+                               has_more = true;
+                               return false;
+                           }
+                           current_pk = entry.pk;
+                       }
+                       offsets.push_back(entry.offset);
+                       return true;
+                   });
+        if (!offsets.empty()) {
+            take_latest();
+        }
+        return {seg_offsets, has_more};
+    }
+
+    void
+    clear() override {
+        tree_.Clear();
+    }
+
+    size_t
+    memory_size() const override {
+        return tree_.MemorySize();
+    }
+
+ private:
+    struct Entry {
+        int64_t pk;
+        int64_t offset;
+
+        static Entry
+        First(int64_t pk) {
+            return {pk, std::numeric_limits<int64_t>::min()};
+        }
+
+        static Entry
+        Last(int64_t pk) {
+            return {pk, std::numeric_limits<int64_t>::max()};
+        }
+
+        bool
+        operator<(const Entry& other) const {
+            return pk < other.pk || (pk == other.pk && offset < other.offset);
+        }
+    };
+
+    ConcurrentBTree<Entry> tree_;
+};
+
 template <typename T>
 class OffsetOrderedArray : public OffsetMap {
  public:
     bool
     contain(const PkType& pk) const override {
         const T& target = std::get<T>(pk);
-        auto it =
-            std::lower_bound(array_.begin(),
-                             array_.end(),
-                             target,
-                             [](const std::pair<T, int64_t>& elem,
-                                const T& value) { return elem.first < value; });
+        auto it = lower_bound(target);
 
         return it != array_.end() && it->first == target;
     }
@@ -265,12 +468,7 @@ class OffsetOrderedArray : public OffsetMap {
         check_search();
 
         const T& target = std::get<T>(pk);
-        auto it =
-            std::lower_bound(array_.begin(),
-                             array_.end(),
-                             target,
-                             [](const std::pair<T, int64_t>& elem,
-                                const T& value) { return elem.first < value; });
+        auto it = lower_bound(target);
 
         std::vector<int64_t> offset_vector;
         for (; it != array_.end() && it->first == target; ++it) {
@@ -280,16 +478,51 @@ class OffsetOrderedArray : public OffsetMap {
         return offset_vector;
     }
 
+    void
+    find_batch(const std::vector<PkType>& pks,
+               const std::function<void(size_t, int64_t)>& fn) const override {
+        check_search();
+        if constexpr (!std::is_same_v<T, int64_t>) {
+            OffsetMap::find_batch(pks, fn);
+        } else {
+            std::vector<int64_t> targets;
+            targets.reserve(pks.size());
+            for (const auto& pk : pks) {
+                targets.push_back(std::get<int64_t>(pk));
+            }
+            auto block_begin = [this](size_t begin) {
+                return array_.begin() + begin;
+            };
+            index_.BlockBatch(
+                targets.data(),
+                targets.size(),
+                [this](size_t begin) {
+                    // a block of pairs spans four cache lines
+                    auto block = array_.data() + begin;
+                    for (size_t i = 0; i < EytzingerIndex::kBlockSize;
+                         i += 4) {
+                        __builtin_prefetch(block + i);
+                    }
+                },
+                [&](size_t i, size_t begin, size_t end) {
+                    auto target = targets[i];
+                    auto it = std::lower_bound(block_begin(begin),
+                                               block_begin(end),
+                                               target,
+                                               lower_bound_comp);
+                    for (; it != array_.end() && it->first == target; ++it) {
+                        fn(i, it->second);
+                    }
+                });
+        }
+    }
+
     void
     find_range(const PkType& pk,
                proto::plan::OpType op,
                BitsetTypeView& bitset,
                Condition condition) const override {
         check_search();
-        auto lower_bound_comp = [](const std::pair<T, int64_t>& elem,
-                                   const T& value) {
-            return elem.first < value;
-        };
         auto upper_bound_comp = [](const T& value,
                                    const std::pair<T, int64_t>& elem) {
             return value < elem.first;
@@ -297,16 +530,14 @@ class OffsetOrderedArray : public OffsetMap {
 
         const T& target = std::get<T>(pk);
         if (op == proto::plan::OpType::Equal) {
-            auto it = std::lower_bound(
-                array_.begin(), array_.end(), target, lower_bound_comp);
+            auto it = lower_bound(target);
             for (; it != array_.end() && it->first == target; ++it) {
                 if (condition(it->second)) {
                     bitset[it->second] = true;
                 }
             }
         } else if (op == proto::plan::OpType::GreaterEqual) {
-            auto it = std::lower_bound(
-                array_.begin(), array_.end(), target, lower_bound_comp);
+            auto it = lower_bound(target);
             for (; it < array_.end(); ++it) {
                 if (condition(it->second)) {
                     bitset[it->second] = true;
@@ -329,8 +560,7 @@ class OffsetOrderedArray : public OffsetMap {
                 }
             }
         } else if (op == proto::plan::OpType::LessThan) {
-            auto it = std::lower_bound(
-                array_.begin(), array_.end(), target, lower_bound_comp);
+            auto it = lower_bound(target);
             for (auto ptr = array_.begin(); ptr < it; ++ptr) {
                 if (condition(ptr->second)) {
                     bitset[ptr->second] = true;
@@ -355,6 +585,10 @@ class OffsetOrderedArray : public OffsetMap {
     void
     seal() override {
         sort(array_.begin(), array_.end());
+        if constexpr (std::is_same_v<T, int64_t>) {
+            index_.Build(array_.size(),
+                         [this](size_t i) { return array_[i].first; });
+        }
         is_sealed = true;
     }
 
@@ -379,15 +613,38 @@ class OffsetOrderedArray : public OffsetMap {
     void
     clear() override {
         array_.clear();
+        index_.clear();
         is_sealed = false;
     }
 
     size_t
     memory_size() const override {
-        return sizeof(std::pair<T, int32_t>) * array_.capacity();
+        return sizeof(std::pair<T, int32_t>) * array_.capacity() +
+               index_.memory_size();
     }
 
  private:
+    static bool
+    lower_bound_comp(const std::pair<T, int32_t>& elem, const T& value) {
+        return elem.first < value;
+    }
+
+    // the first element not less than target, through the index once sealed
+    typename std::vector<std::pair<T, int32_t>>::const_iterator
+    lower_bound(const T& target) const {
+        if constexpr (std::is_same_v<T, int64_t>) {
+            if (is_sealed) {
+                auto [begin, end] = index_.Block(target);
+                return std::lower_bound(array_.begin() + begin,
+                                        array_.begin() + end,
+                                        target,
+                                        lower_bound_comp);
+            }
+        }
+        return std::lower_bound(
+            array_.begin(), array_.end(), target, lower_bound_comp);
+    }
+
     std::pair<std::vector<OffsetMap::OffsetType>, bool>
     find_first_by_index(int64_t limit, const BitsetTypeView& bitset) const {
         int64_t hit_num = 0;  // avoid counting the number everytime.
@@ -422,6 +679,8 @@ class OffsetOrderedArray : public OffsetMap {
  private:
     bool is_sealed = false;
     std::vector<std::pair<T, int32_t>> array_;
+    // int64 pks only, built on seal
+    EytzingerIndex index_;
 };
 
 class InsertRecordSealed {
@@ -430,8 +689,7 @@ class InsertRecordSealed {
                        const int64_t size_per_chunk,
                        const storage::MmapChunkDescriptorPtr
                        /* mmap_descriptor */
-                       = nullptr)
-        : timestamps_(size_per_chunk) {
+                       = nullptr) {
         std::optional<FieldId> pk_field_id = schema.get_primary_field_id();
         // for sealed segment, only pk field is added.
         for (auto& field : schema) {
@@ -495,6 +753,26 @@ class InsertRecordSealed {
         return res_offsets;
     }
 
+    // search_pk for every pks[i] against get_timestamp(i), callback gets the
+    // hits with that timestamp; the lookups are batched so their cache misses
+    // overlap
+    void
+    search_pks_batch(
+        const std::vector<PkType>& pks,
+        const std::function<Timestamp(size_t)>& get_timestamp,
+        bool include_same_ts,
+        const std::function<void(SegOffset offset, Timestamp ts)>& callback)
+        const {
+        std::shared_lock lck(shared_mutex_);
+        pk2offset_->find_batch(pks, [&](size_t i, int64_t offset) {
+            auto timestamp = get_timestamp(i);
+            auto ts = timestamps_[offset];
+            if (include_same_ts ? ts <= timestamp : ts < timestamp) {
+                callback(SegOffset(offset), timestamp);
+            }
+        });
+    }
+
     void
     search_pk_range(const PkType& pk,
                     proto::plan::OpType op,
@@ -600,25 +878,23 @@ class InsertRecordSealed {
     init_timestamps(const std::vector<Timestamp>& timestamps,
                     const TimestampIndex& timestamp_index) {
         std::lock_guard lck(shared_mutex_);
-        timestamps_.set_data_raw(0, timestamps.data(), timestamps.size());
+        timestamps_ = PackedIntegers(timestamps.data(), timestamps.size());
         timestamp_index_ = std::move(timestamp_index);
-        AssertInfo(timestamps_.num_chunk() == 1,
-                   "num chunk not equal to 1 for sealed segment");
-        size_t memory_size = timestamps.size() * sizeof(Timestamp) +
-                             timestamp_index_.memory_size();
+        size_t memory_size =
+            timestamps_.memory_size() + timestamp_index_.memory_size();
         cachinglayer::Manager::GetInstance().ChargeLoadedResource(
             {static_cast<int64_t>(memory_size), 0});
         estimated_memory_size_ += memory_size;
     }
 
-    const ConcurrentVector<Timestamp>&
+    const PackedIntegers&
     timestamps() const {
         return timestamps_;
     }
 
     void
     clear() {
-        timestamps_.clear();
+        timestamps_ = PackedIntegers();
         timestamp_index_ = TimestampIndex();
         if (pk2offset_) {
             pk2offset_->clear();
@@ -633,7 +909,9 @@ class InsertRecordSealed {
     }
 
  public:
-    ConcurrentVector<Timestamp> timestamps_;
+    // the timestamps of a sealed segment are written once, and mostly repeat
+    // or differ little between neighbouring rows, so they are kept packed
+    PackedIntegers timestamps_;
     std::atomic<int64_t> reserved = 0;
     // used for timestamps index of sealed segment
     TimestampIndex timestamp_index_;
@@ -662,8 +940,7 @@ class InsertRecordGrowing {
                            "Primary key should not be nullable");
                 switch (field_meta.get_data_type()) {
                     case DataType::INT64: {
-                        pk2offset_ =
-                            std::make_unique<OffsetOrderedMap<int64_t>>();
+                        pk2offset_ = std::make_unique<OffsetBTreeMap>();
                         break;
                     }
                     case DataType::VARCHAR: {
@@ -692,7 +969,7 @@ class InsertRecordGrowing {
     search_pk(const PkType& pk,
               Timestamp timestamp,
               bool include_same_ts = true) const {
-        std::shared_lock<std::shared_mutex> lck(shared_mutex_);
+        // pk2offset_ synchronizes itself, no need to wait for inserts
         std::vector<SegOffset> res_offsets;
         auto offset_iter = pk2offset_->find(pk);
         auto timestamp_hit =
@@ -948,10 +1225,15 @@ class InsertRecordGrowing {
 
     void
     insert_pk(const PkType& pk, int64_t offset) {
-        std::lock_guard lck(shared_mutex_);
         pk2offset_->insert(pk, offset);
     }
 
+    // inserts offset for pk and returns the offsets pk had before
+    std::vector<int64_t>
+    find_and_insert_pk(const PkType& pk, int64_t offset) {
+        return pk2offset_->find_and_insert(pk, offset);
+    }
+
     // get data without knowing the type
     VectorBase*
     get_data_base(FieldId field_id) const {
@@ -138,5 +138,36 @@ TYPED_TEST_P(TypedOffsetOrderedArrayTest, find_first) {
     }
 }
 
-REGISTER_TYPED_TEST_SUITE_P(TypedOffsetOrderedArrayTest, find_first);
+TYPED_TEST_P(TypedOffsetOrderedArrayTest, find_batch) {
+    // enough pks for several levels of the int64 index, with duplicates
+    int num = 1000;
+    auto data = this->random_generate(num / 2);
+    for (int i = 0; i < num; i++) {
+        this->insert(data[i % data.size()]);
+    }
+    this->seal();
+
+    std::vector<PkType> pks;
+    auto missing = this->random_generate(10);
+    for (const auto& x : missing) {
+        pks.push_back(x);
+    }
+    for (const auto& x : this->data_) {
+        pks.push_back(x);
+    }
+
+    std::vector<std::vector<int64_t>> offsets(pks.size());
+    this->map_.find_batch(pks, [&](size_t i, int64_t offset) {
+        offsets[i].push_back(offset);
+    });
+    for (size_t i = 0; i < pks.size(); i++) {
+        auto expected = this->map_.find(pks[i]);
+        ASSERT_EQ(expected, offsets[i]) << i;
+        ASSERT_EQ(!expected.empty(), this->map_.contain(pks[i]));
+    }
+}
+
+REGISTER_TYPED_TEST_SUITE_P(TypedOffsetOrderedArrayTest,
+                            find_first,
+                            find_batch);
 INSTANTIATE_TYPED_TEST_SUITE_P(Prefix, TypedOffsetOrderedArrayTest, TypeOfPks);
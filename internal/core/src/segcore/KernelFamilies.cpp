@@ -0,0 +1,158 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/KernelFamilies.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bitset/detail/platform/dynamic.h"
+#include "common/HalfFloat.h"
+#include "common/HalfFloatKernels.h"
+#include "common/Int8Distance.h"
+#include "common/Int8DistanceKernels.h"
+#include "common/Types.h"
+#include "minhash/MinHashHook.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the workloads are sized to take about a millisecond per run
+constexpr int64_t kDim = 256;
+constexpr int64_t kNumVectors = 512;
+constexpr int64_t kNumQueries = 4;
+constexpr size_t kNumValues = 1 << 16;
+constexpr size_t kNumShingles = 1 << 12;
+
+template <typename Kernels>
+std::vector<std::string>
+KernelNames(const std::vector<Kernels>& kernels) {
+    std::vector<std::string> names;
+    for (const auto& k : kernels) {
+        names.emplace_back(k.name);
+    }
+    return names;
+}
+
+void
+BitsetWorkload() {
+    static const auto values = [] {
+        std::vector<float> values(kNumValues);
+        for (size_t i = 0; i < kNumValues; ++i) {
+            values[i] = static_cast<float>(i % 1000);
+        }
+        return values;
+    }();
+    TargetBitmap bits(kNumValues);
+    for (int i = 0; i < 16; ++i) {
+        bits.inplace_compare_val<float>(values.data(),
+                                        kNumValues,
+                                        static_cast<float>(i * 60),
+                                        bitset::CompareOpType::LT);
+    }
+}
+
+void
+MinHashWorkload() {
+    static const auto shingles = [] {
+        std::vector<uint64_t> shingles(kNumShingles);
+        for (size_t i = 0; i < kNumShingles; ++i) {
+            shingles[i] = i * 0x9E3779B97F4A7C15ull;
+        }
+        return shingles;
+    }();
+    uint64_t perm_a[8], perm_b[8];
+    for (int k = 0; k < 8; ++k) {
+        perm_a[k] = 2 * k + 1;
+        perm_b[k] = k;
+    }
+    uint32_t sig[8];
+    for (int i = 0; i < 16; ++i) {
+        minhash::linear_and_find_min_batch8_impl(
+            shingles.data(), kNumShingles, perm_a, perm_b, sig);
+    }
+}
+
+void
+Int8DistanceWorkload() {
+    static const auto vectors = [] {
+        std::vector<int8_t> vectors(kNumVectors * kDim);
+        for (size_t i = 0; i < vectors.size(); ++i) {
+            vectors[i] = static_cast<int8_t>(i * 7);
+        }
+        return vectors;
+    }();
+    int32_t dots[kNumQueries];
+    for (int64_t v = 0; v < kNumVectors; ++v) {
+        Int8Dots(vectors.data(),
+                 kNumQueries,
+                 vectors.data() + v * kDim,
+                 kDim,
+                 dots);
+    }
+}
+
+void
+HalfFloatWorkload() {
+    static const auto vectors = [] {
+        std::vector<float> values(kNumVectors * kDim);
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<float>(i % 97) / 97;
+        }
+        std::vector<float16> vectors(values.size());
+        FloatToHalf(values.data(), vectors.data(), values.size());
+        return vectors;
+    }();
+    static const std::vector<float> queries(kNumQueries * kDim, 0.5f);
+    float dots[kNumQueries];
+    for (int64_t v = 0; v < kNumVectors; ++v) {
+        HalfDots(queries.data(),
+                 kNumQueries,
+                 vectors.data() + v * kDim,
+                 kDim,
+                 dots);
+    }
+}
+
+}  // namespace
+
+void
+RegisterKernelFamilies(KernelRegistry& registry) {
+    // only the x86 bitset hooks have a choice
+    auto bitset_sets = bitset::detail::dynamic_instruction_sets();
+    if (!bitset_sets.empty()) {
+        registry.Register({"bitset",
+                           std::move(bitset_sets),
+                           bitset::detail::set_dynamic_instruction_set,
+                           BitsetWorkload});
+    }
+    registry.Register({"minhash",
+                       minhash::minhash_instruction_sets(),
+                       minhash::minhash_hook_set,
+                       MinHashWorkload});
+    registry.Register({"int8_distance",
+                       KernelNames(int8_distance::SupportedKernels()),
+                       int8_distance::SelectKernels,
+                       Int8DistanceWorkload});
+    registry.Register({"half_float",
+                       KernelNames(half_float::SupportedKernels()),
+                       half_float::SelectKernels,
+                       HalfFloatWorkload});
+}
+
+}  // namespace milvus::segcore
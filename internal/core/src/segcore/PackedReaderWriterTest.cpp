@@ -16,6 +16,7 @@
 
 #include <gtest/gtest.h>
 #include "milvus-storage/common/constants.h"
+#include "common/Common.h"
 #include "segcore/packed_writer_c.h"
 #include "segcore/packed_reader_c.h"
 #include "segcore/arrow_fs_c.h"
@@ -102,5 +103,120 @@ TEST(CPackedTest, PackedWriterAndReader) {
 
     c_status = CloseReader(c_packed_reader);
     EXPECT_EQ(c_status.error_code, 0);
+
+    struct ArrowSchema c_take_schema;
+    ASSERT_TRUE(arrow::ExportSchema(*schema, &c_take_schema).ok());
+    int64_t offsets[] = {4, 1, 1};
+    CArrowArray c_out_array = nullptr;
+    CArrowSchema c_out_schema = nullptr;
+    c_status = TakePackedRows(paths,
+                              1,
+                              &c_take_schema,
+                              offsets,
+                              3,
+                              &c_out_array,
+                              &c_out_schema,
+                              nullptr);
+    EXPECT_EQ(c_status.error_code, 0);
+    auto out_array = static_cast<struct ArrowArray*>(c_out_array);
+    auto out_schema = static_cast<struct ArrowSchema*>(c_out_schema);
+    auto taken = arrow::ImportRecordBatch(out_array, out_schema).ValueOrDie();
+    ASSERT_EQ(taken->num_rows(), 3);
+    auto values =
+        std::static_pointer_cast<arrow::Int64Array>(taken->column(0));
+    EXPECT_EQ(values->Value(0), 4);
+    EXPECT_EQ(values->Value(1), 1);
+    EXPECT_EQ(values->Value(2), 1);
+    delete out_array;
+    delete out_schema;
+    FreeCColumnSplits(cgs);
+}
+
+TEST(CPackedTest, AsyncPackedWriter) {
+    auto schema = arrow::schema(
+        {arrow::field("int64",
+                      arrow::int64(),
+                      false,
+                      arrow::key_value_metadata(
+                          {milvus_storage::ARROW_FIELD_ID_KEY}, {"100"}))});
+
+    // a budget below a batch, each write waits for the previous one
+    milvus::SetDefaultPackedWriterAsyncMemoryLimit(1);
+
+    const int64_t buffer_size = 10 * 1024 * 1024;
+    char* path = const_cast<char*>("/tmp");
+    char* paths[] = {const_cast<char*>("/tmp/async_0")};
+
+    CColumnSplits cgs = NewCColumnSplits();
+    int group[] = {0};
+    AddCColumnSplit(cgs, group, 1);
+
+    auto c_status = InitLocalArrowFileSystemSingleton(path);
+    EXPECT_EQ(c_status.error_code, 0);
+    struct ArrowSchema c_write_schema;
+    ASSERT_TRUE(arrow::ExportSchema(*schema, &c_write_schema).ok());
+    CPackedWriter c_packed_writer = nullptr;
+    c_status = NewPackedWriter(&c_write_schema,
+                               buffer_size,
+                               paths,
+                               1,
+                               0,
+                               cgs,
+                               &c_packed_writer,
+                               nullptr);
+    EXPECT_EQ(c_status.error_code, 0);
+
+    const int num_batches = 10;
+    const int batch_rows = 5;
+    for (int b = 0; b < num_batches; ++b) {
+        std::vector<int64_t> data(batch_rows);
+        std::iota(data.begin(), data.end(), b * batch_rows);
+        arrow::Int64Builder builder;
+        ASSERT_TRUE(builder.AppendValues(data.begin(), data.end()).ok());
+        auto array = builder.Finish().ValueOrDie();
+        auto batch = arrow::RecordBatch::Make(schema, batch_rows, {array});
+
+        struct ArrowArray carray;
+        struct ArrowSchema cschema;
+        ASSERT_TRUE(arrow::ExportRecordBatch(*batch, &carray, &cschema).ok());
+        struct ArrowSchema c_origin_schema;
+        ASSERT_TRUE(arrow::ExportSchema(*schema, &c_origin_schema).ok());
+        struct ArrowArray arrays[] = {carray};
+        struct ArrowSchema array_schemas[] = {cschema};
+        c_status = WriteRecordBatch(
+            c_packed_writer, arrays, array_schemas, &c_origin_schema);
+        EXPECT_EQ(c_status.error_code, 0);
+    }
+    c_status = CloseWriter(c_packed_writer);
+    EXPECT_EQ(c_status.error_code, 0);
+    milvus::SetDefaultPackedWriterAsyncMemoryLimit(
+        DEFAULT_PACKED_WRITER_ASYNC_MEMORY_LIMIT);
+
+    // the batches are written in order
+    struct ArrowSchema c_take_schema;
+    ASSERT_TRUE(arrow::ExportSchema(*schema, &c_take_schema).ok());
+    int64_t offsets[] = {0, 23, 49};
+    CArrowArray c_out_array = nullptr;
+    CArrowSchema c_out_schema = nullptr;
+    c_status = TakePackedRows(paths,
+                              1,
+                              &c_take_schema,
+                              offsets,
+                              3,
+                              &c_out_array,
+                              &c_out_schema,
+                              nullptr);
+    EXPECT_EQ(c_status.error_code, 0);
+    auto out_array = static_cast<struct ArrowArray*>(c_out_array);
+    auto out_schema = static_cast<struct ArrowSchema*>(c_out_schema);
+    auto taken = arrow::ImportRecordBatch(out_array, out_schema).ValueOrDie();
+    ASSERT_EQ(taken->num_rows(), 3);
+    auto values =
+        std::static_pointer_cast<arrow::Int64Array>(taken->column(0));
+    EXPECT_EQ(values->Value(0), 0);
+    EXPECT_EQ(values->Value(1), 23);
+    EXPECT_EQ(values->Value(2), 49);
+    delete out_array;
+    delete out_schema;
     FreeCColumnSplits(cgs);
 }
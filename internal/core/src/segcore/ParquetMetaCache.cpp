@@ -0,0 +1,147 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/ParquetMetaCache.h"
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "milvus-storage/common/constants.h"
+#include "milvus-storage/format/parquet/file_reader.h"
+#include "monitor/Monitor.h"
+#include "storage/KeyRetriever.h"
+
+namespace milvus::segcore {
+
+ParquetMetaCache&
+ParquetMetaCache::Instance() {
+    static ParquetMetaCache instance;
+    return instance;
+}
+
+void
+ParquetMetaCache::SetCapacityBytes(size_t capacity_bytes) {
+    capacity_bytes_.store(capacity_bytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (current_bytes_.load() > capacity_bytes && !lru_.empty()) {
+        EraseLocked(entries_.find(lru_.front()));
+        monitor::internal_core_parquet_meta_cache_eviction.Increment();
+    }
+    monitor::internal_core_parquet_meta_cache_bytes_all.Set(
+        current_bytes_.load());
+    LOG_INFO("set parquet meta cache capacity: {} bytes", capacity_bytes);
+}
+
+size_t
+ParquetMetaCache::GetCapacityBytes() const {
+    return capacity_bytes_.load();
+}
+
+size_t
+ParquetMetaCache::GetCurrentBytes() const {
+    return current_bytes_.load();
+}
+
+size_t
+ParquetMetaCache::GetEntryCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::shared_ptr<const ParquetFileMeta>
+ParquetMetaCache::Get(const milvus_storage::ArrowFileSystemPtr& fs,
+                      const std::string& path) {
+    return Get(path, [&]() {
+        auto result = milvus_storage::FileRowGroupReader::Make(
+            fs,
+            path,
+            milvus_storage::DEFAULT_READ_BUFFER_SIZE,
+            storage::GetReaderProperties());
+        AssertInfo(result.ok(),
+                   "[StorageV2] Failed to create file row group reader: " +
+                       result.status().ToString());
+        auto reader = result.ValueOrDie();
+        ParquetFileMeta meta;
+        meta.parquet_metadata = reader->file_metadata()->GetParquetMetadata();
+        meta.field_id_mapping = reader->file_metadata()->GetFieldIDMapping();
+        meta.row_group_metas =
+            reader->file_metadata()->GetRowGroupMetadataVector();
+        meta.bytes = meta.parquet_metadata->size() +
+                     meta.row_group_metas.size() * kRowGroupMetaBytes;
+        auto status = reader->Close();
+        AssertInfo(status.ok(),
+                   "[StorageV2] failed to close file reader when get row "
+                   "group metadata from file {} with error {}",
+                   path,
+                   status.ToString());
+        return meta;
+    });
+}
+
+std::shared_ptr<const ParquetFileMeta>
+ParquetMetaCache::Get(const std::string& path,
+                      const std::function<ParquetFileMeta()>& load) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {
+            lru_.splice(lru_.end(), lru_, it->second.lru_it);
+            monitor::internal_core_parquet_meta_cache_hit.Increment();
+            return it->second.meta;
+        }
+    }
+    monitor::internal_core_parquet_meta_cache_miss.Increment();
+    // read without the lock, two loads of a path both read it
+    auto meta = std::make_shared<const ParquetFileMeta>(load());
+    auto capacity = capacity_bytes_.load();
+    if (capacity == 0 || meta->bytes > capacity) {
+        return meta;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(path);
+    if (it != entries_.end()) {
+        EraseLocked(it);
+    }
+    while (current_bytes_.load() + meta->bytes > capacity && !lru_.empty()) {
+        EraseLocked(entries_.find(lru_.front()));
+        monitor::internal_core_parquet_meta_cache_eviction.Increment();
+    }
+    auto lru_it = lru_.insert(lru_.end(), path);
+    entries_.emplace(path, Entry{meta, lru_it});
+    current_bytes_.fetch_add(meta->bytes);
+    monitor::internal_core_parquet_meta_cache_bytes_all.Set(
+        current_bytes_.load());
+    return meta;
+}
+
+void
+ParquetMetaCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    current_bytes_.store(0);
+    monitor::internal_core_parquet_meta_cache_bytes_all.Set(0);
+}
+
+void
+ParquetMetaCache::EraseLocked(
+    std::unordered_map<std::string, Entry>::iterator it) {
+    current_bytes_.fetch_sub(it->second.meta->bytes);
+    lru_.erase(it->second.lru_it);
+    entries_.erase(it);
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,105 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "milvus-storage/common/metadata.h"
+#include "milvus-storage/filesystem/fs.h"
+#include "parquet/metadata.h"
+
+namespace milvus::segcore {
+
+// What the loads take from the footer of a packed parquet file.
+struct ParquetFileMeta {
+    std::shared_ptr<parquet::FileMetaData> parquet_metadata;
+    std::map<int64_t, milvus_storage::ColumnOffset> field_id_mapping;
+    milvus_storage::RowGroupMetadataVector row_group_metas;
+    // the memory the entry is charged for
+    size_t bytes{0};
+};
+
+// Process-level LRU cache of the parsed footers of packed parquet files.
+//
+// A GroupChunkTranslator opens every file of its column group to read the
+// footer, as does a growing segment counting the row groups it loads, and
+// a segment reloaded, reopened or loaded lazily reads them all again. The
+// files are keyed by path: a binlog path names a log id, which is never
+// written twice, so a path keeps its footer and no HEAD is needed to tell
+// whether it changed.
+//
+// The footers have a budget of their own and the least recently used
+// ones are dropped to stay in it. A capacity of 0 turns the cache off, the
+// footers are read on every load as before.
+class ParquetMetaCache {
+ public:
+    static ParquetMetaCache&
+    Instance();
+
+    void
+    SetCapacityBytes(size_t capacity_bytes);
+    size_t
+    GetCapacityBytes() const;
+    size_t
+    GetCurrentBytes() const;
+    size_t
+    GetEntryCount() const;
+
+    // the footer of path, read with a FileRowGroupReader on a miss
+    std::shared_ptr<const ParquetFileMeta>
+    Get(const milvus_storage::ArrowFileSystemPtr& fs, const std::string& path);
+
+    // the footer of path, load() on a miss
+    std::shared_ptr<const ParquetFileMeta>
+    Get(const std::string& path, const std::function<ParquetFileMeta()>& load);
+
+    void
+    Clear();
+
+    // a row group is charged this beyond the serialized footer
+    static constexpr size_t kRowGroupMetaBytes = 64;
+
+ private:
+    ParquetMetaCache() = default;
+
+    struct Entry {
+        std::shared_ptr<const ParquetFileMeta> meta;
+        std::list<std::string>::iterator lru_it;
+    };
+
+    // drops an entry, caller holds mutex_
+    void
+    EraseLocked(std::unordered_map<std::string, Entry>::iterator it);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    // least recently used first
+    std::list<std::string> lru_;
+    std::atomic<size_t> capacity_bytes_{0};
+    std::atomic<size_t> current_bytes_{0};
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,91 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "segcore/ParquetMetaCache.h"
+
+using milvus::segcore::ParquetFileMeta;
+using milvus::segcore::ParquetMetaCache;
+
+class ParquetMetaCacheTest : public ::testing::Test {
+ protected:
+    void
+    SetUp() override {
+        ParquetMetaCache::Instance().Clear();
+        ParquetMetaCache::Instance().SetCapacityBytes(1000);
+    }
+
+    void
+    TearDown() override {
+        ParquetMetaCache::Instance().Clear();
+        ParquetMetaCache::Instance().SetCapacityBytes(0);
+    }
+
+    // a footer of bytes, counting the reads of the storage
+    std::function<ParquetFileMeta()>
+    Footer(size_t bytes) {
+        return [this, bytes]() {
+            ++reads_;
+            ParquetFileMeta meta;
+            meta.bytes = bytes;
+            return meta;
+        };
+    }
+
+    int reads_ = 0;
+};
+
+TEST_F(ParquetMetaCacheTest, ReadsAFooterOnce) {
+    auto& cache = ParquetMetaCache::Instance();
+    auto meta = cache.Get("files/1/0", Footer(100));
+    ASSERT_EQ(meta->bytes, 100);
+    EXPECT_EQ(cache.Get("files/1/0", Footer(100)), meta);
+    EXPECT_EQ(reads_, 1);
+    EXPECT_EQ(cache.GetEntryCount(), 1);
+    EXPECT_EQ(cache.GetCurrentBytes(), 100);
+
+    cache.Get("files/1/1", Footer(100));
+    EXPECT_EQ(reads_, 2);
+    EXPECT_EQ(cache.GetCurrentBytes(), 200);
+}
+
+TEST_F(ParquetMetaCacheTest, Capacity) {
+    auto& cache = ParquetMetaCache::Instance();
+    cache.Get("files/1/0", Footer(400));
+    cache.Get("files/1/1", Footer(400));
+    // a hit makes files/1/0 the most recently used
+    cache.Get("files/1/0", Footer(400));
+    cache.Get("files/1/2", Footer(400));
+    EXPECT_EQ(reads_, 3);
+    EXPECT_EQ(cache.GetEntryCount(), 2);
+    EXPECT_LE(cache.GetCurrentBytes(), cache.GetCapacityBytes());
+    cache.Get("files/1/0", Footer(400));
+    EXPECT_EQ(reads_, 3);
+    cache.Get("files/1/1", Footer(400));
+    EXPECT_EQ(reads_, 4);
+
+    // a footer above the capacity is read, not kept
+    cache.Get("files/2/0", Footer(2000));
+    EXPECT_EQ(cache.GetEntryCount(), 2);
+
+    cache.SetCapacityBytes(0);
+    EXPECT_EQ(cache.GetEntryCount(), 0);
+    EXPECT_EQ(cache.GetCurrentBytes(), 0);
+    cache.Get("files/1/0", Footer(400));
+    cache.Get("files/1/0", Footer(400));
+    EXPECT_EQ(reads_, 7);
+}
@@ -0,0 +1,100 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/PartitionKeyRows.h"
+
+#include <limits>
+
+#include "common/Chunk.h"
+#include "common/EasyAssert.h"
+
+namespace milvus::segcore {
+
+PartitionKeyRows::PartitionKeyRows(milvus::OpContext* op_ctx,
+                                   const ChunkedColumnInterface& column,
+                                   DataType data_type) {
+    AssertInfo(column.NumRows() <= std::numeric_limits<uint32_t>::max(),
+               "too many rows for partition key rows: {}",
+               column.NumRows());
+    // one chunk pinned at a time
+    for (int64_t chunk_id = 0; chunk_id < column.num_chunks(); ++chunk_id) {
+        auto pw = column.GetChunk(op_ctx, chunk_id);
+        auto chunk = pw.get();
+        auto begin = column.GetNumRowsUntilChunk(chunk_id);
+        auto rows = chunk->RowNums();
+        switch (data_type) {
+            case DataType::INT64: {
+                auto data = reinterpret_cast<const int64_t*>(chunk->RawData());
+                for (int64_t i = 0; i < rows; ++i) {
+                    Append(int_runs_[data[i]], begin + i);
+                }
+                break;
+            }
+            case DataType::VARCHAR: {
+                auto string_chunk = static_cast<StringChunk*>(chunk);
+                for (int64_t i = 0; i < rows; ++i) {
+                    Append(string_runs_[std::string((*string_chunk)[i])],
+                           begin + i);
+                }
+                break;
+            }
+            default:
+                ThrowInfo(DataTypeInvalid,
+                          "unsupported partition key type {}",
+                          data_type);
+        }
+    }
+    for (auto& [_, runs] : int_runs_) {
+        runs.shrink_to_fit();
+        num_runs_ += runs.size();
+    }
+    for (auto& [_, runs] : string_runs_) {
+        runs.shrink_to_fit();
+        num_runs_ += runs.size();
+    }
+}
+
+void
+PartitionKeyRows::Append(Runs& runs, int64_t offset) {
+    if (!runs.empty() && runs.back().begin_ + runs.back().size_ == offset) {
+        runs.back().size_++;
+    } else {
+        runs.push_back(Run{static_cast<uint32_t>(offset), 1});
+    }
+}
+
+void
+PartitionKeyRows::Set(const std::vector<PkType>& keys,
+                      BitsetTypeView& bitset) const {
+    for (const auto& key : keys) {
+        const Runs* runs = nullptr;
+        if (auto v = std::get_if<int64_t>(&key)) {
+            auto it = int_runs_.find(*v);
+            runs = it == int_runs_.end() ? nullptr : &it->second;
+        } else if (auto v = std::get_if<std::string>(&key)) {
+            auto it = string_runs_.find(*v);
+            runs = it == string_runs_.end() ? nullptr : &it->second;
+        }
+        if (runs == nullptr) {
+            continue;
+        }
+        for (const auto& run : *runs) {
+            bitset.set(run.begin_, run.size_, true);
+        }
+    }
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,71 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Types.h"
+#include "mmap/ChunkedColumnInterface.h"
+
+namespace milvus::segcore {
+
+// The rows of each partition key of a sealed segment, read once from the
+// partition key column, so a filter on a tenant sets its rows without
+// reading the column again. The rows of a key are kept as the runs of
+// consecutive offsets they form: few runs when the tenants were written in
+// batches, and a single one when the segment is sorted by the key.
+class PartitionKeyRows {
+ public:
+    // column holds an INT64 or VARCHAR field without nulls
+    PartitionKeyRows(milvus::OpContext* op_ctx,
+                     const ChunkedColumnInterface& column,
+                     DataType data_type);
+
+    // Sets the rows whose key is one of keys.
+    void
+    Set(const std::vector<PkType>& keys, BitsetTypeView& bitset) const;
+
+    size_t
+    num_keys() const {
+        return int_runs_.size() + string_runs_.size();
+    }
+
+    size_t
+    num_runs() const {
+        return num_runs_;
+    }
+
+ private:
+    struct Run {
+        uint32_t begin_;
+        uint32_t size_;
+    };
+    using Runs = std::vector<Run>;
+
+    static void
+    Append(Runs& runs, int64_t offset);
+
+    std::unordered_map<int64_t, Runs> int_runs_;
+    std::unordered_map<std::string, Runs> string_runs_;
+    size_t num_runs_{0};
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,40 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "segcore/projection_reader.h"
+
+using namespace milvus::segcore;
+
+TEST(ProjectionReaderTest, LocateRows) {
+    // two files, the second one starts with an empty row group
+    std::vector<std::vector<int64_t>> row_counts{{3, 2}, {0, 4}};
+    auto locations = LocateRows(row_counts, {8, 0, 3, 4, 5, 2, 5});
+    std::vector<RowLocation> expected{{1, 1, 3},
+                                      {0, 0, 0},
+                                      {0, 1, 0},
+                                      {0, 1, 1},
+                                      {1, 1, 0},
+                                      {0, 0, 2},
+                                      {1, 1, 0}};
+    EXPECT_EQ(locations, expected);
+
+    EXPECT_TRUE(LocateRows(row_counts, {}).empty());
+    EXPECT_ANY_THROW(LocateRows(row_counts, {9}));
+    EXPECT_ANY_THROW(LocateRows(row_counts, {-1}));
+}
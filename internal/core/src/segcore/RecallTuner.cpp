@@ -0,0 +1,105 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/RecallTuner.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace milvus::segcore {
+
+RecallTuner::RecallTuner(int64_t nlist, int64_t default_nprobe)
+    : default_nprobe_(default_nprobe) {
+    nlist = std::max<int64_t>(nlist, 1);
+    for (int64_t nprobe = 1; nprobe < nlist; nprobe *= 2) {
+        candidates_.push_back(nprobe);
+    }
+    candidates_.push_back(nlist);
+    recall_sums_.resize(candidates_.size());
+    samples_.resize(candidates_.size());
+}
+
+int64_t
+RecallTuner::Pick(double recall_target) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the exhaustive probe is the reference, it is never sampled
+    for (size_t i = 0; i + 1 < candidates_.size(); ++i) {
+        if (samples_[i] < kMinSamples) {
+            return default_nprobe_;
+        }
+        if (recall_sums_[i] / samples_[i] >= recall_target) {
+            return candidates_[i];
+        }
+    }
+    return candidates_.back();
+}
+
+bool
+RecallTuner::ShouldSample() {
+    return searches_.fetch_add(1) % kSampleInterval == 0;
+}
+
+void
+RecallTuner::Observe(int64_t nprobe, double recall) {
+    auto it = std::find(candidates_.begin(), candidates_.end(), nprobe);
+    if (it == candidates_.end()) {
+        return;
+    }
+    auto i = it - candidates_.begin();
+    std::lock_guard<std::mutex> lock(mutex_);
+    recall_sums_[i] += recall;
+    ++samples_[i];
+}
+
+std::optional<double>
+RecallTuner::MeanRecall(int64_t nprobe) const {
+    auto it = std::find(candidates_.begin(), candidates_.end(), nprobe);
+    if (it == candidates_.end()) {
+        return std::nullopt;
+    }
+    auto i = it - candidates_.begin();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_[i] < kMinSamples) {
+        return std::nullopt;
+    }
+    return recall_sums_[i] / samples_[i];
+}
+
+std::optional<double>
+RecallTuner::Recall(const std::vector<int64_t>& exact,
+                    const std::vector<int64_t>& approx) {
+    std::vector<int64_t> expected;
+    for (auto offset : exact) {
+        if (offset >= 0) {
+            expected.push_back(offset);
+        }
+    }
+    if (expected.empty()) {
+        return std::nullopt;
+    }
+    std::vector<int64_t> found(approx);
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    std::vector<int64_t> hits;
+    std::set_intersection(expected.begin(),
+                          expected.end(),
+                          found.begin(),
+                          found.end(),
+                          std::back_inserter(hits));
+    return static_cast<double>(hits.size()) / expected.size();
+}
+
+}  // namespace milvus::segcore
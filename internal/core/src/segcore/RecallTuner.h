@@ -0,0 +1,82 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace milvus::segcore {
+
+/**
+ * The recall curve of the nprobe of an interim index, so a search with a
+ * recall target gets the cheapest nprobe reaching it on this index.
+ *
+ * The candidates are the powers of two below nlist and nlist itself, the
+ * exhaustive probe every candidate is measured against. One in
+ * kSampleInterval searches with a target is sampled: its first query runs
+ * at every candidate and Observe records their recall. Until every
+ * candidate has kMinSamples samples, Pick returns the default nprobe.
+ */
+class RecallTuner {
+ public:
+    RecallTuner(int64_t nlist, int64_t default_nprobe);
+
+    // ascending, the last one is the exhaustive probe
+    const std::vector<int64_t>&
+    Candidates() const {
+        return candidates_;
+    }
+
+    // the cheapest candidate whose mean recall reaches recall_target, the
+    // exhaustive probe if none does
+    int64_t
+    Pick(double recall_target) const;
+
+    bool
+    ShouldSample();
+
+    void
+    Observe(int64_t nprobe, double recall);
+
+    // mean recall of the candidate, nullopt before kMinSamples samples
+    std::optional<double>
+    MeanRecall(int64_t nprobe) const;
+
+    // the share of the valid hits of exact that approx found, nullopt when
+    // exact has none
+    static std::optional<double>
+    Recall(const std::vector<int64_t>& exact,
+           const std::vector<int64_t>& approx);
+
+    static constexpr int64_t kSampleInterval = 64;
+    static constexpr int64_t kMinSamples = 8;
+
+ private:
+    std::vector<int64_t> candidates_;
+    int64_t default_nprobe_;
+    std::atomic<int64_t> searches_{0};
+
+    mutable std::mutex mutex_;
+    // per candidate
+    std::vector<double> recall_sums_;
+    std::vector<int64_t> samples_;
+};
+
+}  // namespace milvus::segcore
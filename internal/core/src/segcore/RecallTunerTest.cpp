@@ -0,0 +1,67 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "segcore/RecallTuner.h"
+
+using milvus::segcore::RecallTuner;
+
+TEST(RecallTuner, Candidates) {
+    RecallTuner tuner(100, 8);
+    std::vector<int64_t> expected{1, 2, 4, 8, 16, 32, 64, 100};
+    EXPECT_EQ(tuner.Candidates(), expected);
+    EXPECT_EQ(RecallTuner(1, 1).Candidates(), std::vector<int64_t>{1});
+}
+
+TEST(RecallTuner, Recall) {
+    EXPECT_EQ(RecallTuner::Recall({1, 2, 3, 4}, {4, 3, 9, 8}), 0.5);
+    EXPECT_EQ(RecallTuner::Recall({1, 2, -1, -1}, {2, 1, -1, -1}), 1.0);
+    EXPECT_FALSE(RecallTuner::Recall({-1, -1}, {-1, -1}).has_value());
+}
+
+TEST(RecallTuner, Pick) {
+    RecallTuner tuner(16, 8);
+    auto observe = [&](double r1, double r2, double r4, double r8) {
+        tuner.Observe(1, r1);
+        tuner.Observe(2, r2);
+        tuner.Observe(4, r4);
+        tuner.Observe(8, r8);
+    };
+    // the default nprobe until the curve has enough samples
+    observe(0.5, 0.7, 0.9, 0.97);
+    EXPECT_EQ(tuner.Pick(0.9), 8);
+    EXPECT_FALSE(tuner.MeanRecall(4).has_value());
+
+    for (int i = 1; i < RecallTuner::kMinSamples; ++i) {
+        observe(0.5, 0.7, 0.9, 0.97);
+    }
+    EXPECT_DOUBLE_EQ(tuner.MeanRecall(4).value(), 0.9);
+    EXPECT_EQ(tuner.Pick(0.5), 1);
+    EXPECT_EQ(tuner.Pick(0.85), 4);
+    EXPECT_EQ(tuner.Pick(0.95), 8);
+    // the exhaustive probe when no candidate reaches the target
+    EXPECT_EQ(tuner.Pick(0.99), 16);
+}
+
+TEST(RecallTuner, ShouldSample) {
+    RecallTuner tuner(16, 8);
+    int sampled = 0;
+    for (int i = 0; i < 10 * RecallTuner::kSampleInterval; ++i) {
+        sampled += tuner.ShouldSample();
+    }
+    EXPECT_EQ(sampled, 10);
+}
@@ -11,8 +11,17 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+
+#include "xxhash.h"  // from xxhash/xxhash
 
 #include "common/Consts.h"
 #include "common/Types.h"
@@ -81,9 +90,155 @@ struct SearchResultPair {
     }
 };
 
+// the hash a VARCHAR primary key is deduplicated by, an INT64 key is its
+// own hash
+inline uint64_t
+PkHash(const milvus::PkType& pk) {
+    if (auto str_pk = std::get_if<std::string>(&pk)) {
+        return XXH3_64bits(str_pk->data(), str_pk->size());
+    }
+    if (auto int_pk = std::get_if<int64_t>(&pk)) {
+        return static_cast<uint64_t>(*int_pk);
+    }
+    return 0;
+}
+
+// The primary keys kept by the merge of one nq.
+//
+// A set of PkType hashes and copies every VARCHAR key it is given. This
+// one keeps the 64-bit hash of a key, computed once per result by
+// FillPrimaryKeys, and a view of the first string of that hash, and
+// compares the strings only when hashes meet. The strings viewed are the
+// primary_keys_ of the results being merged, which stay in place until
+// the merge is done: callers pass those, not a copy.
+class PkDedupSet {
+ public:
+    void
+    clear() {
+        hashes_.clear();
+        collided_.clear();
+    }
+
+    // false if pk was in the set already; hash is PkHash(pk)
+    bool
+    Insert(const milvus::PkType& pk, uint64_t hash) {
+        auto str_pk = std::get_if<std::string>(&pk);
+        if (str_pk == nullptr) {
+            return hashes_.emplace(hash, std::string_view()).second;
+        }
+        auto [it, inserted] = hashes_.emplace(hash, *str_pk);
+        if (inserted || it->second == *str_pk) {
+            return inserted;
+        }
+        // a distinct key of the same hash
+        return collided_.emplace(*str_pk).second;
+    }
+
+    bool
+    Contains(const milvus::PkType& pk, uint64_t hash) const {
+        auto it = hashes_.find(hash);
+        if (it == hashes_.end()) {
+            return false;
+        }
+        auto str_pk = std::get_if<std::string>(&pk);
+        return str_pk == nullptr || it->second == *str_pk ||
+               collided_.count(*str_pk) != 0;
+    }
+
+ private:
+    // the keys are hashes already
+    struct IdentityHash {
+        size_t
+        operator()(uint64_t hash) const noexcept {
+            return hash;
+        }
+    };
+
+    std::unordered_map<uint64_t, std::string_view, IdentityHash> hashes_;
+    std::unordered_set<std::string_view> collided_;
+};
+
 struct SearchResultPairComparator {
     bool
     operator()(const SearchResultPair* lhs, const SearchResultPair* rhs) const {
         return *rhs > *lhs;
     }
 };
+
+// Tournament tree of losers over k sorted runs, e.g. the per-segment topk
+// lists of one query. Unlike a heap, replacing the winner replays a single
+// leaf-to-root path: log2(k) comparisons against the stored losers, with no
+// sibling to compare and no element to move.
+//
+// Runs provides Exhausted(run) and Before(left, right) for the heads of two
+// live runs; the caller advances the head of Winner() and calls Replay().
+template <typename Runs>
+class LoserTree {
+ public:
+    LoserTree(const Runs& runs, size_t num_runs)
+        : runs_(runs), num_runs_(num_runs) {
+        capacity_ = 1;
+        while (capacity_ < num_runs_) {
+            capacity_ <<= 1;
+        }
+        // slot 0 keeps the winner, the padding leaves are exhausted runs
+        nodes_.assign(capacity_, 0);
+        nodes_[0] = capacity_ == 1 ? 0 : Build(1);
+    }
+
+    // the run holding the next element, Exhausted() when all runs are
+    size_t
+    Winner() const {
+        return nodes_[0];
+    }
+
+    bool
+    Exhausted() const {
+        return !Live(nodes_[0]);
+    }
+
+    // restores the order after the head of Winner() has moved on
+    void
+    Replay() {
+        auto winner = nodes_[0];
+        for (auto node = (winner + capacity_) >> 1; node > 0; node >>= 1) {
+            if (Beats(nodes_[node], winner)) {
+                std::swap(nodes_[node], winner);
+            }
+        }
+        nodes_[0] = winner;
+    }
+
+ private:
+    bool
+    Live(size_t run) const {
+        return run < num_runs_ && !runs_.Exhausted(run);
+    }
+
+    bool
+    Beats(size_t left, size_t right) const {
+        return Live(left) && (!Live(right) || runs_.Before(left, right));
+    }
+
+    // returns the winner of the subtree, leaving its loser in the node
+    size_t
+    Build(size_t node) {
+        if (node >= capacity_) {
+            return node - capacity_;
+        }
+        auto left = Build(2 * node);
+        auto right = Build(2 * node + 1);
+        if (Beats(left, right)) {
+            nodes_[node] = right;
+            return left;
+        }
+        nodes_[node] = left;
+        return right;
+    }
+
+ private:
+    const Runs& runs_;
+    size_t num_runs_;
+    size_t capacity_;
+    std::vector<size_t> nodes_;
+};
@@ -33,3 +33,76 @@ TEST(SearchResultPair, SameDistance) {
     ASSERT_EQ(pair2 > pair1, true);
     ASSERT_EQ(pair1.primary_key_, INVALID_PK);
 }
+
+namespace {
+
+struct SortedRuns {
+    std::vector<std::vector<int>> runs_;
+    std::vector<size_t> heads_;
+
+    bool
+    Exhausted(size_t run) const {
+        return heads_[run] == runs_[run].size();
+    }
+
+    bool
+    Before(size_t left, size_t right) const {
+        return runs_[left][heads_[left]] < runs_[right][heads_[right]];
+    }
+};
+
+}  // namespace
+
+TEST(LoserTree, MergesSortedRuns) {
+    SortedRuns runs;
+    // an empty run and a number of runs that is not a power of two
+    runs.runs_ = {{1, 4, 9}, {}, {2, 3}, {0, 5, 6, 7}, {8}};
+    runs.heads_.assign(runs.runs_.size(), 0);
+    LoserTree<SortedRuns> tree(runs, runs.runs_.size());
+
+    std::vector<int> merged;
+    while (!tree.Exhausted()) {
+        auto run = tree.Winner();
+        merged.push_back(runs.runs_[run][runs.heads_[run]++]);
+        tree.Replay();
+    }
+    ASSERT_EQ(merged, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    SortedRuns no_runs;
+    LoserTree<SortedRuns> empty_tree(no_runs, 0);
+    ASSERT_TRUE(empty_tree.Exhausted());
+}
+
+TEST(PkDedupSet, VarcharPks) {
+    std::vector<milvus::PkType> pks{
+        std::string("a"), std::string("b"), std::string("a")};
+    PkDedupSet pk_set;
+    ASSERT_TRUE(pk_set.Insert(pks[0], PkHash(pks[0])));
+    ASSERT_TRUE(pk_set.Insert(pks[1], PkHash(pks[1])));
+    ASSERT_FALSE(pk_set.Insert(pks[2], PkHash(pks[2])));
+    ASSERT_TRUE(pk_set.Contains(pks[2], PkHash(pks[2])));
+
+    // distinct keys of one hash are told apart by their strings
+    std::vector<milvus::PkType> colliding{
+        std::string("x"), std::string("y"), std::string("z")};
+    for (auto& pk : colliding) {
+        ASSERT_FALSE(pk_set.Contains(pk, 42));
+        ASSERT_TRUE(pk_set.Insert(pk, 42));
+        ASSERT_TRUE(pk_set.Contains(pk, 42));
+    }
+    for (auto& pk : colliding) {
+        ASSERT_FALSE(pk_set.Insert(pk, 42));
+    }
+
+    pk_set.clear();
+    ASSERT_FALSE(pk_set.Contains(pks[0], PkHash(pks[0])));
+}
+
+TEST(PkDedupSet, Int64Pks) {
+    PkDedupSet pk_set;
+    milvus::PkType pk = int64_t(-7);
+    ASSERT_TRUE(pk_set.Insert(pk, PkHash(pk)));
+    ASSERT_FALSE(pk_set.Insert(pk, PkHash(pk)));
+    milvus::PkType other = int64_t(7);
+    ASSERT_FALSE(pk_set.Contains(other, PkHash(other)));
+}
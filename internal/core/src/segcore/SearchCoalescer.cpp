@@ -0,0 +1,266 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/SearchCoalescer.h"
+
+#include <chrono>
+#include <exception>
+#include <numeric>
+
+#include "common/Consts.h"
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "monitor/Monitor.h"
+
+namespace milvus::segcore {
+
+SearchCoalescer&
+SearchCoalescer::Instance() {
+    static SearchCoalescer instance;
+    return instance;
+}
+
+void
+SearchCoalescer::SetWindowMicros(int64_t window_us) {
+    window_us_.store(window_us);
+    LOG_INFO("set search coalesce window: {} us", window_us);
+}
+
+int64_t
+SearchCoalescer::GetWindowMicros() const {
+    return window_us_.load();
+}
+
+bool
+SearchCoalescer::Coalescable(const query::Plan& plan,
+                             const query::PlaceholderGroup& placeholder_group) {
+    if (plan.signature_ == 0 || plan.plan_node_ == nullptr ||
+        placeholder_group.size() != 1) {
+        return false;
+    }
+    auto& search_info = plan.plan_node_->search_info_;
+    if (search_info.group_by_field_id_.has_value() ||
+        search_info.iterator_v2_info_.has_value() ||
+        search_info.element_level() ||
+        search_info.search_params_.contains(RADIUS)) {
+        return false;
+    }
+    auto& placeholder = placeholder_group[0];
+    return placeholder.num_of_queries_ > 0 && !placeholder.blob_.empty() &&
+           placeholder.offsets_.empty() && !placeholder.element_level_;
+}
+
+bool
+SearchCoalescer::Mergeable(const query::Plan& lhs, const query::Plan& rhs) {
+    auto& lhs_info = lhs.plan_node_->search_info_;
+    auto& rhs_info = rhs.plan_node_->search_info_;
+    return lhs.signature_ == rhs.signature_ &&
+           lhs.target_entries_ == rhs.target_entries_ &&
+           lhs.target_dynamic_fields_ == rhs.target_dynamic_fields_ &&
+           lhs_info.field_id_ == rhs_info.field_id_ &&
+           lhs_info.topk_ == rhs_info.topk_ &&
+           lhs_info.round_decimal_ == rhs_info.round_decimal_ &&
+           lhs_info.metric_type_ == rhs_info.metric_type_ &&
+           lhs_info.search_params_ == rhs_info.search_params_;
+}
+
+std::unique_ptr<SearchResult>
+SearchCoalescer::Search(const Key& key,
+                        const query::Plan& plan,
+                        const query::PlaceholderGroup& placeholder_group,
+                        const SearchFn& search) {
+    auto nq = placeholder_group[0].num_of_queries_;
+    if (window_us_.load() <= 0 || nq >= kMaxBatchNq) {
+        return search(placeholder_group);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = open_.find(key);
+    if (it != open_.end() && !Mergeable(*it->second->plan, plan)) {
+        // the open batch is left to the searches of its plan
+        lock.unlock();
+        return search(placeholder_group);
+    }
+    if (it == open_.end() || it->second->nq + nq > kMaxBatchNq) {
+        auto batch = std::make_shared<Batch>();
+        batch->plan = &plan;
+        batch->groups.push_back(&placeholder_group);
+        batch->nqs.push_back(nq);
+        batch->nq = nq;
+        // a batch too full for the search is left to its leader
+        open_[key] = batch;
+        return Lead(key, batch, lock, search);
+    }
+
+    auto batch = it->second;
+    auto index = batch->groups.size();
+    batch->groups.push_back(&placeholder_group);
+    batch->nqs.push_back(nq);
+    batch->nq += nq;
+    if (batch->nq >= kMaxBatchNq) {
+        batch->closed = true;
+        open_.erase(it);
+        batch->cv.notify_all();
+    }
+    batch->cv.wait(lock, [&batch]() { return batch->done; });
+    std::unique_ptr<SearchResult> result;
+    if (!batch->results.empty()) {
+        result = std::move(batch->results[index]);
+    }
+    lock.unlock();
+    if (result == nullptr) {
+        return search(placeholder_group);
+    }
+    return result;
+}
+
+std::unique_ptr<SearchResult>
+SearchCoalescer::Lead(const Key& key,
+                      const std::shared_ptr<Batch>& batch,
+                      std::unique_lock<std::mutex>& lock,
+                      const SearchFn& search) {
+    batch->cv.wait_for(lock,
+                       std::chrono::microseconds(window_us_.load()),
+                       [&batch]() { return batch->closed; });
+    if (!batch->closed) {
+        batch->closed = true;
+        auto it = open_.find(key);
+        if (it != open_.end() && it->second == batch) {
+            open_.erase(it);
+        }
+    }
+    // a closed batch takes no more searches, its groups are read unlocked
+    lock.unlock();
+    if (batch->groups.size() == 1) {
+        return search(*batch->groups[0]);
+    }
+
+    std::vector<std::unique_ptr<SearchResult>> results;
+    try {
+        auto merged = MergePlaceholderGroups(batch->groups);
+        auto result = search(merged);
+        results = SplitSearchResult(*result, batch->nqs);
+    } catch (const std::exception& e) {
+        LOG_WARN("coalesced search of {} queries failed, searching them "
+                 "one search at a time: {}",
+                 batch->nq,
+                 e.what());
+    }
+    if (!results.empty()) {
+        monitor::internal_core_search_coalesce_count_batch.Increment();
+        monitor::internal_core_search_coalesce_count_search.Increment(
+            results.size());
+    }
+
+    std::unique_ptr<SearchResult> result;
+    lock.lock();
+    if (!results.empty()) {
+        result = std::move(results[0]);
+    }
+    batch->results = std::move(results);
+    batch->done = true;
+    batch->cv.notify_all();
+    lock.unlock();
+    if (result == nullptr) {
+        return search(*batch->groups[0]);
+    }
+    return result;
+}
+
+query::PlaceholderGroup
+SearchCoalescer::MergePlaceholderGroups(
+    const std::vector<const query::PlaceholderGroup*>& groups) {
+    AssertInfo(!groups.empty(), "no placeholder group to merge");
+    auto& first = (*groups[0])[0];
+    size_t bytes = 0;
+    for (auto group : groups) {
+        auto& placeholder = (*group)[0];
+        AssertInfo(placeholder.tag_ == first.tag_ &&
+                       placeholder.blob_.size() * first.num_of_queries_ ==
+                           first.blob_.size() * placeholder.num_of_queries_,
+                   "placeholder {} of {} queries cannot merge with "
+                   "placeholder {} of {} queries",
+                   placeholder.tag_,
+                   placeholder.num_of_queries_,
+                   first.tag_,
+                   first.num_of_queries_);
+        bytes += placeholder.blob_.size();
+    }
+
+    // the signature is left 0, the merged group is not cached
+    query::PlaceholderGroup merged(1);
+    auto& placeholder = merged[0];
+    placeholder.tag_ = first.tag_;
+    placeholder.num_of_queries_ = 0;
+    placeholder.blob_.reserve(bytes);
+    for (auto group : groups) {
+        auto& blob = (*group)[0].blob_;
+        placeholder.blob_.insert(
+            placeholder.blob_.end(), blob.begin(), blob.end());
+        placeholder.num_of_queries_ += (*group)[0].num_of_queries_;
+    }
+    return merged;
+}
+
+std::vector<std::unique_ptr<SearchResult>>
+SearchCoalescer::SplitSearchResult(SearchResult& merged,
+                                   const std::vector<int64_t>& nqs) {
+    auto total_nq = std::accumulate(nqs.begin(), nqs.end(), int64_t(0));
+    auto topk = merged.unity_topK_;
+    auto& prefix_sum = merged.topk_per_nq_prefix_sum_;
+    if (merged.total_nq_ != total_nq || merged.HasIterators() ||
+        !merged.chunk_buffers_.empty() || merged.group_by_values_.has_value() ||
+        merged.element_level_ ||
+        merged.distances_.size() != static_cast<size_t>(total_nq * topk) ||
+        merged.seg_offsets_.size() != merged.distances_.size() ||
+        (!prefix_sum.empty() &&
+         prefix_sum.size() != static_cast<size_t>(total_nq + 1))) {
+        return {};
+    }
+
+    std::vector<std::unique_ptr<SearchResult>> results;
+    results.reserve(nqs.size());
+    int64_t begin = 0;
+    for (auto nq : nqs) {
+        auto result = std::make_unique<SearchResult>();
+        result->total_nq_ = nq;
+        result->unity_topK_ = topk;
+        result->total_data_cnt_ = merged.total_data_cnt_;
+        result->segment_ = merged.segment_;
+        result->pk_type_ = merged.pk_type_;
+        result->group_size_ = merged.group_size_;
+        result->distances_.assign(
+            merged.distances_.begin() + begin * topk,
+            merged.distances_.begin() + (begin + nq) * topk);
+        result->seg_offsets_.assign(
+            merged.seg_offsets_.begin() + begin * topk,
+            merged.seg_offsets_.begin() + (begin + nq) * topk);
+        if (!prefix_sum.empty()) {
+            for (int64_t i = 0; i <= nq; ++i) {
+                result->topk_per_nq_prefix_sum_.push_back(
+                    prefix_sum[begin + i] - prefix_sum[begin]);
+            }
+        }
+        begin += nq;
+        results.push_back(std::move(result));
+    }
+    // the reads of the batch are charged to the search leading it
+    results[0]->search_storage_cost_ = merged.search_storage_cost_;
+    results[0]->search_profile_ = std::move(merged.search_profile_);
+    return results;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,125 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "common/QueryResult.h"
+#include "query/PlanImpl.h"
+
+namespace milvus::segcore {
+
+// Coalesces the concurrent searches of a segment into multi-query ones.
+//
+// Clients often send single query searches of the same plan at a high
+// rate, each of them traversing the index and running the executor on its
+// own. The first search of a segment and a plan waits for a short window,
+// the same searches arriving in it join it, and their queries are searched
+// at once and split back into one result per search.
+//
+// Searches join by their segment, the signature of their plan, their
+// timestamp and their consistency, so all of them see the same rows. A
+// search only joins a batch whose leading plan has the same outputs and
+// search info, the others are searched alone. The searches taking part
+// wait on their thread for the window and the batch; a batch that fails
+// is searched again one search at a time, so each search reports its own
+// error. A window of 0 turns it off.
+class SearchCoalescer {
+ public:
+    // the searches that may join, the segment, the plan signature, the
+    // timestamp, the consistency level and the collection ttl
+    using Key = std::tuple<const void*, uint64_t, uint64_t, int32_t, uint64_t>;
+    using SearchFn = std::function<std::unique_ptr<SearchResult>(
+        const query::PlaceholderGroup&)>;
+
+    static SearchCoalescer&
+    Instance();
+
+    void
+    SetWindowMicros(int64_t window_us);
+    int64_t
+    GetWindowMicros() const;
+
+    // whether searches of plan for placeholder_group may join others: dense
+    // queries of a top k search, without iterators, groups or ranges
+    static bool
+    Coalescable(const query::Plan& plan,
+                const query::PlaceholderGroup& placeholder_group);
+
+    // the result of search(placeholder_group) for plan, searched with the
+    // searches of key arriving in the window
+    std::unique_ptr<SearchResult>
+    Search(const Key& key,
+           const query::Plan& plan,
+           const query::PlaceholderGroup& placeholder_group,
+           const SearchFn& search);
+
+    // whether the searches of two plans may share a search
+    static bool
+    Mergeable(const query::Plan& lhs, const query::Plan& rhs);
+
+    // the queries of groups, in order, in a single group
+    static query::PlaceholderGroup
+    MergePlaceholderGroups(
+        const std::vector<const query::PlaceholderGroup*>& groups);
+
+    // the results of the groups merged into merged, empty if the result
+    // cannot be split
+    static std::vector<std::unique_ptr<SearchResult>>
+    SplitSearchResult(SearchResult& merged, const std::vector<int64_t>& nqs);
+
+    // queries of a batch, a batch this full is searched without waiting
+    static constexpr int64_t kMaxBatchNq = 64;
+
+ private:
+    SearchCoalescer() = default;
+
+    struct Batch {
+        // the plan of the search leading the batch
+        const query::Plan* plan{nullptr};
+        std::vector<const query::PlaceholderGroup*> groups;
+        std::vector<int64_t> nqs;
+        int64_t nq{0};
+        // set once the batch takes no more searches
+        bool closed{false};
+        // set once results are filled, an empty one searches alone
+        bool done{false};
+        std::vector<std::unique_ptr<SearchResult>> results;
+        std::condition_variable cv;
+    };
+
+    std::unique_ptr<SearchResult>
+    Lead(const Key& key,
+         const std::shared_ptr<Batch>& batch,
+         std::unique_lock<std::mutex>& lock,
+         const SearchFn& search);
+
+    std::mutex mutex_;
+    // the batches still open to searches
+    std::map<Key, std::shared_ptr<Batch>> open_;
+    std::atomic<int64_t> window_us_{0};
+};
+
+}  // namespace milvus::segcore
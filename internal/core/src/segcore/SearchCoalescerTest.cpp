@@ -0,0 +1,218 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "segcore/SearchCoalescer.h"
+
+using milvus::SearchResult;
+using milvus::query::PlaceholderGroup;
+using milvus::query::Plan;
+using milvus::segcore::SearchCoalescer;
+
+namespace {
+
+constexpr int64_t kTopK = 2;
+
+// a group of nq queries of one float each
+PlaceholderGroup
+MakeGroup(const std::vector<float>& queries) {
+    PlaceholderGroup group(1);
+    group[0].tag_ = "$0";
+    group[0].num_of_queries_ = queries.size();
+    group[0].blob_.resize(queries.size() * sizeof(float));
+    std::memcpy(
+        group[0].blob_.data(), queries.data(), group[0].blob_.size());
+    return group;
+}
+
+std::unique_ptr<Plan>
+MakePlan(uint64_t signature) {
+    auto plan = std::make_unique<Plan>(std::make_shared<milvus::Schema>());
+    plan->plan_node_ = std::make_unique<milvus::query::VectorPlanNode>();
+    plan->plan_node_->search_info_.topk_ = kTopK;
+    plan->signature_ = signature;
+    return plan;
+}
+
+// a search returning, for every query q, the distances q and q + 0.5
+std::unique_ptr<SearchResult>
+FakeSearch(const PlaceholderGroup& group) {
+    auto nq = group[0].num_of_queries_;
+    auto queries = reinterpret_cast<const float*>(group[0].blob_.data());
+    auto result = std::make_unique<SearchResult>();
+    result->total_nq_ = nq;
+    result->unity_topK_ = kTopK;
+    result->total_data_cnt_ = 100;
+    for (int64_t i = 0; i < nq; ++i) {
+        result->distances_.push_back(queries[i]);
+        result->distances_.push_back(queries[i] + 0.5f);
+        result->seg_offsets_.push_back(i);
+        result->seg_offsets_.push_back(-1);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(SearchCoalescerTest, MergeAndSplit) {
+    auto a = MakeGroup({1.0f});
+    auto b = MakeGroup({2.0f, 3.0f});
+    auto merged = SearchCoalescer::MergePlaceholderGroups({&a, &b});
+    ASSERT_EQ(merged.size(), 1);
+    EXPECT_EQ(merged[0].tag_, "$0");
+    EXPECT_EQ(merged[0].num_of_queries_, 3);
+    EXPECT_EQ(merged.signature_, 0);
+
+    auto result = FakeSearch(merged);
+    result->topk_per_nq_prefix_sum_ = {0, 1, 3, 4};
+    auto results = SearchCoalescer::SplitSearchResult(*result, {1, 2});
+    ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0]->total_nq_, 1);
+    EXPECT_EQ(results[0]->distances_, (std::vector<float>{1.0f, 1.5f}));
+    EXPECT_EQ(results[0]->topk_per_nq_prefix_sum_,
+              (std::vector<size_t>{0, 1}));
+    EXPECT_EQ(results[1]->total_nq_, 2);
+    EXPECT_EQ(results[1]->unity_topK_, kTopK);
+    EXPECT_EQ(results[1]->total_data_cnt_, 100);
+    EXPECT_EQ(results[1]->distances_,
+              (std::vector<float>{2.0f, 2.5f, 3.0f, 3.5f}));
+    EXPECT_EQ(results[1]->seg_offsets_, (std::vector<int64_t>{1, -1, 2, -1}));
+    EXPECT_EQ(results[1]->topk_per_nq_prefix_sum_,
+              (std::vector<size_t>{0, 2, 3}));
+
+    // a result of other queries is not split
+    EXPECT_TRUE(SearchCoalescer::SplitSearchResult(*result, {1, 1}).empty());
+    auto c = MakeGroup({});
+    c[0].tag_ = "$1";
+    EXPECT_ANY_THROW(SearchCoalescer::MergePlaceholderGroups({&a, &c}));
+}
+
+TEST(SearchCoalescerTest, ConcurrentSearches) {
+    auto& coalescer = SearchCoalescer::Instance();
+    coalescer.SetWindowMicros(200000);
+    SearchCoalescer::Key key{nullptr, 1, 100, 0, 0};
+    auto plan = MakePlan(1);
+
+    constexpr int kSearches = 8;
+    std::atomic<int> searches{0};
+    std::vector<std::unique_ptr<SearchResult>> results(kSearches);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kSearches; ++i) {
+        threads.emplace_back([&, i]() {
+            auto group = MakeGroup({static_cast<float>(i)});
+            results[i] = coalescer.Search(
+                key, *plan, group, [&](const PlaceholderGroup& group) {
+                    ++searches;
+                    return FakeSearch(group);
+                });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    coalescer.SetWindowMicros(0);
+
+    EXPECT_LT(searches.load(), kSearches);
+    for (int i = 0; i < kSearches; ++i) {
+        ASSERT_NE(results[i], nullptr);
+        EXPECT_EQ(results[i]->total_nq_, 1);
+        EXPECT_EQ(results[i]->distances_,
+                  (std::vector<float>{float(i), i + 0.5f}));
+    }
+}
+
+TEST(SearchCoalescerTest, FailedBatch) {
+    auto& coalescer = SearchCoalescer::Instance();
+    coalescer.SetWindowMicros(200000);
+    SearchCoalescer::Key key{nullptr, 2, 100, 0, 0};
+    auto plan = MakePlan(2);
+
+    // a search of more than a query fails, each search then goes alone
+    auto search = [](const PlaceholderGroup& group) {
+        if (group[0].num_of_queries_ > 1) {
+            throw std::runtime_error("batch failed");
+        }
+        return FakeSearch(group);
+    };
+    constexpr int kSearches = 4;
+    std::atomic<int> succeeded{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kSearches; ++i) {
+        threads.emplace_back([&, i]() {
+            auto group = MakeGroup({static_cast<float>(i)});
+            auto result = coalescer.Search(key, *plan, group, search);
+            EXPECT_EQ(result->distances_[0], i);
+            ++succeeded;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    coalescer.SetWindowMicros(0);
+
+    EXPECT_EQ(succeeded.load(), kSearches);
+}
+
+TEST(SearchCoalescerTest, OtherOutputsSearchAlone) {
+    auto plan = MakePlan(3);
+    auto same = MakePlan(3);
+    EXPECT_TRUE(SearchCoalescer::Mergeable(*plan, *same));
+    // the plans of a signature may still differ in their outputs
+    auto outputs = MakePlan(3);
+    outputs->target_entries_.push_back(milvus::FieldId(101));
+    EXPECT_FALSE(SearchCoalescer::Mergeable(*plan, *outputs));
+    auto dynamic_fields = MakePlan(3);
+    dynamic_fields->target_dynamic_fields_.push_back("a");
+    EXPECT_FALSE(SearchCoalescer::Mergeable(*plan, *dynamic_fields));
+    auto topk = MakePlan(3);
+    topk->plan_node_->search_info_.topk_ = kTopK + 1;
+    EXPECT_FALSE(SearchCoalescer::Mergeable(*plan, *topk));
+
+    auto& coalescer = SearchCoalescer::Instance();
+    coalescer.SetWindowMicros(200000);
+    SearchCoalescer::Key key{nullptr, 3, 100, 0, 0};
+    std::atomic<int> searches{0};
+    auto search = [&](const PlaceholderGroup& group) {
+        ++searches;
+        return FakeSearch(group);
+    };
+    std::vector<const Plan*> plans{plan.get(), outputs.get()};
+    std::vector<std::unique_ptr<SearchResult>> results(plans.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < plans.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            auto group = MakeGroup({static_cast<float>(i)});
+            results[i] = coalescer.Search(key, *plans[i], group, search);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    coalescer.SetWindowMicros(0);
+
+    EXPECT_EQ(searches.load(), 2);
+    for (size_t i = 0; i < plans.size(); ++i) {
+        EXPECT_EQ(results[i]->distances_,
+                  (std::vector<float>{float(i), i + 0.5f}));
+    }
+}
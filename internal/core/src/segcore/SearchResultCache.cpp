@@ -0,0 +1,323 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/SearchResultCache.h"
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "monitor/Monitor.h"
+#include "segcore/Utils.h"
+
+namespace milvus::segcore {
+
+std::atomic<bool> SearchResCacheManager::enabled_{false};
+
+SearchResCacheManager&
+SearchResCacheManager::Instance() {
+    static SearchResCacheManager instance;
+    return instance;
+}
+
+void
+SearchResCacheManager::SetEnabled(bool enabled) {
+    enabled_.store(enabled);
+}
+
+bool
+SearchResCacheManager::IsEnabled() {
+    return enabled_.load();
+}
+
+uint64_t
+SearchResCacheManager::TsBucket(Timestamp ts) {
+    return TimestampToPhysicalMs(ts) / kTsBucketMs;
+}
+
+std::shared_ptr<const SearchResCacheManager::Value>
+SearchResCacheManager::Capture(const SearchResult& result) {
+    if (result.HasIterators() || !result.chunk_buffers_.empty()) {
+        return nullptr;
+    }
+    auto value = std::make_shared<Value>();
+    value->total_nq = result.total_nq_;
+    value->unity_topK = result.unity_topK_;
+    value->total_data_cnt = result.total_data_cnt_;
+    value->distances = result.distances_;
+    value->seg_offsets = result.seg_offsets_;
+    value->group_by_values = result.group_by_values_;
+    value->group_size = result.group_size_;
+    value->topk_per_nq_prefix_sum = result.topk_per_nq_prefix_sum_;
+    value->element_level = result.element_level_;
+    value->element_indices = result.element_indices_;
+    value->array_offsets = result.array_offsets_;
+
+    value->bytes = sizeof(Value) + sizeof(Entry) +
+                   value->distances.size() * sizeof(float) +
+                   value->seg_offsets.size() * sizeof(int64_t) +
+                   value->topk_per_nq_prefix_sum.size() * sizeof(size_t) +
+                   value->element_indices.size() * sizeof(int32_t);
+    if (value->group_by_values.has_value()) {
+        value->bytes +=
+            value->group_by_values->size() * sizeof(GroupByValueType);
+        for (const auto& group_by_value : *value->group_by_values) {
+            if (group_by_value.has_value() &&
+                std::holds_alternative<std::string>(*group_by_value)) {
+                value->bytes += std::get<std::string>(*group_by_value).size();
+            }
+        }
+    }
+    return value;
+}
+
+void
+SearchResCacheManager::Restore(const Value& value, SearchResult& result) {
+    result.total_nq_ = value.total_nq;
+    result.unity_topK_ = value.unity_topK;
+    result.total_data_cnt_ = value.total_data_cnt;
+    result.distances_ = value.distances;
+    result.seg_offsets_ = value.seg_offsets;
+    result.group_by_values_ = value.group_by_values;
+    result.group_size_ = value.group_size;
+    result.topk_per_nq_prefix_sum_ = value.topk_per_nq_prefix_sum;
+    result.element_level_ = value.element_level;
+    result.element_indices_ = value.element_indices;
+    result.array_offsets_ = value.array_offsets;
+}
+
+void
+SearchResCacheManager::SetCapacityBytes(size_t capacity_bytes) {
+    capacity_bytes_.store(capacity_bytes);
+    EnsureCapacity();
+}
+
+size_t
+SearchResCacheManager::GetCapacityBytes() const {
+    return capacity_bytes_.load();
+}
+
+size_t
+SearchResCacheManager::GetCurrentBytes() const {
+    return current_bytes_.load();
+}
+
+size_t
+SearchResCacheManager::GetEntryCount() const {
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        count += shard.map.size();
+    }
+    return count;
+}
+
+SearchResCacheManager::Stats
+SearchResCacheManager::GetStats() const {
+    Stats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.rejections = rejections_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+SearchResCacheManager::Shard&
+SearchResCacheManager::GetShard(int64_t segment_id) {
+    return shards_[std::hash<int64_t>{}(segment_id) % kNumShards];
+}
+
+std::shared_ptr<const SearchResCacheManager::Value>
+SearchResCacheManager::Get(const Key& key, const Watermark& watermark) {
+    if (!IsEnabled()) {
+        return nullptr;
+    }
+
+    auto& shard = GetShard(key.segment_id);
+    {
+        std::lock_guard<std::mutex> lock(shard.sketch_mutex);
+        shard.sketch.Increment(KeyHasher{}(key));
+    }
+    std::shared_ptr<const Value> value;
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.map.find(key);
+        // a result of an older watermark is replaced by the next Put
+        if (it != shard.map.end() && it->second.watermark == watermark) {
+            value = it->second.value;
+            if (!it->second.referenced.load(std::memory_order_relaxed)) {
+                it->second.referenced.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+    if (value == nullptr) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        monitor::internal_core_search_res_cache_miss.Increment();
+        return nullptr;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    monitor::internal_core_search_res_cache_hit.Increment();
+    return value;
+}
+
+void
+SearchResCacheManager::Put(const Key& key,
+                           const Watermark& watermark,
+                           std::shared_ptr<const Value> value) {
+    if (!IsEnabled()) {
+        return;
+    }
+
+    AssertInfo(value != nullptr, "search res cache value is null");
+    auto bytes = value->bytes;
+    if (bytes > capacity_bytes_.load()) {
+        rejections_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    auto shard_idx = std::hash<int64_t>{}(key.segment_id) % kNumShards;
+    auto& shard = shards_[shard_idx];
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (current_bytes_.load() + bytes > capacity_bytes_.load() &&
+            shard.map.find(key) == shard.map.end()) {
+            auto victim = NextVictim(shard);
+            if (victim != shard.map.end()) {
+                std::lock_guard<std::mutex> sketch_lock(shard.sketch_mutex);
+                if (shard.sketch.Estimate(KeyHasher{}(key)) <
+                    shard.sketch.Estimate(KeyHasher{}(victim->first))) {
+                    rejections_.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+        }
+        auto [it, inserted] = shard.map.try_emplace(key);
+        auto& entry = it->second;
+        if (inserted) {
+            entry.ring_it = shard.ring.insert(shard.ring.end(), key);
+            if (shard.hand == shard.ring.end()) {
+                shard.hand = entry.ring_it;
+            }
+        } else {
+            shard.bytes.fetch_sub(entry.value->bytes);
+            current_bytes_.fetch_sub(entry.value->bytes);
+        }
+        entry.value = std::move(value);
+        entry.watermark = watermark;
+        shard.bytes.fetch_add(bytes);
+        current_bytes_.fetch_add(bytes);
+    }
+
+    if (current_bytes_.load() > capacity_bytes_.load()) {
+        EnsureCapacity(shard_idx);
+    }
+    monitor::internal_core_search_res_cache_bytes_all.Set(
+        current_bytes_.load());
+}
+
+void
+SearchResCacheManager::Clear() {
+    for (auto& shard : shards_) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        current_bytes_.fetch_sub(shard.bytes.load());
+        shard.map.clear();
+        shard.ring.clear();
+        shard.hand = shard.ring.end();
+        shard.bytes.store(0);
+    }
+    monitor::internal_core_search_res_cache_bytes_all.Set(
+        current_bytes_.load());
+}
+
+void
+SearchResCacheManager::EraseEntry(Shard& shard, EntryMap::iterator map_it) {
+    auto ring_it = map_it->second.ring_it;
+    if (shard.hand == ring_it) {
+        shard.hand = shard.ring.erase(ring_it);
+    } else {
+        shard.ring.erase(ring_it);
+    }
+    if (shard.hand == shard.ring.end()) {
+        shard.hand = shard.ring.begin();
+    }
+    shard.bytes.fetch_sub(map_it->second.value->bytes);
+    current_bytes_.fetch_sub(map_it->second.value->bytes);
+    shard.map.erase(map_it);
+}
+
+SearchResCacheManager::EntryMap::iterator
+SearchResCacheManager::NextVictim(Shard& shard) {
+    if (shard.ring.empty()) {
+        return shard.map.end();
+    }
+    // every entry is visited at most twice: the first pass clears the
+    // reference bits, so the sweep always terminates
+    while (true) {
+        if (shard.hand == shard.ring.end()) {
+            shard.hand = shard.ring.begin();
+        }
+        auto map_it = shard.map.find(*shard.hand);
+        AssertInfo(map_it != shard.map.end(),
+                   "search res cache ring and map are inconsistent");
+        if (!map_it->second.referenced.exchange(false,
+                                                std::memory_order_relaxed)) {
+            return map_it;
+        }
+        ++shard.hand;
+    }
+}
+
+void
+SearchResCacheManager::EnsureCapacity(size_t first_shard) {
+    // evict from the shard which just grew first, then sweep the others
+    for (size_t i = 0; i < kNumShards; ++i) {
+        if (current_bytes_.load() <= capacity_bytes_.load()) {
+            break;
+        }
+        auto& shard = shards_[(first_shard + i) % kNumShards];
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        while (current_bytes_.load() > capacity_bytes_.load()) {
+            auto victim = NextVictim(shard);
+            if (victim == shard.map.end()) {
+                break;
+            }
+            EraseEntry(shard, victim);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+            monitor::internal_core_search_res_cache_eviction.Increment();
+        }
+    }
+}
+
+size_t
+SearchResCacheManager::EraseSegment(int64_t segment_id) {
+    size_t erased = 0;
+    auto& shard = GetShard(segment_id);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (auto it = shard.map.begin(); it != shard.map.end();) {
+            if (it->first.segment_id == segment_id) {
+                auto next = std::next(it);
+                EraseEntry(shard, it);
+                it = next;
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+    }
+    monitor::internal_core_search_res_cache_bytes_all.Set(
+        current_bytes_.load());
+    return erased;
+}
+
+}  // namespace milvus::segcore
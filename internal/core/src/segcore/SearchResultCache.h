@@ -0,0 +1,232 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/FrequencySketch.h"
+#include "common/QueryResult.h"
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// Process-level cache for the results of searches on sealed segments.
+//
+// Dashboards and recommendations send the same search again and again. A
+// sealed segment only changes by deletes and by loads, so the result of a
+// search is reused as long as the segment has the same watermark: the count
+// of its deletes and the generation its loads and drops bump.
+//
+// Queries are keyed by the hashes of their serialized plan and placeholder
+// group, and by the buckets of their timestamp and collection ttl watermark.
+// A hit may thus serve a result up to one bucket older than the query, the
+// cache is opt-in for the workloads that accept that.
+//
+// Eviction and admission follow ExprResCacheManager: entries are sharded by
+// segment id, a CLOCK ring per shard picks the victims, and TinyLFU rejects
+// entries looked up less often than the ones they would evict.
+class SearchResCacheManager {
+ public:
+    static constexpr size_t kNumShards = 16;
+    // width of the timestamp buckets of the keys
+    static constexpr uint64_t kTsBucketMs = 1000;
+
+    struct Key {
+        int64_t segment_id{0};
+        uint64_t plan_signature{0};
+        uint64_t placeholder_signature{0};
+        uint64_t ts_bucket{0};
+        uint64_t ttl_bucket{0};
+
+        bool
+        operator==(const Key& other) const {
+            return segment_id == other.segment_id &&
+                   plan_signature == other.plan_signature &&
+                   placeholder_signature == other.placeholder_signature &&
+                   ts_bucket == other.ts_bucket &&
+                   ttl_bucket == other.ttl_bucket;
+        }
+    };
+
+    struct KeyHasher {
+        size_t
+        operator()(const Key& k) const noexcept {
+            size_t h = std::hash<int64_t>{}(k.segment_id);
+            for (auto v : {k.plan_signature,
+                           k.placeholder_signature,
+                           k.ts_bucket,
+                           k.ttl_bucket}) {
+                h = h * 1315423911u ^ std::hash<uint64_t>{}(v);
+            }
+            return h;
+        }
+    };
+
+    // state of the segment a result was computed on
+    struct Watermark {
+        uint64_t generation{0};
+        int64_t deleted_count{0};
+
+        bool
+        operator==(const Watermark& other) const {
+            return generation == other.generation &&
+                   deleted_count == other.deleted_count;
+        }
+    };
+
+    // the fields of a SearchResult the search fills, before the primary keys
+    // and output fields are filled and the results are reduced
+    struct Value {
+        int64_t total_nq{0};
+        int64_t unity_topK{0};
+        int64_t total_data_cnt{0};
+        std::vector<float> distances;
+        std::vector<int64_t> seg_offsets;
+        std::optional<std::vector<GroupByValueType>> group_by_values;
+        std::optional<int64_t> group_size;
+        std::vector<size_t> topk_per_nq_prefix_sum;
+        bool element_level{false};
+        std::vector<int32_t> element_indices;
+        std::shared_ptr<const IArrayOffsets> array_offsets;
+        size_t bytes{0};
+    };
+
+    struct Stats {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+        uint64_t rejections{0};
+    };
+
+ public:
+    static SearchResCacheManager&
+    Instance();
+    static void
+    SetEnabled(bool enabled);
+    static bool
+    IsEnabled();
+
+    static uint64_t
+    TsBucket(Timestamp ts);
+
+    // the cached form of result, or nullptr if it holds iterators or
+    // buffers which can not be shared by several searches
+    static std::shared_ptr<const Value>
+    Capture(const SearchResult& result);
+
+    static void
+    Restore(const Value& value, SearchResult& result);
+
+    void
+    SetCapacityBytes(size_t capacity_bytes);
+    size_t
+    GetCapacityBytes() const;
+    size_t
+    GetCurrentBytes() const;
+    size_t
+    GetEntryCount() const;
+    Stats
+    GetStats() const;
+
+    // the result cached for key, or nullptr if there is none or it was
+    // computed on another watermark of the segment
+    std::shared_ptr<const Value>
+    Get(const Key& key, const Watermark& watermark);
+
+    void
+    Put(const Key& key,
+        const Watermark& watermark,
+        std::shared_ptr<const Value> value);
+
+    void
+    Clear();
+
+    // erase all entries of a segment, returns the number of erased entries
+    size_t
+    EraseSegment(int64_t segment_id);
+
+ private:
+    SearchResCacheManager() = default;
+
+    struct Entry {
+        std::shared_ptr<const Value> value;
+        Watermark watermark;
+        std::list<Key>::iterator ring_it;
+        // second-chance bit, set by hits without taking the exclusive lock
+        std::atomic<bool> referenced{false};
+    };
+
+    using EntryMap = std::unordered_map<Key, Entry, KeyHasher>;
+
+    // lookups a shard sketch is sized for
+    static constexpr size_t kSketchEntriesPerShard = 1024;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        EntryMap map;
+        // CLOCK ring in insertion order, hand points to the next candidate
+        std::list<Key> ring;
+        std::list<Key>::iterator hand = ring.end();
+        std::atomic<size_t> bytes{0};
+        // lookups by key hash, guarded by sketch_mutex as lookups only hold
+        // the shared lock
+        std::mutex sketch_mutex;
+        FrequencySketch sketch{kSketchEntriesPerShard};
+    };
+
+    Shard&
+    GetShard(int64_t segment_id);
+
+    // the entry CLOCK evicts next, clearing the reference bits it passes,
+    // or map.end() if the shard is empty. Caller must hold the exclusive lock.
+    EntryMap::iterator
+    NextVictim(Shard& shard);
+
+    // erase the entry pointed by map_it, caller must hold the exclusive lock
+    void
+    EraseEntry(Shard& shard, EntryMap::iterator map_it);
+
+    // evict entries until current bytes fits the capacity, starting from
+    // the shard with index first_shard
+    void
+    EnsureCapacity(size_t first_shard = 0);
+
+ private:
+    static std::atomic<bool> enabled_;
+    std::atomic<size_t> capacity_bytes_{64ull * 1024ull *
+                                        1024ull};  // default 64MB
+    std::atomic<size_t> current_bytes_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> rejections_{0};
+
+    std::array<Shard, kNumShards> shards_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,152 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "common/QueryResult.h"
+#include "segcore/SearchResultCache.h"
+
+using milvus::segcore::SearchResCacheManager;
+
+namespace {
+
+milvus::SearchResult
+MakeResult(int64_t nq, int64_t topk) {
+    milvus::SearchResult result;
+    result.total_nq_ = nq;
+    result.unity_topK_ = topk;
+    result.total_data_cnt_ = 1000;
+    for (int64_t i = 0; i < nq * topk; ++i) {
+        result.distances_.push_back(static_cast<float>(i));
+        result.seg_offsets_.push_back(i * 3);
+    }
+    return result;
+}
+
+SearchResCacheManager::Key
+MakeKey(int64_t segment_id, uint64_t plan_signature) {
+    return SearchResCacheManager::Key{segment_id, plan_signature, 7, 1, 0};
+}
+
+}  // namespace
+
+TEST(SearchResCacheManagerTest, PutGetRestore) {
+    auto& mgr = SearchResCacheManager::Instance();
+    SearchResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(1ULL << 20);
+
+    auto key = MakeKey(100, 42);
+    SearchResCacheManager::Watermark watermark{3, 5};
+    ASSERT_EQ(mgr.Get(key, watermark), nullptr);
+
+    auto result = MakeResult(2, 10);
+    auto value = SearchResCacheManager::Capture(result);
+    ASSERT_NE(value, nullptr);
+    mgr.Put(key, watermark, value);
+
+    auto cached = mgr.Get(key, watermark);
+    ASSERT_NE(cached, nullptr);
+    milvus::SearchResult restored;
+    SearchResCacheManager::Restore(*cached, restored);
+    EXPECT_EQ(restored.total_nq_, 2);
+    EXPECT_EQ(restored.unity_topK_, 10);
+    EXPECT_EQ(restored.total_data_cnt_, 1000);
+    EXPECT_EQ(restored.distances_, result.distances_);
+    EXPECT_EQ(restored.seg_offsets_, result.seg_offsets_);
+
+    // another query of the same segment
+    EXPECT_EQ(mgr.Get(MakeKey(100, 43), watermark), nullptr);
+
+    mgr.Clear();
+    SearchResCacheManager::SetEnabled(false);
+}
+
+TEST(SearchResCacheManagerTest, WatermarkInvalidates) {
+    auto& mgr = SearchResCacheManager::Instance();
+    SearchResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(1ULL << 20);
+
+    auto key = MakeKey(101, 42);
+    auto result = MakeResult(1, 5);
+    mgr.Put(key, {1, 0}, SearchResCacheManager::Capture(result));
+    ASSERT_NE(mgr.Get(key, {1, 0}), nullptr);
+    // a delete, then a load
+    EXPECT_EQ(mgr.Get(key, {1, 1}), nullptr);
+    EXPECT_EQ(mgr.Get(key, {2, 0}), nullptr);
+
+    // the next put replaces the stale entry
+    mgr.Put(key, {2, 1}, SearchResCacheManager::Capture(result));
+    EXPECT_EQ(mgr.GetEntryCount(), 1);
+    EXPECT_NE(mgr.Get(key, {2, 1}), nullptr);
+
+    mgr.Clear();
+    SearchResCacheManager::SetEnabled(false);
+}
+
+TEST(SearchResCacheManagerTest, EvictionAndEraseSegment) {
+    auto& mgr = SearchResCacheManager::Instance();
+    SearchResCacheManager::SetEnabled(true);
+    mgr.Clear();
+
+    auto result = MakeResult(4, 100);
+    auto value = SearchResCacheManager::Capture(result);
+    // room for a few entries only
+    mgr.SetCapacityBytes(value->bytes * 3);
+    for (uint64_t i = 0; i < 10; ++i) {
+        auto key = MakeKey(102, i);
+        // looked up before put, as a miss of Search does
+        mgr.Get(key, {0, 0});
+        mgr.Put(key, {0, 0}, value);
+        ASSERT_LE(mgr.GetCurrentBytes(), mgr.GetCapacityBytes());
+    }
+    auto stats = mgr.GetStats();
+    EXPECT_GT(stats.evictions + stats.rejections, 0);
+    EXPECT_LE(mgr.GetEntryCount(), 3);
+
+    mgr.Clear();
+    mgr.SetCapacityBytes(1ULL << 20);
+    mgr.Put(MakeKey(102, 0), {0, 0}, value);
+    mgr.Put(MakeKey(103, 0), {0, 0}, value);
+    mgr.Put(MakeKey(103, 1), {0, 0}, value);
+    EXPECT_EQ(mgr.EraseSegment(103), 2);
+    EXPECT_EQ(mgr.GetEntryCount(), 1);
+    EXPECT_EQ(mgr.Get(MakeKey(103, 0), {0, 0}), nullptr);
+
+    mgr.Clear();
+    EXPECT_EQ(mgr.GetCurrentBytes(), 0);
+    SearchResCacheManager::SetEnabled(false);
+}
+
+TEST(SearchResCacheManagerTest, IteratorsAreNotCaptured) {
+    auto result = MakeResult(1, 1);
+    result.vector_iterators_ =
+        std::vector<std::shared_ptr<milvus::VectorIterator>>{};
+    EXPECT_EQ(SearchResCacheManager::Capture(result), nullptr);
+}
+
+TEST(SearchResCacheManagerTest, DisabledCacheKeepsNothing) {
+    auto& mgr = SearchResCacheManager::Instance();
+    SearchResCacheManager::SetEnabled(false);
+    mgr.Clear();
+    auto result = MakeResult(1, 1);
+    mgr.Put(MakeKey(104, 1), {0, 0}, SearchResCacheManager::Capture(result));
+    EXPECT_EQ(mgr.GetEntryCount(), 0);
+    EXPECT_EQ(mgr.Get(MakeKey(104, 1), {0, 0}), nullptr);
+}
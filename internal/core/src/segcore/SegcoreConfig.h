@@ -73,6 +73,48 @@ class SegcoreConfig {
         return enable_interim_segment_index_;
     }
 
+    void
+    set_enable_growing_scalar_index(bool enable_growing_scalar_index) {
+        this->enable_growing_scalar_index_ = enable_growing_scalar_index;
+    }
+
+    bool
+    get_enable_growing_scalar_index() const {
+        return enable_growing_scalar_index_;
+    }
+
+    void
+    set_enable_growing_vector_mirror(bool enable_growing_vector_mirror) {
+        this->enable_growing_vector_mirror_ = enable_growing_vector_mirror;
+    }
+
+    bool
+    get_enable_growing_vector_mirror() const {
+        return enable_growing_vector_mirror_;
+    }
+
+    void
+    set_enable_growing_minhash_lsh(bool enable_growing_minhash_lsh) {
+        this->enable_growing_minhash_lsh_ = enable_growing_minhash_lsh;
+    }
+
+    bool
+    get_enable_growing_minhash_lsh() const {
+        return enable_growing_minhash_lsh_;
+    }
+
+    void
+    set_enable_growing_sparse_inverted_index(
+        bool enable_growing_sparse_inverted_index) {
+        this->enable_growing_sparse_inverted_index_ =
+            enable_growing_sparse_inverted_index;
+    }
+
+    bool
+    get_enable_growing_sparse_inverted_index() const {
+        return enable_growing_sparse_inverted_index_;
+    }
+
     void
     set_sub_dim(int64_t sub_dim) {
         sub_dim_ = sub_dim;
@@ -147,6 +189,46 @@ class SegcoreConfig {
         return refine_with_quant_flag_;
     }
 
+    void
+    set_enable_interim_index_async_build(bool enable) {
+        enable_interim_index_async_build_ = enable;
+    }
+
+    bool
+    get_enable_interim_index_async_build() const {
+        return enable_interim_index_async_build_;
+    }
+
+    void
+    set_enable_growing_string_arena(bool enable) {
+        enable_growing_string_arena_ = enable;
+    }
+
+    bool
+    get_enable_growing_string_arena() const {
+        return enable_growing_string_arena_;
+    }
+
+    void
+    set_vector_group_chunk_cell_size(int64_t size) {
+        vector_group_chunk_cell_size_ = size;
+    }
+
+    int64_t
+    get_vector_group_chunk_cell_size() const {
+        return vector_group_chunk_cell_size_;
+    }
+
+    void
+    set_scalar_group_chunk_cell_size(int64_t size) {
+        scalar_group_chunk_cell_size_ = size;
+    }
+
+    int64_t
+    get_scalar_group_chunk_cell_size() const {
+        return scalar_group_chunk_cell_size_;
+    }
+
     void
     set_enable_geometry_cache(bool enable_geometry_cache) {
         enable_geometry_cache_ = enable_geometry_cache;
@@ -174,7 +256,19 @@ class SegcoreConfig {
             knowhere::IndexEnum::INDEX_FAISS_SCANN_DVR,
     };
     inline static bool enable_interim_segment_index_ = false;
+    // build the first interim index of a growing segment off the insert
+    inline static bool enable_interim_index_async_build_ = false;
+    inline static bool enable_growing_scalar_index_ = false;
+    inline static bool enable_growing_vector_mirror_ = false;
+    inline static bool enable_growing_minhash_lsh_ = false;
+    inline static bool enable_growing_sparse_inverted_index_ = false;
+    // growing string columns keep views into arenas instead of std::string
+    inline static bool enable_growing_string_arena_ = false;
     inline static int64_t chunk_rows_ = 32 * 1024;
+    // target bytes of a sealed column group cell, 0 for a fixed number of
+    // row groups per cell
+    inline static int64_t vector_group_chunk_cell_size_ = 0;
+    inline static int64_t scalar_group_chunk_cell_size_ = 0;
     inline static int64_t nlist_ = 100;
     inline static int64_t nprobe_ = 4;
     inline static int64_t sub_dim_ = 2;
@@ -106,9 +106,7 @@ SegmentChunkReader::GetMultipleChunkDataAccessor<std::string>(
         }
     }
     if (segment_->type() == SegmentType::Growing &&
-        !storage::MmapManager::GetInstance()
-             .GetMmapConfig()
-             .growing_enable_mmap) {
+        !GrowingStringChunkHoldsViews()) {
         auto pw = segment_->chunk_data<std::string>(
             op_ctx_, field_id, current_chunk_id);
         auto chunk_info = pw.get();
@@ -268,9 +266,7 @@ SegmentChunkReader::GetChunkDataAccessor<std::string>(
         }
     }
     if (segment_->type() == SegmentType::Growing &&
-        !storage::MmapManager::GetInstance()
-             .GetMmapConfig()
-             .growing_enable_mmap) {
+        !GrowingStringChunkHoldsViews()) {
         auto pw =
             segment_->chunk_data<std::string>(op_ctx_, field_id, chunk_id);
         return [pw = std::move(pw)](int i) mutable -> const data_access_type {
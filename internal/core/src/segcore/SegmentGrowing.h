@@ -34,6 +34,16 @@ class SegmentGrowing : public SegmentInternalInterface {
            const Timestamp* timestamps,
            InsertRecordProto* insert_record_proto) = 0;
 
+    // Inserts the rows as Insert does, and deletes the rows of this segment
+    // with the same pks and older timestamps, before the new rows turn
+    // visible. The rows of other segments are left to the caller to delete.
+    virtual void
+    Upsert(int64_t reserved_offset,
+           int64_t size,
+           const int64_t* row_ids,
+           const Timestamp* timestamps,
+           InsertRecordProto* insert_record_proto) = 0;
+
     SegmentType
     type() const override {
         return SegmentType::Growing;
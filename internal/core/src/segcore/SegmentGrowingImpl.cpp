@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -18,6 +20,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <boost/iterator/counting_iterator.hpp>
 #include <type_traits>
 #include <unordered_map>
@@ -31,6 +34,7 @@
 #include "common/Json.h"
 #include "common/Types.h"
 #include "common/Common.h"
+#include "common/Utils.h"
 #include "fmt/format.h"
 #include "log/Log.h"
 #include "nlohmann/json.hpp"
@@ -40,6 +44,7 @@
 #include "segcore/SegmentGrowingImpl.h"
 #include "segcore/SegmentGrowing.h"
 #include "segcore/memory_planner.h"
+#include "segcore/ParquetMetaCache.h"
 #include "storage/RemoteChunkManagerSingleton.h"
 #include "storage/loon_ffi/property_singleton.h"
 #include "storage/loon_ffi/util.h"
@@ -460,6 +465,65 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
                            const int64_t* row_ids,
                            const Timestamp* timestamps_raw,
                            InsertRecordProto* insert_record_proto) {
+    InsertRows(reserved_offset,
+               num_rows,
+               row_ids,
+               timestamps_raw,
+               insert_record_proto,
+               false);
+}
+
+void
+SegmentGrowingImpl::Upsert(int64_t reserved_offset,
+                           int64_t num_rows,
+                           const int64_t* row_ids,
+                           const Timestamp* timestamps_raw,
+                           InsertRecordProto* insert_record_proto) {
+    InsertRows(reserved_offset,
+               num_rows,
+               row_ids,
+               timestamps_raw,
+               insert_record_proto,
+               true);
+}
+
+void
+SegmentGrowingImpl::ReplacePks(const std::vector<PkType>& pks,
+                               int64_t reserved_offset,
+                               const Timestamp* timestamps) {
+    std::vector<PkType> deleted_pks;
+    std::vector<Timestamp> deleted_timestamps;
+    std::vector<std::vector<int64_t>> deleted_offsets;
+    for (size_t i = 0; i < pks.size(); ++i) {
+        auto offsets =
+            insert_record_.find_and_insert_pk(pks[i], reserved_offset + i);
+        // as a delete at the timestamp, it misses the rows inserted later
+        offsets.erase(std::remove_if(offsets.begin(),
+                                     offsets.end(),
+                                     [&](int64_t offset) {
+                                         return insert_record_
+                                                    .timestamps_[offset] >=
+                                                timestamps[i];
+                                     }),
+                      offsets.end());
+        if (!offsets.empty()) {
+            deleted_pks.push_back(pks[i]);
+            deleted_timestamps.push_back(timestamps[i]);
+            deleted_offsets.push_back(std::move(offsets));
+        }
+    }
+    // the timestamps of an insert are ordered, as the deletes must be
+    deleted_record_.StreamPushOffsets(
+        deleted_pks, deleted_timestamps.data(), deleted_offsets);
+}
+
+void
+SegmentGrowingImpl::InsertRows(int64_t reserved_offset,
+                               int64_t num_rows,
+                               const int64_t* row_ids,
+                               const Timestamp* timestamps_raw,
+                               InsertRecordProto* insert_record_proto,
+                               bool upsert) {
     AssertInfo(insert_record_proto->num_rows() == num_rows,
                "Entities_raw count not equal to insert size");
     // protect schema being changed during insert
@@ -510,46 +574,40 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
         reserved_offset, timestamps_raw, num_rows);
     stats_.mem_size += num_rows * sizeof(Timestamp);
 
-    for (auto& [field_id, field_meta] : schema_->get_fields()) {
-        if (field_id.get() < START_USER_FIELDID) {
-            continue;
-        }
-        AssertInfo(field_id_to_offset.count(field_id),
-                   fmt::format("can't find field {}", field_id.get()));
-        auto data_offset = field_id_to_offset[field_id];
+    // the fields are appended independently of each other, on the pool
+    // once a batch is large enough to outweigh the handoff. Rows become
+    // visible only through ack_responder_ below, after all of them.
+    auto insert_field = [&](FieldId field_id,
+                            const FieldMeta& field_meta,
+                            int64_t data_offset) {
+        const auto* field_data = &insert_record_proto->fields_data(data_offset);
         if (field_meta.is_nullable()) {
             insert_record_.get_valid_data(field_id)->set_data_raw(
-                num_rows,
-                &insert_record_proto->fields_data(data_offset),
-                field_meta);
+                num_rows, field_data, field_meta);
         }
         if (!indexing_record_.HasRawData(field_id)) {
             insert_record_.get_data_base(field_id)->set_data_raw(
-                reserved_offset,
-                num_rows,
-                &insert_record_proto->fields_data(data_offset),
-                field_meta);
+                reserved_offset, num_rows, field_data, field_meta);
+            if (field_meta.enable_growing_jsonStats()) {
+                AddJsonStatsRows(field_id, reserved_offset, num_rows);
+            }
         }
 
         //insert vector data into index
         if (segcore_config_.get_enable_interim_segment_index()) {
-            indexing_record_.AppendingIndex(
-                reserved_offset,
-                num_rows,
-                field_id,
-                &insert_record_proto->fields_data(data_offset),
-                insert_record_,
-                field_meta);
+            indexing_record_.AppendingIndex(reserved_offset,
+                                            num_rows,
+                                            field_id,
+                                            field_data,
+                                            insert_record_,
+                                            field_meta);
         }
 
         // update ArrayOffsetsGrowing for struct fields
         if (struct_representative_fields_.count(field_id) > 0) {
-            const auto& field_data =
-                insert_record_proto->fields_data(data_offset);
-
             std::vector<int32_t> array_lengths(num_rows);
             ExtractArrayLengths(
-                field_data, field_meta, num_rows, array_lengths.data());
+                *field_data, field_meta, num_rows, array_lengths.data());
 
             auto offsets_it = array_offsets_map_.find(field_id);
             if (offsets_it != array_offsets_map_.end()) {
@@ -562,23 +620,10 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
         if (field_meta.enable_match()) {
             // TODO: iterate texts and call `AddText` instead of `AddTexts`. This may cost much more memory.
             std::vector<std::string> texts(
-                insert_record_proto->fields_data(data_offset)
-                    .scalars()
-                    .string_data()
-                    .data()
-                    .begin(),
-                insert_record_proto->fields_data(data_offset)
-                    .scalars()
-                    .string_data()
-                    .data()
-                    .end());
-            FixedVector<bool> texts_valid_data(
-                insert_record_proto->fields_data(data_offset)
-                    .valid_data()
-                    .begin(),
-                insert_record_proto->fields_data(data_offset)
-                    .valid_data()
-                    .end());
+                field_data->scalars().string_data().data().begin(),
+                field_data->scalars().string_data().data().end());
+            FixedVector<bool> texts_valid_data(field_data->valid_data().begin(),
+                                               field_data->valid_data().end());
             AddTexts(field_id,
                      texts.data(),
                      texts_valid_data.data(),
@@ -587,27 +632,80 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
         }
 
         // update average row data size
-        auto field_data_size = GetRawDataSizeOfDataArray(
-            &insert_record_proto->fields_data(data_offset),
-            field_meta,
-            num_rows);
+        auto field_data_size =
+            GetRawDataSizeOfDataArray(field_data, field_meta, num_rows);
         if (IsVariableDataType(field_meta.get_data_type())) {
             SegmentInternalInterface::set_field_avg_size(
                 field_id, num_rows, field_data_size);
         }
 
-        // Build geometry cache for GEOMETRY fields
-        if (field_meta.get_data_type() == DataType::GEOMETRY &&
-            segcore_config_.get_enable_geometry_cache()) {
-            BuildGeometryCacheForInsert(
-                field_id,
-                &insert_record_proto->fields_data(data_offset),
-                num_rows);
-        }
-
         stats_.mem_size += field_data_size;
 
         try_remove_chunks(field_id);
+    };
+
+    std::vector<std::tuple<FieldId, const FieldMeta*, int64_t>> user_fields;
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        if (field_id.get() < START_USER_FIELDID) {
+            continue;
+        }
+        AssertInfo(field_id_to_offset.count(field_id),
+                   fmt::format("can't find field {}", field_id.get()));
+        user_fields.emplace_back(
+            field_id, &field_meta, field_id_to_offset[field_id]);
+    }
+
+    constexpr int64_t kParallelInsertRows = 1024;
+    if (num_rows >= kParallelInsertRows && user_fields.size() > 1) {
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        std::vector<std::future<void>> futures;
+        futures.reserve(user_fields.size() - 1);
+        for (size_t i = 1; i < user_fields.size(); ++i) {
+            futures.emplace_back(pool.Submit([&, i] {
+                auto [field_id, field_meta, data_offset] = user_fields[i];
+                insert_field(field_id, *field_meta, data_offset);
+            }));
+        }
+        // the calling thread takes the first field, and every future is
+        // waited for before any failure is rethrown, as they borrow this
+        // frame
+        std::exception_ptr insert_exception;
+        try {
+            auto [field_id, field_meta, data_offset] = user_fields[0];
+            insert_field(field_id, *field_meta, data_offset);
+        } catch (...) {
+            insert_exception = std::current_exception();
+        }
+        for (auto& future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!insert_exception) {
+                    insert_exception = std::current_exception();
+                }
+            }
+        }
+        if (insert_exception) {
+            std::rethrow_exception(insert_exception);
+        }
+    } else {
+        for (auto& [field_id, field_meta, data_offset] : user_fields) {
+            insert_field(field_id, *field_meta, data_offset);
+        }
+    }
+
+    // Build geometry cache for GEOMETRY fields, on this thread as the
+    // geometries are parsed with the GEOS context of the segment
+    if (segcore_config_.get_enable_geometry_cache()) {
+        for (auto& [field_id, field_meta, data_offset] : user_fields) {
+            if (field_meta->get_data_type() == DataType::GEOMETRY) {
+                BuildGeometryCacheForInsert(
+                    field_id,
+                    &insert_record_proto->fields_data(data_offset),
+                    num_rows);
+            }
+        }
     }
 
     // step 4: set pks to offset
@@ -616,8 +714,12 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     std::vector<PkType> pks(num_rows);
     ParsePksFromFieldData(
         pks, insert_record_proto->fields_data(field_id_to_offset[field_id]));
-    for (int i = 0; i < num_rows; ++i) {
-        insert_record_.insert_pk(pks[i], reserved_offset + i);
+    if (upsert) {
+        ReplacePks(pks, reserved_offset, timestamps_raw);
+    } else {
+        for (int i = 0; i < num_rows; ++i) {
+            insert_record_.insert_pk(pks[i], reserved_offset + i);
+        }
     }
 
     // step 5: update the resource usage
@@ -626,6 +728,10 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     // step 6: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    BuildGrowingScalarIndexes();
+    BuildGrowingVectorMirrors();
+    BuildGrowingMinHashLSHs();
+    BuildGrowingSparseInvertedIndexes();
 }
 
 void
@@ -710,6 +816,10 @@ SegmentGrowingImpl::load_field_data_internal(const LoadFieldDataInfo& infos) {
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    BuildGrowingScalarIndexes();
+    BuildGrowingVectorMirrors();
+    BuildGrowingMinHashLSHs();
+    BuildGrowingSparseInvertedIndexes();
 }
 
 void
@@ -740,6 +850,9 @@ SegmentGrowingImpl::load_field_data_common(
         }
         insert_record_.get_data_base(field_id)->set_data_raw(reserved_offset,
                                                              field_data);
+        if (field_meta.enable_growing_jsonStats()) {
+            AddJsonStatsRows(field_id, reserved_offset, num_rows);
+        }
     }
     if (segcore_config_.get_enable_interim_segment_index()) {
         auto offset = reserved_offset;
@@ -832,27 +945,12 @@ SegmentGrowingImpl::load_column_group_data_internal(
         std::vector<std::vector<int64_t>> row_group_lists;
         row_group_lists.reserve(insert_files.size());
         for (const auto& file : insert_files) {
-            auto result = milvus_storage::FileRowGroupReader::Make(
-                fs,
-                file,
-                milvus_storage::DEFAULT_READ_BUFFER_SIZE,
-                storage::GetReaderProperties());
-            AssertInfo(result.ok(),
-                       "[StorageV2] Failed to create file row group reader: " +
-                           result.status().ToString());
-            auto reader = result.ValueOrDie();
-            auto row_group_num =
-                reader->file_metadata()->GetRowGroupMetadataVector().size();
+            auto row_group_num = ParquetMetaCache::Instance()
+                                     .Get(fs, file)
+                                     ->row_group_metas.size();
             std::vector<int64_t> all_row_groups(row_group_num);
             std::iota(all_row_groups.begin(), all_row_groups.end(), 0);
             row_group_lists.push_back(all_row_groups);
-            auto status = reader->Close();
-            AssertInfo(
-                status.ok(),
-                "[StorageV2] failed to close file reader when get row group "
-                "metadata from file {} with error {}",
-                file,
-                status.ToString());
         }
 
         // create parallel degree split strategy
@@ -939,6 +1037,10 @@ SegmentGrowingImpl::load_column_group_data_internal(
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    BuildGrowingScalarIndexes();
+    BuildGrowingVectorMirrors();
+    BuildGrowingMinHashLSHs();
+    BuildGrowingSparseInvertedIndexes();
 }
 
 SegcoreError
@@ -1766,15 +1868,22 @@ SegmentGrowingImpl::mask_with_timestamps(BitsetTypeView& bitset_chunk,
             bitset_chunk.set();
             return;
         }
+        // rows [0, pilot) are expired
         auto pilot = upper_bound(timestamps, 0, size, collection_ttl);
-        BitsetType bitset;
-        bitset.reserve(size);
-        bitset.resize(pilot, true);
-        bitset.resize(size, false);
-        bitset_chunk |= bitset;
+        bitset_chunk.set(0, pilot);
     }
 }
 
+bool
+SegmentGrowingImpl::all_visible_at(Timestamp timestamp,
+                                   Timestamp collection_ttl) const {
+    // get_active_count() already stops before the rows after timestamp
+    if (collection_ttl == 0 || get_row_count() == 0) {
+        return true;
+    }
+    return get_timestamps()[0] > collection_ttl;
+}
+
 void
 SegmentGrowingImpl::CreateTextIndex(FieldId field_id,
                                     milvus::OpContext* op_ctx) {
@@ -1835,6 +1944,252 @@ SegmentGrowingImpl::AddTexts(milvus::FieldId field_id,
     }
 }
 
+void
+SegmentGrowingImpl::SetJsonKeyLayoutHints(index::JsonKeyLayoutHintsPtr hints) {
+    std::unique_lock lock(mutex_);
+    json_key_layout_hints_ = hints;
+    if (hints == nullptr) {
+        return;
+    }
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        if (field_meta.enable_growing_jsonStats() &&
+            growing_json_stats_.find(field_id) == growing_json_stats_.end()) {
+            growing_json_stats_[field_id] =
+                std::make_shared<index::GrowingJsonKeyStats>(
+                    field_id, hints, segcore_config_.get_chunk_rows());
+        }
+    }
+}
+
+std::shared_ptr<const index::GrowingJsonKeyStats>
+SegmentGrowingImpl::GetGrowingJsonStats(FieldId field_id) const {
+    std::shared_lock lock(mutex_);
+    auto iter = growing_json_stats_.find(field_id);
+    if (iter == growing_json_stats_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+void
+SegmentGrowingImpl::CreateGrowingScalarIndexes() {
+    if (!segcore_config_.get_enable_growing_scalar_index() ||
+        storage::MmapManager::GetInstance()
+            .GetMmapConfig()
+            .GetEnableGrowingMmap()) {
+        return;
+    }
+    auto pk_field_id =
+        schema_->get_primary_field_id().value_or(FieldId(-1));
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        // the pk has its own offset index, and null rows would need the
+        // validity the scan applies
+        if (field_id.get() < START_USER_FIELDID || field_id == pk_field_id ||
+            field_meta.is_nullable()) {
+            continue;
+        }
+        auto index =
+            CreateGrowingScalarIndex(field_meta,
+                                     insert_record_.get_data_base(field_id),
+                                     segcore_config_.get_chunk_rows());
+        if (index != nullptr) {
+            growing_scalar_indexes_[field_id] = std::move(index);
+        }
+    }
+}
+
+void
+SegmentGrowingImpl::BuildGrowingScalarIndexes() {
+    if (growing_scalar_indexes_.empty()) {
+        return;
+    }
+    auto num_rows = insert_record_.ack_responder_.GetAck();
+    for (auto& [_, index] : growing_scalar_indexes_) {
+        index->Build(num_rows);
+    }
+}
+
+std::shared_ptr<const GrowingScalarIndexBase>
+SegmentGrowingImpl::GetGrowingScalarIndex(FieldId field_id) const {
+    auto iter = growing_scalar_indexes_.find(field_id);
+    if (iter == growing_scalar_indexes_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+void
+SegmentGrowingImpl::CreateGrowingVectorMirrors() {
+    if (!segcore_config_.get_enable_growing_vector_mirror() ||
+        storage::MmapManager::GetInstance()
+            .GetMmapConfig()
+            .GetEnableGrowingMmap()) {
+        return;
+    }
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        // null rows are not stored, so offsets would not map to rows
+        if (field_meta.get_data_type() != DataType::VECTOR_FLOAT ||
+            field_meta.is_nullable()) {
+            continue;
+        }
+        growing_vector_mirrors_[field_id] =
+            std::make_shared<GrowingVectorMirror>(
+                insert_record_.get_data_base(field_id),
+                field_meta.get_dim(),
+                segcore_config_.get_chunk_rows());
+    }
+}
+
+void
+SegmentGrowingImpl::BuildGrowingVectorMirrors() {
+    if (growing_vector_mirrors_.empty()) {
+        return;
+    }
+    auto num_rows = insert_record_.ack_responder_.GetAck();
+    for (auto& [_, mirror] : growing_vector_mirrors_) {
+        mirror->Build(num_rows);
+    }
+}
+
+GrowingVectorMirrorPtr
+SegmentGrowingImpl::GetGrowingVectorMirror(FieldId field_id) const {
+    auto iter = growing_vector_mirrors_.find(field_id);
+    if (iter == growing_vector_mirrors_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+void
+SegmentGrowingImpl::CreateGrowingMinHashLSHs() {
+    if (!segcore_config_.get_enable_growing_minhash_lsh() ||
+        index_meta_ == nullptr ||
+        storage::MmapManager::GetInstance()
+            .GetMmapConfig()
+            .GetEnableGrowingMmap()) {
+        return;
+    }
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        // null rows are not stored, so offsets would not map to rows
+        if (field_meta.get_data_type() != DataType::VECTOR_BINARY ||
+            field_meta.is_nullable() || !index_meta_->HasField(field_id)) {
+            continue;
+        }
+        // the bands come from the index the sealed segment will have
+        const auto& index_params =
+            index_meta_->GetFieldIndexMeta(field_id).GetIndexParams();
+        auto metric = index_params.find(knowhere::meta::METRIC_TYPE);
+        auto band = index_params.find(knowhere::indexparam::MH_LSH_BAND);
+        if (metric == index_params.end() ||
+            !IsMetricType(metric->second, knowhere::metric::MHJACCARD) ||
+            band == index_params.end()) {
+            continue;
+        }
+        auto width =
+            index_params.find(knowhere::indexparam::MH_ELEMENT_BIT_WIDTH);
+        auto element_bit_width =
+            width == index_params.end() ? 32 : std::stoll(width->second);
+        growing_minhash_lshs_[field_id] = std::make_shared<GrowingMinHashLSH>(
+            insert_record_.get_data_base(field_id),
+            field_meta.get_dim(),
+            segcore_config_.get_chunk_rows(),
+            element_bit_width,
+            std::stoll(band->second));
+    }
+}
+
+void
+SegmentGrowingImpl::BuildGrowingMinHashLSHs() {
+    if (growing_minhash_lshs_.empty()) {
+        return;
+    }
+    auto num_rows = insert_record_.ack_responder_.GetAck();
+    for (auto& [_, lsh] : growing_minhash_lshs_) {
+        lsh->Build(num_rows);
+    }
+}
+
+GrowingMinHashLSHPtr
+SegmentGrowingImpl::GetGrowingMinHashLSH(FieldId field_id) const {
+    auto iter = growing_minhash_lshs_.find(field_id);
+    if (iter == growing_minhash_lshs_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+void
+SegmentGrowingImpl::CreateGrowingSparseInvertedIndexes() {
+    if (!segcore_config_.get_enable_growing_sparse_inverted_index() ||
+        index_meta_ == nullptr ||
+        storage::MmapManager::GetInstance()
+            .GetMmapConfig()
+            .GetEnableGrowingMmap()) {
+        return;
+    }
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        // null rows are not stored, so offsets would not map to rows; an
+        // interim index takes the field over once it is built
+        if (field_meta.get_data_type() != DataType::VECTOR_SPARSE_U32_F32 ||
+            field_meta.is_nullable() || !index_meta_->HasField(field_id) ||
+            indexing_record_.is_in(field_id)) {
+            continue;
+        }
+        const auto& index_params =
+            index_meta_->GetFieldIndexMeta(field_id).GetIndexParams();
+        auto metric = index_params.find(knowhere::meta::METRIC_TYPE);
+        if (metric == index_params.end() ||
+            !(IsMetricType(metric->second, knowhere::metric::IP) ||
+              IsMetricType(metric->second, knowhere::metric::BM25))) {
+            continue;
+        }
+        growing_sparse_inverted_indexes_[field_id] =
+            std::make_shared<GrowingSparseInvertedIndex>(
+                insert_record_.get_data_base(field_id),
+                segcore_config_.get_chunk_rows());
+    }
+}
+
+void
+SegmentGrowingImpl::BuildGrowingSparseInvertedIndexes() {
+    if (growing_sparse_inverted_indexes_.empty()) {
+        return;
+    }
+    auto num_rows = insert_record_.ack_responder_.GetAck();
+    for (auto& [_, index] : growing_sparse_inverted_indexes_) {
+        index->Build(num_rows);
+    }
+}
+
+GrowingSparseInvertedIndexPtr
+SegmentGrowingImpl::GetGrowingSparseInvertedIndex(FieldId field_id) const {
+    auto iter = growing_sparse_inverted_indexes_.find(field_id);
+    if (iter == growing_sparse_inverted_indexes_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+void
+SegmentGrowingImpl::AddJsonStatsRows(FieldId field_id,
+                                     int64_t offset,
+                                     int64_t n) {
+    std::shared_ptr<index::GrowingJsonKeyStats> stats;
+    {
+        std::shared_lock lock(mutex_);
+        auto iter = growing_json_stats_.find(field_id);
+        if (iter == growing_json_stats_.end()) {
+            return;
+        }
+        stats = iter->second;
+    }
+    auto valid_data = insert_record_.is_valid_data_exist(field_id)
+                          ? insert_record_.get_valid_data(field_id)
+                          : nullptr;
+    stats->AddRows(
+        offset, n, *insert_record_.get_data<Json>(field_id), valid_data);
+}
+
 void
 SegmentGrowingImpl::BulkGetJsonData(
     milvus::OpContext* op_ctx,
@@ -2040,6 +2395,10 @@ SegmentGrowingImpl::LoadColumnsGroups(std::string manifest_path) {
 
     insert_record_.ack_responder_.AddSegment(reserved_offset,
                                              reserved_offset + num_rows);
+    BuildGrowingScalarIndexes();
+    BuildGrowingVectorMirrors();
+    BuildGrowingMinHashLSHs();
+    BuildGrowingSparseInvertedIndexes();
 }
 
 std::unordered_map<FieldId, std::vector<FieldDataPtr>>
@@ -2263,15 +2622,14 @@ SegmentGrowingImpl::FilterVectorValidOffsets(milvus::OpContext* op_ctx,
             result.valid_data = std::make_unique<bool[]>(count);
             result.valid_offsets.reserve(count);
 
+            std::vector<int64_t> physical_offsets(count);
+            vec_index->GetOffsetMapping().GetPhysicalOffsets(
+                seg_offsets, count, physical_offsets.data());
             for (int64_t i = 0; i < count; ++i) {
-                bool is_valid = vec_index->IsRowValid(seg_offsets[i]);
+                bool is_valid = physical_offsets[i] >= 0;
                 result.valid_data[i] = is_valid;
                 if (is_valid) {
-                    int64_t physical_offset =
-                        vec_index->GetPhysicalOffset(seg_offsets[i]);
-                    if (physical_offset >= 0) {
-                        result.valid_offsets.push_back(physical_offset);
-                    }
+                    result.valid_offsets.push_back(physical_offsets[i]);
                 }
             }
             result.valid_count = result.valid_offsets.size();
@@ -2285,6 +2643,12 @@ SegmentGrowingImpl::FilterVectorValidOffsets(milvus::OpContext* op_ctx,
                 result.valid_data = std::make_unique<bool[]>(count);
                 result.valid_offsets.reserve(count);
 
+                std::vector<int64_t> physical_offsets;
+                if (is_mapping_storage) {
+                    physical_offsets.resize(count);
+                    vec_base->get_offset_mapping().GetPhysicalOffsets(
+                        seg_offsets, count, physical_offsets.data());
+                }
                 for (int64_t i = 0; i < count; ++i) {
                     auto offset = seg_offsets[i];
                     bool is_valid =
@@ -2292,14 +2656,9 @@ SegmentGrowingImpl::FilterVectorValidOffsets(milvus::OpContext* op_ctx,
                         offset < static_cast<int64_t>(valid_data_vec.size()) &&
                         valid_data_vec[offset];
                     result.valid_data[i] = is_valid;
-                    if (is_valid) {
-                        if (is_mapping_storage) {
-                            int64_t physical_offset =
-                                vec_base->get_physical_offset(offset);
-                            if (physical_offset >= 0) {
-                                result.valid_offsets.push_back(physical_offset);
-                            }
-                        }
+                    if (is_valid && is_mapping_storage &&
+                        physical_offsets[i] >= 0) {
+                        result.valid_offsets.push_back(physical_offsets[i]);
                     }
                 }
                 result.valid_count = result.valid_offsets.size();
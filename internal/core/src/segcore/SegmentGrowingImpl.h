@@ -28,6 +28,9 @@
 #include "ConcurrentVector.h"
 #include "DeletedRecord.h"
 #include "FieldIndexing.h"
+#include "GrowingMinHashLSH.h"
+#include "GrowingSparseInvertedIndex.h"
+#include "GrowingVectorMirror.h"
 #include "InsertRecord.h"
 #include "SealedIndexingRecord.h"
 #include "SegmentGrowing.h"
@@ -55,6 +58,13 @@ class SegmentGrowingImpl : public SegmentGrowing {
            const Timestamp* timestamps,
            InsertRecordProto* insert_record_proto) override;
 
+    void
+    Upsert(int64_t reserved_offset,
+           int64_t size,
+           const int64_t* row_ids,
+           const Timestamp* timestamps,
+           InsertRecordProto* insert_record_proto) override;
+
     bool
     Contain(const PkType& pk) const override {
         return insert_record_.contain(pk);
@@ -118,6 +128,22 @@ class SegmentGrowingImpl : public SegmentGrowing {
          milvus::OpContext* op_ctx = nullptr) override;
 
  private:
+    // Insert, or Upsert if upsert
+    void
+    InsertRows(int64_t reserved_offset,
+               int64_t size,
+               const int64_t* row_ids,
+               const Timestamp* timestamps,
+               InsertRecordProto* insert_record_proto,
+               bool upsert);
+
+    // indexes the rows from reserved_offset by pks, and deletes the rows with
+    // the same pks and older timestamps, one pk index probe per row
+    void
+    ReplacePks(const std::vector<PkType>& pks,
+               int64_t reserved_offset,
+               const Timestamp* timestamps);
+
     // Build geometry cache for inserted data
     void
     BuildGeometryCacheForInsert(FieldId field_id,
@@ -223,6 +249,27 @@ class SegmentGrowingImpl : public SegmentGrowing {
     int64_t
     get_active_count(Timestamp ts) const override;
 
+    void
+    SetJsonKeyLayoutHints(index::JsonKeyLayoutHintsPtr hints) override;
+
+    std::shared_ptr<const index::GrowingJsonKeyStats>
+    GetGrowingJsonStats(FieldId field_id) const override;
+
+    std::shared_ptr<const GrowingScalarIndexBase>
+    GetGrowingScalarIndex(FieldId field_id) const override;
+
+    // the SQ8 mirror of a float vector field, nullptr if it has none
+    GrowingVectorMirrorPtr
+    GetGrowingVectorMirror(FieldId field_id) const;
+
+    // the LSH buckets of a MinHash field, nullptr if it has none
+    GrowingMinHashLSHPtr
+    GetGrowingMinHashLSH(FieldId field_id) const;
+
+    // the posting lists of a sparse vector field, nullptr if it has none
+    GrowingSparseInvertedIndexPtr
+    GetGrowingSparseInvertedIndex(FieldId field_id) const;
+
     // for scalar vectors
     template <typename S, typename T = S>
     void
@@ -356,6 +403,10 @@ class SegmentGrowingImpl : public SegmentGrowing {
               },
               segment_id) {
         this->CreateTextIndexes();
+        this->CreateGrowingScalarIndexes();
+        this->CreateGrowingVectorMirrors();
+        this->CreateGrowingMinHashLSHs();
+        this->CreateGrowingSparseInvertedIndexes();
         this->InitializeArrayOffsets();
         this->UpdateResourceTracking();
     }
@@ -392,6 +443,10 @@ class SegmentGrowingImpl : public SegmentGrowing {
                          Timestamp timestamp,
                          Timestamp ttl = 0) const override;
 
+    bool
+    all_visible_at(Timestamp timestamp,
+                   Timestamp collection_ttl) const override;
+
     void
     vector_search(SearchInfo& search_info,
                   const void* query_data,
@@ -593,10 +648,15 @@ class SegmentGrowingImpl : public SegmentGrowing {
     }
 
     const ConcurrentVector<Timestamp>&
-    get_timestamps() const override {
+    get_timestamps() const {
         return insert_record_.timestamps_;
     }
 
+    Timestamp
+    get_timestamp(int64_t offset) const override {
+        return insert_record_.timestamps_[offset];
+    }
+
     void
     fill_empty_field(const FieldMeta& field_meta);
 
@@ -625,6 +685,39 @@ class SegmentGrowingImpl : public SegmentGrowing {
     void
     CreateTextIndexes();
 
+    void
+    CreateGrowingScalarIndexes();
+
+    // indexes the chunks the acknowledged rows have completed
+    void
+    BuildGrowingScalarIndexes();
+
+    void
+    CreateGrowingVectorMirrors();
+
+    // encodes the chunks the acknowledged rows have completed
+    void
+    BuildGrowingVectorMirrors();
+
+    void
+    CreateGrowingMinHashLSHs();
+
+    // hashes the chunks the acknowledged rows have completed
+    void
+    BuildGrowingMinHashLSHs();
+
+    void
+    CreateGrowingSparseInvertedIndexes();
+
+    // indexes the chunks the acknowledged rows have completed
+    void
+    BuildGrowingSparseInvertedIndexes();
+
+    // shreds rows [offset, offset + n) of a JSON field into its growing
+    // JSON key stats, if it has them
+    void
+    AddJsonStatsRows(FieldId field_id, int64_t offset, int64_t n);
+
     /**
      * @brief Load all column groups from a manifest file path
      *
@@ -689,6 +782,24 @@ class SegmentGrowingImpl : public SegmentGrowing {
     // One field_id per struct, since all fields in the same struct have identical array lengths
     std::unordered_set<FieldId> struct_representative_fields_;
 
+    // JSON fields with growing JSON key stats, set once with the layout hints
+    std::unordered_map<FieldId, std::shared_ptr<index::GrowingJsonKeyStats>>
+        growing_json_stats_;
+
+    // scalar fields with an interim index, set at creation
+    std::unordered_map<FieldId, GrowingScalarIndexPtr> growing_scalar_indexes_;
+
+    // float vector fields with an SQ8 mirror, set at creation
+    std::unordered_map<FieldId, GrowingVectorMirrorPtr> growing_vector_mirrors_;
+
+    // MinHash fields with a MINHASH_LSH index meta, set at creation
+    std::unordered_map<FieldId, GrowingMinHashLSHPtr> growing_minhash_lshs_;
+
+    // IP and BM25 sparse vector fields without an interim index, set at
+    // creation
+    std::unordered_map<FieldId, GrowingSparseInvertedIndexPtr>
+        growing_sparse_inverted_indexes_;
+
     // Tracked resource usage for refund-then-charge pattern
     // This stores the last estimated resource usage that was charged to the cache manager
     ResourceUsage tracked_resource_{};
@@ -106,6 +106,42 @@ TEST(Growing, RealCount) {
     ASSERT_EQ(0, segment->get_real_count());
 }
 
+TEST(Growing, Upsert) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+
+    int64_t c = 10;
+    auto dataset = DataGen(schema, c);
+    segment->PreInsert(c);
+    segment->Insert(0,
+                    c,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+    ASSERT_EQ(c, segment->get_real_count());
+
+    // upsert the same pks later, the first rows are deleted
+    auto tss = GenTss(c, 100);
+    segment->PreInsert(c);
+    segment->Upsert(c, c, dataset.row_ids_.data(), tss.data(), dataset.raw_);
+    ASSERT_EQ(c, segment->get_deleted_count());
+    ASSERT_EQ(c, segment->get_real_count());
+
+    // an upsert of new pks deletes nothing
+    auto other = DataGen(schema, c, 42, 0, 1, 10, 1, true);
+    auto other_tss = GenTss(c, 200);
+    segment->PreInsert(c);
+    segment->Upsert(2 * c,
+                    c,
+                    other.row_ids_.data(),
+                    other_tss.data(),
+                    other.raw_);
+    ASSERT_EQ(c, segment->get_deleted_count());
+    ASSERT_EQ(2 * c, segment->get_real_count());
+}
+
 class GrowingTest
     : public ::testing::TestWithParam<
           std::tuple</*index type*/ std::string, knowhere::MetricType>> {
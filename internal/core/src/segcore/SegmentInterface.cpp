@@ -19,11 +19,40 @@
 #include "common/Tracer.h"
 #include "common/Types.h"
 #include "monitor/Monitor.h"
+#include "plan/PlanNode.h"
 #include "query/ExecPlanNodeVisitor.h"
+#include "segcore/ReduceStructure.h"
 #include "futures/Future.h"
+#include "knowhere/comp/index_param.h"
 
 namespace milvus::segcore {
 
+namespace {
+thread_local const SegmentInternalInterface* bound_segment = nullptr;
+thread_local std::shared_ptr<const SealedCatalog> bound_snapshot;
+}  // namespace
+
+ScopedSegmentSnapshot::ScopedSegmentSnapshot(
+    const SegmentInternalInterface* segment,
+    std::shared_ptr<const SealedCatalog> snapshot)
+    : prev_segment_(bound_segment), prev_snapshot_(std::move(bound_snapshot)) {
+    bound_segment = segment;
+    bound_snapshot = std::move(snapshot);
+}
+
+ScopedSegmentSnapshot::~ScopedSegmentSnapshot() {
+    bound_segment = prev_segment_;
+    bound_snapshot = std::move(prev_snapshot_);
+}
+
+const std::shared_ptr<const SealedCatalog>*
+ScopedSegmentSnapshot::Current(const SegmentInternalInterface* segment) {
+    if (bound_segment != segment || bound_snapshot == nullptr) {
+        return nullptr;
+    }
+    return &bound_snapshot;
+}
+
 void
 SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan,
                                           SearchResult& results) const {
@@ -48,6 +77,13 @@ SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan,
     results.pk_type_ = DataType(field_data->type());
 
     ParsePksFromFieldData(results.primary_keys_, *field_data.get());
+    // hashed once here for the dedup of the reduce
+    if (results.pk_type_ == DataType::VARCHAR) {
+        results.pk_hashes_.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            results.pk_hashes_[i] = PkHash(results.primary_keys_[i]);
+        }
+    }
     results.search_storage_cost_.scanned_remote_bytes +=
         op_ctx.storage_usage.scanned_cold_bytes.load();
     results.search_storage_cost_.scanned_total_bytes +=
@@ -77,7 +113,8 @@ SegmentInternalInterface::FillTargetEntry(const query::Plan* plan,
                                         results.seg_offsets_.data(),
                                         size,
                                         target_dynamic_fields);
-        } else if (!is_field_exist(field_id)) {
+        } else if (!is_field_exist(field_id) ||
+                   is_default_value_field(field_id)) {
             field_data = bulk_subscript_not_exist_field(field_meta, size);
         } else {
             field_data = bulk_subscript(
@@ -114,6 +151,73 @@ SegmentInternalInterface::Search(
     return results;
 }
 
+void
+SegmentInternalInterface::SetClusteringCentroid(FieldId field_id,
+                                                ClusteringCentroid centroid) {
+    const auto& field_meta = get_schema()[field_id];
+    AssertInfo(field_meta.get_data_type() == DataType::VECTOR_FLOAT,
+               "clustering centroid for field {} which is not a float vector",
+               field_id.get());
+    AssertInfo(centroid.centroid_.size() == field_meta.get_dim() &&
+                   centroid.radius_ >= 0,
+               "invalid clustering centroid of dim {} and radius {} for "
+               "field {} of dim {}",
+               centroid.centroid_.size(),
+               centroid.radius_,
+               field_id.get(),
+               field_meta.get_dim());
+    std::unique_lock lck(mutex_);
+    clustering_centroids_[field_id] = std::move(centroid);
+}
+
+std::vector<float>
+SegmentInternalInterface::SearchDistanceBounds(
+    const query::Plan* plan,
+    const query::PlaceholderGroup* placeholder_group) const {
+    const auto& search_info = plan->plan_node_->search_info_;
+    // grouped, iterated, range, element level, rescored and rounded
+    // results are not ranked by the distances alone
+    if (search_info.round_decimal_ != -1 ||
+        search_info.group_by_field_id_.has_value() ||
+        search_info.iterative_filter_execution ||
+        search_info.iterator_v2_info_.has_value() ||
+        search_info.search_params_.contains(knowhere::meta::RADIUS) ||
+        search_info.element_level() ||
+        std::dynamic_pointer_cast<const plan::RescoresNode>(
+            plan->plan_node_->plannodes_) != nullptr ||
+        placeholder_group->size() != 1) {
+        return {};
+    }
+    const auto& placeholder = placeholder_group->at(0);
+    if (placeholder.element_level_ || !placeholder.offsets_.empty()) {
+        return {};
+    }
+
+    std::shared_lock lck(mutex_);
+    auto it = clustering_centroids_.find(search_info.field_id_);
+    if (it == clustering_centroids_.end()) {
+        return {};
+    }
+    const auto& ball = it->second;
+    auto dim = ball.centroid_.size();
+    auto num_queries = placeholder.num_of_queries_;
+    if (placeholder.blob_.size() != num_queries * dim * sizeof(float)) {
+        return {};
+    }
+    auto queries = reinterpret_cast<const float*>(placeholder.get_blob());
+    std::vector<float> bounds;
+    bounds.reserve(num_queries);
+    for (int64_t i = 0; i < num_queries; ++i) {
+        auto bound = BestDistanceBound(
+            search_info.metric_type_, queries + i * dim, ball);
+        if (!bound.has_value()) {
+            return {};
+        }
+        bounds.push_back(bound.value());
+    }
+    return bounds;
+}
+
 std::unique_ptr<proto::segcore::RetrieveResults>
 SegmentInternalInterface::Retrieve(tracer::TraceContext* trace_ctx,
                                    const query::RetrievePlan* plan,
@@ -246,7 +350,7 @@ SegmentInternalInterface::FillTargetEntry(
         }
         std::unique_ptr<DataArray> col;
         auto& field_meta = plan->schema_->operator[](field_id);
-        if (!is_field_exist(field_id)) {
+        if (!is_field_exist(field_id) || is_default_value_field(field_id)) {
             col = std::move(bulk_subscript_not_exist_field(field_meta, size));
         } else {
             col = bulk_subscript(&op_ctx, field_id, offsets, size);
@@ -435,14 +539,22 @@ SegmentInternalInterface::set_field_avg_size(FieldId field_id,
 void
 SegmentInternalInterface::timestamp_filter(BitsetType& bitset,
                                            Timestamp timestamp) const {
-    auto& timestamps = get_timestamps();
-    auto cnt = bitset.size();
-    if (timestamps[cnt - 1] <= timestamp) {
+    int64_t cnt = bitset.size();
+    if (get_timestamp(cnt - 1) <= timestamp) {
         // no need to filter out anything.
         return;
     }
 
-    auto pilot = upper_bound(timestamps, 0, cnt, timestamp);
+    // the first offset of a timestamp after the given one
+    int64_t pilot = 0;
+    for (int64_t last = cnt; pilot < last;) {
+        auto mid = pilot + (last - pilot) / 2;
+        if (timestamp >= get_timestamp(mid)) {
+            pilot = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
     // offset bigger than pilot should be filtered out.
     auto offset = pilot;
     while (offset < cnt) {
@@ -460,21 +572,44 @@ void
 SegmentInternalInterface::timestamp_filter(BitsetType& bitset,
                                            const std::vector<int64_t>& offsets,
                                            Timestamp timestamp) const {
-    auto& timestamps = get_timestamps();
     auto cnt = bitset.size();
-    if (timestamps[cnt - 1] <= timestamp) {
+    if (get_timestamp(cnt - 1) <= timestamp) {
         // no need to filter out anything.
         return;
     }
 
     // point query, faster than binary search.
     for (auto& offset : offsets) {
-        if (timestamps[offset] > timestamp) {
+        if (get_timestamp(offset) > timestamp) {
             bitset.set(offset, true);
         }
     }
 }
 
+void
+SegmentInternalInterface::text_match_search(
+    const SearchInfo& search_info,
+    const std::vector<std::string>& queries,
+    const BitsetView& bitset,
+    milvus::OpContext* op_context,
+    SearchResult& output) const {
+    AssertInfo(search_info.metric_type_ == knowhere::metric::BM25,
+               "text match search needs metric BM25, got {}",
+               search_info.metric_type_);
+    AssertInfo(!search_info.group_by_field_id_.has_value() &&
+                   !search_info.iterative_filter_execution,
+               "text match search supports neither group by nor iterative "
+               "filter");
+    SegmentBm25Stats stats{
+        static_cast<uint64_t>(get_row_count() - get_deleted_count()), 0};
+    if (search_info.search_params_.contains(knowhere::meta::BM25_AVGDL)) {
+        stats.avgdl =
+            search_info.search_params_[knowhere::meta::BM25_AVGDL].get<float>();
+    }
+    auto pw = GetTextIndex(op_context, search_info.field_id_);
+    pw.get()->MatchTopK(queries, search_info.topk_, stats, bitset, output);
+}
+
 const SkipIndex&
 SegmentInternalInterface::GetSkipIndex() const {
     return skip_index_;
@@ -28,6 +28,7 @@
 #include "common/EasyAssert.h"
 #include "common/Json.h"
 #include "common/OpContext.h"
+#include "common/Promise.h"
 #include "common/Schema.h"
 #include "common/Span.h"
 #include "common/SystemProperty.h"
@@ -45,15 +46,20 @@
 #include "pb/segcore.pb.h"
 #include "index/SkipIndex.h"
 #include "index/TextMatchIndex.h"
+#include "segcore/ClusteringCentroid.h"
 #include "segcore/ConcurrentVector.h"
+#include "segcore/GrowingScalarIndex.h"
 #include "segcore/InsertRecord.h"
 #include "index/NgramInvertedIndex.h"
 #include "index/json_stats/JsonKeyStats.h"
+#include "index/json_stats/GrowingJsonKeyStats.h"
 
 namespace milvus::segcore {
 
 using namespace milvus::cachinglayer;
 
+struct SealedCatalog;
+
 struct SegmentStats {
     // we stat the memory size used by the segment,
     // including the insert data and delete data.
@@ -222,6 +228,23 @@ class SegmentInterface {
     virtual std::shared_ptr<index::JsonKeyStats>
     GetJsonStats(milvus::OpContext* op_ctx, FieldId field_id) const = 0;
 
+    // the JSON key layout hints of the collection, sealed segments publish
+    // the keys of their JSON stats there and growing segments shred them
+    virtual void
+    SetJsonKeyLayoutHints(index::JsonKeyLayoutHintsPtr hints) = 0;
+
+    // what the clustering compaction knows of a float vector field of the
+    // segment, lets a search skip it
+    virtual void
+    SetClusteringCentroid(FieldId field_id, ClusteringCentroid centroid) = 0;
+
+    // the best distance a row of the segment may have to each query of the
+    // plan, empty when the segment can't bound this search
+    virtual std::vector<float>
+    SearchDistanceBounds(
+        const query::Plan* plan,
+        const query::PlaceholderGroup* placeholder_group) const = 0;
+
     virtual void
     LazyCheckSchema(SchemaPtr sch) = 0;
 
@@ -249,6 +272,13 @@ class SegmentInterface {
 // only for implementation
 class SegmentInternalInterface : public SegmentInterface {
  public:
+    // the columns and scalar indexes the segment serves queries from now, a
+    // Task takes one when it starts, nullptr for a segment without them
+    virtual std::shared_ptr<const SealedCatalog>
+    snapshot() const {
+        return nullptr;
+    }
+
     virtual void
     prefetch_chunks(milvus::OpContext* op_ctx,
                     FieldId field_id,
@@ -256,6 +286,24 @@ class SegmentInternalInterface : public SegmentInterface {
         // do nothing
     }
 
+    // like prefetch_chunks, but returns once the loads are issued, the
+    // future is ready when the chunks are cached
+    virtual ContinueFuture
+    prefetch_chunks_async(milvus::OpContext* op_ctx,
+                          FieldId field_id,
+                          const std::vector<int64_t>& chunk_ids) const {
+        return folly::makeSemiFuture();
+    }
+
+    // the chunk of a string field when it is dictionary encoded, so filters
+    // can run in code space, nullptr otherwise
+    virtual PinWrapper<const StringChunk*>
+    dict_string_chunk(milvus::OpContext* op_ctx,
+                      FieldId field_id,
+                      int64_t chunk_id) const {
+        return PinWrapper<const StringChunk*>(nullptr);
+    }
+
     template <typename T>
     PinWrapper<Span<T>>
     chunk_data(milvus::OpContext* op_ctx,
@@ -448,6 +496,38 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual std::shared_ptr<index::JsonKeyStats>
     GetJsonStats(milvus::OpContext* op_ctx, FieldId field_id) const override;
 
+    void
+    SetJsonKeyLayoutHints(index::JsonKeyLayoutHintsPtr hints) override {
+        json_key_layout_hints_ = std::move(hints);
+    }
+
+    void
+    SetClusteringCentroid(FieldId field_id,
+                          ClusteringCentroid centroid) override;
+
+    std::vector<float>
+    SearchDistanceBounds(
+        const query::Plan* plan,
+        const query::PlaceholderGroup* placeholder_group) const override;
+
+    // nullptr for a segment not created from a collection
+    const index::JsonKeyLayoutHintsPtr&
+    GetJsonKeyLayoutHints() const {
+        return json_key_layout_hints_;
+    }
+
+    // the JSON key stats a growing segment keeps while rows are inserted
+    virtual std::shared_ptr<const index::GrowingJsonKeyStats>
+    GetGrowingJsonStats(FieldId field_id) const {
+        return nullptr;
+    }
+
+    // the interim index a growing segment keeps over its full chunks
+    virtual std::shared_ptr<const GrowingScalarIndexBase>
+    GetGrowingScalarIndex(FieldId field_id) const {
+        return nullptr;
+    }
+
  public:
     // `query_offsets` is not null only for vector array (embedding list) search
     // where it denotes the number of vectors in each embedding list. The length
@@ -463,6 +543,17 @@ class SegmentInternalInterface : public SegmentInterface {
                   milvus::OpContext* op_context,
                   SearchResult& output) const = 0;
 
+    // The search of a VARCHAR field with texts for queries: the topk rows
+    // of each text by BM25 over the text match index of the field, scored
+    // with the doc count of the segment and the avgdl of search_info if it
+    // has one, the segment's otherwise. The rows set in bitset are skipped.
+    void
+    text_match_search(const SearchInfo& search_info,
+                      const std::vector<std::string>& queries,
+                      const BitsetView& bitset,
+                      milvus::OpContext* op_context,
+                      SearchResult& output) const;
+
     virtual void
     mask_with_delete(BitsetTypeView& bitset,
                      int64_t ins_barrier,
@@ -481,6 +572,13 @@ class SegmentInternalInterface : public SegmentInterface {
                          Timestamp timestamp,
                          Timestamp collection_ttl) const = 0;
 
+    // true if mask_with_timestamps() would mask none of the rows below
+    // get_active_count(timestamp), false when that is not known cheaply
+    virtual bool
+    all_visible_at(Timestamp timestamp, Timestamp collection_ttl) const {
+        return false;
+    }
+
     // count of chunks
     virtual int64_t
     num_chunk(FieldId field_id) const = 0;
@@ -550,6 +648,13 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual std::pair<std::vector<OffsetMap::OffsetType>, bool>
     find_first(int64_t limit, const BitsetTypeView& bitset) const = 0;
 
+    // whether find_first returns the first rows in row order rather than in
+    // pk order, so a retrieve may stop filtering once it has enough rows
+    virtual bool
+    find_first_in_row_order() const {
+        return false;
+    }
+
     void
     FillTargetEntryDirectly(
         tracer::TraceContext* trace_ctx,
@@ -570,6 +675,13 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual bool
     is_mmap_field(FieldId field_id) const = 0;
 
+    // whether every row of the field holds its default value, or null if it
+    // has none, as a field added after the segment was written does
+    virtual bool
+    is_default_value_field(FieldId field_id) const {
+        return false;
+    }
+
     virtual std::unique_ptr<DataArray>
     bulk_subscript_not_exist_field(const milvus::FieldMeta& field_meta,
                                    int64_t count) const;
@@ -623,8 +735,8 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual void
     check_search(const query::Plan* plan) const = 0;
 
-    virtual const ConcurrentVector<Timestamp>&
-    get_timestamps() const = 0;
+    virtual Timestamp
+    get_timestamp(int64_t offset) const = 0;
 
  public:
     virtual bool
@@ -676,6 +788,25 @@ class SegmentInternalInterface : public SegmentInterface {
                     bool upper_inclusive,
                     BitsetTypeView& bitset) const = 0;
 
+    // Whether the segment keeps the rows of each value of field_id, its
+    // partition key, so partition_key_rows sets the rows of some values
+    // without reading the column.
+    virtual bool
+    has_partition_key_rows(FieldId field_id) const {
+        return false;
+    }
+
+    virtual void
+    partition_key_rows(milvus::OpContext* op_ctx,
+                       FieldId field_id,
+                       const std::vector<PkType>& keys,
+                       BitsetTypeView& bitset) const {
+        ThrowInfo(NotImplemented,
+                  "segment {} keeps no rows of partition key field {}",
+                  get_segment_id(),
+                  field_id.get());
+    }
+
     virtual GEOSContextHandle_t
     get_ctx() const {
         return ctx_;
@@ -705,9 +836,36 @@ class SegmentInternalInterface : public SegmentInterface {
     std::unordered_map<FieldId, std::shared_ptr<index::JsonKeyStats>>
         json_stats_;
 
+    index::JsonKeyLayoutHintsPtr json_key_layout_hints_;
+
+    // guarded by mutex_
+    std::unordered_map<FieldId, ClusteringCentroid> clustering_centroids_;
+
     GEOSContextHandle_t ctx_ = GEOS_init_r();
 };
 
+// Makes the accessors of segment called on this thread read snapshot, the
+// one the running Task took, until it goes out of scope
+class ScopedSegmentSnapshot {
+ public:
+    ScopedSegmentSnapshot(const SegmentInternalInterface* segment,
+                          std::shared_ptr<const SealedCatalog> snapshot);
+
+    ~ScopedSegmentSnapshot();
+
+    ScopedSegmentSnapshot(const ScopedSegmentSnapshot&) = delete;
+    ScopedSegmentSnapshot&
+    operator=(const ScopedSegmentSnapshot&) = delete;
+
+    // the snapshot of segment bound on this thread, nullptr if none is
+    static const std::shared_ptr<const SealedCatalog>*
+    Current(const SegmentInternalInterface* segment);
+
+ private:
+    const SegmentInternalInterface* prev_segment_;
+    std::shared_ptr<const SealedCatalog> prev_snapshot_;
+};
+
 }  // namespace milvus::segcore
 
 #endif  // MILVUS_SEGCORE_SEGMENT_INTERFACE_H_
@@ -205,8 +205,9 @@ SegmentLoadInfo::ComputeDiffBinlogs(LoadDiff& diff, SegmentLoadInfo& new_info) {
         }
         for (auto child_id : child_fields) {
             new_binlog_fields[child_id] = new_field_binlog.fieldid();
-            auto iter = current_fields.find(new_field_binlog.fieldid());
-            // Find binlogs to load: fields in new_info match current
+            // Find binlogs to load: fields not loaded yet or moved to
+            // another group, the other fields of the group are kept
+            auto iter = current_fields.find(child_id);
             if (iter == current_fields.end() ||
                 iter->second != new_field_binlog.fieldid()) {
                 ids_to_load.emplace_back(child_id);
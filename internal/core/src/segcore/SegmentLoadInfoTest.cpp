@@ -783,6 +783,12 @@ TEST_F(SegmentLoadInfoTest, ComputeDiffMixedFormats) {
     EXPECT_TRUE(diff.HasChanges());
     // Field 103 (legacy) and field 107 (in column group) should be loaded
     EXPECT_EQ(diff.binlogs_to_load.size(), 2);
+    // the fields already loaded from the column group are kept
+    for (const auto& [field_ids, binlog] : diff.binlogs_to_load) {
+        if (binlog.fieldid() == 104) {
+            EXPECT_EQ(field_ids, std::vector<FieldId>{FieldId(107)});
+        }
+    }
 
     // No fields should be dropped
     EXPECT_TRUE(diff.field_data_to_drop.empty());
@@ -811,6 +817,42 @@ TEST_F(SegmentLoadInfoTest, ComputeDiffNoChangesLegacyFormat) {
     EXPECT_TRUE(diff.field_data_to_drop.empty());
 }
 
+TEST_F(SegmentLoadInfoTest, ComputeDiffNoChangesColumnGroup) {
+    // an unchanged column group is not loaded again when an index is added
+    proto::segcore::SegmentLoadInfo current_proto;
+    current_proto.set_segmentid(100);
+    current_proto.set_num_of_rows(1000);
+
+    auto* binlog = current_proto.add_binlog_paths();
+    binlog->set_fieldid(104);
+    binlog->add_child_fields(105);
+    binlog->add_child_fields(106);
+    auto* log = binlog->add_binlogs();
+    log->set_log_path("/path/to/group_binlog");
+    log->set_entries_num(1000);
+
+    auto new_proto = current_proto;
+    auto* index = new_proto.add_index_infos();
+    index->set_fieldid(102);
+    index->set_indexid(1002);
+    index->add_index_file_paths("/path/to/index");
+    auto* index_param = index->add_index_params();
+    index_param->set_key("index_type");
+    index_param->set_value(milvus::index::INVERTED_INDEX_TYPE);
+
+    SegmentLoadInfo current_info(current_proto, schema_);
+    // calculate first diff to set default value fields
+    auto diff = current_info.GetLoadDiff();
+    SegmentLoadInfo new_info(new_proto, schema_);
+    diff = current_info.ComputeDiff(new_info);
+
+    EXPECT_TRUE(diff.binlogs_to_load.empty());
+    EXPECT_TRUE(diff.field_data_to_drop.empty());
+    EXPECT_TRUE(diff.indexes_to_drop.empty());
+    ASSERT_EQ(diff.indexes_to_load.size(), 1);
+    EXPECT_TRUE(diff.indexes_to_load.count(FieldId(102)) > 0);
+}
+
 // ==================== Default Value Filling Tests ====================
 
 TEST_F(SegmentLoadInfoTest, ComputeDiffDefaultFieldsBasic) {
@@ -0,0 +1,174 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/SegmentLoadPlanner.h"
+
+#include <chrono>
+
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus::segcore {
+
+void
+LoadBudget::Acquire(int64_t memory) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] {
+        if (tasks_ == 0) {
+            return true;
+        }
+        return tasks_ < SEGMENT_LOAD_MAX_TASKS.load() &&
+               memory_ + memory <= SEGMENT_LOAD_MEMORY_BUDGET.load();
+    });
+    tasks_++;
+    memory_ += memory;
+}
+
+void
+LoadBudget::Release(int64_t memory) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_--;
+        memory_ -= memory;
+    }
+    cv_.notify_all();
+}
+
+int64_t
+LoadBudget::InflightTasks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_;
+}
+
+int64_t
+LoadBudget::InflightMemory() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_;
+}
+
+SegmentLoadPlanner::TaskId
+SegmentLoadPlanner::AddTask(std::string name,
+                            LoadTaskPriority priority,
+                            int64_t memory,
+                            std::function<void()> run,
+                            const std::vector<TaskId>& dependencies) {
+    auto id = tasks_.size();
+    for (auto dependency : dependencies) {
+        AssertInfo(dependency < id,
+                   "load task {} depends on unknown task {}",
+                   name,
+                   dependency);
+        tasks_[dependency].dependents.push_back(id);
+    }
+    tasks_.push_back(Task{std::move(name),
+                          priority,
+                          std::max<int64_t>(memory, 0),
+                          std::move(run),
+                          {},
+                          dependencies.size()});
+    return id;
+}
+
+void
+SegmentLoadPlanner::Execute(TaskId id) {
+    auto& task = tasks_[id];
+    std::exception_ptr error;
+    try {
+        task.run();
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // the budget is released after the failure is recorded, so that Run
+    // waiting for it does not start another task
+    std::unique_lock<std::mutex> lock(mutex_);
+    inflight_--;
+    finished_++;
+    if (error != nullptr) {
+        if (error_ == nullptr) {
+            error_ = error;
+        }
+    } else {
+        for (auto dependent : task.dependents) {
+            auto& next = tasks_[dependent];
+            if (--next.pending_dependencies == 0) {
+                ready_.emplace(static_cast<int>(next.priority), dependent);
+            }
+        }
+    }
+    lock.unlock();
+    cv_.notify_all();
+    budget_.Release(task.memory);
+}
+
+void
+SegmentLoadPlanner::Run(milvus::ThreadPool& pool) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks_.size());
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (TaskId id = 0; id < tasks_.size(); id++) {
+        if (tasks_[id].pending_dependencies == 0) {
+            ready_.emplace(static_cast<int>(tasks_[id].priority), id);
+        }
+    }
+    while (true) {
+        cv_.wait(lock, [&] {
+            return error_ != nullptr || !ready_.empty() || inflight_ == 0;
+        });
+        if (error_ != nullptr || ready_.empty()) {
+            break;
+        }
+        auto id = ready_.begin()->second;
+        ready_.erase(ready_.begin());
+
+        // the budget is shared with the other segments, so wait for it
+        // without holding the planner
+        lock.unlock();
+        budget_.Acquire(tasks_[id].memory);
+        lock.lock();
+        if (error_ != nullptr) {
+            budget_.Release(tasks_[id].memory);
+            break;
+        }
+        inflight_++;
+        futures.push_back(pool.Submit([this, id]() { Execute(id); }));
+    }
+    cv_.wait(lock, [&] { return inflight_ == 0; });
+    lock.unlock();
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    if (error_ != nullptr) {
+        std::rethrow_exception(error_);
+    }
+    AssertInfo(finished_ == tasks_.size(),
+               "segment {} finished {} of {} load tasks",
+               segment_id_,
+               finished_,
+               tasks_.size());
+    LOG_INFO("segment {} ran {} load tasks in {} ms",
+             segment_id_,
+             tasks_.size(),
+             std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::steady_clock::now() - start)
+                 .count());
+}
+
+}  // namespace milvus::segcore
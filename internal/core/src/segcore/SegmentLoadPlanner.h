@@ -0,0 +1,143 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/ThreadPool.h"
+
+namespace milvus::segcore {
+
+// The order in which the load tasks of a segment are started once their
+// dependencies are done, the fields queries need first go first.
+enum class LoadTaskPriority : int {
+    // primary key, timestamp and row id
+    SYSTEM = 0,
+    // scalar indexes, which serve the filters
+    SCALAR_INDEX = 1,
+    SCALAR_DATA = 2,
+    // vector indexes and vector field data
+    VECTOR = 3,
+};
+
+/**
+ * @brief LoadBudget bounds the load tasks in flight across all the segments
+ * being loaded, by their count and by the memory they are expected to take.
+ * The limits are read from SEGMENT_LOAD_MAX_TASKS and
+ * SEGMENT_LOAD_MEMORY_BUDGET on every acquisition.
+ */
+class LoadBudget {
+ public:
+    static LoadBudget&
+    GetInstance() {
+        static LoadBudget instance;
+        return instance;
+    }
+
+    // Blocks until one more task of 'memory' bytes fits in the budget. A task
+    // is always admitted when no other one is in flight, so a task larger
+    // than the budget does not wait forever.
+    void
+    Acquire(int64_t memory);
+
+    void
+    Release(int64_t memory);
+
+    int64_t
+    InflightTasks() const;
+
+    int64_t
+    InflightMemory() const;
+
+ private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    int64_t tasks_{0};
+    int64_t memory_{0};
+};
+
+/**
+ * @brief SegmentLoadPlanner runs all the fetches of one segment load, the
+ * indexes, column groups and field binlogs, as one DAG instead of phase by
+ * phase. Ready tasks are started by priority, then in the order they were
+ * added, as long as the global LoadBudget admits them.
+ *
+ * Tasks may only depend on tasks added before them. After a task fails no
+ * new one is started, the ones in flight are waited for, and Run rethrows
+ * the first failure.
+ */
+class SegmentLoadPlanner {
+ public:
+    using TaskId = size_t;
+
+    explicit SegmentLoadPlanner(int64_t segment_id,
+                                LoadBudget& budget = LoadBudget::GetInstance())
+        : segment_id_(segment_id), budget_(budget) {
+    }
+
+    TaskId
+    AddTask(std::string name,
+            LoadTaskPriority priority,
+            int64_t memory,
+            std::function<void()> run,
+            const std::vector<TaskId>& dependencies = {});
+
+    size_t
+    TaskCount() const {
+        return tasks_.size();
+    }
+
+    // Runs the tasks on 'pool' and returns once all of them are done.
+    void
+    Run(milvus::ThreadPool& pool);
+
+ private:
+    struct Task {
+        std::string name;
+        LoadTaskPriority priority;
+        int64_t memory;
+        std::function<void()> run;
+        std::vector<TaskId> dependents;
+        size_t pending_dependencies;
+    };
+
+    void
+    Execute(TaskId id);
+
+    const int64_t segment_id_;
+    LoadBudget& budget_;
+    std::vector<Task> tasks_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    // (priority, id) of the tasks whose dependencies are done
+    std::set<std::pair<int, TaskId>> ready_;
+    size_t inflight_{0};
+    size_t finished_{0};
+    std::exception_ptr error_;
+};
+
+}  // namespace milvus::segcore
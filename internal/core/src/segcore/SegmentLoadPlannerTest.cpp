@@ -0,0 +1,153 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/Common.h"
+#include "segcore/SegmentLoadPlanner.h"
+#include "storage/ThreadPools.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+class SegmentLoadPlannerTest : public testing::Test {
+ protected:
+    void
+    SetUp() override {
+        max_tasks_ = SEGMENT_LOAD_MAX_TASKS.load();
+        memory_budget_ = SEGMENT_LOAD_MEMORY_BUDGET.load();
+    }
+
+    void
+    TearDown() override {
+        SEGMENT_LOAD_MAX_TASKS.store(max_tasks_);
+        SEGMENT_LOAD_MEMORY_BUDGET.store(memory_budget_);
+    }
+
+    std::function<void()>
+    Record(const std::string& name) {
+        return [this, name]() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            order_.push_back(name);
+        };
+    }
+
+    size_t
+    Position(const std::string& name) {
+        return std::find(order_.begin(), order_.end(), name) - order_.begin();
+    }
+
+    ThreadPool&
+    Pool() {
+        return ThreadPools::GetThreadPool(ThreadPoolPriority::MIDDLE);
+    }
+
+    int64_t max_tasks_;
+    int64_t memory_budget_;
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+};
+
+TEST_F(SegmentLoadPlannerTest, StartsByPriority) {
+    // one task at a time makes the start order observable
+    SEGMENT_LOAD_MAX_TASKS.store(1);
+    SegmentLoadPlanner planner(1);
+    planner.AddTask("vector", LoadTaskPriority::VECTOR, 0, Record("vector"));
+    planner.AddTask(
+        "scalar", LoadTaskPriority::SCALAR_DATA, 0, Record("scalar"));
+    planner.AddTask(
+        "index", LoadTaskPriority::SCALAR_INDEX, 0, Record("index"));
+    planner.AddTask("pk", LoadTaskPriority::SYSTEM, 0, Record("pk"));
+    planner.AddTask("ts", LoadTaskPriority::SYSTEM, 0, Record("ts"));
+    planner.Run(Pool());
+    std::vector<std::string> expected{"pk", "ts", "index", "scalar", "vector"};
+    EXPECT_EQ(order_, expected);
+}
+
+TEST_F(SegmentLoadPlannerTest, WaitsForDependencies) {
+    SegmentLoadPlanner planner(1);
+    auto index = planner.AddTask(
+        "vector index", LoadTaskPriority::VECTOR, 0, Record("vector index"));
+    auto drop = planner.AddTask(
+        "drop index", LoadTaskPriority::SYSTEM, 0, Record("drop index"));
+    planner.AddTask("vector data",
+                    LoadTaskPriority::SYSTEM,
+                    0,
+                    Record("vector data"),
+                    {index, drop});
+    planner.AddTask("pk", LoadTaskPriority::SYSTEM, 0, Record("pk"));
+    planner.Run(Pool());
+    ASSERT_EQ(order_.size(), 4);
+    EXPECT_GT(Position("vector data"), Position("vector index"));
+    EXPECT_GT(Position("vector data"), Position("drop index"));
+    EXPECT_ANY_THROW(planner.AddTask(
+        "unknown", LoadTaskPriority::SYSTEM, 0, Record("unknown"), {100}));
+}
+
+TEST_F(SegmentLoadPlannerTest, StaysWithinBudget) {
+    SEGMENT_LOAD_MAX_TASKS.store(3);
+    SEGMENT_LOAD_MEMORY_BUDGET.store(100);
+    std::atomic<int64_t> tasks{0}, memory{0};
+    std::atomic<int64_t> max_tasks{0}, max_memory{0};
+    SegmentLoadPlanner planner(1);
+    for (int i = 0; i < 20; i++) {
+        int64_t size = i == 7 ? 500 : 30;
+        planner.AddTask(
+            "task", LoadTaskPriority::SCALAR_DATA, size, [&, size]() {
+                auto t = ++tasks;
+                auto m = memory += size;
+                max_tasks = std::max<int64_t>(max_tasks, t);
+                if (size <= 100) {
+                    max_memory = std::max<int64_t>(max_memory, m);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                memory -= size;
+                --tasks;
+            });
+    }
+    planner.Run(Pool());
+    EXPECT_LE(max_tasks, 3);
+    EXPECT_LE(max_memory, 100);
+    EXPECT_EQ(LoadBudget::GetInstance().InflightTasks(), 0);
+    EXPECT_EQ(LoadBudget::GetInstance().InflightMemory(), 0);
+}
+
+TEST_F(SegmentLoadPlannerTest, StopsOnFailure) {
+    SEGMENT_LOAD_MAX_TASKS.store(1);
+    SegmentLoadPlanner planner(1);
+    auto failed =
+        planner.AddTask("failed", LoadTaskPriority::SYSTEM, 10, []() {
+            throw std::runtime_error("fetch failed");
+        });
+    planner.AddTask("dependent",
+                    LoadTaskPriority::SYSTEM,
+                    0,
+                    Record("dependent"),
+                    {failed});
+    planner.AddTask("later", LoadTaskPriority::VECTOR, 0, Record("later"));
+    EXPECT_THROW(planner.Run(Pool()), std::runtime_error);
+    EXPECT_TRUE(order_.empty());
+    EXPECT_EQ(LoadBudget::GetInstance().InflightTasks(), 0);
+    EXPECT_EQ(LoadBudget::GetInstance().InflightMemory(), 0);
+}
@@ -45,11 +45,24 @@ TimestampIndex::build_with(const Timestamp* timestamps, int64_t size) {
     Assert(offset == size);
     auto min_ts = timestamp_barriers[0];
 
+    auto num_page = (size + kPageRows - 1) / kPageRows;
+    std::vector<Timestamp> page_min_timestamps(num_page);
+    std::vector<Timestamp> page_max_timestamps(num_page);
+    for (int64_t page = 0; page < num_page; ++page) {
+        auto page_begin = timestamps + page * kPageRows;
+        auto page_end = timestamps + std::min(size, (page + 1) * kPageRows);
+        auto [min_v, max_v] = std::minmax_element(page_begin, page_end);
+        page_min_timestamps[page] = *min_v;
+        page_max_timestamps[page] = *max_v;
+    }
+
     this->size_ = size;
     this->start_locs_ = std::move(prefix_sums);
     this->min_timestamp_ = min_ts;
     this->max_timestamp_ = last_max_v;
     this->timestamp_barriers_ = std::move(timestamp_barriers);
+    this->page_min_timestamps_ = std::move(page_min_timestamps);
+    this->page_max_timestamps_ = std::move(page_max_timestamps);
 }
 
 std::pair<int64_t, int64_t>
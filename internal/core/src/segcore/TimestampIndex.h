@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <boost/dynamic_bitset.hpp>
 #include <vector>
 #include <utility>
@@ -33,6 +34,43 @@ class TimestampIndex {
     std::pair<int64_t, int64_t>
     get_active_range(Timestamp query_timestamp) const;
 
+    // How the timestamps of a page of rows compare with a query timestamp
+    enum class PageState {
+        // all of them are not greater than it
+        AllLessEqual,
+        // all of them are greater than it
+        AllGreater,
+        // some are and some are not
+        Straddling,
+    };
+
+    // Calls func(run_begin, run_end, state) for each maximal run of rows
+    // in [begin, end) whose pages compare alike with query_timestamp, in
+    // order. Only the straddling runs need their timestamps read.
+    template <typename Func>
+    void
+    for_each_page_run(Timestamp query_timestamp,
+                      int64_t begin,
+                      int64_t end,
+                      Func&& func) const {
+        int64_t run_begin = begin;
+        auto run_state = PageState::Straddling;
+        while (begin < end) {
+            auto page = begin / kPageRows;
+            auto page_end = std::min(end, (page + 1) * kPageRows);
+            auto state = page_state(page, query_timestamp);
+            if (state != run_state && run_begin < begin) {
+                func(run_begin, begin, run_state);
+                run_begin = begin;
+            }
+            run_state = state;
+            begin = page_end;
+        }
+        if (run_begin < end) {
+            func(run_begin, end, run_state);
+        }
+    }
+
     static BitsetType
     GenerateBitset(Timestamp query_timestamp,
                    std::pair<int64_t, int64_t> active_range,
@@ -49,7 +87,24 @@ class TimestampIndex {
     memory_size() const {
         return sizeof(*this) + lengths_.size() * sizeof(int64_t) +
                start_locs_.size() * sizeof(int64_t) +
-               timestamp_barriers_.size() * sizeof(Timestamp);
+               timestamp_barriers_.size() * sizeof(Timestamp) +
+               page_min_timestamps_.size() * sizeof(Timestamp) +
+               page_max_timestamps_.size() * sizeof(Timestamp);
+    }
+
+ public:
+    static constexpr int64_t kPageRows = 4096;
+
+ private:
+    PageState
+    page_state(int64_t page, Timestamp query_timestamp) const {
+        if (page_max_timestamps_[page] <= query_timestamp) {
+            return PageState::AllLessEqual;
+        }
+        if (page_min_timestamps_[page] > query_timestamp) {
+            return PageState::AllGreater;
+        }
+        return PageState::Straddling;
     }
 
  private:
@@ -62,6 +117,9 @@ class TimestampIndex {
     Timestamp max_timestamp_;
     // numSlice + 1
     std::vector<Timestamp> timestamp_barriers_;
+    // the min and max timestamp of each kPageRows rows, numPage
+    std::vector<Timestamp> page_min_timestamps_;
+    std::vector<Timestamp> page_max_timestamps_;
 };
 
 std::vector<int64_t>
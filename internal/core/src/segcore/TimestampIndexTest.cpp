@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <tuple>
 #include <vector>
 
 #include "segcore/TimestampIndex.h"
@@ -66,3 +67,47 @@ TEST(TimestampIndex, Naive) {
     ASSERT_EQ(range.first, 8);
     ASSERT_EQ(range.second, 8);
 }
+
+TEST(TimestampIndex, PageRuns) {
+    using PageState = TimestampIndex::PageState;
+    constexpr int64_t page = TimestampIndex::kPageRows;
+    // pages hold [0, 100), [100, 200), [150, 250) and a partial [300, 400)
+    const int64_t size = 3 * page + 10;
+    std::vector<Timestamp> timestamps(size);
+    for (int64_t i = 0; i < size; ++i) {
+        auto p = i / page;
+        Timestamp base = p == 3 ? 300 : (p == 2 ? 150 : p * 100);
+        timestamps[i] = base + i % 100;
+    }
+    TimestampIndex index;
+    index.set_length_meta({size});
+    index.build_with(timestamps.data(), size);
+
+    using Run = std::tuple<int64_t, int64_t, PageState>;
+    auto runs_of = [&](Timestamp ts, int64_t begin, int64_t end) {
+        std::vector<Run> runs;
+        index.for_each_page_run(
+            ts, begin, end, [&](int64_t b, int64_t e, PageState state) {
+                runs.emplace_back(b, e, state);
+            });
+        return runs;
+    };
+
+    auto runs = runs_of(1000, 0, size);
+    ASSERT_EQ(runs, (std::vector<Run>{{0, size, PageState::AllLessEqual}}));
+
+    runs = runs_of(120, 10, size - 5);
+    ASSERT_EQ(runs,
+              (std::vector<Run>{{10, page, PageState::AllLessEqual},
+                                {page, 2 * page, PageState::Straddling},
+                                {2 * page, size - 5, PageState::AllGreater}}));
+
+    runs = runs_of(199, 0, size);
+    ASSERT_EQ(runs,
+              (std::vector<Run>{{0, 2 * page, PageState::AllLessEqual},
+                                {2 * page, 3 * page, PageState::Straddling},
+                                {3 * page, size, PageState::AllGreater}}));
+
+    runs = runs_of(0, page, page);
+    ASSERT_TRUE(runs.empty());
+}
@@ -11,6 +11,8 @@
 
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "pb/schema.pb.h"
@@ -80,3 +82,66 @@ TEST(CTokenizer, Default) {
 
     free_tokenizer(tokenizer);
 }
+
+TEST(CTokenizer, TokenizeBatch) {
+    auto analyzer_params = R"({"tokenizer": "standard"})";
+    CTokenizer tokenizer;
+    {
+        auto status = create_tokenizer(analyzer_params, "", &tokenizer);
+        ASSERT_EQ(milvus::ErrorCode::Success, status.error_code);
+    }
+
+    std::vector<std::string> texts{"football, basketball", "", "swimming"};
+    std::vector<const char*> ptrs;
+    std::vector<uint32_t> lens;
+    for (const auto& text : texts) {
+        ptrs.push_back(text.data());
+        lens.push_back(text.size());
+    }
+
+    CTokenBatch batch;
+    {
+        auto status = tokenize_batch(tokenizer,
+                                     ptrs.data(),
+                                     lens.data(),
+                                     texts.size(),
+                                     true,
+                                     true,
+                                     &batch);
+        ASSERT_EQ(milvus::ErrorCode::Success, status.error_code);
+    }
+    ASSERT_EQ(batch.num_texts, 3);
+    ASSERT_EQ(batch.num_tokens, 3);
+    std::vector<uint32_t> text_offsets(batch.text_offsets,
+                                       batch.text_offsets + 4);
+    ASSERT_EQ(text_offsets, (std::vector<uint32_t>{0, 2, 2, 3}));
+
+    std::vector<std::string> refs{"football", "basketball", "swimming"};
+    std::vector<int64_t> positions{0, 1, 0};
+    // crc32 of the token, as typeutil.HashString2LessUint32 computes
+    std::vector<uint32_t> hashes{2933794462u, 3623086097u, 2257135474u};
+    for (int i = 0; i < 3; i++) {
+        auto begin = batch.token_offsets[i];
+        auto end = batch.token_offsets[i + 1];
+        ASSERT_EQ(refs[i], std::string(batch.data + begin, end - begin));
+        ASSERT_EQ(positions[i], batch.positions[i]);
+        ASSERT_EQ(hashes[i], batch.hashes[i]);
+    }
+    free_token_batch(&batch);
+
+    {
+        auto status = tokenize_batch(tokenizer,
+                                     ptrs.data(),
+                                     lens.data(),
+                                     texts.size(),
+                                     false,
+                                     false,
+                                     &batch);
+        ASSERT_EQ(milvus::ErrorCode::Success, status.error_code);
+    }
+    ASSERT_EQ(batch.positions, nullptr);
+    ASSERT_EQ(batch.hashes, nullptr);
+    free_token_batch(&batch);
+
+    free_tokenizer(tokenizer);
+}
@@ -14,6 +14,7 @@
 
 #include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,7 @@
 #include "log/Log.h"
 #include "segcore/storagev1translator/SealedIndexTranslator.h"
 #include "segcore/storagev1translator/V1SealedIndexTranslator.h"
+#include "segcore/SegcoreConfig.h"
 #include "segcore/Types.h"
 #include "storage/DataCodec.h"
 #include "storage/RemoteChunkManagerSingleton.h"
@@ -770,6 +772,45 @@ MergeDataArray(std::vector<MergeBase>& merge_bases,
     data_array->set_type(static_cast<milvus::proto::schema::DataType>(
         field_meta.get_data_type()));
 
+    // the rows of a dense vector field are appended to one buffer, sized up
+    // front so large results are not copied again as it grows
+    if (field_meta.is_vector() && !IsSparseFloatVectorDataType(data_type) &&
+        data_type != DataType::VECTOR_ARRAY) {
+        int64_t num_rows = 0;
+        for (auto& merge_base : merge_bases) {
+            num_rows +=
+                !nullable ||
+                merge_base.get_field_data(field_meta.get_id())
+                    ->valid_data(merge_base.getOffset());
+        }
+        auto dim = field_meta.get_dim();
+        auto vector_array = data_array->mutable_vectors();
+        switch (data_type) {
+            case DataType::VECTOR_FLOAT:
+                vector_array->mutable_float_vector()->mutable_data()->Reserve(
+                    num_rows * dim);
+                break;
+            case DataType::VECTOR_FLOAT16:
+                vector_array->mutable_float16_vector()->reserve(
+                    num_rows * dim * sizeof(float16));
+                break;
+            case DataType::VECTOR_BFLOAT16:
+                vector_array->mutable_bfloat16_vector()->reserve(
+                    num_rows * dim * sizeof(bfloat16));
+                break;
+            case DataType::VECTOR_BINARY:
+                vector_array->mutable_binary_vector()->reserve(num_rows * dim /
+                                                               8);
+                break;
+            case DataType::VECTOR_INT8:
+                vector_array->mutable_int8_vector()->reserve(
+                    num_rows * dim * sizeof(int8));
+                break;
+            default:
+                break;
+        }
+    }
+
     for (auto& merge_base : merge_bases) {
         auto src_field_data = merge_base.get_field_data(field_meta.get_id());
         auto src_offset = merge_base.getOffset();
@@ -805,13 +846,13 @@ MergeDataArray(std::vector<MergeBase>& merge_bases,
             } else if (field_meta.get_data_type() == DataType::VECTOR_FLOAT16) {
                 auto data = VEC_FIELD_DATA(src_field_data, float16);
                 auto obj = vector_array->mutable_float16_vector();
-                obj->assign(data + physical_offset * dim * sizeof(float16),
+                obj->append(data + physical_offset * dim * sizeof(float16),
                             dim * sizeof(float16));
             } else if (field_meta.get_data_type() ==
                        DataType::VECTOR_BFLOAT16) {
                 auto data = VEC_FIELD_DATA(src_field_data, bfloat16);
                 auto obj = vector_array->mutable_bfloat16_vector();
-                obj->assign(data + physical_offset * dim * sizeof(bfloat16),
+                obj->append(data + physical_offset * dim * sizeof(bfloat16),
                             dim * sizeof(bfloat16));
             } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
                 AssertInfo(
@@ -820,7 +861,7 @@ MergeDataArray(std::vector<MergeBase>& merge_bases,
                 auto num_bytes = dim / 8;
                 auto data = VEC_FIELD_DATA(src_field_data, binary);
                 auto obj = vector_array->mutable_binary_vector();
-                obj->assign(data + physical_offset * num_bytes, num_bytes);
+                obj->append(data + physical_offset * num_bytes, num_bytes);
             } else if (field_meta.get_data_type() ==
                        DataType::VECTOR_SPARSE_U32_F32) {
                 auto& src_vec = src_field_data->vectors().sparse_float_vector();
@@ -834,7 +875,7 @@ MergeDataArray(std::vector<MergeBase>& merge_bases,
             } else if (field_meta.get_data_type() == DataType::VECTOR_INT8) {
                 auto data = VEC_FIELD_DATA(src_field_data, int8);
                 auto obj = vector_array->mutable_int8_vector();
-                obj->assign(data + physical_offset * dim * sizeof(int8),
+                obj->append(data + physical_offset * dim * sizeof(int8),
                             dim * sizeof(int8));
             } else if (field_meta.get_data_type() == DataType::VECTOR_ARRAY) {
                 auto& data = src_field_data->vectors().vector_array();
@@ -1116,8 +1157,11 @@ ReverseDataFromIndex(const index::IndexBase* index,
             using IndexType = index::ScalarIndex<std::string>;
             auto ptr = dynamic_cast<const IndexType*>(index);
             std::vector<std::string> raw_data(count);
+            // strings are looked up together, a trie index shares its walks
+            std::vector<std::optional<std::string>> raws(count);
+            ptr->Reverse_Lookup_Batch(seg_offsets, count, raws.data());
             for (int64_t i = 0; i < count; ++i) {
-                auto raw = ptr->Reverse_Lookup(seg_offsets[i]);
+                auto& raw = raws[i];
                 // if has no value, means nullable must be true, no need to check nullable again here
                 if (!raw.has_value()) {
                     valid_data[i] = false;
@@ -1126,7 +1170,7 @@ ReverseDataFromIndex(const index::IndexBase* index,
                 if (nullable) {
                     valid_data[i] = true;
                 }
-                raw_data[i] = raw.value();
+                raw_data[i] = std::move(raw.value());
             }
             auto obj = scalar_array->mutable_string_data();
             *(obj->mutable_data()) = {raw_data.begin(), raw_data.end()};
@@ -1225,13 +1269,18 @@ LoadArrowReaderForJsonStatsFromRemote(
 void
 LoadArrowReaderFromRemote(const std::vector<std::string>& remote_files,
                           std::shared_ptr<ArrowReaderChannel> channel,
-                          milvus::proto::common::LoadPriority priority) {
+                          milvus::proto::common::LoadPriority priority,
+                          milvus::OpContext* op_ctx) {
     try {
         auto rcm = storage::RemoteChunkManagerSingleton::GetInstance()
                        .GetRemoteChunkManager();
 
         auto codec_futures = storage::GetObjectData(
-            rcm.get(), remote_files, milvus::PriorityForLoad(priority), false);
+            rcm.get(),
+            remote_files,
+            milvus::PriorityForLoad(priority),
+            false,
+            op_ctx ? op_ctx->cancellation_token : folly::CancellationToken());
         // Wait for all futures to ensure all threads complete
         auto codecs = storage::WaitAllFutures(std::move(codec_futures));
         for (auto& codec : codecs) {
@@ -1329,6 +1378,13 @@ getCellDataType(bool is_vector, bool is_index) {
     }
 }
 
+int64_t
+getGroupChunkCellSize(bool is_vector) {
+    auto& config = SegcoreConfig::default_config();
+    return is_vector ? config.get_vector_group_chunk_cell_size()
+                     : config.get_scalar_group_chunk_cell_size();
+}
+
 void
 LoadIndexData(milvus::tracer::TraceContext& ctx,
               milvus::segcore::LoadIndexInfo* load_index_info,
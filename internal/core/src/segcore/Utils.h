@@ -156,10 +156,13 @@ LoadArrowReaderForJsonStatsFromRemote(
     const std::vector<std::string>& remote_files,
     std::shared_ptr<ArrowReaderChannel> channel);
 
+// the downloads not started yet when op_ctx is cancelled are skipped, and
+// the channel is closed with the cancellation
 void
 LoadArrowReaderFromRemote(const std::vector<std::string>& remote_files,
                           std::shared_ptr<ArrowReaderChannel> channel,
-                          milvus::proto::common::LoadPriority priority);
+                          milvus::proto::common::LoadPriority priority,
+                          milvus::OpContext* op_ctx = nullptr);
 
 void
 LoadFieldDatasFromRemote(const std::vector<std::string>& remote_files,
@@ -193,6 +196,11 @@ getCacheWarmupPolicy(const std::string& warmup_policy,
 milvus::cachinglayer::CellDataType
 getCellDataType(bool is_vector, bool is_index);
 
+// Target memory size of a cache cell of a storage v2 column group, 0 to
+// merge a fixed number of row groups into each cell.
+int64_t
+getGroupChunkCellSize(bool is_vector);
+
 void
 LoadIndexData(milvus::tracer::TraceContext& ctx,
               milvus::segcore::LoadIndexInfo* load_index_info,
@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <string>
@@ -189,6 +190,42 @@ TEST(Util_Segcore, MergeDataArrayWithNullableVectors) {
     ASSERT_TRUE(merged_result->valid_data(4));
 }
 
+TEST(Util_Segcore, MergeDataArrayKeepsEveryFloat16Row) {
+    using namespace milvus;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    int64_t dim = 4;
+    auto vec = schema->AddDebugField(
+        "embeddings", DataType::VECTOR_FLOAT16, dim, knowhere::metric::L2);
+    auto& field_meta = (*schema)[vec];
+
+    int64_t count = 6;
+    std::vector<float16> data(count * dim);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = float16(static_cast<float>(i));
+    }
+    std::map<FieldId, std::unique_ptr<milvus::DataArray>> output_fields_data;
+    output_fields_data[vec] =
+        CreateVectorDataArrayFrom(data.data(), count, field_meta);
+
+    std::vector<MergeBase> merge_bases;
+    for (int64_t offset : {5, 0, 3}) {
+        merge_bases.emplace_back(&output_fields_data, offset);
+    }
+    auto merged_result = MergeDataArray(merge_bases, field_meta);
+
+    const auto& merged = merged_result->vectors().float16_vector();
+    ASSERT_EQ(merged.size(), merge_bases.size() * dim * sizeof(float16));
+    for (size_t i = 0; i < merge_bases.size(); ++i) {
+        ASSERT_EQ(memcmp(merged.data() + i * dim * sizeof(float16),
+                         data.data() + merge_bases[i].getOffset() * dim,
+                         dim * sizeof(float16)),
+                  0)
+            << i;
+    }
+}
+
 // Tests for CheckCancellation utility function
 TEST(UtilSegcore, CheckCancellationNullContext) {
     using namespace milvus::segcore;
@@ -14,6 +14,7 @@
 #include "common/type_c.h"
 #ifdef __linux__
 #include <malloc.h>
+#include <nlohmann/json.hpp>
 #endif
 
 #include <iostream>
@@ -99,3 +100,43 @@ GetCollectionName(CCollection collection) {
     auto col = static_cast<milvus::segcore::Collection*>(collection);
     return strdup(col->get_collection_name().data());
 }
+
+const char*
+GetJsonQueriedPaths(CCollection collection, int64_t field_id) {
+    SCOPE_CGO_CALL_METRIC();
+
+    auto col = static_cast<milvus::segcore::Collection*>(collection);
+    nlohmann::json paths = nlohmann::json::object();
+    for (const auto& [pointer, hits] :
+         col->get_json_key_layout_hints()->GetQueriedPaths(
+             milvus::FieldId(field_id))) {
+        paths[pointer] = hits;
+    }
+    return strdup(paths.dump().c_str());
+}
+
+CStatus
+ProposeColumnSplits(CCollection collection,
+                    const int64_t* field_ids,
+                    const int64_t* row_sizes,
+                    int num_fields,
+                    CColumnSplits column_splits) {
+    SCOPE_CGO_CALL_METRIC();
+
+    try {
+        auto col = static_cast<milvus::segcore::Collection*>(collection);
+        std::vector<milvus::FieldId> fields;
+        fields.reserve(num_fields);
+        for (int i = 0; i < num_fields; ++i) {
+            fields.emplace_back(field_ids[i]);
+        }
+        auto groups = col->get_field_access_stats()->ProposeColumnGroups(
+            fields, std::vector<int64_t>(row_sizes, row_sizes + num_fields));
+        for (auto& group : groups) {
+            AddCColumnSplit(column_splits, group.data(), group.size());
+        }
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include "common/type_c.h"
+#include "segcore/column_groups_c.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,6 +48,23 @@ DeleteCollection(CCollection collection);
 const char*
 GetCollectionName(CCollection collection);
 
+// JSON object of the JSON pointers filters evaluated on the field to their
+// hit counts, to pass as json_stats_queried_paths to the next JSON stats
+// build of the field. The caller frees the string.
+const char*
+GetJsonQueriedPaths(CCollection collection, int64_t field_id);
+
+// Adds to column_splits the column groups proposed for the next writes of
+// the collection from the fields its queries read together, the columns
+// being the fields field_ids[i] with average row size row_sizes[i]. Adds
+// none before the collection was queried.
+CStatus
+ProposeColumnSplits(CCollection collection,
+                    const int64_t* field_ids,
+                    const int64_t* row_sizes,
+                    int num_fields,
+                    CColumnSplits column_splits);
+
 #ifdef __cplusplus
 }
 #endif
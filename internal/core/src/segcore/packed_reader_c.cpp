@@ -15,6 +15,9 @@
 #include "segcore/packed_reader_c.h"
 #include "milvus-storage/packed/reader.h"
 #include "milvus-storage/filesystem/fs.h"
+#include "milvus-storage/format/parquet/file_reader.h"
+#include "milvus-storage/common/constants.h"
+#include "segcore/projection_reader.h"
 #include "storage/PluginLoader.h"
 #include "storage/KeyRetriever.h"
 #include "storage/StorageV2FSCache.h"
@@ -23,6 +26,8 @@
 #include <arrow/filesystem/filesystem.h>
 #include <arrow/status.h>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include "common/EasyAssert.h"
 #include "common/type_c.h"
 #include "monitor/scope_metric.h"
@@ -168,6 +173,133 @@ ReadNext(CPackedReader c_packed_reader,
     }
 }
 
+CStatus
+TakePackedRows(char** paths,
+               int64_t num_paths,
+               struct ArrowSchema* schema,
+               const int64_t* offsets,
+               int64_t num_offsets,
+               CArrowArray* out_array,
+               CArrowSchema* out_schema,
+               CPluginContext* c_plugin_context) {
+    SCOPE_CGO_CALL_METRIC();
+
+    try {
+        auto truePaths = std::vector<std::string>(paths, paths + num_paths);
+        auto trueFs = milvus_storage::ArrowFileSystemSingleton::GetInstance()
+                          .GetArrowFileSystem();
+        if (!trueFs) {
+            return milvus::FailureCStatus(
+                milvus::ErrorCode::FileReadFailed,
+                "[StorageV2] Failed to get filesystem");
+        }
+        auto trueSchema = arrow::ImportSchema(schema).ValueOrDie();
+        auto row_offsets =
+            std::vector<int64_t>(offsets, offsets + num_offsets);
+
+        auto plugin_ptr =
+            milvus::storage::PluginLoader::GetInstance().getCipherPlugin();
+        if (plugin_ptr != nullptr && c_plugin_context != nullptr) {
+            plugin_ptr->Update(c_plugin_context->ez_id,
+                               c_plugin_context->collection_id,
+                               std::string(c_plugin_context->key));
+        }
+
+        // every packed file holds the same rows of its own columns
+        std::unordered_map<std::string, std::shared_ptr<arrow::ChunkedArray>>
+            columns;
+        for (const auto& path : truePaths) {
+            auto result = milvus_storage::FileRowGroupReader::Make(
+                trueFs,
+                path,
+                milvus_storage::DEFAULT_READ_BUFFER_SIZE,
+                milvus::storage::GetReaderProperties());
+            AssertInfo(result.ok(),
+                       "[StorageV2] Failed to create file row group reader: " +
+                           result.status().ToString());
+            auto reader = result.ValueOrDie();
+            auto parquet_schema =
+                reader->file_metadata()->GetParquetMetadata()->schema();
+            auto row_group_metas =
+                reader->file_metadata()->GetRowGroupMetadataVector();
+            auto status = reader->Close();
+            AssertInfo(status.ok(),
+                       "[StorageV2] Failed to close file reader of {}: {}",
+                       path,
+                       status.ToString());
+
+            std::unordered_set<std::string> file_columns;
+            for (int i = 0; i < parquet_schema->group_node()->field_count();
+                 ++i) {
+                file_columns.insert(
+                    parquet_schema->group_node()->field(i)->name());
+            }
+            arrow::FieldVector needed_fields;
+            for (const auto& field : trueSchema->fields()) {
+                if (file_columns.count(field->name()) > 0 &&
+                    columns.count(field->name()) == 0) {
+                    needed_fields.push_back(field);
+                }
+            }
+            if (needed_fields.empty()) {
+                continue;
+            }
+
+            std::vector<int64_t> row_counts;
+            row_counts.reserve(row_group_metas.size());
+            for (size_t i = 0; i < row_group_metas.size(); ++i) {
+                row_counts.push_back(row_group_metas.Get(i).row_num());
+            }
+            auto table = milvus::segcore::ReadRowsWithProjection(
+                nullptr,
+                {path},
+                {row_counts},
+                trueFs,
+                arrow::schema(needed_fields),
+                row_offsets);
+            for (const auto& field : needed_fields) {
+                columns[field->name()] =
+                    table->GetColumnByName(field->name());
+            }
+        }
+
+        arrow::ChunkedArrayVector ordered_columns;
+        ordered_columns.reserve(trueSchema->num_fields());
+        for (const auto& field : trueSchema->fields()) {
+            auto it = columns.find(field->name());
+            if (it == columns.end() || it->second == nullptr) {
+                return milvus::FailureCStatus(
+                    milvus::ErrorCode::FileReadFailed,
+                    "[StorageV2] column " + field->name() +
+                        " not found in packed files");
+            }
+            ordered_columns.push_back(it->second);
+        }
+        auto record_batch =
+            arrow::Table::Make(trueSchema, ordered_columns, num_offsets)
+                ->CombineChunksToBatch();
+        if (!record_batch.ok()) {
+            return milvus::FailureCStatus(
+                milvus::ErrorCode::FileReadFailed,
+                record_batch.status().ToString());
+        }
+
+        std::unique_ptr<ArrowArray> arr = std::make_unique<ArrowArray>();
+        std::unique_ptr<ArrowSchema> out = std::make_unique<ArrowSchema>();
+        auto status = arrow::ExportRecordBatch(
+            *record_batch.ValueOrDie(), arr.get(), out.get());
+        if (!status.ok()) {
+            return milvus::FailureCStatus(milvus::ErrorCode::FileReadFailed,
+                                          status.ToString());
+        }
+        *out_array = arr.release();
+        *out_schema = out.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 CloseReader(CPackedReader c_packed_reader) {
     SCOPE_CGO_CALL_METRIC();
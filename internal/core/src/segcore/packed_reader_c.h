@@ -63,6 +63,28 @@ ReadNext(CPackedReader c_packed_reader,
          CArrowArray* out_array,
          CArrowSchema* out_schema);
 
+/**
+ * @brief Read the rows at the given offsets of the needed columns from packed
+ *        files. Only the row groups holding one of the rows are read, and only
+ *        the needed columns of them are decoded.
+ *
+ * @param paths The packed files, one per column group, with aligned rows.
+ * @param schema The needed columns.
+ * @param offsets The row offsets to read, in any order.
+ * @param out_array The output pointer of the arrow array, rows in the order
+ *        of the offsets.
+ * @param out_schema The output pointer of the arrow schema.
+ */
+CStatus
+TakePackedRows(char** paths,
+               int64_t num_paths,
+               struct ArrowSchema* schema,
+               const int64_t* offsets,
+               int64_t num_offsets,
+               CArrowArray* out_array,
+               CArrowSchema* out_schema,
+               CPluginContext* c_plugin_context);
+
 /**
  * @brief Close the packed reader and release the resources.
  *
@@ -21,6 +21,7 @@
 #include "milvus-storage/packed/writer.h"
 #include "milvus-storage/common/config.h"
 #include "milvus-storage/filesystem/fs.h"
+#include "storage/AsyncPackedWriter.h"
 #include "storage/PluginLoader.h"
 #include "storage/KeyRetriever.h"
 #include "storage/StorageV2FSCache.h"
@@ -121,8 +122,7 @@ NewPackedWriterWithStorageConfig(struct ArrowSchema* schema,
                        result.status().ToString());
         auto writer = result.ValueOrDie();
         *c_packed_writer =
-            new std::shared_ptr<milvus_storage::PackedRecordBatchWriter>(
-                std::move(writer));
+            new milvus::storage::AsyncPackedWriter(std::move(writer));
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -195,8 +195,7 @@ NewPackedWriter(struct ArrowSchema* schema,
                        result.status().ToString());
         auto writer = result.ValueOrDie();
         *c_packed_writer =
-            new std::shared_ptr<milvus_storage::PackedRecordBatchWriter>(
-                std::move(writer));
+            new milvus::storage::AsyncPackedWriter(std::move(writer));
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -211,9 +210,8 @@ WriteRecordBatch(CPackedWriter c_packed_writer,
     SCOPE_CGO_CALL_METRIC();
 
     try {
-        auto packed_writer = *static_cast<
-            std::shared_ptr<milvus_storage::PackedRecordBatchWriter>*>(
-            c_packed_writer);
+        auto packed_writer =
+            static_cast<milvus::storage::AsyncPackedWriter*>(c_packed_writer);
 
         auto import_schema = arrow::ImportSchema(schema);
         if (!import_schema.ok()) {
@@ -258,10 +256,9 @@ CloseWriter(CPackedWriter c_packed_writer) {
     SCOPE_CGO_CALL_METRIC();
 
     try {
-        auto packed_writer = static_cast<
-            std::shared_ptr<milvus_storage::PackedRecordBatchWriter>*>(
-            c_packed_writer);
-        auto status = (*packed_writer)->Close();
+        auto packed_writer =
+            static_cast<milvus::storage::AsyncPackedWriter*>(c_packed_writer);
+        auto status = packed_writer->Close();
         delete packed_writer;
         if (!status.ok()) {
             return milvus::FailureCStatus(milvus::ErrorCode::FileWriteFailed,
@@ -24,7 +24,7 @@ CreateSearchPlanByExpr(CCollection c_col,
     auto schema = col->get_schema();
 
     try {
-        auto res = milvus::query::CreateSearchPlanByExpr(
+        auto res = col->get_search_plan_cache().GetOrCreate(
             schema, serialized_expr_plan, size);
         auto col_index_meta = col->get_index_meta();
         auto field_id = milvus::query::GetFieldID(res.get());
@@ -47,6 +47,9 @@ CreateSearchPlanByExpr(CCollection c_col,
             col_index_meta->GetFieldIndexMeta(milvus::FieldId(field_id));
         res->plan_node_->search_info_.metric_type_ =
             field_index_meta.GeMetricType();
+        col->get_field_access_stats()->Record(res->plan_node_->filter_fields_,
+                                              res->target_entries_,
+                                              milvus::FieldId(field_id));
 
         auto status = CStatus();
         status.error_code = milvus::Success;
@@ -158,6 +161,10 @@ CreateRetrievePlanByExpr(CCollection c_col,
     try {
         auto res = milvus::query::CreateRetrievePlanByExpr(
             col->get_schema(), serialized_expr_plan, size);
+        if (res->plan_node_ != nullptr) {
+            col->get_field_access_stats()->Record(
+                res->plan_node_->filter_fields_, res->field_ids_, std::nullopt);
+        }
 
         auto status = CStatus();
         status.error_code = milvus::Success;
@@ -0,0 +1,223 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "segcore/projection_reader.h"
+
+#include <algorithm>
+#include <future>
+#include <map>
+#include <utility>
+
+#include <arrow/array/builder_primitive.h>
+#include <arrow/compute/api_vector.h>
+#include "common/Common.h"
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "milvus-storage/format/parquet/file_reader.h"
+#include "segcore/Utils.h"
+#include "segcore/memory_planner.h"
+#include "storage/KeyRetriever.h"
+#include "storage/ThreadPools.h"
+
+namespace milvus::segcore {
+
+std::vector<RowLocation>
+LocateRows(const std::vector<std::vector<int64_t>>& row_group_row_counts,
+           const std::vector<int64_t>& offsets) {
+    // the first row of every row group, and where the row group is
+    std::vector<int64_t> row_group_starts;
+    std::vector<std::pair<size_t, int64_t>> row_groups;
+    int64_t total_rows = 0;
+    for (size_t file_idx = 0; file_idx < row_group_row_counts.size();
+         ++file_idx) {
+        const auto& row_counts = row_group_row_counts[file_idx];
+        for (size_t rg_idx = 0; rg_idx < row_counts.size(); ++rg_idx) {
+            row_group_starts.push_back(total_rows);
+            row_groups.emplace_back(file_idx, rg_idx);
+            total_rows += row_counts[rg_idx];
+        }
+    }
+
+    std::vector<RowLocation> locations;
+    locations.reserve(offsets.size());
+    for (auto offset : offsets) {
+        AssertInfo(offset >= 0 && offset < total_rows,
+                   "[StorageV2] row offset {} is out of range [0, {})",
+                   offset,
+                   total_rows);
+        // the last row group starting at or before the offset, which skips
+        // the empty row groups
+        auto it = std::upper_bound(
+            row_group_starts.begin(), row_group_starts.end(), offset);
+        --it;
+        const auto& [file_idx, rg_idx] =
+            row_groups[it - row_group_starts.begin()];
+        locations.push_back({file_idx, rg_idx, offset - *it});
+    }
+    return locations;
+}
+
+std::shared_ptr<arrow::Table>
+ReadRowsWithProjection(
+    milvus::OpContext* op_ctx,
+    const std::vector<std::string>& files,
+    const std::vector<std::vector<int64_t>>& row_group_row_counts,
+    const milvus_storage::ArrowFileSystemPtr& fs,
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::vector<int64_t>& offsets,
+    milvus::proto::common::LoadPriority priority) {
+    AssertInfo(files.size() == row_group_row_counts.size(),
+               "[StorageV2] Number of files must match number of row group "
+               "row counts");
+    AssertInfo(fs != nullptr, "[StorageV2] file system is nullptr");
+    if (offsets.empty()) {
+        AssertInfo(schema != nullptr,
+                   "[StorageV2] schema is required to read no rows");
+        return arrow::Table::MakeEmpty(schema).ValueOrDie();
+    }
+    auto locations = LocateRows(row_group_row_counts, offsets);
+
+    // (file, row group) -> index of its table, in file order
+    std::map<std::pair<size_t, int64_t>, size_t> needed_row_groups;
+    for (const auto& location : locations) {
+        needed_row_groups.emplace(
+            std::make_pair(location.file_index, location.row_group_index), 0);
+    }
+    // read runs of consecutive row groups with one reader each
+    std::vector<std::pair<size_t, RowGroupBlock>> blocks;
+    for (const auto& [row_group, _] : needed_row_groups) {
+        const auto& [file_idx, rg_idx] = row_group;
+        if (!blocks.empty() && blocks.back().first == file_idx &&
+            blocks.back().second.offset + blocks.back().second.count ==
+                rg_idx) {
+            blocks.back().second.count++;
+        } else {
+            blocks.push_back({file_idx, {rg_idx, 1}});
+        }
+    }
+    size_t num_tables = 0;
+    for (auto& [_, table_idx] : needed_row_groups) {
+        table_idx = num_tables++;
+    }
+
+    auto& pool = ThreadPools::GetThreadPool(milvus::PriorityForLoad(priority));
+    std::vector<std::future<std::vector<std::shared_ptr<arrow::Table>>>>
+        futures;
+    futures.reserve(blocks.size());
+    for (const auto& file_block : blocks) {
+        const auto& file = files[file_block.first];
+        auto block = file_block.second;
+        futures.emplace_back(pool.Submit([op_ctx, fs, file, schema, block]() {
+            CheckCancellation(op_ctx, -1, "ReadRowsWithProjection");
+            auto result = milvus_storage::FileRowGroupReader::Make(
+                fs,
+                file,
+                schema,
+                FILE_SLICE_SIZE.load(),
+                milvus::storage::GetReaderProperties());
+            AssertInfo(result.ok(),
+                       "[StorageV2] Failed to create row group reader: " +
+                           result.status().ToString());
+            auto row_group_reader = result.ValueOrDie();
+            auto status = row_group_reader->SetRowGroupOffsetAndCount(
+                block.offset, block.count);
+            AssertInfo(status.ok(),
+                       "[StorageV2] Failed to set row group offset "
+                       "and count " +
+                           std::to_string(block.offset) + " and " +
+                           std::to_string(block.count) + " with error " +
+                           status.ToString());
+            std::vector<std::shared_ptr<arrow::Table>> tables;
+            tables.reserve(block.count);
+            for (int64_t i = 0; i < block.count; ++i) {
+                std::shared_ptr<arrow::Table> table;
+                auto status = row_group_reader->ReadNextRowGroup(&table);
+                AssertInfo(status.ok(),
+                           "[StorageV2] Failed to read row group " +
+                               std::to_string(block.offset + i) +
+                               " from file " + file + " with error " +
+                               status.ToString());
+                tables.push_back(std::move(table));
+            }
+            auto close_status = row_group_reader->Close();
+            AssertInfo(close_status.ok(),
+                       "[StorageV2] Failed to close row group reader "
+                       "for file " +
+                           file + " with error " + close_status.ToString());
+            return tables;
+        }));
+    }
+
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+    tables.reserve(num_tables);
+    std::exception_ptr error;
+    for (auto& future : futures) {
+        try {
+            auto block_tables = future.get();
+            tables.insert(
+                tables.end(), block_tables.begin(), block_tables.end());
+        } catch (...) {
+            if (error == nullptr) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    // the first row of every row group in the concatenated table
+    std::vector<int64_t> table_starts(tables.size());
+    int64_t num_rows = 0;
+    for (size_t i = 0; i < tables.size(); ++i) {
+        table_starts[i] = num_rows;
+        num_rows += tables[i]->num_rows();
+    }
+    arrow::Int64Builder indices_builder;
+    AssertInfo(indices_builder.Reserve(locations.size()).ok(),
+               "[StorageV2] failed to reserve take indices");
+    for (const auto& location : locations) {
+        auto table_idx = needed_row_groups.at(
+            {location.file_index, location.row_group_index});
+        AssertInfo(location.row_offset < tables[table_idx]->num_rows(),
+                   "[StorageV2] row group {} of file {} has {} rows, expected "
+                   "more than {}",
+                   location.row_group_index,
+                   files[location.file_index],
+                   tables[table_idx]->num_rows(),
+                   location.row_offset);
+        indices_builder.UnsafeAppend(table_starts[table_idx] +
+                                     location.row_offset);
+    }
+    std::shared_ptr<arrow::Array> indices;
+    AssertInfo(indices_builder.Finish(&indices).ok(),
+               "[StorageV2] failed to build take indices");
+
+    auto combined = arrow::ConcatenateTables(tables);
+    AssertInfo(combined.ok(),
+               "[StorageV2] failed to concatenate row groups: {}",
+               combined.status().ToString());
+    auto taken = arrow::compute::Take(combined.ValueOrDie(), indices);
+    AssertInfo(taken.ok(),
+               "[StorageV2] failed to take rows: {}",
+               taken.status().ToString());
+    LOG_DEBUG("[StorageV2] read {} rows from {} of the row groups",
+              offsets.size(),
+              tables.size());
+    return taken.ValueOrDie().table();
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,81 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/table.h>
+#include "common/OpContext.h"
+#include "milvus-storage/filesystem/fs.h"
+#include "pb/common.pb.h"
+
+namespace milvus::segcore {
+
+struct RowLocation {
+    size_t file_index;
+    int64_t row_group_index;
+    // offset of the row in its row group
+    int64_t row_offset;
+
+    bool
+    operator==(const RowLocation& other) const {
+        return file_index == other.file_index &&
+               row_group_index == other.row_group_index &&
+               row_offset == other.row_offset;
+    }
+};
+
+/**
+ * Maps row offsets of a column group to the row groups holding them.
+ *
+ * @param row_group_row_counts: row count of every row group of every file,
+ *        the rows of the files follow each other
+ * @param offsets: row offsets in the column group, in any order
+ * @return the location of every offset, in the order of the offsets
+ */
+std::vector<RowLocation>
+LocateRows(const std::vector<std::vector<int64_t>>& row_group_row_counts,
+           const std::vector<int64_t>& offsets);
+
+/**
+ * Reads the rows at the given offsets of a storage v2 column group. Only the
+ * row groups holding one of the rows are read, and only the columns in the
+ * schema are decoded, instead of every column of every row group.
+ *
+ * @param files: the files of the column group
+ * @param row_group_row_counts: row count of every row group of every file
+ * @param fs: the arrow filesystem pointer used to read
+ * @param schema: the columns to read, all columns if nullptr
+ * @param offsets: row offsets in the column group, in any order, may repeat
+ * @return a table with the rows in the order of the offsets
+ */
+std::shared_ptr<arrow::Table>
+ReadRowsWithProjection(
+    milvus::OpContext* op_ctx,
+    const std::vector<std::string>& files,
+    const std::vector<std::vector<int64_t>>& row_group_row_counts,
+    const milvus_storage::ArrowFileSystemPtr& fs,
+    const std::shared_ptr<arrow::Schema>& schema,
+    const std::vector<int64_t>& offsets,
+    milvus::proto::common::LoadPriority priority =
+        milvus::proto::common::LoadPriority::HIGH);
+
+}  // namespace milvus::segcore
@@ -0,0 +1,337 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/reduce/AggregationReduce.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "common/EasyAssert.h"
+#include "common/Types.h"
+#include "common/Utils.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+int64_t
+NumRows(const proto::segcore::RetrieveResults& result) {
+    if (result.fields_data_size() == 0) {
+        return 0;
+    }
+    const auto& data = result.fields_data(0);
+    const auto& scalars = data.scalars();
+    switch (static_cast<DataType>(data.type())) {
+        case DataType::BOOL:
+            return scalars.bool_data().data_size();
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32:
+            return scalars.int_data().data_size();
+        case DataType::INT64:
+            return scalars.long_data().data_size();
+        case DataType::TIMESTAMPTZ:
+            return scalars.timestamptz_data().data_size();
+        case DataType::FLOAT:
+            return scalars.float_data().data_size();
+        case DataType::DOUBLE:
+            return scalars.double_data().data_size();
+        case DataType::VARCHAR:
+        case DataType::STRING:
+            return scalars.string_data().data_size();
+        default:
+            ThrowInfo(DataTypeInvalid,
+                      "unsupported aggregation result type {}",
+                      static_cast<DataType>(data.type()));
+    }
+}
+
+template <typename T>
+void
+AppendEncoded(std::string& key, const T& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+AggregationReduceHelper::AggregationReduceHelper(
+    const plan::AggregationNode& node,
+    std::vector<std::unique_ptr<RetrieveResults>>&& results,
+    size_t num_partitions)
+    : num_keys_(node.GroupingKeys().size()), results_(std::move(results)) {
+    for (const auto& aggregate : node.aggregates()) {
+        const auto& name = aggregate.call_->fun_name();
+        if (name == KSum || name == KCount) {
+            merge_kinds_.push_back(MergeKind::kSum);
+        } else if (name == KMin) {
+            merge_kinds_.push_back(MergeKind::kMin);
+        } else if (name == KMax) {
+            merge_kinds_.push_back(MergeKind::kMax);
+        } else {
+            ThrowInfo(NotImplemented,
+                      "aggregate {} can't be merged across segments",
+                      name);
+        }
+    }
+    auto num_columns = num_keys_ + merge_kinds_.size();
+    for (const auto& result : results_) {
+        if (NumRows(*result) == 0) {
+            continue;
+        }
+        AssertInfo(result->fields_data_size() ==
+                       static_cast<int>(num_columns),
+                   "aggregation result has {} columns, expected {}",
+                   result->fields_data_size(),
+                   num_columns);
+        if (layout_ == nullptr) {
+            layout_ = result.get();
+        }
+    }
+    read_.resize(results_.size());
+    // the groups of a global aggregation all have the same empty key
+    partitions_.resize(num_keys_ == 0 ? 1
+                                      : std::max<size_t>(num_partitions, 1));
+    for (auto& partition : partitions_) {
+        partition.columns_.resize(num_columns);
+    }
+}
+
+void
+AggregationReduceHelper::ReadResult(size_t i) {
+    const auto& result = *results_[i];
+    auto num_rows = NumRows(result);
+    if (num_rows == 0) {
+        return;
+    }
+    auto& read = read_[i];
+    read.columns_.resize(result.fields_data_size());
+    for (int c = 0; c < result.fields_data_size(); c++) {
+        const auto& data = result.fields_data(c);
+        const auto& scalars = data.scalars();
+        auto& values = read.columns_[c];
+        values.reserve(num_rows);
+        switch (static_cast<DataType>(data.type())) {
+            case DataType::BOOL:
+                for (auto v : scalars.bool_data().data()) {
+                    values.emplace_back(static_cast<bool>(v));
+                }
+                break;
+            case DataType::INT8:
+            case DataType::INT16:
+            case DataType::INT32:
+                for (auto v : scalars.int_data().data()) {
+                    values.emplace_back(static_cast<int64_t>(v));
+                }
+                break;
+            case DataType::INT64:
+                for (auto v : scalars.long_data().data()) {
+                    values.emplace_back(static_cast<int64_t>(v));
+                }
+                break;
+            case DataType::TIMESTAMPTZ:
+                for (auto v : scalars.timestamptz_data().data()) {
+                    values.emplace_back(static_cast<int64_t>(v));
+                }
+                break;
+            case DataType::FLOAT:
+                for (auto v : scalars.float_data().data()) {
+                    values.emplace_back(static_cast<double>(v));
+                }
+                break;
+            case DataType::DOUBLE:
+                for (auto v : scalars.double_data().data()) {
+                    values.emplace_back(static_cast<double>(v));
+                }
+                break;
+            case DataType::VARCHAR:
+            case DataType::STRING:
+                for (const auto& v : scalars.string_data().data()) {
+                    values.emplace_back(v);
+                }
+                break;
+            default:
+                ThrowInfo(DataTypeInvalid,
+                          "unsupported aggregation result type {}",
+                          static_cast<DataType>(data.type()));
+        }
+        AssertInfo(static_cast<int64_t>(values.size()) == num_rows,
+                   "aggregation result columns differ in length");
+        for (int row = 0; row < data.valid_data_size(); row++) {
+            if (!data.valid_data(row)) {
+                values[row] = std::monostate{};
+            }
+        }
+    }
+
+    // a key is its values tagged with their types, strings by length first
+    read.keys_.resize(num_rows);
+    read.hashes_.resize(num_rows);
+    for (int64_t row = 0; row < num_rows; row++) {
+        auto& key = read.keys_[row];
+        for (size_t c = 0; c < num_keys_; c++) {
+            const auto& value = read.columns_[c][row];
+            key.push_back(static_cast<char>(value.index()));
+            if (auto v = std::get_if<bool>(&value)) {
+                key.push_back(*v ? 1 : 0);
+            } else if (auto v = std::get_if<int64_t>(&value)) {
+                AppendEncoded(key, *v);
+            } else if (auto v = std::get_if<double>(&value)) {
+                AppendEncoded(key, *v);
+            } else if (auto v = std::get_if<std::string>(&value)) {
+                AppendEncoded(key, v->size());
+                key.append(*v);
+            }
+        }
+        read.hashes_[row] = std::hash<std::string_view>()(key);
+    }
+}
+
+void
+AggregationReduceHelper::Merge(MergeKind kind,
+                               Value& into,
+                               const Value& value) const {
+    if (std::holds_alternative<std::monostate>(value)) {
+        return;
+    }
+    if (std::holds_alternative<std::monostate>(into)) {
+        into = value;
+        return;
+    }
+    switch (kind) {
+        case MergeKind::kSum:
+            if (auto v = std::get_if<int64_t>(&value)) {
+                std::get<int64_t>(into) += *v;
+            } else {
+                std::get<double>(into) += std::get<double>(value);
+            }
+            break;
+        case MergeKind::kMin:
+            if (value < into) {
+                into = value;
+            }
+            break;
+        case MergeKind::kMax:
+            if (into < value) {
+                into = value;
+            }
+            break;
+    }
+}
+
+void
+AggregationReduceHelper::MergePartition(size_t partition_id) {
+    auto& partition = partitions_[partition_id];
+    auto num_partitions = partitions_.size();
+    for (auto& read : read_) {
+        for (size_t row = 0; row < read.keys_.size(); row++) {
+            if (read.hashes_[row] % num_partitions != partition_id) {
+                continue;
+            }
+            auto [it, inserted] = partition.groups_.emplace(
+                read.keys_[row], partition.groups_.size());
+            if (inserted) {
+                for (size_t c = 0; c < read.columns_.size(); c++) {
+                    partition.columns_[c].push_back(read.columns_[c][row]);
+                }
+                continue;
+            }
+            for (size_t j = 0; j < merge_kinds_.size(); j++) {
+                auto c = num_keys_ + j;
+                Merge(merge_kinds_[j],
+                      partition.columns_[c][it->second],
+                      read.columns_[c][row]);
+            }
+        }
+    }
+}
+
+std::unique_ptr<proto::segcore::RetrieveResults>
+AggregationReduceHelper::Finish() {
+    auto merged = std::make_unique<RetrieveResults>();
+    int64_t all_retrieve_count = 0;
+    int64_t scanned_remote_bytes = 0;
+    int64_t scanned_total_bytes = 0;
+    for (const auto& result : results_) {
+        all_retrieve_count += result->all_retrieve_count();
+        scanned_remote_bytes += result->scanned_remote_bytes();
+        scanned_total_bytes += result->scanned_total_bytes();
+    }
+    if (layout_ == nullptr) {
+        // no segment has a group, any of the results is the merged one
+        if (!results_.empty()) {
+            merged = std::move(results_.front());
+        }
+    } else {
+        for (int c = 0; c < layout_->fields_data_size(); c++) {
+            const auto& layout = layout_->fields_data(c);
+            auto data = merged->add_fields_data();
+            data->set_type(layout.type());
+            data->set_field_id(layout.field_id());
+            data->set_field_name(layout.field_name());
+            auto scalars = data->mutable_scalars();
+            bool has_null = false;
+            for (const auto& partition : partitions_) {
+                for (const auto& value : partition.columns_[c]) {
+                    has_null = has_null ||
+                               std::holds_alternative<std::monostate>(value);
+                }
+            }
+            for (const auto& partition : partitions_) {
+                for (const auto& value : partition.columns_[c]) {
+                    auto valid =
+                        !std::holds_alternative<std::monostate>(value);
+                    if (has_null) {
+                        data->add_valid_data(valid);
+                    }
+                    switch (static_cast<DataType>(layout.type())) {
+                        case DataType::BOOL:
+                            scalars->mutable_bool_data()->add_data(
+                                valid && std::get<bool>(value));
+                            break;
+                        case DataType::INT8:
+                        case DataType::INT16:
+                        case DataType::INT32:
+                            scalars->mutable_int_data()->add_data(
+                                valid ? std::get<int64_t>(value) : 0);
+                            break;
+                        case DataType::INT64:
+                            scalars->mutable_long_data()->add_data(
+                                valid ? std::get<int64_t>(value) : 0);
+                            break;
+                        case DataType::TIMESTAMPTZ:
+                            scalars->mutable_timestamptz_data()->add_data(
+                                valid ? std::get<int64_t>(value) : 0);
+                            break;
+                        case DataType::FLOAT:
+                            scalars->mutable_float_data()->add_data(
+                                valid ? std::get<double>(value) : 0);
+                            break;
+                        case DataType::DOUBLE:
+                            scalars->mutable_double_data()->add_data(
+                                valid ? std::get<double>(value) : 0);
+                            break;
+                        default:
+                            scalars->mutable_string_data()->add_data(
+                                valid ? std::get<std::string>(value) : "");
+                            break;
+                    }
+                }
+            }
+        }
+    }
+    merged->set_all_retrieve_count(all_retrieve_count);
+    merged->set_has_more_result(false);
+    merged->set_scanned_remote_bytes(scanned_remote_bytes);
+    merged->set_scanned_total_bytes(scanned_total_bytes);
+    return merged;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "pb/segcore.pb.h"
+#include "plan/PlanNode.h"
+
+namespace milvus::segcore {
+
+// Merges the results of one aggregation plan on several segments into the
+// result of the plan on all of them. A segment result holds a row per group,
+// the grouping keys first, then the aggregates, and the aggregates of a
+// segment are partial states: counts and sums of the groups add up, mins and
+// maxes keep the extreme.
+//
+// The rows are partitioned by the hash of their keys. Each result is read on
+// its own, then each partition is merged on its own, so both steps can be
+// spread over threads.
+class AggregationReduceHelper {
+ public:
+    using RetrieveResults = proto::segcore::RetrieveResults;
+
+    // Throws unless every aggregate of node merges from its partial states,
+    // avg and the sketches don't.
+    AggregationReduceHelper(
+        const plan::AggregationNode& node,
+        std::vector<std::unique_ptr<RetrieveResults>>&& results,
+        size_t num_partitions);
+
+    size_t
+    num_results() const {
+        return results_.size();
+    }
+
+    size_t
+    num_partitions() const {
+        return partitions_.size();
+    }
+
+    // Reads the rows of result i and hashes their keys. Different results
+    // may be read at once.
+    void
+    ReadResult(size_t i);
+
+    // Merges the groups of a partition, once every result is read.
+    // Different partitions may be merged at once.
+    void
+    MergePartition(size_t partition);
+
+    // The merged result, once every partition is merged.
+    std::unique_ptr<RetrieveResults>
+    Finish();
+
+ private:
+    enum class MergeKind { kSum, kMin, kMax };
+
+    // a scalar of a result column, the integers widened to int64 and the
+    // floats to double
+    using Value =
+        std::variant<std::monostate, bool, int64_t, double, std::string>;
+
+    struct ReadColumns {
+        // columns_[column][row]
+        std::vector<std::vector<Value>> columns_;
+        // the encoded keys of the rows and their hashes
+        std::vector<std::string> keys_;
+        std::vector<size_t> hashes_;
+    };
+
+    struct Partition {
+        // columns_[column][group]
+        std::vector<std::vector<Value>> columns_;
+        // the encoded keys of the groups, pointing into the read results
+        std::unordered_map<std::string_view, size_t> groups_;
+    };
+
+    void
+    Merge(MergeKind kind, Value& into, const Value& value) const;
+
+    size_t num_keys_;
+    std::vector<MergeKind> merge_kinds_;
+    std::vector<std::unique_ptr<RetrieveResults>> results_;
+    // a result holding every column, the types and ids of the merged ones
+    const RetrieveResults* layout_{nullptr};
+    std::vector<ReadColumns> read_;
+    std::vector<Partition> partitions_;
+};
+
+}  // namespace milvus::segcore
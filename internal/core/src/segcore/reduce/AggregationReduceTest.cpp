@@ -0,0 +1,153 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/Utils.h"
+#include "expr/ITypeExpr.h"
+#include "plan/PlanNode.h"
+#include "segcore/reduce/AggregationReduce.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+using RetrieveResults = proto::segcore::RetrieveResults;
+
+namespace {
+
+std::shared_ptr<plan::AggregationNode>
+MakeAggregationNode(bool grouped, std::vector<std::string> agg_names) {
+    std::vector<expr::FieldAccessTypeExprPtr> keys;
+    if (grouped) {
+        keys.push_back(std::make_shared<const expr::FieldAccessTypeExpr>(
+            DataType::VARCHAR, "key", FieldId(101)));
+    }
+    std::vector<plan::AggregationNode::Aggregate> aggregates;
+    for (const auto& name : agg_names) {
+        auto call = std::make_shared<const expr::CallExpr>(
+            name, std::vector<expr::TypedExprPtr>{}, nullptr);
+        aggregates.emplace_back(plan::AggregationNode::Aggregate{call});
+        aggregates.back().resultType_ = DataType::INT64;
+    }
+    return std::make_shared<plan::AggregationNode>(plan::GetNextPlanNodeId(),
+                                                   std::move(keys),
+                                                   std::move(agg_names),
+                                                   std::move(aggregates));
+}
+
+// a segment result grouped by key, with count, sum, min and max columns,
+// INT64_MIN stands for null
+std::unique_ptr<RetrieveResults>
+MakeResult(const std::vector<std::string>& keys,
+           const std::vector<std::vector<int64_t>>& aggregates) {
+    auto result = std::make_unique<RetrieveResults>();
+    auto key = result->add_fields_data();
+    key->set_type(proto::schema::DataType::VarChar);
+    key->set_field_id(101);
+    for (const auto& k : keys) {
+        key->mutable_scalars()->mutable_string_data()->add_data(k);
+    }
+    for (size_t c = 0; c < aggregates.size(); c++) {
+        auto data = result->add_fields_data();
+        data->set_type(proto::schema::DataType::Int64);
+        bool has_null = false;
+        for (auto v : aggregates[c]) {
+            has_null = has_null || v == INT64_MIN;
+        }
+        for (auto v : aggregates[c]) {
+            data->mutable_scalars()->mutable_long_data()->add_data(
+                v == INT64_MIN ? 0 : v);
+            if (has_null) {
+                data->add_valid_data(v != INT64_MIN);
+            }
+        }
+    }
+    result->set_all_retrieve_count(static_cast<int64_t>(keys.size()));
+    return result;
+}
+
+std::unique_ptr<RetrieveResults>
+Reduce(const plan::AggregationNode& node,
+       std::vector<std::unique_ptr<RetrieveResults>>&& results,
+       size_t num_partitions) {
+    AggregationReduceHelper helper(node, std::move(results), num_partitions);
+    for (size_t i = 0; i < helper.num_results(); i++) {
+        helper.ReadResult(i);
+    }
+    for (size_t p = 0; p < helper.num_partitions(); p++) {
+        helper.MergePartition(p);
+    }
+    return helper.Finish();
+}
+
+}  // namespace
+
+TEST(AggregationReduceTest, MergesGroupsAcrossSegments) {
+    auto node = MakeAggregationNode(true, {KCount, KSum, KMin, KMax});
+    for (size_t num_partitions : {1, 3, 16}) {
+        std::vector<std::unique_ptr<RetrieveResults>> results;
+        results.push_back(MakeResult(
+            {"a", "b"}, {{2, 3}, {10, INT64_MIN}, {1, INT64_MIN}, {5, 7}}));
+        results.push_back(MakeResult({}, {{}, {}, {}, {}}));
+        results.push_back(MakeResult({"c", "b", "a"},
+                                     {{1, 4, 1},
+                                      {INT64_MIN, 6, 20},
+                                      {9, 2, -1},
+                                      {9, INT64_MIN, 3}}));
+        auto merged = Reduce(*node, std::move(results), num_partitions);
+        ASSERT_EQ(merged->fields_data_size(), 5);
+        EXPECT_EQ(merged->all_retrieve_count(), 5);
+
+        // group -> {count, sum, min, max}, nulls as INT64_MIN
+        std::map<std::string, std::vector<int64_t>> groups;
+        const auto& keys = merged->fields_data(0).scalars().string_data();
+        ASSERT_EQ(keys.data_size(), 3);
+        for (int row = 0; row < keys.data_size(); row++) {
+            auto& values = groups[keys.data(row)];
+            for (int c = 1; c < 5; c++) {
+                const auto& data = merged->fields_data(c);
+                auto valid =
+                    data.valid_data_size() == 0 || data.valid_data(row);
+                values.push_back(
+                    valid ? data.scalars().long_data().data(row) : INT64_MIN);
+            }
+        }
+        EXPECT_EQ(groups["a"], (std::vector<int64_t>{3, 30, -1, 5}));
+        EXPECT_EQ(groups["b"], (std::vector<int64_t>{7, 6, 2, 7}));
+        EXPECT_EQ(groups["c"], (std::vector<int64_t>{1, INT64_MIN, 9, 9}));
+    }
+}
+
+TEST(AggregationReduceTest, MergesGlobalAggregation) {
+    auto node = MakeAggregationNode(false, {KCount, KMax});
+    std::vector<std::unique_ptr<RetrieveResults>> results;
+    for (auto [count, max] : std::vector<std::pair<int64_t, int64_t>>{
+             {4, 8}, {0, INT64_MIN}, {3, 11}}) {
+        auto result = MakeResult({}, {{count}, {max}});
+        // a global aggregation has no key column
+        result->mutable_fields_data()->DeleteSubrange(0, 1);
+        results.push_back(std::move(result));
+    }
+    auto merged = Reduce(*node, std::move(results), 8);
+    ASSERT_EQ(merged->fields_data_size(), 2);
+    EXPECT_EQ(merged->fields_data(0).scalars().long_data().data(0), 7);
+    EXPECT_EQ(merged->fields_data(1).scalars().long_data().data(0), 11);
+    EXPECT_EQ(merged->fields_data(1).valid_data_size(), 0);
+}
+
+TEST(AggregationReduceTest, RejectsUnmergeableAggregates) {
+    auto node = MakeAggregationNode(true, {"avg"});
+    EXPECT_ANY_THROW(AggregationReduceHelper(
+        *node, std::vector<std::unique_ptr<RetrieveResults>>{}, 4));
+}
@@ -10,6 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "GroupReduce.h"
+
+#include <algorithm>
+
 #include "log/Log.h"
 #include "segcore/SegmentInterface.h"
 #include "segcore/ReduceUtils.h"
@@ -111,16 +114,20 @@ GroupReduceHelper::FilterInvalidSearchResult(SearchResult* search_result) {
 }
 
 int64_t
-GroupReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
-                                              int64_t topk,
-                                              int64_t& offset) {
-    std::priority_queue<SearchResultPair*,
-                        std::vector<SearchResultPair*>,
-                        SearchResultPairComparator>
-        heap;
-    pk_set_.clear();
-    pairs_.clear();
-    pairs_.reserve(num_segments_);
+GroupReduceHelper::MergeOneNQ(int64_t qi,
+                              int64_t topk,
+                              MergeScratch& scratch,
+                              std::vector<int32_t>& merged_segments) {
+    auto& pairs = scratch.pairs_;
+    auto& heap = scratch.heap_;
+    auto& pk_set = scratch.pk_set_;
+    auto& group_by_map = scratch.group_sizes_;
+    pairs.clear();
+    heap.clear();
+    pk_set.clear();
+    group_by_map.clear();
+    // the heap points into pairs, which must not reallocate
+    pairs.reserve(num_segments_);
     for (int i = 0; i < num_segments_; i++) {
         auto search_result = search_results_[i];
         auto offset_beg = search_result->topk_per_nq_prefix_sum_[qi];
@@ -138,30 +145,31 @@ GroupReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
                    "Wrong state, search_result's group_by_values's length is "
                    "not equal to pks' size!");
         auto group_by_val = search_result->group_by_values_.value()[offset_beg];
-        pairs_.emplace_back(primary_key,
-                            distance,
-                            search_result,
-                            i,
-                            offset_beg,
-                            offset_end,
-                            std::move(group_by_val));
-        heap.push(&pairs_.back());
+        pairs.emplace_back(primary_key,
+                           distance,
+                           search_result,
+                           i,
+                           offset_beg,
+                           offset_end,
+                           std::move(group_by_val));
+        heap.push_back(&pairs.back());
     }
 
     // nq has no results for all segments
-    if (heap.size() == 0) {
+    if (heap.empty()) {
         return 0;
     }
+    SearchResultPairComparator comparator;
+    std::make_heap(heap.begin(), heap.end(), comparator);
 
     int64_t group_size = search_results_[0]->group_size_.value();
     int64_t group_by_total_size = group_size * topk;
     int64_t filtered_count = 0;
-    auto start = offset;
-    std::unordered_map<GroupByValueType, int64_t> group_by_map;
 
     auto should_filtered = [&](const PkType& pk,
+                               uint64_t hash,
                                const GroupByValueType& group_by_val) {
-        if (pk_set_.count(pk) != 0)
+        if (pk_set.Contains(pk, hash))
             return true;
         if (group_by_map.size() >= topk &&
             group_by_map.count(group_by_val) == 0)
@@ -171,22 +179,31 @@ GroupReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
         return false;
     };
 
-    while (offset - start < group_by_total_size && !heap.empty()) {
+    while (static_cast<int64_t>(merged_segments.size()) <
+               group_by_total_size &&
+           !heap.empty()) {
         //fetch value
-        auto pilot = heap.top();
-        heap.pop();
+        std::pop_heap(heap.begin(), heap.end(), comparator);
+        auto pilot = heap.back();
+        heap.pop_back();
         auto index = pilot->segment_index_;
-        auto pk = pilot->primary_key_;
+        // the pk of the result, which the pk set may view, not the copy
+        // of the pilot
+        auto search_result = pilot->search_result_;
+        const auto& pk = search_result->primary_keys_[pilot->offset_];
         AssertInfo(pk != INVALID_PK,
                    "Wrong, search results should have been filtered and "
                    "invalid_pk should not be existed");
+        auto hash = search_result->pk_hashes_.empty()
+                        ? PkHash(pk)
+                        : search_result->pk_hashes_[pilot->offset_];
         auto group_by_val = pilot->group_by_value_.value();
 
         //judge filter
-        if (!should_filtered(pk, group_by_val)) {
-            pilot->search_result_->result_offsets_.push_back(offset++);
+        if (!should_filtered(pk, hash, group_by_val)) {
             final_search_records_[index][qi].push_back(pilot->offset_);
-            pk_set_.insert(pk);
+            merged_segments.push_back(index);
+            pk_set.Insert(pk, hash);
             group_by_map[group_by_val] += 1;
         } else {
             filtered_count++;
@@ -195,7 +212,8 @@ GroupReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
         //move pilot forward
         pilot->advance();
         if (pilot->primary_key_ != INVALID_PK) {
-            heap.push(pilot);
+            heap.push_back(pilot);
+            std::push_heap(heap.begin(), heap.end(), comparator);
         }
     }
     return filtered_count;
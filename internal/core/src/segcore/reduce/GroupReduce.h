@@ -35,9 +35,10 @@ class GroupReduceHelper : public ReduceHelper {
     FilterInvalidSearchResult(SearchResult* search_result) override;
 
     int64_t
-    ReduceSearchResultForOneNQ(int64_t qi,
-                               int64_t topk,
-                               int64_t& result_offset) override;
+    MergeOneNQ(int64_t qi,
+               int64_t topk,
+               MergeScratch& scratch,
+               std::vector<int32_t>& merged_segments) override;
 
     void
     RefreshSingleSearchResult(SearchResult* search_result,
@@ -50,9 +51,6 @@ class GroupReduceHelper : public ReduceHelper {
                   int64_t nq_end,
                   std::unique_ptr<milvus::proto::schema::SearchResultData>&
                       search_res_data) override;
-
- private:
-    std::unordered_set<milvus::GroupByValueType> group_by_val_set_{};
 };
 
 }  // namespace milvus::segcore
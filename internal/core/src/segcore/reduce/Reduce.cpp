@@ -12,7 +12,10 @@
 #include "Reduce.h"
 
 #include "log/Log.h"
+#include <atomic>
 #include <cstdint>
+#include <exception>
+#include <future>
 #include <vector>
 
 #include "common/EasyAssert.h"
@@ -21,9 +24,84 @@
 #include "segcore/Utils.h"
 #include "segcore/pkVisitor.h"
 #include "segcore/ReduceUtils.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 
+namespace {
+
+// below this many results a slice is merged on the calling thread
+constexpr int64_t kParallelReduceMinResults = 64 * 1024;
+
+// the per-segment results of one nq, as runs of a LoserTree
+struct NQRuns {
+    const std::vector<SearchResult*>& results_;
+    std::vector<int64_t> offsets_;
+    std::vector<int64_t> ends_;
+
+    bool
+    Exhausted(size_t run) const {
+        return offsets_[run] == ends_[run];
+    }
+
+    // the order of SearchResultPair: larger distance first, then the
+    // smaller pk, then the earlier segment
+    bool
+    Before(size_t left, size_t right) const {
+        auto left_distance = results_[left]->distances_[offsets_[left]];
+        auto right_distance = results_[right]->distances_[offsets_[right]];
+        if (std::fabs(left_distance - right_distance) < EPSILON) {
+            const auto& left_pk = results_[left]->primary_keys_[offsets_[left]];
+            const auto& right_pk =
+                results_[right]->primary_keys_[offsets_[right]];
+            if (left_pk != right_pk) {
+                return left_pk < right_pk;
+            }
+            return left < right;
+        }
+        return left_distance > right_distance;
+    }
+};
+
+// Runs run_worker on degree threads, which claim their tasks from
+// next_task until it reaches end. The calling thread works too, so the
+// tasks complete even if the pool has no idle worker. Rethrows the first
+// error once all workers have stopped.
+template <typename RunWorker>
+void
+RunWorkers(ThreadPool& pool,
+           int64_t degree,
+           RunWorker& run_worker,
+           std::atomic<int64_t>& next_task,
+           int64_t end) {
+    std::vector<std::future<void>> futures;
+    for (int64_t i = 1; i < degree; i++) {
+        futures.emplace_back(pool.Submit(run_worker));
+    }
+    std::exception_ptr error;
+    try {
+        run_worker();
+    } catch (...) {
+        error = std::current_exception();
+        // let the helpers stop at their next task
+        next_task = end;
+    }
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace
+
 void
 ReduceHelper::Initialize() {
     AssertInfo(search_results_.size() > 0, "empty search result");
@@ -211,6 +289,9 @@ ReduceHelper::SortEqualScoresOneNQ(size_t nq_begin,
                 // Start of a new cycle
                 PkType temp_pk =
                     std::move(search_result->primary_keys_[start + i]);
+                bool has_hashes = !search_result->pk_hashes_.empty();
+                uint64_t temp_hash =
+                    has_hashes ? search_result->pk_hashes_[start + i] : 0;
                 int64_t temp_offset = search_result->seg_offsets_[start + i];
                 int32_t temp_elem_idx =
                     search_result->element_level_
@@ -229,6 +310,10 @@ ReduceHelper::SortEqualScoresOneNQ(size_t nq_begin,
                     size_t next = indices[curr];
                     search_result->primary_keys_[start + curr] =
                         std::move(search_result->primary_keys_[start + next]);
+                    if (has_hashes) {
+                        search_result->pk_hashes_[start + curr] =
+                            search_result->pk_hashes_[start + next];
+                    }
                     search_result->seg_offsets_[start + curr] =
                         search_result->seg_offsets_[start + next];
                     if (search_result->element_level_) {
@@ -245,6 +330,9 @@ ReduceHelper::SortEqualScoresOneNQ(size_t nq_begin,
                 }
 
                 search_result->primary_keys_[start + curr] = std::move(temp_pk);
+                if (has_hashes) {
+                    search_result->pk_hashes_[start + curr] = temp_hash;
+                }
                 search_result->seg_offsets_[start + curr] = temp_offset;
                 if (search_result->element_level_) {
                     search_result->element_indices_[start + curr] =
@@ -272,6 +360,8 @@ ReduceHelper::RefreshSearchResults() {
         if (search_result->result_offsets_.size() != 0) {
             RefreshSingleSearchResult(search_result, i, real_topks);
         }
+        // the pks are deduplicated, their hashes would go out of order
+        search_result->pk_hashes_.clear();
         std::partial_sum(real_topks.begin(),
                          real_topks.end(),
                          search_result->topk_per_nq_prefix_sum_.begin() + 1);
@@ -310,83 +400,155 @@ ReduceHelper::RefreshSingleSearchResult(SearchResult* search_result,
 void
 ReduceHelper::FillEntryData() {
     tracer::AutoSpan span("ReduceHelper::FillEntryData", tracer::GetRootSpan());
+    // only the results that survived the reduce are left, so the output
+    // fields are read for at most topk rows of a segment. A segment with no
+    // survivor was not refreshed and still holds all of its results, so it
+    // is skipped.
+    std::vector<SearchResult*> results_to_fill;
     for (auto search_result : search_results_) {
-        auto segment = static_cast<milvus::segcore::SegmentInterface*>(
-            search_result->segment_);
-        std::chrono::high_resolution_clock::time_point get_target_entry_start =
-            std::chrono::high_resolution_clock::now();
-        segment->FillTargetEntry(plan_, *search_result);
-        std::chrono::high_resolution_clock::time_point get_target_entry_end =
-            std::chrono::high_resolution_clock::now();
-        double get_entry_cost =
-            std::chrono::duration<double, std::micro>(get_target_entry_end -
-                                                      get_target_entry_start)
-                .count();
-        milvus::monitor::internal_core_search_get_target_entry_latency.Observe(
-            get_entry_cost / 1000);
+        if (!search_result->result_offsets_.empty()) {
+            results_to_fill.push_back(search_result);
+        }
     }
-}
 
-int64_t
-ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
-                                         int64_t topk,
-                                         int64_t& offset) {
-    std::priority_queue<SearchResultPair*,
-                        std::vector<SearchResultPair*>,
-                        SearchResultPairComparator>
-        heap;
-    pk_set_.clear();
-    pairs_.clear();
-
-    pairs_.reserve(num_segments_);
-    for (int i = 0; i < num_segments_; i++) {
-        auto search_result = search_results_[i];
-        auto offset_beg = search_result->topk_per_nq_prefix_sum_[qi];
-        auto offset_end = search_result->topk_per_nq_prefix_sum_[qi + 1];
-        if (offset_beg == offset_end) {
-            continue;
+    std::atomic<int64_t> next_result{0};
+    int64_t num_results = results_to_fill.size();
+    auto run_worker = [&]() {
+        for (auto i = next_result++; i < num_results; i = next_result++) {
+            auto search_result = results_to_fill[i];
+            auto segment = static_cast<milvus::segcore::SegmentInterface*>(
+                search_result->segment_);
+            std::chrono::high_resolution_clock::time_point
+                get_target_entry_start =
+                    std::chrono::high_resolution_clock::now();
+            segment->FillTargetEntry(plan_, *search_result);
+            std::chrono::high_resolution_clock::time_point
+                get_target_entry_end =
+                    std::chrono::high_resolution_clock::now();
+            double get_entry_cost =
+                std::chrono::duration<double, std::micro>(
+                    get_target_entry_end - get_target_entry_start)
+                    .count();
+            milvus::monitor::internal_core_search_get_target_entry_latency
+                .Observe(get_entry_cost / 1000);
         }
-        auto primary_key = search_result->primary_keys_[offset_beg];
-        auto distance = search_result->distances_[offset_beg];
-        pairs_.emplace_back(
-            primary_key, distance, search_result, i, offset_beg, offset_end);
-        heap.push(&pairs_.back());
+    };
+
+    // segments are filled concurrently, each reading mostly its own mmap'd
+    // or cached chunks. The load pools, HIGH and LOW, stay free for chunks
+    // that have to be fetched on the way.
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::MIDDLE);
+    auto degree = std::min<int64_t>(
+        num_results, static_cast<int64_t>(pool.GetMaxThreadNum()));
+    if (degree <= 1) {
+        run_worker();
+        return;
     }
+    RunWorkers(pool, degree, run_worker, next_result, num_results);
+}
 
-    // nq has no results for all segments
-    if (heap.size() == 0) {
-        return 0;
+int64_t
+ReduceHelper::MergeOneNQ(int64_t qi,
+                         int64_t topk,
+                         MergeScratch& scratch,
+                         std::vector<int32_t>& merged_segments) {
+    NQRuns runs{search_results_};
+    runs.offsets_.resize(num_segments_);
+    runs.ends_.resize(num_segments_);
+    for (int i = 0; i < num_segments_; i++) {
+        runs.offsets_[i] = search_results_[i]->topk_per_nq_prefix_sum_[qi];
+        runs.ends_[i] = search_results_[i]->topk_per_nq_prefix_sum_[qi + 1];
     }
+    LoserTree<NQRuns> tree(runs, num_segments_);
 
+    auto& pk_set = scratch.pk_set_;
+    pk_set.clear();
     int64_t dup_cnt = 0;
-    auto start = offset;
-    while (offset - start < topk && !heap.empty()) {
-        auto pilot = heap.top();
-        heap.pop();
-
-        auto index = pilot->segment_index_;
-        auto pk = pilot->primary_key_;
+    while (static_cast<int64_t>(merged_segments.size()) < topk &&
+           !tree.Exhausted()) {
+        auto index = tree.Winner();
+        auto& offset = runs.offsets_[index];
+        auto search_result = search_results_[index];
+        const auto& pk = search_result->primary_keys_[offset];
         // no valid search result for this nq, break to next
         if (pk == INVALID_PK) {
             break;
         }
+        auto hash = search_result->pk_hashes_.empty()
+                        ? PkHash(pk)
+                        : search_result->pk_hashes_[offset];
         // remove duplicates
-        if (pk_set_.count(pk) == 0) {
-            pilot->search_result_->result_offsets_.push_back(offset++);
-            final_search_records_[index][qi].push_back(pilot->offset_);
-            pk_set_.insert(pk);
+        if (pk_set.Insert(pk, hash)) {
+            final_search_records_[index][qi].push_back(offset);
+            merged_segments.push_back(index);
         } else {
             // skip entity with same primary key
             dup_cnt++;
         }
-        pilot->advance();
-        if (pilot->primary_key_ != INVALID_PK) {
-            heap.push(pilot);
-        }
+        ++offset;
+        tree.Replay();
     }
     return dup_cnt;
 }
 
+int64_t
+ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
+                                         int64_t topk,
+                                         int64_t& offset) {
+    merged_segments_.clear();
+    auto dup_cnt = MergeOneNQ(qi, topk, scratch_, merged_segments_);
+    for (auto index : merged_segments_) {
+        search_results_[index]->result_offsets_.push_back(offset++);
+    }
+    return dup_cnt;
+}
+
+int64_t
+ReduceHelper::ReduceSlice(int64_t nq_begin, int64_t nq_end, int64_t topk) {
+    int64_t num_results = 0;
+    for (auto search_result : search_results_) {
+        num_results += search_result->topk_per_nq_prefix_sum_[nq_end] -
+                       search_result->topk_per_nq_prefix_sum_[nq_begin];
+    }
+    auto& pool = ThreadPools::GetThreadPool(ThreadPoolPriority::HIGH);
+    auto degree =
+        std::min<int64_t>({static_cast<int64_t>(pool.GetMaxThreadNum()),
+                           nq_end - nq_begin,
+                           num_results / kParallelReduceMinResults});
+
+    int64_t offset = 0;
+    int64_t filtered_count = 0;
+    if (degree <= 1) {
+        for (int64_t qi = nq_begin; qi < nq_end; qi++) {
+            filtered_count += ReduceSearchResultForOneNQ(qi, topk, offset);
+        }
+        return filtered_count;
+    }
+
+    // every nq is merged on its own, only the result offsets, which number
+    // the results of the slice in nq order, are handed out afterwards
+    std::vector<std::vector<int32_t>> merged_segments(nq_end - nq_begin);
+    std::vector<int64_t> dup_cnts(nq_end - nq_begin, 0);
+    std::atomic<int64_t> next_nq{nq_begin};
+    auto run_worker = [&]() {
+        MergeScratch scratch;
+        for (auto qi = next_nq++; qi < nq_end; qi = next_nq++) {
+            dup_cnts[qi - nq_begin] = MergeOneNQ(
+                qi, topk, scratch, merged_segments[qi - nq_begin]);
+        }
+    };
+
+    RunWorkers(pool, degree, run_worker, next_nq, nq_end);
+
+    for (int64_t i = 0; i < nq_end - nq_begin; i++) {
+        for (auto index : merged_segments[i]) {
+            search_results_[index]->result_offsets_.push_back(offset++);
+        }
+        filtered_count += dup_cnts[i];
+    }
+    return filtered_count;
+}
+
 void
 ReduceHelper::ReduceResultData() {
     tracer::AutoSpan span("ReduceHelper::ReduceResultData",
@@ -410,11 +572,8 @@ ReduceHelper::ReduceResultData() {
         auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
 
         // reduce search results
-        int64_t offset = 0;
-        for (int64_t qi = nq_begin; qi < nq_end; qi++) {
-            filtered_count += ReduceSearchResultForOneNQ(
-                qi, slice_topKs_[slice_index], offset);
-        }
+        filtered_count +=
+            ReduceSlice(nq_begin, nq_end, slice_topKs_[slice_index]);
     }
     if (filtered_count > 0) {
         LOG_DEBUG("skip duplicated search result, count = {}", filtered_count);
@@ -475,9 +634,10 @@ ReduceHelper::GetSearchResultDataSlice(const int slice_index,
         }
         case milvus::DataType::VARCHAR: {
             auto ids = std::make_unique<milvus::proto::schema::StringArray>();
-            std::vector<std::string> string_pks(result_count);
-            // TODO: prevent mem copy
-            *ids->mutable_data() = {string_pks.begin(), string_pks.end()};
+            ids->mutable_data()->Reserve(result_count);
+            for (int64_t i = 0; i < result_count; i++) {
+                ids->add_data();
+            }
             search_result_data->mutable_ids()->set_allocated_str_id(
                 ids.release());
             break;
@@ -500,10 +660,58 @@ ReduceHelper::GetSearchResultDataSlice(const int slice_index,
         }
     }
 
+    // the results are written in place through the raw arrays, the
+    // repeated field accessors cost more than the copies themselves
+    auto int_ids = pk_type == milvus::DataType::INT64
+                       ? search_result_data->mutable_ids()
+                             ->mutable_int_id()
+                             ->mutable_data()
+                             ->mutable_data()
+                       : nullptr;
+    auto str_ids = pk_type == milvus::DataType::VARCHAR
+                       ? search_result_data->mutable_ids()
+                             ->mutable_str_id()
+                             ->mutable_data()
+                       : nullptr;
+    auto scores = search_result_data->mutable_scores()->mutable_data();
+    auto element_indices =
+        search_result_data->element_indices().data_size() > 0
+            ? search_result_data->mutable_element_indices()
+                  ->mutable_data()
+                  ->mutable_data()
+            : nullptr;
+
+    // a nullable vector field only keeps its valid rows, so the row of a
+    // result is the number of valid results before it
+    std::vector<std::vector<std::pair<FieldId, std::vector<int64_t>>>>
+        valid_prefix_sums(search_results_.size());
+    for (auto field_id : plan_->target_entries_) {
+        auto& field_meta = plan_->schema_->operator[](field_id);
+        if (!field_meta.is_vector() || !field_meta.is_nullable()) {
+            continue;
+        }
+        for (size_t i = 0; i < search_results_.size(); i++) {
+            auto& output_fields_data = search_results_[i]->output_fields_data_;
+            auto it = output_fields_data.find(field_id);
+            if (it == output_fields_data.end() ||
+                it->second->valid_data_size() == 0) {
+                continue;
+            }
+            auto& field_data = it->second;
+            std::vector<int64_t> prefix_sum(field_data->valid_data_size() + 1,
+                                            0);
+            for (int64_t j = 0; j < field_data->valid_data_size(); j++) {
+                prefix_sum[j + 1] = prefix_sum[j] + field_data->valid_data(j);
+            }
+            valid_prefix_sums[i].emplace_back(field_id, std::move(prefix_sum));
+        }
+    }
+
     // fill pks and distances
     for (auto qi = nq_begin; qi < nq_end; qi++) {
         int64_t topk_count = 0;
-        for (auto search_result : search_results_) {
+        for (size_t i = 0; i < search_results_.size(); i++) {
+            auto search_result = search_results_[i];
             AssertInfo(search_result != nullptr,
                        "null search result when reorganize");
             if (search_result->result_offsets_.size() == 0) {
@@ -521,62 +729,26 @@ ReduceHelper::GetSearchResultDataSlice(const int slice_index,
                                std::to_string(loc) + ", result_count = " +
                                std::to_string(result_count));
                 // set result pks
-                switch (pk_type) {
-                    case milvus::DataType::INT64: {
-                        search_result_data->mutable_ids()
-                            ->mutable_int_id()
-                            ->mutable_data()
-                            ->Set(loc,
-                                  std::visit(Int64PKVisitor{},
-                                             search_result->primary_keys_[ki]));
-                        break;
-                    }
-                    case milvus::DataType::VARCHAR: {
-                        *search_result_data->mutable_ids()
-                             ->mutable_str_id()
-                             ->mutable_data()
-                             ->Mutable(loc) = std::visit(
-                            StrPKVisitor{}, search_result->primary_keys_[ki]);
-                        break;
-                    }
-                    default: {
-                        ThrowInfo(DataTypeInvalid,
-                                  fmt::format("unsupported primary key type {}",
-                                              pk_type));
-                    }
+                if (int_ids != nullptr) {
+                    int_ids[loc] = std::visit(Int64PKVisitor{},
+                                              search_result->primary_keys_[ki]);
+                } else {
+                    *str_ids->Mutable(loc) = std::visit(
+                        StrPKVisitor{}, search_result->primary_keys_[ki]);
                 }
 
-                search_result_data->mutable_scores()->Set(
-                    loc, search_result->distances_[ki]);
+                scores[loc] = search_result->distances_[ki];
 
                 if (search_result->element_level_) {
-                    search_result_data->mutable_element_indices()
-                        ->mutable_data()
-                        ->Set(loc, search_result->element_indices_[ki]);
+                    element_indices[loc] = search_result->element_indices_[ki];
                 }
 
                 // set result offset to fill output fields data
                 result_pairs[loc] = {&search_result->output_fields_data_, ki};
 
-                for (auto field_id : plan_->target_entries_) {
-                    auto& field_meta = plan_->schema_->operator[](field_id);
-                    if (field_meta.is_vector() && field_meta.is_nullable()) {
-                        auto it =
-                            search_result->output_fields_data_.find(field_id);
-                        if (it != search_result->output_fields_data_.end()) {
-                            auto& field_data = it->second;
-                            if (field_data->valid_data_size() > 0) {
-                                int64_t valid_idx = 0;
-                                for (int64_t i = 0; i < ki; ++i) {
-                                    if (field_data->valid_data(i)) {
-                                        valid_idx++;
-                                    }
-                                }
-                                result_pairs[loc].setValidDataOffset(field_id,
-                                                                     valid_idx);
-                            }
-                        }
-                    }
+                for (auto& [field_id, prefix_sum] : valid_prefix_sums[i]) {
+                    result_pairs[loc].setValidDataOffset(field_id,
+                                                         prefix_sum[ki]);
                 }
             }
         }
@@ -16,6 +16,7 @@
 #include <memory>
 #include <vector>
 #include <queue>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "common/type_c.h"
@@ -78,11 +79,35 @@ class ReduceHelper {
     void
     ReduceResultData();
 
-    virtual int64_t
+    // the state of the merge of one nq, reused by a thread across nqs so
+    // their containers keep their buckets and capacity
+    struct MergeScratch {
+        PkDedupSet pk_set_;
+        std::unordered_map<milvus::GroupByValueType, int64_t> group_sizes_;
+        std::vector<SearchResultPair> pairs_;
+        std::vector<SearchResultPair*> heap_;
+    };
+
+    // reduces nq [nq_begin, nq_end) of a slice, returns the number of
+    // results skipped
+    int64_t
+    ReduceSlice(int64_t nq_begin, int64_t nq_end, int64_t topk);
+
+    int64_t
     ReduceSearchResultForOneNQ(int64_t qi,
                                int64_t topk,
                                int64_t& result_offset);
 
+    // merges the results of nq qi across the segments into
+    // final_search_records_, appending the segment of every kept result to
+    // merged_segments. Only touches the records of qi, so nqs can be merged
+    // concurrently.
+    virtual int64_t
+    MergeOneNQ(int64_t qi,
+               int64_t topk,
+               MergeScratch& scratch,
+               std::vector<int32_t>& merged_segments);
+
     virtual void
     FillOtherData(int result_count,
                   int64_t nq_begin,
@@ -121,8 +146,8 @@ class ReduceHelper {
     std::vector<int64_t> slice_topKs_;
     // Used for merge results,
     // define these here to avoid allocating them for each query
-    std::vector<SearchResultPair> pairs_;
-    std::unordered_set<milvus::PkType> pk_set_;
+    MergeScratch scratch_;
+    std::vector<int32_t> merged_segments_;
     // dim0: num_segments_; dim1: total_nq_; dim2: offset
     std::vector<std::vector<std::vector<int64_t>>> final_search_records_;
     std::vector<int64_t> slice_nqs_;
@@ -448,11 +448,21 @@ StreamReducerHelper::StreamReduceSearchResultForOneNQ(int64_t qi,
         auto pilot = heap_.top();
         heap_.pop();
         auto seg_index = pilot->segment_index_;
-        auto pk = pilot->primary_key_;
-        if (pk == INVALID_PK) {
+        if (pilot->primary_key_ == INVALID_PK) {
             break;  // valid search result for this nq has been run out, break to next
         }
-        if (pk_set_.count(pk) == 0) {
+        // the pk of the result, which the pk set may view, not the copy
+        // of the pilot; only the new results carry their pk hashes
+        auto search_result = pilot->search_result_;
+        const auto& pk =
+            search_result != nullptr
+                ? search_result->primary_keys_[pilot->offset_]
+                : merged_search_result->primary_keys_[pilot->offset_];
+        auto hash = search_result != nullptr &&
+                            !search_result->pk_hashes_.empty()
+                        ? search_result->pk_hashes_[pilot->offset_]
+                        : PkHash(pk);
+        if (!pk_set_.Contains(pk, hash)) {
             bool skip_for_group_by = false;
             if (pilot->group_by_value_.has_value()) {
                 if (group_by_val_set_.count(pilot->group_by_value_.value()) >
@@ -467,7 +477,7 @@ StreamReducerHelper::StreamReduceSearchResultForOneNQ(int64_t qi,
                 } else {
                     merged_search_result->reduced_offsets_.push_back(offset++);
                 }
-                pk_set_.insert(pk);
+                pk_set_.Insert(pk, hash);
                 if (pilot->group_by_value_.has_value()) {
                     group_by_val_set_.insert(pilot->group_by_value_.value());
                 }
@@ -514,6 +524,7 @@ StreamReducerHelper::RefreshSearchResult() {
                 }
             }
             search_result->primary_keys_.swap(reduced_pks);
+            search_result->pk_hashes_.clear();
             search_result->distances_.swap(reduced_distances);
             search_result->seg_offsets_.swap(reduced_seg_offsets);
             if (search_result->group_by_values_.has_value()) {
@@ -14,6 +14,10 @@
 #include "config/ConfigKnowhere.h"
 #include "fmt/core.h"
 #include "log/Log.h"
+#include "index/DiskAnnCacheBudget.h"
+#include "index/IndexFactory.h"
+#include "monitor/Monitor.h"
+#include "segcore/KernelFamilies.h"
 #include "segcore/SegcoreConfig.h"
 #include "segcore/segcore_init_c.h"
 #include "cachinglayer/Manager.h"
@@ -27,6 +31,16 @@ SegcoreInit(const char* conf_file) {
     milvus::config::KnowhereInitImpl(conf_file);
 }
 
+extern "C" void
+SegcoreInitKernels(const bool benchmark) {
+    auto& registry = milvus::KernelRegistry::Instance();
+    RegisterKernelFamilies(registry);
+    registry.Init(benchmark);
+    for (const auto& [family, variant] : registry.Selections()) {
+        milvus::monitor::internal_core_kernel_variant(family, variant).Set(1);
+    }
+}
+
 // TODO merge small index config into one config map, including enable/disable small_index
 extern "C" void
 SegcoreSetChunkRows(const int64_t value) {
@@ -42,6 +56,41 @@ SegcoreSetEnableInterminSegmentIndex(const bool value) {
     config.set_enable_interim_segment_index(value);
 }
 
+extern "C" void
+SegcoreSetEnableInterimIndexAsyncBuild(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_interim_index_async_build(value);
+}
+
+extern "C" void
+SegcoreSetEnableGrowingScalarIndex(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_growing_scalar_index(value);
+}
+
+extern "C" void
+SegcoreSetEnableGrowingVectorMirror(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_growing_vector_mirror(value);
+}
+
+extern "C" void
+SegcoreSetEnableGrowingMinHashLSH(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_growing_minhash_lsh(value);
+}
+
+extern "C" void
+SegcoreSetEnableGrowingSparseInvertedIndex(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_growing_sparse_inverted_index(value);
+}
+
 extern "C" void
 SegcoreSetEnableGeometryCache(const bool value) {
     milvus::segcore::SegcoreConfig& config =
@@ -49,6 +98,27 @@ SegcoreSetEnableGeometryCache(const bool value) {
     config.set_enable_geometry_cache(value);
 }
 
+extern "C" void
+SegcoreSetEnableGrowingStringArena(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_growing_string_arena(value);
+}
+
+extern "C" void
+SegcoreSetVectorGroupChunkCellSize(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_vector_group_chunk_cell_size(value);
+}
+
+extern "C" void
+SegcoreSetScalarGroupChunkCellSize(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_scalar_group_chunk_cell_size(value);
+}
+
 extern "C" void
 SegcoreSetNlist(const int64_t value) {
     milvus::segcore::SegcoreConfig& config =
@@ -63,6 +133,40 @@ SegcoreSetNprobe(const int64_t value) {
     config.set_nprobe(value);
 }
 
+extern "C" void
+SegcoreSetDiskAnnCacheBudget(const int64_t value) {
+    milvus::index::DiskAnnCacheBudget::GetInstance().SetCapacity(
+        value > 0 ? static_cast<uint64_t>(value) : 0);
+}
+
+extern "C" CStatus
+SegcoreSetMmapLoadIndexTypes(const char* value) {
+    try {
+        // comma separated index types
+        std::vector<std::string> index_types;
+        std::string types(value);
+        size_t start = 0;
+        while (start <= types.size()) {
+            auto end = types.find(',', start);
+            if (end == std::string::npos) {
+                end = types.size();
+            }
+            if (end > start) {
+                index_types.push_back(types.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        milvus::index::IndexFactory::GetInstance().SetMmapLoadIndexTypes(
+            index_types);
+        auto status = CStatus();
+        status.error_code = Success;
+        status.error_msg = "";
+        return status;
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 extern "C" CStatus
 SegcoreSetDenseVectorInterminIndexType(const char* value) {
     milvus::segcore::SegcoreConfig& config =
@@ -24,15 +24,44 @@ extern "C" {
 void
 SegcoreInit(const char*);
 
+// picks the kernel variant of every kernel family of the core, the fastest
+// one on a short benchmark if benchmark is set, the widest one otherwise
+void
+SegcoreInitKernels(const bool benchmark);
+
 void
 SegcoreSetChunkRows(const int64_t);
 
 void
 SegcoreSetEnableInterminSegmentIndex(const bool);
 
+void
+SegcoreSetEnableInterimIndexAsyncBuild(const bool);
+
+void
+SegcoreSetEnableGrowingScalarIndex(const bool);
+
+void
+SegcoreSetEnableGrowingVectorMirror(const bool);
+
+void
+SegcoreSetEnableGrowingMinHashLSH(const bool);
+
+void
+SegcoreSetEnableGrowingSparseInvertedIndex(const bool);
+
 void
 SegcoreSetEnableGeometryCache(const bool);
 
+void
+SegcoreSetEnableGrowingStringArena(const bool);
+
+void
+SegcoreSetVectorGroupChunkCellSize(const int64_t);
+
+void
+SegcoreSetScalarGroupChunkCellSize(const int64_t);
+
 void
 SegcoreSetNlist(const int64_t);
 
@@ -42,6 +71,14 @@ SegcoreSetNprobe(const int64_t);
 CStatus
 SegcoreSetDenseVectorInterminIndexType(const char*);
 
+// bytes shared by the node caches of all DiskANN indexes, 0 for no limit
+void
+SegcoreSetDiskAnnCacheBudget(const int64_t);
+
+// comma separated vector index types always loaded memory mapped
+CStatus
+SegcoreSetMmapLoadIndexTypes(const char*);
+
 void
 SegcoreSetSubDim(const int64_t);
 
@@ -11,9 +11,21 @@
 
 #include "segcore/segment_c.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <limits>
-
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include "common/Common.h"
 #include "common/EasyAssert.h"
 #include "common/common_type_c.h"
 #include "pb/cgo_msg.pb.h"
@@ -31,10 +43,13 @@
 #include "mmap/Types.h"
 #include "monitor/scope_metric.h"
 #include "pb/segcore.pb.h"
+#include "query/ExecPlanNodeVisitor.h"
 #include "segcore/Collection.h"
+#include "segcore/SearchCoalescer.h"
 #include "segcore/SegcoreConfig.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "segcore/Utils.h"
+#include "segcore/reduce/AggregationReduce.h"
 #include "storage/Event.h"
 #include "storage/Util.h"
 #include "futures/Future.h"
@@ -87,6 +102,7 @@ CreateSegment(milvus::segcore::Collection* col,
             ThrowInfo(
                 milvus::UnexpectedError, "invalid segment type: {}", seg_type);
     }
+    segment->SetJsonKeyLayoutHints(col->get_json_key_layout_hints());
     return segment;
 }
 
@@ -232,6 +248,151 @@ DeleteSearchResult(CSearchResult search_result) {
     delete res;
 }
 
+// the results of AsyncSearchSegments, one per segment
+using SegmentSearchResults = std::vector<std::unique_ptr<milvus::SearchResult>>;
+
+static void
+SetSearchTraceContext(milvus::query::Plan* plan, const CTraceContext& c_trace) {
+    // save trace context into search_info
+    auto& trace_ctx = plan->plan_node_->search_info_.trace_ctx_;
+    trace_ctx.traceID = c_trace.traceID;
+    trace_ctx.spanID = c_trace.spanID;
+    trace_ctx.traceFlags = c_trace.traceFlags;
+}
+
+// chunks of a field preloaded, as many as a filter scan prefetches before
+// its first batch
+constexpr int64_t kPreloadChunks = 2;
+
+// Issues the loads of the first chunks of the fields a query scans on a
+// sealed segment, the fields served by an index left out. The future is
+// ready once the loads are over, a failed load is raised again by the pins
+// of the query.
+static folly::SemiFuture<folly::Unit>
+PreloadFields(milvus::segcore::SegmentInterface* segment,
+              const std::set<milvus::FieldId>& fields) {
+    auto internal =
+        dynamic_cast<milvus::segcore::SegmentInternalInterface*>(segment);
+    if (internal == nullptr || internal->type() != SegmentType::Sealed) {
+        return folly::makeSemiFuture();
+    }
+    std::vector<ContinueFuture> futures;
+    for (auto field_id : fields) {
+        if (!internal->HasFieldData(field_id) || internal->HasIndex(field_id)) {
+            continue;
+        }
+        auto end = std::min(internal->num_chunk_data(field_id), kPreloadChunks);
+        std::vector<int64_t> chunk_ids(end);
+        std::iota(chunk_ids.begin(), chunk_ids.end(), 0);
+        futures.push_back(
+            internal->prefetch_chunks_async(nullptr, field_id, chunk_ids));
+    }
+    if (futures.empty()) {
+        return folly::makeSemiFuture();
+    }
+    return folly::collectAll(std::move(futures)).unit();
+}
+
+// the fields of the filter of plan and its searched field
+static std::set<milvus::FieldId>
+SearchFields(const milvus::query::Plan* plan) {
+    auto fields = plan->plan_node_->filter_fields_;
+    fields.insert(plan->plan_node_->search_info_.field_id_);
+    return fields;
+}
+
+static std::unique_ptr<milvus::SearchResult>
+SearchSegment(milvus::segcore::SegmentInterface* segment,
+              milvus::query::Plan* plan,
+              const milvus::query::PlaceholderGroup* phg_ptr,
+              uint64_t timestamp,
+              int32_t consistency_level,
+              uint64_t collection_ttl,
+              folly::CancellationToken cancel_token) {
+    auto& trace_ctx = plan->plan_node_->search_info_.trace_ctx_;
+    auto span = milvus::tracer::StartSpan("SegCoreSearch", &trace_ctx);
+    milvus::tracer::SetRootSpan(span);
+
+    segment->LazyCheckSchema(plan->schema_);
+
+    auto search_result = segment->Search(plan,
+                                         phg_ptr,
+                                         timestamp,
+                                         cancel_token,
+                                         consistency_level,
+                                         collection_ttl);
+    if (!milvus::PositivelyRelated(
+            plan->plan_node_->search_info_.metric_type_)) {
+        for (auto& dis : search_result->distances_) {
+            dis *= -1;
+        }
+    }
+    span->End();
+    milvus::tracer::CloseRootSpan();
+    return search_result;
+}
+
+// Tracks the kth best distance of every query over the segments searched
+// so far, larger is better as SearchSegment returns them, so the segments
+// whose distance bounds are below it for all queries can be skipped.
+class SegmentSearchPruner {
+ public:
+    SegmentSearchPruner(int64_t num_queries, int64_t topk)
+        : topk_(topk), heaps_(num_queries) {
+    }
+
+    bool
+    CannotImprove(const std::vector<float>& bounds) const {
+        for (size_t i = 0; i < heaps_.size(); ++i) {
+            // a tie may still place, depending on the primary keys
+            if (heaps_[i].size() < topk_ || bounds[i] >= heaps_[i].top()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void
+    Merge(const milvus::SearchResult& result) {
+        auto topk = result.unity_topK_;
+        if (result.seg_offsets_.size() != heaps_.size() * topk ||
+            result.distances_.size() != heaps_.size() * topk) {
+            return;
+        }
+        for (size_t i = 0; i < heaps_.size(); ++i) {
+            for (size_t j = i * topk; j < (i + 1) * topk; ++j) {
+                if (result.seg_offsets_[j] == INVALID_SEG_OFFSET) {
+                    continue;
+                }
+                heaps_[i].push(result.distances_[j]);
+                if (heaps_[i].size() > topk_) {
+                    heaps_[i].pop();
+                }
+            }
+        }
+    }
+
+ private:
+    const size_t topk_;
+    // the topk distances of every query so far, the kth on top
+    std::vector<
+        std::priority_queue<float, std::vector<float>, std::greater<float>>>
+        heaps_;
+};
+
+// what the search of a segment without active rows returns
+static std::unique_ptr<milvus::SearchResult>
+PrunedSearchResult(milvus::segcore::SegmentInterface* segment,
+                   int64_t num_queries) {
+    auto result = std::make_unique<milvus::SearchResult>();
+    result->total_nq_ = num_queries;
+    result->unity_topK_ = 0;
+    result->total_data_cnt_ = 0;
+    result->segment_ = static_cast<void*>(
+        dynamic_cast<milvus::segcore::SegmentInternalInterface*>(segment));
+    return result;
+}
+
 CFuture*  // Future<milvus::SearchResult>
 AsyncSearch(CTraceContext c_trace,
             CSegmentInterface c_segment,
@@ -239,53 +400,248 @@ AsyncSearch(CTraceContext c_trace,
             CPlaceholderGroup c_placeholder_group,
             uint64_t timestamp,
             int32_t consistency_level,
-            uint64_t collection_ttl) {
+            uint64_t collection_ttl,
+            int64_t timeout_ms) {
     auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
     auto plan = static_cast<milvus::query::Plan*>(c_plan);
     auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(
         c_placeholder_group);
 
-    auto future = milvus::futures::Future<milvus::SearchResult>::async(
+    auto search = [c_trace,
+                   segment,
+                   plan,
+                   phg_ptr,
+                   timestamp,
+                   consistency_level,
+                   collection_ttl](folly::CancellationToken cancel_token) {
+        SetSearchTraceContext(plan, c_trace);
+        auto search_segment =
+            [&](const milvus::query::PlaceholderGroup& placeholder_group) {
+                return SearchSegment(segment,
+                                     plan,
+                                     &placeholder_group,
+                                     timestamp,
+                                     consistency_level,
+                                     collection_ttl,
+                                     cancel_token);
+            };
+        auto& coalescer = milvus::segcore::SearchCoalescer::Instance();
+        if (coalescer.GetWindowMicros() <= 0 ||
+            !milvus::segcore::SearchCoalescer::Coalescable(*plan, *phg_ptr)) {
+            return search_segment(*phg_ptr).release();
+        }
+        milvus::segcore::SearchCoalescer::Key key{segment,
+                                                  plan->signature_,
+                                                  timestamp,
+                                                  consistency_level,
+                                                  collection_ttl};
+        return coalescer.Search(key, *plan, *phg_ptr, search_segment)
+            .release();
+    };
+    // a segment keeps to the cores of an L3 cache once affinity is on
+    auto executor =
+        milvus::futures::getSegmentCPUExecutor(segment->get_segment_id());
+    std::unique_ptr<milvus::futures::Future<milvus::SearchResult>> future;
+    if (milvus::QUERY_ASYNC_PRELOAD_ENABLED.load()) {
+        // the search takes a thread once the first chunks it scans are cached
+        future = milvus::futures::Future<milvus::SearchResult>::asyncAfter(
+            executor,
+            milvus::futures::ExecutePriority::HIGH,
+            [segment, plan](folly::CancellationToken) {
+                return PreloadFields(segment, SearchFields(plan));
+            },
+            std::move(search),
+            milvus::futures::deadlineAfter(timeout_ms));
+    } else {
+        future = milvus::futures::Future<milvus::SearchResult>::async(
+            executor,
+            milvus::futures::ExecutePriority::HIGH,
+            std::move(search),
+            milvus::futures::deadlineAfter(timeout_ms));
+    }
+    return static_cast<CFuture*>(static_cast<void*>(
+        static_cast<milvus::futures::IFuture*>(future.release())));
+}
+
+CFuture*  // Future<SegmentSearchResults>
+AsyncSearchSegments(CTraceContext c_trace,
+                    CSegmentInterface* c_segments,
+                    int64_t num_segments,
+                    CSearchPlan c_plan,
+                    CPlaceholderGroup c_placeholder_group,
+                    uint64_t timestamp,
+                    int32_t consistency_level,
+                    uint64_t collection_ttl,
+                    int64_t timeout_ms) {
+    // shared with the helpers, which may only start after the search is over
+    struct State {
+        std::vector<milvus::segcore::SegmentInterface*> segments_;
+        SegmentSearchResults results_;
+        // the segments in search order and their SearchDistanceBounds,
+        // larger is better
+        std::vector<size_t> order_;
+        std::vector<std::vector<float>> bounds_;
+        std::optional<SegmentSearchPruner> pruner_;
+        size_t pruned_{0};
+        std::atomic<size_t> next_{0};
+        std::mutex mutex_;
+        std::condition_variable done_cv_;
+        size_t done_{0};
+        std::exception_ptr error_;
+    };
+    auto state = std::make_shared<State>();
+    for (int64_t i = 0; i < num_segments; ++i) {
+        state->segments_.push_back(
+            static_cast<milvus::segcore::SegmentInterface*>(c_segments[i]));
+    }
+    state->results_.resize(num_segments);
+    auto plan = static_cast<milvus::query::Plan*>(c_plan);
+    auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(
+        c_placeholder_group);
+
+    auto future = milvus::futures::Future<SegmentSearchResults>::async(
         milvus::futures::getGlobalCPUExecutor(),
         milvus::futures::ExecutePriority::HIGH,
         [c_trace,
-         segment,
+         state,
          plan,
          phg_ptr,
          timestamp,
          consistency_level,
          collection_ttl](folly::CancellationToken cancel_token) {
-            // save trace context into search_info
-            auto& trace_ctx = plan->plan_node_->search_info_.trace_ctx_;
-            trace_ctx.traceID = c_trace.traceID;
-            trace_ctx.spanID = c_trace.spanID;
-            trace_ctx.traceFlags = c_trace.traceFlags;
-
-            auto span = milvus::tracer::StartSpan("SegCoreSearch", &trace_ctx);
-            milvus::tracer::SetRootSpan(span);
-
-            segment->LazyCheckSchema(plan->schema_);
-
-            auto search_result = segment->Search(plan,
-                                                 phg_ptr,
-                                                 timestamp,
-                                                 cancel_token,
-                                                 consistency_level,
-                                                 collection_ttl);
-            if (!milvus::PositivelyRelated(
-                    plan->plan_node_->search_info_.metric_type_)) {
-                for (auto& dis : search_result->distances_) {
-                    dis *= -1;
+            SetSearchTraceContext(plan, c_trace);
+            const auto num_segments = state->segments_.size();
+            auto& search_info = plan->plan_node_->search_info_;
+            const auto num_queries = phg_ptr->at(0).num_of_queries_;
+            // the range searches of the segments prune by each other
+            if (search_info.range_search_bound_ == nullptr) {
+                search_info.range_search_bound_ =
+                    milvus::query::ExecPlanNodeVisitor::NewRangeSearchBound(
+                        *plan->plan_node_, *phg_ptr);
+            }
+            // the segments the clustering centroid stats bound go last,
+            // the most promising first, so the rest can be pruned
+            state->bounds_.resize(num_segments);
+            std::vector<float> best(num_segments,
+                                    std::numeric_limits<float>::infinity());
+            for (size_t i = 0; i < num_segments; ++i) {
+                auto bounds =
+                    state->segments_[i]->SearchDistanceBounds(plan, phg_ptr);
+                if (bounds.empty()) {
+                    continue;
+                }
+                for (auto& bound : bounds) {
+                    if (!milvus::PositivelyRelated(search_info.metric_type_)) {
+                        bound = -bound;
+                    }
+                }
+                best[i] = *std::max_element(bounds.begin(), bounds.end());
+                state->bounds_[i] = std::move(bounds);
+                if (!state->pruner_.has_value()) {
+                    state->pruner_.emplace(num_queries, search_info.topk_);
                 }
             }
-            span->End();
-            milvus::tracer::CloseRootSpan();
-            return search_result.release();
-        });
+            state->order_.resize(num_segments);
+            std::iota(state->order_.begin(), state->order_.end(), 0);
+            std::stable_sort(state->order_.begin(),
+                             state->order_.end(),
+                             [&](size_t a, size_t b) {
+                                 return best[a] > best[b];
+                             });
+
+            // claims segments until none is left, once a search failed the
+            // rest are only counted
+            auto work = [=]() {
+                for (auto slot = state->next_++; slot < num_segments;
+                     slot = state->next_++) {
+                    auto i = state->order_[slot];
+                    std::unique_ptr<milvus::SearchResult> result;
+                    std::exception_ptr error;
+                    bool failed;
+                    bool pruned = false;
+                    {
+                        std::lock_guard<std::mutex> lock(state->mutex_);
+                        failed = state->error_ != nullptr;
+                        pruned = !failed && !state->bounds_[i].empty() &&
+                                 state->pruner_->CannotImprove(
+                                     state->bounds_[i]);
+                    }
+                    if (pruned) {
+                        result = PrunedSearchResult(state->segments_[i],
+                                                    num_queries);
+                    } else if (!failed) {
+                        try {
+                            result = SearchSegment(state->segments_[i],
+                                                   plan,
+                                                   phg_ptr,
+                                                   timestamp,
+                                                   consistency_level,
+                                                   collection_ttl,
+                                                   cancel_token);
+                        } catch (...) {
+                            error = std::current_exception();
+                        }
+                    }
+                    std::lock_guard<std::mutex> lock(state->mutex_);
+                    if (pruned) {
+                        state->pruned_++;
+                    } else if (result != nullptr && state->pruner_) {
+                        state->pruner_->Merge(*result);
+                    }
+                    state->results_[i] = std::move(result);
+                    if (error != nullptr && state->error_ == nullptr) {
+                        state->error_ = error;
+                    }
+                    if (++state->done_ == num_segments) {
+                        state->done_cv_.notify_all();
+                    }
+                }
+            };
+
+            // this task searches too, so the search completes even if no
+            // helper gets a thread of the executor
+            auto* executor = milvus::futures::getGlobalCPUExecutor();
+            auto num_workers =
+                std::min<size_t>(num_segments, executor->numThreads());
+            for (size_t i = 1; i < num_workers; ++i) {
+                executor->addWithPriority(
+                    work, milvus::futures::ExecutePriority::HIGH);
+            }
+            work();
+
+            std::unique_lock<std::mutex> lock(state->mutex_);
+            state->done_cv_.wait(
+                lock, [&]() { return state->done_ == num_segments; });
+            if (state->error_ != nullptr) {
+                std::rethrow_exception(state->error_);
+            }
+            if (state->pruned_ > 0) {
+                LOG_DEBUG("skipped {} of {} segments by their centroids",
+                          state->pruned_,
+                          num_segments);
+            }
+            return new SegmentSearchResults(std::move(state->results_));
+        },
+        milvus::futures::deadlineAfter(timeout_ms));
     return static_cast<CFuture*>(static_cast<void*>(
         static_cast<milvus::futures::IFuture*>(future.release())));
 }
 
+void
+LeakSearchResults(CSearchResults c_results, CSearchResult* results) {
+    auto search_results = static_cast<SegmentSearchResults*>(c_results);
+    for (size_t i = 0; i < search_results->size(); ++i) {
+        results[i] = (*search_results)[i].release();
+    }
+}
+
+void
+DeleteSearchResults(CSearchResults c_results) {
+    SCOPE_CGO_CALL_METRIC();
+
+    delete static_cast<SegmentSearchResults*>(c_results);
+}
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result) {
     delete[] static_cast<uint8_t*>(
@@ -321,38 +677,183 @@ AsyncRetrieve(CTraceContext c_trace,
               int64_t limit_size,
               bool ignore_non_pk,
               int32_t consistency_level,
-              uint64_t collection_ttl) {
+              uint64_t collection_ttl,
+              int64_t timeout_ms) {
     auto segment = static_cast<milvus::segcore::SegmentInterface*>(c_segment);
     auto plan = static_cast<const milvus::query::RetrievePlan*>(c_plan);
+    auto retrieve = [c_trace,
+                     segment,
+                     plan,
+                     timestamp,
+                     limit_size,
+                     ignore_non_pk,
+                     consistency_level,
+                     collection_ttl](folly::CancellationToken cancel_token) {
+        auto trace_ctx = milvus::tracer::TraceContext{
+            c_trace.traceID, c_trace.spanID, c_trace.traceFlags};
+        milvus::tracer::AutoSpan span("SegCoreRetrieve", &trace_ctx, true);
+
+        segment->LazyCheckSchema(plan->schema_);
+
+        auto retrieve_result = segment->Retrieve(&trace_ctx,
+                                                 plan,
+                                                 timestamp,
+                                                 limit_size,
+                                                 ignore_non_pk,
+                                                 cancel_token,
+                                                 consistency_level,
+                                                 collection_ttl);
+
+        return CreateLeakedCRetrieveResultFromProto(std::move(retrieve_result));
+    };
+    // a segment keeps to the cores of an L3 cache once affinity is on
+    auto executor =
+        milvus::futures::getSegmentCPUExecutor(segment->get_segment_id());
+    std::unique_ptr<milvus::futures::Future<CRetrieveResult>> future;
+    if (milvus::QUERY_ASYNC_PRELOAD_ENABLED.load()) {
+        // the query takes a thread once the first chunks it scans are cached
+        future = milvus::futures::Future<CRetrieveResult>::asyncAfter(
+            executor,
+            milvus::futures::ExecutePriority::HIGH,
+            [segment, plan](folly::CancellationToken) {
+                return PreloadFields(segment, plan->plan_node_->filter_fields_);
+            },
+            std::move(retrieve),
+            milvus::futures::deadlineAfter(timeout_ms));
+    } else {
+        future = milvus::futures::Future<CRetrieveResult>::async(
+            executor,
+            milvus::futures::ExecutePriority::HIGH,
+            std::move(retrieve),
+            milvus::futures::deadlineAfter(timeout_ms));
+    }
+    return static_cast<CFuture*>(static_cast<void*>(
+        static_cast<milvus::futures::IFuture*>(future.release())));
+}
+
+// Calls fn(0), ..., fn(n - 1) on the futures executor, the calling thread
+// among the workers, and rethrows the first error once every call is over.
+// After an error the calls left are skipped.
+static void
+ParallelFor(size_t n, const std::function<void(size_t)>& fn) {
+    if (n == 0) {
+        return;
+    }
+    // shared with the helpers, which may only start after the calls are over
+    struct State {
+        std::function<void(size_t)> fn_;
+        std::atomic<size_t> next_{0};
+        std::mutex mutex_;
+        std::condition_variable done_cv_;
+        size_t done_{0};
+        std::exception_ptr error_;
+    };
+    auto state = std::make_shared<State>();
+    state->fn_ = fn;
+    auto work = [=]() {
+        for (auto i = state->next_++; i < n; i = state->next_++) {
+            std::exception_ptr error;
+            bool failed;
+            {
+                std::lock_guard<std::mutex> lock(state->mutex_);
+                failed = state->error_ != nullptr;
+            }
+            if (!failed) {
+                try {
+                    state->fn_(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(state->mutex_);
+            if (error != nullptr && state->error_ == nullptr) {
+                state->error_ = error;
+            }
+            if (++state->done_ == n) {
+                state->done_cv_.notify_all();
+            }
+        }
+    };
+
+    auto* executor = milvus::futures::getGlobalCPUExecutor();
+    auto num_workers = std::min<size_t>(n, executor->numThreads());
+    for (size_t i = 1; i < num_workers; ++i) {
+        executor->addWithPriority(work, milvus::futures::ExecutePriority::HIGH);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex_);
+    state->done_cv_.wait(lock, [&]() { return state->done_ == n; });
+    if (state->error_ != nullptr) {
+        std::rethrow_exception(state->error_);
+    }
+}
+
+CFuture*  // Future<CRetrieveResult>
+AsyncAggregateSegments(CTraceContext c_trace,
+                       CSegmentInterface* c_segments,
+                       int64_t num_segments,
+                       CRetrievePlan c_plan,
+                       uint64_t timestamp,
+                       int64_t limit_size,
+                       int32_t consistency_level,
+                       uint64_t collection_ttl,
+                       int64_t timeout_ms) {
+    std::vector<milvus::segcore::SegmentInterface*> segments;
+    for (int64_t i = 0; i < num_segments; ++i) {
+        segments.push_back(
+            static_cast<milvus::segcore::SegmentInterface*>(c_segments[i]));
+    }
+    auto plan = static_cast<const milvus::query::RetrievePlan*>(c_plan);
     auto future = milvus::futures::Future<CRetrieveResult>::async(
         milvus::futures::getGlobalCPUExecutor(),
         milvus::futures::ExecutePriority::HIGH,
         [c_trace,
-         segment,
+         segments = std::move(segments),
          plan,
          timestamp,
          limit_size,
-         ignore_non_pk,
          consistency_level,
          collection_ttl](folly::CancellationToken cancel_token) {
             auto trace_ctx = milvus::tracer::TraceContext{
                 c_trace.traceID, c_trace.spanID, c_trace.traceFlags};
-            milvus::tracer::AutoSpan span("SegCoreRetrieve", &trace_ctx, true);
-
-            segment->LazyCheckSchema(plan->schema_);
-
-            auto retrieve_result = segment->Retrieve(&trace_ctx,
-                                                     plan,
-                                                     timestamp,
-                                                     limit_size,
-                                                     ignore_non_pk,
-                                                     cancel_token,
-                                                     consistency_level,
-                                                     collection_ttl);
-
-            return CreateLeakedCRetrieveResultFromProto(
-                std::move(retrieve_result));
-        });
+            milvus::tracer::AutoSpan span(
+                "SegCoreAggregateSegments", &trace_ctx, true);
+
+            auto node =
+                std::dynamic_pointer_cast<const milvus::plan::AggregationNode>(
+                    plan->plan_node_->plannodes_);
+            AssertInfo(node != nullptr,
+                       "AsyncAggregateSegments needs an aggregation plan");
+
+            // every segment aggregates its rows into partial states
+            std::vector<
+                std::unique_ptr<milvus::proto::segcore::RetrieveResults>>
+                results(segments.size());
+            ParallelFor(segments.size(), [&](size_t i) {
+                segments[i]->LazyCheckSchema(plan->schema_);
+                results[i] = segments[i]->Retrieve(&trace_ctx,
+                                                   plan,
+                                                   timestamp,
+                                                   limit_size,
+                                                   false,
+                                                   cancel_token,
+                                                   consistency_level,
+                                                   collection_ttl);
+            });
+
+            // then the states of a group merge in the partition of its key
+            milvus::segcore::AggregationReduceHelper helper(
+                *node,
+                std::move(results),
+                milvus::futures::getGlobalCPUExecutor()->numThreads());
+            ParallelFor(helper.num_results(),
+                        [&](size_t i) { helper.ReadResult(i); });
+            ParallelFor(helper.num_partitions(),
+                        [&](size_t i) { helper.MergePartition(i); });
+            return CreateLeakedCRetrieveResultFromProto(helper.Finish());
+        },
+        milvus::futures::deadlineAfter(timeout_ms));
     return static_cast<CFuture*>(static_cast<void*>(
         static_cast<milvus::futures::IFuture*>(future.release())));
 }
@@ -444,6 +945,57 @@ HasFieldData(CSegmentInterface c_segment, int64_t field_id) {
     return segment->HasFieldData(milvus::FieldId(field_id));
 }
 
+CStatus
+SetSegmentClusteringCentroid(CSegmentInterface c_segment,
+                             int64_t field_id,
+                             const float* centroid,
+                             int64_t dim,
+                             float radius) {
+    SCOPE_CGO_CALL_METRIC();
+
+    try {
+        auto segment =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        milvus::segcore::ClusteringCentroid clustering_centroid;
+        clustering_centroid.centroid_.assign(centroid, centroid + dim);
+        clustering_centroid.radius_ = radius;
+        segment->SetClusteringCentroid(milvus::FieldId(field_id),
+                                       std::move(clustering_centroid));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+SegmentMayImproveSearch(CSegmentInterface c_segment,
+                        CSearchPlan c_plan,
+                        CPlaceholderGroup c_placeholder_group,
+                        const float* kth_distances,
+                        bool* may_improve) {
+    SCOPE_CGO_CALL_METRIC();
+
+    try {
+        auto segment =
+            static_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto plan = static_cast<milvus::query::Plan*>(c_plan);
+        auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(
+            c_placeholder_group);
+        auto bounds = segment->SearchDistanceBounds(plan, phg_ptr);
+        auto positively_related = milvus::PositivelyRelated(
+            plan->plan_node_->search_info_.metric_type_);
+        *may_improve = bounds.empty();
+        for (size_t i = 0; i < bounds.size() && !*may_improve; ++i) {
+            *may_improve = positively_related
+                               ? bounds[i] >= kth_distances[i]
+                               : bounds[i] <= kth_distances[i];
+        }
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 //////////////////////////////    interfaces for growing segment    //////////////////////////////
 CStatus
 Insert(CSegmentInterface c_segment,
@@ -477,6 +1029,38 @@ Insert(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+Upsert(CSegmentInterface c_segment,
+       int64_t reserved_offset,
+       int64_t size,
+       const int64_t* row_ids,
+       const uint64_t* timestamps,
+       const uint8_t* data_info,
+       const uint64_t data_info_len) {
+    SCOPE_CGO_CALL_METRIC();
+
+    try {
+        AssertInfo(data_info_len < std::numeric_limits<int>::max(),
+                   "upsert data length ({}) exceeds max int",
+                   data_info_len);
+        auto segment = static_cast<milvus::segcore::SegmentGrowing*>(c_segment);
+        auto insert_record_proto =
+            std::make_unique<milvus::InsertRecordProto>();
+        auto suc =
+            insert_record_proto->ParseFromArray(data_info, data_info_len);
+        AssertInfo(suc, "failed to parse upsert data from records");
+
+        segment->Upsert(reserved_offset,
+                        size,
+                        row_ids,
+                        timestamps,
+                        insert_record_proto.get());
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 PreInsert(CSegmentInterface c_segment, int64_t size, int64_t* offset) {
     SCOPE_CGO_CALL_METRIC();
@@ -528,6 +1112,28 @@ LoadFieldData(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+LoadFromGrowingSegment(CSegmentInterface c_segment,
+                       CSegmentInterface c_growing) {
+    SCOPE_CGO_CALL_METRIC();
+
+    std::shared_ptr<const milvus::segcore::SegmentInterface> owner(
+        static_cast<milvus::segcore::SegmentInterface*>(c_growing));
+    try {
+        auto segment =
+            dynamic_cast<milvus::segcore::ChunkedSegmentSealedImpl*>(
+                static_cast<milvus::segcore::SegmentInterface*>(c_segment));
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto growing = std::dynamic_pointer_cast<
+            const milvus::segcore::SegmentGrowingImpl>(std::move(owner));
+        AssertInfo(growing != nullptr, "growing segment conversion failed");
+        segment->LoadFromGrowing(std::move(growing));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 CStatus
 LoadDeletedRecord(CSegmentInterface c_segment,
                   CLoadDeletedRecordInfo deleted_record_info) {
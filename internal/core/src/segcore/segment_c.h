@@ -26,6 +26,7 @@ extern "C" {
 #include "segcore/load_field_data_c.h"
 
 typedef void* CSearchResult;
+typedef void* CSearchResults;
 typedef CProto CRetrieveResult;
 
 //////////////////////////////    common interfaces    //////////////////////////////
@@ -134,6 +135,9 @@ ClearSegmentData(CSegmentInterface c_segment);
 void
 DeleteSearchResult(CSearchResult search_result);
 
+// The async calls take the milliseconds the request has left, timeout_ms,
+// zero for no deadline. A call past it is cancelled, a call past it before
+// it starts never runs, and a call close to it runs after the others.
 CFuture*  // Future<CSearchResultBody>
 AsyncSearch(CTraceContext c_trace,
             CSegmentInterface c_segment,
@@ -141,7 +145,29 @@ AsyncSearch(CTraceContext c_trace,
             CPlaceholderGroup c_placeholder_group,
             uint64_t timestamp,
             int32_t consistency_level,
-            uint64_t collection_ttl);
+            uint64_t collection_ttl,
+            int64_t timeout_ms);
+
+// Searches num_segments segments with one plan and placeholder group in a
+// single future, the segments are spread over the futures executor.
+CFuture*  // Future<CSearchResults>
+AsyncSearchSegments(CTraceContext c_trace,
+                    CSegmentInterface* c_segments,
+                    int64_t num_segments,
+                    CSearchPlan c_plan,
+                    CPlaceholderGroup c_placeholder_group,
+                    uint64_t timestamp,
+                    int32_t consistency_level,
+                    uint64_t collection_ttl,
+                    int64_t timeout_ms);
+
+// Moves the result of each segment out of c_results into results, in the
+// order the segments were given. Each is released by DeleteSearchResult.
+void
+LeakSearchResults(CSearchResults c_results, CSearchResult* results);
+
+void
+DeleteSearchResults(CSearchResults c_results);
 
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result);
@@ -154,7 +180,22 @@ AsyncRetrieve(CTraceContext c_trace,
               int64_t limit_size,
               bool ignore_non_pk,
               int32_t consistency_level,
-              uint64_t collection_ttl);
+              uint64_t collection_ttl,
+              int64_t timeout_ms);
+
+// Runs an aggregation plan on num_segments segments in a single future and
+// merges the groups of the segments, the result is that of the plan on all
+// of them. Only sum, count, min and max aggregates merge.
+CFuture*  // Future<CRetrieveResult>
+AsyncAggregateSegments(CTraceContext c_trace,
+                       CSegmentInterface* c_segments,
+                       int64_t num_segments,
+                       CRetrievePlan c_plan,
+                       uint64_t timestamp,
+                       int64_t limit_size,
+                       int32_t consistency_level,
+                       uint64_t collection_ttl,
+                       int64_t timeout_ms);
 
 CFuture*  // Future<CRetrieveResult>
 AsyncRetrieveByOffsets(CTraceContext c_trace,
@@ -181,6 +222,27 @@ HasRawData(CSegmentInterface c_segment, int64_t field_id);
 bool
 HasFieldData(CSegmentInterface c_segment, int64_t field_id);
 
+// Attaches the clustering centroid of a float vector field: no vector of
+// the segment is further than radius, in L2, from the dim floats of
+// centroid. AsyncSearchSegments skips the segment when it can't improve the
+// topk found so far.
+CStatus
+SetSegmentClusteringCentroid(CSegmentInterface c_segment,
+                             int64_t field_id,
+                             const float* centroid,
+                             int64_t dim,
+                             float radius);
+
+// Sets *may_improve to false when no row of the segment can place in the
+// topk of any query of the plan, given the kth distance found so far for
+// each query as the metric computes it.
+CStatus
+SegmentMayImproveSearch(CSegmentInterface c_segment,
+                        CSearchPlan c_plan,
+                        CPlaceholderGroup c_placeholder_group,
+                        const float* kth_distances,
+                        bool* may_improve);
+
 //////////////////////////////    interfaces for growing segment    //////////////////////////////
 CStatus
 Insert(CSegmentInterface c_segment,
@@ -191,6 +253,18 @@ Insert(CSegmentInterface c_segment,
        const uint8_t* data_info,
        const uint64_t data_info_len);
 
+// Inserts the rows like Insert, and deletes the rows of the segment with
+// the same pks and older timestamps in the same pass. The rows with these
+// pks in other segments still need a Delete.
+CStatus
+Upsert(CSegmentInterface c_segment,
+       int64_t reserved_offset,
+       int64_t size,
+       const int64_t* row_ids,
+       const uint64_t* timestamps,
+       const uint8_t* data_info,
+       const uint64_t data_info_len);
+
 CStatus
 PreInsert(CSegmentInterface c_segment, int64_t size, int64_t* offset);
 
@@ -199,6 +273,14 @@ CStatus
 LoadFieldData(CSegmentInterface c_segment,
               CLoadFieldDataInfo load_field_data_info);
 
+// Fills c_segment, a sealed segment, with the rows of c_growing, the
+// growing segment it was flushed from, without reading its binlogs. The
+// sealed segment takes c_growing over whether the call succeeds or not, the
+// caller must not delete it after.
+CStatus
+LoadFromGrowingSegment(CSegmentInterface c_segment,
+                       CSegmentInterface c_growing);
+
 CStatus
 LoadDeletedRecord(CSegmentInterface c_segment,
                   CLoadDeletedRecordInfo deleted_record_info);
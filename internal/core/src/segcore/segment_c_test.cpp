@@ -10,8 +10,12 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <thread>
 
 #include "exec/expression/Element.h"
+#include "monitor/Monitor.h"
+#include "segcore/SearchCoalescer.h"
+#include "segcore/SearchResultCache.h"
 #include "segcore/segment_c.h"
 #include "storage/RemoteChunkManagerSingleton.h"
 #include "test_utils/c_api_test_utils.h"
@@ -848,6 +852,100 @@ TEST(CApiTest, SearchTest) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SearchSegmentsTest) {
+    auto c_collection = NewCollection(get_default_schema_config().c_str());
+    auto col = (milvus::segcore::Collection*)c_collection;
+    int64_t num_segments = 3;
+    int N = 2000;
+    int64_t ts_offset = 1000;
+    std::vector<CSegmentInterface> segments(num_segments);
+    for (int64_t i = 0; i < num_segments; i++) {
+        auto status = NewSegment(c_collection, Growing, i, &segments[i], false);
+        ASSERT_EQ(status.error_code, Success);
+        auto dataset = DataGen(col->get_schema(), N, 42 + i);
+        int64_t offset;
+        PreInsert(segments[i], N, &offset);
+        auto insert_data = serialize(dataset.raw_);
+        auto ins_res = Insert(segments[i],
+                              offset,
+                              N,
+                              dataset.row_ids_.data(),
+                              dataset.timestamps_.data(),
+                              insert_data.data(),
+                              insert_data.size());
+        ASSERT_EQ(ins_res.error_code, Success);
+    }
+
+    milvus::proto::plan::PlanNode plan_node;
+    auto vector_anns = plan_node.mutable_vector_anns();
+    vector_anns->set_vector_type(milvus::proto::plan::VectorType::FloatVector);
+    vector_anns->set_placeholder_tag("$0");
+    vector_anns->set_field_id(100);
+    auto query_info = vector_anns->mutable_query_info();
+    query_info->set_topk(10);
+    query_info->set_round_decimal(3);
+    query_info->set_metric_type("L2");
+    query_info->set_search_params(R"({"nprobe": 10})");
+    auto plan_str = plan_node.SerializeAsString();
+
+    int num_queries = 10;
+    auto blob = generate_query_data<milvus::FloatVector>(num_queries);
+
+    void* plan = nullptr;
+    auto status = CreateSearchPlanByExpr(
+        c_collection, plan_str.data(), plan_str.size(), &plan);
+    ASSERT_EQ(status.error_code, Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(
+        plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto future = AsyncSearchSegments({},
+                                      segments.data(),
+                                      num_segments,
+                                      plan,
+                                      placeholderGroup,
+                                      ts_offset,
+                                      0,
+                                      0);
+    auto futurePtr = static_cast<milvus::futures::IFuture*>(
+        static_cast<void*>(static_cast<CFuture*>(future)));
+    std::mutex mu;
+    mu.lock();
+    futurePtr->registerReadyCallback(
+        [](CLockedGoMutex* mutex) { ((std::mutex*)(mutex))->unlock(); },
+        (CLockedGoMutex*)(&mu));
+    mu.lock();
+    auto [c_results, leaky_status] = futurePtr->leakyGet();
+    future_destroy(future);
+    ASSERT_EQ(leaky_status.error_code, Success);
+
+    // each segment gets what a search of it alone gets
+    std::vector<CSearchResult> results(num_segments);
+    LeakSearchResults(c_results, results.data());
+    DeleteSearchResults(c_results);
+    for (int64_t i = 0; i < num_segments; i++) {
+        CSearchResult expected;
+        auto res = CSearch(
+            segments[i], plan, placeholderGroup, ts_offset, &expected);
+        ASSERT_EQ(res.error_code, Success);
+        auto result = (SearchResult*)results[i];
+        auto expected_result = (SearchResult*)expected;
+        ASSERT_EQ(result->seg_offsets_, expected_result->seg_offsets_);
+        ASSERT_EQ(result->distances_, expected_result->distances_);
+        DeleteSearchResult(expected);
+        DeleteSearchResult(results[i]);
+    }
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    for (auto segment : segments) {
+        DeleteSegment(segment);
+    }
+    DeleteCollection(c_collection);
+}
+
 TEST(CApiTest, SearchTestWithExpr) {
     auto c_collection = NewCollection(get_default_schema_config().c_str());
     CSegmentInterface segment;
@@ -1272,6 +1370,169 @@ TEST(CApiTest, SealedSegment_search_without_predicates) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SealedSegment_search_result_cache_through_plan_cache) {
+    std::string schema_string = generate_collection_schema<milvus::FloatVector>(
+        knowhere::metric::L2, DIM);
+    auto collection = NewCollection(schema_string.c_str());
+    auto schema = ((segcore::Collection*)collection)->get_schema();
+    CSegmentInterface segment;
+    auto status = NewSegment(collection, Sealed, -1, &segment, false);
+    ASSERT_EQ(status.error_code, Success);
+
+    uint64_t ts_offset = 1000;
+    auto dataset = DataGen(schema, ROW_COUNT, ts_offset);
+    auto cm = milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+                  .GetRemoteChunkManager();
+    auto excluded_field_ids =
+        GetExcludedFieldIds(dataset.schema_, {0, 1, 100, 101});
+    auto load_info = PrepareInsertBinlog(kCollectionID,
+                                         kPartitionID,
+                                         kSegmentID,
+                                         dataset,
+                                         cm,
+                                         "",
+                                         excluded_field_ids);
+    status = LoadFieldData(segment, &load_info);
+    ASSERT_EQ(status.error_code, Success);
+
+    auto& cache = SearchResCacheManager::Instance();
+    SearchResCacheManager::SetEnabled(true);
+    cache.Clear();
+    cache.SetCapacityBytes(1ULL << 20);
+
+    ScopedSchemaHandle schema_handle(*schema);
+    auto plan_str =
+        schema_handle.ParseSearch("", "fakevec", 5, "L2", R"({"nprobe": 10})");
+    auto blob = generate_query_data<milvus::FloatVector>(1);
+
+    // the second plan is a copy out of the plan cache of the collection
+    std::vector<CSearchResult> results;
+    for (int i = 0; i < 2; ++i) {
+        void* plan = nullptr;
+        status = CreateSearchPlanByExpr(
+            collection, plan_str.data(), plan_str.size(), &plan);
+        ASSERT_EQ(status.error_code, Success);
+        ASSERT_NE(static_cast<query::Plan*>(plan)->signature_, 0);
+        void* placeholderGroup = nullptr;
+        status = ParsePlaceholderGroup(
+            plan, blob.data(), blob.length(), &placeholderGroup);
+        ASSERT_EQ(status.error_code, Success);
+
+        auto hits = cache.GetStats().hits;
+        CSearchResult search_result;
+        auto res = CSearch(segment,
+                           plan,
+                           placeholderGroup,
+                           ROW_COUNT + ts_offset,
+                           &search_result);
+        ASSERT_EQ(res.error_code, Success);
+        EXPECT_EQ(cache.GetStats().hits, hits + i);
+        results.push_back(search_result);
+        DeleteSearchPlan(plan);
+        DeletePlaceholderGroup(placeholderGroup);
+    }
+    EXPECT_EQ(((SearchResult*)results[1])->seg_offsets_,
+              ((SearchResult*)results[0])->seg_offsets_);
+
+    for (auto result : results) {
+        DeleteSearchResult(result);
+    }
+    cache.Clear();
+    SearchResCacheManager::SetEnabled(false);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, SealedSegment_search_coalesced_through_plan_cache) {
+    std::string schema_string = generate_collection_schema<milvus::FloatVector>(
+        knowhere::metric::L2, DIM);
+    auto collection = NewCollection(schema_string.c_str());
+    auto schema = ((segcore::Collection*)collection)->get_schema();
+    CSegmentInterface segment;
+    auto status = NewSegment(collection, Sealed, -1, &segment, false);
+    ASSERT_EQ(status.error_code, Success);
+
+    uint64_t ts_offset = 1000;
+    auto dataset = DataGen(schema, ROW_COUNT, ts_offset);
+    auto cm = milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+                  .GetRemoteChunkManager();
+    auto excluded_field_ids =
+        GetExcludedFieldIds(dataset.schema_, {0, 1, 100, 101});
+    auto load_info = PrepareInsertBinlog(kCollectionID,
+                                         kPartitionID,
+                                         kSegmentID,
+                                         dataset,
+                                         cm,
+                                         "",
+                                         excluded_field_ids);
+    status = LoadFieldData(segment, &load_info);
+    ASSERT_EQ(status.error_code, Success);
+
+    ScopedSchemaHandle schema_handle(*schema);
+    auto plan_str =
+        schema_handle.ParseSearch("", "fakevec", 5, "L2", R"({"nprobe": 10})");
+    auto vec_col = dataset.get_col<float>(FieldId(100));
+
+    // a search of a single query per plan, every plan out of the plan cache
+    constexpr int kSearches = 4;
+    std::vector<void*> plans(kSearches);
+    std::vector<void*> groups(kSearches);
+    for (int i = 0; i < kSearches; ++i) {
+        status = CreateSearchPlanByExpr(
+            collection, plan_str.data(), plan_str.size(), &plans[i]);
+        ASSERT_EQ(status.error_code, Success);
+        auto blob = CreatePlaceholderGroupFromBlob(
+                        1, DIM, vec_col.data() + (BIAS + i) * DIM)
+                        .SerializeAsString();
+        status = ParsePlaceholderGroup(
+            plans[i], blob.data(), blob.length(), &groups[i]);
+        ASSERT_EQ(status.error_code, Success);
+    }
+    auto search = [&](int i) {
+        CSearchResult result;
+        auto res = CSearch(
+            segment, plans[i], groups[i], ROW_COUNT + ts_offset, &result);
+        EXPECT_EQ(res.error_code, Success);
+        return result;
+    };
+
+    std::vector<CSearchResult> expected(kSearches);
+    for (int i = 0; i < kSearches; ++i) {
+        expected[i] = search(i);
+    }
+
+    auto& coalescer = SearchCoalescer::Instance();
+    auto coalesced =
+        monitor::internal_core_search_coalesce_count_search.Value();
+    coalescer.SetWindowMicros(200000);
+    std::vector<CSearchResult> results(kSearches);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kSearches; ++i) {
+        threads.emplace_back([&, i]() { results[i] = search(i); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    coalescer.SetWindowMicros(0);
+    EXPECT_GT(monitor::internal_core_search_coalesce_count_search.Value(),
+              coalesced);
+
+    for (int i = 0; i < kSearches; ++i) {
+        auto result = (SearchResult*)results[i];
+        auto alone = (SearchResult*)expected[i];
+        EXPECT_EQ(result->total_nq_, 1);
+        EXPECT_EQ(result->seg_offsets_, alone->seg_offsets_);
+        EXPECT_EQ(result->distances_, alone->distances_);
+        EXPECT_EQ(result->seg_offsets_[0], BIAS + i);
+        DeleteSearchResult(results[i]);
+        DeleteSearchResult(expected[i]);
+        DeleteSearchPlan(plans[i]);
+        DeletePlaceholderGroup(groups[i]);
+    }
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, SealedSegment_search_float_With_Expr_Predicate_Range) {
     constexpr auto TOPK = 5;
 
@@ -117,6 +117,22 @@ ChunkTranslator::ChunkTranslator(
                          meta_.num_rows_until_chunk_,
                          meta_.virt_chunk_order_,
                          meta_.vcid_to_cid_arr_);
+    // raw scalar chunks compress well and sparse vector chunks have a
+    // compact layout, mmap'd ones are evicted to disk
+    auto data_type = field_meta.get_data_type();
+    auto is_sparse = IsSparseFloatVectorDataType(data_type);
+    if (!use_mmap_ && (!IsVectorDataType(data_type) || is_sparse) &&
+        CompressedCellTier::Instance().GetCapacityBytes() > 0) {
+        meta_.compressed_source_ = std::make_shared<CompressedCellSource>(
+            key_, is_sparse, field_meta.is_nullable());
+    }
+}
+
+ChunkTranslator::~ChunkTranslator() {
+    if (meta_.compressed_source_ != nullptr) {
+        meta_.compressed_source_->retired.store(true);
+        CompressedCellTier::Instance().EraseSource(key_);
+    }
 }
 
 size_t
@@ -162,9 +178,32 @@ ChunkTranslator::get_cells(
         cells;
     cells.reserve(cids.size());
 
-    std::vector<std::string> remote_files;
-    remote_files.reserve(cids.size());
+    // the chunks evicted to the compressed tier are decompressed
+    std::vector<milvus::cachinglayer::cid_t> remote_cids;
+    remote_cids.reserve(cids.size());
     for (auto cid : cids) {
+        auto cell = meta_.compressed_source_ == nullptr
+                        ? std::nullopt
+                        : CompressedCellTier::Instance().Take(key_, cid);
+        if (!cell.has_value()) {
+            remote_cids.push_back(cid);
+            continue;
+        }
+        ChunkBuffer buffer;
+        buffer.data = cell->data.get();
+        buffer.size = cell->size;
+        buffer.row_nums = cell->row_nums;
+        buffer.guard = std::make_shared<ChunkMmapGuard>(
+            std::shared_ptr<const void>(std::move(cell->data)));
+        cells.emplace_back(cid, make_resident_chunk(cid, std::move(buffer)));
+    }
+    if (remote_cids.empty()) {
+        return cells;
+    }
+
+    std::vector<std::string> remote_files;
+    remote_files.reserve(remote_cids.size());
+    for (auto cid : remote_cids) {
         remote_files.push_back(file_infos_[cid].file_path);
     }
 
@@ -172,12 +211,12 @@ ChunkTranslator::get_cells(
     LOG_INFO("segment {} submits load field {} chunks {} task to thread pool",
              segment_id_,
              field_id_,
-             fmt::format("{}", fmt::join(cids, " ")));
-    LoadArrowReaderFromRemote(remote_files, channel, load_priority_);
+             fmt::format("{}", fmt::join(remote_cids, " ")));
+    LoadArrowReaderFromRemote(remote_files, channel, load_priority_, ctx);
 
     auto data_type = field_meta_.get_data_type();
 
-    for (auto cid : cids) {
+    for (auto cid : remote_cids) {
         // Check for cancellation before processing each chunk
         CheckCancellation(
             ctx, segment_id_, field_id_, "ChunkTranslator::get_cells()");
@@ -190,7 +229,8 @@ ChunkTranslator::get_cells(
             AssertInfo(popped, "failed to pop arrow reader from channel");
             arrow::ArrayVector array_vec =
                 read_single_column_batches(r->reader);
-            chunk = create_chunk(field_meta_, array_vec);
+            chunk = make_resident_chunk(
+                cid, create_chunk_buffer(field_meta_, array_vec));
         } else {
             // we don't know the resulting file size beforehand, thus using a separate file for each chunk.
             auto filepath =
@@ -208,13 +248,12 @@ ChunkTranslator::get_cells(
             std::shared_ptr<milvus::ArrowDataWrapper> r;
             bool popped = channel->pop(r);
             AssertInfo(popped, "failed to pop arrow reader from channel");
-            arrow::ArrayVector array_vec =
-                read_single_column_batches(r->reader);
-            chunk = create_chunk(field_meta_,
-                                 array_vec,
-                                 mmap_populate_,
-                                 filepath.string(),
-                                 load_priority_);
+            chunk = create_chunk_from_reader(field_meta_,
+                                             *r,
+                                             mmap_populate_,
+                                             filepath.string(),
+                                             load_priority_,
+                                             ctx);
         }
         cells.emplace_back(cid, std::move(chunk));
     }
@@ -222,4 +261,20 @@ ChunkTranslator::get_cells(
     return cells;
 }
 
+std::unique_ptr<milvus::Chunk>
+ChunkTranslator::make_resident_chunk(milvus::cachinglayer::cid_t cid,
+                                     ChunkBuffer buffer) {
+    if (meta_.compressed_source_ != nullptr) {
+        auto memory = std::move(buffer.guard);
+        buffer.guard = std::make_shared<ChunkMmapGuard>(
+            CompressedCellTier::KeepOnEviction(meta_.compressed_source_,
+                                               cid,
+                                               buffer.data,
+                                               buffer.size,
+                                               buffer.row_nums,
+                                               std::move(memory)));
+    }
+    return make_chunk_from_buffer(field_meta_, buffer);
+}
+
 }  // namespace milvus::segcore::storagev1translator
@@ -17,8 +17,10 @@
 #include "cachinglayer/Translator.h"
 #include "cachinglayer/Utils.h"
 #include "common/Chunk.h"
+#include "common/ChunkWriter.h"
 #include "common/type_c.h"
 #include "mmap/Types.h"
+#include "segcore/CompressedCellTier.h"
 
 namespace milvus::segcore::storagev1translator {
 
@@ -30,6 +32,9 @@ struct CTMeta : public milvus::cachinglayer::Meta {
         vcid_to_cid_arr_;  // the first cid of each virtual chunk
     int64_t
         virt_chunk_order_;  // indicates the size of each virtual chunk, i.e. 2^virt_chunk_order_
+    // the evicted chunks kept compressed in memory, nullptr if the chunks
+    // of the translator are not
+    std::shared_ptr<milvus::segcore::CompressedCellSource> compressed_source_;
     CTMeta(milvus::cachinglayer::StorageType storage_type,
            milvus::cachinglayer::CellIdMappingMode cell_id_mapping_mode,
            milvus::cachinglayer::CellDataType cell_data_type,
@@ -68,6 +73,8 @@ class ChunkTranslator : public milvus::cachinglayer::Translator<milvus::Chunk> {
                     milvus::proto::common::LoadPriority load_priority,
                     const std::string& warmup_policy);
 
+    ~ChunkTranslator() override;
+
     size_t
     num_cells() const override;
     milvus::cachinglayer::cid_t
@@ -93,13 +100,26 @@ class ChunkTranslator : public milvus::cachinglayer::Translator<milvus::Chunk> {
         constexpr int64_t MIN_STORAGE_BYTES = 1 * 1024 * 1024;
         int64_t total_size = 0;
         for (auto cid : cids) {
-            total_size +=
-                std::max(file_infos_[cid].memory_size, MIN_STORAGE_BYTES);
+            // a chunk of the compressed tier is not read from the storage
+            auto compressed_bytes =
+                meta_.compressed_source_ == nullptr
+                    ? 0
+                    : CompressedCellTier::Instance().CompressedBytes(key_,
+                                                                     cid);
+            total_size += compressed_bytes > 0
+                              ? static_cast<int64_t>(compressed_bytes)
+                              : std::max(file_infos_[cid].memory_size,
+                                         MIN_STORAGE_BYTES);
         }
         return total_size;
     }
 
  private:
+    // the chunk of cid on buffer, handed to the compressed tier on eviction
+    // when the translator takes part in it
+    std::unique_ptr<milvus::Chunk>
+    make_resident_chunk(milvus::cachinglayer::cid_t cid, ChunkBuffer buffer);
+
     std::vector<FileInfo> file_infos_;
     int64_t segment_id_;
     int64_t field_id_;
@@ -14,7 +14,6 @@
 #include "common/ChunkWriter.h"
 #include "common/Types.h"
 #include "segcore/Utils.h"
-#include "segcore/Utils.h"
 #include "storage/Util.h"
 
 namespace milvus::segcore::storagev1translator {
@@ -28,6 +27,7 @@ DefaultValueChunkTranslator::DefaultValueChunkTranslator(
     const std::string& warmup_policy)
     : total_rows_(field_data_info.row_count),
       segment_id_(segment_id),
+      field_id_(field_data_info.field_id),
       key_(
           fmt::format("seg_{}_f_{}_def", segment_id, field_data_info.field_id)),
       use_mmap_(use_mmap),
@@ -78,54 +78,46 @@ DefaultValueChunkTranslator::DefaultValueChunkTranslator(
                          meta_.num_rows_until_chunk_,
                          meta_.virt_chunk_order_,
                          meta_.vcid_to_cid_arr_);
+}
 
-    // Pre-build shared buffer for default-value cells: all cells, including
-    // the tail one, will share this buffer. Tail cells will use a smaller
-    // logical row count while reusing the same underlying memory.
-    auto build_buffer_for_rows = [&](int64_t num_rows) -> milvus::ChunkBuffer {
-        auto data_type = field_meta_.get_data_type();
-        std::shared_ptr<arrow::ArrayBuilder> builder;
-        if (IsVectorDataType(data_type)) {
-            AssertInfo(field_meta_.is_nullable(),
-                       "only nullable vector fields can be dynamically added");
-            builder = std::make_shared<arrow::BinaryBuilder>();
-        } else {
-            builder = milvus::storage::CreateArrowBuilder(data_type);
-        }
-        arrow::Status ast;
-        if (field_meta_.default_value().has_value()) {
-            ast = builder->Reserve(num_rows);
-            AssertInfo(
-                ast.ok(), "reserve arrow builder failed: {}", ast.ToString());
-            auto default_scalar =
-                storage::CreateArrowScalarFromDefaultValue(field_meta_);
-            ast = builder->AppendScalar(*default_scalar, num_rows);
-        } else {
-            ast = builder->AppendNulls(num_rows);
-        }
-        AssertInfo(ast.ok(),
-                   "append null/default values to arrow builder failed: {}",
-                   ast.ToString());
-        arrow::ArrayVector array_vec;
-        array_vec.emplace_back(builder->Finish().ValueOrDie());
-        if (!use_mmap_ || mmap_dir_path_.empty()) {
-            return milvus::create_chunk_buffer(
-                field_meta_, array_vec, mmap_populate_);
-        } else {
-            auto filepath =
-                std::filesystem::path(mmap_dir_path_) /
-                fmt::format(
-                    "seg_{}_f_{}_def", segment_id_, field_data_info.field_id);
-            std::filesystem::create_directories(filepath.parent_path());
-            // just use default load priority: proto::common::LoadPriority::HIGH
-            return milvus::create_chunk_buffer(
-                field_meta_, array_vec, mmap_populate_, filepath.string());
-        }
-    };
-
-    if (primary_cell_rows_ > 0) {
-        primary_buffer_ = build_buffer_for_rows(primary_cell_rows_);
+// Every cell, including the tail one, shares this buffer, the tail using a
+// smaller logical row count over the same memory.
+milvus::ChunkBuffer
+DefaultValueChunkTranslator::build_buffer(int64_t num_rows) const {
+    auto data_type = field_meta_.get_data_type();
+    std::shared_ptr<arrow::ArrayBuilder> builder;
+    if (IsVectorDataType(data_type)) {
+        AssertInfo(field_meta_.is_nullable(),
+                   "only nullable vector fields can be dynamically added");
+        builder = std::make_shared<arrow::BinaryBuilder>();
+    } else {
+        builder = milvus::storage::CreateArrowBuilder(data_type);
+    }
+    arrow::Status ast;
+    if (field_meta_.default_value().has_value()) {
+        ast = builder->Reserve(num_rows);
+        AssertInfo(ast.ok(), "reserve arrow builder failed: {}", ast.ToString());
+        auto default_scalar =
+            storage::CreateArrowScalarFromDefaultValue(field_meta_);
+        ast = builder->AppendScalar(*default_scalar, num_rows);
+    } else {
+        ast = builder->AppendNulls(num_rows);
+    }
+    AssertInfo(ast.ok(),
+               "append null/default values to arrow builder failed: {}",
+               ast.ToString());
+    arrow::ArrayVector array_vec;
+    array_vec.emplace_back(builder->Finish().ValueOrDie());
+    if (!use_mmap_ || mmap_dir_path_.empty()) {
+        return milvus::create_chunk_buffer(
+            field_meta_, array_vec, mmap_populate_);
     }
+    auto filepath = std::filesystem::path(mmap_dir_path_) /
+                    fmt::format("seg_{}_f_{}_def", segment_id_, field_id_);
+    std::filesystem::create_directories(filepath.parent_path());
+    // just use default load priority: proto::common::LoadPriority::HIGH
+    return milvus::create_chunk_buffer(
+        field_meta_, array_vec, mmap_populate_, filepath.string());
 }
 
 DefaultValueChunkTranslator::~DefaultValueChunkTranslator() {
@@ -210,13 +202,11 @@ std::pair<milvus::cachinglayer::ResourceUsage,
           milvus::cachinglayer::ResourceUsage>
 DefaultValueChunkTranslator::estimated_byte_size_of_cell(
     milvus::cachinglayer::cid_t cid) const {
-    // TODO: actually only the first cell is used, other cells share the same buffer,
-    // but for now we estimate the same size for all cells
-    auto value_size = this->value_size();
-    auto rows_begin = meta_.num_rows_until_chunk_[cid];
-    auto rows_end = meta_.num_rows_until_chunk_[cid + 1];
-    auto rows = rows_end - rows_begin;
-    auto cell_bytes = value_size * rows;
+    // all cells share one buffer of primary_cell_rows_ rows, so each is
+    // charged its part of that buffer rather than the rows it covers
+    auto buffer_bytes = this->value_size() * primary_cell_rows_;
+    auto cells = static_cast<int64_t>(num_cells());
+    auto cell_bytes = cells > 0 ? (buffer_bytes + cells - 1) / cells : 0;
     if (use_mmap_) {
         return {{0, cell_bytes}, {0, cell_bytes}};
     } else {
@@ -234,8 +224,12 @@ std::vector<
 DefaultValueChunkTranslator::get_cells(
     milvus::OpContext* ctx,
     const std::vector<milvus::cachinglayer::cid_t>& cids) {
-    AssertInfo(primary_buffer_.has_value(),
-               "primary buffer is not initialized");
+    AssertInfo(primary_cell_rows_ > 0, "no cells to get for zero rows");
+    // built at the first access, a default value column nothing reads
+    // costs no memory nor load time
+    std::call_once(primary_buffer_once_, [this]() {
+        primary_buffer_ = build_buffer(primary_cell_rows_);
+    });
 
     std::vector<
         std::pair<milvus::cachinglayer::cid_t, std::unique_ptr<milvus::Chunk>>>
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include <optional>
@@ -68,6 +69,10 @@ class DefaultValueChunkTranslator
     // preferred bytes per cell when splitting default-value column
     static constexpr int64_t kTargetCellBytes = 64 * 1024;  // 64KB
 
+ private:
+    milvus::ChunkBuffer
+    build_buffer(int64_t num_rows) const;
+
  private:
     // total rows of this field in the segment
     int64_t total_rows_{0};
@@ -79,8 +84,10 @@ class DefaultValueChunkTranslator
     // Shared chunk buffers for default-value cells. All cells with the same
     // row count will share the same underlying memory via these buffers.
     std::optional<milvus::ChunkBuffer> primary_buffer_;
+    std::once_flag primary_buffer_once_;
 
     int64_t segment_id_;
+    int64_t field_id_;
     std::string key_;
     bool use_mmap_;
     bool mmap_populate_;
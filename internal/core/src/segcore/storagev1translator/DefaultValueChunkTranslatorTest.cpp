@@ -854,3 +854,43 @@ TEST_F(DefaultValueChunkTranslatorMmapTest, TestMmapFileSize) {
         << "Mmap file size should be at least " << row_count * sizeof(int64_t)
         << " bytes";
 }
+
+// The shared buffer is built at the first get_cells, and the cells together
+// are charged about its size only
+TEST_F(DefaultValueChunkTranslatorMmapTest, TestBufferBuiltLazily) {
+    int64_t row_count = 5000000;
+    int64_t field_id = 107;
+
+    proto::schema::ValueField value_field;
+    value_field.set_long_data(5);
+    FieldMeta field_meta(FieldName("test_lazy_buffer"),
+                         FieldId(field_id),
+                         DataType::INT64,
+                         false,
+                         value_field);
+
+    FieldDataInfo field_data_info(field_id, row_count, temp_dir_.string());
+
+    auto translator = std::make_unique<DefaultValueChunkTranslator>(
+        segment_id_, field_meta, field_data_info, true /* use_mmap */, true);
+
+    auto expected_file =
+        temp_dir_ / fmt::format("seg_{}_f_{}_def", segment_id_, field_id);
+    EXPECT_FALSE(std::filesystem::exists(expected_file));
+
+    int64_t charged = 0;
+    for (size_t i = 0; i < translator->num_cells(); ++i) {
+        auto [usage, peak_usage] = translator->estimated_byte_size_of_cell(i);
+        charged += usage.file_bytes;
+    }
+    auto buffer_bytes =
+        DefaultValueChunkTranslator::kTargetCellBytes / sizeof(int64_t) *
+        sizeof(int64_t);
+    EXPECT_GE(charged, buffer_bytes);
+    EXPECT_LT(charged, buffer_bytes + translator->num_cells());
+
+    std::vector<cachinglayer::cid_t> cids = {1};
+    auto cells = translator->get_cells(nullptr, cids);
+    ASSERT_EQ(cells.size(), 1);
+    EXPECT_TRUE(std::filesystem::exists(expected_file));
+}
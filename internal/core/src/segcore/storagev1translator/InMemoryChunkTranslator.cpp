@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/storagev1translator/InMemoryChunkTranslator.h"
+
+#include "common/ChunkWriter.h"
+#include "common/EasyAssert.h"
+#include "segcore/Utils.h"
+
+namespace milvus::segcore::storagev1translator {
+
+InMemoryChunkTranslator::InMemoryChunkTranslator(
+    int64_t segment_id,
+    FieldMeta field_meta,
+    std::vector<arrow::ArrayVector>&& cells,
+    const std::string& warmup_policy)
+    : key_(fmt::format("seg_{}_f_{}_mem", segment_id, field_meta.get_id().get())),
+      meta_(milvus::cachinglayer::StorageType::MEMORY,
+            milvus::cachinglayer::CellIdMappingMode::IDENTICAL,
+            milvus::segcore::getCellDataType(
+                IsVectorDataType(field_meta.get_data_type()),
+                /* is_index */ false),
+            milvus::segcore::getCacheWarmupPolicy(
+                warmup_policy,
+                IsVectorDataType(field_meta.get_data_type()),
+                /* is_index */ false,
+                /* in_load_list */ true),
+            /* support_eviction */ false),
+      field_meta_(std::move(field_meta)),
+      cells_(std::move(cells)) {
+    meta_.num_rows_until_chunk_.reserve(cells_.size() + 1);
+    meta_.num_rows_until_chunk_.push_back(0);
+    cell_bytes_.reserve(cells_.size());
+    for (const auto& cell : cells_) {
+        int64_t rows = 0;
+        int64_t bytes = 0;
+        for (const auto& array : cell) {
+            rows += array->length();
+            for (const auto& buffer : array->data()->buffers) {
+                bytes += buffer == nullptr ? 0 : buffer->size();
+            }
+        }
+        meta_.num_rows_until_chunk_.push_back(
+            meta_.num_rows_until_chunk_.back() + rows);
+        cell_bytes_.push_back(bytes);
+    }
+    virtual_chunk_config(meta_.num_rows_until_chunk_.back(),
+                         static_cast<int64_t>(cells_.size()),
+                         meta_.num_rows_until_chunk_,
+                         meta_.virt_chunk_order_,
+                         meta_.vcid_to_cid_arr_);
+}
+
+size_t
+InMemoryChunkTranslator::num_cells() const {
+    return cell_bytes_.size();
+}
+
+milvus::cachinglayer::cid_t
+InMemoryChunkTranslator::cell_id_of(milvus::cachinglayer::uid_t uid) const {
+    return uid;
+}
+
+std::pair<milvus::cachinglayer::ResourceUsage,
+          milvus::cachinglayer::ResourceUsage>
+InMemoryChunkTranslator::estimated_byte_size_of_cell(
+    milvus::cachinglayer::cid_t cid) const {
+    return {{cell_bytes_[cid], 0}, {cell_bytes_[cid], 0}};
+}
+
+const std::string&
+InMemoryChunkTranslator::key() const {
+    return key_;
+}
+
+std::vector<
+    std::pair<milvus::cachinglayer::cid_t, std::unique_ptr<milvus::Chunk>>>
+InMemoryChunkTranslator::get_cells(
+    milvus::OpContext* ctx,
+    const std::vector<milvus::cachinglayer::cid_t>& cids) {
+    std::vector<
+        std::pair<milvus::cachinglayer::cid_t, std::unique_ptr<milvus::Chunk>>>
+        res;
+    res.reserve(cids.size());
+    for (auto cid : cids) {
+        arrow::ArrayVector cell;
+        {
+            std::lock_guard lck(mutex_);
+            AssertInfo(cid < cells_.size() && !cells_[cid].empty(),
+                       "cell {} of {} is built already",
+                       cid,
+                       key_);
+            cell = std::move(cells_[cid]);
+            cells_[cid].clear();
+        }
+        res.emplace_back(cid, milvus::create_chunk(field_meta_, cell));
+    }
+    return res;
+}
+
+}  // namespace milvus::segcore::storagev1translator
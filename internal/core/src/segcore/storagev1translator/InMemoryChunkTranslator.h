@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "cachinglayer/Translator.h"
+#include "cachinglayer/Utils.h"
+#include "common/Chunk.h"
+#include "common/FieldMeta.h"
+#include "segcore/storagev1translator/ChunkTranslator.h"
+
+namespace milvus::segcore::storagev1translator {
+
+// Chunks of a column whose data is in memory already, one cell per array
+// vector. A cell is built once, an in-memory column isn't evicted, and its
+// arrays are dropped then; arrays whose buffers are laid out as the chunk
+// are borrowed rather than copied, see create_chunk_buffer.
+class InMemoryChunkTranslator
+    : public milvus::cachinglayer::Translator<milvus::Chunk> {
+ public:
+    InMemoryChunkTranslator(int64_t segment_id,
+                            FieldMeta field_meta,
+                            std::vector<arrow::ArrayVector>&& cells,
+                            const std::string& warmup_policy = "");
+
+    size_t
+    num_cells() const override;
+    milvus::cachinglayer::cid_t
+    cell_id_of(milvus::cachinglayer::uid_t uid) const override;
+    std::pair<milvus::cachinglayer::ResourceUsage,
+              milvus::cachinglayer::ResourceUsage>
+    estimated_byte_size_of_cell(milvus::cachinglayer::cid_t cid) const override;
+    const std::string&
+    key() const override;
+    std::vector<
+        std::pair<milvus::cachinglayer::cid_t, std::unique_ptr<milvus::Chunk>>>
+    get_cells(milvus::OpContext* ctx,
+              const std::vector<milvus::cachinglayer::cid_t>& cids) override;
+
+    milvus::cachinglayer::Meta*
+    meta() override {
+        return &meta_;
+    }
+
+    int64_t
+    cells_storage_bytes(
+        const std::vector<milvus::cachinglayer::cid_t>& cids) const override {
+        return 0;
+    }
+
+ private:
+    std::string key_;
+    CTMeta meta_;
+    milvus::FieldMeta field_meta_;
+    std::vector<int64_t> cell_bytes_;
+    std::mutex mutex_;
+    // under mutex_, emptied once the cell is built
+    std::vector<arrow::ArrayVector> cells_;
+};
+
+}  // namespace milvus::segcore::storagev1translator
@@ -1,8 +1,13 @@
 #include "segcore/storagev1translator/InterimSealedIndexTranslator.h"
 
+#include <filesystem>
+#include <functional>
+
+#include "common/Common.h"
 #include "index/VectorMemIndex.h"
+#include "log/Log.h"
 #include "segcore/Utils.h"
-#include "segcore/Utils.h"
+#include "storage/LocalChunkManagerSingleton.h"
 
 namespace milvus::segcore::storagev1translator {
 
@@ -36,6 +41,25 @@ InterimSealedIndexTranslator::InterimSealedIndexTranslator(
                                                   /* is_vector */ true,
                                                   /* is_index */ true),
             /* support_eviction */ false) {
+    auto chunk_manager =
+        storage::LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+    if (INTERIM_INDEX_DISK_CACHE_ENABLED.load() && !data_version.empty() &&
+        chunk_manager != nullptr) {
+        // any change of the rows or of how they are indexed is a new file
+        auto version = std::hash<std::string>{}(fmt::format(
+            "{}|{}|{}|{}|{}|{}",
+            data_version,
+            index_type_,
+            metric_type_,
+            build_config_.dump(),
+            knowhere::Version::GetCurrentVersion().VersionNumber(),
+            vec_data_->NumRows()));
+        cache_path_ = fmt::format("{}/interim_index/{}/{}/{:016x}",
+                                  chunk_manager->GetRootPath(),
+                                  segment_id_,
+                                  field_id_,
+                                  version);
+    }
 }
 
 size_t
@@ -91,17 +115,17 @@ InterimSealedIndexTranslator::key() const {
     return index_key_;
 }
 
-std::vector<std::pair<milvus::cachinglayer::cid_t,
-                      std::unique_ptr<milvus::index::IndexBase>>>
-InterimSealedIndexTranslator::get_cells(
-    milvus::OpContext* ctx,
-    const std::vector<milvus::cachinglayer::cid_t>& cids) {
-    // Check for cancellation before building interim index
-    CheckCancellation(
-        ctx, segment_id_, "InterimSealedIndexTranslator::get_cells()");
-
-    std::unique_ptr<index::VectorIndex> vec_index = nullptr;
-    if (!is_sparse_) {
+template <typename T>
+std::unique_ptr<index::VectorMemIndex<T>>
+InterimSealedIndexTranslator::create_index() const {
+    if constexpr (std::is_same_v<T, sparse_u32_f32>) {
+        return std::make_unique<index::VectorMemIndex<T>>(
+            DataType::NONE,
+            index_type_,
+            metric_type_,
+            knowhere::Version::GetCurrentVersion().VersionNumber(),
+            false);
+    } else {
         knowhere::ViewDataOp view_data = [field_raw_data_ptr =
                                               vec_data_](size_t id) {
             const void* data;
@@ -116,42 +140,65 @@ InterimSealedIndexTranslator::get_cells(
                 1);
             return data;
         };
-
-        if (vec_data_type_ == DataType::VECTOR_FLOAT) {
-            vec_index = std::make_unique<index::VectorMemIndex<float>>(
-                DataType::NONE,
-                index_type_,
-                metric_type_,
-                knowhere::Version::GetCurrentVersion().VersionNumber(),
-                view_data,
-                false);
-        } else if (vec_data_type_ == DataType::VECTOR_FLOAT16) {
-            vec_index = std::make_unique<index::VectorMemIndex<knowhere::fp16>>(
-                DataType::NONE,
-                index_type_,
-                metric_type_,
-                knowhere::Version::GetCurrentVersion().VersionNumber(),
-                view_data,
-                false);
-        } else if (vec_data_type_ == DataType::VECTOR_BFLOAT16) {
-            vec_index = std::make_unique<index::VectorMemIndex<knowhere::bf16>>(
-                DataType::NONE,
-                index_type_,
-                metric_type_,
-                knowhere::Version::GetCurrentVersion().VersionNumber(),
-                view_data,
-                false);
-        }
-    } else {
-        // sparse vector case
-        vec_index = std::make_unique<index::VectorMemIndex<sparse_u32_f32>>(
+        return std::make_unique<index::VectorMemIndex<T>>(
             DataType::NONE,
             index_type_,
             metric_type_,
             knowhere::Version::GetCurrentVersion().VersionNumber(),
+            view_data,
             false);
     }
+}
+
+template <typename T>
+std::unique_ptr<index::VectorIndex>
+InterimSealedIndexTranslator::load_or_build_index() {
+    if (!cache_path_.empty() && std::filesystem::exists(cache_path_)) {
+        auto vec_index = create_index<T>();
+        try {
+            vec_index->LoadFromLocalFile(cache_path_, build_config_);
+            LOG_INFO("segment {} loads interim index of field {} from {}",
+                     segment_id_,
+                     field_id_,
+                     cache_path_);
+            return vec_index;
+        } catch (std::exception& e) {
+            LOG_WARN(
+                "segment {} failed to load interim index of field {} from "
+                "{}, build it again: {}",
+                segment_id_,
+                field_id_,
+                cache_path_,
+                e.what());
+        }
+    }
+
+    auto vec_index = create_index<T>();
+    if (!build_index(*vec_index) || cache_path_.empty()) {
+        return vec_index;
+    }
+    try {
+        // the files of older binlogs or params of the field are stale now
+        auto dir = std::filesystem::path(cache_path_).parent_path();
+        std::filesystem::remove_all(dir);
+        auto tmp_path = cache_path_ + ".tmp";
+        vec_index->SaveToFile(tmp_path);
+        std::filesystem::rename(tmp_path, cache_path_);
+        LOG_INFO("segment {} keeps interim index of field {} in {}",
+                 segment_id_,
+                 field_id_,
+                 cache_path_);
+    } catch (std::exception& e) {
+        LOG_WARN("segment {} failed to keep interim index of field {}: {}",
+                 segment_id_,
+                 field_id_,
+                 e.what());
+    }
+    return vec_index;
+}
 
+bool
+InterimSealedIndexTranslator::build_index(index::VectorIndex& vec_index) {
     auto num_chunk = vec_data_->num_chunks();
     const auto& offset_mapping = vec_data_->GetOffsetMapping();
     bool nullable = offset_mapping.IsEnabled();
@@ -160,16 +207,8 @@ InterimSealedIndexTranslator::get_cells(
 
     int64_t total_valid_count =
         nullable ? offset_mapping.GetValidCount() : vec_data_->NumRows();
-
     if (total_valid_count == 0) {
-        if (nullable) {
-            const auto& valid_data = vec_data_->GetValidData();
-            vec_index->BuildValidData(valid_data.data(), valid_data.size());
-        }
-        std::vector<std::pair<cid_t, std::unique_ptr<milvus::index::IndexBase>>>
-            result;
-        result.emplace_back(std::make_pair(0, std::move(vec_index)));
-        return result;
+        return false;
     }
 
     bool first_build = true;
@@ -190,14 +229,36 @@ InterimSealedIndexTranslator::get_cells(
         dataset->SetIsSparse(is_sparse_);
 
         if (first_build) {
-            vec_index->BuildWithDataset(dataset, build_config_);
+            vec_index.BuildWithDataset(dataset, build_config_);
             first_build = false;
         } else {
-            vec_index->AddWithDataset(dataset, build_config_);
+            vec_index.AddWithDataset(dataset, build_config_);
         }
     }
+    return true;
+}
+
+std::vector<std::pair<milvus::cachinglayer::cid_t,
+                      std::unique_ptr<milvus::index::IndexBase>>>
+InterimSealedIndexTranslator::get_cells(
+    milvus::OpContext* ctx,
+    const std::vector<milvus::cachinglayer::cid_t>& cids) {
+    // Check for cancellation before building interim index
+    CheckCancellation(
+        ctx, segment_id_, "InterimSealedIndexTranslator::get_cells()");
+
+    std::unique_ptr<index::VectorIndex> vec_index = nullptr;
+    if (is_sparse_) {
+        vec_index = load_or_build_index<sparse_u32_f32>();
+    } else if (vec_data_type_ == DataType::VECTOR_FLOAT) {
+        vec_index = load_or_build_index<float>();
+    } else if (vec_data_type_ == DataType::VECTOR_FLOAT16) {
+        vec_index = load_or_build_index<knowhere::fp16>();
+    } else if (vec_data_type_ == DataType::VECTOR_BFLOAT16) {
+        vec_index = load_or_build_index<knowhere::bf16>();
+    }
 
-    if (nullable) {
+    if (vec_data_->GetOffsetMapping().IsEnabled()) {
         const auto& valid_data = vec_data_->GetValidData();
         vec_index->BuildValidData(valid_data.data(), valid_data.size());
     }
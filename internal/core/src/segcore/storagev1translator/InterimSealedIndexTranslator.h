@@ -13,10 +13,16 @@
 #include "cachinglayer/Translator.h"
 #include "common/Types.h"
 #include "index/Index.h"
+#include "index/VectorMemIndex.h"
 #include "segcore/ChunkedSegmentSealedImpl.h"
 
 namespace milvus::segcore::storagev1translator {
 
+// Builds the interim index of a vector field of a sealed segment without a
+// final index. With INTERIM_INDEX_DISK_CACHE_ENABLED and a data_version
+// naming the binlogs of the field, the index is also written to the local
+// disk cache, and a later load of the same binlogs with the same index
+// params mmaps it from there instead of building it again.
 class InterimSealedIndexTranslator
     : public milvus::cachinglayer::Translator<milvus::index::IndexBase> {
  public:
@@ -30,6 +36,7 @@ class InterimSealedIndexTranslator
         int64_t dim,
         bool is_sparse,
         DataType vec_data_type,
+        const std::string& data_version = "",
         const std::string& warmup_policy = "");
     size_t
     num_cells() const override;
@@ -53,7 +60,27 @@ class InterimSealedIndexTranslator
         return 0;
     }
 
+    // the file the index is kept in, empty when it is not kept on disk
+    const std::string&
+    cache_path() const {
+        return cache_path_;
+    }
+
  private:
+    template <typename T>
+    std::unique_ptr<index::VectorMemIndex<T>>
+    create_index() const;
+
+    // mmaps the index from cache_path_ if it is there, else builds it and
+    // writes it there
+    template <typename T>
+    std::unique_ptr<index::VectorIndex>
+    load_or_build_index();
+
+    // returns false if there is no valid row to build on
+    bool
+    build_index(index::VectorIndex& vec_index);
+
     std::shared_ptr<ChunkedColumnInterface> vec_data_;
     int64_t segment_id_;
     int64_t field_id_;
@@ -65,6 +92,7 @@ class InterimSealedIndexTranslator
     std::string index_key_;
     milvus::cachinglayer::Meta meta_;
     DataType vec_data_type_;
+    std::string cache_path_;
 };
 
 }  // namespace milvus::segcore::storagev1translator
@@ -22,7 +22,11 @@ SealedIndexTranslator::SealedIndexTranslator(
       index_key_(fmt::format("seg_{}_si_{}",
                              load_index_info->segment_id,
                              load_index_info->field_id)),
-      index_load_info_({load_index_info->enable_mmap,
+      index_load_info_({load_index_info->enable_mmap ||
+                            (IsVectorDataType(load_index_info->field_type) &&
+                             !load_index_info->mmap_dir_path.empty() &&
+                             milvus::index::IndexFactory::GetInstance()
+                                 .UseMmapLoad(index_info_.index_type, false)),
                         load_index_info->mmap_dir_path,
                         load_index_info->field_type,
                         load_index_info->element_type,
@@ -36,7 +40,7 @@ SealedIndexTranslator::SealedIndexTranslator(
                         load_index_info->dim,
                         load_index_info->warmup_policy}),
       meta_(
-          load_index_info->enable_mmap
+          index_load_info_.enable_mmap
               ? milvus::cachinglayer::StorageType::DISK
               : milvus::cachinglayer::StorageType::MEMORY,
           milvus::cachinglayer::CellIdMappingMode::ALWAYS_ZERO,
@@ -15,13 +15,17 @@
 // limitations under the License.
 #pragma once
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include "cachinglayer/Translator.h"
 
 namespace milvus::segcore::storagev2translator {
 
-// Number of row groups (parquet row groups) merged into one cache cell,
-// for now it is a constant.
-// hierarchy: 1 group chunk <-> 1 cache cell <-> kRowGroupsPerCell row groups
+// Number of row groups (parquet row groups) merged into one cache cell
+// when no target cell size is configured.
+// hierarchy: 1 group chunk <-> 1 cache cell <-> 1 or more row groups
 constexpr size_t kRowGroupsPerCell = 4;
 static_assert(kRowGroupsPerCell > 0,
               "kRowGroupsPerCell must be greater than 0");
@@ -35,6 +39,9 @@ struct GroupCTMeta : public milvus::cachinglayer::Meta {
     size_t num_fields_;
     // total number of row groups
     size_t total_row_groups_;
+    // cell i holds row groups [cell_row_group_starts_[i],
+    // cell_row_group_starts_[i + 1]), the size is num_cells + 1
+    std::vector<size_t> cell_row_group_starts_;
 
     GroupCTMeta(size_t num_fields,
                 milvus::cachinglayer::StorageType storage_type,
@@ -54,9 +61,46 @@ struct GroupCTMeta : public milvus::cachinglayer::Meta {
     // Get the range of row groups for a cell [start, end)
     std::pair<size_t, size_t>
     get_row_group_range(size_t cid) const {
-        size_t start = cid * kRowGroupsPerCell;
-        size_t end = std::min(start + kRowGroupsPerCell, total_row_groups_);
-        return {start, end};
+        return {cell_row_group_starts_[cid], cell_row_group_starts_[cid + 1]};
+    }
+
+    // Groups adjacent row groups into cells and fills the cell layout.
+    // With a positive target_cell_size a cell takes row groups while their
+    // summed memory size stays within it, so small row groups are coalesced
+    // and a row group larger than the target makes a cell of its own;
+    // otherwise every cell takes kRowGroupsPerCell row groups.
+    void
+    build_cells(const std::vector<int64_t>& row_group_sizes,
+                const std::vector<int64_t>& row_group_rows,
+                int64_t target_cell_size) {
+        total_row_groups_ = row_group_sizes.size();
+        cell_row_group_starts_ = {0};
+        num_rows_until_chunk_ = {0};
+        chunk_memory_size_.clear();
+
+        size_t start = 0;
+        while (start < total_row_groups_) {
+            size_t end = start;
+            int64_t cell_size = 0;
+            int64_t cell_rows = 0;
+            while (end < total_row_groups_) {
+                if (target_cell_size > 0
+                        ? end > start &&
+                              cell_size + row_group_sizes[end] >
+                                  target_cell_size
+                        : end - start == kRowGroupsPerCell) {
+                    break;
+                }
+                cell_size += row_group_sizes[end];
+                cell_rows += row_group_rows[end];
+                ++end;
+            }
+            cell_row_group_starts_.push_back(end);
+            num_rows_until_chunk_.push_back(num_rows_until_chunk_.back() +
+                                            cell_rows);
+            chunk_memory_size_.push_back(cell_size);
+            start = end;
+        }
     }
 };
 
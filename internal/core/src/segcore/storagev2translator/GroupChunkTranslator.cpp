@@ -28,6 +28,7 @@
 #include "storage/ThreadPools.h"
 #include "storage/KeyRetriever.h"
 #include "segcore/memory_planner.h"
+#include "segcore/ParquetMetaCache.h"
 
 #include <memory>
 #include <string>
@@ -113,32 +114,15 @@ GroupChunkTranslator::GroupChunkTranslator(
     auto fs = milvus_storage::ArrowFileSystemSingleton::GetInstance()
                   .GetArrowFileSystem();
 
-    // Get row group metadata from files
+    // Get row group metadata from files, the footers read by a previous
+    // load of the segment are cached
     parquet_file_metadata_.reserve(insert_files_.size());
     row_group_meta_list_.reserve(insert_files_.size());
     for (const auto& file : insert_files_) {
-        auto result = milvus_storage::FileRowGroupReader::Make(
-            fs,
-            file,
-            milvus_storage::DEFAULT_READ_BUFFER_SIZE,
-            storage::GetReaderProperties());
-        AssertInfo(result.ok(),
-                   "[StorageV2] Failed to create file row group reader: " +
-                       result.status().ToString());
-        auto reader = result.ValueOrDie();
-        parquet_file_metadata_.push_back(
-            reader->file_metadata()->GetParquetMetadata());
-
-        field_id_mapping_ = reader->file_metadata()->GetFieldIDMapping();
-        row_group_meta_list_.push_back(
-            reader->file_metadata()->GetRowGroupMetadataVector());
-        auto status = reader->Close();
-        AssertInfo(status.ok(),
-                   "[StorageV2] translator {} failed to close file reader when "
-                   "get row group "
-                   "metadata from file {} with error {}",
-                   key_,
-                   file + " with error: " + status.ToString());
+        auto file_meta = ParquetMetaCache::Instance().Get(fs, file);
+        parquet_file_metadata_.push_back(file_meta->parquet_metadata);
+        field_id_mapping_ = file_meta->field_id_mapping;
+        row_group_meta_list_.push_back(file_meta->row_group_metas);
     }
 
     // Build prefix sum for O(1) lookup in get_cid_from_file_and_row_group_index
@@ -164,27 +148,14 @@ GroupChunkTranslator::GroupChunkTranslator(
         }
     }
 
-    // Build cell mapping: each cell contains up to kRowGroupsPerCell row groups
-    meta_.total_row_groups_ = total_row_groups;
-    size_t num_cells =
-        (total_row_groups + kRowGroupsPerCell - 1) / kRowGroupsPerCell;
-
     // Merge row groups into group chunks(cache cells)
-    meta_.num_rows_until_chunk_.reserve(num_cells + 1);
-    meta_.num_rows_until_chunk_.push_back(0);
-    meta_.chunk_memory_size_.reserve(num_cells);
-
-    int64_t cumulative_rows = 0;
-    for (size_t cell_id = 0; cell_id < num_cells; ++cell_id) {
-        auto [start, end] = meta_.get_row_group_range(cell_id);
-        int64_t cell_size = 0;
-        for (size_t i = start; i < end; ++i) {
-            cumulative_rows += row_group_row_counts[i];
-            cell_size += row_group_sizes[i];
-        }
-        meta_.num_rows_until_chunk_.push_back(cumulative_rows);
-        meta_.chunk_memory_size_.push_back(cell_size);
-    }
+    bool is_vector = std::any_of(
+        field_metas_.begin(), field_metas_.end(), [](const auto& field) {
+            return IsVectorDataType(field.second.get_data_type());
+        });
+    meta_.build_cells(row_group_sizes,
+                      row_group_row_counts,
+                      getGroupChunkCellSize(is_vector));
 
     AssertInfo(
         meta_.num_rows_until_chunk_.back() == column_group_info_.row_count,
@@ -196,12 +167,10 @@ GroupChunkTranslator::GroupChunkTranslator(
             column_group_info_.row_count));
 
     LOG_INFO(
-        "[StorageV2] translator {} merged {} row groups into {} cells ({} "
-        "row groups per cell)",
+        "[StorageV2] translator {} merged {} row groups into {} cells",
         key_,
         total_row_groups,
-        num_cells,
-        kRowGroupsPerCell);
+        meta_.chunk_memory_size_.size());
 }
 
 GroupChunkTranslator::~GroupChunkTranslator() {
@@ -307,7 +276,6 @@ GroupChunkTranslator::get_cells(milvus::OpContext* ctx,
 
     // Collect all row group indices needed for the requested cells
     std::vector<size_t> needed_row_group_indices;
-    needed_row_group_indices.reserve(kRowGroupsPerCell * cids.size());
     for (auto cid : cids) {
         auto [start, end] = meta_.get_row_group_range(cid);
         for (size_t i = start; i < end; ++i) {
@@ -346,9 +314,34 @@ GroupChunkTranslator::get_cells(milvus::OpContext* ctx,
         key_,
         column_group_info_.field_id);
 
-    // Collect loaded tables by row group index
+    // A cell is built as soon as its last row group arrives, so decoding
+    // overlaps the remaining reads and the row group tables of a built
+    // cell are released early.
+    std::unordered_map<size_t, size_t> row_group_to_cell;
+    row_group_to_cell.reserve(needed_row_group_indices.size());
+    std::vector<size_t> pending_row_groups(cids.size());
+    for (size_t i = 0; i < cids.size(); ++i) {
+        auto [start, end] = meta_.get_row_group_range(cids[i]);
+        for (size_t j = start; j < end; ++j) {
+            row_group_to_cell[j] = i;
+        }
+        pending_row_groups[i] = end - start;
+    }
     std::unordered_map<size_t, std::shared_ptr<arrow::Table>> row_group_tables;
     row_group_tables.reserve(needed_row_group_indices.size());
+    std::vector<std::unique_ptr<milvus::GroupChunk>> chunks(cids.size());
+
+    auto build_cell = [&](size_t i) {
+        auto [start, end] = meta_.get_row_group_range(cids[i]);
+        std::vector<std::shared_ptr<arrow::Table>> tables;
+        tables.reserve(end - start);
+        for (size_t j = start; j < end; ++j) {
+            auto it = row_group_tables.find(j);
+            tables.push_back(std::move(it->second));
+            row_group_tables.erase(it);
+        }
+        chunks[i] = load_group_chunk(tables, cids[i]);
+    };
 
     std::shared_ptr<milvus::ArrowDataWrapper> r;
     // !!! NOTE: the popped row group tables are sorted by the global row group index
@@ -361,31 +354,28 @@ GroupChunkTranslator::get_cells(milvus::OpContext* ctx,
             // Convert file_index and row_group_index (file inner index, not global index) to global row group index
             auto rg_idx = get_global_row_group_idx(table_info.file_index,
                                                    table_info.row_group_index);
-            row_group_tables[rg_idx] = table_info.table;
+            auto cell = row_group_to_cell.find(rg_idx);
+            if (cell == row_group_to_cell.end() ||
+                !row_group_tables.emplace(rg_idx, table_info.table).second) {
+                continue;
+            }
+            if (--pending_row_groups[cell->second] == 0) {
+                build_cell(cell->second);
+            }
         }
     }
 
     // access underlying feature to get exception if any
     storage::WaitAllFutures(load_futures);
 
-    // Build cells from collected tables
-    for (auto cid : cids) {
-        auto [start, end] = meta_.get_row_group_range(cid);
-        std::vector<std::shared_ptr<arrow::Table>> tables;
-        tables.reserve(end - start);
-
-        for (size_t i = start; i < end; ++i) {
-            auto it = row_group_tables.find(i);
-            AssertInfo(it != row_group_tables.end(),
-                       fmt::format("[StorageV2] translator {} row group {} "
-                                   "for cell {} was not loaded",
-                                   key_,
-                                   i,
-                                   cid));
-            tables.push_back(it->second);
-        }
-
-        cells.emplace_back(cid, load_group_chunk(tables, cid));
+    for (size_t i = 0; i < cids.size(); ++i) {
+        AssertInfo(chunks[i] != nullptr,
+                   fmt::format("[StorageV2] translator {} cell {} misses {} "
+                               "row groups",
+                               key_,
+                               cids[i],
+                               pending_row_groups[i]));
+        cells.emplace_back(cids[i], std::move(chunks[i]));
     }
 
     return cells;
@@ -399,4 +399,34 @@ TEST_P(GroupChunkTranslatorTest, TestMultipleFiles) {
 
 INSTANTIATE_TEST_SUITE_P(GroupChunkTranslatorTest,
                          GroupChunkTranslatorTest,
-                         testing::Bool());
\ No newline at end of file
+                         testing::Bool());
+TEST(GroupCTMetaTest, BuildCells) {
+    GroupCTMeta meta(1,
+                     milvus::cachinglayer::StorageType::MEMORY,
+                     milvus::cachinglayer::CellIdMappingMode::IDENTICAL,
+                     milvus::cachinglayer::CellDataType::SCALAR_FIELD,
+                     CacheWarmupPolicy::CacheWarmupPolicy_Disable,
+                     true);
+    std::vector<int64_t> sizes = {10, 10, 10, 50, 10, 10, 10, 10, 10, 10};
+    std::vector<int64_t> rows = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    using Range = std::pair<size_t, size_t>;
+
+    // no target size: kRowGroupsPerCell row groups per cell
+    meta.build_cells(sizes, rows, 0);
+    ASSERT_EQ(meta.chunk_memory_size_.size(), 3);
+    EXPECT_EQ(meta.get_row_group_range(0), Range(0, 4));
+    EXPECT_EQ(meta.get_row_group_range(2), Range(8, 10));
+    EXPECT_EQ(meta.chunk_memory_size_[0], 80);
+    EXPECT_EQ(meta.num_rows_until_chunk_.back(), 55);
+
+    // small row groups are coalesced, an oversized one stands alone
+    meta.build_cells(sizes, rows, 30);
+    ASSERT_EQ(meta.chunk_memory_size_.size(), 4);
+    EXPECT_EQ(meta.get_row_group_range(0), Range(0, 3));
+    EXPECT_EQ(meta.get_row_group_range(1), Range(3, 4));
+    EXPECT_EQ(meta.get_row_group_range(2), Range(4, 7));
+    EXPECT_EQ(meta.get_row_group_range(3), Range(7, 10));
+    EXPECT_EQ(meta.chunk_memory_size_[1], 50);
+    EXPECT_EQ(meta.num_rows_until_chunk_,
+              (std::vector<int64_t>{0, 6, 10, 28, 55}));
+}
@@ -115,35 +115,20 @@ ManifestGroupTranslator::ManifestGroupTranslator(
     const auto& row_group_rows = rows_result.ValueOrDie();
 
     // Merge row groups into group chunks(cache cells)
-    size_t total_row_groups = row_group_sizes.size();
-    meta_.total_row_groups_ = total_row_groups;
-    size_t num_cells =
-        (total_row_groups + kRowGroupsPerCell - 1) / kRowGroupsPerCell;
-
-    // Build num_rows_until_chunk_ and chunk_memory_size_
-    meta_.num_rows_until_chunk_.reserve(num_cells + 1);
-    meta_.num_rows_until_chunk_.push_back(0);
-    meta_.chunk_memory_size_.reserve(num_cells);
-
-    int64_t cumulative_rows = 0;
-    for (size_t cell_id = 0; cell_id < num_cells; ++cell_id) {
-        auto [start, end] = meta_.get_row_group_range(cell_id);
-        int64_t cell_size = 0;
-        for (size_t i = start; i < end; ++i) {
-            cumulative_rows += static_cast<int64_t>(row_group_rows[i]);
-            cell_size += static_cast<int64_t>(row_group_sizes[i]);
-        }
-        meta_.num_rows_until_chunk_.push_back(cumulative_rows);
-        meta_.chunk_memory_size_.push_back(cell_size);
-    }
+    bool is_vector = std::any_of(
+        field_metas_.begin(), field_metas_.end(), [](const auto& field) {
+            return IsVectorDataType(field.second.get_data_type());
+        });
+    meta_.build_cells(
+        std::vector<int64_t>(row_group_sizes.begin(), row_group_sizes.end()),
+        std::vector<int64_t>(row_group_rows.begin(), row_group_rows.end()),
+        getGroupChunkCellSize(is_vector));
 
     LOG_INFO(
-        "[StorageV2] translator {} merged {} row groups into {} cells ({} "
-        "row groups per cell)",
+        "[StorageV2] translator {} merged {} row groups into {} cells",
         key_,
-        total_row_groups,
-        num_cells,
-        kRowGroupsPerCell);
+        meta_.total_row_groups_,
+        meta_.chunk_memory_size_.size());
 }
 
 size_t
@@ -203,7 +188,6 @@ ManifestGroupTranslator::get_cells(
 
     // Collect all row group indices needed for the requested cells
     std::vector<int64_t> needed_row_group_indices;
-    needed_row_group_indices.reserve(kRowGroupsPerCell * cids.size());
     for (auto cid : cids) {
         auto [start, end] = meta_.get_row_group_range(cid);
         for (size_t i = start; i < end; ++i) {
@@ -10,7 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "segcore/tokenizer_c.h"
+#include <algorithm>
 #include <memory>
+#include <string_view>
+#include <vector>
+#include <boost/crc.hpp>
 #include "common/FieldMeta.h"
 #include "common/protobuf_utils.h"
 #include "pb/schema.pb.h"
@@ -66,6 +70,67 @@ create_token_stream(CTokenizer tokenizer, const char* text, uint32_t text_len) {
     return impl->CreateTokenStream(std::string(text, text_len)).release();
 }
 
+namespace {
+
+// a token batch with the hashes computed for it
+struct TokenBatchImpl {
+    std::unique_ptr<milvus::tantivy::TokenBatch> tokens;
+    std::vector<uint32_t> hashes;
+};
+
+// the same as typeutil.HashString2LessUint32, which BM25 hashes tokens with
+uint32_t
+HashToken(std::string_view token) {
+    constexpr size_t kHashPrefixLength = 100;
+    boost::crc_32_type crc;
+    crc.process_bytes(token.data(), std::min(token.size(), kHashPrefixLength));
+    return crc.checksum() % UINT32_MAX;
+}
+
+}  // namespace
+
+CStatus
+tokenize_batch(CTokenizer tokenizer,
+               const char* const* texts,
+               const uint32_t* text_lens,
+               uint64_t num_texts,
+               bool with_positions,
+               bool with_hashes,
+               CTokenBatch* batch) {
+    try {
+        auto impl = reinterpret_cast<milvus::tantivy::Tokenizer*>(tokenizer);
+        auto result = std::make_unique<TokenBatchImpl>();
+        result->tokens = impl->TokenizeBatch(
+            texts, text_lens, num_texts, with_positions);
+        const auto& tokens = *result->tokens;
+        if (with_hashes) {
+            result->hashes.resize(tokens.num_tokens());
+            for (size_t i = 0; i < tokens.num_tokens(); ++i) {
+                result->hashes[i] = HashToken(tokens.token(i));
+            }
+        }
+
+        const auto& raw = tokens.batch_;
+        batch->data = reinterpret_cast<const char*>(raw.data);
+        batch->token_offsets = raw.token_offsets.array;
+        batch->text_offsets = raw.text_offsets.array;
+        batch->positions = with_positions ? raw.positions.array : nullptr;
+        batch->hashes = with_hashes ? result->hashes.data() : nullptr;
+        batch->num_texts = tokens.num_texts();
+        batch->num_tokens = tokens.num_tokens();
+        batch->impl = result.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+void
+free_token_batch(CTokenBatch* batch) {
+    delete static_cast<TokenBatchImpl*>(batch->impl);
+    batch->impl = nullptr;
+}
+
 CValidateResult
 validate_tokenizer(const char* params, const char* extra_info) {
     try {
@@ -49,6 +49,36 @@ validate_tokenizer(const char* params, const char* extra_info);
 CTokenStream
 create_token_stream(CTokenizer tokenizer, const char* text, uint32_t text_len);
 
+// Tokens of a batch of texts. Token i is data[token_offsets[i],
+// token_offsets[i + 1]), not null terminated, and the tokens of text j are
+// tokens [text_offsets[j], text_offsets[j + 1]). positions and hashes hold
+// one entry per token and are NULL unless asked for; a hash is the one BM25
+// gives the token.
+typedef struct CTokenBatch {
+    const char* data;
+    const uint32_t* token_offsets;
+    const uint32_t* text_offsets;
+    const int64_t* positions;
+    const uint32_t* hashes;
+    uint64_t num_texts;
+    uint64_t num_tokens;
+    void* impl;
+} CTokenBatch;
+
+// Tokenizes num_texts texts with one call into the analyzer, which saves a
+// token stream per text and a call and a string per token.
+CStatus
+tokenize_batch(CTokenizer tokenizer,
+               const char* const* texts,
+               const uint32_t* text_lens,
+               uint64_t num_texts,
+               bool with_positions,
+               bool with_hashes,
+               CTokenBatch* batch);
+
+void
+free_token_batch(CTokenBatch* batch);
+
 CStatus
 validate_text_schema(const uint8_t* field_schema, uint64_t length);
 
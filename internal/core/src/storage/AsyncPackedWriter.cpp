@@ -0,0 +1,146 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/AsyncPackedWriter.h"
+
+#include <arrow/util/byte_size.h>
+
+#include <exception>
+#include <utility>
+
+#include "common/Common.h"
+#include "storage/ThreadPools.h"
+
+namespace milvus::storage {
+
+PackedWriteBudget&
+PackedWriteBudget::GetInstance() {
+    static PackedWriteBudget instance;
+    return instance;
+}
+
+void
+PackedWriteBudget::Acquire(int64_t bytes) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [&] {
+        return used_ == 0 ||
+               used_ + bytes <= PACKED_WRITER_ASYNC_MEMORY_LIMIT.load();
+    });
+    used_ += bytes;
+}
+
+void
+PackedWriteBudget::Release(int64_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        used_ -= bytes;
+    }
+    cv_.notify_all();
+}
+
+int64_t
+PackedWriteBudget::Used() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_;
+}
+
+AsyncPackedWriter::AsyncPackedWriter(
+    std::shared_ptr<milvus_storage::PackedRecordBatchWriter> writer)
+    : writer_(std::move(writer)) {
+}
+
+AsyncPackedWriter::~AsyncPackedWriter() {
+    // the queued tasks refer to this writer
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitIdle(lock);
+}
+
+arrow::Status
+AsyncPackedWriter::Write(const std::shared_ptr<arrow::RecordBatch>& batch) {
+    if (PACKED_WRITER_ASYNC_MEMORY_LIMIT.load() <= 0) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        WaitIdle(lock);
+        if (!status_.ok()) {
+            return status_;
+        }
+        lock.unlock();
+        return writer_->Write(batch);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!status_.ok()) {
+            return status_;
+        }
+    }
+    auto bytes = arrow::util::TotalBufferSize(*batch);
+    PackedWriteBudget::GetInstance().Acquire(bytes);
+    bool submit = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back({batch, bytes});
+        submit = !std::exchange(draining_, true);
+    }
+    if (submit) {
+        ThreadPools::GetThreadPool(ThreadPoolPriority::LOW).Submit([this] {
+            Drain();
+        });
+    }
+    return arrow::Status::OK();
+}
+
+arrow::Status
+AsyncPackedWriter::Close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    WaitIdle(lock);
+    auto status = writer_->Close();
+    return status_.ok() ? status : status_;
+}
+
+void
+AsyncPackedWriter::Drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!queue_.empty()) {
+        auto queued = std::move(queue_.front());
+        queue_.pop_front();
+        // the batches after a failure are dropped, the writer is broken
+        bool failed = !status_.ok();
+        lock.unlock();
+        arrow::Status status;
+        if (!failed) {
+            try {
+                status = writer_->Write(queued.batch_);
+            } catch (std::exception& e) {
+                status = arrow::Status::IOError(e.what());
+            }
+        }
+        queued.batch_.reset();
+        PackedWriteBudget::GetInstance().Release(queued.bytes_);
+        lock.lock();
+        if (status_.ok()) {
+            status_ = status;
+        }
+    }
+    draining_ = false;
+    idle_cv_.notify_all();
+}
+
+void
+AsyncPackedWriter::WaitIdle(std::unique_lock<std::mutex>& lock) {
+    idle_cv_.wait(lock, [this] { return !draining_; });
+}
+
+}  // namespace milvus::storage
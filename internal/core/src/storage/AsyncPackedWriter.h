@@ -0,0 +1,105 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <arrow/record_batch.h>
+#include <arrow/status.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "milvus-storage/packed/writer.h"
+
+namespace milvus::storage {
+
+// Bounds the bytes of the record batches queued by all the async packed
+// writers of the process to PACKED_WRITER_ASYNC_MEMORY_LIMIT.
+class PackedWriteBudget {
+ public:
+    static PackedWriteBudget&
+    GetInstance();
+
+    // blocks while the queued bytes and bytes exceed the limit, a batch
+    // larger than the limit is let in alone
+    void
+    Acquire(int64_t bytes);
+
+    void
+    Release(int64_t bytes);
+
+    int64_t
+    Used() const;
+
+ private:
+    PackedWriteBudget() = default;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    int64_t used_{0};
+};
+
+/**
+ * AsyncPackedWriter writes the record batches of a packed writer on the low
+ * priority pool, so the caller only imports a batch and queues it while the
+ * previous ones are encoded and uploaded. The batches of a writer are
+ * written in order by one task at a time, and Write blocks while the
+ * batches queued by all the writers exceed the budget.
+ *
+ * A failed write fails the next Write and Close, which still waits for the
+ * queued batches and closes the underlying writer.
+ */
+class AsyncPackedWriter {
+ public:
+    explicit AsyncPackedWriter(
+        std::shared_ptr<milvus_storage::PackedRecordBatchWriter> writer);
+
+    ~AsyncPackedWriter();
+
+    arrow::Status
+    Write(const std::shared_ptr<arrow::RecordBatch>& batch);
+
+    arrow::Status
+    Close();
+
+ private:
+    struct QueuedBatch {
+        std::shared_ptr<arrow::RecordBatch> batch_;
+        int64_t bytes_;
+    };
+
+    // writes the queued batches until none is left
+    void
+    Drain();
+
+    void
+    WaitIdle(std::unique_lock<std::mutex>& lock);
+
+    std::shared_ptr<milvus_storage::PackedRecordBatchWriter> writer_;
+
+    std::mutex mutex_;
+    std::condition_variable idle_cv_;
+    std::deque<QueuedBatch> queue_;
+    // whether a task of the pool drains queue_
+    bool draining_{false};
+    // the first failure of a background write
+    arrow::Status status_;
+};
+
+}  // namespace milvus::storage
@@ -39,8 +39,8 @@ BinlogReader::Read(int64_t nbytes) {
             SegcoreError(milvus::UnexpectedError, "out range of binlog data"),
             nullptr);
     }
-    auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
-    auto res = std::shared_ptr<uint8_t[]>(data_.get() + tell_, deleter);
+    // the slice shares the ownership of the binlog instead of copying it
+    auto res = std::shared_ptr<uint8_t[]>(data_, data_.get() + tell_);
     tell_ += nbytes;
     return std::make_pair(SegcoreError(milvus::Success, ""), res);
 }
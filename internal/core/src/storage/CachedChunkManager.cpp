@@ -0,0 +1,390 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/CachedChunkManager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+
+#include <fmt/core.h>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "storage/IoEngine.h"
+
+namespace milvus::storage {
+
+namespace {
+
+constexpr char kJournalName[] = "index";
+constexpr char kObjectsDir[] = "objects";
+// objects of about this size are expected, to size the frequency sketch
+constexpr uint64_t kExpectedObjectSize = 1 << 20;
+
+uint64_t
+KeyHash(const std::string& filepath) {
+    return std::hash<std::string>{}(filepath);
+}
+
+}  // namespace
+
+CachedChunkManager::CachedChunkManager(ChunkManagerPtr remote,
+                                       const std::string& cache_path,
+                                       uint64_t capacity)
+    : remote_(std::move(remote)),
+      cache_path_(cache_path),
+      capacity_(capacity),
+      sketch_(std::max<uint64_t>(capacity / kExpectedObjectSize, 1)) {
+    AssertInfo(remote_ != nullptr, "remote chunk manager is nullptr");
+    AssertInfo(capacity_ > 0, "object cache capacity should be positive");
+    std::filesystem::create_directories(std::filesystem::path(cache_path_) /
+                                        kObjectsDir);
+    Recover();
+    LOG_INFO("object cache at {} recovered {} objects, {} of {} bytes",
+             cache_path_,
+             entries_.size(),
+             used_,
+             capacity_);
+}
+
+CachedChunkManager::~CachedChunkManager() {
+    // keeps the LRU order for the next start
+    try {
+        std::lock_guard<std::mutex> lock(mutex_);
+        CompactJournalLocked();
+    } catch (const std::exception& e) {
+        LOG_WARN("failed to compact object cache journal, error: {}",
+                 e.what());
+    }
+}
+
+bool
+CachedChunkManager::Exist(const std::string& filepath) {
+    return remote_->Exist(filepath);
+}
+
+uint64_t
+CachedChunkManager::Size(const std::string& filepath) {
+    return remote_->Size(filepath);
+}
+
+uint64_t
+CachedChunkManager::Read(const std::string& filepath, void* buf, uint64_t len) {
+    if (ReadCached(filepath, 0, buf, len, true)) {
+        return len;
+    }
+    auto read = remote_->Read(filepath, buf, len);
+    if (read == len) {
+        Admit(filepath, buf, len);
+    }
+    return read;
+}
+
+uint64_t
+CachedChunkManager::Read(const std::string& filepath,
+                         uint64_t offset,
+                         void* buf,
+                         uint64_t len) {
+    if (ReadCached(filepath, offset, buf, len, false)) {
+        return len;
+    }
+    return remote_->Read(filepath, offset, buf, len);
+}
+
+void
+CachedChunkManager::Write(const std::string& filepath,
+                          void* buf,
+                          uint64_t len) {
+    Invalidate(filepath);
+    remote_->Write(filepath, buf, len);
+}
+
+void
+CachedChunkManager::Write(const std::string& filepath,
+                          uint64_t offset,
+                          void* buf,
+                          uint64_t len) {
+    Invalidate(filepath);
+    remote_->Write(filepath, offset, buf, len);
+}
+
+std::vector<std::string>
+CachedChunkManager::ListWithPrefix(const std::string& filepath) {
+    return remote_->ListWithPrefix(filepath);
+}
+
+void
+CachedChunkManager::Remove(const std::string& filepath) {
+    Invalidate(filepath);
+    remote_->Remove(filepath);
+}
+
+bool
+CachedChunkManager::Contains(const std::string& filepath) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.find(filepath) != entries_.end();
+}
+
+uint64_t
+CachedChunkManager::CachedSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t size = 0;
+    for (const auto& [_, entry] : entries_) {
+        size += entry.size;
+    }
+    return size;
+}
+
+std::string
+CachedChunkManager::ObjectPath(uint64_t id) const {
+    return (std::filesystem::path(cache_path_) / kObjectsDir /
+            std::to_string(id))
+        .string();
+}
+
+bool
+CachedChunkManager::ReadCached(const std::string& filepath,
+                               uint64_t offset,
+                               void* buf,
+                               uint64_t len,
+                               bool whole) {
+    std::string object_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sketch_.Increment(KeyHash(filepath));
+        auto it = entries_.find(filepath);
+        if (it == entries_.end()) {
+            return false;
+        }
+        auto& entry = it->second;
+        if (whole ? entry.size != len : offset + len > entry.size) {
+            return false;
+        }
+        lru_.splice(lru_.begin(), lru_, entry.lru);
+        object_path = ObjectPath(entry.id);
+    }
+    try {
+        // an eviction in between unlinks the file, which is a miss too
+        return io::ReadFile(object_path, buf, len, offset) == len;
+    } catch (const std::exception& e) {
+        LOG_WARN("failed to read cached object {} of {}, error: {}",
+                 object_path,
+                 filepath,
+                 e.what());
+        return false;
+    }
+}
+
+void
+CachedChunkManager::Admit(const std::string& filepath,
+                          const void* buf,
+                          uint64_t len) {
+    if (len == 0 || len > capacity_) {
+        return;
+    }
+    uint64_t id;
+    std::vector<std::string> evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.count(filepath) > 0 || pending_.count(filepath) > 0) {
+            return;
+        }
+        // TinyLFU: the victims must all be less popular than the candidate
+        auto frequency = sketch_.Estimate(KeyHash(filepath));
+        uint64_t freed = 0;
+        std::vector<std::string> victims;
+        for (auto it = lru_.rbegin();
+             used_ - freed + len > capacity_ && it != lru_.rend();
+             ++it) {
+            if (sketch_.Estimate(KeyHash(*it)) >= frequency) {
+                return;
+            }
+            freed += entries_.at(*it).size;
+            victims.push_back(*it);
+        }
+        if (used_ - freed + len > capacity_) {
+            // the rest of the space is taken by objects being written
+            return;
+        }
+        for (const auto& victim : victims) {
+            evicted.push_back(EvictLocked(victim));
+        }
+        id = next_id_++;
+        used_ += len;
+        pending_.insert(filepath);
+    }
+    for (const auto& path : evicted) {
+        std::remove(path.c_str());
+    }
+
+    auto object_path = ObjectPath(id);
+    auto tmp_path = object_path + ".tmp";
+    bool written = false;
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        written = file.write(static_cast<const char*>(buf), len) &&
+                  file.flush().good();
+    }
+    written =
+        written && std::rename(tmp_path.c_str(), object_path.c_str()) == 0;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(filepath);
+    if (!written) {
+        LOG_WARN("failed to cache object {} at {}", filepath, object_path);
+        std::remove(tmp_path.c_str());
+        used_ -= len;
+        return;
+    }
+    lru_.push_front(filepath);
+    entries_[filepath] = Entry{id, len, lru_.begin()};
+    AppendJournalLocked(fmt::format("+ {} {} {}", id, len, filepath));
+}
+
+void
+CachedChunkManager::Invalidate(const std::string& filepath) {
+    std::string object_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.find(filepath) == entries_.end()) {
+            return;
+        }
+        object_path = EvictLocked(filepath);
+    }
+    std::remove(object_path.c_str());
+}
+
+std::string
+CachedChunkManager::EvictLocked(const std::string& filepath) {
+    auto it = entries_.find(filepath);
+    auto object_path = ObjectPath(it->second.id);
+    // journal before the file goes, a crash in between leaves an orphan
+    // file that is cleaned up on recovery
+    AppendJournalLocked(fmt::format("- {}", it->second.id));
+    used_ -= it->second.size;
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+    return object_path;
+}
+
+void
+CachedChunkManager::AppendJournalLocked(const std::string& record) {
+    journal_ << record << '\n';
+    journal_.flush();
+    if (++journal_records_ > kJournalCompactRatio * (entries_.size() + 16)) {
+        CompactJournalLocked();
+    }
+}
+
+void
+CachedChunkManager::CompactJournalLocked() {
+    auto journal_path = std::filesystem::path(cache_path_) / kJournalName;
+    auto tmp_path = journal_path.string() + ".tmp";
+    {
+        std::ofstream tmp(tmp_path, std::ios::trunc);
+        // least recently used first, so the order survives a replay
+        for (auto it = lru_.rbegin(); it != lru_.rend(); ++it) {
+            const auto& entry = entries_.at(*it);
+            tmp << fmt::format("+ {} {} {}", entry.id, entry.size, *it)
+                << '\n';
+        }
+        AssertInfo(tmp.flush().good(),
+                   "failed to write object cache journal {}",
+                   tmp_path);
+    }
+    journal_.close();
+    std::filesystem::rename(tmp_path, journal_path);
+    journal_.open(journal_path, std::ios::app);
+    AssertInfo(journal_.is_open(),
+               "failed to open object cache journal {}",
+               journal_path.string());
+    journal_records_ = entries_.size();
+}
+
+void
+CachedChunkManager::Recover() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto journal_path = std::filesystem::path(cache_path_) / kJournalName;
+    // replay the journal into id -> (size, path), in admission order, or in
+    // the LRU order of the last compaction
+    std::unordered_map<uint64_t, std::pair<uint64_t, std::string>> objects;
+    std::vector<uint64_t> order;
+    {
+        std::ifstream journal(journal_path);
+        std::string line;
+        while (std::getline(journal, line)) {
+            std::istringstream record(line);
+            char op;
+            uint64_t id;
+            if (!(record >> op >> id)) {
+                continue;
+            }
+            next_id_ = std::max(next_id_, id + 1);
+            if (op == '-') {
+                objects.erase(id);
+                continue;
+            }
+            uint64_t size;
+            std::string filepath;
+            if (op != '+' || !(record >> size) || record.get() != ' ' ||
+                !std::getline(record, filepath) || filepath.empty()) {
+                // a torn last record
+                continue;
+            }
+            objects[id] = {size, filepath};
+            order.push_back(id);
+        }
+    }
+
+    std::unordered_set<std::string> kept;
+    for (auto id : order) {
+        auto it = objects.find(id);
+        if (it == objects.end()) {
+            continue;
+        }
+        auto& [size, filepath] = it->second;
+        auto object_path = ObjectPath(id);
+        std::error_code ec;
+        auto file_size = std::filesystem::file_size(object_path, ec);
+        if (ec || file_size != size || entries_.count(filepath) > 0) {
+            continue;
+        }
+        lru_.push_front(filepath);
+        entries_[filepath] = Entry{id, size, lru_.begin()};
+        used_ += size;
+        kept.insert(object_path);
+    }
+    // the capacity may have shrunk since the last run
+    while (used_ > capacity_) {
+        auto& entry = entries_.at(lru_.back());
+        kept.erase(ObjectPath(entry.id));
+        used_ -= entry.size;
+        entries_.erase(lru_.back());
+        lru_.pop_back();
+    }
+    for (const auto& file : std::filesystem::directory_iterator(
+             std::filesystem::path(cache_path_) / kObjectsDir)) {
+        if (kept.count(file.path().string()) == 0) {
+            std::filesystem::remove(file.path());
+        }
+    }
+    CompactJournalLocked();
+}
+
+}  // namespace milvus::storage
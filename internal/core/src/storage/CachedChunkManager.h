@@ -0,0 +1,171 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/FrequencySketch.h"
+#include "storage/ChunkManager.h"
+
+namespace milvus::storage {
+
+/**
+ * @brief CachedChunkManager keeps whole remote objects on a local disk, so
+ * that loading a segment again, after a release or a restart, reads them
+ * locally instead of from the object storage. All the operations but reads
+ * go to the remote chunk manager.
+ *
+ * An object is cached by its path and size, a full read of the object hits
+ * only if the cached copy has the size being read. Objects a full read
+ * missed are admitted by TinyLFU: when the cache is full, the least recently
+ * used objects are evicted for the new one only if all of them were accessed
+ * less often than it. The cached objects are recorded in an append only
+ * journal in the cache directory, which is replayed and compacted on start,
+ * so the cache survives restarts.
+ */
+class CachedChunkManager : public ChunkManager {
+ public:
+    CachedChunkManager(ChunkManagerPtr remote,
+                       const std::string& cache_path,
+                       uint64_t capacity);
+
+    virtual ~CachedChunkManager();
+
+    bool
+    Exist(const std::string& filepath) override;
+
+    uint64_t
+    Size(const std::string& filepath) override;
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override;
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override;
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override;
+
+    void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len) override;
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override;
+
+    void
+    Remove(const std::string& filepath) override;
+
+    std::string
+    GetName() const override {
+        return "CachedChunkManager";
+    }
+
+    std::string
+    GetRootPath() const override {
+        return remote_->GetRootPath();
+    }
+
+    std::string
+    GetBucketName() const override {
+        return remote_->GetBucketName();
+    }
+
+    ChunkManagerPtr
+    GetRemoteChunkManager() const {
+        return remote_;
+    }
+
+    bool
+    Contains(const std::string& filepath) const;
+
+    // bytes of the cached objects
+    uint64_t
+    CachedSize() const;
+
+ private:
+    struct Entry {
+        uint64_t id;
+        uint64_t size;
+        std::list<std::string>::iterator lru;
+    };
+
+    // Reads from the cached copy if there is one holding the range, with
+    // 'whole' only if the cached object is exactly 'len' bytes.
+    bool
+    ReadCached(const std::string& filepath,
+               uint64_t offset,
+               void* buf,
+               uint64_t len,
+               bool whole);
+
+    void
+    Admit(const std::string& filepath, const void* buf, uint64_t len);
+
+    void
+    Invalidate(const std::string& filepath);
+
+    // Unlinks the entry from the index and journals the eviction, the
+    // caller removes the file once the lock is released.
+    std::string
+    EvictLocked(const std::string& filepath);
+
+    void
+    Recover();
+
+    void
+    AppendJournalLocked(const std::string& record);
+
+    void
+    CompactJournalLocked();
+
+    std::string
+    ObjectPath(uint64_t id) const;
+
+    // rewrite the journal once it holds this many records per cached object
+    static constexpr size_t kJournalCompactRatio = 4;
+
+    const ChunkManagerPtr remote_;
+    const std::string cache_path_;
+    const uint64_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    // most recently used first
+    std::list<std::string> lru_;
+    // objects being written to the cache, their bytes are in used_
+    std::unordered_set<std::string> pending_;
+    uint64_t used_{0};
+    uint64_t next_id_{0};
+    FrequencySketch sketch_;
+    std::ofstream journal_;
+    size_t journal_records_{0};
+};
+
+}  // namespace milvus::storage
@@ -0,0 +1,276 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <vector>
+
+#include "storage/CachedChunkManager.h"
+
+using namespace milvus::storage;
+
+namespace {
+
+// an in memory object storage counting the reads it serves
+class MemoryChunkManager : public ChunkManager {
+ public:
+    bool
+    Exist(const std::string& filepath) override {
+        return objects_.count(filepath) > 0;
+    }
+
+    uint64_t
+    Size(const std::string& filepath) override {
+        return objects_.at(filepath).size();
+    }
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override {
+        return Read(filepath, 0, buf, len);
+    }
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override {
+        auto data = static_cast<char*>(buf);
+        objects_[filepath].assign(data, data + len);
+    }
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override {
+        reads_++;
+        const auto& object = objects_.at(filepath);
+        auto size = std::min<uint64_t>(len, object.size() - offset);
+        std::memcpy(buf, object.data() + offset, size);
+        return size;
+    }
+
+    void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len) override {
+        auto& object = objects_[filepath];
+        object.resize(std::max<uint64_t>(object.size(), offset + len));
+        std::memcpy(object.data() + offset, buf, len);
+    }
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override {
+        std::vector<std::string> paths;
+        for (const auto& [path, _] : objects_) {
+            if (path.rfind(filepath, 0) == 0) {
+                paths.push_back(path);
+            }
+        }
+        return paths;
+    }
+
+    void
+    Remove(const std::string& filepath) override {
+        objects_.erase(filepath);
+    }
+
+    std::string
+    GetName() const override {
+        return "MemoryChunkManager";
+    }
+
+    std::string
+    GetRootPath() const override {
+        return "root";
+    }
+
+    std::string
+    GetBucketName() const override {
+        return "bucket";
+    }
+
+    size_t reads_{0};
+
+ private:
+    std::map<std::string, std::vector<char>> objects_;
+};
+
+}  // namespace
+
+class CachedChunkManagerTest : public testing::Test {
+ protected:
+    void
+    SetUp() override {
+        cache_path_ = (std::filesystem::temp_directory_path() /
+                       "cached_chunk_manager_test")
+                          .string();
+        std::filesystem::remove_all(cache_path_);
+        remote_ = std::make_shared<MemoryChunkManager>();
+    }
+
+    void
+    TearDown() override {
+        std::filesystem::remove_all(cache_path_);
+    }
+
+    void
+    Put(const std::string& path, size_t size) {
+        std::vector<char> data(size);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = static_cast<char>(i * 31 + path.size());
+        }
+        remote_->Write(path, data.data(), size);
+    }
+
+    // reads the whole object through the cache and checks the content
+    void
+    Get(ChunkManager& cm, const std::string& path) {
+        auto size = cm.Size(path);
+        std::vector<char> buf(size), expected(size);
+        ASSERT_EQ(cm.Read(path, buf.data(), size), size);
+        remote_->Read(path, expected.data(), size);
+        remote_->reads_--;
+        EXPECT_EQ(buf, expected);
+    }
+
+    std::string cache_path_;
+    std::shared_ptr<MemoryChunkManager> remote_;
+};
+
+TEST_F(CachedChunkManagerTest, HitAfterMiss) {
+    CachedChunkManager cm(remote_, cache_path_, 1 << 20);
+    Put("a", 1000);
+    Get(cm, "a");
+    EXPECT_EQ(remote_->reads_, 1);
+    EXPECT_TRUE(cm.Contains("a"));
+    EXPECT_EQ(cm.CachedSize(), 1000);
+
+    Get(cm, "a");
+    EXPECT_EQ(remote_->reads_, 1);
+    // a range of the cached object
+    char buf[10];
+    ASSERT_EQ(cm.Read("a", 990, buf, 10), 10);
+    EXPECT_EQ(remote_->reads_, 1);
+    // a full read of another size goes to the remote
+    std::vector<char> larger(2000);
+    EXPECT_EQ(cm.Read("a", larger.data(), larger.size()), 1000);
+    EXPECT_EQ(remote_->reads_, 2);
+}
+
+TEST_F(CachedChunkManagerTest, WriteAndRemoveInvalidate) {
+    CachedChunkManager cm(remote_, cache_path_, 1 << 20);
+    Put("a", 1000);
+    Get(cm, "a");
+    std::vector<char> data(500, 'x');
+    cm.Write("a", data.data(), data.size());
+    EXPECT_FALSE(cm.Contains("a"));
+    Get(cm, "a");
+    EXPECT_TRUE(cm.Contains("a"));
+
+    cm.Remove("a");
+    EXPECT_FALSE(cm.Contains("a"));
+    EXPECT_FALSE(cm.Exist("a"));
+    EXPECT_EQ(cm.CachedSize(), 0);
+}
+
+TEST_F(CachedChunkManagerTest, AdmissionAndEviction) {
+    CachedChunkManager cm(remote_, cache_path_, 3000);
+    Put("hot1", 1000);
+    Put("hot2", 1000);
+    Put("hot3", 1000);
+    Put("cold", 1000);
+    Put("huge", 5000);
+    for (int i = 0; i < 3; i++) {
+        Get(cm, "hot1");
+        Get(cm, "hot2");
+        Get(cm, "hot3");
+    }
+    EXPECT_EQ(cm.CachedSize(), 3000);
+
+    // less popular than the victim it would evict
+    Get(cm, "cold");
+    EXPECT_FALSE(cm.Contains("cold"));
+    Get(cm, "huge");
+    EXPECT_FALSE(cm.Contains("huge"));
+
+    // once more popular it replaces the least recently used object
+    for (int i = 0; i < 5; i++) {
+        Get(cm, "cold");
+    }
+    EXPECT_TRUE(cm.Contains("cold"));
+    EXPECT_FALSE(cm.Contains("hot1"));
+    EXPECT_TRUE(cm.Contains("hot2"));
+    EXPECT_TRUE(cm.Contains("hot3"));
+    EXPECT_EQ(cm.CachedSize(), 3000);
+}
+
+TEST_F(CachedChunkManagerTest, Recover) {
+    Put("a", 1000);
+    Put("b", 2000);
+    Put("c", 3000);
+    {
+        CachedChunkManager cm(remote_, cache_path_, 1 << 20);
+        Get(cm, "a");
+        Get(cm, "b");
+        Get(cm, "c");
+        cm.Remove("b");
+    }
+    // a torn record and a stray file left by a crash
+    {
+        std::ofstream journal(cache_path_ + "/index", std::ios::app);
+        journal << "+ 100 20";
+        std::ofstream stray(cache_path_ + "/objects/101.tmp");
+        stray << "stray";
+    }
+
+    auto reads = remote_->reads_;
+    CachedChunkManager cm(remote_, cache_path_, 1 << 20);
+    EXPECT_TRUE(cm.Contains("a"));
+    EXPECT_FALSE(cm.Contains("b"));
+    EXPECT_TRUE(cm.Contains("c"));
+    EXPECT_EQ(cm.CachedSize(), 4000);
+    Get(cm, "a");
+    Get(cm, "c");
+    EXPECT_EQ(remote_->reads_, reads);
+    EXPECT_FALSE(std::filesystem::exists(cache_path_ + "/objects/101.tmp"));
+
+    // new objects do not reuse the ids of the recovered ones
+    Put("b", 2000);
+    Get(cm, "b");
+    EXPECT_TRUE(cm.Contains("b"));
+    Get(cm, "a");
+    EXPECT_EQ(remote_->reads_, reads + 1);
+}
+
+TEST_F(CachedChunkManagerTest, RecoverIntoSmallerCapacity) {
+    Put("a", 1000);
+    Put("b", 1000);
+    {
+        CachedChunkManager cm(remote_, cache_path_, 1 << 20);
+        Get(cm, "a");
+        Get(cm, "b");
+        Get(cm, "a");
+    }
+    CachedChunkManager cm(remote_, cache_path_, 1500);
+    EXPECT_TRUE(cm.Contains("a"));
+    EXPECT_FALSE(cm.Contains("b"));
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(
+                                cache_path_ + "/objects"),
+                            std::filesystem::directory_iterator()),
+              1);
+}
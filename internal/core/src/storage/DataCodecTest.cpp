@@ -15,13 +15,19 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <optional>
+#include <random>
 #include <string>
 
+#include "arrow/io/memory.h"
+#include "parquet/file_reader.h"
+
 #include "common/Geometry.h"
 #include "storage/DataCodec.h"
 #include "storage/InsertData.h"
 #include "storage/IndexData.h"
+#include "storage/PayloadWriter.h"
 #include "storage/Util.h"
 #include "common/Consts.h"
 #include "common/Json.h"
@@ -1321,4 +1327,95 @@ TEST(storage, InsertDataJsonFillWithNull) {
     ASSERT_EQ(new_payload->get_num_rows(), size);
     ASSERT_EQ(new_payload->get_null_count(), size);
     ASSERT_EQ(*new_payload->ValidData(), *valid_data);
-}
\ No newline at end of file
+}
+namespace {
+
+std::unique_ptr<parquet::ParquetFileReader>
+OpenPayload(const std::vector<uint8_t>& payload) {
+    auto buffer = std::make_shared<arrow::Buffer>(payload.data(),
+                                                  payload.size());
+    return parquet::ParquetFileReader::Open(
+        std::make_shared<arrow::io::BufferReader>(buffer));
+}
+
+bool
+HasEncoding(const parquet::ParquetFileReader& reader,
+            parquet::Encoding::type encoding) {
+    auto encodings =
+        reader.metadata()->RowGroup(0)->ColumnChunk(0)->encodings();
+    return std::find(encodings.begin(), encodings.end(), encoding) !=
+           encodings.end();
+}
+
+}  // namespace
+
+TEST(storage, PayloadWriterAdaptiveEncoding) {
+    int64_t num_rows = 10000;
+
+    // sorted primary keys are delta encoded
+    std::vector<int64_t> pks(num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        pks[i] = 1000 + i * 3;
+    }
+    storage::PayloadWriter pk_writer(DataType::INT64, false);
+    pk_writer.add_payload({DataType::INT64,
+                           reinterpret_cast<const uint8_t*>(pks.data()),
+                           nullptr,
+                           num_rows,
+                           std::nullopt,
+                           false});
+    pk_writer.finish();
+    auto pk_reader = OpenPayload(pk_writer.get_payload_buffer());
+    EXPECT_TRUE(
+        HasEncoding(*pk_reader, parquet::Encoding::DELTA_BINARY_PACKED));
+
+    // low-cardinality scalars keep the dictionary
+    std::vector<int64_t> tags(num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        tags[i] = (i * 7) % 5;
+    }
+    storage::PayloadWriter tag_writer(DataType::INT64, false);
+    tag_writer.add_payload({DataType::INT64,
+                            reinterpret_cast<const uint8_t*>(tags.data()),
+                            nullptr,
+                            num_rows,
+                            std::nullopt,
+                            false});
+    tag_writer.finish();
+    auto tag_reader = OpenPayload(tag_writer.get_payload_buffer());
+    EXPECT_TRUE(HasEncoding(*tag_reader, parquet::Encoding::RLE_DICTIONARY));
+
+    // random binary vectors do not compress and are stored uncompressed
+    int dim = 128;
+    std::vector<uint8_t> vectors(num_rows * dim / 8);
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (auto& v : vectors) {
+        v = dist(rng);
+    }
+    storage::PayloadWriter vec_writer(DataType::VECTOR_BINARY, dim, false);
+    vec_writer.add_payload({DataType::VECTOR_BINARY,
+                            vectors.data(),
+                            nullptr,
+                            num_rows,
+                            dim,
+                            false});
+    vec_writer.finish();
+    auto vec_reader = OpenPayload(vec_writer.get_payload_buffer());
+    EXPECT_EQ(
+        vec_reader->metadata()->RowGroup(0)->ColumnChunk(0)->compression(),
+        arrow::Compression::UNCOMPRESSED);
+
+    // the payloads still read back as written
+    auto field_data = std::make_shared<storage::PayloadReader>(
+                          pk_writer.get_payload_buffer().data(),
+                          pk_writer.get_payload_buffer().size(),
+                          DataType::INT64,
+                          false)
+                          ->get_field_data();
+    ASSERT_EQ(field_data->get_num_rows(), num_rows);
+    for (int64_t i = 0; i < num_rows; ++i) {
+        EXPECT_EQ(*static_cast<const int64_t*>(field_data->RawValue(i)),
+                  pks[i]);
+    }
+}
@@ -372,9 +372,11 @@ DiskFileManagerImpl::CacheIndexToDiskInternal(
             local_index_prefix + prefix.substr(prefix.find_last_of('/') + 1);
         local_chunk_manager->CreateFile(local_index_file_name);
 
-        // Get the remote files
-        std::vector<std::string> batch_remote_files;
-        batch_remote_files.reserve(slices.second.size());
+        std::vector<std::string> remote_slice_files;
+        remote_slice_files.reserve(slices.second.size());
+        for (int& iter : slices.second) {
+            remote_slice_files.push_back(prefix + "_" + std::to_string(iter));
+        }
 
         uint64_t max_parallel_degree =
             uint64_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE.load());
@@ -383,32 +385,17 @@ DiskFileManagerImpl::CacheIndexToDiskInternal(
             auto file_writer = storage::FileWriter(
                 local_index_file_name,
                 storage::io::GetPriorityFromLoadPriority(priority));
-            auto appendIndexFiles = [&]() {
-                auto index_chunks_futures =
-                    GetObjectData(rcm_.get(),
-                                  batch_remote_files,
-                                  milvus::PriorityForLoad(priority));
-                // Wait for all futures to ensure all threads complete
-                auto chunk_codecs =
-                    storage::WaitAllFutures(std::move(index_chunks_futures));
-                for (auto& chunk_codec : chunk_codecs) {
+            // slices are written as they arrive, while the next ones are
+            // still downloading
+            StreamObjectData(
+                rcm_.get(),
+                remote_slice_files,
+                std::max<uint64_t>(max_parallel_degree, 1),
+                [&](size_t, std::unique_ptr<DataCodec> chunk_codec) {
                     file_writer.Write(chunk_codec->PayloadData(),
                                       chunk_codec->PayloadSize());
-                }
-                batch_remote_files.clear();
-            };
-
-            for (int& iter : slices.second) {
-                auto origin_file = prefix + "_" + std::to_string(iter);
-                batch_remote_files.push_back(origin_file);
-
-                if (batch_remote_files.size() == max_parallel_degree) {
-                    appendIndexFiles();
-                }
-            }
-            if (batch_remote_files.size() > 0) {
-                appendIndexFiles();
-            }
+                },
+                milvus::PriorityForLoad(priority));
             file_writer.Finish();
         }
 
@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <boost/filesystem/operations.hpp>
+#include <algorithm>
 #include <chrono>
 #include <arrow/array/builder_binary.h>
 #include <arrow/array/builder_primitive.h>
@@ -123,6 +124,83 @@ TEST_F(DiskAnnFileManagerTest, AddFilePositiveParallel) {
     }
 }
 
+TEST_F(DiskAnnFileManagerTest, StreamObjectDataInOrder) {
+    auto lcm = LocalChunkManagerSingleton::GetInstance().GetChunkManager();
+    std::string indexFilePath = "/tmp/diskann/index_files/1001/index";
+    uint64_t index_size = 50 << 20;
+    lcm->CreateFile(indexFilePath);
+    std::vector<uint8_t> data(index_size);
+    for (size_t i = 0; i < index_size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    lcm->Write(indexFilePath, data.data(), index_size);
+
+    FieldDataMeta filed_data_meta = {1, 2, 3, 100};
+    IndexMeta index_meta = {3, 100, 1001, 1, "index"};
+    auto diskAnnFileManager = std::make_shared<DiskFileManagerImpl>(
+        storage::FileManagerContext(filed_data_meta, index_meta, cm_, fs_));
+    ASSERT_TRUE(diskAnnFileManager->AddFile(indexFilePath));
+
+    std::vector<std::string> remote_files;
+    for (auto& file2size : diskAnnFileManager->GetRemotePathsToFileSize()) {
+        remote_files.emplace_back(file2size.first);
+    }
+    std::sort(remote_files.begin(),
+              remote_files.end(),
+              [](const std::string& a, const std::string& b) {
+                  auto slice = [](const std::string& file) {
+                      return std::stoi(file.substr(file.find_last_of('_') + 1));
+                  };
+                  return slice(a) < slice(b);
+              });
+    ASSERT_GT(remote_files.size(), 2);
+
+    // fewer files in flight than slices, the slices still arrive in order
+    std::vector<uint8_t> assembled;
+    size_t expected_idx = 0;
+    StreamObjectData(
+        cm_.get(),
+        remote_files,
+        2,
+        [&](size_t idx, std::unique_ptr<DataCodec> codec) {
+            EXPECT_EQ(idx, expected_idx++);
+            auto payload = static_cast<const uint8_t*>(codec->PayloadData());
+            assembled.insert(
+                assembled.end(), payload, payload + codec->PayloadSize());
+        });
+    EXPECT_EQ(expected_idx, remote_files.size());
+    EXPECT_EQ(assembled, data);
+
+    // errors of the consumer and of the downloads are passed on
+    EXPECT_ANY_THROW(StreamObjectData(
+        cm_.get(), remote_files, 2, [](size_t idx, std::unique_ptr<DataCodec>) {
+            if (idx == 1) {
+                throw std::runtime_error("consumer failed");
+            }
+        }));
+    auto missing = remote_files;
+    missing.push_back(remote_files.back() + "_missing");
+    EXPECT_ANY_THROW(StreamObjectData(
+        cm_.get(), missing, 2, [](size_t, std::unique_ptr<DataCodec>) {}));
+
+    // batched downloads return the codecs in the order of the files too
+    auto codecs = BatchGetObjectData(cm_.get(), remote_files, 2);
+    ASSERT_EQ(codecs.size(), remote_files.size());
+    assembled.clear();
+    for (auto& codec : codecs) {
+        auto payload = static_cast<const uint8_t*>(codec->PayloadData());
+        assembled.insert(
+            assembled.end(), payload, payload + codec->PayloadSize());
+    }
+    EXPECT_EQ(assembled, data);
+    EXPECT_ANY_THROW(BatchGetObjectData(cm_.get(), missing, 2));
+
+    for (auto& file : remote_files) {
+        cm_->Remove(file);
+    }
+    lcm->Remove(indexFilePath);
+}
+
 TEST_F(DiskAnnFileManagerTest, ReadAndWriteWithStream) {
     auto conf = milvus_storage::ArrowFileSystemConfig();
     conf.storage_type = "local";
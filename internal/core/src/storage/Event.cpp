@@ -234,7 +234,10 @@ BaseEventData::BaseEventData(BinlogReaderPtr reader,
     auto res = reader->Read(payload_length);
     AssertInfo(res.first.ok(), "read payload failed");
     payload_reader = std::make_shared<PayloadReader>(
-        res.second.get(), payload_length, data_type, nullable, is_field_data);
+        std::make_shared<BinlogBuffer>(res.second, payload_length),
+        data_type,
+        nullable,
+        is_field_data);
 }
 
 std::vector<uint8_t>
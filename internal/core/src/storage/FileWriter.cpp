@@ -21,6 +21,250 @@
 
 namespace milvus::storage {
 
+namespace {
+
+int
+OpenFile(const std::string& filename, bool direct) {
+    auto open_flags = O_CREAT | O_RDWR | O_TRUNC;
+    if (direct) {
+#ifndef __APPLE__
+        open_flags |= O_DIRECT;
+#endif
+    }
+
+    auto fd = open(filename.c_str(), open_flags, S_IRUSR | S_IWUSR);
+    if (fd == -1) {
+        ThrowInfo(ErrorCode::FileCreateFailed,
+                  "Failed to open file: {}, error: {}",
+                  filename,
+                  strerror(errno));
+    }
+
+#ifdef __APPLE__
+    if (direct && fcntl(fd, F_NOCACHE, 1) == -1) {
+        auto err = errno;
+        close(fd);
+        ThrowInfo(ErrorCode::FileCreateFailed,
+                  "Failed to set F_NOCACHE on file: {}, error: {}",
+                  filename,
+                  strerror(err));
+    }
+#endif
+    return fd;
+}
+
+size_t
+AlignUp(size_t size) {
+    return (size + FileWriter::ALIGNMENT_MASK) & ~FileWriter::ALIGNMENT_MASK;
+}
+
+// BatchWriter queues the writes of whole files and submits them to the
+// IoEngine in batches of the queue depth, whatever files they belong to. With
+// direct io the unaligned parts are staged into pooled buffers, where the
+// tails of several small files share a buffer. A file is closed once all of
+// its writes completed, so only the files of the batch in flight are open.
+class BatchWriter {
+ public:
+    BatchWriter(bool direct, io::Priority priority)
+        : direct_(direct),
+          priority_(priority),
+          capacity_(FileWriter::GetBufferSize()),
+          queue_depth_(io::IoEngine::GetQueueDepth()),
+          rate_limiter_(io::WriteRateLimiter::GetInstance()) {
+    }
+
+    ~BatchWriter() {
+        for (auto& file : queued_files_) {
+            close(file.fd);
+        }
+        auto& pool = AlignedBufferPool::GetInstance();
+        for (auto buf : staging_) {
+            pool.Release(buf, capacity_);
+        }
+    }
+
+    void
+    Add(const FileWriter::FileData& file) {
+        queued_files_.push_back(
+            {OpenFile(file.filename, direct_), file.size, &file.filename});
+        auto fd = queued_files_.back().fd;
+        adding_ = true;
+        auto src = static_cast<const char*>(file.data);
+        bool staged = direct_ && reinterpret_cast<uintptr_t>(src) %
+                                         FileWriter::ALIGNMENT_BYTES !=
+                                     0;
+        // direct io writes whole blocks, the file is truncated after
+        size_t total = direct_ ? AlignUp(file.size) : file.size;
+        size_t alignment_bytes = direct_ ? FileWriter::ALIGNMENT_BYTES : 1;
+        size_t offset = 0;
+        while (offset < total) {
+            auto allowed_bytes =
+                rate_limiter_.AcquireOrWait(total - offset,
+                                            alignment_bytes,
+                                            priority_,
+                                            wait_state_,
+                                            [&]() { Submit(); });
+            for (size_t done = 0; done < allowed_bytes;) {
+                auto size = std::min(allowed_bytes - done, capacity_);
+                auto pos = offset + done;
+                auto data_size = std::min(size, file.size - pos);
+                auto buf = staged || data_size < size
+                               ? Stage(src + pos, data_size, size)
+                               : const_cast<char*>(src + pos);
+                requests_.push_back({fd, buf, size, pos});
+                done += size;
+                if (requests_.size() == queue_depth_) {
+                    Submit();
+                }
+            }
+            offset += allowed_bytes;
+        }
+        adding_ = false;
+    }
+
+    size_t
+    Finish() {
+        Submit();
+        return bytes_written_;
+    }
+
+ private:
+    struct QueuedFile {
+        int fd;
+        size_t size;
+        const std::string* filename;
+    };
+
+    // Copies 'data_size' bytes into a staging buffer, zero padded to 'size'.
+    char*
+    Stage(const char* src, size_t data_size, size_t size) {
+        if (used_buffers_ == 0 || staged_bytes_ + size > capacity_) {
+            if (used_buffers_ == staging_.size()) {
+                staging_.push_back(
+                    AlignedBufferPool::GetInstance().Acquire(capacity_));
+            }
+            ++used_buffers_;
+            staged_bytes_ = 0;
+        }
+        auto dst = static_cast<char*>(staging_[used_buffers_ - 1]) +
+                   staged_bytes_;
+        memcpy(dst, src, data_size);
+        memset(dst + data_size, 0, size - data_size);
+        staged_bytes_ += size;
+        return dst;
+    }
+
+    void
+    Submit() {
+        if (!requests_.empty()) {
+            try {
+                io::IoEngine::ThreadLocal().Write(requests_);
+            } catch (const std::exception& e) {
+                ThrowInfo(ErrorCode::FileWriteFailed,
+                          "Failed to write files, error: {}",
+                          e.what());
+            }
+            requests_.clear();
+        }
+        used_buffers_ = 0;
+        staged_bytes_ = 0;
+
+        // every queued file but the one being added is complete now
+        auto complete = queued_files_.size();
+        if (complete > 0 && adding_) {
+            --complete;
+        }
+        for (size_t i = 0; i < complete; ++i) {
+            CloseFile(queued_files_[i]);
+        }
+        queued_files_.erase(queued_files_.begin(),
+                            queued_files_.begin() + complete);
+    }
+
+    void
+    CloseFile(const QueuedFile& file) {
+        // the padding of the last block written by direct io is cut off
+        if (direct_ && ftruncate(file.fd, file.size) != 0) {
+            auto err = errno;
+            close(file.fd);
+            ThrowInfo(ErrorCode::FileWriteFailed,
+                      "Failed to truncate file: {}, error: {}",
+                      *file.filename,
+                      strerror(err));
+        }
+        close(file.fd);
+        bytes_written_ += file.size;
+    }
+
+    bool direct_;
+    io::Priority priority_;
+    size_t capacity_;
+    size_t queue_depth_;
+    io::WriteRateLimiter& rate_limiter_;
+    io::RateLimiter::WaitState wait_state_;
+
+    std::vector<io::IoRequest> requests_;
+    std::vector<QueuedFile> queued_files_;
+    bool adding_{false};
+    std::vector<void*> staging_;
+    size_t used_buffers_{0};
+    size_t staged_bytes_{0};
+    size_t bytes_written_{0};
+};
+
+}  // namespace
+
+AlignedBufferPool&
+AlignedBufferPool::GetInstance() {
+    static AlignedBufferPool instance;
+    return instance;
+}
+
+void*
+AlignedBufferPool::Acquire(size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = free_buffers_.find(size);
+        if (it != free_buffers_.end() && !it->second.empty()) {
+            auto buf = it->second.back();
+            it->second.pop_back();
+            cached_bytes_ -= size;
+            return buf;
+        }
+    }
+    auto buf = aligned_alloc(ALIGNMENT_BYTES, size);
+    if (buf == nullptr) {
+        ThrowInfo(ErrorCode::MemAllocateFailed,
+                  "Failed to allocate aligned buffer of size {}",
+                  size);
+    }
+    return buf;
+}
+
+void
+AlignedBufferPool::Release(void* buf, size_t size) noexcept {
+    if (buf == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cached_bytes_ + size <= MAX_CACHED_BYTES) {
+            free_buffers_[size].push_back(buf);
+            cached_bytes_ += size;
+            return;
+        }
+    }
+    free(buf);
+}
+
+AlignedBufferPool::~AlignedBufferPool() {
+    for (auto& [size, buffers] : free_buffers_) {
+        for (auto buf : buffers) {
+            free(buf);
+        }
+    }
+}
+
 FileWriter::FileWriter(std::string filename, io::Priority priority)
     : filename_(std::move(filename)),
       priority_(priority),
@@ -32,7 +276,7 @@ FileWriter::FileWriter(std::string filename, io::Priority priority)
     use_direct_io_ = mode == WriteMode::DIRECT;
     use_writer_pool_ = FileWriteWorkerPool::GetInstance().HasPool();
 
-    // allocate an internal aligned buffer for both modes to batch writes
+    // take an internal aligned buffer for both modes to batch writes
     size_t buf_size = GetBufferSize();
     AssertInfo(
         buf_size != 0 && (buf_size % ALIGNMENT_BYTES) == 0,
@@ -41,41 +285,14 @@ FileWriter::FileWriter(std::string filename, io::Priority priority)
         buf_size,
         ALIGNMENT_BYTES);
     capacity_ = buf_size;
-    aligned_buf_ = aligned_alloc(ALIGNMENT_BYTES, capacity_);
-    if (aligned_buf_ == nullptr) {
-        ThrowInfo(ErrorCode::MemAllocateFailed,
-                  "Failed to allocate aligned buffer of size {}",
-                  capacity_);
-    }
+    aligned_buf_ = AlignedBufferPool::GetInstance().Acquire(capacity_);
 
-    auto open_flags = O_CREAT | O_RDWR | O_TRUNC;
-    if (use_direct_io_) {
-#ifndef __APPLE__
-        open_flags |= O_DIRECT;
-#endif
-    }
-
-    fd_ = open(filename_.c_str(), open_flags, S_IRUSR | S_IWUSR);
-    if (fd_ == -1) {
+    try {
+        fd_ = OpenFile(filename_, use_direct_io_);
+    } catch (...) {
         Cleanup();
-        ThrowInfo(ErrorCode::FileCreateFailed,
-                  "Failed to open file: {}, error: {}",
-                  filename_,
-                  strerror(errno));
-    }
-
-#ifdef __APPLE__
-    if (use_direct_io_) {
-        auto ret = fcntl(fd_, F_NOCACHE, 1);
-        if (ret == -1) {
-            Cleanup();
-            ThrowInfo(ErrorCode::FileCreateFailed,
-                      "Failed to set F_NOCACHE on file: {}, error: {}",
-                      filename_,
-                      strerror(errno));
-        }
+        throw;
     }
-#endif
 }
 
 FileWriter::~FileWriter() {
@@ -89,71 +306,64 @@ FileWriter::Cleanup() noexcept {
         fd_ = -1;
     }
     if (aligned_buf_ != nullptr) {
-        free(aligned_buf_);
+        AlignedBufferPool::GetInstance().Release(aligned_buf_, capacity_);
         aligned_buf_ = nullptr;
     }
 }
 
-bool
-FileWriter::PositionedWrite(const void* data,
-                            size_t nbyte,
-                            size_t file_offset) {
-    const char* src = static_cast<const char*>(data);
-    size_t left = nbyte;
-
-    while (left != 0) {
-        ssize_t done = pwrite(fd_, src, left, file_offset);
-        if (done < 0) {
-            if (errno == EINTR) {
-                continue;
-            }
-            return false;
-        }
-        left -= done;
-        file_offset += done;
-        src += done;
-    }
-
-    return true;
-}
-
 void
 FileWriter::PositionedWriteWithCheck(const void* data,
                                      size_t nbyte,
                                      size_t file_offset) {
     size_t bytes_to_write = nbyte;
-    int32_t empty_loops = 0;
-    int64_t total_wait_us = 0;
+    io::RateLimiter::WaitState wait_state;
     size_t alignment_bytes = use_direct_io_ ? ALIGNMENT_BYTES : 1;
+    const auto queue_depth = io::IoEngine::GetQueueDepth();
+    std::vector<io::IoRequest> requests;
     while (bytes_to_write != 0) {
+        // do not hold back the granted writes while waiting
         auto allowed_bytes =
-            rate_limiter_.Acquire(bytes_to_write, alignment_bytes, priority_);
-        if (allowed_bytes == 0) {
-            ++empty_loops;
-            // if the empty loops is too large or the total wait time is too long, we should write the data directly
-            if (empty_loops > MAX_EMPTY_LOOPS || total_wait_us > MAX_WAIT_US) {
-                allowed_bytes = bytes_to_write;
-                empty_loops = 0;
-                total_wait_us = 0;
-            } else {
-                int64_t wait_us = (1 << (empty_loops / 10)) *
-                                  rate_limiter_.GetRateLimitPeriod();
-                std::this_thread::sleep_for(std::chrono::microseconds(wait_us));
-                total_wait_us += wait_us;
-                continue;
+            rate_limiter_.AcquireOrWait(bytes_to_write,
+                                        alignment_bytes,
+                                        priority_,
+                                        wait_state,
+                                        [&]() { SubmitWrites(requests); });
+        // slices no larger than the buffer keep every request in the batch
+        // a reasonable unit of work for the device
+        for (size_t done = 0; done < allowed_bytes;) {
+            auto size = std::min(allowed_bytes - done, capacity_);
+            requests.push_back(
+                {fd_,
+                 static_cast<char*>(const_cast<void*>(data)) + done,
+                 size,
+                 file_offset + done});
+            done += size;
+            if (requests.size() == queue_depth) {
+                SubmitWrites(requests);
             }
         }
-        if (!PositionedWrite(data, allowed_bytes, file_offset)) {
-            Cleanup();
-            ThrowInfo(ErrorCode::FileWriteFailed,
-                      "Failed to write to file: {}, error: {}",
-                      filename_,
-                      strerror(errno));
-        }
         file_offset += allowed_bytes;
         bytes_to_write -= allowed_bytes;
         data = static_cast<const char*>(data) + allowed_bytes;
     }
+    SubmitWrites(requests);
+}
+
+void
+FileWriter::SubmitWrites(std::vector<io::IoRequest>& requests) {
+    if (requests.empty()) {
+        return;
+    }
+    try {
+        io::IoEngine::ThreadLocal().Write(requests);
+    } catch (const std::exception& e) {
+        Cleanup();
+        ThrowInfo(ErrorCode::FileWriteFailed,
+                  "Failed to write to file: {}, error: {}",
+                  filename_,
+                  e.what());
+    }
+    requests.clear();
 }
 
 void
@@ -177,13 +387,10 @@ FileWriter::WriteInternal(const void* data, size_t nbyte) {
     if (reinterpret_cast<uintptr_t>(src) % ALIGNMENT_BYTES == 0) {
         size_t aligned_left_size = left_size & ~ALIGNMENT_MASK;
         left_size -= aligned_left_size;
-        while (aligned_left_size != 0) {
-            size_t bytes_written = std::min(aligned_left_size, capacity_);
-            PositionedWriteWithCheck(src, bytes_written, file_size_);
-            file_size_ += bytes_written;
-            aligned_left_size -= bytes_written;
-            src += bytes_written;
-        }
+        // written in buffer sized requests, submitted as one batch
+        PositionedWriteWithCheck(src, aligned_left_size, file_size_);
+        file_size_ += aligned_left_size;
+        src += aligned_left_size;
     }
 
     // finally, handle the left unaligned data by the aligned buffer
@@ -327,6 +534,18 @@ FileWriter::Finish() {
     return file_size_;
 }
 
+size_t
+FileWriter::WriteFiles(const std::vector<FileData>& files,
+                       io::Priority priority) {
+    auto mode =
+        priority == io::Priority::HIGH ? WriteMode::BUFFERED : GetMode();
+    BatchWriter writer(mode == WriteMode::DIRECT, priority);
+    for (auto& file : files) {
+        writer.Add(file);
+    }
+    return writer.Finish();
+}
+
 FileWriter::WriteMode FileWriter::mode_ = FileWriter::WriteMode::BUFFERED;
 size_t FileWriter::buffer_size_ = DEFAULT_BUFFER_SIZE;
 
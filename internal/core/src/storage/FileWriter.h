@@ -29,175 +29,49 @@
 #include <sys/stat.h>
 #include <thread>
 #include <unistd.h>
+#include <unordered_map>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "log/Log.h"
 #include "pb/common.pb.h"
+#include "storage/IoEngine.h"
+#include "storage/RateLimiter.h"
 
 namespace milvus::storage {
 
-namespace io {
-enum class Priority { HIGH = 0, MIDDLE = 1, LOW = 2, NR_PRIORITY = 3 };
-
-inline Priority
-GetPriorityFromLoadPriority(milvus::proto::common::LoadPriority priority) {
-    return priority == milvus::proto::common::LoadPriority::HIGH
-               ? io::Priority::HIGH
-               : io::Priority::LOW;
-}
-
-class WriteRateLimiter {
+/**
+ * AlignedBufferPool keeps the aligned buffers released by finished writers for
+ * the next ones, so caching thousands of small files does not allocate and
+ * free a buffer per file. At most MAX_CACHED_BYTES of free buffers are kept,
+ * the rest are freed on release.
+ */
+class AlignedBufferPool {
  public:
-    static WriteRateLimiter&
-    GetInstance() {
-        static WriteRateLimiter instance;
-        return instance;
-    }
-
-    void
-    Configure(int64_t refill_period_us,
-              int64_t avg_bps,
-              int64_t max_burst_bps,
-              int32_t high_priority_ratio,
-              int32_t middle_priority_ratio,
-              int32_t low_priority_ratio) {
-        if (refill_period_us <= 0 || avg_bps <= 0 || max_burst_bps <= 0 ||
-            avg_bps > max_burst_bps) {
-            ThrowInfo(ErrorCode::InvalidParameter,
-                      "All parameters must be positive, but got: "
-                      "refill_period_us: {}, "
-                      "avg_bps: {}, max_burst_bps: {}",
-                      refill_period_us,
-                      avg_bps,
-                      max_burst_bps);
-        }
-        std::unique_lock<std::mutex> lock(mutex_);
-        // avoid too small refill period, 1ms is used as the minimum refill period
-        refill_period_us_ = std::max<int64_t>(1000, refill_period_us);
-        refill_bytes_per_period_ = avg_bps * refill_period_us_ / 1000000;
-        if (refill_bytes_per_period_ <= 0) {
-            refill_bytes_per_period_ = 1;
-        }
-        expire_periods_ = max_burst_bps * refill_period_us_ / 1000000 /
-                          refill_bytes_per_period_;
-        if (expire_periods_ <= 0) {
-            expire_periods_ = 1;
-        }
-        available_bytes_ = 0;
-        last_refill_time_ = std::chrono::steady_clock::now();
-        priority_ratio_ = {
-            high_priority_ratio, middle_priority_ratio, low_priority_ratio};
-        LOG_INFO(
-            "Disk rate limiter configured with refill_period_us: {}, "
-            "refill_bytes_per_period: {},avg_bps: {}, max_burst_bps: {}, "
-            "expire_periods: {}, high_priority_ratio: {}, "
-            "middle_priority_ratio: {}, low_priority_ratio: {}",
-            refill_period_us_,
-            refill_bytes_per_period_,
-            avg_bps,
-            max_burst_bps,
-            expire_periods_,
-            high_priority_ratio,
-            middle_priority_ratio,
-            low_priority_ratio);
-    }
-
-    size_t
-    Acquire(size_t bytes,
-            size_t alignment_bytes = 1,
-            Priority priority = Priority::MIDDLE) {
-        // if priority ratio is <= 0, no rate limit is applied, return the original bytes
-        if (priority_ratio_[static_cast<int>(priority)] <= 0) {
-            return bytes;
-        }
-
-        std::unique_lock<std::mutex> lock(mutex_);
-        // recheck the amplification ratio after taking the lock
-        auto amplification_ratio = priority_ratio_[static_cast<int>(priority)];
-        if (amplification_ratio <= 0) {
-            return bytes;
-        }
-
-        // calculate the available bytes by delta periods
-        std::chrono::steady_clock::time_point now =
-            std::chrono::steady_clock::now();
-        // steady_clock is monotonic, so the time delta is always >= 0
-        auto delta_periods = static_cast<int>(
-            std::chrono::duration_cast<std::chrono::microseconds>(
-                now - last_refill_time_)
-                .count() /
-            refill_period_us_);
-        // early return if the time delta is less than the refill period and
-        // the available bytes is less than the alignment bytes
-        if (delta_periods == 0 && available_bytes_ < alignment_bytes) {
-            return 0;
-        }
-        if (delta_periods > expire_periods_) {
-            available_bytes_ += expire_periods_ * refill_bytes_per_period_;
-        } else {
-            available_bytes_ += delta_periods * refill_bytes_per_period_;
-        }
-        // keep the available bytes in the range of [0, refill_bytes_per_period_ * expire_periods_]
-        available_bytes_ = std::min(
-            available_bytes_,
-            static_cast<size_t>(refill_bytes_per_period_ * expire_periods_));
-
-        // calculate the allowed bytes with amplification ratio
-        auto ret = std::min(bytes, available_bytes_ * amplification_ratio);
-        // align the allowed bytes to the alignment bytes
-        ret = (ret / alignment_bytes) * alignment_bytes;
-        // update available_bytes_ by removing the amplification ratio, the updated value is always >= 0
-        available_bytes_ -= ret / amplification_ratio;
-
-        // update the last refill time only if delta_periods > 0
-        if (delta_periods > 0) {
-            last_refill_time_ = now;
-        }
+    static constexpr size_t ALIGNMENT_BYTES = 4096;
+    static constexpr size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;  // 64MB
 
-        return ret;
-    }
+    static AlignedBufferPool&
+    GetInstance();
 
-    size_t
-    GetRateLimitPeriod() const {
-        return refill_period_us_;
-    }
-
-    size_t
-    GetBytesPerPeriod() const {
-        return refill_bytes_per_period_;
-    }
+    // Returns a buffer of 'size' bytes aligned to ALIGNMENT_BYTES, throws if
+    // it cannot be allocated.
+    void*
+    Acquire(size_t size);
 
     void
-    Reset() {
-        std::unique_lock<std::mutex> lock(mutex_);
-        available_bytes_ = refill_bytes_per_period_;
-        last_refill_time_ = std::chrono::steady_clock::now();
-    }
+    Release(void* buf, size_t size) noexcept;
 
-    WriteRateLimiter(const WriteRateLimiter&) = delete;
-    WriteRateLimiter&
-    operator=(const WriteRateLimiter&) = delete;
-
-    ~WriteRateLimiter() = default;
+    ~AlignedBufferPool();
 
  private:
-    WriteRateLimiter() = default;
-
-    // Set the default rate limit to a valid, reasonable value.
-    // These values should always be overridden by the yaml configuration, but
-    // if not, the default can still serve as a reasonable "no-limit" fallback.
-    int64_t refill_period_us_ = 100000;                       // 100ms
-    int64_t refill_bytes_per_period_ = 1024ll * 1024 * 1024;  // 1GB
-    int32_t expire_periods_ = 10;                             // 10 periods
-    std::chrono::steady_clock::time_point last_refill_time_ =
-        std::chrono::steady_clock::now();
-    size_t available_bytes_ = 0;
-    std::array<int32_t, 3> priority_ratio_ = {-1, -1, -1};
+    AlignedBufferPool() = default;
+
     std::mutex mutex_;
+    std::unordered_map<size_t, std::vector<void*>> free_buffers_;
+    size_t cached_bytes_{0};
 };
 
-}  // namespace io
-
 /**
  * FileWriter is a class that sequentially writes data to new files, designed specifically for saving temporary data downloaded from remote storage.
  * It supports both buffered and direct I/O, and can use an additional thread pool to write data to files.
@@ -211,19 +85,28 @@ class WriteRateLimiter {
  * ...
  * file_writer.Write(data, size);
  * file_writer.Finish();
+ *
+ * Many small files already in memory are better written at once by
+ * FileWriter::WriteFiles, which coalesces the writes of all of them into
+ * batches of the IoEngine queue depth, so the engine keeps writes to many
+ * files in flight instead of finishing one file before opening the next.
  */
 class FileWriter {
  public:
     enum class WriteMode : uint8_t { BUFFERED = 0, DIRECT = 1 };
 
+    // A whole file for WriteFiles, 'data' must stay valid until it returns.
+    struct FileData {
+        std::string filename;
+        const void* data;
+        size_t size;
+    };
+
     static constexpr size_t ALIGNMENT_BYTES = 4096;
     static constexpr size_t ALIGNMENT_MASK = ALIGNMENT_BYTES - 1;
     static constexpr size_t MAX_BUFFER_SIZE = 64 * 1024 * 1024;  // 64MB
     static constexpr size_t MIN_BUFFER_SIZE = 4 * 1024;          // 4KB
     static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;     // 64KB
-    // for rate limiter
-    static constexpr int MAX_EMPTY_LOOPS = 20;
-    static constexpr int64_t MAX_WAIT_US = 5000000;  // 5s
 
     explicit FileWriter(std::string filename,
                         io::Priority priority = io::Priority::MIDDLE);
@@ -236,6 +119,12 @@ class FileWriter {
     size_t
     Finish();
 
+    // Writes every file in 'files' in full, in the global write mode unless
+    // the priority is high, and returns the total bytes written.
+    static size_t
+    WriteFiles(const std::vector<FileData>& files,
+               io::Priority priority = io::Priority::MIDDLE);
+
     // static functions for global configuration
     static void
     SetMode(WriteMode mode);
@@ -259,14 +148,14 @@ class FileWriter {
     void
     FlushWithBufferedIO();
 
-    bool
-    PositionedWrite(const void* data, size_t nbyte, size_t file_offset);
-
     void
     PositionedWriteWithCheck(const void* data,
                              size_t nbyte,
                              size_t file_offset);
 
+    void
+    SubmitWrites(std::vector<io::IoRequest>& requests);
+
     void
     Cleanup() noexcept;
 
@@ -1021,3 +1021,82 @@ TEST_F(FileWriterTest, ConfigChangeDuringFileWriterOperations) {
     std::filesystem::remove(filename1);
     std::filesystem::remove(filename2);
 }
+
+// Test writing many small files at once with buffered IO
+TEST_F(FileWriterTest, WriteFilesWithBufferedIO) {
+    FileWriter::SetMode(FileWriter::WriteMode::BUFFERED);
+    FileWriter::SetBufferSize(kBufferSize);
+
+    std::vector<std::string> contents;
+    std::vector<FileWriter::FileData> files;
+    for (int i = 0; i < 200; ++i) {
+        contents.emplace_back(i * 97 % 10000, static_cast<char>('a' + i % 26));
+    }
+    size_t total_size = 0;
+    for (int i = 0; i < contents.size(); ++i) {
+        files.push_back({(test_dir_ / ("file_" + std::to_string(i))).string(),
+                         contents[i].data(),
+                         contents[i].size()});
+        total_size += contents[i].size();
+    }
+
+    EXPECT_EQ(FileWriter::WriteFiles(files), total_size);
+
+    for (int i = 0; i < contents.size(); ++i) {
+        std::ifstream file(files[i].filename, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+        EXPECT_EQ(content, contents[i]);
+    }
+}
+
+// Test writing many files at once with direct IO, from unaligned sources
+// whose tails share the staging buffers
+TEST_F(FileWriterTest, WriteFilesWithDirectIO) {
+    FileWriter::SetMode(FileWriter::WriteMode::DIRECT);
+    FileWriter::SetBufferSize(kBufferSize * 4);
+
+    std::string data(1024 * 1024 + 1, '\0');
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i % 251);
+    }
+    std::vector<FileWriter::FileData> files;
+    std::vector<std::pair<size_t, size_t>> ranges = {{0, 0},
+                                                     {1, 13},
+                                                     {7, 4096},
+                                                     {100, 70000},
+                                                     {4096, 8192},
+                                                     {3, 1024 * 1024}};
+    size_t total_size = 0;
+    for (int i = 0; i < 300; ++i) {
+        auto [offset, size] = ranges[i % ranges.size()];
+        files.push_back({(test_dir_ / ("file_" + std::to_string(i))).string(),
+                         data.data() + offset,
+                         size});
+        total_size += size;
+    }
+
+    EXPECT_EQ(FileWriter::WriteFiles(files), total_size);
+
+    for (int i = 0; i < files.size(); ++i) {
+        auto [offset, size] = ranges[i % ranges.size()];
+        EXPECT_EQ(std::filesystem::file_size(files[i].filename), size);
+        std::ifstream file(files[i].filename, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(file)),
+                            std::istreambuf_iterator<char>());
+        EXPECT_EQ(content, data.substr(offset, size));
+    }
+}
+
+// Test that a file which cannot be created fails the whole batch
+TEST_F(FileWriterTest, WriteFilesInvalidPath) {
+    FileWriter::SetMode(FileWriter::WriteMode::BUFFERED);
+
+    std::string data = "data";
+    std::vector<FileWriter::FileData> files = {
+        {(test_dir_ / "valid").string(), data.data(), data.size()},
+        {(test_dir_ / "missing_dir" / "invalid").string(),
+         data.data(),
+         data.size()}};
+    EXPECT_THROW(FileWriter::WriteFiles(files), std::exception);
+}
@@ -0,0 +1,219 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/HedgedChunkManager.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <thread>
+
+#include "common/EasyAssert.h"
+#include "monitor/Monitor.h"
+
+namespace milvus::storage {
+
+namespace {
+
+// the state of a read shared with its requests, which may outlive the read
+struct ReadState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    int failed = 0;
+    std::exception_ptr error;
+    std::vector<char> data;
+    uint64_t size = 0;
+};
+
+}  // namespace
+
+LatencyTracker::LatencyTracker(const HedgedReadConfig& config)
+    : config_(config),
+      delay_(std::chrono::duration_cast<std::chrono::microseconds>(
+          config.max_delay)) {
+    latencies_.reserve(kWindow);
+}
+
+void
+LatencyTracker::Add(std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (latencies_.size() < kWindow) {
+        latencies_.push_back(latency.count());
+    } else {
+        latencies_[next_] = latency.count();
+    }
+    next_ = (next_ + 1) % kWindow;
+    if (++added_ % kRefreshInterval != 0) {
+        return;
+    }
+    auto sorted = latencies_;
+    auto nth = sorted.begin() +
+               static_cast<size_t>(config_.delay_percentile *
+                                   (sorted.size() - 1));
+    std::nth_element(sorted.begin(), nth, sorted.end());
+    delay_ = std::clamp(
+        std::chrono::microseconds(*nth),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            config_.min_delay),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            config_.max_delay));
+}
+
+std::chrono::microseconds
+LatencyTracker::HedgeDelay() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return delay_;
+}
+
+void
+LatencyTracker::AddBudget() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_ = std::min(budget_ + config_.budget_ratio, kMaxBudget);
+}
+
+bool
+LatencyTracker::TryAcquireHedge() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (budget_ < 1) {
+        return false;
+    }
+    budget_ -= 1;
+    return true;
+}
+
+HedgedChunkManager::HedgedChunkManager(ChunkManagerPtr remote,
+                                       const HedgedReadConfig& config)
+    : remote_(std::move(remote)),
+      config_(config),
+      tracker_(std::make_shared<LatencyTracker>(config)) {
+    AssertInfo(remote_ != nullptr, "remote chunk manager is null");
+    AssertInfo(config.delay_percentile > 0 && config.delay_percentile <= 1,
+               "invalid hedge delay percentile {}",
+               config.delay_percentile);
+    AssertInfo(config.min_delay <= config.max_delay,
+               "min hedge delay is larger than the max one");
+    AssertInfo(config.max_retries >= 0, "negative read retries");
+}
+
+uint64_t
+HedgedChunkManager::Read(const std::string& filepath, void* buf, uint64_t len) {
+    // the requests capture what they read by value, they may outlive the read
+    return HedgedRead(
+        [filepath, len](ChunkManager& remote, void* data) {
+            return remote.Read(filepath, data, len);
+        },
+        buf,
+        len);
+}
+
+uint64_t
+HedgedChunkManager::Read(const std::string& filepath,
+                         uint64_t offset,
+                         void* buf,
+                         uint64_t len) {
+    return HedgedRead(
+        [filepath, offset, len](ChunkManager& remote, void* data) {
+            return remote.Read(filepath, offset, data, len);
+        },
+        buf,
+        len);
+}
+
+uint64_t
+HedgedChunkManager::HedgedRead(
+    const std::function<uint64_t(ChunkManager&, void*)>& read,
+    void* buf,
+    uint64_t len) {
+    auto state = std::make_shared<ReadState>();
+    auto launch = [&]() {
+        std::thread([state,
+                     read,
+                     remote = remote_,
+                     tracker = tracker_,
+                     len]() {
+            std::vector<char> data(len);
+            auto start = std::chrono::steady_clock::now();
+            try {
+                auto size = read(*remote, data.data());
+                tracker->Add(
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start));
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->done) {
+                    state->done = true;
+                    state->data = std::move(data);
+                    state->size = size;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->failed++;
+                state->error = std::current_exception();
+            }
+            state->cv.notify_all();
+        }).detach();
+    };
+
+    tracker_->AddBudget();
+    auto delay = tracker_->HedgeDelay();
+    int launched = 1;
+    int retries = 0;
+    bool hedged = false;
+    launch();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    auto settled = [&]() { return state->done || state->failed == launched; };
+    while (!state->done) {
+        if (!hedged) {
+            if (!state->cv.wait_for(lock, delay, settled)) {
+                // one hedge per attempt, only while the budget allows
+                hedged = true;
+                if (tracker_->TryAcquireHedge()) {
+                    monitor::internal_storage_hedged_read_count_hedge
+                        .Increment();
+                    ++launched;
+                    launch();
+                }
+                continue;
+            }
+        } else {
+            state->cv.wait(lock, settled);
+        }
+        if (state->done) {
+            break;
+        }
+
+        // every request sent failed
+        if (retries == config_.max_retries) {
+            std::rethrow_exception(state->error);
+        }
+        auto backoff = config_.backoff * (1 << retries);
+        ++retries;
+        lock.unlock();
+        std::this_thread::sleep_for(backoff);
+        lock.lock();
+        monitor::internal_storage_hedged_read_count_retry.Increment();
+        hedged = false;
+        ++launched;
+        launch();
+    }
+
+    std::memcpy(buf, state->data.data(), state->size);
+    return state->size;
+}
+
+}  // namespace milvus::storage
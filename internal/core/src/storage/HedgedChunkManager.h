@@ -0,0 +1,178 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "storage/ChunkManager.h"
+
+namespace milvus::storage {
+
+struct HedgedReadConfig {
+    // a read still running at this percentile of the recent read latencies
+    // is sent again
+    double delay_percentile = 0.95;
+    std::chrono::milliseconds min_delay{10};
+    std::chrono::milliseconds max_delay{2000};
+    // at most this share of the reads is hedged, so a slow endpoint is not
+    // flooded with duplicates
+    double budget_ratio = 0.05;
+    // a read whose requests all failed is retried this many times, waiting
+    // backoff doubled on every retry
+    int max_retries = 2;
+    std::chrono::milliseconds backoff{50};
+};
+
+/**
+ * @brief LatencyTracker keeps the latencies of the last kWindow reads of an
+ * endpoint and the hedging budget, both shared with the requests still
+ * running after their read returned.
+ */
+class LatencyTracker {
+ public:
+    static constexpr size_t kWindow = 1024;
+    // the percentile is recomputed once this many latencies were added
+    static constexpr size_t kRefreshInterval = 64;
+    // the unused hedges saved up for a burst of slow reads
+    static constexpr double kMaxBudget = 10;
+
+    explicit LatencyTracker(const HedgedReadConfig& config);
+
+    void
+    Add(std::chrono::microseconds latency);
+
+    // the delay after which a read is hedged, max_delay until the window
+    // has enough latencies to tell
+    std::chrono::microseconds
+    HedgeDelay();
+
+    // adds the share of a hedge a read earns
+    void
+    AddBudget();
+
+    bool
+    TryAcquireHedge();
+
+ private:
+    const HedgedReadConfig config_;
+    std::mutex mutex_;
+    std::vector<int64_t> latencies_;
+    size_t next_{0};
+    size_t added_{0};
+    std::chrono::microseconds delay_;
+    double budget_{1};
+};
+
+/**
+ * @brief HedgedChunkManager cuts the tail latency of the reads of a remote
+ * chunk manager. A read that did not complete within the hedge delay, a
+ * high percentile of the recent read latencies, is sent once more within
+ * the hedging budget, and the first response wins. A read whose requests
+ * all failed is retried with exponential backoff. All the operations but
+ * reads go to the remote chunk manager as is.
+ *
+ * The requests run on their own threads into their own buffers, the winner
+ * is copied into the caller's buffer, as the loser cannot be cancelled and
+ * keeps writing after the read returned.
+ */
+class HedgedChunkManager : public ChunkManager {
+ public:
+    HedgedChunkManager(ChunkManagerPtr remote, const HedgedReadConfig& config);
+
+    bool
+    Exist(const std::string& filepath) override {
+        return remote_->Exist(filepath);
+    }
+
+    uint64_t
+    Size(const std::string& filepath) override {
+        return remote_->Size(filepath);
+    }
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override;
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override {
+        remote_->Write(filepath, buf, len);
+    }
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override;
+
+    void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len) override {
+        remote_->Write(filepath, offset, buf, len);
+    }
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override {
+        return remote_->ListWithPrefix(filepath);
+    }
+
+    void
+    Remove(const std::string& filepath) override {
+        remote_->Remove(filepath);
+    }
+
+    std::string
+    GetName() const override {
+        return "HedgedChunkManager";
+    }
+
+    std::string
+    GetRootPath() const override {
+        return remote_->GetRootPath();
+    }
+
+    std::string
+    GetBucketName() const override {
+        return remote_->GetBucketName();
+    }
+
+    ChunkManagerPtr
+    GetRemoteChunkManager() const {
+        return remote_;
+    }
+
+ private:
+    // reads 'len' bytes into buf through 'read', which is called with the
+    // remote chunk manager and a buffer of 'len' bytes
+    uint64_t
+    HedgedRead(
+        const std::function<uint64_t(ChunkManager&, void*)>& read,
+        void* buf,
+        uint64_t len);
+
+    const ChunkManagerPtr remote_;
+    const HedgedReadConfig config_;
+    const std::shared_ptr<LatencyTracker> tracker_;
+};
+
+}  // namespace milvus::storage
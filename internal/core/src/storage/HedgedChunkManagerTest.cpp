@@ -0,0 +1,222 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <thread>
+
+#include "storage/HedgedChunkManager.h"
+
+using namespace milvus::storage;
+using namespace std::chrono_literals;
+
+namespace {
+
+// an object storage serving a single object, whose reads take and fail as
+// scripted, in the order they are sent
+class ScriptedChunkManager : public ChunkManager {
+ public:
+    struct Response {
+        std::chrono::milliseconds delay{0};
+        bool fail = false;
+    };
+
+    explicit ScriptedChunkManager(std::string object)
+        : object_(std::move(object)) {
+    }
+
+    void
+    Script(std::deque<Response> responses) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        responses_ = std::move(responses);
+    }
+
+    bool
+    Exist(const std::string& filepath) override {
+        return true;
+    }
+
+    uint64_t
+    Size(const std::string& filepath) override {
+        return object_.size();
+    }
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override {
+        return Read(filepath, 0, buf, len);
+    }
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override {
+    }
+
+    uint64_t
+    Read(const std::string& filepath,
+         uint64_t offset,
+         void* buf,
+         uint64_t len) override {
+        Response response;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!responses_.empty()) {
+                response = responses_.front();
+                responses_.pop_front();
+            }
+        }
+        reads_++;
+        std::this_thread::sleep_for(response.delay);
+        if (response.fail) {
+            throw std::runtime_error("scripted read failure");
+        }
+        auto size = std::min<uint64_t>(len, object_.size() - offset);
+        std::memcpy(buf, object_.data() + offset, size);
+        return size;
+    }
+
+    void
+    Write(const std::string& filepath,
+          uint64_t offset,
+          void* buf,
+          uint64_t len) override {
+    }
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override {
+        return {};
+    }
+
+    void
+    Remove(const std::string& filepath) override {
+    }
+
+    std::string
+    GetName() const override {
+        return "ScriptedChunkManager";
+    }
+
+    std::string
+    GetRootPath() const override {
+        return "root";
+    }
+
+    std::string
+    GetBucketName() const override {
+        return "bucket";
+    }
+
+    std::atomic<size_t> reads_{0};
+
+ private:
+    const std::string object_;
+    std::mutex mutex_;
+    std::deque<Response> responses_;
+};
+
+HedgedReadConfig
+TestConfig() {
+    HedgedReadConfig config;
+    config.min_delay = 10ms;
+    config.max_delay = 50ms;
+    config.budget_ratio = 1;
+    config.backoff = 1ms;
+    return config;
+}
+
+}  // namespace
+
+TEST(HedgedChunkManagerTest, FastReadIsNotHedged) {
+    auto remote = std::make_shared<ScriptedChunkManager>("hello world");
+    HedgedChunkManager hcm(remote, TestConfig());
+
+    char buf[5];
+    ASSERT_EQ(hcm.Read("obj", 6, buf, sizeof(buf)), 5);
+    EXPECT_EQ(std::string(buf, 5), "world");
+    EXPECT_EQ(remote->reads_, 1);
+}
+
+TEST(HedgedChunkManagerTest, SlowReadIsHedged) {
+    auto remote = std::make_shared<ScriptedChunkManager>("hello world");
+    remote->Script({{2000ms, false}, {0ms, false}});
+    HedgedChunkManager hcm(remote, TestConfig());
+
+    char buf[11];
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(hcm.Read("obj", buf, sizeof(buf)), 11);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(std::string(buf, 11), "hello world");
+    EXPECT_EQ(remote->reads_, 2);
+    // the hedge answered long before the slow request
+    EXPECT_LT(elapsed, 1000ms);
+}
+
+TEST(HedgedChunkManagerTest, HedgesAreBudgeted) {
+    auto remote = std::make_shared<ScriptedChunkManager>("hello world");
+    remote->Script({{200ms, false}, {200ms, false}});
+    auto config = TestConfig();
+    config.budget_ratio = 0;
+    HedgedChunkManager hcm(remote, config);
+
+    // the initial budget allows a single hedge
+    char buf[11];
+    ASSERT_EQ(hcm.Read("obj", buf, sizeof(buf)), 11);
+    EXPECT_EQ(remote->reads_, 2);
+    remote->Script({{200ms, false}});
+    ASSERT_EQ(hcm.Read("obj", buf, sizeof(buf)), 11);
+    EXPECT_EQ(remote->reads_, 3);
+}
+
+TEST(HedgedChunkManagerTest, FailedReadIsRetried) {
+    auto remote = std::make_shared<ScriptedChunkManager>("hello world");
+    remote->Script({{0ms, true}, {0ms, true}});
+    HedgedChunkManager hcm(remote, TestConfig());
+
+    char buf[11];
+    ASSERT_EQ(hcm.Read("obj", buf, sizeof(buf)), 11);
+    EXPECT_EQ(std::string(buf, 11), "hello world");
+    EXPECT_EQ(remote->reads_, 3);
+}
+
+TEST(HedgedChunkManagerTest, ThrowsOnceRetriesAreExhausted) {
+    auto remote = std::make_shared<ScriptedChunkManager>("hello world");
+    remote->Script({{0ms, true}, {0ms, true}, {0ms, true}});
+    HedgedChunkManager hcm(remote, TestConfig());
+
+    char buf[11];
+    EXPECT_THROW(hcm.Read("obj", buf, sizeof(buf)), std::runtime_error);
+    EXPECT_EQ(remote->reads_, 3);
+}
+
+TEST(HedgedChunkManagerTest, HedgeDelayFollowsLatencies) {
+    auto config = TestConfig();
+    config.delay_percentile = 0.5;
+    LatencyTracker tracker(config);
+    EXPECT_EQ(tracker.HedgeDelay(), config.max_delay);
+
+    for (size_t i = 0; i < LatencyTracker::kRefreshInterval; ++i) {
+        tracker.Add(std::chrono::microseconds(20000 + i));
+    }
+    EXPECT_GE(tracker.HedgeDelay(), 20ms);
+    EXPECT_LT(tracker.HedgeDelay(), 21ms);
+
+    // clamped to min_delay
+    for (size_t i = 0; i < LatencyTracker::kWindow; ++i) {
+        tracker.Add(1us);
+    }
+    EXPECT_EQ(tracker.HedgeDelay(), config.min_delay);
+}
@@ -0,0 +1,436 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/IoEngine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef MILVUS_WITH_IO_URING
+#include <liburing.h>
+#endif
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+
+namespace milvus::storage::io {
+
+namespace {
+
+std::atomic<IoEngineType> engine_type{IoEngineType::IO_URING};
+std::atomic<size_t> queue_depth{IoEngine::DEFAULT_QUEUE_DEPTH};
+// bumped on every config change, so the thread local engines get rebuilt
+std::atomic<uint64_t> config_version{0};
+
+[[noreturn]] void
+ThrowIoError(bool is_write, int fd, int err) {
+    if (is_write) {
+        ThrowInfo(ErrorCode::FileWriteFailed,
+                  "Failed to write to fd: {}, error: {}",
+                  fd,
+                  strerror(err));
+    }
+    ThrowInfo(ErrorCode::FileReadFailed,
+              "Failed to read from fd: {}, error: {}",
+              fd,
+              err == 0 ? "unexpected end of file" : strerror(err));
+}
+
+class PreadvIoEngine : public IoEngine {
+ public:
+    void
+    Read(const std::vector<IoRequest>& requests) override {
+        Transfer(requests, false);
+    }
+
+    void
+    Write(const std::vector<IoRequest>& requests) override {
+        Transfer(requests, true);
+    }
+
+    IoEngineType
+    Type() const override {
+        return IoEngineType::PREADV;
+    }
+
+ private:
+    // Issues every run of requests that are contiguous in the same file as
+    // one vectored call, so a batch costs as few system calls as possible.
+    void
+    Transfer(const std::vector<IoRequest>& requests, bool is_write) {
+        std::vector<iovec> iovs;
+        size_t begin = 0;
+        while (begin < requests.size()) {
+            const auto fd = requests[begin].fd;
+            auto offset = requests[begin].offset;
+            auto next_offset = offset;
+            iovs.clear();
+            auto end = begin;
+            while (end < requests.size() && requests[end].fd == fd &&
+                   requests[end].offset == next_offset &&
+                   iovs.size() < IOV_MAX) {
+                if (requests[end].size != 0) {
+                    iovs.push_back({requests[end].buf, requests[end].size});
+                }
+                next_offset += requests[end].size;
+                end++;
+            }
+            TransferVector(fd, iovs, offset, is_write);
+            begin = end;
+        }
+    }
+
+    static void
+    TransferVector(int fd,
+                   std::vector<iovec>& iovs,
+                   uint64_t offset,
+                   bool is_write) {
+        size_t first = 0;
+        while (first < iovs.size()) {
+            const auto count = static_cast<int>(iovs.size() - first);
+            ssize_t done =
+                is_write ? pwritev(fd, iovs.data() + first, count, offset)
+                         : preadv(fd, iovs.data() + first, count, offset);
+            if (done < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowIoError(is_write, fd, errno);
+            }
+            if (done == 0) {
+                ThrowIoError(is_write, fd, 0);
+            }
+            offset += done;
+            // skip the finished buffers and trim the partly finished one
+            auto left = static_cast<size_t>(done);
+            while (first < iovs.size() && left >= iovs[first].iov_len) {
+                left -= iovs[first].iov_len;
+                first++;
+            }
+            if (left > 0) {
+                iovs[first].iov_base =
+                    static_cast<char*>(iovs[first].iov_base) + left;
+                iovs[first].iov_len -= left;
+            }
+        }
+    }
+};
+
+#ifdef MILVUS_WITH_IO_URING
+class UringIoEngine : public IoEngine {
+ public:
+    explicit UringIoEngine(size_t queue_depth) : queue_depth_(queue_depth) {
+        auto ret = io_uring_queue_init(queue_depth_, &ring_, 0);
+        if (ret < 0) {
+            ThrowInfo(ErrorCode::UnexpectedError,
+                      "Failed to set up io_uring with queue depth {}: {}",
+                      queue_depth_,
+                      strerror(-ret));
+        }
+    }
+
+    ~UringIoEngine() override {
+        io_uring_queue_exit(&ring_);
+    }
+
+    void
+    Read(const std::vector<IoRequest>& requests) override {
+        Submit(requests, false);
+    }
+
+    void
+    Write(const std::vector<IoRequest>& requests) override {
+        Submit(requests, true);
+    }
+
+    bool
+    RegisterBuffers(const std::vector<iovec>& buffers) override {
+        UnregisterBuffers();
+        auto ret = io_uring_register_buffers(
+            &ring_, buffers.data(), static_cast<unsigned>(buffers.size()));
+        if (ret < 0) {
+            LOG_WARN("Failed to register {} buffers to io_uring: {}",
+                     buffers.size(),
+                     strerror(-ret));
+            return false;
+        }
+        registered_ = buffers;
+        return true;
+    }
+
+    void
+    UnregisterBuffers() override {
+        if (!registered_.empty()) {
+            io_uring_unregister_buffers(&ring_);
+            registered_.clear();
+        }
+    }
+
+    IoEngineType
+    Type() const override {
+        return IoEngineType::IO_URING;
+    }
+
+ private:
+    // Index of the registered buffer holding [buf, buf + size), or -1.
+    int
+    FixedBufferIndex(const char* buf, size_t size) const {
+        for (size_t i = 0; i < registered_.size(); i++) {
+            auto base = static_cast<const char*>(registered_[i].iov_base);
+            if (buf >= base && buf + size <= base + registered_[i].iov_len) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    void
+    Prepare(const IoRequest& request, size_t done, size_t id, bool is_write) {
+        auto sqe = io_uring_get_sqe(&ring_);
+        AssertInfo(sqe != nullptr, "io_uring submission queue is full");
+        auto buf = static_cast<char*>(request.buf) + done;
+        auto size = static_cast<unsigned>(request.size - done);
+        auto offset = request.offset + done;
+        auto fixed = FixedBufferIndex(buf, size);
+        if (fixed >= 0) {
+            is_write ? io_uring_prep_write_fixed(
+                           sqe, request.fd, buf, size, offset, fixed)
+                     : io_uring_prep_read_fixed(
+                           sqe, request.fd, buf, size, offset, fixed);
+        } else {
+            is_write
+                ? io_uring_prep_write(sqe, request.fd, buf, size, offset)
+                : io_uring_prep_read(sqe, request.fd, buf, size, offset);
+        }
+        io_uring_sqe_set_data64(sqe, id);
+    }
+
+    // Keeps up to queue_depth_ requests in flight and resubmits the rest of
+    // the short ones. On failure it stops submitting, but still waits for the
+    // requests in flight, since the kernel may write into their buffers.
+    void
+    Submit(const std::vector<IoRequest>& requests, bool is_write) {
+        std::vector<size_t> done(requests.size(), 0);
+        std::vector<size_t> retry;
+        size_t next = 0;
+        size_t inflight = 0;
+        int error = -1;
+        int error_fd = -1;
+        while (true) {
+            while (error < 0 && inflight < queue_depth_ &&
+                   (!retry.empty() || next < requests.size())) {
+                size_t id;
+                if (!retry.empty()) {
+                    id = retry.back();
+                    retry.pop_back();
+                } else {
+                    id = next++;
+                    if (requests[id].size == 0) {
+                        continue;
+                    }
+                }
+                Prepare(requests[id], done[id], id, is_write);
+                inflight++;
+            }
+            if (inflight == 0) {
+                break;
+            }
+            auto ret = io_uring_submit_and_wait(&ring_, 1);
+            if (ret < 0 && ret != -EINTR) {
+                // nothing was submitted, so no request is left in flight
+                ThrowIoError(is_write, requests.front().fd, -ret);
+            }
+            io_uring_cqe* cqe;
+            unsigned head;
+            unsigned completed = 0;
+            io_uring_for_each_cqe(&ring_, head, cqe) {
+                completed++;
+                inflight--;
+                auto id = static_cast<size_t>(io_uring_cqe_get_data64(cqe));
+                auto res = cqe->res;
+                if (res == -EINTR || res == -EAGAIN) {
+                    retry.push_back(id);
+                } else if (res <= 0) {
+                    if (error < 0) {
+                        error = -res;
+                        error_fd = requests[id].fd;
+                    }
+                } else {
+                    done[id] += res;
+                    if (done[id] < requests[id].size) {
+                        retry.push_back(id);
+                    }
+                }
+            }
+            io_uring_cq_advance(&ring_, completed);
+        }
+        if (error >= 0) {
+            ThrowIoError(is_write, error_fd, error);
+        }
+    }
+
+    const size_t queue_depth_;
+    io_uring ring_{};
+    std::vector<iovec> registered_;
+};
+#endif
+
+}  // namespace
+
+std::unique_ptr<IoEngine>
+CreateIoEngine(IoEngineType type, size_t queue_depth) {
+#ifdef MILVUS_WITH_IO_URING
+    if (type == IoEngineType::IO_URING) {
+        try {
+            return std::make_unique<UringIoEngine>(queue_depth);
+        } catch (const std::exception& e) {
+            LOG_WARN("Fall back to the preadv io engine, error: {}", e.what());
+        }
+    }
+#endif
+    return std::make_unique<PreadvIoEngine>();
+}
+
+IoEngine&
+IoEngine::ThreadLocal() {
+    thread_local std::unique_ptr<IoEngine> engine;
+    thread_local uint64_t version = 0;
+    auto current = config_version.load();
+    if (engine == nullptr || version != current) {
+        engine = CreateIoEngine(GetEngineType(), GetQueueDepth());
+        version = current;
+    }
+    return *engine;
+}
+
+void
+IoEngine::SetEngineType(IoEngineType type) {
+    if (type != IoEngineType::PREADV && type != IoEngineType::IO_URING) {
+        LOG_WARN(
+            "Invalid io engine type: {}, expected: PREADV or IO_URING, "
+            "set to PREADV",
+            static_cast<int>(type));
+        type = IoEngineType::PREADV;
+    }
+    engine_type.store(type);
+    config_version++;
+    LOG_INFO("Set io engine type to {}", static_cast<uint8_t>(type));
+}
+
+void
+IoEngine::SetQueueDepth(size_t depth) {
+    if (depth == 0 || depth > MAX_QUEUE_DEPTH) {
+        LOG_WARN("Invalid io queue depth: {}, expected: (0, {}], set to {}",
+                 depth,
+                 MAX_QUEUE_DEPTH,
+                 DEFAULT_QUEUE_DEPTH);
+        depth = DEFAULT_QUEUE_DEPTH;
+    }
+    queue_depth.store(depth);
+    config_version++;
+    LOG_INFO("Set io queue depth to {}", depth);
+}
+
+IoEngineType
+IoEngine::GetEngineType() {
+    return engine_type.load();
+}
+
+size_t
+IoEngine::GetQueueDepth() {
+    return queue_depth.load();
+}
+
+size_t
+ReadFile(const std::string& path,
+         void* buf,
+         size_t size,
+         uint64_t offset,
+         bool direct,
+         Priority priority) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        ThrowInfo(ErrorCode::FileOpenFailed,
+                  "Failed to stat file: {}, error: {}",
+                  path,
+                  strerror(errno));
+    }
+    auto file_size = static_cast<uint64_t>(st.st_size);
+    size = offset >= file_size
+               ? 0
+               : std::min<uint64_t>(size, file_size - offset);
+    if (size == 0) {
+        return 0;
+    }
+
+    int fd = -1;
+    size_t alignment_bytes = 1;
+#ifndef __APPLE__
+    if (direct && IoEngine::IsDirectIoAligned(buf, size, offset)) {
+        // not every file system supports O_DIRECT, fall back to buffered
+        fd = open(path.c_str(), O_RDONLY | O_DIRECT);
+        if (fd != -1) {
+            alignment_bytes = IoEngine::DIRECT_IO_ALIGNMENT;
+        }
+    }
+#endif
+    if (fd == -1) {
+        fd = open(path.c_str(), O_RDONLY);
+    }
+    if (fd == -1) {
+        ThrowInfo(ErrorCode::FileOpenFailed,
+                  "Failed to open file: {}, error: {}",
+                  path,
+                  strerror(errno));
+    }
+
+    auto& rate_limiter = ReadRateLimiter::GetInstance();
+    RateLimiter::WaitState wait_state;
+    std::vector<IoRequest> requests;
+    try {
+        for (size_t pos = 0; pos < size;) {
+            auto granted = rate_limiter.AcquireOrWait(
+                size - pos, alignment_bytes, priority, wait_state);
+            requests.clear();
+            for (size_t done = 0; done < granted;
+                 done += IoEngine::READ_BLOCK_SIZE) {
+                requests.push_back(
+                    {fd,
+                     static_cast<char*>(buf) + pos + done,
+                     std::min(IoEngine::READ_BLOCK_SIZE, granted - done),
+                     offset + pos + done});
+            }
+            IoEngine::ThreadLocal().Read(requests);
+            pos += granted;
+        }
+    } catch (const std::exception& e) {
+        close(fd);
+        ThrowInfo(ErrorCode::FileReadFailed,
+                  "Failed to read file: {}, error: {}",
+                  path,
+                  e.what());
+    }
+    close(fd);
+    return size;
+}
+
+}  // namespace milvus::storage::io
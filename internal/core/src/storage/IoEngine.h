@@ -0,0 +1,133 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+#include "storage/RateLimiter.h"
+
+namespace milvus::storage::io {
+
+// One positioned read or write of 'size' bytes between 'buf' and the file
+// behind 'fd' at 'offset'.
+struct IoRequest {
+    int fd;
+    void* buf;
+    size_t size;
+    uint64_t offset;
+};
+
+enum class IoEngineType : uint8_t { PREADV = 0, IO_URING = 1 };
+
+/**
+ * IoEngine submits batches of positioned reads and writes to local files.
+ * The io_uring engine keeps up to the queue depth requests in flight from a
+ * single thread, so a few threads are enough to saturate an NVMe device. The
+ * preadv engine is the fallback where io_uring is not built in or not allowed
+ * by the kernel, it merges the contiguous requests of a batch into vectored
+ * system calls.
+ *
+ * An engine is not thread-safe, every thread uses its own through
+ * IoEngine::ThreadLocal(). Both Read and Write return only after every request
+ * completed in full, and throw if any of them failed.
+ *
+ * The basic usage is:
+ *
+ * std::vector<io::IoRequest> requests{{fd, buf, size, offset}, ...};
+ * io::IoEngine::ThreadLocal().Read(requests);
+ */
+class IoEngine {
+ public:
+    static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+    static constexpr size_t DEFAULT_QUEUE_DEPTH = 64;
+    static constexpr size_t MAX_QUEUE_DEPTH = 4096;
+    // the size of the requests ReadFile splits a read into
+    static constexpr size_t READ_BLOCK_SIZE = 1024 * 1024;  // 1MB
+
+    virtual ~IoEngine() = default;
+
+    // Reads every request in full, reading past the end of a file fails.
+    virtual void
+    Read(const std::vector<IoRequest>& requests) = 0;
+
+    virtual void
+    Write(const std::vector<IoRequest>& requests) = 0;
+
+    // Registers long-lived buffers with the kernel, so requests into them
+    // skip pinning the pages on every submission. Returns false if the engine
+    // does not support it, requests still work on any buffer.
+    virtual bool
+    RegisterBuffers(const std::vector<iovec>& buffers) {
+        return false;
+    }
+
+    virtual void
+    UnregisterBuffers() {
+    }
+
+    virtual IoEngineType
+    Type() const = 0;
+
+    // The engine of the calling thread, rebuilt after a config change.
+    static IoEngine&
+    ThreadLocal();
+
+    // static functions for global configuration
+    static void
+    SetEngineType(IoEngineType type);
+
+    static void
+    SetQueueDepth(size_t queue_depth);
+
+    static IoEngineType
+    GetEngineType();
+
+    static size_t
+    GetQueueDepth();
+
+    static bool
+    IsDirectIoAligned(const void* buf, size_t size, uint64_t offset) {
+        return reinterpret_cast<uintptr_t>(buf) % DIRECT_IO_ALIGNMENT == 0 &&
+               size % DIRECT_IO_ALIGNMENT == 0 &&
+               offset % DIRECT_IO_ALIGNMENT == 0;
+    }
+};
+
+// Creates an engine of the given type, falls back to the preadv engine if
+// io_uring is not available.
+std::unique_ptr<IoEngine>
+CreateIoEngine(IoEngineType type, size_t queue_depth);
+
+// Reads up to 'size' bytes of the file at 'path' from 'offset' into 'buf' with
+// batches of READ_BLOCK_SIZE requests, one batch per grant of the
+// ReadRateLimiter at 'priority', and returns the bytes read, which is less
+// than 'size' only at the end of the file. With 'direct' the page cache is
+// bypassed when the buffer, the offset and the size are aligned.
+size_t
+ReadFile(const std::string& path,
+         void* buf,
+         size_t size,
+         uint64_t offset,
+         bool direct = false,
+         Priority priority = Priority::MIDDLE);
+
+}  // namespace milvus::storage::io
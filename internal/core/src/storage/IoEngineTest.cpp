@@ -0,0 +1,235 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <unistd.h>
+#include <vector>
+
+#include "storage/IoEngine.h"
+
+using namespace milvus::storage::io;
+
+class IoEngineTest : public testing::TestWithParam<IoEngineType> {
+ protected:
+    void
+    SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "io_engine_test";
+        std::filesystem::create_directories(test_dir_);
+    }
+
+    void
+    TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::string
+    CreateFile(const std::string& name, const std::vector<char>& data) {
+        auto path = (test_dir_ / name).string();
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+        return path;
+    }
+
+    static std::vector<char>
+    Sequence(size_t size) {
+        std::vector<char> data(size);
+        for (size_t i = 0; i < size; i++) {
+            data[i] = static_cast<char>(i * 31 + 7);
+        }
+        return data;
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_P(IoEngineTest, ReadBatch) {
+    auto data = Sequence(64 * 1024);
+    auto path = CreateFile("read_batch", data);
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+
+    auto engine = CreateIoEngine(GetParam(), 4);
+    // contiguous and scattered requests, more than the queue depth
+    std::vector<char> buf(data.size());
+    std::vector<IoRequest> requests;
+    for (size_t pos = 0; pos < 32 * 1024; pos += 4096) {
+        requests.push_back({fd, buf.data() + pos, 4096, pos});
+    }
+    for (size_t pos = 60 * 1024; pos >= 32 * 1024; pos -= 4096) {
+        requests.push_back({fd, buf.data() + pos, 4096, pos});
+    }
+    requests.push_back({fd, buf.data(), 0, 0});
+    engine->Read(requests);
+    EXPECT_EQ(buf, data);
+    close(fd);
+}
+
+TEST_P(IoEngineTest, WriteBatch) {
+    auto data = Sequence(40 * 1024 + 123);
+    auto path = (test_dir_ / "write_batch").string();
+    int fd = open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_NE(fd, -1);
+
+    auto engine = CreateIoEngine(GetParam(), 2);
+    std::vector<IoRequest> requests;
+    for (size_t pos = 0; pos < data.size(); pos += 1000) {
+        requests.push_back({fd,
+                            data.data() + pos,
+                            std::min<size_t>(1000, data.size() - pos),
+                            pos});
+    }
+    engine->Write(requests);
+    close(fd);
+
+    std::vector<char> content(data.size());
+    EXPECT_EQ(ReadFile(path, content.data(), content.size(), 0),
+              data.size());
+    EXPECT_EQ(content, data);
+}
+
+TEST_P(IoEngineTest, ReadPastEndOfFile) {
+    auto path = CreateFile("short", Sequence(100));
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+
+    auto engine = CreateIoEngine(GetParam(), 4);
+    std::vector<char> buf(200);
+    std::vector<IoRequest> requests{{fd, buf.data(), 200, 0}};
+    EXPECT_ANY_THROW(engine->Read(requests));
+    close(fd);
+}
+
+TEST_P(IoEngineTest, RegisteredBuffers) {
+    auto data = Sequence(16 * 1024);
+    auto path = CreateFile("registered", data);
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT_NE(fd, -1);
+
+    auto engine = CreateIoEngine(GetParam(), 4);
+    std::vector<char> buf(data.size());
+    // requests work the same whether the buffer could be registered or not
+    engine->RegisterBuffers({{buf.data(), buf.size()}});
+    std::vector<IoRequest> requests{{fd, buf.data(), 8192, 0},
+                                    {fd, buf.data() + 8192, 8192, 8192}};
+    engine->Read(requests);
+    engine->UnregisterBuffers();
+    EXPECT_EQ(buf, data);
+    close(fd);
+}
+
+INSTANTIATE_TEST_SUITE_P(IoEngineType,
+                         IoEngineTest,
+                         testing::Values(IoEngineType::PREADV,
+                                         IoEngineType::IO_URING));
+
+TEST(IoEngineReadFileTest, ClampsAtEndOfFile) {
+    auto path = (std::filesystem::temp_directory_path() / "io_engine_clamp")
+                    .string();
+    std::vector<char> data(3 * IoEngine::READ_BLOCK_SIZE + 17);
+    std::iota(data.begin(), data.end(), 0);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    std::vector<char> buf(data.size() + 4096);
+    EXPECT_EQ(ReadFile(path, buf.data(), buf.size(), 0), data.size());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), buf.begin()));
+
+    EXPECT_EQ(ReadFile(path, buf.data(), 10, data.size() - 5), 5);
+    EXPECT_EQ(ReadFile(path, buf.data(), 10, data.size() + 5), 0);
+    std::filesystem::remove(path);
+    EXPECT_ANY_THROW(ReadFile(path, buf.data(), 10, 0));
+}
+
+TEST(IoEngineReadFileTest, DirectRead) {
+    auto path = (std::filesystem::temp_directory_path() / "io_engine_direct")
+                    .string();
+    const size_t size = 2 * IoEngine::READ_BLOCK_SIZE;
+    std::vector<char> data(size);
+    std::iota(data.begin(), data.end(), 0);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    auto buf = static_cast<char*>(
+        aligned_alloc(IoEngine::DIRECT_IO_ALIGNMENT, size));
+    ASSERT_NE(buf, nullptr);
+    EXPECT_EQ(ReadFile(path, buf, size, 0, true), size);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), buf));
+    // unaligned reads fall back to buffered reads
+    EXPECT_EQ(ReadFile(path, buf + 1, 100, 3, true), 100);
+    EXPECT_TRUE(std::equal(data.begin() + 3, data.begin() + 103, buf + 1));
+    free(buf);
+    std::filesystem::remove(path);
+}
+
+TEST(IoEngineReadFileTest, RateLimitedRead) {
+    auto path = (std::filesystem::temp_directory_path() / "io_engine_limited")
+                    .string();
+    std::vector<char> data(IoEngine::READ_BLOCK_SIZE + 4096 * 3 + 5);
+    std::iota(data.begin(), data.end(), 0);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), data.size());
+    }
+
+    // 256KB per 10ms period, the read takes a few grants
+    auto& limiter = ReadRateLimiter::GetInstance();
+    limiter.Configure(/*refill_period_us*/ 10000,
+                      /*avg_bps*/ 256 * 1024 * 100,
+                      /*max_burst_bps*/ 256 * 1024 * 100,
+                      /*high*/ 1,
+                      /*middle*/ 1,
+                      /*low*/ 1);
+    std::vector<char> buf(data.size());
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(ReadFile(path, buf.data(), buf.size(), 0), data.size());
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(30));
+    EXPECT_EQ(buf, data);
+
+    limiter.Configure(10000,
+                      256 * 1024 * 100,
+                      256 * 1024 * 100,
+                      /*high*/ -1,
+                      /*middle*/ -1,
+                      /*low*/ -1);
+    std::filesystem::remove(path);
+}
+
+TEST(IoEngineConfigTest, ThreadLocalFollowsConfig) {
+    auto type = IoEngine::GetEngineType();
+    auto depth = IoEngine::GetQueueDepth();
+
+    IoEngine::SetEngineType(IoEngineType::PREADV);
+    EXPECT_EQ(IoEngine::ThreadLocal().Type(), IoEngineType::PREADV);
+    IoEngine::SetQueueDepth(0);
+    EXPECT_EQ(IoEngine::GetQueueDepth(), IoEngine::DEFAULT_QUEUE_DEPTH);
+    IoEngine::SetQueueDepth(IoEngine::MAX_QUEUE_DEPTH + 1);
+    EXPECT_EQ(IoEngine::GetQueueDepth(), IoEngine::DEFAULT_QUEUE_DEPTH);
+    IoEngine::SetQueueDepth(16);
+    EXPECT_EQ(IoEngine::GetQueueDepth(), 16);
+
+    IoEngine::SetEngineType(type);
+    IoEngine::SetQueueDepth(depth);
+}
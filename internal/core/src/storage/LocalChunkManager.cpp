@@ -26,6 +26,8 @@
 
 #include "common/EasyAssert.h"
 #include "common/Exception.h"
+#include "storage/FileWriter.h"
+#include "storage/IoEngine.h"
 
 namespace milvus::storage {
 
@@ -84,25 +86,13 @@ LocalChunkManager::Read(const std::string& filepath,
                         uint64_t offset,
                         void* buf,
                         uint64_t size) {
-    std::ifstream infile;
-    infile.open(filepath.data(), std::ios_base::binary);
-    if (infile.fail()) {
-        std::stringstream err_msg;
-        err_msg << "Error: open local file '" << filepath << " failed, "
-                << strerror(errno);
-        ThrowInfo(FileOpenFailed, err_msg.str());
-    }
-
-    infile.seekg(offset, std::ios::beg);
-    if (!infile.read(reinterpret_cast<char*>(buf), size)) {
-        if (!infile.eof()) {
-            std::stringstream err_msg;
-            err_msg << "Error: read local file '" << filepath << " failed, "
-                    << strerror(errno);
-            ThrowInfo(FileReadFailed, err_msg.str());
-        }
-    }
-    return infile.gcount();
+    // large reads are split into a batch for the io engine, so a single
+    // thread keeps the device busy while loading index files
+    return io::ReadFile(filepath,
+                        buf,
+                        size,
+                        offset,
+                        FileWriter::GetMode() == FileWriter::WriteMode::DIRECT);
 }
 
 void
@@ -130,30 +130,14 @@ MemFileManagerImpl::LoadIndexToMemory(
     std::map<std::string, std::unique_ptr<DataCodec>> file_to_index_data;
     auto parallel_degree =
         static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
-    std::vector<std::string> batch_files;
-
-    auto LoadBatchIndexFiles = [&]() {
-        auto index_datas = GetObjectData(
-            rcm_.get(), batch_files, milvus::PriorityForLoad(priority));
-        // Wait for all futures to ensure all threads complete
-        auto codecs = storage::WaitAllFutures(std::move(index_datas));
-        for (size_t idx = 0; idx < batch_files.size(); ++idx) {
-            auto file_name =
-                batch_files[idx].substr(batch_files[idx].find_last_of('/') + 1);
-            file_to_index_data[file_name] = std::move(codecs[idx]);
-        }
-    };
-
-    for (auto& file : remote_files) {
-        if (batch_files.size() >= parallel_degree) {
-            LoadBatchIndexFiles();
-            batch_files.clear();
-        }
-        batch_files.emplace_back(file);
-    }
-
-    if (batch_files.size() > 0) {
-        LoadBatchIndexFiles();
+    auto codecs = BatchGetObjectData(rcm_.get(),
+                                     remote_files,
+                                     std::max<uint64_t>(parallel_degree, 1),
+                                     milvus::PriorityForLoad(priority));
+    for (size_t idx = 0; idx < remote_files.size(); ++idx) {
+        auto file_name =
+            remote_files[idx].substr(remote_files[idx].find_last_of('/') + 1);
+        file_to_index_data[file_name] = std::move(codecs[idx]);
     }
 
     AssertInfo(file_to_index_data.size() == remote_files.size(),
@@ -161,6 +145,20 @@ MemFileManagerImpl::LoadIndexToMemory(
     return file_to_index_data;
 }
 
+void
+MemFileManagerImpl::StreamIndexToMemory(
+    const std::vector<std::string>& remote_files,
+    milvus::proto::common::LoadPriority priority,
+    const std::function<void(size_t, std::unique_ptr<DataCodec>)>& consumer) {
+    auto parallel_degree =
+        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    StreamObjectData(rcm_.get(),
+                     remote_files,
+                     std::max<uint64_t>(parallel_degree, 1),
+                     consumer,
+                     milvus::PriorityForLoad(priority));
+}
+
 std::vector<FieldDataPtr>
 MemFileManagerImpl::CacheRawDataToMemory(const Config& config) {
     auto storage_version =
@@ -172,8 +170,10 @@ MemFileManagerImpl::CacheRawDataToMemory(const Config& config) {
     return cache_raw_data_to_memory_internal(config);
 }
 
-std::vector<FieldDataPtr>
-MemFileManagerImpl::cache_raw_data_to_memory_internal(const Config& config) {
+void
+MemFileManagerImpl::StreamRawDataToMemory(
+    const Config& config,
+    const std::function<void(std::vector<FieldDataPtr>&&)>& consumer) {
     auto insert_files = index::GetValueFromConfig<std::vector<std::string>>(
         config, INSERT_FILES_KEY);
     AssertInfo(insert_files.has_value(),
@@ -184,15 +184,16 @@ MemFileManagerImpl::cache_raw_data_to_memory_internal(const Config& config) {
     auto parallel_degree =
         uint64_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
     std::vector<std::string> batch_files;
-    std::vector<FieldDataPtr> field_datas;
 
     auto FetchRawData = [&]() {
         auto raw_datas = GetObjectData(rcm_.get(), batch_files);
         // Wait for all futures to ensure all threads complete
         auto codecs = storage::WaitAllFutures(std::move(raw_datas));
+        std::vector<FieldDataPtr> field_datas;
         for (auto& codec : codecs) {
             field_datas.emplace_back(codec->GetFieldData());
         }
+        consumer(std::move(field_datas));
     };
 
     for (auto& file : remote_files) {
@@ -205,8 +206,20 @@ MemFileManagerImpl::cache_raw_data_to_memory_internal(const Config& config) {
     if (batch_files.size() > 0) {
         FetchRawData();
     }
+}
 
-    AssertInfo(field_datas.size() == remote_files.size(),
+std::vector<FieldDataPtr>
+MemFileManagerImpl::cache_raw_data_to_memory_internal(const Config& config) {
+    std::vector<FieldDataPtr> field_datas;
+    StreamRawDataToMemory(config, [&](std::vector<FieldDataPtr>&& batch) {
+        for (auto& field_data : batch) {
+            field_datas.emplace_back(std::move(field_data));
+        }
+    });
+
+    auto insert_files = index::GetValueFromConfig<std::vector<std::string>>(
+        config, INSERT_FILES_KEY);
+    AssertInfo(field_datas.size() == insert_files.value().size(),
                "inconsistent file num and raw data num!");
     return field_datas;
 }
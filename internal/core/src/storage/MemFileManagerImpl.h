@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -66,9 +67,26 @@ class MemFileManagerImpl : public FileManagerImpl {
     LoadIndexToMemory(const std::vector<std::string>& remote_files,
                       milvus::proto::common::LoadPriority priority);
 
+    // Like LoadIndexToMemory, but hands the files to consumer one by one in
+    // the order of remote_files while the next ones are still downloading.
+    void
+    StreamIndexToMemory(
+        const std::vector<std::string>& remote_files,
+        milvus::proto::common::LoadPriority priority,
+        const std::function<void(size_t, std::unique_ptr<DataCodec>)>&
+            consumer);
+
     std::vector<FieldDataPtr>
     CacheRawDataToMemory(const Config& config);
 
+    // Like CacheRawDataToMemory for the insert files of storage v1, but
+    // hands the field datas to consumer batch by batch, in file order,
+    // before fetching the next batch.
+    void
+    StreamRawDataToMemory(
+        const Config& config,
+        const std::function<void(std::vector<FieldDataPtr>&&)>& consumer);
+
     bool
     AddFile(const BinarySet& binary_set);
 
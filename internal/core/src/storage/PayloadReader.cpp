@@ -14,6 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "arrow/io/api.h"
 #include "arrow/status.h"
 #include "common/EasyAssert.h"
@@ -36,16 +38,30 @@ PayloadReader::PayloadReader(const uint8_t* data,
                              DataType data_type,
                              bool nullable,
                              bool is_field_data)
+    : PayloadReader(std::make_shared<arrow::Buffer>(data, length),
+                    data_type,
+                    nullable,
+                    is_field_data) {
+}
+
+PayloadReader::PayloadReader(std::shared_ptr<arrow::Buffer> buffer,
+                             DataType data_type,
+                             bool nullable,
+                             bool is_field_data)
     : column_type_(data_type), nullable_(nullable) {
-    init(data, length, is_field_data);
+    init(std::move(buffer), is_field_data);
 }
 
 void
-PayloadReader::init(const uint8_t* data, int length, bool is_field_data) {
+PayloadReader::init(std::shared_ptr<arrow::Buffer> buffer,
+                    bool is_field_data) {
+    buffer_ = buffer;
     if (column_type_ == DataType::NONE) {
-        payload_buf_ = std::make_shared<BytesBuf>(data, length);
+        payload_buf_ =
+            std::make_shared<BytesBuf>(buffer->data(), buffer->size());
     } else {
-        auto input = std::make_shared<arrow::io::BufferReader>(data, length);
+        // the reader slices the buffer, the pages are not copied out of it
+        auto input = std::make_shared<arrow::io::BufferReader>(buffer);
         arrow::MemoryPool* pool = arrow::default_memory_pool();
         // Configure general Parquet reader settings
         auto reader_properties = parquet::ReaderProperties(pool);
@@ -145,6 +161,14 @@ PayloadReader::init(const uint8_t* data, int length, bool is_field_data) {
                 dim_ > 0, "VectorArray dim must be positive, got {}", dim_);
         }
 
+        // a fixed width row group decodes into a single array, which an
+        // in-memory chunk borrows instead of copying
+        if (!is_field_data && !IsVariableDataType(column_type_) &&
+            !IsVectorArrayDataType(column_type_)) {
+            arrow_reader->set_batch_size(std::max<int64_t>(
+                file_meta->num_rows(), arrow_reader_props.batch_size()));
+        }
+
         std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
         st = arrow_reader->GetRecordBatchReader(&rb_reader);
         AssertInfo(st.ok(), "get record batch reader");
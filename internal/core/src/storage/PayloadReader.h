@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <arrow/buffer.h>
 #include <arrow/record_batch.h>
 #include <parquet/arrow/reader.h>
 
@@ -25,10 +26,29 @@
 
 namespace milvus::storage {
 
+// An arrow buffer over a slice of a binlog that shares its ownership, so the
+// readers over it keep the binlog alive without copying the payload.
+class BinlogBuffer : public arrow::Buffer {
+ public:
+    BinlogBuffer(std::shared_ptr<uint8_t[]> data, int64_t size)
+        : arrow::Buffer(data.get(), size), data_(std::move(data)) {
+    }
+
+ private:
+    std::shared_ptr<uint8_t[]> data_;
+};
+
 class PayloadReader {
  public:
     explicit PayloadReader(const FieldDataPtr& fieldData);
 
+    // Reads the payload in 'buffer' without copying it, the readers and the
+    // binary payload keep the buffer alive.
+    explicit PayloadReader(std::shared_ptr<arrow::Buffer> buffer,
+                           DataType data_type,
+                           bool nullable,
+                           bool is_field_data = true);
+
     explicit PayloadReader(const uint8_t* data,
                            int length,
                            DataType data_type,
@@ -38,7 +58,7 @@ class PayloadReader {
     ~PayloadReader() = default;
 
     void
-    init(const uint8_t* data, int length, bool is_field_data);
+    init(std::shared_ptr<arrow::Buffer> buffer, bool is_field_data);
 
     const FieldDataPtr
     get_field_data() const {
@@ -115,6 +135,7 @@ class PayloadReader {
 
     // buffer for zero-copy bytes
     std::shared_ptr<BytesBuf> payload_buf_;
+    std::shared_ptr<arrow::Buffer> buffer_;
 };
 
 }  // namespace milvus::storage
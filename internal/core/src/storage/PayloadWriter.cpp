@@ -14,6 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "arrow/util/compression.h"
 #include "common/EasyAssert.h"
 #include "common/FieldMeta.h"
 #include "common/Types.h"
@@ -22,6 +29,134 @@
 
 namespace milvus::storage {
 
+namespace {
+
+// the leading values the column statistics are taken from
+constexpr int64_t STATS_SAMPLE_ROWS = 4096;
+constexpr int64_t COMPRESSION_SAMPLE_BYTES = 64 * 1024;
+// a column with fewer distinct sampled values than this share of the sampled
+// rows keeps dictionary encoding
+constexpr double LOW_CARDINALITY_RATIO = 0.1;
+// a column with at least this share of non-decreasing sampled values, like
+// primary keys and timestamps, is delta encoded
+constexpr double SORTED_RATIO = 0.9;
+// a column saving less than this share of its size is stored uncompressed
+constexpr double MIN_COMPRESSION_SAVING = 0.1;
+constexpr int COMPRESSION_LEVEL = 3;
+
+struct ColumnStats {
+    bool low_cardinality = false;
+    bool mostly_sorted = false;
+};
+
+template <typename ArrayType>
+ColumnStats
+SampleColumnStats(const arrow::Array& array) {
+    using ValueType = typename ArrayType::value_type;
+    auto& typed = static_cast<const ArrayType&>(array);
+    std::unordered_set<ValueType> distinct;
+    int64_t sampled = 0;
+    int64_t sorted = 0;
+    std::optional<ValueType> prev;
+    for (int64_t i = 0; i < typed.length() && sampled < STATS_SAMPLE_ROWS;
+         ++i) {
+        if (typed.IsNull(i)) {
+            continue;
+        }
+        auto value = typed.Value(i);
+        distinct.insert(value);
+        if (prev.has_value() && !(value < prev.value())) {
+            ++sorted;
+        }
+        prev = value;
+        ++sampled;
+    }
+    ColumnStats stats;
+    if (sampled > 1) {
+        stats.low_cardinality =
+            distinct.size() < sampled * LOW_CARDINALITY_RATIO;
+        stats.mostly_sorted = sorted >= (sampled - 1) * SORTED_RATIO;
+    }
+    return stats;
+}
+
+// Compresses the leading bytes of 'data' to tell whether the column is worth
+// compressing at all.
+bool
+Compressible(const uint8_t* data, int64_t size) {
+    size = std::min(size, COMPRESSION_SAMPLE_BYTES);
+    if (size == 0) {
+        return true;
+    }
+    auto codec =
+        arrow::util::Codec::Create(arrow::Compression::ZSTD, COMPRESSION_LEVEL);
+    if (!codec.ok()) {
+        return true;
+    }
+    auto max_size = (*codec)->MaxCompressedLen(size, data);
+    std::vector<uint8_t> compressed(max_size);
+    auto compressed_size =
+        (*codec)->Compress(size, data, max_size, compressed.data());
+    return compressed_size.ok() &&
+           *compressed_size <= size * (1 - MIN_COMPRESSION_SAVING);
+}
+
+// Picks the encoding and codec of the column from the statistics of its
+// values: delta encoding for sorted integers, byte stream split for floats,
+// and no dictionary nor compression for vectors that do not compress.
+// Low-cardinality columns keep the default dictionary encoding with ZSTD.
+void
+SetColumnEncoding(parquet::WriterProperties::Builder& builder,
+                  const std::string& path,
+                  DataType data_type,
+                  const std::shared_ptr<arrow::Array>& array) {
+    switch (data_type) {
+        case DataType::INT32:
+        case DataType::INT64:
+        case DataType::TIMESTAMPTZ: {
+            auto stats = array->type_id() == arrow::Type::INT32
+                             ? SampleColumnStats<arrow::Int32Array>(*array)
+                             : SampleColumnStats<arrow::Int64Array>(*array);
+            if (!stats.low_cardinality && stats.mostly_sorted) {
+                builder.disable_dictionary(path);
+                builder.encoding(path,
+                                 parquet::Encoding::DELTA_BINARY_PACKED);
+            }
+            break;
+        }
+        case DataType::FLOAT:
+        case DataType::DOUBLE: {
+            auto stats = data_type == DataType::FLOAT
+                             ? SampleColumnStats<arrow::FloatArray>(*array)
+                             : SampleColumnStats<arrow::DoubleArray>(*array);
+            if (!stats.low_cardinality) {
+                builder.disable_dictionary(path);
+                builder.encoding(path, parquet::Encoding::BYTE_STREAM_SPLIT);
+            }
+            break;
+        }
+        case DataType::VECTOR_FLOAT:
+        case DataType::VECTOR_FLOAT16:
+        case DataType::VECTOR_BFLOAT16:
+        case DataType::VECTOR_BINARY:
+        case DataType::VECTOR_INT8: {
+            builder.disable_dictionary(path);
+            auto vectors =
+                std::dynamic_pointer_cast<arrow::FixedSizeBinaryArray>(array);
+            if (vectors != nullptr &&
+                !Compressible(vectors->raw_values(),
+                              vectors->length() * vectors->byte_width())) {
+                builder.compression(path, arrow::Compression::UNCOMPRESSED);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+}  // namespace
+
 // create payload writer for numeric data type
 PayloadWriter::PayloadWriter(const DataType column_type, bool nullable)
     : column_type_(column_type), nullable_(nullable) {
@@ -120,14 +255,17 @@ PayloadWriter::finish() {
         arrow_properties = arrow_props_builder.build();
     }
 
+    parquet::WriterProperties::Builder properties_builder;
+    properties_builder.compression(arrow::Compression::ZSTD)
+        ->compression_level(COMPRESSION_LEVEL);
+    SetColumnEncoding(
+        properties_builder, schema_->field(0)->name(), column_type_, array);
+
     ast = parquet::arrow::WriteTable(*table,
                                      mem_pool,
                                      output_,
                                      1024 * 1024 * 1024,
-                                     parquet::WriterProperties::Builder()
-                                         .compression(arrow::Compression::ZSTD)
-                                         ->compression_level(3)
-                                         ->build(),
+                                     properties_builder.build(),
                                      arrow_properties);
     AssertInfo(ast.ok(), ast.ToString());
 }
@@ -0,0 +1,95 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/RateLimiter.h"
+
+#include <thread>
+
+#include "monitor/Monitor.h"
+
+namespace milvus::storage::io {
+
+size_t
+RateLimiter::AcquireOrWait(size_t bytes,
+                           size_t alignment_bytes,
+                           Priority priority,
+                           WaitState& state,
+                           const std::function<void()>& before_wait) {
+    bool high = priority == Priority::HIGH;
+    bool waiting = false;
+    bool slept = false;
+    auto start = std::chrono::steady_clock::now();
+    size_t allowed_bytes = 0;
+    while (true) {
+        allowed_bytes = Acquire(bytes, alignment_bytes, priority);
+        if (allowed_bytes != 0) {
+            break;
+        }
+        ++state.empty_loops;
+        // if the empty loops is too large or the total wait time is too long,
+        // grant the bytes directly
+        if (state.empty_loops > MAX_EMPTY_LOOPS ||
+            state.total_wait_us > MAX_WAIT_US) {
+            allowed_bytes = bytes;
+            state = WaitState{};
+            break;
+        }
+        if (high && !waiting) {
+            waiting = true;
+            ++waiting_high_;
+        }
+        if (before_wait) {
+            before_wait();
+        }
+        int64_t wait_us =
+            (1 << (state.empty_loops / 10)) * GetRateLimitPeriod();
+        std::this_thread::sleep_for(std::chrono::microseconds(wait_us));
+        state.total_wait_us += wait_us;
+        slept = true;
+    }
+    if (waiting) {
+        --waiting_high_;
+    }
+    if (slept) {
+        auto waited = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+        wait_duration_->Observe(waited);
+    }
+    return allowed_bytes;
+}
+
+WriteRateLimiter&
+WriteRateLimiter::GetInstance() {
+    static WriteRateLimiter instance;
+    return instance;
+}
+
+WriteRateLimiter::WriteRateLimiter()
+    : RateLimiter("write", &monitor::internal_storage_rate_limit_wait_write) {
+}
+
+ReadRateLimiter&
+ReadRateLimiter::GetInstance() {
+    static ReadRateLimiter instance;
+    return instance;
+}
+
+ReadRateLimiter::ReadRateLimiter()
+    : RateLimiter("read", &monitor::internal_storage_rate_limit_wait_read) {
+}
+
+}  // namespace milvus::storage::io
@@ -0,0 +1,253 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include "common/EasyAssert.h"
+#include "log/Log.h"
+#include "pb/common.pb.h"
+
+namespace prometheus {
+class Histogram;
+}  // namespace prometheus
+
+namespace milvus::storage {
+
+namespace io {
+enum class Priority { HIGH = 0, MIDDLE = 1, LOW = 2, NR_PRIORITY = 3 };
+
+inline Priority
+GetPriorityFromLoadPriority(milvus::proto::common::LoadPriority priority) {
+    return priority == milvus::proto::common::LoadPriority::HIGH
+               ? io::Priority::HIGH
+               : io::Priority::LOW;
+}
+
+/**
+ * RateLimiter is a token bucket shared by the local disk I/O of one kind,
+ * every priority draws from the same bucket with its own amplification
+ * ratio. While a HIGH priority caller waits for tokens the other priorities
+ * get none, so a background load can not starve the query path.
+ */
+class RateLimiter {
+ public:
+    // an AcquireOrWait waiting longer than this grants all the bytes
+    static constexpr int MAX_EMPTY_LOOPS = 20;
+    static constexpr int64_t MAX_WAIT_US = 5000000;  // 5s
+
+    // the waits of the acquisitions of one read or write
+    struct WaitState {
+        int32_t empty_loops = 0;
+        int64_t total_wait_us = 0;
+    };
+
+    RateLimiter(std::string name, prometheus::Histogram* wait_duration)
+        : name_(std::move(name)), wait_duration_(wait_duration) {
+    }
+
+    void
+    Configure(int64_t refill_period_us,
+              int64_t avg_bps,
+              int64_t max_burst_bps,
+              int32_t high_priority_ratio,
+              int32_t middle_priority_ratio,
+              int32_t low_priority_ratio) {
+        if (refill_period_us <= 0 || avg_bps <= 0 || max_burst_bps <= 0 ||
+            avg_bps > max_burst_bps) {
+            ThrowInfo(ErrorCode::InvalidParameter,
+                      "All parameters must be positive, but got: "
+                      "refill_period_us: {}, "
+                      "avg_bps: {}, max_burst_bps: {}",
+                      refill_period_us,
+                      avg_bps,
+                      max_burst_bps);
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        // avoid too small refill period, 1ms is used as the minimum refill period
+        refill_period_us_ = std::max<int64_t>(1000, refill_period_us);
+        refill_bytes_per_period_ = avg_bps * refill_period_us_ / 1000000;
+        if (refill_bytes_per_period_ <= 0) {
+            refill_bytes_per_period_ = 1;
+        }
+        expire_periods_ = max_burst_bps * refill_period_us_ / 1000000 /
+                          refill_bytes_per_period_;
+        if (expire_periods_ <= 0) {
+            expire_periods_ = 1;
+        }
+        available_bytes_ = 0;
+        last_refill_time_ = std::chrono::steady_clock::now();
+        priority_ratio_ = {
+            high_priority_ratio, middle_priority_ratio, low_priority_ratio};
+        LOG_INFO(
+            "Disk {} rate limiter configured with refill_period_us: {}, "
+            "refill_bytes_per_period: {},avg_bps: {}, max_burst_bps: {}, "
+            "expire_periods: {}, high_priority_ratio: {}, "
+            "middle_priority_ratio: {}, low_priority_ratio: {}",
+            name_,
+            refill_period_us_,
+            refill_bytes_per_period_,
+            avg_bps,
+            max_burst_bps,
+            expire_periods_,
+            high_priority_ratio,
+            middle_priority_ratio,
+            low_priority_ratio);
+    }
+
+    size_t
+    Acquire(size_t bytes,
+            size_t alignment_bytes = 1,
+            Priority priority = Priority::MIDDLE) {
+        // if priority ratio is <= 0, no rate limit is applied, return the original bytes
+        if (priority_ratio_[static_cast<int>(priority)] <= 0) {
+            return bytes;
+        }
+        // the tokens go to the waiting HIGH priority callers first
+        if (priority != Priority::HIGH && waiting_high_.load() > 0) {
+            return 0;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        // recheck the amplification ratio after taking the lock
+        auto amplification_ratio = priority_ratio_[static_cast<int>(priority)];
+        if (amplification_ratio <= 0) {
+            return bytes;
+        }
+
+        // calculate the available bytes by delta periods
+        std::chrono::steady_clock::time_point now =
+            std::chrono::steady_clock::now();
+        // steady_clock is monotonic, so the time delta is always >= 0
+        auto delta_periods = static_cast<int>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                now - last_refill_time_)
+                .count() /
+            refill_period_us_);
+        // early return if the time delta is less than the refill period and
+        // the available bytes is less than the alignment bytes
+        if (delta_periods == 0 && available_bytes_ < alignment_bytes) {
+            return 0;
+        }
+        if (delta_periods > expire_periods_) {
+            available_bytes_ += expire_periods_ * refill_bytes_per_period_;
+        } else {
+            available_bytes_ += delta_periods * refill_bytes_per_period_;
+        }
+        // keep the available bytes in the range of [0, refill_bytes_per_period_ * expire_periods_]
+        available_bytes_ = std::min(
+            available_bytes_,
+            static_cast<size_t>(refill_bytes_per_period_ * expire_periods_));
+
+        // calculate the allowed bytes with amplification ratio
+        auto ret = std::min(bytes, available_bytes_ * amplification_ratio);
+        // align the allowed bytes to the alignment bytes
+        ret = (ret / alignment_bytes) * alignment_bytes;
+        // update available_bytes_ by removing the amplification ratio, the updated value is always >= 0
+        available_bytes_ -= ret / amplification_ratio;
+
+        // update the last refill time only if delta_periods > 0
+        if (delta_periods > 0) {
+            last_refill_time_ = now;
+        }
+
+        return ret;
+    }
+
+    // Acquires up to bytes, sleeping a period at a time while none is
+    // available, and records the time waited. Once the waits in state exceed
+    // MAX_EMPTY_LOOPS or MAX_WAIT_US all the bytes are granted and the state
+    // starts over. before_wait runs before every sleep.
+    size_t
+    AcquireOrWait(size_t bytes,
+                  size_t alignment_bytes,
+                  Priority priority,
+                  WaitState& state,
+                  const std::function<void()>& before_wait = nullptr);
+
+    size_t
+    GetRateLimitPeriod() const {
+        return refill_period_us_;
+    }
+
+    size_t
+    GetBytesPerPeriod() const {
+        return refill_bytes_per_period_;
+    }
+
+    void
+    Reset() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_bytes_ = refill_bytes_per_period_;
+        last_refill_time_ = std::chrono::steady_clock::now();
+    }
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter&
+    operator=(const RateLimiter&) = delete;
+
+    ~RateLimiter() = default;
+
+ private:
+    const std::string name_;
+    prometheus::Histogram* const wait_duration_;
+
+    // Set the default rate limit to a valid, reasonable value.
+    // These values should always be overridden by the yaml configuration, but
+    // if not, the default can still serve as a reasonable "no-limit" fallback.
+    int64_t refill_period_us_ = 100000;                       // 100ms
+    int64_t refill_bytes_per_period_ = 1024ll * 1024 * 1024;  // 1GB
+    int32_t expire_periods_ = 10;                             // 10 periods
+    std::chrono::steady_clock::time_point last_refill_time_ =
+        std::chrono::steady_clock::now();
+    size_t available_bytes_ = 0;
+    std::array<int32_t, 3> priority_ratio_ = {-1, -1, -1};
+    // the HIGH priority callers inside AcquireOrWait without their bytes
+    std::atomic<int32_t> waiting_high_{0};
+    std::mutex mutex_;
+};
+
+// limits the local disk writes of FileWriter
+class WriteRateLimiter : public RateLimiter {
+ public:
+    static WriteRateLimiter&
+    GetInstance();
+
+ private:
+    WriteRateLimiter();
+};
+
+// limits the local disk reads of ReadFile
+class ReadRateLimiter : public RateLimiter {
+ public:
+    static ReadRateLimiter&
+    GetInstance();
+
+ private:
+    ReadRateLimiter();
+};
+
+}  // namespace io
+
+}  // namespace milvus::storage
@@ -19,6 +19,8 @@
 #include <memory>
 #include <shared_mutex>
 
+#include "storage/CachedChunkManager.h"
+#include "storage/HedgedChunkManager.h"
 #include "storage/Util.h"
 
 namespace milvus::storage {
@@ -46,6 +48,34 @@ class RemoteChunkManagerSingleton {
         }
     }
 
+    // Puts a local disk cache of 'capacity' bytes at 'cache_path' in front
+    // of the remote chunk manager, must be called after Init.
+    void
+    EnableObjectCache(const std::string& cache_path, uint64_t capacity) {
+        AssertInfo(rcm_ != nullptr,
+                   "remote chunk manager is not initialized");
+        if (std::dynamic_pointer_cast<CachedChunkManager>(rcm_) != nullptr) {
+            return;
+        }
+        rcm_ = std::make_shared<CachedChunkManager>(rcm_, cache_path, capacity);
+    }
+
+    // Hedges and retries the reads of the remote chunk manager, must be
+    // called after Init and before EnableObjectCache, so that only the cache
+    // misses are hedged.
+    void
+    EnableHedgedReads(const HedgedReadConfig& config) {
+        AssertInfo(rcm_ != nullptr,
+                   "remote chunk manager is not initialized");
+        AssertInfo(std::dynamic_pointer_cast<CachedChunkManager>(rcm_) ==
+                       nullptr,
+                   "hedged reads must be enabled before the object cache");
+        if (std::dynamic_pointer_cast<HedgedChunkManager>(rcm_) != nullptr) {
+            return;
+        }
+        rcm_ = std::make_shared<HedgedChunkManager>(rcm_, config);
+    }
+
     void
     Release() {
     }
@@ -1,5 +1,8 @@
 #include <unistd.h>
+#include <algorithm>
+#include <cstring>
 #include "RemoteInputStream.h"
+#include "common/Common.h"
 #include "common/Consts.h"
 #include "common/EasyAssert.h"
 
@@ -7,17 +10,106 @@ namespace milvus::storage {
 
 RemoteInputStream::RemoteInputStream(
     std::shared_ptr<arrow::io::RandomAccessFile>&& remote_file)
-    : remote_file_(std::move(remote_file)) {
+    : RemoteInputStream(
+          std::move(remote_file),
+          std::max<int64_t>(REMOTE_READ_RANGE_SIZE.load(), 1),
+          std::max<int64_t>(REMOTE_READ_AHEAD_RANGES.load(), 1)) {
+}
+
+RemoteInputStream::RemoteInputStream(
+    std::shared_ptr<arrow::io::RandomAccessFile>&& remote_file,
+    size_t range_size,
+    size_t max_ahead_ranges)
+    : remote_file_(std::move(remote_file)),
+      range_size_(range_size),
+      max_ahead_ranges_(max_ahead_ranges) {
+    AssertInfo(range_size_ > 0 && max_ahead_ranges_ > 0,
+               "invalid read ahead, range size: {}, max ranges: {}",
+               range_size_,
+               max_ahead_ranges_);
     auto status = remote_file_->GetSize();
     AssertInfo(status.ok(), "Failed to get size of remote file");
     file_size_ = static_cast<size_t>(status.ValueOrDie());
 }
 
+void
+RemoteInputStream::FillWindow() {
+    if (ranges_.empty()) {
+        next_range_offset_ = position_;
+    }
+    while (ranges_.size() < window_ && next_range_offset_ < file_size_) {
+        auto size = std::min(range_size_, file_size_ - next_range_offset_);
+        ranges_.push_back(
+            {next_range_offset_,
+             size,
+             remote_file_->ReadAsync(static_cast<int64_t>(next_range_offset_),
+                                     static_cast<int64_t>(size))});
+        next_range_offset_ += size;
+    }
+}
+
+void
+RemoteInputStream::ResetWindow() {
+    // the ranges in flight keep the file alive and are dropped on completion
+    ranges_.clear();
+    next_range_offset_ = position_;
+    window_ = 1;
+    ready_ranges_ = 0;
+}
+
+size_t
+RemoteInputStream::Consume(
+    size_t size, const std::function<void(const uint8_t*, size_t)>& sink) {
+    size = position_ >= file_size_ ? 0 : std::min(size, file_size_ - position_);
+    size_t done = 0;
+    while (done < size) {
+        FillWindow();
+        auto& range = ranges_.front();
+        if (!range.visited) {
+            range.visited = true;
+            if (!range.data.is_finished()) {
+                // the reader is faster than the fetches, fetch more at once
+                window_ = std::min(window_ * 2, max_ahead_ranges_);
+                ready_ranges_ = 0;
+                FillWindow();
+            } else if (++ready_ranges_ >= kShrinkAfterReadyRanges &&
+                       window_ > 1) {
+                window_--;
+                ready_ranges_ = 0;
+            }
+        }
+        const auto& result = range.data.result();
+        AssertInfo(result.ok(),
+                   "Failed to read from input stream: {}",
+                   result.status().ToString());
+        const auto& buffer = result.ValueOrDie();
+        auto begin = position_ - range.offset;
+        AssertInfo(static_cast<size_t>(buffer->size()) == range.size,
+                   "Failed to read from input stream, expect {} bytes at {}, "
+                   "got {}",
+                   range.size,
+                   range.offset,
+                   buffer->size());
+        auto n = std::min(size - done, range.size - begin);
+        sink(buffer->data() + begin, n);
+        position_ += n;
+        done += n;
+        if (position_ == range.offset + range.size) {
+            ranges_.pop_front();
+        }
+    }
+    // keep fetching while the caller works on the data
+    FillWindow();
+    return done;
+}
+
 size_t
 RemoteInputStream::Read(void* data, size_t size) {
-    auto status = remote_file_->Read(size, data);
-    AssertInfo(status.ok(), "Failed to read from input stream");
-    return static_cast<size_t>(status.ValueOrDie());
+    auto dst = static_cast<uint8_t*>(data);
+    return Consume(size, [&dst](const uint8_t* src, size_t n) {
+        std::memcpy(dst, src, n);
+        dst += n;
+    });
 }
 
 size_t
@@ -29,29 +121,18 @@ RemoteInputStream::ReadAt(void* data, size_t offset, size_t size) {
 
 size_t
 RemoteInputStream::Read(int fd, size_t size) {
-    size_t read_batch_size =
-        std::min(size, static_cast<size_t>(DEFAULT_INDEX_FILE_SLICE_SIZE));
-    size_t rest_size = size;
-    std::vector<uint8_t> data(read_batch_size);
-
-    while (rest_size > 0) {
-        size_t read_size = std::min(rest_size, read_batch_size);
-        auto status = remote_file_->Read(read_size, data.data());
-        AssertInfo(status.ok(), "Failed to read from input stream");
-        ssize_t ret = ::write(fd, data.data(), read_size);
-        AssertInfo(ret == static_cast<ssize_t>(read_size),
-                   "Failed to write to file");
-        rest_size -= read_size;
-    }
+    auto read_size = Consume(size, [fd](const uint8_t* src, size_t n) {
+        ssize_t ret = ::write(fd, src, n);
+        AssertInfo(ret == static_cast<ssize_t>(n), "Failed to write to file");
+    });
+    AssertInfo(read_size == size, "Failed to read from input stream");
     ::fsync(fd);
     return size;
 }
 
 size_t
 RemoteInputStream::Tell() const {
-    auto status = remote_file_->Tell();
-    AssertInfo(status.ok(), "Failed to tell input stream");
-    return static_cast<size_t>(status.ValueOrDie());
+    return position_;
 }
 
 bool
@@ -61,8 +142,22 @@ RemoteInputStream::Eof() const {
 
 bool
 RemoteInputStream::Seek(int64_t offset) {
-    auto status = remote_file_->Seek(offset);
-    return status.ok();
+    if (offset < 0 || static_cast<size_t>(offset) > file_size_) {
+        return false;
+    }
+    auto target = static_cast<size_t>(offset);
+    if (!ranges_.empty() && target >= ranges_.front().offset &&
+        target < next_range_offset_) {
+        // skipping ahead within the fetched ranges keeps the read-ahead
+        while (target >= ranges_.front().offset + ranges_.front().size) {
+            ranges_.pop_front();
+        }
+        position_ = target;
+        return true;
+    }
+    position_ = target;
+    ResetWindow();
+    return true;
 }
 
 size_t
@@ -70,4 +165,4 @@ RemoteInputStream::Size() const {
     return file_size_;
 }
 
-}  // namespace milvus::storage
\ No newline at end of file
+}  // namespace milvus::storage
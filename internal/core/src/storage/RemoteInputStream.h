@@ -11,16 +11,37 @@
 
 #pragma once
 
+#include <deque>
+#include <functional>
+#include <memory>
+
+#include "arrow/buffer.h"
+#include "arrow/io/interfaces.h"
+#include "arrow/util/future.h"
 #include "filemanager/InputStream.h"
 #include "milvus-storage/filesystem/fs.h"
 
 namespace milvus::storage {
 
+/**
+ * RemoteInputStream reads a remote object as a sequential stream. Sequential
+ * reads are served from ranges of the object that are fetched ahead of the
+ * reader with concurrent range reads on the arrow io thread pool, and are
+ * consumed in order. The read-ahead window starts at one range and doubles
+ * every time the reader has to wait for a range, up to max_ahead_ranges. It
+ * shrinks again while the reader keeps finding its ranges fetched already, and
+ * falls back to one range after a Seek.
+ */
 class RemoteInputStream : public milvus::InputStream {
  public:
     explicit RemoteInputStream(
         std::shared_ptr<arrow::io::RandomAccessFile>&& remote_file);
 
+    RemoteInputStream(
+        std::shared_ptr<arrow::io::RandomAccessFile>&& remote_file,
+        size_t range_size,
+        size_t max_ahead_ranges);
+
     ~RemoteInputStream() override = default;
 
     size_t
@@ -44,9 +65,47 @@ class RemoteInputStream : public milvus::InputStream {
     bool
     Seek(int64_t offset) override;
 
+    size_t
+    ReadAheadWindow() const {
+        return window_;
+    }
+
  private:
+    struct Range {
+        size_t offset;
+        size_t size;
+        arrow::Future<std::shared_ptr<arrow::Buffer>> data;
+        // whether the reader got to the range, the window adapts only once
+        bool visited{false};
+    };
+
+    // Passes up to 'size' bytes from the current position to 'sink' in
+    // order, in pieces that end at range boundaries.
+    size_t
+    Consume(size_t size,
+            const std::function<void(const uint8_t*, size_t)>& sink);
+
+    // Issues range reads until the window is full or the file is exhausted.
+    void
+    FillWindow();
+
+    void
+    ResetWindow();
+
+    // consecutive ranges found fetched before the window may shrink
+    static constexpr int kShrinkAfterReadyRanges = 4;
+
     size_t file_size_;
     std::shared_ptr<arrow::io::RandomAccessFile> remote_file_;
+
+    const size_t range_size_;
+    const size_t max_ahead_ranges_;
+    size_t position_{0};
+    // ranges in flight or fetched, in file order starting at position_
+    std::deque<Range> ranges_;
+    size_t next_range_offset_{0};
+    size_t window_{1};
+    int ready_ranges_{0};
 };
 
-}  // namespace milvus::storage
\ No newline at end of file
+}  // namespace milvus::storage
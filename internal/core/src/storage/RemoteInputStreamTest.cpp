@@ -0,0 +1,125 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+#include <vector>
+
+#include "arrow/io/memory.h"
+#include "storage/RemoteInputStream.h"
+
+using namespace milvus::storage;
+
+namespace {
+
+std::vector<uint8_t>
+Sequence(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return data;
+}
+
+std::shared_ptr<arrow::io::RandomAccessFile>
+MakeFile(const std::vector<uint8_t>& data) {
+    return std::make_shared<arrow::io::BufferReader>(
+        arrow::Buffer::Wrap(data.data(), data.size()));
+}
+
+}  // namespace
+
+TEST(RemoteInputStreamTest, SequentialReadsCrossRanges) {
+    auto data = Sequence(10000);
+    RemoteInputStream stream(MakeFile(data), 1024, 4);
+    ASSERT_EQ(stream.Size(), data.size());
+
+    std::vector<uint8_t> result;
+    // read sizes below, at and above the range size
+    for (size_t size : {1, 100, 1024, 3000, 7}) {
+        std::vector<uint8_t> buf(size);
+        ASSERT_EQ(stream.Read(buf.data(), size), size);
+        result.insert(result.end(), buf.begin(), buf.end());
+        EXPECT_EQ(stream.Tell(), result.size());
+        EXPECT_GE(stream.ReadAheadWindow(), 1);
+        EXPECT_LE(stream.ReadAheadWindow(), 4);
+    }
+    std::vector<uint8_t> rest(data.size());
+    auto left = data.size() - result.size();
+    ASSERT_EQ(stream.Read(rest.data(), rest.size()), left);
+    result.insert(result.end(), rest.begin(), rest.begin() + left);
+    EXPECT_TRUE(stream.Eof());
+    EXPECT_EQ(result, data);
+    EXPECT_EQ(stream.Read(rest.data(), 1), 0);
+}
+
+TEST(RemoteInputStreamTest, Seek) {
+    auto data = Sequence(10000);
+    RemoteInputStream stream(MakeFile(data), 1024, 4);
+    uint8_t buf[16];
+
+    ASSERT_EQ(stream.Read(buf, 10), 10);
+    // past the fetched ranges
+    ASSERT_TRUE(stream.Seek(2000));
+    ASSERT_EQ(stream.Read(buf, 16), 16);
+    EXPECT_TRUE(std::equal(buf, buf + 16, data.begin() + 2000));
+    // backwards within the current range
+    ASSERT_TRUE(stream.Seek(2001));
+    ASSERT_EQ(stream.Read(buf, 16), 16);
+    EXPECT_TRUE(std::equal(buf, buf + 16, data.begin() + 2001));
+    // before the fetched ranges
+    ASSERT_TRUE(stream.Seek(500));
+    EXPECT_EQ(stream.ReadAheadWindow(), 1);
+    ASSERT_EQ(stream.Read(buf, 16), 16);
+    EXPECT_TRUE(std::equal(buf, buf + 16, data.begin() + 500));
+    ASSERT_TRUE(stream.Seek(9990));
+    ASSERT_EQ(stream.Read(buf, 16), 10);
+    EXPECT_TRUE(std::equal(buf, buf + 10, data.begin() + 9990));
+
+    EXPECT_FALSE(stream.Seek(-1));
+    EXPECT_FALSE(stream.Seek(data.size() + 1));
+    EXPECT_TRUE(stream.Seek(data.size()));
+    EXPECT_TRUE(stream.Eof());
+}
+
+TEST(RemoteInputStreamTest, ReadAt) {
+    auto data = Sequence(4096);
+    RemoteInputStream stream(MakeFile(data), 1024, 4);
+    uint8_t buf[100];
+    ASSERT_EQ(stream.ReadAt(buf, 3000, 100), 100);
+    EXPECT_TRUE(std::equal(buf, buf + 100, data.begin() + 3000));
+    // random reads leave the stream position alone
+    EXPECT_EQ(stream.Tell(), 0);
+}
+
+TEST(RemoteInputStreamTest, ReadToFile) {
+    auto data = Sequence(5000);
+    RemoteInputStream stream(MakeFile(data), 1024, 2);
+    auto path = (std::filesystem::temp_directory_path() /
+                 "remote_input_stream_test")
+                    .string();
+    int fd = open(path.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+    ASSERT_NE(fd, -1);
+    ASSERT_EQ(stream.Read(fd, 3000), 3000);
+    ASSERT_EQ(stream.Read(fd, 2000), 2000);
+    EXPECT_ANY_THROW(stream.Read(fd, 1));
+    close(fd);
+
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)),
+                                 std::istreambuf_iterator<char>());
+    EXPECT_EQ(content, data);
+    std::filesystem::remove(path);
+}
@@ -10,11 +10,15 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include "storage/StorageV2FSCache.h"
+#include <algorithm>
+#include <chrono>
 #include <future>
 #include <mutex>
 #include <shared_mutex>
+#include <vector>
 #include "milvus-storage/filesystem/fs.h"
 #include "log/Log.h"
+#include "monitor/Monitor.h"
 
 namespace milvus::storage {
 
@@ -24,12 +28,66 @@ StorageV2FSCache::Instance() {
     return instance;
 }
 
+std::atomic<int64_t> StorageV2FSCache::warmup_connections_{0};
+
+void
+StorageV2FSCache::SetWarmupConnections(int64_t connections) {
+    warmup_connections_.store(std::max<int64_t>(connections, 0));
+}
+
+int64_t
+StorageV2FSCache::GetWarmupConnections() {
+    return warmup_connections_.load();
+}
+
+void
+StorageV2FSCache::Warmup(const milvus_storage::ArrowFileSystemPtr& fs,
+                         const Key& key) {
+    auto connections = std::min<int64_t>(warmup_connections_.load(),
+                                         key.max_connections);
+    if (connections <= 0 || key.storage_type == "local") {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<void>> futures;
+    futures.reserve(connections);
+    try {
+        for (int64_t i = 0; i < connections; ++i) {
+            futures.push_back(std::async(std::launch::async, [&fs, &key]() {
+                // whether the root exists does not matter, the request only
+                // has to set up a connection
+                auto info = fs->GetFileInfo(key.root_path);
+                if (!info.ok()) {
+                    LOG_DEBUG("filesystem warmup request failed, error: {}",
+                              info.status().ToString());
+                }
+            }));
+        }
+    } catch (const std::exception& e) {
+        // a cold pool is still usable
+        LOG_WARN("filesystem warmup stopped early, error: {}", e.what());
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    auto elapsed = std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    monitor::internal_storage_fs_cache_wait_warmup.Observe(elapsed);
+    LOG_INFO("warmed up {} connections to {}/{} in {}ms",
+             connections,
+             key.address,
+             key.bucket_name,
+             elapsed);
+}
+
 milvus_storage::ArrowFileSystemPtr
 StorageV2FSCache::Get(const Key& key) {
     {
         std::shared_lock lck(mutex_);
         auto it = concurrent_map_.find(key);
         if (it != concurrent_map_.end()) {
+            monitor::internal_storage_fs_cache_count_hit.Increment();
             return it->second.second.get();
         }
     }
@@ -47,6 +105,7 @@ StorageV2FSCache::Get(const Key& key) {
         // double check: avoid iter has been erased by other thread
         auto it = concurrent_map_.find(key);
         if (it != concurrent_map_.end()) {
+            monitor::internal_storage_fs_cache_count_hit.Increment();
             return it->second.second.get();
         }
         lck.unlock();
@@ -54,6 +113,8 @@ StorageV2FSCache::Get(const Key& key) {
         return Get(key);
     }
 
+    monitor::internal_storage_fs_cache_count_miss.Increment();
+    auto start = std::chrono::steady_clock::now();
     try {
         milvus_storage::ArrowFileSystemConfig conf;
         conf.address = std::string(key.address);
@@ -87,6 +148,12 @@ StorageV2FSCache::Get(const Key& key) {
         }
 
         auto fs = result.ValueOrDie();
+        // the callers waiting on the future get the warm filesystem too
+        Warmup(fs, key);
+        monitor::internal_storage_fs_cache_wait_create.Observe(
+            std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start)
+                .count());
         iter->second.first.set_value(fs);
         return fs;
     } catch (...) {
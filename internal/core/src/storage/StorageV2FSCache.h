@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <future>
 #include <shared_mutex>
 
@@ -120,7 +121,23 @@ class StorageV2FSCache {
 
     virtual ~StorageV2FSCache() = default;
 
+    // Every new remote filesystem opens this many connections of its pool up
+    // front, up to its max_connections, so the first burst of requests does
+    // not wait for connection setup. 0 disables the warmup.
+    static void
+    SetWarmupConnections(int64_t connections);
+
+    static int64_t
+    GetWarmupConnections();
+
  private:
+    // issues concurrent lightweight requests that leave their connections
+    // in the pool of fs
+    static void
+    Warmup(const milvus_storage::ArrowFileSystemPtr& fs, const Key& key);
+
+    static std::atomic<int64_t> warmup_connections_;
+
     std::shared_mutex mutex_;
     tbb::concurrent_unordered_map<Key, Value, KeyHasher> concurrent_map_;
 };
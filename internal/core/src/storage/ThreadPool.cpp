@@ -15,6 +15,9 @@
 // limitations under the License.
 
 #include "ThreadPool.h"
+
+#include <algorithm>
+
 #include "log/Log.h"
 
 namespace milvus {
@@ -27,6 +30,8 @@ std::atomic<float> MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT(
     DEFAULT_MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT);
 std::atomic<float> LOW_PRIORITY_THREAD_CORE_COEFFICIENT(
     DEFAULT_LOW_PRIORITY_THREAD_CORE_COEFFICIENT);
+std::atomic<bool> THREAD_POOL_WORK_STEALING_ENABLED(
+    DEFAULT_THREAD_POOL_WORK_STEALING_ENABLED);
 
 void
 SetHighPriorityThreadCoreCoefficient(const float coefficient) {
@@ -49,6 +54,13 @@ SetLowPriorityThreadCoreCoefficient(const float coefficient) {
              LOW_PRIORITY_THREAD_CORE_COEFFICIENT.load());
 }
 
+void
+SetThreadPoolWorkStealingEnable(const bool enable) {
+    THREAD_POOL_WORK_STEALING_ENABLED.store(enable);
+    LOG_INFO("set thread pool work stealing enabled: {}",
+             THREAD_POOL_WORK_STEALING_ENABLED.load());
+}
+
 void
 InitCpuNum(const int num) {
     CPU_NUM = num;
@@ -68,6 +80,7 @@ ThreadPool::Init() {
 void
 ThreadPool::ShutDown() {
     LOG_INFO("Start shutting down {}", name_);
+    DetachStealPeers();
     {
         std::lock_guard<std::mutex> lock(mutex_);
         shutdown_ = true;
@@ -102,12 +115,16 @@ ThreadPool::Worker() {
     std::function<void()> func;
     bool dequeue;
     SetThreadName(name_);
+    // bound once, the tasks a worker steals from other pools allocate from
+    // the arena of its own pool
+    monitor::BindThreadToArena(arena_);
     while (!shutdown_) {
         std::unique_lock<std::mutex> lock(mutex_);
         idle_threads_size_++;
         auto is_timeout = !condition_lock_.wait_for(
             lock, std::chrono::seconds(WAIT_SECONDS), [this]() {
-                return shutdown_ || !work_queue_.empty();
+                return shutdown_ || !work_queue_.empty() ||
+                       HasStealableTask();
             });
         idle_threads_size_--;
         if (work_queue_.empty()) {
@@ -128,10 +145,136 @@ ThreadPool::Worker() {
         }
         dequeue = work_queue_.dequeue(func);
         lock.unlock();
+        if (!dequeue) {
+            dequeue = TrySteal(func);
+        }
         if (dequeue) {
             func();
             func = nullptr;
         }
     }
 }
+
+void
+ThreadPool::AddStealSource(ThreadPool* source, int weight) {
+    if (source == this || source == nullptr) {
+        return;
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(steal_mutex_);
+        steal_sources_.push_back({source, std::max(1, weight), 0});
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(source->steal_mutex_);
+        source->thieves_.push_back(this);
+    }
+}
+
+void
+ThreadPool::DetachStealPeers() {
+    std::vector<StealSource> sources;
+    std::vector<ThreadPool*> thieves;
+    {
+        std::unique_lock<std::shared_mutex> lock(steal_mutex_);
+        sources.swap(steal_sources_);
+        thieves.swap(thieves_);
+    }
+    for (auto& source : sources) {
+        std::unique_lock<std::shared_mutex> lock(source.pool->steal_mutex_);
+        auto& list = source.pool->thieves_;
+        list.erase(std::remove(list.begin(), list.end(), this), list.end());
+    }
+    // a thief holds its steal_mutex_ while dequeuing from our queue, so
+    // once it is released no thief touches this pool anymore
+    for (auto thief : thieves) {
+        std::unique_lock<std::shared_mutex> lock(thief->steal_mutex_);
+        auto& list = thief->steal_sources_;
+        list.erase(std::remove_if(list.begin(),
+                                  list.end(),
+                                  [this](const auto& source) {
+                                      return source.pool == this;
+                                  }),
+                   list.end());
+    }
+}
+
+bool
+ThreadPool::HasStealableTask() {
+    if (!THREAD_POOL_WORK_STEALING_ENABLED.load()) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(steal_mutex_);
+    for (auto& source : steal_sources_) {
+        if (!source.pool->work_queue_.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+ThreadPool::TrySteal(std::function<void()>& func) {
+    if (!THREAD_POOL_WORK_STEALING_ENABLED.load()) {
+        return false;
+    }
+    std::shared_lock<std::shared_mutex> lock(steal_mutex_);
+    std::lock_guard<std::mutex> credit_lock(steal_credit_mutex_);
+    std::vector<StealSource*> backlogs;
+    for (auto& source : steal_sources_) {
+        if (!source.pool->work_queue_.empty()) {
+            backlogs.push_back(&source);
+        }
+    }
+    // each steal credits the sources with a backlog by their weight and
+    // takes from the one with the most credit, which then gives up the
+    // weights of all of them, so the steals follow the ratio of the weights
+    while (!backlogs.empty()) {
+        int64_t total_weight = 0;
+        size_t picked = 0;
+        for (size_t i = 0; i < backlogs.size(); ++i) {
+            total_weight += backlogs[i]->weight;
+            if (backlogs[i]->credit + backlogs[i]->weight >
+                backlogs[picked]->credit + backlogs[picked]->weight) {
+                picked = i;
+            }
+        }
+        if (backlogs[picked]->pool->work_queue_.dequeue(func)) {
+            for (auto source : backlogs) {
+                source->credit += source->weight;
+            }
+            backlogs[picked]->credit -= total_weight;
+            stolen_tasks_.fetch_add(1);
+            return true;
+        }
+        // drained by its own workers meanwhile
+        backlogs.erase(backlogs.begin() + picked);
+    }
+    return false;
+}
+
+bool
+ThreadPool::NotifyIdleWorker() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_ || idle_threads_size_ == 0) {
+        return false;
+    }
+    condition_lock_.notify_one();
+    return true;
+}
+
+void
+ThreadPool::NotifyThieves() {
+    if (!THREAD_POOL_WORK_STEALING_ENABLED.load()) {
+        return;
+    }
+    // holding steal_mutex_ keeps the thieves alive, they detach under the
+    // exclusive lock before being destroyed
+    std::shared_lock<std::shared_mutex> lock(steal_mutex_);
+    for (auto thief : thieves_) {
+        if (thief->NotifyIdleWorker()) {
+            return;
+        }
+    }
+}
+
 };  // namespace milvus
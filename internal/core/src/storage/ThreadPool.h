@@ -21,6 +21,7 @@
 #include <mutex>
 #include <memory>
 #include <queue>
+#include <shared_mutex>
 #include <thread>
 #include <vector>
 #include <utility>
@@ -28,6 +29,7 @@
 
 #include "SafeQueue.h"
 #include "log/Log.h"
+#include "monitor/jemalloc_arena.h"
 
 namespace milvus {
 
@@ -36,10 +38,12 @@ const int DEFAULT_CPU_NUM = 1;
 const int64_t DEFAULT_HIGH_PRIORITY_THREAD_CORE_COEFFICIENT = 10;
 const int64_t DEFAULT_MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT = 5;
 const int64_t DEFAULT_LOW_PRIORITY_THREAD_CORE_COEFFICIENT = 1;
+const bool DEFAULT_THREAD_POOL_WORK_STEALING_ENABLED = false;
 
 extern std::atomic<float> HIGH_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern std::atomic<float> MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern std::atomic<float> LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
+extern std::atomic<bool> THREAD_POOL_WORK_STEALING_ENABLED;
 
 extern int CPU_NUM;
 
@@ -52,13 +56,20 @@ SetMiddlePriorityThreadCoreCoefficient(const float coefficient);
 void
 SetLowPriorityThreadCoreCoefficient(const float coefficient);
 
+void
+SetThreadPoolWorkStealingEnable(const bool enable);
+
 void
 InitCpuNum(const int core);
 
 class ThreadPool {
  public:
-    explicit ThreadPool(const float thread_core_coefficient, std::string name)
-        : shutdown_(false), name_(std::move(name)) {
+    // the allocations of the workers go to the jemalloc arena of arena
+    explicit ThreadPool(
+        const float thread_core_coefficient,
+        std::string name,
+        monitor::JemallocArena arena = monitor::JemallocArena::kLoad)
+        : shutdown_(false), name_(std::move(name)), arena_(arena) {
         idle_threads_size_ = 0;
         current_threads_size_ = 0;
         min_threads_size_ = 1;
@@ -118,16 +129,26 @@ class ThreadPool {
 
         work_queue_.enqueue(wrap_func);
 
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        if (idle_threads_size_ > 0) {
-            condition_lock_.notify_one();
-        } else if (current_threads_size_ < max_threads_size_.load()) {
-            // Dynamic increase thread number
-            std::thread t(&ThreadPool::Worker, this);
-            assert(threads_.find(t.get_id()) == threads_.end());
-            threads_[t.get_id()] = std::move(t);
-            current_threads_size_++;
+        bool saturated = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (idle_threads_size_ > 0) {
+                condition_lock_.notify_one();
+            } else if (current_threads_size_ < max_threads_size_.load()) {
+                // Dynamic increase thread number
+                std::thread t(&ThreadPool::Worker, this);
+                assert(threads_.find(t.get_id()) == threads_.end());
+                threads_[t.get_id()] = std::move(t);
+                current_threads_size_++;
+            } else {
+                saturated = true;
+            }
+        }
+        if (saturated) {
+            // all workers are busy, let an idle worker of another pool
+            // pick the task up
+            NotifyThieves();
         }
 
         return task_ptr->get_future();
@@ -139,6 +160,23 @@ class ThreadPool {
     void
     FinishThreads();
 
+    // Allow idle workers of this pool to run tasks queued in source. While
+    // several sources have a backlog, the tasks stolen from each of them
+    // follow the ratio of their weights, a smooth weighted round robin, so
+    // higher priority backlogs drain faster without starving the others.
+    void
+    AddStealSource(ThreadPool* source, int weight);
+
+    // Detach this pool from every pool it steals from or is stolen from,
+    // must be called before the pool is destroyed.
+    void
+    DetachStealPeers();
+
+    size_t
+    GetStolenTaskNum() const {
+        return stolen_tasks_.load();
+    }
+
     void
     Resize(int new_size) {
         //no need to hold mutex here as we don't require
@@ -150,6 +188,20 @@ class ThreadPool {
         max_threads_size_.store(new_size);
     }
 
+ private:
+    bool
+    HasStealableTask();
+
+    bool
+    TrySteal(std::function<void()>& func);
+
+    void
+    NotifyThieves();
+
+    // wake up one idle worker, returns false if there is none
+    bool
+    NotifyIdleWorker();
+
  public:
     int min_threads_size_;
     int idle_threads_size_;
@@ -163,6 +215,23 @@ class ThreadPool {
     std::mutex mutex_;
     std::condition_variable condition_lock_;
     std::string name_;
+
+ private:
+    monitor::JemallocArena arena_;
+    // guards steal_sources_ and thieves_, only queue locks and the mutex_
+    // of a thief are taken while holding it
+    std::shared_mutex steal_mutex_;
+    struct StealSource {
+        ThreadPool* pool;
+        int weight;
+        // the credit of the source in the weighted round robin
+        int64_t credit;
+    };
+    std::vector<StealSource> steal_sources_;
+    std::vector<ThreadPool*> thieves_;
+    // guards the credits of steal_sources_, taken under steal_mutex_
+    std::mutex steal_credit_mutex_;
+    std::atomic<size_t> stolen_tasks_{0};
 };
 
 }  // namespace milvus
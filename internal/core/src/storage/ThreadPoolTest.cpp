@@ -16,6 +16,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "storage/ThreadPool.h"
 
 namespace milvus {
@@ -71,4 +76,109 @@ TEST_F(ThreadPoolTest, ResizeAboveMaximum) {
     EXPECT_EQ(pool.GetMaxThreadNum(), 16);
 }
 
+TEST_F(ThreadPoolTest, IdleWorkerStealsFromBusyPool) {
+    ThreadPool busy_pool(1.0, "busy_pool");
+    ThreadPool idle_pool(1.0, "idle_pool");
+    busy_pool.Resize(1);
+    idle_pool.AddStealSource(&busy_pool, 1);
+    SetThreadPoolWorkStealingEnable(true);
+
+    // occupy the only worker of busy_pool until the second task ran
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker = busy_pool.Submit([released]() { released.wait(); });
+
+    auto stolen = busy_pool.Submit([]() { return 42; });
+    ASSERT_EQ(stolen.wait_for(std::chrono::seconds(10)),
+              std::future_status::ready);
+    EXPECT_EQ(stolen.get(), 42);
+    EXPECT_EQ(idle_pool.GetStolenTaskNum(), 1);
+
+    release.set_value();
+    blocker.get();
+    idle_pool.DetachStealPeers();
+    SetThreadPoolWorkStealingEnable(DEFAULT_THREAD_POOL_WORK_STEALING_ENABLED);
+}
+
+TEST_F(ThreadPoolTest, WorkStealingDisabled) {
+    ThreadPool busy_pool(1.0, "busy_pool");
+    ThreadPool idle_pool(1.0, "idle_pool");
+    busy_pool.Resize(1);
+    idle_pool.AddStealSource(&busy_pool, 1);
+    SetThreadPoolWorkStealingEnable(false);
+
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    auto blocker = busy_pool.Submit([released]() { released.wait(); });
+    auto queued = busy_pool.Submit([]() { return 42; });
+    EXPECT_EQ(queued.wait_for(std::chrono::milliseconds(200)),
+              std::future_status::timeout);
+
+    release.set_value();
+    blocker.get();
+    EXPECT_EQ(queued.get(), 42);
+    EXPECT_EQ(idle_pool.GetStolenTaskNum(), 0);
+    SetThreadPoolWorkStealingEnable(DEFAULT_THREAD_POOL_WORK_STEALING_ENABLED);
+}
+
+TEST_F(ThreadPoolTest, StealsFollowTheWeights) {
+    ThreadPool heavy_pool(1.0, "heavy_pool");
+    ThreadPool light_pool(1.0, "light_pool");
+    ThreadPool idle_pool(1.0, "idle_pool");
+    heavy_pool.Resize(1);
+    light_pool.Resize(1);
+    idle_pool.Resize(1);
+    idle_pool.AddStealSource(&heavy_pool, 2);
+    idle_pool.AddStealSource(&light_pool, 1);
+
+    // occupy the only worker of both sources, then queue their backlogs
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> started{0};
+    auto block = [&started, released]() {
+        ++started;
+        released.wait();
+    };
+    auto heavy_blocker = heavy_pool.Submit(block);
+    auto light_blocker = light_pool.Submit(block);
+    while (started.load() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    constexpr int kTasks = 30;
+    std::mutex order_mutex;
+    std::vector<char> order;
+    std::vector<std::future<void>> stolen;
+    for (int i = 0; i < kTasks; ++i) {
+        for (auto [pool, tag] : {std::pair{&heavy_pool, 'h'},
+                                 std::pair{&light_pool, 'l'}}) {
+            stolen.push_back(pool->Submit([&order_mutex, &order, tag]() {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(tag);
+            }));
+        }
+    }
+    // the single worker of idle_pool steals the backlogs one at a time
+    SetThreadPoolWorkStealingEnable(true);
+    idle_pool.Submit([]() {}).get();
+    for (auto& task : stolen) {
+        ASSERT_EQ(task.wait_for(std::chrono::seconds(10)),
+                  std::future_status::ready);
+    }
+    EXPECT_EQ(idle_pool.GetStolenTaskNum(), 2 * kTasks);
+
+    // while both have a backlog, two heavy tasks run for each light one
+    ASSERT_EQ(order.size(), 2 * kTasks);
+    for (int i = 0; i < kTasks; i += 3) {
+        EXPECT_EQ(std::count(order.begin(), order.begin() + i + 3, 'h'),
+                  2 * (i + 3) / 3);
+    }
+
+    release.set_value();
+    heavy_blocker.get();
+    light_blocker.get();
+    idle_pool.DetachStealPeers();
+    SetThreadPoolWorkStealingEnable(DEFAULT_THREAD_POOL_WORK_STEALING_ENABLED);
+}
+
 }  // namespace milvus
@@ -39,6 +39,11 @@ ThreadPools::GetThreadPool(milvus::ThreadPoolPriority priority) {
         return *(iter->second);
     } else {
         float coefficient = 1.0;
+        // the HIGH pool runs the work of queries, such as filters split
+        // across workers, the others mostly run loads and downloads
+        auto arena = priority == milvus::ThreadPoolPriority::HIGH
+                         ? monitor::JemallocArena::kQuery
+                         : monitor::JemallocArena::kLoad;
         switch (priority) {
             case milvus::ThreadPoolPriority::HIGH:
                 coefficient = HIGH_PRIORITY_THREAD_CORE_COEFFICIENT.load();
@@ -52,8 +57,20 @@ ThreadPools::GetThreadPool(milvus::ThreadPoolPriority priority) {
         }
         std::string name = name_map()[priority];
         auto result = thread_pool_map.emplace(
-            priority, std::make_unique<ThreadPool>(coefficient, name));
-        return *(result.first->second);
+            priority, std::make_unique<ThreadPool>(coefficient, name, arena));
+        auto& pool = *(result.first->second);
+        // idle workers of a pool run tasks queued in the pools of higher
+        // priority only, a worker of a higher priority pool never picks up
+        // a long lower priority task, nor one waiting on its own pool
+        for (auto& [other_priority, other_pool] : thread_pool_map) {
+            if (other_priority < priority) {
+                pool.AddStealSource(other_pool.get(),
+                                    StealWeight(other_priority));
+            } else if (other_priority > priority) {
+                other_pool->AddStealSource(&pool, StealWeight(priority));
+            }
+        }
+        return pool;
     }
 }
 
@@ -62,6 +62,20 @@ class ThreadPools {
     void
     ShutDown();
 
+    // share of the tasks stolen from a pool of this priority, when idle
+    // workers of a lower priority pool steal from several backlogs
+    static int
+    StealWeight(ThreadPoolPriority priority) {
+        switch (priority) {
+            case HIGH:
+                return 4;
+            case MIDDLE:
+                return 2;
+            default:
+                return 1;
+        }
+    }
+
     static std::map<ThreadPoolPriority, std::string>
     name_map() {
         static std::map<ThreadPoolPriority, std::string> name_map = {
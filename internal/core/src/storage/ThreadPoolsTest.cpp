@@ -10,6 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "storage/ThreadPools.h"
 
 TEST(ThreadPool, ThreadNum) {
@@ -26,3 +29,42 @@ TEST(ThreadPool, ThreadNum) {
                                           2.0);
     ASSERT_EQ(threadPool.GetMaxThreadNum(), 2.0 * milvus::CPU_NUM);
 }
+
+TEST(ThreadPool, OnlyLowerPrioritySteals) {
+    auto& high = milvus::ThreadPools::GetThreadPool(milvus::HIGH);
+    auto& middle = milvus::ThreadPools::GetThreadPool(milvus::MIDDLE);
+    auto& low = milvus::ThreadPools::GetThreadPool(milvus::LOW);
+    milvus::SetThreadPoolWorkStealingEnable(true);
+    auto high_stolen = high.GetStolenTaskNum();
+    auto middle_stolen = middle.GetStolenTaskNum();
+
+    // occupy every worker of the low priority pool
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<size_t> started{0};
+    std::vector<std::future<void>> blockers;
+    for (size_t i = 0; i < low.GetMaxThreadNum(); ++i) {
+        blockers.push_back(low.Submit([&started, released]() {
+            ++started;
+            released.wait();
+        }));
+    }
+    while (started.load() < blockers.size()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // idle workers of the higher priority pools leave the backlog alone
+    auto queued = low.Submit([]() { return 42; });
+    EXPECT_EQ(queued.wait_for(std::chrono::milliseconds(200)),
+              std::future_status::timeout);
+    EXPECT_EQ(high.GetStolenTaskNum(), high_stolen);
+    EXPECT_EQ(middle.GetStolenTaskNum(), middle_stolen);
+
+    release.set_value();
+    for (auto& blocker : blockers) {
+        blocker.get();
+    }
+    EXPECT_EQ(queued.get(), 42);
+    milvus::SetThreadPoolWorkStealingEnable(
+        milvus::DEFAULT_THREAD_POOL_WORK_STEALING_ENABLED);
+}
@@ -14,6 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <deque>
 #include <memory>
 
 #include "arrow/array/builder_binary.h"
@@ -977,33 +979,116 @@ EncodeAndUploadIndexSlice(ChunkManager* chunk_manager,
     return std::make_pair(std::move(object_key), serialized_index_size);
 }
 
+static std::unique_ptr<DataCodec>
+DownloadAndDeserialize(ChunkManager* chunk_manager,
+                       bool is_field_data,
+                       const std::string file) {
+    // TODO remove this Size() cost
+    auto fileSize = chunk_manager->Size(file);
+    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize]);
+    chunk_manager->Read(file, buf.get(), fileSize);
+    auto res = DeserializeFileData(buf, fileSize, is_field_data);
+    return res;
+}
+
 std::vector<std::future<std::unique_ptr<DataCodec>>>
 GetObjectData(ChunkManager* remote_chunk_manager,
               const std::vector<std::string>& remote_files,
               milvus::ThreadPoolPriority priority,
-              bool is_field_data) {
+              bool is_field_data,
+              folly::CancellationToken cancel_token) {
     auto& pool = ThreadPools::GetThreadPool(priority);
     std::vector<std::future<std::unique_ptr<DataCodec>>> futures;
     futures.reserve(remote_files.size());
 
-    auto DownloadAndDeserialize = [](ChunkManager* chunk_manager,
-                                     bool is_field_data,
-                                     const std::string file) {
-        // TODO remove this Size() cost
-        auto fileSize = chunk_manager->Size(file);
-        auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[fileSize]);
-        chunk_manager->Read(file, buf.get(), fileSize);
-        auto res = DeserializeFileData(buf, fileSize, is_field_data);
-        return res;
-    };
-
     for (auto& file : remote_files) {
         futures.emplace_back(pool.Submit(
-            DownloadAndDeserialize, remote_chunk_manager, is_field_data, file));
+            [remote_chunk_manager, is_field_data, file, cancel_token]() {
+                if (cancel_token.isCancellationRequested()) {
+                    ThrowInfo(
+                        FollyCancel, "download of {} cancelled", file);
+                }
+                return DownloadAndDeserialize(
+                    remote_chunk_manager, is_field_data, file);
+            }));
     }
     return futures;
 }
 
+std::vector<std::unique_ptr<DataCodec>>
+BatchGetObjectData(ChunkManager* remote_chunk_manager,
+                   const std::vector<std::string>& remote_files,
+                   size_t max_inflight,
+                   milvus::ThreadPoolPriority priority,
+                   bool is_field_data) {
+    AssertInfo(max_inflight > 0, "max inflight files should be positive");
+    std::vector<std::unique_ptr<DataCodec>> codecs(remote_files.size());
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    auto fetch = [&]() {
+        try {
+            for (auto i = next++; i < remote_files.size() && !failed;
+                 i = next++) {
+                codecs[i] = DownloadAndDeserialize(
+                    remote_chunk_manager, is_field_data, remote_files[i]);
+            }
+        } catch (...) {
+            // the other tasks stop after their current file
+            failed = true;
+            throw;
+        }
+    };
+
+    auto& pool = ThreadPools::GetThreadPool(priority);
+    auto tasks = std::min(max_inflight, remote_files.size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i) {
+        futures.emplace_back(pool.Submit(fetch));
+    }
+    // fetch refers to the locals above, wait for every task before returning
+    WaitAllFutures(futures);
+    return codecs;
+}
+
+void
+StreamObjectData(ChunkManager* remote_chunk_manager,
+                 const std::vector<std::string>& remote_files,
+                 size_t max_inflight,
+                 const ObjectDataConsumer& consumer,
+                 milvus::ThreadPoolPriority priority,
+                 bool is_field_data) {
+    AssertInfo(max_inflight > 0, "max inflight files should be positive");
+    auto& pool = ThreadPools::GetThreadPool(priority);
+    std::deque<std::future<std::unique_ptr<DataCodec>>> futures;
+    size_t next = 0;
+    auto submit_more = [&]() {
+        while (futures.size() < max_inflight && next < remote_files.size()) {
+            futures.emplace_back(pool.Submit(DownloadAndDeserialize,
+                                             remote_chunk_manager,
+                                             is_field_data,
+                                             remote_files[next++]));
+        }
+    };
+
+    try {
+        for (size_t i = 0; i < remote_files.size(); ++i) {
+            submit_more();
+            auto codec = futures.front().get();
+            futures.pop_front();
+            // refill before consuming, so the downloads overlap with it
+            submit_more();
+            consumer(i, std::move(codec));
+        }
+    } catch (...) {
+        // the downloads in flight still use remote_chunk_manager
+        for (auto& future : futures) {
+            future.wait();
+        }
+        throw;
+    }
+}
+
 std::map<std::string, int64_t>
 PutIndexData(ChunkManager* remote_chunk_manager,
              const std::vector<const uint8_t*>& data_slices,
@@ -1312,29 +1397,14 @@ MergeFieldData(std::vector<FieldDataPtr>& data_array) {
 
 std::vector<FieldDataPtr>
 FetchFieldData(ChunkManager* cm, const std::vector<std::string>& remote_files) {
-    std::vector<FieldDataPtr> field_datas;
-    std::vector<std::string> batch_files;
-    auto FetchRawData = [&]() {
-        auto fds = GetObjectData(cm, batch_files);
-        // Wait for all futures and collect exceptions to ensure all threads complete
-        auto codecs = storage::WaitAllFutures(std::move(fds));
-        for (auto& codec : codecs) {
-            field_datas.emplace_back(codec->GetFieldData());
-        }
-    };
-
     auto parallel_degree =
         uint64_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
-
-    for (auto& file : remote_files) {
-        if (batch_files.size() >= parallel_degree) {
-            FetchRawData();
-            batch_files.clear();
-        }
-        batch_files.emplace_back(file);
-    }
-    if (batch_files.size() > 0) {
-        FetchRawData();
+    auto codecs = BatchGetObjectData(
+        cm, remote_files, std::max<uint64_t>(parallel_degree, 1));
+    std::vector<FieldDataPtr> field_datas;
+    field_datas.reserve(codecs.size());
+    for (auto& codec : codecs) {
+        field_datas.emplace_back(codec->GetFieldData());
     }
     return field_datas;
 }
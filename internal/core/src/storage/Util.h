@@ -16,11 +16,14 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <future>
 
+#include <folly/CancellationToken.h>
+
 #include "common/FieldData.h"
 #include "common/LoadInfo.h"
 #include "knowhere/comp/index_param.h"
@@ -177,11 +180,45 @@ EncodeAndUploadIndexSlice(ChunkManager* chunk_manager,
                           std::string object_key,
                           std::shared_ptr<CPluginContext> plugin_context);
 
+// A download still queued when cancel_token is cancelled fails at once
+// instead of fetching its file.
 std::vector<std::future<std::unique_ptr<DataCodec>>>
 GetObjectData(
     ChunkManager* remote_chunk_manager,
     const std::vector<std::string>& remote_files,
     milvus::ThreadPoolPriority priority = milvus::ThreadPoolPriority::HIGH,
+    bool is_field_data = true,
+    folly::CancellationToken cancel_token = {});
+
+// Downloads and decodes remote_files, many small objects such as delta logs,
+// stats and index meta files, with at most max_inflight of them in flight.
+// Rather than a task per file, max_inflight tasks each pull the next file as
+// soon as they are done with one, so thousands of files neither flood the
+// pool nor wait for the slowest file of a batch. The codecs are returned in
+// the order of remote_files.
+std::vector<std::unique_ptr<DataCodec>>
+BatchGetObjectData(
+    ChunkManager* remote_chunk_manager,
+    const std::vector<std::string>& remote_files,
+    size_t max_inflight,
+    milvus::ThreadPoolPriority priority = milvus::ThreadPoolPriority::HIGH,
+    bool is_field_data = true);
+
+using ObjectDataConsumer =
+    std::function<void(size_t index, std::unique_ptr<DataCodec> codec)>;
+
+// Downloads and decodes remote_files with at most max_inflight of them in
+// flight, and hands every codec to consumer in the order of remote_files as
+// soon as it arrived. Downloads go on while consumer runs, and a codec is
+// freed as soon as consumer returns, so the memory held is bounded by
+// max_inflight files rather than by all of them.
+void
+StreamObjectData(
+    ChunkManager* remote_chunk_manager,
+    const std::vector<std::string>& remote_files,
+    size_t max_inflight,
+    const ObjectDataConsumer& consumer,
+    milvus::ThreadPoolPriority priority = milvus::ThreadPoolPriority::HIGH,
     bool is_field_data = true);
 
 // Helper function to wait for all futures and collect exceptions
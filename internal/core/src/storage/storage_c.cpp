@@ -16,9 +16,11 @@
 
 #include "storage/storage_c.h"
 #include "storage/FileWriter.h"
+#include "storage/IoEngine.h"
 #include "monitor/Monitor.h"
 #include "storage/PluginLoader.h"
 #include "storage/RemoteChunkManagerSingleton.h"
+#include "storage/StorageV2FSCache.h"
 #include "storage/LocalChunkManagerSingleton.h"
 #include "storage/MmapManager.h"
 #include "storage/ThreadPools.h"
@@ -155,6 +157,102 @@ InitDiskFileWriterConfig(CDiskWriteConfig c_disk_write_config) {
     }
 }
 
+CStatus
+InitDiskReadRateLimiterConfig(CDiskWriteRateLimiterConfig c_config) {
+    try {
+        milvus::storage::io::ReadRateLimiter::GetInstance().Configure(
+            c_config.refill_period_us,
+            c_config.avg_bps,
+            c_config.max_burst_bps,
+            c_config.high_priority_ratio,
+            c_config.middle_priority_ratio,
+            c_config.low_priority_ratio);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InitDiskIoEngineConfig(const char* engine, int64_t queue_depth) {
+    try {
+        std::string engine_str(engine);
+        if (engine_str == "io_uring") {
+            milvus::storage::io::IoEngine::SetEngineType(
+                milvus::storage::io::IoEngineType::IO_URING);
+        } else if (engine_str == "preadv") {
+            milvus::storage::io::IoEngine::SetEngineType(
+                milvus::storage::io::IoEngineType::PREADV);
+        } else {
+            return milvus::FailureCStatus(milvus::ConfigInvalid,
+                                          "Invalid io engine");
+        }
+        milvus::storage::io::IoEngine::SetQueueDepth(queue_depth);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InitStorageV2FSWarmupConfig(int64_t warmup_connections) {
+    try {
+        if (warmup_connections < 0) {
+            return milvus::FailureCStatus(milvus::ConfigInvalid,
+                                          "Invalid warmup connections");
+        }
+        milvus::storage::StorageV2FSCache::SetWarmupConnections(
+            warmup_connections);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InitRemoteHedgedReadConfig(double delay_percentile,
+                           int64_t min_delay_ms,
+                           int64_t max_delay_ms,
+                           double budget_ratio,
+                           int64_t max_retries,
+                           int64_t backoff_ms) {
+    try {
+        if (delay_percentile <= 0 || delay_percentile > 1 ||
+            min_delay_ms < 0 || min_delay_ms > max_delay_ms ||
+            budget_ratio < 0 || max_retries < 0 || backoff_ms < 0) {
+            return milvus::FailureCStatus(milvus::ConfigInvalid,
+                                          "Invalid hedged read config");
+        }
+        milvus::storage::HedgedReadConfig config;
+        config.delay_percentile = delay_percentile;
+        config.min_delay = std::chrono::milliseconds(min_delay_ms);
+        config.max_delay = std::chrono::milliseconds(max_delay_ms);
+        config.budget_ratio = budget_ratio;
+        config.max_retries = max_retries;
+        config.backoff = std::chrono::milliseconds(backoff_ms);
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+            .EnableHedgedReads(config);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
+CStatus
+InitRemoteObjectCache(const char* c_path, int64_t capacity_bytes) {
+    try {
+        if (capacity_bytes <= 0) {
+            return milvus::FailureCStatus(milvus::ConfigInvalid,
+                                          "Invalid object cache capacity");
+        }
+        milvus::storage::RemoteChunkManagerSingleton::GetInstance()
+            .EnableObjectCache(std::string(c_path), capacity_bytes);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(&e);
+    }
+}
+
 void
 CleanRemoteChunkManagerSingleton() {
     milvus::storage::RemoteChunkManagerSingleton::GetInstance().Release();
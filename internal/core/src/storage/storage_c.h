@@ -42,6 +42,35 @@ ResizeTheadPool(int64_t priority, float ratio);
 CStatus
 InitDiskFileWriterConfig(CDiskWriteConfig c_disk_write_config);
 
+CStatus
+InitDiskIoEngineConfig(const char* engine, int64_t queue_depth);
+
+// the read limiter takes the same parameters as the write one of
+// InitDiskFileWriterConfig, non-positive ratios leave a priority unlimited
+CStatus
+InitDiskReadRateLimiterConfig(CDiskWriteRateLimiterConfig c_config);
+
+// every new remote filesystem of storage v2 opens this many connections up
+// front, 0 disables the warmup
+CStatus
+InitStorageV2FSWarmupConfig(int64_t warmup_connections);
+
+// a remote read still running at 'delay_percentile' of the recent read
+// latencies, clamped to [min_delay_ms, max_delay_ms], is sent again, for at
+// most 'budget_ratio' of the reads; a read whose requests all failed is
+// retried 'max_retries' times from 'backoff_ms', must be called before
+// InitRemoteObjectCache
+CStatus
+InitRemoteHedgedReadConfig(double delay_percentile,
+                           int64_t min_delay_ms,
+                           int64_t max_delay_ms,
+                           double budget_ratio,
+                           int64_t max_retries,
+                           int64_t backoff_ms);
+
+CStatus
+InitRemoteObjectCache(const char* c_path, int64_t capacity_bytes);
+
 // Plugin related APIs
 CStatus
 InitPluginLoader(const char* plugin_path);
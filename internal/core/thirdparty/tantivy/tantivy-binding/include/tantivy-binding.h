@@ -93,6 +93,11 @@ struct RustResult {
 
 using SetBitsetFn = void(*)(void*, const uint32_t*, uintptr_t);
 
+struct SegmentBm25Stats {
+  uint64_t num_docs;
+  float avgdl;
+};
+
 struct TantivyToken {
   const char *token;
   int64_t start_offset;
@@ -101,6 +106,19 @@ struct TantivyToken {
   int64_t position_length;
 };
 
+/// Tokens of many texts produced by one call. The token texts lie end to end
+/// in `data`: token i is `data[token_offsets[i]..token_offsets[i + 1]]`, and
+/// the tokens of text j are tokens `text_offsets[j]..text_offsets[j + 1]`.
+/// `positions` holds one position per token, or is empty when not asked for.
+struct TantivyTokenBatch {
+  uint8_t *data;
+  size_t data_len;
+  size_t data_cap;
+  RustArray token_offsets;
+  RustArray text_offsets;
+  RustArrayI64 positions;
+};
+
 extern "C" {
 
 void free_rust_array(RustArray array);
@@ -321,6 +339,15 @@ RustResult tantivy_match_query(void *ptr,
                                uintptr_t min_should_match,
                                void *bitset);
 
+RustResult tantivy_match_query_topk(void *ptr,
+                                    const char *query,
+                                    uintptr_t k,
+                                    SegmentBm25Stats stats,
+                                    const uint8_t *excluded,
+                                    uintptr_t num_rows,
+                                    int64_t *offsets,
+                                    float *scores);
+
 RustResult tantivy_phrase_match_query(void *ptr, const char *query, uint32_t slop, void *bitset);
 
 RustResult tantivy_register_tokenizer(void *ptr,
@@ -522,6 +549,14 @@ const char *tantivy_token_stream_get_token(void *token_stream);
 
 TantivyToken tantivy_token_stream_get_detailed_token(void *token_stream);
 
+TantivyTokenBatch tantivy_tokenize_batch(void *tokenizer,
+                                         const char *const *texts,
+                                         const uint32_t *text_lens,
+                                         size_t num_texts,
+                                         bool with_positions);
+
+void tantivy_free_token_batch(TantivyTokenBatch batch);
+
 RustResult tantivy_create_analyzer(const char *analyzer_params, const char *extra_info);
 
 RustResult tantivy_validate_analyzer(const char *analyzer_params, const char *extra_info);
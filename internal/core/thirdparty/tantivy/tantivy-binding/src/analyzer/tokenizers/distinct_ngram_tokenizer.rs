@@ -0,0 +1,186 @@
+use std::collections::HashSet;
+
+use tantivy::tokenizer::{Token, TokenStream, Tokenizer};
+use tantivy::TantivyError;
+
+/// Tokenize text into its distinct n-grams: every gram of `min_gram` to
+/// `max_gram` chars is emitted once per text, however often it occurs.
+///
+/// The ngram index records doc ids only, so a gram repeated in a text adds
+/// nothing to the index but another lookup in the indexing hash map.
+#[derive(Clone, Debug)]
+pub struct DistinctNgramTokenizer {
+    min_gram: usize,
+    max_gram: usize,
+    token: Token,
+}
+
+impl DistinctNgramTokenizer {
+    pub fn new(min_gram: usize, max_gram: usize) -> Result<Self, TantivyError> {
+        if min_gram == 0 {
+            return Err(TantivyError::InvalidArgument(
+                "min_gram must be greater than 0".to_string(),
+            ));
+        }
+        if min_gram > max_gram {
+            return Err(TantivyError::InvalidArgument(
+                "min_gram must not be greater than max_gram".to_string(),
+            ));
+        }
+
+        Ok(DistinctNgramTokenizer {
+            min_gram,
+            max_gram,
+            token: Token::default(),
+        })
+    }
+}
+
+/// Byte ranges of the distinct grams of text, in the order they first occur
+fn distinct_ngrams(text: &str, min_gram: usize, max_gram: usize) -> Vec<(usize, usize)> {
+    // ASCII text, which `is_ascii` checks a word or a vector at a time, has a
+    // char per byte, so its grams need no char boundaries
+    if text.is_ascii() {
+        return collect_distinct(text, text.len(), min_gram, max_gram, |i| i);
+    }
+    let boundaries: Vec<usize> = text
+        .char_indices()
+        .map(|(i, _)| i)
+        .chain(std::iter::once(text.len()))
+        .collect();
+    collect_distinct(text, boundaries.len() - 1, min_gram, max_gram, |i| {
+        boundaries[i]
+    })
+}
+
+fn collect_distinct(
+    text: &str,
+    num_chars: usize,
+    min_gram: usize,
+    max_gram: usize,
+    boundary: impl Fn(usize) -> usize,
+) -> Vec<(usize, usize)> {
+    let mut grams = Vec::new();
+    if num_chars < min_gram {
+        return grams;
+    }
+    let num_starts = num_chars - min_gram + 1;
+    let mut seen = HashSet::with_capacity(num_starts * (max_gram - min_gram + 1));
+    for start_char in 0..num_starts {
+        let start = boundary(start_char);
+        let max_end = (start_char + max_gram).min(num_chars);
+        for end_char in start_char + min_gram..=max_end {
+            let end = boundary(end_char);
+            if seen.insert(&text[start..end]) {
+                grams.push((start, end));
+            }
+        }
+    }
+    grams
+}
+
+/// TokenStream for DistinctNgramTokenizer
+pub struct DistinctNgramTokenStream<'a> {
+    text: &'a str,
+    grams: Vec<(usize, usize)>,
+    next: usize,
+    token: &'a mut Token,
+}
+
+impl Tokenizer for DistinctNgramTokenizer {
+    type TokenStream<'a> = DistinctNgramTokenStream<'a>;
+
+    fn token_stream<'a>(&'a mut self, text: &'a str) -> Self::TokenStream<'a> {
+        self.token.reset();
+        DistinctNgramTokenStream {
+            text,
+            grams: distinct_ngrams(text, self.min_gram, self.max_gram),
+            next: 0,
+            token: &mut self.token,
+        }
+    }
+}
+
+impl TokenStream for DistinctNgramTokenStream<'_> {
+    fn advance(&mut self) -> bool {
+        if self.next >= self.grams.len() {
+            return false;
+        }
+        let (start, end) = self.grams[self.next];
+        self.token.position = self.next;
+        self.token.offset_from = start;
+        self.token.offset_to = end;
+        self.token.text.clear();
+        self.token.text.push_str(&self.text[start..end]);
+        self.next += 1;
+        true
+    }
+
+    fn token(&self) -> &Token {
+        self.token
+    }
+
+    fn token_mut(&mut self) -> &mut Token {
+        self.token
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::collections::HashSet;
+
+    use tantivy::tokenizer::{NgramTokenizer, TokenStream, Tokenizer};
+
+    use super::DistinctNgramTokenizer;
+
+    fn collect_texts<T: TokenStream>(mut stream: T) -> Vec<String> {
+        let mut texts = Vec::new();
+        while stream.advance() {
+            texts.push(stream.token().text.clone());
+        }
+        texts
+    }
+
+    #[test]
+    fn test_distinct_ngrams_match_ngram_tokenizer() {
+        for text in ["", "a", "banana", "aaaaaaaa", "ngram测试测试ngram", "测试"] {
+            for (min_gram, max_gram) in [(1, 1), (2, 3), (3, 5)] {
+                let mut distinct = DistinctNgramTokenizer::new(min_gram, max_gram).unwrap();
+                let texts = collect_texts(distinct.token_stream(text));
+                let unique: HashSet<String> = texts.iter().cloned().collect();
+                assert_eq!(unique.len(), texts.len(), "{}", text);
+
+                let mut ngram = NgramTokenizer::new(min_gram, max_gram, false).unwrap();
+                let expected: HashSet<String> = collect_texts(ngram.token_stream(text))
+                    .into_iter()
+                    .collect();
+                assert_eq!(unique, expected, "{}", text);
+            }
+        }
+    }
+
+    #[test]
+    fn test_distinct_ngrams_offsets() {
+        let mut tokenizer = DistinctNgramTokenizer::new(2, 2).unwrap();
+        let mut stream = tokenizer.token_stream("a测试测试");
+        let mut grams = Vec::new();
+        while stream.advance() {
+            let token = stream.token();
+            grams.push((token.text.clone(), token.offset_from, token.offset_to));
+        }
+        assert_eq!(
+            grams,
+            vec![
+                ("a测".to_string(), 0, 4),
+                ("测试".to_string(), 1, 7),
+                ("试测".to_string(), 4, 10),
+            ]
+        );
+    }
+
+    #[test]
+    fn test_invalid_grams() {
+        assert!(DistinctNgramTokenizer::new(0, 2).is_err());
+        assert!(DistinctNgramTokenizer::new(3, 2).is_err());
+    }
+}
@@ -1,4 +1,5 @@
 mod char_group_tokenizer;
+mod distinct_ngram_tokenizer;
 mod grpc_tokenizer;
 mod icu_tokneizer;
 mod jieba_tokenizer;
@@ -8,6 +9,7 @@ mod ngram_tokenizer_with_chars;
 mod tokenizer;
 
 pub use self::char_group_tokenizer::CharGroupTokenizer;
+pub use self::distinct_ngram_tokenizer::DistinctNgramTokenizer;
 pub use self::grpc_tokenizer::GrpcTokenizer;
 pub use self::icu_tokneizer::IcuTokenizer;
 pub use self::jieba_tokenizer::JiebaTokenizer;
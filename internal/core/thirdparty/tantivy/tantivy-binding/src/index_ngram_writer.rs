@@ -1,9 +1,10 @@
 use std::sync::Arc;
 
 use tantivy::schema::{Field, IndexRecordOption, Schema, TextFieldIndexing, TextOptions};
-use tantivy::tokenizer::{NgramTokenizer, TextAnalyzer};
+use tantivy::tokenizer::TextAnalyzer;
 use tantivy::Index;
 
+use crate::analyzer::tokenizers::DistinctNgramTokenizer;
 use crate::error::Result;
 use crate::index_writer::IndexWriterWrapper;
 use crate::index_writer_v7::IndexWriterWrapperImpl;
@@ -35,13 +36,10 @@ impl IndexWriterWrapper {
         num_threads: usize,
         overall_memory_budget_in_bytes: usize,
     ) -> Result<IndexWriterWrapper> {
-        let tokenizer = TextAnalyzer::builder(NgramTokenizer::new(
-            min_gram as usize,
-            max_gram as usize,
-            false,
-        )?)
-        .dynamic()
-        .build();
+        // the index keeps doc ids only, a gram is indexed once per row
+        let tokenizer = TextAnalyzer::builder(DistinctNgramTokenizer::new(min_gram, max_gram)?)
+            .dynamic()
+            .build();
 
         let (schema, field) = build_ngram_schema(field_name);
 
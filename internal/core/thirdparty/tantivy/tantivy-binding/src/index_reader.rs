@@ -3,13 +3,13 @@ use std::ops::Bound;
 use std::sync::Arc;
 
 use libc::c_char;
-use tantivy::fastfield::FastValue;
-use tantivy::query::{
-    BooleanQuery, ExistsQuery, Query, RangeQuery, RegexQuery, TermQuery, TermSetQuery,
-};
+use tantivy::fastfield::{Column, FastValue};
+use tantivy::query::{BooleanQuery, ExistsQuery, Query, RangeQuery, RegexQuery, TermQuery};
 use tantivy::schema::{Field, IndexRecordOption};
 use tantivy::tokenizer::{NgramTokenizer, TokenStream, Tokenizer};
-use tantivy::{Directory, HasLen, Index, IndexReader, ReloadPolicy, Term};
+use tantivy::{
+    Directory, DocId, DocSet, HasLen, Index, IndexReader, ReloadPolicy, Term, TERMINATED,
+};
 
 use crate::bitset_wrapper::BitsetWrapper;
 use crate::docid_collector::{DocIdCollector, DocIdCollectorI64};
@@ -21,9 +21,8 @@ use crate::vec_collector::VecCollector;
 
 use crate::error::{Result, TantivyBindingError};
 
-// Threshold for batch-in query. Less than this threshold, we use term_query one by one and use
-// TermSetQuery when larger than this threshold. This value is based on some experiments.
-const BATCH_THRESHOLD: usize = 10000;
+// Docs handed to the bitset callback at once by batched term queries.
+const POSTING_BLOCK_SIZE: usize = 4096;
 
 #[allow(dead_code)]
 pub(crate) struct IndexReaderWrapper {
@@ -168,18 +167,69 @@ impl IndexReaderWrapper {
             .map_err(TantivyBindingError::TantivyError)
     }
 
-    #[inline]
-    fn single_term_query<F>(&self, term_builder: F, bitset: *mut c_void) -> Result<()>
-    where
-        F: FnOnce(Field) -> Term,
-    {
-        let q = TermQuery::new(term_builder(self.field), IndexRecordOption::Basic);
-        self.search(&q, bitset)
+    // Looks the sorted terms up in the term dictionary of every segment and
+    // sets their postings in blocks of `POSTING_BLOCK_SIZE` docs. Unlike a
+    // query per term, the searcher, weights and collectors are set up once
+    // for the whole IN list, and unlike `TermSetQuery` no automaton is
+    // built nor a per segment bitset filled.
+    fn sorted_terms_query(&self, mut terms: Vec<Term>, bitset: *mut c_void) -> Result<()> {
+        terms.sort_unstable();
+        terms.dedup();
+        let bitset_wrapper = BitsetWrapper::new(bitset, self.set_bitset);
+        let searcher = self.reader.searcher();
+        let mut docs: Vec<DocId> = Vec::with_capacity(POSTING_BLOCK_SIZE);
+        for segment_reader in searcher.segment_readers() {
+            let inv_index = segment_reader.inverted_index(self.field)?;
+            // newer versions store the milvus offset in the doc_id fast field
+            let doc_id_column = match self.id_field {
+                Some(_) => Some(segment_reader.fast_fields().i64("doc_id")?),
+                None => None,
+            };
+            let alive_bitset = segment_reader.alive_bitset();
+            for term in terms.iter() {
+                let mut postings = match inv_index.read_postings(term, IndexRecordOption::Basic)? {
+                    Some(postings) => postings,
+                    None => continue,
+                };
+                while postings.doc() != TERMINATED {
+                    let doc = postings.doc();
+                    if alive_bitset.map_or(true, |alive| alive.is_alive(doc)) {
+                        docs.push(doc);
+                        if docs.len() == POSTING_BLOCK_SIZE {
+                            Self::set_docs(&bitset_wrapper, doc_id_column.as_ref(), &mut docs);
+                        }
+                    }
+                    postings.advance();
+                }
+            }
+            Self::set_docs(&bitset_wrapper, doc_id_column.as_ref(), &mut docs);
+        }
+        Ok(())
     }
 
-    // Due to overhead, `TermSetQuery` is not efficient for small number of terms. So we execute term query one by one
-    // when the terms number is less than `BATCH_THRESHOLD`.
     #[inline]
+    fn set_docs(
+        bitset_wrapper: &BitsetWrapper,
+        doc_id_column: Option<&Column<i64>>,
+        docs: &mut Vec<DocId>,
+    ) {
+        if docs.is_empty() {
+            return;
+        }
+        match doc_id_column {
+            Some(column) => {
+                let doc_ids: Vec<u32> = column
+                    .values_for_docs_flatten(docs)
+                    .into_iter()
+                    .map(|doc_id| doc_id as u32)
+                    .collect();
+                bitset_wrapper.batch_set(&doc_ids);
+            }
+            None => bitset_wrapper.batch_set(docs),
+        }
+        docs.clear();
+    }
+
     fn batch_terms_query<T, F>(
         &self,
         terms: &[T],
@@ -190,18 +240,11 @@ impl IndexReaderWrapper {
         T: Copy,
         F: Fn(Field, T) -> Term,
     {
-        if terms.len() < BATCH_THRESHOLD {
-            return terms.iter().try_for_each(|term| {
-                self.single_term_query(|field| term_builder(field, *term), bitset)
-            });
-        }
-
         let term_vec: Vec<_> = terms
             .iter()
             .map(|&term| term_builder(self.field, term))
             .collect();
-        let q = TermSetQuery::new(term_vec);
-        self.search(&q, bitset)
+        self.sorted_terms_query(term_vec, bitset)
     }
 
     pub fn terms_query_bool(&self, terms: &[bool], bitset: *mut c_void) -> Result<()> {
@@ -227,19 +270,11 @@ impl IndexReaderWrapper {
 
     pub fn terms_query_keyword(&self, terms: &[*const c_char], bitset: *mut c_void) -> Result<()> {
         let mut term_strs = Vec::with_capacity(terms.len());
-        if terms.len() < BATCH_THRESHOLD {
-            return terms
-                .iter()
-                .try_for_each(|term| self.term_query_keyword(c_ptr_to_str(*term)?, bitset));
-        }
-
         for term in terms {
             let term_str = c_ptr_to_str(*term)?;
             term_strs.push(Term::from_field_text(self.field, term_str));
         }
-        let q = TermSetQuery::new(term_strs);
-
-        self.search(&q, bitset)
+        self.sorted_terms_query(term_strs, bitset)
     }
 
     pub fn term_query_keyword_i64(&self, term: &str) -> Result<Vec<i64>> {
@@ -683,7 +718,7 @@ mod test {
 
     use tantivy::{
         doc,
-        schema::{Schema, STORED, STRING, TEXT_WITH_DOC_ID},
+        schema::{NumericOptions, Schema, STORED, STRING, TEXT_WITH_DOC_ID},
         Index,
     };
 
@@ -803,4 +838,38 @@ mod test {
             .unwrap();
         assert_eq!(res.len(), 20000);
     }
+
+    #[test]
+    fn test_terms_query_i64() {
+        let mut schema_builder = Schema::builder();
+        schema_builder.add_i64_field("num", NumericOptions::default().set_indexed());
+        schema_builder.enable_user_specified_doc_id();
+        let schema = schema_builder.build();
+        let num = schema.get_field("num").unwrap();
+
+        let index = Index::create_in_ram(schema.clone());
+        let mut index_writer = index.writer(50000000).unwrap();
+        // two commits, so the terms are looked up in two segments
+        for i in 0..2000 {
+            index_writer
+                .add_document_with_doc_id(i, doc!(num => (i % 100) as i64))
+                .unwrap();
+            if i == 999 {
+                index_writer.commit().unwrap();
+            }
+        }
+        index_writer.commit().unwrap();
+
+        let reader_wrapper = IndexReaderWrapper::from_index(Arc::new(index), set_bitset).unwrap();
+        // duplicated, absent and unsorted terms
+        let terms = vec![42i64, 5, 1000, 5, -1];
+        let mut res: HashSet<u32> = HashSet::new();
+        reader_wrapper
+            .terms_query_i64(&terms, &mut res as *mut _ as *mut c_void)
+            .unwrap();
+        assert_eq!(res.len(), 40);
+        for doc in res {
+            assert!(doc % 100 == 5 || doc % 100 == 42);
+        }
+    }
 }
@@ -1,9 +1,16 @@
 use std::ffi::c_void;
 
+use std::cmp::{Ordering, Reverse};
+use std::collections::BinaryHeap;
+
 use tantivy::{
-    query::{BooleanQuery, PhraseQuery},
+    query::{
+        Bm25StatisticsProvider, BooleanQuery, EnableScoring, Occur, PhraseQuery, Query, TermQuery,
+        Weight,
+    },
+    schema::{Field, IndexRecordOption},
     tokenizer::{TextAnalyzer, TokenStream},
-    Term,
+    Score, Searcher, Term,
 };
 
 use crate::{
@@ -13,6 +20,71 @@ use crate::{
     bitset_wrapper::BitsetWrapper, direct_bitset_collector::DirectBitsetCollector, error::Result,
 };
 
+// The BM25 stats of the milvus segment a text index belongs to. The index of
+// a growing segment lags its rows and the one of a sealed segment keeps the
+// rows deleted since it was built, so the doc count comes from the segment.
+// A zero avgdl takes the mean doc length of the index.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct SegmentBm25Stats {
+    pub num_docs: u64,
+    pub avgdl: f32,
+}
+
+struct SegmentBm25StatsProvider<'a> {
+    searcher: &'a Searcher,
+    stats: SegmentBm25Stats,
+}
+
+impl Bm25StatisticsProvider for SegmentBm25StatsProvider<'_> {
+    fn total_num_tokens(&self, field: Field) -> tantivy::Result<u64> {
+        let avgdl = if self.stats.avgdl > 0.0 {
+            self.stats.avgdl as f64
+        } else {
+            let num_docs = Bm25StatisticsProvider::total_num_docs(self.searcher)?;
+            if num_docs == 0 {
+                return Ok(0);
+            }
+            Bm25StatisticsProvider::total_num_tokens(self.searcher, field)? as f64 / num_docs as f64
+        };
+        Ok((avgdl * self.total_num_docs()? as f64).round() as u64)
+    }
+
+    fn total_num_docs(&self) -> tantivy::Result<u64> {
+        if self.stats.num_docs > 0 {
+            return Ok(self.stats.num_docs);
+        }
+        Bm25StatisticsProvider::total_num_docs(self.searcher)
+    }
+
+    fn doc_freq(&self, term: &Term) -> tantivy::Result<u64> {
+        self.searcher.doc_freq(term)
+    }
+}
+
+// a scored row, the greater the better, the lower offset first on a tie
+#[derive(PartialEq)]
+struct Hit {
+    score: Score,
+    offset: i64,
+}
+
+impl Eq for Hit {}
+
+impl Ord for Hit {
+    fn cmp(&self, other: &Self) -> Ordering {
+        self.score
+            .total_cmp(&other.score)
+            .then_with(|| other.offset.cmp(&self.offset))
+    }
+}
+
+impl PartialOrd for Hit {
+    fn partial_cmp(&self, other: &Self) -> Option<Ordering> {
+        Some(self.cmp(other))
+    }
+}
+
 impl IndexReaderWrapper {
     // split the query string into multiple tokens using index's default tokenizer,
     // and then execute the disconjunction of term query.
@@ -71,6 +143,108 @@ impl IndexReaderWrapper {
         self.search(&query, bitset)
     }
 
+    // scores the docs matching any token of the query by BM25 over the stats
+    // of the segment and writes the k best to offsets and scores, the best
+    // first. The rows at or past num_rows and those set in excluded, one bit
+    // a row, are skipped. The term scorers of the union are pruned by
+    // block-max WAND, so not every matching doc is scored. Returns the number
+    // of hits written.
+    pub(crate) fn match_query_topk(
+        &self,
+        q: &str,
+        k: usize,
+        stats: SegmentBm25Stats,
+        excluded: *const u8,
+        num_rows: usize,
+        offsets: *mut i64,
+        scores: *mut f32,
+    ) -> Result<u32> {
+        let mut tokenizer = self
+            .index
+            .tokenizer_for_field(self.field)
+            .unwrap_or(standard_analyzer(vec![]))
+            .clone();
+        let mut token_stream = tokenizer.token_stream(q);
+        let mut subqueries: Vec<(Occur, Box<dyn Query>)> = Vec::new();
+        while token_stream.advance() {
+            let token = token_stream.token();
+            let term = Term::from_field_text(self.field, &token.text);
+            subqueries.push((
+                Occur::Should,
+                Box::new(TermQuery::new(term, IndexRecordOption::WithFreqs)),
+            ));
+        }
+        if subqueries.is_empty() || k == 0 {
+            return Ok(0);
+        }
+        let query = BooleanQuery::new(subqueries);
+        let searcher = self.reader.searcher();
+        let provider = SegmentBm25StatsProvider {
+            searcher: &searcher,
+            stats,
+        };
+        let weight = query
+            .weight(EnableScoring::enabled_from_statistics_provider(
+                &provider, &searcher,
+            ))
+            .map_err(TantivyBindingError::TantivyError)?;
+
+        let is_excluded = |offset: i64| {
+            let offset = offset as usize;
+            offset >= num_rows
+                || (!excluded.is_null()
+                    && unsafe { *excluded.add(offset / 8) } & (1 << (offset % 8)) != 0)
+        };
+        // the worst of the k best hits on top
+        let mut heap: BinaryHeap<Reverse<Hit>> = BinaryHeap::with_capacity(k);
+        let mut threshold = Score::MIN;
+        for reader in searcher.segment_readers() {
+            // newer versions store the milvus offset in the doc_id fast field
+            let doc_id_column = match self.id_field {
+                Some(_) => Some(reader.fast_fields().i64("doc_id")?),
+                None => None,
+            };
+            let alive_bitset = reader.alive_bitset();
+            weight
+                .for_each_pruning(threshold, reader, &mut |doc, score| {
+                    if alive_bitset.map_or(false, |alive| alive.is_deleted(doc)) {
+                        return threshold;
+                    }
+                    let offset = match &doc_id_column {
+                        Some(column) => match column.first(doc) {
+                            Some(offset) => offset,
+                            None => return threshold,
+                        },
+                        None => doc as i64,
+                    };
+                    if is_excluded(offset) {
+                        return threshold;
+                    }
+                    let hit = Hit { score, offset };
+                    if heap.len() < k {
+                        heap.push(Reverse(hit));
+                    } else if heap.peek().map_or(false, |worst| hit > worst.0) {
+                        heap.pop();
+                        heap.push(Reverse(hit));
+                    }
+                    if heap.len() == k {
+                        threshold = heap.peek().unwrap().0.score;
+                    }
+                    threshold
+                })
+                .map_err(TantivyBindingError::TantivyError)?;
+        }
+
+        let hits = heap.into_sorted_vec();
+        for (i, Reverse(hit)) in hits.iter().enumerate() {
+            unsafe {
+                *offsets.add(i) = hit.offset;
+                *scores.add(i) = hit.score;
+            }
+        }
+        Ok(hits.len() as u32)
+    }
+
     // split the query string into multiple tokens using index's default tokenizer,
     // and then execute the disconjunction of term query.
     pub(crate) fn phrase_match_query(&self, q: &str, slop: u32, bitset: *mut c_void) -> Result<()> {
@@ -236,4 +410,87 @@ mod tests {
             .unwrap();
         assert!(res.is_empty());
     }
+
+    #[test]
+    fn test_match_query_topk() {
+        let dir = tempfile::TempDir::new().unwrap();
+        let mut writer = IndexWriterWrapper::create_text_writer(
+            "text",
+            dir.path().to_str().unwrap(),
+            "default",
+            "",
+            "",
+            1,
+            50_000_000,
+            false,
+            TantivyIndexVersion::default_version(),
+        )
+        .unwrap();
+
+        writer.add("a", Some(0)).unwrap();
+        writer.add("a b", Some(1)).unwrap();
+        writer.add("c", Some(2)).unwrap();
+        writer.add("a b b", Some(3)).unwrap();
+        for i in 4..1000 {
+            writer.add("a c", Some(i)).unwrap();
+        }
+        writer.commit().unwrap();
+
+        let reader = writer.create_reader(set_bitset).unwrap();
+
+        let index_stats = SegmentBm25Stats {
+            num_docs: 0,
+            avgdl: 0.0,
+        };
+        let topk = |q: &str, k: usize, stats: SegmentBm25Stats, excluded: &[u8]| {
+            let mut offsets = vec![-1i64; k];
+            let mut scores = vec![0f32; k];
+            let num = reader
+                .match_query_topk(
+                    q,
+                    k,
+                    stats,
+                    excluded.as_ptr(),
+                    1000,
+                    offsets.as_mut_ptr(),
+                    scores.as_mut_ptr(),
+                )
+                .unwrap() as usize;
+            offsets.truncate(num);
+            scores.truncate(num);
+            (offsets, scores)
+        };
+        let none = vec![0u8; 125];
+
+        // the rare token b ranks its docs first
+        let (offsets, scores) = topk("a b", 2, index_stats, &none);
+        assert_eq!(offsets, vec![3, 1]);
+        assert!(scores[0] >= scores[1]);
+
+        // the excluded rows are skipped
+        let mut excluded = none.clone();
+        excluded[0] = 1 << 3;
+        let (offsets, _) = topk("a b", 2, index_stats, &excluded);
+        assert_eq!(offsets[0], 1);
+
+        // the stats of the segment, not those of the index, weigh the terms
+        let (_, scores) = topk("b", 1, index_stats, &none);
+        let segment_stats = SegmentBm25Stats {
+            num_docs: 100_000,
+            avgdl: 2.0,
+        };
+        let (_, segment_scores) = topk("b", 1, segment_stats, &none);
+        assert!(segment_scores[0] > scores[0]);
+
+        // a short doc outscores a long one with the same term frequency
+        let (offsets, _) = topk("c", 2, index_stats, &none);
+        assert_eq!(offsets[0], 2);
+
+        // fewer hits than k
+        let (offsets, _) = topk("b", 10, index_stats, &none);
+        assert_eq!(offsets.len(), 2);
+
+        let (offsets, _) = topk("d", 10, index_stats, &none);
+        assert!(offsets.is_empty());
+    }
 }
@@ -4,7 +4,7 @@ use libc::{c_char, c_void};
 
 use crate::{
     analyzer::create_analyzer, array::RustResult, cstr_to_str, index_reader::IndexReaderWrapper,
-    log::init_log,
+    index_reader_text::SegmentBm25Stats, log::init_log,
 };
 
 #[no_mangle]
@@ -27,6 +27,26 @@ pub extern "C" fn tantivy_match_query(
     }
 }
 
+#[no_mangle]
+pub extern "C" fn tantivy_match_query_topk(
+    ptr: *mut c_void,
+    query: *const c_char,
+    k: usize,
+    stats: SegmentBm25Stats,
+    excluded: *const u8,
+    num_rows: usize,
+    offsets: *mut i64,
+    scores: *mut f32,
+) -> RustResult {
+    let real = ptr as *mut IndexReaderWrapper;
+    let query = cstr_to_str!(query);
+    unsafe {
+        (*real)
+            .match_query_topk(query, k, stats, excluded, num_rows, offsets, scores)
+            .into()
+    }
+}
+
 #[no_mangle]
 pub extern "C" fn tantivy_phrase_match_query(
     ptr: *mut c_void,
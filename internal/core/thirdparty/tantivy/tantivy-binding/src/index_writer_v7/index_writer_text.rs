@@ -11,10 +11,10 @@ use super::IndexWriterWrapperImpl;
 
 fn build_text_schema(field_name: &str, tokenizer_name: &str) -> (Schema, Field) {
     let mut schema_builder = Schema::builder();
-    // positions is required for matching phase.
+    // positions is required for matching phase, and fieldnorms for the
+    // length normalization of the BM25 scores of `match_query_topk`.
     let indexing = TextFieldIndexing::default()
         .set_tokenizer(tokenizer_name)
-        .set_fieldnorms(false)
         .set_index_option(IndexRecordOption::WithFreqsAndPositions);
     let option = TextOptions::default().set_indexing_options(indexing);
     let field = schema_builder.add_text_field(field_name, option);
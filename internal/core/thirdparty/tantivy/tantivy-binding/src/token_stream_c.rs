@@ -1,8 +1,9 @@
 use std::ffi::c_char;
 
-use libc::c_void;
+use libc::{c_void, size_t};
 use tantivy::tokenizer::{BoxTokenStream, TextAnalyzer, Token};
 
+use crate::array::{free_rust_array, free_rust_array_i64, RustArray, RustArrayI64};
 use crate::string_c::c_str_to_str;
 use crate::{
     string_c::create_string,
@@ -67,3 +68,81 @@ pub extern "C" fn tantivy_token_stream_get_detailed_token(
     let real = token_stream as *mut BoxTokenStream<'_>;
     TantivyToken::from_token(unsafe { (*real).token() })
 }
+
+/// Tokens of many texts produced by one call. The token texts lie end to end
+/// in `data`: token i is `data[token_offsets[i]..token_offsets[i + 1]]`, and
+/// the tokens of text j are tokens `text_offsets[j]..text_offsets[j + 1]`.
+/// `positions` holds one position per token, or is empty when not asked for.
+#[repr(C)]
+pub struct TantivyTokenBatch {
+    pub data: *mut u8,
+    pub data_len: size_t,
+    pub data_cap: size_t,
+    pub token_offsets: RustArray,
+    pub text_offsets: RustArray,
+    pub positions: RustArrayI64,
+}
+
+// Note: the texts need not be null terminated, and the returned batch should
+// be released by calling `tantivy_free_token_batch` after use.
+#[no_mangle]
+pub extern "C" fn tantivy_tokenize_batch(
+    tokenizer: *mut c_void,
+    texts: *const *const c_char,
+    text_lens: *const u32,
+    num_texts: size_t,
+    with_positions: bool,
+) -> TantivyTokenBatch {
+    let analyzer = unsafe { &mut *(tokenizer as *mut TextAnalyzer) };
+    let mut data: Vec<u8> = Vec::new();
+    let mut token_offsets: Vec<u32> = vec![0];
+    let mut text_offsets: Vec<u32> = Vec::with_capacity(num_texts + 1);
+    let mut positions: Vec<i64> = Vec::new();
+    text_offsets.push(0);
+    for i in 0..num_texts {
+        let text = unsafe {
+            let bytes =
+                std::slice::from_raw_parts(*texts.add(i) as *const u8, *text_lens.add(i) as usize);
+            std::str::from_utf8_unchecked(bytes)
+        };
+        let mut stream = analyzer.token_stream(text);
+        while stream.advance() {
+            let token = stream.token();
+            data.extend_from_slice(token.text.as_bytes());
+            token_offsets.push(data.len() as u32);
+            if with_positions {
+                positions.push(token.position as i64);
+            }
+        }
+        text_offsets.push((token_offsets.len() - 1) as u32);
+    }
+
+    let data_len = data.len();
+    let data_cap = data.capacity();
+    TantivyTokenBatch {
+        data: data.leak().as_mut_ptr(),
+        data_len,
+        data_cap,
+        token_offsets: RustArray::from_vec(token_offsets),
+        text_offsets: RustArray::from_vec(text_offsets),
+        positions: RustArrayI64::from_vec(positions),
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn tantivy_free_token_batch(batch: TantivyTokenBatch) {
+    let TantivyTokenBatch {
+        data,
+        data_len,
+        data_cap,
+        token_offsets,
+        text_offsets,
+        positions,
+    } = batch;
+    unsafe {
+        Vec::from_raw_parts(data, data_len, data_cap);
+    }
+    free_rust_array(token_offsets);
+    free_rust_array(text_offsets);
+    free_rust_array_i64(positions);
+}
@@ -22,8 +22,10 @@ static constexpr const char* DEFAULT_ANALYZER_NAME = "milvus_tokenizer";
 static const char* DEFAULT_ANALYZER_PARAMS = "{}";
 static constexpr uintptr_t DEFAULT_NUM_THREADS =
     1;  // Every field with index writer will generate a thread, make huge thread amount, wait for refactoring.
+// the least memory tantivy lets an indexing thread have
+static constexpr uintptr_t MEMORY_BUDGET_PER_THREAD_IN_BYTES = 15 * 1024 * 1024;
 static constexpr uintptr_t DEFAULT_OVERALL_MEMORY_BUDGET_IN_BYTES =
-    DEFAULT_NUM_THREADS * 15 * 1024 * 1024;
+    DEFAULT_NUM_THREADS * MEMORY_BUDGET_PER_THREAD_IN_BYTES;
 
 template <typename T>
 inline TantivyDataType
@@ -979,6 +981,34 @@ struct TantivyIndexWrapper {
                    "TantivyIndexWrapper.match_query: invalid result type");
     }
 
+    // writes the k best BM25 hits of query to offsets and scores, the best
+    // first, and returns their number. The rows at or past num_rows and
+    // those set in excluded are skipped.
+    uint32_t
+    match_query_topk(const std::string& query,
+                     uintptr_t k,
+                     SegmentBm25Stats stats,
+                     const uint8_t* excluded,
+                     uintptr_t num_rows,
+                     int64_t* offsets,
+                     float* scores) {
+        auto array = tantivy_match_query_topk(reader_,
+                                              query.c_str(),
+                                              k,
+                                              stats,
+                                              excluded,
+                                              num_rows,
+                                              offsets,
+                                              scores);
+        auto res = RustResultWrapper(array);
+        AssertInfo(res.result_->success,
+                   "TantivyIndexWrapper.match_query_topk: {}",
+                   res.result_->error);
+        AssertInfo(res.result_->value.tag == Value::Tag::U32,
+                   "TantivyIndexWrapper.match_query_topk: invalid result type");
+        return res.result_->value.u32._0;
+    }
+
     void
     phrase_match_query(const std::string& query, uint32_t slop, void* bitset) {
         auto array =
@@ -3,6 +3,7 @@
 #include <assert.h>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "tantivy-binding.h"
 #include "rust-binding.h"
@@ -54,4 +55,40 @@ struct TokenStream {
     void* ptr_;
     std::shared_ptr<std::string> text_;
 };
+
+// Owns the tokens of a batch of texts, laid out as TantivyTokenBatch
+// describes.
+struct TokenBatch {
+ public:
+    NO_COPY_OR_ASSIGN(TokenBatch);
+
+    explicit TokenBatch(TantivyTokenBatch batch) : batch_(batch) {
+    }
+
+    ~TokenBatch() {
+        tantivy_free_token_batch(batch_);
+    }
+
+ public:
+    size_t
+    num_texts() const {
+        return batch_.text_offsets.len - 1;
+    }
+
+    size_t
+    num_tokens() const {
+        return batch_.token_offsets.len - 1;
+    }
+
+    std::string_view
+    token(size_t i) const {
+        auto begin = batch_.token_offsets.array[i];
+        auto end = batch_.token_offsets.array[i + 1];
+        auto data = reinterpret_cast<const char*>(batch_.data);
+        return std::string_view(data + begin, end - begin);
+    }
+
+ public:
+    TantivyTokenBatch batch_;
+};
 }  // namespace milvus::tantivy
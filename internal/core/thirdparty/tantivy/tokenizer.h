@@ -51,6 +51,17 @@ struct Tokenizer {
         return std::make_unique<TokenStream>(token_stream, shared_text);
     }
 
+    // Tokenizes all the texts in one call into the analyzer, instead of a
+    // call per token.
+    std::unique_ptr<TokenBatch>
+    TokenizeBatch(const char* const* texts,
+                  const uint32_t* text_lens,
+                  size_t num_texts,
+                  bool with_positions) {
+        return std::make_unique<TokenBatch>(tantivy_tokenize_batch(
+            ptr_, texts, text_lens, num_texts, with_positions));
+    }
+
     std::unique_ptr<Tokenizer>
     Clone() {
         auto newptr = tantivy_clone_analyzer(ptr_);
@@ -11,7 +11,10 @@
 
 #include <benchmark/benchmark.h>
 #include <filesystem>
+#include <string>
+#include <vector>
 #include "common/File.h"
+#include "storage/FileWriter.h"
 
 static void
 BN_FILE_Write_Syscall(benchmark::State& stats, int n) {
@@ -40,6 +43,52 @@ BN_FILE_Write_Stream(benchmark::State& stats, size_t buf_size, int n) {
     f.FFlush();
 }
 
+// writes 'num_files' files of 'n' bytes each through a FileWriter per file
+static void
+BN_FileWriter_Write_PerFile(benchmark::State& stats,
+                            milvus::storage::FileWriter::WriteMode mode,
+                            int num_files,
+                            int n) {
+    milvus::storage::FileWriter::SetMode(mode);
+    std::string s(n, '*');
+    auto dir = std::filesystem::current_path() / "bn_filewriter_per_file";
+    std::filesystem::create_directories(dir);
+
+    for (auto _ : stats) {
+        for (int i = 0; i < num_files; ++i) {
+            milvus::storage::FileWriter writer(
+                (dir / std::to_string(i)).string());
+            writer.Write(s.data(), n);
+            writer.Finish();
+        }
+    }
+    stats.SetBytesProcessed(int64_t(stats.iterations()) * num_files * n);
+    std::filesystem::remove_all(dir);
+}
+
+// writes the same files coalesced into batches by FileWriter::WriteFiles
+static void
+BN_FileWriter_WriteFiles(benchmark::State& stats,
+                         milvus::storage::FileWriter::WriteMode mode,
+                         int num_files,
+                         int n) {
+    milvus::storage::FileWriter::SetMode(mode);
+    std::string s(n, '*');
+    auto dir = std::filesystem::current_path() / "bn_filewriter_write_files";
+    std::filesystem::create_directories(dir);
+    std::vector<milvus::storage::FileWriter::FileData> files;
+    for (int i = 0; i < num_files; ++i) {
+        files.push_back(
+            {(dir / std::to_string(i)).string(), s.data(), s.size()});
+    }
+
+    for (auto _ : stats) {
+        milvus::storage::FileWriter::WriteFiles(files);
+    }
+    stats.SetBytesProcessed(int64_t(stats.iterations()) * num_files * n);
+    std::filesystem::remove_all(dir);
+}
+
 static void
 BN_FILE_Write_Syscall_2(benchmark::State& stats) {
     BN_FILE_Write_Syscall(stats, 2);
@@ -86,4 +135,45 @@ static void
 BN_FILE_Write_Stream_163840_65535(benchmark::State& stats) {
     BN_FILE_Write_Stream(stats, 163840, 65535);
 }
-BENCHMARK(BN_FILE_Write_Stream_163840_65535);
\ No newline at end of file
+BENCHMARK(BN_FILE_Write_Stream_163840_65535);
+static void
+BN_FileWriter_Write_PerFile_Buffered_1000_16384(benchmark::State& stats) {
+    BN_FileWriter_Write_PerFile(
+        stats, milvus::storage::FileWriter::WriteMode::BUFFERED, 1000, 16384);
+}
+BENCHMARK(BN_FileWriter_Write_PerFile_Buffered_1000_16384);
+
+static void
+BN_FileWriter_WriteFiles_Buffered_1000_16384(benchmark::State& stats) {
+    BN_FileWriter_WriteFiles(
+        stats, milvus::storage::FileWriter::WriteMode::BUFFERED, 1000, 16384);
+}
+BENCHMARK(BN_FileWriter_WriteFiles_Buffered_1000_16384);
+
+static void
+BN_FileWriter_Write_PerFile_Direct_1000_16384(benchmark::State& stats) {
+    BN_FileWriter_Write_PerFile(
+        stats, milvus::storage::FileWriter::WriteMode::DIRECT, 1000, 16384);
+}
+BENCHMARK(BN_FileWriter_Write_PerFile_Direct_1000_16384);
+
+static void
+BN_FileWriter_WriteFiles_Direct_1000_16384(benchmark::State& stats) {
+    BN_FileWriter_WriteFiles(
+        stats, milvus::storage::FileWriter::WriteMode::DIRECT, 1000, 16384);
+}
+BENCHMARK(BN_FileWriter_WriteFiles_Direct_1000_16384);
+
+static void
+BN_FileWriter_Write_PerFile_Direct_100_1000000(benchmark::State& stats) {
+    BN_FileWriter_Write_PerFile(
+        stats, milvus::storage::FileWriter::WriteMode::DIRECT, 100, 1000000);
+}
+BENCHMARK(BN_FileWriter_Write_PerFile_Direct_100_1000000);
+
+static void
+BN_FileWriter_WriteFiles_Direct_100_1000000(benchmark::State& stats) {
+    BN_FileWriter_WriteFiles(
+        stats, milvus::storage::FileWriter::WriteMode::DIRECT, 100, 1000000);
+}
+BENCHMARK(BN_FileWriter_WriteFiles_Direct_100_1000000);
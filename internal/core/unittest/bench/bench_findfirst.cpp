@@ -72,4 +72,47 @@ BM_BITSET_FINDFIRST(benchmark::State& stats) {
     }
 }
 
-BENCHMARK(BM_BITSET_FINDFIRST);
\ No newline at end of file
+BENCHMARK(BM_BITSET_FINDFIRST);
+// every other row passes, the offsets of a dense filter result are extracted
+static milvus::BitsetType
+DenseBitset() {
+    milvus::BitsetType bitset(640000);
+    for (size_t i = 0; i < bitset.size(); i += 2) {
+        bitset.set(i);
+    }
+    return bitset;
+}
+
+static void
+BM_BITSET_DENSE_FINDNEXT(benchmark::State& stats) {
+    auto bitset = DenseBitset();
+    std::vector<int64_t> res;
+    res.reserve(bitset.size());
+    for (auto _ : stats) {
+        res.clear();
+        for (auto i = bitset.find_first(); i.has_value();
+             i = bitset.find_next(i.value())) {
+            res.push_back(i.value());
+        }
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK(BM_BITSET_DENSE_FINDNEXT);
+
+static void
+BM_BITSET_DENSE_FOR_EACH_BATCH(benchmark::State& stats) {
+    auto bitset = DenseBitset();
+    std::vector<int64_t> res;
+    res.reserve(bitset.size());
+    for (auto _ : stats) {
+        res.clear();
+        bitset.for_each_batch([&](const int64_t* offsets, size_t n) {
+            res.insert(res.end(), offsets, offsets + n);
+            return true;
+        });
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK(BM_BITSET_DENSE_FOR_EACH_BATCH);
@@ -0,0 +1,130 @@
+// Copyright (C) 2019-2025 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minhash/MinHashComputer.h"
+#include "minhash/MinHashHook.h"
+
+using namespace milvus::minhash;
+
+namespace {
+
+constexpr int32_t kNumTexts = 10000;
+constexpr int32_t kNumHashes = 128;
+constexpr int32_t kShingleSize = 3;
+
+// kNumTexts random lowercase texts of text_len chars
+std::vector<std::string>
+GenTexts(int32_t text_len) {
+    std::default_random_engine er(42);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::vector<std::string> texts(kNumTexts);
+    for (auto& text : texts) {
+        text.resize(text_len);
+        for (auto& c : text) {
+            c = static_cast<char>(letter(er));
+        }
+    }
+    return texts;
+}
+
+}  // namespace
+
+// end to end, char level shingles of a batch of short documents
+static void
+BM_MinHash_ComputeFromTexts(benchmark::State& state) {
+    minhash_hook_init();
+    auto text_strings = GenTexts(state.range(0));
+    std::vector<const char*> texts;
+    std::vector<int32_t> text_lengths;
+    for (const auto& text : text_strings) {
+        texts.push_back(text.c_str());
+        text_lengths.push_back(text.size());
+    }
+    std::vector<uint64_t> perm_a(kNumHashes);
+    std::vector<uint64_t> perm_b(kNumHashes);
+    InitPermutations(kNumHashes, 42, perm_a.data(), perm_b.data());
+    std::vector<uint32_t> signatures(kNumTexts * kNumHashes);
+
+    for (auto _ : state) {
+        ComputeFromTextsDirectly(texts.data(),
+                                 text_lengths.data(),
+                                 kNumTexts,
+                                 nullptr,
+                                 kShingleSize,
+                                 perm_a.data(),
+                                 perm_b.data(),
+                                 HashFunction::XXHASH64,
+                                 kNumHashes,
+                                 signatures.data());
+        benchmark::DoNotOptimize(signatures.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumTexts);
+}
+BENCHMARK(BM_MinHash_ComputeFromTexts)->Arg(16)->Arg(64)->Arg(256)->Arg(1024);
+
+// the signature kernels alone over precomputed base hashes, text by text
+// with the batch8 kernel (arg 0) or a batch of texts at once (arg 1)
+static void
+BM_MinHash_SignatureKernel(benchmark::State& state) {
+    minhash_hook_init();
+    bool multi_text = state.range(0) != 0;
+    int32_t shingles_per_text = state.range(1);
+    std::default_random_engine er(42);
+    std::vector<int32_t> shingle_counts(kNumTexts, shingles_per_text);
+    std::vector<uint64_t> base_hashes(kNumTexts * shingles_per_text);
+    for (auto& hash : base_hashes) {
+        hash = static_cast<uint32_t>(er());
+    }
+    std::vector<uint64_t> perm_a(kNumHashes);
+    std::vector<uint64_t> perm_b(kNumHashes);
+    InitPermutations(kNumHashes, 42, perm_a.data(), perm_b.data());
+    std::vector<uint32_t> signatures(kNumTexts * kNumHashes);
+
+    for (auto _ : state) {
+        if (multi_text) {
+            for (int32_t i = 0; i < kNumHashes; i += 8) {
+                linear_and_find_min_batch8_multi_impl(base_hashes.data(),
+                                                      shingle_counts.data(),
+                                                      kNumTexts,
+                                                      perm_a.data() + i,
+                                                      perm_b.data() + i,
+                                                      signatures.data() + i,
+                                                      kNumHashes);
+            }
+        } else {
+            const uint64_t* base = base_hashes.data();
+            for (int32_t t = 0; t < kNumTexts; t++) {
+                uint32_t* sig = signatures.data() + t * kNumHashes;
+                for (int32_t i = 0; i < kNumHashes; i += 8) {
+                    for (int32_t k = 0; k < 8; k++) {
+                        sig[i + k] = UINT32_MAX;
+                    }
+                    linear_and_find_min_batch8_impl(base,
+                                                    shingles_per_text,
+                                                    perm_a.data() + i,
+                                                    perm_b.data() + i,
+                                                    sig + i);
+                }
+                base += shingles_per_text;
+            }
+        }
+        benchmark::DoNotOptimize(signatures.data());
+    }
+    state.SetItemsProcessed(state.iterations() * kNumTexts);
+}
+BENCHMARK(BM_MinHash_SignatureKernel)
+    ->ArgsProduct({{0, 1}, {4, 16, 64, 256}});
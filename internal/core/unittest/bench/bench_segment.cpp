@@ -0,0 +1,391 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// Macro benchmarks of the segment hot paths over reproducible synthetic
+// segments: filters per type and operator, MVCC with deletes, reduce,
+// bulk_subscript, field data loading and the expression result cache.
+// Segments are generated from fixed seeds, so runs of two builds compare
+// the same data. Track regressions with the JSON output, e.g.
+//   segment_bench --benchmark_out=segment.json --benchmark_out_format=json
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common/Consts.h"
+#include "exec/expression/ExprCache.h"
+#include "exec/expression/function/init_c.h"
+#include "folly/init/Init.h"
+#include "query/Plan.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "segcore/ChunkedSegmentSealedImpl.h"
+#include "segcore/reduce/Reduce.h"
+#include "storage/LocalChunkManagerSingleton.h"
+#include "storage/RemoteChunkManagerSingleton.h"
+#include "test_utils/Constants.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/cachinglayer_test_utils.h"
+#include "test_utils/storage_test_utils.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t kRows = 256 * 1024;
+constexpr int64_t kDim = 16;
+constexpr uint64_t kSeed = 42;
+// JSON values and strings are drawn from this many groups
+constexpr int kGroups = 100;
+
+enum Layout : int64_t {
+    SEALED = 0,
+    SEALED_MMAP = 1,
+    GROWING = 2,
+};
+
+const auto schema = []() {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->AddDebugField(
+        "vec", DataType::VECTOR_FLOAT, kDim, knowhere::metric::L2);
+    schema->AddDebugField("age", DataType::INT64, true);
+    schema->AddDebugField("score", DataType::DOUBLE, true);
+    schema->AddDebugField("name", DataType::VARCHAR, true);
+    schema->AddDebugField("meta", DataType::JSON, true);
+    schema->set_primary_field_id(pk);
+    return schema;
+}();
+
+const GeneratedData&
+Dataset(int null_percent, uint64_t seed = kSeed) {
+    static std::map<std::pair<int, uint64_t>, GeneratedData> datasets;
+    auto key = std::make_pair(null_percent, seed);
+    auto it = datasets.find(key);
+    if (it == datasets.end()) {
+        it = datasets
+                 .emplace(key,
+                          DataGen(schema,
+                                  kRows,
+                                  seed,
+                                  0,
+                                  1,
+                                  10,
+                                  kGroups,
+                                  false,
+                                  true,
+                                  null_percent > 0,
+                                  null_percent))
+                 .first;
+    }
+    return it->second;
+}
+
+// the segments are built once per layout, null ratio and seed, and shared
+// by all the benchmarks reading them
+SegmentInternalInterface*
+Segment(Layout layout, int null_percent, uint64_t seed = kSeed) {
+    static std::map<std::tuple<Layout, int, uint64_t>,
+                    std::unique_ptr<SegmentInternalInterface>>
+        segments;
+    auto key = std::make_tuple(layout, null_percent, seed);
+    auto it = segments.find(key);
+    if (it != segments.end()) {
+        return it->second.get();
+    }
+
+    const auto& dataset = Dataset(null_percent, seed);
+    std::unique_ptr<SegmentInternalInterface> segment;
+    if (layout == GROWING) {
+        auto growing = CreateGrowingSegment(schema, empty_index_meta);
+        growing->PreInsert(kRows);
+        growing->Insert(0,
+                        kRows,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+        segment = std::move(growing);
+    } else {
+        segment = CreateSealedWithFieldDataLoaded(
+            schema, dataset, layout == SEALED_MMAP);
+    }
+    return segments.emplace(key, std::move(segment)).first->second.get();
+}
+
+std::unique_ptr<RetrievePlan>
+RetrievePlanOf(const std::string& expr) {
+    ScopedSchemaHandle handle(*schema);
+    auto plan_bytes = handle.Parse(expr);
+    return CreateRetrievePlanByExpr(
+        schema, plan_bytes.data(), plan_bytes.size());
+}
+
+const std::vector<std::string> filter_exprs = {
+    "age < 131072",               // int64 range, half of the rows
+    "age in [1, 10, 100, 1000]",  // int64 term
+    "score > 0",                  // double compare
+    "name like \"1%\"",           // varchar prefix
+    "meta[\"int\"] < 50",         // json path compare
+    "age is null",                // null check
+    "age < 131072 and score > 0 or name == \"7\"",  // logical
+};
+
+// args: expression, layout, null percent
+void
+Filter(benchmark::State& state) {
+    auto plan = RetrievePlanOf(filter_exprs[state.range(0)]);
+    auto segment = Segment(static_cast<Layout>(state.range(1)),
+                           static_cast<int>(state.range(2)));
+    state.SetLabel(filter_exprs[state.range(0)]);
+    for (auto _ : state) {
+        auto result = segment->Retrieve(
+            nullptr, plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE, false);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * kRows);
+}
+
+BENCHMARK(Filter)
+    ->ArgsProduct({benchmark::CreateDenseRange(0, 6, 1),
+                   {SEALED, SEALED_MMAP, GROWING},
+                   {0, 20}})
+    ->Unit(benchmark::kMillisecond);
+
+// args: layout, deleted rows per 1000
+void
+MvccWithDeletes(benchmark::State& state) {
+    auto layout = static_cast<Layout>(state.range(0));
+    auto deletes_per_mille = state.range(1);
+    // a segment of its own, the deletes are not undone
+    auto segment = layout == GROWING
+                       ? std::unique_ptr<SegmentInternalInterface>(
+                             CreateGrowingSegment(schema, empty_index_meta))
+                       : std::unique_ptr<SegmentInternalInterface>(
+                             CreateSealedSegment(schema));
+    const auto& dataset = Dataset(0);
+    if (layout == GROWING) {
+        auto growing = dynamic_cast<SegmentGrowing*>(segment.get());
+        growing->PreInsert(kRows);
+        growing->Insert(0,
+                        kRows,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+    } else {
+        LoadGeneratedDataIntoSegment(dataset, segment.get());
+    }
+
+    auto num_deletes = kRows * deletes_per_mille / 1000;
+    if (num_deletes > 0) {
+        auto pks = dataset.get_col<int64_t>(schema->get_primary_field_id()
+                                                .value());
+        IdArray ids;
+        std::vector<Timestamp> timestamps;
+        for (int64_t i = 0; i < num_deletes; ++i) {
+            ids.mutable_int_id()->add_data(pks[i * 1000 / deletes_per_mille]);
+            timestamps.push_back(kRows + i);
+        }
+        segment->Delete(num_deletes, &ids, timestamps.data());
+    }
+
+    auto plan = RetrievePlanOf("age >= 0");
+    for (auto _ : state) {
+        auto result = segment->Retrieve(
+            nullptr, plan.get(), MAX_TIMESTAMP, DEFAULT_MAX_OUTPUT_SIZE, false);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * kRows);
+}
+
+BENCHMARK(MvccWithDeletes)
+    ->ArgsProduct({{SEALED, GROWING}, {0, 1, 100, 500}})
+    ->Unit(benchmark::kMillisecond);
+
+// args: segments, topk
+void
+Reduce(benchmark::State& state) {
+    auto num_segments = state.range(0);
+    auto topk = state.range(1);
+    constexpr int64_t num_queries = 10;
+
+    ScopedSchemaHandle handle(*schema);
+    auto plan_bytes = handle.ParseSearch("", "vec", topk, "L2");
+    auto plan =
+        CreateSearchPlanByExpr(schema, plan_bytes.data(), plan_bytes.size());
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, kDim, kSeed);
+    auto ph_group =
+        ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    std::vector<SegmentInternalInterface*> segments;
+    for (int64_t i = 0; i < num_segments; ++i) {
+        segments.push_back(Segment(SEALED, 0, kSeed + i));
+    }
+
+    int64_t slice_nqs[] = {num_queries};
+    int64_t slice_topks[] = {topk};
+    for (auto _ : state) {
+        // reduce consumes the results, so every round searches again
+        state.PauseTiming();
+        std::vector<std::unique_ptr<SearchResult>> results;
+        std::vector<SearchResult*> result_ptrs;
+        for (auto segment : segments) {
+            results.push_back(
+                segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP));
+            result_ptrs.push_back(results.back().get());
+        }
+        state.ResumeTiming();
+
+        ReduceHelper helper(
+            result_ptrs, plan.get(), slice_nqs, slice_topks, 1, nullptr);
+        helper.Reduce();
+        helper.Marshal();
+        auto blobs = static_cast<SearchResultDataBlobs*>(
+            helper.GetSearchResultDataBlobs());
+        state.PauseTiming();
+        delete blobs;
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(Reduce)
+    ->ArgsProduct({{1, 4, 16}, {10, 100, 1000}})
+    ->Unit(benchmark::kMillisecond);
+
+// args: field, layout, rows fetched
+void
+BulkSubscript(benchmark::State& state) {
+    static const std::vector<std::string> fields = {"age", "name", "meta"};
+    auto field_id = schema->get_field_id(FieldName(fields[state.range(0)]));
+    auto segment = Segment(static_cast<Layout>(state.range(1)), 20);
+    auto count = state.range(2);
+
+    std::vector<int64_t> offsets(count);
+    std::default_random_engine random(kSeed);
+    for (auto& offset : offsets) {
+        offset = random() % kRows;
+    }
+    state.SetLabel(fields[state.range(0)]);
+    for (auto _ : state) {
+        auto data =
+            segment->bulk_subscript(nullptr, field_id, offsets.data(), count);
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(BulkSubscript)
+    ->ArgsProduct({{0, 1, 2}, {SEALED, SEALED_MMAP, GROWING}, {100, 10000}})
+    ->Unit(benchmark::kMicrosecond);
+
+// args: mmap, null percent
+void
+LoadSealedFieldData(benchmark::State& state) {
+    bool with_mmap = state.range(0) != 0;
+    const auto& dataset = Dataset(static_cast<int>(state.range(1)));
+    auto cm = storage::RemoteChunkManagerSingleton::GetInstance()
+                  .GetRemoteChunkManager();
+    // the binlogs are written once, every round only loads them
+    auto load_info = PrepareInsertBinlog(kCollectionID,
+                                         kPartitionID,
+                                         kSegmentID,
+                                         dataset,
+                                         cm,
+                                         with_mmap ? "./data/mmap-bench" : "");
+    for (auto _ : state) {
+        auto segment = CreateSealedSegment(schema);
+        auto status = LoadFieldData(segment.get(), &load_info);
+        AssertInfo(status.error_code == Success,
+                   "failed to load field data: {}",
+                   status.error_msg);
+        benchmark::DoNotOptimize(segment);
+        state.PauseTiming();
+        segment.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kRows);
+}
+
+BENCHMARK(LoadSealedFieldData)
+    ->ArgsProduct({{0, 1}, {0, 20}})
+    ->Unit(benchmark::kMillisecond);
+
+// args: bits per entry
+void
+ExprResCache(benchmark::State& state) {
+    auto bits = state.range(0);
+    auto& mgr = exec::ExprResCacheManager::Instance();
+    exec::ExprResCacheManager::SetEnabled(true);
+    mgr.Clear();
+    mgr.SetCapacityBytes(256ULL << 20);
+
+    constexpr int kEntries = 64;
+    exec::ExprResCacheManager::Value value;
+    value.result = std::make_shared<TargetBitmap>(bits);
+    value.valid_result = std::make_shared<TargetBitmap>(bits, true);
+    value.active_count = bits;
+    std::default_random_engine random(kSeed);
+    for (int64_t i = 0; i < bits; i += 3) {
+        value.result->set(i, random() % 2);
+    }
+
+    int64_t round = 0;
+    for (auto _ : state) {
+        exec::ExprResCacheManager::Key key{round % kEntries,
+                                           "age < 131072"};
+        exec::ExprResCacheManager::Value out;
+        if (!mgr.Get(key, out)) {
+            mgr.Put(key, value);
+        }
+        benchmark::DoNotOptimize(out);
+        ++round;
+    }
+
+    mgr.Clear();
+    exec::ExprResCacheManager::SetEnabled(false);
+}
+
+BENCHMARK(ExprResCache)->Arg(8192)->Arg(kRows)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+    ::benchmark::Initialize(&argc, argv);
+    folly::Init follyInit(&argc, &argv, false);
+    InitExecExpressionFunctionFactory();
+
+    storage::LocalChunkManagerSingleton::GetInstance().Init(TestLocalPath);
+    storage::RemoteChunkManagerSingleton::GetInstance().Init(
+        get_default_local_storage_config());
+    storage::MmapManager::GetInstance().Init(get_default_mmap_config());
+
+    static const int64_t mb = 1024 * 1024;
+    cachinglayer::Manager::ConfigureTieredStorage(
+        {CacheWarmupPolicy::CacheWarmupPolicy_Disable,
+         CacheWarmupPolicy::CacheWarmupPolicy_Disable,
+         CacheWarmupPolicy::CacheWarmupPolicy_Disable,
+         CacheWarmupPolicy::CacheWarmupPolicy_Disable},
+        {8192 * mb, 8192 * mb, 8192 * mb, 8192 * mb, 8192 * mb, 8192 * mb},
+        true,
+        true,
+        {10, true, 30},
+        std::chrono::milliseconds(0));
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return 0;
+}
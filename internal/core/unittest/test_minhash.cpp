@@ -13,6 +13,7 @@
 #include <vector>
 #include <memory>
 #include <cstring>
+#include <string>
 #include <algorithm>
 #include <iostream>
 
@@ -664,3 +665,89 @@ TEST_F(MinHashTest, StressTestNativeVsCurrent) {
         seed = seed * 1103515245 + 12345;
     }
 }
+
+TEST_F(MinHashTest, MultiTextKernelMatchesNative) {
+    std::vector<int32_t> shingle_counts = {0, 1, 7, 8, 15, 16, 17, 100, 0, 3};
+    std::vector<uint64_t> base_hashes;
+    uint64_t seed = 12345;
+    for (auto count : shingle_counts) {
+        for (int32_t j = 0; j < count; j++) {
+            seed = seed * 1103515245 + 12345;
+            base_hashes.push_back(seed & MAX_HASH_MASK);
+        }
+    }
+    int32_t num_texts = shingle_counts.size();
+    // a stride wider than 8 as the signatures of a text are num_hashes wide
+    size_t stride = 16;
+    std::vector<uint32_t> sig_native(num_texts * stride, 0);
+    std::vector<uint32_t> sig_current(num_texts * stride, 0);
+    linear_and_find_min_batch8_multi_native(base_hashes.data(),
+                                            shingle_counts.data(),
+                                            num_texts,
+                                            perm_a_.data(),
+                                            perm_b_.data(),
+                                            sig_native.data(),
+                                            stride);
+    linear_and_find_min_batch8_multi_impl(base_hashes.data(),
+                                          shingle_counts.data(),
+                                          num_texts,
+                                          perm_a_.data(),
+                                          perm_b_.data(),
+                                          sig_current.data(),
+                                          stride);
+    EXPECT_EQ(sig_current, sig_native);
+    for (int32_t k = 0; k < 8; k++) {
+        EXPECT_EQ(sig_current[k], MAX_HASH_32);
+        auto expected = linear_and_find_min_native(
+            base_hashes.data(), 1, perm_a_[k], perm_b_[k]);
+        EXPECT_EQ(sig_current[k + stride], expected);
+    }
+}
+
+TEST_F(MinHashTest, ManyTextsMatchOneByOne) {
+    // enough shingles for several tiles of texts
+    int32_t num_texts = 5000;
+    std::vector<std::string> text_strings;
+    for (int32_t i = 0; i < num_texts; i++) {
+        text_strings.push_back("document " + std::to_string(i * 7919) +
+                               std::string(i % 13, 'x'));
+    }
+    text_strings[194].clear();
+    std::vector<const char*> texts;
+    std::vector<int32_t> text_lengths;
+    for (const auto& s : text_strings) {
+        texts.push_back(s.c_str());
+        text_lengths.push_back(s.size());
+    }
+
+    int32_t shingle_size = 3;
+    std::vector<uint32_t> signatures(num_texts * num_hashes_);
+    ComputeFromTextsDirectly(texts.data(),
+                             text_lengths.data(),
+                             num_texts,
+                             nullptr,
+                             shingle_size,
+                             perm_a_.data(),
+                             perm_b_.data(),
+                             HashFunction::XXHASH64,
+                             num_hashes_,
+                             signatures.data());
+
+    std::vector<uint32_t> expected(num_hashes_);
+    for (int32_t i = 0; i < num_texts; i += 97) {
+        ComputeFromTextsDirectly(&texts[i],
+                                 &text_lengths[i],
+                                 1,
+                                 nullptr,
+                                 shingle_size,
+                                 perm_a_.data(),
+                                 perm_b_.data(),
+                                 HashFunction::XXHASH64,
+                                 num_hashes_,
+                                 expected.data());
+        EXPECT_TRUE(std::equal(expected.begin(),
+                               expected.end(),
+                               signatures.begin() + i * num_hashes_))
+            << "text " << i;
+    }
+}
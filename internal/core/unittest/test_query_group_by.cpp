@@ -578,4 +578,92 @@ TEST_P(QueryAggTest, GlobalCountEmptyTest) {
     auto actual_count = output_column->ValueAt<int64_t>(0);
     EXPECT_EQ(0, actual_count);
     // count(*) will get zero if no valid input into agg node
-}
\ No newline at end of file
+}
+// count(*), min and max with no filter come from the segment stats
+TEST_P(QueryAggTest, GlobalStatsAggTest) {
+    std::vector<milvus::plan::PlanNodePtr> sources;
+    auto nullable = GetParam();
+    PlanNodePtr mvcc_node = std::make_shared<milvus::plan::MvccNode>(
+        milvus::plan::GetNextPlanNodeId(), sources);
+    sources = std::vector<milvus::plan::PlanNodePtr>{mvcc_node};
+    auto int32_id = field_map_[int32_field];
+    auto int64_id = field_map_[int64_field];
+    PlanNodePtr project_node = std::make_shared<milvus::plan::ProjectNode>(
+        milvus::plan::GetNextPlanNodeId(),
+        std::vector<FieldId>{int32_id, int64_id},
+        std::vector<std::string>{int32_field, int64_field},
+        std::vector<DataType>{DataType::INT32, DataType::INT64},
+        sources);
+    sources = std::vector<milvus::plan::PlanNodePtr>{project_node};
+
+    std::vector<std::string> agg_names{KCount, KMin, KMax};
+    std::vector<plan::AggregationNode::Aggregate> aggregates;
+    {
+        auto call = std::make_shared<const expr::CallExpr>(
+            KCount, std::vector<expr::TypedExprPtr>{}, nullptr);
+        aggregates.emplace_back(plan::AggregationNode::Aggregate{call});
+        aggregates.back().resultType_ =
+            GetAggResultType(KCount, DataType::NONE);
+    }
+    auto add_field_agg = [&](const std::string& agg_name,
+                             DataType type,
+                             const char* field_name,
+                             FieldId field_id) {
+        auto input = std::make_shared<const expr::FieldAccessTypeExpr>(
+            type, field_name, field_id);
+        auto call = std::make_shared<const expr::CallExpr>(
+            agg_name, std::vector<expr::TypedExprPtr>{input}, nullptr);
+        aggregates.emplace_back(plan::AggregationNode::Aggregate{call});
+        aggregates.back().rawInputTypes_.emplace_back(type);
+        aggregates.back().resultType_ = GetAggResultType(agg_name, type);
+    };
+    add_field_agg(KMin, DataType::INT32, int32_field, int32_id);
+    add_field_agg(KMax, DataType::INT64, int64_field, int64_id);
+    PlanNodePtr agg_node = std::make_shared<plan::AggregationNode>(
+        milvus::plan::GetNextPlanNodeId(),
+        std::vector<expr::FieldAccessTypeExprPtr>{},
+        std::move(agg_names),
+        std::move(aggregates),
+        sources);
+
+    auto plan = plan::PlanFragment(agg_node);
+    auto query_context = std::make_shared<milvus::exec::QueryContext>(
+        "test1", segment_.get(), num_rows_, MAX_TIMESTAMP);
+    auto op_context = milvus::OpContext();
+    query_context->set_op_context(&op_context);
+    auto task = Task::Create("task_query_group_by", plan, 0, query_context);
+    RowVectorPtr ret = execPlan(task);
+    ASSERT_EQ(3, ret->childrens().size());
+    ASSERT_EQ(1, ret->size());
+
+    // the same data as SetUp() loaded
+    auto raw_data =
+        DataGen(schema_, num_rows_, 42, 0, 2, 10, false, false, false);
+    auto int32_values = raw_data.get_col<int32_t>(int32_id);
+    auto int64_values = raw_data.get_col<int64_t>(int64_id);
+    std::optional<int32_t> expected_min;
+    std::optional<int64_t> expected_max;
+    for (int64_t i = 0; i < num_rows_; i++) {
+        if (!nullable || raw_data.get_col_valid(int32_id)[i]) {
+            expected_min = std::min(
+                expected_min.value_or(int32_values[i]), int32_values[i]);
+        }
+        if (!nullable || raw_data.get_col_valid(int64_id)[i]) {
+            expected_max = std::max(
+                expected_max.value_or(int64_values[i]), int64_values[i]);
+        }
+    }
+
+    auto count_column = std::dynamic_pointer_cast<ColumnVector>(ret->child(0));
+    EXPECT_EQ(num_rows_, count_column->ValueAt<int64_t>(0));
+    auto min_column = std::dynamic_pointer_cast<ColumnVector>(ret->child(1));
+    ASSERT_EQ(expected_min.has_value(), min_column->ValidAt(0));
+    if (expected_min.has_value()) {
+        EXPECT_EQ(*expected_min, min_column->ValueAt<int32_t>(0));
+    }
+    auto max_column = std::dynamic_pointer_cast<ColumnVector>(ret->child(2));
+    ASSERT_EQ(expected_max.has_value(), max_column->ValidAt(0));
+    if (expected_max.has_value()) {
+        EXPECT_EQ(*expected_max, max_column->ValueAt<int64_t>(0));
+    }
+}
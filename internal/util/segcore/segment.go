@@ -15,6 +15,7 @@ import (
 	"context"
 	"fmt"
 	"runtime"
+	"time"
 	"unsafe"
 
 	"github.com/cockroachdb/errors"
@@ -122,6 +123,16 @@ func (s *cSegmentImpl) HasFieldData(fieldID int64) bool {
 	return bool(ret)
 }
 
+// cTimeoutMs is the milliseconds ctx has left, zero if it has no deadline.
+// The segcore drops the requests past it.
+func cTimeoutMs(ctx context.Context) C.int64_t {
+	deadline, ok := ctx.Deadline()
+	if !ok {
+		return 0
+	}
+	return C.int64_t(max(time.Until(deadline).Milliseconds(), 1))
+}
+
 // Search requests a search on the segment.
 func (s *cSegmentImpl) Search(ctx context.Context, searchReq *SearchRequest) (*SearchResult, error) {
 	traceCtx := ParseCTraceContext(ctx)
@@ -138,6 +149,7 @@ func (s *cSegmentImpl) Search(ctx context.Context, searchReq *SearchRequest) (*S
 				C.uint64_t(searchReq.mvccTimestamp),
 				C.int32_t(searchReq.consistencyLevel),
 				C.uint64_t(searchReq.collectionTTL),
+				cTimeoutMs(ctx),
 			))
 		},
 		cgo.WithName("search"),
@@ -167,6 +179,7 @@ func (s *cSegmentImpl) Retrieve(ctx context.Context, plan *RetrievePlan) (*Retri
 				C.bool(plan.ignoreNonPk),
 				C.int32_t(plan.consistencyLevel),
 				C.uint64_t(plan.collectionTTL),
+				cTimeoutMs(ctx),
 			))
 		},
 		cgo.WithName("retrieve"),